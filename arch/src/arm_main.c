@@ -10,6 +10,7 @@
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_macros.h>
+#include <fwk_noreturn.h>
 #include <cmsis_compiler.h>
 
 #define SCB_CCR ((FWK_RW uint32_t *)(0xE000ED14))
@@ -18,7 +19,17 @@
 #define SCB_CCR_DIV_0_TRP_MASK    (1U << 4)
 #define SCB_CCR_STKALIGN_MASK     (1U << 9)
 
+#ifdef BUILD_HAS_EVENT_PROFILING
+#define DCB_DEMCR ((FWK_RW uint32_t *)(0xE000EDFC))
+#define DWT_CTRL ((FWK_RW uint32_t *)(0xE0001000))
+#define DWT_CYCCNT ((FWK_RW uint32_t *)(0xE0001004))
+
+#define DCB_DEMCR_TRCENA_MASK     (1U << 24)
+#define DWT_CTRL_CYCCNTENA_MASK   (1U << 0)
+#endif
+
 extern int arm_nvic_init(struct fwk_arch_interrupt_driver **driver);
+extern void arm_nvic_resume(void);
 extern int arm_mm_init(struct fwk_arch_mm_data *data);
 
 #if defined(__ARMCC_VERSION)
@@ -54,9 +65,47 @@ void _exit(int status)
 }
 #endif
 
+#ifdef BUILD_HAS_EVENT_PROFILING
+/*
+ * Timestamp in processor cycles provided by the cycle counter of the Data
+ * Watchpoint and Trace unit (DWT) (1).
+ *
+ * (1) ARM® v7-M Architecture Reference Manual, section C1.8.
+ */
+static uint32_t arm_timestamp(void)
+{
+    return *DWT_CYCCNT;
+}
+
+static void arm_init_dwt(void)
+{
+    /* The DWT is enabled by the TRCENA bit of the DEMCR register */
+    *DCB_DEMCR |= DCB_DEMCR_TRCENA_MASK;
+
+    *DWT_CYCCNT = 0;
+    *DWT_CTRL |= DWT_CTRL_CYCCNTENA_MASK;
+}
+#endif
+
+/*
+ * Wait for an interrupt in the sleep state. With PRIMASK set, a pending
+ * interrupt wakes the processor up without being taken (1).
+ *
+ * (1) ARM® v7-M Architecture Reference Manual, section B1.5.19.
+ */
+static void arm_idle(void)
+{
+    __DSB();
+    __WFI();
+}
+
 static struct fwk_arch_init_driver arch_init_driver = {
     .mm = arm_mm_init,
     .interrupt = arm_nvic_init,
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    .timestamp = arm_timestamp,
+    #endif
+    .idle = arm_idle,
 };
 
 static void arm_init_ccr(void)
@@ -84,6 +133,30 @@ static void arm_init_ccr(void)
 int main(void)
 {
     arm_init_ccr();
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    arm_init_dwt();
+    #endif
 
     return fwk_arch_init(&arch_init_driver);
 }
+
+/*
+ * Entry point of the firmware when the processor wakes up from a low-power
+ * state with the memory of the firmware retained. The reset handler of the
+ * platform branches here instead of initializing the C runtime, and the
+ * firmware boots again if it cannot be resumed.
+ */
+noreturn void arm_resume(void)
+{
+    extern noreturn void arm_exception_reset(void);
+
+    arm_init_ccr();
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    arm_init_dwt();
+    #endif
+    arm_nvic_resume();
+
+    fwk_arch_resume();
+
+    arm_exception_reset();
+}
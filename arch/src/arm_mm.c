@@ -22,17 +22,29 @@ int arm_mm_init(struct fwk_arch_mm_data *data)
     extern unsigned int Image$$ARM_LIB_STACKHEAP$$ZI$$Base;
     extern unsigned int Image$$ARM_LIB_STACKHEAP$$ZI$$Length;
 
+    /* The hot heap region only exists if the firmware defines one */
+    extern unsigned int Image$$ER_HOTHEAP$$ZI$$Base __attribute__((weak));
+    extern unsigned int Image$$ER_HOTHEAP$$ZI$$Length __attribute__((weak));
+
     data->start = (uintptr_t)(&Image$$ARM_LIB_STACKHEAP$$ZI$$Base);
     data->size = (size_t)(&Image$$ARM_LIB_STACKHEAP$$ZI$$Length);
+
+    data->hot_start = (uintptr_t)(&Image$$ER_HOTHEAP$$ZI$$Base);
+    data->hot_size = (size_t)(&Image$$ER_HOTHEAP$$ZI$$Length);
 #else
     extern char __stackheap_start__;
     extern char __stackheap_end__;
+    extern char __hotheap_start__;
+    extern char __hotheap_end__;
 
     uintptr_t start = (uintptr_t)(&__stackheap_start__);
     uintptr_t end = (uintptr_t)(&__stackheap_end__);
 
     data->start = start;
     data->size = end - start;
+
+    data->hot_start = (uintptr_t)(&__hotheap_start__);
+    data->hot_size = (uintptr_t)(&__hotheap_end__) - data->hot_start;
 #endif
 
     return FWK_SUCCESS;
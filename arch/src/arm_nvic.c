@@ -16,6 +16,7 @@
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_noreturn.h>
+#include <fwk_trace.h>
 #include <cmsis_compiler.h>
 
 #ifdef BUILD_HAS_MULTITHREADING
@@ -26,16 +27,36 @@ extern noreturn void arm_exception_invalid(void);
 
 struct nvic;
 
+#define SCB_AIRCR ((FWK_RW uint32_t *)(0xE000ED0CUL))
 #define SCB_SHCSR ((FWK_RW uint32_t *)(0xE000ED24UL))
 #define SCB_VTOR ((FWK_RW uint32_t *)(0xE000ED08UL))
 #define SCS_ICTR ((FWK_R  uint32_t *)(0xE000E004UL))
 #define SCS_STIR ((FWK_W  uint32_t *)(0xE000EF00UL))
 #define SCS_NVIC ((struct nvic *)(0xE000E100UL))
 
+#define SCB_AIRCR_VECTKEY           (UINT32_C(0x05FA) << 16)
+#define SCB_AIRCR_VECTKEY_MASK      (UINT32_C(0xFFFF) << 16)
+#define SCB_AIRCR_PRIGROUP_POS      8
+#define SCB_AIRCR_PRIGROUP_MASK     (UINT32_C(0x7) << SCB_AIRCR_PRIGROUP_POS)
+
 #define SCB_SHCSR_MEMFAULTENA_MASK  (1 << 16)
 #define SCB_SHCSR_BUSFAULTENA_MASK  (1 << 17)
 #define SCB_SHCSR_USGFAULTENA_MASK  (1 << 18)
 
+#ifdef BUILD_HAS_INTERRUPT_TRACING
+#define SCB_DEMCR ((FWK_RW uint32_t *)(0xE000EDFCUL))
+#define DWT_CTRL ((FWK_RW uint32_t *)(0xE0001000UL))
+#define DWT_CYCCNT ((FWK_RW uint32_t *)(0xE0001004UL))
+
+#define SCB_DEMCR_TRCENA_MASK (1 << 24)
+#define DWT_CTRL_CYCCNTENA_MASK (1 << 0)
+#endif
+
+#if defined(BUILD_HAS_INTERRUPT_TRACING) || defined(BUILD_HAS_TRACE)
+/* All the IRQs are called through the global handler */
+#define IRQ_GLOBAL_ALL
+#endif
+
 enum exception_num {
     EXCEPTION_NUM_INVALID      = 0U,
     EXCEPTION_NUM_RESET        = 1U,
@@ -62,32 +83,99 @@ struct nvic {
            uint32_t RESERVED3[16];
     FWK_R  uint32_t IABR[16];      /* Interrupt Active Bit Register */
            uint32_t RESERVED4[48];
-    FWK_W  uint32_t IPR[16];       /* Interrupt Priority Register */
-           uint32_t RESERVED5[48];
+    FWK_RW uint8_t  IPR[496];      /* Interrupt Priority Register */
 };
 
 static uint32_t isr_count;
 static uint32_t irq_count;
 
+/* Number of priority bits implemented, the most significant of the fields */
+static unsigned int priority_bits;
+
 /*
  * For interrupts with parameters, their entry in the vector table points to a
  * global handler that calls a registered function in the callback table with a
  * corresponding parameter. Entries in the vector table for interrupts without
  * parameters point directly to the handler functions.
+ *
+ * When the interrupts are traced, or when the firmware has trace points, the
+ * entries of all the IRQs point to the global handler, which measures the
+ * handlers with the DWT cycle counter and marks their entry and exit.
  */
 struct callback {
     void (*func)(uintptr_t param);
     uintptr_t param;
+#ifdef IRQ_GLOBAL_ALL
+    void (*func_no_param)(void);
+#endif
 };
 
 static void (**vector)(void);
 static struct callback *callback;
 
-static void irq_global(void)
+#ifdef BUILD_HAS_INTERRUPT_TRACING
+static struct fwk_interrupt_trace_stats *trace_stats;
+
+/*
+ * Number of interrupt handlers being processed. A handler preempting another
+ * one during an update restores the level before returning, so the updates do
+ * not need to be atomic.
+ */
+static volatile unsigned int nesting_level;
+
+static FWK_HOT void irq_global(void)
+{
+    unsigned int isr = __get_IPSR();
+    struct callback *entry = &callback[isr];
+    struct fwk_interrupt_trace_stats *stats = &trace_stats[isr];
+    uint32_t start, duration;
+
+    nesting_level++;
+    if (nesting_level > stats->max_nesting)
+        stats->max_nesting = nesting_level;
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_ENTRY, isr);
+
+    start = *DWT_CYCCNT;
+
+    if (entry->func != NULL)
+        entry->func(entry->param);
+    else
+        entry->func_no_param();
+
+    /* The subtraction handles the wrap around of the cycle counter */
+    duration = *DWT_CYCCNT - start;
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_EXIT, isr);
+
+    nesting_level--;
+
+    stats->count++;
+    if (duration > stats->max_duration)
+        stats->max_duration = duration;
+}
+#elif defined(BUILD_HAS_TRACE)
+static FWK_HOT void irq_global(void)
+{
+    unsigned int isr = __get_IPSR();
+    struct callback *entry = &callback[isr];
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_ENTRY, isr);
+
+    if (entry->func != NULL)
+        entry->func(entry->param);
+    else
+        entry->func_no_param();
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_EXIT, isr);
+}
+#else
+static FWK_HOT void irq_global(void)
 {
     struct callback *entry = &callback[__get_IPSR()];
     entry->func(entry->param);
 }
+#endif
 
 static int global_enable(void)
 {
@@ -167,10 +255,22 @@ static int clear_pending(unsigned int interrupt)
 
 static int set_isr_irq(unsigned int interrupt, void (*isr)(void))
 {
+#ifdef IRQ_GLOBAL_ALL
+    struct callback *entry;
+#endif
+
     if (interrupt >= irq_count)
         return FWK_E_PARAM;
 
+#ifdef IRQ_GLOBAL_ALL
+    vector[EXCEPTION_NUM_COUNT + interrupt] = irq_global;
+
+    entry = &callback[EXCEPTION_NUM_COUNT + interrupt];
+    entry->func = NULL;
+    entry->func_no_param = isr;
+#else
     vector[EXCEPTION_NUM_COUNT + interrupt] = isr;
+#endif
 
     return FWK_SUCCESS;
 }
@@ -240,6 +340,56 @@ static int get_current(unsigned int *interrupt)
     return FWK_SUCCESS;
 }
 
+#ifdef BUILD_HAS_INTERRUPT_TRACING
+static int get_trace_stats(unsigned int interrupt,
+                           struct fwk_interrupt_trace_stats *stats)
+{
+    if (interrupt >= irq_count)
+        return FWK_E_PARAM;
+
+    *stats = trace_stats[EXCEPTION_NUM_COUNT + interrupt];
+
+    return FWK_SUCCESS;
+}
+#endif
+
+static int set_priority(unsigned int interrupt, unsigned int priority)
+{
+    if (interrupt >= irq_count)
+        return FWK_E_PARAM;
+
+    if (priority >= (1U << priority_bits))
+        return FWK_E_RANGE;
+
+    SCS_NVIC->IPR[interrupt] = (uint8_t)(priority << (8 - priority_bits));
+
+    return FWK_SUCCESS;
+}
+
+static int set_priority_grouping(unsigned int subpriority_bits)
+{
+    unsigned int field_subpriority_bits;
+    uint32_t prigroup;
+
+    if (subpriority_bits > priority_bits)
+        return FWK_E_RANGE;
+
+    /*
+     * The unimplemented bits are subpriority bits of the fields, of which at
+     * least one is a subpriority bit (1).
+     *
+     * (1) ARM® v7-M Architecture Reference Manual, section B1.5.4.
+     */
+    field_subpriority_bits = (8 - priority_bits) + subpriority_bits;
+    prigroup = (field_subpriority_bits == 0) ? 0 : field_subpriority_bits - 1;
+
+    *SCB_AIRCR = (*SCB_AIRCR & ~(SCB_AIRCR_VECTKEY_MASK |
+                                 SCB_AIRCR_PRIGROUP_MASK)) |
+                 SCB_AIRCR_VECTKEY | (prigroup << SCB_AIRCR_PRIGROUP_POS);
+
+    return FWK_SUCCESS;
+}
+
 static const struct fwk_arch_interrupt_driver arm_nvic_driver = {
     .global_enable     = global_enable,
     .global_disable    = global_disable,
@@ -255,6 +405,11 @@ static const struct fwk_arch_interrupt_driver arm_nvic_driver = {
     .set_isr_nmi_param = set_isr_nmi_param,
     .set_isr_fault     = set_isr_fault,
     .get_current       = get_current,
+#ifdef BUILD_HAS_INTERRUPT_TRACING
+    .get_trace_stats   = get_trace_stats,
+#endif
+    .set_priority      = set_priority,
+    .set_priority_grouping = set_priority_grouping,
 };
 
 static void irq_invalid(void)
@@ -266,12 +421,27 @@ static void irq_invalid(void)
     disable(__get_IPSR());
 }
 
+/*
+ * Restore the state of the NVIC lost while the processor was powered down. The
+ * interrupts are enabled again by the modules as they resume.
+ */
+void arm_nvic_resume(void)
+{
+    *SCB_VTOR = (uint32_t)vector;
+    __DMB();
+
+    *SCB_SHCSR |= SCB_SHCSR_MEMFAULTENA_MASK |
+                  SCB_SHCSR_BUSFAULTENA_MASK |
+                  SCB_SHCSR_USGFAULTENA_MASK;
+}
+
 int arm_nvic_init(const struct fwk_arch_interrupt_driver **driver)
 {
     uint32_t ictr_intlinesnum;
     uint32_t align_entries;
     uint32_t align_word;
     unsigned int i;
+    uint8_t priority_mask;
 
     if (driver == NULL)
         return FWK_E_PARAM;
@@ -281,6 +451,14 @@ int arm_nvic_init(const struct fwk_arch_interrupt_driver **driver)
     irq_count = (ictr_intlinesnum + 1) * 32;
     isr_count = irq_count + EXCEPTION_NUM_COUNT;
 
+    /* The unimplemented priority bits read as zero */
+    SCS_NVIC->IPR[0] = UINT8_MAX;
+    priority_mask = SCS_NVIC->IPR[0];
+    SCS_NVIC->IPR[0] = 0;
+
+    for (priority_bits = 0; priority_mask != 0; priority_bits++)
+        priority_mask <<= 1;
+
     /*
      * Allocate and initialize a table for the callback functions and their
      * corresponding parameters.
@@ -288,6 +466,18 @@ int arm_nvic_init(const struct fwk_arch_interrupt_driver **driver)
     callback = fwk_mm_calloc(isr_count, sizeof(callback[0]));
     if (callback == NULL)
         return FWK_E_NOMEM;
+
+#ifdef BUILD_HAS_INTERRUPT_TRACING
+    trace_stats = fwk_mm_calloc(isr_count, sizeof(trace_stats[0]));
+    if (trace_stats == NULL)
+        return FWK_E_NOMEM;
+
+    /* Start the cycle counter used to measure the interrupt handlers */
+    *SCB_DEMCR |= SCB_DEMCR_TRCENA_MASK;
+    *DWT_CYCCNT = 0;
+    *DWT_CTRL |= DWT_CTRL_CYCCNTENA_MASK;
+#endif
+
     /*
      * The base address for the vector table must align on the number of
      * entries in the table, corresponding to a word boundary rounded up to the
@@ -15,6 +15,12 @@
 #include <cmsis_compiler.h>
 
 #ifdef __NEWLIB__
+static void copy_section(char *load, char *start, char *end)
+{
+    if (load != start)
+        memcpy(start, load, end - start);
+}
+
 /*
  * This function overloads a weak definition provided by Newlib. It is called
  * during initialization of the C runtime just after .bss has been zeroed.
@@ -24,13 +30,19 @@ void software_init_hook(void)
     extern char __data_load__;
     extern char __data_start__;
     extern char __data_end__;
+    extern char __hottext_load__;
+    extern char __hottext_start__;
+    extern char __hottext_end__;
 
-    char *load = &__data_load__;
-    char *start = &__data_start__;
-    char *end = &__data_end__;
+    copy_section(&__data_load__, &__data_start__, &__data_end__);
 
-    if (load != start)
-        memcpy(start, load, end - start);
+    if (&__hottext_load__ != &__hottext_start__) {
+        copy_section(&__hottext_load__, &__hottext_start__, &__hottext_end__);
+
+        /* Ensure the copied code is visible to the instruction fetches */
+        __DSB();
+        __ISB();
+    }
 }
 #endif
 
@@ -42,10 +54,12 @@ noreturn void arm_exception_reset(void)
      *  1. The toolchain-specific C runtime is initialized
      *     For Arm Compiler:
      *       1. Zero-initialized data is zeroed
-     *       2. Initialized data is decompressed and copied
+     *       2. Initialized data and the hot functions are decompressed and
+     *          copied
      *     For GCC/Newlib:
      *       1. Zero-initialized data is zeroed
-     *       2. Initialized data is copied by software_init_hook()
+     *       2. Initialized data and the hot functions are copied by
+     *          software_init_hook()
      * 2. The main() function is called by the C runtime
      */
 
@@ -29,6 +29,17 @@
  *      In this configuration MEM0 represents the RAM region attached to the
  *      instruction bus and MEM1 represents the RAM region attached to the data
  *      bus.
+ *
+ * Any of the layouts may be complemented by a hot memory region, for instance a
+ * data tightly-coupled memory, by defining FIRMWARE_HOT_MEM_BASE and
+ * FIRMWARE_HOT_MEM_SIZE. This region is used only for the allocations made
+ * with fwk_mm_alloc_hot().
+ *
+ * Likewise, the functions marked with FWK_HOT may be executed from a hot code
+ * memory, for instance an instruction tightly-coupled memory, by defining
+ * FIRMWARE_HOT_CODE_BASE and FIRMWARE_HOT_CODE_SIZE. These functions are copied
+ * from the load image to this memory during the initialization of the C
+ * runtime.
  */
 
 #define FWK_MEM_MODE_SINGLE_REGION 0
@@ -68,3 +79,15 @@
 
     #define FIRMWARE_MEM1_LIMIT (FIRMWARE_MEM1_BASE + FIRMWARE_MEM1_SIZE)
 #endif
+
+#ifdef FIRMWARE_HOT_MEM_BASE
+    #ifndef FIRMWARE_HOT_MEM_SIZE
+        #error "FIRMWARE_HOT_MEM_SIZE has not been configured"
+    #endif
+#endif
+
+#ifdef FIRMWARE_HOT_CODE_BASE
+    #ifndef FIRMWARE_HOT_CODE_SIZE
+        #error "FIRMWARE_HOT_CODE_SIZE has not been configured"
+    #endif
+#endif
@@ -5,8 +5,13 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+/* Required for clock_gettime() and nanosleep() when building with -std=c11 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <fwk_arch.h>
 #include <fwk_errno.h>
 #include <fwk_noreturn.h>
@@ -37,9 +42,55 @@ static int mm_init(struct fwk_arch_mm_data *data)
     return FWK_SUCCESS;
 }
 
+#ifdef BUILD_HAS_EVENT_PROFILING
+/*
+ * Timestamp in nanoseconds of the monotonic clock.
+ */
+static uint32_t timestamp(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint32_t)((time.tv_sec * 1000000000ULL) + time.tv_nsec);
+}
+#endif
+
+/* Handler called when the firmware waits for an interrupt, may be NULL */
+static bool (*idle_handler)(void);
+
+/*
+ * Set the handler called when the firmware waits for an interrupt. The handler
+ * returns true if it raised an interrupt, false if the firmware should wait
+ * for another source to raise one. Used to emulate devices progressing while
+ * the firmware waits, a virtual timer for instance.
+ */
+void host_set_idle_handler(bool (*handler)(void))
+{
+    idle_handler = handler;
+}
+
+/*
+ * There is no interrupt on the host, sleep instead of spinning while waiting
+ * for one.
+ */
+static void idle(void)
+{
+    const struct timespec duration = { .tv_nsec = 1000000 }; /* 1ms */
+
+    if ((idle_handler != NULL) && idle_handler())
+        return;
+
+    nanosleep(&duration, NULL);
+}
+
 static const struct fwk_arch_init_driver arch_init_driver = {
     .mm = mm_init,
     .interrupt = host_interrupt_init,
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    .timestamp = timestamp,
+    #endif
+    .idle = idle,
 };
 
 int main(void)
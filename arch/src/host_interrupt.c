@@ -6,64 +6,189 @@
  *
  * Description:
  *     Interrupt management.
+ *
+ *     There is no interrupt controller on the host. The interrupts are
+ *     emulated: an interrupt is raised by software by setting it pending, and
+ *     its handler is called from the context that made it pending, or that
+ *     enabled it, once the interrupts are enabled. The handlers do not nest.
+ *     There is no NMI and no fault handler.
  */
 
 #include <stdbool.h>
 #include <stdint.h>
 #include <fwk_arch.h>
 #include <fwk_errno.h>
+#include <fwk_interrupt.h>
+
+/* Number of emulated interrupts */
+#define HOST_INTERRUPT_COUNT 64
+
+/* Emulated interrupt */
+struct host_interrupt {
+    /* Handler without parameter, NULL if the handler takes a parameter */
+    void (*isr)(void);
+
+    /* Handler with a parameter */
+    void (*isr_param)(uintptr_t param);
+
+    /* Parameter of the handler */
+    uintptr_t param;
+
+    /* Whether the interrupt is enabled */
+    bool enabled;
+
+    /* Whether the interrupt is pending */
+    bool pending;
+};
+
+static struct host_interrupt interrupt_table[HOST_INTERRUPT_COUNT];
+
+/* Whether the interrupts are globally enabled */
+static bool global_enabled = true;
+
+/* Interrupt being handled, FWK_INTERRUPT_NONE outside of an interrupt */
+static unsigned int current_interrupt = FWK_INTERRUPT_NONE;
+
+/*
+ * Call the handlers of the enabled pending interrupts, in order of interrupt
+ * number. A handler making an interrupt pending is not interrupted, the
+ * interrupt is handled after it returns.
+ */
+static void handle_pending_interrupts(void)
+{
+    struct host_interrupt *entry;
+    unsigned int interrupt = 0;
+
+    if (!global_enabled || (current_interrupt != FWK_INTERRUPT_NONE))
+        return;
+
+    while (interrupt < HOST_INTERRUPT_COUNT) {
+        entry = &interrupt_table[interrupt];
+        if (!entry->pending || !entry->enabled ||
+            ((entry->isr == NULL) && (entry->isr_param == NULL))) {
+            interrupt++;
+            continue;
+        }
+
+        entry->pending = false;
+        current_interrupt = interrupt;
+
+        if (entry->isr != NULL)
+            entry->isr();
+        else
+            entry->isr_param(entry->param);
+
+        current_interrupt = FWK_INTERRUPT_NONE;
+
+        /* The handler may have raised a lower-numbered interrupt */
+        interrupt = 0;
+
+        if (!global_enabled)
+            return;
+    }
+}
 
 static int global_enable(void)
 {
-    return FWK_E_SUPPORT;
+    global_enabled = true;
+    handle_pending_interrupts();
+
+    return FWK_SUCCESS;
 }
 
 static int global_disable(void)
 {
-    return FWK_E_SUPPORT;
+    global_enabled = false;
+
+    return FWK_SUCCESS;
 }
 
 static int is_enabled(unsigned int interrupt, bool *state)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    *state = interrupt_table[interrupt].enabled;
+
+    return FWK_SUCCESS;
 }
 
 static int enable(unsigned int interrupt)
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].enabled = true;
+    handle_pending_interrupts();
+
+    return FWK_SUCCESS;
 }
 
 static int disable(unsigned int interrupt)
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].enabled = false;
+
+    return FWK_SUCCESS;
 }
 
 static int is_pending(unsigned int interrupt, bool *state)
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    *state = interrupt_table[interrupt].pending;
+
+    return FWK_SUCCESS;
 }
 
 static int set_pending(unsigned int interrupt)
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].pending = true;
+    handle_pending_interrupts();
+
+    return FWK_SUCCESS;
 }
 
 static int clear_pending(unsigned int interrupt)
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].pending = false;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_irq(unsigned int interrupt,
                            void (*isr)(void))
 {
-   return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].isr = isr;
+    interrupt_table[interrupt].isr_param = NULL;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_irq_param(unsigned int interrupt,
                              void (*isr)(uintptr_t param),
                              uintptr_t parameter)
 {
-    return FWK_E_SUPPORT;
+    if (interrupt >= HOST_INTERRUPT_COUNT)
+        return FWK_E_PARAM;
+
+    interrupt_table[interrupt].isr = NULL;
+    interrupt_table[interrupt].isr_param = isr;
+    interrupt_table[interrupt].param = parameter;
+
+    return FWK_SUCCESS;
 }
 
 static int set_isr_nmi(void (*isr)(void))
@@ -83,7 +208,13 @@ static int set_isr_fault(void (*isr)(void))
 
 static int get_current(unsigned int *interrupt)
 {
-   return FWK_E_SUPPORT;
+    *interrupt = current_interrupt;
+
+    /* Not an interrupt */
+    if (current_interrupt == FWK_INTERRUPT_NONE)
+        return FWK_E_STATE;
+
+    return FWK_SUCCESS;
 }
 
 static const struct fwk_arch_interrupt_driver driver = {
@@ -14,6 +14,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <fwk_interrupt.h>
 
 /*!
  * \addtogroup GroupLibFramework Framework
@@ -178,6 +179,49 @@ struct fwk_arch_interrupt_driver {
      * \retval FWK_E_STATE An interrupt is not currently being serviced.
      */
     int (*get_current)(unsigned int *interrupt);
+
+    /*!
+     * \brief Get the tracing statistics of an interrupt.
+     *
+     * \param interrupt Interrupt number.
+     * \param [out] stats Tracing statistics of the interrupt.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     *
+     * \note May be NULL, in which case the interrupts are not traced.
+     */
+    int (*get_trace_stats)(unsigned int interrupt,
+                           struct fwk_interrupt_trace_stats *stats);
+
+    /*!
+     * \brief Set the priority of an interrupt.
+     *
+     * \param interrupt Interrupt number.
+     * \param priority Priority of the interrupt, \c 0 being the highest.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     * \retval FWK_E_RANGE The priority is not implemented.
+     *
+     * \note May be NULL, in which case all the interrupts have the same
+     *      priority.
+     */
+    int (*set_priority)(unsigned int interrupt, unsigned int priority);
+
+    /*!
+     * \brief Set the number of the least significant bits of the priorities
+     *      which are subpriority bits.
+     *
+     * \param subpriority_bits Number of subpriority bits.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_RANGE The number of bits is not supported.
+     *
+     * \note May be NULL, in which case all the bits of the priorities set
+     *      the preemption of the interrupts.
+     */
+    int (*set_priority_grouping)(unsigned int subpriority_bits);
 };
 
 /*!
@@ -189,6 +233,17 @@ struct fwk_arch_mm_data {
 
     /*! Size of the memory area used for dynamic memory allocation */
     size_t size;
+
+    /*!
+     * \brief Base address of the hot memory area.
+     *
+     * \details Optional area of fast memory used by \ref fwk_mm_alloc_hot().
+     *      Left equal to zero if there is no such area.
+     */
+    uintptr_t hot_start;
+
+    /*! Size of the hot memory area */
+    size_t hot_size;
 };
 
 /*!
@@ -227,6 +282,32 @@ struct fwk_arch_init_driver {
      * \retval FWK_E_PANIC Unrecoverable initialization error.
      */
     int (*interrupt)(struct fwk_arch_interrupt_driver **driver);
+
+    /*!
+     * \brief Get a timestamp.
+     *
+     * \details This handler is used by the framework to measure the time
+     *      spent processing events when the firmware is built with event
+     *      profiling support, in which case it is mandatory. The timestamp
+     *      is a free-running counter that is allowed to wrap around.
+     *
+     * \return Current value of the timestamp counter.
+     */
+    uint32_t (*timestamp)(void);
+
+    /*!
+     * \brief Wait for an interrupt in a low-power state.
+     *
+     * \details This handler is used by the single-thread framework when there
+     *      is no event left to process. It is called with the interrupts
+     *      globally disabled and must return, with the interrupts still
+     *      disabled, once an interrupt is pending. The pending interrupt is
+     *      serviced when the framework enables the interrupts again.
+     *
+     * \note May be NULL, in which case the framework busy-waits for events
+     *      raised by interrupt service routines.
+     */
+    void (*idle)(void);
 };
 
 /*!
@@ -241,6 +322,30 @@ struct fwk_arch_init_driver {
  */
 int fwk_arch_init(const struct fwk_arch_init_driver *driver);
 
+/*!
+ * \brief Resume the framework library from its retained state.
+ *
+ * \details Called by the architecture layer, instead of \ref fwk_arch_init(),
+ *      when the SCP wakes up from a low-power state in which the memory of the
+ *      firmware was retained, including the data and zero-initialized data
+ *      sections and the heap. The architecture layer restores the state of
+ *      the processor and of the interrupt controller beforehand, then the
+ *      modules are resumed in the order of the module table (see
+ *      \ref fwk_module.resume) before the events are processed again.
+ *
+ *      The SCP must have entered the low-power state from the idle handler of
+ *      the framework, with no event left to process. Only the single-thread
+ *      framework can be resumed.
+ *
+ * \retval FWK_SUCCESS Operation succeeded.
+ * \retval FWK_E_STATE The framework was not initialized, for instance because
+ *      the memory was lost, and the firmware has to boot again.
+ * \retval FWK_E_SUPPORT A module of the firmware is not retainable, and the
+ *      firmware has to boot again.
+ * \retval FWK_E_PANIC Unrecoverable resume error.
+ */
+int fwk_arch_resume(void);
+
 /*!
  * @}
  */
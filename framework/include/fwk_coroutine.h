@@ -0,0 +1,206 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Resumable event handlers.
+ */
+
+#ifndef FWK_COROUTINE_H
+#define FWK_COROUTINE_H
+
+#include <stdbool.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+
+/*!
+ * \ingroup GroupLibFramework
+ * \defgroup GroupCoroutine Resumable Event Handlers
+ *
+ * \details A resumable event handler implements a flow spanning several
+ *      events as straight-line code rather than as a hand-written state
+ *      machine. The handler returns \ref FWK_PENDING where it waits for an
+ *      event, and is called again with each event the module receives until
+ *      the awaited one arrives, at which point it resumes where it left off.
+ *      A single event loop is thus never blocked, and no RTOS is needed.
+ *
+ *      Handlers are stackless: only the resumption point is saved, local
+ *      variables do not keep their value across the waits and the state of
+ *      the flow must be kept in the context of the module. At most one wait
+ *      macro may appear on a given source line, and the waits cannot be
+ *      placed within a \c switch statement of the handler.
+ *
+ *      Example usage:
+ *      \code{.c}
+ *      static int suspend_flow(struct fwk_coroutine *co,
+ *                              const struct fwk_event *event)
+ *      {
+ *          FWK_COROUTINE_BEGIN(co);
+ *
+ *          status = put_event_to_driver(REQUEST_EVENT_ID);
+ *          if (status != FWK_SUCCESS)
+ *              FWK_COROUTINE_EXIT(co, status);
+ *
+ *          FWK_COROUTINE_WAIT_RESPONSE(co, event, REQUEST_EVENT_ID);
+ *
+ *          status = start_alarm(TIMEOUT_EVENT_ID);
+ *          if (status != FWK_SUCCESS)
+ *              FWK_COROUTINE_EXIT(co, status);
+ *
+ *          FWK_COROUTINE_WAIT_EVENT(co, event, TIMEOUT_EVENT_ID);
+ *
+ *          FWK_COROUTINE_END(co);
+ *      }
+ *      \endcode
+ *
+ * @{
+ */
+
+/*!
+ * \brief Resumable event handler state.
+ */
+struct fwk_coroutine {
+    /*! Resumption point, zero when the handler is not running */
+    unsigned int resume_point;
+
+    /*! Identifier of the awaited event */
+    fwk_id_t event_id;
+};
+
+/*!
+ * \brief Reset a resumable event handler so that it is run from the start
+ *      when next called.
+ *
+ * \param co Handler state.
+ */
+static inline void fwk_coroutine_reset(struct fwk_coroutine *co)
+{
+    co->resume_point = 0;
+}
+
+/*!
+ * \brief Check whether a resumable event handler is waiting for an event.
+ *
+ * \param co Handler state.
+ *
+ * \retval true The handler has started and not completed.
+ * \retval false The handler is not running.
+ */
+static inline bool fwk_coroutine_is_running(const struct fwk_coroutine *co)
+{
+    return co->resume_point != 0;
+}
+
+/*!
+ * \brief Start the body of a resumable event handler.
+ *
+ * \param co Handler state.
+ */
+#define FWK_COROUTINE_BEGIN(co) \
+    switch ((co)->resume_point) { \
+    case 0:
+
+/*!
+ * \brief Terminate a resumable event handler with a status.
+ *
+ * \param co Handler state.
+ * \param status Status returned by the handler.
+ */
+#define FWK_COROUTINE_EXIT(co, status) \
+    do { \
+        (co)->resume_point = 0; \
+        return (status); \
+    } while (0)
+
+/*!
+ * \brief End the body of a resumable event handler, which returns
+ *      \ref FWK_SUCCESS.
+ *
+ * \param co Handler state.
+ */
+#define FWK_COROUTINE_END(co) \
+    } \
+    FWK_COROUTINE_EXIT(co, FWK_SUCCESS)
+
+/*!
+ * \brief Return \ref FWK_PENDING and resume with the next call.
+ *
+ * \param co Handler state.
+ */
+#define FWK_COROUTINE_YIELD(co) \
+    do { \
+        (co)->resume_point = __LINE__; \
+        return FWK_PENDING; \
+    case __LINE__: \
+        ; \
+    } while (0)
+
+/*!
+ * \brief Return \ref FWK_PENDING until a condition is true.
+ *
+ * \details The condition is checked before waiting, and again with each call.
+ *
+ * \param co Handler state.
+ * \param cond Condition.
+ */
+#define FWK_COROUTINE_WAIT_UNTIL(co, cond) \
+    do { \
+        (co)->resume_point = __LINE__; \
+        if (false) { \
+    case __LINE__: \
+            ; \
+        } \
+        if (!(cond)) \
+            return FWK_PENDING; \
+    } while (0)
+
+/*!
+ * \brief Return \ref FWK_PENDING until an event, other than the one being
+ *      processed, is received.
+ *
+ * \details Used to wait for the events put by interrupt handlers, alarm
+ *      callbacks for instance, or for notifications.
+ *
+ * \param co Handler state.
+ * \param event Event the handler is called with.
+ * \param awaited_id Identifier of the awaited event.
+ */
+#define FWK_COROUTINE_WAIT_EVENT(co, event, awaited_id) \
+    do { \
+        (co)->event_id = (awaited_id); \
+        (co)->resume_point = __LINE__; \
+        return FWK_PENDING; \
+    case __LINE__: \
+        if (!fwk_id_is_equal((event)->id, (co)->event_id)) \
+            return FWK_PENDING; \
+    } while (0)
+
+/*!
+ * \brief Return \ref FWK_PENDING until the response to an event is received.
+ *
+ * \details The response may be an immediate or a delayed response.
+ *
+ * \param co Handler state.
+ * \param event Event the handler is called with.
+ * \param awaited_id Identifier of the event the response of which is
+ *      awaited.
+ */
+#define FWK_COROUTINE_WAIT_RESPONSE(co, event, awaited_id) \
+    do { \
+        (co)->event_id = (awaited_id); \
+        (co)->resume_point = __LINE__; \
+        return FWK_PENDING; \
+    case __LINE__: \
+        if (!(event)->is_response || \
+            !fwk_id_is_equal((event)->id, (co)->event_id)) \
+            return FWK_PENDING; \
+    } while (0)
+
+/*!
+ * @}
+ */
+
+#endif /* FWK_COROUTINE_H */
@@ -11,6 +11,7 @@
 #ifndef FWK_DLIST_H
 #define FWK_DLIST_H
 
+#include <stdbool.h>
 #include <fwk_slist.h>
 
 /*!
@@ -105,6 +106,41 @@ void __fwk_dlist_insert(
     struct fwk_dlist_node *restrict new,
     struct fwk_dlist_node *restrict node);
 
+/*
+ * Insert a node into a sorted doubly-linked list.
+ *
+ * For internal use only.
+ * See fwk_list_insert_sorted(list, new, hint, is_before) for the public
+ * interface.
+ */
+void __fwk_dlist_insert_sorted(
+    struct fwk_dlist *list,
+    struct fwk_dlist_node *restrict new,
+    struct fwk_dlist_node *restrict hint,
+    bool (*is_before)(const struct fwk_dlist_node *node,
+                      const struct fwk_dlist_node *other));
+
+/*
+ * Move all the nodes of a doubly-linked list to the end of another one.
+ *
+ * For internal use only.
+ * See fwk_list_splice(list, other) for the public interface.
+ */
+void __fwk_dlist_splice(
+    struct fwk_dlist *list,
+    struct fwk_dlist *other);
+
+/*
+ * Move nodes from the head of a doubly-linked list to the end of another one.
+ *
+ * For internal use only.
+ * See fwk_list_pop_head_n(list, other, count) for the public interface.
+ */
+unsigned int __fwk_dlist_pop_head_n(
+    struct fwk_dlist *list,
+    struct fwk_dlist *other,
+    unsigned int count);
+
 /*!
  * @endcond
  */
@@ -24,6 +24,9 @@
 /*! Success */
 #define FWK_SUCCESS          0
 
+/*! Request accepted, its completion is reported later */
+#define FWK_PENDING          1
+
 /*! Invalid parameter(s) */
 #define FWK_E_PARAM         -1
 
@@ -34,6 +34,30 @@
  */
 #define FWK_EVENT_PARAMETERS_SIZE 16
 
+/*!
+ * \brief Event priority classes.
+ *
+ * \details Events of a higher priority class are always processed before
+ *      events of a lower priority class. Events of the same class are
+ *      processed in the order they were queued.
+ */
+enum fwk_event_priority {
+    /*! Default priority class */
+    FWK_EVENT_PRIORITY_NORMAL,
+
+    /*!
+     * \brief Latency-critical events.
+     *
+     * \details Such events are dispatched after the event being processed, if
+     *      any, completes, without waiting for the queued events of lower
+     *      priority.
+     */
+    FWK_EVENT_PRIORITY_HIGH,
+
+    /*! Number of event priority classes */
+    FWK_EVENT_PRIORITY_COUNT
+};
+
 /*!
  * \brief Event.
  *
@@ -75,6 +99,21 @@ struct fwk_event {
      */
     bool is_delayed_response;
 
+    /*!
+     * \brief Flag indicating whether the event supersedes the events queued
+     *      earlier with the same source, target and identifier.
+     *
+     * \details Used for the requests that lose their value once a newer one
+     *      is queued, a performance level request for instance. The superseded
+     *      events that have not been dispatched yet are dropped when the event
+     *      is queued, provided they were queued with this flag set too. An
+     *      event put from a thread does not supersede the events put by ISRs
+     *      that are still waiting to be moved to the event queues of the
+     *      framework. Not supported for responses, notifications and events
+     *      requiring a response.
+     */
+    bool supersedes;
+
     /*!
      * \internal
      * \brief Flag indicating whether the event is a response event that a
@@ -82,6 +121,23 @@ struct fwk_event {
      */
     bool is_thread_wakeup_event;
 
+    /*!
+     * \internal
+     * \brief Flag indicating whether the event is a notification delivered to
+     *      several targets, the target identifier being set by the framework
+     *      for each of them.
+     */
+    bool is_multicast;
+
+    /*!
+     * \brief Priority class of the event.
+     *
+     * \details Responses built by the framework inherit the priority class of
+     *      the event they respond to. Only honoured by the single-threaded
+     *      framework.
+     */
+    enum fwk_event_priority priority;
+
     /*!
      * \brief Event identifier.
      *
@@ -91,6 +147,13 @@ struct fwk_event {
      */
     fwk_id_t id;
 
+    /*!
+     * \internal
+     * \brief Timestamp of the queuing of the event, set by the framework when
+     *      the firmware is built with event profiling support.
+     */
+    uint32_t queue_timestamp;
+
     /*! Table of event parameters */
     alignas(max_align_t) uint8_t params[FWK_EVENT_PARAMETERS_SIZE];
 };
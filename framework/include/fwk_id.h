@@ -14,6 +14,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <internal/fwk_id.h>
+#include <fwk_assert.h>
 #include <fwk_errno.h>
 
 /*!
@@ -395,9 +396,30 @@ enum fwk_id_type {
 
 /*!
  * \brief Generic identifier.
+ *
+ * \details An identifier is packed into a single 32-bit word. With the
+ *      supported toolchains, the four least significant bits hold the
+ *      identifier type and the following eight bits the module index. The remaining bits depend on the type:
+ *      - Element: 12-bit element index.
+ *      - Sub-element: 12-bit element index followed by an 8-bit sub-element
+ *        index.
+ *      - API: 4-bit API index.
+ *      - Event: 6-bit event index.
+ *      - Notification: 6-bit notification index.
+ *
+ *      Unused bits are zero, so two identifiers refer to the same entity if and
+ *      only if their words are equal. The functions below are defined in this
+ *      header so that comparisons and index extractions compile to a few
+ *      instructions at the call site. Their argument checks are assertions,
+ *      which are removed from release builds.
+ *
+ * \note Identifiers should be passed by value.
  */
 typedef union __fwk_id fwk_id_t;
 
+static_assert(sizeof(fwk_id_t) == sizeof(uint32_t),
+    "fwk_id_t has invalid size");
+
 /*!
  * \brief Check if the identifier is of a certain identifier type.
  *
@@ -407,7 +429,13 @@ typedef union __fwk_id fwk_id_t;
  * \retval true The identifier is of the type specified.
  * \retval false The identifier is not of the type specified.
  */
-bool fwk_id_is_type(fwk_id_t id, enum fwk_id_type type);
+static inline bool fwk_id_is_type(fwk_id_t id, enum fwk_id_type type)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return id.common.type == type;
+}
 
 /*!
  * \brief Retrieve the type of an identifier.
@@ -416,7 +444,13 @@ bool fwk_id_is_type(fwk_id_t id, enum fwk_id_type type);
  *
  * \return Identifier type.
  */
-enum fwk_id_type fwk_id_get_type(fwk_id_t id);
+static inline enum fwk_id_type fwk_id_get_type(fwk_id_t id)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return id.common.type;
+}
 
 /*!
  * \brief Check if two identifiers refer to the same entity.
@@ -427,7 +461,13 @@ enum fwk_id_type fwk_id_get_type(fwk_id_t id);
  * \retval true The identifiers refer to the same entity.
  * \retval false The identifiers do not refer to the same entity.
  */
-bool fwk_id_is_equal(fwk_id_t left, fwk_id_t right);
+static inline bool fwk_id_is_equal(fwk_id_t left, fwk_id_t right)
+{
+    assert(left.common.type != __FWK_ID_TYPE_INVALID);
+    assert(left.common.type < __FWK_ID_TYPE_COUNT);
+
+    return left.value == right.value;
+}
 
 /*!
  * \brief Retrieve the identifier of the module that owns a given identifier.
@@ -439,7 +479,13 @@ bool fwk_id_is_equal(fwk_id_t left, fwk_id_t right);
  *
  * \return Identifier of the owning module.
  */
-fwk_id_t fwk_id_build_module_id(fwk_id_t id);
+static inline fwk_id_t fwk_id_build_module_id(fwk_id_t id)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return FWK_ID_MODULE(id.common.module_idx);
+}
 
 /*!
  * \brief Retrieve the identifier of an element for a given identifier and
@@ -458,7 +504,13 @@ fwk_id_t fwk_id_build_module_id(fwk_id_t id);
  *
  * \return Element identifier associated with the element index for the module.
  */
-fwk_id_t fwk_id_build_element_id(fwk_id_t id, unsigned int element_idx);
+static inline fwk_id_t fwk_id_build_element_id(fwk_id_t id, unsigned int element_idx)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return FWK_ID_ELEMENT(id.common.module_idx, element_idx);
+}
 
 /*!
  * \brief Retrieve the identifier of an API for a given identifier and
@@ -477,7 +529,13 @@ fwk_id_t fwk_id_build_element_id(fwk_id_t id, unsigned int element_idx);
  *
  * \return API identifier associated with the API index for the module.
  */
-fwk_id_t fwk_id_build_api_id(fwk_id_t id, unsigned int api_idx);
+static inline fwk_id_t fwk_id_build_api_id(fwk_id_t id, unsigned int api_idx)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return FWK_ID_API(id.common.module_idx, api_idx);
+}
 
 /*!
  * \brief Retrieve the module index of an identifier.
@@ -486,7 +544,13 @@ fwk_id_t fwk_id_build_api_id(fwk_id_t id, unsigned int api_idx);
  *
  * \return Module index.
  */
-unsigned int fwk_id_get_module_idx(fwk_id_t id);
+static inline unsigned int fwk_id_get_module_idx(fwk_id_t id)
+{
+    assert(id.common.type != __FWK_ID_TYPE_INVALID);
+    assert(id.common.type < __FWK_ID_TYPE_COUNT);
+
+    return id.common.module_idx;
+}
 
 /*!
  * \brief Retrieve the index of an element from its identifier or the identifier
@@ -496,7 +560,13 @@ unsigned int fwk_id_get_module_idx(fwk_id_t id);
  *
  * \return Element index.
  */
-unsigned int fwk_id_get_element_idx(fwk_id_t element_id);
+static inline unsigned int fwk_id_get_element_idx(fwk_id_t element_id)
+{
+    assert((element_id.common.type == __FWK_ID_TYPE_ELEMENT) ||
+           (element_id.common.type == __FWK_ID_TYPE_SUB_ELEMENT));
+
+    return element_id.element.element_idx;
+}
 
 /*!
  * \brief Retrieve the index of a sub-element from its identifier.
@@ -505,7 +575,12 @@ unsigned int fwk_id_get_element_idx(fwk_id_t element_id);
  *
  * \return Sub-element index.
  */
-unsigned int fwk_id_get_sub_element_idx(fwk_id_t sub_element_id);
+static inline unsigned int fwk_id_get_sub_element_idx(fwk_id_t sub_element_id)
+{
+    assert(sub_element_id.common.type == __FWK_ID_TYPE_SUB_ELEMENT);
+
+    return sub_element_id.sub_element.sub_element_idx;
+}
 
 /*!
  * \brief Retrieve the index of an API from its identifier.
@@ -514,7 +589,12 @@ unsigned int fwk_id_get_sub_element_idx(fwk_id_t sub_element_id);
  *
  * \return API index.
  */
-unsigned int fwk_id_get_api_idx(fwk_id_t api_id);
+static inline unsigned int fwk_id_get_api_idx(fwk_id_t api_id)
+{
+    assert(api_id.common.type == __FWK_ID_TYPE_API);
+
+    return api_id.api.api_idx;
+}
 
 /*!
  * \brief Retrieve the index of an event from its identifier.
@@ -523,7 +603,12 @@ unsigned int fwk_id_get_api_idx(fwk_id_t api_id);
  *
  * \return Event index.
  */
-unsigned int fwk_id_get_event_idx(fwk_id_t event_id);
+static inline unsigned int fwk_id_get_event_idx(fwk_id_t event_id)
+{
+    assert(event_id.common.type == __FWK_ID_TYPE_EVENT);
+
+    return event_id.event.event_idx;
+}
 
 /*!
  * \brief Retrieve the index of a notification from its identifier.
@@ -532,7 +617,12 @@ unsigned int fwk_id_get_event_idx(fwk_id_t event_id);
  *
  * \return Notification index.
  */
-unsigned int fwk_id_get_notification_idx(fwk_id_t notification_id);
+static inline unsigned int fwk_id_get_notification_idx(fwk_id_t notification_id)
+{
+    assert(notification_id.common.type == __FWK_ID_TYPE_NOTIFICATION);
+
+    return notification_id.notification.notification_idx;
+}
 
 /*!
  * @}
@@ -143,6 +143,10 @@ int fwk_interrupt_clear_pending(unsigned int interrupt);
 /*!
  * \brief Assign an interrupt service routine to an interrupt.
  *
+ * \note On Arm Cortex-M, the interrupt service routine is installed directly
+ *      into the vector table, which is located in RAM. This is the path with
+ *      the lowest latency.
+ *
  * \param interrupt Interrupt number. This function accepts FWK_INTERRUPT_NMI as
  *      an interrupt number.
  * \param isr Pointer to the interrupt service routine function.
@@ -157,6 +161,14 @@ int fwk_interrupt_set_isr(unsigned int interrupt, void (*isr)(void));
  * \brief Assign an interrupt service routine that receives a parameter to an
  *     interrupt.
  *
+ * \note On Arm Cortex-M, the interrupt is dispatched by a common handler that
+ *      loads the routine and its parameter from a table indexed by the active
+ *      exception number. A latency-critical interrupt whose parameter is known
+ *      when the firmware is built, or that has a single instance, can instead
+ *      be given a routine without a parameter through
+ *      \ref fwk_interrupt_set_isr(), such that it is entered directly from the
+ *      vector table.
+ *
  * \param interrupt Interrupt number. This function accepts FWK_INTERRUPT_NMI as
  *      an interrupt number.
  * \param isr Pointer to the interrupt service routine function.
@@ -170,6 +182,78 @@ int fwk_interrupt_set_isr_param(unsigned int interrupt,
                                 void (*isr)(uintptr_t param),
                                 uintptr_t param);
 
+/*!
+ * \brief Set the priority of an interrupt.
+ *
+ * \details An interrupt preempts the interrupt service routines of the
+ *      interrupts of lower preemption priority (see
+ *      \ref fwk_interrupt_set_priority_grouping()). The interrupts all have the
+ *      highest priority until they are given another one, and the number of
+ *      priorities depends on the interrupt controller.
+ *
+ * \note In a multi-threaded firmware, the interrupt service routines putting
+ *      events queue them in the same way whatever their priority, the events
+ *      being processed by the threads in the order of their own priorities.
+ *
+ * \param interrupt Interrupt number.
+ * \param priority Priority of the interrupt, \c 0 being the highest.
+ *
+ * \retval FWK_SUCCESS Operation succeeded.
+ * \retval FWK_E_PARAM One or more parameters were invalid.
+ * \retval FWK_E_RANGE The priority is not implemented.
+ * \retval FWK_E_INIT The component has not been initialized.
+ * \retval FWK_E_SUPPORT The interrupt priorities are not supported.
+ */
+int fwk_interrupt_set_priority(unsigned int interrupt, unsigned int priority);
+
+/*!
+ * \brief Set the split of the priorities between preemption priority and
+ *      subpriority.
+ *
+ * \details The least significant bits of the priorities are subpriority bits.
+ *      They only order the pending interrupts of the same preemption priority,
+ *      set by the other bits, without letting one of them preempt the others.
+ *      By default, all the bits set the preemption of the interrupts.
+ *
+ * \note In a multi-threaded firmware, the grouping must be set before the
+ *      threads are started, during the initialization of the modules.
+ *
+ * \param subpriority_bits Number of subpriority bits.
+ *
+ * \retval FWK_SUCCESS Operation succeeded.
+ * \retval FWK_E_RANGE The number of bits is not supported.
+ * \retval FWK_E_INIT The component has not been initialized.
+ * \retval FWK_E_SUPPORT The interrupt priorities are not supported.
+ */
+int fwk_interrupt_set_priority_grouping(unsigned int subpriority_bits);
+
+/*!
+ * \brief Interrupt tracing statistics.
+ */
+struct fwk_interrupt_trace_stats {
+    /*! Number of times the interrupt service routine has been called */
+    uint32_t count;
+
+    /*!
+     * \brief Longest execution time of the interrupt service routine.
+     *
+     * \details The duration is expressed in ticks of the counter used by the
+     *      architecture layer, and includes the time spent in the interrupt
+     *      service routines of the higher priority interrupts that preempted
+     *      it.
+     */
+    uint32_t max_duration;
+
+    /*!
+     * \brief Deepest interrupt nesting level the interrupt service routine
+     *      has been called at.
+     *
+     * \details The level is \c 1 when no other interrupt service routine was
+     *      being processed.
+     */
+    uint32_t max_nesting;
+};
+
 /*!
  * \brief Get the interrupt number for the interrupt service routine being
  *      processed.
@@ -187,6 +271,21 @@ int fwk_interrupt_set_isr_param(unsigned int interrupt,
  */
 int fwk_interrupt_get_current(unsigned int *interrupt);
 
+/*!
+ * \brief Get the tracing statistics of an interrupt.
+ *
+ * \param interrupt Interrupt number.
+ * \param [out] stats Tracing statistics of the interrupt.
+ *
+ * \retval FWK_SUCCESS Operation succeeded.
+ * \retval FWK_E_PARAM One or more parameters were invalid.
+ * \retval FWK_E_INIT The component has not been initialized.
+ * \retval FWK_E_SUPPORT The architecture layer does not trace the
+ *      interrupts.
+ */
+int fwk_interrupt_get_trace_stats(unsigned int interrupt,
+                                  struct fwk_interrupt_trace_stats *stats);
+
 /*!
  * @}
  */
@@ -131,6 +131,47 @@
         struct fwk_dlist * : __fwk_dlist_pop_head \
     )(list)
 
+/*!
+ * \brief Move all the nodes of a linked list to the end of another linked
+ *      list.
+ *
+ * \details The operation takes a constant time whatever the number of nodes to
+ *      move. The order of the moved nodes is preserved and \p other is left
+ *      empty.
+ *
+ * \param list Pointer to the list to add the nodes to. Must not be \c NULL.
+ * \param other Pointer to the list to move the nodes from. Must not be \c NULL
+ *      and must be different from \p list.
+ *
+ * \return None.
+ */
+#define fwk_list_splice(list, other) \
+    _Generic((list), \
+        struct fwk_slist * : __fwk_slist_splice, \
+        struct fwk_dlist * : __fwk_dlist_splice \
+    )(list, other)
+
+/*!
+ * \brief Move nodes from the head of a linked list to the end of another
+ *      linked list.
+ *
+ * \details The nodes are walked once to find the last node to move and are
+ *      then moved together. The order of the moved nodes is preserved.
+ *
+ * \param list Pointer to the list to move the nodes from. Must not be \c NULL.
+ * \param other Pointer to the list to add the nodes to. Must not be \c NULL
+ *      and must be different from \p list.
+ * \param count Maximum number of nodes to move.
+ *
+ * \return The number of nodes moved, which is lower than \p count when
+ *      \p list holds fewer than \p count nodes.
+ */
+#define fwk_list_pop_head_n(list, other, count) \
+    _Generic((list), \
+        struct fwk_slist * : __fwk_slist_pop_head_n, \
+        struct fwk_dlist * : __fwk_dlist_pop_head_n \
+    )(list, other, count)
+
 /*!
  * \brief Get the next node of a linked list.
  *
@@ -184,6 +225,32 @@
         struct fwk_dlist * : __fwk_dlist_insert \
     )(list, new, node)
 
+/*!
+ * \brief Insert a node into a sorted linked list.
+ *
+ * \details The search for the position of the new node starts from \p hint,
+ *      backwards or forwards as needed, so a hint close to the final position,
+ *      such as the node inserted last into a list of timestamps, keeps the
+ *      search short. The new node is inserted after the nodes it does not
+ *      belong before, so nodes that compare equal keep their insertion order.
+ *
+ * \param list Pointer to the list, sorted according to \p is_before. Must not
+ *      be \c NULL.
+ * \param new Pointer to the node to insert. Must not be \c NULL. In debug mode,
+ *      the node links must be \c NULL as they are checked to ensure the node is
+ *      not already in use.
+ * \param hint Pointer to the node of the list to start the search from. If this
+ *      is \c NULL then the search starts from the head of the list.
+ * \param is_before Pointer to the function telling whether the node
+ *      \p node belongs before the node \p other. Must not be \c NULL.
+ *
+ * \return None.
+ */
+#define fwk_list_insert_sorted(list, new, hint, is_before) \
+    _Generic((list), \
+        struct fwk_dlist * : __fwk_dlist_insert_sorted \
+    )(list, new, hint, is_before)
+
 /*!
  * \brief Check if a node is in a list.
  *
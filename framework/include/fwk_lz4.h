@@ -0,0 +1,89 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_LZ4_H
+#define FWK_LZ4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupLibFramework
+ * \defgroup GroupLz4 LZ4 Decompression
+ *
+ * \details Decoder of the LZ4 block format, used to load the compressed
+ *      firmware images produced by the build system (see
+ *      \ref section_compressed_image).
+ *
+ * @{
+ */
+
+/*! Signature of a compressed image, "LZ4I" in memory */
+#define FWK_LZ4_IMAGE_SIGNATURE UINT32_C(0x49345A4C)
+
+/*!
+ * \brief Header of a compressed image.
+ *
+ * \details The header is followed by the LZ4 block holding the image.
+ */
+struct fwk_lz4_image_header {
+    /*! Signature, \ref FWK_LZ4_IMAGE_SIGNATURE */
+    uint32_t signature;
+
+    /*! Size in bytes of the uncompressed image */
+    uint32_t size;
+
+    /*! Size in bytes of the LZ4 block */
+    uint32_t compressed_size;
+};
+
+/*!
+ * \brief Decompress an LZ4 block.
+ *
+ * \details The block is decoded in a single pass, each sequence being written
+ *      to the destination as soon as it is read from the source.
+ *
+ * \param destination Destination buffer.
+ * \param destination_size Size in bytes of the destination buffer.
+ * \param source LZ4 block.
+ * \param source_size Size in bytes of the LZ4 block.
+ * \param[out] size Size in bytes of the decompressed data.
+ *
+ * \retval FWK_SUCCESS The block was decompressed.
+ * \retval FWK_E_PARAM A pointer parameter is NULL.
+ * \retval FWK_E_DATA The block is malformed.
+ * \retval FWK_E_NOMEM The decompressed data does not fit in the destination
+ *      buffer.
+ */
+int fwk_lz4_decompress(void *destination, size_t destination_size,
+                       const void *source, size_t source_size, size_t *size);
+
+/*!
+ * \brief Load a firmware image, compressed or not.
+ *
+ * \details An image starting with a \ref fwk_lz4_image_header is decompressed,
+ *      any other image is copied as is.
+ *
+ * \param destination Destination buffer.
+ * \param destination_size Size in bytes of the destination buffer.
+ * \param source Image.
+ * \param source_size Size in bytes of the image.
+ * \param[out] size Size in bytes of the loaded image.
+ *
+ * \retval FWK_SUCCESS The image was loaded.
+ * \retval FWK_E_PARAM A pointer parameter is NULL.
+ * \retval FWK_E_DATA The image is compressed and malformed.
+ * \retval FWK_E_NOMEM The loaded image does not fit in the destination buffer.
+ */
+int fwk_lz4_load_image(void *destination, size_t destination_size,
+                       const void *source, size_t source_size, size_t *size);
+
+/*!
+ * @}
+ */
+
+#endif /* FWK_LZ4_H */
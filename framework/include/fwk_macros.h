@@ -190,6 +190,17 @@
                            ((BUILD_VERSION_MINOR & 0xff) << 16) | \
                             (BUILD_VERSION_PATCH & 0xffff))
 
+/*!
+ * \brief Mark a function as being on a hot path of the firmware.
+ *
+ * \details Hot functions are grouped in a section of their own. On products
+ *      defining a hot code memory, for instance an instruction tightly-coupled
+ *      memory, this section is copied to it at boot and the functions are
+ *      executed from there. Elsewhere, the functions stay with the rest of the
+ *      code.
+ */
+#define FWK_HOT __attribute__((section(".text.fwk_hot")))
+
 /*!
  * @}
  */
@@ -0,0 +1,84 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Device memory copy primitives.
+ */
+
+#ifndef FWK_MEM_H
+#define FWK_MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * @{
+ */
+
+/*!
+ * \defgroup GroupMem Device Memory Copies
+ *
+ * \details Copies to and from Device or Normal Non-cacheable memory, such as
+ *      the shared memories of the mailboxes and the memories of the other
+ *      processors of the system. Unlike the functions of the C library linked
+ *      against the firmware, which may copy byte by byte or assume that
+ *      unaligned accesses are supported, the functions only make aligned word
+ *      accesses, by bursts of four words which the compiler can merge into
+ *      load and store multiple instructions, and byte accesses at the edges
+ *      of the areas.
+ *
+ *      The modules copying large areas through a DMA engine, such as the
+ *      bootloader, use the functions when no DMA engine is available.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Copy an area.
+ *
+ * \details The areas are copied word by word when their base addresses have
+ *      the same alignment, byte by byte otherwise.
+ *
+ * \param destination Base address of the destination area.
+ * \param source Base address of the source area, not overlapping with the
+ *      destination area.
+ * \param size Size in bytes of the area.
+ */
+void fwk_mem_copy(void *destination, const void *source, size_t size);
+
+/*!
+ * \brief Set an area to a value.
+ *
+ * \param destination Base address of the area.
+ * \param value Value of the bytes of the area.
+ * \param size Size in bytes of the area.
+ */
+void fwk_mem_set(void *destination, uint8_t value, size_t size);
+
+/*!
+ * \brief Copy an area to a memory which only supports word accesses.
+ *
+ * \details The destination area is written with word accesses only, the last
+ *      word being padded with zeros if the size is not a multiple of a word.
+ *      The source area may have any alignment.
+ *
+ * \param destination Base address of the destination area, aligned on a word.
+ * \param source Base address of the source area, not overlapping with the
+ *      destination area.
+ * \param size Size in bytes of the area.
+ */
+void fwk_mem_write_words(void *destination, const void *source, size_t size);
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* FWK_MEM_H */
@@ -12,6 +12,7 @@
 #define FWK_MM_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <fwk_align.h>
 
 /*!
@@ -83,6 +84,207 @@ void *fwk_mm_calloc(size_t num, size_t size);
  */
 void *fwk_mm_calloc_aligned(size_t num, size_t size, unsigned int alignment);
 
+/*!
+ * \brief Allocate a block of memory from the hot memory region.
+ *
+ * \details The hot memory region is an optional region of fast memory, for
+ *      instance a tightly-coupled memory, provided by the architecture layer.
+ *      It is intended for the structures accessed on the hot paths of the
+ *      firmware such as event pools and queues. The block is allocated from
+ *      the heap when there is no hot memory region or it is exhausted.
+ *
+ * \note Memory allocated by this function will be aligned by default on the
+ *      value defined by \ref FWK_MM_DEFAULT_ALIGNMENT.
+ *
+ * \param num Number of items.
+ * \param size Item size in bytes.
+ *
+ * \retval NULL Allocation failed.
+ * \return Pointer to a newly-allocated block of memory.
+ */
+void *fwk_mm_alloc_hot(size_t num, size_t size);
+
+/*!
+ * \brief Allocate a block of memory from the hot memory region and
+ *      initialize all its bits to zero.
+ *
+ * \details See \ref fwk_mm_alloc_hot().
+ *
+ * \param num Number of items.
+ * \param size Item size in bytes.
+ *
+ * \retval NULL Allocation failed.
+ * \return Pointer to a newly-allocated block of memory.
+ */
+void *fwk_mm_calloc_hot(size_t num, size_t size);
+
+/*!
+ * \brief Allocate a set of parallel tables from the hot memory region and
+ *      initialize all their bits to zero.
+ *
+ * \details The tables have the same number of entries, typically one per
+ *      element of a module, and are allocated one after the other in a single
+ *      block, each of them aligned on \ref FWK_MM_DEFAULT_ALIGNMENT. A module
+ *      keeping the fields of its elements accessed on its hot paths in such
+ *      tables rather than in its per-element contexts touches fewer cache
+ *      lines when it scans all its elements. The block is allocated as
+ *      described in \ref fwk_mm_alloc_hot().
+ *
+ * \param num Number of entries of each table.
+ * \param entry_size_table Table of the entry sizes in bytes of the tables.
+ * \param[out] table_table Table filled in with the addresses of the tables.
+ * \param table_count Number of tables.
+ *
+ * \retval FWK_SUCCESS The tables were allocated.
+ * \retval FWK_E_PARAM One or more parameters were invalid.
+ * \retval FWK_E_NOMEM The allocation failed.
+ * \return One of the standard framework error codes.
+ */
+int fwk_mm_calloc_hot_tables(size_t num, const size_t *entry_size_table,
+                             void **table_table, unsigned int table_count);
+
+/*!
+ * \brief Usage statistics of the heap.
+ */
+struct fwk_mm_stats {
+    /*! Size of the heap in bytes, including the hot memory region */
+    size_t size;
+
+    /*!
+     * \brief Number of bytes allocated, including the padding inserted to
+     *      align the allocations.
+     */
+    size_t used;
+
+    /*! Size of the hot memory region in bytes */
+    size_t hot_size;
+
+    /*! Number of bytes allocated from the hot memory region */
+    size_t hot_used;
+};
+
+/*!
+ * \brief Get the usage statistics of the heap.
+ *
+ * \note The number of bytes allocated by each module during the pre-runtime
+ *      phase is returned by \ref fwk_module_get_heap_usage().
+ *
+ * \param[out] stats Pointer to storage for the statistics.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_INIT The memory management component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p stats is equal to \c NULL.
+ */
+int fwk_mm_get_stats(struct fwk_mm_stats *stats);
+
+/*!
+ * \brief Fixed-size block pool.
+ *
+ * \details A pool is carved from the heap during the pre-runtime phase and
+ *      then provides constant-time allocation and release of blocks of a fixed
+ *      size, including from interrupt context. It is intended for the
+ *      structures whose number varies at runtime, whose storage would
+ *      otherwise have to be allocated for the worst case.
+ *
+ *      The fields of the structure are managed by the pool functions and must
+ *      not be accessed directly.
+ */
+struct fwk_mm_pool {
+    /*! \internal Head of the list of free blocks */
+    void *free_block;
+
+    /*! \internal Address of the first block */
+    uintptr_t start;
+
+    /*! \internal Size of a block in bytes, rounded up to their alignment */
+    size_t block_size;
+
+    /*! \internal Number of blocks */
+    unsigned int block_count;
+
+    /*! \internal Number of blocks in use */
+    unsigned int used;
+
+    /*! \internal Highest number of blocks in use at the same time */
+    unsigned int used_max;
+};
+
+/*!
+ * \brief Usage statistics of a pool.
+ */
+struct fwk_mm_pool_stats {
+    /*! Number of blocks in the pool */
+    unsigned int size;
+
+    /*! Number of blocks currently in use */
+    unsigned int used;
+
+    /*!
+     * \brief Highest number of blocks in use at the same time since the
+     *      initialization of the pool.
+     *
+     * \details This is the value to base the size of the pool on.
+     */
+    unsigned int used_max;
+};
+
+/*!
+ * \brief Initialize a pool, allocating its blocks from the heap.
+ *
+ * \note The blocks are aligned on the value defined by
+ *      \ref FWK_MM_DEFAULT_ALIGNMENT. As the heap, a pool can only be
+ *      initialized during the pre-runtime phase.
+ *
+ * \param[out] pool Pointer to the pool to initialize.
+ * \param block_count Number of blocks.
+ * \param block_size Block size in bytes.
+ *
+ * \retval FWK_SUCCESS The pool was initialized.
+ * \retval FWK_E_PARAM The pointer \p pool is equal to \c NULL.
+ * \retval FWK_E_PARAM The number of blocks or their size is equal to zero.
+ * \retval FWK_E_NOMEM The blocks could not be allocated.
+ */
+int fwk_mm_pool_init(struct fwk_mm_pool *pool, unsigned int block_count,
+                     size_t block_size);
+
+/*!
+ * \brief Allocate a block from a pool.
+ *
+ * \note This function can be called from interrupt context.
+ *
+ * \param pool Pointer to the pool.
+ *
+ * \retval NULL All the blocks of the pool are in use.
+ * \return Pointer to the allocated block.
+ */
+void *fwk_mm_pool_alloc(struct fwk_mm_pool *pool);
+
+/*!
+ * \brief Release a block to the pool it was allocated from.
+ *
+ * \note This function can be called from interrupt context.
+ *
+ * \param pool Pointer to the pool.
+ * \param block Pointer to the block.
+ *
+ * \retval FWK_SUCCESS The block was released.
+ * \retval FWK_E_PARAM The pointer \p pool is equal to \c NULL.
+ * \retval FWK_E_PARAM The pointer \p block is not a block of the pool.
+ */
+int fwk_mm_pool_free(struct fwk_mm_pool *pool, void *block);
+
+/*!
+ * \brief Get the usage statistics of a pool.
+ *
+ * \param pool Pointer to the pool.
+ * \param[out] stats Pointer to storage for the statistics.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_PARAM One of the parameters is equal to \c NULL.
+ */
+int fwk_mm_pool_get_stats(const struct fwk_mm_pool *pool,
+                          struct fwk_mm_pool_stats *stats);
+
 /*!
  * @}
  */
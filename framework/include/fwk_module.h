@@ -12,6 +12,7 @@
 #define FWK_MODULE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <fwk_element.h>
 #include <fwk_event.h>
@@ -82,11 +83,36 @@ struct fwk_module {
     /*! Number of events defined by the module */
     unsigned int event_count;
 
+    /*!
+     * \brief Number of event structures the module adds to the event pool of
+     *      the framework.
+     *
+     * \details Modules that may have a large number of events queued at the
+     *      same time, for instance one per element, declare it here so that the
+     *      event pool is sized accordingly. The framework event pool contains
+     *      a default number of event structures plus the sum of the numbers
+     *      declared by the modules of the firmware.
+     */
+    unsigned int event_pool_size;
+
     #ifdef BUILD_HAS_NOTIFICATION
     /*! Number of notifications defined by the module */
     unsigned int notification_count;
     #endif
 
+    /*!
+     * \brief The module supports the warm resume of the firmware.
+     *
+     * \details When the SCP wakes up from a low-power state in which the
+     *      memory of the firmware was retained, the framework resumes the
+     *      firmware from the retained state of the modules rather than booting
+     *      it again (see \ref fwk_arch_resume()). This is only possible if all
+     *      the modules of the firmware are retainable, the state of their
+     *      contexts staying valid across the low-power state of the SCP once
+     *      restored by their \ref resume function.
+     */
+    bool retainable;
+
     /*!
      * \brief Pointer to the module initialization function.
      *
@@ -210,6 +236,25 @@ struct fwk_module {
      */
     int (*start)(fwk_id_t id);
 
+    /*!
+     * \brief Pointer to the resume function.
+     *
+     * \details This function is called by the framework for the module and then
+     *      for all of its started elements when the firmware is resumed, in
+     *      place of the initialization, bind and start functions. It restores
+     *      the state lost while the SCP was powered down, for instance the
+     *      interrupts the module enabled when it started.
+     *
+     * \note This function is \b optional, and only called for retainable
+     *      modules.
+     *
+     * \param id Identifier of the module or element to resume.
+     *
+     * \retval FWK_SUCCESS The module or element was successfully resumed.
+     * \return One of the other module-defined error codes.
+     */
+    int (*resume)(fwk_id_t id);
+
     /*!
      * \brief Pointer to the bind request processing function.
      *
@@ -286,6 +331,40 @@ struct fwk_module {
                                 struct fwk_event *resp_event);
 };
 
+/*!
+ * \brief Highest thread priority a module can request in its configuration.
+ */
+#define FWK_MODULE_THREAD_PRIORITY_MAX 7
+
+/*!
+ * \brief Number of rounds of calls to the \ref fwk_module::bind function.
+ */
+#define FWK_MODULE_BIND_ROUND_COUNT 2
+
+/*!
+ * \brief Time spent by a module in the stages of the pre-runtime phase.
+ *
+ * \details The durations are expressed in ticks of the timestamp handler given
+ *      to the framework by the architecture layer. Each duration covers the
+ *      module and all its elements.
+ */
+struct fwk_module_boot_time {
+    /*! Time spent in the \ref fwk_module::init function */
+    uint32_t init;
+
+    /*! Time spent in the \ref fwk_module::element_init function */
+    uint32_t element_init;
+
+    /*! Time spent in the \ref fwk_module::post_init function */
+    uint32_t post_init;
+
+    /*! Time spent in the \ref fwk_module::bind function, per round */
+    uint32_t bind[FWK_MODULE_BIND_ROUND_COUNT];
+
+    /*! Time spent in the \ref fwk_module::start function */
+    uint32_t start;
+};
+
 /*!
  * \brief Module configuration.
  */
@@ -307,8 +386,55 @@ struct fwk_module_config {
      */
     const struct fwk_element *(*get_element_table)(fwk_id_t module_id);
 
+    /*!
+     * \brief Table of element descriptions.
+     *
+     * \details Used when \ref get_element_table is equal to NULL, for the
+     *      modules whose elements are fully described at build time. The
+     *      table ends with an invalid element description where the pointer to
+     *      the element name is equal to NULL. It need not be copied by the
+     *      module: along with a constant module configuration, it is kept in
+     *      read-only memory and is not built at runtime.
+     */
+    const struct fwk_element *elements;
+
     /*! Pointer to the module-specific configuration data */
     const void *data;
+
+    /*!
+     * \brief Priority of the threads created by the module and its elements.
+     *
+     * \details When several threads have an event ready to be processed, the
+     *      framework processes the events of the thread with the highest
+     *      priority first. Threads of the same priority are served in the
+     *      order they became ready. The priority ranges from 0, the default
+     *      and the priority of the common thread, to
+     *      \ref FWK_MODULE_THREAD_PRIORITY_MAX.
+     *
+     * \note Only used by multi-threaded firmware.
+     */
+    unsigned int thread_priority;
+
+    /*!
+     * \brief Size in bytes of the stack of the threads created by the module
+     *      and its elements.
+     *
+     * \details If equal to zero, the default stack size is used.
+     *
+     * \note Only used by multi-threaded firmware.
+     */
+    size_t thread_stack_size;
+
+    /*!
+     * \brief Flag indicating whether the start of the module is deferred.
+     *
+     * \details The module and its elements are not started during the start
+     *      stage of the pre-runtime phase but when the firmware calls
+     *      \ref fwk_module_start_deferred() during the runtime phase, for
+     *      instance once the application processors have been released. Until
+     *      then they remain in the \ref FWK_MODULE_STATE_BOUND state.
+     */
+    bool deferred_start;
 };
 
 /*!
@@ -404,6 +530,38 @@ int fwk_module_get_element_count(fwk_id_t module_id);
  */
 int fwk_module_get_sub_element_count(fwk_id_t element_id);
 
+/*!
+ * \brief Get the number of bytes of heap allocated for a module.
+ *
+ * \details The heap usage of a module covers the allocations made while the
+ *      module and its elements are initialized, bound and started, by the
+ *      module itself and by the framework for its contexts.
+ *
+ * \param module_id Identifier of the module.
+ * \param[out] size Number of bytes allocated for the module.
+ *
+ * \retval FWK_SUCCESS The heap usage was returned.
+ * \retval FWK_E_PARAM The identifier of the module is invalid.
+ * \retval FWK_E_PARAM The pointer \p size is equal to \c NULL.
+ */
+int fwk_module_get_heap_usage(fwk_id_t module_id, size_t *size);
+
+/*!
+ * \brief Get the time spent by a module in the stages of the pre-runtime
+ *      phase.
+ *
+ * \param module_id Identifier of the module.
+ * \param[out] time Time spent by the module in each stage.
+ *
+ * \retval FWK_SUCCESS The durations were returned.
+ * \retval FWK_E_PARAM The identifier of the module is invalid.
+ * \retval FWK_E_PARAM The pointer \p time is equal to \c NULL.
+ * \retval FWK_E_SUPPORT The firmware is built without event profiling
+ *      support, which provides the timestamp handler.
+ */
+int fwk_module_get_boot_time(fwk_id_t module_id,
+                             struct fwk_module_boot_time *time);
+
 /*!
  * \brief Get the name of a module or element.
  *
@@ -459,6 +617,20 @@ int fwk_module_check_call(fwk_id_t id);
  */
 int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api);
 
+/*!
+ * \brief Start the modules whose start has been deferred.
+ *
+ * \details The modules with the \ref fwk_module_config.deferred_start flag set
+ *      are started, together with their elements, in the order of the module
+ *      table. Modules already started are skipped, so the function may be
+ *      called more than once.
+ *
+ * \retval FWK_SUCCESS The deferred modules were started successfully.
+ * \retval FWK_E_STATE Call before the runtime phase.
+ * \return One of the error codes returned by the start functions.
+ */
+int fwk_module_start_deferred(void);
+
 /*!
  * @}
  */
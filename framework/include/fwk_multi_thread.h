@@ -8,6 +8,8 @@
 #ifndef FWK_MULTI_THREAD_H
 #define FWK_MULTI_THREAD_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_thread.h>
@@ -23,6 +25,29 @@
  * @{
  */
 
+/*!
+ * \brief Size in bytes of the guard below the stack of each thread.
+ *
+ * \details The guard is aligned on its size and is not part of the stack. A
+ *      platform may protect it from any access, for instance with an MPU
+ *      region, to catch the stack overflows.
+ */
+#define FWK_THREAD_STACK_GUARD_SIZE 32
+
+/*!
+ * \brief Thread stack description.
+ */
+struct fwk_thread_stack_info {
+    /*! Address of the guard just below the stack */
+    uintptr_t guard;
+
+    /*! Size of the stack in bytes, the guard excluded */
+    size_t size;
+
+    /*! Largest number of bytes of the stack used so far */
+    size_t max_used;
+};
+
 /*!
  * \brief Create a thread for a module or element
  *
@@ -66,6 +91,10 @@ int fwk_thread_create(fwk_id_t id);
  *      The event identifier and target identifier are validated and must
  *      belong to the same module.
  *
+ *      When the thread of the target has no event pending, the event is not
+ *      queued: it is processed straight away on the stack of the calling
+ *      thread, which must be sized accordingly.
+ *
  * \param event Event to put into the queue for processing. Must not be \c NULL.
  * \param[out] resp_event The response event. Must not be \c NULL.
  *
@@ -80,6 +109,28 @@ int fwk_thread_create(fwk_id_t id);
 int fwk_thread_put_event_and_wait(struct fwk_event *event,
                                   struct fwk_event *resp_event);
 
+/*!
+ * \brief Get the description of the stack of a thread.
+ *
+ * \details The threads are those created by the framework: the common thread
+ *      at index zero, followed by the threads created with
+ *      fwk_thread_create() in their order of creation.
+ *
+ *      The stacks are filled with a pattern when they are allocated. The
+ *      number of bytes used so far is the extent of the stack the pattern has
+ *      been overwritten in, which lets the stacks be sized from measurements.
+ *
+ * \param index Index of the thread.
+ * \param[out] info Description of the stack.
+ *
+ * \retval FWK_SUCCESS The description was returned.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p info is equal to \c NULL.
+ * \retval FWK_E_RANGE There is no thread of index \p index.
+ */
+int fwk_thread_get_stack_info(unsigned int index,
+                              struct fwk_thread_stack_info *info);
+
 /*!
  * @}
  */
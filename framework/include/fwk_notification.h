@@ -20,6 +20,18 @@
  * @{
  */
 
+/*!
+ * \brief Parameters of the responses to the notifications sent with
+ *      \ref fwk_notification_notify_collect().
+ *
+ * \details The response parameters of such notifications must start with
+ *      this structure.
+ */
+struct fwk_notification_resp_params {
+    /*! Status of the processing of the notification by the subscriber */
+    int status;
+};
+
 /*!
  * \brief Subscribe to a notification.
  *
@@ -74,6 +86,37 @@ int fwk_notification_unsubscribe(fwk_id_t notification_id, fwk_id_t source_id,
 int fwk_notification_notify(struct fwk_event *notification_event,
                             unsigned int *count);
 
+/*!
+ * \brief Send a notification to all entities that are subscribed to it and
+ *      collect their responses.
+ *
+ * \details The framework keeps track of the responses of the subscribers.
+ *      Only the last one is delivered to the notifier, as the completion of
+ *      the notification. Its status, see \ref fwk_notification_resp_params,
+ *      is the status of the first subscriber that failed to process the
+ *      notification, or \ref FWK_SUCCESS if all of them succeeded. Its other
+ *      parameters are those of the last response.
+ *
+ *      A single notification with a given identifier can be collected at a
+ *      time for a given source.
+ *
+ * \param notification_event Pointer to the notification event. Must not be
+ *      \c NULL. A response is requested from the subscribers.
+ * \param [out] count Number of notification events that were sent. Must not be
+ *      \c NULL. No completion is delivered if it is zero.
+ *
+ * \retval FWK_SUCCESS All subscribers were notified successfully.
+ * \retval FWK_E_INIT The notification component has not been initialized.
+ * \retval FWK_E_HANDLER The function was called from an interrupt handler.
+ * \retval FWK_E_PARAM One of more parameters were invalid.
+ * \retval FWK_E_STATE The responses to the same notification from the same
+ *      source are already being collected.
+ * \retval FWK_E_NOMEM The maximum number of notifications being collected has
+ *      been reached.
+ */
+int fwk_notification_notify_collect(struct fwk_event *notification_event,
+                                    unsigned int *count);
+
 /*!
  * @}
  */
@@ -101,6 +101,27 @@ void __fwk_slist_push_tail(
  */
 struct fwk_slist_node *__fwk_slist_pop_head(struct fwk_slist *list);
 
+/*
+ * Move all the nodes of a singly-linked list to the end of another one.
+ *
+ * For internal use only.
+ * See fwk_list_splice(list, other) for the public interface.
+ */
+void __fwk_slist_splice(
+    struct fwk_slist *list,
+    struct fwk_slist *other);
+
+/*
+ * Move nodes from the head of a singly-linked list to the end of another one.
+ *
+ * For internal use only.
+ * See fwk_list_pop_head_n(list, other, count) for the public interface.
+ */
+unsigned int __fwk_slist_pop_head_n(
+    struct fwk_slist *list,
+    struct fwk_slist *other,
+    unsigned int count);
+
 /*
  * Get the next node from a singly-linked list.
  *
@@ -11,7 +11,9 @@
 #ifndef FWK_THREAD_H
 #define FWK_THREAD_H
 
+#include <stdint.h>
 #include <fwk_event.h>
+#include <fwk_id.h>
 
 /*!
  * \addtogroup GroupLibFramework Framework
@@ -24,6 +26,75 @@
  * @{
  */
 
+/*!
+ * \brief Usage statistics of the framework event pool.
+ */
+struct fwk_thread_event_pool_stats {
+    /*! Number of event structures in the pool */
+    unsigned int size;
+
+    /*! Number of event structures currently in use */
+    unsigned int used;
+
+    /*!
+     * \brief Highest number of event structures in use at the same time since
+     *      the initialization of the framework.
+     *
+     * \details This is the value to base the size of the event pool on.
+     */
+    unsigned int used_max;
+};
+
+/*!
+ * \brief Number of bins of the event processing time histograms.
+ *
+ * \details The bin of index \c n counts the event dispatches which took from
+ *      16^n to 16^(n+1) - 1 timestamp ticks to process, apart from the first
+ *      bin which starts at zero and the last bin which has no upper bound.
+ */
+#define FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT 8
+
+/*!
+ * \brief Event processing statistics.
+ *
+ * \details Durations are expressed in ticks of the timestamp provided by the
+ *      architecture layer (see \ref fwk_arch_init_driver.timestamp).
+ */
+struct fwk_thread_profile_stats {
+    /*! Number of event dispatches */
+    unsigned int count;
+
+    /*! Cumulated processing time of the event dispatches */
+    uint64_t total;
+
+    /*! Longest processing time of an event dispatch */
+    uint32_t max;
+
+    /*! Histogram of the processing time of the event dispatches */
+    unsigned int histogram[FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT];
+};
+
+/*!
+ * \brief Processor load statistics.
+ *
+ * \details The processor is busy while the framework dispatches an event, and
+ *      idle otherwise. The load over a period is the difference between the
+ *      busy times of two samples divided by the difference between their
+ *      timestamps. The period must be shorter than the wrap around period of
+ *      the timestamp.
+ */
+struct fwk_thread_load_stats {
+    /*! Timestamp of the sample */
+    uint32_t timestamp;
+
+    /*!
+     * \brief Cumulated processing time of the event dispatches.
+     *
+     * \details The time is not cleared by \ref fwk_thread_reset_profile_stats.
+     */
+    uint64_t busy;
+};
+
 /*!
  * \brief Put an event in one of the event queues.
  *
@@ -60,6 +131,171 @@
  */
 int fwk_thread_put_event(struct fwk_event *event);
 
+/*!
+ * \brief Put several events at once.
+ *
+ * \details Used by the modules issuing a batch of events, to several targets
+ *      for instance. The event structures of the batch are taken from the
+ *      pool at once and the events are queued in the order of \p events.
+ *      Compared with calls of \ref fwk_thread_put_event, the calling context
+ *      is checked once and, when called from an ISR in a multi-threaded
+ *      firmware, the framework thread is woken up once for the whole batch.
+ *
+ *      Either all the events are queued, or none. The events are checked as
+ *      described in \ref fwk_thread_put_event, and responses cannot be put
+ *      this way.
+ *
+ * \param events Table of events to queue. Must not be \c NULL.
+ * \param count Number of events in \p events.
+ *
+ * \retval FWK_SUCCESS The events were queued.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p events is equal to \c NULL.
+ * \retval FWK_E_PARAM One or more fields of the events were invalid, or one of
+ *      the events is a response.
+ * \retval FWK_E_NOMEM There are not enough free event structures left.
+ * \retval FWK_E_OS Operating system error.
+ */
+int fwk_thread_put_events(struct fwk_event *events, unsigned int count);
+
+/*!
+ * \brief Reserve an event structure to be filled in place and queued with
+ *      \ref fwk_thread_commit_event.
+ *
+ * \details This avoids the copy of the event description performed by
+ *      \ref fwk_thread_put_event. The reserved event structure is cleared
+ *      before being returned. It must be handed back to the framework with
+ *      either \ref fwk_thread_commit_event or \ref fwk_thread_cancel_event.
+ *
+ * \param[out] event Pointer to storage for the pointer to the reserved event
+ *      structure. Must not be \c NULL.
+ *
+ * \retval FWK_SUCCESS An event structure was reserved.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p event is equal to \c NULL.
+ * \retval FWK_E_NOMEM There is no free event structure left.
+ */
+int fwk_thread_reserve_event(struct fwk_event **event);
+
+/*!
+ * \brief Queue an event reserved with \ref fwk_thread_reserve_event.
+ *
+ * \details The event is checked and queued as described in
+ *      \ref fwk_thread_put_event. The event structure belongs to the
+ *      framework again once the function has been called, whatever its
+ *      result.
+ *
+ * \param event Pointer to the reserved event. Must not be \c NULL.
+ *
+ * \retval FWK_SUCCESS The event was queued.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM One or more fields in the \p event parameter were
+ *      invalid.
+ * \retval FWK_E_OS Operating system error.
+ */
+int fwk_thread_commit_event(struct fwk_event *event);
+
+/*!
+ * \brief Give back an event reserved with \ref fwk_thread_reserve_event
+ *      without queuing it.
+ *
+ * \param event Pointer to the reserved event. Must not be \c NULL.
+ *
+ * \retval FWK_SUCCESS The event structure was released.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p event is equal to \c NULL.
+ */
+int fwk_thread_cancel_event(struct fwk_event *event);
+
+/*!
+ * \brief Get the usage statistics of the framework event pool.
+ *
+ * \param[out] stats Pointer to storage for the statistics. Must not be
+ *      \c NULL.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_INIT The thread framework component is not initialized.
+ * \retval FWK_E_PARAM The pointer \p stats is equal to \c NULL.
+ */
+int fwk_thread_get_event_pool_stats(struct fwk_thread_event_pool_stats *stats);
+
+/*!
+ * \brief Get the event processing statistics of a module, an event or a
+ *      notification.
+ *
+ * \details The statistics of a module cover all the events, responses and
+ *      notifications processed by the module. The statistics of an event or
+ *      notification identifier cover all the dispatches of the event, response
+ *      or notification with that identifier, whatever the module processing
+ *      it.
+ *
+ * \note Only available when the firmware is built with event profiling
+ *      support.
+ *
+ * \param id Module, event or notification identifier.
+ * \param[out] stats Pointer to storage for the statistics. Must not be
+ *      \c NULL.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_INIT The event profiling is not initialized.
+ * \retval FWK_E_PARAM The identifier \p id is not valid.
+ * \retval FWK_E_PARAM The pointer \p stats is equal to \c NULL.
+ */
+int fwk_thread_get_profile_stats(fwk_id_t id,
+                                 struct fwk_thread_profile_stats *stats);
+
+/*!
+ * \brief Get the queuing delay statistics of a module.
+ *
+ * \details The statistics cover the time spent by the events, responses and
+ *      notifications targeting the module between their queuing, in the event
+ *      queues of the framework or in the queues of the threads, and the
+ *      beginning of their processing. Compared with the processing time
+ *      returned by \ref fwk_thread_get_profile_stats, they tell the congestion
+ *      of the queues apart from slow event handlers.
+ *
+ * \note Only available when the firmware is built with event profiling
+ *      support.
+ *
+ * \param module_id Module identifier.
+ * \param[out] stats Pointer to storage for the statistics. Must not be
+ *      \c NULL.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_INIT The event profiling is not initialized.
+ * \retval FWK_E_PARAM The identifier \p module_id is not a valid module
+ *      identifier.
+ * \retval FWK_E_PARAM The pointer \p stats is equal to \c NULL.
+ */
+int fwk_thread_get_queue_stats(fwk_id_t module_id,
+                               struct fwk_thread_profile_stats *stats);
+
+/*!
+ * \brief Get the processor load statistics.
+ *
+ * \note Only available when the firmware is built with event profiling
+ *      support.
+ *
+ * \param[out] stats Pointer to storage for the statistics. Must not be
+ *      \c NULL.
+ *
+ * \retval FWK_SUCCESS The statistics were returned.
+ * \retval FWK_E_INIT The event profiling is not initialized.
+ * \retval FWK_E_PARAM The pointer \p stats is equal to \c NULL.
+ */
+int fwk_thread_get_load_stats(struct fwk_thread_load_stats *stats);
+
+/*!
+ * \brief Clear all the event processing and queuing delay statistics.
+ *
+ * \note Only available when the firmware is built with event profiling
+ *      support.
+ *
+ * \retval FWK_SUCCESS The statistics were cleared.
+ * \retval FWK_E_INIT The event profiling is not initialized.
+ */
+int fwk_thread_reset_profile_stats(void);
+
 /*!
  * \brief Get a copy of a delayed response event.
  *
@@ -88,6 +324,26 @@ int fwk_thread_put_event(struct fwk_event *event);
 int fwk_thread_get_delayed_response(fwk_id_t id, uint32_t cookie,
                                     struct fwk_event *event);
 
+/*!
+ * \brief Wait for an interrupt with the calling thread.
+ *
+ * \details In single-thread builds, the processor is put into a low-power
+ *      state by the idle handler of the architecture until an interrupt is
+ *      pending, or the function returns immediately if the architecture does
+ *      not provide an idle handler. In multi-thread builds, the calling thread
+ *      yields to the other threads ready to run.
+ *
+ *      The caller is expected to check the condition it waits for with the
+ *      interrupts globally disabled, then call this function and finally let
+ *      the pending interrupts be serviced by enabling the interrupts again. An
+ *      interrupt raised after the check is then not missed.
+ *
+ * \note The interrupts must be globally disabled by the caller, in a
+ *      non-nested critical section in multi-thread builds. They are disabled
+ *      when the function returns.
+ */
+void fwk_thread_wait_for_interrupt(void);
+
 /*!
  * @}
  */
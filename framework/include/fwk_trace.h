@@ -0,0 +1,143 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Trace points.
+ */
+
+#ifndef FWK_TRACE_H
+#define FWK_TRACE_H
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * @{
+ */
+
+/*!
+ * \defgroup GroupTrace Trace Points
+ *
+ * \details Trace points mark the activity of the firmware on a timeline. A
+ *      trace point passes a 16-bit trace identifier and a 32-bit value to the
+ *      trace driver, which timestamps them and exports them to the debug
+ *      tools.
+ *
+ *      The trace points are only built into firmware with trace support
+ *      (BUILD_HAS_TRACE), and are discarded until a trace driver has been
+ *      registered.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Trace identifiers of the framework trace points.
+ */
+enum fwk_trace_id {
+    /*!
+     * \brief Start of the processing of an event or notification.
+     *
+     * \details The value is the identifier of the event or notification.
+     */
+    FWK_TRACE_ID_EVENT_START,
+
+    /*!
+     * \brief End of the processing of an event or notification.
+     *
+     * \details The value is the identifier of the target of the event or
+     *      notification.
+     */
+    FWK_TRACE_ID_EVENT_END,
+
+    /*!
+     * \brief Entry of an interrupt service routine.
+     *
+     * \details The value is the exception number of the interrupt.
+     */
+    FWK_TRACE_ID_ISR_ENTRY,
+
+    /*!
+     * \brief Exit of an interrupt service routine.
+     *
+     * \details The value is the exception number of the interrupt.
+     */
+    FWK_TRACE_ID_ISR_EXIT,
+};
+
+/*!
+ * \brief Build the trace identifier of a module trace point.
+ *
+ * \details Each module has a range of 256 trace identifiers, above the ones of
+ *      the framework.
+ *
+ * \param MODULE_IDX Module index.
+ * \param IDX Index of the trace point within the module, lower than 256.
+ *
+ * \return Trace identifier.
+ */
+#define FWK_TRACE_ID_MODULE(MODULE_IDX, IDX) \
+    ((uint16_t)((((MODULE_IDX) + 1) << 8) | ((IDX) & 0xFF)))
+
+/*!
+ * \brief Trace driver.
+ */
+struct fwk_trace_driver {
+    /*!
+     * \brief Export a trace point.
+     *
+     * \details The function may be called from any context, including
+     *      interrupt service routines.
+     *
+     * \param id Trace identifier.
+     * \param value Value of the trace point.
+     */
+    void (*emit)(uint16_t id, uint32_t value);
+};
+
+/*!
+ * \brief Register the trace driver.
+ *
+ * \param driver Trace driver, NULL to discard the trace points.
+ *
+ * \retval FWK_SUCCESS The driver was registered.
+ * \retval FWK_E_PARAM The driver has no emit function.
+ */
+int fwk_trace_set_driver(const struct fwk_trace_driver *driver);
+
+/*!
+ * \internal
+ *
+ * \brief Pass a trace point to the trace driver.
+ *
+ * \param id Trace identifier.
+ * \param value Value of the trace point.
+ */
+void __fwk_trace(uint16_t id, uint32_t value);
+
+/*!
+ * \brief Trace point.
+ *
+ * \details The trace point compiles to nothing in firmware built without
+ *      trace support.
+ *
+ * \param ID Trace identifier.
+ * \param VALUE Value of the trace point.
+ */
+#ifdef BUILD_HAS_TRACE
+#define FWK_TRACE(ID, VALUE) __fwk_trace((ID), (VALUE))
+#else
+#define FWK_TRACE(ID, VALUE) ((void)0)
+#endif
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* FWK_TRACE_H */
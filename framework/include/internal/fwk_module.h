@@ -15,6 +15,21 @@
 #include <fwk_module.h>
 #include <internal/fwk_notification.h>
 
+/*
+ * Binding resolved at build time, listed in the module_static_binding_table
+ * generated for the firmware.
+ */
+struct fwk_module_static_binding {
+    /* Identifier of the module binding, FWK_ID_NONE for any module */
+    fwk_id_t source_id;
+
+    /* Identifier of the API, the same for all the entities of its module */
+    fwk_id_t api_id;
+
+    /* Pointer to the API, NULL for the last entry of the table */
+    const void *api;
+};
+
 /*
  * Module context.
  */
@@ -48,8 +63,13 @@ struct fwk_module_ctx {
     struct fwk_dlist *subscription_dlist_table;
     #endif
 
-    /* List of delayed response events */
-    struct fwk_slist delayed_response_list;
+    /* Number of bytes of heap allocated for the module */
+    size_t heap_usage;
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    /* Time spent by the module in the stages of the pre-runtime phase */
+    struct fwk_module_boot_time boot_time;
+    #endif
 };
 
 /*
@@ -75,9 +95,6 @@ struct fwk_element_ctx {
      */
     struct fwk_dlist *subscription_dlist_table;
     #endif
-
-    /* List of delayed response events */
-    struct fwk_slist delayed_response_list;
 };
 
 /*
@@ -90,6 +107,17 @@ struct fwk_element_ctx {
  */
 int __fwk_module_init(void);
 
+/*
+ * \brief Resume the module framework component from its retained state.
+ *
+ * \retval FWK_SUCCESS The module framework component was resumed.
+ * \retval FWK_E_STATE The module framework component was not initialized.
+ * \retval FWK_E_SUPPORT A module of the firmware is not retainable.
+ * \return One of the other framework error codes depending on the
+ *      irrecoverable error that occurred.
+ */
+int __fwk_module_resume(void);
+
 /*
  * \brief Get a pointer to the context of a module or element.
  *
@@ -9,6 +9,8 @@
 #define FWK_INTERNAL_MULTI_THREAD_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_list.h>
@@ -16,6 +18,12 @@
 #include <internal/fwk_thread.h>
 #include <cmsis_os2.h>
 
+/*
+ * Number of lists in the table of delayed responses. The delayed responses are
+ * distributed among the lists according to their cookie.
+ */
+#define FWK_DELAYED_RESPONSE_LIST_COUNT 16
+
 /*
  * Module/element thread context.
  */
@@ -40,6 +48,13 @@ struct __fwk_thread_ctx {
     /* Thread queue of events */
     struct fwk_slist event_queue;
 
+    /*
+     * Priority of the thread, from 0 to FWK_MODULE_THREAD_PRIORITY_MAX. Among
+     * the ready threads, the one with the highest priority is the next one
+     * to process an event.
+     */
+    unsigned int priority;
+
     /*
      * Flag indicating if the thread is waiting for the completion of the
      * processing of an event by another thread (true) or not (false). A thread
@@ -63,6 +78,27 @@ struct __fwk_thread_ctx {
      * processing the event which an event response is expected from.
      */
     struct fwk_event *response_event;
+
+    /*
+     * Flag indicating if the module or element having the identifier 'id' is
+     * processing an event within the thread that requested it through the
+     * fwk_thread_put_event_and_wait() framework API (true) or not (false).
+     * While this flag is set, the events sent to the module or element are
+     * queued but the thread is not added to the queue of ready threads.
+     */
+    bool processing_in_calling_thread;
+
+    /* Link for the list of all the threads created by the framework */
+    struct fwk_slist_node thread_list_node;
+
+    /*
+     * Address of the guard just below the stack of the thread, the stack
+     * itself starting FWK_THREAD_STACK_GUARD_SIZE bytes above.
+     */
+    uintptr_t stack_guard;
+
+    /* Size in bytes of the stack of the thread */
+    size_t stack_size;
 };
 
 /*
@@ -98,9 +134,19 @@ struct __fwk_multi_thread_ctx {
      */
     struct fwk_slist event_free_queue;
 
+    /* Number of event structures */
+    unsigned int event_count;
+
+    /* Number of event structures not in the queue of free events */
+    unsigned int used_event_count;
+
+    /* Highest value reached by used_event_count */
+    unsigned int used_event_count_max;
+
     /*
      * Queue of events generated by ISRs and not dispatched yet to the
-     * threads.
+     * threads. The queue is updated without masking the interrupts, ISRs
+     * appending events to it and the common thread taking them out.
      */
     struct fwk_slist event_isr_queue;
 
@@ -111,6 +157,20 @@ struct __fwk_multi_thread_ctx {
      * ready to execute as soon as the CPU becomes available for them.
      */
     struct fwk_slist thread_ready_queue;
+
+    /*
+     * List of all the threads created by the framework, starting with the
+     * common thread, in their order of creation.
+     */
+    struct fwk_slist thread_list;
+
+    /*
+     * Table of lists of delayed responses. A delayed response is linked to
+     * the list of index its cookie modulo FWK_DELAYED_RESPONSE_LIST_COUNT. As
+     * the cookies are allocated sequentially, the delayed responses are
+     * evenly spread over the lists.
+     */
+    struct fwk_slist delayed_response_table[FWK_DELAYED_RESPONSE_LIST_COUNT];
 };
 
 /*
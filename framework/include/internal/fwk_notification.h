@@ -23,15 +23,28 @@ struct __fwk_notification_subscription {
     fwk_id_t target_id;
 };
 
+/*
+ * Subscription declared at build time, listed in the
+ * module_static_subscription_table generated for the firmware.
+ */
+struct fwk_notification_static_subscription {
+    /* Identifier of the notification, none for the last entry of the table */
+    fwk_id_t notification_id;
+
+    /* Identifier of the notification source entity. */
+    fwk_id_t source_id;
+
+    /* Identifier of the notification target entity. */
+    fwk_id_t target_id;
+};
+
 /*
  * \brief Initialize the notification framework component.
  *
  * \param notification_count The maximum number of notification subscriptions at
- *      any time.
+ *      any time, in addition to the subscriptions declared at build time.
  *
  * \retval FWK_SUCCESS The notification framework component was initialized.
- * \retval FWK_E_PARAM The maximum number of notification subscriptions is equal
- *      to zero.
  * \retval FWK_E_NOMEM Insufficient memory available to allocate the
  *      notification subscription.
  */
@@ -44,4 +57,16 @@ int __fwk_notification_init(size_t notification_count);
  */
 void __fwk_notification_reset(void);
 
+/*
+ * \brief Account for a notification response before it is delivered.
+ *
+ * \param response Notification response event. When it completes the
+ *      collection of the responses to the notification, its status is replaced
+ *      by the collected status.
+ *
+ * \retval true The response has to be delivered to its target.
+ * \retval false The response has been collected and must be dropped.
+ */
+bool __fwk_notification_collect_response(struct fwk_event *response);
+
 #endif /* FWK_INTERNAL_NOTIFICATION_H */
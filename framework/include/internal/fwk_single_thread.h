@@ -10,8 +10,22 @@
 
 #include <stdbool.h>
 #include <fwk_event.h>
+#include <fwk_id.h>
 #include <fwk_list.h>
 
+/*
+ * Target of a multicast notification.
+ */
+struct __fwk_thread_notification_target {
+    struct fwk_slist_node slist_node;
+
+    /* Multicast notification event */
+    const struct fwk_event *event;
+
+    /* Identifier of the target entity */
+    fwk_id_t target_id;
+};
+
 /*
  * Thread component context. Exposed for testing purposes only.
  */
@@ -26,14 +40,41 @@ struct __fwk_thread_ctx {
      */
     struct fwk_slist free_event_queue;
 
+    /* Number of event structures */
+    unsigned int event_count;
+
+    /* Number of event structures not in the queue of free events */
+    unsigned int used_event_count;
+
+    /* Highest value reached by used_event_count */
+    unsigned int used_event_count_max;
+
+    /* Queue of notification target structures that are free */
+    struct fwk_slist free_target_queue;
+
+    /*
+     * Queue of the targets of all the multicast notifications awaiting
+     * processing, in the order they were added.
+     */
+    struct fwk_slist multicast_target_queue;
+
     /* Queue of events, generated by ISRs, that are awaiting processing */
     struct fwk_slist isr_event_queue;
 
-    /* Queue of events that are awaiting processing */
-    struct fwk_slist event_queue;
+    /*
+     * Flag indicating whether the ISR event queue contains at least one event
+     * of a priority class higher than FWK_EVENT_PRIORITY_NORMAL.
+     */
+    volatile bool isr_priority_event_pending;
+
+    /* Queues of events that are awaiting processing, one per priority class */
+    struct fwk_slist event_queue[FWK_EVENT_PRIORITY_COUNT];
 
     /* The event currently being processed */
     struct fwk_event *current_event;
+
+    /* Handler waiting for an interrupt when there is no event to process */
+    void (*idle)(void);
 };
 
 /*
@@ -9,6 +9,7 @@
 #define FWK_INTERNAL_THREAD_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <fwk_event.h>
 #include <fwk_noreturn.h>
 #include <fwk_thread.h>
@@ -23,6 +24,15 @@
  */
 int __fwk_thread_init(size_t event_count);
 
+/*
+ * \brief Set the handler called by the single-thread framework to wait for an
+ *      interrupt when there is no event to process.
+ *
+ * \param idle Idle handler provided by the architecture layer, or \c NULL to
+ *      busy-wait for events raised by interrupt service routines.
+ */
+void __fwk_thread_set_idle_handler(void (*idle)(void));
+
 /*
  * \brief Begin waiting for and processing events raised by modules and
  *      interrupt handlers.
@@ -60,4 +70,91 @@ const struct fwk_event *__fwk_thread_get_current_event(void);
  */
 int __fwk_thread_put_notification(struct fwk_event *event);
 
+/*
+ * \brief Begin a multicast notification.
+ *
+ * \details A multicast notification is a single event structure delivered in
+ *      turn to each of its targets. Its targets are added with
+ *      \ref __fwk_thread_add_notification_target and it is queued with
+ *      \ref __fwk_thread_put_multicast_notification.
+ *
+ * \note Only available in the single-thread framework.
+ *
+ * \param event Pointer to the notification event description, copied into
+ *      the multicast notification. Its target identifier is ignored.
+ *
+ * \return The multicast notification, or \c NULL if there is no free event
+ *      structure left.
+ */
+struct fwk_event *__fwk_thread_begin_multicast_notification(
+    const struct fwk_event *event);
+
+/*
+ * \brief Add a target to a multicast notification.
+ *
+ * \param multicast Multicast notification returned by
+ *      \ref __fwk_thread_begin_multicast_notification.
+ * \param target_id Identifier of the target.
+ *
+ * \retval FWK_SUCCESS The target was added.
+ * \retval FWK_E_NOMEM There is no free target structure left.
+ */
+int __fwk_thread_add_notification_target(struct fwk_event *multicast,
+                                         fwk_id_t target_id);
+
+/*
+ * \brief Queue a multicast notification.
+ *
+ * \details The multicast notification is released once it has been delivered
+ *      to all its targets, or immediately if it has no target.
+ *
+ * \param multicast Multicast notification returned by
+ *      \ref __fwk_thread_begin_multicast_notification.
+ * \param target_count Number of targets added to the multicast notification.
+ */
+void __fwk_thread_put_multicast_notification(struct fwk_event *multicast,
+                                             unsigned int target_count);
+
+/*
+ * \brief Initialize the event profiling.
+ *
+ * \details The event processing statistics are allocated for all the modules
+ *      of the firmware and their events and notifications.
+ *
+ * \param timestamp Timestamp handler provided by the architecture layer.
+ *
+ * \retval FWK_SUCCESS The event profiling was initialized.
+ * \retval FWK_E_PARAM The timestamp handler is equal to \c NULL.
+ * \retval FWK_E_NOMEM Insufficient memory available for the statistics.
+ */
+int __fwk_thread_profile_init(uint32_t (*timestamp)(void));
+
+/*
+ * \brief Record the time an event is queued at.
+ *
+ * \param event Pointer to the event being queued.
+ */
+void __fwk_thread_profile_queue(struct fwk_event *event);
+
+/*
+ * \brief Get the timestamp marking the beginning of the processing of an
+ *      event.
+ *
+ * \details Also used by the framework to time the stages of the pre-runtime
+ *      phase.
+ *
+ * \return The current timestamp.
+ */
+uint32_t __fwk_thread_profile_start(void);
+
+/*
+ * \brief Account for the processing of an event, and for the time it has
+ *      been queued if it has been.
+ *
+ * \param event Pointer to the event that has been processed.
+ * \param start Timestamp returned by \ref __fwk_thread_profile_start when
+ *      the processing of the event began.
+ */
+void __fwk_thread_profile_end(const struct fwk_event *event, uint32_t start);
+
 #endif /* FWK_INTERNAL_THREAD_H */
@@ -13,14 +13,16 @@
 #include <fwk_host.h>
 #include <fwk_mm.h>
 #include <internal/fwk_module.h>
+#include <internal/fwk_thread.h>
 
 extern int fwk_mm_init(uintptr_t start, size_t size);
+extern int fwk_mm_init_hot(uintptr_t start, size_t size);
 extern int fwk_interrupt_init(const struct fwk_arch_interrupt_driver *driver);
 
 static int mm_init(int (*mm_init_handler)(struct fwk_arch_mm_data *data))
 {
     int status;
-    struct fwk_arch_mm_data data;
+    struct fwk_arch_mm_data data = { 0 };
 
     /*
      * Retrieve a description of the memory area used for dynamic memory
@@ -35,6 +37,12 @@ static int mm_init(int (*mm_init_handler)(struct fwk_arch_mm_data *data))
     if (status != FWK_SUCCESS)
         return FWK_E_PANIC;
 
+    if (data.hot_size != 0) {
+        status = fwk_mm_init_hot(data.hot_start, data.hot_size);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -82,6 +90,18 @@ int fwk_arch_init(const struct fwk_arch_init_driver *driver)
     if (status != FWK_SUCCESS)
         return FWK_E_PANIC;
 
+    #ifndef BUILD_HAS_MULTITHREADING
+    /* Set the low-power wait used when there is no event to process */
+    __fwk_thread_set_idle_handler(driver->idle);
+    #endif
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    /* Initialize event profiling */
+    status = __fwk_thread_profile_init(driver->timestamp);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+    #endif
+
     /* Initialize modules */
     status = __fwk_module_init();
     if (status != FWK_SUCCESS)
@@ -89,3 +109,21 @@ int fwk_arch_init(const struct fwk_arch_init_driver *driver)
 
     return FWK_SUCCESS;
 }
+
+int fwk_arch_resume(void)
+{
+    int status;
+
+    /*
+     * The memory management and the interrupt driver, including the table of
+     * the interrupt service routines, are retained with the rest of the
+     * memory.
+     */
+    status = __fwk_module_resume();
+    if ((status == FWK_E_STATE) || (status == FWK_E_SUPPORT))
+        return status;
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
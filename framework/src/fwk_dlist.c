@@ -111,6 +111,89 @@ void __fwk_dlist_insert(
     node->prev = new;
 }
 
+void __fwk_dlist_insert_sorted(
+    struct fwk_dlist *list,
+    struct fwk_dlist_node *restrict new,
+    struct fwk_dlist_node *restrict hint,
+    bool (*is_before)(const struct fwk_dlist_node *node,
+                      const struct fwk_dlist_node *other))
+{
+    struct fwk_dlist_node *node;
+
+    assert(list != NULL);
+    assert(new != NULL);
+    assert(new != hint);
+    assert(is_before != NULL);
+    fwk_expect(new->next == NULL);
+    fwk_expect(new->prev == NULL);
+
+    node = (hint == NULL) ? list->head : hint;
+
+    assert((node == (struct fwk_dlist_node *)list) ||
+        __fwk_slist_contains(
+            (struct fwk_slist *)list,
+            (struct fwk_slist_node *)node));
+
+    /* Walk back while the new node belongs before the previous node */
+    while ((node->prev != (struct fwk_dlist_node *)list) &&
+           is_before(new, node->prev))
+        node = node->prev;
+
+    /* Walk forward to the first node the new node belongs before */
+    while ((node != (struct fwk_dlist_node *)list) && !is_before(new, node))
+        node = node->next;
+
+    /* Insert the new node just before the node that was found */
+    node->prev->next = new;
+    new->prev = node->prev;
+    new->next = node;
+    node->prev = new;
+}
+
+void __fwk_dlist_splice(
+    struct fwk_dlist *list,
+    struct fwk_dlist *other)
+{
+    assert(list != NULL);
+    assert(other != NULL);
+    assert(list != other);
+
+    if (fwk_list_is_empty(other))
+        return;
+
+    other->head->prev = list->tail;
+
+    __fwk_slist_splice(
+        (struct fwk_slist *)list,
+        (struct fwk_slist *)other);
+}
+
+unsigned int __fwk_dlist_pop_head_n(
+    struct fwk_dlist *list,
+    struct fwk_dlist *other,
+    unsigned int count)
+{
+    unsigned int moved;
+    struct fwk_dlist_node *other_tail;
+
+    assert(list != NULL);
+    assert(other != NULL);
+
+    other_tail = other->tail;
+
+    moved = __fwk_slist_pop_head_n(
+        (struct fwk_slist *)list,
+        (struct fwk_slist *)other,
+        count);
+    if (moved == 0)
+        return 0;
+
+    list->head->prev = (struct fwk_dlist_node *)list;
+    other_tail->next->prev = other_tail;
+
+    return moved;
+}
+
 static_assert(offsetof(struct fwk_dlist, head) ==
     offsetof(struct fwk_slist, head),
     "fwk_dlist::head not aligned with fwk_slist::head");
@@ -184,6 +184,43 @@ int fwk_interrupt_get_current(unsigned int *interrupt)
     return driver->get_current(interrupt);
 }
 
+int fwk_interrupt_get_trace_stats(unsigned int interrupt,
+                                  struct fwk_interrupt_trace_stats *stats)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    if (driver->get_trace_stats == NULL)
+        return FWK_E_SUPPORT;
+
+    return driver->get_trace_stats(interrupt, stats);
+}
+
+int fwk_interrupt_set_priority(unsigned int interrupt, unsigned int priority)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (driver->set_priority == NULL)
+        return FWK_E_SUPPORT;
+
+    return driver->set_priority(interrupt, priority);
+}
+
+int fwk_interrupt_set_priority_grouping(unsigned int subpriority_bits)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (driver->set_priority_grouping == NULL)
+        return FWK_E_SUPPORT;
+
+    return driver->set_priority_grouping(subpriority_bits);
+}
+
 /* This function is only for internal use by the framework */
 int fwk_interrupt_set_isr_fault(void (*isr)(void))
 {
@@ -0,0 +1,146 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     LZ4 block decoder.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fwk_errno.h>
+#include <fwk_lz4.h>
+
+/* Minimum length of a match */
+#define LZ4_MIN_MATCH 4
+
+/* Value of a token field announcing additional length bytes */
+#define LZ4_LENGTH_EXTENDED 15
+
+/*
+ * Read the additional bytes of a length. Returns false if the source ends
+ * before the length does.
+ */
+static bool read_length(const uint8_t **src, const uint8_t *src_end,
+                        size_t *length)
+{
+    uint8_t byte;
+
+    do {
+        if (*src == src_end)
+            return false;
+
+        byte = *(*src)++;
+        *length += byte;
+    } while (byte == UINT8_MAX);
+
+    return true;
+}
+
+int fwk_lz4_decompress(void *destination, size_t destination_size,
+                       const void *source, size_t source_size, size_t *size)
+{
+    const uint8_t *src = source;
+    const uint8_t *src_end = src + source_size;
+    uint8_t *dst = destination;
+    uint8_t *dst_end = dst + destination_size;
+    const uint8_t *match;
+    uint8_t token;
+    size_t length;
+    size_t offset;
+
+    if ((destination == NULL) || (source == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    while (src < src_end) {
+        token = *src++;
+
+        /* Literals */
+        length = token >> 4;
+        if ((length == LZ4_LENGTH_EXTENDED) &&
+            !read_length(&src, src_end, &length))
+            return FWK_E_DATA;
+
+        if (length > (size_t)(src_end - src))
+            return FWK_E_DATA;
+        if (length > (size_t)(dst_end - dst))
+            return FWK_E_NOMEM;
+
+        memcpy(dst, src, length);
+        src += length;
+        dst += length;
+
+        /* The last sequence has no match */
+        if (src == src_end)
+            break;
+
+        /* Match */
+        if ((src_end - src) < 2)
+            return FWK_E_DATA;
+
+        offset = src[0] | (src[1] << 8);
+        src += 2;
+
+        if ((offset == 0) ||
+            (offset > (size_t)(dst - (uint8_t *)destination)))
+            return FWK_E_DATA;
+
+        length = token & 0xF;
+        if ((length == LZ4_LENGTH_EXTENDED) &&
+            !read_length(&src, src_end, &length))
+            return FWK_E_DATA;
+        length += LZ4_MIN_MATCH;
+
+        if (length > (size_t)(dst_end - dst))
+            return FWK_E_NOMEM;
+
+        /* The match may overlap the bytes being written, copy byte by byte */
+        match = dst - offset;
+        while (length-- > 0)
+            *dst++ = *match++;
+    }
+
+    *size = dst - (uint8_t *)destination;
+
+    return FWK_SUCCESS;
+}
+
+int fwk_lz4_load_image(void *destination, size_t destination_size,
+                       const void *source, size_t source_size, size_t *size)
+{
+    struct fwk_lz4_image_header header;
+    int status;
+
+    if ((destination == NULL) || (source == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    if (source_size >= sizeof(header))
+        memcpy(&header, source, sizeof(header));
+
+    if ((source_size < sizeof(header)) ||
+        (header.signature != FWK_LZ4_IMAGE_SIGNATURE)) {
+        if (source_size > destination_size)
+            return FWK_E_NOMEM;
+
+        memcpy(destination, source, source_size);
+        *size = source_size;
+
+        return FWK_SUCCESS;
+    }
+
+    if (header.compressed_size > (source_size - sizeof(header)))
+        return FWK_E_DATA;
+    if (header.size > destination_size)
+        return FWK_E_NOMEM;
+
+    status = fwk_lz4_decompress(destination, header.size,
+                                (const uint8_t *)source + sizeof(header),
+                                header.compressed_size, size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return (*size == header.size) ? FWK_SUCCESS : FWK_E_DATA;
+}
@@ -0,0 +1,136 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Device memory copy primitives.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <fwk_mem.h>
+
+/* Number of words of the bursts */
+#define BURST_WORD_COUNT 4
+
+#define BURST_SIZE (BURST_WORD_COUNT * sizeof(uint32_t))
+
+static size_t get_misalignment(const volatile void *address)
+{
+    return (uintptr_t)address % sizeof(uint32_t);
+}
+
+/*
+ * The destination accesses are volatile so that the compiler does not turn the
+ * loops back into calls to the functions of the C library.
+ */
+static void copy_bytes(volatile uint8_t *destination,
+                       const volatile uint8_t *source, size_t size)
+{
+    while (size-- > 0)
+        *destination++ = *source++;
+}
+
+/* The areas are aligned on a word and the size is a multiple of a word */
+static void copy_words(volatile uint32_t *destination, const uint32_t *source,
+                       size_t size)
+{
+    uint32_t w0, w1, w2, w3;
+
+    for (; size >= BURST_SIZE; size -= BURST_SIZE) {
+        w0 = source[0];
+        w1 = source[1];
+        w2 = source[2];
+        w3 = source[3];
+        destination[0] = w0;
+        destination[1] = w1;
+        destination[2] = w2;
+        destination[3] = w3;
+        source += BURST_WORD_COUNT;
+        destination += BURST_WORD_COUNT;
+    }
+
+    for (; size > 0; size -= sizeof(uint32_t))
+        *destination++ = *source++;
+}
+
+void fwk_mem_copy(void *destination, const void *source, size_t size)
+{
+    volatile uint8_t *dst = destination;
+    const uint8_t *src = source;
+    size_t head_size;
+    size_t word_size;
+
+    if (get_misalignment(dst) != get_misalignment(src)) {
+        copy_bytes(dst, src, size);
+        return;
+    }
+
+    head_size = (sizeof(uint32_t) - get_misalignment(dst)) % sizeof(uint32_t);
+    if (head_size >= size) {
+        copy_bytes(dst, src, size);
+        return;
+    }
+
+    copy_bytes(dst, src, head_size);
+    dst += head_size;
+    src += head_size;
+    size -= head_size;
+
+    word_size = size - (size % sizeof(uint32_t));
+    copy_words((volatile uint32_t *)dst, (const uint32_t *)src, word_size);
+
+    copy_bytes(dst + word_size, src + word_size, size - word_size);
+}
+
+void fwk_mem_set(void *destination, uint8_t value, size_t size)
+{
+    volatile uint8_t *dst = destination;
+    volatile uint32_t *word;
+    uint32_t word_value = value * UINT32_C(0x01010101);
+
+    for (; (size > 0) && (get_misalignment(dst) != 0); size--)
+        *dst++ = value;
+
+    for (word = (volatile uint32_t *)dst; size >= BURST_SIZE;
+         size -= BURST_SIZE) {
+        word[0] = word_value;
+        word[1] = word_value;
+        word[2] = word_value;
+        word[3] = word_value;
+        word += BURST_WORD_COUNT;
+    }
+
+    for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t))
+        *word++ = word_value;
+
+    for (dst = (volatile uint8_t *)word; size > 0; size--)
+        *dst++ = value;
+}
+
+void fwk_mem_write_words(void *destination, const void *source, size_t size)
+{
+    volatile uint32_t *dst = destination;
+    const uint8_t *src = source;
+    size_t word_size = size - (size % sizeof(uint32_t));
+    uint32_t word;
+
+    if (get_misalignment(src) == 0)
+        copy_words(dst, (const uint32_t *)src, word_size);
+    else {
+        for (size_t offset = 0; offset < word_size;
+             offset += sizeof(uint32_t)) {
+            memcpy(&word, src + offset, sizeof(word));
+            dst[offset / sizeof(uint32_t)] = word;
+        }
+    }
+
+    if (size != word_size) {
+        word = 0;
+        memcpy(&word, src + word_size, size - word_size);
+        dst[word_size / sizeof(uint32_t)] = word;
+    }
+}
@@ -15,13 +15,56 @@
 #include <string.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 
+/* Memory region allocations are made from */
+struct heap {
+    uintptr_t start;
+    uintptr_t free;
+    uintptr_t end;
+};
+
 static bool initialized;
 static bool mm_locked;
-static uintptr_t heap_free;
-static uintptr_t heap_end;
+static struct heap heap;
+static struct heap hot_heap;
+
+static void *heap_alloc(struct heap *region, size_t num, size_t size,
+                        unsigned int alignment)
+{
+    uintptr_t start;
+    size_t total_size;
+    bool overflow;
+
+    if (mm_locked || !num || !size || !alignment || (region->start == 0))
+        return NULL;
+
+    /* Ensure 'alignment' is a power of two */
+    if (alignment & (alignment - 1))
+        return NULL;
+
+    overflow = __builtin_mul_overflow(num, size, &total_size);
+
+    /* Ensure the computation of 'total_size' has not overflowed */
+    if (overflow)
+        return NULL;
+
+    start = FWK_ALIGN_NEXT(region->free, alignment);
+
+    /* Ensure there is no overflow during the alignment */
+    if (start < region->free)
+        return NULL;
+
+    /* Ensure 'total_size' fits in the remaining area */
+    if (total_size > (region->end - start))
+        return NULL;
+
+    region->free = start + total_size;
+
+    return (void *)start;
+}
 
 /*
  * Initialize the memory management component.
@@ -41,14 +84,45 @@ int fwk_mm_init(uintptr_t start, size_t size)
     if ((start == 0) || (size == 0))
         return FWK_E_RANGE;
 
-    heap_free = start;
-    heap_end = start + size;
+    heap = (struct heap) {
+        .start = start,
+        .free = start,
+        .end = start + size,
+    };
 
     initialized = true;
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Initialize the hot memory region.
+ *
+ * This function is not exposed by the memory management component but is
+ * used by the framework during its initialization routine, when the
+ * architecture layer provides a hot memory region.
+ *
+ * \retval FWK_SUCCESS Initialization was successful.
+ * \retval FWK_E_STATE The hot memory region has already been initialized.
+ * \retval FWK_E_RANGE There is a problem with the memory layout provided.
+ */
+int fwk_mm_init_hot(uintptr_t start, size_t size)
+{
+    if (hot_heap.start != 0)
+        return FWK_E_STATE;
+
+    if ((start == 0) || (size == 0))
+        return FWK_E_RANGE;
+
+    hot_heap = (struct heap) {
+        .start = start,
+        .free = start,
+        .end = start + size,
+    };
+
+    return FWK_SUCCESS;
+}
+
 void fwk_mm_lock(void)
 {
     mm_locked = true;
@@ -61,45 +135,79 @@ void *fwk_mm_alloc(size_t num, size_t size)
 
 void *fwk_mm_alloc_aligned(size_t num, size_t size, unsigned int alignment)
 {
-    uintptr_t start;
-    size_t total_size;
-    bool overflow;
-
-    if (mm_locked || !num || !size || !alignment || !initialized)
-        goto error;
+    void *start;
 
-    /* Ensure 'alignment' is a power of two */
-    if (alignment & (alignment - 1))
-        goto error;
+    start = heap_alloc(&heap, num, size, alignment);
+    fwk_expect(start != NULL);
 
-    overflow = __builtin_mul_overflow(num, size, &total_size);
+    return start;
+}
 
-    /* Ensure the computation of 'total_size' has not overflowed */
-    if (overflow)
-        goto error;
+void *fwk_mm_alloc_hot(size_t num, size_t size)
+{
+    void *start;
 
-    start = FWK_ALIGN_NEXT(heap_free, alignment);
+    /* Fall back to the heap if the hot memory is missing or exhausted */
+    start = heap_alloc(&hot_heap, num, size, FWK_MM_DEFAULT_ALIGNMENT);
+    if (start == NULL)
+        start = fwk_mm_alloc(num, size);
 
-    /* Ensure there is no overflow during the alignment */
-    if (start < heap_free)
-        goto error;
+    return start;
+}
 
-    /* Ensure 'total_size' fits in the remaining heap area */
-    if (total_size > (heap_end - start))
-        goto error;
+void *fwk_mm_calloc(size_t num, size_t size)
+{
+    return fwk_mm_calloc_aligned(num, size, FWK_MM_DEFAULT_ALIGNMENT);
+}
 
-    heap_free = start + total_size;
+void *fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    void *start;
 
-    return (void *)start;
+    start = fwk_mm_alloc_hot(num, size);
+    if (start != NULL)
+        memset(start, 0, num * size);
 
-error:
-    fwk_expect(false);
-    return NULL;
+    return start;
 }
 
-void *fwk_mm_calloc(size_t num, size_t size)
+int fwk_mm_calloc_hot_tables(size_t num, const size_t *entry_size_table,
+                             void **table_table, unsigned int table_count)
 {
-    return fwk_mm_calloc_aligned(num, size, FWK_MM_DEFAULT_ALIGNMENT);
+    unsigned int table_idx;
+    size_t table_size;
+    size_t total_size = 0;
+    uintptr_t table;
+
+    if ((num == 0) || (entry_size_table == NULL) || (table_table == NULL) ||
+        (table_count == 0))
+        return FWK_E_PARAM;
+
+    for (table_idx = 0; table_idx < table_count; table_idx++) {
+        if (entry_size_table[table_idx] == 0)
+            return FWK_E_PARAM;
+
+        /* Ensure the tables and their padding do not overflow */
+        if (__builtin_mul_overflow(num, entry_size_table[table_idx],
+                                   &table_size) ||
+            __builtin_add_overflow(total_size, table_size, &total_size) ||
+            (total_size > (SIZE_MAX - FWK_MM_DEFAULT_ALIGNMENT)))
+            return FWK_E_PARAM;
+
+        total_size = FWK_ALIGN_NEXT(total_size, FWK_MM_DEFAULT_ALIGNMENT);
+    }
+
+    table = (uintptr_t)fwk_mm_calloc_hot(1, total_size);
+    if (table == 0)
+        return FWK_E_NOMEM;
+
+    for (table_idx = 0; table_idx < table_count; table_idx++) {
+        table_table[table_idx] = (void *)table;
+        table += FWK_ALIGN_NEXT(num * entry_size_table[table_idx],
+                                FWK_MM_DEFAULT_ALIGNMENT);
+    }
+
+    return FWK_SUCCESS;
 }
 
 void *fwk_mm_calloc_aligned(size_t num, size_t size, unsigned int alignment)
@@ -113,11 +221,123 @@ void *fwk_mm_calloc_aligned(size_t num, size_t size, unsigned int alignment)
     return start;
 }
 
+int fwk_mm_get_stats(struct fwk_mm_stats *stats)
+{
+    if (!initialized)
+        return FWK_E_INIT;
+
+    if (stats == NULL)
+        return FWK_E_PARAM;
+
+    stats->hot_size = hot_heap.end - hot_heap.start;
+    stats->hot_used = hot_heap.free - hot_heap.start;
+    stats->size = (heap.end - heap.start) + stats->hot_size;
+    stats->used = (heap.free - heap.start) + stats->hot_used;
+
+    return FWK_SUCCESS;
+}
+
+int fwk_mm_pool_init(struct fwk_mm_pool *pool, unsigned int block_count,
+                     size_t block_size)
+{
+    unsigned int block_idx;
+    uintptr_t block;
+
+    if ((pool == NULL) || (block_count == 0) || (block_size == 0))
+        return FWK_E_PARAM;
+
+    /*
+     * A free block holds the address of the next free block. The size of the
+     * blocks is rounded so that all of them are aligned.
+     */
+    if (block_size < sizeof(void *))
+        block_size = sizeof(void *);
+    block_size = FWK_ALIGN_NEXT(block_size, FWK_MM_DEFAULT_ALIGNMENT);
+
+    pool->start = (uintptr_t)fwk_mm_alloc(block_count, block_size);
+    if (pool->start == 0)
+        return FWK_E_NOMEM;
+
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    pool->used = 0;
+    pool->used_max = 0;
+
+    /* Link the blocks in address order, the last one ending the list */
+    pool->free_block = (void *)pool->start;
+    for (block_idx = 0; block_idx < block_count; block_idx++) {
+        block = pool->start + (block_idx * block_size);
+        *(void **)block = (block_idx == (block_count - 1)) ?
+                          NULL : (void *)(block + block_size);
+    }
+
+    return FWK_SUCCESS;
+}
+
+void *fwk_mm_pool_alloc(struct fwk_mm_pool *pool)
+{
+    void *block;
+
+    if (pool == NULL)
+        return NULL;
+
+    fwk_interrupt_global_disable();
+    block = pool->free_block;
+    if (block != NULL) {
+        pool->free_block = *(void **)block;
+        pool->used++;
+        if (pool->used > pool->used_max)
+            pool->used_max = pool->used;
+    }
+    fwk_interrupt_global_enable();
+
+    return block;
+}
+
+int fwk_mm_pool_free(struct fwk_mm_pool *pool, void *block)
+{
+    uintptr_t offset;
+
+    if ((pool == NULL) || (block == NULL))
+        return FWK_E_PARAM;
+
+    /* Ensure the block is one of the blocks of the pool */
+    offset = (uintptr_t)block - pool->start;
+    if (((uintptr_t)block < pool->start) ||
+        (offset >= (pool->block_count * pool->block_size)) ||
+        ((offset % pool->block_size) != 0))
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+    fwk_assert(pool->used > 0);
+    *(void **)block = pool->free_block;
+    pool->free_block = block;
+    pool->used--;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+int fwk_mm_pool_get_stats(const struct fwk_mm_pool *pool,
+                          struct fwk_mm_pool_stats *stats)
+{
+    if ((pool == NULL) || (stats == NULL))
+        return FWK_E_PARAM;
+
+    fwk_interrupt_global_disable();
+    stats->size = pool->block_count;
+    stats->used = pool->used;
+    stats->used_max = pool->used_max;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
 #ifdef __NEWLIB__
 void *_sbrk(intptr_t increment)
 {
     if (increment == 0) {
-        return (void *)heap_end;
+        return (void *)heap.end;
     } else {
         errno = ENOMEM;
 
@@ -20,8 +20,12 @@
 #endif
 
 #define EVENT_COUNT 64
+#ifdef BUILD_NOTIFICATION_COUNT
+#define NOTIFICATION_COUNT BUILD_NOTIFICATION_COUNT
+#else
 #define NOTIFICATION_COUNT 64
-#define BIND_ROUND_MAX 1
+#endif
+#define BIND_ROUND_MAX (FWK_MODULE_BIND_ROUND_COUNT - 1)
 
 /* Pre-runtime phase stages */
 enum module_stage {
@@ -50,8 +54,9 @@ struct context {
     fwk_id_t bind_id;
 };
 
-extern const struct fwk_module *module_table[];
-extern const struct fwk_module_config *module_config_table[];
+extern const struct fwk_module *const module_table[];
+extern const struct fwk_module_config *const module_config_table[];
+extern const struct fwk_module_static_binding module_static_binding_table[];
 
 static struct context ctx;
 
@@ -64,6 +69,27 @@ static const char err_msg_func[] = "[MOD] Error %d in %s\n";
  * Static functions
  */
 
+static size_t get_heap_used(void)
+{
+    struct fwk_mm_stats stats;
+
+    if (fwk_mm_get_stats(&stats) != FWK_SUCCESS)
+        return 0;
+
+    return stats.used;
+}
+
+static size_t get_event_pool_size(void)
+{
+    size_t event_count = EVENT_COUNT;
+    unsigned int module_idx;
+
+    for (module_idx = 0; module_table[module_idx] != NULL; module_idx++)
+        event_count += module_table[module_idx]->event_pool_size;
+
+    return event_count;
+}
+
 #ifdef BUILD_HAS_NOTIFICATION
 static int init_notification_dlist_table(size_t count,
     struct fwk_dlist **notification_dlist_table)
@@ -121,7 +147,6 @@ static int init_elements(struct fwk_module_ctx *module_ctx,
 
         element_ctx->desc = element;
         element_ctx->sub_element_count = element->sub_element_count;
-        fwk_list_init(&element_ctx->delayed_response_list);
 
         #ifdef BUILD_HAS_NOTIFICATION
         if (module->notification_count) {
@@ -152,6 +177,9 @@ static int init_module(struct fwk_module_ctx *module_ctx,
     int status;
     const struct fwk_element *element_table = NULL;
     unsigned int count;
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
 
     if ((module->name == NULL) ||
         (module->type >= FWK_MODULE_TYPE_COUNT) ||
@@ -164,7 +192,6 @@ static int init_module(struct fwk_module_ctx *module_ctx,
 
     module_ctx->desc = module;
     module_ctx->config = module_config;
-    fwk_list_init(&module_ctx->delayed_response_list);
     ctx.bind_id = module_ctx->id;
 
     #ifdef BUILD_HAS_NOTIFICATION
@@ -180,22 +207,38 @@ static int init_module(struct fwk_module_ctx *module_ctx,
         element_table = module_config->get_element_table(module_ctx->id);
         if (!fwk_expect(element_table != NULL))
             return FWK_E_PARAM;
+    } else
+        element_table = module_config->elements;
 
+    if (element_table != NULL) {
         for (count = 0; element_table[count].name != NULL; count++)
             continue;
 
         module_ctx->element_count = count;
     }
 
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    start = __fwk_thread_profile_start();
+    #endif
     status = module->init(module_ctx->id, module_ctx->element_count,
                           module_config->data);
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    module_ctx->boot_time.init = __fwk_thread_profile_start() - start;
+    #endif
     if (!fwk_expect(status == FWK_SUCCESS)) {
         FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
         return status;
     }
 
     if (module_ctx->element_count > 0) {
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        start = __fwk_thread_profile_start();
+        #endif
         status = init_elements(module_ctx, element_table);
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        module_ctx->boot_time.element_init =
+            __fwk_thread_profile_start() - start;
+        #endif
         if (status != FWK_SUCCESS) {
             FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
             return status;
@@ -203,7 +246,13 @@ static int init_module(struct fwk_module_ctx *module_ctx,
     }
 
     if (module->post_init != NULL) {
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        start = __fwk_thread_profile_start();
+        #endif
         status = module->post_init(module_ctx->id);
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        module_ctx->boot_time.post_init = __fwk_thread_profile_start() - start;
+        #endif
         if (!fwk_expect(status == FWK_SUCCESS)) {
             FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
             return status;
@@ -220,6 +269,7 @@ static int init_modules(void)
     int status;
     unsigned int module_idx;
     struct fwk_module_ctx *module_ctx;
+    size_t heap_used;
 
     while (module_table[ctx.module_count] != NULL)
         ctx.module_count++;
@@ -234,8 +284,10 @@ static int init_modules(void)
     for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
         module_ctx = &ctx.module_ctx_table[module_idx];
         module_ctx->id = FWK_ID_MODULE(module_idx);
+        heap_used = get_heap_used();
         status = init_module(module_ctx, module_table[module_idx],
                              module_config_table[module_idx]);
+        module_ctx->heap_usage += get_heap_used() - heap_used;
         if (status != FWK_SUCCESS) {
             FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
             return status;
@@ -303,10 +355,23 @@ static int bind_modules(unsigned int round)
     int status;
     unsigned int module_idx;
     struct fwk_module_ctx *module_ctx;
+    size_t heap_used;
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
 
     for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
         module_ctx = &ctx.module_ctx_table[module_idx];
+        heap_used = get_heap_used();
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        start = __fwk_thread_profile_start();
+        #endif
         status = bind_module(module_ctx, round);
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        module_ctx->boot_time.bind[round] =
+            __fwk_thread_profile_start() - start;
+        #endif
+        module_ctx->heap_usage += get_heap_used() - heap_used;
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -360,15 +425,31 @@ static int start_module(struct fwk_module_ctx *module_ctx)
     return start_elements(module_ctx);
 }
 
-static int start_modules(void)
+static int start_modules(bool deferred)
 {
     int status;
     unsigned int module_idx;
     struct fwk_module_ctx *module_ctx;
+    size_t heap_used;
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
 
     for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
         module_ctx = &ctx.module_ctx_table[module_idx];
+        if ((module_ctx->config->deferred_start != deferred) ||
+            (module_ctx->state == FWK_MODULE_STATE_STARTED))
+            continue;
+
+        heap_used = get_heap_used();
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        start = __fwk_thread_profile_start();
+        #endif
         status = start_module(module_ctx);
+        #ifdef BUILD_HAS_EVENT_PROFILING
+        module_ctx->boot_time.start = __fwk_thread_profile_start() - start;
+        #endif
+        module_ctx->heap_usage += get_heap_used() - heap_used;
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -376,6 +457,68 @@ static int start_modules(void)
     return FWK_SUCCESS;
 }
 
+static int resume_module(struct fwk_module_ctx *module_ctx)
+{
+    int status;
+    const struct fwk_module *module;
+    unsigned int element_idx;
+
+    module = module_ctx->desc;
+    if ((module->resume == NULL) ||
+        (module_ctx->state != FWK_MODULE_STATE_STARTED))
+        return FWK_SUCCESS;
+
+    status = module->resume(module_ctx->id);
+    if (!fwk_expect(status == FWK_SUCCESS)) {
+        FWK_HOST_PRINT(err_msg_func, status, __func__);
+        return status;
+    }
+
+    for (element_idx = 0; element_idx < module_ctx->element_count;
+         element_idx++) {
+
+        if (module_ctx->element_ctx_table[element_idx].state !=
+            FWK_MODULE_STATE_STARTED)
+            continue;
+
+        status = module->resume(
+            fwk_id_build_element_id(module_ctx->id, element_idx));
+        if (!fwk_expect(status == FWK_SUCCESS)) {
+            FWK_HOST_PRINT(err_msg_func, status, __func__);
+            return status;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Find the binding resolved at build time of the module being bound to an API.
+ *
+ * \param api_id Identifier of the API.
+ *
+ * \retval NULL The binding is not resolved at build time.
+ * \return Pointer to the binding.
+ */
+static const struct fwk_module_static_binding *get_static_binding(
+    fwk_id_t api_id)
+{
+    const struct fwk_module_static_binding *binding;
+
+    for (binding = module_static_binding_table; binding->api != NULL;
+         binding++) {
+        if (!fwk_id_is_equal(binding->api_id, api_id))
+            continue;
+
+        if (fwk_id_is_equal(binding->source_id, FWK_ID_NONE) ||
+            (fwk_id_get_module_idx(binding->source_id) ==
+             fwk_id_get_module_idx(ctx.bind_id)))
+            return binding;
+    }
+
+    return NULL;
+}
+
 /*
  * Private interface functions
  */
@@ -390,7 +533,7 @@ int __fwk_module_init(void)
         return FWK_E_STATE;
     }
 
-    status = __fwk_thread_init(EVENT_COUNT);
+    status = __fwk_thread_init(get_event_pool_size());
     if (status != FWK_SUCCESS)
         return status;
 
@@ -413,7 +556,7 @@ int __fwk_module_init(void)
     #endif
 
     ctx.stage = MODULE_STAGE_START;
-    status = start_modules();
+    status = start_modules(false);
     if (status != FWK_SUCCESS)
         return status;
 
@@ -424,6 +567,38 @@ int __fwk_module_init(void)
     return FWK_SUCCESS;
 }
 
+int __fwk_module_resume(void)
+{
+    int status;
+    unsigned int module_idx;
+
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_STATE, __func__);
+        return FWK_E_STATE;
+    }
+
+    #ifdef BUILD_HAS_MULTITHREADING
+    /* The threads of the kernel cannot be resumed */
+    return FWK_E_SUPPORT;
+    #endif
+
+    /* The firmware is either resumed as a whole or booted again */
+    for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
+        if (!ctx.module_ctx_table[module_idx].desc->retainable)
+            return FWK_E_SUPPORT;
+    }
+
+    for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
+        status = resume_module(&ctx.module_ctx_table[module_idx]);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    __fwk_thread_run();
+
+    return FWK_SUCCESS;
+}
+
 struct fwk_module_ctx *__fwk_module_get_ctx(fwk_id_t id)
 {
     return &ctx.module_ctx_table[fwk_id_get_module_idx(id)];
@@ -438,19 +613,43 @@ struct fwk_element_ctx *__fwk_module_get_element_ctx(fwk_id_t element_id)
 
 int __fwk_module_get_state(fwk_id_t id, enum fwk_module_state *state)
 {
+    unsigned int module_idx, element_idx;
+    struct fwk_module_ctx *module_ctx;
+    struct fwk_element_ctx *element_ctx;
+
     if (state == NULL)
         return FWK_E_PARAM;
 
-    if (fwk_module_is_valid_element_id(id) ||
-        fwk_module_is_valid_sub_element_id(id))
-        *state = __fwk_module_get_element_ctx(id)->state;
-    else {
-        if (fwk_module_is_valid_module_id(id))
-            *state = __fwk_module_get_ctx(id)->state;
-        else
-            return FWK_E_PARAM;
+    /*
+     * This function is on the path of every API call checked with
+     * fwk_module_check_call(): decode the identifier only once.
+     */
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE) &&
+        !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT) &&
+        !fwk_id_is_type(id, FWK_ID_TYPE_SUB_ELEMENT))
+        return FWK_E_PARAM;
+
+    module_idx = fwk_id_get_module_idx(id);
+    if (module_idx >= ctx.module_count)
+        return FWK_E_PARAM;
+    module_ctx = &ctx.module_ctx_table[module_idx];
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        *state = module_ctx->state;
+        return FWK_SUCCESS;
     }
 
+    element_idx = fwk_id_get_element_idx(id);
+    if (element_idx >= module_ctx->element_count)
+        return FWK_E_PARAM;
+    element_ctx = &module_ctx->element_ctx_table[element_idx];
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_SUB_ELEMENT) &&
+        (fwk_id_get_sub_element_idx(id) >= element_ctx->sub_element_count))
+        return FWK_E_PARAM;
+
+    *state = element_ctx->state;
+
     return FWK_SUCCESS;
 }
 
@@ -579,6 +778,16 @@ bool fwk_module_is_valid_notification_id(fwk_id_t id)
     #endif
 }
 
+int fwk_module_start_deferred(void)
+{
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_STATE, __func__);
+        return FWK_E_STATE;
+    }
+
+    return start_modules(true);
+}
+
 int fwk_module_get_element_count(fwk_id_t id)
 {
     if (fwk_module_is_valid_module_id(id))
@@ -595,6 +804,31 @@ int fwk_module_get_sub_element_count(fwk_id_t element_id)
         return FWK_E_PARAM;
 }
 
+int fwk_module_get_heap_usage(fwk_id_t module_id, size_t *size)
+{
+    if (!fwk_module_is_valid_module_id(module_id) || (size == NULL))
+        return FWK_E_PARAM;
+
+    *size = __fwk_module_get_ctx(module_id)->heap_usage;
+
+    return FWK_SUCCESS;
+}
+
+int fwk_module_get_boot_time(fwk_id_t module_id,
+                             struct fwk_module_boot_time *time)
+{
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    if (!fwk_module_is_valid_module_id(module_id) || (time == NULL))
+        return FWK_E_PARAM;
+
+    *time = __fwk_module_get_ctx(module_id)->boot_time;
+
+    return FWK_SUCCESS;
+    #else
+    return FWK_E_SUPPORT;
+    #endif
+}
+
 const char *fwk_module_get_name(fwk_id_t id)
 {
     if (fwk_module_is_valid_element_id(id))
@@ -645,6 +879,7 @@ int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api)
 {
     int status = FWK_E_PARAM;
     struct fwk_module_ctx *module_ctx;
+    const struct fwk_module_static_binding *static_binding;
 
     if (!fwk_module_is_valid_entity_id(target_id))
         goto error;
@@ -669,6 +904,12 @@ int fwk_module_bind(fwk_id_t target_id, fwk_id_t api_id, const void *api)
         goto error;
     }
 
+    static_binding = get_static_binding(api_id);
+    if (static_binding != NULL) {
+        *(const void **)api = static_binding->api;
+        return FWK_SUCCESS;
+    }
+
     status = module_ctx->desc->process_bind_request(ctx.bind_id, target_id,
                                                     api_id, (const void **)api);
     if (!fwk_expect(status == FWK_SUCCESS)) {
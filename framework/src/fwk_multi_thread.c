@@ -13,7 +13,9 @@
 #include <fwk_host.h>
 #include <fwk_interrupt.h>
 #include <fwk_element.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
+#include <fwk_trace.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_notification.h>
 #include <internal/fwk_multi_thread.h>
@@ -24,6 +26,11 @@
 #define SIGNAL_EVENT_PROCESSED 0x04
 #define SIGNAL_NO_READY_THREAD 0x08
 
+#define DEFAULT_THREAD_STACK_SIZE (256 * 4)
+
+/* Pattern the stacks are filled with to measure their usage */
+#define STACK_FILL_PATTERN UINT32_C(0xCCCCCCCC)
+
 static struct __fwk_multi_thread_ctx ctx;
 #ifdef BUILD_HOST
 static const char err_msg_line[] = "[THR] Error %d @%d\n";
@@ -38,12 +45,20 @@ static const char err_msg_func[] = "[THR] Error %d in %s\n";
  * Initialize the attributes of thread.
  *
  * \param[out] attr Thread's attributes.
+ * \param priority Framework priority of the thread.
+ * \param stack_size Size in bytes of the thread's stack, zero for the default
+ *     stack size.
  *
  * \retval FWK_SUCCESS The initialization succeeded.
  * \retval FWK_E_NOMEM A memory allocation failed.
  */
-static int init_thread_attr(osThreadAttr_t *attr)
+static int init_thread_attr(osThreadAttr_t *attr, unsigned int priority,
+                            size_t stack_size)
 {
+    char *guard;
+    uint32_t *stack;
+    size_t word_idx;
+
     attr->name = "";
     attr->attr_bits = osThreadDetached;
     attr->cb_size = osRtxThreadCbSize;
@@ -51,16 +66,76 @@ static int init_thread_attr(osThreadAttr_t *attr)
     if (attr->cb_mem == NULL)
         return FWK_E_NOMEM;
 
-    attr->stack_size = 256 * 4;
-    attr->stack_mem = fwk_mm_calloc(1, attr->stack_size);
-    if (attr->stack_mem == NULL)
+    if (stack_size == 0)
+        stack_size = DEFAULT_THREAD_STACK_SIZE;
+
+    /*
+     * The RTOS requires the stack size to be a multiple of 8 bytes. The guard
+     * is allocated just below the stack, aligned on its size.
+     */
+    attr->stack_size = FWK_ALIGN_NEXT(stack_size, 8);
+    guard = fwk_mm_calloc_aligned(1,
+        FWK_THREAD_STACK_GUARD_SIZE + attr->stack_size,
+        FWK_THREAD_STACK_GUARD_SIZE);
+    if (guard == NULL)
         return FWK_E_NOMEM;
 
-    attr->priority = osPriorityNormal;
+    attr->stack_mem = guard + FWK_THREAD_STACK_GUARD_SIZE;
+    stack = attr->stack_mem;
+    for (word_idx = 0; word_idx < (attr->stack_size / sizeof(uint32_t));
+         word_idx++)
+        stack[word_idx] = STACK_FILL_PATTERN;
+
+    attr->priority = (osPriority_t)(osPriorityNormal + priority);
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Record the stack of a thread and add the thread to the list of all the
+ * threads.
+ *
+ * \param thread_ctx Pointer to the context of the thread.
+ * \param attr Attributes the thread has been created with.
+ */
+static void add_thread(struct __fwk_thread_ctx *thread_ctx,
+                       const osThreadAttr_t *attr)
+{
+    thread_ctx->stack_guard = (uintptr_t)attr->stack_mem -
+                              FWK_THREAD_STACK_GUARD_SIZE;
+    thread_ctx->stack_size = attr->stack_size;
+    fwk_list_push_tail(&ctx.thread_list, &thread_ctx->thread_list_node);
+}
+
+/*
+ * Get the number of bytes of the stack of a thread used so far.
+ *
+ * \param thread_ctx Pointer to the context of the thread.
+ *
+ * \return Number of bytes from the top of the stack down to the lowest word
+ *     not holding the fill pattern anymore.
+ */
+static size_t get_stack_max_used(const struct __fwk_thread_ctx *thread_ctx)
+{
+    const uint32_t *stack;
+    size_t word_count, word_idx;
+
+    stack = (const uint32_t *)(thread_ctx->stack_guard +
+                               FWK_THREAD_STACK_GUARD_SIZE);
+    word_count = thread_ctx->stack_size / sizeof(uint32_t);
+
+    /*
+     * The first word is skipped as the RTOS may keep there the magic word of
+     * its own stack overflow check.
+     */
+    for (word_idx = 1; word_idx < word_count; word_idx++) {
+        if (stack[word_idx] != STACK_FILL_PATTERN)
+            break;
+    }
+
+    return (word_count - word_idx) * sizeof(uint32_t);
+}
+
 /*
  * Put back an event into the queue of free events.
  *
@@ -72,7 +147,62 @@ static void free_event(struct fwk_event *event)
 {
     fwk_interrupt_global_disable();
     fwk_list_push_tail(&ctx.event_free_queue, &event->slist_node);
+    ctx.used_event_count--;
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Take an event from the queue of free events.
+ *
+ * \return The pointer to the event, NULL if the queue of free events is empty.
+ */
+static struct fwk_event *allocate_event(void)
+{
+    struct fwk_event *event;
+
+    fwk_interrupt_global_disable();
+    event = FWK_LIST_GET(fwk_list_pop_head(&ctx.event_free_queue),
+                         struct fwk_event, slist_node);
+    if (event != NULL) {
+        ctx.used_event_count++;
+        if (ctx.used_event_count > ctx.used_event_count_max)
+            ctx.used_event_count_max = ctx.used_event_count;
+    }
+    fwk_interrupt_global_enable();
+
+    return event;
+}
+
+/*
+ * Take several events from the queue of free events at once.
+ *
+ * \param[out] events List the events are linked to.
+ * \param count Number of events.
+ *
+ * \retval true The events were taken.
+ * \retval false There are fewer than \p count free events, none was taken.
+ */
+static bool allocate_events(struct fwk_slist *events, unsigned int count)
+{
+    unsigned int idx;
+
+    fwk_interrupt_global_disable();
+
+    if ((ctx.event_count - ctx.used_event_count) < count) {
+        fwk_interrupt_global_enable();
+        return false;
+    }
+
+    for (idx = 0; idx < count; idx++)
+        fwk_list_push_tail(events, fwk_list_pop_head(&ctx.event_free_queue));
+
+    ctx.used_event_count += count;
+    if (ctx.used_event_count > ctx.used_event_count_max)
+        ctx.used_event_count_max = ctx.used_event_count;
+
     fwk_interrupt_global_enable();
+
+    return true;
 }
 
 /*
@@ -91,11 +221,7 @@ static struct fwk_event *duplicate_event(struct fwk_event *event)
 
     assert(event != NULL);
 
-    fwk_interrupt_global_disable();
-    allocated_event = FWK_LIST_GET(fwk_list_pop_head(&ctx.event_free_queue),
-                                   struct fwk_event, slist_node);
-    fwk_interrupt_global_enable();
-
+    allocated_event = allocate_event();
     if (allocated_event != NULL) {
         *allocated_event = *event;
 
@@ -109,6 +235,38 @@ static struct fwk_event *duplicate_event(struct fwk_event *event)
     return NULL;
 }
 
+/*
+ * Remove from an event queue the event superseded by a new event, if any.
+ *
+ * \param queue Pointer to the event queue.
+ * \param event Pointer to the new event.
+ *
+ * \return The pointer to the superseded event, NULL if there is none.
+ */
+static struct fwk_event *remove_superseded_event(struct fwk_slist *queue,
+                                                 const struct fwk_event *event)
+{
+    struct fwk_slist_node *node;
+    struct fwk_event *queued_event;
+
+    if (!event->supersedes || event->is_notification)
+        return NULL;
+
+    for (node = fwk_list_head(queue); node != NULL;
+         node = fwk_list_next(queue, node)) {
+        queued_event = FWK_LIST_GET(node, struct fwk_event, slist_node);
+        if (queued_event->supersedes && !queued_event->is_notification &&
+            fwk_id_is_equal(queued_event->id, event->id) &&
+            fwk_id_is_equal(queued_event->source_id, event->source_id) &&
+            fwk_id_is_equal(queued_event->target_id, event->target_id)) {
+            fwk_list_remove(queue, node);
+            return queued_event;
+        }
+    }
+
+    return NULL;
+}
+
 /*
  * Get the thread context of a given module or element.
  *
@@ -139,20 +297,16 @@ static struct __fwk_thread_ctx *thread_get_ctx(fwk_id_t id)
 }
 
 /*
- * Get the list of delayed responses for a given module or element.
- *
- * \note The function assumes the validity of all its input parameters.
+ * Get the list of delayed responses a delayed response is linked to.
  *
- * \param id Identifier of the module or element.
+ * \param cookie Cookie of the delayed response.
  *
- * \return A pointer to the list of subscriptions.
+ * \return A pointer to the list of delayed responses.
  */
-static struct fwk_slist *get_delayed_response_list(fwk_id_t id)
+static struct fwk_slist *get_delayed_response_list(uint32_t cookie)
 {
-    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
-        return &__fwk_module_get_ctx(id)->delayed_response_list;
-
-    return &__fwk_module_get_element_ctx(id)->delayed_response_list;
+    return &ctx.delayed_response_table[
+        cookie % FWK_DELAYED_RESPONSE_LIST_COUNT];
 }
 
 /*
@@ -173,13 +327,14 @@ static struct fwk_event *search_delayed_response(fwk_id_t id, uint32_t cookie)
     struct fwk_slist_node *delayed_response_node;
     struct fwk_event *delayed_response;
 
-    delayed_response_list = get_delayed_response_list(id);
+    delayed_response_list = get_delayed_response_list(cookie);
     delayed_response_node = fwk_list_head(delayed_response_list);
 
     while (delayed_response_node != NULL) {
         delayed_response = FWK_LIST_GET(delayed_response_node,
                                         struct fwk_event, slist_node);
-        if (delayed_response->cookie == cookie)
+        if ((delayed_response->cookie == cookie) &&
+            fwk_id_is_equal(delayed_response->source_id, id))
             return delayed_response;
 
         delayed_response_node = fwk_list_next(delayed_response_list,
@@ -189,6 +344,101 @@ static struct fwk_event *search_delayed_response(fwk_id_t id, uint32_t cookie)
     return NULL;
 }
 
+/*
+ * Append an event to the queue of ISR events.
+ *
+ * The queue may be appended to by ISRs of any priority, preempting one another,
+ * while the common thread takes events out of it. It is thus updated without
+ * masking the interrupts: the tail of the queue is swapped atomically with the
+ * new event, then the event is linked to the previous tail, or becomes the
+ * head of the queue if the queue was empty.
+ *
+ * \param event Pointer to the event.
+ */
+static void isr_event_queue_push(struct fwk_event *event)
+{
+    struct fwk_slist_node *sentinel, *prev;
+
+    sentinel = (struct fwk_slist_node *)&ctx.event_isr_queue;
+
+    event->slist_node.next = sentinel;
+    prev = __atomic_exchange_n(&ctx.event_isr_queue.tail, &event->slist_node,
+                               __ATOMIC_SEQ_CST);
+    __atomic_store_n(&prev->next, &event->slist_node, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Take the first event out of the queue of ISR events.
+ *
+ * This function must only be called by the common thread.
+ *
+ * \return The pointer to the event, NULL if the queue is empty or if the only
+ *      event of the queue is still being appended to by an ISR. In the latter
+ *      case, the ISR signals the common thread once the event is appended.
+ */
+static struct fwk_event *isr_event_queue_pop(void)
+{
+    struct fwk_slist_node *sentinel, *head, *next, *expected;
+
+    sentinel = (struct fwk_slist_node *)&ctx.event_isr_queue;
+
+    head = __atomic_load_n(&ctx.event_isr_queue.head, __ATOMIC_SEQ_CST);
+    if (head == sentinel)
+        return NULL;
+
+    next = __atomic_load_n(&head->next, __ATOMIC_SEQ_CST);
+    if (next != sentinel)
+        __atomic_store_n(&ctx.event_isr_queue.head, next, __ATOMIC_SEQ_CST);
+    else {
+        /* Empty the queue unless an ISR is appending an event to it */
+        expected = head;
+        if (!__atomic_compare_exchange_n(&ctx.event_isr_queue.tail, &expected,
+                                         sentinel, false, __ATOMIC_SEQ_CST,
+                                         __ATOMIC_SEQ_CST))
+            return NULL;
+
+        /* An ISR may have made a new event the head of the queue meanwhile */
+        expected = head;
+        __atomic_compare_exchange_n(&ctx.event_isr_queue.head, &expected,
+                                    sentinel, false, __ATOMIC_SEQ_CST,
+                                    __ATOMIC_SEQ_CST);
+    }
+
+    head->next = NULL;
+
+    return FWK_LIST_GET(head, struct fwk_event, slist_node);
+}
+
+/*
+ * Signal the common thread that ISR events have been appended to the queue of
+ * ISR events, if it is waiting for them.
+ *
+ * The events are appended before checking whether the common thread is
+ * waiting for an ISR event, and the common thread flags that it is waiting
+ * before checking a last time that the queue is empty. Either the common
+ * thread finds the events, or it is signalled.
+ *
+ * \retval FWK_SUCCESS The common thread was signalled if needed.
+ * \retval FWK_E_OS The common thread could not be signalled.
+ */
+static int signal_isr_event(void)
+{
+    uint32_t flags;
+
+    if (!__atomic_load_n(&ctx.waiting_for_isr_event, __ATOMIC_SEQ_CST))
+        return FWK_SUCCESS;
+
+    flags = osThreadFlagsSet(ctx.common_thread_ctx.os_thread_id,
+                             SIGNAL_ISR_EVENT);
+    if ((int32_t)flags < 0) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_OS, __func__);
+        return FWK_E_OS;
+    }
+    __atomic_store_n(&ctx.waiting_for_isr_event, false, __ATOMIC_SEQ_CST);
+
+    return FWK_SUCCESS;
+}
+
 /*
  * Put an event in the ISR event queue.
  *
@@ -203,35 +453,22 @@ static struct fwk_event *search_delayed_response(fwk_id_t id, uint32_t cookie)
 static int put_isr_event(struct fwk_event *event)
 {
     struct fwk_event *allocated_event;
-    uint32_t flags;
 
     allocated_event = duplicate_event(event);
     if (allocated_event == NULL)
         return FWK_E_NOMEM;
 
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_queue(allocated_event);
+    #endif
+
     FWK_HOST_PRINT("[THR] Add ISR event (%s,%s,%s)\n",
                    FWK_ID_STR(event->source_id),
                    FWK_ID_STR(event->target_id), FWK_ID_STR(event->id));
 
-    /*
-     * Assumption: there are no interrupt priorities, at least among interrupts
-     * leading to the call of fwk_thread_put_event(). As a consequence the
-     * access to the ISR queue of events is not protected here against
-     * concurrent accesses, as this function should only be executed from within
-     * an interrupt context.
-     */
-    fwk_list_push_tail(&ctx.event_isr_queue, &allocated_event->slist_node);
-    if (ctx.waiting_for_isr_event) {
-        flags = osThreadFlagsSet(ctx.common_thread_ctx.os_thread_id,
-                                 SIGNAL_ISR_EVENT);
-        if ((int32_t)flags < 0) {
-            FWK_HOST_PRINT(err_msg_func, FWK_E_OS, __func__);
-            return FWK_E_OS;
-        }
-        ctx.waiting_for_isr_event = false;
-    }
+    isr_event_queue_push(allocated_event);
 
-    return FWK_SUCCESS;
+    return signal_isr_event();
 }
 
 /*
@@ -258,13 +495,54 @@ static bool is_thread_wakeup_event(struct __fwk_thread_ctx *thread_ctx,
     return thread_ctx->response_event->cookie == event->cookie;
 }
 
+/*
+ * Link an event structure owned by the framework to a thread queue.
+ *
+ * If the thread queue was empty, the thread is added at the end of the list
+ * of threads having at least one event pending in its event queue.
+ *
+ * \param target_thread_ctx Pointer to the context of the thread target of the
+ *      event.
+ * \param event Pointer to the event to link, its cookie being set.
+ */
+static void link_event(struct __fwk_thread_ctx *target_thread_ctx,
+                       struct fwk_event *event)
+{
+    struct fwk_event *superseded_event;
+    bool is_empty;
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_queue(event);
+    #endif
+
+    if (event->is_thread_wakeup_event) {
+        fwk_list_push_head(&target_thread_ctx->event_queue,
+                           &event->slist_node);
+        fwk_list_push_head(&ctx.thread_ready_queue,
+                           &target_thread_ctx->slist_node);
+    } else {
+        is_empty = fwk_list_is_empty(&target_thread_ctx->event_queue);
+        superseded_event = remove_superseded_event(
+            &target_thread_ctx->event_queue, event);
+        fwk_list_push_tail(&target_thread_ctx->event_queue,
+                           &event->slist_node);
+        if (superseded_event != NULL)
+            free_event(superseded_event);
+
+        if (is_empty &&
+            (target_thread_ctx != ctx.current_thread_ctx) &&
+            (!(target_thread_ctx->waiting_event_processing_completion)) &&
+            (!(target_thread_ctx->processing_in_calling_thread)))
+            fwk_list_push_tail(&ctx.thread_ready_queue,
+                               &target_thread_ctx->slist_node);
+    }
+}
+
 /*
  * Put an event in a thread queue.
  *
  * This function is a sub-routine of the fwk_thread_put_event() and
- * fwk_thread_put_event_and_wait() interface functions. If the thread queue was
- * empty, the thread is added at the end of the list of threads having at least
- * one event pending in its event queue.
+ * fwk_thread_put_event_and_wait() interface functions.
  *
  * \param thread_ctx Pointer to the context of the thread target of the event.
  * \param event Pointer to the event to queue.
@@ -272,12 +550,11 @@ static bool is_thread_wakeup_event(struct __fwk_thread_ctx *thread_ctx,
  * \retval FWK_SUCCESS The event was put successfully.
  * \retval FWK_E_PARAM The event source is not valid.
  */
-static int put_event(struct __fwk_thread_ctx *target_thread_ctx,
-                     struct fwk_event *event)
+static FWK_HOT int put_event(struct __fwk_thread_ctx *target_thread_ctx,
+                             struct fwk_event *event)
 {
     int status = FWK_E_PARAM;
     struct fwk_event *allocated_event;
-    bool is_empty;
 
     FWK_HOST_PRINT("[THR] Add event to thread queue (%s,%s,%s)\n",
                    FWK_ID_STR(event->source_id), FWK_ID_STR(event->target_id),
@@ -292,7 +569,7 @@ static int put_event(struct __fwk_thread_ctx *target_thread_ctx,
         if (allocated_event == NULL)
             goto error;
 
-        fwk_list_remove(get_delayed_response_list(event->source_id),
+        fwk_list_remove(get_delayed_response_list(event->cookie),
             &allocated_event->slist_node);
 
         memcpy(allocated_event->params, event->params,
@@ -306,22 +583,7 @@ static int put_event(struct __fwk_thread_ctx *target_thread_ctx,
 
     allocated_event->cookie = event->cookie = ctx.event_cookie_counter++;
 
-    if (allocated_event->is_thread_wakeup_event) {
-        fwk_list_push_head(&target_thread_ctx->event_queue,
-                           &allocated_event->slist_node);
-        fwk_list_push_head(&ctx.thread_ready_queue,
-                           &target_thread_ctx->slist_node);
-    } else {
-        is_empty = fwk_list_is_empty(&target_thread_ctx->event_queue);
-        fwk_list_push_tail(&target_thread_ctx->event_queue,
-                           &allocated_event->slist_node);
-
-        if (is_empty &&
-            (target_thread_ctx != ctx.current_thread_ctx) &&
-            (!(target_thread_ctx->waiting_event_processing_completion)))
-            fwk_list_push_tail(&ctx.thread_ready_queue,
-                               &target_thread_ctx->slist_node);
-    }
+    link_event(target_thread_ctx, allocated_event);
 
     return FWK_SUCCESS;
 
@@ -330,6 +592,63 @@ error:
     return status;
 }
 
+/*
+ * Check the validity of an event issued by a module.
+ *
+ * \note The source identifier of the event is populated with the identifier
+ *      of the entity processing the current event if any.
+ *
+ * \param event Pointer to the event.
+ *
+ * \retval FWK_SUCCESS The event is valid.
+ * \retval FWK_E_PARAM One or more fields of the event are not valid.
+ */
+static int check_event(struct fwk_event *event)
+{
+    unsigned int interrupt;
+
+    if (thread_get_ctx(event->target_id) == NULL)
+        return FWK_E_PARAM;
+
+    if ((fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) &&
+        (ctx.current_event != NULL))
+        event->source_id = ctx.current_event->target_id;
+    else {
+        if (!fwk_module_is_valid_entity_id(event->source_id))
+            return FWK_E_PARAM;
+    }
+
+    if (event->supersedes &&
+        (event->is_response || event->response_requested))
+        return FWK_E_PARAM;
+
+    if (event->is_notification) {
+        if (!fwk_module_is_valid_notification_id(event->id))
+            return FWK_E_PARAM;
+        if ((!event->is_response) || (event->response_requested))
+            return FWK_E_PARAM;
+        if (fwk_id_get_module_idx(event->target_id) !=
+            fwk_id_get_module_idx(event->id))
+            return FWK_E_PARAM;
+    } else {
+        if (!fwk_module_is_valid_event_id(event->id))
+            return FWK_E_PARAM;
+        if (event->is_response) {
+            if (fwk_id_get_module_idx(event->source_id) !=
+                fwk_id_get_module_idx(event->id))
+                return FWK_E_PARAM;
+            if (event->response_requested)
+                return FWK_E_PARAM;
+        } else {
+            if (fwk_id_get_module_idx(event->target_id) !=
+                fwk_id_get_module_idx(event->id))
+                return FWK_E_PARAM;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 /*
  * Process event requiring a response
  *
@@ -368,12 +687,33 @@ static void process_event_requiring_response(struct fwk_event *event)
     else {
         allocated_event = duplicate_event(&resp_event);
         if (allocated_event != NULL) {
-            fwk_list_push_tail(get_delayed_response_list(resp_event.source_id),
+            fwk_list_push_tail(get_delayed_response_list(resp_event.cookie),
                                &allocated_event->slist_node);
         }
     }
 }
 
+/*
+ * Check whether an event has to be delivered to its target.
+ *
+ * This function is a sub-routine of process_next_thread_event().
+ *
+ * \param event Pointer to the current event.
+ *
+ * \retval true The event has to be delivered.
+ * \retval false The event is a response to a notification whose responses are
+ *      collected by the framework, and not the last one.
+ */
+static bool is_delivered(struct fwk_event *event)
+{
+    #ifdef BUILD_HAS_NOTIFICATION
+    if (event->is_response && event->is_notification)
+        return __fwk_notification_collect_response(event);
+    #endif
+
+    return true;
+}
+
 /*
  * Process the next event of a given thread.
  *
@@ -382,11 +722,15 @@ static void process_event_requiring_response(struct fwk_event *event)
  * \param thread_ctx Pointer to the context of the thread, the next event of
  *     which has to be processed.
  */
-static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
+static FWK_HOT void process_next_thread_event(
+    struct __fwk_thread_ctx *thread_ctx)
 {
     int status;
     struct fwk_event *event, async_resp_event;
     const struct fwk_module *module;
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
 
     /*
      * Extract the event from the thread event queue and update the pointer to
@@ -403,9 +747,15 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
                    FWK_ID_STR(event->source_id),
                    FWK_ID_STR(event->target_id), FWK_ID_STR(event->id));
 
+    FWK_TRACE(FWK_TRACE_ID_EVENT_START, event->id.value);
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    start = __fwk_thread_profile_start();
+    #endif
+
     if (event->response_requested)
         process_event_requiring_response(event);
-    else {
+    else if (is_delivered(event)) {
         module = __fwk_module_get_ctx(event->target_id)->desc;
         if (event->is_notification)
             status = module->process_notification(event, &async_resp_event);
@@ -415,6 +765,12 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
             FWK_HOST_PRINT(err_msg_line, status, __LINE__);
     }
 
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_end(event, start);
+    #endif
+
+    FWK_TRACE(FWK_TRACE_ID_EVENT_END, event->target_id.value);
+
     /* No event currently processed, no thread currently active. */
     ctx.current_event = NULL;
     ctx.current_thread_ctx = NULL;
@@ -425,6 +781,136 @@ static void process_next_thread_event(struct __fwk_thread_ctx *thread_ctx)
         fwk_list_push_tail(&ctx.thread_ready_queue, &thread_ctx->slist_node);
 }
 
+/*
+ * Process an event requiring a response within the calling thread.
+ *
+ * This function is a sub-routine of fwk_thread_put_event_and_wait(). It is
+ * called when the thread of the target of the event is idle: the event is
+ * processed straight away on the stack of the calling thread rather than
+ * being duplicated into the target thread queue, saving the switches to the
+ * target thread and back.
+ *
+ * \param target_thread_ctx Pointer to the context of the thread of the target
+ *     of the event.
+ * \param event Pointer to the event to process.
+ * \param[out] resp_event Pointer to the storage for the response event.
+ *
+ * \retval true The target delayed the response. It has been saved in the
+ *     list of delayed responses and the calling thread has to wait for it.
+ * \retval false The response has been written to \p resp_event.
+ */
+static bool process_event_in_calling_thread(
+    struct __fwk_thread_ctx *target_thread_ctx,
+    struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+    const struct fwk_module *module;
+    struct fwk_event *processed_event, *allocated_event;
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
+
+    FWK_HOST_PRINT("[THR] Process event in calling thread (%s,%s,%s)\n",
+                   FWK_ID_STR(event->source_id),
+                   FWK_ID_STR(event->target_id), FWK_ID_STR(event->id));
+
+    module = __fwk_module_get_ctx(event->target_id)->desc;
+
+    event->cookie = ctx.event_cookie_counter++;
+
+    *resp_event = *event;
+    resp_event->source_id = event->target_id;
+    resp_event->target_id = event->source_id;
+    resp_event->is_delayed_response = false;
+
+    processed_event = ctx.current_event;
+    ctx.current_event = event;
+    target_thread_ctx->processing_in_calling_thread = true;
+
+    FWK_TRACE(FWK_TRACE_ID_EVENT_START, event->id.value);
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    start = __fwk_thread_profile_start();
+
+    /* The event is not queued */
+    event->queue_timestamp = start;
+    #endif
+
+    status = module->process_event(event, resp_event);
+    if (status != FWK_SUCCESS)
+        FWK_HOST_PRINT(err_msg_line, status, __LINE__);
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_end(event, start);
+    #endif
+
+    FWK_TRACE(FWK_TRACE_ID_EVENT_END, event->target_id.value);
+
+    target_thread_ctx->processing_in_calling_thread = false;
+    ctx.current_event = processed_event;
+
+    /* Events sent to the target in the meantime are now ready to process */
+    if (!fwk_list_is_empty(&target_thread_ctx->event_queue)) {
+        fwk_list_push_tail(&ctx.thread_ready_queue,
+                           &target_thread_ctx->slist_node);
+    }
+
+    resp_event->is_response = true;
+    resp_event->response_requested = false;
+    if (!resp_event->is_delayed_response)
+        return false;
+
+    allocated_event = duplicate_event(resp_event);
+    if (allocated_event != NULL) {
+        fwk_list_push_tail(get_delayed_response_list(resp_event->cookie),
+                           &allocated_event->slist_node);
+    }
+
+    return true;
+}
+
+/*
+ * Take the next thread to process an event out of the queue of ready threads.
+ *
+ * A thread woken up by the response it was waiting for is at the head of the
+ * queue and is always taken first. Otherwise the thread with the highest
+ * priority is taken, the threads of equal priority being taken in the order
+ * they became ready.
+ *
+ * \pre The queue of ready threads must not be empty.
+ *
+ * \return Pointer to the context of the thread.
+ */
+static struct __fwk_thread_ctx *pop_next_ready_thread(void)
+{
+    struct fwk_slist_node *node;
+    struct __fwk_thread_ctx *thread_ctx, *next_thread_ctx;
+
+    next_thread_ctx = FWK_LIST_GET(fwk_list_head(&ctx.thread_ready_queue),
+                                   struct __fwk_thread_ctx, slist_node);
+
+    /*
+     * A thread waiting for the completion of an event processing is in the
+     * queue of ready threads only once its wake-up event has been queued.
+     */
+    if (!next_thread_ctx->waiting_event_processing_completion) {
+        for (node = fwk_list_next(&ctx.thread_ready_queue,
+                                  &next_thread_ctx->slist_node);
+             node != NULL;
+             node = fwk_list_next(&ctx.thread_ready_queue, node)) {
+            thread_ctx = FWK_LIST_GET(node, struct __fwk_thread_ctx,
+                                      slist_node);
+            if (thread_ctx->priority > next_thread_ctx->priority)
+                next_thread_ctx = thread_ctx;
+        }
+    }
+
+    fwk_list_remove(&ctx.thread_ready_queue, &next_thread_ctx->slist_node);
+
+    return next_thread_ctx;
+}
+
 /*
  * Launch the processing of the next event.
  *
@@ -446,9 +932,7 @@ static struct __fwk_thread_ctx *launch_next_event_processing(
     struct fwk_event *event;
 
     while (!fwk_list_is_empty(&ctx.thread_ready_queue)) {
-        next_thread_ctx = FWK_LIST_GET(
-            fwk_list_pop_head(&ctx.thread_ready_queue),
-            struct __fwk_thread_ctx, slist_node);
+        next_thread_ctx = pop_next_ready_thread();
 
         if (next_thread_ctx == current_thread_ctx)
             return current_thread_ctx;
@@ -558,27 +1042,29 @@ static void specific_thread_function(void *arg)
 static void get_next_isr_event(void)
 {
     uint32_t flags;
-    struct fwk_event *isr_event;
+    struct fwk_event *isr_event, *superseded_event;
     struct __fwk_thread_ctx *target_thread_ctx;
 
     for (;;) {
-        fwk_interrupt_global_disable();
-        if (fwk_list_is_empty(&ctx.event_isr_queue)) {
-            /* Wait for an ISR event. */
-            ctx.waiting_for_isr_event = true;
-            fwk_interrupt_global_enable();
-            flags = osThreadFlagsWait(
-                SIGNAL_ISR_EVENT, osFlagsWaitAll, osWaitForever);
-            if (flags != SIGNAL_ISR_EVENT)
-                FWK_HOST_PRINT(err_msg_line, FWK_E_OS, __LINE__);
-            continue;
-        }
+        isr_event = isr_event_queue_pop();
+        if (isr_event == NULL) {
+            __atomic_store_n(&ctx.waiting_for_isr_event, true,
+                             __ATOMIC_SEQ_CST);
+
+            isr_event = isr_event_queue_pop();
+            if (isr_event == NULL) {
+                /* Wait for an ISR event. */
+                flags = osThreadFlagsWait(
+                    SIGNAL_ISR_EVENT, osFlagsWaitAll, osWaitForever);
+                if (flags != SIGNAL_ISR_EVENT)
+                    FWK_HOST_PRINT(err_msg_line, FWK_E_OS, __LINE__);
+                continue;
+            }
 
-        isr_event = FWK_LIST_GET(fwk_list_pop_head(&ctx.event_isr_queue),
-                                 struct fwk_event, slist_node);
-        fwk_interrupt_global_enable();
+            __atomic_store_n(&ctx.waiting_for_isr_event, false,
+                             __ATOMIC_SEQ_CST);
+        }
 
-        assert(isr_event != NULL);
         FWK_HOST_PRINT("[THR] Get ISR event (%s,%s,%s)\n",
                        FWK_ID_STR(isr_event->source_id),
                        FWK_ID_STR(isr_event->target_id),
@@ -594,8 +1080,12 @@ static void get_next_isr_event(void)
             fwk_list_push_head(&target_thread_ctx->event_queue,
                                &isr_event->slist_node);
         } else {
+            superseded_event = remove_superseded_event(
+                &target_thread_ctx->event_queue, isr_event);
             fwk_list_push_tail(&target_thread_ctx->event_queue,
                                &isr_event->slist_node);
+            if (superseded_event != NULL)
+                free_event(superseded_event);
         }
 
         if (!(target_thread_ctx->waiting_event_processing_completion) ||
@@ -632,6 +1122,7 @@ int __fwk_thread_init(size_t event_count)
     int status;
     struct fwk_event *event_table, *event_table_end, *event;
     osThreadAttr_t thread_attr;
+    unsigned int list_idx;
 
     fwk_interrupt_global_enable();
     status = osKernelInitialize();
@@ -640,7 +1131,7 @@ int __fwk_thread_init(size_t event_count)
         goto error;
     }
 
-    event_table = fwk_mm_calloc(event_count, sizeof(struct fwk_event));
+    event_table = fwk_mm_calloc_hot(event_count, sizeof(struct fwk_event));
     if (event_table == NULL) {
         status = FWK_E_NOMEM;
         goto error;
@@ -649,14 +1140,20 @@ int __fwk_thread_init(size_t event_count)
     /* All the event structures are free to be used. */
     fwk_list_init(&ctx.event_free_queue);
     fwk_list_init(&(ctx.thread_ready_queue));
+    fwk_list_init(&(ctx.thread_list));
     fwk_list_init(&(ctx.event_isr_queue));
     fwk_list_init(&(ctx.common_thread_ctx.event_queue));
+    for (list_idx = 0; list_idx < FWK_DELAYED_RESPONSE_LIST_COUNT; list_idx++)
+        fwk_list_init(&ctx.delayed_response_table[list_idx]);
     for (event = event_table, event_table_end = event_table + event_count;
          event < event_table_end; event++)
         fwk_list_push_tail(&ctx.event_free_queue,
                            &event->slist_node);
+    ctx.event_count = event_count;
+    ctx.used_event_count = 0;
+    ctx.used_event_count_max = 0;
 
-    status = init_thread_attr(&thread_attr);
+    status = init_thread_attr(&thread_attr, 0, 0);
     if (status != FWK_SUCCESS)
         goto error;
 
@@ -666,6 +1163,7 @@ int __fwk_thread_init(size_t event_count)
         status = FWK_E_OS;
         goto error;
     }
+    add_thread(&ctx.common_thread_ctx, &thread_attr);
 
     ctx.initialized = true;
 
@@ -724,6 +1222,7 @@ int fwk_thread_create(fwk_id_t id)
 {
     int status;
     struct __fwk_thread_ctx **p_thread_ctx, *thread_ctx;
+    const struct fwk_module_config *config;
     osThreadAttr_t thread_attr;
 
     if (!ctx.initialized) {
@@ -740,7 +1239,14 @@ int fwk_thread_create(fwk_id_t id)
         goto error;
     }
 
-    status = init_thread_attr(&thread_attr);
+    config = __fwk_module_get_ctx(id)->config;
+    if (config->thread_priority > FWK_MODULE_THREAD_PRIORITY_MAX) {
+        status = FWK_E_PARAM;
+        goto error;
+    }
+
+    status = init_thread_attr(&thread_attr, config->thread_priority,
+                              config->thread_stack_size);
     if (status != FWK_SUCCESS)
         goto error;
 
@@ -757,12 +1263,14 @@ int fwk_thread_create(fwk_id_t id)
 
     fwk_list_init(&thread_ctx->event_queue);
     thread_ctx->id = id;
+    thread_ctx->priority = config->thread_priority;
     thread_ctx->os_thread_id = osThreadNew(specific_thread_function, thread_ctx,
                                            &thread_attr);
     if (thread_ctx->os_thread_id == NULL) {
         status = FWK_E_OS;
         goto error;
     }
+    add_thread(thread_ctx, &thread_attr);
 
     *p_thread_ctx = thread_ctx;
 
@@ -776,7 +1284,6 @@ error:
 int fwk_thread_put_event(struct fwk_event *event)
 {
     int status = FWK_E_PARAM;
-    struct __fwk_thread_ctx *thread_ctx;
     unsigned int interrupt;
 
     if (!ctx.initialized) {
@@ -787,56 +1294,184 @@ int fwk_thread_put_event(struct fwk_event *event)
     if (event == NULL)
         goto error;
 
-    thread_ctx = thread_get_ctx(event->target_id);
-    if (thread_ctx == NULL)
+    status = check_event(event);
+    if (status != FWK_SUCCESS)
         goto error;
 
-    if ((fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) &&
-        (ctx.current_event != NULL))
-        event->source_id = ctx.current_event->target_id;
-    else {
-        if (!fwk_module_is_valid_entity_id(event->source_id))
-            goto error;
+    /* Call from a thread */
+    if (fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) {
+        event->is_delayed_response = event->is_response;
+        return put_event(thread_get_ctx(event->target_id), event);
     }
 
-    if (event->is_notification) {
-        if (!fwk_module_is_valid_notification_id(event->id))
-            goto error;
-        if ((!event->is_response) || (event->response_requested))
+    /* Call from an ISR */
+    return put_isr_event(event);
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_put_events(struct fwk_event *events, unsigned int count)
+{
+    int status = FWK_E_PARAM;
+    unsigned int interrupt, idx;
+    bool is_isr;
+    struct fwk_slist allocated_events;
+    struct fwk_event *event, *allocated_event;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (events == NULL)
+        goto error;
+
+    for (idx = 0; idx < count; idx++) {
+        if (events[idx].is_response) {
+            status = FWK_E_PARAM;
             goto error;
-        if (fwk_id_get_module_idx(event->target_id) !=
-            fwk_id_get_module_idx(event->id))
-             goto error;
-    } else {
-        if (!fwk_module_is_valid_event_id(event->id))
+        }
+
+        status = check_event(&events[idx]);
+        if (status != FWK_SUCCESS)
             goto error;
-        if (event->is_response) {
-            if (fwk_id_get_module_idx(event->source_id) !=
-                fwk_id_get_module_idx(event->id))
-                goto error;
-            if (event->response_requested)
-                goto error;
+    }
+
+    fwk_list_init(&allocated_events);
+    if (!allocate_events(&allocated_events, count)) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    is_isr = (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS);
+
+    for (idx = 0; idx < count; idx++) {
+        event = &events[idx];
+        allocated_event = FWK_LIST_GET(fwk_list_pop_head(&allocated_events),
+                                       struct fwk_event, slist_node);
+        *allocated_event = *event;
+        allocated_event->slist_node = (struct fwk_slist_node) { 0 };
+        allocated_event->is_delayed_response = false;
+        allocated_event->is_thread_wakeup_event = false;
+
+        if (is_isr) {
+            #ifdef BUILD_HAS_EVENT_PROFILING
+            __fwk_thread_profile_queue(allocated_event);
+            #endif
+            isr_event_queue_push(allocated_event);
         } else {
-            if (fwk_id_get_module_idx(event->target_id) !=
-                fwk_id_get_module_idx(event->id))
-                goto error;
+            allocated_event->cookie = event->cookie =
+                ctx.event_cookie_counter++;
+            link_event(thread_get_ctx(event->target_id), allocated_event);
         }
     }
 
-    /* Call from a thread */
-    if (fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) {
-        event->is_delayed_response = event->is_response;
-        return put_event(thread_ctx, event);
+    /* The common thread is signalled once for the whole batch */
+    if (is_isr)
+        return signal_isr_event();
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_get_event_pool_stats(struct fwk_thread_event_pool_stats *stats)
+{
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
     }
 
-    /* Call from an ISR */
-    return put_isr_event(event);
+    if (stats == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_PARAM, __func__);
+        return FWK_E_PARAM;
+    }
+
+    fwk_interrupt_global_disable();
+    stats->size = ctx.event_count;
+    stats->used = ctx.used_event_count;
+    stats->used_max = ctx.used_event_count_max;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+int fwk_thread_reserve_event(struct fwk_event **event)
+{
+    int status = FWK_E_PARAM;
+    struct fwk_event *reserved_event;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (event == NULL)
+        goto error;
+
+    reserved_event = allocate_event();
+    if (reserved_event == NULL) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    *reserved_event = (struct fwk_event) { 0 };
+    *event = reserved_event;
+
+    return FWK_SUCCESS;
 
 error:
     FWK_HOST_PRINT(err_msg_func, status, __func__);
     return status;
 }
 
+int fwk_thread_commit_event(struct fwk_event *event)
+{
+    int status;
+
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    if (event == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_PARAM, __func__);
+        return FWK_E_PARAM;
+    }
+
+    /*
+     * The event may be a delayed response or target a thread waiting for its
+     * completion, both of which are queued through dedicated event structures.
+     * The reserved structure is thus copied and released.
+     */
+    status = fwk_thread_put_event(event);
+    free_event(event);
+
+    return status;
+}
+
+int fwk_thread_cancel_event(struct fwk_event *event)
+{
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    if (event == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_PARAM, __func__);
+        return FWK_E_PARAM;
+    }
+
+    event->slist_node = (struct fwk_slist_node) { 0 };
+    free_event(event);
+
+    return FWK_SUCCESS;
+}
+
 int fwk_thread_put_event_and_wait(struct fwk_event *event,
                                   struct fwk_event *resp_event)
 {
@@ -878,9 +1513,23 @@ int fwk_thread_put_event_and_wait(struct fwk_event *event,
     event->is_delayed_response = false;
     event->response_requested = true;
     event->is_notification = false;
-    status = put_event(target_thread_ctx, event);
-    if (status != FWK_SUCCESS)
-        return status;
+    event->supersedes = false;
+
+    /*
+     * If the target thread is idle, there is no need to go through its event
+     * queue and to switch to it: process the event within the calling thread.
+     */
+    if (fwk_list_is_empty(&target_thread_ctx->event_queue) &&
+        (!target_thread_ctx->waiting_event_processing_completion) &&
+        (!target_thread_ctx->processing_in_calling_thread)) {
+        if (!process_event_in_calling_thread(target_thread_ctx, event,
+                                             resp_event))
+            return FWK_SUCCESS;
+    } else {
+        status = put_event(target_thread_ctx, event);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 
     resp_event->cookie = event->cookie;
     ctx.current_thread_ctx->response_event = resp_event;
@@ -953,3 +1602,51 @@ error:
     FWK_HOST_PRINT(err_msg_func, status, __func__);
     return status;
 }
+
+int fwk_thread_get_stack_info(unsigned int index,
+                              struct fwk_thread_stack_info *info)
+{
+    int status;
+    struct fwk_slist_node *node;
+    struct __fwk_thread_ctx *thread_ctx;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (info == NULL) {
+        status = FWK_E_PARAM;
+        goto error;
+    }
+
+    for (node = fwk_list_head(&ctx.thread_list);
+         (node != NULL) && (index > 0);
+         node = fwk_list_next(&ctx.thread_list, node))
+        index--;
+
+    if (node == NULL) {
+        status = FWK_E_RANGE;
+        goto error;
+    }
+
+    thread_ctx = FWK_LIST_GET(node, struct __fwk_thread_ctx, thread_list_node);
+
+    info->guard = thread_ctx->stack_guard;
+    info->size = thread_ctx->stack_size;
+    info->max_used = get_stack_max_used(thread_ctx);
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+void fwk_thread_wait_for_interrupt(void)
+{
+    /* The kernel cannot be called with the interrupts disabled */
+    fwk_interrupt_global_enable();
+    osThreadYield();
+    fwk_interrupt_global_disable();
+}
@@ -8,6 +8,7 @@
  *     Notification facilities.
  */
 
+#include <stdbool.h>
 #include <fwk_assert.h>
 #include <fwk_host.h>
 #include <fwk_interrupt.h>
@@ -17,6 +18,24 @@
 #include <internal/fwk_notification.h>
 #include <internal/fwk_thread.h>
 
+/* Number of notifications whose responses can be collected at a time */
+#define NOTIFICATION_COLLECTION_COUNT 8
+
+/* Responses being collected for a notification */
+struct notification_collection {
+    /* Identifier of the notification */
+    fwk_id_t notification_id;
+
+    /* Identifier of the notification source entity */
+    fwk_id_t source_id;
+
+    /* Number of pending responses, zero if the structure is free */
+    unsigned int pending_responses;
+
+    /* First failure status among the responses, FWK_SUCCESS if none */
+    int status;
+};
+
 struct notification_ctx {
     /*
      * Flag indicating whether the notification framework component is
@@ -28,10 +47,17 @@ struct notification_ctx {
      * Queue of notification subscription structures that are free.
      */
     struct fwk_dlist free_subscription_dlist;
+
+    /* Notifications whose responses are being collected */
+    struct notification_collection
+        collection_table[NOTIFICATION_COLLECTION_COUNT];
 };
 
 static struct notification_ctx ctx;
 
+extern const struct fwk_notification_static_subscription
+    module_static_subscription_table[];
+
 #ifdef BUILD_HOST
 static const char err_msg_func[] = "[NOT] Error %d in %s\n";
 #endif
@@ -67,6 +93,25 @@ static struct fwk_dlist *get_subscription_dlist(
                fwk_id_get_notification_idx(notification_id)];
 }
 
+/*
+ * Check whether the subscriptions of a list may be associated with different
+ * sources.
+ *
+ * \details The subscription lists are indexed by notification and source
+ *      module or element. The sub-elements of an element have no context of
+ *      their own and share the lists of their element, thus the sources of the
+ *      subscriptions only need to be compared for them.
+ *
+ * \param source_id Identifier of the emitter of the notification.
+ *
+ * \retval true The subscriptions of the list have to be filtered by source.
+ * \retval false All the subscriptions of the list are for \p source_id.
+ */
+static bool is_subscription_dlist_shared(fwk_id_t source_id)
+{
+    return fwk_id_is_type(source_id, FWK_ID_TYPE_SUB_ELEMENT);
+}
+
 /*
  * Search for a subscription with a given source and target identifier in a list
  * of subscriptions.
@@ -87,20 +132,86 @@ static struct __fwk_notification_subscription *search_subscription(
 {
     struct fwk_dlist_node *node;
     struct __fwk_notification_subscription *subscription;
+    bool check_source = is_subscription_dlist_shared(source_id);
 
     for (node = fwk_list_head(subscription_dlist); node != NULL;
          node = fwk_list_next(subscription_dlist, node)) {
         subscription = FWK_LIST_GET(node,
             struct __fwk_notification_subscription, dlist_node);
 
-        if (fwk_id_is_equal(subscription->source_id, source_id) &&
-            fwk_id_is_equal(subscription->target_id, target_id))
+        if (check_source &&
+            !fwk_id_is_equal(subscription->source_id, source_id))
+            continue;
+
+        if (fwk_id_is_equal(subscription->target_id, target_id))
             return subscription;
     }
 
     return NULL;
 }
 
+/*
+ * Search for a subscription declared at build time.
+ *
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ * \param target_id Identifier of the target of the notification.
+ *
+ * \retval true The subscription is declared at build time.
+ * \retval false The subscription is not declared at build time.
+ */
+static bool is_static_subscription(fwk_id_t notification_id,
+                                   fwk_id_t source_id, fwk_id_t target_id)
+{
+    const struct fwk_notification_static_subscription *subscription;
+
+    for (subscription = module_static_subscription_table;
+         !fwk_id_is_type(subscription->notification_id, FWK_ID_TYPE_NONE);
+         subscription++) {
+        if (fwk_id_is_equal(subscription->notification_id, notification_id) &&
+            fwk_id_is_equal(subscription->source_id, source_id) &&
+            fwk_id_is_equal(subscription->target_id, target_id))
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Send a notification to one of its targets.
+ *
+ * \note The function is a sub-routine of 'send_notifications'.
+ *
+ * \param notification_event Pointer to the notification event.
+ * \param target_id Identifier of the target of the notification.
+ * \param multicast Pointer to the event shared by the targets, or NULL.
+ * \param[in, out] multicast_count Number of targets of \p multicast.
+ * \param[in, out] count The number of notifications being sent.
+ */
+static void send_notification(struct fwk_event *notification_event,
+                              fwk_id_t target_id, struct fwk_event *multicast,
+                              unsigned int *multicast_count,
+                              unsigned int *count)
+{
+    int status;
+
+    #ifndef BUILD_HAS_MULTITHREADING
+    if ((multicast != NULL) &&
+        (__fwk_thread_add_notification_target(multicast, target_id) ==
+         FWK_SUCCESS)) {
+        (*multicast_count)++;
+        (*count)++;
+        return;
+    }
+    #endif
+
+    notification_event->target_id = target_id;
+
+    status = __fwk_thread_put_notification(notification_event);
+    if (status == FWK_SUCCESS)
+        (*count)++;
+}
+
 /*
  * Send all the notifications associated with a notification event.
  *
@@ -113,31 +224,88 @@ static struct __fwk_notification_subscription *search_subscription(
 static void send_notifications(struct fwk_event *notification_event,
                                unsigned int *count)
 {
-    int status;
     struct fwk_dlist *subscription_dlist;
     struct fwk_dlist_node *node;
     struct __fwk_notification_subscription *subscription;
+    const struct fwk_notification_static_subscription *static_subscription;
+    bool check_source;
+    struct fwk_event *multicast = NULL;
+    unsigned int multicast_count = 0;
 
     subscription_dlist = get_subscription_dlist(notification_event->id,
                                                 notification_event->source_id);
+    check_source = is_subscription_dlist_shared(notification_event->source_id);
     notification_event->is_response = false;
     notification_event->is_notification = true;
 
+    #ifndef BUILD_HAS_MULTITHREADING
+    /*
+     * The subscribers share a single event structure rather than each of them
+     * being sent a copy of the notification. The copies are only resorted to
+     * when there is no structure left to record the targets.
+     */
+    multicast = __fwk_thread_begin_multicast_notification(notification_event);
+    #endif
+
+    /* The subscriptions declared at build time are notified first */
+    for (static_subscription = module_static_subscription_table;
+         !fwk_id_is_type(static_subscription->notification_id,
+                         FWK_ID_TYPE_NONE);
+         static_subscription++) {
+        if (!fwk_id_is_equal(static_subscription->notification_id,
+                             notification_event->id) ||
+            !fwk_id_is_equal(static_subscription->source_id,
+                             notification_event->source_id))
+            continue;
+
+        send_notification(notification_event, static_subscription->target_id,
+                          multicast, &multicast_count, count);
+    }
+
     for (node = fwk_list_head(subscription_dlist); node != NULL;
          node = fwk_list_next(subscription_dlist, node)) {
         subscription = FWK_LIST_GET(node,
             struct __fwk_notification_subscription, dlist_node);
 
-        if (!fwk_id_is_equal(subscription->source_id,
+        if (check_source &&
+            !fwk_id_is_equal(subscription->source_id,
                              notification_event->source_id))
             continue;
 
-        notification_event->target_id = subscription->target_id;
+        send_notification(notification_event, subscription->target_id,
+                          multicast, &multicast_count, count);
+    }
+
+    #ifndef BUILD_HAS_MULTITHREADING
+    if (multicast != NULL)
+        __fwk_thread_put_multicast_notification(multicast, multicast_count);
+    #endif
+}
 
-        status = __fwk_thread_put_notification(notification_event);
-        if (status == FWK_SUCCESS)
-            (*count)++;
+/*
+ * Search the collection of the responses to a notification.
+ *
+ * \param notification_id Identifier of the notification.
+ * \param source_id Identifier of the emitter of the notification.
+ *
+ * \return A pointer to the collection, NULL if the responses to the
+ *      notification are not being collected.
+ */
+static struct notification_collection *search_collection(
+    fwk_id_t notification_id, fwk_id_t source_id)
+{
+    struct notification_collection *collection;
+
+    for (collection = ctx.collection_table;
+         collection < &ctx.collection_table[NOTIFICATION_COLLECTION_COUNT];
+         collection++) {
+        if ((collection->pending_responses != 0) &&
+            fwk_id_is_equal(collection->notification_id, notification_id) &&
+            fwk_id_is_equal(collection->source_id, source_id))
+            return collection;
     }
+
+    return NULL;
 }
 
 /*
@@ -149,6 +317,14 @@ int __fwk_notification_init(size_t notification_count)
     struct __fwk_notification_subscription *subscription_table,
         *subscription_table_upper_limit, *subscription;
 
+    fwk_list_init(&ctx.free_subscription_dlist);
+
+    /* All the subscriptions may be declared at build time */
+    if (notification_count == 0) {
+        ctx.initialized = true;
+        return FWK_SUCCESS;
+    }
+
     subscription_table = fwk_mm_calloc(
         notification_count, sizeof(struct __fwk_notification_subscription));
     if (subscription_table == NULL) {
@@ -157,7 +333,6 @@ int __fwk_notification_init(size_t notification_count)
     }
 
     /* All the subscription structures are free to be used. */
-    fwk_list_init(&ctx.free_subscription_dlist);
     for (subscription = subscription_table,
          subscription_table_upper_limit = subscription + notification_count;
          subscription < subscription_table_upper_limit;
@@ -175,6 +350,29 @@ void __fwk_notification_reset(void)
     ctx = (struct notification_ctx){ 0 };
 }
 
+bool __fwk_notification_collect_response(struct fwk_event *response)
+{
+    struct notification_collection *collection;
+    struct fwk_notification_resp_params *params =
+        (struct fwk_notification_resp_params *)response->params;
+
+    collection = search_collection(response->id, response->target_id);
+    if (collection == NULL)
+        return true;
+
+    if ((params->status != FWK_SUCCESS) &&
+        (collection->status == FWK_SUCCESS))
+        collection->status = params->status;
+
+    if (--collection->pending_responses != 0)
+        return false;
+
+    /* The last response completes the collection */
+    params->status = collection->status;
+
+    return true;
+}
+
 /*
  * Public interface functions
  */
@@ -206,6 +404,10 @@ int fwk_notification_subscribe(fwk_id_t notification_id, fwk_id_t source_id,
         goto error;
     }
 
+    /* The subscription is already effective */
+    if (is_static_subscription(notification_id, source_id, target_id))
+        return FWK_SUCCESS;
+
     subscription_dlist = get_subscription_dlist(notification_id, source_id);
     if (search_subscription(subscription_dlist, source_id, target_id) != NULL) {
         status = FWK_E_STATE;
@@ -263,6 +465,11 @@ int fwk_notification_unsubscribe(fwk_id_t notification_id, fwk_id_t source_id,
         goto error;
     }
 
+    if (is_static_subscription(notification_id, source_id, target_id)) {
+        status = FWK_E_ACCESS;
+        goto error;
+    }
+
     subscription_dlist = get_subscription_dlist(notification_id, source_id);
     subscription = search_subscription(subscription_dlist,
                                        source_id, target_id);
@@ -325,3 +532,85 @@ error:
     FWK_HOST_PRINT(err_msg_func, status, __func__);
     return status;
 }
+
+int fwk_notification_notify_collect(struct fwk_event *notification_event,
+                                    unsigned int *count)
+{
+    int status;
+    unsigned int interrupt;
+    const struct fwk_event *current_event;
+    struct notification_collection *collection;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if ((notification_event == NULL) || (count == NULL))
+        return FWK_E_PARAM;
+
+    if (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS) {
+        status = FWK_E_HANDLER;
+        goto error;
+    }
+
+    current_event = __fwk_thread_get_current_event();
+    if (current_event != NULL)
+        notification_event->source_id = current_event->target_id;
+
+    /*
+     * The collections are only updated by the threads of their sources, the
+     * free collection is reserved with the interrupts disabled as several
+     * threads may look for one at the same time.
+     */
+    fwk_interrupt_global_disable();
+
+    /* The responses to two instances of a notification are not told apart */
+    if (search_collection(notification_event->id,
+                          notification_event->source_id) != NULL) {
+        fwk_interrupt_global_enable();
+        status = FWK_E_STATE;
+        goto error;
+    }
+
+    for (collection = ctx.collection_table;
+         collection < &ctx.collection_table[NOTIFICATION_COLLECTION_COUNT];
+         collection++) {
+        if (collection->pending_responses == 0)
+            break;
+    }
+
+    if (collection == &ctx.collection_table[NOTIFICATION_COLLECTION_COUNT]) {
+        fwk_interrupt_global_enable();
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    /* Reserved until the notification has been sent */
+    collection->notification_id = notification_event->id;
+    collection->source_id = notification_event->source_id;
+    collection->pending_responses = 1;
+    collection->status = FWK_SUCCESS;
+
+    fwk_interrupt_global_enable();
+
+    /*
+     * The responses are processed by the thread of the source once the
+     * processing of the current event has completed, thus not before the
+     * number of responses to expect is known.
+     */
+    notification_event->response_requested = true;
+    status = fwk_notification_notify(notification_event, count);
+    if (status != FWK_SUCCESS) {
+        collection->pending_responses = 0;
+        return status;
+    }
+
+    collection->pending_responses = *count;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
@@ -94,6 +94,61 @@ struct fwk_slist_node *__fwk_slist_pop_head(struct fwk_slist *list)
     return popped;
 }
 
+void __fwk_slist_splice(
+    struct fwk_slist *list,
+    struct fwk_slist *other)
+{
+    assert(list != NULL);
+    assert(other != NULL);
+    assert(list != other);
+
+    if (fwk_list_is_empty(other))
+        return;
+
+    other->tail->next = (struct fwk_slist_node *)list;
+
+    list->tail->next = other->head;
+    list->tail = other->tail;
+
+    __fwk_slist_init(other);
+}
+
+unsigned int __fwk_slist_pop_head_n(
+    struct fwk_slist *list,
+    struct fwk_slist *other,
+    unsigned int count)
+{
+    unsigned int moved;
+    struct fwk_slist_node *first, *last;
+
+    assert(list != NULL);
+    assert(other != NULL);
+    assert(list != other);
+
+    if ((count == 0) || fwk_list_is_empty(list))
+        return 0;
+
+    first = list->head;
+    last = first;
+    for (moved = 1; moved < count; moved++) {
+        if (last->next == (struct fwk_slist_node *)list)
+            break;
+
+        last = last->next;
+    }
+
+    list->head = last->next;
+    if (last->next == (struct fwk_slist_node *)list)
+        list->tail = (struct fwk_slist_node *)list;
+
+    last->next = (struct fwk_slist_node *)other;
+
+    other->tail->next = first;
+    other->tail = last;
+
+    return moved;
+}
+
 struct fwk_slist_node *__fwk_slist_next(
     const struct fwk_slist *list,
     const struct fwk_slist_node *node)
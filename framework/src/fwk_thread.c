@@ -16,12 +16,17 @@
 #include <fwk_host.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
+#include <fwk_trace.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_notification.h>
 #include <internal/fwk_single_thread.h>
 #include <internal/fwk_thread.h>
 
+/* Number of structures to hold the targets of multicast notifications */
+#define NOTIFICATION_TARGET_COUNT 32
+
 static struct __fwk_thread_ctx ctx;
 
 #ifdef BUILD_HOST
@@ -33,96 +38,405 @@ static const char err_msg_func[] = "[THR] Error %d in %s\n";
  * Static functions
  */
 
-static int put_event(struct fwk_event *event)
+static struct fwk_event *allocate_event(void)
 {
     struct fwk_event *free_event;
-    unsigned int interrupt;
 
+    fwk_interrupt_global_disable();
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx.free_event_queue),
         struct fwk_event, slist_node);
+    if (free_event != NULL) {
+        ctx.used_event_count++;
+        if (ctx.used_event_count > ctx.used_event_count_max)
+            ctx.used_event_count_max = ctx.used_event_count;
+    }
+    fwk_interrupt_global_enable();
+
+    return free_event;
+}
+
+/*
+ * Take several event structures from the queue of free events at once, or none
+ * if there are not enough of them.
+ */
+static bool allocate_events(struct fwk_slist *events, unsigned int count)
+{
+    unsigned int idx;
+
+    fwk_interrupt_global_disable();
+
+    if ((ctx.event_count - ctx.used_event_count) < count) {
+        fwk_interrupt_global_enable();
+        return false;
+    }
+
+    for (idx = 0; idx < count; idx++)
+        fwk_list_push_tail(events, fwk_list_pop_head(&ctx.free_event_queue));
+
+    ctx.used_event_count += count;
+    if (ctx.used_event_count > ctx.used_event_count_max)
+        ctx.used_event_count_max = ctx.used_event_count;
+
+    fwk_interrupt_global_enable();
+
+    return true;
+}
+
+static void free_event(struct fwk_event *event)
+{
+    fwk_interrupt_global_disable();
+    fwk_list_push_tail(&ctx.free_event_queue, &event->slist_node);
+    ctx.used_event_count--;
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Remove from an event queue the event superseded by a new event, if any.
+ *
+ * \param queue Event queue.
+ * \param event New event.
+ *
+ * \return The superseded event, NULL if there is none.
+ */
+static struct fwk_event *remove_superseded_event(struct fwk_slist *queue,
+                                                 const struct fwk_event *event)
+{
+    struct fwk_slist_node *node;
+    struct fwk_event *queued_event;
+
+    if (!event->supersedes || event->is_notification)
+        return NULL;
+
+    for (node = fwk_list_head(queue); node != NULL;
+         node = fwk_list_next(queue, node)) {
+        queued_event = FWK_LIST_GET(node, struct fwk_event, slist_node);
+        if (queued_event->supersedes && !queued_event->is_notification &&
+            fwk_id_is_equal(queued_event->id, event->id) &&
+            fwk_id_is_equal(queued_event->source_id, event->source_id) &&
+            fwk_id_is_equal(queued_event->target_id, event->target_id)) {
+            fwk_list_remove(queue, node);
+            return queued_event;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Link an event structure taken from the queue of free events to the event
+ * queue or to the ISR event queue depending on the calling context.
+ */
+static void queue_event(struct fwk_event *event)
+{
+    unsigned int interrupt;
+    struct fwk_slist *queue;
+    struct fwk_event *superseded_event;
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_queue(event);
+    #endif
+
+    if (fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS)
+        queue = &ctx.event_queue[event->priority];
+    else {
+        queue = &ctx.isr_event_queue;
+        if (event->priority != FWK_EVENT_PRIORITY_NORMAL)
+            ctx.isr_priority_event_pending = true;
+    }
+
+    superseded_event = remove_superseded_event(queue, event);
+    fwk_list_push_tail(queue, &event->slist_node);
+
+    if (superseded_event != NULL)
+        free_event(superseded_event);
+}
 
-    if (free_event == NULL) {
+static FWK_HOT int put_event(struct fwk_event *event)
+{
+    struct fwk_event *allocated_event;
+
+    allocated_event = allocate_event();
+    if (allocated_event == NULL) {
         FWK_HOST_PRINT(err_msg_func, FWK_E_NOMEM, __func__);
         assert(false);
         return FWK_E_NOMEM;
     }
 
-    *free_event = *event;
+    *allocated_event = *event;
+    allocated_event->slist_node = (struct fwk_slist_node) { 0 };
+    allocated_event->is_multicast = false;
 
-    if (fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS)
-        fwk_list_push_tail(&ctx.event_queue, &free_event->slist_node);
-    else
-        fwk_list_push_tail(&ctx.isr_event_queue, &free_event->slist_node);
+    queue_event(allocated_event);
 
     return FWK_SUCCESS;
 }
 
-static void process_next_event(void)
+/*
+ * Check the validity of an event issued by a module.
+ *
+ * \note The source identifier of the event is populated with the identifier
+ *      of the entity processing the current event if any.
+ *
+ * \retval FWK_SUCCESS The event is valid.
+ * \retval FWK_E_PARAM One or more fields of the event are not valid.
+ */
+static int check_event(struct fwk_event *event)
+{
+    unsigned int interrupt;
+
+    if ((fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) &&
+        (ctx.current_event != NULL))
+        event->source_id = ctx.current_event->target_id;
+    else if (!fwk_module_is_valid_entity_id(event->source_id))
+        return FWK_E_PARAM;
+
+    if (!fwk_module_is_valid_entity_id(event->target_id) ||
+        !fwk_module_is_valid_event_id(event->id))
+        return FWK_E_PARAM;
+
+    if (event->priority >= FWK_EVENT_PRIORITY_COUNT)
+        return FWK_E_PARAM;
+
+    if (event->supersedes &&
+        (event->is_response || event->response_requested))
+        return FWK_E_PARAM;
+
+    if (event->is_response) {
+        if (fwk_id_get_module_idx(event->source_id) !=
+            fwk_id_get_module_idx(event->id))
+            return FWK_E_PARAM;
+        if (event->response_requested)
+            return FWK_E_PARAM;
+    } else {
+        if (fwk_id_get_module_idx(event->target_id) !=
+            fwk_id_get_module_idx(event->id))
+            return FWK_E_PARAM;
+        if (event->is_notification)
+            return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Get the event queue of the highest priority class that is not empty.
+ *
+ * \return The event queue, or NULL if all the event queues are empty.
+ */
+static struct fwk_slist *get_next_event_queue(void)
+{
+    unsigned int priority = FWK_EVENT_PRIORITY_COUNT;
+
+    while (priority-- > 0) {
+        if (!fwk_list_is_empty(&ctx.event_queue[priority]))
+            return &ctx.event_queue[priority];
+    }
+
+    return NULL;
+}
+
+/*
+ * Get the next target of a multicast notification and release the structure
+ * that held it.
+ *
+ * \param event Multicast notification event.
+ * \param[out] target_id Identifier of the target.
+ *
+ * \retval true The next target was returned.
+ * \retval false The notification has been delivered to all its targets.
+ */
+static bool pop_notification_target(const struct fwk_event *event,
+                                    fwk_id_t *target_id)
+{
+    struct fwk_slist_node *node;
+    struct __fwk_thread_notification_target *target = NULL;
+
+    fwk_interrupt_global_disable();
+
+    /*
+     * The targets of a notification are found in the order they were added.
+     * Those of the notifications queued before it have been popped already
+     * unless ISRs or priority classes reordered the notifications.
+     */
+    for (node = fwk_list_head(&ctx.multicast_target_queue); node != NULL;
+         node = fwk_list_next(&ctx.multicast_target_queue, node)) {
+        target = FWK_LIST_GET(node, struct __fwk_thread_notification_target,
+                              slist_node);
+        if (target->event == event)
+            break;
+    }
+
+    if (node != NULL) {
+        fwk_list_remove(&ctx.multicast_target_queue, node);
+        *target_id = target->target_id;
+        fwk_list_push_tail(&ctx.free_target_queue, node);
+    }
+
+    fwk_interrupt_global_enable();
+
+    return node != NULL;
+}
+
+static void dispatch_event(struct fwk_event *event)
 {
     int status;
-    struct fwk_event *event, async_response_event = {0};
+    struct fwk_event *response_event, async_response_event = {0};
     const struct fwk_module *module;
     int (*process_event)(const struct fwk_event *event,
                          struct fwk_event *resp_event);
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    uint32_t start;
+    #endif
 
-
-    ctx.current_event = event = FWK_LIST_GET(
-        fwk_list_pop_head(&ctx.event_queue), struct fwk_event, slist_node);
-
-    FWK_HOST_PRINT("[THR] Get event (%s,%s,%s)\n",
-                   FWK_ID_STR(event->source_id), FWK_ID_STR(event->target_id),
-                   FWK_ID_STR(event->id));
+    #ifdef BUILD_HAS_NOTIFICATION
+    /* Only the last response to a collected notification is delivered */
+    if (event->is_response && event->is_notification &&
+        !__fwk_notification_collect_response(event))
+        return;
+    #endif
 
     module = __fwk_module_get_ctx(event->target_id)->desc;
     process_event = event->is_notification ? module->process_notification :
                     module->process_event;
 
-    if (event->response_requested) {
-        async_response_event.source_id = event->target_id;
-        async_response_event.target_id = event->source_id;
-        async_response_event.id = event->id;
-        memcpy(&async_response_event.params, &event->params,
-               sizeof(async_response_event.params));
+    FWK_TRACE(FWK_TRACE_ID_EVENT_START, event->id.value);
 
-        status = process_event(event, &async_response_event);
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    start = __fwk_thread_profile_start();
+    #endif
+
+    if (event->response_requested) {
+        /*
+         * The response is built directly within the event structure it will
+         * be queued with. The local structure is used only if there is no
+         * free event structure left, in which case queuing the response
+         * fails.
+         */
+        response_event = allocate_event();
+        if (response_event == NULL)
+            response_event = &async_response_event;
+        else
+            *response_event = (struct fwk_event) { 0 };
+
+        response_event->source_id = event->target_id;
+        response_event->target_id = event->source_id;
+        response_event->id = event->id;
+        response_event->priority = event->priority;
+        memcpy(&response_event->params, &event->params,
+               sizeof(response_event->params));
+
+        status = process_event(event, response_event);
         if (status != FWK_SUCCESS)
             FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
 
-        async_response_event.is_response = true;
-        async_response_event.response_requested = false;
-        async_response_event.is_notification = event->is_notification;
-        if (!async_response_event.is_delayed_response)
-            put_event(&async_response_event);
+        response_event->is_response = true;
+        response_event->response_requested = false;
+        response_event->is_notification = event->is_notification;
+
+        if (response_event == &async_response_event) {
+            if (!async_response_event.is_delayed_response)
+                put_event(&async_response_event);
+        } else if (!response_event->is_delayed_response)
+            queue_event(response_event);
+        else
+            free_event(response_event);
     } else {
         status = process_event(event, &async_response_event);
         if (status != FWK_SUCCESS)
             FWK_HOST_PRINT(err_msg_line, status, __func__, __LINE__);
     }
 
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    __fwk_thread_profile_end(event, start);
+    #endif
+
+    FWK_TRACE(FWK_TRACE_ID_EVENT_END, event->target_id.value);
+}
+
+static FWK_HOT void process_next_event(struct fwk_slist *event_queue)
+{
+    struct fwk_event *event;
+
+    ctx.current_event = event = FWK_LIST_GET(
+        fwk_list_pop_head(event_queue), struct fwk_event, slist_node);
+
+    FWK_HOST_PRINT("[THR] Get event (%s,%s,%s)\n",
+                   FWK_ID_STR(event->source_id), FWK_ID_STR(event->target_id),
+                   FWK_ID_STR(event->id));
+
+    if (event->is_multicast) {
+        /* The same event structure is delivered to each target in turn */
+        while (pop_notification_target(event, &event->target_id))
+            dispatch_event(event);
+    } else
+        dispatch_event(event);
+
     ctx.current_event = NULL;
 
-    fwk_interrupt_global_disable();
-    fwk_list_push_tail(&ctx.free_event_queue, &event->slist_node);
-    fwk_interrupt_global_enable();
+    free_event(event);
 
     return;
 }
 
 static void process_isr(void)
 {
-    struct fwk_event *isr_event;
+    struct fwk_slist isr_events, *event_queue;
+    struct fwk_event *isr_event, *superseded_event;
+
+    fwk_list_init(&isr_events);
 
+    /*
+     * Move all the pending ISR events at once to keep the critical section
+     * short and independent of the number of events raised by ISRs.
+     */
     fwk_interrupt_global_disable();
-    isr_event = FWK_LIST_GET(fwk_list_pop_head(&ctx.isr_event_queue),
-                             struct fwk_event, slist_node);
+    fwk_list_splice(&isr_events, &ctx.isr_event_queue);
+    ctx.isr_priority_event_pending = false;
     fwk_interrupt_global_enable();
 
-    FWK_HOST_PRINT("[THR] Get ISR event (%s,%s,%s)\n",
-                   FWK_ID_STR(isr_event->source_id),
-                   FWK_ID_STR(isr_event->target_id),
-                   FWK_ID_STR(isr_event->id));
+    while (!fwk_list_is_empty(&isr_events)) {
+        isr_event = FWK_LIST_GET(fwk_list_pop_head(&isr_events),
+                                 struct fwk_event, slist_node);
 
-    fwk_list_push_tail(&ctx.event_queue, &isr_event->slist_node);
+        FWK_HOST_PRINT("[THR] Get ISR event (%s,%s,%s)\n",
+                       FWK_ID_STR(isr_event->source_id),
+                       FWK_ID_STR(isr_event->target_id),
+                       FWK_ID_STR(isr_event->id));
+
+        event_queue = &ctx.event_queue[isr_event->priority];
+        superseded_event = remove_superseded_event(event_queue, isr_event);
+        fwk_list_push_tail(event_queue, &isr_event->slist_node);
+
+        if (superseded_event != NULL)
+            free_event(superseded_event);
+    }
+}
+
+/*
+ * Wait for an ISR to raise an event.
+ *
+ * The ISR event queue is checked with the interrupts disabled so that an event
+ * raised in between the check and the call to the idle handler is not missed:
+ * the interrupt that raised it stays pending and ends the wait.
+ */
+static void wait_for_isr_event(void)
+{
+    if (ctx.idle == NULL) {
+        while (fwk_list_is_empty(&ctx.isr_event_queue))
+            continue;
+
+        return;
+    }
+
+    fwk_interrupt_global_disable();
+    while (fwk_list_is_empty(&ctx.isr_event_queue)) {
+        ctx.idle();
+
+        /* Let the pending interrupts be serviced */
+        fwk_interrupt_global_enable();
+        fwk_interrupt_global_disable();
+    }
+    fwk_interrupt_global_enable();
 }
 
 /*
@@ -133,23 +447,44 @@ int __fwk_thread_init(size_t event_count)
 {
     int status;
     struct fwk_event *event_table, *event;
+    struct __fwk_thread_notification_target *target_table, *target;
+    unsigned int priority;
 
-    event_table = fwk_mm_calloc(event_count, sizeof(struct fwk_event));
+    target_table = fwk_mm_calloc(NOTIFICATION_TARGET_COUNT,
+                                 sizeof(*target_table));
+    if (target_table == NULL) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    event_table = fwk_mm_calloc_hot(event_count, sizeof(struct fwk_event));
     if (event_table == NULL) {
         status = FWK_E_NOMEM;
         goto error;
     }
 
-    /* All the event structures are free to be used. */
+    /* All the event and target structures are free to be used. */
     fwk_list_init(&ctx.free_event_queue);
-    fwk_list_init(&ctx.event_queue);
+    fwk_list_init(&ctx.free_target_queue);
+    fwk_list_init(&ctx.multicast_target_queue);
     fwk_list_init(&ctx.isr_event_queue);
+    for (priority = 0; priority < FWK_EVENT_PRIORITY_COUNT; priority++)
+        fwk_list_init(&ctx.event_queue[priority]);
 
     for (event = event_table;
          event < (event_table + event_count);
          event++)
         fwk_list_push_tail(&ctx.free_event_queue, &event->slist_node);
 
+    for (target = target_table;
+         target < (target_table + NOTIFICATION_TARGET_COUNT);
+         target++)
+        fwk_list_push_tail(&ctx.free_target_queue, &target->slist_node);
+
+    ctx.event_count = event_count;
+    ctx.used_event_count = 0;
+    ctx.used_event_count_max = 0;
+
     ctx.initialized = true;
 
     return FWK_SUCCESS;
@@ -161,17 +496,36 @@ error:
 
 noreturn void __fwk_thread_run(void)
 {
+    struct fwk_slist *event_queue;
+
     for (;;) {
-        while (!fwk_list_is_empty(&ctx.event_queue))
-            process_next_event();
+        for (;;) {
+            /*
+             * Events of high priority raised by ISRs are moved to the event
+             * queues ahead of the processing of the next event to bound their
+             * queueing delay.
+             */
+            if (ctx.isr_priority_event_pending)
+                process_isr();
 
-        while (fwk_list_is_empty(&ctx.isr_event_queue))
-            continue;
+            event_queue = get_next_event_queue();
+            if (event_queue == NULL)
+                break;
+
+            process_next_event(event_queue);
+        }
+
+        wait_for_isr_event();
 
         process_isr();
     }
 }
 
+void __fwk_thread_set_idle_handler(void (*idle)(void))
+{
+    ctx.idle = idle;
+}
+
 struct __fwk_thread_ctx *__fwk_thread_get_ctx(void)
 {
     return &ctx;
@@ -190,6 +544,59 @@ int __fwk_thread_put_notification(struct fwk_event *event)
 
     return put_event(event);
 }
+
+struct fwk_event *__fwk_thread_begin_multicast_notification(
+    const struct fwk_event *event)
+{
+    struct fwk_event *multicast;
+
+    multicast = allocate_event();
+    if (multicast == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_NOMEM, __func__);
+        return NULL;
+    }
+
+    *multicast = *event;
+    multicast->slist_node = (struct fwk_slist_node) { 0 };
+    multicast->is_response = false;
+    multicast->is_notification = true;
+    multicast->is_multicast = true;
+
+    return multicast;
+}
+
+int __fwk_thread_add_notification_target(struct fwk_event *multicast,
+                                         fwk_id_t target_id)
+{
+    struct __fwk_thread_notification_target *target;
+
+    fwk_interrupt_global_disable();
+    target = FWK_LIST_GET(fwk_list_pop_head(&ctx.free_target_queue),
+                          struct __fwk_thread_notification_target, slist_node);
+    if (target != NULL) {
+        target->event = multicast;
+        target->target_id = target_id;
+        fwk_list_push_tail(&ctx.multicast_target_queue, &target->slist_node);
+    }
+    fwk_interrupt_global_enable();
+
+    if (target == NULL)
+        return FWK_E_NOMEM;
+
+    /* The target identifier is set for each target when delivering */
+    multicast->target_id = target_id;
+
+    return FWK_SUCCESS;
+}
+
+void __fwk_thread_put_multicast_notification(struct fwk_event *multicast,
+                                             unsigned int target_count)
+{
+    if (target_count == 0)
+        free_event(multicast);
+    else
+        queue_event(multicast);
+}
 #endif
 
 /*
@@ -199,7 +606,6 @@ int __fwk_thread_put_notification(struct fwk_event *event)
 int fwk_thread_put_event(struct fwk_event *event)
 {
     int status = FWK_E_PARAM;
-    unsigned int interrupt;
 
     if (!ctx.initialized) {
         status = FWK_E_INIT;
@@ -209,33 +615,165 @@ int fwk_thread_put_event(struct fwk_event *event)
     if (event == NULL)
         goto error;
 
-    if ((fwk_interrupt_get_current(&interrupt) != FWK_SUCCESS) &&
-        (ctx.current_event != NULL))
-        event->source_id = ctx.current_event->target_id;
-    else if (!fwk_module_is_valid_entity_id(event->source_id))
+    status = check_event(event);
+    if (status != FWK_SUCCESS)
         goto error;
 
-    if (!fwk_module_is_valid_entity_id(event->target_id) ||
-        !fwk_module_is_valid_event_id(event->id))
+    return put_event(event);
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_put_events(struct fwk_event *events, unsigned int count)
+{
+    int status = FWK_E_PARAM;
+    unsigned int idx;
+    struct fwk_slist allocated_events;
+    struct fwk_event *allocated_event;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
         goto error;
+    }
 
-    if (event->is_response) {
-        if (fwk_id_get_module_idx(event->source_id) !=
-            fwk_id_get_module_idx(event->id))
-            goto error;
-        if (event->response_requested)
+    if (events == NULL)
+        goto error;
+
+    for (idx = 0; idx < count; idx++) {
+        if (events[idx].is_response) {
+            status = FWK_E_PARAM;
             goto error;
-    } else {
-        if (fwk_id_get_module_idx(event->target_id) !=
-            fwk_id_get_module_idx(event->id))
-             goto error;
-        if (event->is_notification)
+        }
+
+        status = check_event(&events[idx]);
+        if (status != FWK_SUCCESS)
             goto error;
     }
 
-    return put_event(event);
+    fwk_list_init(&allocated_events);
+    if (!allocate_events(&allocated_events, count)) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        allocated_event = FWK_LIST_GET(fwk_list_pop_head(&allocated_events),
+                                       struct fwk_event, slist_node);
+        *allocated_event = events[idx];
+        allocated_event->slist_node = (struct fwk_slist_node) { 0 };
+        allocated_event->is_multicast = false;
+
+        queue_event(allocated_event);
+    }
+
+    return FWK_SUCCESS;
 
 error:
     FWK_HOST_PRINT(err_msg_func, status, __func__);
     return status;
 }
+
+int fwk_thread_get_event_pool_stats(struct fwk_thread_event_pool_stats *stats)
+{
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    if (stats == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_PARAM, __func__);
+        return FWK_E_PARAM;
+    }
+
+    fwk_interrupt_global_disable();
+    stats->size = ctx.event_count;
+    stats->used = ctx.used_event_count;
+    stats->used_max = ctx.used_event_count_max;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
+}
+
+int fwk_thread_reserve_event(struct fwk_event **event)
+{
+    int status = FWK_E_PARAM;
+    struct fwk_event *reserved_event;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (event == NULL)
+        goto error;
+
+    reserved_event = allocate_event();
+    if (reserved_event == NULL) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    *reserved_event = (struct fwk_event) { 0 };
+    *event = reserved_event;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_commit_event(struct fwk_event *event)
+{
+    int status = FWK_E_PARAM;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (event == NULL)
+        goto error;
+
+    status = check_event(event);
+    if (status != FWK_SUCCESS) {
+        free_event(event);
+        goto error;
+    }
+
+    event->slist_node = (struct fwk_slist_node) { 0 };
+    event->is_multicast = false;
+    queue_event(event);
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_cancel_event(struct fwk_event *event)
+{
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    if (event == NULL) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_PARAM, __func__);
+        return FWK_E_PARAM;
+    }
+
+    event->slist_node = (struct fwk_slist_node) { 0 };
+    free_event(event);
+
+    return FWK_SUCCESS;
+}
+
+void fwk_thread_wait_for_interrupt(void)
+{
+    if (ctx.idle != NULL)
+        ctx.idle();
+}
@@ -0,0 +1,382 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Event processing profiling facilities.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fwk_errno.h>
+#include <fwk_host.h>
+#include <fwk_id.h>
+#include <fwk_math.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_thread.h>
+#include <internal/fwk_thread.h>
+
+/* Binary logarithm of the ratio between the bounds of a histogram bin */
+#define HISTOGRAM_BIN_WIDTH_LOG2 4
+
+/* Event processing statistics of a module */
+struct module_profile {
+    /* Statistics of all the events processed by the module */
+    struct fwk_thread_profile_stats stats;
+
+    /* Statistics of the time spent queued by the events of the module */
+    struct fwk_thread_profile_stats queue_stats;
+
+    /* Table of statistics, one per event defined by the module */
+    struct fwk_thread_profile_stats *event_stats_table;
+
+    #ifdef BUILD_HAS_NOTIFICATION
+    /* Table of statistics, one per notification defined by the module */
+    struct fwk_thread_profile_stats *notification_stats_table;
+    #endif
+};
+
+struct context {
+    /* Event profiling initialization completed flag */
+    bool initialized;
+
+    /* Timestamp handler */
+    uint32_t (*timestamp)(void);
+
+    /* Number of modules */
+    unsigned int module_count;
+
+    /* Table of module event processing statistics */
+    struct module_profile *module_profile_table;
+
+    /* Cumulated processing time of the outermost event dispatches */
+    uint64_t busy;
+
+    /* Number of event dispatches in progress */
+    unsigned int nesting_level;
+};
+
+extern const struct fwk_module *const module_table[];
+
+static struct context ctx;
+
+#ifdef BUILD_HOST
+static const char err_msg_func[] = "[PRF] Error %d in %s\n";
+#endif
+
+/*
+ * Static functions
+ */
+
+static struct fwk_thread_profile_stats *alloc_stats_table(unsigned int count)
+{
+    if (count == 0)
+        return NULL;
+
+    return fwk_mm_calloc(count, sizeof(struct fwk_thread_profile_stats));
+}
+
+static unsigned int get_histogram_bin(uint32_t duration)
+{
+    unsigned int bin;
+
+    if (duration == 0)
+        return 0;
+
+    bin = fwk_math_log2(duration) / HISTOGRAM_BIN_WIDTH_LOG2;
+    if (bin >= FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT)
+        bin = FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT - 1;
+
+    return bin;
+}
+
+static void update_stats(struct fwk_thread_profile_stats *stats,
+                         uint32_t duration)
+{
+    stats->count++;
+    stats->total += duration;
+    if (duration > stats->max)
+        stats->max = duration;
+    stats->histogram[get_histogram_bin(duration)]++;
+}
+
+/*
+ * Get the statistics associated with an identifier.
+ *
+ * \return The statistics, or NULL if the identifier is not a valid module,
+ *      event or notification identifier.
+ */
+static struct fwk_thread_profile_stats *get_stats(fwk_id_t id)
+{
+    unsigned int module_idx;
+    struct module_profile *module_profile;
+    const struct fwk_module *module;
+
+    module_idx = fwk_id_get_module_idx(id);
+    if (module_idx >= ctx.module_count)
+        return NULL;
+
+    module_profile = &ctx.module_profile_table[module_idx];
+    module = module_table[module_idx];
+
+    switch (fwk_id_get_type(id)) {
+    case FWK_ID_TYPE_MODULE:
+        return &module_profile->stats;
+
+    case FWK_ID_TYPE_EVENT:
+        if (fwk_id_get_event_idx(id) >= module->event_count)
+            return NULL;
+        return &module_profile->event_stats_table[fwk_id_get_event_idx(id)];
+
+    #ifdef BUILD_HAS_NOTIFICATION
+    case FWK_ID_TYPE_NOTIFICATION:
+        if (fwk_id_get_notification_idx(id) >= module->notification_count)
+            return NULL;
+        return &module_profile->notification_stats_table[
+            fwk_id_get_notification_idx(id)];
+    #endif
+
+    default:
+        return NULL;
+    }
+}
+
+/*
+ * Get the queuing statistics of the module of an identifier.
+ *
+ * \return The statistics, or NULL if the identifier does not refer to a valid
+ *      module.
+ */
+static struct fwk_thread_profile_stats *get_queue_stats(fwk_id_t id)
+{
+    unsigned int module_idx;
+
+    module_idx = fwk_id_get_module_idx(id);
+    if (module_idx >= ctx.module_count)
+        return NULL;
+
+    return &ctx.module_profile_table[module_idx].queue_stats;
+}
+
+/*
+ * Private interface functions
+ */
+
+int __fwk_thread_profile_init(uint32_t (*timestamp)(void))
+{
+    int status;
+    unsigned int module_count = 0;
+    unsigned int module_idx;
+    struct module_profile *module_profile_table, *module_profile;
+    const struct fwk_module *module;
+
+    if (timestamp == NULL) {
+        status = FWK_E_PARAM;
+        goto error;
+    }
+
+    while (module_table[module_count] != NULL)
+        module_count++;
+
+    module_profile_table = fwk_mm_calloc(module_count,
+                                         sizeof(struct module_profile));
+    if (module_profile_table == NULL) {
+        status = FWK_E_NOMEM;
+        goto error;
+    }
+
+    for (module_idx = 0; module_idx < module_count; module_idx++) {
+        module_profile = &module_profile_table[module_idx];
+        module = module_table[module_idx];
+
+        module_profile->event_stats_table =
+            alloc_stats_table(module->event_count);
+        if ((module->event_count > 0) &&
+            (module_profile->event_stats_table == NULL)) {
+            status = FWK_E_NOMEM;
+            goto error;
+        }
+
+        #ifdef BUILD_HAS_NOTIFICATION
+        module_profile->notification_stats_table =
+            alloc_stats_table(module->notification_count);
+        if ((module->notification_count > 0) &&
+            (module_profile->notification_stats_table == NULL)) {
+            status = FWK_E_NOMEM;
+            goto error;
+        }
+        #endif
+    }
+
+    ctx.timestamp = timestamp;
+    ctx.module_count = module_count;
+    ctx.module_profile_table = module_profile_table;
+    ctx.initialized = true;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+void __fwk_thread_profile_queue(struct fwk_event *event)
+{
+    event->queue_timestamp = ctx.timestamp();
+}
+
+uint32_t __fwk_thread_profile_start(void)
+{
+    ctx.nesting_level++;
+
+    return ctx.timestamp();
+}
+
+void __fwk_thread_profile_end(const struct fwk_event *event, uint32_t start)
+{
+    uint32_t duration;
+    struct fwk_thread_profile_stats *stats;
+
+    /* The subtraction handles the wrap around of the timestamp counter */
+    duration = ctx.timestamp() - start;
+
+    /*
+     * An event processed within the dispatch of another one, in the calling
+     * thread, is already part of the processing time of the outer dispatch.
+     */
+    if (--ctx.nesting_level == 0)
+        ctx.busy += duration;
+
+    stats = get_stats(fwk_id_build_module_id(event->target_id));
+    if (stats != NULL)
+        update_stats(stats, duration);
+
+    /* The subtraction handles the wrap around of the timestamp counter */
+    stats = get_queue_stats(event->target_id);
+    if (stats != NULL)
+        update_stats(stats, start - event->queue_timestamp);
+
+    stats = get_stats(event->id);
+    if (stats != NULL)
+        update_stats(stats, duration);
+}
+
+/*
+ * Public interface functions
+ */
+
+int fwk_thread_get_profile_stats(fwk_id_t id,
+                                 struct fwk_thread_profile_stats *stats)
+{
+    int status = FWK_E_PARAM;
+    struct fwk_thread_profile_stats *id_stats;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (stats == NULL)
+        goto error;
+
+    id_stats = get_stats(id);
+    if (id_stats == NULL)
+        goto error;
+
+    *stats = *id_stats;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_get_queue_stats(fwk_id_t module_id,
+                               struct fwk_thread_profile_stats *stats)
+{
+    int status = FWK_E_PARAM;
+    struct fwk_thread_profile_stats *module_stats;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if ((stats == NULL) || !fwk_id_is_type(module_id, FWK_ID_TYPE_MODULE))
+        goto error;
+
+    module_stats = get_queue_stats(module_id);
+    if (module_stats == NULL)
+        goto error;
+
+    *stats = *module_stats;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_get_load_stats(struct fwk_thread_load_stats *stats)
+{
+    int status = FWK_E_PARAM;
+
+    if (!ctx.initialized) {
+        status = FWK_E_INIT;
+        goto error;
+    }
+
+    if (stats == NULL)
+        goto error;
+
+    stats->timestamp = ctx.timestamp();
+    stats->busy = ctx.busy;
+
+    return FWK_SUCCESS;
+
+error:
+    FWK_HOST_PRINT(err_msg_func, status, __func__);
+    return status;
+}
+
+int fwk_thread_reset_profile_stats(void)
+{
+    unsigned int module_idx;
+    struct module_profile *module_profile;
+    const struct fwk_module *module;
+
+    if (!ctx.initialized) {
+        FWK_HOST_PRINT(err_msg_func, FWK_E_INIT, __func__);
+        return FWK_E_INIT;
+    }
+
+    for (module_idx = 0; module_idx < ctx.module_count; module_idx++) {
+        module_profile = &ctx.module_profile_table[module_idx];
+        module = module_table[module_idx];
+
+        module_profile->stats = (struct fwk_thread_profile_stats) { 0 };
+        module_profile->queue_stats = (struct fwk_thread_profile_stats) { 0 };
+
+        if (module->event_count > 0) {
+            memset(module_profile->event_stats_table, 0,
+                   module->event_count *
+                   sizeof(struct fwk_thread_profile_stats));
+        }
+
+        #ifdef BUILD_HAS_NOTIFICATION
+        if (module->notification_count > 0) {
+            memset(module_profile->notification_stats_table, 0,
+                   module->notification_count *
+                   sizeof(struct fwk_thread_profile_stats));
+        }
+        #endif
+    }
+
+    return FWK_SUCCESS;
+}
@@ -0,0 +1,34 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Trace points.
+ */
+
+#include <stddef.h>
+#include <fwk_errno.h>
+#include <fwk_macros.h>
+#include <fwk_trace.h>
+
+static const struct fwk_trace_driver *trace_driver;
+
+int fwk_trace_set_driver(const struct fwk_trace_driver *driver)
+{
+    if ((driver != NULL) && (driver->emit == NULL))
+        return FWK_E_PARAM;
+
+    trace_driver = driver;
+
+    return FWK_SUCCESS;
+}
+
+FWK_HOT void __fwk_trace(uint16_t id, uint32_t value)
+{
+    const struct fwk_trace_driver *driver = trace_driver;
+
+    if (driver != NULL)
+        driver->emit(id, value);
+}
@@ -0,0 +1,46 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Required for clock_gettime() when building with -std=c11 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <fwk_bench.h>
+#include <fwk_test.h>
+
+extern struct fwk_test_suite_desc test_suite;
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (time.tv_sec * 1000000000ULL) + time.tv_nsec;
+}
+
+void fwk_bench_run(const char *name, void (*benchmark)(unsigned int op_count),
+                   unsigned int op_count)
+{
+    unsigned int run;
+    uint64_t start, duration, duration_min = UINT64_MAX;
+
+    for (run = 0; run < FWK_BENCH_RUN_COUNT; run++) {
+        start = get_time_ns();
+        benchmark(op_count);
+        duration = get_time_ns() - start;
+
+        if (duration < duration_min)
+            duration_min = duration;
+    }
+
+    printf("[BENCH] suite=%s name=%s ops=%u ns_per_op=%.2f\n",
+           test_suite.name, name, op_count,
+           (double)duration_min / op_count);
+}
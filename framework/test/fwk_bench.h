@@ -0,0 +1,59 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FWK_BENCH_H
+#define FWK_BENCH_H
+
+/*!
+ * \addtogroup GroupLibFramework Framework
+ * @{
+ */
+
+/*!
+ * \addtogroup GroupTest Test
+ * @{
+ */
+
+/*!
+ * \brief Number of times a benchmark is run, the fastest run being reported.
+ */
+#define FWK_BENCH_RUN_COUNT 5
+
+/*!
+ * \brief Run a benchmark and report its result.
+ *
+ * \details The benchmark is run \ref FWK_BENCH_RUN_COUNT times and the duration
+ *      of the fastest run, the least disturbed by the host, is reported on a
+ *      single line of the form:
+ *      \code
+ *      [BENCH] suite=<suite> name=<name> ops=<op_count> ns_per_op=<duration>
+ *      \endcode
+ *
+ * \note The framework tests are built in debug mode, so the results include
+ *      the cost of the assertions. They are meant to be compared between
+ *      revisions of the framework, rather than with a firmware built in
+ *      release mode.
+ *
+ * \param name Name of the benchmark.
+ * \param benchmark Pointer to the function running the benchmark, which
+ *      performs \p op_count operations per call.
+ * \param op_count Number of operations performed per call of \p benchmark.
+ *
+ * \return None.
+ */
+void fwk_bench_run(const char *name, void (*benchmark)(unsigned int op_count),
+                   unsigned int op_count);
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* FWK_BENCH_H */
@@ -17,6 +17,7 @@ static int mm_init_handler_return_val;
 static int fwk_interrupt_init_return_val;
 static int interrupt_init_handler_return_val;
 static int __fwk_module_init_return_val;
+static int __fwk_module_resume_return_val;
 
 /*
  * Mock functions
@@ -26,6 +27,11 @@ int fwk_mm_init(uintptr_t start, size_t size)
     return fwk_mm_init_return_val;
 }
 
+int fwk_mm_init_hot(uintptr_t start, size_t size)
+{
+    return fwk_mm_init_return_val;
+}
+
 int mm_init_handler(struct fwk_arch_mm_data *data)
 {
     return mm_init_handler_return_val;
@@ -46,6 +52,21 @@ int __fwk_module_init(void)
     return __fwk_module_init_return_val;
 }
 
+int __fwk_module_resume(void)
+{
+    return __fwk_module_resume_return_val;
+}
+
+static void (*idle_handler)(void);
+void __fwk_thread_set_idle_handler(void (*idle)(void))
+{
+    idle_handler = idle;
+}
+
+static void idle(void)
+{
+}
+
 static const struct fwk_arch_init_driver driver_invalid = {
     .mm = NULL,
 };
@@ -57,11 +78,13 @@ static void test_case_setup(void)
     fwk_interrupt_init_return_val = FWK_SUCCESS;
     interrupt_init_handler_return_val = FWK_SUCCESS;
     __fwk_module_init_return_val = FWK_SUCCESS;
+    __fwk_module_resume_return_val = FWK_SUCCESS;
 }
 
 static const struct fwk_arch_init_driver driver = {
     .mm = mm_init_handler,
     .interrupt = interrupt_init_handler,
+    .idle = idle,
 };
 
 static void test_fwk_arch_init_success(void)
@@ -70,6 +93,7 @@ static void test_fwk_arch_init_success(void)
 
     result = fwk_arch_init(&driver);
     assert(result == FWK_SUCCESS);
+    assert(idle_handler == idle);
 }
 
 static void test_fwk_arch_init_bad_param(void)
@@ -124,12 +148,35 @@ static void test_fwk_arch_init_module_fail(void)
     assert(result == FWK_E_PANIC);
 }
 
+static void test_fwk_arch_resume(void)
+{
+    int result;
+
+    result = fwk_arch_resume();
+    assert(result == FWK_SUCCESS);
+
+    /* The firmware has to boot again */
+    __fwk_module_resume_return_val = FWK_E_STATE;
+    result = fwk_arch_resume();
+    assert(result == FWK_E_STATE);
+
+    __fwk_module_resume_return_val = FWK_E_SUPPORT;
+    result = fwk_arch_resume();
+    assert(result == FWK_E_SUPPORT);
+
+    /* A module failed to resume */
+    __fwk_module_resume_return_val = FWK_E_DEVICE;
+    result = fwk_arch_resume();
+    assert(result == FWK_E_PANIC);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_arch_init_success),
     FWK_TEST_CASE(test_fwk_arch_init_bad_param),
     FWK_TEST_CASE(test_fwk_arch_init_mm_fail),
     FWK_TEST_CASE(test_fwk_arch_init_interrupt_fail),
-    FWK_TEST_CASE(test_fwk_arch_init_module_fail)
+    FWK_TEST_CASE(test_fwk_arch_init_module_fail),
+    FWK_TEST_CASE(test_fwk_arch_resume)
 };
 
 struct fwk_test_suite_desc test_suite = {
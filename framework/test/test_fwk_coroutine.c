@@ -0,0 +1,141 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <fwk_assert.h>
+#include <fwk_coroutine.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+#define REQUEST_EVENT_ID FWK_ID_EVENT(0x2, 0x0)
+#define ALARM_EVENT_ID FWK_ID_EVENT(0x2, 0x1)
+
+static struct fwk_coroutine coroutine;
+static unsigned int step;
+static bool ready;
+static int request_status;
+
+static int flow(struct fwk_coroutine *co, const struct fwk_event *event)
+{
+    FWK_COROUTINE_BEGIN(co);
+
+    step = 1;
+    FWK_COROUTINE_WAIT_RESPONSE(co, event, REQUEST_EVENT_ID);
+
+    step = 2;
+    if (request_status != FWK_SUCCESS)
+        FWK_COROUTINE_EXIT(co, request_status);
+
+    FWK_COROUTINE_WAIT_EVENT(co, event, ALARM_EVENT_ID);
+
+    step = 3;
+    FWK_COROUTINE_YIELD(co);
+
+    step = 4;
+    FWK_COROUTINE_WAIT_UNTIL(co, ready);
+
+    step = 5;
+    FWK_COROUTINE_END(co);
+}
+
+static void test_case_setup(void)
+{
+    fwk_coroutine_reset(&coroutine);
+    step = 0;
+    ready = false;
+    request_status = FWK_SUCCESS;
+}
+
+static void test_fwk_coroutine_flow(void)
+{
+    struct fwk_event event = { .id = REQUEST_EVENT_ID };
+
+    assert(!fwk_coroutine_is_running(&coroutine));
+
+    /* The request event starts the flow, its response is awaited */
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 1);
+    assert(fwk_coroutine_is_running(&coroutine));
+
+    /* Other events and the request event itself do not resume the flow */
+    event.id = ALARM_EVENT_ID;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    event.id = REQUEST_EVENT_ID;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 1);
+
+    event.is_response = true;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 2);
+
+    event.is_response = false;
+    event.id = ALARM_EVENT_ID;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 3);
+
+    /* Any event resumes a yield */
+    event.id = REQUEST_EVENT_ID;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 4);
+
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 4);
+
+    ready = true;
+    assert(flow(&coroutine, &event) == FWK_SUCCESS);
+    assert(step == 5);
+    assert(!fwk_coroutine_is_running(&coroutine));
+
+    /* The flow starts again with the next call */
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    assert(step == 1);
+}
+
+static void test_fwk_coroutine_exit(void)
+{
+    struct fwk_event event = { .id = REQUEST_EVENT_ID };
+
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+
+    request_status = FWK_E_DEVICE;
+    event.is_response = true;
+    assert(flow(&coroutine, &event) == FWK_E_DEVICE);
+    assert(step == 2);
+    assert(!fwk_coroutine_is_running(&coroutine));
+}
+
+static void test_fwk_coroutine_wait_until_true(void)
+{
+    struct fwk_event event = { .id = REQUEST_EVENT_ID };
+
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    event.is_response = true;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+    event.id = ALARM_EVENT_ID;
+    assert(flow(&coroutine, &event) == FWK_PENDING);
+
+    /* A condition that is already true does not wait */
+    ready = true;
+    assert(flow(&coroutine, &event) == FWK_SUCCESS);
+    assert(step == 5);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_coroutine_flow),
+    FWK_TEST_CASE(test_fwk_coroutine_exit),
+    FWK_TEST_CASE(test_fwk_coroutine_wait_until_true),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_coroutine",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
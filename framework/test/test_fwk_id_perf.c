@@ -0,0 +1,109 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Microbenchmark of the identifier comparison and index extraction
+ *     functions.
+ */
+
+#include <fwk_assert.h>
+#include <fwk_bench.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+#define OP_COUNT (1U << 22)
+
+/* Identifiers scanned by the benchmarks, as in a subscription list */
+static const fwk_id_t id_table[] = {
+    FWK_ID_MODULE_INIT(3),
+    FWK_ID_ELEMENT_INIT(3, 1),
+    FWK_ID_SUB_ELEMENT_INIT(3, 1, 2),
+    FWK_ID_API_INIT(3, 4),
+    FWK_ID_EVENT_INIT(3, 5),
+    FWK_ID_NOTIFICATION_INIT(3, 6),
+    FWK_ID_ELEMENT_INIT(7, 1),
+    FWK_ID_NOTIFICATION_INIT(7, 6),
+};
+
+/*
+ * The identifiers are read through a volatile pointer so that the compiler
+ * cannot fold the loops of the benchmarks.
+ */
+static const fwk_id_t *volatile id_table_ptr = id_table;
+
+static void bench_fwk_id_is_equal(unsigned int op_count)
+{
+    unsigned int i;
+    unsigned int match_count = 0;
+    const fwk_id_t *table = id_table_ptr;
+    fwk_id_t target = FWK_ID_NOTIFICATION(7, 6);
+
+    for (i = 0; i < op_count; i++) {
+        if (fwk_id_is_equal(table[i % FWK_ARRAY_SIZE(id_table)], target))
+            match_count++;
+    }
+
+    assert(match_count == (op_count / FWK_ARRAY_SIZE(id_table)));
+}
+
+static void bench_fwk_id_get_idx(unsigned int op_count)
+{
+    unsigned int i;
+    unsigned int sum = 0;
+    const fwk_id_t *table = id_table_ptr;
+    fwk_id_t id;
+
+    for (i = 0; i < op_count; i++) {
+        id = table[(i % 2) + 1];
+        sum += fwk_id_get_module_idx(id) + fwk_id_get_element_idx(id);
+    }
+
+    assert(sum == (op_count * 4));
+}
+
+static void bench_fwk_id_is_type(unsigned int op_count)
+{
+    unsigned int i;
+    unsigned int match_count = 0;
+    const fwk_id_t *table = id_table_ptr;
+
+    for (i = 0; i < op_count; i++) {
+        if (fwk_id_is_type(table[i % FWK_ARRAY_SIZE(id_table)],
+                           FWK_ID_TYPE_ELEMENT))
+            match_count++;
+    }
+
+    assert(match_count == (2 * op_count / FWK_ARRAY_SIZE(id_table)));
+}
+
+static void test_fwk_id_is_equal_perf(void)
+{
+    fwk_bench_run("fwk_id_is_equal", bench_fwk_id_is_equal, OP_COUNT);
+}
+
+static void test_fwk_id_get_idx_perf(void)
+{
+    fwk_bench_run("fwk_id_get_module_idx+fwk_id_get_element_idx",
+                  bench_fwk_id_get_idx, OP_COUNT);
+}
+
+static void test_fwk_id_is_type_perf(void)
+{
+    fwk_bench_run("fwk_id_is_type", bench_fwk_id_is_type, OP_COUNT);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_id_is_equal_perf),
+    FWK_TEST_CASE(test_fwk_id_get_idx_perf),
+    FWK_TEST_CASE(test_fwk_id_is_type_perf),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_id_perf",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
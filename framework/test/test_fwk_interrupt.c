@@ -33,6 +33,9 @@ static int set_isr_nmi_return_val;
 static int set_isr_nmi_param_return_val;
 static int set_isr_fault_return_val;
 static int get_current_return_val;
+static int get_trace_stats_return_val;
+static int set_priority_return_val;
+static int set_priority_grouping_return_val;
 static unsigned int global_enable_call_count;
 static unsigned int global_disable_call_count;
 
@@ -120,6 +123,22 @@ static int get_current(unsigned int *interrupt)
     return get_current_return_val;
 }
 
+static int get_trace_stats(unsigned int interrupt,
+                           struct fwk_interrupt_trace_stats *stats)
+{
+    return get_trace_stats_return_val;
+}
+
+static int set_priority(unsigned int interrupt, unsigned int priority)
+{
+    return set_priority_return_val;
+}
+
+static int set_priority_grouping(unsigned int subpriority_bits)
+{
+    return set_priority_grouping_return_val;
+}
+
 static const struct fwk_arch_interrupt_driver driver = {
     .global_enable = global_enable,
     .global_disable = global_disable,
@@ -135,6 +154,30 @@ static const struct fwk_arch_interrupt_driver driver = {
     .set_isr_nmi_param = set_isr_nmi_param,
     .set_isr_fault = set_isr_fault,
     .get_current = get_current,
+    .get_trace_stats = get_trace_stats,
+    .set_priority = set_priority,
+    .set_priority_grouping = set_priority_grouping,
+};
+
+/*
+ * Driver of an architecture layer that does not trace the interrupts and does
+ * not support their priorities
+ */
+static const struct fwk_arch_interrupt_driver driver_no_trace = {
+    .global_enable = global_enable,
+    .global_disable = global_disable,
+    .is_enabled = is_enabled,
+    .enable = enable,
+    .disable = disable,
+    .is_pending = is_pending,
+    .set_pending = set_pending,
+    .clear_pending = clear_pending,
+    .set_isr_irq = set_isr,
+    .set_isr_irq_param = set_isr_param,
+    .set_isr_nmi = set_isr_nmi,
+    .set_isr_nmi_param = set_isr_nmi_param,
+    .set_isr_fault = set_isr_fault,
+    .get_current = get_current,
 };
 
 static const struct fwk_arch_interrupt_driver driver_invalid = {};
@@ -153,6 +196,9 @@ static void test_case_setup(void)
     set_isr_nmi_param_return_val = FWK_E_HANDLER;
     set_isr_fault_return_val = FWK_E_HANDLER;
     get_current_return_val = FWK_E_HANDLER;
+    get_trace_stats_return_val = FWK_E_HANDLER;
+    set_priority_return_val = FWK_E_HANDLER;
+    set_priority_grouping_return_val = FWK_E_HANDLER;
     global_disable_call_count = 0;
     global_enable_call_count = 0;
 }
@@ -162,6 +208,7 @@ static void test_fwk_interrupt_before_init(void)
     int result;
     unsigned int interrupt = 1;
     bool state;
+    struct fwk_interrupt_trace_stats stats;
 
     result = fwk_interrupt_global_enable();
     assert(result == FWK_E_INIT);
@@ -198,6 +245,15 @@ static void test_fwk_interrupt_before_init(void)
 
     result = fwk_interrupt_get_current(&interrupt);
     assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_get_trace_stats(interrupt, &stats);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_set_priority(interrupt, 0);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_interrupt_set_priority_grouping(0);
+    assert(result == FWK_E_INIT);
 }
 
 static void test_fwk_interrupt_init(void)
@@ -345,6 +401,64 @@ static void test_fwk_interrupt_get_current(void)
     assert(result == FWK_SUCCESS);
 }
 
+static void test_fwk_interrupt_get_trace_stats(void)
+{
+    int result;
+    struct fwk_interrupt_trace_stats stats;
+
+    result = fwk_interrupt_get_trace_stats(INTERRUPT_ID, NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_interrupt_get_trace_stats(INTERRUPT_ID, &stats);
+    assert(result == FWK_E_HANDLER);
+
+    get_trace_stats_return_val = FWK_SUCCESS;
+    result = fwk_interrupt_get_trace_stats(INTERRUPT_ID, &stats);
+    assert(result == FWK_SUCCESS);
+
+    /* The tracing support of the driver is optional */
+    result = fwk_interrupt_init(&driver_no_trace);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_interrupt_get_trace_stats(INTERRUPT_ID, &stats);
+    assert(result == FWK_E_SUPPORT);
+
+    result = fwk_interrupt_init(&driver);
+    assert(result == FWK_SUCCESS);
+}
+
+static void test_fwk_interrupt_set_priority(void)
+{
+    int result;
+
+    result = fwk_interrupt_set_priority(INTERRUPT_ID, 1);
+    assert(result == FWK_E_HANDLER);
+
+    set_priority_return_val = FWK_SUCCESS;
+    result = fwk_interrupt_set_priority(INTERRUPT_ID, 1);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_interrupt_set_priority_grouping(1);
+    assert(result == FWK_E_HANDLER);
+
+    set_priority_grouping_return_val = FWK_SUCCESS;
+    result = fwk_interrupt_set_priority_grouping(1);
+    assert(result == FWK_SUCCESS);
+
+    /* The priority support of the driver is optional */
+    result = fwk_interrupt_init(&driver_no_trace);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_interrupt_set_priority(INTERRUPT_ID, 1);
+    assert(result == FWK_E_SUPPORT);
+
+    result = fwk_interrupt_set_priority_grouping(1);
+    assert(result == FWK_E_SUPPORT);
+
+    result = fwk_interrupt_init(&driver);
+    assert(result == FWK_SUCCESS);
+}
+
 static void test_fwk_interrupt_nested_critical_section(void)
 {
     fwk_interrupt_global_disable();
@@ -380,6 +494,8 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_interrupt_set_isr_param),
     FWK_TEST_CASE(test_fwk_interrupt_set_isr_fault),
     FWK_TEST_CASE(test_fwk_interrupt_get_current),
+    FWK_TEST_CASE(test_fwk_interrupt_get_trace_stats),
+    FWK_TEST_CASE(test_fwk_interrupt_set_priority),
     FWK_TEST_CASE(test_fwk_interrupt_nested_critical_section),
 };
 
@@ -0,0 +1,150 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <fwk_assert.h>
+#include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+struct item {
+    struct fwk_dlist_node node;
+    unsigned int key;
+};
+
+static struct fwk_dlist list;
+static struct item item[5];
+
+static bool is_before(const struct fwk_dlist_node *node,
+                      const struct fwk_dlist_node *other)
+{
+    return FWK_LIST_GET(node, struct item, node)->key <
+           FWK_LIST_GET(other, struct item, node)->key;
+}
+
+static void setup(void)
+{
+    unsigned int i;
+
+    fwk_list_init(&list);
+
+    /* Remove node links before each test case */
+    memset(item, 0, sizeof(item));
+    for (i = 0; i < FWK_ARRAY_SIZE(item); i++)
+        item[i].key = i * 10;
+}
+
+static void check_list(const unsigned int *order, unsigned int count)
+{
+    unsigned int i;
+    struct fwk_dlist_node *node = (struct fwk_dlist_node *)&list;
+
+    for (i = 0; i < count; i++) {
+        assert(node->next == &item[order[i]].node);
+        assert(node->next->prev == node);
+        node = node->next;
+    }
+
+    assert(node->next == (struct fwk_dlist_node *)&list);
+    assert(list.tail == node);
+}
+
+static void test_list_insert_sorted_empty(void)
+{
+    static const unsigned int order[] = { 2 };
+
+    fwk_list_insert_sorted(&list, &item[2].node, NULL, is_before);
+
+    check_list(order, FWK_ARRAY_SIZE(order));
+}
+
+static void test_list_insert_sorted_no_hint(void)
+{
+    static const unsigned int order[] = { 0, 1, 2, 3, 4 };
+
+    fwk_list_insert_sorted(&list, &item[2].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[0].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[4].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[1].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[3].node, NULL, is_before);
+
+    check_list(order, FWK_ARRAY_SIZE(order));
+}
+
+static void test_list_insert_sorted_hint_before(void)
+{
+    static const unsigned int order[] = { 0, 1, 3, 4 };
+
+    fwk_list_push_tail(&list, &item[0].node);
+    fwk_list_push_tail(&list, &item[1].node);
+    fwk_list_push_tail(&list, &item[4].node);
+
+    /* The search walks forward from the hint */
+    fwk_list_insert_sorted(&list, &item[3].node, &item[0].node, is_before);
+
+    check_list(order, FWK_ARRAY_SIZE(order));
+}
+
+static void test_list_insert_sorted_hint_after(void)
+{
+    static const unsigned int order[] = { 0, 1, 3, 4 };
+
+    fwk_list_push_tail(&list, &item[0].node);
+    fwk_list_push_tail(&list, &item[3].node);
+    fwk_list_push_tail(&list, &item[4].node);
+
+    /* The search walks back from the hint */
+    fwk_list_insert_sorted(&list, &item[1].node, &item[4].node, is_before);
+
+    check_list(order, FWK_ARRAY_SIZE(order));
+}
+
+static void test_list_insert_sorted_head_tail(void)
+{
+    static const unsigned int order[] = { 0, 2, 4 };
+
+    fwk_list_push_tail(&list, &item[2].node);
+
+    fwk_list_insert_sorted(&list, &item[4].node, &item[2].node, is_before);
+    fwk_list_insert_sorted(&list, &item[0].node, &item[4].node, is_before);
+
+    check_list(order, FWK_ARRAY_SIZE(order));
+    assert(list.head == &item[0].node);
+}
+
+static void test_list_insert_sorted_equal_keys(void)
+{
+    static const unsigned int order[] = { 0, 1, 2, 3 };
+
+    item[2].key = item[1].key;
+    item[3].key = item[1].key;
+
+    fwk_list_insert_sorted(&list, &item[0].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[1].node, NULL, is_before);
+    fwk_list_insert_sorted(&list, &item[2].node, &item[0].node, is_before);
+    fwk_list_insert_sorted(&list, &item[3].node, &item[1].node, is_before);
+
+    /* Nodes with equal keys keep their insertion order */
+    check_list(order, FWK_ARRAY_SIZE(order));
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_list_insert_sorted_empty),
+    FWK_TEST_CASE(test_list_insert_sorted_no_hint),
+    FWK_TEST_CASE(test_list_insert_sorted_hint_before),
+    FWK_TEST_CASE(test_list_insert_sorted_hint_after),
+    FWK_TEST_CASE(test_list_insert_sorted_head_tail),
+    FWK_TEST_CASE(test_list_insert_sorted_equal_keys),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_list_insert_sorted",
+    .test_case_setup = setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,159 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include <fwk_assert.h>
+#include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+static struct fwk_slist slist;
+static struct fwk_slist other_slist;
+static struct fwk_slist_node snodes[4];
+
+static struct fwk_dlist dlist;
+static struct fwk_dlist other_dlist;
+static struct fwk_dlist_node dnodes[4];
+
+static void test_case_setup(void)
+{
+    fwk_list_init(&slist);
+    fwk_list_init(&other_slist);
+    fwk_list_init(&dlist);
+    fwk_list_init(&other_dlist);
+
+    /* Remove node links before each test case */
+    memset(snodes, 0, sizeof(snodes));
+    memset(dnodes, 0, sizeof(dnodes));
+}
+
+static void test_slist_pop_head_n_empty(void)
+{
+    unsigned int moved;
+
+    moved = fwk_list_pop_head_n(&slist, &other_slist, 2);
+
+    assert(moved == 0);
+    assert(fwk_list_is_empty(&slist));
+    assert(fwk_list_is_empty(&other_slist));
+}
+
+static void test_slist_pop_head_n_zero(void)
+{
+    unsigned int moved;
+
+    fwk_list_push_tail(&slist, &snodes[0]);
+
+    moved = fwk_list_pop_head_n(&slist, &other_slist, 0);
+
+    assert(moved == 0);
+    assert(slist.head == &snodes[0]);
+    assert(fwk_list_is_empty(&other_slist));
+}
+
+static void test_slist_pop_head_n_some(void)
+{
+    unsigned int moved;
+
+    fwk_list_push_tail(&slist, &snodes[0]);
+    fwk_list_push_tail(&slist, &snodes[1]);
+    fwk_list_push_tail(&slist, &snodes[2]);
+    fwk_list_push_tail(&other_slist, &snodes[3]);
+
+    moved = fwk_list_pop_head_n(&slist, &other_slist, 2);
+
+    assert(moved == 2);
+
+    assert(slist.head == &snodes[2]);
+    assert(slist.tail == &snodes[2]);
+    assert(snodes[2].next == (struct fwk_slist_node *)&slist);
+
+    assert(other_slist.head == &snodes[3]);
+    assert(snodes[3].next == &snodes[0]);
+    assert(snodes[0].next == &snodes[1]);
+    assert(snodes[1].next == (struct fwk_slist_node *)&other_slist);
+    assert(other_slist.tail == &snodes[1]);
+}
+
+static void test_slist_pop_head_n_all(void)
+{
+    unsigned int moved;
+
+    fwk_list_push_tail(&slist, &snodes[0]);
+    fwk_list_push_tail(&slist, &snodes[1]);
+
+    moved = fwk_list_pop_head_n(&slist, &other_slist, 3);
+
+    assert(moved == 2);
+    assert(fwk_list_is_empty(&slist));
+
+    assert(other_slist.head == &snodes[0]);
+    assert(other_slist.tail == &snodes[1]);
+    assert(snodes[1].next == (struct fwk_slist_node *)&other_slist);
+}
+
+static void test_dlist_pop_head_n_some(void)
+{
+    unsigned int moved;
+
+    fwk_list_push_tail(&dlist, &dnodes[0]);
+    fwk_list_push_tail(&dlist, &dnodes[1]);
+    fwk_list_push_tail(&dlist, &dnodes[2]);
+    fwk_list_push_tail(&other_dlist, &dnodes[3]);
+
+    moved = fwk_list_pop_head_n(&dlist, &other_dlist, 2);
+
+    assert(moved == 2);
+
+    assert(dlist.head == &dnodes[2]);
+    assert(dlist.tail == &dnodes[2]);
+    assert(dnodes[2].prev == (struct fwk_dlist_node *)&dlist);
+
+    assert(other_dlist.head == &dnodes[3]);
+    assert(dnodes[3].next == &dnodes[0]);
+    assert(dnodes[0].prev == &dnodes[3]);
+    assert(dnodes[1].prev == &dnodes[0]);
+    assert(dnodes[1].next == (struct fwk_dlist_node *)&other_dlist);
+    assert(other_dlist.tail == &dnodes[1]);
+}
+
+static void test_dlist_pop_head_n_all(void)
+{
+    unsigned int moved;
+
+    fwk_list_push_tail(&dlist, &dnodes[0]);
+    fwk_list_push_tail(&dlist, &dnodes[1]);
+
+    moved = fwk_list_pop_head_n(&dlist, &other_dlist, 2);
+
+    assert(moved == 2);
+    assert(fwk_list_is_empty(&dlist));
+
+    assert(other_dlist.head == &dnodes[0]);
+    assert(dnodes[0].prev == (struct fwk_dlist_node *)&other_dlist);
+    assert(other_dlist.tail == &dnodes[1]);
+
+    /* The moved nodes can be removed from the other list */
+    fwk_list_remove(&other_dlist, &dnodes[1]);
+    assert(other_dlist.tail == &dnodes[0]);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_slist_pop_head_n_empty),
+    FWK_TEST_CASE(test_slist_pop_head_n_zero),
+    FWK_TEST_CASE(test_slist_pop_head_n_some),
+    FWK_TEST_CASE(test_slist_pop_head_n_all),
+    FWK_TEST_CASE(test_dlist_pop_head_n_some),
+    FWK_TEST_CASE(test_dlist_pop_head_n_all),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_list_pop_head_n",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
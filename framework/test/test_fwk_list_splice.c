@@ -0,0 +1,169 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <fwk_assert.h>
+#include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+static struct fwk_slist slist;
+static struct fwk_slist other_slist;
+
+static struct fwk_slist_node snodes[4];
+
+static struct fwk_dlist dlist;
+static struct fwk_dlist other_dlist;
+
+static struct fwk_dlist_node dnodes[4];
+
+static void test_case_setup(void)
+{
+    fwk_list_init(&slist);
+    fwk_list_init(&other_slist);
+
+    snodes[0] = (struct fwk_slist_node) { 0 };
+    snodes[1] = (struct fwk_slist_node) { 0 };
+    snodes[2] = (struct fwk_slist_node) { 0 };
+    snodes[3] = (struct fwk_slist_node) { 0 };
+
+    fwk_list_init(&dlist);
+    fwk_list_init(&other_dlist);
+
+    dnodes[0] = (struct fwk_dlist_node) { 0 };
+    dnodes[1] = (struct fwk_dlist_node) { 0 };
+    dnodes[2] = (struct fwk_dlist_node) { 0 };
+    dnodes[3] = (struct fwk_dlist_node) { 0 };
+}
+
+static void test_slist_splice_empty_on_empty(void)
+{
+    fwk_list_splice(&slist, &other_slist);
+
+    assert(fwk_list_is_empty(&slist));
+    assert(fwk_list_is_empty(&other_slist));
+}
+
+static void test_slist_splice_empty_on_many(void)
+{
+    fwk_list_push_tail(&slist, &snodes[0]);
+    fwk_list_push_tail(&slist, &snodes[1]);
+
+    fwk_list_splice(&slist, &other_slist);
+
+    assert(slist.head == &snodes[0]);
+    assert(slist.tail == &snodes[1]);
+    assert(snodes[1].next == (struct fwk_slist_node *)&slist);
+    assert(fwk_list_is_empty(&other_slist));
+}
+
+static void test_slist_splice_many_on_empty(void)
+{
+    fwk_list_push_tail(&other_slist, &snodes[0]);
+    fwk_list_push_tail(&other_slist, &snodes[1]);
+
+    fwk_list_splice(&slist, &other_slist);
+
+    assert(slist.head == &snodes[0]);
+    assert(slist.tail == &snodes[1]);
+    assert(snodes[0].next == &snodes[1]);
+    assert(snodes[1].next == (struct fwk_slist_node *)&slist);
+
+    assert(other_slist.head == (struct fwk_slist_node *)&other_slist);
+    assert(other_slist.tail == (struct fwk_slist_node *)&other_slist);
+}
+
+static void test_slist_splice_many_on_many(void)
+{
+    fwk_list_push_tail(&slist, &snodes[0]);
+    fwk_list_push_tail(&slist, &snodes[1]);
+    fwk_list_push_tail(&other_slist, &snodes[2]);
+    fwk_list_push_tail(&other_slist, &snodes[3]);
+
+    fwk_list_splice(&slist, &other_slist);
+
+    assert(slist.head == &snodes[0]);
+    assert(slist.tail == &snodes[3]);
+    assert(snodes[0].next == &snodes[1]);
+    assert(snodes[1].next == &snodes[2]);
+    assert(snodes[2].next == &snodes[3]);
+    assert(snodes[3].next == (struct fwk_slist_node *)&slist);
+
+    assert(fwk_list_is_empty(&other_slist));
+
+    /* The spliced list is still usable as a queue */
+    assert(fwk_list_pop_head(&slist) == &snodes[0]);
+    fwk_list_push_tail(&other_slist, &snodes[0]);
+    assert(other_slist.head == &snodes[0]);
+    assert(other_slist.tail == &snodes[0]);
+}
+
+static void test_dlist_splice_empty_on_many(void)
+{
+    fwk_list_push_tail(&dlist, &dnodes[0]);
+
+    fwk_list_splice(&dlist, &other_dlist);
+
+    assert(dlist.head == &dnodes[0]);
+    assert(dlist.tail == &dnodes[0]);
+    assert(fwk_list_is_empty(&other_dlist));
+}
+
+static void test_dlist_splice_many_on_empty(void)
+{
+    fwk_list_push_tail(&other_dlist, &dnodes[0]);
+    fwk_list_push_tail(&other_dlist, &dnodes[1]);
+
+    fwk_list_splice(&dlist, &other_dlist);
+
+    assert(dlist.head == &dnodes[0]);
+    assert(dlist.tail == &dnodes[1]);
+    assert(dnodes[0].prev == (struct fwk_dlist_node *)&dlist);
+    assert(dnodes[1].next == (struct fwk_dlist_node *)&dlist);
+
+    assert(fwk_list_is_empty(&other_dlist));
+}
+
+static void test_dlist_splice_many_on_many(void)
+{
+    fwk_list_push_tail(&dlist, &dnodes[0]);
+    fwk_list_push_tail(&dlist, &dnodes[1]);
+    fwk_list_push_tail(&other_dlist, &dnodes[2]);
+    fwk_list_push_tail(&other_dlist, &dnodes[3]);
+
+    fwk_list_splice(&dlist, &other_dlist);
+
+    assert(dlist.head == &dnodes[0]);
+    assert(dlist.tail == &dnodes[3]);
+    assert(dnodes[1].next == &dnodes[2]);
+    assert(dnodes[2].prev == &dnodes[1]);
+    assert(dnodes[3].next == (struct fwk_dlist_node *)&dlist);
+
+    assert(fwk_list_is_empty(&other_dlist));
+
+    /* The spliced nodes can be removed from the list */
+    fwk_list_remove(&dlist, &dnodes[2]);
+    assert(dnodes[1].next == &dnodes[3]);
+    assert(dnodes[3].prev == &dnodes[1]);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_slist_splice_empty_on_empty),
+    FWK_TEST_CASE(test_slist_splice_empty_on_many),
+    FWK_TEST_CASE(test_slist_splice_many_on_empty),
+    FWK_TEST_CASE(test_slist_splice_many_on_many),
+    FWK_TEST_CASE(test_dlist_splice_empty_on_many),
+    FWK_TEST_CASE(test_dlist_splice_many_on_empty),
+    FWK_TEST_CASE(test_dlist_splice_many_on_many),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_list_splice",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,172 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_lz4.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+
+static const char data[] =
+    "abcabcabcabcabcabcabcabcabcabcabcabcXYZXYZXYZXYZ hello hello hello hello!";
+
+/* The data, without its terminating null character, as an LZ4 block */
+static const uint8_t block[] = {
+    0x3F, 0x61, 0x62, 0x63, 0x03, 0x00, 0x0E, 0x35, 0x58, 0x59, 0x5A, 0x03,
+    0x00, 0x6A, 0x20, 0x68, 0x65, 0x6C, 0x6C, 0x6F, 0x06, 0x00, 0x50, 0x65,
+    0x6C, 0x6C, 0x6F, 0x21,
+};
+
+static uint8_t buffer[128];
+
+static void test_fwk_lz4_decompress(void)
+{
+    int status;
+    size_t size;
+
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), block, sizeof(block),
+                                &size);
+    assert(status == FWK_SUCCESS);
+    assert(size == (sizeof(data) - 1));
+    assert(memcmp(buffer, data, size) == 0);
+}
+
+static void test_fwk_lz4_decompress_param(void)
+{
+    int status;
+    size_t size;
+
+    status = fwk_lz4_decompress(NULL, sizeof(buffer), block, sizeof(block),
+                                &size);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), NULL, sizeof(block),
+                                &size);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), block, sizeof(block),
+                                NULL);
+    assert(status == FWK_E_PARAM);
+}
+
+static void test_fwk_lz4_decompress_nomem(void)
+{
+    int status;
+    size_t size;
+
+    status = fwk_lz4_decompress(buffer, sizeof(data) - 2, block, sizeof(block),
+                                &size);
+    assert(status == FWK_E_NOMEM);
+}
+
+static void test_fwk_lz4_decompress_truncated(void)
+{
+    int status;
+    size_t size;
+
+    /* The block ends in the middle of the offset of the first match */
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), block, 5, &size);
+    assert(status == FWK_E_DATA);
+
+    /* The block ends in the middle of the literals of the last sequence */
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), block,
+                                sizeof(block) - 1, &size);
+    assert(status == FWK_E_DATA);
+}
+
+static void test_fwk_lz4_decompress_invalid_offset(void)
+{
+    int status;
+    size_t size;
+    uint8_t invalid_block[sizeof(block)];
+
+    /* The first match refers to data before the start of the destination */
+    memcpy(invalid_block, block, sizeof(block));
+    invalid_block[4] = 0x04;
+
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), invalid_block,
+                                sizeof(invalid_block), &size);
+    assert(status == FWK_E_DATA);
+
+    invalid_block[4] = 0x00;
+
+    status = fwk_lz4_decompress(buffer, sizeof(buffer), invalid_block,
+                                sizeof(invalid_block), &size);
+    assert(status == FWK_E_DATA);
+}
+
+static void test_fwk_lz4_load_image_compressed(void)
+{
+    int status;
+    size_t size;
+    uint8_t image[sizeof(struct fwk_lz4_image_header) + sizeof(block)];
+    struct fwk_lz4_image_header header = {
+        .signature = FWK_LZ4_IMAGE_SIGNATURE,
+        .size = sizeof(data) - 1,
+        .compressed_size = sizeof(block),
+    };
+
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + sizeof(header), block, sizeof(block));
+
+    status = fwk_lz4_load_image(buffer, sizeof(buffer), image, sizeof(image),
+                                &size);
+    assert(status == FWK_SUCCESS);
+    assert(size == (sizeof(data) - 1));
+    assert(memcmp(buffer, data, size) == 0);
+
+    /* The image is larger than announced by its header */
+    header.size--;
+    memcpy(image, &header, sizeof(header));
+
+    status = fwk_lz4_load_image(buffer, sizeof(buffer), image, sizeof(image),
+                                &size);
+    assert(status != FWK_SUCCESS);
+
+    /* The block is larger than the image */
+    header.size++;
+    header.compressed_size++;
+    memcpy(image, &header, sizeof(header));
+
+    status = fwk_lz4_load_image(buffer, sizeof(buffer), image, sizeof(image),
+                                &size);
+    assert(status == FWK_E_DATA);
+}
+
+static void test_fwk_lz4_load_image_uncompressed(void)
+{
+    int status;
+    size_t size;
+
+    status = fwk_lz4_load_image(buffer, sizeof(buffer), data, sizeof(data),
+                                &size);
+    assert(status == FWK_SUCCESS);
+    assert(size == sizeof(data));
+    assert(memcmp(buffer, data, size) == 0);
+
+    status = fwk_lz4_load_image(buffer, sizeof(data) - 1, data, sizeof(data),
+                                &size);
+    assert(status == FWK_E_NOMEM);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_lz4_decompress),
+    FWK_TEST_CASE(test_fwk_lz4_decompress_param),
+    FWK_TEST_CASE(test_fwk_lz4_decompress_nomem),
+    FWK_TEST_CASE(test_fwk_lz4_decompress_truncated),
+    FWK_TEST_CASE(test_fwk_lz4_decompress_invalid_offset),
+    FWK_TEST_CASE(test_fwk_lz4_load_image_compressed),
+    FWK_TEST_CASE(test_fwk_lz4_load_image_uncompressed),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_lz4",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,103 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <fwk_assert.h>
+#include <fwk_macros.h>
+#include <fwk_mem.h>
+#include <fwk_test.h>
+
+#define BUFFER_SIZE 64
+#define GUARD 0xA5
+
+static uint32_t source_buffer[BUFFER_SIZE / sizeof(uint32_t)];
+static uint32_t buffer[(BUFFER_SIZE / sizeof(uint32_t)) + 2];
+static uint32_t reference[(BUFFER_SIZE / sizeof(uint32_t)) + 2];
+
+static void setup(void)
+{
+    uint8_t *source = (uint8_t *)source_buffer;
+    size_t i;
+
+    for (i = 0; i < sizeof(source_buffer); i++)
+        source[i] = (uint8_t)(i + 1);
+
+    memset(buffer, GUARD, sizeof(buffer));
+    memset(reference, GUARD, sizeof(reference));
+}
+
+static void test_fwk_mem_copy(void)
+{
+    const uint8_t *source = (const uint8_t *)source_buffer;
+    size_t dst_offset, src_offset, size;
+
+    for (dst_offset = 0; dst_offset < sizeof(uint32_t); dst_offset++) {
+        for (src_offset = 0; src_offset < sizeof(uint32_t); src_offset++) {
+            for (size = 0; size <= (BUFFER_SIZE - src_offset); size++) {
+                setup();
+
+                fwk_mem_copy((uint8_t *)buffer + dst_offset,
+                             source + src_offset, size);
+                memcpy((uint8_t *)reference + dst_offset,
+                       source + src_offset, size);
+
+                assert(memcmp(buffer, reference, sizeof(buffer)) == 0);
+            }
+        }
+    }
+}
+
+static void test_fwk_mem_set(void)
+{
+    size_t offset, size;
+
+    for (offset = 0; offset < sizeof(uint32_t); offset++) {
+        for (size = 0; size <= BUFFER_SIZE; size++) {
+            setup();
+
+            fwk_mem_set((uint8_t *)buffer + offset, 0x3C, size);
+            memset((uint8_t *)reference + offset, 0x3C, size);
+
+            assert(memcmp(buffer, reference, sizeof(buffer)) == 0);
+        }
+    }
+}
+
+static void test_fwk_mem_write_words(void)
+{
+    const uint8_t *source = (const uint8_t *)source_buffer;
+    size_t src_offset, size, padded_size;
+
+    for (src_offset = 0; src_offset < sizeof(uint32_t); src_offset++) {
+        for (size = 0; size <= (BUFFER_SIZE - src_offset); size++) {
+            setup();
+
+            fwk_mem_write_words(buffer, source + src_offset, size);
+
+            /* The last word is padded with zeros */
+            padded_size = FWK_ALIGN_NEXT(size, sizeof(uint32_t));
+            memset(reference, 0, padded_size);
+            memcpy(reference, source + src_offset, size);
+
+            assert(memcmp(buffer, reference, sizeof(buffer)) == 0);
+        }
+    }
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_mem_copy),
+    FWK_TEST_CASE(test_fwk_mem_set),
+    FWK_TEST_CASE(test_fwk_mem_write_words),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_mem",
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
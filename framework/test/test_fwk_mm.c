@@ -16,6 +16,7 @@
 #include <fwk_test.h>
 
 #define SIZE_MEM            (1024 * 1024)
+#define SIZE_HOT_MEM        1024
 #define ALLOC_NUM           5
 #define ALLOC_SIZE          64
 #define ALLOC_ODD_SIZE      3
@@ -31,6 +32,8 @@ static void test_fwk_mm_alloc(void);
 static void test_fwk_mm_alloc_aligned(void);
 static void test_fwk_mm_calloc(void);
 static void test_fwk_mm_calloc_aligned(void);
+static void test_fwk_mm_alloc_hot(void);
+static void test_fwk_mm_calloc_hot_tables(void);
 static void test_fwk_mm_lock(void);
 
 static const struct fwk_test_case_desc test_case_table[] = {
@@ -40,6 +43,8 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_mm_alloc_aligned),
     FWK_TEST_CASE(test_fwk_mm_calloc),
     FWK_TEST_CASE(test_fwk_mm_calloc_aligned),
+    FWK_TEST_CASE(test_fwk_mm_alloc_hot),
+    FWK_TEST_CASE(test_fwk_mm_calloc_hot_tables),
     FWK_TEST_CASE(test_fwk_mm_lock)
 };
 
@@ -50,9 +55,11 @@ struct fwk_test_suite_desc test_suite = {
 };
 
 extern int fwk_mm_init(uintptr_t start, size_t size);
+extern int fwk_mm_init_hot(uintptr_t start, size_t size);
 extern void fwk_mm_lock(void);
 
 static int start[SIZE_MEM];
+static char hot_start[SIZE_HOT_MEM];
 
 static void test_fwk_mm_alloc_before_init(void)
 {
@@ -291,9 +298,138 @@ static void test_fwk_mm_calloc_aligned(void)
 
 }
 
+static bool is_in_hot_mem(const void *block, size_t size)
+{
+    return ((uintptr_t)block >= (uintptr_t)hot_start) &&
+           (((uintptr_t)block + size) <=
+            ((uintptr_t)hot_start + SIZE_HOT_MEM));
+}
+
+static void test_fwk_mm_alloc_hot(void)
+{
+    int i;
+    int status;
+    char *result;
+    struct fwk_mm_stats stats;
+
+    /* Without hot memory, the block is allocated from the heap */
+    result = fwk_mm_alloc_hot(ALLOC_NUM, ALLOC_SIZE);
+    assert(result != NULL);
+    assert(!is_in_hot_mem(result, ALLOC_TOTAL_SIZE));
+
+    status = fwk_mm_get_stats(&stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.hot_size == 0);
+    assert(stats.hot_used == 0);
+
+    /* Invalid hot memory */
+    status = fwk_mm_init_hot(0, SIZE_HOT_MEM);
+    assert(status == FWK_E_RANGE);
+
+    status = fwk_mm_init_hot((uintptr_t)hot_start, 0);
+    assert(status == FWK_E_RANGE);
+
+    status = fwk_mm_init_hot((uintptr_t)hot_start, SIZE_HOT_MEM);
+    assert(status == FWK_SUCCESS);
+
+    status = fwk_mm_init_hot((uintptr_t)hot_start, SIZE_HOT_MEM);
+    assert(status == FWK_E_STATE);
+
+    /* Bad parameters */
+    result = fwk_mm_alloc_hot(0, ALLOC_SIZE);
+    assert(result == NULL);
+
+    result = fwk_mm_alloc_hot(ALLOC_NUM, 0);
+    assert(result == NULL);
+
+    /* The block is allocated from the hot memory */
+    result = fwk_mm_alloc_hot(ALLOC_NUM, ALLOC_SIZE);
+    assert(result != NULL);
+    assert(is_in_hot_mem(result, ALLOC_TOTAL_SIZE));
+    assert(((uintptr_t)result % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+
+    status = fwk_mm_get_stats(&stats);
+    assert(status == FWK_SUCCESS);
+    assert(stats.hot_size == SIZE_HOT_MEM);
+    assert(stats.hot_used >= ALLOC_TOTAL_SIZE);
+    assert(stats.size == (SIZE_MEM + SIZE_HOT_MEM));
+
+    memset(result, MEM_PATTERN, ALLOC_TOTAL_SIZE);
+
+    result = fwk_mm_calloc_hot(ALLOC_NUM, ALLOC_SIZE);
+    assert(result != NULL);
+    assert(is_in_hot_mem(result, ALLOC_TOTAL_SIZE));
+    for (i = 0; i < ALLOC_TOTAL_SIZE; i++)
+        assert(result[i] == 0);
+
+    /* A block not fitting in the hot memory is allocated from the heap */
+    result = fwk_mm_alloc_hot(1, SIZE_HOT_MEM);
+    assert(result != NULL);
+    assert(!is_in_hot_mem(result, SIZE_HOT_MEM));
+}
+
+static void test_fwk_mm_calloc_hot_tables(void)
+{
+    int i;
+    int status;
+    void *table_table[2];
+    const size_t entry_size_table[] = { ALLOC_ODD_SIZE, ALLOC_SIZE };
+    const size_t bad_entry_size_table[] = { ALLOC_ODD_SIZE, 0 };
+    const size_t overflow_entry_size_table[] = { SIZE_MAX, SIZE_MAX };
+    char *table;
+
+    /* Bad parameters */
+    status = fwk_mm_calloc_hot_tables(0, entry_size_table, table_table, 2);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, NULL, table_table, 2);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, entry_size_table, NULL, 2);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, entry_size_table,
+                                      table_table, 0);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, bad_entry_size_table,
+                                      table_table, 2);
+    assert(status == FWK_E_PARAM);
+
+    /* The size of the tables overflowed */
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, overflow_entry_size_table,
+                                      table_table, 2);
+    assert(status == FWK_E_PARAM);
+
+    /* The tables follow each other in the hot memory, aligned */
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, entry_size_table,
+                                      table_table, 2);
+    assert(status == FWK_SUCCESS);
+    assert(is_in_hot_mem(table_table[0], ALLOC_NUM * ALLOC_ODD_SIZE));
+    assert(is_in_hot_mem(table_table[1], ALLOC_TOTAL_SIZE));
+    assert(((uintptr_t)table_table[0] % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+    assert(((uintptr_t)table_table[1] % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+    assert((uintptr_t)table_table[1] ==
+           FWK_ALIGN_NEXT((uintptr_t)table_table[0] +
+                          (ALLOC_NUM * ALLOC_ODD_SIZE),
+                          FWK_MM_DEFAULT_ALIGNMENT));
+
+    /* Every allocated byte should be initialized to zero */
+    table = table_table[0];
+    for (i = 0; i < (ALLOC_NUM * ALLOC_ODD_SIZE); i++)
+        assert(table[i] == 0);
+
+    table = table_table[1];
+    for (i = 0; i < ALLOC_TOTAL_SIZE; i++)
+        assert(table[i] == 0);
+}
+
 static void test_fwk_mm_lock(void)
 {
+    int status;
     void *result;
+    void *table_table[1];
+    const size_t entry_size_table[] = { ALLOC_SIZE };
 
     /*
      * Make sure that memory allocation works properly before the
@@ -328,4 +464,14 @@ static void test_fwk_mm_lock(void)
 
     result = fwk_mm_calloc_aligned(ALLOC_NUM, ALLOC_SIZE, ALLOC_ALIGN);
     assert(result == NULL);
+
+    result = fwk_mm_alloc_hot(ALLOC_NUM, ALLOC_SIZE);
+    assert(result == NULL);
+
+    result = fwk_mm_calloc_hot(ALLOC_NUM, ALLOC_SIZE);
+    assert(result == NULL);
+
+    status = fwk_mm_calloc_hot_tables(ALLOC_NUM, entry_size_table,
+                                      table_table, 1);
+    assert(status == FWK_E_NOMEM);
 }
@@ -0,0 +1,120 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Microbenchmark of the memory allocation functions.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_assert.h>
+#include <fwk_bench.h>
+#include <fwk_errno.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_test.h>
+
+#define ALLOC_SIZE 16
+#define ALLOC_OP_COUNT 4096
+#define BLOCK_COUNT 64
+#define POOL_OP_COUNT (1U << 20)
+
+/* The heap is never freed, it has to hold the allocations of all the runs */
+#define SIZE_MEM ((ALLOC_OP_COUNT * ALLOC_SIZE * FWK_BENCH_RUN_COUNT * 2) + \
+                  (BLOCK_COUNT * ALLOC_SIZE))
+
+extern int fwk_mm_init(uintptr_t start, size_t size);
+
+static uint64_t start[SIZE_MEM / sizeof(uint64_t)];
+static struct fwk_mm_pool pool;
+
+/* Mock functions */
+int __wrap_fwk_interrupt_global_enable(void)
+{
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_global_disable(void)
+{
+    return FWK_SUCCESS;
+}
+
+static void bench_fwk_mm_alloc(unsigned int op_count)
+{
+    unsigned int i;
+    void *block;
+
+    for (i = 0; i < op_count; i++) {
+        block = fwk_mm_alloc(1, ALLOC_SIZE);
+        assert(block != NULL);
+    }
+}
+
+static void bench_fwk_mm_calloc(unsigned int op_count)
+{
+    unsigned int i;
+    void *block;
+
+    for (i = 0; i < op_count; i++) {
+        block = fwk_mm_calloc(1, ALLOC_SIZE);
+        assert(block != NULL);
+    }
+}
+
+static void bench_fwk_mm_pool(unsigned int op_count)
+{
+    int status;
+    unsigned int i;
+    void *block;
+
+    for (i = 0; i < op_count; i++) {
+        block = fwk_mm_pool_alloc(&pool);
+        assert(block != NULL);
+
+        status = fwk_mm_pool_free(&pool, block);
+        assert(status == FWK_SUCCESS);
+    }
+}
+
+static int test_suite_setup(void)
+{
+    int status;
+
+    status = fwk_mm_init((uintptr_t)start, sizeof(start));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_mm_pool_init(&pool, BLOCK_COUNT, ALLOC_SIZE);
+}
+
+static void test_fwk_mm_alloc_perf(void)
+{
+    fwk_bench_run("fwk_mm_alloc", bench_fwk_mm_alloc, ALLOC_OP_COUNT);
+}
+
+static void test_fwk_mm_calloc_perf(void)
+{
+    fwk_bench_run("fwk_mm_calloc", bench_fwk_mm_calloc, ALLOC_OP_COUNT);
+}
+
+static void test_fwk_mm_pool_perf(void)
+{
+    fwk_bench_run("fwk_mm_pool_alloc+fwk_mm_pool_free", bench_fwk_mm_pool,
+                  POOL_OP_COUNT);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_mm_alloc_perf),
+    FWK_TEST_CASE(test_fwk_mm_calloc_perf),
+    FWK_TEST_CASE(test_fwk_mm_pool_perf),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_mm_perf",
+    .test_suite_setup = test_suite_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,204 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_test.h>
+
+#define SIZE_MEM            (64 * 1024)
+#define BLOCK_COUNT         4
+#define BLOCK_SIZE          20
+
+extern int fwk_mm_init(uintptr_t start, size_t size);
+extern void fwk_mm_lock(void);
+
+static int start[SIZE_MEM];
+
+/* Mock functions */
+static int critical_section_nest_level;
+int __wrap_fwk_interrupt_global_enable(void)
+{
+    assert(critical_section_nest_level > 0);
+    critical_section_nest_level--;
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_global_disable(void)
+{
+    critical_section_nest_level++;
+    return FWK_SUCCESS;
+}
+
+static int test_suite_setup(void)
+{
+    return fwk_mm_init((uintptr_t)start, sizeof(start));
+}
+
+static void test_case_teardown(void)
+{
+    assert(critical_section_nest_level == 0);
+}
+
+static void test_fwk_mm_pool_init(void)
+{
+    int result;
+    struct fwk_mm_pool pool;
+
+    result = fwk_mm_pool_init(NULL, BLOCK_COUNT, BLOCK_SIZE);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_init(&pool, 0, BLOCK_SIZE);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, 0);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_init(&pool, SIZE_MEM, SIZE_MEM);
+    assert(result == FWK_E_NOMEM);
+
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, BLOCK_SIZE);
+    assert(result == FWK_SUCCESS);
+    assert((pool.start % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+    assert(pool.block_size >= BLOCK_SIZE);
+    assert((pool.block_size % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+
+    /* Blocks smaller than a pointer are enlarged to hold the free list */
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, 1);
+    assert(result == FWK_SUCCESS);
+    assert(pool.block_size >= sizeof(void *));
+}
+
+static void test_fwk_mm_pool_alloc_free(void)
+{
+    int result;
+    unsigned int i;
+    struct fwk_mm_pool pool;
+    void *block_table[BLOCK_COUNT];
+    void *block;
+
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, BLOCK_SIZE);
+    assert(result == FWK_SUCCESS);
+
+    assert(fwk_mm_pool_alloc(NULL) == NULL);
+
+    /* All the blocks are distinct and aligned */
+    for (i = 0; i < BLOCK_COUNT; i++) {
+        block_table[i] = fwk_mm_pool_alloc(&pool);
+        assert(block_table[i] != NULL);
+        assert(((uintptr_t)block_table[i] % FWK_MM_DEFAULT_ALIGNMENT) == 0);
+        if (i > 0) {
+            assert(((uintptr_t)block_table[i] -
+                    (uintptr_t)block_table[i - 1]) >= BLOCK_SIZE);
+        }
+    }
+
+    /* The pool is exhausted */
+    assert(fwk_mm_pool_alloc(&pool) == NULL);
+
+    /* Blocks that do not belong to the pool */
+    result = fwk_mm_pool_free(NULL, block_table[0]);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_free(&pool, NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_free(&pool, (char *)block_table[0] + 1);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_free(&pool, (char *)block_table[0] - 1);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_free(&pool,
+        (char *)pool.start + (BLOCK_COUNT * pool.block_size));
+    assert(result == FWK_E_PARAM);
+
+    /* A released block is the next one to be allocated */
+    result = fwk_mm_pool_free(&pool, block_table[2]);
+    assert(result == FWK_SUCCESS);
+
+    block = fwk_mm_pool_alloc(&pool);
+    assert(block == block_table[2]);
+    assert(fwk_mm_pool_alloc(&pool) == NULL);
+
+    /* The blocks can be used again once all of them are released */
+    for (i = 0; i < BLOCK_COUNT; i++) {
+        result = fwk_mm_pool_free(&pool, block_table[i]);
+        assert(result == FWK_SUCCESS);
+    }
+
+    for (i = 0; i < BLOCK_COUNT; i++)
+        assert(fwk_mm_pool_alloc(&pool) != NULL);
+    assert(fwk_mm_pool_alloc(&pool) == NULL);
+}
+
+static void test_fwk_mm_pool_get_stats(void)
+{
+    int result;
+    struct fwk_mm_pool pool;
+    struct fwk_mm_pool_stats stats;
+    void *block1, *block2;
+
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, BLOCK_SIZE);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_mm_pool_get_stats(NULL, &stats);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_get_stats(&pool, NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_mm_pool_get_stats(&pool, &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.size == BLOCK_COUNT);
+    assert(stats.used == 0);
+    assert(stats.used_max == 0);
+
+    block1 = fwk_mm_pool_alloc(&pool);
+    block2 = fwk_mm_pool_alloc(&pool);
+    result = fwk_mm_pool_free(&pool, block1);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_mm_pool_get_stats(&pool, &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.size == BLOCK_COUNT);
+    assert(stats.used == 1);
+    assert(stats.used_max == 2);
+
+    result = fwk_mm_pool_free(&pool, block2);
+    assert(result == FWK_SUCCESS);
+}
+
+static void test_fwk_mm_pool_lock(void)
+{
+    int result;
+    struct fwk_mm_pool pool;
+
+    /* The pools cannot be created once the heap is locked */
+    fwk_mm_lock();
+    result = fwk_mm_pool_init(&pool, BLOCK_COUNT, BLOCK_SIZE);
+    assert(result == FWK_E_NOMEM);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_mm_pool_init),
+    FWK_TEST_CASE(test_fwk_mm_pool_alloc_free),
+    FWK_TEST_CASE(test_fwk_mm_pool_get_stats),
+    FWK_TEST_CASE(test_fwk_mm_pool_lock),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_mm_pool",
+    .test_suite_setup = test_suite_setup,
+    .test_case_teardown = test_case_teardown,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -9,6 +9,7 @@
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_macros.h>
+#include <fwk_mm.h>
 #include <fwk_test.h>
 #include <internal/fwk_module.h>
 
@@ -75,6 +76,7 @@ static struct config_module_data config_module1;
 
 struct fwk_module *module_table[3];
 struct fwk_module_config *module_config_table[3];
+struct fwk_module_static_binding module_static_binding_table[3];
 
 static struct fwk_module fake_module_desc0;
 static struct fwk_module fake_module_desc1;
@@ -90,19 +92,28 @@ static int bind_return_val;
 static int bind_count_call;
 static int start_return_val;
 static int start_count_call;
+static int resume_return_val;
+static int resume_count_call;
 static int process_bind_request_return_val;
 static bool process_bind_request_return_api;
 static bool get_element_table0_return_val;
 static bool get_element_table1_return_val;
 static int process_event_return_val;
 static int thread_init_return_val;
+static size_t thread_init_event_count;
+static size_t heap_used;
+static size_t init_heap_usage;
 
 static int init(fwk_id_t module_id, unsigned int element_count,
     const void *data)
 {
-    (void) module_id;
     (void) element_count;
     (void) data;
+
+    /* Module 0 allocates memory during its initialization */
+    if (fwk_id_is_equal(module_id, MODULE0_ID))
+        heap_used += init_heap_usage;
+
     return init_return_val;
 }
 
@@ -135,6 +146,13 @@ static int start(fwk_id_t id)
     return start_return_val;
 }
 
+static int resume(fwk_id_t id)
+{
+    (void) id;
+    resume_count_call++;
+    return resume_return_val;
+}
+
 static struct fake_api fake_api = {
     .init = init,
     .element_init = element_init
@@ -184,18 +202,27 @@ void * __wrap_fwk_mm_calloc(size_t num, size_t size)
 {
     if (num == 0)
         return NULL;
-    if (fwk_mm_calloc_return == 0)
+    if (fwk_mm_calloc_return == 0) {
+        heap_used += num * size;
         return calloc(num, size);
-    else if (fwk_mm_calloc_return <= 4) {
+    } else if (fwk_mm_calloc_return <= 4) {
         fwk_mm_calloc_return++;
+        heap_used += num * size;
         return calloc(num, size);
     }
     return NULL;
 }
 
+int __wrap_fwk_mm_get_stats(struct fwk_mm_stats *stats)
+{
+    stats->size = SIZE_MAX;
+    stats->used = heap_used;
+    return FWK_SUCCESS;
+}
+
 int __wrap___fwk_thread_init(size_t event_count)
 {
-    (void) event_count;
+    thread_init_event_count = event_count;
     return thread_init_return_val;
 }
 
@@ -220,6 +247,7 @@ static void test_case_setup(void)
     post_init_return_val = FWK_SUCCESS;
     bind_return_val = FWK_SUCCESS;
     start_return_val = FWK_SUCCESS;
+    resume_return_val = FWK_SUCCESS;
     process_bind_request_return_val = FWK_SUCCESS;
     process_bind_request_return_api = true;
     process_event_return_val = FWK_SUCCESS;
@@ -227,6 +255,8 @@ static void test_case_setup(void)
 
     bind_count_call = 0;
     start_count_call = 0;
+    resume_count_call = 0;
+    init_heap_usage = 0;
 
     config_elem0.fake_val = 5;
     config_elem0.ref = fwk_id_build_element_id(MODULE0_ID, ELEM0_IDX);
@@ -250,6 +280,8 @@ static void test_case_setup(void)
     fake_module_desc0.post_init = post_init;
     fake_module_desc0.bind = bind;
     fake_module_desc0.start = start;
+    fake_module_desc0.resume = resume;
+    fake_module_desc0.retainable = false;
     fake_module_desc0.process_bind_request = process_bind_request;
 
     fake_module_desc1.name = "FAKE MODULE 1";
@@ -262,6 +294,8 @@ static void test_case_setup(void)
     fake_module_desc1.post_init = post_init;
     fake_module_desc1.bind = bind;
     fake_module_desc1.start = start;
+    fake_module_desc1.resume = resume;
+    fake_module_desc1.retainable = false;
 
     fake_element_desc_table0[0].name = "FAKE ELEM 0";
     fake_element_desc_table0[0].data = &config_elem0;
@@ -277,10 +311,12 @@ static void test_case_setup(void)
     fake_element_desc_table1[1].data = NULL;
 
     fake_module_config0.get_element_table = get_element_table0;
+    fake_module_config0.elements = NULL;
     fake_module_config0.data = &config_module0;
 
     fake_module_config1.get_element_table = get_element_table1;
     fake_module_config1.data = &config_module1;
+    fake_module_config1.deferred_start = false;
 
     module_table[0] = &fake_module_desc0;
     module_table[1] = &fake_module_desc1;
@@ -290,6 +326,9 @@ static void test_case_setup(void)
     module_config_table[1] = &fake_module_config1;
     module_config_table[2] = NULL;
 
+    memset(module_static_binding_table, 0,
+           sizeof(module_static_binding_table));
+
     __fwk_module_reset();
     __fwk_module_init();
 }
@@ -554,6 +593,29 @@ static void test_fwk_thread_failure(void)
     thread_init_return_val = FWK_SUCCESS;
 }
 
+static void test_fwk_thread_event_pool_size(void)
+{
+    size_t default_event_count;
+
+    fake_module_desc0.event_pool_size = 0;
+    fake_module_desc1.event_pool_size = 0;
+    thread_init_return_val = FWK_E_PARAM;
+    __fwk_module_reset();
+    __fwk_module_init();
+    default_event_count = thread_init_event_count;
+
+    /* The event pool grows with the sizes declared by the modules */
+    fake_module_desc0.event_pool_size = 4;
+    fake_module_desc1.event_pool_size = 2;
+    __fwk_module_reset();
+    __fwk_module_init();
+    assert(thread_init_event_count == (default_event_count + 6));
+
+    fake_module_desc0.event_pool_size = 0;
+    fake_module_desc1.event_pool_size = 0;
+    thread_init_return_val = FWK_SUCCESS;
+}
+
 static void check_correct_initialization(void)
 {
     int result;
@@ -625,6 +687,68 @@ static void test___fwk_module_init_succeed(void)
     check_correct_initialization();
 }
 
+static void test___fwk_module_init_static_element_table(void)
+{
+    int result;
+
+    /* Module 0 describes its elements with a static table */
+    fake_module_config0.get_element_table = NULL;
+    fake_module_config0.elements = fake_element_desc_table0;
+
+    __fwk_module_reset();
+    result = __fwk_module_init();
+    assert(result == FWK_SUCCESS);
+    assert(__fwk_module_get_ctx(MODULE0_ID)->element_count == 2);
+    assert(__fwk_module_get_element_ctx(ELEM0_ID)->desc ==
+           &fake_element_desc_table0[0]);
+    assert(__fwk_module_get_element_ctx(ELEM1_ID)->desc ==
+           &fake_element_desc_table0[1]);
+}
+
+static void test_fwk_module_start_deferred(void)
+{
+    int result;
+    enum fwk_module_state state;
+
+    /* Not allowed before the runtime phase */
+    __fwk_module_reset();
+    result = fwk_module_start_deferred();
+    assert(result == FWK_E_STATE);
+
+    /* The start of module 1 and its element is deferred */
+    fake_module_config1.deferred_start = true;
+    start_count_call = 0;
+    result = __fwk_module_init();
+    assert(result == FWK_SUCCESS);
+    assert(start_count_call == 3);
+
+    result = __fwk_module_get_state(MODULE1_ID, &state);
+    assert(result == FWK_SUCCESS);
+    assert(state == FWK_MODULE_STATE_BOUND);
+
+    result = __fwk_module_get_state(ELEM2_ID, &state);
+    assert(result == FWK_SUCCESS);
+    assert(state == FWK_MODULE_STATE_BOUND);
+
+    /* Only module 1 and its element are started */
+    result = fwk_module_start_deferred();
+    assert(result == FWK_SUCCESS);
+    assert(start_count_call == 5);
+
+    result = __fwk_module_get_state(MODULE1_ID, &state);
+    assert(result == FWK_SUCCESS);
+    assert(state == FWK_MODULE_STATE_STARTED);
+
+    result = __fwk_module_get_state(ELEM2_ID, &state);
+    assert(result == FWK_SUCCESS);
+    assert(state == FWK_MODULE_STATE_STARTED);
+
+    /* Started modules are not started again */
+    result = fwk_module_start_deferred();
+    assert(result == FWK_SUCCESS);
+    assert(start_count_call == 5);
+}
+
 static void test___fwk_module_get_state(void)
 {
     int result;
@@ -929,6 +1053,54 @@ static void test_fwk_module_get_sub_element_count(void)
     assert(sub_element_count == 1);
 }
 
+static void test_fwk_module_get_heap_usage(void)
+{
+    int result;
+    size_t size;
+
+    init_heap_usage = 100;
+    __fwk_module_reset();
+    result = __fwk_module_init();
+    assert(result == FWK_SUCCESS);
+
+    /*
+     * Module 0 is charged with its own allocation and with the contexts and
+     * notification subscription lists of its two elements and itself.
+     */
+    result = fwk_module_get_heap_usage(MODULE0_ID, &size);
+    assert(result == FWK_SUCCESS);
+    assert(size == (100 + (2 * sizeof(struct fwk_element_ctx)) +
+                    (3 * 3 * sizeof(struct fwk_dlist))));
+
+    /* Module 1 is only charged with the context of its element */
+    result = fwk_module_get_heap_usage(MODULE1_ID, &size);
+    assert(result == FWK_SUCCESS);
+    assert(size == sizeof(struct fwk_element_ctx));
+
+    result = fwk_module_get_heap_usage(MODULE0_ID, NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_module_get_heap_usage(ELEM0_ID, &size);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_module_get_heap_usage(FWK_ID_MODULE(2), &size);
+    assert(result == FWK_E_PARAM);
+}
+
+static void test_fwk_module_get_boot_time(void)
+{
+    int result;
+    struct fwk_module_boot_time time;
+
+    __fwk_module_reset();
+    result = __fwk_module_init();
+    assert(result == FWK_SUCCESS);
+
+    /* The tests are built without event profiling, hence no timestamps */
+    result = fwk_module_get_boot_time(MODULE0_ID, &time);
+    assert(result == FWK_E_SUPPORT);
+}
+
 static void test_fwk_module_get_name(void)
 {
     fwk_id_t id;
@@ -1024,6 +1196,39 @@ static void test_fwk_module_check_call_succeed(void)
     assert(result == FWK_SUCCESS);
 }
 
+static void test___fwk_module_get_state_sub_element(void)
+{
+    int result;
+    enum fwk_module_state state;
+
+    __fwk_module_reset();
+    result = __fwk_module_init();
+    assert(result == FWK_SUCCESS);
+
+    result = __fwk_module_get_state(SUB_ELEM0_ID, &state);
+    assert(result == FWK_SUCCESS);
+    assert(state == FWK_MODULE_STATE_STARTED);
+
+    /* Invalid module, element and sub-element indices */
+    result = __fwk_module_get_state(FWK_ID_MODULE(2), &state);
+    assert(result == FWK_E_PARAM);
+
+    result = __fwk_module_get_state(FWK_ID_ELEMENT(MODULE1_IDX, 1), &state);
+    assert(result == FWK_E_PARAM);
+
+    result = __fwk_module_get_state(
+        FWK_ID_SUB_ELEMENT(MODULE0_IDX, ELEM0_IDX, 1), &state);
+    assert(result == FWK_E_PARAM);
+
+    result = __fwk_module_get_state(
+        FWK_ID_SUB_ELEMENT(MODULE0_IDX, ELEM1_IDX, 0), &state);
+    assert(result == FWK_E_PARAM);
+
+    /* Not an entity identifier */
+    result = __fwk_module_get_state(API0_ID, &state);
+    assert(result == FWK_E_PARAM);
+}
+
 static void test_fwk_module_bind_stage_failure(void)
 {
     int result;
@@ -1123,6 +1328,72 @@ static void test_fwk_module_bind(void)
     assert(result == FWK_SUCCESS);
 }
 
+static void test_fwk_module_bind_static_binding(void)
+{
+    int result;
+    struct fake_api static_api;
+    struct fake_api *api;
+
+    module_static_binding_table[0] = (struct fwk_module_static_binding) {
+        .source_id = FWK_ID_NONE_INIT,
+        .api_id = FWK_ID_API_INIT(MODULE0_IDX, API0_IDX),
+        .api = &static_api,
+    };
+
+    /* The framework component is forced into the bound stage */
+    __fwk_module_reset();
+    bind_return_val = FWK_E_PARAM;
+    result = __fwk_module_init();
+    assert(result == FWK_E_PARAM);
+    bind_return_val = FWK_SUCCESS;
+
+    /*
+     * The binding request should return the API of the table without calling
+     * the process_bind_request function of the module.
+     */
+    process_bind_request_return_val = FWK_E_PARAM;
+    api = NULL;
+    result = fwk_module_bind(MODULE0_ID, API0_ID, &api);
+    assert(result == FWK_SUCCESS);
+    assert(api == &static_api);
+
+    /* The API is not in the table, the module processes the request */
+    result = fwk_module_bind(MODULE0_ID, API1_ID, &api);
+    assert(result == FWK_E_PARAM);
+    process_bind_request_return_val = FWK_SUCCESS;
+}
+
+static void test___fwk_module_resume(void)
+{
+    int result;
+
+    /* Module 1 is not retainable */
+    fake_module_desc0.retainable = true;
+    result = __fwk_module_resume();
+    assert(result == FWK_E_SUPPORT);
+    assert(resume_count_call == 0);
+
+    /*
+     * The modules are resumed, and then their elements. The function does not
+     * return once the events are processed again.
+     */
+    fake_module_desc1.retainable = true;
+    __fwk_module_resume();
+    assert(resume_count_call == 5);
+
+    /* A module fails to resume */
+    resume_count_call = 0;
+    resume_return_val = FWK_E_DEVICE;
+    result = __fwk_module_resume();
+    assert(result == FWK_E_DEVICE);
+    assert(resume_count_call == 1);
+
+    /* The framework was not initialized */
+    __fwk_module_reset();
+    result = __fwk_module_resume();
+    assert(result == FWK_E_STATE);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test___fwk_module_init_memory_allocation_failure),
     FWK_TEST_CASE(test___fwk_module_init_module_desc_bad_params),
@@ -1130,7 +1401,10 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test___fwk_module_init_bind_failure),
     FWK_TEST_CASE(test___fwk_module_init_start_failure),
     FWK_TEST_CASE(test_fwk_thread_failure),
+    FWK_TEST_CASE(test_fwk_thread_event_pool_size),
     FWK_TEST_CASE(test___fwk_module_init_succeed),
+    FWK_TEST_CASE(test___fwk_module_init_static_element_table),
+    FWK_TEST_CASE(test_fwk_module_start_deferred),
     FWK_TEST_CASE(test___fwk_module_get_state),
     FWK_TEST_CASE(test_fwk_module_is_valid_module_id),
     FWK_TEST_CASE(test_fwk_module_is_valid_element_id),
@@ -1141,12 +1415,17 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_fwk_module_is_valid_notification_id),
     FWK_TEST_CASE(test_fwk_module_get_element_count),
     FWK_TEST_CASE(test_fwk_module_get_sub_element_count),
+    FWK_TEST_CASE(test_fwk_module_get_heap_usage),
+    FWK_TEST_CASE(test_fwk_module_get_boot_time),
     FWK_TEST_CASE(test_fwk_module_get_name),
     FWK_TEST_CASE(test_fwk_module_get_data),
     FWK_TEST_CASE(test_fwk_module_check_call_failed),
     FWK_TEST_CASE(test_fwk_module_check_call_succeed),
+    FWK_TEST_CASE(test___fwk_module_get_state_sub_element),
     FWK_TEST_CASE(test_fwk_module_bind_stage_failure),
-    FWK_TEST_CASE(test_fwk_module_bind)
+    FWK_TEST_CASE(test_fwk_module_bind),
+    FWK_TEST_CASE(test_fwk_module_bind_static_binding),
+    FWK_TEST_CASE(test___fwk_module_resume)
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -39,6 +39,7 @@ static struct __fwk_multi_thread_ctx *ctx;
 /* Mock module */
 static struct __fwk_thread_ctx fake_thread_module_ctx;
 static struct fwk_module fake_module;
+static const struct fwk_module_config fake_module_config;
 static struct fwk_module_ctx fake_module_ctx;
 
 static unsigned int process_event_call_count;
@@ -93,6 +94,11 @@ osStatus_t __wrap_osKernelInitialize(void)
 {
     return osOK;
 }
+
+osStatus_t __wrap_osThreadYield(void)
+{
+    return osOK;
+}
 /*
  * Indicate the number of function calls before exiting the non-returning
  * functions
@@ -172,6 +178,18 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return fwk_mm_calloc_val;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_aligned(size_t num, size_t size,
+                                   unsigned int alignment)
+{
+    (void) alignment;
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 int __wrap_fwk_interrupt_global_disable(void)
 {
     return 0;
@@ -207,6 +225,11 @@ bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
     return true;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
 {
     (void) id;
@@ -236,11 +259,15 @@ static int test_suite_setup(void)
     if (status != FWK_SUCCESS)
         return status;
 
+    fake_module_ctx.config = &fake_module_config;
+
     return fwk_thread_create(FWK_ID_MODULE(0x0));
 }
 
 static void test_case_setup(void)
 {
+    unsigned int list_idx;
+
     event[0].slist_node = slist_node[0];
     event[0].source_id = FWK_ID_MODULE(0x1);
     event[0].target_id = FWK_ID_MODULE(0x2);
@@ -316,6 +343,7 @@ static void test_case_setup(void)
     fake_module_ctx.thread_ctx = &fake_thread_module_ctx;
     fake_thread_module_ctx.response_event = NULL;
     fake_thread_module_ctx.waiting_event_processing_completion = false;
+    fake_thread_module_ctx.priority = 0;
 
     ctx->waiting_for_isr_event = false;
     ctx->event_cookie_counter = 0;
@@ -324,7 +352,8 @@ static void test_case_setup(void)
     fwk_list_init(&ctx->event_isr_queue);
     fwk_list_init(&ctx->common_thread_ctx.event_queue);
     fwk_list_init(&fake_thread_module_ctx.event_queue);
-    fwk_list_init(&fake_module_ctx.delayed_response_list);
+    for (list_idx = 0; list_idx < FWK_DELAYED_RESPONSE_LIST_COUNT; list_idx++)
+        fwk_list_init(&ctx->delayed_response_table[list_idx]);
 }
 
 static void test_get_next_isr_event_1(void)
@@ -357,6 +386,37 @@ static void test_get_next_isr_event_1(void)
     assert(ctx->event_cookie_counter == 0);
 }
 
+static void test_get_next_isr_event_append_in_progress(void)
+{
+    /*
+     * Test of get_next_isr_event() when an ISR has swapped the tail of the
+     * queue of ISR events with its event but has not linked it yet to the
+     * only event of the queue.
+     * The first event is not taken out of the queue as the queue cannot be
+     * emptied, the execution proceeds to wait for an ISR event and is stopped.
+     */
+    fwk_list_push_tail(&ctx->event_isr_queue, &event[0].slist_node);
+    event[1].slist_node.next = (struct fwk_slist_node *)&ctx->event_isr_queue;
+    ctx->event_isr_queue.tail = &event[1].slist_node;
+
+    osThreadFlagsWait_break = 1;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        common_thread_function(NULL);
+
+    assert(process_event_call_count == 0);
+    assert(process_notification_call_count == 0);
+
+    assert(osThreadFlagsWait_param_flags[0] == SIGNAL_ISR_EVENT);
+    assert(osThreadFlagsSet_call_count == 0);
+
+    assert(ctx->event_isr_queue.head == &event[0].slist_node);
+    assert(ctx->event_isr_queue.tail == &event[1].slist_node);
+    assert(fwk_list_is_empty(&ctx->thread_ready_queue));
+
+    assert(ctx->waiting_for_isr_event == true);
+    assert(ctx->event_cookie_counter == 0);
+}
+
 static void test_get_next_isr_event_2(void)
 {
     /*
@@ -775,6 +835,54 @@ static void test_launch_next_event_processing_4(void)
     assert(ctx->event_cookie_counter == 0);
 }
 
+static void test_launch_next_event_processing_priority(void)
+{
+    /*
+     * Test of launch_next_event_processing() with two threads in the queue of
+     * ready threads, the second one having a higher priority than the first
+     * one.
+     *
+     * The specific thread, the one with the highest priority, is removed from
+     * the queue of ready threads and the SIGNAL_EVENT_TO_PROCESS signal is set
+     * for it. The common thread stays in the queue of ready threads. Then, the
+     * execution within the common thread proceeds to wait the
+     * SIGNAL_EVENT_TO_PROCESS or SIGNAL_NO_READY_THREAD where the execution is
+     * stopped.
+     */
+    fwk_list_push_tail(&ctx->thread_ready_queue,
+        &ctx->common_thread_ctx.slist_node);
+    fwk_list_push_tail(&ctx->common_thread_ctx.event_queue,
+        &event[0].slist_node);
+    fwk_list_push_tail(&ctx->thread_ready_queue,
+        &fake_thread_module_ctx.slist_node);
+    fwk_list_push_tail(&fake_thread_module_ctx.event_queue,
+        &event[3].slist_node);
+    fake_thread_module_ctx.priority = 1;
+
+    osThreadFlagsWait_break = 1;
+    osThreadFlagsSet_return_val[0] = 0;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        common_thread_function(NULL);
+
+    assert(process_event_call_count == 0);
+    assert(process_notification_call_count == 0);
+
+    assert(osThreadFlagsWait_param_flags[0] == (SIGNAL_EVENT_TO_PROCESS |
+                                                SIGNAL_NO_READY_THREAD));
+
+    assert(osThreadFlagsSet_call_count == 1);
+    assert(osThreadFlagsSet_param_flags[0] == SIGNAL_EVENT_TO_PROCESS);
+    assert(osThreadFlagsSet_param_thread_id[0] ==
+        (osThreadId_t)MODULE_THREAD_ID);
+
+    assert(ctx->thread_ready_queue.head ==
+           &ctx->common_thread_ctx.slist_node);
+    assert(ctx->thread_ready_queue.tail ==
+           &ctx->common_thread_ctx.slist_node);
+    assert(ctx->common_thread_ctx.event_queue.head == &event[0].slist_node);
+    assert(fake_thread_module_ctx.event_queue.head == &event[3].slist_node);
+}
+
 static void test_thread_function_1(void)
 {
     /*
@@ -1059,8 +1167,8 @@ static void test_thread_function_7(void)
     assert(fwk_list_is_empty(&ctx->common_thread_ctx.event_queue));
     assert(fwk_list_is_empty(&fake_thread_module_ctx.event_queue));
 
-    assert(fake_module_ctx.delayed_response_list.head == &event[0].slist_node);
-    assert(fake_module_ctx.delayed_response_list.tail == &event[0].slist_node);
+    assert(ctx->delayed_response_table[4].head == &event[0].slist_node);
+    assert(ctx->delayed_response_table[4].tail == &event[0].slist_node);
 
     assert(fwk_id_is_equal(event[0].source_id, event[2].target_id));
     assert(fwk_id_is_equal(event[0].target_id, event[2].source_id));
@@ -1505,6 +1613,7 @@ static void test_process_next_thread_event_5(void)
 
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_get_next_isr_event_1),
+    FWK_TEST_CASE(test_get_next_isr_event_append_in_progress),
     FWK_TEST_CASE(test_get_next_isr_event_2),
     FWK_TEST_CASE(test_get_next_isr_event_3),
     FWK_TEST_CASE(test_get_next_isr_event_4),
@@ -1514,6 +1623,7 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_launch_next_event_processing_2),
     FWK_TEST_CASE(test_launch_next_event_processing_3),
     FWK_TEST_CASE(test_launch_next_event_processing_4),
+    FWK_TEST_CASE(test_launch_next_event_processing_priority),
     FWK_TEST_CASE(test_thread_function_1),
     FWK_TEST_CASE(test_thread_function_2),
     FWK_TEST_CASE(test_thread_function_3),
@@ -35,6 +35,7 @@ static struct fwk_element fake_element;
 static struct fwk_element_ctx fake_element_ctx;
 static struct __fwk_thread_ctx fake_thread_module_ctx;
 static struct fwk_module fake_module;
+static struct fwk_module_config fake_module_config;
 static struct fwk_module_ctx fake_module_ctx;
 
 /* Wrapped OS functions */
@@ -47,6 +48,11 @@ osStatus_t __wrap_osKernelInitialize(void)
 {
     return osOK;
 }
+
+osStatus_t __wrap_osThreadYield(void)
+{
+    return osOK;
+}
 /*
  * Indicate the number of function calls before exiting the non-returning
  * functions
@@ -69,12 +75,14 @@ uint32_t __wrap_osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
 
 static osThreadId_t osThreadNew_return_val;
 static const osThreadAttr_t *osThreadNew_param_attr;
+static void *osThreadNew_param_stack_mem;
 osThreadId_t __wrap_osThreadNew(osThreadFunc_t func, void *argument,
                                 const osThreadAttr_t *attr)
 {
     (void) func;
     (void) argument;
     osThreadNew_param_attr = attr;
+    osThreadNew_param_stack_mem = attr->stack_mem;
     return osThreadNew_return_val;
 }
 
@@ -99,6 +107,18 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return fwk_mm_calloc_val;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_aligned(size_t num, size_t size,
+                                   unsigned int alignment)
+{
+    (void) alignment;
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 int __wrap_fwk_interrupt_global_disable(void)
 {
     return 0;
@@ -136,6 +156,11 @@ bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
     return false;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
 {
     (void) id;
@@ -172,8 +197,10 @@ static void test_case_setup(void)
 
     fake_thread_element_ctx.os_thread_id = (osThreadId_t)ELEM_THREAD_ID;
     fake_thread_module_ctx.os_thread_id = (osThreadId_t)MODULE_THREAD_ID;
+    fake_module_config = (struct fwk_module_config){ };
     fake_module_ctx = (struct fwk_module_ctx){ };
     fake_module_ctx.desc = &fake_module;
+    fake_module_ctx.config = &fake_module_config;
     fake_module_ctx.thread_ctx = NULL;
 
     fake_element_ctx = (struct fwk_element_ctx){ };
@@ -307,6 +334,85 @@ static void test_create_module_thread(void)
     assert(fake_module_ctx.thread_ctx == fwk_mm_calloc_val);
 }
 
+static void test_create_thread_priority_invalid(void)
+{
+    int status;
+    fwk_id_t id = FWK_ID_MODULE(0x1);
+
+    fake_module_config.thread_priority = FWK_MODULE_THREAD_PRIORITY_MAX + 1;
+    status = fwk_thread_create(id);
+    assert(status == FWK_E_PARAM);
+    assert(fake_module_ctx.thread_ctx == NULL);
+}
+
+static void test_create_thread_priority_stack_size(void)
+{
+    int status;
+    fwk_id_t id = FWK_ID_MODULE(0x1);
+    struct __fwk_thread_ctx *thread_ctx;
+
+    fake_module_config.thread_priority = FWK_MODULE_THREAD_PRIORITY_MAX;
+    fake_module_config.thread_stack_size = 2045;
+    status = fwk_thread_create(id);
+    assert(status == FWK_SUCCESS);
+    assert(osThreadNew_param_attr->stack_mem != NULL);
+    assert(osThreadNew_param_attr->stack_size == 2048);
+    assert(osThreadNew_param_attr->priority ==
+           (osPriorityNormal + FWK_MODULE_THREAD_PRIORITY_MAX));
+
+    thread_ctx = fake_module_ctx.thread_ctx;
+    assert(thread_ctx == fwk_mm_calloc_val);
+    assert(thread_ctx->priority == FWK_MODULE_THREAD_PRIORITY_MAX);
+}
+
+static void test_get_stack_info(void)
+{
+    int status;
+    struct fwk_thread_stack_info info;
+    uint32_t *stack;
+
+    status = __fwk_thread_init(16);
+    assert(status == FWK_SUCCESS);
+
+    fake_module_config.thread_stack_size = 2048;
+    status = fwk_thread_create(FWK_ID_MODULE(0x1));
+    assert(status == FWK_SUCCESS);
+
+    status = fwk_thread_get_stack_info(0, NULL);
+    assert(status == FWK_E_PARAM);
+
+    /* Common thread */
+    status = fwk_thread_get_stack_info(0, &info);
+    assert(status == FWK_SUCCESS);
+    assert(info.size == (256 * 4));
+    assert(info.max_used == 0);
+
+    /* Module thread */
+    status = fwk_thread_get_stack_info(1, &info);
+    assert(status == FWK_SUCCESS);
+    assert(info.size == 2048);
+    assert(info.max_used == 0);
+    assert((char *)info.guard + FWK_THREAD_STACK_GUARD_SIZE ==
+           osThreadNew_param_stack_mem);
+
+    /* Use the top quarter of the stack of the module thread */
+    stack = osThreadNew_param_stack_mem;
+    stack[(2048 * 3 / 4) / sizeof(uint32_t)] = 0;
+    status = fwk_thread_get_stack_info(1, &info);
+    assert(status == FWK_SUCCESS);
+    assert(info.max_used == (2048 / 4));
+
+    /* The first word of the stack is reserved to the RTOS */
+    stack[(2048 * 3 / 4) / sizeof(uint32_t)] = UINT32_C(0xCCCCCCCC);
+    stack[0] = 0;
+    status = fwk_thread_get_stack_info(1, &info);
+    assert(status == FWK_SUCCESS);
+    assert(info.max_used == 0);
+
+    status = fwk_thread_get_stack_info(2, &info);
+    assert(status == FWK_E_RANGE);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_create_common_thread),
     FWK_TEST_CASE(test_create_id_invalid),
@@ -317,7 +423,10 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_create_thread_memory_allocation_failed),
     FWK_TEST_CASE(test_create_thread_creation_failed),
     FWK_TEST_CASE(test_create_element_thread),
-    FWK_TEST_CASE(test_create_module_thread)
+    FWK_TEST_CASE(test_create_module_thread),
+    FWK_TEST_CASE(test_create_thread_priority_invalid),
+    FWK_TEST_CASE(test_create_thread_priority_stack_size),
+    FWK_TEST_CASE(test_get_stack_info)
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -34,6 +34,11 @@ osStatus_t __wrap_osKernelInitialize(void)
     return osKernelInitailize_return_val;
 }
 
+osStatus_t __wrap_osThreadYield(void)
+{
+    return osOK;
+}
+
 /*
  * Indicate the number of function calls before exiting the non-returning
  * functions
@@ -86,6 +91,18 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return fwk_mm_calloc_val;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_aligned(size_t num, size_t size,
+                                   unsigned int alignment)
+{
+    (void) alignment;
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 int __wrap_fwk_interrupt_global_disable(void)
 {
     return 0;
@@ -121,6 +138,11 @@ bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
     return false;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
 {
     (void) id;
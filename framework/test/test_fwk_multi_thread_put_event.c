@@ -34,6 +34,7 @@
 static jmp_buf test_context;
 struct fwk_event event[4];
 struct fwk_event notification;
+struct fwk_event pending_event;
 struct __fwk_multi_thread_ctx *ctx;
 
 /* Mock module and element */
@@ -42,17 +43,24 @@ static struct fwk_element fake_element;
 static struct fwk_element_ctx fake_element_ctx;
 static struct __fwk_thread_ctx fake_thread_module_ctx;
 static struct fwk_module fake_module;
+static const struct fwk_module_config fake_module_config;
 static struct fwk_module_ctx fake_module_ctx;
 static struct fwk_event fake_module_response_event;
 
 static int fwk_thread_put_event_and_wait_return_val;
 static bool process_event_call_thread_put_event_and_wait;
+static unsigned int process_event_call_count;
+static const struct fwk_event *process_event_param_event;
+static bool process_event_delay_response;
 static int process_event(const struct fwk_event *evt,
                          struct fwk_event *response_event)
 {
-    (void) evt;
-    (void) response_event;
+    process_event_call_count++;
+    process_event_param_event = evt;
+    if (process_event_delay_response)
+        response_event->is_delayed_response = true;
     if (process_event_call_thread_put_event_and_wait) {
+        process_event_call_thread_put_event_and_wait = false;
         fwk_thread_put_event_and_wait_return_val =
             fwk_thread_put_event_and_wait(&event[2], &event[3]);
     }
@@ -70,6 +78,11 @@ osStatus_t __wrap_osKernelInitialize(void)
 {
     return osOK;
 }
+
+osStatus_t __wrap_osThreadYield(void)
+{
+    return osOK;
+}
 /*
  * Indicate the number of function calls before exiting the non-returning
  * functions
@@ -138,6 +151,18 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return fwk_mm_calloc_val;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_aligned(size_t num, size_t size,
+                                   unsigned int alignment)
+{
+    (void) alignment;
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 int __wrap_fwk_interrupt_global_disable(void)
 {
     return 0;
@@ -177,6 +202,11 @@ bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
     return fwk_module_is_valid_notification_id_return_val;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
 {
     (void) id;
@@ -205,6 +235,8 @@ static int test_suite_setup(void)
     if (status != FWK_SUCCESS)
         return status;
 
+    fake_module_ctx.config = &fake_module_config;
+
     fwk_module_is_valid_module_id_return_val = true;
     status = fwk_thread_create(FWK_ID_MODULE(0x1));
     if (status != FWK_SUCCESS)
@@ -217,6 +249,8 @@ static int test_suite_setup(void)
 
 static void test_case_setup(void)
 {
+    unsigned int list_idx;
+
     ctx->waiting_for_isr_event = false;
     ctx->running = false;
     ctx->current_thread_ctx = NULL;
@@ -252,6 +286,11 @@ static void test_case_setup(void)
     event[3].response_requested = false;
     event[3].id = FWK_ID_EVENT(8, 10);
 
+    memset(&pending_event, 0, sizeof(pending_event));
+    pending_event.source_id = FWK_ID_MODULE(0x1);
+    pending_event.target_id = FWK_ID_MODULE(0x6);
+    pending_event.id = FWK_ID_EVENT(6, 9);
+
     memset(&notification, 0, sizeof(notification));
 
     notification.source_id = FWK_ID_MODULE(0x7);
@@ -297,6 +336,9 @@ static void test_case_setup(void)
     fwk_module_is_valid_notification_id_return_val = true;
 
     process_event_call_thread_put_event_and_wait = false;
+    process_event_call_count = 0;
+    process_event_param_event = NULL;
+    process_event_delay_response = false;
     fwk_thread_put_event_and_wait_return_val = FWK_SUCCESS;
 
     fwk_list_init(&ctx->event_free_queue);
@@ -305,8 +347,8 @@ static void test_case_setup(void)
     fwk_list_init(&ctx->common_thread_ctx.event_queue);
     fwk_list_init(&fake_thread_module_ctx.event_queue);
     fwk_list_init(&fake_thread_element_ctx.event_queue);
-    fwk_list_init(&fake_module_ctx.delayed_response_list);
-    fwk_list_init(&fake_element_ctx.delayed_response_list);
+    for (list_idx = 0; list_idx < FWK_DELAYED_RESPONSE_LIST_COUNT; list_idx++)
+        fwk_list_init(&ctx->delayed_response_table[list_idx]);
 }
 
 static void test_put_event_ctx_not_initialized(void)
@@ -538,13 +580,14 @@ static void test_put_event_to_waiting_thread_not_wakeup_event(void)
 {
     int status;
 
-    fwk_list_push_tail(&fake_module_ctx.delayed_response_list,
+    fwk_list_push_tail(&ctx->delayed_response_table[1],
                        &event[1].slist_node);
     fake_thread_module_ctx.waiting_event_processing_completion = true;
     event[0].source_id = FWK_ID_MODULE(0x2);
     event[0].target_id = FWK_ID_MODULE(0x1);
     event[0].is_response = true;
     event[0].cookie = 1;
+    event[1].source_id = FWK_ID_MODULE(0x2);
     event[1].cookie = 1;
     fake_module_response_event.cookie = 2;
     fake_module_ctx.thread_ctx->response_event = &fake_module_response_event;
@@ -564,13 +607,14 @@ static void test_put_event_to_waiting_thread_wakeup_event(void)
 {
     int status;
 
-    fwk_list_push_tail(&fake_module_ctx.delayed_response_list,
+    fwk_list_push_tail(&ctx->delayed_response_table[2],
                        &event[1].slist_node);
     fake_thread_module_ctx.waiting_event_processing_completion = true;
     event[0].source_id = FWK_ID_MODULE(0x2);
     event[0].target_id = FWK_ID_MODULE(0x1);
     event[0].is_response = true;
     event[0].cookie = 2;
+    event[1].source_id = FWK_ID_MODULE(0x2);
     event[1].cookie = 2;
     fake_module_response_event.cookie = 2;
     fake_module_ctx.thread_ctx->response_event = &fake_module_response_event;
@@ -587,6 +631,71 @@ static void test_put_event_to_waiting_thread_wakeup_event(void)
     assert(osThreadFlagsSet_count_call == 0);
 }
 
+static void test_put_events_isr_events(void)
+{
+    int status;
+
+    ctx->event_count = 2;
+    ctx->used_event_count = 0;
+    fwk_list_push_tail(&ctx->event_free_queue, &event[2].slist_node);
+    ctx->waiting_for_isr_event = true;
+
+    status = fwk_thread_put_events(NULL, 2);
+    assert(status == FWK_E_PARAM);
+
+    /* Responses cannot be put in a batch */
+    event[1].is_response = true;
+    status = fwk_thread_put_events(event, 2);
+    assert(status == FWK_E_PARAM);
+    event[1].is_response = false;
+
+    /* Not enough free events, none is queued */
+    ctx->used_event_count = 1;
+    status = fwk_thread_put_events(event, 2);
+    assert(status == FWK_E_NOMEM);
+    assert(ctx->event_free_queue.head == &event[2].slist_node);
+    assert(ctx->used_event_count == 1);
+    ctx->used_event_count = 0;
+
+    /* The common thread is signalled once for the batch */
+    fwk_list_push_tail(&ctx->event_free_queue, &event[3].slist_node);
+    status = fwk_thread_put_events(event, 2);
+    assert(status == FWK_SUCCESS);
+
+    assert(fwk_list_is_empty(&ctx->event_free_queue));
+    assert(ctx->used_event_count == 2);
+    assert(ctx->event_isr_queue.head == &event[2].slist_node);
+    assert(ctx->event_isr_queue.tail == &event[3].slist_node);
+    assert(osThreadFlagsSet_count_call == 1);
+    assert(osThreadFlagsSet_param_flags[0] == SIGNAL_ISR_EVENT);
+    assert(ctx->event_cookie_counter == 0);
+}
+
+static void test_put_events_call_from_a_thread(void)
+{
+    int status;
+
+    ctx->event_count = 2;
+    ctx->used_event_count = 0;
+    fwk_list_push_tail(&ctx->event_free_queue, &event[2].slist_node);
+    fwk_list_push_tail(&ctx->event_free_queue, &event[3].slist_node);
+    fwk_interrupt_get_current_return_val = FWK_E_STATE;
+
+    status = fwk_thread_put_events(event, 2);
+    assert(status == FWK_SUCCESS);
+
+    assert(fake_module_ctx.thread_ctx->event_queue.head ==
+        &event[2].slist_node);
+    assert(fake_module_ctx.thread_ctx->event_queue.tail ==
+        &event[3].slist_node);
+    assert(ctx->thread_ready_queue.head == &fake_thread_module_ctx.slist_node);
+    assert(ctx->thread_ready_queue.tail == &fake_thread_module_ctx.slist_node);
+    assert(event[0].cookie == 0);
+    assert(event[1].cookie == 1);
+    assert(ctx->event_cookie_counter == 2);
+    assert(osThreadFlagsSet_count_call == 0);
+}
+
 static void test_put_event_and_wait_invalid_context(void)
 {
     int status;
@@ -739,6 +848,10 @@ static void test_put_event_and_wait_thread_ready_queue_not_empty(void)
     ctx->current_thread_ctx = &fake_thread_element_ctx;
     fwk_interrupt_get_current_return_val = FWK_E_STATE;
     /* thread_ready_queue is not empty */
+    fwk_list_push_tail(&fake_module_ctx.thread_ctx->event_queue,
+        &pending_event.slist_node);
+    fwk_list_push_tail(&ctx->thread_ready_queue,
+        &fake_module_ctx.thread_ctx->slist_node);
     fwk_list_push_tail(&ctx->event_free_queue, &event[1].slist_node);
     osThreadFlagsWait_break = 0;
     osThreadFlagsWait_return_val[0] = SIGNAL_EVENT_PROCESSED;
@@ -803,6 +916,83 @@ static void test_put_event_and_wait_thread_ready_queue_empty(void)
     assert(ctx->event_cookie_counter == 1);
 }
 
+static void test_put_event_and_wait_target_thread_idle(void)
+{
+    int status;
+
+    ctx->running = true;
+    ctx->event_cookie_counter = 5;
+    ctx->current_thread_ctx = &fake_thread_element_ctx;
+    fwk_interrupt_get_current_return_val = FWK_E_STATE;
+    /* The target thread has no event to process */
+    fwk_list_push_tail(&ctx->event_free_queue, &event[1].slist_node);
+
+    status = fwk_thread_put_event_and_wait(&event[0], &event[2]);
+    assert(status == FWK_SUCCESS);
+
+    /* The event has been processed within the calling thread */
+    assert(process_event_call_count == 1);
+    assert(process_event_param_event == &event[0]);
+    assert(ctx->event_free_queue.head == &event[1].slist_node);
+    assert(fwk_list_is_empty(&fake_module_ctx.thread_ctx->event_queue));
+    assert(fwk_list_is_empty(&ctx->thread_ready_queue));
+    assert(osThreadFlagsSet_count_call == 0);
+    assert(osThreadFlagsWait_count_call == 0);
+
+    assert(fwk_id_is_equal(event[2].source_id, event[0].target_id));
+    assert(fwk_id_is_equal(event[2].target_id, event[0].source_id));
+    assert(fwk_id_is_equal(event[2].id, event[0].id));
+    assert(event[2].cookie == 5);
+    assert(event[2].is_response == true);
+    assert(event[2].response_requested == false);
+    assert(event[2].is_delayed_response == false);
+
+    assert(ctx->current_thread_ctx == &fake_thread_element_ctx);
+    assert(ctx->current_event == NULL);
+    assert(fake_thread_element_ctx.waiting_event_processing_completion ==
+           false);
+    assert(fake_thread_module_ctx.processing_in_calling_thread == false);
+    assert(ctx->event_cookie_counter == 6);
+}
+
+static void test_put_event_and_wait_target_thread_idle_delayed_response(void)
+{
+    int status;
+    struct fwk_slist *delayed_response_list;
+
+    ctx->running = true;
+    ctx->event_cookie_counter = 5;
+    ctx->current_thread_ctx = &fake_thread_element_ctx;
+    fwk_interrupt_get_current_return_val = FWK_E_STATE;
+    /* The target thread has no event to process but delays its response */
+    process_event_delay_response = true;
+    fwk_list_push_tail(&ctx->event_free_queue, &event[1].slist_node);
+    osThreadFlagsWait_return_val[0] = SIGNAL_EVENT_PROCESSED;
+
+    status = fwk_thread_put_event_and_wait(&event[0], &event[2]);
+    assert(status == FWK_SUCCESS);
+
+    assert(process_event_call_count == 1);
+    assert(fwk_list_is_empty(&fake_module_ctx.thread_ctx->event_queue));
+
+    /* The response has been saved, the calling thread waited for it */
+    delayed_response_list =
+        &ctx->delayed_response_table[5 % FWK_DELAYED_RESPONSE_LIST_COUNT];
+    assert(delayed_response_list->head == &event[1].slist_node);
+    assert(fwk_id_is_equal(event[1].source_id, event[0].target_id));
+    assert(event[1].cookie == 5);
+    assert(event[1].is_response == true);
+    assert(event[1].is_delayed_response == true);
+    assert(osThreadFlagsWait_param_flags[0] == SIGNAL_EVENT_PROCESSED);
+    assert(osThreadFlagsWait_param_options[0] == osFlagsWaitAll);
+
+    assert(ctx->current_thread_ctx == &fake_thread_element_ctx);
+    assert(fake_thread_element_ctx.response_event == NULL);
+    assert(fake_thread_element_ctx.waiting_event_processing_completion ==
+           false);
+    assert(ctx->event_cookie_counter == 6);
+}
+
 static void test_put_event_and_wait_called_from_common_thread(void)
 {
     ctx->running = true;
@@ -883,6 +1073,12 @@ static void test_put_event_and_wait_event_with_response(void)
     fwk_list_push_tail(&ctx->thread_ready_queue,
         &fake_element_ctx.thread_ctx->slist_node);
 
+    /* The target thread is busy, the event goes through its queue */
+    fwk_list_push_tail(&fake_module_ctx.thread_ctx->event_queue,
+        &pending_event.slist_node);
+    fwk_list_push_tail(&ctx->thread_ready_queue,
+        &fake_module_ctx.thread_ctx->slist_node);
+
     fwk_list_push_tail(&fake_element_ctx.thread_ctx->event_queue,
         &event[2].slist_node);
     fwk_list_push_tail(&fake_element_ctx.thread_ctx->event_queue,
@@ -893,7 +1089,8 @@ static void test_put_event_and_wait_event_with_response(void)
 
     assert(fwk_thread_put_event_and_wait_return_val == FWK_SUCCESS);
     assert(fake_module_ctx.thread_ctx->event_queue.head ==
-        &event[1].slist_node);
+        &pending_event.slist_node);
+    assert(pending_event.slist_node.next == &event[1].slist_node);
     assert(fwk_id_is_equal(event[1].source_id, FWK_ID_MODULE(0x6)));
     assert(fwk_id_is_equal(event[1].target_id, FWK_ID_MODULE(0x6)));
     assert(event[1].response_requested == true);
@@ -939,6 +1136,12 @@ static void test_put_event_and_wait_event_without_response(void)
     fwk_list_push_tail(&ctx->thread_ready_queue,
         &fake_element_ctx.thread_ctx->slist_node);
 
+    /* The target thread is busy, the event goes through its queue */
+    fwk_list_push_tail(&fake_module_ctx.thread_ctx->event_queue,
+        &pending_event.slist_node);
+    fwk_list_push_tail(&ctx->thread_ready_queue,
+        &fake_module_ctx.thread_ctx->slist_node);
+
     if (setjmp(test_context) == FWK_SUCCESS)
         specific_thread_function(fake_element_ctx.thread_ctx);
 
@@ -947,7 +1150,8 @@ static void test_put_event_and_wait_event_without_response(void)
     assert(ctx->event_free_queue.head == &event[0].slist_node);
 
     assert(fake_module_ctx.thread_ctx->event_queue.head ==
-        &event[1].slist_node);
+        &pending_event.slist_node);
+    assert(pending_event.slist_node.next == &event[1].slist_node);
 
     assert(fwk_id_is_equal(event[1].source_id, FWK_ID_MODULE(0x2)));
     assert(fwk_id_is_equal(event[1].target_id, FWK_ID_MODULE(0x6)));
@@ -985,6 +1189,8 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_put_event_to_waiting_thread_not_delayed_response),
     FWK_TEST_CASE(test_put_event_to_waiting_thread_not_wakeup_event),
     FWK_TEST_CASE(test_put_event_to_waiting_thread_wakeup_event),
+    FWK_TEST_CASE(test_put_events_isr_events),
+    FWK_TEST_CASE(test_put_events_call_from_a_thread),
     FWK_TEST_CASE(test_put_event_and_wait_invalid_context),
     FWK_TEST_CASE(test_put_event_and_wait_invalid_event_id),
     FWK_TEST_CASE(test_put_event_and_wait_incompatible_target_event),
@@ -996,6 +1202,8 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_put_event_and_wait_wait_flags_failed),
     FWK_TEST_CASE(test_put_event_and_wait_thread_ready_queue_not_empty),
     FWK_TEST_CASE(test_put_event_and_wait_thread_ready_queue_empty),
+    FWK_TEST_CASE(test_put_event_and_wait_target_thread_idle),
+    FWK_TEST_CASE(test_put_event_and_wait_target_thread_idle_delayed_response),
     FWK_TEST_CASE(test_put_event_and_wait_called_from_common_thread),
     FWK_TEST_CASE(test_put_event_and_wait_called_from_current_thread),
     FWK_TEST_CASE(test_put_event_and_wait_event_with_response),
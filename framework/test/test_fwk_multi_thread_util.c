@@ -16,6 +16,7 @@
 #include <fwk_list.h>
 #include <fwk_macros.h>
 #include <fwk_test.h>
+#include <fwk_thread.h>
 #include <internal/fwk_id.h>
 #include <internal/fwk_module.h>
 #include <internal/fwk_multi_thread.h>
@@ -36,6 +37,7 @@ static struct fwk_element fake_element;
 static struct fwk_element_ctx fake_element_ctx;
 static struct __fwk_thread_ctx fake_thread_module_ctx;
 static struct fwk_module fake_module;
+static const struct fwk_module_config fake_module_config;
 static struct fwk_module_ctx fake_module_ctx;
 
 static int process_event(const struct fwk_event *evt,
@@ -58,6 +60,13 @@ osStatus_t __wrap_osKernelInitialize(void)
     return osOK;
 }
 
+static unsigned int osThreadYield_count_call;
+osStatus_t __wrap_osThreadYield(void)
+{
+    osThreadYield_count_call++;
+    return osOK;
+}
+
 /*
  * Indicate the number of function calls before exiting the non-returning
  * functions
@@ -95,6 +104,18 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return fwk_mm_calloc_val;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_aligned(size_t num, size_t size,
+                                   unsigned int alignment)
+{
+    (void) alignment;
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 int __wrap_fwk_interrupt_global_disable(void)
 {
     return 0;
@@ -132,6 +153,11 @@ bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
     return true;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
 {
     (void) id;
@@ -163,6 +189,8 @@ static int test_suite_setup(void)
     if (status != FWK_SUCCESS)
         return status;
 
+    fake_module_ctx.config = &fake_module_config;
+
     fwk_module_is_valid_module_id_return_val = true;
     status = fwk_thread_create(FWK_ID_MODULE(0x1));
     if (status != FWK_SUCCESS)
@@ -363,6 +391,54 @@ static void test_thread_get_ctx_invalid_module_from_element_id(void)
     assert(status == FWK_E_PARAM);
 }
 
+static void test_get_delayed_response(void)
+{
+    int status;
+    struct fwk_event delayed_response;
+
+    fwk_interrupt_get_current_return_val = FWK_E_STATE;
+
+    /*
+     * Two delayed responses with different cookies are linked to different
+     * lists, the lists a given cookie is searched for in.
+     */
+    event[2].cookie = FWK_DELAYED_RESPONSE_LIST_COUNT + 1;
+    event[3].cookie = 1;
+    fwk_list_push_tail(&ctx->delayed_response_table[1], &event[2].slist_node);
+    fwk_list_push_tail(&ctx->delayed_response_table[1], &event[3].slist_node);
+
+    status = fwk_thread_get_delayed_response(FWK_ID_MODULE(0x7), 1,
+                                             &delayed_response);
+    assert(status == FWK_SUCCESS);
+    assert(fwk_id_is_equal(delayed_response.source_id, FWK_ID_MODULE(0x7)));
+    assert(delayed_response.cookie == 1);
+
+    status = fwk_thread_get_delayed_response(FWK_ID_MODULE(0x5),
+        FWK_DELAYED_RESPONSE_LIST_COUNT + 1, &delayed_response);
+    assert(status == FWK_SUCCESS);
+    assert(fwk_id_is_equal(delayed_response.source_id, FWK_ID_MODULE(0x5)));
+
+    /* The cookie of a response delayed by another entity */
+    status = fwk_thread_get_delayed_response(FWK_ID_MODULE(0x5), 1,
+                                             &delayed_response);
+    assert(status == FWK_E_PARAM);
+
+    status = fwk_thread_get_delayed_response(FWK_ID_MODULE(0x7), 2,
+                                             &delayed_response);
+    assert(status == FWK_E_PARAM);
+
+    fwk_list_init(&ctx->delayed_response_table[1]);
+}
+
+static void test_wait_for_interrupt(void)
+{
+    osThreadYield_count_call = 0;
+
+    /* The calling thread yields to the other threads */
+    fwk_thread_wait_for_interrupt();
+    assert(osThreadYield_count_call == 1);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_put_event_thread_ctx_in_thread_ready_queue),
     FWK_TEST_CASE(test_put_event_not_empty_target_list),
@@ -372,7 +448,9 @@ static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test_thread_get_ctx_module_context),
     FWK_TEST_CASE(test_thread_get_ctx_element_context),
     FWK_TEST_CASE(test_thread_get_ctx_module_from_element_id),
-    FWK_TEST_CASE(test_thread_get_ctx_invalid_module_from_element_id)
+    FWK_TEST_CASE(test_thread_get_ctx_invalid_module_from_element_id),
+    FWK_TEST_CASE(test_get_delayed_response),
+    FWK_TEST_CASE(test_wait_for_interrupt)
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -16,9 +16,13 @@
 #include <fwk_slist.h>
 #include <fwk_test.h>
 #include <internal/fwk_module.h>
+#include <internal/fwk_notification.h>
 #include <internal/fwk_single_thread.h>
 #include <internal/fwk_thread.h>
 
+struct fwk_notification_static_subscription
+    module_static_subscription_table[3];
+
 /* Mock functions */
 static void * fwk_mm_calloc_val;
 static size_t fwk_mm_calloc_num;
@@ -94,6 +98,46 @@ int __wrap___fwk_thread_put_notification(struct fwk_event *event)
     return FWK_SUCCESS;
 }
 
+static struct fwk_event multicast_event;
+static bool begin_multicast_return_val;
+struct fwk_event *__wrap___fwk_thread_begin_multicast_notification(
+    const struct fwk_event *event)
+{
+    if (!begin_multicast_return_val)
+        return NULL;
+
+    multicast_event = *event;
+
+    return &multicast_event;
+}
+
+static unsigned int multicast_target_max;
+static unsigned int multicast_target_count;
+int __wrap___fwk_thread_add_notification_target(struct fwk_event *multicast,
+                                                fwk_id_t target_id)
+{
+    assert(multicast == &multicast_event);
+
+    if (multicast_target_count >= multicast_target_max)
+        return FWK_E_NOMEM;
+
+    multicast_target_count++;
+    multicast->target_id = target_id;
+
+    return __wrap___fwk_thread_put_notification(multicast);
+}
+
+static unsigned int put_multicast_target_count;
+static unsigned int put_multicast_count;
+void __wrap___fwk_thread_put_multicast_notification(struct fwk_event *multicast,
+                                                    unsigned int target_count)
+{
+    assert(multicast == &multicast_event);
+
+    put_multicast_target_count = target_count;
+    put_multicast_count++;
+}
+
 static struct fwk_event *get_current_event_return_val;
 const struct fwk_event *__wrap___fwk_thread_get_current_event(void)
 {
@@ -110,12 +154,20 @@ static void test_case_setup(void)
     fwk_mm_calloc_return_val = true;
     get_current_event_return_val = NULL;
     notification_event_count = 0;
+    begin_multicast_return_val = false;
+    multicast_target_max = 0;
+    multicast_target_count = 0;
+    put_multicast_target_count = 0;
+    put_multicast_count = 0;
 
     for (i = 0; i < FWK_ARRAY_SIZE(fake_module_dlist_table); i++)
         fwk_list_init(&fake_module_dlist_table[i]);
 
     for (i = 0; i < FWK_ARRAY_SIZE(fake_element_dlist_table); i++)
         fwk_list_init(&fake_element_dlist_table[i]);
+
+    for (i = 0; i < FWK_ARRAY_SIZE(module_static_subscription_table); i++)
+        module_static_subscription_table[i].notification_id = FWK_ID_NONE;
 }
 
 static void test_case_teardown(void)
@@ -444,11 +496,244 @@ static void test_fwk_notification_notify(void)
     notification_event_count = 0;
 }
 
+static void test_fwk_notification_notify_sub_element(void)
+{
+    int result;
+    struct fwk_event notification_event = {
+        .source_id = FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x0),
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+    };
+    unsigned int count;
+
+    result = __fwk_notification_init(3);
+    assert(result == FWK_SUCCESS);
+
+    /* The sub-elements of an element share the subscription lists */
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x0),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x1),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x1),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_E_STATE);
+
+    /* Only the subscribers to the sub-element are notified */
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 1);
+    assert(notification_event_count == 1);
+    assert(fwk_id_is_equal(notification_event_table[0].source_id,
+                           FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x0)));
+    assert(fwk_id_is_equal(notification_event_table[0].target_id,
+                           FWK_ID_MODULE(0x4)));
+
+    result = fwk_notification_unsubscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                          FWK_ID_SUB_ELEMENT(0x2, 0x9, 0x0),
+                                          FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    notification_event_count = 0;
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 0);
+    assert(notification_event_count == 0);
+}
+
+static void test_fwk_notification_notify_multicast(void)
+{
+    int result;
+    struct fwk_event notification_event = {
+        .source_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_NOTIFICATION(0x2, 0x1),
+    };
+    unsigned int count;
+
+    result = __fwk_notification_init(3);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_MODULE(0x2),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_MODULE(0x2),
+                                        FWK_ID_ELEMENT(0x6, 0x1));
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_MODULE(0x2),
+                                        FWK_ID_MODULE(0x5));
+    assert(result == FWK_SUCCESS);
+
+    /* All the subscribers share a single event */
+    begin_multicast_return_val = true;
+    multicast_target_max = 3;
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 3);
+    assert(multicast_target_count == 3);
+    assert(put_multicast_count == 1);
+    assert(put_multicast_target_count == 3);
+    assert(notification_event_count == 3);
+    assert(fwk_id_is_equal(notification_event_table[0].target_id,
+                           FWK_ID_MODULE(0x4)));
+    assert(fwk_id_is_equal(notification_event_table[1].target_id,
+                           FWK_ID_ELEMENT(0x6, 0x1)));
+    assert(fwk_id_is_equal(notification_event_table[2].target_id,
+                           FWK_ID_MODULE(0x5)));
+
+    /* The targets that cannot be recorded are sent a copy of the event */
+    notification_event_count = 0;
+    multicast_target_count = 0;
+    put_multicast_count = 0;
+    multicast_target_max = 1;
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 3);
+    assert(multicast_target_count == 1);
+    assert(put_multicast_count == 1);
+    assert(put_multicast_target_count == 1);
+    assert(notification_event_count == 3);
+    assert(fwk_id_is_equal(notification_event_table[1].target_id,
+                           FWK_ID_ELEMENT(0x6, 0x1)));
+    assert(fwk_id_is_equal(notification_event_table[2].target_id,
+                           FWK_ID_MODULE(0x5)));
+}
+
+static void test_fwk_notification_static_subscription(void)
+{
+    int result;
+    struct fwk_event notification_event = { 0 };
+    unsigned int count;
+
+    module_static_subscription_table[0] =
+        (struct fwk_notification_static_subscription) {
+            .notification_id = FWK_ID_NOTIFICATION(0x2, 0x1),
+            .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+            .target_id = FWK_ID_MODULE(0x4),
+        };
+    module_static_subscription_table[1] =
+        (struct fwk_notification_static_subscription) {
+            .notification_id = FWK_ID_NOTIFICATION(0x2, 0x1),
+            .source_id = FWK_ID_ELEMENT(0x2, 0x8),
+            .target_id = FWK_ID_MODULE(0x5),
+        };
+
+    /* No subscription structure when all the subscriptions are static */
+    fwk_mm_calloc_num = 0;
+    result = __fwk_notification_init(0);
+    assert(result == FWK_SUCCESS);
+    assert(fwk_mm_calloc_num == 0);
+
+    /* Subscribing to a static subscription succeeds without allocation */
+    result = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                        FWK_ID_ELEMENT(0x2, 0x9),
+                                        FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+    assert(fwk_list_is_empty(&fake_element_dlist_table[1]));
+
+    /* Static subscriptions cannot be removed */
+    result = fwk_notification_unsubscribe(FWK_ID_NOTIFICATION(0x2, 0x1),
+                                          FWK_ID_ELEMENT(0x2, 0x9),
+                                          FWK_ID_MODULE(0x4));
+    assert(result == FWK_E_ACCESS);
+
+    /* Only the static subscriptions of the source are notified */
+    notification_event.source_id = FWK_ID_ELEMENT(0x2, 0x9);
+    notification_event.id = FWK_ID_NOTIFICATION(0x2, 0x1);
+    result = fwk_notification_notify(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 1);
+    assert(notification_event_count == 1);
+    assert(fwk_id_is_equal(notification_event_table[0].target_id,
+                           FWK_ID_MODULE(0x4)));
+}
+
+static void test_fwk_notification_notify_collect(void)
+{
+    int result;
+    unsigned int i, count;
+    struct fwk_event notification_event = { 0 };
+    struct fwk_event response_event = { 0 };
+    struct fwk_notification_resp_params *params =
+        (struct fwk_notification_resp_params *)response_event.params;
+
+    for (i = 0; i < 2; i++) {
+        module_static_subscription_table[i] =
+            (struct fwk_notification_static_subscription) {
+                .notification_id = FWK_ID_NOTIFICATION(0x2, 0x1),
+                .source_id = FWK_ID_ELEMENT(0x2, 0x9),
+                .target_id = FWK_ID_MODULE(0x4 + i),
+            };
+    }
+
+    result = __fwk_notification_init(0);
+    assert(result == FWK_SUCCESS);
+
+    notification_event.source_id = FWK_ID_ELEMENT(0x2, 0x9);
+    notification_event.id = FWK_ID_NOTIFICATION(0x2, 0x1);
+
+    /* Not allowed from an interrupt handler */
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    result = fwk_notification_notify_collect(&notification_event, &count);
+    assert(result == FWK_E_HANDLER);
+    interrupt_get_current_return_val = FWK_E_STATE;
+
+    result = fwk_notification_notify_collect(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 2);
+    assert(notification_event_count == 2);
+    assert(notification_event_table[0].response_requested);
+    assert(notification_event_table[1].response_requested);
+
+    /* The responses are already being collected */
+    result = fwk_notification_notify_collect(&notification_event, &count);
+    assert(result == FWK_E_STATE);
+
+    response_event.id = FWK_ID_NOTIFICATION(0x2, 0x1);
+    response_event.source_id = FWK_ID_MODULE(0x4);
+    response_event.target_id = FWK_ID_ELEMENT(0x2, 0x9);
+    response_event.is_response = true;
+    response_event.is_notification = true;
+
+    /* The first response is dropped */
+    params->status = FWK_E_DEVICE;
+    assert(!__fwk_notification_collect_response(&response_event));
+
+    /* The last response is delivered with the status of the failure */
+    response_event.source_id = FWK_ID_MODULE(0x5);
+    params->status = FWK_SUCCESS;
+    assert(__fwk_notification_collect_response(&response_event));
+    assert(params->status == FWK_E_DEVICE);
+
+    /* Responses to other notifications are delivered as is */
+    params->status = FWK_E_BUSY;
+    assert(__fwk_notification_collect_response(&response_event));
+    assert(params->status == FWK_E_BUSY);
+
+    /* The collection is complete, the notification can be sent again */
+    result = fwk_notification_notify_collect(&notification_event, &count);
+    assert(result == FWK_SUCCESS);
+    assert(count == 2);
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test___fwk_notification_init),
     FWK_TEST_CASE(test_fwk_notification_subscribe),
     FWK_TEST_CASE(test_fwk_notification_unsubscribe),
-    FWK_TEST_CASE(test_fwk_notification_notify)
+    FWK_TEST_CASE(test_fwk_notification_notify),
+    FWK_TEST_CASE(test_fwk_notification_notify_sub_element),
+    FWK_TEST_CASE(test_fwk_notification_notify_multicast),
+    FWK_TEST_CASE(test_fwk_notification_static_subscription),
+    FWK_TEST_CASE(test_fwk_notification_notify_collect),
 };
 
 struct fwk_test_suite_desc test_suite = {
@@ -21,6 +21,8 @@
 
 static jmp_buf test_context;
 static struct __fwk_thread_ctx *ctx;
+static struct fwk_slist *normal_event_queue;
+static struct fwk_slist *high_event_queue;
 
 /* Mock functions */
 static void * fwk_mm_calloc_val;
@@ -34,6 +36,11 @@ void *__wrap_fwk_mm_calloc(size_t num, size_t size)
     return NULL;
 }
 
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
 static struct fwk_module fake_module_desc;
 static struct fwk_module_ctx fake_module_ctx;
 struct fwk_module_ctx *__wrap___fwk_module_get_ctx(fwk_id_t id)
@@ -88,6 +95,11 @@ int __wrap_fwk_interrupt_get_current(unsigned int *interrupt)
     return interrupt_get_current_return_val;
 }
 
+bool __wrap___fwk_notification_collect_response(struct fwk_event *response)
+{
+    return true;
+}
+
 static const struct fwk_event *processed_event;
 static int process_event(const struct fwk_event *event,
                          struct fwk_event *response_event)
@@ -97,17 +109,26 @@ static int process_event(const struct fwk_event *event,
 }
 
 static const struct fwk_event *processed_notification;
+static fwk_id_t notification_target_table[4];
+static unsigned int notification_target_count;
 
 static int process_notification(const struct fwk_event *event,
                                 struct fwk_event *response_event)
 {
     processed_notification = event;
+    if (notification_target_count <
+        FWK_ARRAY_SIZE(notification_target_table)) {
+        notification_target_table[notification_target_count++] =
+            event->target_id;
+    }
     return FWK_SUCCESS;
 }
 
 static int test_suite_setup(void)
 {
     ctx = __fwk_thread_get_ctx();
+    normal_event_queue = &ctx->event_queue[FWK_EVENT_PRIORITY_NORMAL];
+    high_event_queue = &ctx->event_queue[FWK_EVENT_PRIORITY_HIGH];
     fake_module_desc.process_event = process_event;
     fake_module_desc.process_notification = process_notification;
     fake_module_ctx.desc = &fake_module_desc;
@@ -124,14 +145,20 @@ static void test_case_setup(void)
     fwk_mm_calloc_return_val = true;
     fake_module_desc.process_event = process_event;
     fake_module_ctx.desc = &fake_module_desc;
+    notification_target_count = 0;
 }
 
 static void test_case_teardown(void)
 {
+    unsigned int priority;
+
     *ctx = (struct __fwk_thread_ctx){ };
     fwk_list_init(&ctx->free_event_queue);
-    fwk_list_init(&ctx->event_queue);
+    fwk_list_init(&ctx->free_target_queue);
+    fwk_list_init(&ctx->multicast_target_queue);
     fwk_list_init(&ctx->isr_event_queue);
+    for (priority = 0; priority < FWK_EVENT_PRIORITY_COUNT; priority++)
+        fwk_list_init(&ctx->event_queue[priority]);
 }
 
 static void test___fwk_thread_init(void)
@@ -201,8 +228,8 @@ static void test___fwk_thread_run(void)
     allocated_event = FWK_LIST_GET(fwk_list_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
 
-    __real___fwk_slist_push_tail(&ctx->event_queue, &(event1.slist_node));
-    __real___fwk_slist_push_tail(&ctx->event_queue, &(event2.slist_node));
+    __real___fwk_slist_push_tail(normal_event_queue, &(event1.slist_node));
+    __real___fwk_slist_push_tail(normal_event_queue, &(event2.slist_node));
     __real___fwk_slist_push_tail(&ctx->isr_event_queue, &(event3.slist_node));
     __real___fwk_slist_push_tail(&ctx->isr_event_queue,
                                  &(notification1.slist_node));
@@ -212,8 +239,8 @@ static void test___fwk_thread_run(void)
         __fwk_thread_run();
     assert(ctx->isr_event_queue.head == &(event3.slist_node));
     assert(ctx->isr_event_queue.tail == &(notification1.slist_node));
-    assert(ctx->event_queue.head == &(event2.slist_node));
-    assert(ctx->event_queue.tail == &(allocated_event->slist_node));
+    assert(normal_event_queue->head == &(event2.slist_node));
+    assert(normal_event_queue->tail == &(allocated_event->slist_node));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -229,8 +256,8 @@ static void test___fwk_thread_run(void)
         __fwk_thread_run();
     assert(ctx->isr_event_queue.head == &(event3.slist_node));
     assert(ctx->isr_event_queue.tail == &(notification1.slist_node));
-    assert(ctx->event_queue.head == &(allocated_event->slist_node));
-    assert(ctx->event_queue.tail == &(allocated_event->slist_node));
+    assert(normal_event_queue->head == &(allocated_event->slist_node));
+    assert(normal_event_queue->tail == &(allocated_event->slist_node));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -246,7 +273,7 @@ static void test___fwk_thread_run(void)
         __fwk_thread_run();
     assert(ctx->isr_event_queue.head == &(event3.slist_node));
     assert(ctx->isr_event_queue.tail == &(notification1.slist_node));
-    assert(fwk_list_is_empty(&ctx->event_queue));
+    assert(fwk_list_is_empty(normal_event_queue));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -259,12 +286,12 @@ static void test___fwk_thread_run(void)
     assert(fwk_id_is_equal(processed_event->target_id, FWK_ID_MODULE(0x1)));
     assert(fwk_id_is_equal(processed_event->id, FWK_ID_EVENT(0x2, 0x7)));
 
-    /* Extract ISR Event3 and process it */
+    /* Extract all the ISR events and process Event3 */
     if (setjmp(test_context) == FWK_SUCCESS)
         __fwk_thread_run();
-    assert(ctx->isr_event_queue.head == &(notification1.slist_node));
-    assert(ctx->isr_event_queue.tail == &(notification1.slist_node));
-    assert(fwk_list_is_empty(&ctx->event_queue));
+    assert(fwk_list_is_empty(&ctx->isr_event_queue));
+    assert(normal_event_queue->head == &(notification1.slist_node));
+    assert(normal_event_queue->tail == &(notification1.slist_node));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -274,15 +301,15 @@ static void test___fwk_thread_run(void)
     assert(processed_event->response_requested == false);
     assert(processed_event->is_notification == false);
 
-    /* Extract ISR Notification1 and process it */
+    /* Process Notification1 */
     free_event_queue_break = false;
     fwk_list_push_tail(&ctx->free_event_queue, &(allocated_event->slist_node));
     free_event_queue_break = true;
     if (setjmp(test_context) == FWK_SUCCESS)
         __fwk_thread_run();
     assert(fwk_list_is_empty(&ctx->isr_event_queue));
-    assert(ctx->event_queue.head == &(allocated_event->slist_node));
-    assert(ctx->event_queue.tail == &(allocated_event->slist_node));
+    assert(normal_event_queue->head == &(allocated_event->slist_node));
+    assert(normal_event_queue->tail == &(allocated_event->slist_node));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -296,7 +323,7 @@ static void test___fwk_thread_run(void)
     if (setjmp(test_context) == FWK_SUCCESS)
         __fwk_thread_run();
     assert(fwk_list_is_empty(&ctx->isr_event_queue));
-    assert(fwk_list_is_empty(&ctx->event_queue));
+    assert(fwk_list_is_empty(normal_event_queue));
 
     free_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->free_event_queue),
         struct fwk_event, slist_node);
@@ -313,6 +340,131 @@ static void test___fwk_thread_run(void)
                            FWK_ID_NOTIFICATION(0x5, 0x9)));
 }
 
+static void test___fwk_thread_run_priority(void)
+{
+    int result;
+    struct fwk_event *free_event;
+
+    struct fwk_event event1 = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 0x7),
+    };
+
+    struct fwk_event event2 = {
+        .source_id = FWK_ID_MODULE(0x3),
+        .target_id = FWK_ID_MODULE(0x4),
+        .id = FWK_ID_EVENT(0x4, 0x8),
+        .priority = FWK_EVENT_PRIORITY_HIGH,
+    };
+
+    struct fwk_event event3 = {
+        .source_id = FWK_ID_MODULE(0x5),
+        .target_id = FWK_ID_MODULE(0x6),
+        .id = FWK_ID_EVENT(0x6, 0x9),
+        .priority = FWK_EVENT_PRIORITY_HIGH,
+    };
+
+    struct fwk_event event4 = {
+        .source_id = FWK_ID_MODULE(0x5),
+        .target_id = FWK_ID_MODULE(0x6),
+        .id = FWK_ID_EVENT(0x6, 0xA),
+        .priority = FWK_EVENT_PRIORITY_HIGH,
+    };
+
+    result = __fwk_thread_init(1);
+    assert(result == FWK_SUCCESS);
+    free_event_queue_break = true;
+
+    __real___fwk_slist_push_tail(normal_event_queue, &(event1.slist_node));
+    __real___fwk_slist_push_tail(high_event_queue, &(event2.slist_node));
+    __real___fwk_slist_push_tail(high_event_queue, &(event3.slist_node));
+
+    /* High priority events are processed first, in FIFO order */
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event == &event2);
+    assert(high_event_queue->head == &(event3.slist_node));
+    assert(normal_event_queue->head == &(event1.slist_node));
+
+    /* A high priority ISR event is dispatched ahead of normal events */
+    __real___fwk_slist_push_tail(&ctx->isr_event_queue, &(event4.slist_node));
+    ctx->isr_priority_event_pending = true;
+
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event == &event3);
+    assert(!ctx->isr_priority_event_pending);
+    assert(fwk_list_is_empty(&ctx->isr_event_queue));
+    assert(high_event_queue->head == &(event4.slist_node));
+
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event == &event4);
+    assert(fwk_list_is_empty(high_event_queue));
+
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(processed_event == &event1);
+    assert(fwk_list_is_empty(normal_event_queue));
+
+    free_event = FWK_LIST_GET(ctx->free_event_queue.tail, struct fwk_event,
+        slist_node);
+    assert(free_event == &event1);
+}
+
+static unsigned int idle_count;
+static struct fwk_event idle_isr_event = {
+    .source_id = FWK_ID_MODULE(0x1),
+    .target_id = FWK_ID_MODULE(0x2),
+    .id = FWK_ID_EVENT(0x2, 0x3),
+};
+
+static void idle(void)
+{
+    /* Simulate an ISR raising an event on the second wait */
+    if (++idle_count == 2) {
+        __real___fwk_slist_push_tail(&ctx->isr_event_queue,
+                                     &(idle_isr_event.slist_node));
+    }
+}
+
+static void test___fwk_thread_run_idle(void)
+{
+    int result;
+
+    result = __fwk_thread_init(1);
+    assert(result == FWK_SUCCESS);
+    free_event_queue_break = true;
+
+    __fwk_thread_set_idle_handler(idle);
+    assert(ctx->idle == idle);
+
+    idle_count = 0;
+    idle_isr_event.slist_node = (struct fwk_slist_node) { 0 };
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+    assert(idle_count == 2);
+    assert(processed_event == &idle_isr_event);
+    assert(fwk_list_is_empty(&ctx->isr_event_queue));
+}
+
+static void test_fwk_thread_wait_for_interrupt(void)
+{
+    idle_count = 0;
+
+    /* Without idle handler, the function returns immediately */
+    __fwk_thread_set_idle_handler(NULL);
+    fwk_thread_wait_for_interrupt();
+    assert(idle_count == 0);
+
+    __fwk_thread_set_idle_handler(idle);
+    fwk_thread_wait_for_interrupt();
+    assert(idle_count == 1);
+
+    __fwk_thread_set_idle_handler(NULL);
+}
+
 static void test_fwk_thread_put_event(void)
 {
     int result;
@@ -359,7 +511,7 @@ static void test_fwk_thread_put_event(void)
 
     result = fwk_thread_put_event(&event1);
     assert(result == FWK_SUCCESS);
-    result_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->event_queue),
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
         struct fwk_event, slist_node);
     assert(fwk_id_is_equal(result_event->source_id, event1.source_id));
     assert(fwk_id_is_equal(result_event->target_id, event1.target_id));
@@ -372,6 +524,7 @@ static void test_fwk_thread_put_event(void)
     result = fwk_thread_put_event(&event2);
     assert(result == FWK_SUCCESS);
     assert(fwk_list_is_empty(&ctx->free_event_queue));
+    assert(!ctx->isr_priority_event_pending);
     result_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->isr_event_queue),
         struct fwk_event, slist_node);
     assert(fwk_id_is_equal(result_event->source_id, event2.source_id));
@@ -381,6 +534,244 @@ static void test_fwk_thread_put_event(void)
     assert(result_event->is_notification == false);
 }
 
+static void test_fwk_thread_put_events(void)
+{
+    int result;
+    struct fwk_event *result_event;
+    struct fwk_event events[2] = {
+        {
+            .source_id = FWK_ID_MODULE(0x1),
+            .target_id = FWK_ID_MODULE(0x2),
+            .id = FWK_ID_EVENT(0x2, 7),
+        },
+        {
+            .source_id = FWK_ID_MODULE(0x1),
+            .target_id = FWK_ID_MODULE(0x3),
+            .id = FWK_ID_EVENT(0x3, 7),
+        },
+    };
+
+    /* Thread not initialized */
+    result = fwk_thread_put_events(events, 2);
+    assert(result == FWK_E_INIT);
+
+    result = __fwk_thread_init(2);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_put_events(NULL, 2);
+    assert(result == FWK_E_PARAM);
+
+    /* Invalid event, none is queued */
+    events[1].id = FWK_ID_EVENT(0x2, 7);
+    result = fwk_thread_put_events(events, 2);
+    assert(result == FWK_E_PARAM);
+    assert(ctx->used_event_count == 0);
+    events[1].id = FWK_ID_EVENT(0x3, 7);
+
+    /* Not enough free events, none is queued */
+    result = fwk_thread_reserve_event(&result_event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_put_events(events, 2);
+    assert(result == FWK_E_NOMEM);
+    assert(ctx->used_event_count == 1);
+    result = fwk_thread_cancel_event(result_event);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_put_events(events, 2);
+    assert(result == FWK_SUCCESS);
+    assert(fwk_list_is_empty(&ctx->free_event_queue));
+    assert(ctx->used_event_count == 2);
+
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
+        struct fwk_event, slist_node);
+    assert(fwk_id_is_equal(result_event->target_id, events[0].target_id));
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
+        struct fwk_event, slist_node);
+    assert(fwk_id_is_equal(result_event->target_id, events[1].target_id));
+}
+
+static void test_fwk_thread_put_event_supersedes(void)
+{
+    int result;
+    struct fwk_event *result_event;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 7),
+        .supersedes = true,
+        .response_requested = true,
+    };
+
+    result = __fwk_thread_init(4);
+    assert(result == FWK_SUCCESS);
+
+    /* Superseding events cannot require a response */
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_E_PARAM);
+    event.response_requested = false;
+
+    event.params[0] = 1;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+
+    /* Different identifier, not superseded */
+    event.id = FWK_ID_EVENT(0x2, 6);
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+
+    /* The first event is dropped */
+    event.id = FWK_ID_EVENT(0x2, 7);
+    event.params[0] = 2;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(ctx->used_event_count == 2);
+
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
+        struct fwk_event, slist_node);
+    assert(fwk_id_is_equal(result_event->id, FWK_ID_EVENT(0x2, 6)));
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
+        struct fwk_event, slist_node);
+    assert(fwk_id_is_equal(result_event->id, FWK_ID_EVENT(0x2, 7)));
+    assert(result_event->params[0] == 2);
+    assert(fwk_list_is_empty(normal_event_queue));
+
+    /* Events without the flag are not superseded */
+    event.supersedes = false;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    event.supersedes = true;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(ctx->used_event_count == 4);
+    assert(fwk_list_is_empty(&ctx->free_event_queue));
+}
+
+static void test_fwk_thread_put_event_priority(void)
+{
+    int result;
+    struct fwk_event *result_event;
+
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(0x1),
+        .target_id = FWK_ID_MODULE(0x2),
+        .id = FWK_ID_EVENT(0x2, 7),
+        .priority = FWK_EVENT_PRIORITY_COUNT,
+    };
+
+    result = __fwk_thread_init(2);
+    assert(result == FWK_SUCCESS);
+
+    /* Invalid priority class */
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_E_PARAM);
+
+    event.priority = FWK_EVENT_PRIORITY_HIGH;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(fwk_list_is_empty(normal_event_queue));
+    result_event = FWK_LIST_GET(fwk_list_pop_head(high_event_queue),
+        struct fwk_event, slist_node);
+    assert(result_event->priority == FWK_EVENT_PRIORITY_HIGH);
+
+    interrupt_get_current_return_val = FWK_SUCCESS;
+    result = fwk_thread_put_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(ctx->isr_priority_event_pending);
+    result_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->isr_event_queue),
+        struct fwk_event, slist_node);
+    assert(result_event->priority == FWK_EVENT_PRIORITY_HIGH);
+}
+
+static void test_fwk_thread_reserve_commit_event(void)
+{
+    int result;
+    struct fwk_event *event, *other_event;
+
+    /* Thread not initialized */
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_E_INIT);
+
+    result = __fwk_thread_init(2);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_reserve_event(NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_reserve_event(&other_event);
+    assert(result == FWK_SUCCESS);
+    assert(event != other_event);
+    assert(fwk_list_is_empty(&ctx->free_event_queue));
+
+    /* No free event left */
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_E_NOMEM);
+
+    /* Cancelled event goes back to the free queue */
+    result = fwk_thread_cancel_event(other_event);
+    assert(result == FWK_SUCCESS);
+    assert(ctx->free_event_queue.head == &other_event->slist_node);
+
+    /* Invalid event is released */
+    is_valid_event_id_return_val = false;
+    result = fwk_thread_commit_event(event);
+    assert(result == FWK_E_PARAM);
+    assert(ctx->free_event_queue.tail == &event->slist_node);
+    is_valid_event_id_return_val = true;
+
+    /* Event filled in place is queued without copy */
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_SUCCESS);
+    assert(event == other_event);
+    event->source_id = FWK_ID_MODULE(0x1);
+    event->target_id = FWK_ID_MODULE(0x2);
+    event->id = FWK_ID_EVENT(0x2, 7);
+    event->response_requested = true;
+
+    result = fwk_thread_commit_event(event);
+    assert(result == FWK_SUCCESS);
+    assert(normal_event_queue->head == &event->slist_node);
+    assert(normal_event_queue->tail == &event->slist_node);
+}
+
+static void test_fwk_thread_get_event_pool_stats(void)
+{
+    int result;
+    struct fwk_event *event;
+    struct fwk_thread_event_pool_stats stats;
+
+    /* Thread not initialized */
+    result = fwk_thread_get_event_pool_stats(&stats);
+    assert(result == FWK_E_INIT);
+
+    result = __fwk_thread_init(3);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_event_pool_stats(NULL);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_get_event_pool_stats(&stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.size == 3);
+    assert(stats.used == 0);
+    assert(stats.used_max == 0);
+
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_reserve_event(&event);
+    assert(result == FWK_SUCCESS);
+    result = fwk_thread_cancel_event(event);
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_event_pool_stats(&stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.size == 3);
+    assert(stats.used == 1);
+    assert(stats.used_max == 2);
+}
+
 static void test___fwk_thread_put_notification(void)
 {
     int result;
@@ -406,7 +797,7 @@ static void test___fwk_thread_put_notification(void)
 
     result = __fwk_thread_put_notification(&event1);
     assert(result == FWK_SUCCESS);
-    result_event = FWK_LIST_GET(fwk_list_pop_head(&ctx->event_queue),
+    result_event = FWK_LIST_GET(fwk_list_pop_head(normal_event_queue),
         struct fwk_event, slist_node);
     assert(fwk_id_is_equal(result_event->source_id, event1.source_id));
     assert(fwk_id_is_equal(result_event->target_id, event1.target_id));
@@ -428,10 +819,68 @@ static void test___fwk_thread_put_notification(void)
     assert(result_event->is_notification == true);
 }
 
+static void test___fwk_thread_run_multicast(void)
+{
+    int result;
+    struct fwk_event *multicast;
+    struct fwk_event notification = {
+        .source_id = FWK_ID_MODULE(0x3),
+        .target_id = FWK_ID_MODULE(0x3),
+        .id = FWK_ID_NOTIFICATION(0x3, 0x1),
+    };
+
+    result = __fwk_thread_init(2);
+    assert(result == FWK_SUCCESS);
+
+    /* A multicast notification without target is released */
+    multicast = __fwk_thread_begin_multicast_notification(&notification);
+    assert(multicast != NULL);
+    __fwk_thread_put_multicast_notification(multicast, 0);
+    assert(fwk_list_is_empty(normal_event_queue));
+    assert(ctx->used_event_count == 0);
+
+    multicast = __fwk_thread_begin_multicast_notification(&notification);
+    assert(multicast != NULL);
+    assert(multicast->is_notification == true);
+    assert(multicast->is_multicast == true);
+
+    result = __fwk_thread_add_notification_target(multicast,
+                                                  FWK_ID_MODULE(0x4));
+    assert(result == FWK_SUCCESS);
+    result = __fwk_thread_add_notification_target(multicast,
+                                                  FWK_ID_ELEMENT(0x5, 0x2));
+    assert(result == FWK_SUCCESS);
+    __fwk_thread_put_multicast_notification(multicast, 2);
+    assert(normal_event_queue->head == &(multicast->slist_node));
+
+    /* The event is delivered to both targets then released */
+    free_event_queue_break = true;
+    if (setjmp(test_context) == FWK_SUCCESS)
+        __fwk_thread_run();
+
+    assert(processed_notification == multicast);
+    assert(notification_target_count == 2);
+    assert(fwk_id_is_equal(notification_target_table[0], FWK_ID_MODULE(0x4)));
+    assert(fwk_id_is_equal(notification_target_table[1],
+                           FWK_ID_ELEMENT(0x5, 0x2)));
+    assert(fwk_list_is_empty(normal_event_queue));
+    assert(fwk_list_is_empty(&ctx->multicast_target_queue));
+    assert(ctx->free_event_queue.tail == &(multicast->slist_node));
+}
+
 static const struct fwk_test_case_desc test_case_table[] = {
     FWK_TEST_CASE(test___fwk_thread_init),
     FWK_TEST_CASE(test___fwk_thread_run),
+    FWK_TEST_CASE(test___fwk_thread_run_priority),
+    FWK_TEST_CASE(test___fwk_thread_run_idle),
+    FWK_TEST_CASE(test_fwk_thread_wait_for_interrupt),
+    FWK_TEST_CASE(test___fwk_thread_run_multicast),
     FWK_TEST_CASE(test_fwk_thread_put_event),
+    FWK_TEST_CASE(test_fwk_thread_put_events),
+    FWK_TEST_CASE(test_fwk_thread_put_event_supersedes),
+    FWK_TEST_CASE(test_fwk_thread_put_event_priority),
+    FWK_TEST_CASE(test_fwk_thread_reserve_commit_event),
+    FWK_TEST_CASE(test_fwk_thread_get_event_pool_stats),
     FWK_TEST_CASE(test___fwk_thread_put_notification)
 };
 
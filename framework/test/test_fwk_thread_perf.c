@@ -0,0 +1,256 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Microbenchmark of the event and notification processing. The events are
+ *     processed by the event loop of the framework, left through the idle
+ *     handler once all the events have been processed.
+ */
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <fwk_assert.h>
+#include <fwk_bench.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_list.h>
+#include <fwk_macros.h>
+#include <fwk_notification.h>
+#include <fwk_test.h>
+#include <fwk_thread.h>
+#include <internal/fwk_module.h>
+#include <internal/fwk_notification.h>
+#include <internal/fwk_thread.h>
+
+/* Number of event structures, thus of events queued at a time */
+#define EVENT_COUNT 64
+
+/* Largest number of subscribers to the notification */
+#define SUBSCRIBER_COUNT_MAX 32
+
+#define EVENT_OP_COUNT (EVENT_COUNT * 256)
+#define NOTIFICATION_OP_COUNT 4096
+
+static jmp_buf bench_context;
+static unsigned int processed_event_count;
+static unsigned int processed_notification_count;
+static unsigned int subscriber_count;
+
+static struct fwk_dlist subscription_dlist;
+const struct fwk_notification_static_subscription
+    module_static_subscription_table[] = {
+        { .notification_id = FWK_ID_NONE_INIT },
+    };
+static struct fwk_module fake_module_desc;
+static struct fwk_module_ctx fake_module_ctx = {
+    .desc = &fake_module_desc,
+    .subscription_dlist_table = &subscription_dlist,
+};
+
+/* Mock functions */
+void *__wrap_fwk_mm_calloc(size_t num, size_t size)
+{
+    return calloc(num, size);
+}
+
+void *__wrap_fwk_mm_calloc_hot(size_t num, size_t size)
+{
+    return __wrap_fwk_mm_calloc(num, size);
+}
+
+struct fwk_module_ctx *__wrap___fwk_module_get_ctx(fwk_id_t id)
+{
+    return &fake_module_ctx;
+}
+
+struct fwk_element_ctx *__wrap___fwk_module_get_element_ctx(fwk_id_t id)
+{
+    return NULL;
+}
+
+bool __wrap_fwk_module_is_valid_entity_id(fwk_id_t id)
+{
+    return true;
+}
+
+bool __wrap_fwk_module_is_valid_event_id(fwk_id_t id)
+{
+    return true;
+}
+
+bool __wrap_fwk_module_is_valid_notification_id(fwk_id_t id)
+{
+    return true;
+}
+
+int __wrap_fwk_interrupt_global_enable(void)
+{
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_global_disable(void)
+{
+    return FWK_SUCCESS;
+}
+
+int __wrap_fwk_interrupt_get_current(unsigned int *interrupt)
+{
+    return FWK_E_STATE;
+}
+
+static int process_event(const struct fwk_event *event,
+                         struct fwk_event *resp_event)
+{
+    processed_event_count++;
+    return FWK_SUCCESS;
+}
+
+static int process_notification(const struct fwk_event *event,
+                                struct fwk_event *resp_event)
+{
+    processed_notification_count++;
+    return FWK_SUCCESS;
+}
+
+/* Leave the event loop once all the events have been processed */
+static void idle(void)
+{
+    longjmp(bench_context, 1);
+}
+
+static void process_events(void)
+{
+    if (setjmp(bench_context) == 0)
+        __fwk_thread_run();
+}
+
+static void bench_put_event(unsigned int op_count)
+{
+    int status;
+    unsigned int i;
+    struct fwk_event event;
+
+    processed_event_count = 0;
+
+    for (i = 0; i < op_count; i++) {
+        event = (struct fwk_event) {
+            .source_id = FWK_ID_MODULE(1),
+            .target_id = FWK_ID_MODULE(0),
+            .id = FWK_ID_EVENT(0, 0),
+        };
+
+        status = fwk_thread_put_event(&event);
+        assert(status == FWK_SUCCESS);
+
+        if (((i + 1) % EVENT_COUNT) == 0)
+            process_events();
+    }
+    process_events();
+
+    assert(processed_event_count == op_count);
+}
+
+static void bench_notify(unsigned int op_count)
+{
+    int status;
+    unsigned int i, count;
+    struct fwk_event notification;
+
+    processed_notification_count = 0;
+
+    for (i = 0; i < op_count; i++) {
+        notification = (struct fwk_event) {
+            .source_id = FWK_ID_MODULE(0),
+            .id = FWK_ID_NOTIFICATION(0, 0),
+        };
+
+        status = fwk_notification_notify(&notification, &count);
+        assert(status == FWK_SUCCESS);
+        assert(count == subscriber_count);
+
+        process_events();
+    }
+
+    assert(processed_notification_count == (op_count * subscriber_count));
+}
+
+/* Subscribe new targets to the notification up to a number of subscribers */
+static void subscribe(unsigned int count)
+{
+    int status;
+
+    for (; subscriber_count < count; subscriber_count++) {
+        status = fwk_notification_subscribe(FWK_ID_NOTIFICATION(0, 0),
+                                            FWK_ID_MODULE(0),
+                                            FWK_ID_ELEMENT(1,
+                                                           subscriber_count));
+        assert(status == FWK_SUCCESS);
+    }
+}
+
+static int test_suite_setup(void)
+{
+    int status;
+
+    fake_module_desc.process_event = process_event;
+    fake_module_desc.process_notification = process_notification;
+    fwk_list_init(&subscription_dlist);
+
+    status = __fwk_thread_init(EVENT_COUNT);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = __fwk_notification_init(SUBSCRIBER_COUNT_MAX);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    __fwk_thread_set_idle_handler(idle);
+
+    return FWK_SUCCESS;
+}
+
+static void test_fwk_thread_put_event_perf(void)
+{
+    fwk_bench_run("fwk_thread_put_event+dispatch", bench_put_event,
+                  EVENT_OP_COUNT);
+}
+
+static void test_fwk_notification_notify_1_perf(void)
+{
+    subscribe(1);
+    fwk_bench_run("fwk_notification_notify+dispatch(subscribers=1)",
+                  bench_notify, NOTIFICATION_OP_COUNT);
+}
+
+static void test_fwk_notification_notify_8_perf(void)
+{
+    subscribe(8);
+    fwk_bench_run("fwk_notification_notify+dispatch(subscribers=8)",
+                  bench_notify, NOTIFICATION_OP_COUNT);
+}
+
+static void test_fwk_notification_notify_32_perf(void)
+{
+    subscribe(SUBSCRIBER_COUNT_MAX);
+    fwk_bench_run("fwk_notification_notify+dispatch(subscribers=32)",
+                  bench_notify, NOTIFICATION_OP_COUNT);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_thread_put_event_perf),
+    FWK_TEST_CASE(test_fwk_notification_notify_1_perf),
+    FWK_TEST_CASE(test_fwk_notification_notify_8_perf),
+    FWK_TEST_CASE(test_fwk_notification_notify_32_perf),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_thread_perf",
+    .test_suite_setup = test_suite_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,348 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2015-2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_test.h>
+#include <fwk_thread.h>
+#include <internal/fwk_thread.h>
+
+static uint32_t timestamp_value;
+
+static const struct fwk_module module_a = {
+    .event_count = 2,
+    .notification_count = 1,
+};
+
+static const struct fwk_module module_b = {
+    .event_count = 1,
+};
+
+const struct fwk_module *module_table[] = {
+    &module_a,
+    &module_b,
+    NULL,
+};
+
+/* Mock functions */
+static void *fwk_mm_calloc_val;
+void *__wrap_fwk_mm_calloc(size_t num, size_t size)
+{
+    if (fwk_mm_calloc_val)
+        return calloc(num, size);
+    return NULL;
+}
+
+static uint32_t timestamp(void)
+{
+    return timestamp_value;
+}
+
+static void dispatch(struct fwk_event *event, uint32_t duration)
+{
+    uint32_t start;
+
+    start = __fwk_thread_profile_start();
+    timestamp_value += duration;
+    __fwk_thread_profile_end(event, start);
+}
+
+static void test_case_setup(void)
+{
+    fwk_mm_calloc_val = (void *)1;
+    timestamp_value = 0;
+}
+
+static void test___fwk_thread_profile_init(void)
+{
+    int result;
+    struct fwk_thread_profile_stats stats;
+    struct fwk_thread_load_stats load;
+
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_E_INIT);
+
+    result = fwk_thread_get_load_stats(&load);
+    assert(result == FWK_E_INIT);
+
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_E_INIT);
+
+    result = __fwk_thread_profile_init(NULL);
+    assert(result == FWK_E_PARAM);
+
+    fwk_mm_calloc_val = NULL;
+    result = __fwk_thread_profile_init(timestamp);
+    assert(result == FWK_E_NOMEM);
+
+    fwk_mm_calloc_val = (void *)1;
+    result = __fwk_thread_profile_init(timestamp);
+    assert(result == FWK_SUCCESS);
+}
+
+static void test_fwk_thread_get_profile_stats(void)
+{
+    int result;
+    struct fwk_thread_profile_stats stats;
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(1),
+        .target_id = FWK_ID_ELEMENT(0, 3),
+        .id = FWK_ID_EVENT(0, 1),
+    };
+    struct fwk_event response = {
+        .source_id = FWK_ID_ELEMENT(0, 3),
+        .target_id = FWK_ID_MODULE(1),
+        .id = FWK_ID_EVENT(0, 1),
+        .is_response = true,
+    };
+    struct fwk_event notification = {
+        .source_id = FWK_ID_MODULE(0),
+        .target_id = FWK_ID_MODULE(1),
+        .id = FWK_ID_NOTIFICATION(0, 0),
+        .is_notification = true,
+    };
+
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    /* 0xFFFFFFF0 -> 0x10: the timestamp counter wraps around */
+    timestamp_value = UINT32_MAX - 0xF;
+    dispatch(&event, 0x20);
+    dispatch(&event, 0x3);
+    dispatch(&response, 0x1000);
+    dispatch(&notification, 0);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(0), NULL);
+    assert(result == FWK_E_PARAM);
+
+    /* Module 0 processed the two events */
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 2);
+    assert(stats.total == 0x23);
+    assert(stats.max == 0x20);
+    assert(stats.histogram[0] == 1);
+    assert(stats.histogram[1] == 1);
+
+    /* Module 1 processed the response and the notification */
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(1), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 2);
+    assert(stats.total == 0x1000);
+    assert(stats.max == 0x1000);
+    assert(stats.histogram[0] == 1);
+    assert(stats.histogram[3] == 1);
+
+    /* The event identifier covers the events and the response */
+    result = fwk_thread_get_profile_stats(FWK_ID_EVENT(0, 1), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 3);
+    assert(stats.total == 0x1023);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_EVENT(0, 0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 0);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_NOTIFICATION(0, 0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 1);
+    assert(stats.max == 0);
+
+    /* Invalid identifiers */
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(2), &stats);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_EVENT(1, 1), &stats);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_NOTIFICATION(1, 0), &stats);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_ELEMENT(0, 0), &stats);
+    assert(result == FWK_E_PARAM);
+}
+
+static void test_fwk_thread_profile_histogram_last_bin(void)
+{
+    int result;
+    struct fwk_thread_profile_stats stats;
+    struct fwk_event event = {
+        .target_id = FWK_ID_MODULE(1),
+        .id = FWK_ID_EVENT(1, 0),
+    };
+
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    dispatch(&event, UINT32_MAX);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_EVENT(1, 0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 1);
+    assert(stats.max == UINT32_MAX);
+    assert(stats.histogram[FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT - 1] == 1);
+}
+
+static void test_fwk_thread_reset_profile_stats(void)
+{
+    int result;
+    struct fwk_thread_profile_stats stats;
+    struct fwk_event event = {
+        .target_id = FWK_ID_MODULE(0),
+        .id = FWK_ID_EVENT(0, 0),
+    };
+
+    dispatch(&event, 10);
+
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 0);
+    assert(stats.total == 0);
+    assert(stats.max == 0);
+    assert(stats.histogram[0] == 0);
+
+    result = fwk_thread_get_profile_stats(FWK_ID_EVENT(0, 0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 0);
+}
+
+static void test_fwk_thread_get_load_stats(void)
+{
+    int result;
+    uint32_t start;
+    struct fwk_thread_load_stats before, after;
+    struct fwk_event event = {
+        .target_id = FWK_ID_MODULE(0),
+        .id = FWK_ID_EVENT(0, 0),
+    };
+    struct fwk_event nested_event = {
+        .target_id = FWK_ID_MODULE(1),
+        .id = FWK_ID_EVENT(1, 0),
+    };
+
+    result = fwk_thread_get_load_stats(NULL);
+    assert(result == FWK_E_PARAM);
+
+    timestamp_value = 1000;
+    result = fwk_thread_get_load_stats(&before);
+    assert(result == FWK_SUCCESS);
+    assert(before.timestamp == 1000);
+
+    dispatch(&event, 10);
+    timestamp_value += 50;
+
+    /* The nested dispatch is not counted twice */
+    start = __fwk_thread_profile_start();
+    dispatch(&nested_event, 5);
+    timestamp_value += 15;
+    __fwk_thread_profile_end(&event, start);
+
+    result = fwk_thread_get_load_stats(&after);
+    assert(result == FWK_SUCCESS);
+    assert((after.timestamp - before.timestamp) == 80);
+    assert((after.busy - before.busy) == 30);
+
+    /* The busy time is cumulative */
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_load_stats(&before);
+    assert(result == FWK_SUCCESS);
+    assert(before.busy == after.busy);
+}
+
+static void test_fwk_thread_get_queue_stats(void)
+{
+    int result;
+    struct fwk_thread_profile_stats stats;
+    struct fwk_event event = {
+        .target_id = FWK_ID_ELEMENT(0, 1),
+        .id = FWK_ID_EVENT(0, 0),
+    };
+    struct fwk_event other_event = {
+        .target_id = FWK_ID_MODULE(1),
+        .id = FWK_ID_EVENT(1, 0),
+    };
+
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    /* The events wait 0x30 and 0x11 ticks, the counter wraps around */
+    timestamp_value = UINT32_MAX - 0xF;
+    __fwk_thread_profile_queue(&event);
+    __fwk_thread_profile_queue(&other_event);
+    timestamp_value += 0x30;
+    dispatch(&event, 0x200);
+
+    __fwk_thread_profile_queue(&event);
+    timestamp_value += 0x11;
+    dispatch(&event, 0);
+
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(0), NULL);
+    assert(result == FWK_E_PARAM);
+
+    /* The queuing delay is accounted for the module of the target */
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 2);
+    assert(stats.total == 0x41);
+    assert(stats.max == 0x30);
+    assert(stats.histogram[1] == 2);
+
+    /* The processing time is not part of the queuing delay */
+    result = fwk_thread_get_profile_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.total == 0x200);
+
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(1), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 0);
+
+    /* Only module identifiers are accepted */
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(2), &stats);
+    assert(result == FWK_E_PARAM);
+
+    result = fwk_thread_get_queue_stats(FWK_ID_EVENT(0, 0), &stats);
+    assert(result == FWK_E_PARAM);
+
+    /* The queuing statistics are cleared with the processing statistics */
+    result = fwk_thread_reset_profile_stats();
+    assert(result == FWK_SUCCESS);
+
+    result = fwk_thread_get_queue_stats(FWK_ID_MODULE(0), &stats);
+    assert(result == FWK_SUCCESS);
+    assert(stats.count == 0);
+    assert(stats.total == 0);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test___fwk_thread_profile_init),
+    FWK_TEST_CASE(test_fwk_thread_get_profile_stats),
+    FWK_TEST_CASE(test_fwk_thread_profile_histogram_last_bin),
+    FWK_TEST_CASE(test_fwk_thread_reset_profile_stats),
+    FWK_TEST_CASE(test_fwk_thread_get_load_stats),
+    FWK_TEST_CASE(test_fwk_thread_get_queue_stats),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_thread_profile",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,99 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define BUILD_HAS_TRACE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_macros.h>
+#include <fwk_test.h>
+#include <fwk_trace.h>
+
+static unsigned int emit_count;
+static uint16_t emit_id;
+static uint32_t emit_value;
+
+static void emit(uint16_t id, uint32_t value)
+{
+    emit_count++;
+    emit_id = id;
+    emit_value = value;
+}
+
+static const struct fwk_trace_driver driver = {
+    .emit = emit,
+};
+
+static void test_case_setup(void)
+{
+    emit_count = 0;
+    emit_id = 0;
+    emit_value = 0;
+
+    fwk_trace_set_driver(NULL);
+}
+
+static void test_fwk_trace_set_driver_invalid(void)
+{
+    static const struct fwk_trace_driver invalid_driver = { 0 };
+    int result;
+
+    result = fwk_trace_set_driver(&invalid_driver);
+    assert(result == FWK_E_PARAM);
+
+    FWK_TRACE(FWK_TRACE_ID_EVENT_START, 1);
+    assert(emit_count == 0);
+}
+
+static void test_fwk_trace_no_driver(void)
+{
+    FWK_TRACE(FWK_TRACE_ID_EVENT_START, 1);
+    assert(emit_count == 0);
+}
+
+static void test_fwk_trace_emit(void)
+{
+    int result;
+
+    result = fwk_trace_set_driver(&driver);
+    assert(result == FWK_SUCCESS);
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_EXIT, 0x12345678);
+    assert(emit_count == 1);
+    assert(emit_id == FWK_TRACE_ID_ISR_EXIT);
+    assert(emit_value == 0x12345678);
+
+    result = fwk_trace_set_driver(NULL);
+    assert(result == FWK_SUCCESS);
+
+    FWK_TRACE(FWK_TRACE_ID_ISR_EXIT, 0);
+    assert(emit_count == 1);
+}
+
+static void test_fwk_trace_id_module(void)
+{
+    assert(FWK_TRACE_ID_MODULE(0, 0) == 0x0100);
+    assert(FWK_TRACE_ID_MODULE(2, 3) == 0x0303);
+    assert(FWK_TRACE_ID_MODULE(254, 255) == 0xFFFF);
+    assert(FWK_TRACE_ID_MODULE(0, 0) > FWK_TRACE_ID_ISR_EXIT);
+}
+
+static const struct fwk_test_case_desc test_case_table[] = {
+    FWK_TEST_CASE(test_fwk_trace_set_driver_invalid),
+    FWK_TEST_CASE(test_fwk_trace_no_driver),
+    FWK_TEST_CASE(test_fwk_trace_emit),
+    FWK_TEST_CASE(test_fwk_trace_id_module),
+};
+
+struct fwk_test_suite_desc test_suite = {
+    .name = "fwk_trace",
+    .test_case_setup = test_case_setup,
+    .test_case_count = FWK_ARRAY_SIZE(test_case_table),
+    .test_case_table = test_case_table,
+};
@@ -0,0 +1,115 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Activity monitor based DVFS governor.
+ */
+
+#ifndef MOD_AMU_GOVERNOR_H
+#define MOD_AMU_GOVERNOR_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupAmuGovernor AMU Governor
+ *
+ * \details The module selects the operating points of DVFS domains from the
+ *      activity of their cores, as measured by the activity monitors (AMU)
+ *      of the cores. The elements of the module are the governed domains.
+ *
+ *      Every sampling period, the constant frequency cycle counter of each
+ *      core of a domain is read through the memory-mapped interface of its
+ *      activity monitors. The counter only increments while the core is
+ *      active, so its increment over the period gives the utilization of the
+ *      core. The domain is set to the lowest operating point at which the
+ *      utilization of its busiest core is expected to be at most the target
+ *      utilization of the domain.
+ *
+ *      The operating points are selected within the frequency limits of the
+ *      domains, which the agents set through the SCMI performance protocol.
+ *      A level set by an agent holds until the next sampling period.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Utilization of a fully active core.
+ *
+ * \details The utilizations are fractions of the sampling period, in Q16
+ *      fixed point.
+ */
+#define MOD_AMU_GOVERNOR_UTILIZATION_MAX (UINT32_C(1) << 16)
+
+/*!
+ * \brief Core configuration.
+ */
+struct mod_amu_governor_core_config {
+    /*! Base address of the memory-mapped activity monitors of the core */
+    uintptr_t amu_base;
+
+    /*!
+     * \brief Identifier of the power domain of the core.
+     *
+     * \details The activity monitors of the core are only read while its
+     *      power domain is on, the core is idle otherwise. The identifier is
+     *      ignored if it is not an element identifier, or in firmware without
+     *      the power domain module.
+     */
+    fwk_id_t pd_id;
+};
+
+/*!
+ * \brief Domain configuration.
+ */
+struct mod_amu_governor_domain_config {
+    /*! Identifier of the DVFS domain */
+    fwk_id_t dvfs_domain_id;
+
+    /*! Table of the cores of the domain */
+    const struct mod_amu_governor_core_config *core_table;
+
+    /*! Number of cores */
+    unsigned int core_count;
+
+    /*!
+     * \brief Target utilization of the busiest core of the domain, in Q16
+     *      fixed point.
+     *
+     * \details The lower the target utilization, the more headroom is left
+     *      for the load to rise before the next sampling period.
+     */
+    uint32_t target_utilization;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_amu_governor_config {
+    /*! Sub-element identifier of the alarm sampling the activity monitors */
+    fwk_id_t alarm_id;
+
+    /*! Sampling period in milliseconds */
+    unsigned int sample_period_ms;
+
+    /*! Frequency of the constant frequency cycle counters in Hz */
+    uint64_t constant_frequency;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_AMU_GOVERNOR_H */
@@ -0,0 +1,36 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Memory-mapped interface of the activity monitors.
+ */
+
+#ifndef AMU_H
+#define AMU_H
+
+#include <stdint.h>
+#include <fwk_macros.h>
+
+/* Architected counters of the counter group 0 */
+enum amu_group0_counter {
+    AMU_GROUP0_CORE_CYCLES,
+    AMU_GROUP0_CONSTANT_CYCLES,
+    AMU_GROUP0_INSTRUCTIONS_RETIRED,
+    AMU_GROUP0_MEMORY_STALL_CYCLES,
+    AMU_GROUP0_COUNTER_COUNT
+};
+
+/* 64-bit counter, accessed as two 32-bit words */
+struct amu_counter {
+    FWK_R uint32_t LOW;
+    FWK_R uint32_t HIGH;
+};
+
+struct amu_reg {
+    struct amu_counter AMEVCNTR0[AMU_GROUP0_COUNTER_COUNT];
+};
+
+#endif /* AMU_H */
@@ -0,0 +1,361 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Activity monitor based DVFS governor.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <mod_amu_governor.h>
+#include <mod_dvfs.h>
+#include <mod_timer.h>
+#include <amu.h>
+#if BUILD_HAS_MOD_POWER_DOMAIN
+#include <mod_power_domain.h>
+#endif
+
+struct core_ctx {
+    /* Value of the constant frequency cycle counter at the last sample */
+    uint64_t count;
+
+    /* The counter was read at the last sample */
+    bool count_valid;
+};
+
+struct domain_ctx {
+    /* Domain configuration */
+    const struct mod_amu_governor_domain_config *config;
+
+    /* Table of core contexts */
+    struct core_ctx *core_ctx_table;
+
+    /* A frequency request to the DVFS domain is in progress */
+    bool request_pending;
+};
+
+static struct {
+    /* Module configuration */
+    const struct mod_amu_governor_config *config;
+
+    /* Table of domain contexts */
+    struct domain_ctx *domain_ctx_table;
+
+    /* Number of domains */
+    unsigned int domain_count;
+
+    /* Number of constant frequency cycles in a sampling period */
+    uint64_t period_cycles;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* DVFS domain API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+
+    #if BUILD_HAS_MOD_POWER_DOMAIN
+    /* Power domain API */
+    const struct mod_pd_public_api *pd_api;
+    #endif
+} ctx;
+
+/*
+ * Static functions
+ */
+
+/* Read a 64-bit counter without tearing across a carry into its high word */
+static uint64_t read_counter(const struct amu_counter *counter)
+{
+    uint32_t high;
+    uint32_t low;
+
+    do {
+        high = counter->HIGH;
+        low = counter->LOW;
+    } while (counter->HIGH != high);
+
+    return ((uint64_t)high << 32) | low;
+}
+
+static bool is_core_on(const struct mod_amu_governor_core_config *config)
+{
+    #if BUILD_HAS_MOD_POWER_DOMAIN
+    unsigned int state;
+
+    if (!fwk_id_is_type(config->pd_id, FWK_ID_TYPE_ELEMENT))
+        return true;
+
+    if (ctx.pd_api->get_current_state(config->pd_id, &state) != FWK_SUCCESS)
+        return false;
+
+    return (state == MOD_PD_STATE_ON);
+    #else
+    return true;
+    #endif
+}
+
+/*
+ * Sample the cores of a domain, and return the utilization of the busiest
+ * one over the sampling period.
+ */
+static uint32_t sample_cores(struct domain_ctx *domain_ctx)
+{
+    const struct mod_amu_governor_domain_config *config = domain_ctx->config;
+    const struct amu_reg *reg;
+    struct core_ctx *core_ctx;
+    uint32_t utilization = 0;
+    unsigned int core_idx;
+    uint64_t count;
+    uint64_t cycles;
+
+    for (core_idx = 0; core_idx < config->core_count; core_idx++) {
+        core_ctx = &domain_ctx->core_ctx_table[core_idx];
+
+        /* The counters are reset while the core is off */
+        if (!is_core_on(&config->core_table[core_idx])) {
+            core_ctx->count_valid = false;
+            continue;
+        }
+
+        reg = (const struct amu_reg *)config->core_table[core_idx].amu_base;
+        count = read_counter(&reg->AMEVCNTR0[AMU_GROUP0_CONSTANT_CYCLES]);
+
+        if (core_ctx->count_valid && (count >= core_ctx->count)) {
+            cycles = FWK_MIN(count - core_ctx->count, ctx.period_cycles);
+            utilization = FWK_MAX(utilization,
+                (uint32_t)((cycles * MOD_AMU_GOVERNOR_UTILIZATION_MAX) /
+                           ctx.period_cycles));
+        }
+
+        core_ctx->count = count;
+        core_ctx->count_valid = true;
+    }
+
+    return utilization;
+}
+
+/*
+ * Select the lowest operating point within the frequency limits at which the
+ * utilization is expected to be at most the target utilization, or the
+ * highest one within the limits if there is none.
+ */
+static int select_frequency(fwk_id_t domain_id, uint64_t required_frequency,
+                            uint64_t *frequency)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = ctx.dvfs_api;
+    struct mod_dvfs_frequency_limits limits;
+    struct mod_dvfs_opp opp;
+    size_t opp_count;
+    size_t opp_idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = dvfs_api->get_frequency_limits(domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *frequency = 0;
+
+    for (opp_idx = 0; opp_idx < opp_count; opp_idx++) {
+        status = dvfs_api->get_nth_opp(domain_id, opp_idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (opp.frequency < limits.minimum)
+            continue;
+
+        if (opp.frequency > limits.maximum)
+            break;
+
+        *frequency = opp.frequency;
+
+        if (opp.frequency >= required_frequency)
+            break;
+    }
+
+    return (*frequency == 0) ? FWK_E_RANGE : FWK_SUCCESS;
+}
+
+static void update_domain(struct domain_ctx *domain_ctx)
+{
+    const struct mod_amu_governor_domain_config *config = domain_ctx->config;
+    struct mod_dvfs_opp current_opp;
+    uint64_t required_frequency;
+    uint64_t frequency;
+    uint32_t utilization;
+    int status;
+
+    utilization = sample_cores(domain_ctx);
+
+    /* The counters keep being sampled while a transition is in progress */
+    if (domain_ctx->request_pending)
+        return;
+
+    status = ctx.dvfs_api->get_current_opp(config->dvfs_domain_id,
+                                           &current_opp);
+    if (status != FWK_SUCCESS)
+        return;
+
+    required_frequency = (current_opp.frequency * utilization) /
+                         config->target_utilization;
+
+    status = select_frequency(config->dvfs_domain_id, required_frequency,
+                              &frequency);
+    if ((status != FWK_SUCCESS) || (frequency == current_opp.frequency))
+        return;
+
+    status = ctx.dvfs_api->set_frequency_async(config->dvfs_domain_id,
+                                               frequency);
+    if (status == FWK_SUCCESS)
+        domain_ctx->request_pending = true;
+}
+
+static void complete_request(fwk_id_t dvfs_domain_id)
+{
+    struct domain_ctx *domain_ctx;
+    unsigned int domain_idx;
+
+    for (domain_idx = 0; domain_idx < ctx.domain_count; domain_idx++) {
+        domain_ctx = &ctx.domain_ctx_table[domain_idx];
+
+        if (fwk_id_is_equal(domain_ctx->config->dvfs_domain_id,
+                            dvfs_domain_id)) {
+            domain_ctx->request_pending = false;
+            return;
+        }
+    }
+}
+
+/*
+ * Framework handlers
+ */
+
+static int amu_governor_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    const struct mod_amu_governor_config *config = data;
+
+    if ((element_count == 0) || (config == NULL) ||
+        (config->sample_period_ms == 0))
+        return FWK_E_DATA;
+
+    ctx.period_cycles =
+        (config->constant_frequency * config->sample_period_ms) / 1000;
+    if (ctx.period_cycles == 0)
+        return FWK_E_DATA;
+
+    ctx.domain_ctx_table = fwk_mm_calloc(element_count,
+                                         sizeof(ctx.domain_ctx_table[0]));
+    if (ctx.domain_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    ctx.domain_count = element_count;
+    ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int amu_governor_element_init(fwk_id_t element_id,
+                                     unsigned int sub_element_count,
+                                     const void *data)
+{
+    const struct mod_amu_governor_domain_config *config = data;
+    struct domain_ctx *domain_ctx;
+
+    if ((config == NULL) ||
+        (config->core_count == 0) || (config->core_table == NULL) ||
+        (config->target_utilization == 0) ||
+        (config->target_utilization > MOD_AMU_GOVERNOR_UTILIZATION_MAX))
+        return FWK_E_DATA;
+
+    domain_ctx = &ctx.domain_ctx_table[fwk_id_get_element_idx(element_id)];
+
+    domain_ctx->core_ctx_table =
+        fwk_mm_calloc(config->core_count,
+                      sizeof(domain_ctx->core_ctx_table[0]));
+    if (domain_ctx->core_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    domain_ctx->config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int amu_governor_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if ((round != 0) || fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                             &ctx.alarm_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    #if BUILD_HAS_MOD_POWER_DOMAIN
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_POWER_DOMAIN),
+                             mod_pd_api_id_public, &ctx.pd_api);
+    if (status != FWK_SUCCESS)
+        return status;
+    #endif
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+                           mod_dvfs_api_id_dvfs, &ctx.dvfs_api);
+}
+
+static int amu_governor_start(fwk_id_t id)
+{
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    return ctx.alarm_api->start(ctx.config->alarm_id,
+                                ctx.config->sample_period_ms,
+                                MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+static int amu_governor_process_event(const struct fwk_event *event,
+                                      struct fwk_event *resp_event)
+{
+    unsigned int domain_idx;
+
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        for (domain_idx = 0; domain_idx < ctx.domain_count; domain_idx++)
+            update_domain(&ctx.domain_ctx_table[domain_idx]);
+
+        return FWK_SUCCESS;
+    }
+
+    /* A failed transition is retried in the next sampling period */
+    if (fwk_id_is_equal(event->id, mod_dvfs_event_id_set_frequency)) {
+        complete_request(event->source_id);
+
+        return FWK_SUCCESS;
+    }
+
+    return FWK_E_PARAM;
+}
+
+const struct fwk_module module_amu_governor = {
+    .name = "AMU governor",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .init = amu_governor_init,
+    .element_init = amu_governor_element_init,
+    .bind = amu_governor_bind,
+    .start = amu_governor_start,
+    .process_event = amu_governor_process_event,
+};
@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \ingroup GroupModules Modules
@@ -19,6 +21,11 @@
  * \brief Application Processor (AP) context module.
  *
  * \details This module implements the AP context zero-initialization.
+ *      The start of the AP context, the part the AP reads when it boots, can
+ *      be zeroed first and the remainder in the background, in chunks
+ *      processed as events in between the other events of the firmware. The
+ *      AP can then be released as soon as the start of the AP context is
+ *      zeroed.
  * \{
  */
 
@@ -34,8 +41,87 @@ struct mod_apcontext_config {
 
     /*! Identifier of the clock this module depends on */
     fwk_id_t clock_id;
+
+    /*!
+     * \brief Size in bytes of the start of the AP context zeroed before the
+     *      AP is released.
+     *
+     * \details The start of the AP context is zeroed when the module starts,
+     *      or when the clock it depends on is running, before the modules
+     *      subscribed to the clock notification after this module are
+     *      notified. The remainder is zeroed in the background and
+     *      \ref mod_apcontext_notification_id_zeroed is sent once the whole
+     *      AP context is zeroed. The AP must not write to the remainder before
+     *      then. Zero, or a size greater than or equal to the size of the AP
+     *      context, zeroes the whole AP context before the AP is released.
+     */
+    size_t boot_size;
+
+    /*!
+     * \brief Size in bytes of the chunks the remainder of the AP context is
+     *      zeroed in, one chunk per event.
+     *
+     * \details Zero zeroes the remainder in a single chunk.
+     */
+    size_t chunk_size;
+
+    /*!
+     * \brief Identifier of the zeroing driver, typically a DMA engine.
+     *
+     * \details Module or element identifier of the driver. FWK_ID_NONE, or
+     *      left unset, to zero the AP context with the processor, with wide
+     *      stores.
+     */
+    fwk_id_t zero_driver_id;
+
+    /*!
+     * \brief Identifier of the zeroing driver API, see
+     *      \ref mod_apcontext_zero_api.
+     */
+    fwk_id_t zero_driver_api_id;
+};
+
+/*!
+ * \brief Zeroing driver interface.
+ *
+ * \details Interface of a driver zeroing memory on behalf of the module, for
+ *      instance with a DMA engine.
+ */
+struct mod_apcontext_zero_api {
+    /*!
+     * \brief Zero a memory area and wait for the operation to complete.
+     *
+     * \param driver_id Identifier of the driver.
+     * \param base Base address of the area.
+     * \param size Size in bytes of the area.
+     *
+     * \retval FWK_SUCCESS The area was zeroed.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*zero)(fwk_id_t driver_id, uintptr_t base, size_t size);
 };
 
+/*!
+ * \brief Notification indices.
+ */
+enum mod_apcontext_notification_idx {
+    /*! The whole AP context is zeroed */
+    MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED,
+
+    /*! Number of notifications */
+    MOD_APCONTEXT_NOTIFICATION_IDX_COUNT,
+};
+
+/*!
+ * \brief Identifier of the \ref MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED
+ *      notification.
+ */
+static const fwk_id_t mod_apcontext_notification_id_zeroed =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_APCONTEXT,
+        MOD_APCONTEXT_NOTIFICATION_IDX_ZEROED);
+
 /*!
  * \}
  */
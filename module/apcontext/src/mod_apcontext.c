@@ -5,13 +5,14 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-#include <string.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
+#include <fwk_mem.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <mod_apcontext.h>
 #include <mod_clock.h>
 #include <mod_log.h>
@@ -19,20 +20,83 @@
 
 #define MODULE_NAME "[APContext]"
 
+/* Event zeroing the next chunk of the AP context */
+static const fwk_id_t apcontext_event_id_zero =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_APCONTEXT, 0);
+
 static const struct mod_log_api *log;
 
-static void apcontext_zero(void)
+static struct {
+    /* Zeroing driver API, NULL to zero with the processor */
+    const struct mod_apcontext_zero_api *zero_api;
+
+    /* Size in bytes of the start of the AP context already zeroed */
+    size_t zeroed_size;
+} ctx;
+
+/* Zero the next 'size' bytes of the AP context */
+static int zero_next(const struct mod_apcontext_config *config, size_t size)
 {
+    int status;
+    uintptr_t base = config->base + ctx.zeroed_size;
+
+    if (ctx.zero_api != NULL) {
+        status = ctx.zero_api->zero(config->zero_driver_id, base, size);
+        if (status != FWK_SUCCESS)
+            return status;
+    } else
+        fwk_mem_set((void *)base, 0, size);
+
+    ctx.zeroed_size += size;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Request the zeroing of the next chunk of the AP context, or notify that the
+ * whole AP context is zeroed.
+ */
+static int continue_zeroing(const struct mod_apcontext_config *config)
+{
+    unsigned int notification_count;
+    struct fwk_event event = {
+        .source_id = fwk_module_id_apcontext,
+        .target_id = fwk_module_id_apcontext,
+    };
+
+    if (ctx.zeroed_size < config->size) {
+        event.id = apcontext_event_id_zero;
+        return fwk_thread_put_event(&event);
+    }
+
+    MOD_LOG(log, MOD_LOG_GROUP_DEBUG, MODULE_NAME " AP context area zeroed\n");
+
+    event.id = mod_apcontext_notification_id_zeroed;
+    return fwk_notification_notify(&event, &notification_count);
+}
+
+static int apcontext_zero(void)
+{
+    int status;
     const struct mod_apcontext_config *config;
+    size_t boot_size;
 
     config = fwk_module_get_data(fwk_module_id_apcontext);
 
-    log->log(MOD_LOG_GROUP_DEBUG, MODULE_NAME
+    MOD_LOG(log, MOD_LOG_GROUP_DEBUG, MODULE_NAME
         " Zeroing AP context area [0x%08x - 0x%08x]\n",
         config->base,
         config->base + config->size);
 
-    memset((void *)config->base, 0, config->size);
+    boot_size = config->boot_size;
+    if ((boot_size == 0) || (boot_size > config->size))
+        boot_size = config->size;
+
+    status = zero_next(config, boot_size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return continue_zeroing(config);
 }
 
 /*
@@ -61,6 +125,8 @@ static int apcontext_bind(fwk_id_t id, unsigned int round)
 {
     int status;
 
+    const struct mod_apcontext_config *config;
+
     /* Skip second round */
     if (round > 0)
         return FWK_SUCCESS;
@@ -69,6 +135,14 @@ static int apcontext_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return FWK_E_PANIC;
 
+    config = fwk_module_get_data(fwk_module_id_apcontext);
+    /* Unset or FWK_ID_NONE, the AP context is zeroed by the processor */
+    if (fwk_id_is_type(config->zero_driver_id, FWK_ID_TYPE_MODULE) ||
+        fwk_id_is_type(config->zero_driver_id, FWK_ID_TYPE_ELEMENT)) {
+        return fwk_module_bind(config->zero_driver_id,
+                               config->zero_driver_api_id, &ctx.zero_api);
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -77,10 +151,8 @@ static int apcontext_start(fwk_id_t id)
     const struct mod_apcontext_config *config =
         fwk_module_get_data(fwk_module_id_apcontext);
 
-    if (fwk_id_is_equal(config->clock_id, FWK_ID_NONE)) {
-        apcontext_zero();
-        return FWK_SUCCESS;
-    }
+    if (fwk_id_is_equal(config->clock_id, FWK_ID_NONE))
+        return apcontext_zero();
 
     /* Register the module for clock state notifications */
     return fwk_notification_subscribe(
@@ -92,6 +164,7 @@ static int apcontext_start(fwk_id_t id)
 static int apcontext_process_notification(const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
+    int status;
     struct clock_notification_params *params;
 
     assert(fwk_id_is_equal(event->id, mod_clock_notification_id_state_changed));
@@ -104,7 +177,9 @@ static int apcontext_process_notification(const struct fwk_event *event,
      * only
      */
     if (params->new_state == MOD_CLOCK_STATE_RUNNING) {
-        apcontext_zero();
+        status = apcontext_zero();
+        if (status != FWK_SUCCESS)
+            return status;
 
         /* Unsubscribe to the notification */
         return fwk_notification_unsubscribe(event->id, event->source_id,
@@ -114,11 +189,34 @@ static int apcontext_process_notification(const struct fwk_event *event,
     return FWK_SUCCESS;
 }
 
+static int apcontext_process_event(const struct fwk_event *event,
+                                   struct fwk_event *resp_event)
+{
+    int status;
+    const struct mod_apcontext_config *config;
+    size_t size;
+
+    config = fwk_module_get_data(fwk_module_id_apcontext);
+
+    size = config->size - ctx.zeroed_size;
+    if ((config->chunk_size != 0) && (config->chunk_size < size))
+        size = config->chunk_size;
+
+    status = zero_next(config, size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return continue_zeroing(config);
+}
+
 const struct fwk_module module_apcontext = {
     .name = "APContext",
     .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = 1,
+    .notification_count = MOD_APCONTEXT_NOTIFICATION_IDX_COUNT,
     .init = apcontext_init,
     .bind = apcontext_bind,
     .start = apcontext_start,
+    .process_event = apcontext_process_event,
     .process_notification = apcontext_process_notification,
 };
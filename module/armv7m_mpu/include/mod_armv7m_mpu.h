@@ -17,8 +17,32 @@
  * \{
  */
 
+/*!
+ * \brief API indices.
+ */
+enum mod_armv7m_mpu_api_idx {
+    /*!
+     * \brief Data cache maintenance for the SMT channels with a cacheable
+     *      mailbox, see \ref mod_smt_cache_api.
+     *
+     * \details The operations are extended to whole cache lines of 32 bytes.
+     *      On processors without data cache, they only complete the pending
+     *      memory accesses.
+     */
+    MOD_ARMV7M_MPU_API_IDX_SMT_CACHE,
+
+    /*! Number of APIs */
+    MOD_ARMV7M_MPU_API_IDX_COUNT,
+};
+
 /*!
  * \brief Module configuration.
+ *
+ * \details In a firmware built with multithreading support, the module
+ *      installs a no-access region over the guard below the stack of each
+ *      thread (see \ref FWK_THREAD_STACK_GUARD_SIZE) in the regions above the
+ *      configured ones, as far as the MPU has regions left. A stack overflow
+ *      then raises a fault rather than corrupting the memory below the stack.
  */
 struct mod_armv7m_mpu_config {
     /*!
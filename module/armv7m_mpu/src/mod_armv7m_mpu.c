@@ -5,10 +5,64 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdint.h>
 #include <mod_armv7m_mpu.h>
 #include <fwk_assert.h>
+#include <fwk_errno.h>
 #include <fwk_id.h>
 #include <fwk_module.h>
+#ifdef BUILD_HAS_MULTITHREADING
+#include <fwk_multi_thread.h>
+#endif
+#if BUILD_HAS_MOD_SMT
+#include <fwk_module_idx.h>
+#include <mod_smt.h>
+#endif
+
+/* Size in bytes of a line of the data cache of the ARMv7-M processors */
+#define DCACHE_LINE_SIZE 32
+
+#ifdef BUILD_HAS_MULTITHREADING
+static struct {
+    /* Number of MPU regions programmed from the configuration */
+    size_t region_count;
+} ctx;
+#endif
+
+#if BUILD_HAS_MOD_SMT
+/*
+ * The CMSIS functions maintaining the cache by address do not all extend an
+ * unaligned range to the start of its first cache line.
+ */
+static void clean_dcache(uintptr_t address, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uintptr_t start = address & ~(uintptr_t)(DCACHE_LINE_SIZE - 1);
+
+    SCB_CleanDCache_by_Addr((uint32_t *)start,
+                            (int32_t)(size + (address - start)));
+#else
+    __DSB();
+#endif
+}
+
+static void invalidate_dcache(uintptr_t address, size_t size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uintptr_t start = address & ~(uintptr_t)(DCACHE_LINE_SIZE - 1);
+
+    SCB_InvalidateDCache_by_Addr((uint32_t *)start,
+                                 (int32_t)(size + (address - start)));
+#else
+    __DSB();
+#endif
+}
+
+static const struct mod_smt_cache_api smt_cache_api = {
+    .clean = clean_dcache,
+    .invalidate = invalidate_dcache,
+};
+#endif
 
 static int armv7m_mpu_init(
     fwk_id_t module_id,
@@ -26,12 +80,70 @@ static int armv7m_mpu_init(
     ARM_MPU_Load(config->regions, config->region_count);
     ARM_MPU_Enable(MPU_CTRL_HFNMIENA_Msk);
 
+#ifdef BUILD_HAS_MULTITHREADING
+    ctx.region_count = config->region_count;
+#endif
+
     return FWK_SUCCESS;
 }
 
+#ifdef BUILD_HAS_MULTITHREADING
+static int armv7m_mpu_start(fwk_id_t id)
+{
+    struct fwk_thread_stack_info info;
+    unsigned int region, region_max, thread_idx;
+
+    static_assert(FWK_THREAD_STACK_GUARD_SIZE == 32,
+                  "The stack guards must match the smallest MPU region");
+
+    region_max = (MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos;
+
+    /*
+     * The threads are all created by the end of the initialization stage. The
+     * guards are installed in the regions left by the configuration, which
+     * take precedence over the configured ones, the guard of every thread
+     * being active at all times.
+     */
+    ARM_MPU_Disable();
+
+    for (region = ctx.region_count, thread_idx = 0;
+         (region < region_max) &&
+         (fwk_thread_get_stack_info(thread_idx, &info) == FWK_SUCCESS);
+         region++, thread_idx++) {
+        ARM_MPU_SetRegion(ARM_MPU_RBAR(region, info.guard),
+            ARM_MPU_RASR(1, ARM_MPU_AP_NONE, 0, 0, 0, 0, 0,
+                         ARM_MPU_REGION_SIZE_32B));
+    }
+
+    ARM_MPU_Enable(MPU_CTRL_HFNMIENA_Msk);
+
+    return FWK_SUCCESS;
+}
+#endif
+
+static int armv7m_mpu_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    switch (fwk_id_get_api_idx(api_id)) {
+#if BUILD_HAS_MOD_SMT
+    case MOD_ARMV7M_MPU_API_IDX_SMT_CACHE:
+        *api = &smt_cache_api;
+        return FWK_SUCCESS;
+#endif
+
+    default:
+        return FWK_E_SUPPORT;
+    }
+}
+
 /* Module description */
 const struct fwk_module module_armv7m_mpu = {
     .name = "ARMV7M_MPU",
     .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_ARMV7M_MPU_API_IDX_COUNT,
     .init = armv7m_mpu_init,
+    .process_bind_request = armv7m_mpu_process_bind_request,
+#ifdef BUILD_HAS_MULTITHREADING
+    .start = armv7m_mpu_start,
+#endif
 };
@@ -0,0 +1,131 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_ARMV7M_TRACE_H
+#define MOD_ARMV7M_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \ingroup GroupModules
+ * \addtogroup GroupTraceARMv7M Trace (ARMv7-M)
+ * \{
+ */
+
+/*!
+ * \brief Trace sink.
+ */
+enum mod_armv7m_trace_sink {
+    /*!
+     * \brief Serial Wire Output.
+     *
+     * \details Each trace point is written to an ITM stimulus port as three
+     *      software source packets: the 32-bit cycle count, the 16-bit trace
+     *      identifier and the 32-bit value. The packets of a trace point are
+     *      never interleaved with the ones of another.
+     */
+    MOD_ARMV7M_TRACE_SINK_SWO,
+
+    /*!
+     * \brief Buffer in memory.
+     *
+     * \details The trace points are recorded into a ring of entries, see
+     *      \ref mod_armv7m_trace_buffer.
+     */
+    MOD_ARMV7M_TRACE_SINK_BUFFER,
+};
+
+/*!
+ * \brief Buffer signature, "TRCB" in memory.
+ */
+#define MOD_ARMV7M_TRACE_BUFFER_SIGNATURE UINT32_C(0x42435254)
+
+/*!
+ * \brief Entry of the trace buffer.
+ */
+struct mod_armv7m_trace_entry {
+    /*! Value of the DWT cycle counter when the trace point was reached */
+    uint32_t timestamp;
+
+    /*! Trace identifier */
+    uint16_t id;
+
+    /*! Reserved */
+    uint16_t reserved;
+
+    /*! Value of the trace point */
+    uint32_t value;
+};
+
+/*!
+ * \brief Trace buffer.
+ *
+ * \details The buffer is meant to be read by a debugger, either while the
+ *      processor is halted or after the trace of interest has been recorded.
+ *      Once the ring is full the oldest entries are overwritten, the entries
+ *      are then read from index \c write_count modulo \c entry_count onwards.
+ */
+struct mod_armv7m_trace_buffer {
+    /*! Signature, \ref MOD_ARMV7M_TRACE_BUFFER_SIGNATURE */
+    uint32_t signature;
+
+    /*! Number of entries of the ring */
+    uint32_t entry_count;
+
+    /*! Number of entries recorded since the buffer was initialized */
+    volatile uint32_t write_count;
+
+    /*! Frequency of the DWT cycle counter in Hz, zero if unknown */
+    uint32_t frequency;
+
+    /*! Ring of entries */
+    struct mod_armv7m_trace_entry entries[];
+};
+
+/*!
+ * \brief Module configuration.
+ *
+ * \details The module starts the DWT cycle counter and registers itself as
+ *      the trace driver of the framework (see \ref GroupTrace). The trace
+ *      points are only exported in firmware built with trace support.
+ */
+struct mod_armv7m_trace_config {
+    /*! Trace sink */
+    enum mod_armv7m_trace_sink sink;
+
+    /*! Frequency of the DWT cycle counter in Hz, zero if unknown */
+    uint32_t frequency;
+
+    /*! ITM stimulus port the trace points are written to (SWO sink) */
+    unsigned int stimulus_port;
+
+    /*!
+     * \brief Prescaler of the SWO clock (SWO sink).
+     *
+     * \details The bit rate of the SWO is the frequency of the trace clock
+     *      divided by the prescaler plus one. The SWO uses the NRZ (UART)
+     *      encoding.
+     */
+    uint16_t swo_prescaler;
+
+    /*!
+     * \brief Address of the trace buffer (buffer sink).
+     *
+     * \details The address must be aligned on a word boundary.
+     */
+    uintptr_t buffer_address;
+
+    /*! Size of the trace buffer in bytes (buffer sink) */
+    size_t buffer_size;
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_ARMV7M_TRACE_H */
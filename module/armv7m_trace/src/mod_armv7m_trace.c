@@ -0,0 +1,188 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fmw_cmsis.h>
+#include <mod_armv7m_trace.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_trace.h>
+
+/* Key unlocking the write access to the ITM registers */
+#define ITM_LAR_KEY UINT32_C(0xC5ACCE55)
+
+/* Trace bus identifier of the ITM */
+#define ITM_TRACE_BUS_ID 1
+
+/* Pin protocol of the TPIU: asynchronous SWO, NRZ encoding */
+#define TPI_SPPR_SWO_NRZ 2
+
+static struct {
+    /* Module configuration */
+    const struct mod_armv7m_trace_config *config;
+
+    /* Trace buffer (buffer sink) */
+    struct mod_armv7m_trace_buffer *buffer;
+} ctx;
+
+/*
+ * Static functions
+ */
+
+static void itm_write_u32(unsigned int port, uint32_t value)
+{
+    /* Wait for the stimulus port FIFO to have room */
+    while (ITM->PORT[port].u32 == 0)
+        continue;
+
+    ITM->PORT[port].u32 = value;
+}
+
+static void itm_write_u16(unsigned int port, uint16_t value)
+{
+    while (ITM->PORT[port].u32 == 0)
+        continue;
+
+    ITM->PORT[port].u16 = value;
+}
+
+static void start_swo(const struct mod_armv7m_trace_config *config)
+{
+    /* Bypass the formatter, the SWO only carries the ITM stream */
+    TPI->SPPR = TPI_SPPR_SWO_NRZ;
+    TPI->ACPR = config->swo_prescaler;
+    TPI->FFCR &= ~TPI_FFCR_EnFCont_Msk;
+
+    ITM->LAR = ITM_LAR_KEY;
+    ITM->TCR = (ITM_TRACE_BUS_ID << ITM_TCR_TraceBusID_Pos) |
+               ITM_TCR_SWOENA_Msk | ITM_TCR_SYNCENA_Msk | ITM_TCR_ITMENA_Msk;
+    /* Unprivileged software may not use the stimulus port */
+    ITM->TPR = 0;
+    ITM->TER |= UINT32_C(1) << config->stimulus_port;
+}
+
+/*
+ * Trace driver
+ */
+
+static FWK_HOT void emit_swo(uint16_t id, uint32_t value)
+{
+    unsigned int port = ctx.config->stimulus_port;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    itm_write_u32(port, DWT->CYCCNT);
+    itm_write_u16(port, id);
+    itm_write_u32(port, value);
+
+    __set_PRIMASK(primask);
+}
+
+static FWK_HOT void emit_buffer(uint16_t id, uint32_t value)
+{
+    struct mod_armv7m_trace_buffer *buffer = ctx.buffer;
+    struct mod_armv7m_trace_entry *entry;
+    uint32_t primask;
+    uint32_t write_count;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    write_count = buffer->write_count;
+    buffer->write_count = write_count + 1;
+
+    entry = &buffer->entries[write_count % buffer->entry_count];
+    entry->timestamp = DWT->CYCCNT;
+    entry->id = id;
+    entry->value = value;
+
+    __set_PRIMASK(primask);
+}
+
+static const struct fwk_trace_driver swo_driver = {
+    .emit = emit_swo,
+};
+
+static const struct fwk_trace_driver buffer_driver = {
+    .emit = emit_buffer,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int armv7m_trace_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    const struct mod_armv7m_trace_config *config = data;
+    const struct fwk_trace_driver *driver;
+    struct mod_armv7m_trace_buffer *buffer;
+    size_t entry_count;
+
+    if ((element_count != 0) || (config == NULL))
+        return FWK_E_DATA;
+
+    /* The DWT and ITM are enabled by the TRCENA bit of the DEMCR register */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    switch (config->sink) {
+    case MOD_ARMV7M_TRACE_SINK_SWO:
+        if (config->stimulus_port >= FWK_ARRAY_SIZE(ITM->PORT))
+            return FWK_E_DATA;
+
+        start_swo(config);
+        driver = &swo_driver;
+        break;
+
+    case MOD_ARMV7M_TRACE_SINK_BUFFER:
+        if ((config->buffer_address == 0) ||
+            ((config->buffer_address % sizeof(uint32_t)) != 0) ||
+            (config->buffer_size < sizeof(*buffer)))
+            return FWK_E_DATA;
+
+        entry_count = (config->buffer_size - sizeof(*buffer)) /
+                      sizeof(buffer->entries[0]);
+        if (entry_count == 0)
+            return FWK_E_DATA;
+
+        buffer = (struct mod_armv7m_trace_buffer *)config->buffer_address;
+        buffer->signature = 0;
+        buffer->entry_count = entry_count;
+        buffer->write_count = 0;
+        buffer->frequency = config->frequency;
+        /* The signature is written last for the buffer to be found complete */
+        buffer->signature = MOD_ARMV7M_TRACE_BUFFER_SIGNATURE;
+
+        ctx.buffer = buffer;
+        driver = &buffer_driver;
+        break;
+
+    default:
+        return FWK_E_DATA;
+    }
+
+    ctx.config = config;
+
+#ifdef BUILD_HAS_TRACE
+    return fwk_trace_set_driver(driver);
+#else
+    (void)driver;
+
+    return FWK_SUCCESS;
+#endif
+}
+
+const struct fwk_module module_armv7m_trace = {
+    .name = "ARMV7M_TRACE",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .init = armv7m_trace_init,
+};
@@ -0,0 +1,124 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Adaptive voltage scaling.
+ */
+
+#ifndef MOD_AVS_H
+#define MOD_AVS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupAvs Adaptive Voltage Scaling
+ *
+ * \details The module trims the voltages of the operating points of DVFS
+ *      domains down to what the chip needs, instead of the nominal voltages
+ *      of the configuration which cover the worst-case silicon. The elements
+ *      of the module are the trimmed domains.
+ *
+ *      The operating points of a domain are calibrated when the firmware
+ *      starts, and every calibration period afterwards. For each operating
+ *      point, the voltage steps down from the nominal one for as long as the
+ *      monitor of the domain reports the operating point as stable at the
+ *      lower voltage, within the maximum trim of the domain. The guard margin
+ *      of the domain is added to the lowest stable voltage, and the result is
+ *      applied by the DVFS module through its power supply. Each calibration
+ *      starts over from the nominal voltages, so that the voltages follow the
+ *      ageing and the temperature of the chip.
+ *
+ *      The monitor of a domain is a driver implementing
+ *      \ref mod_avs_monitor_api, typically on top of on-die process or
+ *      critical path sensors, or of a stability test of the domain.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Monitor API.
+ *
+ * \details API implemented by the monitors of the domains.
+ */
+struct mod_avs_monitor_api {
+    /*!
+     * \brief Check whether an operating point is stable at a voltage.
+     *
+     * \param monitor_id Identifier of the monitor.
+     * \param frequency Frequency of the operating point in Hertz (Hz).
+     * \param voltage Voltage to check in millivolts (mV).
+     * \param [out] stable Whether the operating point is stable at the
+     *      voltage.
+     *
+     * \retval FWK_SUCCESS The operating point was checked.
+     * \return One of the standard framework error codes, in which case the
+     *      calibration of the domain is abandoned and its voltages are left
+     *      as they are.
+     */
+    int (*check)(fwk_id_t monitor_id, uint64_t frequency, uint64_t voltage,
+                 bool *stable);
+};
+
+/*!
+ * \brief Domain configuration.
+ */
+struct mod_avs_domain_config {
+    /*! Identifier of the DVFS domain */
+    fwk_id_t dvfs_domain_id;
+
+    /*! Identifier of the monitor of the domain */
+    fwk_id_t monitor_id;
+
+    /*! Identifier of the monitor API */
+    fwk_id_t monitor_api_id;
+
+    /*! Voltage step of the calibration in millivolts (mV) */
+    uint32_t step;
+
+    /*!
+     * \brief Maximum trim below the nominal voltages in millivolts (mV).
+     *
+     * \details Bounds the voltages whatever the monitor reports.
+     */
+    uint32_t max_trim;
+
+    /*! Guard margin above the lowest stable voltages in millivolts (mV) */
+    uint32_t margin;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_avs_config {
+    /*!
+     * \brief Sub-element identifier of the alarm of the periodic
+     *      calibrations.
+     *
+     * \details The domains are only calibrated when the firmware starts if
+     *      the identifier is not a sub-element identifier.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Calibration period in milliseconds */
+    unsigned int period_ms;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_AVS_H */
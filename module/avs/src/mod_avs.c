@@ -0,0 +1,283 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Adaptive voltage scaling.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <mod_avs.h>
+#include <mod_dvfs.h>
+#include <mod_timer.h>
+
+enum mod_avs_event_idx {
+    /* Calibrate the domains when the firmware starts */
+    MOD_AVS_EVENT_IDX_CALIBRATE,
+
+    MOD_AVS_EVENT_IDX_COUNT,
+};
+
+struct domain_ctx {
+    /* Domain configuration */
+    const struct mod_avs_domain_config *config;
+
+    /* Monitor API */
+    const struct mod_avs_monitor_api *monitor_api;
+
+    /* Table of the operating points of the domain, at nominal voltages */
+    struct mod_dvfs_opp *opp_table;
+
+    /* Number of operating points */
+    size_t opp_count;
+};
+
+static struct {
+    /* Module configuration */
+    const struct mod_avs_config *config;
+
+    /* Table of domain contexts */
+    struct domain_ctx *domain_ctx_table;
+
+    /* Number of domains */
+    unsigned int domain_count;
+
+    /* Alarm API, NULL if the domains are only calibrated at start */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* DVFS domain API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+} ctx;
+
+/*
+ * Static functions
+ */
+
+/*
+ * Find the lowest voltage at which an operating point is stable, within the
+ * maximum trim, and add the guard margin to it.
+ */
+static int calibrate_opp(const struct domain_ctx *domain_ctx,
+                         const struct mod_dvfs_opp *opp, uint64_t *voltage)
+{
+    const struct mod_avs_domain_config *config = domain_ctx->config;
+    uint64_t lowest_voltage;
+    uint64_t stable_voltage;
+    bool stable;
+    int status;
+
+    lowest_voltage = opp->voltage -
+        FWK_MIN((uint64_t)config->max_trim, opp->voltage - 1);
+
+    stable_voltage = opp->voltage;
+    while ((stable_voltage - lowest_voltage) >= config->step) {
+        status = domain_ctx->monitor_api->check(config->monitor_id,
+            opp->frequency, stable_voltage - config->step, &stable);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (!stable)
+            break;
+
+        stable_voltage -= config->step;
+    }
+
+    *voltage = FWK_MIN(stable_voltage + config->margin, opp->voltage);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * The calibration of a domain stops at the first failure, for instance while
+ * the domain is in transition. The operating points calibrated so far keep
+ * their new voltages, the others are calibrated at the next period.
+ */
+static int calibrate_domain(const struct domain_ctx *domain_ctx)
+{
+    uint64_t voltage;
+    size_t opp_idx;
+    int status;
+
+    for (opp_idx = 0; opp_idx < domain_ctx->opp_count; opp_idx++) {
+        status = calibrate_opp(domain_ctx, &domain_ctx->opp_table[opp_idx],
+                               &voltage);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = ctx.dvfs_api->set_opp_voltage(
+            domain_ctx->config->dvfs_domain_id, opp_idx, voltage);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static void calibrate_domains(void)
+{
+    unsigned int domain_idx;
+
+    for (domain_idx = 0; domain_idx < ctx.domain_count; domain_idx++)
+        calibrate_domain(&ctx.domain_ctx_table[domain_idx]);
+}
+
+/*
+ * Framework handlers
+ */
+
+static int avs_init(fwk_id_t module_id, unsigned int element_count,
+                    const void *data)
+{
+    const struct mod_avs_config *config = data;
+
+    if ((element_count == 0) || (config == NULL))
+        return FWK_E_DATA;
+
+    if (fwk_id_is_type(config->alarm_id, FWK_ID_TYPE_SUB_ELEMENT) &&
+        (config->period_ms == 0))
+        return FWK_E_DATA;
+
+    ctx.domain_ctx_table = fwk_mm_calloc(element_count,
+                                         sizeof(ctx.domain_ctx_table[0]));
+    if (ctx.domain_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    ctx.domain_count = element_count;
+    ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int avs_element_init(fwk_id_t element_id,
+                            unsigned int sub_element_count,
+                            const void *data)
+{
+    const struct mod_avs_domain_config *config = data;
+
+    if ((config == NULL) || (config->step == 0))
+        return FWK_E_DATA;
+
+    ctx.domain_ctx_table[fwk_id_get_element_idx(element_id)].config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int avs_bind(fwk_id_t id, unsigned int round)
+{
+    struct domain_ctx *domain_ctx;
+    int status;
+
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        domain_ctx = &ctx.domain_ctx_table[fwk_id_get_element_idx(id)];
+
+        return fwk_module_bind(domain_ctx->config->monitor_id,
+                               domain_ctx->config->monitor_api_id,
+                               &domain_ctx->monitor_api);
+    }
+
+    if (fwk_id_is_type(ctx.config->alarm_id, FWK_ID_TYPE_SUB_ELEMENT)) {
+        status = fwk_module_bind(ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                                 &ctx.alarm_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+                           mod_dvfs_api_id_dvfs, &ctx.dvfs_api);
+}
+
+static int avs_start_domain(struct domain_ctx *domain_ctx)
+{
+    fwk_id_t dvfs_domain_id = domain_ctx->config->dvfs_domain_id;
+    size_t opp_idx;
+    int status;
+
+    status = ctx.dvfs_api->get_opp_count(dvfs_domain_id,
+                                         &domain_ctx->opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    domain_ctx->opp_table = fwk_mm_calloc(domain_ctx->opp_count,
+                                          sizeof(domain_ctx->opp_table[0]));
+    if (domain_ctx->opp_table == NULL)
+        return FWK_E_NOMEM;
+
+    /* No voltage has been trimmed yet, these are the nominal voltages */
+    for (opp_idx = 0; opp_idx < domain_ctx->opp_count; opp_idx++) {
+        status = ctx.dvfs_api->get_nth_opp(dvfs_domain_id, opp_idx,
+                                           &domain_ctx->opp_table[opp_idx]);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int avs_start(fwk_id_t id)
+{
+    struct fwk_event event;
+    int status;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        return avs_start_domain(
+            &ctx.domain_ctx_table[fwk_id_get_element_idx(id)]);
+    }
+
+    /* The domains are calibrated once all the modules have started */
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_AVS, MOD_AVS_EVENT_IDX_CALIBRATE),
+        .source_id = id,
+        .target_id = id,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (ctx.alarm_api == NULL)
+        return FWK_SUCCESS;
+
+    return ctx.alarm_api->start(ctx.config->alarm_id, ctx.config->period_ms,
+                                MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+static int avs_process_event(const struct fwk_event *event,
+                             struct fwk_event *resp_event)
+{
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm) ||
+        fwk_id_is_equal(event->id,
+                        FWK_ID_EVENT(FWK_MODULE_IDX_AVS,
+                                     MOD_AVS_EVENT_IDX_CALIBRATE))) {
+        calibrate_domains();
+
+        return FWK_SUCCESS;
+    }
+
+    return FWK_E_PARAM;
+}
+
+const struct fwk_module module_avs = {
+    .name = "AVS",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = MOD_AVS_EVENT_IDX_COUNT,
+    .init = avs_init,
+    .element_init = avs_element_init,
+    .bind = avs_bind,
+    .start = avs_start,
+    .process_event = avs_process_event,
+};
@@ -8,8 +8,12 @@
 #ifndef MOD_BOOTLOADER_H
 #define MOD_BOOTLOADER_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \addtogroup GroupModules Modules
@@ -58,6 +62,69 @@ struct mod_bootloader_config {
      * size of the image and its offset from source_base.
      */
     uint32_t sds_struct_id;
+
+    /*!
+     * \brief Size in bytes of the chunks the image is copied in.
+     *
+     * \details The checksum of each chunk is computed right after its copy,
+     *      while the chunk is still in the caches. Zero copies the image in
+     *      one chunk.
+     */
+    size_t chunk_size;
+
+    /*!
+     * \brief Verify the image against a CRC-32 checksum.
+     *
+     * \details When true, the SDS structure holds, after the image size, the
+     *      CRC-32 (IEEE 802.3) checksum of the image written by the
+     *      application processor firmware.
+     */
+    bool verify_checksum;
+
+    /*!
+     * \brief Identifier of the copy driver, typically a DMA engine.
+     *
+     * \details FWK_ID_NONE to copy the image with the processor.
+     */
+    fwk_id_t copy_driver_id;
+
+    /*! Identifier of the copy driver API, see \ref mod_bootloader_copy_api */
+    fwk_id_t copy_driver_api_id;
+
+    /*!
+     * \brief Identifier of the timer used to sleep in between the reads of the
+     *      SDS structure while waiting for the image.
+     *
+     * \details FWK_ID_NONE to poll continuously. Only used when the firmware
+     *      includes the timer module.
+     */
+    fwk_id_t timer_id;
+
+    /*! Time to sleep in between two reads of the SDS structure, in us */
+    uint32_t poll_interval_us;
+};
+
+/*!
+ * \brief Copy driver interface.
+ *
+ * \details Interface of a driver copying memory on behalf of the bootloader,
+ *      for instance with a DMA engine.
+ */
+struct mod_bootloader_copy_api {
+    /*!
+     * \brief Copy a memory area and wait for the copy to complete.
+     *
+     * \param driver_id Identifier of the driver.
+     * \param destination Base address of the destination area.
+     * \param source Base address of the source area.
+     * \param size Size in bytes of the area to copy.
+     *
+     * \retval FWK_SUCCESS The area was copied.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*copy)(fwk_id_t driver_id, uintptr_t destination, uintptr_t source,
+                size_t size);
 };
 
 /*!
@@ -68,6 +135,10 @@ struct mod_bootloader_api {
      * \brief Copy a RAM Firmware image from a source location to a destination
      *      (which is expected to be the SCP SRAM).
      *
+     * \details A compressed image (see \ref fwk_lz4_image_header) is
+     *      decompressed into the destination by the processor, the copy driver
+     *      and the chunks are only used for uncompressed images.
+     *
      * \param config Pointer to an scp_bootloader_config structure containing
      *      settings that control where the image is copied from and to.
      *
@@ -87,6 +158,53 @@ struct mod_bootloader_api {
      *      area.
      */
     int (*load_image)(void);
+
+    /*!
+     * \brief Load the RAM Firmware image once its metadata is valid, without
+     *      waiting for it.
+     *
+     * \details The image is loaded right away if the application processor
+     *      firmware has already set the data valid flag of the SDS structure.
+     *      Otherwise, it is loaded when the SDS module notifies the update of
+     *      the structure, which must then be watched (see
+     *      \ref mod_sds_structure_desc). In both cases, the result of the load
+     *      is returned to the caller in the response to the
+     *      \ref mod_bootloader_event_id_load_image event, one of the return
+     *      codes of load_image() or FWK_E_BUSY if a load is already pending.
+     *
+     * \note The function must be called while processing an event or a
+     *      notification, the response being sent to the module or element
+     *      which processes it.
+     *
+     * \retval FWK_SUCCESS The load is requested.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*load_image_async)(void);
+};
+
+/*!
+ * \brief Event indices.
+ */
+enum mod_bootloader_event_idx {
+    /*! Load the image once its metadata is valid */
+    MOD_BOOTLOADER_EVENT_IDX_LOAD_IMAGE,
+
+    /*! Number of defined events */
+    MOD_BOOTLOADER_EVENT_IDX_COUNT,
+};
+
+/*! Identifier of the image load event */
+static const fwk_id_t mod_bootloader_event_id_load_image =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_BOOTLOADER,
+                      MOD_BOOTLOADER_EVENT_IDX_LOAD_IMAGE);
+
+/*!
+ * \brief Parameters of the response to the image load event.
+ */
+struct mod_bootloader_load_image_resp_params {
+    /*! Status of the load */
+    int status;
 };
 
 /*!
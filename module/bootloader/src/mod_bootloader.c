@@ -5,22 +5,43 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
-#include <string.h>
 #include <fwk_element.h>
 #include <fwk_errno.h>
+#include <fwk_event.h>
 #include <fwk_id.h>
+#include <fwk_lz4.h>
+#include <fwk_mem.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <mod_bootloader.h>
 #include <mod_sds.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 
-/* Offset within the SDS structure where the valid flag is located. */
-#define BOOTLOADER_STRUCT_VALID_POS           0
-/* Offset within the SDS structure where the image offset is located. */
-#define BOOTLOADER_STRUCT_IMAGE_OFFSET_POS    4
-/* Offset within the SDS structure where the image size is located. */
-#define BOOTLOADER_STRUCT_IMAGE_SIZE_POS      8
+/* Layout of the SDS structure holding the image metadata */
+struct bootloader_struct {
+    /* Flags, with the valid flag */
+    uint32_t image_flags;
+
+    /* Offset of the image from the source base */
+    uint32_t image_offset;
+
+    /* Size of the image */
+    uint32_t image_size;
+
+    /* CRC-32 checksum of the image, when verified */
+    uint32_t image_checksum;
+};
+
+/* Size of the SDS structure when the image checksum is not verified */
+#define BOOTLOADER_STRUCT_SIZE_MIN \
+    offsetof(struct bootloader_struct, image_checksum)
 
 #define IMAGE_FLAGS_VALID_MASK 0x1
 
@@ -28,21 +49,120 @@
 struct bootloader_ctx {
     const struct mod_bootloader_config *module_config;
     const struct mod_sds_api *sds_api;
+    const struct mod_bootloader_copy_api *copy_api;
+    #if BUILD_HAS_MOD_TIMER
+    const struct mod_timer_api *timer_api;
+    #endif
+
+    /* An asynchronous load waits for the update of the SDS structure */
+    bool load_pending;
+
+    /* Identifier of the entity which requested the pending load */
+    fwk_id_t load_requester_id;
 };
 
 static struct bootloader_ctx module_ctx;
 
 /*
- * Module API
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320), processed four bits at
+ * a time to keep the table small.
  */
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static const uint32_t crc32_table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
 
-static int load_image(void)
+    while (size-- > 0) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ crc32_table[crc & 0xF];
+        crc = (crc >> 4) ^ crc32_table[crc & 0xF];
+    }
+
+    return crc;
+}
+
+/*
+ * Wait until Trusted Firmware writes the image metadata and sets the data
+ * valid flag, sleeping in between the reads when a timer is available.
+ */
+static int wait_image(const volatile struct bootloader_struct *sds_struct)
 {
+    #if BUILD_HAS_MOD_TIMER
     int status;
-    void *image_base;
-    uint32_t image_flags;
-    uint32_t image_offset;
-    uint32_t image_size;
+    #endif
+
+    while (true) {
+        if (sds_struct->image_flags & IMAGE_FLAGS_VALID_MASK)
+            return FWK_SUCCESS;
+
+        #if BUILD_HAS_MOD_TIMER
+        if (module_ctx.timer_api != NULL) {
+            status = module_ctx.timer_api->delay_sleep(
+                module_ctx.module_config->timer_id,
+                module_ctx.module_config->poll_interval_us);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+        #endif
+    }
+}
+
+/*
+ * Copy the image chunk by chunk, updating the checksum over each chunk right
+ * after it has been copied.
+ */
+static int copy_image(uintptr_t destination, uintptr_t source, size_t size,
+                      uint32_t *crc)
+{
+    int status;
+    size_t chunk_size = module_ctx.module_config->chunk_size;
+    size_t copied_size;
+
+    if (chunk_size == 0)
+        chunk_size = size;
+
+    *crc = UINT32_MAX;
+
+    while (size > 0) {
+        copied_size = (size < chunk_size) ? size : chunk_size;
+
+        if (module_ctx.copy_api != NULL) {
+            status = module_ctx.copy_api->copy(
+                module_ctx.module_config->copy_driver_id, destination, source,
+                copied_size);
+            if (status != FWK_SUCCESS)
+                return status;
+        } else
+            fwk_mem_copy((void *)destination, (const void *)source,
+                         copied_size);
+
+        if (module_ctx.module_config->verify_checksum)
+            *crc = crc32_update(*crc, (const uint8_t *)destination, copied_size);
+
+        destination += copied_size;
+        source += copied_size;
+        size -= copied_size;
+    }
+
+    *crc = ~*crc;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Validate the configuration and look up the SDS structure holding the image
+ * metadata.
+ */
+static int get_image_struct(
+    const volatile struct bootloader_struct **sds_struct)
+{
+    int status;
+    const volatile void *sds_struct_base;
+    size_t sds_struct_size;
 
     if (module_ctx.module_config->source_base == 0)
         return FWK_E_PARAM;
@@ -55,35 +175,35 @@ static int load_image(void)
     if (module_ctx.module_config->sds_struct_id == 0)
         return FWK_E_PARAM;
 
-    /*
-     * Wait until Trusted Firmware writes the image metadata and sets the
-     * data valid flag.
-     */
-    while (true) {
-        status = module_ctx.sds_api->struct_read(
-            module_ctx.module_config->sds_struct_id,
-            BOOTLOADER_STRUCT_VALID_POS, &image_flags, sizeof(image_flags));
+    /* The structure is looked up once, its fields are then read directly */
+    status = module_ctx.sds_api->struct_get(
+        module_ctx.module_config->sds_struct_id, &sds_struct_base,
+        &sds_struct_size);
+    if (status != FWK_SUCCESS)
+        return status;
 
-        if (status != FWK_SUCCESS)
-            return status;
-        if (image_flags & IMAGE_FLAGS_VALID_MASK)
-            break;
-    }
+    if (sds_struct_size < (module_ctx.module_config->verify_checksum ?
+                           sizeof(**sds_struct) : BOOTLOADER_STRUCT_SIZE_MIN))
+        return FWK_E_SIZE;
 
-    /* The image metadata from Trusted Firmware can now be read and validated */
-    status = module_ctx.sds_api->struct_read(
-        module_ctx.module_config->sds_struct_id,
-        BOOTLOADER_STRUCT_IMAGE_OFFSET_POS, &image_offset,
-        sizeof(image_offset));
+    *sds_struct = sds_struct_base;
 
-    if (status != FWK_SUCCESS)
-        return status;
-    status = module_ctx.sds_api->struct_read(
-        module_ctx.module_config->sds_struct_id,
-        BOOTLOADER_STRUCT_IMAGE_SIZE_POS, &image_size, sizeof(image_size));
+    return FWK_SUCCESS;
+}
 
-    if (status != FWK_SUCCESS)
-        return status;
+/* Load the image once Trusted Firmware has set the data valid flag */
+static int load_valid_image(const volatile struct bootloader_struct *sds_struct)
+{
+    int status;
+    uintptr_t image_base;
+    uint32_t image_offset;
+    uint32_t image_size;
+    uint32_t crc = 0;
+    size_t size;
+
+    /* The image metadata from Trusted Firmware can now be read and validated */
+    image_offset = sds_struct->image_offset;
+    image_size = sds_struct->image_size;
 
     if (image_size == 0)
         return FWK_E_SIZE;
@@ -91,19 +211,81 @@ static int load_image(void)
         return FWK_E_ALIGN;
     if (image_offset > module_ctx.module_config->source_size)
         return FWK_E_SIZE;
+    if (image_size > (module_ctx.module_config->source_size - image_offset))
+        return FWK_E_SIZE;
 
-    /* Read the image header now that its base address is known */
-    image_base = (void *)((uint8_t *)module_ctx.module_config->source_base +
-                          image_offset);
+    image_base = module_ctx.module_config->source_base + image_offset;
 
-    memcpy((void *)module_ctx.module_config->destination_base, image_base,
-           image_size);
+    if ((image_size >= sizeof(struct fwk_lz4_image_header)) &&
+        (((const struct fwk_lz4_image_header *)image_base)->signature ==
+         FWK_LZ4_IMAGE_SIGNATURE)) {
+        /*
+         * A compressed image is decompressed by the processor. Its checksum
+         * is the one of the compressed image.
+         */
+        status = fwk_lz4_load_image(
+            (void *)module_ctx.module_config->destination_base,
+            module_ctx.module_config->destination_size,
+            (const void *)image_base, image_size, &size);
+        if (status == FWK_E_NOMEM)
+            return FWK_E_SIZE;
+        if (status != FWK_SUCCESS)
+            return status;
 
-    return FWK_SUCCESS;
+        if (module_ctx.module_config->verify_checksum) {
+            crc = ~crc32_update(UINT32_MAX, (const uint8_t *)image_base,
+                                image_size);
+        }
+    } else {
+        if (image_size > module_ctx.module_config->destination_size)
+            return FWK_E_SIZE;
+
+        status = copy_image(module_ctx.module_config->destination_base,
+                            image_base, image_size, &crc);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (!module_ctx.module_config->verify_checksum)
+        return FWK_SUCCESS;
+
+    return (crc == sds_struct->image_checksum) ? FWK_SUCCESS : FWK_E_DATA;
+}
+
+/*
+ * Module API
+ */
+
+static int load_image(void)
+{
+    int status;
+    const volatile struct bootloader_struct *sds_struct;
+
+    status = get_image_struct(&sds_struct);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = wait_image(sds_struct);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return load_valid_image(sds_struct);
+}
+
+static int load_image_async(void)
+{
+    struct fwk_event event = {
+        .id = mod_bootloader_event_id_load_image,
+        .target_id = fwk_module_id_bootloader,
+        .response_requested = true,
+    };
+
+    return fwk_thread_put_event(&event);
 }
 
 static const struct mod_bootloader_api bootloader_api = {
     .load_image = load_image,
+    .load_image_async = load_image_async,
 };
 
 /*
@@ -134,8 +316,30 @@ static int bootloader_bind(fwk_id_t id, unsigned int call_number)
     status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SDS),
                              FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
                              &module_ctx.sds_api);
+    if (status != FWK_SUCCESS)
+        return status;
 
-    return status;
+    if (!fwk_id_is_type(module_ctx.module_config->copy_driver_id,
+                        FWK_ID_TYPE_NONE)) {
+        status = fwk_module_bind(module_ctx.module_config->copy_driver_id,
+                                 module_ctx.module_config->copy_driver_api_id,
+                                 &module_ctx.copy_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    #if BUILD_HAS_MOD_TIMER
+    if (!fwk_id_is_type(module_ctx.module_config->timer_id,
+                        FWK_ID_TYPE_NONE)) {
+        status = fwk_module_bind(module_ctx.module_config->timer_id,
+                                 MOD_TIMER_API_ID_TIMER,
+                                 &module_ctx.timer_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+    #endif
+
+    return FWK_SUCCESS;
 }
 
 static int bootloader_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
@@ -151,12 +355,110 @@ static int bootloader_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
     return FWK_SUCCESS;
 }
 
+static int bootloader_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp_event)
+{
+    int status;
+    const volatile struct bootloader_struct *sds_struct;
+    struct mod_bootloader_load_image_resp_params *resp_params =
+        (void *)resp_event->params;
+
+    if (!fwk_id_is_equal(event->id, mod_bootloader_event_id_load_image))
+        return FWK_E_PARAM;
+
+    if (module_ctx.load_pending) {
+        resp_params->status = FWK_E_BUSY;
+
+        return FWK_SUCCESS;
+    }
+
+    status = get_image_struct(&sds_struct);
+    if (status != FWK_SUCCESS) {
+        resp_params->status = status;
+
+        return FWK_SUCCESS;
+    }
+
+    if (sds_struct->image_flags & IMAGE_FLAGS_VALID_MASK) {
+        resp_params->status = load_valid_image(sds_struct);
+
+        return FWK_SUCCESS;
+    }
+
+    /* The image is loaded once Trusted Firmware updates the SDS structure */
+    status = fwk_notification_subscribe(
+        mod_sds_notification_id_structure_updated,
+        fwk_module_id_sds,
+        fwk_module_id_bootloader);
+    if (status != FWK_SUCCESS) {
+        resp_params->status = status;
+
+        return FWK_SUCCESS;
+    }
+
+    module_ctx.load_pending = true;
+    module_ctx.load_requester_id = event->source_id;
+    resp_event->is_delayed_response = true;
+
+    return FWK_SUCCESS;
+}
+
+static int bootloader_process_notification(const struct fwk_event *event,
+                                           struct fwk_event *resp_event)
+{
+    int status;
+    const volatile struct bootloader_struct *sds_struct;
+    const struct mod_sds_notification_params_structure_updated *params =
+        (const void *)event->params;
+    struct mod_bootloader_load_image_resp_params *resp_params;
+    struct fwk_event response;
+
+    if (!fwk_id_is_equal(event->id,
+                         mod_sds_notification_id_structure_updated))
+        return FWK_E_PARAM;
+
+    if (!module_ctx.load_pending ||
+        (params->structure_id != module_ctx.module_config->sds_struct_id))
+        return FWK_SUCCESS;
+
+    status = get_image_struct(&sds_struct);
+    if ((status == FWK_SUCCESS) &&
+        !(sds_struct->image_flags & IMAGE_FLAGS_VALID_MASK))
+        return FWK_SUCCESS;
+
+    if (status == FWK_SUCCESS)
+        status = load_valid_image(sds_struct);
+
+    module_ctx.load_pending = false;
+
+    response = (struct fwk_event) {
+        .id = mod_bootloader_event_id_load_image,
+        .target_id = module_ctx.load_requester_id,
+        .is_response = true,
+        .is_delayed_response = true,
+    };
+
+    resp_params = (void *)response.params;
+    resp_params->status = status;
+
+    status = fwk_notification_unsubscribe(
+        mod_sds_notification_id_structure_updated,
+        fwk_module_id_sds,
+        fwk_module_id_bootloader);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_thread_put_event(&response);
+}
+
 const struct fwk_module module_bootloader = {
     .name = "Bootloader",
     .type = FWK_MODULE_TYPE_SERVICE,
     .api_count = 1,
-    .event_count = 0,
+    .event_count = MOD_BOOTLOADER_EVENT_IDX_COUNT,
     .init = bootloader_init,
     .bind = bootloader_bind,
     .process_bind_request = bootloader_process_bind_request,
+    .process_event = bootloader_process_event,
+    .process_notification = bootloader_process_notification,
 };
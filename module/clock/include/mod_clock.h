@@ -98,12 +98,49 @@ struct clock_state_change_pending_resp_params {
     int status;
 };
 
+/*!
+ * \brief Clock event indices.
+ */
+enum mod_clock_event_idx {
+    /*!
+     * Request completed asynchronously by the driver of a clock. The response
+     * to the event, with \ref mod_clock_resp_params parameters, is sent to
+     * the entity whose request returned \ref FWK_PENDING on completion of the
+     * request.
+     */
+    MOD_CLOCK_EVENT_IDX_REQUEST,
+
+    /*! Number of defined events */
+    MOD_CLOCK_EVENT_IDX_COUNT
+};
+
+#if BUILD_HAS_MOD_CLOCK
+/*!
+ * \brief Identifier for the \ref MOD_CLOCK_EVENT_IDX_REQUEST event.
+ */
+static const fwk_id_t mod_clock_event_id_request =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_CLOCK, MOD_CLOCK_EVENT_IDX_REQUEST);
+#endif
+
+/*!
+ * \brief Parameters of the response to the \ref MOD_CLOCK_EVENT_IDX_REQUEST
+ *     event.
+ */
+struct mod_clock_resp_params {
+    /*! Status of the request */
+    int status;
+};
+
 /*!
  * \brief APIs that the module makes available to entities requesting binding.
  */
 enum mod_clock_api_type {
     /*! Clock HAL */
     MOD_CLOCK_API_TYPE_HAL,
+
+    /*! Clock driver response, see \ref mod_clock_drv_response_api */
+    MOD_CLOCK_API_TYPE_DRIVER_RESPONSE,
+
     MOD_CLOCK_API_COUNT,
 };
 
@@ -182,8 +219,24 @@ struct mod_clock_dev_config {
      *     when the clock's power domain changes state, then this identifier
      *     must be FWK_ID_NONE. In this case the clock will not be registered
      *     to receive notifications from the power domain module.
+     *
+     *     The clocks with the same source are grouped: the notifications of
+     *     the power domain are received once for the group, the transitions
+     *     of the drivers of the clocks are processed in a row, and a single
+     *     response is sent to the power domain module.
      */
     fwk_id_t pd_source_id;
+
+    /*!
+     * \brief Reference to the clock element the clock is derived from.
+     *
+     * \details The parent links describe the clock tree. When the rate or
+     *     the state of a clock changes, the rates of the clocks derived from
+     *     it are recalculated. If the clock is the root of a clock tree or is
+     *     independent of the other clocks, then this identifier must be
+     *     FWK_ID_NONE.
+     */
+    fwk_id_t parent_id;
 };
 
 /*!
@@ -249,6 +302,10 @@ struct mod_clock_drv_api {
      *      achieve the given rate.
      *
      * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_PENDING The rate change has been initiated and the driver
+     *      reports its completion through the
+     *      \ref mod_clock_drv_response_api::request_complete function. Only
+     *      allowed for the clocks bound to the driver by the clock HAL.
      * \return One of the standard framework error codes.
      */
     int (*set_rate)(fwk_id_t clock_id, uint64_t rate,
@@ -281,6 +338,29 @@ struct mod_clock_drv_api {
     int (*get_rate_from_index)(fwk_id_t clock_id, unsigned int rate_index,
                                uint64_t *rate);
 
+    /*!
+     * \brief Get a series of consecutive clock rates in Hertz from the clock's
+     *     range.
+     *
+     * \note This function is optional. If the driver does not provide it then
+     *     the HAL retrieves the rates one at a time through
+     *     \ref get_rate_from_index and the pointer may be set to NULL.
+     *
+     * \param clock_id Clock device identifier.
+     *
+     * \param start_index The index into the clock's range of the first rate.
+     *
+     * \param count The number of rates to get.
+     *
+     * \param[out] rates The rates, in Hertz, corresponding to the indices
+     *     \p start_index to \p start_index + \p count - 1.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_rates)(fwk_id_t clock_id, unsigned int start_index,
+                     unsigned int count, uint64_t *rates);
+
     /*!
      * \brief Set the running state of a clock.
      *
@@ -370,6 +450,26 @@ struct mod_clock_drv_api {
     int (*process_power_transition)(fwk_id_t clock_id, unsigned int state);
 };
 
+/*!
+ * \brief Clock driver response interface.
+ *
+ * \details Interface the clock drivers use to report the completion of the
+ *      requests they completed asynchronously.
+ */
+struct mod_clock_drv_response_api {
+    /*!
+     * \brief Report the completion of a request of the clock HAL for which the
+     *      driver returned \ref FWK_PENDING.
+     *
+     * \note May be called from an interrupt service routine.
+     *
+     * \param clock_id Clock HAL element identifier of the clock.
+     *
+     * \param status Status of the request.
+     */
+    void (*request_complete)(fwk_id_t clock_id, int status);
+};
+
 /*!
  * \brief Clock interface.
  */
@@ -377,6 +477,14 @@ struct mod_clock_api {
     /*!
      * \brief Set a new clock rate by providing a frequency in Hertz (Hz).
      *
+     * \note The driver is not called if the clock already runs at the
+     *      requested rate.
+     *
+     * \note When the driver completes the rate change asynchronously, the
+     *      function returns \ref FWK_PENDING and the response to the
+     *      \ref MOD_CLOCK_EVENT_IDX_REQUEST event is sent to the calling
+     *      entity on completion. A single request may be pending per clock.
+     *
      * \param clock_id Clock device identifier.
      *
      * \param rate The desired frequency in Hertz.
@@ -385,7 +493,9 @@ struct mod_clock_api {
      *      achieve the given rate.
      *
      * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_PENDING The request is completed asynchronously.
      * \retval FWK_E_PARAM The clock identifier was invalid.
+     * \retval FWK_E_BUSY A request is already pending for the clock.
      * \return One of the standard framework error codes.
      */
     int (*set_rate)(fwk_id_t clock_id, uint64_t rate,
@@ -394,6 +504,10 @@ struct mod_clock_api {
     /*!
      * \brief Get the current rate of a clock in Hertz (Hz).
      *
+     * \details The rate is cached by the module, the driver is only called
+     *      after the rate or the state of the clock has been set or its power
+     *      domain has changed state.
+     *
      * \param clock_id Clock device identifier.
      *
      * \param[out] rate The current clock rate in Hertz.
@@ -422,6 +536,27 @@ struct mod_clock_api {
     int (*get_rate_from_index)(fwk_id_t clock_id, unsigned int rate_index,
                                uint64_t *rate);
 
+    /*!
+     * \brief Get a series of consecutive clock rates in Hertz from the clock's
+     *     range.
+     *
+     * \param clock_id Clock device identifier.
+     *
+     * \param start_index The index into the clock's range of the first rate.
+     *
+     * \param count The number of rates to get.
+     *
+     * \param[out] rates The rates, in Hertz, corresponding to the indices
+     *     \p start_index to \p start_index + \p count - 1.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_E_PARAM The clock identifier was invalid.
+     * \retval FWK_E_PARAM The rates pointer was NULL.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_rates)(fwk_id_t clock_id, unsigned int start_index,
+                     unsigned int count, uint64_t *rates);
+
     /*!
      * \brief Set the running state of a clock.
      *
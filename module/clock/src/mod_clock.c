@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <fwk_assert.h>
 #include <fwk_element.h>
@@ -22,8 +23,54 @@ struct clock_dev_ctx {
     const struct mod_clock_dev_config *config;
     struct mod_clock_drv_api *api;
     unsigned int pd_pre_power_transition_notification_cookie;
-    unsigned int transition_pending_notifications_sent;
-    unsigned int transition_pending_response_status;
+
+    /* Current rate of the clock, valid only if rate_valid is true */
+    uint64_t rate;
+    bool rate_valid;
+
+    /* Clock tree links, NULL when there is no such clock */
+    struct clock_dev_ctx *parent;
+    struct clock_dev_ctx *first_child;
+    struct clock_dev_ctx *next_sibling;
+
+    /* Request completed asynchronously by the driver */
+    struct {
+        /* The driver is processing a request */
+        bool pending;
+
+        /* The response to the request event has been delayed */
+        bool delayed;
+
+        /* The driver completed the request before the request event */
+        bool completed;
+
+        /* Status reported by the driver on completion */
+        int status;
+
+        /* Cookie of the request event */
+        uint32_t cookie;
+    } request;
+
+    /*
+     * Group of the clocks of the same power domain, whose notifications are
+     * processed by the first clock of the group, its leader.
+     */
+    struct {
+        /* Leader of the group, NULL for a clock without power domain */
+        struct clock_dev_ctx *leader;
+
+        /* Next clock of the group, NULL for the last one */
+        struct clock_dev_ctx *next;
+
+        /*
+         * Number of clocks of the group whose subscribers have not all
+         * responded to the pending state change notification (leader only)
+         */
+        unsigned int pending_count;
+
+        /* First veto of the pending state change, if any (leader only) */
+        int status;
+    } group;
 };
 
 /* Module context */
@@ -35,6 +82,256 @@ struct clock_ctx {
 
 struct clock_ctx module_ctx;
 
+/* Events internal to the module, following the public ones */
+enum clock_event_idx {
+    CLOCK_EVENT_IDX_REQUEST_COMPLETE = MOD_CLOCK_EVENT_IDX_COUNT,
+    CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGED,
+    CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGE_PENDING,
+    CLOCK_EVENT_IDX_COUNT
+};
+
+/* Number of events queued at once for the clocks of a group */
+#define CLOCK_GROUP_EVENT_COUNT 8
+
+/*
+ * Static helpers
+ */
+
+static fwk_id_t get_clock_id(const struct clock_dev_ctx *ctx)
+{
+    return FWK_ID_ELEMENT(FWK_MODULE_IDX_CLOCK,
+                          (unsigned int)(ctx - module_ctx.dev_ctx_table));
+}
+
+/*
+ * Get the clock following a clock in the pre-order traversal of the subtree
+ * rooted at the root clock, or NULL when the traversal is complete.
+ */
+static struct clock_dev_ctx *get_next_in_subtree(struct clock_dev_ctx *root,
+                                                 struct clock_dev_ctx *ctx)
+{
+    if (ctx->first_child != NULL)
+        return ctx->first_child;
+
+    while (ctx != root) {
+        if (ctx->next_sibling != NULL)
+            return ctx->next_sibling;
+        ctx = ctx->parent;
+    }
+
+    return NULL;
+}
+
+/*
+ * Invalidate the cached rates of a clock and of the clocks derived from it.
+ */
+static void invalidate_subtree_rates(struct clock_dev_ctx *root)
+{
+    struct clock_dev_ctx *ctx;
+
+    for (ctx = root; ctx != NULL; ctx = get_next_in_subtree(root, ctx))
+        ctx->rate_valid = false;
+}
+
+/*
+ * Recalculate the cached rates of the clocks derived from a clock once the
+ * rate of the clock has changed. A rate the driver fails to report is left
+ * invalid and is queried again by the next get_rate() call.
+ */
+static void update_subtree_rates(struct clock_dev_ctx *root)
+{
+    int status;
+    struct clock_dev_ctx *ctx;
+
+    for (ctx = get_next_in_subtree(root, root); ctx != NULL;
+         ctx = get_next_in_subtree(root, ctx)) {
+        status = ctx->api->get_rate(ctx->config->driver_id, &ctx->rate);
+        ctx->rate_valid = (status == FWK_SUCCESS);
+    }
+}
+
+/*
+ * Queue the event whose response is sent to the caller on completion of a
+ * request the driver completes asynchronously.
+ */
+static int create_async_request(struct clock_dev_ctx *ctx, fwk_id_t clock_id)
+{
+    int status;
+    struct fwk_event request_event = {
+        .target_id = clock_id,
+        .id = mod_clock_event_id_request,
+        .response_requested = true,
+    };
+
+    ctx->request.pending = true;
+
+    status = fwk_thread_put_event(&request_event);
+    if (status != FWK_SUCCESS) {
+        ctx->request.pending = false;
+        return status;
+    }
+
+    return FWK_PENDING;
+}
+
+/*
+ * Check whether a clock takes part in the pre-transition (pending) or
+ * transition notifications of its power domain: its driver must handle them
+ * and the module must be configured for them.
+ */
+static bool is_pd_notified(const struct clock_dev_ctx *ctx, bool pending)
+{
+    if (pending) {
+        return (ctx->api->process_pending_power_transition != NULL) &&
+            fwk_id_is_type(
+                module_ctx.config->pd_pre_transition_notification_id,
+                FWK_ID_TYPE_NOTIFICATION);
+    }
+
+    return (ctx->api->process_power_transition != NULL) &&
+        fwk_id_is_type(module_ctx.config->pd_transition_notification_id,
+                       FWK_ID_TYPE_NOTIFICATION);
+}
+
+/*
+ * Get the state of the clocks of a power domain in a given power state.
+ *
+ * For now it is sufficient to assume that a PD ON state implies that the clock
+ * is running and any other state implies that the clock has stopped. This will
+ * likely need to be revisited so that the clock driver can influence the
+ * resulting state that is propagated via the outgoing notification.
+ */
+static enum mod_clock_state get_pd_clock_state(unsigned int pd_state)
+{
+    return (pd_state == MOD_PD_STATE_ON) ? MOD_CLOCK_STATE_RUNNING :
+                                           MOD_CLOCK_STATE_STOPPED;
+}
+
+/*
+ * Queue the events notifying the subscribers of the other clocks of a group,
+ * the notifications being sent by the clocks themselves.
+ */
+static int put_group_events(struct clock_dev_ctx *leader, bool pending,
+                            enum mod_clock_state state, unsigned int *count)
+{
+    struct clock_dev_ctx *ctx;
+    struct clock_notification_params *params;
+    struct fwk_event events[CLOCK_GROUP_EVENT_COUNT];
+    unsigned int event_count = 0;
+    int status;
+
+    *count = 0;
+
+    for (ctx = leader->group.next; ctx != NULL; ctx = ctx->group.next) {
+        if (!is_pd_notified(ctx, pending))
+            continue;
+
+        events[event_count] = (struct fwk_event) {
+            .target_id = get_clock_id(ctx),
+            .id = FWK_ID_EVENT(FWK_MODULE_IDX_CLOCK, pending ?
+                CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGE_PENDING :
+                CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGED),
+        };
+        params = (struct clock_notification_params *)
+            events[event_count].params;
+        params->new_state = state;
+
+        if (++event_count < CLOCK_GROUP_EVENT_COUNT)
+            continue;
+
+        status = fwk_thread_put_events(events, event_count);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        *count += event_count;
+        event_count = 0;
+    }
+
+    if (event_count == 0)
+        return FWK_SUCCESS;
+
+    status = fwk_thread_put_events(events, event_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *count += event_count;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Notify the subscribers of the clock whose event is being processed of its
+ * pending state change. Their responses are collected by the framework, any of
+ * them can veto the transition.
+ */
+static int notify_state_change_pending(enum mod_clock_state state,
+                                       unsigned int *count)
+{
+    struct clock_notification_params *params;
+    struct fwk_event event = {
+        .response_requested = true,
+        .id = mod_clock_notification_id_state_change_pending,
+    };
+
+    params = (struct clock_notification_params *)event.params;
+    params->new_state = state;
+
+    return fwk_notification_notify_collect(&event, count);
+}
+
+/* Notify the subscribers of the clock whose event is being processed */
+static int notify_state_changed(enum mod_clock_state state)
+{
+    unsigned int count;
+    struct clock_notification_params *params;
+    struct fwk_event event = {
+        .response_requested = false,
+        .id = mod_clock_notification_id_state_changed,
+    };
+
+    params = (struct clock_notification_params *)event.params;
+    params->new_state = state;
+
+    return fwk_notification_notify(&event, &count);
+}
+
+/*
+ * Account for a clock of a group whose subscribers have all responded to the
+ * pending state change notification. Once all the clocks of the group have
+ * completed, the first veto, if any, is forwarded in the response to the power
+ * domain notification.
+ */
+static int complete_group_pre_transition(struct clock_dev_ctx *leader,
+                                         int status)
+{
+    struct mod_pd_power_state_pre_transition_notification_resp_params
+        *pd_resp_params;
+    struct fwk_event pd_response_event = {
+        .id = module_ctx.config->pd_pre_transition_notification_id,
+        .target_id = leader->config->pd_source_id,
+        .cookie = leader->pd_pre_power_transition_notification_cookie,
+        .is_notification = true,
+        .is_response = true,
+        .is_delayed_response = true,
+    };
+
+    if (!fwk_expect(leader->group.pending_count > 0))
+        return FWK_E_STATE;
+
+    if ((status != FWK_SUCCESS) && (leader->group.status == FWK_SUCCESS))
+        leader->group.status = status;
+
+    if (--leader->group.pending_count > 0)
+        return FWK_SUCCESS;
+
+    pd_resp_params =
+        (struct mod_pd_power_state_pre_transition_notification_resp_params *)
+            pd_response_event.params;
+    pd_resp_params->status = leader->group.status;
+
+    return fwk_thread_put_event(&pd_response_event);
+}
+
 /*
  * Module API functions
  */
@@ -51,7 +348,26 @@ static int clock_set_rate(fwk_id_t clock_id, uint64_t rate,
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(clock_id);
 
-    return ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
+    if (ctx->request.pending)
+        return FWK_E_BUSY;
+
+    /* Nothing to do if the clock already runs at the requested rate */
+    if (ctx->rate_valid && (ctx->rate == rate))
+        return FWK_SUCCESS;
+
+    /*
+     * The rate the driver sets may differ from the requested one because of
+     * the rounding, the cache is refilled by the next get_rate() call.
+     */
+    invalidate_subtree_rates(ctx);
+
+    status = ctx->api->set_rate(ctx->config->driver_id, rate, round_mode);
+    if (status == FWK_SUCCESS)
+        update_subtree_rates(ctx);
+    if (status != FWK_PENDING)
+        return status;
+
+    return create_async_request(ctx, clock_id);
 }
 
 static int clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
@@ -68,7 +384,19 @@ static int clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(clock_id);
 
-    return ctx->api->get_rate(ctx->config->driver_id, rate);
+    if (ctx->rate_valid) {
+        *rate = ctx->rate;
+        return FWK_SUCCESS;
+    }
+
+    status = ctx->api->get_rate(ctx->config->driver_id, rate);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->rate = *rate;
+    ctx->rate_valid = true;
+
+    return FWK_SUCCESS;
 }
 
 static int clock_get_rate_from_index(fwk_id_t clock_id, unsigned int rate_index,
@@ -90,6 +418,36 @@ static int clock_get_rate_from_index(fwk_id_t clock_id, unsigned int rate_index,
                                          rate);
 }
 
+static int clock_get_rates(fwk_id_t clock_id, unsigned int start_index,
+                           unsigned int count, uint64_t *rates)
+{
+    int status;
+    unsigned int i;
+    struct clock_dev_ctx *ctx;
+
+    status = fwk_module_check_call(clock_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (rates == NULL)
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(clock_id);
+
+    if (ctx->api->get_rates != NULL)
+        return ctx->api->get_rates(ctx->config->driver_id, start_index, count,
+                                   rates);
+
+    for (i = 0; i < count; i++) {
+        status = ctx->api->get_rate_from_index(ctx->config->driver_id,
+                                               start_index + i, &rates[i]);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
 {
     int status;
@@ -101,6 +459,8 @@ static int clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(clock_id);
 
+    invalidate_subtree_rates(ctx);
+
     return ctx->api->set_state(ctx->config->driver_id, state);
 }
 
@@ -148,11 +508,41 @@ static const struct mod_clock_api clock_api = {
     .set_rate = clock_set_rate,
     .get_rate = clock_get_rate,
     .get_rate_from_index = clock_get_rate_from_index,
+    .get_rates = clock_get_rates,
     .set_state = clock_set_state,
     .get_state = clock_get_state,
     .get_info = clock_get_info,
 };
 
+/*
+ * Driver response API functions
+ */
+
+static void clock_request_complete(fwk_id_t clock_id, int status)
+{
+    int put_status;
+    struct fwk_event event;
+    struct mod_clock_resp_params *params =
+        (struct mod_clock_resp_params *)event.params;
+
+    /* The completion is processed from the event handler of the module */
+    event = (struct fwk_event) {
+        .source_id = clock_id,
+        .target_id = clock_id,
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_CLOCK,
+                           CLOCK_EVENT_IDX_REQUEST_COMPLETE),
+    };
+    params->status = status;
+
+    put_status = fwk_thread_put_event(&event);
+    assert(put_status == FWK_SUCCESS);
+    (void)put_status;
+}
+
+static const struct mod_clock_drv_response_api clock_drv_response_api = {
+    .request_complete = clock_request_complete,
+};
+
 /*
  * Framework handler functions
  */
@@ -182,12 +572,39 @@ static int clock_init(fwk_id_t module_id, unsigned int element_count,
 static int clock_dev_init(fwk_id_t element_id, unsigned int sub_element_count,
                           const void *data)
 {
-    struct clock_dev_ctx *ctx;
+    struct clock_dev_ctx *ctx, *parent, *ancestor;
     const struct mod_clock_dev_config *dev_config = data;
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
     ctx->config = dev_config;
 
+    if (fwk_id_is_type(dev_config->parent_id, FWK_ID_TYPE_NONE))
+        return FWK_SUCCESS;
+
+    /* The parent must be another clock of the module */
+    if (!fwk_id_is_type(dev_config->parent_id, FWK_ID_TYPE_ELEMENT) ||
+        (fwk_id_get_module_idx(dev_config->parent_id) !=
+         fwk_id_get_module_idx(element_id)) ||
+        (fwk_id_get_element_idx(dev_config->parent_id) >=
+         module_ctx.dev_count))
+        return FWK_E_DATA;
+
+    parent = module_ctx.dev_ctx_table +
+        fwk_id_get_element_idx(dev_config->parent_id);
+
+    /*
+     * Reject the links closing a loop. A loop is detected when the link of
+     * its last clock is added, as the links of the other clocks exist then.
+     */
+    for (ancestor = parent; ancestor != NULL; ancestor = ancestor->parent) {
+        if (ancestor == ctx)
+            return FWK_E_DATA;
+    }
+
+    ctx->parent = parent;
+    ctx->next_sibling = parent->first_child;
+    parent->first_child = ctx;
+
     return FWK_SUCCESS;
 }
 
@@ -214,6 +631,10 @@ static int clock_start(fwk_id_t id)
 {
     int status;
     struct clock_dev_ctx *ctx;
+    struct clock_dev_ctx *member;
+    struct clock_dev_ctx *last;
+    bool notified = false;
+    bool pending_notified = false;
 
     /* Nothing to be done at the module level */
     if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
@@ -224,10 +645,36 @@ static int clock_start(fwk_id_t id)
     if (fwk_id_is_type(ctx->config->pd_source_id, FWK_ID_TYPE_NONE))
          return FWK_SUCCESS;
 
-    if ((ctx->api->process_power_transition != NULL) &&
-        (fwk_id_is_type(
-            module_ctx.config->pd_transition_notification_id,
-            FWK_ID_TYPE_NOTIFICATION))) {
+    /* The clock has been added to the group of a clock started before it */
+    if (ctx->group.leader != NULL)
+        return FWK_SUCCESS;
+
+    /*
+     * The first clock of a power domain to start leads the group of the clocks
+     * of the domain. It is the only one to subscribe to the notifications of
+     * the domain.
+     */
+    ctx->group.leader = ctx;
+    last = ctx;
+    for (member = module_ctx.dev_ctx_table;
+         member < (module_ctx.dev_ctx_table + module_ctx.dev_count);
+         member++) {
+        if ((member == ctx) ||
+            !fwk_id_is_equal(member->config->pd_source_id,
+                             ctx->config->pd_source_id))
+            continue;
+
+        member->group.leader = ctx;
+        last->group.next = member;
+        last = member;
+    }
+
+    for (member = ctx; member != NULL; member = member->group.next) {
+        notified = notified || is_pd_notified(member, false);
+        pending_notified = pending_notified || is_pd_notified(member, true);
+    }
+
+    if (notified) {
         status = fwk_notification_subscribe(
             module_ctx.config->pd_transition_notification_id,
             ctx->config->pd_source_id,
@@ -236,10 +683,7 @@ static int clock_start(fwk_id_t id)
             return status;
     }
 
-    if ((ctx->api->process_pending_power_transition != NULL) &&
-        (fwk_id_is_type(
-            module_ctx.config->pd_pre_transition_notification_id,
-            FWK_ID_TYPE_NOTIFICATION))) {
+    if (pending_notified) {
         status = fwk_notification_subscribe(
             module_ctx.config->pd_pre_transition_notification_id,
             ctx->config->pd_source_id,
@@ -254,28 +698,121 @@ static int clock_start(fwk_id_t id)
 static int clock_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
                                       fwk_id_t api_id, const void **api)
 {
-    if (fwk_id_get_api_idx(api_id) != MOD_CLOCK_API_TYPE_HAL)
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_CLOCK_API_TYPE_HAL:
+        *api = &clock_api;
+        return FWK_SUCCESS;
+
+    case MOD_CLOCK_API_TYPE_DRIVER_RESPONSE:
+        *api = &clock_drv_response_api;
+        return FWK_SUCCESS;
+
+    default:
         /* The requested API is not supported. */
         return FWK_E_ACCESS;
+    }
+}
 
-    *api = &clock_api;
-    return FWK_SUCCESS;
+static int clock_process_event(const struct fwk_event *event,
+                               struct fwk_event *resp_event)
+{
+    int status;
+    struct clock_dev_ctx *ctx;
+    struct fwk_event delayed_resp;
+    const struct mod_clock_resp_params *event_params =
+        (const struct mod_clock_resp_params *)event->params;
+    const struct clock_notification_params *notification_params;
+    unsigned int notification_count;
+    struct mod_clock_resp_params *resp_params;
+
+    if (!fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(event->target_id);
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_CLOCK_EVENT_IDX_REQUEST:
+        if (ctx->request.completed) {
+            /* The driver was faster than the queuing of the request */
+            resp_params = (struct mod_clock_resp_params *)resp_event->params;
+            resp_params->status = ctx->request.status;
+            ctx->request.completed = false;
+            ctx->request.pending = false;
+        } else {
+            resp_event->is_delayed_response = true;
+            ctx->request.cookie = event->cookie;
+            ctx->request.delayed = true;
+        }
+
+        return FWK_SUCCESS;
+
+    case CLOCK_EVENT_IDX_REQUEST_COMPLETE:
+        if (!ctx->request.pending)
+            return FWK_E_STATE;
+
+        if (event_params->status == FWK_SUCCESS)
+            update_subtree_rates(ctx);
+
+        if (!ctx->request.delayed) {
+            ctx->request.completed = true;
+            ctx->request.status = event_params->status;
+            return FWK_SUCCESS;
+        }
+
+        ctx->request.delayed = false;
+        ctx->request.pending = false;
+
+        status = fwk_thread_get_delayed_response(event->target_id,
+            ctx->request.cookie, &delayed_resp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        resp_params = (struct mod_clock_resp_params *)delayed_resp.params;
+        resp_params->status = event_params->status;
+
+        return fwk_thread_put_event(&delayed_resp);
+
+    case CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGED:
+        notification_params =
+            (const struct clock_notification_params *)event->params;
+
+        return notify_state_changed(notification_params->new_state);
+
+    case CLOCK_EVENT_IDX_NOTIFY_STATE_CHANGE_PENDING:
+        notification_params =
+            (const struct clock_notification_params *)event->params;
+
+        status = notify_state_change_pending(notification_params->new_state,
+                                             &notification_count);
+        if ((status != FWK_SUCCESS) || (notification_count == 0))
+            return complete_group_pre_transition(ctx->group.leader, status);
+
+        return FWK_SUCCESS;
+
+    default:
+        return FWK_E_PARAM;
+    }
 }
 
+/*
+ * The power domain notifications are processed by the first clock of each
+ * group, on behalf of all the clocks of the group: their drivers are called in
+ * a row and a single response is sent to the power domain.
+ */
 static int clock_process_pd_pre_transition_notification(
-    struct clock_dev_ctx *ctx,
+    struct clock_dev_ctx *leader,
     const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
     int status;
+    int driver_status;
+    unsigned int notification_count;
+    unsigned int event_count;
+    enum mod_clock_state state;
+    struct clock_dev_ctx *ctx;
     struct mod_pd_power_state_pre_transition_notification_params *pd_params;
     struct mod_pd_power_state_pre_transition_notification_resp_params
         *pd_resp_params;
-    struct clock_notification_params *out_params;
-    struct fwk_event outbound_event = {
-        .response_requested = true,
-        .id = mod_clock_notification_id_state_change_pending,
-    };
 
     pd_params = (struct mod_pd_power_state_pre_transition_notification_params *)
         event->params;
@@ -283,87 +820,99 @@ static int clock_process_pd_pre_transition_notification(
         (struct mod_pd_power_state_pre_transition_notification_resp_params *)
             resp_event->params;
 
-    assert(ctx->api->process_pending_power_transition != NULL);
-    status = ctx->api->process_pending_power_transition(
-        ctx->config->driver_id,
-        pd_params->current_state,
-        pd_params->target_state);
-
     /*
      * The response to the notification should initially be the overall result
      * of the downwards propagation of the state change through the driver(s).
      */
+    status = FWK_SUCCESS;
+    for (ctx = leader; ctx != NULL; ctx = ctx->group.next) {
+        if (!is_pd_notified(ctx, true))
+            continue;
+
+        /* The rate of the clock may change with the state of its domain */
+        invalidate_subtree_rates(ctx);
+
+        driver_status = ctx->api->process_pending_power_transition(
+            ctx->config->driver_id,
+            pd_params->current_state,
+            pd_params->target_state);
+        if (status == FWK_SUCCESS)
+            status = driver_status;
+    }
+
     pd_resp_params->status = status;
 
-    if (status != FWK_SUCCESS) {
-        ctx->transition_pending_notifications_sent = 0;
+    if (status != FWK_SUCCESS)
         return status;
-    }
 
-    ctx->transition_pending_response_status = FWK_SUCCESS;
-    out_params =
-        (struct clock_notification_params *)outbound_event.params;
+    state = get_pd_clock_state(pd_params->target_state);
 
-    /*
-     * For now it is sufficient to assume that a PD ON state implies that
-     * the clock is running and any other state implies that the clock has
-     * stopped. This will likely need to be revisited so that the clock
-     * driver can influence the resulting state that is propagated via the
-     * outgoing notification.
-     */
-    out_params->new_state = (pd_params->target_state == MOD_PD_STATE_ON)
-        ? MOD_CLOCK_STATE_RUNNING
-        : MOD_CLOCK_STATE_STOPPED;
+    status = FWK_SUCCESS;
+    notification_count = 0;
+    if (is_pd_notified(leader, true))
+        status = notify_state_change_pending(state, &notification_count);
 
-    /* Notify subscribers of the pending clock state change */
-    status = fwk_notification_notify(
-        &outbound_event,
-        &(ctx->transition_pending_notifications_sent));
+    if (status == FWK_SUCCESS) {
+        status = put_group_events(leader, true, state, &event_count);
+    }
+
+    if (status != FWK_SUCCESS) {
+        pd_resp_params->status = status;
+        return status;
+    }
 
-    if (ctx->transition_pending_notifications_sent > 0) {
+    leader->group.pending_count = event_count;
+    if (notification_count > 0)
+        leader->group.pending_count++;
+    leader->group.status = FWK_SUCCESS;
+
+    if (leader->group.pending_count > 0) {
         /* There are one or more subscribers that must respond */
         resp_event->is_delayed_response = true;
-        ctx->pd_pre_power_transition_notification_cookie = event->cookie;
+        leader->pd_pre_power_transition_notification_cookie = event->cookie;
     }
 
     return FWK_SUCCESS;
 }
 
 static int clock_process_pd_transition_notification(
-    struct clock_dev_ctx *ctx,
+    struct clock_dev_ctx *leader,
     const struct fwk_event *event)
 {
     int status;
-    unsigned int transition_notifications_sent;
+    int driver_status;
+    unsigned int event_count;
+    enum mod_clock_state state;
+    struct clock_dev_ctx *ctx;
     struct mod_pd_power_state_transition_notification_params *pd_params;
-    struct clock_notification_params* out_params;
-    struct fwk_event outbound_event = {
-        .response_requested = false,
-        .id = mod_clock_notification_id_state_changed,
-    };
 
     pd_params =
         (struct mod_pd_power_state_transition_notification_params *)event
             ->params;
 
-    assert(ctx->api->process_power_transition != NULL);
-    status = ctx->api->process_power_transition(
-        ctx->config->driver_id, pd_params->state);
+    status = FWK_SUCCESS;
+    for (ctx = leader; ctx != NULL; ctx = ctx->group.next) {
+        if (!is_pd_notified(ctx, false))
+            continue;
+
+        invalidate_subtree_rates(ctx);
+
+        driver_status = ctx->api->process_power_transition(
+            ctx->config->driver_id, pd_params->state);
+        if (status == FWK_SUCCESS)
+            status = driver_status;
+    }
 
     if (status != FWK_SUCCESS)
         return status;
 
     /* Notify subscribers of the clock state change */
-    out_params = (struct clock_notification_params *)outbound_event.params;
-    if (pd_params->state == MOD_PD_STATE_ON)
-        out_params->new_state = MOD_CLOCK_STATE_RUNNING;
-    else
-        out_params->new_state = MOD_CLOCK_STATE_STOPPED;
+    state = get_pd_clock_state(pd_params->state);
 
-    status = fwk_notification_notify(
-        &outbound_event, &(transition_notifications_sent));
+    if (is_pd_notified(leader, false))
+        notify_state_changed(state);
 
-    return FWK_SUCCESS;
+    return put_group_events(leader, false, state, &event_count);
 }
 
 static int clock_process_notification_response(
@@ -371,52 +920,20 @@ static int clock_process_notification_response(
     const struct fwk_event *event)
 {
     struct clock_state_change_pending_resp_params *resp_params;
-    struct mod_pd_power_state_pre_transition_notification_resp_params
-        *pd_resp_params;
-    struct fwk_event pd_response_event = {
-        .id = module_ctx.config->pd_pre_transition_notification_id,
-        .target_id = ctx->config->pd_source_id,
-        .cookie = ctx->pd_pre_power_transition_notification_cookie,
-        .is_notification = true,
-        .is_response = true,
-        .is_delayed_response = true,
-    };
 
     assert(fwk_id_is_equal(event->id,
                            mod_clock_notification_id_state_change_pending));
 
-    /* At least one notification response must be outstanding */
-    if (ctx->transition_pending_notifications_sent == 0) {
-        assert(false);
-        return FWK_E_PANIC;
-    }
-
-    resp_params =
-        (struct clock_state_change_pending_resp_params *)event->params;
-
     /*
-     * Change the status used in the response to the power domain notification
-     * if this response has a non-success status code, otherwise leave the
-     * existing value alone. By default the status is FWK_SUCCESS and changing
-     * it to an error status code will veto the power domain state transition
-     * that is pending.
+     * The responses of all the subscribers have been collected, the status is
+     * that of the first subscriber that vetoed the power domain state
+     * transition, if any.
      */
-    if (resp_params->status != FWK_SUCCESS)
-        ctx->transition_pending_response_status = resp_params->status;
-
-    if ((--(ctx->transition_pending_notifications_sent)) == 0) {
-        /*
-         * If this is the final response then the response to the power domain
-         * notification can be sent.
-         */
-        pd_resp_params =
-            (struct mod_pd_power_state_pre_transition_notification_resp_params
-                 *)pd_response_event.params;
-        pd_resp_params->status = ctx->transition_pending_response_status;
-        fwk_thread_put_event(&pd_response_event);
-    }
+    resp_params =
+        (struct clock_state_change_pending_resp_params *)event->params;
 
-    return FWK_SUCCESS;
+    return complete_group_pre_transition(ctx->group.leader,
+                                         resp_params->status);
 }
 
 static int clock_process_notification(
@@ -449,12 +966,13 @@ const struct fwk_module module_clock = {
     .name = "Clock HAL",
     .type = FWK_MODULE_TYPE_HAL,
     .api_count = MOD_CLOCK_API_COUNT,
-    .event_count = 0,
+    .event_count = CLOCK_EVENT_IDX_COUNT,
     .notification_count = MOD_CLOCK_NOTIFICATION_IDX_COUNT,
     .init = clock_init,
     .element_init = clock_dev_init,
     .bind = clock_bind,
     .start = clock_start,
     .process_bind_request = clock_process_bind_request,
+    .process_event = clock_process_event,
     .process_notification = clock_process_notification,
 };
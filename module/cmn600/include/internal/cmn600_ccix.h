@@ -19,6 +19,9 @@
 
 /*
  * CMN600 CCIX Setup Function
+ *
+ * Returns FWK_PENDING when the link status is polled from a timer alarm, the
+ * link is then brought up by ccix_link_poll().
  */
 int ccix_setup(struct cmn600_ctx *ctx, void *remote_config);
 
@@ -29,9 +32,21 @@ int ccix_exchange_protocol_credit(struct cmn600_ctx *ctx, uint8_t link_id);
 
 /*
  *  CMN600 CCIX Enter system Coherency Function
+ *
+ * Returns FWK_PENDING when the link status is polled from a timer alarm, the
+ * link then enters system coherency in ccix_link_poll().
  */
 int ccix_enter_system_coherency(struct cmn600_ctx *ctx, uint8_t link_id);
 
+/*
+ * CMN600 CCIX Link Status Poll Function
+ *
+ * Advances the link sequence started by ccix_setup() or
+ * ccix_enter_system_coherency(). Returns FWK_PENDING until the sequence has
+ * completed.
+ */
+int ccix_link_poll(struct cmn600_ctx *ctx);
+
 
 /*
  * CCIX Gateway (CXG) protocol link control & status registers
@@ -27,7 +27,72 @@ struct external_rnsam_tuple {
 };
 
 /* Max Node Counts */
+/*
+ * Update of a register from a precomputed image: the bits in mask are replaced
+ * by those of value, the other bits are preserved.
+ */
+struct cmn600_reg_update {
+    uint64_t value;
+    uint64_t mask;
+};
+
+/*
+ * Register image shared by all the RN-SAM nodes, computed once from the memory
+ * map of the configuration.
+ */
+struct cmn600_rnsam_image {
+    struct cmn600_reg_update non_hash_mem_region[5];
+    struct cmn600_reg_update non_hash_tgt_nodeid[3];
+    struct cmn600_reg_update sys_cache_grp_region[2];
+};
+
+/* Step of a CCIX link sequence, see cmn600_ccix.c */
+struct cmn600_ccix_link_step;
+
+/*
+ * CCIX link sequence in progress: the link control bits of each step are set
+ * then the link status is waited for before moving to the next step.
+ */
+struct cmn600_ccix_link_sequence {
+    const struct cmn600_ccix_link_step *steps;
+    unsigned int step_count;
+    unsigned int step;
+    uint8_t link_id;
+
+    /* The sequence is run on the links from link_id to last_link_id */
+    uint8_t last_link_id;
+
+    /* Time in microseconds spent waiting for the current step */
+    uint32_t wait_time;
+};
+
+/* CCIX link operations completing asynchronously */
+enum cmn600_ccix_link_op {
+    CMN600_CCIX_LINK_OP_NONE,
+    CMN600_CCIX_LINK_OP_SET_CONFIG,
+    CMN600_CCIX_LINK_OP_ENTER_SYSTEM_COHERENCY,
+};
+
+/* PMU counter, made of a DTM local counter and a DTC global counter */
+struct cmn600_pmu_counter {
+    /* Crosspoint whose DTM counts the events */
+    struct cmn600_mxp_reg *xp;
+
+    /* Node the events are selected on, the crosspoint for its own events */
+    void *node;
+
+    /* Index of the counter in the DTM, also the event slot of the source */
+    unsigned int dtm_idx;
+
+    /* Raw value at the last sample */
+    uint64_t last_value;
+
+    /* Events counted since the PMU was set up */
+    uint64_t value;
+};
+
 #define MAX_HNF_COUNT 4
+#define MAX_HNF_SUB_REGION_COUNT 2
 #define MAX_RND_COUNT 8
 #define MAX_RNI_COUNT 8
 
@@ -41,6 +106,16 @@ struct cmn600_ctx {
     uint32_t hnf_offset[MAX_HNF_COUNT];
     uint64_t *hnf_cache_group;
 
+    /* Number of HN-F nodes of the second system cache group */
+    unsigned int hnf_scg1_count;
+
+    /* System cache sub-region entries programmed into every HN-F node */
+    unsigned int hnf_sub_region_count;
+    uint64_t hnf_sub_region[MAX_HNF_SUB_REGION_COUNT];
+
+    /* Register image programmed into every RN-SAM node */
+    struct cmn600_rnsam_image rnsam_image;
+
     /*
      * External RN-SAMs. The driver keeps a list of tuples (node identifier and
      * node pointers). The configuration of these nodes is via the SAM API.
@@ -78,6 +153,10 @@ struct cmn600_ctx {
     unsigned int cxg_ha_id_remote;
     uint8_t raid_value;
     uint8_t unique_ha_ldid_value;
+
+    /* Links of the CCIX configuration, none before it is set */
+    uint8_t ccix_link_first;
+    uint8_t ccix_link_count;
     struct cmn600_cxg_ra_reg *cxg_ra_reg;
     struct cmn600_cxg_ha_reg *cxg_ha_reg;
     struct cmn600_cxla_reg *cxla_reg;
@@ -85,11 +164,38 @@ struct cmn600_ctx {
     /* CCIX host parameters to be sent to upper level firmware */
     struct mod_cmn600_ccix_host_node_config ccix_host_info;
 
+    /* First debug and trace controller (DTC) */
+    struct cmn600_dt_reg *dtc_reg;
+
+    /* PMU counters, in the order of the configuration */
+    struct cmn600_pmu_counter *pmu_counter_table;
+
+    /* Time of the last sample of the PMU counters, 0 before the first one */
+    uint64_t pmu_timestamp;
+
+    /* CCIX link sequence */
+    struct cmn600_ccix_link_sequence ccix_link;
+
+    /* Asynchronous CCIX link operation in progress */
+    enum cmn600_ccix_link_op ccix_link_op;
+
+    /* Status of the last asynchronous CCIX link operation */
+    int ccix_link_status;
+
+    /* The response to the pending CCIX link operation event is delayed */
+    bool ccix_link_response_delayed;
+
+    /* Cookie of the pending CCIX link operation event */
+    uint32_t ccix_link_cookie;
+
     struct mod_log_api *log_api;
 
     /* Timer module API */
     struct mod_timer_api *timer_api;
 
+    /* Timer alarm API, used to poll the CCIX link status */
+    const struct mod_timer_alarm_api *alarm_api;
+
     bool initialized;
 };
 
@@ -0,0 +1,41 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      CMN600 PMU telemetry.
+ */
+
+#ifndef CMN600_PMU_H
+#define CMN600_PMU_H
+
+#include <stdint.h>
+#include <internal/cmn600_ctx.h>
+
+/*
+ * CMN600 PMU Discovery Function
+ *
+ * Locates the nodes of the PMU counters of the configuration and allocates
+ * their DTM counters.
+ */
+int pmu_discovery(struct cmn600_ctx *ctx);
+
+/*
+ * CMN600 PMU Setup Function
+ *
+ * Programs the event selection of the PMU counters and enables the counting.
+ * The counters count from 0 once set up.
+ */
+void pmu_setup(struct cmn600_ctx *ctx);
+
+/*
+ * CMN600 PMU Sample Function
+ *
+ * Accumulates the events counted since the last sample and publishes the
+ * telemetry.
+ */
+void pmu_sample(struct cmn600_ctx *ctx, uint64_t timestamp);
+
+#endif /* CMN600_PMU_H */
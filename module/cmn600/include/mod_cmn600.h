@@ -12,6 +12,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \addtogroup GroupModules Modules
@@ -33,6 +35,11 @@
  */
 #define MAX_HA_MMAP_ENTRIES     4
 
+/*!
+ * \brief Number of CCIX links of the CCIX gateway.
+ */
+#define MOD_CMN600_CCIX_LINK_COUNT_MAX 3
+
 /*!
  * \brief Module API indices
  */
@@ -43,6 +50,9 @@ enum mod_cmn600_api_idx {
     /*! Index of the CCIX config setup API */
     MOD_CMN600_API_IDX_CCIX_CONFIG,
 
+    /*! Index of the PMU telemetry API */
+    MOD_CMN600_API_IDX_PMU,
+
     /*! Number of APIs */
     MOD_CMN600_API_COUNT
 };
@@ -96,6 +106,173 @@ struct mod_cmn600_memory_region_map {
     unsigned int node_id;
 };
 
+/*!
+ * \brief Mapping of the memory served by the HN-F nodes to the SN-F nodes.
+ */
+enum mod_cmn600_snf_mode {
+    /*!
+     * Each HN-F node targets a single SN-F node, given by its entry in
+     * \ref mod_cmn600_config.snf_table.
+     */
+    MOD_CMN600_SNF_MODE_DIRECT,
+
+    /*!
+     * Every HN-F node stripes the memory it serves across the three SN-F
+     * nodes of \ref mod_cmn600_config.snf_striping, for instance to
+     * interleave the memory over three memory controllers.
+     */
+    MOD_CMN600_SNF_MODE_THREE_SN,
+};
+
+/*!
+ * \brief Striping of the memory across three SN-F nodes.
+ */
+struct mod_cmn600_snf_striping {
+    /*! Identifiers of the SN-F nodes */
+    unsigned int node_id[3];
+
+    /*!
+     * \brief Top two address bits of the memory striped, lower bit first.
+     *
+     * \details The HN-F nodes use these bits to balance the memory, whose
+     *      size is not a multiple of three, across the SN-F nodes.
+     */
+    unsigned int top_address_bit[2];
+};
+
+/*!
+ * \brief Maximum number of PMU counters.
+ */
+#define MOD_CMN600_PMU_COUNTER_MAX 8
+
+/*!
+ * \brief Source of the events counted by a PMU counter.
+ */
+enum mod_cmn600_pmu_event_source {
+    /*! Event of a crosspoint (XP) */
+    MOD_CMN600_PMU_EVENT_SOURCE_XP,
+
+    /*! Event of a node attached to a crosspoint, for instance an HN-F */
+    MOD_CMN600_PMU_EVENT_SOURCE_NODE,
+};
+
+/*!
+ * \brief HN-F events.
+ */
+enum mod_cmn600_pmu_hnf_event {
+    /*! System level cache misses */
+    MOD_CMN600_PMU_HNF_EVENT_CACHE_MISS = 0x01,
+
+    /*!
+     * Requests sent to the SN-F of the HN-F. Each request transfers a cache
+     * line, this event measures the memory bandwidth.
+     */
+    MOD_CMN600_PMU_HNF_EVENT_MC_REQS = 0x0D,
+};
+
+/*!
+ * \brief Crosspoint events.
+ */
+enum mod_cmn600_pmu_xp_event {
+    /*! Flits transmitted */
+    MOD_CMN600_PMU_XP_EVENT_TXFLIT_VALID = 0x1,
+
+    /*! Cycles a flit is stalled before being transmitted */
+    MOD_CMN600_PMU_XP_EVENT_TXFLIT_STALL = 0x2,
+};
+
+/*!
+ * \brief CCIX gateway requesting agent (CXRA) events.
+ *
+ * \details The events are counted for each CCIX link, and measure how close
+ *      the link is to saturation.
+ */
+enum mod_cmn600_pmu_cxra_event {
+    /*! Cycles the requests to CCIX link 0 are stalled for protocol credits */
+    MOD_CMN600_PMU_CXRA_EVENT_REQ_PCRD_STALL_LINK0 = 0x0B,
+
+    /*! Cycles the data to CCIX link 0 are stalled for protocol credits */
+    MOD_CMN600_PMU_CXRA_EVENT_DAT_PCRD_STALL_LINK0 = 0x0E,
+};
+
+/*!
+ * \brief Build the identifier of a CXRA event of a CCIX link.
+ *
+ * \param EVENT Event of CCIX link 0, see \ref mod_cmn600_pmu_cxra_event.
+ * \param LINK Identifier of the CCIX link.
+ */
+#define MOD_CMN600_PMU_CXRA_LINK_EVENT(EVENT, LINK) ((EVENT) + (LINK))
+
+/*!
+ * \brief Crosspoint interfaces the crosspoint events are counted on.
+ */
+enum mod_cmn600_pmu_xp_interface {
+    MOD_CMN600_PMU_XP_INTERFACE_EAST,
+    MOD_CMN600_PMU_XP_INTERFACE_WEST,
+    MOD_CMN600_PMU_XP_INTERFACE_NORTH,
+    MOD_CMN600_PMU_XP_INTERFACE_SOUTH,
+    MOD_CMN600_PMU_XP_INTERFACE_PORT0,
+    MOD_CMN600_PMU_XP_INTERFACE_PORT1,
+};
+
+/*!
+ * \brief CHI channels the crosspoint events are counted on.
+ */
+enum mod_cmn600_pmu_xp_channel {
+    MOD_CMN600_PMU_XP_CHANNEL_REQ,
+    MOD_CMN600_PMU_XP_CHANNEL_RSP,
+    MOD_CMN600_PMU_XP_CHANNEL_SNP,
+    MOD_CMN600_PMU_XP_CHANNEL_DAT,
+};
+
+/*!
+ * \brief Build the identifier of a crosspoint event.
+ *
+ * \param EVENT Event, see \ref mod_cmn600_pmu_xp_event.
+ * \param INTERFACE Interface, see \ref mod_cmn600_pmu_xp_interface.
+ * \param CHANNEL Channel, see \ref mod_cmn600_pmu_xp_channel.
+ */
+#define MOD_CMN600_PMU_XP_EVENT(EVENT, INTERFACE, CHANNEL) \
+    ((EVENT) | ((INTERFACE) << 2) | ((CHANNEL) << 5))
+
+/*!
+ * \brief PMU counter descriptor.
+ */
+struct mod_cmn600_pmu_counter_config {
+    /*! Source of the events */
+    enum mod_cmn600_pmu_event_source source;
+
+    /*!
+     * \brief Identifier of the crosspoint, or of the node attached to a
+     *      crosspoint, the events are counted on.
+     */
+    unsigned int node_id;
+
+    /*! Identifier of the event in the PMU events of the source */
+    uint8_t event;
+};
+
+/*!
+ * \brief PMU telemetry published in memory.
+ *
+ * \details The counters are sampled periodically. An observer reads the
+ *      sequence count, the other fields and then the sequence count again,
+ *      and starts over if the two counts differ or are odd.
+ */
+struct mod_cmn600_pmu_telemetry {
+    /*! Odd while the counters are updated */
+    volatile uint32_t sequence;
+
+    /*! Number of counters */
+    uint32_t counter_count;
+
+    /*! Time of the last sample in microseconds */
+    uint64_t timestamp;
+
+    /*! Values of the counters, in the order of the configuration */
+    uint64_t counter[MOD_CMN600_PMU_COUNTER_MAX];
+};
+
 /*!
  * \brief CMN600 configuration data
  */
@@ -118,12 +295,38 @@ struct mod_cmn600_config {
      * \details Each entry of this table corresponds to a HN-F node in the
      *      system. The HN-F's logical identifiers are used as indices in this
      *      table
+     *
+     * \note Used only if \ref snf_mode is
+     *      \ref MOD_CMN600_SNF_MODE_DIRECT.
      */
     const unsigned int *snf_table;
 
     /*! Number of entries in the \ref snf_table */
     size_t snf_count;
 
+    /*! Mapping of the memory served by the HN-F nodes to the SN-F nodes */
+    enum mod_cmn600_snf_mode snf_mode;
+
+    /*!
+     * \brief Striping of the memory across the SN-F nodes.
+     *
+     * \note Used only if \ref snf_mode is
+     *      \ref MOD_CMN600_SNF_MODE_THREE_SN.
+     */
+    struct mod_cmn600_snf_striping snf_striping;
+
+    /*!
+     * \brief Mask of the logical identifiers of the HN-F nodes of the second
+     *      system cache group, 0 for a single group of all the HN-F nodes.
+     *
+     * \details The first system cache region of the memory map is hashed
+     *      over the HN-F nodes of the first group, and the second region over
+     *      those of the second group. Partitioning the HN-F nodes keeps the
+     *      lines of each region in the HN-F nodes close to the requesters and
+     *      to the memory of the region, as for a NUMA node.
+     */
+    uint32_t hnf_scg1_mask;
+
     /*! Host SA count */
     unsigned int sa_count;
 
@@ -138,6 +341,58 @@ struct mod_cmn600_config {
 
     /*! Identifier of the clock that this device depends on */
     fwk_id_t clock_id;
+
+    /*!
+     * \brief Period in microseconds of the polling of the CCIX link status, 0
+     *      to wait for the CCIX link synchronously.
+     *
+     * \details When not equal to 0, the CCIX link bring-up and the entry into
+     *      system coherency complete asynchronously: the link status is polled
+     *      from a timer alarm and the other events of the system are processed
+     *      in the meantime.
+     */
+    unsigned int ccix_poll_period;
+
+    /*!
+     * \brief Sub-element identifier of the alarm used to poll the CCIX link
+     *      status.
+     *
+     * \note Used only if \ref ccix_poll_period is not equal to 0.
+     */
+    fwk_id_t ccix_alarm_id;
+
+    /*!
+     * \brief Table of PMU counters, NULL to disable the PMU telemetry.
+     *
+     * \details The counters of a crosspoint and of its nodes share the four
+     *      counters of the crosspoint. The counters are only supported on the
+     *      crosspoints of the first debug and trace controller (DTC) domain.
+     */
+    const struct mod_cmn600_pmu_counter_config *pmu_counter_table;
+
+    /*! Number of entries in the \ref pmu_counter_table */
+    size_t pmu_counter_count;
+
+    /*!
+     * \brief Period in milliseconds of the sampling of the PMU counters.
+     *
+     * \note Used only if \ref pmu_counter_count is not equal to 0.
+     */
+    unsigned int pmu_sampling_period;
+
+    /*!
+     * \brief Sub-element identifier of the alarm used to sample the PMU
+     *      counters. The timer of the alarm timestamps the samples.
+     *
+     * \note Used only if \ref pmu_counter_count is not equal to 0.
+     */
+    fwk_id_t pmu_alarm_id;
+
+    /*!
+     * \brief Address of the memory the telemetry is published to as a
+     *      \ref mod_cmn600_pmu_telemetry structure, 0 if not published.
+     */
+    uintptr_t pmu_telemetry_address;
 };
 
 /*!
@@ -156,6 +411,21 @@ struct mod_cmn600_ccix_ha_mmap {
 };
 
 
+/*!
+ * \brief Balancing of the CCIX traffic across the links of a CCIX
+ *      configuration.
+ */
+enum mod_cmn600_ccix_link_balance {
+    /*! The local agents are assigned to the links in turn */
+    MOD_CMN600_CCIX_LINK_BALANCE_AGENT,
+
+    /*!
+     * The remote memory regions are assigned to the links in turn, through
+     * the home agents of the regions. The local agents use the first link.
+     */
+    MOD_CMN600_CCIX_LINK_BALANCE_REGION,
+};
+
 /*!
  * \brief CMN600 CCIX configuration data from remote node
  */
@@ -181,6 +451,15 @@ struct mod_cmn600_ccix_remote_node_config {
     /*! CCIX link identifier */
     uint8_t ccix_link_id;
 
+    /*!
+     * \brief Number of CCIX links the traffic is spread across, from
+     *      \ref ccix_link_id. 0 is the same as 1, a single link.
+     */
+    uint8_t ccix_link_count;
+
+    /*! Balancing of the traffic across the CCIX links */
+    enum mod_cmn600_ccix_link_balance ccix_link_balance;
+
     /*! optimised tlp mode */
     bool    ccix_opt_tlp;
 
@@ -231,6 +510,10 @@ struct mod_cmn600_ccix_config_api {
     * \param[in] config CCIX endpoint configuration
     *
     * \retval FWK_SUCCESS if the operation succeed.
+    * \retval FWK_PENDING The CCIX link is being brought up. The
+    *      \ref mod_cmn600_event_id_ccix_link response event is sent to the
+    *      caller once the operation has completed.
+    * \retval FWK_E_BUSY Another CCIX link operation is in progress.
     * \return one of the error code otherwise.
     */
    int (*set_config)(struct mod_cmn600_ccix_remote_node_config *config);
@@ -238,7 +521,9 @@ struct mod_cmn600_ccix_config_api {
     * \brief Interface to trigger the protocol credit exchange
     *
     * \param  link_id Link on which the protocol credit exchange
-    *                 would initiate.
+    *                 would initiate. The credits of all the links of
+    *                 the CCIX configuration are exchanged for its first
+    *                 link.
     *
     * \retval FWK_SUCCESS if the operation succeed.
     * \return one of the error code otherwise.
@@ -248,14 +533,70 @@ struct mod_cmn600_ccix_config_api {
     * \brief Interface to configure for system coherency
     *
     * \param  link_id Link on which the coherency has to
-    *                 be enabled.
+    *                 be enabled. All the links of the CCIX
+    *                 configuration enter coherency for its first link.
     *
     * \retval FWK_SUCCESS if the operation succeed.
+    * \retval FWK_PENDING The link is entering system coherency. The
+    *      \ref mod_cmn600_event_id_ccix_link response event is sent to the
+    *      caller once the operation has completed.
+    * \retval FWK_E_BUSY Another CCIX link operation is in progress.
     * \return one of the error code otherwise.
     */
    int (*enter_system_coherency)(uint8_t link_id);
 };
 
+/*!
+ * \brief CMN600 PMU telemetry interface
+ */
+struct mod_cmn600_pmu_api {
+    /*!
+     * \brief Get the value of a PMU counter at the last sample.
+     *
+     * \param counter_idx Index of the counter in the PMU counter table of the
+     *      configuration.
+     * \param[out] value Number of events counted since the PMU was set up.
+     * \param[out] timestamp Time of the last sample in microseconds.
+     *
+     * \retval FWK_SUCCESS The counter value was returned.
+     * \retval FWK_E_PARAM The counter index is not valid.
+     * \retval FWK_E_STATE The counters have not been sampled yet.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_counter)(unsigned int counter_idx, uint64_t *value,
+                       uint64_t *timestamp);
+};
+
+/*!
+ * \brief Event indices.
+ */
+enum mod_cmn600_event_idx {
+    /*! Pending CCIX link operation */
+    MOD_CMN600_EVENT_IDX_CCIX_LINK,
+
+    /*! Number of events */
+    MOD_CMN600_EVENT_IDX_COUNT,
+};
+
+/*!
+ * \brief Pending CCIX link operation event identifier.
+ *
+ * \details The response to this event reports the completion of an operation
+ *      of the \ref mod_cmn600_ccix_config_api interface that returned
+ *      FWK_PENDING. Its parameters are a \ref mod_cmn600_ccix_link_event_params
+ *      structure.
+ */
+static const fwk_id_t mod_cmn600_event_id_ccix_link =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_CMN600, MOD_CMN600_EVENT_IDX_CCIX_LINK);
+
+/*!
+ * \brief Parameters of the response to a pending CCIX link operation event.
+ */
+struct mod_cmn600_ccix_link_event_params {
+    /*! Status of the operation */
+    int status;
+};
+
 
 /*!
  * @}
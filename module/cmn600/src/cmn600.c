@@ -87,12 +87,11 @@ uint64_t sam_encode_region_size(uint64_t size)
     return result;
 }
 
-void configure_region(volatile uint64_t *reg, unsigned int bit_offset,
-    uint64_t base, uint64_t size, enum sam_node_type node_type)
+uint64_t sam_encode_region(uint64_t base, uint64_t size,
+    enum sam_node_type node_type)
 {
     uint64_t value;
 
-    assert(reg);
     assert((base % size) == 0);
 
     value = CMN600_RNSAM_REGION_ENTRY_VALID;
@@ -100,8 +99,7 @@ void configure_region(volatile uint64_t *reg, unsigned int bit_offset,
     value |= sam_encode_region_size(size) << CMN600_RNSAM_REGION_ENTRY_SIZE_POS;
     value |= (base / SAM_GRANULARITY) << CMN600_RNSAM_REGION_ENTRY_BASE_POS;
 
-    *reg &= ~(CMN600_RNSAM_REGION_ENTRY_MASK << bit_offset);
-    *reg |= value << bit_offset;
+    return value;
 }
 
 static const char * const type_to_name[] = {
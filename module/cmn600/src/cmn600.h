@@ -508,10 +508,22 @@ struct cmn600_hni_reg {
 #define CMN600_HNF_SAM_MEMREGION_BASE_POS 26
 #define CMN600_HNF_SAM_MEMREGION_VALID UINT64_C(0x8000000000000000)
 
+#define CMN600_HNF_SAM_CONTROL_SN0_POS 0
+#define CMN600_HNF_SAM_CONTROL_SN1_POS 12
+#define CMN600_HNF_SAM_CONTROL_SN2_POS 24
+#define CMN600_HNF_SAM_CONTROL_SN_MASK UINT64_C(0x7FF)
+#define CMN600_HNF_SAM_CONTROL_THREE_SN_EN UINT64_C(0x0000001000000000)
+#define CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT0_POS 40
+#define CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT1_POS 48
+#define CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT_MASK UINT64_C(0x3F)
+
 #define CMN600_HNF_CACHE_GROUP_ENTRIES_MAX 32
 #define CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP 4
 #define CMN600_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH 12
 
+/* Number of HN-F nodes of each system cache group in SYS_CACHE_GRP_HN_COUNT */
+#define CMN600_RNSAM_SCG_HNF_COUNT_BITS_WIDTH 8
+
 #define CMN600_HNI_SAM_REGION_CFG_SER_DEVNE_WR UINT64_C(0x1000000000000000)
 
 #define CMN600_RND_CFG_CTL_PCIE_MSTR_PRESENT UINT64_C(0x0000000000000020)
@@ -530,12 +542,41 @@ struct cmn600_hni_reg {
 #define CMN600_PPU_PWPR_OPMODE_FAM UINT64_C(0x0000000000000030)
 #define CMN600_PPU_PWPR_DYN_EN UINT64_C(0x0000000000000100)
 
+/* Performance Monitoring Unit (PMU) */
+#define CMN600_PMU_EVENT_SEL_OFFSET 0x2000
+#define CMN600_PMU_EVENT_SEL_BITS_WIDTH 8
+#define CMN600_PMU_EVENT_SEL_MASK UINT64_C(0xFF)
+
+#define CMN600_DT_DTC_CTL_DT_EN UINT64_C(0x0000000000000001)
+#define CMN600_DT_PMCR_PMU_EN UINT64_C(0x0000000000000001)
+/* Number of global counters of a DTC, packed in pairs in PMEVCNT */
+#define CMN600_DT_PMEVCNT_COUNT 8
+#define CMN600_DT_PMEVCNT_BITS_WIDTH 32
+
+#define CMN600_DTM_CONTROL_DTM_ENABLE UINT64_C(0x0000000000000001)
+#define CMN600_DTM_PMU_CONFIG_PMU_EN UINT64_C(0x0000000000000001)
+#define CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_POS 16
+#define CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_BITS_WIDTH 4
+#define CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_MASK UINT64_C(0x7)
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_POS 32
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_BITS_WIDTH 8
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_MASK UINT64_C(0xFF)
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_XP 0x04
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_DEVICE 0x10
+#define CMN600_DTM_PMU_CONFIG_INPUT_SEL_DEVICE_PER_PORT 4
+/* Number of local counters of a DTM, packed in PMEVCNT[0] */
+#define CMN600_DTM_PMEVCNT_COUNT 4
+#define CMN600_DTM_PMEVCNT_BITS_WIDTH 16
+#define CMN600_DTM_PMEVCNT_MASK UINT64_C(0xFFFF)
+
 /* Mesh and Node ID mapping */
 #define CMN600_MESH_X_MAX 8
 #define CMN600_MESH_Y_MAX 8
 
 #define CMN600_NODE_ID_PORT_POS 2
 #define CMN600_NODE_ID_PORT_MASK 0x1
+/* Port and device bits, cleared in the node identifier of a crosspoint */
+#define CMN600_NODE_ID_XP_MASK 0x7
 #define CMN600_NODE_ID_Y_POS 3
 
 #define CMN600_ROOT_NODE_OFFSET_PORT_POS 14
@@ -644,19 +685,16 @@ bool is_child_external(void *node_base, unsigned int child_index);
 uint64_t sam_encode_region_size(uint64_t size);
 
 /*
- * Configure a memory region
+ * Encode a memory region entry
  *
- * \param[out] reg Region group descriptor to be configured
- *      \pre Must be a valid pointer
- * \param bit_offset Bit offset of the memory region in the group descriptor
  * \param base Region base address
  * \param size Region size
  * \param node_type Type of the target node
  *
- * \return None
+ * \return Value of the region entry, to be placed in its group descriptor
  */
-void configure_region(volatile uint64_t *reg, unsigned int bit_offset,
-    uint64_t base, uint64_t size, enum sam_node_type node_type);
+uint64_t sam_encode_region(uint64_t base, uint64_t size,
+    enum sam_node_type node_type);
 
 /*
  * Retrieve the node type name
@@ -76,6 +76,185 @@ static bool cxg_link_wait_condition(void *data)
 }
 
 
+/*
+ * Step of a CCIX link sequence: the link control bits are set in the CXRA and
+ * CXHA, then the link status condition is waited for.
+ */
+struct cmn600_ccix_link_step {
+    uint64_t ra_ctrl_set;
+    uint64_t ha_ctrl_set;
+    enum cxg_link_up_wait_cond cond;
+    uint32_t timeout;
+};
+
+static const struct cmn600_ccix_link_step link_up_sequence[] = {
+    /* Wait until link enable bits are set */
+    {
+        .cond = CXG_LINK_CTRL_EN_BIT_SET,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+    /* Wait till link up bits are cleared in control register */
+    {
+        .cond = CXG_LINK_CTRL_UP_BIT_CLR,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+    /* Wait till link down bits are set in status register */
+    {
+        .cond = CXG_LINK_STATUS_DWN_BIT_SET,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+    /* Wait till link ACK bits are cleared in status register */
+    {
+        .cond = CXG_LINK_STATUS_ACK_BIT_CLR,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+    /*
+     * Bring up link using link request bit and wait till link ACK bits are set
+     * in status register
+     */
+    {
+        .ra_ctrl_set = CXG_LINK_CTRL_REQ_MASK,
+        .ha_ctrl_set = CXG_LINK_CTRL_REQ_MASK,
+        .cond = CXG_LINK_STATUS_ACK_BIT_SET,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+    /* Wait till link down bits are cleared in status register */
+    {
+        .cond = CXG_LINK_STATUS_DWN_BIT_CLR,
+        .timeout = CXG_PRTCL_LINK_CTRL_TIMEOUT,
+    },
+};
+
+static const struct cmn600_ccix_link_step system_coherency_sequence[] = {
+    /*
+     * Enter system coherency by setting DVMDOMAIN request bit and wait till
+     * DVMDOMAIN ACK bit is set in status register
+     */
+    {
+        .ha_ctrl_set = CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK,
+        .cond = CXG_LINK_STATUS_DVMDOMAIN_ACK_BIT_SET,
+        .timeout = CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
+    },
+};
+
+static void start_link_step(struct cmn600_ctx *ctx)
+{
+    struct cmn600_ccix_link_sequence *link = &ctx->ccix_link;
+    const struct cmn600_ccix_link_step *step = &link->steps[link->step];
+
+    if (step->ra_ctrl_set != 0) {
+        ctx->cxg_ra_reg->LINK_REGS[link->link_id].CXG_PRTCL_LINK_CTRL |=
+            step->ra_ctrl_set;
+    }
+    if (step->ha_ctrl_set != 0) {
+        ctx->cxg_ha_reg->LINK_REGS[link->link_id].CXG_PRTCL_LINK_CTRL |=
+            step->ha_ctrl_set;
+    }
+
+    link->wait_time = 0;
+}
+
+/*
+ * Move on to the next step of the link sequence, or to its first step on the
+ * next link. Returns false once the sequence has completed on all the links.
+ */
+static bool next_link_step(struct cmn600_ctx *ctx)
+{
+    struct cmn600_ccix_link_sequence *link = &ctx->ccix_link;
+
+    if (++link->step == link->step_count) {
+        if (link->link_id == link->last_link_id)
+            return false;
+
+        link->link_id++;
+        link->step = 0;
+    }
+
+    start_link_step(ctx);
+
+    return true;
+}
+
+static bool is_link_step_done(struct cmn600_ctx *ctx)
+{
+    struct cxg_wait_condition_data wait_data = {
+        .ctx = ctx,
+        .link_id = ctx->ccix_link.link_id,
+        .cond = ctx->ccix_link.steps[ctx->ccix_link.step].cond,
+    };
+
+    return cxg_link_wait_condition(&wait_data);
+}
+
+/*
+ * Run a link sequence on the links from link_id to last_link_id, one link
+ * after the other. The sequence is carried out by ccix_link_poll() when the
+ * link status is polled from a timer alarm.
+ */
+static int run_link_sequence(struct cmn600_ctx *ctx,
+    const struct cmn600_ccix_link_step *steps, unsigned int step_count,
+    uint8_t link_id, uint8_t last_link_id)
+{
+    int status;
+    struct cmn600_ccix_link_sequence *link = &ctx->ccix_link;
+    struct cxg_wait_condition_data wait_data;
+
+    *link = (struct cmn600_ccix_link_sequence) {
+        .steps = steps,
+        .step_count = step_count,
+        .link_id = link_id,
+        .last_link_id = last_link_id,
+    };
+    start_link_step(ctx);
+
+    if (ctx->config->ccix_poll_period != 0)
+        return FWK_PENDING;
+
+    wait_data.ctx = ctx;
+
+    for (;;) {
+        wait_data.link_id = link->link_id;
+        wait_data.cond = steps[link->step].cond;
+        status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
+                                      steps[link->step].timeout,
+                                      cxg_link_wait_condition,
+                                      &wait_data);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (!next_link_step(ctx))
+            return FWK_SUCCESS;
+    }
+}
+
+/*
+ * Get the last of the links operated on from a link: all the links of the CCIX
+ * configuration from its first link, the link alone otherwise.
+ */
+static uint8_t get_last_link_id(struct cmn600_ctx *ctx, uint8_t link_id)
+{
+    if ((ctx->ccix_link_count != 0) && (link_id == ctx->ccix_link_first))
+        return ctx->ccix_link_first + ctx->ccix_link_count - 1;
+
+    return link_id;
+}
+
+/* Get the link of the nth agent or region, the links being assigned in turn */
+static uint8_t get_striped_link_id(struct cmn600_ctx *ctx, unsigned int idx)
+{
+    return ctx->ccix_link_first + (idx % ctx->ccix_link_count);
+}
+
+static uint8_t get_agent_link_id(struct cmn600_ctx *ctx,
+    struct mod_cmn600_ccix_remote_node_config *config, uint8_t agent_id)
+{
+    if (config->ccix_link_balance == MOD_CMN600_CCIX_LINK_BALANCE_AGENT)
+        return get_striped_link_id(ctx, agent_id);
+
+    return ctx->ccix_link_first;
+}
+
+
 static void program_cxg_ra_rnf_ldid_to_raid_reg(struct cmn600_ctx *ctx,
     uint8_t ldid_value)
 {
@@ -226,38 +405,110 @@ static void program_hnf_ldid_to_chi_node_id_reg(struct cmn600_ctx *ctx,
     }
 }
 
+/*
+ * Assign the home agents of the remote memory regions to the links in turn.
+ * The regions of a home agent follow the link of its first region.
+ */
+static void program_region_agentid_to_linkid(struct cmn600_ctx *ctx,
+    struct mod_cmn600_ccix_remote_node_config *config)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t ha_id;
+
+    for (i = 0; i < config->remote_ha_mmap_count; i++) {
+        ha_id = config->remote_ha_mmap[i].ha_id;
+
+        for (j = 0; j < i; j++) {
+            if (config->remote_ha_mmap[j].ha_id == ha_id)
+                break;
+        }
+
+        if (j == i)
+            program_agentid_to_linkid_reg(ctx, ha_id,
+                get_striped_link_id(ctx, i));
+    }
+}
+
 static void program_cxg_ra_sam_addr_region(struct cmn600_ctx *ctx,
     struct mod_cmn600_ccix_remote_node_config *config)
 {
     uint8_t i;
     uint64_t blocks;
     uint64_t sz;
+    uint64_t ha_id;
 
     for (i = 0; i < config->remote_ha_mmap_count; i++) {
         /* Size must be a multiple of SAM_GRANULARITY */
         fwk_assert((config->remote_ha_mmap[i].size % (64 * 1024)) == 0);
 
+        /*
+         * The regions balanced across the links target their own home agent,
+         * the one of the link of the region.
+         */
+        if (config->ccix_link_balance == MOD_CMN600_CCIX_LINK_BALANCE_REGION)
+            ha_id = config->remote_ha_mmap[i].ha_id;
+        else
+            ha_id = ctx->cxg_ha_id_remote;
+
         blocks = config->remote_ha_mmap[i].size / (64 * 1024);
         sz = fwk_math_log2(blocks);
         ctx->cxg_ra_reg->CXG_RA_SAM_ADDR_REGION_REG[i] =
             sz | (config->remote_ha_mmap[i].base) |
-            ((uint64_t)ctx->cxg_ha_id_remote << SAM_ADDR_HOME_AGENT_ID_SHIFT) |
+            (ha_id << SAM_ADDR_HOME_AGENT_ID_SHIFT) |
             (SAM_ADDR_REG_VALID_MASK);
     }
 }
 
+static int check_ccix_link_config(struct cmn600_ctx *ctx,
+    struct mod_cmn600_ccix_remote_node_config *config)
+{
+    uint8_t link_count;
+    uint8_t i;
+
+    link_count = (config->ccix_link_count == 0) ? 1 : config->ccix_link_count;
+    if ((config->ccix_link_id >= MOD_CMN600_CCIX_LINK_COUNT_MAX) ||
+        (link_count > (MOD_CMN600_CCIX_LINK_COUNT_MAX - config->ccix_link_id)))
+        return FWK_E_PARAM;
+
+    switch (config->ccix_link_balance) {
+    case MOD_CMN600_CCIX_LINK_BALANCE_AGENT:
+        break;
+
+    case MOD_CMN600_CCIX_LINK_BALANCE_REGION:
+        if (config->remote_ha_mmap_count > MAX_HA_MMAP_ENTRIES)
+            return FWK_E_PARAM;
+
+        /* The home agents are mapped to links in 64-entry tables */
+        for (i = 0; i < config->remote_ha_mmap_count; i++) {
+            if (config->remote_ha_mmap[i].ha_id >= 64)
+                return FWK_E_PARAM;
+        }
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
+    ctx->ccix_link_first = config->ccix_link_id;
+    ctx->ccix_link_count = link_count;
+
+    return FWK_SUCCESS;
+}
+
 static int enable_and_start_ccix_link_up_sequence(struct cmn600_ctx *ctx,
     struct mod_cmn600_ccix_remote_node_config *config, uint8_t link_id)
 {
     uint64_t val1;
+    uint64_t bus_num;
+    uint8_t last_link_id;
+    uint8_t id;
     int status;
-    struct cxg_wait_condition_data wait_data;
 
     if (link_id > 2)
         return FWK_E_PARAM;
 
-    wait_data.ctx = ctx;
-    wait_data.link_id = link_id;
+    last_link_id = get_last_link_id(ctx, link_id);
 
     if (config->ccix_opt_tlp)
         ctx->cxla_reg->CXLA_CCIX_PROP_CONFIGURED |= PCIE_OPT_HDR_MASK;
@@ -276,8 +527,11 @@ static int enable_and_start_ccix_link_up_sequence(struct cmn600_ctx *ctx,
         (CXLA_CCIX_PROP_MAX_PACK_SIZE_512 <<
         CXLA_CCIX_PROP_MAX_PACK_SIZE_SHIFT_VAL);
 
-    ctx->cxla_reg->CXLA_LINKID_TO_PCIE_BUS_NUM =
-        ((uint64_t)config->pcie_bus_num << (link_id * 16));
+    /* The links are all carried by the PCIe bus of the configuration */
+    bus_num = 0;
+    for (id = link_id; id <= last_link_id; id++)
+        bus_num |= (uint64_t)config->pcie_bus_num << (id * 16);
+    ctx->cxla_reg->CXLA_LINKID_TO_PCIE_BUS_NUM = bus_num;
 
     /* Set up TC1 for PCIe so CCIx uses VC1 */
     val1 = ctx->cxla_reg->CXLA_PCIE_HDR_FIELDS &
@@ -294,99 +548,30 @@ static int enable_and_start_ccix_link_up_sequence(struct cmn600_ctx *ctx,
         val1 | ((uint64_t)CCIX_VENDER_ID <<
         CXLA_PCIE_HDR_VENDOR_ID_SHIFT_VAL);
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
         MOD_NAME "CXLA_PCIE_HDR_FIELDS: 0x%lx\n",
         ctx->cxla_reg->CXLA_PCIE_HDR_FIELDS);
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
-        MOD_NAME "Enabling CCIX link %d...", link_id);
-    /* Set link enable bit to enable the CCIX link */
-    ctx->cxg_ra_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL =
-        CXG_LINK_CTRL_EN_MASK;
-    ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL =
-        CXG_LINK_CTRL_EN_MASK;
-
-    /* Wait until link enable bits are set */
-    wait_data.cond = CXG_LINK_CTRL_EN_BIT_SET;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                  CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                  cxg_link_wait_condition,
-                                  &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+        MOD_NAME "Bringing up CCIX links %d to %d...\n", link_id,
+        last_link_id);
+    /* Set link enable bit to enable the CCIX links */
+    for (id = link_id; id <= last_link_id; id++) {
+        ctx->cxg_ra_reg->LINK_REGS[id].CXG_PRTCL_LINK_CTRL =
+            CXG_LINK_CTRL_EN_MASK;
+        ctx->cxg_ha_reg->LINK_REGS[id].CXG_PRTCL_LINK_CTRL =
+            CXG_LINK_CTRL_EN_MASK;
     }
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, "Done\n");
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
-        MOD_NAME "Verifying link down status...");
-    /* Wait till link up bits are cleared in control register */
-    wait_data.cond = CXG_LINK_CTRL_UP_BIT_CLR;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                  CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                  cxg_link_wait_condition,
-                                  &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
-    }
-
-    /* Wait till link down bits are set in status register */
-    wait_data.cond = CXG_LINK_STATUS_DWN_BIT_SET;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                  CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                  cxg_link_wait_condition,
-                                  &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
+    status = run_link_sequence(ctx, link_up_sequence,
+        FWK_ARRAY_SIZE(link_up_sequence), link_id, last_link_id);
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_INFO,
+            MOD_NAME "CCIX link %d bring-up failed\n",
+            ctx->ccix_link.link_id);
     }
 
-    /* Wait till link ACK bits are cleared in status register */
-    wait_data.cond = CXG_LINK_STATUS_ACK_BIT_CLR;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                   CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                   cxg_link_wait_condition,
-                                   &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
-    }
-
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, "Done\n");
-
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, MOD_NAME "Bringing up link...");
-
-    /* Bring up link using link request bit */
-    ctx->cxg_ra_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
-        CXG_LINK_CTRL_REQ_MASK;
-    ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
-        CXG_LINK_CTRL_REQ_MASK;
-
-    /* Wait till link ACK bits are set in status register */
-    wait_data.cond = CXG_LINK_STATUS_ACK_BIT_SET;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                   CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                   cxg_link_wait_condition,
-                                   &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
-    }
-
-
-    /* Wait till link down bits are cleared in status register */
-    wait_data.cond = CXG_LINK_STATUS_DWN_BIT_CLR;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                   CXG_PRTCL_LINK_CTRL_TIMEOUT,
-                                   cxg_link_wait_condition,
-                                   &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
-    }
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, "Done\n");
-    return FWK_SUCCESS;
+    return status;
 }
 
 int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
@@ -403,8 +588,12 @@ int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
     struct mod_cmn600_ccix_remote_node_config * ccix_remote_config =
         (struct mod_cmn600_ccix_remote_node_config *)remote_config;
 
+    status = check_ccix_link_config(ctx, ccix_remote_config);
+    if (status != FWK_SUCCESS)
+        return status;
+
     cmn600_setup_sam((struct cmn600_rnsam_reg *)((uint32_t)ctx->cxg_ra_reg));
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
         MOD_NAME "Programming CCIX gateway...\n");
 
     /*
@@ -431,7 +620,7 @@ int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
          * remote agents in CXRA/CXHA/CXLA
          */
         program_agentid_to_linkid_reg(ctx, agent_id,
-            ccix_remote_config->ccix_link_id);
+            get_agent_link_id(ctx, ccix_remote_config, agent_id));
 
         /*
          * The HN-F ldid to CHI node id valid bit for
@@ -473,7 +662,7 @@ int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
 
         /* Program agentid to linkid LUT for remote agents */
         program_agentid_to_linkid_reg(ctx, agent_id,
-            ccix_remote_config->ccix_link_id);
+            get_agent_link_id(ctx, ccix_remote_config, agent_id));
     }
 
     for (i = 0; i < ctx->rni_count; i++) {
@@ -488,9 +677,13 @@ int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
 
         /* Program agentid to linkid LUT for remote agents */
         program_agentid_to_linkid_reg(ctx, agent_id,
-            ccix_remote_config->ccix_link_id);
+            get_agent_link_id(ctx, ccix_remote_config, agent_id));
     }
 
+    if (ccix_remote_config->ccix_link_balance ==
+        MOD_CMN600_CCIX_LINK_BALANCE_REGION)
+        program_region_agentid_to_linkid(ctx, ccix_remote_config);
+
     program_cxg_ra_sam_addr_region(ctx, ccix_remote_config);
     status = enable_and_start_ccix_link_up_sequence(ctx, ccix_remote_config,
         ccix_remote_config->ccix_link_id);
@@ -500,49 +693,67 @@ int ccix_setup(struct cmn600_ctx *ctx, void *remote_config)
 
 int ccix_exchange_protocol_credit(struct cmn600_ctx *ctx, uint8_t link_id)
 {
+    uint8_t last_link_id;
+    uint8_t id;
 
     if (link_id > 2)
         return FWK_E_PARAM;
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
-        MOD_NAME "Exchanging protocol credits for link %d...", link_id);
+    last_link_id = get_last_link_id(ctx, link_id);
+
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+        MOD_NAME "Exchanging protocol credits for links %d to %d...", link_id,
+        last_link_id);
     /* Exchange protocol credits using link up bit */
-    ctx->cxg_ra_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
-        CXG_LINK_CTRL_UP_MASK;
-    ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
-        CXG_LINK_CTRL_UP_MASK;
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, "Done\n");
+    for (id = link_id; id <= last_link_id; id++) {
+        ctx->cxg_ra_reg->LINK_REGS[id].CXG_PRTCL_LINK_CTRL |=
+            CXG_LINK_CTRL_UP_MASK;
+        ctx->cxg_ha_reg->LINK_REGS[id].CXG_PRTCL_LINK_CTRL |=
+            CXG_LINK_CTRL_UP_MASK;
+    }
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG, "Done\n");
     return FWK_SUCCESS;
 }
 
 int ccix_enter_system_coherency(struct cmn600_ctx *ctx, uint8_t link_id)
 {
-    struct cxg_wait_condition_data wait_data;
     int status;
 
     if (link_id > 2)
         return FWK_E_PARAM;
 
-    wait_data.ctx = ctx;
-    wait_data.link_id = link_id;
-
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
-        MOD_NAME "Entering system coherency for link %d...", link_id);
-    /* Enter system coherency by setting DVMDOMAIN request bit */
-    ctx->cxg_ha_reg->LINK_REGS[link_id].CXG_PRTCL_LINK_CTRL |=
-        CXG_LINK_CTRL_DVMDOMAIN_REQ_MASK;
-
-    /* Wait till DVMDOMAIN ACK bit is set in status register */
-    wait_data.cond = CXG_LINK_STATUS_DVMDOMAIN_ACK_BIT_SET;
-    status = ctx->timer_api->wait(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                  CXG_PRTCL_LINK_DVMDOMAIN_TIMEOUT,
-                                  cxg_link_wait_condition,
-                                  &wait_data);
-    if (status != FWK_SUCCESS) {
-        ctx->log_api->log(MOD_LOG_GROUP_INFO, "Failed\n");
-        return status;
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+        MOD_NAME "Entering system coherency for link %d...\n", link_id);
+
+    status = run_link_sequence(ctx, system_coherency_sequence,
+        FWK_ARRAY_SIZE(system_coherency_sequence), link_id,
+        get_last_link_id(ctx, link_id));
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_INFO,
+            MOD_NAME "Link %d failed to enter system coherency\n",
+            ctx->ccix_link.link_id);
     }
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, "Done\n");
-    return FWK_SUCCESS;
+    return status;
+}
+
+int ccix_link_poll(struct cmn600_ctx *ctx)
+{
+    struct cmn600_ccix_link_sequence *link = &ctx->ccix_link;
+
+    fwk_assert(link->step < link->step_count);
+
+    while (is_link_step_done(ctx)) {
+        if (!next_link_step(ctx))
+            return FWK_SUCCESS;
+    }
+
+    link->wait_time += ctx->config->ccix_poll_period;
+    if (link->wait_time < link->steps[link->step].timeout)
+        return FWK_PENDING;
+
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_INFO,
+        MOD_NAME "CCIX link %d timed out\n", link->link_id);
+
+    return FWK_E_TIMEOUT;
 }
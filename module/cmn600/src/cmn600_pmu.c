@@ -0,0 +1,247 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <mod_cmn600.h>
+#include <mod_log.h>
+#include <cmn600.h>
+#include <internal/cmn600_ctx.h>
+#include <internal/cmn600_pmu.h>
+
+#define MOD_NAME "[CMN600] "
+
+/* A counter is made of a 32-bit global counter and a 16-bit local counter */
+#define PMU_COUNTER_MASK ((UINT64_C(1) << (CMN600_DT_PMEVCNT_BITS_WIDTH + \
+    CMN600_DTM_PMEVCNT_BITS_WIDTH)) - 1)
+
+static struct cmn600_mxp_reg *find_xp(struct cmn600_ctx *ctx,
+    unsigned int node_id)
+{
+    unsigned int xp_idx;
+    unsigned int xp_count;
+    struct cmn600_mxp_reg *xp;
+
+    xp_count = get_node_child_count(ctx->root);
+    for (xp_idx = 0; xp_idx < xp_count; xp_idx++) {
+        xp = get_child_node(ctx->config->base, ctx->root, xp_idx);
+        if (get_node_id(xp) == (node_id & ~CMN600_NODE_ID_XP_MASK))
+            return xp;
+    }
+
+    return NULL;
+}
+
+static void *find_node(struct cmn600_ctx *ctx, struct cmn600_mxp_reg *xp,
+    unsigned int node_id)
+{
+    unsigned int node_idx;
+    unsigned int node_count;
+    void *node;
+
+    node_count = get_node_child_count(xp);
+    for (node_idx = 0; node_idx < node_count; node_idx++) {
+        if (is_child_external(xp, node_idx))
+            continue;
+
+        node = get_child_node(ctx->config->base, xp, node_idx);
+        if (get_node_id(node) == node_id)
+            return node;
+    }
+
+    return NULL;
+}
+
+int pmu_discovery(struct cmn600_ctx *ctx)
+{
+    unsigned int counter_idx;
+    unsigned int idx;
+    const struct mod_cmn600_pmu_counter_config *counter_config;
+    struct cmn600_pmu_counter *counter;
+    const struct mod_cmn600_config *config = ctx->config;
+
+    if (ctx->dtc_reg == NULL)
+        return FWK_E_DEVICE;
+
+    ctx->pmu_counter_table = fwk_mm_calloc(config->pmu_counter_count,
+        sizeof(ctx->pmu_counter_table[0]));
+    if (ctx->pmu_counter_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (counter_idx = 0; counter_idx < config->pmu_counter_count;
+         counter_idx++) {
+        counter_config = &config->pmu_counter_table[counter_idx];
+        counter = &ctx->pmu_counter_table[counter_idx];
+
+        counter->xp = find_xp(ctx, counter_config->node_id);
+        if (counter->xp == NULL)
+            return FWK_E_DATA;
+
+        if (counter_config->source == MOD_CMN600_PMU_EVENT_SOURCE_XP)
+            counter->node = counter->xp;
+        else {
+            counter->node = find_node(ctx, counter->xp,
+                counter_config->node_id);
+            if (counter->node == NULL)
+                return FWK_E_DATA;
+        }
+
+        /* The counters of a crosspoint are allocated in order */
+        for (idx = 0; idx < counter_idx; idx++) {
+            if (ctx->pmu_counter_table[idx].xp == counter->xp)
+                counter->dtm_idx++;
+        }
+        if (counter->dtm_idx >= CMN600_DTM_PMEVCNT_COUNT)
+            return FWK_E_DATA;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/* Raw value of a counter, from its global and local counters */
+static uint64_t read_counter(struct cmn600_ctx *ctx, unsigned int counter_idx)
+{
+    const struct cmn600_pmu_counter *counter =
+        &ctx->pmu_counter_table[counter_idx];
+    unsigned int global_shift =
+        (counter_idx % 2) * CMN600_DT_PMEVCNT_BITS_WIDTH;
+    unsigned int local_shift =
+        counter->dtm_idx * CMN600_DTM_PMEVCNT_BITS_WIDTH;
+    FWK_RW uint64_t *global_reg = &ctx->dtc_reg->PMEVCNT[(counter_idx / 2) * 2];
+    uint32_t global;
+    uint32_t global_check;
+    uint64_t local;
+
+    /* The global counter is incremented when the local counter wraps */
+    global = (uint32_t)(*global_reg >> global_shift);
+    do {
+        global_check = global;
+        local = (counter->xp->PMEVCNT[0] >> local_shift) &
+            CMN600_DTM_PMEVCNT_MASK;
+        global = (uint32_t)(*global_reg >> global_shift);
+    } while (global != global_check);
+
+    return ((uint64_t)global << CMN600_DTM_PMEVCNT_BITS_WIDTH) | local;
+}
+
+void pmu_setup(struct cmn600_ctx *ctx)
+{
+    unsigned int counter_idx;
+    unsigned int event_shift;
+    unsigned int port;
+    unsigned int input_shift;
+    unsigned int global_shift;
+    uint64_t input_sel;
+    uint64_t pmu_config;
+    const struct mod_cmn600_pmu_counter_config *counter_config;
+    struct cmn600_pmu_counter *counter;
+    FWK_RW uint64_t *event_sel;
+    struct mod_cmn600_pmu_telemetry *telemetry;
+    const struct mod_cmn600_config *config = ctx->config;
+
+    ctx->dtc_reg->DTC_CTL |= CMN600_DT_DTC_CTL_DT_EN;
+
+    for (counter_idx = 0; counter_idx < config->pmu_counter_count;
+         counter_idx++) {
+        counter_config = &config->pmu_counter_table[counter_idx];
+        counter = &ctx->pmu_counter_table[counter_idx];
+
+        /* The event is selected in the event slot of the DTM counter */
+        event_sel = (FWK_RW uint64_t *)
+            ((uintptr_t)counter->node + CMN600_PMU_EVENT_SEL_OFFSET);
+        event_shift = counter->dtm_idx * CMN600_PMU_EVENT_SEL_BITS_WIDTH;
+        *event_sel = (*event_sel &
+            ~(CMN600_PMU_EVENT_SEL_MASK << event_shift)) |
+            ((uint64_t)counter_config->event << event_shift);
+
+        if (counter_config->source == MOD_CMN600_PMU_EVENT_SOURCE_XP)
+            input_sel = CMN600_DTM_PMU_CONFIG_INPUT_SEL_XP + counter->dtm_idx;
+        else {
+            port = (counter_config->node_id >> CMN600_NODE_ID_PORT_POS) &
+                CMN600_NODE_ID_PORT_MASK;
+            input_sel = CMN600_DTM_PMU_CONFIG_INPUT_SEL_DEVICE +
+                (port * CMN600_DTM_PMU_CONFIG_INPUT_SEL_DEVICE_PER_PORT) +
+                counter->dtm_idx;
+        }
+
+        /* Pair the DTM counter with the global counter of the same index */
+        input_shift = CMN600_DTM_PMU_CONFIG_INPUT_SEL_POS +
+            counter->dtm_idx * CMN600_DTM_PMU_CONFIG_INPUT_SEL_BITS_WIDTH;
+        global_shift = CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_POS +
+            counter->dtm_idx * CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_BITS_WIDTH;
+
+        pmu_config = counter->xp->DTM_PMU_CONFIG;
+        pmu_config &= ~(CMN600_DTM_PMU_CONFIG_INPUT_SEL_MASK << input_shift);
+        pmu_config &= ~(CMN600_DTM_PMU_CONFIG_GLOBAL_NUM_MASK << global_shift);
+        pmu_config |= input_sel << input_shift;
+        pmu_config |= (uint64_t)counter_idx << global_shift;
+        counter->xp->DTM_PMU_CONFIG = pmu_config | CMN600_DTM_PMU_CONFIG_PMU_EN;
+
+        counter->xp->DTM_CONTROL |= CMN600_DTM_CONTROL_DTM_ENABLE;
+    }
+
+    ctx->dtc_reg->PMCR |= CMN600_DT_PMCR_PMU_EN;
+
+    if (config->pmu_telemetry_address != 0) {
+        telemetry = (struct mod_cmn600_pmu_telemetry *)
+            config->pmu_telemetry_address;
+        telemetry->sequence = 0;
+        telemetry->counter_count = 0;
+    }
+
+    /* Count from the current value of the counters */
+    for (counter_idx = 0; counter_idx < config->pmu_counter_count;
+         counter_idx++) {
+        counter = &ctx->pmu_counter_table[counter_idx];
+        counter->last_value = read_counter(ctx, counter_idx);
+        counter->value = 0;
+    }
+
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+        MOD_NAME "%d PMU counters set up\n", config->pmu_counter_count);
+}
+
+void pmu_sample(struct cmn600_ctx *ctx, uint64_t timestamp)
+{
+    unsigned int counter_idx;
+    uint64_t value;
+    struct cmn600_pmu_counter *counter;
+    struct mod_cmn600_pmu_telemetry *telemetry;
+    const struct mod_cmn600_config *config = ctx->config;
+
+    for (counter_idx = 0; counter_idx < config->pmu_counter_count;
+         counter_idx++) {
+        counter = &ctx->pmu_counter_table[counter_idx];
+
+        value = read_counter(ctx, counter_idx);
+        counter->value += (value - counter->last_value) & PMU_COUNTER_MASK;
+        counter->last_value = value;
+    }
+
+    ctx->pmu_timestamp = timestamp;
+
+    if (config->pmu_telemetry_address == 0)
+        return;
+
+    telemetry = (struct mod_cmn600_pmu_telemetry *)
+        config->pmu_telemetry_address;
+
+    telemetry->sequence++;
+    __sync_synchronize();
+
+    telemetry->counter_count = config->pmu_counter_count;
+    telemetry->timestamp = timestamp;
+    for (counter_idx = 0; counter_idx < config->pmu_counter_count;
+         counter_idx++)
+        telemetry->counter[counter_idx] =
+            ctx->pmu_counter_table[counter_idx].value;
+
+    __sync_synchronize();
+    telemetry->sequence++;
+}
@@ -15,6 +15,7 @@
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <mod_clock.h>
 #include <mod_cmn600.h>
 #include <mod_log.h>
@@ -22,60 +23,88 @@
 #include <cmn600.h>
 #include <internal/cmn600_ccix.h>
 #include <internal/cmn600_ctx.h>
+#include <internal/cmn600_pmu.h>
 #include <mod_ppu_v1.h>
 
 #define MOD_NAME "[CMN600] "
 
+/* Parameters of the deferred alarms of the module */
+enum cmn600_alarm {
+    CMN600_ALARM_CCIX_LINK,
+    CMN600_ALARM_PMU,
+};
+
 struct cmn600_ctx *ctx;
 
+/*
+ * Compute the SAM control of the HN-F nodes striping the memory across three
+ * SN-F nodes.
+ */
+static uint64_t get_three_sn_sam_control(
+    const struct mod_cmn600_snf_striping *striping)
+{
+    return ((uint64_t)striping->node_id[0] <<
+                CMN600_HNF_SAM_CONTROL_SN0_POS) |
+           ((uint64_t)striping->node_id[1] <<
+                CMN600_HNF_SAM_CONTROL_SN1_POS) |
+           ((uint64_t)striping->node_id[2] <<
+                CMN600_HNF_SAM_CONTROL_SN2_POS) |
+           ((uint64_t)striping->top_address_bit[0] <<
+                CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT0_POS) |
+           ((uint64_t)striping->top_address_bit[1] <<
+                CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT1_POS) |
+           CMN600_HNF_SAM_CONTROL_THREE_SN_EN;
+}
+
 static void process_node_hnf(struct cmn600_hnf_reg *hnf)
 {
     unsigned int logical_id;
-    unsigned int group;
-    unsigned int bit_pos;
     unsigned int region_idx;
-    unsigned int region_sub_count = 0;
-    const struct mod_cmn600_memory_region_map *region;
     const struct mod_cmn600_config *config = ctx->config;
 
-    logical_id = get_node_logical_id(hnf);
+    /* Set target nodes */
+    if (config->snf_mode == MOD_CMN600_SNF_MODE_THREE_SN)
+        hnf->SAM_CONTROL = get_three_sn_sam_control(&config->snf_striping);
+    else {
+        logical_id = get_node_logical_id(hnf);
 
-    assert(logical_id < config->snf_count);
+        assert(logical_id < config->snf_count);
 
-    group = logical_id / CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP;
-    bit_pos = CMN600_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH *
-              (logical_id % CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP);
+        hnf->SAM_CONTROL = config->snf_table[logical_id];
+    }
 
-    ctx->hnf_cache_group[group] += ((uint64_t)get_node_id(hnf)) << bit_pos;
+    /* Map sub-regions to this HN-F node */
+    for (region_idx = 0; region_idx < ctx->hnf_sub_region_count; region_idx++)
+        hnf->SAM_MEMREGION[region_idx] = ctx->hnf_sub_region[region_idx];
 
-    /* Set target node */
-    hnf->SAM_CONTROL = config->snf_table[logical_id];
+    /* Configure the system cache RAM PPU */
+    hnf->PPU_PWPR = CMN600_PPU_PWPR_POLICY_ON |
+                    CMN600_PPU_PWPR_OPMODE_FAM |
+                    CMN600_PPU_PWPR_DYN_EN;
+}
 
-    /*
-     * Map sub-regions to this HN-F node
-     */
-    for (region_idx = 0; region_idx < config->mmap_count; region_idx++) {
-        region = &config->mmap_table[region_idx];
+static void apply_reg_updates(volatile uint64_t *reg,
+    const struct cmn600_reg_update *update, unsigned int count)
+{
+    unsigned int idx;
 
-        /* Skip non sub-regions */
-        if (region->type != MOD_CMN600_REGION_TYPE_SYSCACHE_SUB)
+    for (idx = 0; idx < count; idx++) {
+        if (update[idx].mask == 0)
             continue;
 
-        /* Configure sub-region entry */
-        hnf->SAM_MEMREGION[region_sub_count] = region->node_id |
-            (sam_encode_region_size(region->size) <<
-                CMN600_HNF_SAM_MEMREGION_SIZE_POS) |
-            ((region->base / SAM_GRANULARITY) <<
-                CMN600_HNF_SAM_MEMREGION_BASE_POS) |
-            CMN600_HNF_SAM_MEMREGION_VALID;
-
-        region_sub_count++;
+        if (update[idx].mask == UINT64_MAX)
+            reg[idx] = update[idx].value;
+        else
+            reg[idx] = (reg[idx] & ~update[idx].mask) | update[idx].value;
     }
+}
 
-    /* Configure the system cache RAM PPU */
-    hnf->PPU_PWPR = CMN600_PPU_PWPR_POLICY_ON |
-                    CMN600_PPU_PWPR_OPMODE_FAM |
-                    CMN600_PPU_PWPR_DYN_EN;
+static void set_reg_update(struct cmn600_reg_update *update,
+    unsigned int bit_pos, uint64_t mask, uint64_t value)
+{
+    update->mask |= mask << bit_pos;
+    update->value &= ~(mask << bit_pos);
+    update->value |= (value & mask) << bit_pos;
 }
 
 /*
@@ -94,7 +123,8 @@ static int cmn600_discovery(void)
     struct node_header *node;
     const struct mod_cmn600_config *config = ctx->config;
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, MOD_NAME "Starting discovery...\n");
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+            MOD_NAME "Starting discovery...\n");
 
     assert(get_node_type(ctx->root) == NODE_TYPE_CFG);
 
@@ -105,8 +135,8 @@ static int cmn600_discovery(void)
         xp = get_child_node(config->base, ctx->root, xp_idx);
         assert(get_node_type(xp) == NODE_TYPE_XP);
 
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG, MOD_NAME "\n");
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG, MOD_NAME "\n");
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
             MOD_NAME "XP (%d, %d) ID:%d, LID:%d\n",
             get_node_pos_x(xp),
             get_node_pos_y(xp),
@@ -126,7 +156,7 @@ static int cmn600_discovery(void)
             if (get_child_node_id(xp, node_idx) == config->cxgla_node_id)
                 ctx->cxla_reg = (void *)node;
 
-            ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+            MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
                     MOD_NAME "  Found external node ID:%d\n",
                     get_child_node_id(xp, node_idx));
 
@@ -134,13 +164,13 @@ static int cmn600_discovery(void)
             } else {
                 switch (get_node_type(node)) {
                 case NODE_TYPE_HN_F:
-                    if ((ctx->hnf_count++) >= MAX_HNF_COUNT) {
-                        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+                    if (ctx->hnf_count >= MAX_HNF_COUNT) {
+                        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
                                 MOD_NAME "  hnf count %d >= max limit (%d)\n",
-                                ctx->hnf_count, MAX_HNF_COUNT);
+                                ctx->hnf_count + 1, MAX_HNF_COUNT);
                         return FWK_E_DATA;
                     }
-                    ctx->hnf_offset[ctx->hnf_count] = (uint32_t)node;
+                    ctx->hnf_offset[ctx->hnf_count++] = (uint32_t)node;
                     break;
 
                 case NODE_TYPE_RN_SAM:
@@ -148,23 +178,23 @@ static int cmn600_discovery(void)
                     break;
 
                 case NODE_TYPE_RN_D:
-                    if ((ctx->rnd_count++) >= MAX_RND_COUNT) {
-                        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+                    if (ctx->rnd_count >= MAX_RND_COUNT) {
+                        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
                                 MOD_NAME "  rnd count %d >= max limit (%d)\n",
-                                ctx->rnd_count, MAX_RND_COUNT);
+                                ctx->rnd_count + 1, MAX_RND_COUNT);
                         return FWK_E_DATA;
                     }
-                    ctx->rnd_ldid[ctx->rnd_count] = get_node_logical_id(node);
+                    ctx->rnd_ldid[ctx->rnd_count++] = get_node_logical_id(node);
                     break;
 
                 case NODE_TYPE_RN_I:
-                    if ((ctx->rni_count++) >= MAX_RNI_COUNT) {
-                        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+                    if (ctx->rni_count >= MAX_RNI_COUNT) {
+                        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
                                 MOD_NAME "  rni count %d >= max limit (%d)\n",
-                                ctx->rni_count, MAX_RNI_COUNT);
+                                ctx->rni_count + 1, MAX_RNI_COUNT);
                         return FWK_E_DATA;
                     }
-                    ctx->rni_ldid[ctx->rni_count] = get_node_logical_id(node);
+                    ctx->rni_ldid[ctx->rni_count++] = get_node_logical_id(node);
                     break;
 
                 case NODE_TYPE_CXRA:
@@ -176,12 +206,17 @@ static int cmn600_discovery(void)
                     ctx->ccix_host_info.host_ha_count++;
                     break;
 
+                case NODE_TYPE_DTC:
+                    if (ctx->dtc_reg == NULL)
+                        ctx->dtc_reg = (struct cmn600_dt_reg *)node;
+                    break;
+
                 default:
                     /* Nothing to be done for other node types */
                     break;
                 }
 
-                ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+                MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
                     MOD_NAME "  %s ID:%d, LID:%d\n",
                     get_node_type_name(get_node_type(node)),
                     get_node_id(node),
@@ -190,7 +225,7 @@ static int cmn600_discovery(void)
         }
     }
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
         MOD_NAME "Total internal RN-SAM nodes: %d\n"
         MOD_NAME "Total external RN-SAM nodes: %d\n"
         MOD_NAME "Total HN-F nodes: %d\n"
@@ -203,24 +238,66 @@ static int cmn600_discovery(void)
         ctx->rni_count);
 
     if (ctx->cxla_reg) {
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
             MOD_NAME "CCIX CXLA node at: 0x%08x\n",
             (uint32_t)ctx->cxla_reg);
     }
     if (ctx->cxg_ra_reg) {
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
             MOD_NAME "CCIX CXRA node at: 0x%08x\n",
             (uint32_t)ctx->cxg_ra_reg);
     }
     if (ctx->cxg_ha_reg) {
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
             MOD_NAME "CCIX CXHA node at: 0x%08x\n",
             (uint32_t)ctx->cxg_ha_reg);
     }
     return FWK_SUCCESS;
 }
 
-static void cmn600_configure(void)
+/*
+ * Check the partition of the HN-F nodes found by the discovery into system
+ * cache groups. The HN-F nodes are expected to have the logical identifiers 0
+ * to the number of HN-F nodes minus one, and each group to have a node.
+ */
+static int cmn600_check_hnf_partition(void)
+{
+    uint32_t scg1_mask = ctx->config->hnf_scg1_mask;
+
+    if (((uint64_t)scg1_mask >> ctx->hnf_count) != 0)
+        return FWK_E_DATA;
+
+    ctx->hnf_scg1_count = __builtin_popcount(scg1_mask);
+    if ((scg1_mask != 0) && (ctx->hnf_scg1_count == ctx->hnf_count))
+        return FWK_E_DATA;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Get the entry of an HN-F node in the cache groups. The entries list the
+ * nodes of the first system cache group then those of the second one, each in
+ * the order of their logical identifiers.
+ */
+static unsigned int get_hnf_cache_group_entry(unsigned int logical_id)
+{
+    uint32_t scg1_mask = ctx->config->hnf_scg1_mask;
+    uint32_t lower_mask = (uint32_t)(fwk_math_pow2((uint64_t)logical_id) - 1);
+
+    if ((scg1_mask & fwk_math_pow2((uint64_t)logical_id)) == 0)
+        return __builtin_popcount(~scg1_mask & lower_mask);
+
+    return (ctx->hnf_count - ctx->hnf_scg1_count) +
+        __builtin_popcount(scg1_mask & lower_mask);
+}
+
+/*
+ * Record the RN-SAM nodes and the HN-F cache groups found by the discovery.
+ * The mesh only needs to be traversed once: later setups, for instance when
+ * the interconnect is powered on again after a system suspend, are driven by
+ * the tables built here.
+ */
+static void cmn600_build_topology(void)
 {
     unsigned int xp_count;
     unsigned int xp_idx;
@@ -228,6 +305,11 @@ static void cmn600_configure(void)
     unsigned int node_idx;
     unsigned int xrnsam_entry;
     unsigned int irnsam_entry;
+    unsigned int hnf_idx;
+    unsigned int entry;
+    unsigned int group;
+    unsigned int bit_pos;
+    struct cmn600_hnf_reg *hnf;
     struct cmn600_mxp_reg *xp;
     void *node;
     const struct mod_cmn600_config *config = ctx->config;
@@ -257,20 +339,35 @@ static void cmn600_configure(void)
                 ctx->external_rnsam_table[xrnsam_entry].node = node;
 
                 xrnsam_entry++;
-            } else {
-                enum node_type node_type = get_node_type(node);
-
-                if (node_type == NODE_TYPE_RN_SAM) {
-                    fwk_assert(irnsam_entry < ctx->internal_rnsam_count);
+            } else if (get_node_type(node) == NODE_TYPE_RN_SAM) {
+                fwk_assert(irnsam_entry < ctx->internal_rnsam_count);
 
-                    ctx->internal_rnsam_table[irnsam_entry] = node;
+                ctx->internal_rnsam_table[irnsam_entry] = node;
 
-                    irnsam_entry++;
-                } else if (node_type == NODE_TYPE_HN_F)
-                    process_node_hnf(node);
+                irnsam_entry++;
             }
         }
     }
+
+    /* HN-F nodes were recorded by the discovery */
+    for (hnf_idx = 0; hnf_idx < ctx->hnf_count; hnf_idx++) {
+        hnf = (struct cmn600_hnf_reg *)ctx->hnf_offset[hnf_idx];
+        entry = get_hnf_cache_group_entry(get_node_logical_id(hnf));
+
+        group = entry / CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP;
+        bit_pos = CMN600_HNF_CACHE_GROUP_ENTRY_BITS_WIDTH *
+                  (entry % CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP);
+
+        ctx->hnf_cache_group[group] |= ((uint64_t)get_node_id(hnf)) << bit_pos;
+    }
+}
+
+static void cmn600_configure(void)
+{
+    unsigned int hnf_idx;
+
+    for (hnf_idx = 0; hnf_idx < ctx->hnf_count; hnf_idx++)
+        process_node_hnf((struct cmn600_hnf_reg *)ctx->hnf_offset[hnf_idx]);
 }
 
 static const char * const mmap_type_name[] = {
@@ -280,24 +377,27 @@ static const char * const mmap_type_name[] = {
     [MOD_CMN600_REGION_TYPE_CCIX] = "CCIX",
 };
 
-int cmn600_setup_sam(struct cmn600_rnsam_reg *rnsam)
+/*
+ * Compute the RN-SAM and HN-F register contents that only depend on the memory
+ * map and on the HN-F nodes found by the discovery.
+ */
+static int cmn600_build_register_image(void)
 {
     unsigned int region_idx;
     unsigned int region_io_count = 0;
+    unsigned int region_sys_count = 0;
     const struct mod_cmn600_memory_region_map *region;
     const struct mod_cmn600_config *config = ctx->config;
+    struct cmn600_rnsam_image *image = &ctx->rnsam_image;
     unsigned int bit_pos;
     unsigned int group;
-    unsigned int group_count;
     enum sam_node_type sam_node_type;
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
-        MOD_NAME "Configuring SAM for node %d\n",
-        get_node_id(rnsam));
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG, MOD_NAME "Memory map:\n");
 
     for (region_idx = 0; region_idx < config->mmap_count; region_idx++) {
         region = &config->mmap_table[region_idx];
-        ctx->log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
             MOD_NAME "  [0x%lx - 0x%lx] %s\n",
             region->base,
             region->base + region->size - 1,
@@ -310,17 +410,19 @@ int cmn600_setup_sam(struct cmn600_rnsam_reg *rnsam)
         switch (region->type) {
         case MOD_CMN600_MEMORY_REGION_TYPE_IO:
         case MOD_CMN600_REGION_TYPE_CCIX:
+            if (group >= FWK_ARRAY_SIZE(image->non_hash_mem_region))
+                return FWK_E_DATA;
+
             /*
              * Configure memory region
              */
             sam_node_type =
                 (region->type == MOD_CMN600_MEMORY_REGION_TYPE_IO) ?
                     SAM_NODE_TYPE_HN_I : SAM_NODE_TYPE_CXRA;
-            configure_region(&rnsam->NON_HASH_MEM_REGION[group],
+            set_reg_update(&image->non_hash_mem_region[group],
                 bit_pos,
-                region->base,
-                region->size,
-                sam_node_type);
+                CMN600_RNSAM_REGION_ENTRY_MASK,
+                sam_encode_region(region->base, region->size, sam_node_type));
             /*
              * Configure target node
              */
@@ -330,27 +432,51 @@ int cmn600_setup_sam(struct cmn600_rnsam_reg *rnsam)
                       (region_io_count %
                        CMN600_RNSAM_NON_HASH_TGT_NODEID_ENTRIES_PER_GROUP);
 
-            rnsam->NON_HASH_TGT_NODEID[group] &=
-                ~(CMN600_RNSAM_NON_HASH_TGT_NODEID_ENTRY_MASK << bit_pos);
-            rnsam->NON_HASH_TGT_NODEID[group] |= (region->node_id &
-                CMN600_RNSAM_NON_HASH_TGT_NODEID_ENTRY_MASK) << bit_pos;
+            if (group >= FWK_ARRAY_SIZE(image->non_hash_tgt_nodeid))
+                return FWK_E_DATA;
+
+            set_reg_update(&image->non_hash_tgt_nodeid[group],
+                bit_pos,
+                CMN600_RNSAM_NON_HASH_TGT_NODEID_ENTRY_MASK,
+                region->node_id);
 
             region_io_count++;
             break;
 
         case MOD_CMN600_MEMORY_REGION_TYPE_SYSCACHE:
+            /* The system cache regions are mapped to the groups in order */
+            group = region_sys_count / CMN600_RNSAM_REGION_ENTRIES_PER_GROUP;
+            bit_pos = CMN600_RNSAM_REGION_ENTRY_BITS_WIDTH *
+                      (region_sys_count %
+                       CMN600_RNSAM_REGION_ENTRIES_PER_GROUP);
+
+            if (group >= FWK_ARRAY_SIZE(image->sys_cache_grp_region))
+                return FWK_E_DATA;
+
             /*
              * Configure memory region
              */
-            configure_region(&rnsam->SYS_CACHE_GRP_REGION[group],
+            set_reg_update(&image->sys_cache_grp_region[group],
                 bit_pos,
-                region->base,
-                region->size,
-                SAM_NODE_TYPE_HN_F);
-           break;
+                CMN600_RNSAM_REGION_ENTRY_MASK,
+                sam_encode_region(region->base, region->size,
+                    SAM_NODE_TYPE_HN_F));
+
+            region_sys_count++;
+            break;
 
         case MOD_CMN600_REGION_TYPE_SYSCACHE_SUB:
-            /* Do nothing. System cache sub-regions are handled by HN-Fs */
+            /* System cache sub-regions are handled by HN-Fs */
+            if (ctx->hnf_sub_region_count >= MAX_HNF_SUB_REGION_COUNT)
+                return FWK_E_DATA;
+
+            ctx->hnf_sub_region[ctx->hnf_sub_region_count++] =
+                region->node_id |
+                (sam_encode_region_size(region->size) <<
+                    CMN600_HNF_SAM_MEMREGION_SIZE_POS) |
+                ((region->base / SAM_GRANULARITY) <<
+                    CMN600_HNF_SAM_MEMREGION_BASE_POS) |
+                CMN600_HNF_SAM_MEMREGION_VALID;
             break;
 
         default:
@@ -359,12 +485,40 @@ int cmn600_setup_sam(struct cmn600_rnsam_reg *rnsam)
         }
     }
 
-    group_count = ctx->hnf_count / CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP;
+    /* The second system cache group serves the second region */
+    if ((ctx->hnf_scg1_count != 0) && (region_sys_count < 2))
+        return FWK_E_DATA;
+
+    return FWK_SUCCESS;
+}
+
+int cmn600_setup_sam(struct cmn600_rnsam_reg *rnsam)
+{
+    unsigned int group;
+    unsigned int group_count;
+    const struct cmn600_rnsam_image *image = &ctx->rnsam_image;
+
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG,
+        MOD_NAME "Configuring SAM for node %d\n",
+        get_node_id(rnsam));
+
+    apply_reg_updates(rnsam->NON_HASH_MEM_REGION, image->non_hash_mem_region,
+        FWK_ARRAY_SIZE(image->non_hash_mem_region));
+    apply_reg_updates(rnsam->NON_HASH_TGT_NODEID, image->non_hash_tgt_nodeid,
+        FWK_ARRAY_SIZE(image->non_hash_tgt_nodeid));
+    apply_reg_updates(rnsam->SYS_CACHE_GRP_REGION, image->sys_cache_grp_region,
+        FWK_ARRAY_SIZE(image->sys_cache_grp_region));
+
+    group_count = (ctx->hnf_count +
+        CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP - 1) /
+        CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP;
     for (group = 0; group < group_count; group++)
         rnsam->SYS_CACHE_GRP_HN_NODEID[group] = ctx->hnf_cache_group[group];
 
-    /* Program the number of HNFs */
-    rnsam->SYS_CACHE_GRP_HN_COUNT = ctx->hnf_count;
+    /* Program the number of HNFs of each system cache group */
+    rnsam->SYS_CACHE_GRP_HN_COUNT = (ctx->hnf_count - ctx->hnf_scg1_count) |
+        ((uint64_t)ctx->hnf_scg1_count <<
+            CMN600_RNSAM_SCG_HNF_COUNT_BITS_WIDTH);
 
     /* Enable RNSAM */
     rnsam->STATUS = CMN600_RNSAM_STATUS_UNSTALL;
@@ -409,22 +563,29 @@ static int cmn600_setup(void)
              * HN-F nodes in the system.
              */
             ctx->hnf_cache_group = fwk_mm_calloc(
-                ctx->hnf_count / CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP,
+                (ctx->hnf_count + CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP - 1)
+                    / CMN600_HNF_CACHE_GROUP_ENTRIES_PER_GROUP,
                 sizeof(*ctx->hnf_cache_group));
             if (ctx->hnf_cache_group == NULL)
                 return FWK_E_NOMEM;
         }
-    }
 
-    cmn600_configure();
+        status = cmn600_check_hnf_partition();
+        if (status != FWK_SUCCESS)
+            return status;
 
-    /* Setup internal RN-SAM nodes */
-    for (rnsam_idx = 0; rnsam_idx < ctx->internal_rnsam_count; rnsam_idx++)
-        cmn600_setup_sam(ctx->internal_rnsam_table[rnsam_idx]);
+        cmn600_build_topology();
+
+        status = cmn600_build_register_image();
+        if (status != FWK_SUCCESS)
+            return status;
+
+        /* Capture CCIX Host Topology */
+        for (i = 0; i < ctx->config->mmap_count; i++) {
+            if (ctx->config->mmap_table[i].type !=
+                MOD_CMN600_REGION_TYPE_CCIX)
+                continue;
 
-    /* Capture CCIX Host Topology */
-    for (i = 0; i < ctx->config->mmap_count; i++) {
-        if (ctx->config->mmap_table[i].type == MOD_CMN600_REGION_TYPE_CCIX) {
             ccix_mmap_idx = ctx->ccix_host_info.ccix_host_mmap_count;
             if (ccix_mmap_idx >= MAX_HA_MMAP_ENTRIES)
                 return FWK_E_DATA;
@@ -435,9 +596,31 @@ static int cmn600_setup(void)
                 ctx->config->mmap_table[i].size;
             ctx->ccix_host_info.ccix_host_mmap_count++;
         }
+
+        if (ctx->config->pmu_counter_count != 0) {
+            status = pmu_discovery(ctx);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+    }
+
+    cmn600_configure();
+
+    /* Setup internal RN-SAM nodes */
+    for (rnsam_idx = 0; rnsam_idx < ctx->internal_rnsam_count; rnsam_idx++)
+        cmn600_setup_sam(ctx->internal_rnsam_table[rnsam_idx]);
+
+    if (ctx->config->pmu_counter_count != 0) {
+        pmu_setup(ctx);
+
+        status = ctx->alarm_api->start(ctx->config->pmu_alarm_id,
+            ctx->config->pmu_sampling_period, MOD_TIMER_ALARM_TYPE_PERIODIC,
+            NULL, CMN600_ALARM_PMU);
+        if (status != FWK_SUCCESS)
+            return status;
     }
 
-    ctx->log_api->log(MOD_LOG_GROUP_DEBUG, MOD_NAME "Done\n");
+    MOD_LOG(ctx->log_api, MOD_LOG_GROUP_DEBUG, MOD_NAME "Done\n");
 
     ctx->initialized = true;
 
@@ -501,24 +684,99 @@ static int cmn600_ccix_config_get(
 }
 
 
+/* Setup the RN-SAMs of the CCIX regions once the CCIX link is up */
+static void cmn600_ccix_setup_rnsam(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < ctx->config->mmap_count; i++) {
+        if (ctx->config->mmap_table[i].type == MOD_CMN600_REGION_TYPE_CCIX)
+            cmn600_setup_rnsam(ctx->config->mmap_table[i].node_id);
+    }
+}
+
+/*
+ * Start polling the CCIX link status for an operation that completes
+ * asynchronously. The caller is sent the response to the pending CCIX link
+ * operation event once the operation has completed.
+ */
+static int cmn600_ccix_link_op_start(enum cmn600_ccix_link_op op)
+{
+    int status;
+    struct fwk_event event = {
+        .id = mod_cmn600_event_id_ccix_link,
+        .target_id = fwk_module_id_cmn600,
+        .response_requested = true,
+    };
+
+    status = ctx->alarm_api->start_us(ctx->config->ccix_alarm_id,
+        ctx->config->ccix_poll_period, MOD_TIMER_ALARM_TYPE_PERIODIC, NULL,
+        CMN600_ALARM_CCIX_LINK);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS) {
+        ctx->alarm_api->stop(ctx->config->ccix_alarm_id);
+        return status;
+    }
+
+    ctx->ccix_link_op = op;
+    ctx->ccix_link_response_delayed = false;
+
+    return FWK_PENDING;
+}
+
+static int cmn600_ccix_link_op_complete(int status)
+{
+    struct fwk_event resp;
+    struct mod_cmn600_ccix_link_event_params *resp_params;
+
+    ctx->alarm_api->stop(ctx->config->ccix_alarm_id);
+
+    if ((status == FWK_SUCCESS) &&
+        (ctx->ccix_link_op == CMN600_CCIX_LINK_OP_SET_CONFIG))
+        cmn600_ccix_setup_rnsam();
+
+    ctx->ccix_link_op = CMN600_CCIX_LINK_OP_NONE;
+    ctx->ccix_link_status = status;
+
+    if (!ctx->ccix_link_response_delayed)
+        return FWK_SUCCESS;
+
+    ctx->ccix_link_response_delayed = false;
+
+    status = fwk_thread_get_delayed_response(fwk_module_id_cmn600,
+        ctx->ccix_link_cookie, &resp);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    resp_params = (struct mod_cmn600_ccix_link_event_params *)resp.params;
+    resp_params->status = ctx->ccix_link_status;
+
+    return fwk_thread_put_event(&resp);
+}
+
 static int cmn600_ccix_config_set(
     struct mod_cmn600_ccix_remote_node_config *config)
 {
-    unsigned int i;
     int status;
 
     status = fwk_module_check_call(fwk_module_id_cmn600);
     if (status != FWK_SUCCESS)
         return status;
 
+    if (ctx->ccix_link_op != CMN600_CCIX_LINK_OP_NONE)
+        return FWK_E_BUSY;
+
     status = ccix_setup(ctx, config);
+    if (status == FWK_PENDING)
+        return cmn600_ccix_link_op_start(CMN600_CCIX_LINK_OP_SET_CONFIG);
     if (status != FWK_SUCCESS)
         return status;
 
-    for (i = 0; i < ctx->config->mmap_count; i++) {
-        if (ctx->config->mmap_table[i].type == MOD_CMN600_REGION_TYPE_CCIX)
-            cmn600_setup_rnsam(ctx->config->mmap_table[i].node_id);
-    }
+    cmn600_ccix_setup_rnsam();
+
     return FWK_SUCCESS;
 }
 
@@ -542,9 +800,64 @@ static int cmn600_ccix_enter_system_coherency(uint8_t link_id)
     if (status != FWK_SUCCESS)
         return status;
 
+    if (ctx->ccix_link_op != CMN600_CCIX_LINK_OP_NONE)
+        return FWK_E_BUSY;
+
     status = ccix_enter_system_coherency(ctx, link_id);
+    if (status == FWK_PENDING) {
+        return cmn600_ccix_link_op_start(
+            CMN600_CCIX_LINK_OP_ENTER_SYSTEM_COHERENCY);
+    }
+
     return status;
+}
+
+/*
+ * PMU telemetry API
+ */
+
+static int cmn600_pmu_get_counter(unsigned int counter_idx, uint64_t *value,
+    uint64_t *timestamp)
+{
+    int status;
+
+    status = fwk_module_check_call(fwk_module_id_cmn600);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (counter_idx >= ctx->config->pmu_counter_count)
+        return FWK_E_PARAM;
+
+    if ((value == NULL) || (timestamp == NULL))
+        return FWK_E_PARAM;
 
+    if (ctx->pmu_timestamp == 0)
+        return FWK_E_STATE;
+
+    *value = ctx->pmu_counter_table[counter_idx].value;
+    *timestamp = ctx->pmu_timestamp;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_cmn600_pmu_api cmn600_pmu_api = {
+    .get_counter = cmn600_pmu_get_counter,
+};
+
+static void cmn600_pmu_sample(void)
+{
+    int status;
+    uint64_t timestamp;
+    fwk_id_t timer_id;
+
+    timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+        fwk_id_get_element_idx(ctx->config->pmu_alarm_id));
+
+    status = ctx->timer_api->get_time(timer_id, &timestamp);
+    if (status != FWK_SUCCESS)
+        return;
+
+    pmu_sample(ctx, timestamp);
 }
 
 static const struct mod_cmn600_ccix_config_api cmn600_ccix_config_api = {
@@ -563,6 +876,8 @@ static int cmn600_init(fwk_id_t module_id, unsigned int element_count,
     const void *data)
 {
     const struct mod_cmn600_config *config = data;
+    const struct mod_cmn600_snf_striping *striping;
+    unsigned int idx;
 
     /* No elements support */
     if (element_count > 0)
@@ -585,6 +900,28 @@ static int cmn600_init(fwk_id_t module_id, unsigned int element_count,
     if (config->snf_count > CMN600_HNF_CACHE_GROUP_ENTRIES_MAX)
         return FWK_E_DATA;
 
+    if (config->snf_mode == MOD_CMN600_SNF_MODE_THREE_SN) {
+        striping = &config->snf_striping;
+
+        for (idx = 0; idx < FWK_ARRAY_SIZE(striping->node_id); idx++) {
+            if (striping->node_id[idx] > CMN600_HNF_SAM_CONTROL_SN_MASK)
+                return FWK_E_DATA;
+        }
+
+        if ((striping->top_address_bit[0] >= striping->top_address_bit[1]) ||
+            (striping->top_address_bit[1] >
+             CMN600_HNF_SAM_CONTROL_TOP_ADDRESS_BIT_MASK))
+            return FWK_E_DATA;
+    } else if (config->snf_mode != MOD_CMN600_SNF_MODE_DIRECT)
+        return FWK_E_DATA;
+
+    if (config->pmu_counter_count != 0) {
+        if ((config->pmu_counter_table == NULL) ||
+            (config->pmu_counter_count > MOD_CMN600_PMU_COUNTER_MAX) ||
+            (config->pmu_sampling_period == 0))
+            return FWK_E_DATA;
+    }
+
     ctx->root = get_root_node(config->base, config->hnd_node_id,
         config->mesh_size_x, config->mesh_size_y);
 
@@ -615,6 +952,24 @@ static int cmn600_bind(fwk_id_t id, unsigned int round)
                                  &ctx->timer_api);
         if (status != FWK_SUCCESS)
             return FWK_E_PANIC;
+
+        if (ctx->config->ccix_poll_period != 0) {
+            /* Bind to the alarm used to poll the CCIX link status */
+            status = fwk_module_bind(ctx->config->ccix_alarm_id,
+                                     MOD_TIMER_API_ID_ALARM,
+                                     &ctx->alarm_api);
+            if (status != FWK_SUCCESS)
+                return FWK_E_PANIC;
+        }
+
+        if (ctx->config->pmu_counter_count != 0) {
+            /* Bind to the alarm used to sample the PMU counters */
+            status = fwk_module_bind(ctx->config->pmu_alarm_id,
+                                     MOD_TIMER_API_ID_ALARM,
+                                     &ctx->alarm_api);
+            if (status != FWK_SUCCESS)
+                return FWK_E_PANIC;
+        }
     }
 
     return FWK_SUCCESS;
@@ -631,6 +986,10 @@ static int cmn600_process_bind_request(fwk_id_t requester_id,
     case MOD_CMN600_API_IDX_CCIX_CONFIG:
         *api = &cmn600_ccix_config_api;
         break;
+
+    case MOD_CMN600_API_IDX_PMU:
+        *api = &cmn600_pmu_api;
+        break;
     }
 
     return FWK_SUCCESS;
@@ -667,13 +1026,65 @@ static int cmn600_process_notification(
     return FWK_SUCCESS;
 }
 
+static int cmn600_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+    struct mod_cmn600_ccix_link_event_params *resp_params;
+    const struct mod_timer_alarm_event_params *alarm_params;
+
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        alarm_params =
+            (const struct mod_timer_alarm_event_params *)event->params;
+
+        /* Sample of the PMU counters */
+        if (alarm_params->param == CMN600_ALARM_PMU) {
+            cmn600_pmu_sample();
+            return FWK_SUCCESS;
+        }
+
+        /*
+         * Poll of the CCIX link status. The alarm event may have been sent
+         * before the operation completed.
+         */
+        if (ctx->ccix_link_op == CMN600_CCIX_LINK_OP_NONE)
+            return FWK_SUCCESS;
+
+        status = ccix_link_poll(ctx);
+        if (status == FWK_PENDING)
+            return FWK_SUCCESS;
+
+        return cmn600_ccix_link_op_complete(status);
+    }
+
+    if (!fwk_id_is_equal(event->id, mod_cmn600_event_id_ccix_link))
+        return FWK_E_PARAM;
+
+    /* The response is sent once the CCIX link operation has completed */
+    if (ctx->ccix_link_op != CMN600_CCIX_LINK_OP_NONE) {
+        ctx->ccix_link_cookie = event->cookie;
+        ctx->ccix_link_response_delayed = true;
+        resp_event->is_delayed_response = true;
+
+        return FWK_SUCCESS;
+    }
+
+    resp_params =
+        (struct mod_cmn600_ccix_link_event_params *)resp_event->params;
+    resp_params->status = ctx->ccix_link_status;
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_cmn600 = {
     .name = "CMN600",
     .type = FWK_MODULE_TYPE_DRIVER,
     .api_count = MOD_CMN600_API_COUNT,
+    .event_count = MOD_CMN600_EVENT_IDX_COUNT,
     .init = cmn600_init,
     .bind = cmn600_bind,
     .start = cmn600_start,
     .process_bind_request = cmn600_process_bind_request,
     .process_notification = cmn600_process_notification,
+    .process_event = cmn600_process_event,
 };
@@ -89,6 +89,32 @@ struct mod_css_clock_dev_config {
     /*! Reference to the API provided by the PLL driver. */
     fwk_id_t pll_api_id;
 
+    /*!
+     * \brief Element identifier of the alternate PLL.
+     *
+     * \details When the group has a second PLL, the clocks of the group
+     *      switch between the two PLLs (ping-pong mode): the PLL that the
+     *      clocks are not running from is locked to the new rate, and the
+     *      clocks then switch to it without being parked on the switching
+     *      source. The latency of a rate change is then bounded by the switch
+     *      of the clock multiplexers rather than by the lock time of the PLL.
+     *      The alternate PLL must provide the API referenced by
+     *      \ref pll_api_id.
+     *
+     * \note The identifier is either left unset or equal to FWK_ID_NONE if
+     *      the group has a single PLL.
+     */
+    fwk_id_t pll_alt_id;
+
+    /*!
+     * \brief Clock source selecting the alternate PLL.
+     *
+     * \details The source replaces the clock source of the rate lookup table
+     *      entries (or \ref clock_default_source for non-indexed clocks)
+     *      while the clocks run from the alternate PLL.
+     */
+    uint8_t clock_alt_source;
+
     /*! Pointer to the table of clocks that are members of the group. */
     fwk_id_t const *member_table;
 
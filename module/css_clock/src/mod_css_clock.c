@@ -6,7 +6,6 @@
  */
 
 #include <stdint.h>
-#include <stdlib.h>
 #include <fwk_element.h>
 #include <fwk_errno.h>
 #include <fwk_mm.h>
@@ -22,6 +21,27 @@ struct css_clock_dev_ctx {
     struct mod_clock_drv_api *pll_api;
     struct mod_css_clock_direct_api *clock_api;
     const struct mod_css_clock_dev_config *config;
+
+    /* Rates of the lookup table entries, in ascending order */
+    uint64_t *rate_key_table;
+
+    /* Index of the lookup table entry matched by the last rate lookup */
+    unsigned int rate_entry_idx;
+
+    /* API of the alternate PLL, NULL if the group has a single PLL */
+    struct mod_clock_drv_api *pll_alt_api;
+
+    /* The member clocks run from the alternate PLL */
+    bool pll_alt_active;
+
+    /*
+     * The member clocks run from the active PLL with the settings of the
+     * current rate, the next rate change can switch PLLs.
+     */
+    bool pll_switch_ready;
+
+    /* Lookup table entry of the current rate (indexed clocks) */
+    const struct mod_css_clock_rate *current_entry;
 };
 
 /* Module context */
@@ -36,33 +56,131 @@ static struct css_clock_ctx module_ctx;
  * Static helper functions
  */
 
-static int compare_rate_entry(const void *a, const void *b)
-{
-    struct mod_css_clock_rate *key = (struct mod_css_clock_rate *)a;
-    struct mod_css_clock_rate *element = (struct mod_css_clock_rate *)b;
-
-    return (key->rate - element->rate);
-}
-
 static int get_rate_entry(struct css_clock_dev_ctx *ctx, uint64_t target_rate,
                           struct mod_css_clock_rate **entry)
 {
-    struct mod_css_clock_rate *current_rate_entry;
+    const uint64_t *rate_key_table;
+    unsigned int low, high, mid;
 
     if (ctx == NULL)
         return FWK_E_PARAM;
     if (entry == NULL)
         return FWK_E_PARAM;
 
+    rate_key_table = ctx->rate_key_table;
+
+    /*
+     * Consecutive lookups usually target the rate of the last entry found
+     * (e.g. when restoring the current rate), so check that entry first.
+     */
+    if ((ctx->rate_entry_idx < ctx->config->rate_count) &&
+        (rate_key_table[ctx->rate_entry_idx] == target_rate)) {
+        *entry = (struct mod_css_clock_rate *)
+            &ctx->config->rate_table[ctx->rate_entry_idx];
+        return FWK_SUCCESS;
+    }
+
     /* Perform a binary search to find the entry matching the requested rate */
-    current_rate_entry = (struct mod_css_clock_rate *) bsearch(&target_rate,
-        ctx->config->rate_table, ctx->config->rate_count,
-        sizeof(struct mod_css_clock_rate), compare_rate_entry);
+    low = 0;
+    high = ctx->config->rate_count;
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (rate_key_table[mid] == target_rate) {
+            ctx->rate_entry_idx = mid;
+            *entry = (struct mod_css_clock_rate *)&ctx->config->rate_table[mid];
+            return FWK_SUCCESS;
+        }
 
-    if (current_rate_entry == NULL)
-        return FWK_E_PARAM;
+        if (rate_key_table[mid] < target_rate)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return FWK_E_PARAM;
+}
+
+/*
+ * Lock the PLL that the member clocks are not running from to a rate. The
+ * identifier and the clock source of the PLL are returned.
+ */
+static int lock_idle_pll(struct css_clock_dev_ctx *ctx, uint64_t pll_rate,
+                         enum mod_clock_round_mode round_mode,
+                         uint8_t primary_source, uint8_t *source)
+{
+    int status;
+
+    if (ctx->pll_alt_active) {
+        status = ctx->pll_api->set_rate(ctx->config->pll_id, pll_rate,
+                                        round_mode);
+        *source = primary_source;
+    } else {
+        status = ctx->pll_alt_api->set_rate(ctx->config->pll_alt_id,
+                                            pll_rate, round_mode);
+        *source = ctx->config->clock_alt_source;
+    }
+
+    return status;
+}
+
+static int switch_pll_indexed(struct css_clock_dev_ctx *ctx,
+                              const struct mod_css_clock_rate *rate_entry)
+{
+    int status;
+    unsigned int i;
+    uint8_t source;
+    bool div_first;
+    fwk_id_t member_id;
+
+    status = lock_idle_pll(ctx, rate_entry->pll_rate,
+                           MOD_CLOCK_ROUND_MODE_NONE, rate_entry->clock_source,
+                           &source);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /*
+     * The member clocks always run at the lower of the two rates until both
+     * the source and the divider are set: the divider is increased before the
+     * switch and decreased after it.
+     */
+    div_first = (rate_entry->clock_div > ctx->current_entry->clock_div);
+
+    for (i = 0; i < ctx->config->member_count; i++) {
+        member_id = ctx->config->member_table[i];
+
+        if (div_first) {
+            status = ctx->clock_api->set_div(member_id,
+                                             rate_entry->clock_div_type,
+                                             rate_entry->clock_div);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
+        /* The multiplexer switches between the two running PLLs glitch-free */
+        status = ctx->clock_api->set_source(member_id, source);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (!div_first) {
+            status = ctx->clock_api->set_div(member_id,
+                                             rate_entry->clock_div_type,
+                                             rate_entry->clock_div);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
+        if (ctx->config->modulation_supported) {
+            status = ctx->clock_api->set_mod(member_id,
+                                             rate_entry->clock_mod_numerator,
+                                             rate_entry->clock_mod_denominator);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+    }
+
+    ctx->pll_alt_active = !ctx->pll_alt_active;
 
-    *entry = current_rate_entry;
     return FWK_SUCCESS;
 }
 
@@ -81,6 +199,13 @@ static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
     if (status != FWK_SUCCESS)
         goto exit;
 
+    /* Ping-pong mode */
+    if (ctx->pll_switch_ready) {
+        ctx->pll_switch_ready = false;
+        status = switch_pll_indexed(ctx, rate_entry);
+        goto exit;
+    }
+
     /* Switch each member clock away from the PLL source */
     for (i = 0; i < ctx->config->member_count; i++) {
         status = ctx->clock_api->set_source(ctx->config->member_table[i],
@@ -117,9 +242,14 @@ static int set_rate_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
             goto exit;
     }
 
+    ctx->pll_alt_active = false;
+
 exit:
-    if (status == FWK_SUCCESS)
+    if (status == FWK_SUCCESS) {
         ctx->current_rate = rate;
+        ctx->current_entry = rate_entry;
+        ctx->pll_switch_ready = (ctx->pll_alt_api != NULL);
+    }
     return status;
 }
 
@@ -128,10 +258,31 @@ static int set_rate_non_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
 {
     int status;
     unsigned int i;
+    uint8_t source;
 
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    /* Ping-pong mode */
+    if (ctx->pll_switch_ready) {
+        ctx->pll_switch_ready = false;
+
+        status = lock_idle_pll(ctx, rate, round_mode,
+                               ctx->config->clock_default_source, &source);
+        if (status != FWK_SUCCESS)
+            goto exit;
+
+        for (i = 0; i < ctx->config->member_count; i++) {
+            status = ctx->clock_api->set_source(ctx->config->member_table[i],
+                                                source);
+            if (status != FWK_SUCCESS)
+                goto exit;
+        }
+
+        ctx->pll_alt_active = !ctx->pll_alt_active;
+        goto exit;
+    }
+
     /* Switch each member clock away from the PLL source */
     for (i = 0; i < ctx->config->member_count; i++) {
         status = ctx->clock_api->set_source(ctx->config->member_table[i],
@@ -153,9 +304,13 @@ static int set_rate_non_indexed(struct css_clock_dev_ctx *ctx, uint64_t rate,
             goto exit;
     }
 
+    ctx->pll_alt_active = false;
+
 exit:
-    if (status == FWK_SUCCESS)
+    if (status == FWK_SUCCESS) {
         ctx->current_rate = rate;
+        ctx->pll_switch_ready = (ctx->pll_alt_api != NULL);
+    }
     return status;
 }
 
@@ -222,6 +377,35 @@ static int css_clock_get_rate_from_index(fwk_id_t dev_id,
         return FWK_E_SUPPORT;
 }
 
+static int css_clock_get_rates(fwk_id_t dev_id, unsigned int start_index,
+                               unsigned int count, uint64_t *rates)
+{
+    int status;
+    unsigned int i;
+    struct css_clock_dev_ctx *ctx;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (rates == NULL)
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    if ((start_index >= ctx->config->rate_count) ||
+        (count > (ctx->config->rate_count - start_index)))
+        return FWK_E_PARAM;
+
+    if (ctx->config->clock_type != MOD_CSS_CLOCK_TYPE_INDEXED)
+        return FWK_E_SUPPORT;
+
+    for (i = 0; i < count; i++)
+        rates[i] = ctx->config->rate_table[start_index + i].rate;
+
+    return FWK_SUCCESS;
+}
+
 static int css_clock_set_state(fwk_id_t dev_id, enum mod_clock_state state)
 {
     int status;
@@ -304,6 +488,12 @@ static int css_clock_power_state_change(
     }
 
     if (next_state == MOD_PD_STATE_ON) {
+        /*
+         * The settings of the member clocks may have been lost, the rate is
+         * set from the switching source.
+         */
+        ctx->pll_switch_ready = false;
+
         if (ctx->initialized) {
             /* Restore all clocks in the group to the last frequency */
             return css_clock_set_rate(dev_id, ctx->current_rate,
@@ -357,6 +547,7 @@ static const struct mod_clock_drv_api api_clock = {
     .set_rate = css_clock_set_rate,
     .get_rate = css_clock_get_rate,
     .get_rate_from_index = css_clock_get_rate_from_index,
+    .get_rates = css_clock_get_rates,
     .set_state = css_clock_set_state,
     .get_state = css_clock_get_state,
     .get_range = css_clock_get_range,
@@ -399,7 +590,13 @@ static int css_clock_element_init(fwk_id_t element_id,
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
-    if (dev_config->clock_type == MOD_CSS_CLOCK_TYPE_INDEXED) {
+    if ((dev_config->clock_type == MOD_CSS_CLOCK_TYPE_INDEXED) &&
+        (dev_config->rate_count > 0)) {
+        ctx->rate_key_table = fwk_mm_calloc(dev_config->rate_count,
+                                            sizeof(uint64_t));
+        if (ctx->rate_key_table == NULL)
+            return FWK_E_NOMEM;
+
         /* Verify that the rate entries in the lookup table are ordered */
         while (i < dev_config->rate_count) {
             current_rate = dev_config->rate_table[i].rate;
@@ -408,6 +605,7 @@ static int css_clock_element_init(fwk_id_t element_id,
             if (current_rate < last_rate)
                 return FWK_E_DATA;
 
+            ctx->rate_key_table[i] = current_rate;
             last_rate = current_rate;
             i++;
         }
@@ -445,6 +643,14 @@ static int css_clock_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
+    /* Bind to the alternate PLL of the group, if any */
+    if (fwk_id_is_type(config->pll_alt_id, FWK_ID_TYPE_ELEMENT)) {
+        status = fwk_module_bind(config->pll_alt_id, config->pll_api_id,
+                                 &ctx->pll_alt_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     /* Bind to the API used to control the clocks in the group */
     status = fwk_module_bind(config->member_table[0],
                              config->member_api_id, &ctx->clock_api);
@@ -36,6 +36,11 @@
  */
 #define MOD_DMC620_ACCESS_ADDRESS_COUNT 8
 
+/*!
+ * \brief Number of PMU counters clocked by the divided clock
+ */
+#define MOD_DMC620_PMU_CLKDIV2_COUNTER_COUNT 8
+
 /*!
  * \brief Access address next registers
  */
@@ -393,7 +398,8 @@ struct mod_dmc620_reg {
     FWK_R   uint32_t    PMU_SNAPSHOT_ACK;
     FWK_RW  uint32_t    PMU_OVERFLOW_STATUS_CLKDIV2;
     FWK_RW  uint32_t    PMU_OVERFLOW_STATUS_CLK;
-            struct mod_dmc620_pmu_counter PMC_CLKDIV2_COUNT[8];
+            struct mod_dmc620_pmu_counter PMC_CLKDIV2_COUNT
+                                        [MOD_DMC620_PMU_CLKDIV2_COUNTER_COUNT];
             struct mod_dmc620_pmu_counter PMC_CLK_COUNT[2];
             uint8_t     RESERVED60[0xE00 - 0xBA0];
     FWK_RW  uint32_t    INTEG_CFG;
@@ -612,6 +618,137 @@ struct mod_dmc620_reg {
  */
 #define DMC_ERR0CTRL0_CFI_ENABLE UINT32_C(0x00000100)
 
+/*!
+ * \brief Low-power modes driven by the memory power policy, from the
+ *      shallowest to the deepest.
+ */
+enum mod_dmc620_low_power_mode {
+    /*! No low-power mode is entered when the memory is idle */
+    MOD_DMC620_LOW_POWER_MODE_NONE,
+
+    /*! The DRAM is automatically powered down when the memory is idle */
+    MOD_DMC620_LOW_POWER_MODE_POWER_DOWN,
+
+    /*! The DRAM automatically enters self-refresh when the memory is idle */
+    MOD_DMC620_LOW_POWER_MODE_SELF_REFRESH,
+
+    /*! Number of low-power modes */
+    MOD_DMC620_LOW_POWER_MODE_COUNT,
+};
+
+/*!
+ * \brief Low-power mode configuration.
+ */
+struct mod_dmc620_low_power_mode_config {
+    /*! Value of the LOW_POWER_CONTROL_NEXT register selecting the mode */
+    uint32_t low_power_control;
+
+    /*! Latency of the exit from the mode in nanoseconds */
+    uint32_t exit_latency_ns;
+};
+
+/*!
+ * \brief Patrol scrub rates driven by the memory power policy.
+ */
+enum mod_dmc620_scrub_rate {
+    /*! Rate used while the system is idle, the fastest */
+    MOD_DMC620_SCRUB_RATE_IDLE,
+
+    /*! Rate giving the expected scrub coverage */
+    MOD_DMC620_SCRUB_RATE_NOMINAL,
+
+    /*! Rate used under load, the slowest */
+    MOD_DMC620_SCRUB_RATE_LOADED,
+
+    /*! Number of scrub rates */
+    MOD_DMC620_SCRUB_RATE_COUNT,
+};
+
+/*!
+ * \brief Scrub rate configuration.
+ */
+struct mod_dmc620_scrub_rate_config {
+    /*! Value of the SCRUB_CONTROL0_NEXT register selecting the rate */
+    uint32_t scrub_control;
+
+    /*!
+     * \brief Memory scrubbed per sampling period, in any unit common to all
+     *      the rates.
+     */
+    uint32_t rate;
+};
+
+/*!
+ * \brief Patrol scrub configuration.
+ *
+ * \details The idle rate is selected when all the clusters are off or the
+ *      load is light, and the loaded rate otherwise. The difference between
+ *      the memory scrubbed and what the nominal rate would have scrubbed is
+ *      accounted at each sample. The nominal rate replaces the loaded rate
+ *      once the scrubbing has fallen behind by the credit limit, so that the
+ *      coverage stays that of the nominal rate.
+ */
+struct mod_dmc620_scrub_config {
+    /*! Configuration of each scrub rate */
+    struct mod_dmc620_scrub_rate_config rate[MOD_DMC620_SCRUB_RATE_COUNT];
+
+    /*!
+     * \brief Limit of the memory scrubbed ahead of, or behind, the nominal
+     *      rate, in the unit of the rates.
+     */
+    uint32_t credit_limit;
+};
+
+/*!
+ * \brief Memory power policy configuration.
+ *
+ * \details Once the DMC is ready, the policy periodically samples a PMU
+ *      counter of the DMC counting the memory traffic. The deepest low-power
+ *      mode within the latency budget is selected when all the clusters are
+ *      off. Otherwise, the power-down mode is selected when the load is light,
+ *      and no low-power mode is selected when it is not. The patrol scrub
+ *      rate follows the same inputs, see \ref mod_dmc620_scrub_config.
+ */
+struct mod_dmc620_power_policy_config {
+    /*! Sub-element identifier of the alarm sampling the traffic */
+    fwk_id_t alarm_id;
+
+    /*! Sampling period in milliseconds */
+    unsigned int sampling_period_ms;
+
+    /*!
+     * \brief Index of the PMU counter clocked by the divided clock that counts
+     *      the traffic.
+     */
+    unsigned int pmu_counter;
+
+    /*! Value of the CONTROL register of the PMU counter */
+    uint32_t pmu_counter_control;
+
+    /*! Traffic count per sampling period under which the load is light */
+    uint32_t light_load_threshold;
+
+    /*! Maximum latency of the exit from a low-power mode in nanoseconds */
+    uint32_t latency_budget_ns;
+
+    /*! Configuration of each low-power mode */
+    struct mod_dmc620_low_power_mode_config
+        mode[MOD_DMC620_LOW_POWER_MODE_COUNT];
+
+    /*! Table of the identifiers of the power domains of the clusters */
+    const fwk_id_t *cluster_pd_id_table;
+
+    /*! Number of clusters */
+    unsigned int cluster_count;
+
+    /*!
+     * \brief Patrol scrub configuration.
+     *
+     * \details May be \c NULL if the scrub rate is not managed at runtime.
+     */
+    const struct mod_dmc620_scrub_config *scrub;
+};
+
 /*!
  * \brief Element configuration.
  */
@@ -622,6 +759,12 @@ struct mod_dmc620_element_config {
     fwk_id_t ddr_id;
     /*! Identifier of the clock that this element depends on */
     fwk_id_t clock_id;
+    /*!
+     * \brief Memory power policy configuration.
+     *
+     * \details May be \c NULL if the low-power mode is not managed at runtime.
+     */
+    const struct mod_dmc620_power_policy_config *power_policy;
 };
 
 /*!
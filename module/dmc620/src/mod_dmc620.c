@@ -10,6 +10,7 @@
 
 #include <fwk_assert.h>
 #include <fwk_errno.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
@@ -17,25 +18,257 @@
 #include <mod_clock.h>
 #include <mod_log.h>
 #include <mod_power_domain.h>
+#include <mod_timer.h>
 #include <cmsis_compiler.h>
 
+/* Memory power policy context of a DMC */
+struct dmc620_power_policy_ctx {
+    /* Alarm API, NULL when the policy is disabled */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* The policy is running */
+    bool running;
+
+    /* Deepest low-power mode within the latency budget */
+    enum mod_dmc620_low_power_mode max_mode;
+
+    /* Current low-power mode */
+    enum mod_dmc620_low_power_mode mode;
+
+    /* Mask of the clusters that are off */
+    uint32_t cluster_off_mask;
+
+    /* Value of the traffic counter at the last sample */
+    uint32_t last_count;
+
+    /* Traffic during the last sampling period */
+    uint32_t traffic;
+
+    /* Current scrub rate */
+    enum mod_dmc620_scrub_rate scrub_rate;
+
+    /* Memory scrubbed ahead of the nominal rate, negative when behind */
+    int64_t scrub_credit;
+};
+
 static struct mod_log_api *log_api;
 static struct mod_dmc_ddr_phy_api *ddr_phy_api;
+static struct dmc620_power_policy_ctx *power_policy_ctx_table;
 
 static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id);
 
+/*
+ * Memory power policy
+ */
+
+static void dmc620_set_policy_state(struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_power_policy_config *policy,
+    enum mod_dmc620_low_power_mode mode,
+    enum mod_dmc620_scrub_rate scrub_rate)
+{
+    dmc->LOW_POWER_CONTROL_NEXT = policy->mode[mode].low_power_control;
+    if (policy->scrub != NULL)
+        dmc->SCRUB_CONTROL0_NEXT =
+            policy->scrub->rate[scrub_rate].scrub_control;
+
+    /* The new value takes effect through the CONFIG state */
+    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_CONFIG;
+    while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) !=
+           MOD_DMC620_MEMC_CMD_CONFIG)
+        continue;
+
+    dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_GO;
+    while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) != MOD_DMC620_MEMC_CMD_GO)
+        continue;
+}
+
+/*
+ * Select the scrub rate of a DMC. The loaded rate is not selected once the
+ * scrubbing is behind the nominal rate by the credit limit.
+ */
+static enum mod_dmc620_scrub_rate dmc620_select_scrub_rate(
+    const struct dmc620_power_policy_ctx *ctx,
+    const struct mod_dmc620_power_policy_config *policy, bool idle)
+{
+    if (policy->scrub == NULL)
+        return MOD_DMC620_SCRUB_RATE_NOMINAL;
+
+    if (idle)
+        return MOD_DMC620_SCRUB_RATE_IDLE;
+
+    if (ctx->scrub_credit <= -(int64_t)policy->scrub->credit_limit)
+        return MOD_DMC620_SCRUB_RATE_NOMINAL;
+
+    return MOD_DMC620_SCRUB_RATE_LOADED;
+}
+
+/* Account the memory scrubbed during the last sampling period */
+static void dmc620_account_scrub(struct dmc620_power_policy_ctx *ctx,
+    const struct mod_dmc620_scrub_config *scrub)
+{
+    int64_t limit = scrub->credit_limit;
+
+    ctx->scrub_credit += (int64_t)scrub->rate[ctx->scrub_rate].rate -
+        (int64_t)scrub->rate[MOD_DMC620_SCRUB_RATE_NOMINAL].rate;
+
+    if (ctx->scrub_credit > limit)
+        ctx->scrub_credit = limit;
+    else if (ctx->scrub_credit < -limit)
+        ctx->scrub_credit = -limit;
+}
+
+/*
+ * Select the low-power mode and the scrub rate of a DMC from the cluster
+ * states and the load.
+ */
+static void dmc620_power_policy_update(fwk_id_t element_id)
+{
+    bool clusters_off;
+    enum mod_dmc620_low_power_mode mode;
+    enum mod_dmc620_scrub_rate scrub_rate;
+    struct dmc620_power_policy_ctx *ctx;
+    const struct mod_dmc620_element_config *element_config;
+    const struct mod_dmc620_power_policy_config *policy;
+
+    ctx = &power_policy_ctx_table[fwk_id_get_element_idx(element_id)];
+    if (!ctx->running)
+        return;
+
+    element_config = fwk_module_get_data(element_id);
+    policy = element_config->power_policy;
+
+    clusters_off = (policy->cluster_count != 0) &&
+        (ctx->cluster_off_mask == (UINT32_MAX >> (32 - policy->cluster_count)));
+
+    if (clusters_off)
+        mode = MOD_DMC620_LOW_POWER_MODE_SELF_REFRESH;
+    else if (ctx->traffic < policy->light_load_threshold)
+        mode = MOD_DMC620_LOW_POWER_MODE_POWER_DOWN;
+    else
+        mode = MOD_DMC620_LOW_POWER_MODE_NONE;
+
+    scrub_rate = dmc620_select_scrub_rate(ctx, policy,
+        mode != MOD_DMC620_LOW_POWER_MODE_NONE);
+
+    if (mode > ctx->max_mode)
+        mode = ctx->max_mode;
+
+    if ((mode == ctx->mode) && (scrub_rate == ctx->scrub_rate))
+        return;
+
+    dmc620_set_policy_state((struct mod_dmc620_reg *)element_config->dmc,
+                            policy, mode, scrub_rate);
+    ctx->mode = mode;
+    ctx->scrub_rate = scrub_rate;
+}
+
+static void dmc620_power_policy_sample(fwk_id_t element_id)
+{
+    uint32_t count;
+    struct mod_dmc620_reg *dmc;
+    struct dmc620_power_policy_ctx *ctx;
+    const struct mod_dmc620_element_config *element_config;
+
+    ctx = &power_policy_ctx_table[fwk_id_get_element_idx(element_id)];
+    element_config = fwk_module_get_data(element_id);
+    dmc = (struct mod_dmc620_reg *)element_config->dmc;
+
+    count = dmc->PMC_CLKDIV2_COUNT[element_config->power_policy->pmu_counter]
+        .VALUE_31_00;
+    ctx->traffic = count - ctx->last_count;
+    ctx->last_count = count;
+
+    if (element_config->power_policy->scrub != NULL)
+        dmc620_account_scrub(ctx, element_config->power_policy->scrub);
+
+    dmc620_power_policy_update(element_id);
+}
+
+static int dmc620_power_policy_start(fwk_id_t element_id)
+{
+    struct mod_dmc620_reg *dmc;
+    struct dmc620_power_policy_ctx *ctx;
+    const struct mod_dmc620_element_config *element_config;
+    const struct mod_dmc620_power_policy_config *policy;
+
+    ctx = &power_policy_ctx_table[fwk_id_get_element_idx(element_id)];
+    if ((ctx->alarm_api == NULL) || ctx->running)
+        return FWK_SUCCESS;
+
+    element_config = fwk_module_get_data(element_id);
+    policy = element_config->power_policy;
+    dmc = (struct mod_dmc620_reg *)element_config->dmc;
+
+    dmc->PMC_CLKDIV2_COUNT[policy->pmu_counter].CONTROL =
+        policy->pmu_counter_control;
+    ctx->last_count = dmc->PMC_CLKDIV2_COUNT[policy->pmu_counter].VALUE_31_00;
+
+    /*
+     * The DMC runs without low-power mode and scrubs at the nominal rate until
+     * the first sample.
+     */
+    ctx->mode = MOD_DMC620_LOW_POWER_MODE_NONE;
+    ctx->scrub_rate = MOD_DMC620_SCRUB_RATE_NOMINAL;
+    ctx->traffic = UINT32_MAX;
+    dmc620_set_policy_state(dmc, policy, ctx->mode, ctx->scrub_rate);
+    ctx->running = true;
+
+    return ctx->alarm_api->start(policy->alarm_id, policy->sampling_period_ms,
+                                 MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
 /* Framework API */
 static int mod_dmc620_init(fwk_id_t module_id, unsigned int element_count,
                            const void *config)
 {
+    power_policy_ctx_table = fwk_mm_calloc(element_count,
+                                           sizeof(power_policy_ctx_table[0]));
+    if (power_policy_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
 static int mod_dmc620_element_init(fwk_id_t element_id, unsigned int unused,
                                    const void *data)
 {
+    enum mod_dmc620_low_power_mode mode;
+    struct dmc620_power_policy_ctx *ctx;
+    const struct mod_dmc620_element_config *element_config = data;
+    const struct mod_dmc620_power_policy_config *policy;
+    const struct mod_dmc620_scrub_config *scrub;
+
     assert(data != NULL);
 
+    policy = element_config->power_policy;
+    if (policy == NULL)
+        return FWK_SUCCESS;
+
+    if ((policy->sampling_period_ms == 0) ||
+        (policy->pmu_counter >= MOD_DMC620_PMU_CLKDIV2_COUNTER_COUNT) ||
+        (policy->cluster_count > 32) ||
+        ((policy->cluster_count != 0) && (policy->cluster_pd_id_table == NULL)))
+        return FWK_E_DATA;
+
+    /* The idle rate is the fastest and the loaded rate the slowest */
+    scrub = policy->scrub;
+    if ((scrub != NULL) &&
+        ((scrub->rate[MOD_DMC620_SCRUB_RATE_IDLE].rate <
+          scrub->rate[MOD_DMC620_SCRUB_RATE_NOMINAL].rate) ||
+         (scrub->rate[MOD_DMC620_SCRUB_RATE_LOADED].rate >
+          scrub->rate[MOD_DMC620_SCRUB_RATE_NOMINAL].rate)))
+        return FWK_E_DATA;
+
+    ctx = &power_policy_ctx_table[fwk_id_get_element_idx(element_id)];
+
+    ctx->max_mode = MOD_DMC620_LOW_POWER_MODE_NONE;
+    for (mode = MOD_DMC620_LOW_POWER_MODE_POWER_DOWN;
+         mode < MOD_DMC620_LOW_POWER_MODE_COUNT; mode++) {
+        if (policy->mode[mode].exit_latency_ns > policy->latency_budget_ns)
+            break;
+        ctx->max_mode = mode;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -44,13 +277,22 @@ static int mod_dmc620_bind(fwk_id_t id, unsigned int round)
     int status;
     const struct mod_dmc620_module_config *module_config;
 
+    const struct mod_dmc620_element_config *element_config;
+
     /* Nothing to do in the second round of calls. */
     if (round == 1)
         return FWK_SUCCESS;
 
-    /* Nothing to do in case of elements. */
-    if (fwk_module_is_valid_element_id(id))
-        return FWK_SUCCESS;
+    if (fwk_module_is_valid_element_id(id)) {
+        element_config = fwk_module_get_data(id);
+        if (element_config->power_policy == NULL)
+            return FWK_SUCCESS;
+
+        /* Bind to the alarm sampling the traffic of the DMC */
+        return fwk_module_bind(element_config->power_policy->alarm_id,
+            MOD_TIMER_API_ID_ALARM,
+            &power_policy_ctx_table[fwk_id_get_element_idx(id)].alarm_api);
+    }
 
     module_config = fwk_module_get_data(fwk_module_id_dmc620);
     assert(module_config != NULL);
@@ -70,13 +312,30 @@ static int mod_dmc620_bind(fwk_id_t id, unsigned int round)
 
 static int mod_dmc620_start(fwk_id_t id)
 {
+    int status;
+    unsigned int cluster;
     const struct mod_dmc620_element_config *element_config;
+    const struct mod_dmc620_power_policy_config *policy;
 
     if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
         return FWK_SUCCESS;
 
     element_config = fwk_module_get_data(id);
 
+    if (element_config->power_policy != NULL) {
+        policy = element_config->power_policy;
+
+        /* Register for the power state transitions of the clusters */
+        for (cluster = 0; cluster < policy->cluster_count; cluster++) {
+            status = fwk_notification_subscribe(
+                mod_pd_notification_id_power_state_transition,
+                policy->cluster_pd_id_table[cluster],
+                id);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+    }
+
     /* Register elements for clock state notifications */
     return fwk_notification_subscribe(
         mod_clock_notification_id_state_changed,
@@ -86,13 +345,54 @@ static int mod_dmc620_start(fwk_id_t id)
 
 static int dmc620_notify_system_state_transition_resume(fwk_id_t id)
 {
+    int status;
     struct mod_dmc620_reg *dmc;
     const struct mod_dmc620_element_config *element_config;
 
     element_config = fwk_module_get_data(id);
     dmc = (struct mod_dmc620_reg *)element_config->dmc;
 
-    return dmc620_config(dmc, element_config->ddr_id);
+    status = dmc620_config(dmc, element_config->ddr_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return dmc620_power_policy_start(id);
+}
+
+/*
+ * The clusters are considered on until notified otherwise. The policy is
+ * updated on each transition so that the self-refresh mode is left as soon as
+ * a cluster is powered on, before the next sample.
+ */
+static int dmc620_notify_cluster_state_transition(fwk_id_t id,
+    fwk_id_t cluster_pd_id,
+    const struct mod_pd_power_state_transition_notification_params *params)
+{
+    unsigned int cluster;
+    struct dmc620_power_policy_ctx *ctx;
+    const struct mod_dmc620_element_config *element_config;
+    const struct mod_dmc620_power_policy_config *policy;
+
+    element_config = fwk_module_get_data(id);
+    policy = element_config->power_policy;
+    ctx = &power_policy_ctx_table[fwk_id_get_element_idx(id)];
+
+    for (cluster = 0; cluster < policy->cluster_count; cluster++) {
+        if (fwk_id_is_equal(policy->cluster_pd_id_table[cluster],
+                            cluster_pd_id))
+            break;
+    }
+    if (cluster == policy->cluster_count)
+        return FWK_E_PARAM;
+
+    if (params->state == MOD_PD_STATE_OFF)
+        ctx->cluster_off_mask |= UINT32_C(1) << cluster;
+    else
+        ctx->cluster_off_mask &= ~(UINT32_C(1) << cluster);
+
+    dmc620_power_policy_update(id);
+
+    return FWK_SUCCESS;
 }
 
 static int mod_dmc620_process_notification(
@@ -101,9 +401,18 @@ static int mod_dmc620_process_notification(
 {
     struct clock_notification_params *params;
 
-    assert(fwk_id_is_equal(event->id, mod_clock_notification_id_state_changed));
     assert(fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT));
 
+    if (fwk_id_is_equal(event->id,
+                        mod_pd_notification_id_power_state_transition)) {
+        return dmc620_notify_cluster_state_transition(event->target_id,
+            event->source_id,
+            (const struct mod_pd_power_state_transition_notification_params *)
+                event->params);
+    }
+
+    assert(fwk_id_is_equal(event->id, mod_clock_notification_id_state_changed));
+
     params = (struct clock_notification_params *)event->params;
 
     if (params->new_state == MOD_CLOCK_STATE_RUNNING)
@@ -112,6 +421,18 @@ static int mod_dmc620_process_notification(
     return FWK_SUCCESS;
 }
 
+static int mod_dmc620_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, mod_timer_event_id_alarm))
+        return FWK_E_PARAM;
+
+    /* Periodic sample of the traffic of the DMC */
+    dmc620_power_policy_sample(event->target_id);
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_dmc620 = {
     .name = "DMC620",
     .type = FWK_MODULE_TYPE_DRIVER,
@@ -120,6 +441,7 @@ const struct fwk_module module_dmc620 = {
     .bind = mod_dmc620_bind,
     .start = mod_dmc620_start,
     .process_notification = mod_dmc620_process_notification,
+    .process_event = mod_dmc620_process_event,
     .api_count = 0,
     .event_count = 0,
 };
@@ -134,12 +456,12 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     module_config = fwk_module_get_data(fwk_module_id_dmc620);
     reg_val = module_config->dmc_val;
 
-    status = log_api->log(MOD_LOG_GROUP_INFO,
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Initialising DMC620 at 0x%x\n", (uintptr_t) dmc);
     if (status != FWK_SUCCESS)
         return status;
 
-    status = log_api->log(MOD_LOG_GROUP_INFO,
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Writing functional settings\n");
     if (status != FWK_SUCCESS)
         return status;
@@ -209,7 +531,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     dmc->MUX_CONTROL_NEXT = reg_val->MUX_CONTROL_NEXT;
 
     /* Timing Configuration */
-    status = log_api->log(MOD_LOG_GROUP_INFO,
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Writing timing settings\n");
     if (status != FWK_SUCCESS)
         return status;
@@ -271,7 +593,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     for (i = 0; i < 3; i++) /* ~200ns */
         __NOP();
 
-    status = log_api->log(MOD_LOG_GROUP_INFO,
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Sending direct DDR commands\n");
     if (status != FWK_SUCCESS)
         return status;
@@ -282,7 +604,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
         __NOP();
 
     /* Switch to READY */
-    status = log_api->log(MOD_LOG_GROUP_INFO,
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Setting DMC to READY mode\n");
     if (status != FWK_SUCCESS)
         return status;
@@ -293,7 +615,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) != MOD_DMC620_MEMC_CMD_GO)
         continue;
 
-    status = log_api->log(MOD_LOG_GROUP_INFO, "[DDR] DMC init done.\n");
+    status = MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] DMC init done.\n");
     if (status != FWK_SUCCESS)
         return status;
 
@@ -8,6 +8,7 @@
 #ifndef MOD_DVFS_H
 #define MOD_DVFS_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <fwk_id.h>
@@ -38,8 +39,49 @@ struct mod_dvfs_frequency_limits {
 struct mod_dvfs_opp {
     uint64_t voltage; /*!< Power supply voltage in millivolts (mV) */
     uint64_t frequency; /*!< Clock rate in Hertz (Hz) */
+
+    /*!
+     * \brief Power cost in milliwatts (mW), or zero if it is not known.
+     *
+     * \details The power costs reported by the domain API are scaled by the
+     *      calibration of the domain, see
+     *      \ref mod_dvfs_domain_config::power_sensor_id.
+     */
+    uint32_t power;
+};
+
+/*!
+ * \brief Energy table header.
+ *
+ * \details The energy table describes the operating points of all the
+ *      domains, and their power costs. The header is followed by the entries
+ *      of the operating points, in ascending order of domain index first, and
+ *      of frequency then.
+ */
+struct mod_dvfs_energy_table_header {
+    uint32_t entry_count; /*!< Number of entries */
 };
 
+/*!
+ * \brief Energy table entry.
+ */
+struct mod_dvfs_energy_table_entry {
+    uint16_t domain_idx; /*!< Index of the domain */
+    uint16_t opp_idx; /*!< Index of the operating point in the domain */
+    uint32_t frequency; /*!< Clock rate in kilohertz (kHz) */
+    uint32_t voltage; /*!< Power supply voltage in millivolts (mV) */
+    uint32_t power; /*!< Calibrated power cost in milliwatts (mW) */
+};
+
+/*!
+ * \brief Size of an energy table.
+ *
+ * \param ENTRY_COUNT Number of operating points of all the domains.
+ */
+#define MOD_DVFS_ENERGY_TABLE_SIZE(ENTRY_COUNT) \
+    (sizeof(struct mod_dvfs_energy_table_header) + \
+     ((ENTRY_COUNT) * sizeof(struct mod_dvfs_energy_table_entry)))
+
 /*!
  * \}
  */
@@ -49,6 +91,50 @@ struct mod_dvfs_opp {
  * \{
  */
 
+/*!
+ * \brief Transition mode of the asynchronous requests.
+ */
+enum mod_dvfs_transition_mode {
+    /*!
+     * \brief Sequential transitions.
+     *
+     * \details The voltage and the clock are programmed one after the other
+     *      from a single event, which blocks until the voltage is reached.
+     */
+    MOD_DVFS_TRANSITION_MODE_SEQUENTIAL,
+
+    /*!
+     * \brief Overlapped transitions.
+     *
+     * \details The voltage is programmed through the asynchronous interface
+     *      of the power supply, and the clock is programmed as soon as the
+     *      power supply reports the completion of the voltage change. Other
+     *      events are processed while the voltage ramps, and the requests
+     *      submitted during a transition are coalesced and applied once it
+     *      completes.
+     *
+     * \note The synchronous requests fail with \ref FWK_E_BUSY while a
+     *      transition is in progress.
+     */
+    MOD_DVFS_TRANSITION_MODE_OVERLAPPED,
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_dvfs_config {
+    /*!
+     * \brief Identifier of the SDS structure the energy table is exported
+     *      to, or zero if the energy table is not exported.
+     *
+     * \details The structure must be at least \ref MOD_DVFS_ENERGY_TABLE_SIZE
+     *      bytes large. The table is written once the SDS module is
+     *      initialized, and the entries of a domain are updated whenever its
+     *      calibration changes. The export requires the SDS module.
+     */
+    uint32_t energy_table_sds_id;
+};
+
 /*!
  * \brief Domain configuration.
  */
@@ -56,10 +142,27 @@ struct mod_dvfs_domain_config {
     /*!
      * \brief Power supply identifier.
      *
+     * \details The domain has no power supply if the identifier is not an
+     *      element identifier, as for the memory controller and interconnect
+     *      clocks on a fixed supply. Only the frequency of these domains is
+     *      changed, the voltages of their operating points are nominal.
+     *
      * \warning This identifier must refer to an element of the \c psu module.
      */
     fwk_id_t psu_id;
 
+    /*!
+     * \brief The power supply is shared with other domains.
+     *
+     * \details The domain votes for the voltage of its operating points as
+     *      the voter \ref psu_voter_idx of the power supply, which arbitrates
+     *      between the votes of the domains, rather than setting the voltage.
+     */
+    bool psu_shared;
+
+    /*! Index of the domain among the voters of a shared power supply */
+    unsigned int psu_voter_idx;
+
     /*!
      * \brief Clock identifier.
      *
@@ -73,11 +176,34 @@ struct mod_dvfs_domain_config {
     /*! Sustained operating point index */
     size_t sustained_idx;
 
+    /*! Transition mode of the asynchronous requests */
+    enum mod_dvfs_transition_mode transition_mode;
+
+    /*!
+     * \brief Identifier of the power sensor of the domain, used to calibrate
+     *      the power costs of the operating points.
+     *
+     * \details When a frequency change is requested asynchronously, the
+     *      sensor is read and the ratio of its value to the power cost of the
+     *      current operating point updates the calibration scale of the power
+     *      costs of the domain. The sensor must report values in milliwatts
+     *      (mW), representative of the power cost of the operating points.
+     *
+     *      The power costs are not calibrated if the identifier is not an
+     *      element identifier, or in firmware without the sensor module.
+     */
+    fwk_id_t power_sensor_id;
+
     /*!
      * \brief Operating points.
      *
-     * \note The frequencies of these operating points must be in ascending
-     *      order.
+     * \note The frequencies of these operating points must be in strictly
+     *      ascending order. The initialization of the domain fails with
+     *      \ref FWK_E_DATA otherwise.
+     *
+     * \note The voltages of these operating points are the nominal ones. They
+     *      can be trimmed at runtime, see
+     *      \ref mod_dvfs_domain_api::set_opp_voltage.
      */
     struct mod_dvfs_opp *opps;
 };
@@ -152,10 +278,24 @@ struct mod_dvfs_domain_api {
     /*!
      * \brief Set the frequency of a domain.
      *
-     * \note This function is asynchronous.
+     * \note This function is asynchronous. Once the transition is complete,
+     *      the caller receives a response to the
+     *      \ref mod_dvfs_event_id_set_frequency event.
+     *
+     * \note The requests submitted before the transition starts are
+     *      coalesced: only the latest frequency is applied, and all the
+     *      callers receive the status of its transition.
      *
      * \param domain_id Element identifier of the domain.
-     * \param idx Index of the operating point to transition to.
+     * \param frequency Frequency of the operating point to transition to.
+     *
+     * \retval FWK_SUCCESS The request was submitted.
+     * \retval FWK_E_PARAM The domain identifier is not valid.
+     * \retval FWK_E_RANGE The frequency is not supported or is out of the
+     *      current limits.
+     * \retval FWK_E_NOMEM The event queue is full.
+     * \return One of the other specific error codes described by the
+     *      framework.
      */
     int (*set_frequency_async)(fwk_id_t domain_id, uint64_t frequency);
 
@@ -180,16 +320,45 @@ struct mod_dvfs_domain_api {
         const struct mod_dvfs_frequency_limits *limits);
 
     /*!
-     * \brief Set the frequency of a domain.
+     * \brief Set the frequency limits of a domain.
      *
-     * \note This function is asynchronous.
+     * \note This function is asynchronous. Once the limits are applied, the
+     *      caller receives a response to the
+     *      \ref mod_dvfs_event_id_set_frequency_limits event.
      *
      * \param domain_id Element identifier of the domain.
      * \param limits Pointer to the new limits.
+     *
+     * \retval FWK_SUCCESS The request was submitted.
+     * \retval FWK_E_PARAM The domain identifier or the limits are not valid.
+     * \retval FWK_E_NOMEM The event queue is full.
+     * \return One of the other specific error codes described by the
+     *      framework.
      */
     int (*set_frequency_limits_async)(
         fwk_id_t domain_id,
         const struct mod_dvfs_frequency_limits *limits);
+
+    /*!
+     * \brief Trim the voltage of an operating point of a domain.
+     *
+     * \details The voltage replaces the one of the operating point in the
+     *      transitions that follow, and is applied immediately if the domain
+     *      is at that operating point. The voltage cannot be raised above the
+     *      configured nominal voltage of the operating point, which is the
+     *      only way back for a trimmed voltage.
+     *
+     * \param domain_id Element identifier of the domain.
+     * \param n Index of the operating point.
+     * \param voltage New voltage in millivolts (mV).
+     *
+     * \retval FWK_SUCCESS The voltage was trimmed.
+     * \retval FWK_E_PARAM The domain identifier or the index is not valid.
+     * \retval FWK_E_RANGE The voltage is zero or above the nominal voltage.
+     * \retval FWK_E_BUSY A transition of the domain is in progress.
+     * \retval FWK_E_DEVICE The voltage could not be applied.
+     */
+    int (*set_opp_voltage)(fwk_id_t domain_id, size_t n, uint64_t voltage);
 };
 
 /*!
@@ -260,6 +429,27 @@ static const fwk_id_t mod_dvfs_event_id_set_frequency_limits =
         FWK_MODULE_IDX_DVFS,
         MOD_DVFS_EVENT_IDX_SET_FREQUENCY_LIMITS);
 
+/*!
+ * \brief Trace point indices, see \ref FWK_TRACE_ID_MODULE.
+ */
+enum mod_dvfs_trace_idx {
+    /*!
+     * \brief Start of an overlapped transition.
+     *
+     * \details The value is the frequency of the transition in kHz.
+     */
+    MOD_DVFS_TRACE_IDX_TRANSITION_START,
+
+    /*!
+     * \brief End of an overlapped transition, once the power supply has
+     *      responded.
+     *
+     * \details The value is the status of the transition. Transitions not
+     *      changing the voltage complete at once and have no end trace point.
+     */
+    MOD_DVFS_TRACE_IDX_TRANSITION_END,
+};
+
 /*!
  * \}
  */
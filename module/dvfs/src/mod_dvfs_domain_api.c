@@ -7,61 +7,74 @@
 
 #include <stdbool.h>
 #include <fwk_assert.h>
+#include <fwk_event.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <mod_clock.h>
 #include <mod_dvfs_private.h>
 #include <mod_psu.h>
 
-static const struct mod_dvfs_opp *get_opp_for_values(
+/*
+ * Find the index of the operating point of a frequency. The operating points
+ * are sorted by ascending frequency, which is checked when the domain is
+ * initialized.
+ */
+static bool get_opp_idx(
     const struct mod_dvfs_domain_ctx *ctx,
     uint64_t frequency,
-    uint64_t voltage)
+    size_t *opp_idx)
 {
-    size_t opp_idx;
-    const struct mod_dvfs_opp *opp;
-
-    /* A value of zero indicates the parameter should be ignored */
-    assert((frequency != 0) || (voltage != 0));
-
-    for (opp_idx = 0; opp_idx < ctx->opp_count; opp_idx++) {
-        opp = &ctx->config->opps[opp_idx];
-
-        /* Only check the frequency if requested */
-        if ((frequency != 0) && (opp->frequency != frequency))
-            continue;
-
-        /* Only check the voltage if requested */
-        if ((voltage != 0) && (opp->voltage != voltage))
-            continue;
-
-        return opp;
+    size_t low = 0;
+    size_t high = ctx->opp_count;
+    size_t mid;
+    uint64_t mid_frequency;
+
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        mid_frequency = ctx->opps[mid].frequency;
+
+        if (mid_frequency == frequency) {
+            *opp_idx = mid;
+            return true;
+        }
+
+        if (mid_frequency < frequency)
+            low = mid + 1;
+        else
+            high = mid;
     }
 
-    return NULL;
+    return false;
 }
 
 static bool is_opp_within_limits(
-    const struct mod_dvfs_opp *opp,
-    const struct mod_dvfs_frequency_limits *limits)
+    const struct mod_dvfs_domain_ctx *ctx,
+    size_t opp_idx)
 {
-    return (opp->frequency >= limits->minimum) &&
-           (opp->frequency <= limits->maximum);
+    return (opp_idx >= ctx->limits_min_idx) &&
+           (opp_idx <= ctx->limits_max_idx);
 }
 
-static bool are_limits_valid(
+/*
+ * Check that the limits match operating points and get the indices of these
+ * operating points.
+ */
+static bool get_limits_idx(
     const struct mod_dvfs_domain_ctx *ctx,
-    const struct mod_dvfs_frequency_limits *limits)
+    const struct mod_dvfs_frequency_limits *limits,
+    size_t *min_idx,
+    size_t *max_idx)
 {
     if (limits->minimum > limits->maximum)
         return false;
 
-    if (get_opp_for_values(ctx, limits->minimum, 0) == NULL)
+    if (!get_opp_idx(ctx, limits->minimum, min_idx))
         return false;
 
-    if (get_opp_for_values(ctx, limits->maximum, 0) == NULL)
+    if (!get_opp_idx(ctx, limits->maximum, max_idx))
         return false;
 
     return true;
@@ -70,20 +83,19 @@ static bool are_limits_valid(
 static const struct mod_dvfs_opp *adjust_opp_for_new_limits(
     const struct mod_dvfs_domain_ctx *ctx,
     const struct mod_dvfs_opp *opp,
-    const struct mod_dvfs_frequency_limits *limits)
+    size_t min_idx,
+    size_t max_idx)
 {
-    uint64_t needle;
-
-    if (opp->frequency < limits->minimum)
-        needle = limits->minimum;
-    else if (opp->frequency > limits->maximum)
-        needle = limits->maximum;
-    else {
-        /* No transition necessary */
-        return opp;
-    }
+    const struct mod_dvfs_opp *min_opp = &ctx->opps[min_idx];
+    const struct mod_dvfs_opp *max_opp = &ctx->opps[max_idx];
+
+    if (opp->frequency < min_opp->frequency)
+        return min_opp;
+    else if (opp->frequency > max_opp->frequency)
+        return max_opp;
 
-    return get_opp_for_values(ctx, needle, 0);
+    /* No transition necessary */
+    return opp;
 }
 
 static int api_get_current_opp(fwk_id_t domain_id, struct mod_dvfs_opp *opp)
@@ -114,7 +126,8 @@ int api_get_sustained_opp(fwk_id_t domain_id, struct mod_dvfs_opp *opp)
     if (ctx == NULL)
         return FWK_E_PARAM;
 
-    *opp = ctx->config->opps[ctx->config->sustained_idx];
+    *opp = ctx->opps[ctx->config->sustained_idx];
+    opp->power = __mod_dvfs_get_opp_power(ctx, ctx->config->sustained_idx);
 
     return FWK_SUCCESS;
 }
@@ -134,7 +147,8 @@ int api_get_nth_opp(fwk_id_t domain_id,
     if (n >= ctx->opp_count)
         return FWK_E_PARAM;
 
-    *opp = ctx->config->opps[n];
+    *opp = ctx->opps[n];
+    opp->power = __mod_dvfs_get_opp_power(ctx, n);
 
     return FWK_SUCCESS;
 }
@@ -169,34 +183,170 @@ int api_get_latency(fwk_id_t domain_id, uint16_t *latency)
     return FWK_SUCCESS;
 }
 
-static int api_set_frequency(fwk_id_t domain_id, uint64_t frequency)
+static int api_set_opp_voltage(fwk_id_t domain_id, size_t n, uint64_t voltage)
 {
     int status;
-    const struct mod_dvfs_domain_ctx *ctx;
-    const struct mod_dvfs_opp *new_opp;
+    struct mod_dvfs_domain_ctx *ctx;
+    struct mod_dvfs_opp *opp;
+    uint64_t frequency;
 
     ctx = __mod_dvfs_get_valid_domain_ctx(domain_id);
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    if (n >= ctx->opp_count)
+        return FWK_E_PARAM;
+
+    /* The voltage can only be trimmed below the nominal one */
+    if ((voltage == 0) || (voltage > ctx->config->opps[n].voltage))
+        return FWK_E_RANGE;
+
+    /* The operating point may be the target of the transition in progress */
+    if (ctx->transition.state != MOD_DVFS_TRANSITION_STATE_IDLE)
+        return FWK_E_BUSY;
+
+    opp = &ctx->opps[n];
+    if (voltage == opp->voltage)
+        return FWK_SUCCESS;
+
+    /* Apply the new voltage if the domain is at the operating point */
+    if (__mod_dvfs_has_psu(ctx)) {
+        status = ctx->apis.clock->get_rate(ctx->config->clock_id, &frequency);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        if (frequency == opp->frequency) {
+            status = __mod_dvfs_set_voltage(ctx, voltage);
+            if (status != FWK_SUCCESS)
+                return FWK_E_DEVICE;
+        }
+    }
+
+    opp->voltage = voltage;
+
+    /* The domain resumes at the new voltage */
+    if (ctx->suspended_opp.frequency == opp->frequency)
+        ctx->suspended_opp.voltage = voltage;
+
+    __mod_dvfs_energy_update(domain_id);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Get the operating point of a frequency, provided it is within the current
+ * limits of the domain.
+ */
+const struct mod_dvfs_opp *__mod_dvfs_get_opp_for_frequency(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint64_t frequency)
+{
+    size_t opp_idx;
+
     /* Only accept frequencies that exist in the operating point table */
-    new_opp = get_opp_for_values(ctx, frequency, 0);
+    if (!get_opp_idx(ctx, frequency, &opp_idx))
+        return NULL;
+
+    if (!is_opp_within_limits(ctx, opp_idx))
+        return NULL;
+
+    return &ctx->opps[opp_idx];
+}
+
+int __mod_dvfs_set_frequency(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint64_t frequency)
+{
+    const struct mod_dvfs_opp *new_opp;
+
+    if (ctx->transition.state != MOD_DVFS_TRANSITION_STATE_IDLE)
+        return FWK_E_BUSY;
+
+    new_opp = __mod_dvfs_get_opp_for_frequency(ctx, frequency);
     if (new_opp == NULL)
         return FWK_E_RANGE;
 
-    if (!is_opp_within_limits(new_opp, &ctx->frequency_limits))
-        return FWK_E_RANGE;
+    return __mod_dvfs_set_opp(ctx, new_opp);
+}
+
+int __mod_dvfs_set_frequency_limits(
+    struct mod_dvfs_domain_ctx *ctx,
+    const struct mod_dvfs_frequency_limits *limits)
+{
+    int status;
+    size_t min_idx, max_idx;
+    struct mod_dvfs_opp current_opp;
+    const struct mod_dvfs_opp *new_opp;
+
+    if (ctx->transition.state != MOD_DVFS_TRANSITION_STATE_IDLE)
+        return FWK_E_BUSY;
+
+    if (!get_limits_idx(ctx, limits, &min_idx, &max_idx))
+        return FWK_E_PARAM;
+
+    status = __mod_dvfs_get_current_opp(ctx, &current_opp);
+    if (status != FWK_SUCCESS)
+        return status;
 
+    new_opp = adjust_opp_for_new_limits(ctx, &current_opp, min_idx, max_idx);
     status = __mod_dvfs_set_opp(ctx, new_opp);
     if (status != FWK_SUCCESS)
         return status;
 
+    ctx->frequency_limits = *limits;
+    ctx->limits_min_idx = min_idx;
+    ctx->limits_max_idx = max_idx;
+
     return FWK_SUCCESS;
 }
 
+static int api_set_frequency(fwk_id_t domain_id, uint64_t frequency)
+{
+    const struct mod_dvfs_domain_ctx *ctx;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    return __mod_dvfs_set_frequency(ctx, frequency);
+}
+
 static int api_set_frequency_async(fwk_id_t domain_id, uint64_t frequency)
 {
-    return FWK_E_SUPPORT;
+    int status;
+    struct mod_dvfs_domain_ctx *ctx;
+    struct fwk_event event;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    /*
+     * Reject invalid requests now so that the caller does not have to wait
+     * for the response to find out. The request is validated again when the
+     * event is processed, as the limits may have changed in the meantime.
+     */
+    if (__mod_dvfs_get_opp_for_frequency(ctx, frequency) == NULL)
+        return FWK_E_RANGE;
+
+    /* Build and submit the event */
+    event = (struct fwk_event) {
+        .id = mod_dvfs_event_id_set_frequency,
+        .target_id = domain_id,
+        .response_requested = true,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_E_NOMEM)
+        return FWK_E_NOMEM;
+    else if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    /* Supersede any request that has not been applied yet */
+    ctx->frequency_request = frequency;
+    ctx->frequency_request_pending = true;
+
+    return FWK_SUCCESS;
 }
 
 int api_get_frequency_limits(
@@ -218,37 +368,51 @@ static int api_set_frequency_limits(
     fwk_id_t domain_id,
     const struct mod_dvfs_frequency_limits *limits)
 {
-    int status;
     struct mod_dvfs_domain_ctx *ctx;
-    struct mod_dvfs_opp current_opp;
-    const struct mod_dvfs_opp *new_opp;
 
     ctx = __mod_dvfs_get_valid_domain_ctx(domain_id);
     if (ctx == NULL)
         return FWK_E_PARAM;
 
-    if (!are_limits_valid(ctx, limits))
-        return FWK_E_PARAM;
-
-    status = __mod_dvfs_get_current_opp(ctx, &current_opp);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    new_opp = adjust_opp_for_new_limits(ctx, &current_opp, limits);
-    status = __mod_dvfs_set_opp(ctx, new_opp);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    ctx->frequency_limits = *limits;
-
-    return FWK_SUCCESS;
+    return __mod_dvfs_set_frequency_limits(ctx, limits);
 }
 
 static int api_set_frequency_limits_async(
     fwk_id_t domain_id,
     const struct mod_dvfs_frequency_limits *limits)
 {
-    return FWK_E_SUPPORT;
+    int status;
+    size_t min_idx, max_idx;
+    const struct mod_dvfs_domain_ctx *ctx;
+    struct fwk_event event;
+    struct mod_dvfs_event_params_set_frequency_limits *params;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(domain_id);
+    if (ctx == NULL)
+        return FWK_E_PARAM;
+
+    if (!get_limits_idx(ctx, limits, &min_idx, &max_idx))
+        return FWK_E_PARAM;
+
+    /* Build and submit the event */
+    event = (struct fwk_event) {
+        .id = mod_dvfs_event_id_set_frequency_limits,
+        .target_id = domain_id,
+        .response_requested = true,
+    };
+
+    params = (void *)&event.params;
+    *params = (struct mod_dvfs_event_params_set_frequency_limits) {
+        .limits = *limits,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_E_NOMEM)
+        return FWK_E_NOMEM;
+    else if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
 }
 
 const struct mod_dvfs_domain_api __mod_dvfs_domain_api = {
@@ -262,4 +426,5 @@ const struct mod_dvfs_domain_api __mod_dvfs_domain_api = {
     .get_frequency_limits = api_get_frequency_limits,
     .set_frequency_limits = api_set_frequency_limits,
     .set_frequency_limits_async = api_set_frequency_limits_async,
+    .set_opp_voltage = api_set_opp_voltage,
 };
@@ -8,9 +8,27 @@
 #ifndef MOD_DVFS_DOMAIN_API_PRIVATE_H
 #define MOD_DVFS_DOMAIN_API_PRIVATE_H
 
+#include <stdint.h>
 #include <mod_dvfs.h>
 
+struct mod_dvfs_domain_ctx;
+
 /* Module API implementation */
 extern const struct mod_dvfs_domain_api __mod_dvfs_domain_api;
 
+/* Get the operating point of a frequency within the current limits */
+const struct mod_dvfs_opp *__mod_dvfs_get_opp_for_frequency(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint64_t frequency);
+
+/* Transition to the operating point of a frequency */
+int __mod_dvfs_set_frequency(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uint64_t frequency);
+
+/* Update the frequency limits, adjusting the operating point if needed */
+int __mod_dvfs_set_frequency_limits(
+    struct mod_dvfs_domain_ctx *ctx,
+    const struct mod_dvfs_frequency_limits *limits);
+
 #endif /* MOD_DVFS_DOMAIN_API_PRIVATE_H */
@@ -0,0 +1,274 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_notification.h>
+#include <mod_dvfs_private.h>
+#if BUILD_HAS_MOD_SDS
+#include <mod_sds.h>
+#endif
+
+#if BUILD_HAS_MOD_SDS
+static struct {
+    /* Module configuration, NULL if the energy table is not exported */
+    const struct mod_dvfs_config *config;
+
+    /* SDS API */
+    const struct mod_sds_api *sds_api;
+
+    /* The SDS module is initialized and the energy table written */
+    bool exported;
+} energy_ctx;
+
+/* Get the offset of the first entry of a domain in the energy table */
+static unsigned int get_entry_offset(unsigned int domain_idx)
+{
+    unsigned int offset = sizeof(struct mod_dvfs_energy_table_header);
+    unsigned int idx;
+
+    for (idx = 0; idx < domain_idx; idx++) {
+        offset += __mod_dvfs_get_valid_domain_ctx(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, idx))->opp_count *
+            sizeof(struct mod_dvfs_energy_table_entry);
+    }
+
+    return offset;
+}
+
+/* Write the entries of a domain to the energy table */
+static int export_domain(unsigned int domain_idx)
+{
+    const struct mod_dvfs_domain_ctx *ctx;
+    struct mod_dvfs_energy_table_entry entry;
+    const struct mod_dvfs_opp *opp;
+    unsigned int offset;
+    size_t opp_idx;
+    int status;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx));
+    offset = get_entry_offset(domain_idx);
+
+    for (opp_idx = 0; opp_idx < ctx->opp_count; opp_idx++) {
+        opp = &ctx->opps[opp_idx];
+
+        entry = (struct mod_dvfs_energy_table_entry) {
+            .domain_idx = (uint16_t)domain_idx,
+            .opp_idx = (uint16_t)opp_idx,
+            .frequency = (uint32_t)(opp->frequency / FWK_KHZ),
+            .voltage = (uint32_t)opp->voltage,
+            .power = __mod_dvfs_get_opp_power(ctx, opp_idx),
+        };
+
+        status = energy_ctx.sds_api->struct_write(
+            energy_ctx.config->energy_table_sds_id,
+            offset, &entry, sizeof(entry));
+        if (status != FWK_SUCCESS)
+            return status;
+
+        offset += sizeof(entry);
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int export_table(void)
+{
+    struct mod_dvfs_energy_table_header header = { 0 };
+    unsigned int domain_count;
+    unsigned int domain_idx;
+    int status;
+
+    domain_count = fwk_module_get_element_count(fwk_module_id_dvfs);
+
+    for (domain_idx = 0; domain_idx < domain_count; domain_idx++) {
+        status = export_domain(domain_idx);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        header.entry_count += __mod_dvfs_get_valid_domain_ctx(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx))->opp_count;
+    }
+
+    status = energy_ctx.sds_api->struct_write(
+        energy_ctx.config->energy_table_sds_id,
+        0, &header, sizeof(header));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = energy_ctx.sds_api->struct_finalize(
+        energy_ctx.config->energy_table_sds_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    energy_ctx.exported = true;
+
+    return FWK_SUCCESS;
+}
+#endif
+
+int __mod_dvfs_energy_init(const struct mod_dvfs_config *config)
+{
+    #if BUILD_HAS_MOD_SDS
+    if ((config != NULL) && (config->energy_table_sds_id != 0))
+        energy_ctx.config = config;
+    #endif
+
+    return FWK_SUCCESS;
+}
+
+int __mod_dvfs_energy_bind(void)
+{
+    #if BUILD_HAS_MOD_SDS
+    if (energy_ctx.config == NULL)
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(fwk_module_id_sds,
+                           FWK_ID_API(FWK_MODULE_IDX_SDS, 0),
+                           &energy_ctx.sds_api);
+    #else
+    return FWK_SUCCESS;
+    #endif
+}
+
+int __mod_dvfs_energy_start(fwk_id_t module_id)
+{
+    #if BUILD_HAS_MOD_SDS
+    if (energy_ctx.config == NULL)
+        return FWK_SUCCESS;
+
+    return fwk_notification_subscribe(
+        mod_sds_notification_id_initialized,
+        fwk_module_id_sds,
+        module_id);
+    #else
+    return FWK_SUCCESS;
+    #endif
+}
+
+int __mod_dvfs_process_energy_notification(const struct fwk_event *event)
+{
+    #if BUILD_HAS_MOD_SDS
+    if (!fwk_id_is_equal(event->id, mod_sds_notification_id_initialized))
+        return FWK_E_PARAM;
+
+    return export_table();
+    #else
+    return FWK_E_PARAM;
+    #endif
+}
+
+void __mod_dvfs_energy_update(fwk_id_t domain_id)
+{
+    #if BUILD_HAS_MOD_SDS
+    if (energy_ctx.exported)
+        export_domain(fwk_id_get_element_idx(domain_id));
+    #endif
+}
+
+uint32_t __mod_dvfs_get_opp_power(
+    const struct mod_dvfs_domain_ctx *ctx,
+    size_t opp_idx)
+{
+    uint64_t power;
+
+    power = ((uint64_t)ctx->opps[opp_idx].power * ctx->power_scale) /
+            MOD_DVFS_POWER_SCALE_UNITY;
+
+    return (uint32_t)FWK_MIN(power, (uint64_t)UINT32_MAX);
+}
+
+#if BUILD_HAS_MOD_SENSOR
+/*
+ * Update the calibration scale of a domain from the power read at one of its
+ * operating points. The scale moves by a quarter of the way to the ratio of
+ * the power read to the configured power cost, so that the power costs are
+ * not thrown off by a single reading.
+ */
+static void update_power_scale(
+    struct mod_dvfs_domain_ctx *ctx,
+    fwk_id_t domain_id,
+    size_t opp_idx,
+    uint64_t value)
+{
+    int64_t ratio;
+    int64_t scale;
+
+    ratio = (int64_t)((value * MOD_DVFS_POWER_SCALE_UNITY) /
+                      ctx->opps[opp_idx].power);
+    ratio = FWK_MIN(ratio, (int64_t)UINT32_MAX);
+
+    scale = (int64_t)ctx->power_scale;
+    scale += (ratio - scale) / 4;
+
+    if (scale == (int64_t)ctx->power_scale)
+        return;
+
+    ctx->power_scale = (uint32_t)scale;
+
+    __mod_dvfs_energy_update(domain_id);
+}
+#endif
+
+void __mod_dvfs_calibrate_power(
+    struct mod_dvfs_domain_ctx *ctx,
+    fwk_id_t domain_id)
+{
+    #if BUILD_HAS_MOD_SENSOR
+    const struct mod_dvfs_opp *opp;
+    struct mod_dvfs_opp current_opp;
+    uint64_t value;
+    int status;
+
+    if ((ctx->apis.sensor == NULL) || ctx->power_reading_pending)
+        return;
+
+    status = __mod_dvfs_get_current_opp(ctx, &current_opp);
+    if (status != FWK_SUCCESS)
+        return;
+
+    /* Only the operating points with a power cost are calibrated */
+    opp = __mod_dvfs_get_opp_for_frequency(ctx, current_opp.frequency);
+    if ((opp == NULL) || (opp->power == 0))
+        return;
+
+    ctx->power_reading_opp_idx = opp - ctx->opps;
+
+    status = ctx->apis.sensor->get_value(ctx->config->power_sensor_id, &value);
+    if (status == FWK_SUCCESS)
+        update_power_scale(ctx, domain_id, ctx->power_reading_opp_idx, value);
+    else if (status == FWK_PENDING)
+        ctx->power_reading_pending = true;
+    #endif
+}
+
+int __mod_dvfs_process_power_reading(const struct fwk_event *event)
+{
+    #if BUILD_HAS_MOD_SENSOR
+    struct mod_dvfs_domain_ctx *ctx;
+    const struct mod_sensor_event_params *params;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(event->target_id);
+    if ((ctx == NULL) || !ctx->power_reading_pending)
+        return FWK_E_STATE;
+
+    ctx->power_reading_pending = false;
+
+    params = (const void *)&event->params;
+    if (params->status == FWK_SUCCESS) {
+        update_power_scale(ctx, event->target_id, ctx->power_reading_opp_idx,
+                           params->value);
+    }
+
+    return FWK_SUCCESS;
+    #else
+    return FWK_E_PARAM;
+    #endif
+}
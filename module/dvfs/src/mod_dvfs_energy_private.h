@@ -0,0 +1,53 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MOD_DVFS_ENERGY_PRIVATE_H
+#define MOD_DVFS_ENERGY_PRIVATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <mod_dvfs.h>
+#include <mod_dvfs_module_private.h>
+
+/* Calibration scale of the power costs as configured, in Q16 fixed point */
+#define MOD_DVFS_POWER_SCALE_UNITY (UINT32_C(1) << 16)
+
+/* Initialize the export of the energy table */
+int __mod_dvfs_energy_init(const struct mod_dvfs_config *config);
+
+/* Bind to the modules the export of the energy table relies on */
+int __mod_dvfs_energy_bind(void);
+
+/* Start the export of the energy table */
+int __mod_dvfs_energy_start(fwk_id_t module_id);
+
+/* Update the entries of a domain in the energy table, once exported */
+void __mod_dvfs_energy_update(fwk_id_t domain_id);
+
+/* Get the calibrated power cost of an operating point of a domain */
+uint32_t __mod_dvfs_get_opp_power(
+    const struct mod_dvfs_domain_ctx *ctx,
+    size_t opp_idx);
+
+/*
+ * Read the power sensor of a domain to calibrate the power cost of its
+ * current operating point. This must be called while processing an event
+ * targeting the domain, so that a pending reading is reported to it.
+ */
+void __mod_dvfs_calibrate_power(
+    struct mod_dvfs_domain_ctx *ctx,
+    fwk_id_t domain_id);
+
+/* Process the response to a pending reading of a power sensor */
+int __mod_dvfs_process_power_reading(const struct fwk_event *event);
+
+/* Process the notification of the initialization of the SDS module */
+int __mod_dvfs_process_energy_notification(const struct fwk_event *event);
+
+#endif /* MOD_DVFS_ENERGY_PRIVATE_H */
@@ -5,21 +5,265 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <fwk_assert.h>
 #include <fwk_macros.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <fwk_trace.h>
+#include <mod_clock.h>
 #include <mod_dvfs_private.h>
+#include <mod_psu.h>
+
+/*
+ * Start an overlapped transition to the latest frequency request. The
+ * transition is in progress on return if its state is not idle, in which case
+ * it completes when the power supply responds.
+ */
+static int start_transition(struct mod_dvfs_domain_ctx *ctx)
+{
+    int status;
+    struct mod_dvfs_opp current_opp;
+    const struct mod_dvfs_opp *new_opp;
+
+    ctx->frequency_request_pending = false;
+
+    new_opp = __mod_dvfs_get_opp_for_frequency(ctx, ctx->frequency_request);
+    if (new_opp == NULL)
+        return FWK_E_RANGE;
+
+    status = __mod_dvfs_get_current_opp(ctx, &current_opp);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->transition.opp = new_opp;
+    ctx->transition.set_rate = (new_opp->frequency != current_opp.frequency);
+
+    FWK_TRACE(FWK_TRACE_ID_MODULE(FWK_MODULE_IDX_DVFS,
+                                  MOD_DVFS_TRACE_IDX_TRANSITION_START),
+              (uint32_t)(new_opp->frequency / 1000));
+
+    if (__mod_dvfs_has_psu(ctx) && (new_opp->voltage > current_opp.voltage)) {
+        /* Raise the voltage, the clock is set once it is reached */
+        status = __mod_dvfs_set_voltage_async(ctx, new_opp->voltage);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        ctx->transition.psu_request_count++;
+        ctx->transition.state = MOD_DVFS_TRANSITION_STATE_RAISING_VOLTAGE;
+
+        return FWK_SUCCESS;
+    }
+
+    if (ctx->transition.set_rate) {
+        status = ctx->apis.clock->set_rate(
+            ctx->config->clock_id,
+            new_opp->frequency,
+            MOD_CLOCK_ROUND_MODE_NONE);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+    }
+
+    if (__mod_dvfs_has_psu(ctx) && (new_opp->voltage < current_opp.voltage)) {
+        /* Lower the voltage after lowering the frequency */
+        status = __mod_dvfs_set_voltage_async(ctx, new_opp->voltage);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        ctx->transition.psu_request_count++;
+        ctx->transition.state = MOD_DVFS_TRANSITION_STATE_LOWERING_VOLTAGE;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/* Respond to the entities waiting for the end of an overlapped transition */
+static void respond_to_requesters(struct mod_dvfs_domain_ctx *ctx, int status)
+{
+    unsigned int requester_idx;
+    struct fwk_event response;
+    struct mod_dvfs_event_params_set_frequency_response *response_params;
+
+    for (requester_idx = 0;
+         requester_idx < ctx->transition.requester_count;
+         requester_idx++) {
+        response = (struct fwk_event) {
+            .id = mod_dvfs_event_id_set_frequency,
+            .target_id = ctx->transition.requester_table[requester_idx],
+            .is_response = true,
+            .is_delayed_response = true,
+        };
+
+        response_params = (void *)&response.params;
+        response_params->status = status;
+
+        fwk_thread_put_event(&response);
+    }
+
+    ctx->transition.requester_count = 0;
+}
+
+static int event_set_opp_overlapped(
+    struct mod_dvfs_domain_ctx *ctx,
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    struct mod_dvfs_event_params_set_frequency_response *response_params;
+
+    response_params = (void *)&response->params;
+
+    /*
+     * A request submitted during a transition is applied once the transition
+     * completes, unless the transition is only lowering the voltage. The
+     * clock of such a transition is already set, so the new transition can
+     * start at once and redirect the voltage ramp in progress.
+     */
+    if (ctx->frequency_request_pending &&
+        ((ctx->transition.state == MOD_DVFS_TRANSITION_STATE_IDLE) ||
+         (ctx->transition.state ==
+          MOD_DVFS_TRANSITION_STATE_LOWERING_VOLTAGE))) {
+        ctx->frequency_request_status = start_transition(ctx);
+        if (ctx->frequency_request_status != FWK_SUCCESS) {
+            response_params->status = ctx->frequency_request_status;
+
+            return FWK_SUCCESS;
+        }
+    }
+
+    if (ctx->transition.state == MOD_DVFS_TRANSITION_STATE_IDLE) {
+        response_params->status = ctx->frequency_request_status;
+
+        return FWK_SUCCESS;
+    }
+
+    if (ctx->transition.requester_count == MOD_DVFS_TRANSITION_REQUESTER_MAX) {
+        response_params->status = FWK_E_BUSY;
+
+        return FWK_SUCCESS;
+    }
+
+    ctx->transition.requester_table[ctx->transition.requester_count++] =
+        event->source_id;
+    response->is_delayed_response = true;
+
+    return FWK_SUCCESS;
+}
 
 static int event_set_opp(
     const struct fwk_event *event,
     struct fwk_event *response)
 {
-    return FWK_E_SUPPORT;
+    struct mod_dvfs_domain_ctx *ctx;
+    struct mod_dvfs_event_params_set_frequency_response *response_params;
+
+    /* These conditions were checked when we submitted the event */
+    assert(fwk_id_get_module_idx(event->target_id) == FWK_MODULE_IDX_DVFS);
+    assert(fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT));
+
+    response_params = (void *)&response->params;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(event->target_id);
+    assert(ctx != NULL);
+
+    /* Sample the power of the operating point the domain is leaving */
+    __mod_dvfs_calibrate_power(ctx, event->target_id);
+
+    if (ctx->config->transition_mode == MOD_DVFS_TRANSITION_MODE_OVERLAPPED)
+        return event_set_opp_overlapped(ctx, event, response);
+
+    /*
+     * The first event processed applies the latest request. The events of
+     * the requests it superseded find the transition already done and report
+     * its status.
+     */
+    if (ctx->frequency_request_pending) {
+        ctx->frequency_request_pending = false;
+        ctx->frequency_request_status =
+            __mod_dvfs_set_frequency(ctx, ctx->frequency_request);
+    }
+
+    response_params->status = ctx->frequency_request_status;
+
+    return FWK_SUCCESS;
+}
+
+/* Response of the power supply to the voltage change of a transition */
+static int event_set_voltage_response(const struct fwk_event *event)
+{
+    int status;
+    struct mod_dvfs_domain_ctx *ctx;
+    const struct mod_psu_event_params_set_voltage_response *params;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(event->target_id);
+    assert(ctx != NULL);
+
+    if ((ctx->transition.state == MOD_DVFS_TRANSITION_STATE_IDLE) ||
+        (ctx->transition.psu_request_count == 0))
+        return FWK_E_STATE;
+
+    /* Ignore the responses to the voltage changes of superseded transitions */
+    if (--ctx->transition.psu_request_count > 0)
+        return FWK_SUCCESS;
+
+    /* The responses to the votes have the same parameters */
+    params = (const void *)&event->params;
+    status = (params->status == FWK_SUCCESS) ? FWK_SUCCESS : FWK_E_DEVICE;
+
+    if ((status == FWK_SUCCESS) &&
+        (ctx->transition.state == MOD_DVFS_TRANSITION_STATE_RAISING_VOLTAGE) &&
+        ctx->transition.set_rate) {
+        status = ctx->apis.clock->set_rate(
+            ctx->config->clock_id,
+            ctx->transition.opp->frequency,
+            MOD_CLOCK_ROUND_MODE_NONE);
+        if (status != FWK_SUCCESS)
+            status = FWK_E_DEVICE;
+    }
+
+    ctx->transition.state = MOD_DVFS_TRANSITION_STATE_IDLE;
+
+    /* Chain the transition to the requests submitted in the meantime */
+    if ((status == FWK_SUCCESS) && ctx->frequency_request_pending) {
+        status = start_transition(ctx);
+        if ((status == FWK_SUCCESS) &&
+            (ctx->transition.state != MOD_DVFS_TRANSITION_STATE_IDLE))
+            return FWK_SUCCESS;
+    }
+
+    ctx->frequency_request_pending = false;
+    ctx->frequency_request_status = status;
+
+    FWK_TRACE(FWK_TRACE_ID_MODULE(FWK_MODULE_IDX_DVFS,
+                                  MOD_DVFS_TRACE_IDX_TRANSITION_END),
+              (uint32_t)status);
+
+    respond_to_requesters(ctx, status);
+
+    return FWK_SUCCESS;
 }
 
 static int event_set_frequency_limits(
     const struct fwk_event *event,
     struct fwk_event *response)
 {
-    return FWK_E_SUPPORT;
+    struct mod_dvfs_domain_ctx *ctx;
+    const struct mod_dvfs_event_params_set_frequency_limits *params;
+    struct mod_dvfs_event_params_set_frequency_limits_response
+        *response_params;
+
+    /* These conditions were checked when we submitted the event */
+    assert(fwk_id_get_module_idx(event->target_id) == FWK_MODULE_IDX_DVFS);
+    assert(fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT));
+
+    params = (const void *)&event->params;
+    response_params = (void *)&response->params;
+
+    ctx = __mod_dvfs_get_valid_domain_ctx(event->target_id);
+    assert(ctx != NULL);
+
+    response_params->status =
+        __mod_dvfs_set_frequency_limits(ctx, &params->limits);
+
+    return FWK_SUCCESS;
 }
 
 int __mod_dvfs_process_event(
@@ -37,6 +281,19 @@ int __mod_dvfs_process_event(
 
     handler_t handler;
 
+    if (event->is_response) {
+        #if BUILD_HAS_MOD_SENSOR
+        if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request))
+            return __mod_dvfs_process_power_reading(event);
+        #endif
+
+        if (!fwk_id_is_equal(event->id, mod_psu_event_id_set_voltage) &&
+            !fwk_id_is_equal(event->id, mod_psu_event_id_set_voltage_vote))
+            return FWK_E_PARAM;
+
+        return event_set_voltage_response(event);
+    }
+
     /* Ensure we have a handler implemented for this event */
     handler = handlers[fwk_id_get_event_idx(event->id)];
     if (handler == NULL)
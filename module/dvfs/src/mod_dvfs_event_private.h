@@ -8,7 +8,14 @@
 #ifndef MOD_DVFS_EVENT_PRIVATE_H
 #define MOD_DVFS_EVENT_PRIVATE_H
 
+#include <stdint.h>
 #include <fwk_event.h>
+#include <mod_dvfs.h>
+
+/* "Set frequency limits" event */
+struct mod_dvfs_event_params_set_frequency_limits {
+    struct mod_dvfs_frequency_limits limits;
+};
 
 /* Event handler */
 int __mod_dvfs_process_event(
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdbool.h>
+#include <string.h>
 #include <fwk_assert.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
@@ -28,6 +30,19 @@ static int count_opps(const struct mod_dvfs_opp *opps)
     return opp - &opps[0];
 }
 
+/* The operating point lookups rely on the frequencies being sorted */
+static bool are_opps_sorted(const struct mod_dvfs_opp *opps, size_t opp_count)
+{
+    size_t opp_idx;
+
+    for (opp_idx = 1; opp_idx < opp_count; opp_idx++) {
+        if (opps[opp_idx].frequency <= opps[opp_idx - 1].frequency)
+            return false;
+    }
+
+    return true;
+}
+
 static struct mod_dvfs_domain_ctx *get_domain_ctx(fwk_id_t domain_id)
 {
     unsigned int element_idx = fwk_id_get_element_idx(domain_id);
@@ -46,7 +61,7 @@ static int dvfs_init(
     if (domain_ctx == NULL)
         return FWK_E_NOMEM;
 
-    return FWK_SUCCESS;
+    return __mod_dvfs_energy_init(data);
 }
 
 static int dvfs_element_init(
@@ -66,13 +81,27 @@ static int dvfs_element_init(
     ctx->opp_count = count_opps(ctx->config->opps);
     assert(ctx->opp_count > 0);
 
+    if (!are_opps_sorted(ctx->config->opps, ctx->opp_count))
+        return FWK_E_DATA;
+
+    /* The voltages of the operating points may be trimmed at runtime */
+    ctx->opps = fwk_mm_calloc(ctx->opp_count, sizeof(ctx->opps[0]));
+    if (ctx->opps == NULL)
+        return FWK_E_NOMEM;
+
+    memcpy(ctx->opps, ctx->config->opps,
+           ctx->opp_count * sizeof(ctx->opps[0]));
+
     /* Frequency limits default to the minimum and maximum available */
     ctx->frequency_limits = (struct mod_dvfs_frequency_limits) {
-        .minimum = ctx->config->opps[0].frequency,
-        .maximum = ctx->config->opps[ctx->opp_count - 1].frequency,
+        .minimum = ctx->opps[0].frequency,
+        .maximum = ctx->opps[ctx->opp_count - 1].frequency,
     };
+    ctx->limits_min_idx = 0;
+    ctx->limits_max_idx = ctx->opp_count - 1;
 
-    ctx->suspended_opp = ctx->config->opps[ctx->config->sustained_idx];
+    ctx->suspended_opp = ctx->opps[ctx->config->sustained_idx];
+    ctx->power_scale = MOD_DVFS_POWER_SCALE_UNITY;
 
     return FWK_SUCCESS;
 }
@@ -87,13 +116,15 @@ static int dvfs_bind_element(fwk_id_t domain_id, unsigned int round)
     if (round > 0)
         return FWK_SUCCESS;
 
-    /* Bind to the power supply module */
-    status = fwk_module_bind(
-        ctx->config->psu_id,
-        mod_psu_api_id_psu_device,
-        &ctx->apis.psu);
-    if (status != FWK_SUCCESS)
-        return FWK_E_PANIC;
+    /* Bind to the power supply module, unless the domain has none */
+    if (__mod_dvfs_has_psu(ctx)) {
+        status = fwk_module_bind(
+            ctx->config->psu_id,
+            mod_psu_api_id_psu_device,
+            &ctx->apis.psu);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
 
     /* Bind to the clock module */
     status = fwk_module_bind(
@@ -103,16 +134,30 @@ static int dvfs_bind_element(fwk_id_t domain_id, unsigned int round)
     if (status != FWK_SUCCESS)
         return FWK_E_PANIC;
 
+    #if BUILD_HAS_MOD_SENSOR
+    /* Bind to the sensor module to calibrate the power costs */
+    if (fwk_id_is_type(ctx->config->power_sensor_id, FWK_ID_TYPE_ELEMENT)) {
+        status = fwk_module_bind(
+            FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR),
+            mod_sensor_api_id_sensor,
+            &ctx->apis.sensor);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
+    #endif
+
     return FWK_SUCCESS;
 }
 
 static int dvfs_bind(fwk_id_t id, unsigned int round)
 {
-    /* We only need to handle binding our elements */
     if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
         return dvfs_bind_element(id, round);
 
-    return FWK_SUCCESS;
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    return __mod_dvfs_energy_bind();
 }
 
 static int dvfs_process_bind_request_module(
@@ -149,7 +194,7 @@ static int dvfs_start(fwk_id_t id)
     const struct mod_dvfs_domain_ctx *ctx;
 
     if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
-        return FWK_SUCCESS;
+        return __mod_dvfs_energy_start(id);
 
     ctx = get_domain_ctx(id);
 
@@ -190,6 +235,10 @@ static int dvfs_process_notification(
     struct clock_notification_params *params;
     struct clock_state_change_pending_resp_params *resp_params;
 
+    /* The module is notified of the initialization of the energy table */
+    if (fwk_id_is_type(event->target_id, FWK_ID_TYPE_MODULE))
+        return __mod_dvfs_process_energy_notification(event);
+
     assert(
         fwk_id_is_equal(
             event->id,
@@ -8,9 +8,23 @@
 #ifndef MOD_DVFS_MODULE_PRIVATE_H
 #define MOD_DVFS_MODULE_PRIVATE_H
 
+#include <stdbool.h>
 #include <fwk_id.h>
 #include <mod_clock.h>
 #include <mod_psu.h>
+#if BUILD_HAS_MOD_SENSOR
+#include <mod_sensor.h>
+#endif
+
+/* Maximum number of requesters waiting for an overlapped transition */
+#define MOD_DVFS_TRANSITION_REQUESTER_MAX 8
+
+/* State of an overlapped transition */
+enum mod_dvfs_transition_state {
+    MOD_DVFS_TRANSITION_STATE_IDLE,
+    MOD_DVFS_TRANSITION_STATE_RAISING_VOLTAGE,
+    MOD_DVFS_TRANSITION_STATE_LOWERING_VOLTAGE,
+};
 
 /* Domain context */
 struct mod_dvfs_domain_ctx {
@@ -23,16 +37,75 @@ struct mod_dvfs_domain_ctx {
 
         /* Clock API */
         const struct mod_clock_api *clock;
+
+        #if BUILD_HAS_MOD_SENSOR
+        /* Sensor API, NULL if the power costs are not calibrated */
+        const struct mod_sensor_api *sensor;
+        #endif
     } apis;
 
     /* Number of operating points */
     size_t opp_count;
 
+    /* Operating points, with the voltages trimmed by the voltage scaling */
+    struct mod_dvfs_opp *opps;
+
     /* Operating point prior to domain suspension */
     struct mod_dvfs_opp suspended_opp;
 
     /* Current operating point limits */
     struct mod_dvfs_frequency_limits frequency_limits;
+
+    /* Indices of the operating points of the current limits */
+    size_t limits_min_idx;
+    size_t limits_max_idx;
+
+    /*
+     * Latest frequency requested asynchronously. The asynchronous requests
+     * submitted before a transition starts are coalesced into this slot so
+     * that only the latest one is applied.
+     */
+    uint64_t frequency_request;
+
+    /* The latest asynchronous frequency request has yet to be applied */
+    bool frequency_request_pending;
+
+    /* Status of the last applied asynchronous frequency request */
+    int frequency_request_status;
+
+    /* Calibration scale of the power costs, in Q16 fixed point */
+    uint32_t power_scale;
+
+    /* A reading of the power sensor is in progress */
+    bool power_reading_pending;
+
+    /* Index of the operating point the power sensor is being read at */
+    size_t power_reading_opp_idx;
+
+    /* Overlapped transition in progress */
+    struct {
+        /* State of the transition */
+        enum mod_dvfs_transition_state state;
+
+        /* Operating point the domain transitions to */
+        const struct mod_dvfs_opp *opp;
+
+        /* Whether the clock rate must be changed once the voltage is set */
+        bool set_rate;
+
+        /*
+         * Number of voltage changes requested to the power supply and not
+         * responded to yet. Only the response to the latest one completes the
+         * transition, the others belong to superseded transitions.
+         */
+        unsigned int psu_request_count;
+
+        /* Entities waiting for the response of their request */
+        fwk_id_t requester_table[MOD_DVFS_TRANSITION_REQUESTER_MAX];
+
+        /* Number of entities waiting for the response of their request */
+        unsigned int requester_count;
+    } transition;
 };
 
 struct mod_dvfs_domain_ctx *__mod_dvfs_get_valid_domain_ctx(fwk_id_t domain_id);
@@ -10,6 +10,7 @@
 
 #include <mod_dvfs_event_private.h>
 #include <mod_dvfs_domain_api_private.h>
+#include <mod_dvfs_energy_private.h>
 #include <mod_dvfs_module_private.h>
 #include <mod_dvfs_util_private.h>
 
@@ -5,9 +5,16 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdbool.h>
+#include <fwk_id.h>
 #include <fwk_module.h>
 #include <mod_dvfs_private.h>
 
+bool __mod_dvfs_has_psu(const struct mod_dvfs_domain_ctx *ctx)
+{
+    return fwk_id_is_type(ctx->config->psu_id, FWK_ID_TYPE_ELEMENT);
+}
+
 int __mod_dvfs_set_opp(
     const struct mod_dvfs_domain_ctx *ctx,
     const struct mod_dvfs_opp *new_opp)
@@ -19,11 +26,9 @@ int __mod_dvfs_set_opp(
     if (status != FWK_SUCCESS)
         return status;
 
-    if (new_opp->voltage > current_opp.voltage) {
+    if (__mod_dvfs_has_psu(ctx) && (new_opp->voltage > current_opp.voltage)) {
         /* Raise the voltage before raising the frequency */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id,
-            new_opp->voltage);
+        status = __mod_dvfs_set_voltage(ctx, new_opp->voltage);
         if (status != FWK_SUCCESS)
             return FWK_E_DEVICE;
     }
@@ -37,11 +42,9 @@ int __mod_dvfs_set_opp(
             return FWK_E_DEVICE;
     }
 
-    if (new_opp->voltage < current_opp.voltage) {
+    if (__mod_dvfs_has_psu(ctx) && (new_opp->voltage < current_opp.voltage)) {
         /* Lower the voltage after lowering the frequency */
-        status = ctx->apis.psu->set_voltage(
-            ctx->config->psu_id,
-            new_opp->voltage);
+        status = __mod_dvfs_set_voltage(ctx, new_opp->voltage);
         if (status != FWK_SUCCESS)
             return FWK_E_DEVICE;
     }
@@ -49,11 +52,40 @@ int __mod_dvfs_set_opp(
     return FWK_SUCCESS;
 }
 
+int __mod_dvfs_set_voltage(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uintmax_t voltage)
+{
+    if (ctx->config->psu_shared) {
+        return ctx->apis.psu->set_voltage_vote(
+            ctx->config->psu_id,
+            ctx->config->psu_voter_idx,
+            voltage);
+    }
+
+    return ctx->apis.psu->set_voltage(ctx->config->psu_id, voltage);
+}
+
+int __mod_dvfs_set_voltage_async(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uintmax_t voltage)
+{
+    if (ctx->config->psu_shared) {
+        return ctx->apis.psu->set_voltage_vote_async(
+            ctx->config->psu_id,
+            ctx->config->psu_voter_idx,
+            voltage);
+    }
+
+    return ctx->apis.psu->set_voltage_async(ctx->config->psu_id, voltage);
+}
+
 int __mod_dvfs_get_current_opp(
     const struct mod_dvfs_domain_ctx *ctx,
     struct mod_dvfs_opp *opp)
 {
     int status;
+    const struct mod_dvfs_opp *config_opp;
 
     status = ctx->apis.clock->get_rate(
         ctx->config->clock_id,
@@ -61,6 +93,34 @@ int __mod_dvfs_get_current_opp(
     if (status != FWK_SUCCESS)
         return FWK_E_DEVICE;
 
+    /* The power cost is only known at the configured operating points */
+    config_opp = __mod_dvfs_get_opp_for_frequency(ctx, opp->frequency);
+    opp->power = (config_opp == NULL) ? 0 :
+        __mod_dvfs_get_opp_power(ctx, config_opp - ctx->opps);
+
+    /* Without power supply, the voltage is the nominal one of the OPP */
+    if (!__mod_dvfs_has_psu(ctx)) {
+        opp->voltage = (config_opp == NULL) ? 0 : config_opp->voltage;
+        return FWK_SUCCESS;
+    }
+
+    if (ctx->config->psu_shared) {
+        /*
+         * The voltage of the domain is its vote, the output voltage of the
+         * power supply follows the highest vote of the domains sharing it.
+         */
+        status = ctx->apis.psu->get_voltage_vote(
+            ctx->config->psu_id,
+            ctx->config->psu_voter_idx,
+            &opp->voltage);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        /* Until the domain has voted, its voltage is the output voltage */
+        if (opp->voltage != 0)
+            return FWK_SUCCESS;
+    }
+
     status = ctx->apis.psu->get_voltage(
         ctx->config->psu_id,
         &opp->voltage);
@@ -8,13 +8,24 @@
 #ifndef MOD_DVFS_UTIL_PRIVATE_H
 #define MOD_DVFS_UTIL_PRIVATE_H
 
+#include <stdbool.h>
 #include <mod_dvfs.h>
 #include <mod_dvfs_domain_api_private.h>
 
+bool __mod_dvfs_has_psu(const struct mod_dvfs_domain_ctx *ctx);
+
 int __mod_dvfs_set_opp(
     const struct mod_dvfs_domain_ctx *ctx,
     const struct mod_dvfs_opp *new_opp);
 
+int __mod_dvfs_set_voltage(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uintmax_t voltage);
+
+int __mod_dvfs_set_voltage_async(
+    const struct mod_dvfs_domain_ctx *ctx,
+    uintmax_t voltage);
+
 int __mod_dvfs_get_current_opp(
     const struct mod_dvfs_domain_ctx *ctx,
     struct mod_dvfs_opp *opp);
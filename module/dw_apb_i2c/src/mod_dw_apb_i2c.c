@@ -22,8 +22,12 @@ struct dw_apb_i2c_ctx {
     fwk_id_t i2c_id;
     struct dw_apb_i2c_reg *i2c_reg;
     bool read_on_going;
-    uint8_t byte_count;
+    /* Data to transmit, or buffer for the received data */
     uint8_t *data;
+    /* Number of data bytes or read commands to push to the transmit FIFO */
+    unsigned int tx_count;
+    /* Number of bytes to pull from the receive FIFO */
+    unsigned int rx_count;
 };
 
 static struct dw_apb_i2c_ctx *ctx_table;
@@ -85,6 +89,10 @@ static int enable_i2c(struct dw_apb_i2c_ctx *ctx, uint8_t slave_address)
     /* Program the slave address */
     i2c_reg->IC_TAR = (slave_address & IC_TAR_ADDRESS);
 
+    /* Program the FIFO thresholds */
+    i2c_reg->IC_TX_TL = I2C_TRANSMIT_FIFO_THRESHOLD;
+    i2c_reg->IC_RX_TL = 0;
+
     /* Enable STOP detected interrupt and TX aborted interrupt */
     i2c_reg->IC_INTR_MASK = (IC_INTR_STOP_DET_MASK | IC_INTR_TX_ABRT_MASK);
 
@@ -95,38 +103,148 @@ static int enable_i2c(struct dw_apb_i2c_ctx *ctx, uint8_t slave_address)
 }
 
 /*
- * An IRQ is triggered if the transaction has been completed successfully or
- * if the transaction has been aborted.
+ * Push data bytes or read commands to the transmit FIFO. For a read, the
+ * number of bytes requested and not pulled from the receive FIFO yet is bounded
+ * by the depth of the receive FIFO so that it cannot overflow.
+ */
+static void fill_tx_fifo(struct dw_apb_i2c_ctx *ctx)
+{
+    unsigned int count;
+    unsigned int pending_count;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    count = I2C_TRANSMIT_BUFFER_LENGTH - i2c_reg->IC_TXFLR;
+
+    if (ctx->read_on_going) {
+        pending_count = ctx->rx_count - ctx->tx_count;
+        if ((I2C_RECEIVE_BUFFER_LENGTH - pending_count) < count)
+            count = I2C_RECEIVE_BUFFER_LENGTH - pending_count;
+    }
+
+    if (ctx->tx_count < count)
+        count = ctx->tx_count;
+
+    ctx->tx_count -= count;
+
+    if (ctx->read_on_going) {
+        while (count-- > 0)
+            i2c_reg->IC_DATA_CMD = IC_DATA_CMD_READ;
+    } else {
+        while (count-- > 0)
+            i2c_reg->IC_DATA_CMD = *ctx->data++;
+    }
+}
+
+static void drain_rx_fifo(struct dw_apb_i2c_ctx *ctx)
+{
+    unsigned int count;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    count = i2c_reg->IC_RXFLR;
+    if (ctx->rx_count < count)
+        count = ctx->rx_count;
+
+    ctx->rx_count -= count;
+
+    while (count-- > 0)
+        *ctx->data++ = (uint8_t)(i2c_reg->IC_DATA_CMD & IC_DATA_CMD_DATA_MASK);
+}
+
+/*
+ * Enable the FIFO interrupts needed to continue the transfer in progress.
+ */
+static void update_intr_mask(struct dw_apb_i2c_ctx *ctx)
+{
+    uint32_t intr_mask = IC_INTR_STOP_DET_MASK | IC_INTR_TX_ABRT_MASK;
+    unsigned int rx_threshold;
+    struct dw_apb_i2c_reg *i2c_reg = ctx->i2c_reg;
+
+    /*
+     * The transmit FIFO is refilled when it reaches the threshold, unless the
+     * reads are throttled by the receive FIFO in which case the refill is done
+     * when the receive FIFO is drained.
+     */
+    if ((ctx->tx_count != 0) &&
+        (!ctx->read_on_going ||
+         ((ctx->rx_count - ctx->tx_count) < I2C_RECEIVE_BUFFER_LENGTH)))
+        intr_mask |= IC_INTR_TX_EMPTY_MASK;
+
+    if (ctx->read_on_going && (ctx->rx_count != 0)) {
+        rx_threshold = ctx->rx_count;
+        if (rx_threshold > I2C_RECEIVE_FIFO_THRESHOLD)
+            rx_threshold = I2C_RECEIVE_FIFO_THRESHOLD;
+
+        /* The interrupt is raised when the FIFO level exceeds IC_RX_TL */
+        i2c_reg->IC_RX_TL = rx_threshold - 1;
+        intr_mask |= IC_INTR_RX_FULL_MASK;
+    }
+
+    i2c_reg->IC_INTR_MASK = intr_mask;
+}
+
+/*
+ * An IRQ is triggered when the transmit FIFO needs to be refilled, when the
+ * receive FIFO needs to be drained, and when the transaction has been completed
+ * successfully or aborted.
  */
 static void i2c_isr(uintptr_t data)
 {
-    unsigned int i;
-    int i2c_status = FWK_E_DEVICE;
+    int i2c_status;
+    uint32_t intr_stat;
     struct dw_apb_i2c_reg *i2c_reg;
     struct dw_apb_i2c_ctx *ctx = (struct dw_apb_i2c_ctx *)data;
 
     i2c_reg = ctx->i2c_reg;
+    intr_stat = i2c_reg->IC_INTR_STAT;
 
-    /* The transaction has completed successfully */
-    if (i2c_reg->IC_INTR_STAT & IC_INTR_STOP_DET_MASK) {
+    if (intr_stat & IC_INTR_TX_ABRT_MASK) {
+        /* The transaction has been aborted */
+        i2c_reg->IC_CLR_TX_ABRT;
+        i2c_status = FWK_E_DEVICE;
+    } else if (intr_stat & IC_INTR_STOP_DET_MASK) {
         i2c_reg->IC_CLR_STOP_DET;
-        i2c_status = FWK_SUCCESS;
-        if (ctx->read_on_going) {
-            ctx->read_on_going = false;
-            /* Read the data from the device buffer */
-            for (i = 0; i < ctx->byte_count; i++)
-                ctx->data[i] =
-                    (uint8_t)(i2c_reg->IC_DATA_CMD & IC_DATA_CMD_DATA_MASK);
-        }
+        if (ctx->read_on_going)
+            drain_rx_fifo(ctx);
+
+        /* A STOP condition is issued early if the transmit FIFO ran dry */
+        if ((ctx->tx_count == 0) && (ctx->rx_count == 0))
+            i2c_status = FWK_SUCCESS;
+        else
+            i2c_status = FWK_E_DEVICE;
+    } else {
+        /* The transfer is in progress, refill and drain the FIFOs */
+        if (ctx->read_on_going)
+            drain_rx_fifo(ctx);
+        fill_tx_fifo(ctx);
+        update_intr_mask(ctx);
+
+        return;
     }
 
-    /* The transaction has been aborted */
-    if (i2c_reg->IC_INTR_STAT & IC_INTR_TX_ABRT_MASK)
-        i2c_reg->IC_CLR_TX_ABRT;
+    i2c_reg->IC_INTR_MASK = 0;
+    ctx->read_on_going = false;
 
     ctx->i2c_api->transaction_completed(ctx->i2c_id, i2c_status);
 }
 
+/*
+ * Start a transfer by filling the transmit FIFO. The rest of the transfer is
+ * driven by the FIFO threshold interrupts.
+ */
+static void start_transfer(struct dw_apb_i2c_ctx *ctx)
+{
+    /*
+     * The program of the I2C controller cannot be interrupted, the controller
+     * issues a STOP condition when its transmit FIFO is empty.
+     */
+    fwk_interrupt_global_disable();
+
+    fill_tx_fifo(ctx);
+    update_intr_mask(ctx);
+
+    fwk_interrupt_global_enable();
+}
+
 /*
  * Driver API
  */
@@ -134,33 +252,27 @@ static int transmit_as_master(fwk_id_t dev_id,
                               struct mod_i2c_request *transmit_request)
 {
     int status;
-    unsigned int sent_bytes;
     struct dw_apb_i2c_ctx *ctx;
 
     status = fwk_module_check_call(dev_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    if (transmit_request->transmit_byte_count > I2C_TRANSMIT_BUFFER_LENGTH)
-        return FWK_E_SUPPORT;
-
     if (transmit_request->slave_address == 0)
         return FWK_E_PARAM;
 
     ctx = ctx_table + fwk_id_get_element_idx(dev_id);
 
+    ctx->data = transmit_request->transmit_data;
+    ctx->tx_count = transmit_request->transmit_byte_count;
+    ctx->rx_count = 0;
+    ctx->read_on_going = false;
+
     status = enable_i2c(ctx, transmit_request->slave_address);
     if (status != FWK_SUCCESS)
         return FWK_E_DEVICE;
 
-    /* The program of the I2C controller cannot be interrupted. */
-    fwk_interrupt_global_disable();
-
-    for (sent_bytes = 0; sent_bytes < transmit_request->transmit_byte_count;
-        sent_bytes++)
-        ctx->i2c_reg->IC_DATA_CMD = transmit_request->transmit_data[sent_bytes];
-
-    fwk_interrupt_global_enable();
+    start_transfer(ctx);
 
     return FWK_SUCCESS;
 }
@@ -169,37 +281,27 @@ static int receive_as_master(fwk_id_t dev_id,
                              struct mod_i2c_request *receive_request)
 {
     int status;
-    unsigned int i;
     struct dw_apb_i2c_ctx *ctx;
 
     status = fwk_module_check_call(dev_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    if (receive_request->receive_byte_count > I2C_RECEIVE_BUFFER_LENGTH)
-        return FWK_E_SUPPORT;
-
     if (receive_request->slave_address == 0)
         return FWK_E_PARAM;
 
     ctx = ctx_table + fwk_id_get_element_idx(dev_id);
 
-    ctx->byte_count = receive_request->receive_byte_count;
     ctx->data = receive_request->receive_data;
+    ctx->tx_count = receive_request->receive_byte_count;
+    ctx->rx_count = receive_request->receive_byte_count;
     ctx->read_on_going = true;
 
     status = enable_i2c(ctx, receive_request->slave_address);
     if (status != FWK_SUCCESS)
         return FWK_E_DEVICE;
 
-    /* The program of the I2C controller cannot be interrupted. */
-    fwk_interrupt_global_disable();
-
-    /* Program the I2C controller with the expected reply length in bytes. */
-    for (i = 0; i < receive_request->receive_byte_count; i++)
-        ctx->i2c_reg->IC_DATA_CMD = IC_DATA_CMD_READ;
-
-    fwk_interrupt_global_enable();
+    start_transfer(ctx);
 
     return FWK_SUCCESS;
 }
@@ -29,6 +29,11 @@
 
 /*!
  * \brief Generic timer device descriptor
+ *
+ * \details Several devices can share a counter, each using its own timer
+ *      frame and comparator. A second device can for instance give the timer
+ *      HAL a separate channel for the short deadlines, whose alarms then do
+ *      not reprogram the comparator of the periodic alarms.
  */
 struct mod_gtimer_dev_config {
     /*! Address of the device's timer register */
@@ -37,9 +42,17 @@ struct mod_gtimer_dev_config {
     /*! Address of the device's counter register */
     uintptr_t hw_counter;
 
-    /*! Address of the device's control register */
+    /*!
+     * \brief Address of the device's control register
+     *
+     * \note May be zero for a device sharing the counter of another device,
+     *      which then enables the counter for both.
+     */
     uintptr_t control;
 
+    /*! Index of the timer frame of the device in the counter register */
+    unsigned int frame;
+
     /*! The frequency in Hertz that the timer ticks at */
     const uint32_t frequency;
 
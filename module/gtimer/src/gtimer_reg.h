@@ -37,6 +37,9 @@ struct cntcontrol_reg {
 #define CNTCONTROL_SCR_ENSYNC_DIRECT  UINT32_C(0x00000000)
 #define CNTCONTROL_SCR_ENSYNC_DELAY   UINT32_C(0x00000001)
 
+/* Number of timer frames (CNTBASE) whose access is controlled by CNTCTL */
+#define CNTCTL_FRAME_COUNT 8
+
 /*!
  * \brief Counter registers (CNTCTL)
  */
@@ -45,8 +48,8 @@ struct cntctl_reg {
     FWK_RW  uint32_t NSAR;
     FWK_R   uint32_t TTIDR;
             uint8_t  RESERVED0[0x40 - 0x0C];
-    FWK_RW  uint32_t ACR;
-            uint8_t  RESERVED1[0xFD0 - 0x44];
+    FWK_RW  uint32_t ACR[CNTCTL_FRAME_COUNT];
+            uint8_t  RESERVED1[0xFD0 - 0x60];
     FWK_R   uint32_t PID[11];
 };
 
@@ -72,19 +72,11 @@ static int disable(fwk_id_t dev_id)
     return FWK_SUCCESS;
 }
 
-static int get_counter(fwk_id_t dev_id, uint64_t *value)
+static uint64_t read_counter(const struct dev_ctx *ctx)
 {
-    const struct dev_ctx *ctx;
-    int status;
     uint32_t counter_low;
     uint32_t counter_high;
 
-    status = fwk_module_check_call(dev_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    ctx = ctx_table + fwk_id_get_element_idx(dev_id);
-
     /*
      * To avoid race conditions where the high half of the counter increments
      * after it has been sampled but before the low half is sampled, the values
@@ -96,7 +88,17 @@ static int get_counter(fwk_id_t dev_id, uint64_t *value)
         counter_low = ctx->hw_timer->PCTL;
     } while (counter_high != ctx->hw_timer->PCTH);
 
-    *value = ((uint64_t)counter_high << 32) | counter_low;
+    return ((uint64_t)counter_high << 32) | counter_low;
+}
+
+/*
+ * The counter is read on the hot paths of the timer HAL, the delays and waits
+ * in particular. The timer HAL, the only user of this API, has already checked
+ * the call so the check is not repeated here.
+ */
+static int get_counter(fwk_id_t dev_id, uint64_t *value)
+{
+    *value = read_counter(ctx_table + fwk_id_get_element_idx(dev_id));
 
     return FWK_SUCCESS;
 }
@@ -111,9 +113,8 @@ static int set_timer(fwk_id_t dev_id, uint64_t timestamp)
     if (status != FWK_SUCCESS)
         return status;
 
-    status = get_counter(dev_id, &counter);
-    if (status != FWK_SUCCESS)
-        return status;
+    ctx = ctx_table + fwk_id_get_element_idx(dev_id);
+    counter = read_counter(ctx);
 
     /*
      * If an alarm's period is very small, the timer device could be configured
@@ -126,8 +127,6 @@ static int set_timer(fwk_id_t dev_id, uint64_t timestamp)
      */
     timestamp = FWK_MAX(counter + GTIMER_MIN_TIMESTAMP, timestamp);
 
-    ctx = ctx_table + fwk_id_get_element_idx(dev_id);
-
     ctx->hw_timer->P_CVALL = timestamp & 0xFFFFFFFF;
     ctx->hw_timer->P_CVALH = timestamp >> 32;
 
@@ -211,7 +210,7 @@ static int gtimer_device_init(fwk_id_t element_id, unsigned int unused,
     ctx->config = data;
     if (ctx->config->hw_timer == 0   ||
         ctx->config->hw_counter == 0 ||
-        ctx->config->control == 0    ||
+        ctx->config->frame >= CNTCTL_FRAME_COUNT ||
         ctx->config->frequency < GTIMER_FREQUENCY_MIN_HZ ||
         ctx->config->frequency > GTIMER_FREQUENCY_MAX_HZ) {
 
@@ -224,11 +223,11 @@ static int gtimer_device_init(fwk_id_t element_id, unsigned int unused,
 
     disable(element_id);
 
-    ctx->hw_counter->ACR = CNTCTL_ACR_RPCT |
-                           CNTCTL_ACR_RVCT |
-                           CNTCTL_ACR_RFRQ |
-                           CNTCTL_ACR_RVOFF|
-                           CNTCTL_ACR_RWPT;
+    ctx->hw_counter->ACR[ctx->config->frame] = CNTCTL_ACR_RPCT |
+                                               CNTCTL_ACR_RVCT |
+                                               CNTCTL_ACR_RFRQ |
+                                               CNTCTL_ACR_RVOFF|
+                                               CNTCTL_ACR_RWPT;
     ctx->hw_counter->FRQ = ctx->config->frequency;
 
     return FWK_SUCCESS;
@@ -265,6 +264,10 @@ static int gtimer_start(fwk_id_t id)
 
     ctx = ctx_table + fwk_id_get_element_idx(id);
 
+    /* The counter is enabled by the device it is shared with */
+    if (ctx->control == NULL)
+        return FWK_SUCCESS;
+
     if (!fwk_id_is_type(ctx->config->clock_id, FWK_ID_TYPE_NONE)) {
         /* Register for clock state notifications */
         return fwk_notification_subscribe(
@@ -44,6 +44,17 @@ struct mod_i2c_dev_config {
 
     /*! Identifier of the driver API. */
     fwk_id_t api_id;
+
+    /*!
+     * \brief Maximum number of requests queued while a transaction is in
+     *      progress on the I2C device.
+     *
+     * \details The queued requests are started in order as the transactions
+     *      complete. When the queue is full, or if its length is zero, the
+     *      requests submitted while a transaction is in progress are rejected
+     *      with \ref FWK_E_BUSY.
+     */
+    unsigned int request_queue_length;
 };
 
 /*!
@@ -152,7 +163,7 @@ struct mod_i2c_api {
      *
      * \retval FWK_SUCCESS The request was submitted.
      * \retval FWK_E_PARAM One or more parameters were invalid.
-     * \retval FWK_E_BUSY An I2C transaction is already on-going.
+     * \retval FWK_E_BUSY The request queue of the I2C device is full.
      * \retval FWK_E_DEVICE The transmission is aborted due to a device error.
      * \return One of the standard framework error codes.
      */
@@ -175,7 +186,7 @@ struct mod_i2c_api {
      *
      * \retval FWK_SUCCESS The request was submitted.
      * \retval FWK_E_PARAM One or more parameters were invalid.
-     * \retval FWK_E_BUSY An I2C transaction is already on-going.
+     * \retval FWK_E_BUSY The request queue of the I2C device is full.
      * \retval FWK_E_DEVICE The reception is aborted due to a device error.
      * \return One of the standard framework error codes.
      */
@@ -205,13 +216,39 @@ struct mod_i2c_api {
      *
      * \retval FWK_SUCCESS The request was submitted.
      * \retval FWK_E_PARAM One or more parameters were invalid.
-     * \retval FWK_E_BUSY An I2C transaction is already on-going.
+     * \retval FWK_E_BUSY The request queue of the I2C device is full.
      * \retval FWK_E_DEVICE The reception is aborted due to a device error.
      * \return One of the standard framework error codes.
      */
     int (*transmit_then_receive_as_master)(fwk_id_t dev_id,
         uint8_t slave_address, uint8_t *transmit_data, uint8_t *receive_data,
         uint8_t transmit_byte_count, uint8_t receive_byte_count);
+
+    /*!
+     * \brief Request a series of transactions as Master, performed back to
+     *      back on the I2C bus.
+     *
+     * \details Each request of the table describes a transmission, a
+     *      reception, or a transmission followed by a reception, to or from
+     *      the slave at the address of the request. When the function returns
+     *      the transactions are not completed, not even started. The table of
+     *      requests and the data buffers must stay allocated and their content
+     *      must not be modified until the transactions are completed or
+     *      aborted. When the last transaction has finished, or when a
+     *      transaction fails, a single response event is sent to the client.
+     *      The transactions following a failed transaction are not performed.
+     *
+     * \param dev_id Identifier of the I2C device
+     * \param request_table Table of the requests, performed in order
+     * \param request_count Number of requests in the table
+     *
+     * \retval FWK_SUCCESS The request was submitted.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     * \retval FWK_E_BUSY The request queue of the I2C device is full.
+     * \return One of the standard framework error codes.
+     */
+    int (*transfer_as_master)(fwk_id_t dev_id,
+        struct mod_i2c_request *request_table, unsigned int request_count);
 };
 
 /*!
@@ -261,6 +298,7 @@ enum mod_i2c_event_idx {
     MOD_I2C_EVENT_IDX_REQUEST,
     MOD_I2C_EVENT_IDX_REQUEST_COMPLETED,
     MOD_I2C_EVENT_IDX_RESTART,
+    MOD_I2C_EVENT_IDX_TRANSFER,
     MOD_I2C_EVENT_IDX_COUNT,
 };
 
@@ -276,6 +314,10 @@ static const fwk_id_t mod_i2c_event_id_request_completed = FWK_ID_EVENT_INIT(
 static const fwk_id_t mod_i2c_event_id_restart = FWK_ID_EVENT_INIT(
     FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_RESTART);
 
+/*! Transfer event identifier */
+static const fwk_id_t mod_i2c_event_id_transfer = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_I2C, MOD_I2C_EVENT_IDX_TRANSFER);
+
 
 /*!
  * \}
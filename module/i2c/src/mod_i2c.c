@@ -15,12 +15,40 @@
 #include <fwk_thread.h>
 #include <mod_i2c.h>
 
+/* Transaction queued or in progress on an I2C device */
+struct mod_i2c_transaction {
+    /* Request being performed, or to perform first */
+    struct mod_i2c_request request;
+
+    /* Requests to perform after the current one, for a transfer */
+    struct mod_i2c_request *next_request;
+    unsigned int next_request_count;
+
+    /* Cookie of the event whose response is sent on completion */
+    uint32_t cookie;
+};
+
 struct mod_i2c_dev_ctx {
     const struct mod_i2c_dev_config *config;
     const struct mod_i2c_driver_api *driver_api;
-    struct mod_i2c_request request;
+
+    /* Transaction in progress, valid only if busy is true */
+    struct mod_i2c_transaction transaction;
     bool busy;
-    uint32_t cookie;
+
+    /* Number of requests submitted and not completed yet */
+    unsigned int request_count;
+
+    /* Circular queue of the transactions waiting for the bus */
+    struct mod_i2c_transaction *queue;
+    unsigned int queue_head;
+    unsigned int queue_count;
+};
+
+/* Parameters of the transfer event */
+struct mod_i2c_transfer_params {
+    struct mod_i2c_request *request_table;
+    unsigned int request_count;
 };
 
 static struct mod_i2c_dev_ctx *ctx_table;
@@ -41,6 +69,53 @@ static int get_ctx(fwk_id_t id, struct mod_i2c_dev_ctx **ctx)
     return FWK_SUCCESS;
 }
 
+static bool is_valid_request(const struct mod_i2c_request *request)
+{
+    /* The slave address should be on 7 bits */
+    if (!fwk_expect(request->slave_address < 0x80))
+        return false;
+
+    if (!fwk_expect((request->transmit_byte_count != 0) ||
+                    (request->receive_byte_count != 0)))
+        return false;
+
+    if (!fwk_expect((request->transmit_byte_count == 0) ||
+                    (request->transmit_data != NULL)))
+        return false;
+
+    return fwk_expect((request->receive_byte_count == 0) ||
+                      (request->receive_data != NULL));
+}
+
+/*
+ * Account for a new request, the requests beyond the one in progress and the
+ * queued ones are rejected.
+ */
+static int reserve_request(struct mod_i2c_dev_ctx *ctx)
+{
+    if (ctx->request_count > ctx->config->request_queue_length)
+        return FWK_E_BUSY;
+
+    ctx->request_count++;
+
+    return FWK_SUCCESS;
+}
+
+static int submit_request(struct mod_i2c_dev_ctx *ctx, struct fwk_event *event)
+{
+    int status;
+
+    status = reserve_request(ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_thread_put_event(event);
+    if (status != FWK_SUCCESS)
+        ctx->request_count--;
+
+    return status;
+}
+
 static int create_i2c_request(fwk_id_t dev_id, uint8_t slave_address,
     uint8_t *transmit_data, uint8_t *receive_data, uint8_t transmit_byte_count,
     uint8_t receive_byte_count)
@@ -61,12 +136,6 @@ static int create_i2c_request(fwk_id_t dev_id, uint8_t slave_address,
     if (!fwk_expect(slave_address < 0x80))
         return FWK_E_PARAM;
 
-    /* Check whether an I2C request is already on-going */
-    if (ctx->busy)
-        return FWK_E_BUSY;
-
-    ctx->busy = true;
-
     /* Create the request */
     event = (struct fwk_event) {
         .id = mod_i2c_event_id_request,
@@ -82,7 +151,102 @@ static int create_i2c_request(fwk_id_t dev_id, uint8_t slave_address,
         .receive_byte_count = receive_byte_count,
     };
 
-    return fwk_thread_put_event(&event);
+    return submit_request(ctx, &event);
+}
+
+/* Start the current request of the transaction in progress */
+static int start_request(struct mod_i2c_dev_ctx *ctx)
+{
+    struct mod_i2c_request *request = &ctx->transaction.request;
+
+    if (request->transmit_byte_count != 0)
+        return ctx->driver_api->transmit_as_master(ctx->config->driver_id,
+                                                   request);
+
+    return ctx->driver_api->receive_as_master(ctx->config->driver_id,
+                                              request);
+}
+
+/*
+ * Start a transaction, or queue it if a transaction is in progress. The
+ * response to the event of the transaction is delayed until its completion.
+ */
+static int process_transaction_request(struct mod_i2c_dev_ctx *ctx,
+    const struct mod_i2c_transaction *transaction,
+    struct fwk_event *resp_event)
+{
+    unsigned int queue_idx;
+    struct mod_i2c_event_param *resp_param =
+        (struct mod_i2c_event_param *)resp_event->params;
+
+    if (ctx->busy) {
+        /* There is room in the queue as the number of requests is bounded */
+        fwk_assert(ctx->queue_count < ctx->config->request_queue_length);
+
+        queue_idx = (ctx->queue_head + ctx->queue_count) %
+            ctx->config->request_queue_length;
+        ctx->queue[queue_idx] = *transaction;
+        ctx->queue_count++;
+    } else {
+        ctx->transaction = *transaction;
+        ctx->busy = true;
+
+        if (start_request(ctx) != FWK_SUCCESS) {
+            /* Nothing can be queued while no transaction is in progress */
+            ctx->busy = false;
+            ctx->request_count--;
+            resp_param->status = FWK_E_DEVICE;
+
+            return FWK_SUCCESS;
+        }
+    }
+
+    resp_event->is_delayed_response = true;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Respond to the client of the transaction in progress and start the next
+ * queued transaction, if any.
+ */
+static int complete_transaction(fwk_id_t dev_id, struct mod_i2c_dev_ctx *ctx,
+                                int i2c_status)
+{
+    int status;
+    struct fwk_event resp;
+    struct mod_i2c_event_param *param =
+        (struct mod_i2c_event_param *)resp.params;
+
+    for (;;) {
+        ctx->busy = false;
+        ctx->request_count--;
+
+        status = fwk_thread_get_delayed_response(dev_id,
+            ctx->transaction.cookie, &resp);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        param->status = i2c_status;
+        status = fwk_thread_put_event(&resp);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        if (ctx->queue_count == 0)
+            return FWK_SUCCESS;
+
+        /* Chain the next transaction */
+        ctx->transaction = ctx->queue[ctx->queue_head];
+        ctx->queue_head = (ctx->queue_head + 1) %
+            ctx->config->request_queue_length;
+        ctx->queue_count--;
+        ctx->busy = true;
+
+        if (start_request(ctx) == FWK_SUCCESS)
+            return FWK_SUCCESS;
+
+        i2c_status = FWK_E_DEVICE;
+    }
 }
 
 /*
@@ -133,10 +297,50 @@ static int transmit_then_receive_as_master(fwk_id_t dev_id,
         receive_data, transmit_byte_count, receive_byte_count);
 }
 
+static int transfer_as_master(fwk_id_t dev_id,
+                              struct mod_i2c_request *request_table,
+                              unsigned int request_count)
+{
+    int status;
+    unsigned int i;
+    struct fwk_event event;
+    struct mod_i2c_dev_ctx *ctx;
+    struct mod_i2c_transfer_params *event_param =
+        (struct mod_i2c_transfer_params *)event.params;
+
+    fwk_assert(fwk_module_is_valid_element_id(dev_id));
+
+    if (!fwk_expect((request_table != NULL) && (request_count != 0)))
+        return FWK_E_PARAM;
+
+    for (i = 0; i < request_count; i++) {
+        if (!is_valid_request(&request_table[i]))
+            return FWK_E_PARAM;
+    }
+
+    status = get_ctx(dev_id, &ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    event = (struct fwk_event) {
+        .id = mod_i2c_event_id_transfer,
+        .target_id = dev_id,
+        .response_requested = true,
+    };
+
+    *event_param = (struct mod_i2c_transfer_params) {
+        .request_table = request_table,
+        .request_count = request_count,
+    };
+
+    return submit_request(ctx, &event);
+}
+
 static struct mod_i2c_api i2c_api = {
     .transmit_as_master = transmit_as_master,
     .receive_as_master = receive_as_master,
     .transmit_then_receive_as_master = transmit_then_receive_as_master,
+    .transfer_as_master = transfer_as_master,
 };
 
 /*
@@ -189,6 +393,14 @@ static int mod_i2c_dev_init(fwk_id_t element_id,
     ctx = ctx_table + fwk_id_get_element_idx(element_id);
     ctx->config = (struct mod_i2c_dev_config *)data;
 
+    if (ctx->config->request_queue_length == 0)
+        return FWK_SUCCESS;
+
+    ctx->queue = fwk_mm_calloc(ctx->config->request_queue_length,
+                               sizeof(ctx->queue[0]));
+    if (ctx->queue == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
@@ -247,13 +459,13 @@ static int mod_i2c_process_event(const struct fwk_event *event,
                                  struct fwk_event *resp_event)
 {
     int status;
-    struct fwk_event resp;
     struct mod_i2c_dev_ctx *ctx;
-    struct mod_i2c_event_param *param =
-        (struct mod_i2c_event_param *)resp.params;
-    struct mod_i2c_event_param *event_param =
-        (struct mod_i2c_event_param *)event->params;
-    struct mod_i2c_request *request = (struct mod_i2c_request *)event->params;
+    struct mod_i2c_transaction transaction;
+    struct mod_i2c_request *request;
+    const struct mod_i2c_event_param *event_param =
+        (const struct mod_i2c_event_param *)event->params;
+    const struct mod_i2c_transfer_params *transfer_param =
+        (const struct mod_i2c_transfer_params *)event->params;
 
     fwk_assert(fwk_module_is_valid_element_id(event->target_id));
 
@@ -261,47 +473,56 @@ static int mod_i2c_process_event(const struct fwk_event *event,
     if (status != FWK_SUCCESS)
         return status;
 
-    if (fwk_id_is_equal(event->id, mod_i2c_event_id_request)) {
-        ctx->request = *request;
-
-        if (ctx->request.transmit_byte_count != 0) {
-            status = ctx->driver_api->transmit_as_master(ctx->config->driver_id,
-                &ctx->request);
-        } else {
-            status = ctx->driver_api->receive_as_master(ctx->config->driver_id,
-                &ctx->request);
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_I2C_EVENT_IDX_REQUEST:
+        transaction = (struct mod_i2c_transaction) {
+            .request = *(const struct mod_i2c_request *)event->params,
+            .cookie = event->cookie,
+        };
+
+        return process_transaction_request(ctx, &transaction, resp_event);
+
+    case MOD_I2C_EVENT_IDX_TRANSFER:
+        transaction = (struct mod_i2c_transaction) {
+            .request = transfer_param->request_table[0],
+            .next_request = &transfer_param->request_table[1],
+            .next_request_count = transfer_param->request_count - 1,
+            .cookie = event->cookie,
+        };
+
+        return process_transaction_request(ctx, &transaction, resp_event);
+
+    case MOD_I2C_EVENT_IDX_REQUEST_COMPLETED:
+        if (!ctx->busy)
+            return FWK_E_STATE;
+
+        request = &ctx->transaction.request;
+
+        if (event_param->status == FWK_SUCCESS) {
+            if ((request->transmit_byte_count != 0) &&
+                (request->receive_byte_count != 0)) {
+                /* A receive operation needs to be performed */
+                request->transmit_byte_count = 0;
+            } else if (ctx->transaction.next_request_count != 0) {
+                /* Perform the next request of the transfer */
+                *request = *ctx->transaction.next_request++;
+                ctx->transaction.next_request_count--;
+            } else
+                return complete_transaction(event->target_id, ctx, FWK_SUCCESS);
+
+            if (start_request(ctx) == FWK_SUCCESS)
+                return FWK_SUCCESS;
+
+            return complete_transaction(event->target_id, ctx, FWK_E_DEVICE);
         }
-        ctx->cookie = event->cookie;
-        resp_event->is_delayed_response = true;
-
-    } else if (fwk_id_is_equal(event->id, mod_i2c_event_id_request_completed)) {
-
-        if ((ctx->request.transmit_byte_count != 0) &&
-            (ctx->request.receive_byte_count != 0) &&
-            (event_param->status == FWK_SUCCESS)) {
-            /* A receive operation needs to be performed */
-            ctx->request.transmit_byte_count = 0;
-            status = ctx->driver_api->receive_as_master(ctx->config->driver_id,
-                &ctx->request);
-        } else {
-            /* The transaction is completed or aborted. */
-            ctx->busy = false;
-            status = fwk_thread_get_delayed_response(event->target_id,
-                ctx->cookie, &resp);
-            if (status != FWK_SUCCESS)
-                return FWK_E_DEVICE;
 
-            param->status = event_param->status;
-            status = fwk_thread_put_event(&resp);
-        }
+        /* The transaction is aborted */
+        return complete_transaction(event->target_id, ctx,
+                                    event_param->status);
 
-    } else
+    default:
         return FWK_E_PARAM;
-
-    if (status != FWK_SUCCESS)
-        return FWK_E_DEVICE;
-
-    return FWK_SUCCESS;
+    }
 }
 
 const struct fwk_module module_i2c = {
@@ -0,0 +1,71 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Interrupt priorities.
+ */
+
+#ifndef MOD_IRQ_PRIORITY_H
+#define MOD_IRQ_PRIORITY_H
+
+#include <stddef.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupIrqPriority Interrupt Priorities
+ *
+ * \details The module sets the priorities of the interrupts of the firmware
+ *      from a table of the product configuration, when the modules are
+ *      initialized and before any of them enables its interrupts. The
+ *      interrupts which are not in the table keep the highest priority, so
+ *      the table lists the interrupts whose service routines may be
+ *      preempted, for instance by the doorbells of the SCMI channels.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Priority of an interrupt.
+ */
+struct mod_irq_priority_entry {
+    /*! Interrupt number */
+    unsigned int interrupt;
+
+    /*! Priority of the interrupt, \c 0 being the highest */
+    unsigned int priority;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_irq_priority_config {
+    /*!
+     * \brief Number of subpriority bits of the priorities.
+     *
+     * \details See \ref fwk_interrupt_set_priority_grouping().
+     */
+    unsigned int subpriority_bits;
+
+    /*! Table of the interrupt priorities */
+    const struct mod_irq_priority_entry *priority_table;
+
+    /*! Number of entries in the table */
+    size_t priority_count;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_IRQ_PRIORITY_H */
@@ -0,0 +1,69 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Interrupt priorities.
+ */
+
+#include <stddef.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_module.h>
+#include <mod_irq_priority.h>
+
+static const struct mod_irq_priority_config *config;
+
+static int set_priorities(void)
+{
+    int status;
+    size_t entry_idx;
+    const struct mod_irq_priority_entry *entry;
+
+    status = fwk_interrupt_set_priority_grouping(config->subpriority_bits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (entry_idx = 0; entry_idx < config->priority_count; entry_idx++) {
+        entry = &config->priority_table[entry_idx];
+
+        status = fwk_interrupt_set_priority(entry->interrupt, entry->priority);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Framework handlers
+ */
+
+static int irq_priority_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    config = data;
+
+    if ((config == NULL) ||
+        ((config->priority_count > 0) && (config->priority_table == NULL)))
+        return FWK_E_DATA;
+
+    return set_priorities();
+}
+
+/* The interrupt controller loses the priorities while the SCP is off */
+static int irq_priority_resume(fwk_id_t id)
+{
+    return set_priorities();
+}
+
+const struct fwk_module module_irq_priority = {
+    .name = "IRQ priority",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .retainable = true,
+    .init = irq_priority_init,
+    .resume = irq_priority_resume,
+};
@@ -0,0 +1,136 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Processor load monitor.
+ */
+
+#ifndef MOD_LOAD_MONITOR_H
+#define MOD_LOAD_MONITOR_H
+
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupLoadMonitor Load Monitor
+ *
+ * \details The module samples the event processing time measured by the
+ *      framework periodically, and computes the load of the processor and the
+ *      share of it due to each monitored module over a sliding window of the
+ *      last samples. The processor is busy while the framework processes an
+ *      event, and idle otherwise.
+ *
+ *      A warning is logged when the load of the processor reaches the
+ *      threshold, and once more after it has fallen below the threshold.
+ *
+ *      The firmware must be built with event profiling support.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Load of a fully busy processor.
+ *
+ * \details Loads are expressed in hundredths of a percent.
+ */
+#define MOD_LOAD_MONITOR_LOAD_MAX 10000
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_load_monitor_config {
+    /*! Sub-element identifier of the alarm sampling the load */
+    fwk_id_t alarm_id;
+
+    /*!
+     * \brief Sampling period in milliseconds.
+     *
+     * \details The period must be shorter than the wrap around period of the
+     *      timestamp of the architecture layer.
+     */
+    unsigned int sampling_period_ms;
+
+    /*! Number of samples in the sliding window */
+    unsigned int window_length;
+
+    /*!
+     * \brief Load of the processor over the window from which a warning is
+     *      logged, in hundredths of a percent.
+     *
+     * \details Zero disables the warning.
+     */
+    unsigned int warning_threshold;
+
+    /*! Table of the identifiers of the monitored modules */
+    const fwk_id_t *module_id_table;
+
+    /*! Number of monitored modules */
+    unsigned int module_count;
+};
+
+/*!
+ * \brief Load monitor API.
+ */
+struct mod_load_monitor_api {
+    /*!
+     * \brief Get the load of the processor over the sliding window.
+     *
+     * \param[out] load Load in hundredths of a percent.
+     * \param[out] window_ms Duration of the samples taken into account in
+     *      milliseconds, lower than the window until it has filled up.
+     *
+     * \retval FWK_SUCCESS The load was returned.
+     * \retval FWK_E_STATE No sample has been taken yet.
+     * \retval FWK_E_PARAM One of the parameters is invalid.
+     */
+    int (*get_load)(unsigned int *load, unsigned int *window_ms);
+
+    /*!
+     * \brief Get the load due to a monitored module over the sliding window.
+     *
+     * \param index Index of the module in the table of monitored modules.
+     * \param[out] module_id Identifier of the module.
+     * \param[out] load Load in hundredths of a percent.
+     *
+     * \retval FWK_SUCCESS The load was returned.
+     * \retval FWK_E_RANGE The index is out of the table of monitored modules.
+     * \retval FWK_E_STATE No sample has been taken yet.
+     * \retval FWK_E_PARAM One of the parameters is invalid.
+     */
+    int (*get_module_load)(unsigned int index, fwk_id_t *module_id,
+                           unsigned int *load);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_load_monitor_api_idx {
+    /*! Load monitor API */
+    MOD_LOAD_MONITOR_API_IDX_LOAD,
+
+    /*! Number of APIs */
+    MOD_LOAD_MONITOR_API_IDX_COUNT,
+};
+
+/*! Identifier of the load monitor API */
+static const fwk_id_t mod_load_monitor_api_id_load =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_LOAD_MONITOR,
+                    MOD_LOAD_MONITOR_API_IDX_LOAD);
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_LOAD_MONITOR_H */
@@ -0,0 +1,322 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Processor load monitor.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <mod_load_monitor.h>
+#include <mod_log.h>
+#include <mod_timer.h>
+
+/* Busy and elapsed times of a sampling period, in timestamp ticks */
+struct sample {
+    uint32_t elapsed;
+    uint32_t busy;
+};
+
+static struct {
+    /* Module configuration */
+    const struct mod_load_monitor_config *config;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Ring of the samples of the window */
+    struct sample *sample_table;
+
+    /*
+     * Ring of the busy times of the monitored modules, the busy times of a
+     * sample are stored contiguously.
+     */
+    uint32_t *module_busy_table;
+
+    /* Index of the oldest sample of the window */
+    unsigned int sample_idx;
+
+    /* Number of samples of the window taken */
+    unsigned int sample_count;
+
+    /* Sums of the samples of the window */
+    uint64_t elapsed_sum;
+    uint64_t busy_sum;
+    uint64_t *module_busy_sum_table;
+
+    /* Load statistics of the previous sample */
+    struct fwk_thread_load_stats last_load_stats;
+
+    /* Cumulated processing time of the monitored modules at the last sample */
+    uint64_t *module_last_total_table;
+
+    /* The load of the processor is over the warning threshold */
+    bool overloaded;
+} ctx;
+
+/*
+ * Static functions
+ */
+
+static unsigned int get_load(uint64_t busy)
+{
+    if (ctx.elapsed_sum == 0)
+        return 0;
+
+    if (busy >= ctx.elapsed_sum)
+        return MOD_LOAD_MONITOR_LOAD_MAX;
+
+    return (unsigned int)((busy * MOD_LOAD_MONITOR_LOAD_MAX) /
+                          ctx.elapsed_sum);
+}
+
+static uint32_t get_module_busy(unsigned int module_idx)
+{
+    struct fwk_thread_profile_stats stats;
+    uint64_t last_total;
+    int status;
+
+    status = fwk_thread_get_profile_stats(
+        ctx.config->module_id_table[module_idx], &stats);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    last_total = ctx.module_last_total_table[module_idx];
+    ctx.module_last_total_table[module_idx] = stats.total;
+
+    /* The statistics have been cleared since the last sample */
+    if (stats.total < last_total)
+        return (uint32_t)stats.total;
+
+    return (uint32_t)(stats.total - last_total);
+}
+
+static void check_threshold(void)
+{
+    unsigned int threshold = ctx.config->warning_threshold;
+    unsigned int window_ms;
+    unsigned int load;
+
+    if (threshold == 0)
+        return;
+
+    load = get_load(ctx.busy_sum);
+    if ((load >= threshold) == ctx.overloaded)
+        return;
+
+    ctx.overloaded = !ctx.overloaded;
+    window_ms = ctx.sample_count * ctx.config->sampling_period_ms;
+
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_WARNING,
+            "[LOAD] Processor load %s threshold: %u.%02u pct over %u ms\n",
+            ctx.overloaded ? "over" : "back under",
+            load / 100, load % 100, window_ms);
+}
+
+static int take_sample(void)
+{
+    const struct mod_load_monitor_config *config = ctx.config;
+    struct fwk_thread_load_stats load_stats;
+    struct sample *sample;
+    uint32_t *module_busy;
+    unsigned int module_idx;
+    int status;
+
+    status = fwk_thread_get_load_stats(&load_stats);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    sample = &ctx.sample_table[ctx.sample_idx];
+    module_busy = &ctx.module_busy_table[ctx.sample_idx * config->module_count];
+
+    /* Replace the oldest sample of the window */
+    ctx.elapsed_sum -= sample->elapsed;
+    ctx.busy_sum -= sample->busy;
+
+    /* The subtraction handles the wrap around of the timestamp counter */
+    sample->elapsed = load_stats.timestamp - ctx.last_load_stats.timestamp;
+    sample->busy = (uint32_t)(load_stats.busy - ctx.last_load_stats.busy);
+    if (sample->busy > sample->elapsed)
+        sample->busy = sample->elapsed;
+
+    ctx.elapsed_sum += sample->elapsed;
+    ctx.busy_sum += sample->busy;
+
+    for (module_idx = 0; module_idx < config->module_count; module_idx++) {
+        ctx.module_busy_sum_table[module_idx] -= module_busy[module_idx];
+        module_busy[module_idx] = get_module_busy(module_idx);
+        ctx.module_busy_sum_table[module_idx] += module_busy[module_idx];
+    }
+
+    ctx.last_load_stats = load_stats;
+    ctx.sample_idx = (ctx.sample_idx + 1) % config->window_length;
+    if (ctx.sample_count < config->window_length)
+        ctx.sample_count++;
+
+    check_threshold();
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Load monitor API
+ */
+
+static int load_monitor_get_load(unsigned int *load, unsigned int *window_ms)
+{
+    if ((load == NULL) || (window_ms == NULL))
+        return FWK_E_PARAM;
+
+    if (ctx.sample_count == 0)
+        return FWK_E_STATE;
+
+    *load = get_load(ctx.busy_sum);
+    *window_ms = ctx.sample_count * ctx.config->sampling_period_ms;
+
+    return FWK_SUCCESS;
+}
+
+static int load_monitor_get_module_load(unsigned int index,
+                                        fwk_id_t *module_id,
+                                        unsigned int *load)
+{
+    if ((module_id == NULL) || (load == NULL))
+        return FWK_E_PARAM;
+
+    if (index >= ctx.config->module_count)
+        return FWK_E_RANGE;
+
+    if (ctx.sample_count == 0)
+        return FWK_E_STATE;
+
+    *module_id = ctx.config->module_id_table[index];
+    *load = get_load(ctx.module_busy_sum_table[index]);
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_load_monitor_api load_monitor_api = {
+    .get_load = load_monitor_get_load,
+    .get_module_load = load_monitor_get_module_load,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int load_monitor_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    const struct mod_load_monitor_config *config = data;
+    unsigned int module_count;
+
+    if ((element_count != 0) || (config == NULL) ||
+        (config->sampling_period_ms == 0) || (config->window_length == 0) ||
+        ((config->module_count != 0) && (config->module_id_table == NULL)))
+        return FWK_E_DATA;
+
+    module_count = config->module_count;
+
+    ctx.sample_table = fwk_mm_calloc(config->window_length,
+                                     sizeof(ctx.sample_table[0]));
+    if (ctx.sample_table == NULL)
+        return FWK_E_NOMEM;
+
+    if (module_count != 0) {
+        ctx.module_busy_table =
+            fwk_mm_calloc(config->window_length * module_count,
+                          sizeof(ctx.module_busy_table[0]));
+        ctx.module_busy_sum_table =
+            fwk_mm_calloc(module_count, sizeof(ctx.module_busy_sum_table[0]));
+        ctx.module_last_total_table =
+            fwk_mm_calloc(module_count,
+                          sizeof(ctx.module_last_total_table[0]));
+        if ((ctx.module_busy_table == NULL) ||
+            (ctx.module_busy_sum_table == NULL) ||
+            (ctx.module_last_total_table == NULL))
+            return FWK_E_NOMEM;
+    }
+
+    ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int load_monitor_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+                             MOD_LOG_API_ID, &ctx.log_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                           &ctx.alarm_api);
+}
+
+static int load_monitor_process_bind_request(fwk_id_t source_id,
+                                             fwk_id_t target_id,
+                                             fwk_id_t api_id,
+                                             const void **api)
+{
+    if (!fwk_id_is_equal(api_id, mod_load_monitor_api_id_load))
+        return FWK_E_PARAM;
+
+    *api = &load_monitor_api;
+
+    return FWK_SUCCESS;
+}
+
+static int load_monitor_start(fwk_id_t id)
+{
+    unsigned int module_idx;
+    int status;
+
+    /* The first sample covers the period from the start of the module */
+    status = fwk_thread_get_load_stats(&ctx.last_load_stats);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (module_idx = 0; module_idx < ctx.config->module_count; module_idx++)
+        get_module_busy(module_idx);
+
+    return ctx.alarm_api->start(ctx.config->alarm_id,
+                                ctx.config->sampling_period_ms,
+                                MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+static int load_monitor_process_event(const struct fwk_event *event,
+                                      struct fwk_event *resp_event)
+{
+    if (!fwk_id_is_equal(event->id, mod_timer_event_id_alarm))
+        return FWK_E_PARAM;
+
+    return take_sample();
+}
+
+const struct fwk_module module_load_monitor = {
+    .name = "Load monitor",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_LOAD_MONITOR_API_IDX_COUNT,
+    .init = load_monitor_init,
+    .bind = load_monitor_bind,
+    .process_bind_request = load_monitor_process_bind_request,
+    .start = load_monitor_start,
+    .process_event = load_monitor_process_event,
+};
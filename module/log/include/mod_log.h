@@ -8,6 +8,10 @@
 #ifndef MOD_LOG_H
 #define MOD_LOG_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
 #include <fwk_id.h>
 
 /*!
@@ -26,6 +30,12 @@
  *      A grouping feature allows logged messages to be organized into
  *      categories that can be enabled or disabled through the module
  *      configuration.
+ *
+ *      The messages can be deferred: the log calls then only store the format
+ *      string pointer and the arguments in a ring buffer, and the messages are
+ *      formatted and written to the output device later, by the events
+ *      processed by the module or when the log is flushed. This keeps the
+ *      time spent in the log calls independent of the speed of the device.
  * @{
  */
 
@@ -57,6 +67,88 @@ enum mod_log_group {
     MOD_LOG_GROUP_WARNING = (1 << 3),
 };
 
+/*!
+ * \brief Mask of the log groups built into the firmware.
+ *
+ * \details All the log groups are built in, unless the firmware selects them
+ *      through the BS_FIRMWARE_LOG_GROUPS build system parameter.
+ */
+#ifdef BUILD_HAS_LOG_GROUP_FILTER
+#define MOD_LOG_GROUPS_BUILT_IN ( \
+    MOD_LOG_GROUP_DEBUG_BUILT_IN | \
+    MOD_LOG_GROUP_ERROR_BUILT_IN | \
+    MOD_LOG_GROUP_INFO_BUILT_IN | \
+    MOD_LOG_GROUP_WARNING_BUILT_IN)
+#else
+#define MOD_LOG_GROUPS_BUILT_IN ( \
+    MOD_LOG_GROUP_DEBUG | \
+    MOD_LOG_GROUP_ERROR | \
+    MOD_LOG_GROUP_INFO | \
+    MOD_LOG_GROUP_WARNING)
+#endif
+
+/*!
+ * \cond
+ */
+#ifdef BUILD_HAS_LOG_GROUP_DEBUG
+#define MOD_LOG_GROUP_DEBUG_BUILT_IN MOD_LOG_GROUP_DEBUG
+#else
+#define MOD_LOG_GROUP_DEBUG_BUILT_IN 0
+#endif
+
+#ifdef BUILD_HAS_LOG_GROUP_ERROR
+#define MOD_LOG_GROUP_ERROR_BUILT_IN MOD_LOG_GROUP_ERROR
+#else
+#define MOD_LOG_GROUP_ERROR_BUILT_IN 0
+#endif
+
+#ifdef BUILD_HAS_LOG_GROUP_INFO
+#define MOD_LOG_GROUP_INFO_BUILT_IN MOD_LOG_GROUP_INFO
+#else
+#define MOD_LOG_GROUP_INFO_BUILT_IN 0
+#endif
+
+#ifdef BUILD_HAS_LOG_GROUP_WARNING
+#define MOD_LOG_GROUP_WARNING_BUILT_IN MOD_LOG_GROUP_WARNING
+#else
+#define MOD_LOG_GROUP_WARNING_BUILT_IN 0
+#endif
+
+/*
+ * Value of the MOD_LOG() calls removed at compile time. Being a function call,
+ * it does not trigger warnings about statements without effect.
+ */
+static inline int mod_log_removed(void)
+{
+    return FWK_SUCCESS;
+}
+/*!
+ * \endcond
+ */
+
+/*!
+ * \brief Log formatted data through a log module API.
+ *
+ * \details Calls \ref mod_log_api::log() when the log group is built into
+ *      the firmware (see \ref MOD_LOG_GROUPS_BUILT_IN). Otherwise the call is
+ *      removed at compile time along with its format string and arguments,
+ *      and the macro evaluates to \ref FWK_SUCCESS.
+ *
+ *      Example:
+ *      \code
+ *      status = MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[MOD] %u\n", x);
+ *      \endcode
+ *
+ * \param api Pointer to the log module API.
+ * \param group Log group the message is assigned to.
+ * \param ... Format string and arguments (see \ref mod_log_api::log()).
+ *
+ * \return The value returned by \ref mod_log_api::log(), or \ref FWK_SUCCESS.
+ */
+#define MOD_LOG(api, group, ...) \
+    ((((group) & MOD_LOG_GROUPS_BUILT_IN) != 0) ? \
+        (api)->log((group), __VA_ARGS__) : mod_log_removed())
+
 /*!
  * \brief Log module API identifier.
  *
@@ -89,6 +181,91 @@ struct mod_log_config {
      * \note May be NULL, in which case the banner functionality is not used.
      */
     const char *banner;
+
+    /*!
+     * \brief Log a summary of the heap usage once all the modules have been
+     *      started.
+     *
+     * \details The summary is the one logged by
+     *      \ref mod_log_api::log_heap_usage().
+     */
+    const bool heap_usage_summary;
+
+    /*!
+     * \brief Log the time spent by the modules in the pre-runtime phase once
+     *      all the modules have been started.
+     *
+     * \details The summary is the one logged by
+     *      \ref mod_log_api::log_boot_time().
+     *
+     * \note Only supported when the firmware is built with event profiling
+     *      support.
+     */
+    const bool boot_time_summary;
+
+    /*!
+     * \brief Size in bytes of the buffer where the log messages are deferred.
+     *
+     * \details When zero, the log messages are formatted and written to the
+     *      device within the \ref mod_log_api::log() calls.
+     *
+     *      Otherwise, the log messages are recorded in the buffer and written
+     *      to the device in the background. When the buffer is full, the
+     *      messages are dropped and the number of dropped messages is logged
+     *      once the buffer has been drained.
+     */
+    const size_t deferred_buffer_size;
+
+    /*!
+     * \brief Base address of the buffer where the log messages are deferred.
+     *
+     * \details Allows the buffer to be placed in a dedicated memory region,
+     *      for instance a region reserved by the platform for that purpose.
+     *
+     * \note May be zero, in which case the buffer is allocated from the heap.
+     */
+    const uintptr_t deferred_buffer_address;
+
+    /*!
+     * \brief Log groups whose messages are rate-limited. Value is a mask (see
+     *      \ref mod_log_group).
+     *
+     * \details The messages are rate-limited per format string, with a token
+     *      bucket: up to \ref rate_limit_burst messages sharing a format
+     *      string are logged at once, and one more message is allowed every
+     *      \ref rate_limit_period_ms. The other messages are suppressed, and
+     *      the number of suppressed messages is logged before the next
+     *      message of the format string that is not.
+     *
+     * \note The messages are not rate-limited when zero, and the other
+     *      rate-limiting fields are then ignored. Only the groups logging
+     *      whole lines should be rate-limited.
+     */
+    const unsigned int rate_limit_groups;
+
+    /*!
+     * \brief Number of format strings whose rate is tracked at once.
+     *
+     * \details The entry of a format string is reused by another one once
+     *      its bucket is full and its suppressed messages have been reported.
+     *      The messages of a format string are not rate-limited while all the
+     *      entries are in use.
+     */
+    const unsigned int rate_limit_entry_count;
+
+    /*! Number of messages of a format string logged at once */
+    const unsigned int rate_limit_burst;
+
+    /*! Period in milliseconds after which one more message is allowed */
+    const unsigned int rate_limit_period_ms;
+
+    /*!
+     * \brief Element identifier of the timer giving the time of the messages
+     *      for their rate limit.
+     *
+     * \note The messages are not rate-limited before the timer is started.
+     */
+    const fwk_id_t rate_limit_timer_id;
 };
 
 /*!
@@ -122,6 +299,25 @@ struct mod_log_driver_api {
      * \retval FWK_E_DEVICE Internal device error.
      */
     int (*putchar)(fwk_id_t device_id, char c);
+
+    /*!
+     * \brief Pointer to the function used to write a sequence of characters.
+     *
+     * \details When provided, the log module passes the characters of a
+     *      message to this function in chunks rather than one at a time to
+     *      \ref putchar(). The device may queue the characters and return
+     *      before they have been transmitted.
+     *
+     * \note This function is \b optional.
+     *
+     * \param device_id Device identifier.
+     * \param buf Characters to be written.
+     * \param len Number of characters to be written.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_DEVICE Internal device error.
+     */
+    int (*write)(fwk_id_t device_id, const char *buf, size_t len);
 };
 
 /*!
@@ -135,6 +331,10 @@ struct mod_log_api {
      *      assigned to enabled groups will be output. The module configuration
      *      can be used to enable and disable log groups.
      *
+     *      The \ref MOD_LOG() macro should be used to call this function, so
+     *      that the messages of the log groups not built into the firmware are
+     *      removed from it.
+     *
      * \param group One of the log groups that the log is assigned to (\see
      *      log_group).
      *
@@ -155,9 +355,21 @@ struct mod_log_api {
      *      * log("%04d", 9999) results in "9999"
      *      * __Note__: \<width\> must be a number between 0 and 9 inclusive.
      *
+     * \note When the log messages are deferred (see
+     *      \ref mod_log_config::deferred_buffer_size), only the pointers to
+     *      'fmt' and to the strings of the \%s arguments are recorded. They
+     *      must remain valid until the message is written, which is the case
+     *      of string literals and module names.
+     *
+     * \note A message suppressed by its rate limit (see
+     *      \ref mod_log_config::rate_limit_groups) is not logged, and the call
+     *      succeeds.
+     *
      * \retval FWK_SUCCESS Operation succeeded.
      * \retval FWK_E_DATA Invalid format specifier(s).
      * \retval FWK_E_DEVICE Internal device error.
+     * \retval FWK_E_NOMEM The log messages are deferred and the buffer is
+     *      full, the message has been dropped.
      * \retval FWK_E_PARAM Invalid group.
      * \retval FWK_E_PARAM Invalid 'fmt' pointer.
      * \retval FWK_E_STATE Log module is not ready.
@@ -168,15 +380,77 @@ struct mod_log_api {
      * \brief Function used to flush the log's buffer.
      *
      * \details When invoked, any buffered log data will be flushed out before
-     *      this function returns.
+     *      this function returns. This includes the deferred log messages.
      *
      * \retval FWK_SUCCESS Operation succeeded.
      * \retval FWK_E_DEVICE Internal device error.
      * \retval FWK_E_STATE Log module is not ready.
      */
     int (*flush)(void);
+
+    /*!
+     * \brief Log the event processing statistics gathered by the framework.
+     *
+     * \details The statistics of each module having processed at least one
+     *      event are logged, followed by the queuing delay statistics of its
+     *      events and by the statistics of each of its events and
+     *      notifications that have been processed at least once. The
+     *      statistics are assigned to the \ref MOD_LOG_GROUP_INFO log group.
+     *
+     * \note Only supported when the firmware is built with event profiling
+     *      support.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_DEVICE Internal device error.
+     * \retval FWK_E_STATE Log module is not ready.
+     * \retval FWK_E_SUPPORT The firmware is built without event profiling
+     *      support.
+     */
+    int (*log_event_profile)(void);
+
+    /*!
+     * \brief Log the heap usage.
+     *
+     * \details The number of bytes of heap in use is logged, followed by the
+     *      number of bytes allocated for each module having allocated memory.
+     *      The usage is assigned to the \ref MOD_LOG_GROUP_INFO log group.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_DEVICE Internal device error.
+     * \retval FWK_E_STATE Log module is not ready.
+     */
+    int (*log_heap_usage)(void);
+
+    /*!
+     * \brief Log the time spent by the modules in the pre-runtime phase.
+     *
+     * \details For each module, the time spent in the initialization, the
+     *      element initialization, the post-initialization, each binding
+     *      round and the start is logged, in timestamp ticks. The durations
+     *      are assigned to the \ref MOD_LOG_GROUP_INFO log group.
+     *
+     * \note Only supported when the firmware is built with event profiling
+     *      support.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_DEVICE Internal device error.
+     * \retval FWK_E_STATE Log module is not ready.
+     * \retval FWK_E_SUPPORT The firmware is built without event profiling
+     *      support.
+     */
+    int (*log_boot_time)(void);
 };
 
+/*!
+ * \brief Log API of the module.
+ *
+ * \details The API returned for all the binding requests of the module. It is
+ *      exposed for a firmware to resolve the bindings to the log module at
+ *      build time, with
+ *      BS_FIRMWARE_STATIC_BINDINGS := any:log:0:mod_log_module_api
+ */
+extern const struct mod_log_api mod_log_module_api;
+
 /*!
  * @}
  */
@@ -5,20 +5,143 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <limits.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <fwk_assert.h>
 #include <fwk_element.h>
 #include <fwk_errno.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_mm.h>
+#include <fwk_thread.h>
 #include <mod_log.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
+
+/* Module event indices */
+enum mod_log_event_idx {
+    MOD_LOG_EVENT_IDX_HEAP_SUMMARY,
+    MOD_LOG_EVENT_IDX_BOOT_TIME_SUMMARY,
+    MOD_LOG_EVENT_IDX_DRAIN,
+    MOD_LOG_EVENT_IDX_COUNT
+};
+
+/*
+ * Ring buffer of the deferred log records.
+ *
+ * A record is made of the format string pointer, the size of the record in
+ * bytes and the arguments of the log call in their raw binary form. Records
+ * are appended at the head of the ring and drained from its tail.
+ */
+struct log_ring {
+    /* Storage of the ring, NULL when logs are not deferred */
+    uint8_t *buffer;
+
+    /* Size of the storage in bytes */
+    size_t size;
+
+    /* Offset of the next record to be written */
+    size_t head;
+
+    /* Offset of the oldest record */
+    size_t tail;
+
+    /* Number of bytes used by the records */
+    size_t used;
+
+    /* Number of records dropped because the ring was full */
+    unsigned int dropped_count;
+
+    /* A drain event has been queued and not processed yet */
+    bool drain_pending;
+
+    /* The records are being formatted */
+    bool draining;
+
+    /* The module has been started, the drain events can be queued */
+    bool started;
+};
+
+/* Rate limit of the messages sharing a format string */
+struct rate_limit_entry {
+    /* Format string of the messages, NULL when the entry is unused */
+    const char *fmt;
+
+    /* Number of messages that can be logged before being suppressed */
+    unsigned int tokens;
+
+    /* Time the last token was added to the bucket, in microseconds */
+    uint64_t refill_time;
+
+    /* Number of messages suppressed since the last one logged */
+    unsigned int suppressed_count;
+};
+
+/*
+ * Number of characters passed at once to the write function of the driver,
+ * when the driver provides one.
+ */
+#define WRITE_BUFFER_SIZE 32
+
+/* Operations performed by do_print() */
+enum print_mode {
+    /* Format the log arguments and write the result to the device */
+    PRINT_MODE_OUTPUT,
+
+    /* Copy the log arguments in a record of the ring */
+    PRINT_MODE_RECORD,
+
+    /* Format the arguments of a record and write the result to the device */
+    PRINT_MODE_REPLAY,
+};
+
+struct print_ctx {
+    enum print_mode mode;
+
+    /* Arguments of the log call (PRINT_MODE_OUTPUT and PRINT_MODE_RECORD) */
+    va_list *args;
+
+    /*
+     * Offset in the ring of the next argument to be recorded or replayed
+     * (PRINT_MODE_RECORD and PRINT_MODE_REPLAY).
+     */
+    size_t offset;
+
+    /* Number of bytes recorded or replayed */
+    size_t length;
+
+    /* Characters not yet passed to the write function of the driver */
+    char write_buffer[WRITE_BUFFER_SIZE];
+
+    /* Number of characters in the write buffer */
+    size_t write_count;
+};
+
+/*
+ * Maximum number of records formatted when processing a drain event. Other
+ * events are processed between two drain events.
+ */
+#define DRAIN_RECORD_COUNT 4
+
+/* Size of the fixed part of a record */
+#define RECORD_HEADER_SIZE (sizeof(const char *) + sizeof(uint32_t))
 
 static const struct mod_log_config *log_config;
 static struct mod_log_driver_api *log_driver;
+static struct log_ring ring;
+
+/* Table of the rate limits, NULL when the messages are not rate-limited */
+static struct rate_limit_entry *rate_limit_table;
+
+#if BUILD_HAS_MOD_TIMER
+static const struct mod_timer_api *timer_api;
+#endif
 
 #define ALL_GROUPS_MASK (MOD_LOG_GROUP_DEBUG | \
                          MOD_LOG_GROUP_ERROR | \
@@ -47,25 +170,50 @@ static const char * const errstr[] = {
     [-FWK_E_PANIC]       = "E_PANIC",
 };
 
-static int do_putchar(char c)
+static int write_buffered(struct print_ctx *ctx)
+{
+    int status;
+
+    if (ctx->write_count == 0)
+        return FWK_SUCCESS;
+
+    status = log_driver->write(log_config->device_id, ctx->write_buffer,
+                               ctx->write_count);
+    ctx->write_count = 0;
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    return FWK_SUCCESS;
+}
+
+static int do_putchar(struct print_ctx *ctx, char c)
 {
     int status;
 
     /* Include a 'carriage return' before the new line */
     if (c == '\n') {
-        status = do_putchar('\r');
+        status = do_putchar(ctx, '\r');
         if (status != FWK_SUCCESS)
             return status;
     }
 
-    status = log_driver->putchar(log_config->device_id, c);
-    if (status != FWK_SUCCESS)
-        return FWK_E_DEVICE;
+    if (log_driver->write == NULL) {
+        status = log_driver->putchar(log_config->device_id, c);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        return FWK_SUCCESS;
+    }
+
+    ctx->write_buffer[ctx->write_count++] = c;
+    if (ctx->write_count == sizeof(ctx->write_buffer))
+        return write_buffered(ctx);
 
     return FWK_SUCCESS;
 }
 
-static int print_uint64(uint64_t value, unsigned int base, unsigned int fill)
+static int print_uint64(struct print_ctx *ctx, uint64_t value,
+                        unsigned int base, unsigned int fill)
 {
     /* Just need enough space to store 64 bit decimal integer */
     unsigned char str[20];
@@ -80,13 +228,13 @@ static int print_uint64(uint64_t value, unsigned int base, unsigned int fill)
     } while (value /= base);
 
     while (fill-- > i) {
-        status = do_putchar('0');
+        status = do_putchar(ctx, '0');
         if (status != FWK_SUCCESS)
             return status;
     }
 
     while (i > 0) {
-        status = do_putchar(str[--i]);
+        status = do_putchar(ctx, str[--i]);
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -94,28 +242,28 @@ static int print_uint64(uint64_t value, unsigned int base, unsigned int fill)
     return FWK_SUCCESS;
 }
 
-static int print_int32(int32_t num, unsigned int fill)
+static int print_int32(struct print_ctx *ctx, int32_t num, unsigned int fill)
 {
     int status;
     uint64_t unum;
 
     if (num < 0) {
-        status = do_putchar('-');
+        status = do_putchar(ctx, '-');
         if (status != FWK_SUCCESS)
             return status;
         unum = (uint64_t)-num;
     } else
         unum = (uint64_t)num;
 
-    return print_uint64(unum, 10, fill);
+    return print_uint64(ctx, unum, 10, fill);
 }
 
-static int print_string(const char *str)
+static int print_string(struct print_ctx *ctx, const char *str)
 {
     int status;
 
     while (*str) {
-        status = do_putchar(*str++);
+        status = do_putchar(ctx, *str++);
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -123,13 +271,106 @@ static int print_string(const char *str)
     return FWK_SUCCESS;
 }
 
-static int do_print(const char *fmt, va_list *args)
+static void ring_copy_to(size_t offset, const void *data, size_t size)
+{
+    const uint8_t *bytes = data;
+
+    while (size-- > 0) {
+        ring.buffer[offset] = *bytes++;
+        offset = (offset + 1) % ring.size;
+    }
+}
+
+static void ring_copy_from(size_t offset, void *data, size_t size)
+{
+    uint8_t *bytes = data;
+
+    while (size-- > 0) {
+        *bytes++ = ring.buffer[offset];
+        offset = (offset + 1) % ring.size;
+    }
+}
+
+static int ring_write(struct print_ctx *ctx, const void *data, size_t size)
+{
+    if ((ring.used + ctx->length + size) > ring.size)
+        return FWK_E_NOMEM;
+
+    ring_copy_to(ctx->offset, data, size);
+    ctx->offset = (ctx->offset + size) % ring.size;
+    ctx->length += size;
+
+    return FWK_SUCCESS;
+}
+
+static void ring_read(struct print_ctx *ctx, void *data, size_t size)
+{
+    ring_copy_from(ctx->offset, data, size);
+    ctx->offset = (ctx->offset + size) % ring.size;
+    ctx->length += size;
+}
+
+/*
+ * The argument getters read the next argument of the log call, and add it to
+ * the record being built in PRINT_MODE_RECORD, or read it back from the
+ * record being formatted in PRINT_MODE_REPLAY.
+ */
+
+static int get_arg_uint32(struct print_ctx *ctx, uint32_t *value)
+{
+    if (ctx->mode == PRINT_MODE_REPLAY) {
+        ring_read(ctx, value, sizeof(*value));
+        return FWK_SUCCESS;
+    }
+
+    *value = va_arg(*ctx->args, uint32_t);
+
+    if (ctx->mode == PRINT_MODE_RECORD)
+        return ring_write(ctx, value, sizeof(*value));
+
+    return FWK_SUCCESS;
+}
+
+static int get_arg_uint64(struct print_ctx *ctx, uint64_t *value)
+{
+    if (ctx->mode == PRINT_MODE_REPLAY) {
+        ring_read(ctx, value, sizeof(*value));
+        return FWK_SUCCESS;
+    }
+
+    *value = va_arg(*ctx->args, uint64_t);
+
+    if (ctx->mode == PRINT_MODE_RECORD)
+        return ring_write(ctx, value, sizeof(*value));
+
+    return FWK_SUCCESS;
+}
+
+static int get_arg_string(struct print_ctx *ctx, const char **str)
+{
+    if (ctx->mode == PRINT_MODE_REPLAY) {
+        ring_read(ctx, str, sizeof(*str));
+        return FWK_SUCCESS;
+    }
+
+    *str = va_arg(*ctx->args, const char *);
+
+    if (ctx->mode == PRINT_MODE_RECORD)
+        return ring_write(ctx, str, sizeof(*str));
+
+    return FWK_SUCCESS;
+}
+
+static int format(const char *fmt, struct print_ctx *ctx)
 {
     int status;
     int bit64;
     int64_t num;
     uint64_t unum;
+    uint32_t value;
+    const char *str;
     unsigned int fill;
+    bool output = (ctx->mode != PRINT_MODE_RECORD);
 
     while (*fmt) {
 
@@ -142,17 +383,22 @@ next_symbol:
             /* Check the format specifier */
             switch (*fmt) {
             case 'e':
-                num = va_arg(*args, int);
+                status = get_arg_uint32(ctx, &value);
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+                num = (int32_t)value;
                 unum = (uint64_t)(-num);
                 if ((num <= 0) && (unum < FWK_ARRAY_SIZE(errstr))) {
 
-                    status = print_string("FWK_");
+                    status = print_string(ctx, "FWK_");
                     if (status != FWK_SUCCESS)
                         return status;
 
-                    status = print_string(errstr[unum]);
+                    status = print_string(ctx, errstr[unum]);
                 } else
-                    status = print_int32(num, 0);
+                    status = print_int32(ctx, num, 0);
 
                 if (status != FWK_SUCCESS)
                     return status;
@@ -163,31 +409,55 @@ next_symbol:
                 if (bit64)
                     return FWK_E_DATA;
 
-                num = va_arg(*args, int32_t);
+                status = get_arg_uint32(ctx, &value);
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+                num = (int32_t)value;
 
-                status = print_int32(num, fill);
+                status = print_int32(ctx, num, fill);
                 if (status != FWK_SUCCESS)
                     return status;
                 break;
 
             case 's':
-                status = print_string(va_arg(*args, const char *));
+                status = get_arg_string(ctx, &str);
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+
+                status = print_string(ctx, str);
                 if (status != FWK_SUCCESS)
                     return status;
                 break;
 
             case 'c':
-                status = do_putchar(va_arg(*args, int));
+                status = get_arg_uint32(ctx, &value);
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+
+                status = do_putchar(ctx, (char)value);
                 if (status != FWK_SUCCESS)
                     return status;
                 break;
 
             case 'x':
                 if (bit64)
-                    unum = va_arg(*args, uint64_t);
-                else
-                    unum = va_arg(*args, uint32_t);
-                status = print_uint64(unum, 16, fill);
+                    status = get_arg_uint64(ctx, &unum);
+                else {
+                    status = get_arg_uint32(ctx, &value);
+                    unum = value;
+                }
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+
+                status = print_uint64(ctx, unum, 16, fill);
                 if (status != FWK_SUCCESS)
                     return status;
                 break;
@@ -201,9 +471,14 @@ next_symbol:
                 if (bit64)
                     return FWK_E_DATA;
 
-                unum = va_arg(*args, uint32_t);
+                status = get_arg_uint32(ctx, &value);
+                if (status != FWK_SUCCESS)
+                    return status;
+                if (!output)
+                    break;
+                unum = value;
 
-                status = print_uint64(unum, 10, fill);
+                status = print_uint64(ctx, unum, 10, fill);
                 if (status != FWK_SUCCESS)
                     return status;
                 break;
@@ -222,14 +497,187 @@ next_symbol:
             fmt++;
             continue;
         }
-        status = do_putchar(*fmt++);
-        if (status != FWK_SUCCESS)
-            return status;
+        if (output) {
+            status = do_putchar(ctx, *fmt);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+        fmt++;
     }
 
     return FWK_SUCCESS;
 }
 
+static int do_print(const char *fmt, struct print_ctx *ctx)
+{
+    int status;
+    int write_status;
+
+    status = format(fmt, ctx);
+
+    /* Write the characters formatted before any error */
+    write_status = write_buffered(ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return write_status;
+}
+
+static int print_direct(const char *fmt, ...)
+{
+    int status;
+    va_list args;
+    struct print_ctx ctx = {
+        .mode = PRINT_MODE_OUTPUT,
+        .args = &args,
+    };
+
+    va_start(args, fmt);
+    status = do_print(fmt, &ctx);
+    va_end(args);
+
+    return status;
+}
+
+static int put_drain_event(void)
+{
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_LOG, MOD_LOG_EVENT_IDX_DRAIN),
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+/*
+ * Append the record of a log call to the ring. The record is dropped when the
+ * ring does not have enough free space for it.
+ */
+static int record_log(const char *fmt, va_list *args)
+{
+    int status;
+    uint32_t length = 0;
+    bool drain;
+    struct print_ctx ctx = {
+        .mode = PRINT_MODE_RECORD,
+        .args = args,
+    };
+
+    fwk_interrupt_global_disable();
+
+    ctx.offset = ring.head;
+    status = ring_write(&ctx, &fmt, sizeof(fmt));
+    if (status == FWK_SUCCESS)
+        status = ring_write(&ctx, &length, sizeof(length));
+    if (status == FWK_SUCCESS)
+        status = do_print(fmt, &ctx);
+
+    if (status == FWK_SUCCESS) {
+        /* Complete the header and commit the record */
+        length = ctx.length;
+        ring_copy_to((ring.head + sizeof(fmt)) % ring.size, &length,
+                     sizeof(length));
+        ring.head = ctx.offset;
+        ring.used += ctx.length;
+    } else if (status == FWK_E_NOMEM)
+        ring.dropped_count++;
+
+    drain = ring.started && !ring.drain_pending;
+    if (drain)
+        ring.drain_pending = true;
+
+    fwk_interrupt_global_enable();
+
+    if (drain && (put_drain_event() != FWK_SUCCESS))
+        ring.drain_pending = false;
+
+    return status;
+}
+
+/* Format the oldest record of the ring and write it to the device */
+static int drain_record(void)
+{
+    int status;
+    const char *fmt;
+    uint32_t length;
+    struct print_ctx ctx = {
+        .mode = PRINT_MODE_REPLAY,
+        .offset = ring.tail,
+    };
+
+    ring_read(&ctx, &fmt, sizeof(fmt));
+    ring_read(&ctx, &length, sizeof(length));
+
+    status = do_print(fmt, &ctx);
+
+    /* The record is released even if it could not be written entirely */
+    fwk_interrupt_global_disable();
+    ring.tail = (ring.tail + length) % ring.size;
+    ring.used -= length;
+    fwk_interrupt_global_enable();
+
+    return status;
+}
+
+/*
+ * Format up to 'count' records of the ring. Once the ring is empty, the number
+ * of records dropped since the last report is logged.
+ */
+static int drain_ring(unsigned int count)
+{
+    int status = FWK_SUCCESS;
+    unsigned int dropped_count = 0;
+
+    fwk_interrupt_global_disable();
+    if (ring.draining) {
+        /* The ring is already being drained, from a preempted context */
+        fwk_interrupt_global_enable();
+        return FWK_SUCCESS;
+    }
+    ring.draining = true;
+    fwk_interrupt_global_enable();
+
+    while ((count-- > 0) && (ring.used > 0)) {
+        status = drain_record();
+        if (status != FWK_SUCCESS)
+            goto exit;
+    }
+
+    fwk_interrupt_global_disable();
+    if (ring.used == 0) {
+        dropped_count = ring.dropped_count;
+        ring.dropped_count = 0;
+    }
+    fwk_interrupt_global_enable();
+
+    if (dropped_count > 0)
+        status = print_direct("[LOG] %u messages dropped\n", dropped_count);
+
+exit:
+    ring.draining = false;
+
+    return status;
+}
+
+static int process_drain_event(void)
+{
+    int status;
+    bool drain;
+
+    status = drain_ring(DRAIN_RECORD_COUNT);
+
+    fwk_interrupt_global_disable();
+    drain = (ring.used > 0) || (ring.dropped_count > 0);
+    ring.drain_pending = drain;
+    fwk_interrupt_global_enable();
+
+    if (drain && (put_drain_event() != FWK_SUCCESS))
+        ring.drain_pending = false;
+
+    return status;
+}
+
 static bool is_valid_group(unsigned int group)
 {
     /* Check if group is 'none' */
@@ -244,6 +692,152 @@ static bool is_valid_group(unsigned int group)
     return !(group & (group - 1));
 }
 
+/*
+ * Get the current time in microseconds. Returns false when the time is not
+ * available.
+ */
+static bool get_time(uint64_t *time)
+{
+    #if BUILD_HAS_MOD_TIMER
+    if (timer_api == NULL)
+        return false;
+
+    return (timer_api->get_time(log_config->rate_limit_timer_id, time) ==
+            FWK_SUCCESS);
+    #else
+    return false;
+    #endif
+}
+
+/* Add the tokens earned by a bucket since its last refill */
+static void refill_bucket(struct rate_limit_entry *entry, uint64_t now)
+{
+    uint64_t period = (uint64_t)log_config->rate_limit_period_ms * 1000;
+    uint64_t count;
+
+    /* The time may have been read before that of a preempting log call */
+    if (now <= entry->refill_time)
+        return;
+
+    count = (now - entry->refill_time) / period;
+    if ((entry->tokens + count) >= log_config->rate_limit_burst) {
+        entry->tokens = log_config->rate_limit_burst;
+        entry->refill_time = now;
+    } else {
+        entry->tokens += (unsigned int)count;
+        entry->refill_time += count * period;
+    }
+}
+
+/*
+ * Get the entry of a format string, or take an entry for it: an unused entry
+ * or one whose bucket is full and with no suppressed message to report. NULL
+ * when all the entries are in use.
+ */
+static struct rate_limit_entry *get_rate_limit_entry(const char *fmt,
+                                                     uint64_t now)
+{
+    struct rate_limit_entry *entry;
+    struct rate_limit_entry *free_entry = NULL;
+    unsigned int idx;
+
+    for (idx = 0; idx < log_config->rate_limit_entry_count; idx++) {
+        entry = &rate_limit_table[idx];
+        if (entry->fmt == fmt)
+            return entry;
+
+        if (free_entry != NULL)
+            continue;
+
+        if (entry->fmt != NULL) {
+            refill_bucket(entry, now);
+            if ((entry->tokens < log_config->rate_limit_burst) ||
+                (entry->suppressed_count > 0))
+                continue;
+        }
+
+        free_entry = entry;
+    }
+
+    if (free_entry != NULL) {
+        *free_entry = (struct rate_limit_entry) {
+            .fmt = fmt,
+            .tokens = log_config->rate_limit_burst,
+            .refill_time = now,
+        };
+    }
+
+    return free_entry;
+}
+
+/*
+ * Apply the rate limit of a message. Returns false when the message is
+ * suppressed, otherwise gives the number of messages suppressed before it.
+ */
+static bool check_rate_limit(enum mod_log_group group, const char *fmt,
+                             unsigned int *suppressed_count)
+{
+    struct rate_limit_entry *entry;
+    uint64_t now;
+    bool allowed = true;
+
+    *suppressed_count = 0;
+
+    if ((rate_limit_table == NULL) ||
+        ((group & log_config->rate_limit_groups) == 0))
+        return true;
+
+    if (!get_time(&now))
+        return true;
+
+    fwk_interrupt_global_disable();
+
+    entry = get_rate_limit_entry(fmt, now);
+    if (entry != NULL) {
+        refill_bucket(entry, now);
+        if (entry->tokens > 0) {
+            entry->tokens--;
+            *suppressed_count = entry->suppressed_count;
+            entry->suppressed_count = 0;
+        } else {
+            entry->suppressed_count++;
+            allowed = false;
+        }
+    }
+
+    fwk_interrupt_global_enable();
+
+    return allowed;
+}
+
+/* Record or write a message, depending on whether the messages are deferred */
+static int output_log(const char *fmt, va_list *args)
+{
+    struct print_ctx ctx;
+
+    if (ring.buffer != NULL)
+        return record_log(fmt, args);
+
+    ctx = (struct print_ctx) {
+        .mode = PRINT_MODE_OUTPUT,
+        .args = args,
+    };
+
+    return do_print(fmt, &ctx);
+}
+
+static int output_log_args(const char *fmt, ...)
+{
+    int status;
+    va_list args;
+
+    va_start(args, fmt);
+    status = output_log(fmt, &args);
+    va_end(args);
+
+    return status;
+}
+
 /*
  * Module API
  */
@@ -252,6 +846,7 @@ static int do_log(enum mod_log_group group, const char *fmt, ...)
 {
     int status;
     va_list args;
+    unsigned int suppressed_count;
 
     /* API called too early */
     if (log_driver == NULL)
@@ -267,9 +862,19 @@ static int do_log(enum mod_log_group group, const char *fmt, ...)
     if (fmt == NULL)
         return FWK_E_PARAM;
 
-    if (group & log_config->log_groups) {
+    if (group & log_config->log_groups & MOD_LOG_GROUPS_BUILT_IN) {
+        if (!check_rate_limit(group, fmt, &suppressed_count))
+            return FWK_SUCCESS;
+
+        if (suppressed_count > 0) {
+            status = output_log_args("[LOG] Next message suppressed %u times\n",
+                                     suppressed_count);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
         va_start(args, fmt);
-        status = do_print(fmt, &args);
+        status = output_log(fmt, &args);
         va_end(args);
 
         if (status != FWK_SUCCESS)
@@ -291,6 +896,12 @@ static int do_flush(void)
     if (status != FWK_SUCCESS)
         return status;
 
+    if (ring.buffer != NULL) {
+        status = drain_ring(UINT_MAX);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     status = log_driver->flush(log_config->device_id);
     if (status != FWK_SUCCESS)
         return FWK_E_DEVICE;
@@ -298,9 +909,215 @@ static int do_flush(void)
     return FWK_SUCCESS;
 }
 
-static const struct mod_log_api module_api = {
+#ifdef BUILD_HAS_EVENT_PROFILING
+static int log_profile_stats(const struct fwk_thread_profile_stats *stats)
+{
+    int status;
+    unsigned int bin;
+
+    status = do_log(MOD_LOG_GROUP_INFO, ": count %u avg %u max %u histogram",
+                    stats->count, (uint32_t)(stats->total / stats->count),
+                    stats->max);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (bin = 0; bin < FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT; bin++) {
+        status = do_log(MOD_LOG_GROUP_INFO, " %u", stats->histogram[bin]);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return do_log(MOD_LOG_GROUP_INFO, "\n");
+}
+
+static int log_module_profile(unsigned int module_idx)
+{
+    int status;
+    fwk_id_t module_id = FWK_ID_MODULE(module_idx);
+    struct fwk_thread_profile_stats stats;
+    unsigned int idx;
+
+    status = fwk_thread_get_profile_stats(module_id, &stats);
+    if ((status != FWK_SUCCESS) || (stats.count == 0))
+        return FWK_SUCCESS;
+
+    status = do_log(MOD_LOG_GROUP_INFO, "[PROFILE] %s",
+                    fwk_module_get_name(module_id));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = log_profile_stats(&stats);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_thread_get_queue_stats(module_id, &stats);
+    if ((status == FWK_SUCCESS) && (stats.count != 0)) {
+        status = do_log(MOD_LOG_GROUP_INFO, "[PROFILE]     queue");
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = log_profile_stats(&stats);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    for (idx = 0; fwk_module_is_valid_event_id(FWK_ID_EVENT(module_idx, idx));
+         idx++) {
+        status = fwk_thread_get_profile_stats(FWK_ID_EVENT(module_idx, idx),
+                                              &stats);
+        if ((status != FWK_SUCCESS) || (stats.count == 0))
+            continue;
+
+        status = do_log(MOD_LOG_GROUP_INFO, "[PROFILE]     event %u", idx);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = log_profile_stats(&stats);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    for (idx = 0;
+         fwk_module_is_valid_notification_id(
+             FWK_ID_NOTIFICATION(module_idx, idx));
+         idx++) {
+        status = fwk_thread_get_profile_stats(
+            FWK_ID_NOTIFICATION(module_idx, idx), &stats);
+        if ((status != FWK_SUCCESS) || (stats.count == 0))
+            continue;
+
+        status = do_log(MOD_LOG_GROUP_INFO, "[PROFILE]     notification %u",
+                        idx);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = log_profile_stats(&stats);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+#endif
+
+static int do_log_event_profile(void)
+{
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    int status;
+    unsigned int module_idx;
+
+    /* API called too early */
+    if (log_driver == NULL)
+        return FWK_E_STATE;
+
+    status = fwk_module_check_call(FWK_ID_MODULE(FWK_MODULE_IDX_LOG));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (module_idx = 0;
+         fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+         module_idx++) {
+        status = log_module_profile(module_idx);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+    #else
+    return FWK_E_SUPPORT;
+    #endif
+}
+
+static int do_log_heap_usage(void)
+{
+    int status;
+    struct fwk_mm_stats stats;
+    unsigned int module_idx;
+    fwk_id_t module_id;
+    size_t usage;
+
+    /* API called too early */
+    if (log_driver == NULL)
+        return FWK_E_STATE;
+
+    status = fwk_module_check_call(FWK_ID_MODULE(FWK_MODULE_IDX_LOG));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_mm_get_stats(&stats);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = do_log(MOD_LOG_GROUP_INFO, "[HEAP] %u of %u bytes used\n",
+                    (unsigned int)stats.used, (unsigned int)stats.size);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (module_idx = 0;
+         fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+         module_idx++) {
+        module_id = FWK_ID_MODULE(module_idx);
+
+        status = fwk_module_get_heap_usage(module_id, &usage);
+        if ((status != FWK_SUCCESS) || (usage == 0))
+            continue;
+
+        status = do_log(MOD_LOG_GROUP_INFO, "[HEAP]     %s: %u\n",
+                        fwk_module_get_name(module_id), (unsigned int)usage);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int do_log_boot_time(void)
+{
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    int status;
+    unsigned int module_idx;
+    fwk_id_t module_id;
+    struct fwk_module_boot_time time;
+
+    /* API called too early */
+    if (log_driver == NULL)
+        return FWK_E_STATE;
+
+    status = fwk_module_check_call(FWK_ID_MODULE(FWK_MODULE_IDX_LOG));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (module_idx = 0;
+         fwk_module_is_valid_module_id(FWK_ID_MODULE(module_idx));
+         module_idx++) {
+        module_id = FWK_ID_MODULE(module_idx);
+
+        status = fwk_module_get_boot_time(module_id, &time);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = do_log(MOD_LOG_GROUP_INFO,
+                        "[BOOT] %s: init %u element_init %u post_init %u "
+                        "bind %u %u start %u\n",
+                        fwk_module_get_name(module_id), time.init,
+                        time.element_init, time.post_init, time.bind[0],
+                        time.bind[1], time.start);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+    #else
+    return FWK_E_SUPPORT;
+    #endif
+}
+
+const struct mod_log_api mod_log_module_api = {
     .log = do_log,
     .flush = do_flush,
+    .log_event_profile = do_log_event_profile,
+    .log_heap_usage = do_log_heap_usage,
+    .log_boot_time = do_log_boot_time,
 };
 
 /*
@@ -319,6 +1136,39 @@ static int log_init(fwk_id_t module_id, unsigned int element_count,
     if (config->log_groups & ~ALL_GROUPS_MASK)
         return FWK_E_PARAM;
 
+    if (config->deferred_buffer_size > 0) {
+        /* The buffer must at least be able to hold a record without argument */
+        if (config->deferred_buffer_size < RECORD_HEADER_SIZE)
+            return FWK_E_PARAM;
+
+        if (config->deferred_buffer_address != 0)
+            ring.buffer = (uint8_t *)config->deferred_buffer_address;
+        else {
+            ring.buffer = fwk_mm_alloc(config->deferred_buffer_size, 1);
+            if (ring.buffer == NULL)
+                return FWK_E_NOMEM;
+        }
+
+        ring.size = config->deferred_buffer_size;
+    }
+
+    if (config->rate_limit_groups != 0) {
+        #if BUILD_HAS_MOD_TIMER
+        if ((config->rate_limit_groups & ~ALL_GROUPS_MASK) ||
+            (config->rate_limit_entry_count == 0) ||
+            (config->rate_limit_burst == 0) ||
+            (config->rate_limit_period_ms == 0))
+            return FWK_E_PARAM;
+
+        rate_limit_table = fwk_mm_calloc(config->rate_limit_entry_count,
+                                         sizeof(rate_limit_table[0]));
+        if (rate_limit_table == NULL)
+            return FWK_E_NOMEM;
+        #else
+        return FWK_E_SUPPORT;
+        #endif
+    }
+
     log_config = config;
 
     return FWK_SUCCESS;
@@ -348,6 +1198,15 @@ static int log_bind(fwk_id_t id, unsigned int round)
 
     log_driver = driver;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (rate_limit_table != NULL) {
+        status = fwk_module_bind(log_config->rate_limit_timer_id,
+                                 MOD_TIMER_API_ID_TIMER, &timer_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_HANDLER;
+    }
+    #endif
+
     if (log_config->banner) {
         status = do_log(MOD_LOG_GROUP_INFO, log_config->banner);
         if (status != FWK_SUCCESS)
@@ -361,20 +1220,85 @@ static int log_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+static int log_start(fwk_id_t id)
+{
+    int status;
+    struct fwk_event event;
+
+    /*
+     * The summaries are logged when the events are processed, once all the
+     * modules have been started and the pre-runtime phase is complete.
+     */
+    event = (struct fwk_event) {
+        .source_id = id,
+        .target_id = id,
+    };
+
+    if (ring.buffer != NULL) {
+        /* Drain the records logged during the pre-runtime phase */
+        ring.started = true;
+        ring.drain_pending = true;
+
+        event.id = FWK_ID_EVENT(FWK_MODULE_IDX_LOG, MOD_LOG_EVENT_IDX_DRAIN);
+        status = fwk_thread_put_event(&event);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (log_config->heap_usage_summary) {
+        event.id = FWK_ID_EVENT(FWK_MODULE_IDX_LOG,
+                                MOD_LOG_EVENT_IDX_HEAP_SUMMARY);
+        status = fwk_thread_put_event(&event);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (log_config->boot_time_summary) {
+        event.id = FWK_ID_EVENT(FWK_MODULE_IDX_LOG,
+                                MOD_LOG_EVENT_IDX_BOOT_TIME_SUMMARY);
+        status = fwk_thread_put_event(&event);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int log_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
     fwk_id_t api_id, const void **api)
 {
-    *api = &module_api;
+    *api = &mod_log_module_api;
 
     return FWK_SUCCESS;
 }
 
+static int log_process_event(const struct fwk_event *event,
+                             struct fwk_event *resp_event)
+{
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_LOG_EVENT_IDX_HEAP_SUMMARY:
+        return do_log_heap_usage();
+
+    case MOD_LOG_EVENT_IDX_BOOT_TIME_SUMMARY:
+        return do_log_boot_time();
+
+    case MOD_LOG_EVENT_IDX_DRAIN:
+        return process_drain_event();
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 /* Module descriptor */
 const struct fwk_module module_log = {
     .name = "Log",
     .type = FWK_MODULE_TYPE_HAL,
     .api_count = 1,
+    .event_count = MOD_LOG_EVENT_IDX_COUNT,
     .init = log_init,
     .bind = log_bind,
+    .start = log_start,
     .process_bind_request = log_process_bind_request,
+    .process_event = log_process_event,
 };
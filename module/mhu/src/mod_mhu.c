@@ -58,46 +58,34 @@ struct mhu_ctx {
 
 static struct mhu_ctx mhu_ctx;
 
-static void mhu_isr(void)
+static void mhu_isr(uintptr_t ctx_ptr)
 {
-    int status;
-    unsigned int interrupt;
-    unsigned int device_idx;
-    struct mhu_device_ctx *device_ctx;
+    struct mhu_device_ctx *device_ctx = (struct mhu_device_ctx *)ctx_ptr;
     struct mhu_reg *reg;
+    uint32_t pending, signaled;
     unsigned int slot;
     struct mhu_smt_channel *smt_channel;
 
-    status = fwk_interrupt_get_current(&interrupt);
-    if (status != FWK_SUCCESS)
-        return;
-
-    for (device_idx = 0; device_idx < mhu_ctx.device_count; device_idx++) {
-        device_ctx = &mhu_ctx.device_ctx_table[device_idx];
-        if (device_ctx->config->irq == interrupt)
-            break;
-    }
-
-    if (device_idx >= mhu_ctx.device_count)
-        return;
-
     reg = (struct mhu_reg *)device_ctx->config->in;
 
-    /* Loop over all the slots */
-    while (reg->STAT != 0) {
-        slot = __builtin_ctz(reg->STAT);
+    /*
+     * The status register is read once per pass and all the slots set in the
+     * snapshot are serviced before being acknowledged with a single write. The
+     * register is read again for the slots signaled in the meantime.
+     */
+    while ((pending = reg->STAT) != 0) {
+        signaled = pending & device_ctx->bound_slots;
+
+        while (signaled != 0) {
+            slot = 31 - __builtin_clz(signaled);
+            signaled &= ~(UINT32_C(1) << slot);
 
-        /*
-         * If the slot is bound to an SMT channel, signal the message to the
-         * SMT channel.
-         */
-        if (device_ctx->bound_slots & (1 << slot)) {
             smt_channel = &device_ctx->smt_channel_table[slot];
             smt_channel->api->signal_message(smt_channel->id);
         }
 
-        /* Acknowledge the interrupt */
-        reg->CLEAR = 1 << slot;
+        /* Acknowledge the interrupts */
+        reg->CLEAR = pending;
     }
 }
 
@@ -187,8 +175,10 @@ static int mhu_bind(fwk_id_t id, unsigned int round)
 
             smt_channel = &device_ctx->smt_channel_table[slot];
 
+            /* Bind back to the transport, SMT or compatible, of the slot */
             status = fwk_module_bind(smt_channel->id,
-                FWK_ID_API(FWK_MODULE_IDX_SMT, MOD_SMT_API_IDX_DRIVER_INPUT),
+                fwk_id_build_api_id(smt_channel->id,
+                                    MOD_SMT_API_IDX_DRIVER_INPUT),
                 &smt_channel->api);
             if (status != FWK_SUCCESS)
                 return status;
@@ -232,7 +222,8 @@ static int mhu_start(fwk_id_t id)
     device_ctx = &mhu_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
 
     if (device_ctx->bound_slots != 0) {
-        status = fwk_interrupt_set_isr(device_ctx->config->irq, &mhu_isr);
+        status = fwk_interrupt_set_isr_param(device_ctx->config->irq,
+                                             &mhu_isr, (uintptr_t)device_ctx);
         if (status != FWK_SUCCESS)
             return status;
         status = fwk_interrupt_enable(device_ctx->config->irq);
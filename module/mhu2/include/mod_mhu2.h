@@ -11,6 +11,7 @@
 #ifndef MOD_MHU2_H
 #define MOD_MHU2_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <fwk_macros.h>
 
@@ -30,6 +31,8 @@
 enum mod_mhu2_api_idx {
     /*! SMT driver API */
     MOD_MHU2_API_IDX_SMT_DRIVER,
+    /*! SCMI transport API, register transport mode only */
+    MOD_MHU2_API_IDX_SCMI_TRANSPORT,
     /*! Number of APIs */
     MOD_MHU2_API_IDX_COUNT,
 };
@@ -53,8 +56,38 @@ struct mod_mhu2_channel_config {
 
     /*! Channel number */
     unsigned int channel;
+
+    /*!
+     * \brief Number of channel windows carrying a message in the register
+     *      transport mode, zero in the doorbell mode.
+     *
+     * \details In the doorbell mode, each bit of the channel rings the SMT
+     *      channel bound to the slot of the same index. In the register
+     *      transport mode, the device is an SCMI transport and the SCMI
+     *      messages travel in the channel windows \ref channel to
+     *      \ref channel + \ref window_count - 1 of the MHU in each direction,
+     *      one 32-bit word per window. The first windows hold the message
+     *      header followed by the payload, and the last window holds the
+     *      length of the message in bytes. The last window is written last and
+     *      is the only window raising the interrupt of the receiver.
+     *
+     *      A window count of \ref MOD_MHU2_WINDOW_COUNT_MAX allows for
+     *      payloads of up to 7 words, enough for the short messages such as
+     *      performance level and clock rate requests. The window count must
+     *      be at least 2.
+     */
+    unsigned int window_count;
+
+    /*! Secure channel flag, register transport mode only */
+    bool secure;
 };
 
+/*!
+ * \brief Maximum number of channel windows of a device in the register
+ *      transport mode.
+ */
+#define MOD_MHU2_WINDOW_COUNT_MAX 9
+
 /*!
  * @}
  */
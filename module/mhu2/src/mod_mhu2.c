@@ -8,8 +8,10 @@
  *      Message Handling Unit (MHU) v2 Device Driver.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
@@ -20,9 +22,15 @@
 #include <mod_mhu2.h>
 #include <mhu2.h>
 #include <mod_smt.h>
+#if BUILD_HAS_MOD_SCMI
+#include <mod_scmi.h>
+#endif
 
 #define MHU_SLOT_COUNT_MAX 32
 
+/* Number of words of a message in the register transport mode */
+#define MHU_MESSAGE_WORD_COUNT_MAX (MOD_MHU2_WINDOW_COUNT_MAX - 1)
+
 struct mhu2_smt_channel {
     fwk_id_t id;
     const struct mod_smt_driver_input_api *api;
@@ -48,6 +56,26 @@ struct mhu2_channel_ctx {
 
     /* Table of SMT channels bound to the channel */
     struct mhu2_smt_channel *smt_channel_table;
+
+    #if BUILD_HAS_MOD_SCMI
+    /* SCMI service bound to the channel (register transport mode) */
+    fwk_id_t scmi_service_id;
+
+    /* SCMI service API (register transport mode) */
+    const struct mod_scmi_from_transport_api *scmi_api;
+
+    /* Message being processed flag (register transport mode) */
+    volatile bool locked;
+
+    /* Length in bytes of the message being processed, header included */
+    size_t in_length;
+
+    /* Message header and payload read from the receive windows */
+    uint32_t in_words[MHU_MESSAGE_WORD_COUNT_MAX];
+
+    /* Response header and payload to write to the send windows */
+    uint32_t out_words[MHU_MESSAGE_WORD_COUNT_MAX];
+    #endif
 };
 
 /* MHU v2 context */
@@ -59,6 +87,258 @@ static struct mhu2_ctx {
     unsigned int channel_count;
 } ctx;
 
+#if BUILD_HAS_MOD_SCMI
+/*
+ * SCMI transport API (register transport mode)
+ */
+
+static size_t get_max_payload_size(const struct mhu2_channel_ctx *channel_ctx)
+{
+    /* The last window holds the length and the first one the header */
+    return (channel_ctx->config->window_count - 2) * sizeof(uint32_t);
+}
+
+static int mhu2_get_secure(fwk_id_t channel_id, bool *secure)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (secure == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    *secure = channel_ctx->config->secure;
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_get_max_payload_size(fwk_id_t channel_id, size_t *size)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (size == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    *size = get_max_payload_size(channel_ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_get_message_header(fwk_id_t channel_id, uint32_t *header)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (header == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *header = channel_ctx->in_words[0];
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_get_payload(fwk_id_t channel_id, const void **payload,
+                            size_t *size)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (payload == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *payload = &channel_ctx->in_words[1];
+
+    if (size != NULL)
+        *size = channel_ctx->in_length - sizeof(channel_ctx->in_words[0]);
+
+    return FWK_SUCCESS;
+}
+
+static int mhu2_write_payload(fwk_id_t channel_id, size_t offset,
+                              const void *payload, size_t size)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+    size_t max_payload_size;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+    max_payload_size = get_max_payload_size(channel_ctx);
+
+    if ((payload == NULL) || (offset > max_payload_size) ||
+        (size > (max_payload_size - offset)))
+        return FWK_E_PARAM;
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    memcpy((uint8_t *)&channel_ctx->out_words[1] + offset, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+static int respond(struct mhu2_channel_ctx *channel_ctx, const void *payload,
+                   size_t size)
+{
+    int status = FWK_SUCCESS;
+    struct mhu2_send_channel_reg *window;
+    unsigned int word_count, word_idx;
+
+    /*
+     * A response that does not fit in the windows is replaced by an error
+     * response. The agent would otherwise never get a response.
+     */
+    if (size > get_max_payload_size(channel_ctx)) {
+        channel_ctx->out_words[1] = (uint32_t)SCMI_GENERIC_ERROR;
+        payload = NULL;
+        size = sizeof(int32_t);
+        status = FWK_E_PARAM;
+    }
+
+    if (payload != NULL)
+        memcpy(&channel_ctx->out_words[1], payload, size);
+
+    channel_ctx->out_words[0] = channel_ctx->in_words[0];
+    word_count = 1 + ((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+
+    window = channel_ctx->send_channel;
+
+    /* Turn on receiver */
+    channel_ctx->send->ACCESS_REQUEST = 1;
+    while (channel_ctx->send->ACCESS_READY != 1)
+        continue;
+
+    for (word_idx = 0; word_idx < word_count; word_idx++)
+        window[word_idx].STAT_SET = channel_ctx->out_words[word_idx];
+
+    channel_ctx->locked = false;
+
+    /* The length is written last, raising the interrupt of the agent */
+    window[channel_ctx->config->window_count - 1].STAT_SET =
+        sizeof(uint32_t) + size;
+
+    /* Signal that the receiver is no longer needed */
+    channel_ctx->send->ACCESS_REQUEST = 0;
+
+    return status;
+}
+
+static int mhu2_respond(fwk_id_t channel_id, const void *payload, size_t size)
+{
+    int status;
+    struct mhu2_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    return respond(channel_ctx, payload, size);
+}
+
+static int mhu2_transmit(fwk_id_t channel_id, uint32_t message_header,
+                         const void *payload, size_t size)
+{
+    /* Register transport channels are agent-to-platform channels only */
+    return FWK_E_SUPPORT;
+}
+
+static const struct mod_scmi_to_transport_api mhu2_mod_scmi_to_transport_api = {
+    .get_secure = mhu2_get_secure,
+    .get_max_payload_size = mhu2_get_max_payload_size,
+    .get_message_header = mhu2_get_message_header,
+    .get_payload = mhu2_get_payload,
+    .write_payload = mhu2_write_payload,
+    .respond = mhu2_respond,
+    .transmit = mhu2_transmit,
+};
+
+/*
+ * Read a message from the receive windows and let the SCMI service process
+ * it. The length window is acknowledged last.
+ */
+static void mhu2_register_transport_isr(struct mhu2_channel_ctx *channel_ctx)
+{
+    struct mhu2_recv_channel_reg *window = channel_ctx->recv_channel;
+    unsigned int length_idx = channel_ctx->config->window_count - 1;
+    unsigned int word_count, word_idx;
+    uint32_t length;
+
+    length = window[length_idx].STAT;
+    if (length == 0)
+        return;
+
+    /* The agent sent a message before the response to the previous one */
+    if (channel_ctx->locked) {
+        window[length_idx].STAT_CLEAR = length;
+        return;
+    }
+
+    channel_ctx->locked = true;
+
+    word_count = (length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    if (word_count > length_idx)
+        word_count = length_idx;
+
+    for (word_idx = 0; word_idx < word_count; word_idx++) {
+        channel_ctx->in_words[word_idx] = window[word_idx].STAT;
+        window[word_idx].STAT_CLEAR = channel_ctx->in_words[word_idx];
+    }
+
+    window[length_idx].STAT_CLEAR = length;
+
+    if ((length < sizeof(uint32_t)) ||
+        (length > (length_idx * sizeof(uint32_t)))) {
+        if (length < sizeof(uint32_t))
+            channel_ctx->in_words[0] = 0;
+        respond(channel_ctx, &(int32_t) { SCMI_PROTOCOL_ERROR },
+                sizeof(int32_t));
+        return;
+    }
+
+    channel_ctx->in_length = length;
+
+    channel_ctx->scmi_api->signal_message(channel_ctx->scmi_service_id);
+}
+#endif
+
 static void mhu2_isr(uintptr_t ctx_param)
 {
     struct mhu2_channel_ctx *channel_ctx = (struct mhu2_channel_ctx *)ctx_param;
@@ -67,6 +347,13 @@ static void mhu2_isr(uintptr_t ctx_param)
 
     assert(channel_ctx != NULL);
 
+    #if BUILD_HAS_MOD_SCMI
+    if (channel_ctx->config->window_count != 0) {
+        mhu2_register_transport_isr(channel_ctx);
+        return;
+    }
+    #endif
+
     while (channel_ctx->recv_channel->STAT != 0) {
         slot = __builtin_ctz(channel_ctx->recv_channel->STAT);
 
@@ -168,12 +455,37 @@ static int mhu2_channel_init(fwk_id_t channel_id,
         return FWK_E_DATA;
     }
 
+    if (config->window_count != 0) {
+        #if BUILD_HAS_MOD_SCMI
+        if ((config->window_count < 2) ||
+            (config->window_count > MOD_MHU2_WINDOW_COUNT_MAX) ||
+            ((config->channel + config->window_count) >
+             channel_ctx->send->MSG_NO_CAP)) {
+            assert(false);
+            return FWK_E_DATA;
+        }
+        #else
+        /* The register transport mode is an SCMI transport */
+        assert(false);
+        return FWK_E_SUPPORT;
+        #endif
+    }
+
     channel_ctx->config = config;
     channel_ctx->slot_count = slot_count;
     channel_ctx->send_channel = &channel_ctx->send->channel[config->channel];
     recv_reg = (struct mhu2_recv_reg *)config->recv;
     channel_ctx->recv_channel = &recv_reg->channel[config->channel];
 
+    /* Only the length window raises the interrupt in register mode */
+    if (config->window_count != 0) {
+        for (unsigned int window_idx = 0;
+             window_idx < (config->window_count - 1); window_idx++)
+            channel_ctx->recv_channel[window_idx].MASK_SET = UINT32_MAX;
+
+        return FWK_SUCCESS;
+    }
+
     channel_ctx->smt_channel_table =
         fwk_mm_calloc(slot_count, sizeof(channel_ctx->smt_channel_table[0]));
     if (channel_ctx->smt_channel_table == NULL) {
@@ -200,9 +512,10 @@ static int mhu2_bind(fwk_id_t id, unsigned int round)
 
             smt_channel = &channel_ctx->smt_channel_table[slot];
 
+            /* Bind back to the transport, SMT or compatible, of the slot */
             status = fwk_module_bind(smt_channel->id,
-                                     FWK_ID_API(FWK_MODULE_IDX_SMT,
-                                                MOD_SMT_API_IDX_DRIVER_INPUT),
+                                     fwk_id_build_api_id(smt_channel->id,
+                                         MOD_SMT_API_IDX_DRIVER_INPUT),
                                      &smt_channel->api);
             if (status != FWK_SUCCESS) {
                 /* Unable to bind back to SMT channel */
@@ -210,6 +523,21 @@ static int mhu2_bind(fwk_id_t id, unsigned int round)
                 return status;
             }
         }
+
+        #if BUILD_HAS_MOD_SCMI
+        if (fwk_id_is_type(channel_ctx->scmi_service_id,
+                           FWK_ID_TYPE_ELEMENT)) {
+            status = fwk_module_bind(channel_ctx->scmi_service_id,
+                                     FWK_ID_API(FWK_MODULE_IDX_SCMI,
+                                                MOD_SCMI_API_IDX_TRANSPORT),
+                                     &channel_ctx->scmi_api);
+            if (status != FWK_SUCCESS) {
+                /* Unable to bind back to SCMI service */
+                assert(false);
+                return status;
+            }
+        }
+        #endif
     }
 
     return FWK_SUCCESS;
@@ -223,6 +551,30 @@ static int mhu2_process_bind_request(fwk_id_t source_id,
     struct mhu2_channel_ctx *channel_ctx;
     unsigned int slot;
 
+    #if BUILD_HAS_MOD_SCMI
+    if (fwk_id_get_api_idx(api_id) == MOD_MHU2_API_IDX_SCMI_TRANSPORT) {
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT)) {
+            assert(false);
+            return FWK_E_ACCESS;
+        }
+
+        channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(target_id)];
+
+        /* Only a channel in register transport mode has the API */
+        if ((channel_ctx->config->window_count == 0) ||
+            fwk_id_is_type(channel_ctx->scmi_service_id, FWK_ID_TYPE_ELEMENT)) {
+            assert(false);
+            return FWK_E_ACCESS;
+        }
+
+        channel_ctx->scmi_service_id = source_id;
+
+        *api = &mhu2_mod_scmi_to_transport_api;
+
+        return FWK_SUCCESS;
+    }
+    #endif
+
     if (!fwk_id_is_type(target_id, FWK_ID_TYPE_SUB_ELEMENT)) {
         /*
          * Something tried to bind to the module or an element. Only binding to
@@ -235,7 +587,8 @@ static int mhu2_process_bind_request(fwk_id_t source_id,
     channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(target_id)];
     slot = fwk_id_get_sub_element_idx(target_id);
 
-    if (channel_ctx->bound_slots & (1 << slot)) {
+    if ((channel_ctx->config->window_count != 0) ||
+        (channel_ctx->bound_slots & (1 << slot))) {
         /* Something tried to bind to a slot that has already been bound to */
         assert(false);
         return FWK_E_ACCESS;
@@ -259,7 +612,11 @@ static int mhu2_start(fwk_id_t id)
 
     channel_ctx = &ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
 
-    if (channel_ctx->bound_slots != 0) {
+    if ((channel_ctx->bound_slots != 0)
+        #if BUILD_HAS_MOD_SCMI
+        || (channel_ctx->scmi_api != NULL)
+        #endif
+        ) {
         status = fwk_interrupt_set_isr_param(channel_ctx->config->irq,
                                              &mhu2_isr,
                                              (uintptr_t)channel_ctx);
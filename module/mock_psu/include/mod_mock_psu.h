@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <fwk_id.h>
 #include <fwk_module_idx.h>
 
 /*!
@@ -25,6 +26,13 @@
 
 /*!
  * \brief Element configuration.
+ *
+ * \details A mock device completes its requests immediately unless an alarm
+ *      is configured. It then models the transitions of a real supply: the
+ *      output voltage ramps at the slew rate and settles, the enabled state
+ *      changes once settled, and the completion of each request is reported
+ *      asynchronously to the PSU HAL from the alarm. Failures can be injected
+ *      to exercise the error paths of the consumers.
  */
 struct mod_mock_psu_device_config {
     /*! Default state of the mock device's supply (enabled or disabled) */
@@ -32,6 +40,42 @@ struct mod_mock_psu_device_config {
 
     /*! Default voltage, in millivolts (mV), of the device's supply */
     uint64_t default_voltage;
+
+    /*!
+     * \brief Identifier of the alarm timing the transitions of the device.
+     *
+     * \details The transitions are modelled only if the identifier is a
+     *      sub-element identifier, the fields below are ignored otherwise.
+     *
+     * \note The modelling of the transitions requires the timer module.
+     *
+     * \note A modelled device accepts one request at a time: the slew rate of
+     *      the PSU device should be zero so that the PSU HAL waits for the
+     *      completions rather than timing the ramps itself.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Identifier of the PSU device the completions are reported to */
+    fwk_id_t psu_id;
+
+    /*!
+     * \brief Slew rate of the output voltage in millivolts per millisecond
+     *      (mV/ms), or zero for voltage changes taking only the settle time.
+     */
+    unsigned int slew_rate;
+
+    /*! Settle time of the output at the end of a transition (us) */
+    unsigned int settle_time;
+
+    /*!
+     * \brief Period of the injected failures, in requests.
+     *
+     * \details Every request of that rank to set the enabled state or the
+     *      voltage of the device fails with \ref FWK_E_DEVICE once its
+     *      transition has completed, the output being restored. Zero for no
+     *      injected failures.
+     */
+    unsigned int fail_period;
 };
 
 /*!
@@ -45,13 +45,62 @@ static int mock_psu_element_init(
 
     assert(sub_element_count == 0);
 
+    /* The transitions are modelled with an alarm */
+    #if !BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_type(config->alarm_id, FWK_ID_TYPE_SUB_ELEMENT))
+        return FWK_E_SUPPORT;
+    #endif
+
     ctx = get_device_ctx(device_id);
+    ctx->config = config;
     ctx->enabled = config->default_enabled;
     ctx->voltage = config->default_voltage;
 
     return FWK_SUCCESS;
 }
 
+static int mock_psu_bind(fwk_id_t id, unsigned int round)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    struct mod_mock_psu_device_ctx *ctx;
+
+    /* Only the elements bind, in the first round */
+    if ((round > 0) || !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    ctx = get_device_ctx(id);
+    if (!fwk_id_is_type(ctx->config->alarm_id, FWK_ID_TYPE_SUB_ELEMENT))
+        return FWK_SUCCESS;
+
+    /* Bind to the alarm timing the transitions and to its timer */
+    status = fwk_module_bind(
+        ctx->config->alarm_id,
+        MOD_TIMER_API_ID_ALARM,
+        &ctx->apis.alarm);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    status = fwk_module_bind(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+                       fwk_id_get_element_idx(ctx->config->alarm_id)),
+        MOD_TIMER_API_ID_TIMER,
+        &ctx->apis.timer);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    /* Bind to the PSU device to report the completions to */
+    status = fwk_module_bind(
+        ctx->config->psu_id,
+        mod_psu_api_id_driver_response,
+        &ctx->apis.psu);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+    #endif
+
+    return FWK_SUCCESS;
+}
+
 static int mock_psu_process_bind_request(
     fwk_id_t source_id,
     fwk_id_t target_id,
@@ -67,6 +116,15 @@ static int mock_psu_process_bind_request(
     return FWK_SUCCESS;
 }
 
+bool __mod_mock_psu_is_modelled(const struct mod_mock_psu_device_ctx *ctx)
+{
+    #if BUILD_HAS_MOD_TIMER
+    return ctx->apis.alarm != NULL;
+    #else
+    return false;
+    #endif
+}
+
 struct mod_mock_psu_device_ctx *__mod_mock_psu_get_valid_device_ctx(
     fwk_id_t device_id)
 {
@@ -83,5 +141,6 @@ const struct fwk_module module_mock_psu = {
     .api_count = MOD_MOCK_PSU_API_COUNT,
     .init = mock_psu_init,
     .element_init = mock_psu_element_init,
+    .bind = mock_psu_bind,
     .process_bind_request = mock_psu_process_bind_request,
 };
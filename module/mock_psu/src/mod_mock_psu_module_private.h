@@ -10,12 +10,47 @@
 
 #include <stdbool.h>
 #include <fwk_id.h>
+#include <mod_mock_psu.h>
+#include <mod_psu.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 
 struct mod_mock_psu_device_ctx {
+    const struct mod_mock_psu_device_config *config; /* Configuration */
     bool enabled; /* Current enabled state */
     uint64_t voltage; /* Current voltage (in mV) */
+
+    #if BUILD_HAS_MOD_TIMER
+    struct {
+        /* Alarm API, NULL if the transitions are not modelled */
+        const struct mod_timer_alarm_api *alarm;
+
+        /* Timer API, used to measure the progress of the voltage ramps */
+        const struct mod_timer_api *timer;
+
+        /* PSU driver response API */
+        const struct mod_psu_driver_response_api *psu;
+    } apis;
+
+    /* Transition in progress */
+    struct {
+        bool pending; /* A transition is in progress */
+        bool voltage_change; /* Change of voltage rather than enabled state */
+        bool fail; /* The transition fails once complete */
+        bool target_enabled; /* Enabled state at the end of the transition */
+        uint64_t start_voltage; /* Voltage at the start of the ramp (mV) */
+        uint64_t target_voltage; /* Voltage at the end of the ramp (mV) */
+        uint64_t start_time; /* Time at the start of the ramp (us) */
+    } transition;
+
+    unsigned int request_count; /* Number of requests, to inject failures */
+    #endif
 };
 
+/* Whether the transitions of a device are modelled */
+bool __mod_mock_psu_is_modelled(const struct mod_mock_psu_device_ctx *ctx);
+
 struct mod_mock_psu_device_ctx *__mod_mock_psu_get_valid_device_ctx(
     fwk_id_t device_id);
 
@@ -9,8 +9,163 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module_idx.h>
 #include <mod_mock_psu_private.h>
 
+#if BUILD_HAS_MOD_TIMER
+/* Get the current time in microseconds from the timer of a device's alarm */
+static int get_time(const struct mod_mock_psu_device_ctx *ctx, uint64_t *time)
+{
+    fwk_id_t timer_id;
+
+    timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+                              fwk_id_get_element_idx(ctx->config->alarm_id));
+
+    if (ctx->apis.timer->get_time(timer_id, time) != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    return FWK_SUCCESS;
+}
+
+/* Get the output voltage of a device while its voltage ramps */
+static uint64_t get_ramp_voltage(const struct mod_mock_psu_device_ctx *ctx)
+{
+    uint64_t start = ctx->transition.start_voltage;
+    uint64_t target = ctx->transition.target_voltage;
+    uint64_t now, step;
+
+    if (ctx->config->slew_rate == 0)
+        return start;
+
+    /* Without a time reference, the ramp is assumed not to have started */
+    if (get_time(ctx, &now) != FWK_SUCCESS)
+        return start;
+
+    /* The slew rate in mV/ms is the voltage step in mV per 1000 us */
+    step = ((now - ctx->transition.start_time) * ctx->config->slew_rate) / 1000;
+
+    if (start > target)
+        return ((start - target) > step) ? (start - step) : target;
+    else
+        return ((target - start) > step) ? (start + step) : target;
+}
+
+/* Alarm callback, called from the timer ISR at the end of a transition */
+static void transition_alarm_callback(uintptr_t param)
+{
+    struct mod_mock_psu_device_ctx *ctx;
+
+    ctx = __mod_mock_psu_get_valid_device_ctx(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_MOCK_PSU, param));
+    if (ctx == NULL)
+        return;
+
+    ctx->transition.pending = false;
+
+    /* A failed transition leaves the output as it was */
+    if (!ctx->transition.fail) {
+        if (ctx->transition.voltage_change)
+            ctx->voltage = ctx->transition.target_voltage;
+        else
+            ctx->enabled = ctx->transition.target_enabled;
+    }
+
+    ctx->apis.psu->respond(ctx->config->psu_id,
+        ctx->transition.fail ? FWK_E_DEVICE : FWK_SUCCESS);
+}
+
+/*
+ * Start the transition of a device taking a given time. The transition is
+ * completed immediately if it takes no time.
+ */
+static int start_transition(
+    struct mod_mock_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    uint64_t time)
+{
+    int status;
+
+    ctx->request_count++;
+    ctx->transition.fail = (ctx->config->fail_period != 0) &&
+        ((ctx->request_count % ctx->config->fail_period) == 0);
+
+    if (time == 0) {
+        if (ctx->transition.fail)
+            return FWK_E_DEVICE;
+
+        if (ctx->transition.voltage_change)
+            ctx->voltage = ctx->transition.target_voltage;
+        else
+            ctx->enabled = ctx->transition.target_enabled;
+
+        return FWK_SUCCESS;
+    }
+
+    status = get_time(ctx, &ctx->transition.start_time);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->transition.pending = true;
+
+    status = ctx->apis.alarm->start_us(
+        ctx->config->alarm_id,
+        (uint32_t)FWK_MIN(time, (uint64_t)UINT32_MAX),
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        transition_alarm_callback,
+        fwk_id_get_element_idx(device_id));
+    if (status != FWK_SUCCESS) {
+        ctx->transition.pending = false;
+        return FWK_E_DEVICE;
+    }
+
+    return FWK_PENDING;
+}
+
+/* Start the ramp of the output voltage of a device to a new voltage */
+static int start_voltage_change(
+    struct mod_mock_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    uint64_t voltage)
+{
+    uint64_t delta;
+    uint64_t time = ctx->config->settle_time;
+
+    if (ctx->transition.pending)
+        return FWK_E_BUSY;
+
+    delta = (ctx->voltage > voltage) ?
+        (ctx->voltage - voltage) : (voltage - ctx->voltage);
+
+    /* Round the ramp time up so as not to complete before the ramp ends */
+    if (ctx->config->slew_rate != 0) {
+        time += ((delta * 1000) + ctx->config->slew_rate - 1) /
+                ctx->config->slew_rate;
+    }
+
+    ctx->transition.voltage_change = true;
+    ctx->transition.start_voltage = ctx->voltage;
+    ctx->transition.target_voltage = voltage;
+
+    return start_transition(ctx, device_id, time);
+}
+
+/* Start the change of the enabled state of a device */
+static int start_enabled_change(
+    struct mod_mock_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    bool enable)
+{
+    if (ctx->transition.pending)
+        return FWK_E_BUSY;
+
+    ctx->transition.voltage_change = false;
+    ctx->transition.target_enabled = enable;
+
+    return start_transition(ctx, device_id, ctx->config->settle_time);
+}
+#endif
+
 static int api_set_enabled(fwk_id_t device_id, bool enable)
 {
     struct mod_mock_psu_device_ctx *ctx;
@@ -19,6 +174,11 @@ static int api_set_enabled(fwk_id_t device_id, bool enable)
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (__mod_mock_psu_is_modelled(ctx))
+        return start_enabled_change(ctx, device_id, enable);
+    #endif
+
     ctx->enabled = enable;
 
     return FWK_SUCCESS;
@@ -45,6 +205,11 @@ static int api_set_voltage(fwk_id_t device_id, uintmax_t voltage)
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (__mod_mock_psu_is_modelled(ctx))
+        return start_voltage_change(ctx, device_id, voltage);
+    #endif
+
     ctx->voltage = voltage;
 
     return FWK_SUCCESS;
@@ -58,6 +223,13 @@ static int api_get_voltage(fwk_id_t device_id, uintmax_t *voltage)
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (ctx->transition.pending && ctx->transition.voltage_change) {
+        *voltage = get_ramp_voltage(ctx);
+        return FWK_SUCCESS;
+    }
+    #endif
+
     *voltage = ctx->voltage;
 
     return FWK_SUCCESS;
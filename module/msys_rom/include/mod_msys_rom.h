@@ -12,6 +12,7 @@
 #ifndef MOD_MSYS_ROM_H
 #define MOD_MSYS_ROM_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <fwk_id.h>
@@ -40,6 +41,18 @@ struct msys_rom_config {
 
     /*! Element ID of the primary core PPU */
     const fwk_id_t id_primary_core;
+
+    /*!
+     * \brief Load the RAM firmware image without waiting for it.
+     *
+     * \details When set, the image is requested from the bootloader module
+     *      as soon as the primary core is powered, and the module jumps to
+     *      the RAM firmware once the bootloader responds, the firmware
+     *      processing the other events in the meantime. The SDS structure of
+     *      the bootloader must then be watched (see
+     *      \ref mod_bootloader_api::load_image_async).
+     */
+    const bool async_image_load;
 };
 
 /*!
@@ -32,6 +32,7 @@ struct msys_rom_ctx {
     struct ppu_v1_boot_api *ppu_boot_api;
     struct mod_bootloader_api *bootloader_api;
     unsigned int notification_count; /* Notifications awaiting a response */
+    bool image_load_pending; /* Asynchronous image load awaiting a response */
 } ctx;
 
 enum rom_event {
@@ -80,12 +81,46 @@ static int msys_deferred_setup(void)
     ctx.ppu_boot_api->power_mode_on(ctx.rom_config->id_primary_cluster);
     ctx.ppu_boot_api->power_mode_on(ctx.rom_config->id_primary_core);
 
-    ctx.log_api->log(MOD_LOG_GROUP_INFO, "[SYSTEM] Primary CPU powered\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_INFO, "[SYSTEM] Primary CPU powered\n");
+
+    /* The jump is done when the bootloader responds with the loaded image */
+    if (ctx.rom_config->async_image_load) {
+        status = ctx.bootloader_api->load_image_async();
+        if (status != FWK_SUCCESS)
+            return status;
+
+        ctx.image_load_pending = true;
+
+        return FWK_SUCCESS;
+    }
 
     status = ctx.bootloader_api->load_image();
     if (status != FWK_SUCCESS) {
-        ctx.log_api->log(MOD_LOG_GROUP_ERROR,
-                         "[SYSTEM] Failed to load RAM firmware image\n");
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_ERROR,
+                             "[SYSTEM] Failed to load RAM firmware image\n");
+        return FWK_E_DATA;
+    }
+
+    msys_jump_to_ramfw();
+
+    return FWK_SUCCESS;
+}
+
+static int msys_process_image_load_response(const struct fwk_event *event)
+{
+    const struct mod_bootloader_load_image_resp_params *params =
+        (const void *)event->params;
+
+    if (!ctx.image_load_pending) {
+        assert(false);
+        return FWK_E_STATE;
+    }
+
+    ctx.image_load_pending = false;
+
+    if (params->status != FWK_SUCCESS) {
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_ERROR,
+                             "[SYSTEM] Failed to load RAM firmware image\n");
         return FWK_E_DATA;
     }
 
@@ -166,6 +201,9 @@ static int msys_rom_process_event(const struct fwk_event *event,
         .id = mod_msys_rom_notification_id_systop,
     };
 
+    if (fwk_id_is_equal(event->id, mod_bootloader_event_id_load_image))
+        return msys_process_image_load_response(event);
+
     /* Notify any subscribers of the SYSTOP power domain state change */
     notification_params =
         (struct mod_pd_power_state_transition_notification_params *)
@@ -6,7 +6,6 @@
  */
 
 #include <stdint.h>
-#include <stdlib.h>
 #include <fwk_assert.h>
 #include <fwk_element.h>
 #include <fwk_errno.h>
@@ -101,6 +100,12 @@ struct pik_clock_dev_ctx {
     uint8_t current_source;
     enum mod_clock_state current_state;
     const struct mod_pik_clock_dev_config *config;
+
+    /* Rates of the lookup table entries, in ascending order */
+    uint64_t *rate_key_table;
+
+    /* Index of the lookup table entry matched by the last rate lookup */
+    unsigned int rate_entry_idx;
 };
 
 /* Module context */
@@ -116,34 +121,49 @@ static struct pik_clock_ctx module_ctx;
  * Static helper functions
  */
 
-static int compare_rate_entry(const void *a, const void *b)
-{
-    struct mod_pik_clock_rate *key = (struct mod_pik_clock_rate *)a;
-    struct mod_pik_clock_rate *element = (struct mod_pik_clock_rate *)b;
-
-    return (key->rate - element->rate);
-}
-
 static int get_rate_entry(struct pik_clock_dev_ctx *ctx, uint64_t target_rate,
                           struct mod_pik_clock_rate **entry)
 {
-    struct mod_pik_clock_rate *current_rate_entry;
+    const uint64_t *rate_key_table;
+    unsigned int low, high, mid;
 
     if (ctx == NULL)
         return FWK_E_PARAM;
     if (entry == NULL)
         return FWK_E_PARAM;
 
+    rate_key_table = ctx->rate_key_table;
+
+    /*
+     * Consecutive lookups usually target the rate of the last entry found
+     * (e.g. when restoring the current rate), so check that entry first.
+     */
+    if ((ctx->rate_entry_idx < ctx->config->rate_count) &&
+        (rate_key_table[ctx->rate_entry_idx] == target_rate)) {
+        *entry = (struct mod_pik_clock_rate *)
+            &ctx->config->rate_table[ctx->rate_entry_idx];
+        return FWK_SUCCESS;
+    }
+
     /* Perform a binary search to find the entry matching the requested rate */
-    current_rate_entry = (struct mod_pik_clock_rate *) bsearch(&target_rate,
-        ctx->config->rate_table, ctx->config->rate_count,
-        sizeof(struct mod_pik_clock_rate), compare_rate_entry);
+    low = 0;
+    high = ctx->config->rate_count;
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (rate_key_table[mid] == target_rate) {
+            ctx->rate_entry_idx = mid;
+            *entry = (struct mod_pik_clock_rate *)&ctx->config->rate_table[mid];
+            return FWK_SUCCESS;
+        }
 
-    if (current_rate_entry == NULL)
-        return FWK_E_PARAM;
+        if (rate_key_table[mid] < target_rate)
+            low = mid + 1;
+        else
+            high = mid;
+    }
 
-    *entry = current_rate_entry;
-    return FWK_SUCCESS;
+    return FWK_E_PARAM;
 }
 
 static int ssclock_set_div(struct pik_clock_dev_ctx *ctx, uint32_t divider,
@@ -402,6 +422,32 @@ static int pik_clock_get_rate_from_index(fwk_id_t dev_id,
     return FWK_SUCCESS;
 }
 
+static int pik_clock_get_rates(fwk_id_t dev_id, unsigned int start_index,
+                               unsigned int count, uint64_t *rates)
+{
+    int status;
+    unsigned int i;
+    struct pik_clock_dev_ctx *ctx;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (rates == NULL)
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    if ((start_index >= ctx->config->rate_count) ||
+        (count > (ctx->config->rate_count - start_index)))
+        return FWK_E_PARAM;
+
+    for (i = 0; i < count; i++)
+        rates[i] = ctx->config->rate_table[start_index + i].rate;
+
+    return FWK_SUCCESS;
+}
+
 static int pik_clock_set_state(
     fwk_id_t dev_id,
     enum mod_clock_state target_state)
@@ -544,6 +590,7 @@ static const struct mod_clock_drv_api api_clock = {
     .set_rate = pik_clock_set_rate,
     .get_rate = pik_clock_get_rate,
     .get_rate_from_index = pik_clock_get_rate_from_index,
+    .get_rates = pik_clock_get_rates,
     .set_state = pik_clock_set_state,
     .get_state = pik_clock_get_state,
     .get_range = pik_clock_get_range,
@@ -700,6 +747,13 @@ static int pik_clock_element_init(fwk_id_t element_id,
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
+    if (dev_config->rate_count > 0) {
+        ctx->rate_key_table = fwk_mm_calloc(dev_config->rate_count,
+                                            sizeof(uint64_t));
+        if (ctx->rate_key_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
     /* Verify that the rate entries in the device's lookup table are ordered */
     while (i < dev_config->rate_count) {
         current_rate = dev_config->rate_table[i].rate;
@@ -708,6 +762,7 @@ static int pik_clock_element_init(fwk_id_t element_id,
         if (current_rate < last_rate)
             return FWK_E_DATA;
 
+        ctx->rate_key_table[i] = current_rate;
         last_rate = current_rate;
         i++;
     }
@@ -9,6 +9,7 @@
 #ifndef MOD_PL011_H
 #define MOD_PL011_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <fwk_id.h>
 
@@ -42,6 +43,26 @@ struct mod_pl011_device_config {
 
     /*! Identifier of the clock that this device depends on */
     fwk_id_t clock_id;
+
+    /*!
+     * \brief Size in bytes of the transmit buffer.
+     *
+     * \details When not zero, the characters written to the device are
+     *      queued in a buffer of this size, and moved to the transmit FIFO by
+     *      the transmit interrupt handler. The writes then only wait when the
+     *      buffer is full.
+     *
+     *      When zero, the writes wait for room in the transmit FIFO for each
+     *      character.
+     */
+    size_t tx_buffer_size;
+
+    /*!
+     * \brief Interrupt of the device.
+     *
+     * \note Only used when \ref tx_buffer_size is not zero.
+     */
+    unsigned int irq;
 };
 
 /*!
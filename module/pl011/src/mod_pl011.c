@@ -6,7 +6,10 @@
  */
 
 #include <fwk_assert.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <fwk_errno.h>
+#include <fwk_interrupt.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_notification.h>
@@ -16,14 +19,102 @@
 #include <mod_power_domain.h>
 #include <pl011.h>
 
-static const struct mod_pl011_device_config **device_config_table;
+/* Device context */
+struct pl011_device_ctx {
+    /* Device configuration */
+    const struct mod_pl011_device_config *config;
+
+    /* Device registers */
+    struct pl011_reg *reg;
+
+    /* Transmit buffer, NULL if the device is not buffered */
+    char *tx_buffer;
+
+    /* Offset of the next character to be queued in the transmit buffer */
+    size_t tx_head;
+
+    /* Offset of the next character to be moved to the transmit FIFO */
+    size_t tx_tail;
+
+    /* Number of characters in the transmit buffer */
+    size_t tx_count;
+};
+
+static struct pl011_device_ctx *device_ctx_table;
+
+static struct pl011_device_ctx *get_device_ctx(fwk_id_t device_id)
+{
+    return &device_ctx_table[fwk_id_get_element_idx(device_id)];
+}
 
-static struct pl011_reg *get_device_reg(fwk_id_t device_id)
+/*
+ * Move characters from the transmit buffer to the transmit FIFO until either
+ * the buffer is empty or the FIFO is full. The transmit interrupt is enabled
+ * while characters remain in the buffer.
+ *
+ * Must be called with the interrupts disabled.
+ */
+static void fill_tx_fifo(struct pl011_device_ctx *ctx)
+{
+    struct pl011_reg *reg = ctx->reg;
+
+    while ((ctx->tx_count > 0) && !(reg->FR & PL011_FR_TXFF)) {
+        reg->DR = ctx->tx_buffer[ctx->tx_tail];
+        ctx->tx_tail = (ctx->tx_tail + 1) % ctx->config->tx_buffer_size;
+        ctx->tx_count--;
+    }
+
+    if (ctx->tx_count > 0)
+        reg->IMSC |= PL011_IMSC_TXIM;
+    else
+        reg->IMSC &= ~PL011_IMSC_TXIM;
+}
+
+static void tx_isr(uintptr_t param)
 {
-    unsigned int device_idx;
+    struct pl011_device_ctx *ctx = (struct pl011_device_ctx *)param;
 
-    device_idx = fwk_id_get_element_idx(device_id);
-    return (struct pl011_reg *)device_config_table[device_idx]->reg_base;
+    ctx->reg->ICR = PL011_ICR_TXIC;
+
+    fill_tx_fifo(ctx);
+}
+
+static void write_buffered(struct pl011_device_ctx *ctx, const char *buf,
+                           size_t len)
+{
+    size_t size = ctx->config->tx_buffer_size;
+
+    while (len > 0) {
+        fwk_interrupt_global_disable();
+
+        /*
+         * When the buffer is full, wait for room in the FIFO as the transmit
+         * interrupt cannot be taken here.
+         */
+        if (ctx->tx_count == size)
+            fill_tx_fifo(ctx);
+
+        while ((len > 0) && (ctx->tx_count < size)) {
+            ctx->tx_buffer[ctx->tx_head] = *buf++;
+            ctx->tx_head = (ctx->tx_head + 1) % size;
+            ctx->tx_count++;
+            len--;
+        }
+
+        fill_tx_fifo(ctx);
+
+        fwk_interrupt_global_enable();
+    }
+}
+
+static void write_polled(struct pl011_reg *reg, const char *buf, size_t len)
+{
+    while (len-- > 0) {
+        while (reg->FR & PL011_FR_TXFF)
+            continue;
+
+        reg->DR = *buf++;
+    }
 }
 
 /*
@@ -86,37 +177,52 @@ static int set_baud_rate(unsigned int baud_rate_bps, uint64_t clock_rate_hz,
  * Module log driver API
  */
 
-static int do_putchar(fwk_id_t device_id, char c)
+static int do_write(fwk_id_t device_id, const char *buf, size_t len)
 {
     int status;
-    struct pl011_reg *reg;
+    struct pl011_device_ctx *ctx;
 
     status = fwk_module_check_call(device_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    reg = get_device_reg(device_id);
+    ctx = get_device_ctx(device_id);
 
-    while (reg->FR & PL011_FR_TXFF)
-        continue;
-
-    reg->DR = c;
+    if (ctx->tx_buffer != NULL)
+        write_buffered(ctx, buf, len);
+    else
+        write_polled(ctx->reg, buf, len);
 
     return FWK_SUCCESS;
 }
 
+static int do_putchar(fwk_id_t device_id, char c)
+{
+    return do_write(device_id, &c, 1);
+}
+
 static int do_flush(fwk_id_t device_id)
 {
     int status;
-    struct pl011_reg *reg;
+    struct pl011_device_ctx *ctx;
+    bool empty;
 
     status = fwk_module_check_call(device_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    reg = get_device_reg(device_id);
+    ctx = get_device_ctx(device_id);
+
+    if (ctx->tx_buffer != NULL) {
+        do {
+            fwk_interrupt_global_disable();
+            fill_tx_fifo(ctx);
+            empty = (ctx->tx_count == 0);
+            fwk_interrupt_global_enable();
+        } while (!empty);
+    }
 
-    while (reg->FR & PL011_FR_BUSY)
+    while (ctx->reg->FR & PL011_FR_BUSY)
         continue;
 
     return FWK_SUCCESS;
@@ -125,6 +231,7 @@ static int do_flush(fwk_id_t device_id)
 static const struct mod_log_driver_api driver_api = {
     .flush = do_flush,
     .putchar = do_putchar,
+    .write = do_write,
 };
 
 /*
@@ -137,13 +244,9 @@ static int pl011_init(fwk_id_t module_id, unsigned int element_count,
     if (element_count == 0)
         return FWK_E_DATA;
 
-    /*
-     * Create an array of pointers used to store the configuration data pointer
-     * of each element.
-     */
-    device_config_table = fwk_mm_calloc(element_count,
-                                        sizeof(*device_config_table));
-    if (device_config_table == NULL)
+    device_ctx_table = fwk_mm_calloc(element_count,
+                                     sizeof(*device_ctx_table));
+    if (device_ctx_table == NULL)
         return FWK_E_NOMEM;
 
     return FWK_SUCCESS;
@@ -152,6 +255,7 @@ static int pl011_init(fwk_id_t module_id, unsigned int element_count,
 static int pl011_element_init(fwk_id_t element_id, unsigned int unused,
                               const void *data)
 {
+    struct pl011_device_ctx *ctx;
     struct pl011_reg *reg;
     const struct mod_pl011_device_config *config = data;
     int status;
@@ -176,7 +280,24 @@ static int pl011_element_init(fwk_id_t element_id, unsigned int unused,
               PL011_CR_RXE |
               PL011_CR_TXE;
 
-    device_config_table[fwk_id_get_element_idx(element_id)] = config;
+    ctx = get_device_ctx(element_id);
+    ctx->config = config;
+    ctx->reg = reg;
+
+    if (config->tx_buffer_size > 0) {
+        ctx->tx_buffer = fwk_mm_alloc(config->tx_buffer_size, 1);
+        if (ctx->tx_buffer == NULL)
+            return FWK_E_NOMEM;
+
+        /* Interrupt when the transmit FIFO becomes less than 1/2 full */
+        reg->IFLS = (reg->IFLS & ~PL011_IFLS_TXIFLSEL) |
+                    PL011_IFLS_TXIFLSEL_1_2;
+
+        status = fwk_interrupt_set_isr_param(config->irq, tx_isr,
+                                             (uintptr_t)ctx);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 
     return FWK_SUCCESS;
 }
@@ -191,12 +312,23 @@ static int pl011_process_bind_request(fwk_id_t requester_id, fwk_id_t target_id,
 
 static int pl011_start(fwk_id_t id)
 {
+    int status;
     const struct mod_pl011_device_config *config;
 
     if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
         return FWK_SUCCESS;
 
-    config = device_config_table[fwk_id_get_element_idx(id)];
+    config = get_device_ctx(id)->config;
+
+    if (config->tx_buffer_size > 0) {
+        /*
+         * The characters written before the interrupt is enabled are moved
+         * to the FIFO as soon as it is.
+         */
+        status = fwk_interrupt_enable(config->irq);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 
     if (fwk_id_is_type(config->clock_id, FWK_ID_TYPE_NONE))
         return FWK_SUCCESS;
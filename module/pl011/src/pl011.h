@@ -102,6 +102,7 @@ struct pl011_reg {
 #define PL011_CR_CTSEN               UINT16_C(0x8000)
 
 #define PL011_IFLS_TXIFLSEL          UINT16_C(0x0007)
+#define PL011_IFLS_TXIFLSEL_1_2      UINT16_C(0x0002)
 #define PL011_IFLS_RXIFLSEL          UINT16_C(0x0038)
 
 #define PL011_IMSC_RIMIM             UINT16_C(0x0001)
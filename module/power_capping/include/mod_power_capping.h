@@ -0,0 +1,201 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Power capping.
+ */
+
+#ifndef MOD_POWER_CAPPING_H
+#define MOD_POWER_CAPPING_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupPowerCapping Power Capping
+ *
+ * \details The module holds the power drawn by groups of DVFS domains under a
+ *      budget. The elements of the module are the groups.
+ *
+ *      Every control period, the power sensors of each group are read and
+ *      their values summed. A proportional-integral controller derives from
+ *      the difference between the budget and the power of the group the
+ *      share of the operating points of its DVFS domains that are permitted,
+ *      and the maximum frequency limit of each domain is set accordingly.
+ *      The integral term is frozen while the output is saturated so that the
+ *      control does not wind up when the budget cannot be reached.
+ *
+ *      The module owns the maximum frequency limits of the domains, the
+ *      minimum limits are left unchanged.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Controller output permitting all the operating points.
+ *
+ * \details The output of the controller is a fraction of the operating points
+ *      of the domains, in Q16 fixed point.
+ */
+#define MOD_POWER_CAPPING_OUTPUT_MAX (UINT32_C(1) << 16)
+
+/*!
+ * \brief Group configuration.
+ */
+struct mod_power_capping_group_config {
+    /*!
+     * \brief Table of the identifiers of the power sensors of the group.
+     *
+     * \details The power of the group is the sum of the values of its
+     *      sensors. A sensor must belong to a single group.
+     */
+    const fwk_id_t *sensor_id_table;
+
+    /*! Number of power sensors */
+    unsigned int sensor_count;
+
+    /*! Table of the identifiers of the DVFS domains of the group */
+    const fwk_id_t *dvfs_domain_id_table;
+
+    /*! Number of DVFS domains */
+    unsigned int dvfs_domain_count;
+
+    /*! Initial budget, in the unit of the sensors */
+    uint32_t budget;
+
+    /*! Lowest budget that can be set */
+    uint32_t budget_min;
+
+    /*! Highest budget that can be set */
+    uint32_t budget_max;
+
+    /*!
+     * \brief Proportional gain.
+     *
+     * \details Change of the output per unit of difference between the budget
+     *      and the power, in Q16 fixed point fractions of the operating points.
+     */
+    int32_t kp;
+
+    /*!
+     * \brief Integral gain.
+     *
+     * \details Change of the output per control period and per unit of
+     *      difference between the budget and the power, in Q16 fixed point
+     *      fractions of the operating points.
+     */
+    int32_t ki;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_power_capping_config {
+    /*! Sub-element identifier of the alarm running the control loop */
+    fwk_id_t alarm_id;
+
+    /*! Control period in milliseconds */
+    unsigned int control_period_ms;
+};
+
+/*!
+ * \brief Group information.
+ */
+struct mod_power_capping_info {
+    /*! Lowest budget that can be set */
+    uint32_t budget_min;
+
+    /*! Highest budget that can be set */
+    uint32_t budget_max;
+
+    /*! Control period in milliseconds */
+    unsigned int control_period_ms;
+};
+
+/*!
+ * \brief Power capping API.
+ */
+struct mod_power_capping_api {
+    /*!
+     * \brief Get the information of a group.
+     *
+     * \param group_id Element identifier of the group.
+     * \param[out] info Group information.
+     *
+     * \retval FWK_SUCCESS The information was returned.
+     * \retval FWK_E_PARAM One of the parameters is invalid.
+     */
+    int (*get_info)(fwk_id_t group_id, struct mod_power_capping_info *info);
+
+    /*!
+     * \brief Get the budget of a group.
+     *
+     * \param group_id Element identifier of the group.
+     * \param[out] budget Budget, in the unit of the sensors.
+     *
+     * \retval FWK_SUCCESS The budget was returned.
+     * \retval FWK_E_PARAM One of the parameters is invalid.
+     */
+    int (*get_budget)(fwk_id_t group_id, uint32_t *budget);
+
+    /*!
+     * \brief Set the budget of a group.
+     *
+     * \details The budget applies from the next control period.
+     *
+     * \param group_id Element identifier of the group.
+     * \param budget Budget, in the unit of the sensors.
+     *
+     * \retval FWK_SUCCESS The budget was set.
+     * \retval FWK_E_RANGE The budget is out of the limits of the group.
+     * \retval FWK_E_PARAM The group identifier is invalid.
+     */
+    int (*set_budget)(fwk_id_t group_id, uint32_t budget);
+
+    /*!
+     * \brief Get the power of a group measured in the last control period.
+     *
+     * \param group_id Element identifier of the group.
+     * \param[out] power Power, in the unit of the sensors.
+     *
+     * \retval FWK_SUCCESS The power was returned.
+     * \retval FWK_E_STATE The power of the group has not been measured yet.
+     * \retval FWK_E_PARAM One of the parameters is invalid.
+     */
+    int (*get_power)(fwk_id_t group_id, uint32_t *power);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_power_capping_api_idx {
+    /*! Power capping API */
+    MOD_POWER_CAPPING_API_IDX_POWER_CAPPING,
+
+    /*! Number of APIs */
+    MOD_POWER_CAPPING_API_IDX_COUNT,
+};
+
+/*! Identifier of the power capping API */
+static const fwk_id_t mod_power_capping_api_id_power_capping =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_POWER_CAPPING,
+                    MOD_POWER_CAPPING_API_IDX_POWER_CAPPING);
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_POWER_CAPPING_H */
@@ -0,0 +1,460 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Power capping.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <mod_dvfs.h>
+#include <mod_power_capping.h>
+#include <mod_sensor.h>
+#include <mod_timer.h>
+
+struct group_ctx {
+    /* Group configuration */
+    const struct mod_power_capping_group_config *config;
+
+    /* Current budget */
+    uint32_t budget;
+
+    /* Power measured in the last control period */
+    uint32_t power;
+
+    /* The power of the group has been measured once at least */
+    bool measured;
+
+    /* Integral term of the controller, Q16 */
+    int32_t integral;
+
+    /* Output of the controller, Q16 */
+    uint32_t output;
+
+    /* Sum of the sensor values read in the current control period */
+    uint64_t power_sum;
+
+    /* Number of sensor readings in progress */
+    unsigned int pending_count;
+
+    /* Table of the sensors with a reading in progress */
+    bool *pending_table;
+
+    /* A sensor reading of the current control period failed */
+    bool reading_failed;
+};
+
+static struct {
+    /* Module configuration */
+    const struct mod_power_capping_config *config;
+
+    /* Table of group contexts */
+    struct group_ctx *group_ctx_table;
+
+    /* Number of groups */
+    unsigned int group_count;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Sensor API */
+    const struct mod_sensor_api *sensor_api;
+
+    /* DVFS domain API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+} ctx;
+
+/*
+ * Static functions
+ */
+
+static struct group_ctx *get_group_ctx(fwk_id_t group_id)
+{
+    if (!fwk_module_is_valid_element_id(group_id) ||
+        (fwk_id_get_module_idx(group_id) != FWK_MODULE_IDX_POWER_CAPPING))
+        return NULL;
+
+    return &ctx.group_ctx_table[fwk_id_get_element_idx(group_id)];
+}
+
+static int32_t clamp_output(int64_t value)
+{
+    if (value < 0)
+        return 0;
+
+    if (value > (int64_t)MOD_POWER_CAPPING_OUTPUT_MAX)
+        return (int32_t)MOD_POWER_CAPPING_OUTPUT_MAX;
+
+    return (int32_t)value;
+}
+
+/*
+ * Set the maximum frequency limit of a domain to the operating point selected
+ * by the output of the controller, among the operating points above the
+ * minimum limit.
+ */
+static int apply_output(fwk_id_t domain_id, uint32_t output)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = ctx.dvfs_api;
+    struct mod_dvfs_frequency_limits limits;
+    struct mod_dvfs_opp opp;
+    size_t opp_count;
+    size_t min_idx;
+    size_t max_idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = dvfs_api->get_frequency_limits(domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (min_idx = 0; min_idx < (opp_count - 1); min_idx++) {
+        status = dvfs_api->get_nth_opp(domain_id, min_idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (opp.frequency >= limits.minimum)
+            break;
+    }
+
+    max_idx = min_idx + (size_t)(((uint64_t)(opp_count - 1 - min_idx) *
+                                  output) / MOD_POWER_CAPPING_OUTPUT_MAX);
+
+    status = dvfs_api->get_nth_opp(domain_id, max_idx, &opp);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (opp.frequency == limits.maximum)
+        return FWK_SUCCESS;
+
+    limits.maximum = opp.frequency;
+
+    return dvfs_api->set_frequency_limits_async(domain_id, &limits);
+}
+
+static void update_control(struct group_ctx *group_ctx)
+{
+    const struct mod_power_capping_group_config *config = group_ctx->config;
+    int64_t error;
+    int64_t integral;
+    int64_t output;
+    unsigned int domain_idx;
+
+    if (group_ctx->reading_failed)
+        return;
+
+    group_ctx->power = (group_ctx->power_sum > UINT32_MAX) ?
+                       UINT32_MAX : (uint32_t)group_ctx->power_sum;
+    group_ctx->measured = true;
+
+    error = (int64_t)group_ctx->budget - (int64_t)group_ctx->power;
+    integral = group_ctx->integral + (int64_t)config->ki * error;
+    output = (int64_t)config->kp * error + integral;
+
+    /*
+     * Conditional integration: the integral term is not updated when the
+     * output is saturated and the error pushes it further into saturation.
+     */
+    if (!((output > (int64_t)MOD_POWER_CAPPING_OUTPUT_MAX) && (error > 0)) &&
+        !((output < 0) && (error < 0)))
+        group_ctx->integral = clamp_output(integral);
+
+    group_ctx->output = (uint32_t)clamp_output(output);
+
+    for (domain_idx = 0; domain_idx < config->dvfs_domain_count; domain_idx++)
+        apply_output(config->dvfs_domain_id_table[domain_idx],
+                     group_ctx->output);
+}
+
+static void start_period(struct group_ctx *group_ctx)
+{
+    const struct mod_power_capping_group_config *config = group_ctx->config;
+    unsigned int sensor_idx;
+    uint64_t value;
+    int status;
+
+    /* The readings of the previous period are still in progress */
+    if (group_ctx->pending_count != 0)
+        return;
+
+    group_ctx->power_sum = 0;
+    group_ctx->reading_failed = false;
+
+    for (sensor_idx = 0; sensor_idx < config->sensor_count; sensor_idx++) {
+        status = ctx.sensor_api->get_value(
+            config->sensor_id_table[sensor_idx], &value);
+        if (status == FWK_SUCCESS)
+            group_ctx->power_sum += value;
+        else if (status == FWK_PENDING) {
+            group_ctx->pending_table[sensor_idx] = true;
+            group_ctx->pending_count++;
+        } else
+            group_ctx->reading_failed = true;
+    }
+
+    if (group_ctx->pending_count == 0)
+        update_control(group_ctx);
+}
+
+static void complete_reading(fwk_id_t sensor_id,
+                             const struct mod_sensor_event_params *params)
+{
+    struct group_ctx *group_ctx;
+    unsigned int group_idx;
+    unsigned int sensor_idx;
+
+    for (group_idx = 0; group_idx < ctx.group_count; group_idx++) {
+        group_ctx = &ctx.group_ctx_table[group_idx];
+
+        for (sensor_idx = 0; sensor_idx < group_ctx->config->sensor_count;
+             sensor_idx++) {
+            if (!group_ctx->pending_table[sensor_idx] ||
+                !fwk_id_is_equal(
+                    group_ctx->config->sensor_id_table[sensor_idx],
+                    sensor_id))
+                continue;
+
+            group_ctx->pending_table[sensor_idx] = false;
+            group_ctx->pending_count--;
+
+            if (params->status == FWK_SUCCESS)
+                group_ctx->power_sum += params->value;
+            else
+                group_ctx->reading_failed = true;
+
+            if (group_ctx->pending_count == 0)
+                update_control(group_ctx);
+
+            return;
+        }
+    }
+}
+
+/*
+ * Power capping API
+ */
+
+static int power_capping_get_info(fwk_id_t group_id,
+                                  struct mod_power_capping_info *info)
+{
+    struct group_ctx *group_ctx;
+
+    group_ctx = get_group_ctx(group_id);
+    if ((group_ctx == NULL) || (info == NULL))
+        return FWK_E_PARAM;
+
+    *info = (struct mod_power_capping_info) {
+        .budget_min = group_ctx->config->budget_min,
+        .budget_max = group_ctx->config->budget_max,
+        .control_period_ms = ctx.config->control_period_ms,
+    };
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_get_budget(fwk_id_t group_id, uint32_t *budget)
+{
+    struct group_ctx *group_ctx;
+
+    group_ctx = get_group_ctx(group_id);
+    if ((group_ctx == NULL) || (budget == NULL))
+        return FWK_E_PARAM;
+
+    *budget = group_ctx->budget;
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_set_budget(fwk_id_t group_id, uint32_t budget)
+{
+    struct group_ctx *group_ctx;
+
+    group_ctx = get_group_ctx(group_id);
+    if (group_ctx == NULL)
+        return FWK_E_PARAM;
+
+    if ((budget < group_ctx->config->budget_min) ||
+        (budget > group_ctx->config->budget_max))
+        return FWK_E_RANGE;
+
+    group_ctx->budget = budget;
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_get_power(fwk_id_t group_id, uint32_t *power)
+{
+    struct group_ctx *group_ctx;
+
+    group_ctx = get_group_ctx(group_id);
+    if ((group_ctx == NULL) || (power == NULL))
+        return FWK_E_PARAM;
+
+    if (!group_ctx->measured)
+        return FWK_E_STATE;
+
+    *power = group_ctx->power;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_power_capping_api power_capping_api = {
+    .get_info = power_capping_get_info,
+    .get_budget = power_capping_get_budget,
+    .set_budget = power_capping_set_budget,
+    .get_power = power_capping_get_power,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int power_capping_init(fwk_id_t module_id, unsigned int element_count,
+                              const void *data)
+{
+    const struct mod_power_capping_config *config = data;
+
+    if ((element_count == 0) || (config == NULL) ||
+        (config->control_period_ms == 0))
+        return FWK_E_DATA;
+
+    ctx.group_ctx_table = fwk_mm_calloc(element_count,
+                                        sizeof(ctx.group_ctx_table[0]));
+    if (ctx.group_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    ctx.group_count = element_count;
+    ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_element_init(fwk_id_t element_id,
+                                      unsigned int sub_element_count,
+                                      const void *data)
+{
+    const struct mod_power_capping_group_config *config = data;
+    struct group_ctx *group_ctx;
+
+    if ((config == NULL) ||
+        (config->sensor_count == 0) || (config->sensor_id_table == NULL) ||
+        (config->dvfs_domain_count == 0) ||
+        (config->dvfs_domain_id_table == NULL) ||
+        (config->budget_min > config->budget_max) ||
+        (config->budget < config->budget_min) ||
+        (config->budget > config->budget_max))
+        return FWK_E_DATA;
+
+    group_ctx = &ctx.group_ctx_table[fwk_id_get_element_idx(element_id)];
+
+    group_ctx->pending_table =
+        fwk_mm_calloc(config->sensor_count,
+                      sizeof(group_ctx->pending_table[0]));
+    if (group_ctx->pending_table == NULL)
+        return FWK_E_NOMEM;
+
+    group_ctx->config = config;
+    group_ctx->budget = config->budget;
+
+    /* The control starts from the full range of operating points */
+    group_ctx->integral = (int32_t)MOD_POWER_CAPPING_OUTPUT_MAX;
+    group_ctx->output = MOD_POWER_CAPPING_OUTPUT_MAX;
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if ((round != 0) || fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                             &ctx.alarm_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR),
+                             mod_sensor_api_id_sensor, &ctx.sensor_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+                           mod_dvfs_api_id_dvfs, &ctx.dvfs_api);
+}
+
+static int power_capping_process_bind_request(fwk_id_t source_id,
+                                              fwk_id_t target_id,
+                                              fwk_id_t api_id,
+                                              const void **api)
+{
+    if (!fwk_id_is_equal(api_id, mod_power_capping_api_id_power_capping))
+        return FWK_E_PARAM;
+
+    *api = &power_capping_api;
+
+    return FWK_SUCCESS;
+}
+
+static int power_capping_start(fwk_id_t id)
+{
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    return ctx.alarm_api->start(ctx.config->alarm_id,
+                                ctx.config->control_period_ms,
+                                MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+static int power_capping_process_event(const struct fwk_event *event,
+                                       struct fwk_event *resp_event)
+{
+    unsigned int group_idx;
+
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        for (group_idx = 0; group_idx < ctx.group_count; group_idx++)
+            start_period(&ctx.group_ctx_table[group_idx]);
+
+        return FWK_SUCCESS;
+    }
+
+    /* Value of a pending sensor reading */
+    if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request)) {
+        complete_reading(event->source_id,
+            (const struct mod_sensor_event_params *)event->params);
+
+        return FWK_SUCCESS;
+    }
+
+    /* A failed request is retried in the next control period */
+    if (fwk_id_is_equal(event->id, mod_dvfs_event_id_set_frequency_limits))
+        return FWK_SUCCESS;
+
+    return FWK_E_PARAM;
+}
+
+const struct fwk_module module_power_capping = {
+    .name = "Power capping",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_POWER_CAPPING_API_IDX_COUNT,
+    .init = power_capping_init,
+    .element_init = power_capping_element_init,
+    .bind = power_capping_bind,
+    .process_bind_request = power_capping_process_bind_request,
+    .start = power_capping_start,
+    .process_event = power_capping_process_event,
+};
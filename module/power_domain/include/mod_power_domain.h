@@ -153,6 +153,40 @@ struct mod_power_domain_config {
 
     /*! Number of identifiers in the "authorized_id_table" table. */
     size_t authorized_id_table_size;
+
+    /*!
+     * \brief Identifier of the timer device used to timestamp the power state
+     *      transitions.
+     *
+     * \details Optional. If the identifier is an element identifier,
+     *      statistics on the power states entered and on the latency of the
+     *      transitions are maintained for each power domain, see
+     *      \ref mod_pd_state_stats. The statistics require the timer module.
+     */
+    fwk_id_t stats_timer_id;
+
+    /*!
+     * \brief Sub-element identifier of the alarm bounding the quiescing of
+     *      the system before a shutdown.
+     *
+     * \details Optional. Before a system shutdown or reset, the module sends
+     *      the pre-shutdown notification with a response requested to all its
+     *      subscribers at once, and shuts the system down once they have all
+     *      responded. If the identifier is a sub-element identifier, the
+     *      shutdown proceeds when the alarm expires, whatever the responses
+     *      still expected. Otherwise, the module waits for all the responses.
+     *      The alarm requires the timer module.
+     */
+    fwk_id_t shutdown_alarm_id;
+
+    /*!
+     * \brief Maximum time given to the subscribers to the pre-shutdown
+     *      notification to quiesce, in milliseconds.
+     *
+     * \details Only used when \ref shutdown_alarm_id is a sub-element
+     *      identifier.
+     */
+    unsigned int shutdown_timeout_ms;
 };
 
 /*!
@@ -241,6 +275,61 @@ struct mod_power_domain_element_config {
 
     /*! Size of the table of allowed state masks */
     size_t state_name_table_size;
+
+    /*!
+     * \brief Mask of the power states whose power state pre-transition
+     *      notification is observe-only.
+     *
+     * \details The bit 'i' is equal to one if none of the subscribers to the
+     *      power state pre-transition notification of the power domain can
+     *      deny a transition to the state 'i'. For those transitions, the
+     *      notification is sent without requesting a response and the driver
+     *      is called without waiting for the subscribers. The subscribers
+     *      must then not rely on their response being taken into account.
+     *      Optional, equal to zero by default: all the transitions wait for
+     *      the responses of the subscribers.
+     */
+    uint32_t pre_transition_observe_only_state_mask;
+
+    /*!
+     * \brief Mask of the power states whose power state transition
+     *      notification is observe-only.
+     *
+     * \details The bit 'i' is equal to one if the transitions of the parent
+     *      and of the children of the power domain which follow its transition
+     *      to the state 'i' do not have to wait for the subscribers to the
+     *      power state transition notification. For those transitions, the
+     *      notification is sent after the fact without requesting a response,
+     *      and the power-up of a system, for instance, carries on down to the
+     *      cores without waiting for the subscribers at each level. Optional,
+     *      equal to zero by default: the transitions that follow wait for the
+     *      responses of the subscribers.
+     */
+    uint32_t transition_observe_only_state_mask;
+
+    /*!
+     * \brief Delay, in microseconds, before a transition of the power domain
+     *      to a deeper power state is initiated.
+     *
+     * \details Optional, equal to zero by default: the transitions are
+     *      initiated as soon as they are allowed. Otherwise, a transition to
+     *      a deeper state, typically the power-off of a cluster following the
+     *      suspend of its last core, is initiated once the power domain has
+     *      lingered in its current state for the delay. A request for another
+     *      state within that window, like the wake-up of one of the cores of
+     *      the cluster, cancels the transition without any driver call. The
+     *      delay requires the timer module and an alarm, see
+     *      \ref off_delay_alarm_id.
+     */
+    uint32_t off_delay_us;
+
+    /*!
+     * \brief Sub-element identifier of the alarm timing the delay before the
+     *      transitions to a deeper power state.
+     *
+     * \details Only used when \ref off_delay_us is not equal to zero.
+     */
+    fwk_id_t off_delay_alarm_id;
 };
 
 /*!
@@ -335,6 +424,45 @@ enum {
      ((LEVEL_1_STATE) << MOD_PD_CS_LEVEL_1_STATE_SHIFT) | \
      ((LEVEL_0_STATE) << MOD_PD_CS_LEVEL_0_STATE_SHIFT))
 
+/*!
+ * \brief Statistics of a power domain state.
+ *
+ * \details The times are expressed in microseconds. The latency of a
+ *      transition is the time from the request of the state to the report of
+ *      the transition by the driver. It is split into the time spent waiting
+ *      for the responses to the power state pre-transition notification, the
+ *      time spent in the call to the driver and the time spent waiting for the
+ *      driver to report the completion of the transition. The remainder is
+ *      spent waiting for the parent or the children of the power domain to be
+ *      in a compatible state. Only the transitions to a requested state are
+ *      accounted for in the latency statistics.
+ */
+struct mod_pd_state_stats {
+    /*! Number of times the state was entered */
+    uint32_t entry_count;
+
+    /*! Number of transitions to the state accounted for in the latencies */
+    uint32_t transition_count;
+
+    /*! Total time spent in the state, up to the last exit from the state */
+    uint64_t residency;
+
+    /*! Worst-case latency of a transition to the state */
+    uint32_t latency_max;
+
+    /*! Total latency of the transitions to the state */
+    uint64_t latency_total;
+
+    /*! Total time spent waiting for pre-transition notification responses */
+    uint64_t notification_time_total;
+
+    /*! Total time spent in the driver calls */
+    uint64_t driver_time_total;
+
+    /*! Total time spent waiting for the driver transition reports */
+    uint64_t report_wait_time_total;
+};
+
 /*!
  * \brief Power domain driver interface.
  *
@@ -460,6 +588,44 @@ struct mod_pd_driver_api {
      */
     int (*shutdown)(fwk_id_t dev_id,
                     enum mod_pd_system_shutdown system_shutdown);
+
+    /*!
+     * \brief Initiate the transition of the power domain identified by
+     *      \p dev_id to the \p state power state without waiting for its
+     *      completion.
+     *
+     * \note This function is optional (may be \c NULL). It is provided along
+     *      with \ref wait_state to transition several power domains in
+     *      parallel, a call to \ref request_state followed by a call to
+     *      \ref wait_state being equivalent to a call to \ref set_state.
+     *
+     * \param dev_id Driver identifier of the power domain.
+     * \param state Power state the power domain has to be put into.
+     *
+     * \retval FWK_SUCCESS The power state transition was initiated.
+     * \retval FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \return One of the other specific error codes described by the driver
+     *      module.
+     */
+    int (*request_state)(fwk_id_t dev_id, unsigned int state);
+
+    /*!
+     * \brief Wait for the completion of the power state transition initiated
+     *      by \ref request_state for the power domain identified by \p dev_id.
+     *
+     * \note This function is optional (may be \c NULL) but must be provided
+     *      if \ref request_state is.
+     *
+     * \param dev_id Driver identifier of the power domain.
+     *
+     * \retval FWK_SUCCESS The power state has been successfully set.
+     * \retval FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \return One of the other specific error codes described by the driver
+     *      module.
+     */
+    int (*wait_state)(fwk_id_t dev_id);
 };
 
 /*!
@@ -502,6 +668,45 @@ struct mod_pd_public_api {
      * \retval FWK_E_PARAM The pointer 'parent_pd_id' is equal to NULL.
      */
     int (*get_domain_parent_id)(fwk_id_t pd_id, fwk_id_t *parent_pd_id);
+
+    /*!
+     * \brief Get the current state of a power domain.
+     *
+     * \details The state is read from a table of the current states of the
+     *      power domains updated by the power domain module each time a power
+     *      state transition completes. The function neither sends an event
+     *      nor waits, it may be called from any context.
+     *
+     * \note The state of a power domain undergoing a transition is the state
+     *      it was in before the transition.
+     *
+     * \param pd_id Identifier of the power domain whose state has to be
+     *      retrieved.
+     * \param[out] state The power domain state.
+     *
+     * \retval FWK_SUCCESS The power state was returned.
+     * \retval FWK_E_PARAM The power domain identifier is unknown.
+     * \retval FWK_E_PARAM The pointer 'state' is equal to NULL.
+     */
+    int (*get_current_state)(fwk_id_t pd_id, unsigned int *state);
+
+    /*!
+     * \brief Get the current composite state of a power domain and its
+     *      ancestors (if any) in the power domain tree.
+     *
+     * \details The composite state is built from the table of the current
+     *      states of the power domains, see \ref get_current_state.
+     *
+     * \param pd_id Identifier of the power domain whose composite state has to
+     *      be retrieved.
+     * \param[out] composite_state The power domain composite state.
+     *
+     * \retval FWK_SUCCESS The composite state was returned.
+     * \retval FWK_E_PARAM The power domain identifier is unknown.
+     * \retval FWK_E_PARAM The pointer 'composite_state' is equal to NULL.
+     */
+    int (*get_current_composite_state)(fwk_id_t pd_id,
+                                       unsigned int *composite_state);
 };
 
 /*!
@@ -546,6 +751,45 @@ struct mod_pd_restricted_api {
      */
     int (*get_domain_parent_id)(fwk_id_t pd_id, fwk_id_t *parent_pd_id);
 
+    /*!
+     * \brief Get the current state of a power domain.
+     *
+     * \details The state is read from a table of the current states of the
+     *      power domains updated by the power domain module each time a power
+     *      state transition completes. The function neither sends an event
+     *      nor waits, it may be called from any context.
+     *
+     * \note The state of a power domain undergoing a transition is the state
+     *      it was in before the transition.
+     *
+     * \param pd_id Identifier of the power domain whose state has to be
+     *      retrieved.
+     * \param[out] state The power domain state.
+     *
+     * \retval FWK_SUCCESS The power state was returned.
+     * \retval FWK_E_PARAM The power domain identifier is unknown.
+     * \retval FWK_E_PARAM The pointer 'state' is equal to NULL.
+     */
+    int (*get_current_state)(fwk_id_t pd_id, unsigned int *state);
+
+    /*!
+     * \brief Get the current composite state of a power domain and its
+     *      ancestors (if any) in the power domain tree.
+     *
+     * \details The composite state is built from the table of the current
+     *      states of the power domains, see \ref get_current_state.
+     *
+     * \param pd_id Identifier of the power domain whose composite state has to
+     *      be retrieved.
+     * \param[out] composite_state The power domain composite state.
+     *
+     * \retval FWK_SUCCESS The composite state was returned.
+     * \retval FWK_E_PARAM The power domain identifier is unknown.
+     * \retval FWK_E_PARAM The pointer 'composite_state' is equal to NULL.
+     */
+    int (*get_current_composite_state)(fwk_id_t pd_id,
+                                       unsigned int *composite_state);
+
     /*!
      * \brief Set the state of a power domain.
      *
@@ -633,6 +877,42 @@ struct mod_pd_restricted_api {
     int (*set_composite_state_async)(fwk_id_t pd_id, bool resp_requested,
                                      uint32_t composite_state);
 
+    /*!
+     * \brief Request an asynchronous composite power state transition for a
+     *      set of sibling power domains.
+     *
+     * \details The requests are processed in a single event, in the order of
+     *      the children of the parent power domain. The calls to the drivers
+     *      for the power domains that can transition right away are thus
+     *      issued back to back, and the transition of the common ancestors is
+     *      evaluated once all the siblings have been processed. No response
+     *      is sent at the end of the request processing.
+     *
+     * \warning Successful completion of this function does not indicate
+     *      completion of a transition, but instead that a request has been
+     *      submitted.
+     *
+     * \param parent_pd_id Identifier of the parent of the power domains whose
+     *      state has to be set.
+     *
+     * \param child_mask Mask of the power domains whose state has to be set.
+     *      Bit \c n is equal to one if the state of the \c n-th child of the
+     *      parent power domain, in the order of the power domain tree, has to
+     *      be set.
+     *
+     * \param composite_state State the power domains have to be put into and
+     *      possibly the state(s) their ancestor(s) has(have) to be put into.
+     *
+     * \retval FWK_SUCCESS The composite power state transitions were
+     *      submitted.
+     * \retval FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     */
+    int (*set_children_composite_state_async)(fwk_id_t parent_pd_id,
+                                              uint32_t child_mask,
+                                              uint32_t composite_state);
+
     /*!
      * \brief Get the state of a given power domain.
      *
@@ -670,6 +950,24 @@ struct mod_pd_restricted_api {
      */
     int (*get_composite_state)(fwk_id_t pd_id, unsigned int *composite_state);
 
+    /*!
+     * \brief Get the statistics of a power domain state.
+     *
+     * \param pd_id Identifier of the power domain.
+     * \param state Power state.
+     * \param[out] stats Statistics of the power state.
+     *
+     * \retval FWK_SUCCESS The statistics were returned.
+     * \retval FWK_E_ACCESS Invalid access, the framework has rejected the
+     *      call to the API.
+     * \retval FWK_E_PARAM The power domain identifier is unknown, the state
+     *      is not a valid state of the power domain or the pointer 'stats' is
+     *      equal to NULL.
+     * \retval FWK_E_SUPPORT The statistics are not maintained.
+     */
+    int (*get_state_stats)(fwk_id_t pd_id, unsigned int state,
+                           struct mod_pd_state_stats *stats);
+
     /*!
      * \brief Reset of a power domain.
      *
@@ -713,11 +1011,17 @@ struct mod_pd_restricted_api {
     /*!
      * \brief Shutdown the system.
      *
+     * \details The subscribers to the pre-shutdown notification are notified
+     *      first, and the system is shut down once they have all responded or
+     *      when the timeout of the quiescing expires, see
+     *      \ref mod_power_domain_config::shutdown_alarm_id.
+     *
      * \note The function shutdowns the system whatever its current state. If
      *      the shutdown is successful, the function does not return.
      *
      * \retval FWK_E_ACCESS Invalid access, the framework has rejected the
      *      call to the API.
+     * \retval FWK_E_BUSY A system shutdown is already in progress.
      * \retval FWK_E_HANDLER The function is not called from a thread.
      * \retval FWK_E_NOMEM Failed to allocate a request descriptor.
      */
@@ -848,6 +1152,19 @@ struct mod_pd_power_state_transition_notification_params {
     unsigned int state;
 };
 
+/*!
+ * \brief Parameters of a pre-shutdown notification.
+ *
+ * \details The notification is sent to all the subscribers at once. Each
+ *      subscriber quiesces the devices it is in charge of, possibly delaying
+ *      its response until that is done, and then responds. The response has
+ *      no parameters.
+ */
+struct mod_pd_pre_shutdown_notification_params {
+    /*! Type of the imminent system shutdown */
+    enum mod_pd_system_shutdown system_shutdown;
+};
+
 /*!
  * \defgroup GroupPowerDomainIds Identifiers
  * \{
@@ -887,6 +1204,9 @@ enum mod_pd_notification_idx {
     /*! Power state pre-transition */
     MOD_PD_NOTIFICATION_IDX_POWER_STATE_PRE_TRANSITION,
 
+    /*! System pre-shutdown */
+    MOD_PD_NOTIFICATION_IDX_PRE_SHUTDOWN,
+
     /*! Number of notifications defined by the power domain module */
     MOD_PD_NOTIFICATION_COUNT,
 };
@@ -904,6 +1224,11 @@ static const fwk_id_t mod_pd_notification_id_power_state_transition =
 static const fwk_id_t mod_pd_notification_id_power_state_pre_transition =
     FWK_ID_NOTIFICATION_INIT(FWK_MODULE_IDX_POWER_DOMAIN,
         MOD_PD_NOTIFICATION_IDX_POWER_STATE_PRE_TRANSITION);
+
+/*! Identifier of the system pre-shutdown notification */
+static const fwk_id_t mod_pd_notification_id_pre_shutdown =
+    FWK_ID_NOTIFICATION_INIT(FWK_MODULE_IDX_POWER_DOMAIN,
+                             MOD_PD_NOTIFICATION_IDX_PRE_SHUTDOWN);
 #endif
 
 /*!
@@ -16,7 +16,9 @@
 #include <fwk_element.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
+#include <fwk_math.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -25,6 +27,9 @@
 #include <fwk_notification.h>
 #include <mod_log.h>
 #include <mod_power_domain.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 
 /*
  * Module and power domain contexts
@@ -54,16 +59,18 @@ struct power_state_transition_notification_ctx {
 
 /* Context for the power state pre-transition notification */
 struct power_state_pre_transition_notification_ctx {
-    /* Number of pending notification responses */
-    unsigned int pending_responses;
+    /*
+     * Flag indicating whether the responses to the notification, collected by
+     * the framework, are pending.
+     */
+    bool pending;
 
     /* Target power state */
     unsigned int state;
 
     /*
-     * Status of the responses received so far. Either FWK_SUCCESS if all the
-     * responses received so far have indicated success, or FWK_E_DEVICE
-     * otherwise.
+     * Status of the responses. Either FWK_SUCCESS if all the responses have
+     * indicated success or are pending, or FWK_E_DEVICE otherwise.
      */
     int response_status;
 
@@ -106,24 +113,43 @@ struct pd_ctx {
     /* Size of the table of allowed state masks */
     size_t allowed_state_mask_table_size;
 
+    /*
+     * Table of the valid composite states targeting the power domain, in
+     * increasing order. Built for the core power domains only. Equal to NULL
+     * if the composite states are validated level by level.
+     */
+    uint32_t *valid_composite_state_table;
+
+    /* Number of entries of the table of valid composite states */
+    unsigned int valid_composite_state_count;
+
     /* Pointer to the power domain's parent context */
     struct pd_ctx *parent;
 
     /*
      * Pointer to the context of the power domain's first child. This
      * field is equal to NULL if the power domain does not have any children.
+     * The power domains being sorted by tree position in the table of power
+     * domain contexts, the children of a power domain are contiguous in the
+     * table.
      */
     struct pd_ctx *first_child;
 
+    /* Number of children of the power domain */
+    unsigned int child_count;
+
     /*
-     * Pointer to the context of the power domain sibling in the chain of the
-     * children power domains of their parent.
+     * Requested power state for the power domain. Updated through
+     * set_requested_state() only, to keep the masks up to date.
      */
-    struct pd_ctx *sibling;
-
-    /* Requested power state for the power domain */
     unsigned int requested_state;
 
+    /*
+     * Mask of the power states of the power domain allowed by the power states
+     * requested for all its children.
+     */
+    uint32_t children_allowed_state_mask;
+
     /* Last power state requested to the driver for the power domain */
     unsigned int state_requested_to_driver;
 
@@ -143,6 +169,51 @@ struct pd_ctx {
     /* Context for the power state pre-transition notification */
     struct power_state_pre_transition_notification_ctx
         power_state_pre_transition_notification_ctx;
+
+    /*
+     * Table of the statistics of the states of the power domain, indexed by
+     * state. NULL if the statistics are not maintained.
+     */
+    struct mod_pd_state_stats *state_stats_table;
+
+    /* Number of entries of the table of state statistics */
+    unsigned int state_stats_count;
+
+    /* Statistics timestamps and durations, in microseconds */
+    struct {
+        /* Time the current state was entered */
+        uint64_t state_entry;
+
+        /* Time the requested state was requested */
+        uint64_t request;
+
+        /* Time the last pre-transition notification was sent */
+        uint64_t notification;
+
+        /* Time the last driver call returned */
+        uint64_t driver_return;
+
+        /* Time spent waiting for pre-transition notification responses */
+        uint64_t notification_duration;
+
+        /* Time spent in the driver call */
+        uint64_t driver_duration;
+
+        /* The transition to the requested state is being timed */
+        bool timed;
+    } time;
+
+    /* Delay of the transitions to a deeper state, see off_delay_us */
+    struct {
+        /* The alarm of the delay is running */
+        bool armed;
+
+        /* The delay has elapsed, the transition can be initiated */
+        bool elapsed;
+
+        /* Sequence number of the last start of the alarm */
+        uintptr_t sequence;
+    } off_delay;
 };
 
 struct system_suspend_ctx {
@@ -156,6 +227,20 @@ struct system_suspend_ctx {
     unsigned int state;
 };
 
+struct system_shutdown_ctx {
+    /* Flag indicating if the system is being quiesced before a shutdown */
+    bool ongoing;
+
+    /* Type of the system shutdown */
+    enum mod_pd_system_shutdown system_shutdown;
+
+    /* Number of pre-shutdown notification responses still expected */
+    unsigned int pending_responses;
+
+    /* Cookie of the system shutdown request, to respond to it */
+    uint32_t cookie;
+};
+
 struct mod_pd_ctx {
     /* Module configuration data */
     struct mod_power_domain_config *config;
@@ -166,6 +251,28 @@ struct mod_pd_ctx {
     /* Number of power domains */
     unsigned int pd_count;
 
+    /*
+     * Shadow of the current states of the power domains, indexed by power
+     * domain index. Written by the power domain thread only, with one store
+     * per update, it can be read from any context without an event.
+     */
+    volatile unsigned int *current_state_table;
+
+    /*
+     * Shadow of the requested states of the power domains, indexed by power
+     * domain index. Updated through set_requested_state() only.
+     */
+    unsigned int *requested_state_table;
+
+    /*
+     * Masks of the power states of the parents allowed by the power states
+     * requested for the power domains, indexed by power domain index.
+     */
+    uint32_t *parent_allowed_state_mask_table;
+
+    /* Types of the power domains, indexed by power domain index */
+    enum mod_pd_type *type_table;
+
     /* Log module API */
     const struct mod_log_api *log_api;
 
@@ -174,6 +281,22 @@ struct mod_pd_ctx {
 
     /* System suspend context */
     struct system_suspend_ctx system_suspend;
+
+    /* System shutdown context */
+    struct system_shutdown_ctx system_shutdown;
+
+    #ifndef BUILD_HAS_MULTITHREADING
+    /* Number of queued set state and reset requests not processed yet */
+    unsigned int queued_request_count;
+    #endif
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Timer API used to timestamp the power state transitions */
+    const struct mod_timer_api *timer_api;
+
+    /* Alarm API used to delay the transitions to deeper states */
+    const struct mod_timer_alarm_api *alarm_api;
+    #endif
 };
 
 /*
@@ -188,6 +311,7 @@ enum pd_event_idx {
     PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION,
     PD_EVENT_IDX_SYSTEM_SUSPEND,
     PD_EVENT_IDX_SYSTEM_SHUTDOWN,
+    PD_EVENT_IDX_SET_CHILDREN_STATE,
     PD_EVENT_COUNT
 };
 
@@ -223,6 +347,22 @@ struct pd_set_state_response {
     uint32_t composite_state;
 };
 
+/*
+ * PD_EVENT_IDX_SET_CHILDREN_STATE
+ * Parameters of the set children state request event
+ */
+struct pd_set_children_state_request {
+    /* Mask of the children of the target power domain to set the state of */
+    uint32_t child_mask;
+
+    /*
+     * The composite state that defines the power state that the children have
+     * to be put into and possibly the power states their ancestors have to be
+     * put into.
+     */
+    uint32_t composite_state;
+};
+
 /*
  * PD_EVENT_IDX_GET_STATE
  * Parameters of the get state request event
@@ -290,6 +430,13 @@ static const unsigned int mod_pd_cs_level_state_shift[MOD_PD_LEVEL_COUNT] = {
     MOD_PD_CS_LEVEL_3_STATE_SHIFT
 };
 
+/*
+ * Maximum number of valid composite states of a core power domain for them to
+ * be looked up in a table. Beyond that, the composite states are validated
+ * level by level.
+ */
+#define PD_VALID_COMPOSITE_STATE_COUNT_MAX 64
+
 /*
  * Internal variables
  */
@@ -415,14 +562,50 @@ static bool is_allowed_by_child(const struct pd_ctx *child,
 
 static bool is_allowed_by_children(const struct pd_ctx *pd, unsigned int state)
 {
-    const struct pd_ctx *child;
+    return (pd->children_allowed_state_mask & (UINT32_C(1) << state)) != 0;
+}
 
-    for (child = pd->first_child; child != NULL; child = child->sibling) {
-        if (!is_allowed_by_child(child, state, child->requested_state))
-            return false;
-    }
+/*
+ * Get the index of a power domain, to access the tables of the module context
+ * indexed by power domain index.
+ */
+static unsigned int get_pd_idx(const struct pd_ctx *pd)
+{
+    return pd - mod_pd_ctx.pd_ctx_table;
+}
 
-    return true;
+/*
+ * Set the requested power state of a power domain and update the mask of the
+ * power states allowed by its children for its parent.
+ */
+static void set_requested_state(struct pd_ctx *pd, unsigned int state)
+{
+    unsigned int parent_state;
+    unsigned int pd_idx = get_pd_idx(pd);
+    unsigned int child_idx, last_child_idx;
+    uint32_t mask = 0;
+    struct pd_ctx *parent = pd->parent;
+
+    pd->requested_state = state;
+    mod_pd_ctx.requested_state_table[pd_idx] = state;
+
+    if (parent == NULL)
+        return;
+
+    for (parent_state = 0;
+         parent_state < pd->allowed_state_mask_table_size; parent_state++) {
+        if ((pd->allowed_state_mask_table[parent_state] &
+             (UINT32_C(1) << state)) != 0)
+            mask |= UINT32_C(1) << parent_state;
+    }
+    mod_pd_ctx.parent_allowed_state_mask_table[pd_idx] = mask;
+
+    mask = ~UINT32_C(0);
+    child_idx = get_pd_idx(parent->first_child);
+    last_child_idx = child_idx + parent->child_count;
+    for (; child_idx < last_child_idx; child_idx++)
+        mask &= mod_pd_ctx.parent_allowed_state_mask_table[child_idx];
+    parent->children_allowed_state_mask = mask;
 }
 
 static const char *get_state_name(const struct pd_ctx *pd, unsigned int state)
@@ -437,6 +620,87 @@ static const char *get_state_name(const struct pd_ctx *pd, unsigned int state)
         return unknown_name;
 }
 
+/* Functions related to the state statistics */
+
+/*
+ * Get the current time in microseconds, zero if the time is not available.
+ */
+static uint64_t get_time(void)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    fwk_id_t timer_id = mod_pd_ctx.config->stats_timer_id;
+    uint64_t time;
+
+    if (mod_pd_ctx.timer_api == NULL)
+        return 0;
+
+    status = mod_pd_ctx.timer_api->get_time(timer_id, &time);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    return time;
+    #else
+    return 0;
+    #endif
+}
+
+static struct mod_pd_state_stats *get_state_stats(const struct pd_ctx *pd,
+                                                  unsigned int state)
+{
+    if (state >= pd->state_stats_count)
+        return NULL;
+
+    return &pd->state_stats_table[state];
+}
+
+/*
+ * Update the statistics of a power domain on the report of a transition.
+ *
+ * \param pd Description of the power domain.
+ * \param previous_state State the power domain has exited.
+ * \param new_state State the power domain has entered.
+ */
+static void update_state_stats(struct pd_ctx *pd, unsigned int previous_state,
+                               unsigned int new_state)
+{
+    uint64_t now, latency;
+    struct mod_pd_state_stats *stats;
+
+    if (pd->state_stats_table == NULL)
+        return;
+
+    now = get_time();
+
+    stats = get_state_stats(pd, previous_state);
+    if (stats != NULL)
+        stats->residency += now - pd->time.state_entry;
+    pd->time.state_entry = now;
+
+    stats = get_state_stats(pd, new_state);
+    if (stats == NULL)
+        return;
+
+    stats->entry_count++;
+
+    /* Only the transitions to the requested state are timed */
+    if (!pd->time.timed || (new_state != pd->requested_state) ||
+        (new_state != pd->state_requested_to_driver))
+        return;
+
+    pd->time.timed = false;
+
+    latency = now - pd->time.request;
+
+    stats->transition_count++;
+    stats->latency_total += latency;
+    if (latency > stats->latency_max)
+        stats->latency_max = (latency > UINT32_MAX) ? UINT32_MAX : latency;
+    stats->notification_time_total += pd->time.notification_duration;
+    stats->driver_time_total += pd->time.driver_duration;
+    stats->report_wait_time_total += now - pd->time.driver_return;
+}
+
 /* Functions related to a composite state */
 static unsigned int get_level_state_from_composite_state(
     uint32_t composite_state, enum mod_pd_level level)
@@ -452,6 +716,55 @@ static enum mod_pd_level get_highest_level_from_composite_state(
                               MOD_PD_CS_STATE_MASK);
 }
 
+/*
+ * Mask of the bits of a composite state that are relevant for a power domain:
+ * the highest level and the states from the level of the power domain up to
+ * the highest level.
+ */
+static uint32_t get_composite_state_mask(enum mod_pd_level level,
+                                         enum mod_pd_level highest_level)
+{
+    uint32_t mask = (uint32_t)MOD_PD_CS_STATE_MASK << MOD_PD_CS_LEVEL_SHIFT;
+
+    for (; level <= highest_level; level++)
+        mask |= (uint32_t)MOD_PD_CS_STATE_MASK <<
+                mod_pd_cs_level_state_shift[level];
+
+    return mask;
+}
+
+/*
+ * Look up a composite state in the table of the valid composite states of a
+ * power domain.
+ */
+static bool find_valid_composite_state(const struct pd_ctx *pd,
+                                       uint32_t composite_state)
+{
+    unsigned int min_idx = 0;
+    unsigned int max_idx_plus_one = pd->valid_composite_state_count;
+    unsigned int middle_idx;
+    uint32_t entry;
+
+    /* The states of the levels outside of the composite state are ignored */
+    composite_state &= get_composite_state_mask(
+        get_level_from_tree_pos(pd->config->tree_pos),
+        get_highest_level_from_composite_state(composite_state));
+
+    while (min_idx < max_idx_plus_one) {
+        middle_idx = (min_idx + max_idx_plus_one) / 2;
+        entry = pd->valid_composite_state_table[middle_idx];
+        if (entry == composite_state)
+            return true;
+
+        if (entry > composite_state)
+            max_idx_plus_one = middle_idx;
+        else
+            min_idx = middle_idx + 1;
+    }
+
+    return false;
+}
+
 static bool is_valid_composite_state(struct pd_ctx *target_pd,
                                      uint32_t composite_state)
 {
@@ -473,6 +786,13 @@ static bool is_valid_composite_state(struct pd_ctx *target_pd,
         (highest_level >= MOD_PD_LEVEL_COUNT))
         goto error;
 
+    if (pd->valid_composite_state_table != NULL) {
+        if (!find_valid_composite_state(pd, composite_state))
+            goto error;
+
+        return true;
+    }
+
     for (; level <= highest_level; level++) {
         if (pd == NULL)
             goto error;
@@ -492,7 +812,7 @@ static bool is_valid_composite_state(struct pd_ctx *target_pd,
     return true;
 
 error:
-    mod_pd_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+    MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR,
         "[PD] Invalid composite state for %s: 0x%08x\n",
         fwk_module_get_name(target_pd->id), composite_state);
     return false;
@@ -530,6 +850,98 @@ static bool is_upwards_transition_propagation(const struct pd_ctx *lowest_pd,
     return false;
 }
 
+/*
+ * Enumerate the valid composite states targeting a power domain.
+ *
+ * \param pd Power domain at level 'level' of the composite states being built.
+ * \param level Level of 'pd'.
+ * \param composite_state States of the levels below 'level'.
+ * \param child Power domain at the level below 'level', NULL at the level of
+ *      the target power domain.
+ * \param child_state State of 'child' in the composite states being built.
+ * \param table Table to store the composite states into, NULL to only count
+ *      them.
+ * \param count Number of composite states enumerated so far.
+ *
+ * \return Number of composite states enumerated so far.
+ */
+static unsigned int enumerate_valid_composite_states(const struct pd_ctx *pd,
+    enum mod_pd_level level, uint32_t composite_state,
+    const struct pd_ctx *child, unsigned int child_state, uint32_t *table,
+    unsigned int count)
+{
+    unsigned int state;
+    uint32_t level_composite_state;
+
+    for (state = 0; state < MOD_PD_STATE_COUNT_MAX; state++) {
+        if (!is_valid_state(pd, state))
+            continue;
+
+        if ((child != NULL) && !is_allowed_by_child(child, state, child_state))
+            continue;
+
+        level_composite_state = composite_state |
+            (state << mod_pd_cs_level_state_shift[level]);
+
+        if ((table != NULL) && (count < PD_VALID_COMPOSITE_STATE_COUNT_MAX)) {
+            table[count] = level_composite_state |
+                ((uint32_t)level << MOD_PD_CS_LEVEL_SHIFT);
+        }
+        count++;
+
+        if ((pd->parent != NULL) && ((level + 1) < MOD_PD_LEVEL_COUNT)) {
+            count = enumerate_valid_composite_states(pd->parent, level + 1,
+                level_composite_state, pd, state, table, count);
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Sub-routine of 'pd_post_init()', to build the tables of the valid composite
+ * states of the core power domains.
+ */
+static int build_valid_composite_state_tables(void)
+{
+    unsigned int index, count, i, j;
+    struct pd_ctx *pd;
+    enum mod_pd_level level;
+    uint32_t *table;
+    uint32_t entry;
+
+    for (index = 0; index < mod_pd_ctx.pd_count; index++) {
+        pd = &mod_pd_ctx.pd_ctx_table[index];
+        if (pd->config->attributes.pd_type != MOD_PD_TYPE_CORE)
+            continue;
+
+        level = get_level_from_tree_pos(pd->config->tree_pos);
+        count = enumerate_valid_composite_states(pd, level, 0, NULL, 0, NULL,
+                                                 0);
+        if ((count == 0) || (count > PD_VALID_COMPOSITE_STATE_COUNT_MAX))
+            continue;
+
+        table = fwk_mm_alloc(count, sizeof(table[0]));
+        if (table == NULL)
+            return FWK_E_NOMEM;
+
+        enumerate_valid_composite_states(pd, level, 0, NULL, 0, table, 0);
+
+        /* Sort the table to look the composite states up by bisection */
+        for (i = 1; i < count; i++) {
+            entry = table[i];
+            for (j = i; (j > 0) && (table[j - 1] > entry); j--)
+                table[j] = table[j - 1];
+            table[j] = entry;
+        }
+
+        pd->valid_composite_state_table = table;
+        pd->valid_composite_state_count = count;
+    }
+
+    return FWK_SUCCESS;
+}
+
 /* Sub-routine of 'pd_post_init()', to build the power domain tree */
 static int build_pd_tree(void)
 {
@@ -539,8 +951,6 @@ static int build_pd_tree(void)
     uint64_t parent_tree_pos;
     uint64_t last_parent_tree_pos;
     struct pd_ctx *parent = NULL;
-    struct pd_ctx *child;
-    struct pd_ctx *prev_sibling;
 
     last_parent_tree_pos = 0; /* Impossible value for a parent position */
     for (index = 0; index < mod_pd_ctx.pd_count; index++) {
@@ -552,6 +962,7 @@ static int build_pd_tree(void)
             last_parent_tree_pos = parent_tree_pos;
         }
         pd->parent = parent;
+        pd->children_allowed_state_mask = ~UINT32_C(0);
 
         if (parent == NULL) {
             if (index == (mod_pd_ctx.pd_count - 1))
@@ -561,24 +972,16 @@ static int build_pd_tree(void)
         }
 
         /*
-         * Update the list of children of the power domain parent. The children
-         * are in increasing order of their identifier in the chain of children.
+         * Update the range of children of the power domain parent. The power
+         * domains being in increasing order of their position, the children
+         * of a power domain follow each other in the table.
          */
-        child = parent->first_child;
-        prev_sibling = NULL;
-
-        while ((child != NULL) && (child->config->tree_pos < tree_pos)) {
-            prev_sibling = child;
-            child = child->sibling;
-        }
-
-        if (prev_sibling == NULL) {
-            pd->sibling = parent->first_child;
+        if (parent->child_count == 0)
             parent->first_child = pd;
-        } else {
-            pd->sibling = prev_sibling->sibling;
-            prev_sibling->sibling = pd;
-        }
+        else if (pd != (parent->first_child + parent->child_count))
+            return FWK_E_PARAM;
+
+        parent->child_count++;
     }
 
     return FWK_SUCCESS;
@@ -595,7 +998,7 @@ static int build_pd_tree(void)
 static bool is_allowed_by_parent_and_children(struct pd_ctx *pd,
     unsigned int state)
 {
-    struct pd_ctx *parent, *child;
+    struct pd_ctx *parent, *child, *last_child;
 
     parent = pd->parent;
     if (parent != NULL) {
@@ -603,11 +1006,10 @@ static bool is_allowed_by_parent_and_children(struct pd_ctx *pd,
             return false;
     }
 
-    child = pd->first_child;
-    while (child != NULL) {
+    last_child = pd->first_child + pd->child_count;
+    for (child = pd->first_child; child < last_child; child++) {
         if (!is_allowed_by_child(child, state, child->current_state))
             return false;
-        child = child->sibling;
     }
 
     return true;
@@ -638,24 +1040,89 @@ static bool check_power_state_pre_transition_notification(struct pd_ctx *pd,
     return true;
 }
 
+/*
+ * Check whether the transition of a power domain to its requested state has to
+ * be delayed, and start the delay if it is not running yet.
+ *
+ * \param pd Description of the power domain.
+ *
+ * \retval true The transition is delayed.
+ * \retval false The transition can be initiated.
+ */
+static bool delay_power_state_transition(struct pd_ctx *pd)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+
+    if ((pd->config->off_delay_us == 0) || pd->off_delay.elapsed)
+        return false;
+
+    if (!is_deeper_state(pd->requested_state, pd->state_requested_to_driver))
+        return false;
+
+    if (pd->off_delay.armed)
+        return true;
+
+    status = mod_pd_ctx.alarm_api->start_us(pd->config->off_delay_alarm_id,
+        pd->config->off_delay_us, MOD_TIMER_ALARM_TYPE_ONCE, NULL,
+        ++pd->off_delay.sequence);
+    if (status != FWK_SUCCESS) {
+        MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR, driver_error_msg,
+            status, __func__, __LINE__);
+        return false;
+    }
+
+    pd->off_delay.armed = true;
+
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+/*
+ * Cancel the delay of the transition of a power domain to a deeper state, if
+ * any, following a change of its requested state.
+ *
+ * \param pd Description of the power domain.
+ */
+static void cancel_power_state_transition_delay(struct pd_ctx *pd)
+{
+    pd->off_delay.elapsed = false;
+
+    if (!pd->off_delay.armed)
+        return;
+
+    pd->off_delay.armed = false;
+
+    #if BUILD_HAS_MOD_TIMER
+    mod_pd_ctx.alarm_api->stop(pd->config->off_delay_alarm_id);
+    #endif
+}
+
 /*
  * Initiate a power state pre-transition notification if necessary.
  *
  * \param pd Description of the power domain to initiate the notification
  *      for.
  *
- * \retval true Waiting for notification responses.
+ * \retval true Waiting for notification responses or for the delay before
+ *      the transition.
  * \retval false Not waiting for any notification response.
  */
 static bool initiate_power_state_pre_transition_notification(struct pd_ctx *pd)
 {
     unsigned int state;
+    unsigned int notification_count = 0;
     struct fwk_event notification_event = {
         .id = mod_pd_notification_id_power_state_pre_transition,
         .response_requested = true
     };
     struct mod_pd_power_state_pre_transition_notification_params *params;
 
+    if (delay_power_state_transition(pd))
+        return true;
+
     state = pd->requested_state;
     if (!check_power_state_pre_transition_notification(pd, state))
         return false;
@@ -664,23 +1131,39 @@ static bool initiate_power_state_pre_transition_notification(struct pd_ctx *pd)
      * If still waiting for some responses on the previous power state
      * pre-transition notification, wait for them before to issue the next one.
      */
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses != 0)
+    if (pd->power_state_pre_transition_notification_ctx.pending)
         return true;
 
     params = (struct mod_pd_power_state_pre_transition_notification_params *)
         notification_event.params;
     params->current_state = pd->current_state;
     params->target_state = state;
-    fwk_notification_notify(&notification_event,
-        &pd->power_state_pre_transition_notification_ctx.pending_responses);
 
     pd->power_state_pre_transition_notification_ctx.state = state;
     pd->power_state_pre_transition_notification_ctx.response_status =
         FWK_SUCCESS;
     pd->power_state_pre_transition_notification_ctx.valid = true;
 
-    return (pd->power_state_pre_transition_notification_ctx.pending_responses
-            != 0);
+    /*
+     * None of the subscribers can deny the transition, they are notified
+     * without waiting for them before to initiate the transition.
+     */
+    if ((pd->config->pre_transition_observe_only_state_mask &
+         (UINT32_C(1) << state)) != 0) {
+        notification_event.response_requested = false;
+        fwk_notification_notify(&notification_event, &notification_count);
+
+        return false;
+    }
+
+    fwk_notification_notify_collect(&notification_event, &notification_count);
+    if (pd->state_stats_table != NULL)
+        pd->time.notification = get_time();
+
+    pd->power_state_pre_transition_notification_ctx.pending =
+        (notification_count != 0);
+
+    return pd->power_state_pre_transition_notification_ctx.pending;
 }
 
 /*
@@ -700,17 +1183,27 @@ static int initiate_power_state_transition(struct pd_ctx *pd)
 
     if ((pd->driver_api->deny != NULL) &&
         pd->driver_api->deny(pd->driver_id, state)) {
-        mod_pd_ctx.log_api->log(MOD_LOG_GROUP_WARNING,
+        MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_WARNING,
             "[PD] Transition of %s to state <%s>,\n",
             fwk_module_get_name(pd->id), get_state_name(pd, state));
-        mod_pd_ctx.log_api->log(MOD_LOG_GROUP_WARNING,
+        MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_WARNING,
             "\tdenied by driver.\n");
         return FWK_E_DEVICE;
     }
 
+    if (pd->state_stats_table != NULL)
+        pd->time.driver_return = get_time();
+
+    pd->off_delay.elapsed = false;
+
     status = pd->driver_api->set_state(pd->driver_id, state);
 
-    mod_pd_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+    if (pd->state_stats_table != NULL) {
+        pd->time.driver_duration = get_time() - pd->time.driver_return;
+        pd->time.driver_return += pd->time.driver_duration;
+    }
+
+    MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_DEBUG,
         "[PD] %s: %s->%s, %e\n", fwk_module_get_name(pd->id),
         get_state_name(pd, pd->state_requested_to_driver),
         get_state_name(pd, state), status);
@@ -827,8 +1320,14 @@ static void process_set_state_request(struct pd_ctx *lowest_pd,
          * A new valid power state is requested for the power domain. Send any
          * pending response concerning the previous requested power state.
          */
-        pd->requested_state = state;
+        set_requested_state(pd, state);
         pd->power_state_pre_transition_notification_ctx.valid = false;
+        cancel_power_state_transition_delay(pd);
+        if (pd->state_stats_table != NULL) {
+            pd->time.request = get_time();
+            pd->time.notification_duration = 0;
+            pd->time.timed = true;
+        }
         respond(pd, FWK_E_OVERWRITTEN);
 
         if (pd->state_requested_to_driver == state)
@@ -888,16 +1387,111 @@ static void process_set_state_request(struct pd_ctx *lowest_pd,
     }
 }
 
-/*
- * Complete a system suspend
- *
- * Following the shutdown of the last standing core put all of its ancestors
- * in the MOD_PD_STATE_OFF state but the system power domain which is put
- * into the state that has been asked for.
- *
- * target_pd Description of the power domain target of the 'set composite state'
- *     request to suspend the system in the desired state.
- */
+/*
+ * Process a 'set children state' request
+ *
+ * \param parent_pd Description of the parent of the power domains target of
+ *      the request
+ * \param req_params Parameters of the 'set children state' request
+ */
+static void process_set_children_state_request(struct pd_ctx *parent_pd,
+    const struct pd_set_children_state_request *req_params)
+{
+    struct pd_ctx *child, *last_child;
+    unsigned int child_idx;
+    struct pd_set_state_request child_req_params = {
+        .composite_state = req_params->composite_state,
+    };
+    struct fwk_event child_resp_event = {
+        .response_requested = false,
+    };
+
+    /*
+     * The children are processed one after the other within the processing of
+     * this event. The ancestors are left in their current state until all the
+     * children target of the request have been put into a compatible state,
+     * so their transition is evaluated only once.
+     */
+    last_child = parent_pd->first_child + parent_pd->child_count;
+    for (child = parent_pd->first_child, child_idx = 0; child < last_child;
+         child++, child_idx++) {
+        if (child_idx >= 32)
+            break;
+
+        if ((req_params->child_mask & (UINT32_C(1) << child_idx)) == 0)
+            continue;
+
+        process_set_state_request(child, &child_req_params,
+                                  &child_resp_event);
+    }
+}
+
+/*
+ * Complete a system suspend
+ *
+ * Following the shutdown of the last standing core put all of its ancestors
+ * in the MOD_PD_STATE_OFF state but the system power domain which is put
+ * into the state that has been asked for.
+ *
+ * target_pd Description of the power domain target of the 'set composite state'
+ *     request to suspend the system in the desired state.
+ */
+#ifndef BUILD_HAS_MULTITHREADING
+/*
+ * Check if a 'set state' request can be processed when it is made rather than
+ * queued. This is the case of the wake-up of a core whose ancestors are
+ * already settled in the states of the requested composite state, when no
+ * other request is waiting for processing. The processing then consists of a
+ * single driver call.
+ *
+ * \param pd Description of the target of the 'set state' request
+ * \param composite_state Requested composite state
+ *
+ * \retval true The request can be processed immediately.
+ * \retval false The request has to be queued.
+ */
+static bool is_fast_core_on_request(const struct pd_ctx *pd,
+                                    uint32_t composite_state)
+{
+    enum mod_pd_level level, highest_level;
+    unsigned int state;
+    unsigned int interrupt;
+
+    if ((mod_pd_ctx.queued_request_count != 0) ||
+        mod_pd_ctx.system_suspend.ongoing)
+        return false;
+
+    /* The requests made from an interrupt handler are always queued */
+    if (fwk_interrupt_get_current(&interrupt) != FWK_E_STATE)
+        return false;
+
+    if ((pd->config->attributes.pd_type != MOD_PD_TYPE_CORE) ||
+        (pd->requested_state == MOD_PD_STATE_ON) ||
+        (pd->current_state != pd->requested_state) ||
+        (pd->state_requested_to_driver != pd->requested_state) ||
+        pd->response.pending ||
+        pd->power_state_pre_transition_notification_ctx.pending)
+        return false;
+
+    level = get_level_from_tree_pos(pd->config->tree_pos);
+    if (get_level_state_from_composite_state(composite_state, level) !=
+        MOD_PD_STATE_ON)
+        return false;
+
+    highest_level = get_highest_level_from_composite_state(composite_state);
+    for (level++, pd = pd->parent; level <= highest_level;
+         level++, pd = pd->parent) {
+        state = get_level_state_from_composite_state(composite_state, level);
+        if ((state != pd->requested_state) ||
+            (state != pd->current_state) ||
+            (state != pd->state_requested_to_driver))
+            return false;
+    }
+
+    return true;
+}
+#endif
+
 static int complete_system_suspend(struct pd_ctx *target_pd)
 {
     enum mod_pd_level level;
@@ -936,6 +1530,15 @@ static int complete_system_suspend(struct pd_ctx *target_pd)
     return resp_params->status;
 }
 
+/*
+ * Set the current state of a power domain and its shadow.
+ */
+static void set_current_state(struct pd_ctx *pd, unsigned int state)
+{
+    pd->current_state = state;
+    mod_pd_ctx.current_state_table[get_pd_idx(pd)] = state;
+}
+
 /*
  * Process a 'get composite state' request.
  *
@@ -986,18 +1589,22 @@ static void process_reset_request(struct pd_ctx *pd,
                                   struct pd_response *resp_params)
 {
     int status;
-    struct pd_ctx *child;
+    unsigned int child_idx, last_child_idx;
 
     status = FWK_E_PWRSTATE;
     if (pd->requested_state == MOD_PD_STATE_OFF)
         goto exit;
 
-    child = pd->first_child;
-    while (child != NULL) {
-        if ((child->requested_state != MOD_PD_STATE_OFF) ||
-            (child->current_state != MOD_PD_STATE_OFF))
-            goto exit;
-        child = child->sibling;
+    if (pd->child_count != 0) {
+        child_idx = get_pd_idx(pd->first_child);
+        last_child_idx = child_idx + pd->child_count;
+        for (; child_idx < last_child_idx; child_idx++) {
+            if ((mod_pd_ctx.requested_state_table[child_idx] !=
+                 MOD_PD_STATE_OFF) ||
+                (mod_pd_ctx.current_state_table[child_idx] !=
+                 MOD_PD_STATE_OFF))
+                goto exit;
+        }
     }
 
     status = pd->driver_api->reset(pd->driver_id);
@@ -1016,11 +1623,12 @@ static void process_power_state_transition_report_deeper_state(
     struct pd_ctx *pd)
 {
     struct pd_ctx *parent = pd->parent;
-    unsigned int requested_state = parent->requested_state;
+    unsigned int requested_state;
 
     if (parent == NULL)
         return;
 
+    requested_state = parent->requested_state;
     if (parent->state_requested_to_driver == requested_state)
         return;
 
@@ -1040,10 +1648,11 @@ static void process_power_state_transition_report_deeper_state(
 static void process_power_state_transition_report_shallower_state(
     struct pd_ctx *pd)
 {
-    struct pd_ctx *child;
+    struct pd_ctx *child, *last_child;
     unsigned int requested_state;
 
-    for (child = pd->first_child; child != NULL; child = child->sibling) {
+    last_child = pd->first_child + pd->child_count;
+    for (child = pd->first_child; child < last_child; child++) {
         requested_state = child->requested_state;
         if (child->state_requested_to_driver == requested_state)
             continue;
@@ -1067,6 +1676,7 @@ static void process_power_state_transition_report(struct pd_ctx *pd,
 {
     unsigned int new_state = report_params->state;
     unsigned int previous_state;
+    unsigned int notification_count = 0;
     struct fwk_event notification_event = {
         .id = mod_pd_notification_id_power_state_transition,
         .response_requested = true
@@ -1077,12 +1687,29 @@ static void process_power_state_transition_report(struct pd_ctx *pd,
         respond(pd, FWK_SUCCESS);
 
     previous_state = pd->current_state;
-    pd->current_state = new_state;
+    set_current_state(pd, new_state);
 
-    if (pd->power_state_transition_notification_ctx.pending_responses == 0) {
-        params = (struct mod_pd_power_state_transition_notification_params *)
-            notification_event.params;
-        params->state = new_state;
+    update_state_stats(pd, previous_state, new_state);
+
+    params = (struct mod_pd_power_state_transition_notification_params *)
+        notification_event.params;
+    params->state = new_state;
+
+    if ((pd->config->transition_observe_only_state_mask &
+         (UINT32_C(1) << new_state)) != 0) {
+        /*
+         * The transitions that follow do not wait for the subscribers. The
+         * responses still expected for a previous notification, if any, then
+         * complete as if they had been sent for the new state, and do not
+         * complete the transition report a second time.
+         */
+        notification_event.response_requested = false;
+        fwk_notification_notify(&notification_event, &notification_count);
+
+        pd->power_state_transition_notification_ctx.state = new_state;
+        pd->power_state_transition_notification_ctx.previous_state = new_state;
+    } else if (
+        pd->power_state_transition_notification_ctx.pending_responses == 0) {
         pd->power_state_transition_notification_ctx.state = new_state;
         fwk_notification_notify(&notification_event,
             &pd->power_state_transition_notification_ctx.pending_responses);
@@ -1098,7 +1725,8 @@ static void process_power_state_transition_report(struct pd_ctx *pd,
      * If notifications are pending, the transition report is delayed until all
      * the state change notifications responses have arrived.
      */
-    if (pd->power_state_transition_notification_ctx.pending_responses > 0) {
+    if ((notification_event.response_requested) &&
+        (pd->power_state_transition_notification_ctx.pending_responses > 0)) {
          /*
           * Save previous state which will be used once all the notifications
           * have arrived to continue for deeper or shallower state for the next
@@ -1116,6 +1744,34 @@ static void process_power_state_transition_report(struct pd_ctx *pd,
         process_power_state_transition_report_shallower_state(pd);
 }
 
+#if BUILD_HAS_MOD_TIMER
+/*
+ * Process the expiry of the delay before the transition of a power domain to a
+ * deeper state.
+ *
+ * \param pd Description of the power domain
+ * \param alarm_params Parameters of the alarm event
+ */
+static void process_off_delay_alarm(struct pd_ctx *pd,
+    const struct mod_timer_alarm_event_params *alarm_params)
+{
+    /* Ignore the alarms of the delays cancelled in the meantime */
+    if (!pd->off_delay.armed ||
+        (alarm_params->param != pd->off_delay.sequence))
+        return;
+
+    pd->off_delay.armed = false;
+    pd->off_delay.elapsed = true;
+
+    if ((pd->requested_state == pd->state_requested_to_driver) ||
+        (!is_allowed_by_parent_and_children(pd, pd->requested_state)))
+        return;
+
+    if (!initiate_power_state_pre_transition_notification(pd))
+        initiate_power_state_transition(pd);
+}
+#endif
+
 /*
  * Process a 'system suspend' request
  *
@@ -1138,18 +1794,18 @@ static void process_system_suspend_request(
      * but one core and its ancestors.
      */
     for (pd_idx = 0; pd_idx < mod_pd_ctx.pd_count; pd_idx++) {
-        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
-        if ((pd->requested_state == MOD_PD_STATE_OFF) &&
-            (pd->current_state == MOD_PD_STATE_OFF))
+        if ((mod_pd_ctx.requested_state_table[pd_idx] == MOD_PD_STATE_OFF) &&
+            (mod_pd_ctx.current_state_table[pd_idx] == MOD_PD_STATE_OFF))
             continue;
 
-        if (pd->config->attributes.pd_type == MOD_PD_TYPE_CORE) {
+        pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
+        if (mod_pd_ctx.type_table[pd_idx] == MOD_PD_TYPE_CORE) {
             if (last_core_pd != NULL) {
                 resp_params->status = FWK_E_STATE;
                 return;
             }
             last_core_pd = pd;
-        } else if (pd->config->attributes.pd_type == MOD_PD_TYPE_CLUSTER) {
+        } else if (mod_pd_ctx.type_table[pd_idx] == MOD_PD_TYPE_CLUSTER) {
             if (last_cluster_pd != NULL) {
                 resp_params->status = FWK_E_STATE;
                 return;
@@ -1169,8 +1825,8 @@ static void process_system_suspend_request(
             mod_pd_ctx.system_suspend.ongoing = true;
             mod_pd_ctx.system_suspend.last_core_pd = last_core_pd;
             mod_pd_ctx.system_suspend.state = req_params->state;
-            last_core_pd->requested_state =
-                last_core_pd->state_requested_to_driver = MOD_PD_STATE_OFF;
+            set_requested_state(last_core_pd, MOD_PD_STATE_OFF);
+            last_core_pd->state_requested_to_driver = MOD_PD_STATE_OFF;
         }
     }
 
@@ -1178,15 +1834,11 @@ static void process_system_suspend_request(
 }
 
 /*
- * Process a 'system shutdown' request
+ * Shut the power domains down, from the lowest level to the system.
  *
- * req_params Parameters of the 'system shutdown' request
- * resp_params Parameters of the 'system shutdown' request response to be filled
- *     in
+ * \param system_shutdown Type of the system shutdown
  */
-static void process_system_shutdown_request(
-    const struct pd_system_shutdown_request *req_params,
-    struct pd_response *resp_params)
+static void shutdown_power_domains(enum mod_pd_system_shutdown system_shutdown)
 {
     int status;
     unsigned int pd_idx;
@@ -1197,29 +1849,143 @@ static void process_system_shutdown_request(
         pd = &mod_pd_ctx.pd_ctx_table[pd_idx];
         pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, pd_idx);
 
-        mod_pd_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_DEBUG,
             "[PD] Shutting down %s\n", fwk_module_get_name(pd_id));
 
         if (pd->driver_api->shutdown != NULL) {
-            status = pd->driver_api->shutdown(pd->driver_id,
-                                              req_params->system_shutdown);
+            status = pd->driver_api->shutdown(pd->driver_id, system_shutdown);
         } else
             status = pd->driver_api->set_state(pd->driver_id, MOD_PD_STATE_OFF);
 
         if (status != FWK_SUCCESS)
-            mod_pd_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+            MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR,
                 "[PD] Shutdown of %s returned %e\n",
                 fwk_module_get_name(pd_id), status);
         else
-            mod_pd_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+            MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_DEBUG,
                 "[PD] %s shutdown\n", fwk_module_get_name(pd_id));
 
-        pd->requested_state =
-            pd->state_requested_to_driver =
-            pd->current_state = MOD_PD_STATE_OFF;
+        set_requested_state(pd, MOD_PD_STATE_OFF);
+        pd->state_requested_to_driver = MOD_PD_STATE_OFF;
+        set_current_state(pd, MOD_PD_STATE_OFF);
     }
+}
+
+/*
+ * Shut the system down once the subscribers to the pre-shutdown notification
+ * have quiesced, or once they have been given up on, and respond to the
+ * system shutdown request.
+ */
+static void complete_system_shutdown(void)
+{
+    int status;
+    struct fwk_event resp_event;
+    struct pd_response *resp_params =
+        (struct pd_response *)(&resp_event.params);
+
+    mod_pd_ctx.system_shutdown.ongoing = false;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_type(mod_pd_ctx.config->shutdown_alarm_id,
+                       FWK_ID_TYPE_SUB_ELEMENT))
+        mod_pd_ctx.alarm_api->stop(mod_pd_ctx.config->shutdown_alarm_id);
+    #endif
+
+    shutdown_power_domains(mod_pd_ctx.system_shutdown.system_shutdown);
 
+    status = fwk_thread_get_delayed_response(fwk_module_id_power_domain,
+        mod_pd_ctx.system_shutdown.cookie, &resp_event);
+    if (status != FWK_SUCCESS)
+        return;
+
+    /* The shutdown did not happen if this point is reached */
     resp_params->status = FWK_E_PANIC;
+
+    fwk_thread_put_event(&resp_event);
+}
+
+/*
+ * Process a 'system shutdown' request
+ *
+ * The subscribers to the pre-shutdown notification are all notified at once so
+ * that they quiesce their devices in parallel. The response to the request is
+ * delayed until they have all responded, or until the timeout of the
+ * quiescing, if any, expires.
+ *
+ * event 'system shutdown' request event
+ * resp Response event to be filled in
+ */
+static void process_system_shutdown_request(const struct fwk_event *event,
+                                            struct fwk_event *resp)
+{
+    int status;
+    const struct pd_system_shutdown_request *req_params =
+        (struct pd_system_shutdown_request *)event->params;
+    struct pd_response *resp_params = (struct pd_response *)resp->params;
+    struct system_shutdown_ctx *shutdown = &mod_pd_ctx.system_shutdown;
+    struct fwk_event notification_event = {
+        .id = mod_pd_notification_id_pre_shutdown,
+        .response_requested = true
+    };
+    struct mod_pd_pre_shutdown_notification_params *notification_params =
+        (struct mod_pd_pre_shutdown_notification_params *)
+        notification_event.params;
+
+    if (shutdown->ongoing) {
+        resp_params->status = FWK_E_BUSY;
+        return;
+    }
+
+    notification_params->system_shutdown = req_params->system_shutdown;
+    status = fwk_notification_notify(&notification_event,
+                                     &shutdown->pending_responses);
+    if ((status != FWK_SUCCESS) || (shutdown->pending_responses == 0)) {
+        shutdown_power_domains(req_params->system_shutdown);
+        resp_params->status = FWK_E_PANIC;
+        return;
+    }
+
+    shutdown->ongoing = true;
+    shutdown->system_shutdown = req_params->system_shutdown;
+    shutdown->cookie = event->cookie;
+    resp->is_delayed_response = true;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_type(mod_pd_ctx.config->shutdown_alarm_id,
+                       FWK_ID_TYPE_SUB_ELEMENT)) {
+        status = mod_pd_ctx.alarm_api->start(
+            mod_pd_ctx.config->shutdown_alarm_id,
+            mod_pd_ctx.config->shutdown_timeout_ms,
+            MOD_TIMER_ALARM_TYPE_ONCE, NULL, 0);
+        if (status != FWK_SUCCESS) {
+            MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR, driver_error_msg,
+                status, __func__, __LINE__);
+        }
+    }
+    #endif
+}
+
+/*
+ * Process a response to the pre-shutdown notification.
+ */
+static int process_pre_shutdown_notification_response(void)
+{
+    struct system_shutdown_ctx *shutdown = &mod_pd_ctx.system_shutdown;
+
+    /* Late responses, once the quiescing has timed out, are ignored */
+    if (!shutdown->ongoing)
+        return FWK_SUCCESS;
+
+    if (shutdown->pending_responses == 0) {
+        assert(false);
+        return FWK_E_PANIC;
+    }
+
+    shutdown->pending_responses--;
+    if (shutdown->pending_responses == 0)
+        complete_system_shutdown();
+
+    return FWK_SUCCESS;
 }
 
 /*
@@ -1227,6 +1993,26 @@ static void process_system_shutdown_request(
  */
 
 /* Functions common to the public and restricted API */
+/*
+ * Queue a request that may change the state of the power domains.
+ */
+static int put_request(struct fwk_event *req)
+{
+    int status;
+
+    status = fwk_thread_put_event(req);
+
+    #ifndef BUILD_HAS_MULTITHREADING
+    if (status == FWK_SUCCESS) {
+        fwk_interrupt_global_disable();
+        mod_pd_ctx.queued_request_count++;
+        fwk_interrupt_global_enable();
+    }
+    #endif
+
+    return status;
+}
+
 static int pd_get_domain_type(fwk_id_t pd_id, enum mod_pd_type *type)
 {
     int status;
@@ -1271,6 +2057,47 @@ static int pd_get_domain_parent_id(fwk_id_t pd_id, fwk_id_t *parent_pd_id)
     return FWK_SUCCESS;
 }
 
+static int pd_get_current_state(fwk_id_t pd_id, unsigned int *state)
+{
+    if (state == NULL)
+        return FWK_E_PARAM;
+
+    if (!fwk_module_is_valid_element_id(pd_id))
+        return FWK_E_PARAM;
+
+    *state = mod_pd_ctx.current_state_table[fwk_id_get_element_idx(pd_id)];
+
+    return FWK_SUCCESS;
+}
+
+static int pd_get_current_composite_state(fwk_id_t pd_id,
+                                          unsigned int *composite_state)
+{
+    const struct pd_ctx *pd;
+    enum mod_pd_level level;
+    unsigned int state = 0;
+
+    if (composite_state == NULL)
+        return FWK_E_PARAM;
+
+    if (!fwk_module_is_valid_element_id(pd_id))
+        return FWK_E_PARAM;
+
+    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(pd_id)];
+    level = get_level_from_tree_pos(pd->config->tree_pos);
+
+    /* Same traversal as for a 'get composite state' request */
+    do {
+        state |= mod_pd_ctx.current_state_table[get_pd_idx(pd)]
+                 << mod_pd_cs_level_state_shift[level++];
+        pd = pd->parent;
+    } while (pd != NULL);
+
+    *composite_state = state | ((--level) << MOD_PD_CS_LEVEL_SHIFT);
+
+    return FWK_SUCCESS;
+}
+
 /* Functions specific to the restricted API */
 
 static int pd_set_state(fwk_id_t pd_id, unsigned int state)
@@ -1342,7 +2169,7 @@ static int pd_set_state_async(fwk_id_t pd_id,
     req_params->composite_state = (level << MOD_PD_CS_LEVEL_SHIFT) |
                                   (state << mod_pd_cs_level_state_shift[level]);
 
-    return fwk_thread_put_event(&req);
+    return put_request(&req);
 }
 
 static int pd_set_composite_state(fwk_id_t pd_id, uint32_t composite_state)
@@ -1399,6 +2226,20 @@ static int pd_set_composite_state_async(fwk_id_t pd_id,
     if (!is_valid_composite_state(pd, composite_state))
         return FWK_E_PARAM;
 
+    #ifndef BUILD_HAS_MULTITHREADING
+    /*
+     * Wake a core up without the latency of the queuing of the request when
+     * the wake-up amounts to a driver call.
+     */
+    if (!response_requested && is_fast_core_on_request(pd, composite_state)) {
+        req = (struct fwk_event) { .response_requested = false };
+        req_params->composite_state = composite_state;
+        process_set_state_request(pd, req_params, &req);
+
+        return FWK_SUCCESS;
+    }
+    #endif
+
     req = (struct fwk_event) {
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_POWER_DOMAIN, PD_EVENT_IDX_SET_STATE),
         .source_id = pd->driver_id,
@@ -1408,7 +2249,58 @@ static int pd_set_composite_state_async(fwk_id_t pd_id,
 
     req_params->composite_state = composite_state;
 
-    return fwk_thread_put_event(&req);
+    return put_request(&req);
+}
+
+static int pd_set_children_composite_state_async(fwk_id_t parent_pd_id,
+                                                 uint32_t child_mask,
+                                                 uint32_t composite_state)
+{
+    int status;
+    struct pd_ctx *parent_pd, *child, *last_child;
+    unsigned int child_idx;
+    uint32_t remaining_mask;
+    struct fwk_event req;
+    struct pd_set_children_state_request *req_params =
+        (struct pd_set_children_state_request *)(&req.params);
+
+    status = fwk_module_check_call(parent_pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    parent_pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(parent_pd_id)];
+
+    remaining_mask = child_mask;
+    last_child = parent_pd->first_child + parent_pd->child_count;
+    for (child = parent_pd->first_child, child_idx = 0;
+         (child < last_child) && (remaining_mask != 0);
+         child++, child_idx++) {
+        if ((remaining_mask & (UINT32_C(1) << child_idx)) == 0)
+            continue;
+
+        if (!is_valid_composite_state(child, composite_state))
+            return FWK_E_PARAM;
+
+        remaining_mask &= ~(UINT32_C(1) << child_idx);
+    }
+
+    /*
+     * The mask must be non-null and reference only children of the parent
+     * power domain.
+     */
+    if ((child_mask == 0) || (remaining_mask != 0))
+        return FWK_E_PARAM;
+
+    req = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_POWER_DOMAIN,
+                           PD_EVENT_IDX_SET_CHILDREN_STATE),
+        .target_id = parent_pd_id,
+    };
+
+    req_params->child_mask = child_mask;
+    req_params->composite_state = composite_state;
+
+    return put_request(&req);
 }
 
 static int pd_get_state(fwk_id_t pd_id, unsigned int *state)
@@ -1483,6 +2375,34 @@ static int pd_get_composite_state(fwk_id_t pd_id, unsigned int *composite_state)
     return FWK_SUCCESS;
 }
 
+static int pd_get_state_stats(fwk_id_t pd_id, unsigned int state,
+                              struct mod_pd_state_stats *stats)
+{
+    int status;
+    struct pd_ctx *pd;
+    const struct mod_pd_state_stats *state_stats;
+
+    status = fwk_module_check_call(pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(pd_id)];
+
+    if (pd->state_stats_table == NULL)
+        return FWK_E_SUPPORT;
+
+    if ((stats == NULL) || !is_valid_state(pd, state))
+        return FWK_E_PARAM;
+
+    state_stats = get_state_stats(pd, state);
+    if (state_stats == NULL)
+        return FWK_E_PARAM;
+
+    *stats = *state_stats;
+
+    return FWK_SUCCESS;
+}
+
 static int pd_reset(fwk_id_t pd_id)
 {
     int status;
@@ -1583,7 +2503,7 @@ static int pd_reset_async(fwk_id_t pd_id, bool response_requested)
         .response_requested = response_requested,
     };
 
-    return fwk_thread_put_event(&req);
+    return put_request(&req);
 }
 
 static int report_power_state_transition(const struct pd_ctx *pd,
@@ -1597,7 +2517,8 @@ static int report_power_state_transition(const struct pd_ctx *pd,
         .source_id = pd->driver_id,
         .target_id = pd->id,
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_POWER_DOMAIN,
-                           PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION)
+                           PD_EVENT_IDX_REPORT_POWER_STATE_TRANSITION),
+        .priority = FWK_EVENT_PRIORITY_HIGH,
     };
     report_params->state = state;
 
@@ -1623,18 +2544,25 @@ static int pd_report_power_state_transition(fwk_id_t pd_id, unsigned int state)
 static const struct mod_pd_public_api pd_public_api = {
     .get_domain_type = pd_get_domain_type,
     .get_domain_parent_id = pd_get_domain_parent_id,
+    .get_current_state = pd_get_current_state,
+    .get_current_composite_state = pd_get_current_composite_state,
 };
 
 static const struct mod_pd_restricted_api pd_restricted_api = {
     .get_domain_type = pd_get_domain_type,
     .get_domain_parent_id = pd_get_domain_parent_id,
+    .get_current_state = pd_get_current_state,
+    .get_current_composite_state = pd_get_current_composite_state,
 
     .set_state = pd_set_state,
     .set_state_async = pd_set_state_async,
     .set_composite_state = pd_set_composite_state,
     .set_composite_state_async = pd_set_composite_state_async,
+    .set_children_composite_state_async =
+        pd_set_children_composite_state_async,
     .get_state = pd_get_state,
     .get_composite_state = pd_get_composite_state,
+    .get_state_stats = pd_get_state_stats,
     .reset = pd_reset,
     .system_suspend = pd_system_suspend,
     .system_shutdown = pd_system_shutdown
@@ -1653,6 +2581,15 @@ static const struct mod_pd_driver_input_api pd_driver_input_api = {
 static int pd_init(fwk_id_t module_id, unsigned int dev_count,
                    const void *data)
 {
+    int status;
+    void *table_table[4];
+    const size_t entry_size_table[] = {
+        sizeof(mod_pd_ctx.current_state_table[0]),
+        sizeof(mod_pd_ctx.requested_state_table[0]),
+        sizeof(mod_pd_ctx.parent_allowed_state_mask_table[0]),
+        sizeof(mod_pd_ctx.type_table[0]),
+    };
+
     if ((data == NULL) || (dev_count == 0))
         return FWK_E_PARAM;
 
@@ -1666,9 +2603,34 @@ static int pd_init(fwk_id_t module_id, unsigned int dev_count,
     if (mod_pd_ctx.pd_ctx_table == NULL)
         return FWK_E_NOMEM;
 
+    /*
+     * The fields scanned over several power domains are kept in tables
+     * allocated together, away from the power domain contexts.
+     */
+    status = fwk_mm_calloc_hot_tables(dev_count, entry_size_table,
+                                      table_table,
+                                      FWK_ARRAY_SIZE(table_table));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    mod_pd_ctx.current_state_table = table_table[0];
+    mod_pd_ctx.requested_state_table = table_table[1];
+    mod_pd_ctx.parent_allowed_state_mask_table = table_table[2];
+    mod_pd_ctx.type_table = table_table[3];
+
     mod_pd_ctx.pd_count = dev_count;
     mod_pd_ctx.system_pd_ctx = &mod_pd_ctx.pd_ctx_table[dev_count - 1];
 
+    /* The transitions are timestamped with a timer */
+    #if !BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_type(mod_pd_ctx.config->stats_timer_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_SUPPORT;
+
+    if (fwk_id_is_type(mod_pd_ctx.config->shutdown_alarm_id,
+                       FWK_ID_TYPE_SUB_ELEMENT))
+        return FWK_E_SUPPORT;
+    #endif
+
     return fwk_thread_create(module_id);
 }
 
@@ -1704,6 +2666,12 @@ static int pd_power_domain_init(fwk_id_t pd_id, unsigned int unused,
         (pd_config->allowed_state_mask_table_size == 0))
         return FWK_E_PARAM;
 
+    /* The transitions are delayed with an alarm */
+    #if !BUILD_HAS_MOD_TIMER
+    if (pd_config->off_delay_us != 0)
+        return FWK_E_SUPPORT;
+    #endif
+
     pd->allowed_state_mask_table = pd_config->allowed_state_mask_table;
     pd->allowed_state_mask_table_size =
         pd_config->allowed_state_mask_table_size;
@@ -1711,8 +2679,20 @@ static int pd_power_domain_init(fwk_id_t pd_id, unsigned int unused,
     for (state = 0; state < pd->allowed_state_mask_table_size; state++)
         pd->valid_state_mask |= pd->allowed_state_mask_table[state];
 
+    if (fwk_id_is_type(mod_pd_ctx.config->stats_timer_id,
+                       FWK_ID_TYPE_ELEMENT) &&
+        (pd->valid_state_mask != 0)) {
+        pd->state_stats_count = fwk_math_log2(pd->valid_state_mask) + 1;
+        pd->state_stats_table = fwk_mm_calloc(pd->state_stats_count,
+                                              sizeof(pd->state_stats_table[0]));
+        if (pd->state_stats_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
     pd->id = pd_id;
     pd->config = pd_config;
+    mod_pd_ctx.type_table[fwk_id_get_element_idx(pd_id)] =
+        pd_config->attributes.pd_type;
 
     return FWK_SUCCESS;
 }
@@ -1725,7 +2705,7 @@ static int pd_post_init(fwk_id_t module_id)
     if (status != FWK_SUCCESS)
         return status;
 
-    return FWK_SUCCESS;
+    return build_valid_composite_state_tables();
 }
 
 static int pd_bind(fwk_id_t id, unsigned int round)
@@ -1740,8 +2720,28 @@ static int pd_bind(fwk_id_t id, unsigned int round)
         return FWK_SUCCESS;
 
     if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
-        return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+        status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
             FWK_ID_API(FWK_MODULE_IDX_LOG, 0), &mod_pd_ctx.log_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        #if BUILD_HAS_MOD_TIMER
+        if (fwk_id_is_type(mod_pd_ctx.config->stats_timer_id,
+                           FWK_ID_TYPE_ELEMENT)) {
+            status = fwk_module_bind(mod_pd_ctx.config->stats_timer_id,
+                MOD_TIMER_API_ID_TIMER, &mod_pd_ctx.timer_api);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+
+        if (fwk_id_is_type(mod_pd_ctx.config->shutdown_alarm_id,
+                           FWK_ID_TYPE_SUB_ELEMENT)) {
+            return fwk_module_bind(mod_pd_ctx.config->shutdown_alarm_id,
+                MOD_TIMER_API_ID_ALARM, &mod_pd_ctx.alarm_api);
+        }
+        #endif
+
+        return FWK_SUCCESS;
     }
 
     pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(id)];
@@ -1761,6 +2761,13 @@ static int pd_bind(fwk_id_t id, unsigned int round)
 
     pd->driver_api = driver_api;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (config->off_delay_us != 0) {
+        return fwk_module_bind(config->off_delay_alarm_id,
+            MOD_TIMER_API_ID_ALARM, &mod_pd_ctx.alarm_api);
+    }
+    #endif
+
     return FWK_SUCCESS;
 }
 
@@ -1777,9 +2784,9 @@ static int pd_start(fwk_id_t id)
 
     for (index = mod_pd_ctx.pd_count - 1; index >= 0; index--) {
         pd = &mod_pd_ctx.pd_ctx_table[index];
-        pd->requested_state = MOD_PD_STATE_OFF;
+        set_requested_state(pd, MOD_PD_STATE_OFF);
         pd->state_requested_to_driver = MOD_PD_STATE_OFF;
-        pd->current_state = MOD_PD_STATE_OFF;
+        set_current_state(pd, MOD_PD_STATE_OFF);
 
         /*
          * If the power domain parent is powered down, don't call the driver
@@ -1794,10 +2801,11 @@ static int pd_start(fwk_id_t id)
         /* Get the current power state of the power domain from its driver. */
         status = pd->driver_api->get_state(pd->driver_id, &state);
         if (status != FWK_SUCCESS) {
-            mod_pd_ctx.log_api->log(MOD_LOG_GROUP_ERROR, driver_error_msg,
+            MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR, driver_error_msg,
                 status, __func__, __LINE__);
         } else {
-            pd->requested_state = pd->state_requested_to_driver = state;
+            set_requested_state(pd, state);
+            pd->state_requested_to_driver = state;
 
             if (state == MOD_PD_STATE_OFF)
                 continue;
@@ -1865,6 +2873,43 @@ static int pd_process_event(const struct fwk_event *event,
     if (fwk_id_is_type(event->target_id, FWK_ID_TYPE_ELEMENT))
         pd = &mod_pd_ctx.pd_ctx_table[fwk_id_get_element_idx(event->target_id)];
 
+    #if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        /* The alarm of the module bounds the quiescing before a shutdown */
+        if (pd == NULL) {
+            if (mod_pd_ctx.system_shutdown.ongoing) {
+                MOD_LOG(mod_pd_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                    "[PD] Shutdown with %u pre-shutdown responses pending\n",
+                    mod_pd_ctx.system_shutdown.pending_responses);
+                complete_system_shutdown();
+            }
+
+            return FWK_SUCCESS;
+        }
+
+        process_off_delay_alarm(pd,
+            (struct mod_timer_alarm_event_params *)event->params);
+
+        return FWK_SUCCESS;
+    }
+    #endif
+
+    #ifndef BUILD_HAS_MULTITHREADING
+    switch (fwk_id_get_event_idx(event->id)) {
+    case PD_EVENT_IDX_SET_STATE:
+    case PD_EVENT_IDX_SET_CHILDREN_STATE:
+    case PD_EVENT_IDX_RESET:
+        fwk_interrupt_global_disable();
+        assert(mod_pd_ctx.queued_request_count != 0);
+        mod_pd_ctx.queued_request_count--;
+        fwk_interrupt_global_enable();
+        break;
+
+    default:
+        break;
+    }
+    #endif
+
     switch (fwk_id_get_event_idx(event->id)) {
     case PD_EVENT_IDX_SET_STATE:
         assert(pd != NULL);
@@ -1874,6 +2919,14 @@ static int pd_process_event(const struct fwk_event *event,
 
         return FWK_SUCCESS;
 
+    case PD_EVENT_IDX_SET_CHILDREN_STATE:
+        assert(pd != NULL);
+
+        process_set_children_state_request(pd,
+            (struct pd_set_children_state_request *)event->params);
+
+        return FWK_SUCCESS;
+
     case PD_EVENT_IDX_GET_STATE:
         assert(pd != NULL);
 
@@ -1906,14 +2959,12 @@ static int pd_process_event(const struct fwk_event *event,
         return FWK_SUCCESS;
 
     case PD_EVENT_IDX_SYSTEM_SHUTDOWN:
-        process_system_shutdown_request(
-            (struct pd_system_shutdown_request *)event->params,
-            (struct pd_response *)resp->params);
+        process_system_shutdown_request(event, resp);
 
         return FWK_SUCCESS;
 
     default:
-        mod_pd_ctx.log_api->log(
+        MOD_LOG(mod_pd_ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[PD] Invalid power state request: <%d>.\n",
             event->id);
@@ -1926,20 +2977,23 @@ static int process_power_state_pre_transition_notification_response(
     struct pd_ctx *pd,
     struct mod_pd_power_state_pre_transition_notification_resp_params *params)
 {
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses
-        == 0) {
+    if (!pd->power_state_pre_transition_notification_ctx.pending) {
         assert(false);
         return FWK_E_PANIC;
     }
 
+    /* The responses of all the notified entities have been collected */
     if (params->status != FWK_SUCCESS) {
         pd->power_state_pre_transition_notification_ctx.response_status =
             FWK_E_DEVICE;
     }
 
-    pd->power_state_pre_transition_notification_ctx.pending_responses--;
-    if (pd->power_state_pre_transition_notification_ctx.pending_responses != 0)
-        return FWK_SUCCESS;
+    pd->power_state_pre_transition_notification_ctx.pending = false;
+
+    if (pd->state_stats_table != NULL) {
+        pd->time.notification_duration +=
+            get_time() - pd->time.notification;
+    }
 
     if (pd->power_state_pre_transition_notification_ctx.valid == true) {
         /*
@@ -2031,6 +3085,9 @@ static int pd_process_notification(const struct fwk_event *event,
         return FWK_E_SUPPORT;
     }
 
+    if (fwk_id_is_equal(event->id, mod_pd_notification_id_pre_shutdown))
+        return process_pre_shutdown_notification_response();
+
     if (!fwk_module_is_valid_element_id(event->target_id)) {
         assert(false);
         return FWK_E_PARAM;
@@ -50,6 +50,19 @@ struct mod_ppu_v0_pd_config {
      * Flag indicating if this domain should be powered on during element init.
      */
     bool default_power_on;
+
+    /*!
+     * \brief Flag indicating if the completion of the power mode transitions
+     *     is signalled by the static policy transition interrupt of the PPU
+     *     rather than polled for.
+     *
+     * \details When set, the driver requests the power mode and returns, the
+     *     transition is reported to the power domain module from the PPU
+     *     interrupt handler. Requires a PPU interrupt.
+     *
+     * \note The transitions of the resets are still polled for.
+     */
+    bool async_transitions;
 };
 
 /*!
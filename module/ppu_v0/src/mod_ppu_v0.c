@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <fwk_id.h>
 #include <fwk_assert.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -36,6 +37,15 @@ struct ppu_v0_pd_ctx {
 
     /* Power module driver input API */
     struct mod_pd_driver_input_api *pd_driver_input_api;
+
+    /* Power state requested through the request_state() driver function */
+    unsigned int requested_state;
+
+    /* A transition completed by the policy transition interrupt is pending */
+    bool transition_pending;
+
+    /* Power state to report on completion of the transition */
+    unsigned int pending_state;
 };
 
 /* Module context */
@@ -83,8 +93,9 @@ static int get_state(struct ppu_v0_reg *ppu, unsigned int *state)
 
     *state = ppu_mode_to_power_state[ppu_mode];
     if (*state == MODE_UNSUPPORTED) {
-        ppu_v0_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
-                                "[PD] Unexpected PPU mode (%i).\n", ppu_mode);
+        MOD_LOG(ppu_v0_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                                    "[PD] Unexpected PPU mode (%i).\n",
+                                    ppu_mode);
         return FWK_E_DEVICE;
     }
 
@@ -98,6 +109,61 @@ static int pd_init(struct ppu_v0_pd_ctx *pd_ctx)
     return FWK_SUCCESS;
 }
 
+/*
+ * Set the power mode of a PPU.
+ *
+ * \param pd_ctx Power domain context.
+ * \param mode Power mode.
+ * \param state Power state to report on completion of the transition.
+ *
+ * \retval FWK_SUCCESS The power mode has been reached.
+ * \retval FWK_PENDING The transition is completed in the PPU interrupt
+ *      handler.
+ */
+static int set_power_mode(struct ppu_v0_pd_ctx *pd_ctx, enum ppu_v0_mode mode,
+                          unsigned int state)
+{
+    struct ppu_v0_reg *ppu = pd_ctx->ppu;
+    unsigned int irq = pd_ctx->config->ppu.irq;
+
+    pd_ctx->pending_state = state;
+
+    if (!pd_ctx->config->async_transitions || (irq == FWK_INTERRUPT_NONE)) {
+        ppu_v0_set_power_mode(ppu, mode);
+        return FWK_SUCCESS;
+    }
+
+    fwk_interrupt_disable(irq);
+
+    ppu_v0_ack_interrupt(ppu, PPU_V0_ISR_STA_POLICY_TRN);
+    ppu_v0_interrupt_unmask(ppu, PPU_V0_IMR_STA_POLICY_TRN);
+    ppu_v0_request_power_mode(ppu, mode);
+
+    /* No transition if the PPU is already in the requested mode */
+    if (ppu_v0_is_power_mode_reached(ppu, mode)) {
+        ppu_v0_interrupt_mask(ppu, PPU_V0_IMR_STA_POLICY_TRN);
+        ppu_v0_ack_interrupt(ppu, PPU_V0_ISR_STA_POLICY_TRN);
+        fwk_interrupt_clear_pending(irq);
+        fwk_interrupt_enable(irq);
+        return FWK_SUCCESS;
+    }
+
+    pd_ctx->transition_pending = true;
+    fwk_interrupt_enable(irq);
+
+    return FWK_PENDING;
+}
+
+static void report_pending_state(struct ppu_v0_pd_ctx *pd_ctx)
+{
+    int status;
+
+    status = pd_ctx->pd_driver_input_api->report_power_state_transition(
+        pd_ctx->bound_id, pd_ctx->pending_state);
+    assert(status == FWK_SUCCESS);
+    (void)status;
+}
+
 static int pd_set_state(fwk_id_t pd_id, unsigned int state)
 {
     int status;
@@ -113,25 +179,78 @@ static int pd_set_state(fwk_id_t pd_id, unsigned int state)
 
     switch (state) {
     case MOD_PD_STATE_ON:
-        ppu_v0_set_power_mode(pd_ctx->ppu, PPU_V0_MODE_ON);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_ON);
-        assert(status == FWK_SUCCESS);
+        if (set_power_mode(pd_ctx, PPU_V0_MODE_ON, state) == FWK_SUCCESS)
+            report_pending_state(pd_ctx);
+        break;
+
+    case MOD_PD_STATE_OFF:
+        if (set_power_mode(pd_ctx, PPU_V0_MODE_OFF, state) == FWK_SUCCESS)
+            report_pending_state(pd_ctx);
+        break;
+
+    default:
+        MOD_LOG(ppu_v0_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[PD] Requested power state (%i) is not supported.\n", state);
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int pd_request_state(fwk_id_t pd_id, unsigned int state)
+{
+    int status;
+    struct ppu_v0_pd_ctx *pd_ctx;
+
+    status = fwk_module_check_call(pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v0_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
+
+    switch (state) {
+    case MOD_PD_STATE_ON:
+        ppu_v0_request_power_mode(pd_ctx->ppu, PPU_V0_MODE_ON);
         break;
 
     case MOD_PD_STATE_OFF:
-        ppu_v0_set_power_mode(pd_ctx->ppu, PPU_V0_MODE_OFF);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_OFF);
-        assert(status == FWK_SUCCESS);
+        ppu_v0_request_power_mode(pd_ctx->ppu, PPU_V0_MODE_OFF);
         break;
 
     default:
-        ppu_v0_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(ppu_v0_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[PD] Requested power state (%i) is not supported.\n", state);
         return FWK_E_PARAM;
     }
 
+    pd_ctx->requested_state = state;
+
+    return FWK_SUCCESS;
+}
+
+static int pd_wait_state(fwk_id_t pd_id)
+{
+    int status;
+    struct ppu_v0_pd_ctx *pd_ctx;
+    enum ppu_v0_mode mode;
+
+    status = fwk_module_check_call(pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v0_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
+
+    fwk_assert(pd_ctx->pd_driver_input_api != NULL);
+
+    mode = (pd_ctx->requested_state == MOD_PD_STATE_ON) ? PPU_V0_MODE_ON :
+                                                          PPU_V0_MODE_OFF;
+    while (!ppu_v0_is_power_mode_reached(pd_ctx->ppu, mode))
+        continue;
+
+    status = pd_ctx->pd_driver_input_api->report_power_state_transition(
+        pd_ctx->bound_id, pd_ctx->requested_state);
+    assert(status == FWK_SUCCESS);
+
     return FWK_SUCCESS;
 }
 
@@ -168,10 +287,32 @@ static int pd_reset(fwk_id_t pd_id)
     return status;
 }
 
+/*
+ * Complete the transition pending on the policy transition interrupt of a PPU.
+ */
+static void ppu_interrupt_handler(uintptr_t pd_ctx_param)
+{
+    struct ppu_v0_pd_ctx *pd_ctx = (struct ppu_v0_pd_ctx *)pd_ctx_param;
+
+    assert(pd_ctx != NULL);
+
+    if (!pd_ctx->transition_pending ||
+        !ppu_v0_is_policy_transition_interrupt(pd_ctx->ppu))
+        return;
+
+    ppu_v0_ack_interrupt(pd_ctx->ppu, PPU_V0_ISR_STA_POLICY_TRN);
+    ppu_v0_interrupt_mask(pd_ctx->ppu, PPU_V0_IMR_STA_POLICY_TRN);
+    pd_ctx->transition_pending = false;
+
+    report_pending_state(pd_ctx);
+}
+
 static const struct mod_pd_driver_api pd_driver = {
     .set_state = pd_set_state,
     .get_state = pd_get_state,
     .reset = pd_reset,
+    .request_state = pd_request_state,
+    .wait_state = pd_wait_state,
 };
 
 /*
@@ -203,6 +344,14 @@ static int ppu_v0_pd_init(fwk_id_t pd_id, unsigned int unused, const void *data)
     pd_ctx->ppu = (struct ppu_v0_reg *)(config->ppu.reg_base);
     pd_ctx->bound_id = FWK_ID_NONE;
 
+    if (config->async_transitions && (config->ppu.irq != FWK_INTERRUPT_NONE)) {
+        status = fwk_interrupt_set_isr_param(config->ppu.irq,
+                                             ppu_interrupt_handler,
+                                             (uintptr_t)pd_ctx);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     switch (config->pd_type) {
     case MOD_PD_TYPE_DEVICE:
     case MOD_PD_TYPE_DEVICE_DEBUG:
@@ -46,13 +46,21 @@ int ppu_v0_set_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode)
     if (status != FWK_SUCCESS)
         return status;
 
-    while ((ppu->POWER_STATUS & (PPU_V0_PSR_POWSTAT | PPU_V0_PSR_DYNAMIC))
-           != mode)
+    while (!ppu_v0_is_power_mode_reached(ppu, mode))
         continue;
 
     return FWK_SUCCESS;
 }
 
+bool ppu_v0_is_power_mode_reached(struct ppu_v0_reg *ppu,
+                                  enum ppu_v0_mode mode)
+{
+    assert(ppu != NULL);
+
+    return (ppu->POWER_STATUS & (PPU_V0_PSR_POWSTAT | PPU_V0_PSR_DYNAMIC))
+           == mode;
+}
+
 int ppu_v0_get_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode *mode)
 {
     assert(ppu != NULL);
@@ -62,3 +70,32 @@ int ppu_v0_get_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode *mode)
 
     return FWK_SUCCESS;
 }
+
+void ppu_v0_interrupt_mask(struct ppu_v0_reg *ppu, unsigned int mask)
+{
+    assert(ppu != NULL);
+
+    ppu->IMR |= mask & PPU_V0_IMR_MASK;
+}
+
+void ppu_v0_interrupt_unmask(struct ppu_v0_reg *ppu, unsigned int mask)
+{
+    assert(ppu != NULL);
+
+    ppu->IMR &= ~(mask & PPU_V0_IMR_MASK);
+}
+
+void ppu_v0_ack_interrupt(struct ppu_v0_reg *ppu, unsigned int mask)
+{
+    assert(ppu != NULL);
+
+    /* The interrupt status bits are cleared by writing one to them */
+    ppu->ISR = mask & PPU_V0_ISR_MASK;
+}
+
+bool ppu_v0_is_policy_transition_interrupt(struct ppu_v0_reg *ppu)
+{
+    assert(ppu != NULL);
+
+    return ppu->ISR & PPU_V0_ISR_STA_POLICY_TRN;
+}
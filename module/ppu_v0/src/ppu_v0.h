@@ -134,7 +134,13 @@ enum ppu_v0_mode {
 void ppu_v0_init(struct ppu_v0_reg *ppu);
 int ppu_v0_request_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode);
 int ppu_v0_set_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode);
+bool ppu_v0_is_power_mode_reached(struct ppu_v0_reg *ppu,
+                                  enum ppu_v0_mode mode);
 int ppu_v0_get_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode *mode);
+void ppu_v0_interrupt_mask(struct ppu_v0_reg *ppu, unsigned int mask);
+void ppu_v0_interrupt_unmask(struct ppu_v0_reg *ppu, unsigned int mask);
+void ppu_v0_ack_interrupt(struct ppu_v0_reg *ppu, unsigned int mask);
+bool ppu_v0_is_policy_transition_interrupt(struct ppu_v0_reg *ppu);
 
 /*!
  * \endcond
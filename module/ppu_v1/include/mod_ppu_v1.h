@@ -111,6 +111,35 @@ struct mod_ppu_v1_pd_config {
      *     \ref mod_ppu_v1_power_state_observer_api::post_ppu_on().
      */
     void *post_ppu_on_param;
+
+    /*!
+     * \brief Flag indicating if the completion of the power mode transitions
+     *     is signalled by the static policy transition interrupt of the PPU
+     *     rather than polled for.
+     *
+     * \details When set, the driver requests the power mode and returns, the
+     *     transition is reported to the power domain module from the PPU
+     *     interrupt handler. Requires a PPU interrupt.
+     *
+     * \note The locking of the cores that precedes the power down of a cluster
+     *     is still polled for.
+     */
+    bool async_transitions;
+
+    /*!
+     * \brief Flag indicating if a cluster is powered up and down by the PPU
+     *     dynamic mode rather than by the driver.
+     *
+     * \details When set, the cluster PPU is programmed with the OFF dynamic
+     *     policy while the cluster is on. The PPU then powers the cluster
+     *     down when all its cores are down and up when a core wakes up,
+     *     without any action of the driver. The driver is interrupted only to
+     *     report the SLEEP and ON transitions to the power domain module, as
+     *     for the cores.
+     *
+     * \note Only supported for cluster power domains without observer.
+     */
+    bool autonomous;
 };
 
 /*!
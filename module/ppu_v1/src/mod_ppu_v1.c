@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <fwk_assert.h>
+#include <fwk_errno.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_macros.h>
@@ -49,6 +50,18 @@ struct ppu_v1_pd_ctx {
 
     /* Context data specific to the type of power domain */
     void *data;
+
+    /* A transition completed by the policy transition interrupt is pending */
+    bool transition_pending;
+
+    /* Power state to report on completion of the transition */
+    unsigned int pending_state;
+
+    /*
+     * Cluster power domains only, enable the cluster power down interrupt on
+     * completion of the power up of the cluster.
+     */
+    bool arm_cluster_off_irq;
 };
 
 /* Cluster power domain specific context */
@@ -117,14 +130,73 @@ static int get_state(struct ppu_v1_reg *ppu, unsigned int *state)
         *state = MOD_PD_STATE_SLEEP;
 
     if (*state == MODE_UNSUPPORTED) {
-        ppu_v1_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
-                                "[PPU_V1] Unexpected PPU mode (%i).\n", mode);
+        MOD_LOG(ppu_v1_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                                    "[PPU_V1] Unexpected PPU mode (%i).\n",
+                                    mode);
         return FWK_E_DEVICE;
     }
 
     return FWK_SUCCESS;
 }
 
+/*
+ * Set the power mode of a PPU.
+ *
+ * \param pd_ctx Power domain context.
+ * \param mode Power mode.
+ * \param state Power state to report on completion of the transition.
+ * \param allow_async Whether the completion of the transition may be
+ *      signalled by the policy transition interrupt.
+ *
+ * \retval FWK_SUCCESS The power mode has been reached.
+ * \retval FWK_PENDING The transition is completed in the PPU interrupt
+ *      handler.
+ */
+static int set_power_mode(struct ppu_v1_pd_ctx *pd_ctx, enum ppu_v1_mode mode,
+                          unsigned int state, bool allow_async)
+{
+    struct ppu_v1_reg *ppu = pd_ctx->ppu;
+    unsigned int irq = pd_ctx->config->ppu.irq;
+
+    pd_ctx->pending_state = state;
+
+    if (!allow_async || !pd_ctx->config->async_transitions ||
+        (irq == FWK_INTERRUPT_NONE)) {
+        ppu_v1_set_power_mode(ppu, mode);
+        return FWK_SUCCESS;
+    }
+
+    fwk_interrupt_disable(irq);
+
+    ppu_v1_ack_interrupt(ppu, PPU_V1_ISR_STA_POLICY_TRN_IRQ);
+    ppu_v1_interrupt_unmask(ppu, PPU_V1_IMR_STA_POLICY_TRN_IRQ_MASK);
+    ppu_v1_request_power_mode(ppu, mode);
+
+    /* No transition if the PPU is already in the requested mode */
+    if (ppu_v1_is_power_mode_reached(ppu, mode)) {
+        ppu_v1_interrupt_mask(ppu, PPU_V1_IMR_STA_POLICY_TRN_IRQ_MASK);
+        ppu_v1_ack_interrupt(ppu, PPU_V1_ISR_STA_POLICY_TRN_IRQ);
+        fwk_interrupt_clear_pending(irq);
+        fwk_interrupt_enable(irq);
+        return FWK_SUCCESS;
+    }
+
+    pd_ctx->transition_pending = true;
+    fwk_interrupt_enable(irq);
+
+    return FWK_PENDING;
+}
+
+static void report_pending_state(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    int status;
+
+    status = pd_ctx->pd_driver_input_api->report_power_state_transition(
+        pd_ctx->bound_id, pd_ctx->pending_state);
+    assert(status == FWK_SUCCESS);
+    (void)status;
+}
+
 static int ppu_v1_pd_set_state(fwk_id_t pd_id, unsigned int state)
 {
     int status;
@@ -138,25 +210,75 @@ static int ppu_v1_pd_set_state(fwk_id_t pd_id, unsigned int state)
 
     switch (state) {
     case MOD_PD_STATE_ON:
-        ppu_v1_set_power_mode(pd_ctx->ppu, PPU_V1_MODE_ON);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_ON);
-        assert(status == FWK_SUCCESS);
+        if (set_power_mode(pd_ctx, PPU_V1_MODE_ON, state, true) == FWK_SUCCESS)
+            report_pending_state(pd_ctx);
         break;
 
     case MOD_PD_STATE_OFF:
-        ppu_v1_set_power_mode(pd_ctx->ppu, PPU_V1_MODE_OFF);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_OFF);
-        assert(status == FWK_SUCCESS);
+        if (set_power_mode(pd_ctx, PPU_V1_MODE_OFF, state, true) ==
+            FWK_SUCCESS)
+            report_pending_state(pd_ctx);
+        break;
+
+    default:
+        MOD_LOG(ppu_v1_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[PD] Requested power state (%i) is not supported.\n", state);
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int ppu_v1_pd_request_state(fwk_id_t pd_id, unsigned int state)
+{
+    int status;
+    struct ppu_v1_pd_ctx *pd_ctx;
+
+    status = fwk_module_check_call(pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
+
+    switch (state) {
+    case MOD_PD_STATE_ON:
+        ppu_v1_request_power_mode(pd_ctx->ppu, PPU_V1_MODE_ON);
+        break;
+
+    case MOD_PD_STATE_OFF:
+        ppu_v1_request_power_mode(pd_ctx->ppu, PPU_V1_MODE_OFF);
         break;
 
     default:
-        ppu_v1_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(ppu_v1_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[PD] Requested power state (%i) is not supported.\n", state);
         return FWK_E_PARAM;
     }
 
+    pd_ctx->pending_state = state;
+
+    return FWK_SUCCESS;
+}
+
+static int ppu_v1_pd_wait_state(fwk_id_t pd_id)
+{
+    int status;
+    struct ppu_v1_pd_ctx *pd_ctx;
+    enum ppu_v1_mode mode;
+
+    status = fwk_module_check_call(pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
+
+    mode = (pd_ctx->pending_state == MOD_PD_STATE_ON) ? PPU_V1_MODE_ON :
+                                                        PPU_V1_MODE_OFF;
+    while (!ppu_v1_is_power_mode_reached(pd_ctx->ppu, mode))
+        continue;
+
+    report_pending_state(pd_ctx);
+
     return FWK_SUCCESS;
 }
 
@@ -197,6 +319,8 @@ static const struct mod_pd_driver_api pd_driver = {
     .set_state = ppu_v1_pd_set_state,
     .get_state = ppu_v1_pd_get_state,
     .reset = ppu_v1_pd_reset,
+    .request_state = ppu_v1_pd_request_state,
+    .wait_state = ppu_v1_pd_wait_state,
 };
 
 /*
@@ -222,18 +346,25 @@ static int ppu_v1_core_pd_init(struct ppu_v1_pd_ctx *pd_ctx)
     return FWK_SUCCESS;
 }
 
-static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
+/* Complete the transition of a core power domain to the OFF or ON state */
+static void complete_core_transition(struct ppu_v1_pd_ctx *pd_ctx)
 {
-    int status;
-    struct ppu_v1_pd_ctx *pd_ctx;
-    struct ppu_v1_reg *ppu;
+    struct ppu_v1_reg *ppu = pd_ctx->ppu;
 
-    status = fwk_module_check_call(core_pd_id);
-    if (status != FWK_SUCCESS)
-        return status;
+    if (pd_ctx->pending_state == MOD_PD_STATE_OFF) {
+        ppu_v1_lock_off_disable(ppu);
+        ppu_v1_off_unlock(ppu);
+    } else
+        ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
 
-    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(core_pd_id);
-    ppu = pd_ctx->ppu;
+    report_pending_state(pd_ctx);
+}
+
+static int set_core_state(struct ppu_v1_pd_ctx *pd_ctx, unsigned int state,
+                          bool allow_async)
+{
+    int status;
+    struct ppu_v1_reg *ppu = pd_ctx->ppu;
 
     switch (state) {
     case MOD_PD_STATE_OFF:
@@ -241,12 +372,9 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
                                           PPU_V1_MODE_ON,
                                           PPU_V1_EDGE_SENSITIVITY_MASKED);
         ppu_v1_interrupt_mask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
-        ppu_v1_set_power_mode(ppu, PPU_V1_MODE_OFF);
-        ppu_v1_lock_off_disable(ppu);
-        ppu_v1_off_unlock(ppu);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_OFF);
-        assert(status == FWK_SUCCESS);
+        if (set_power_mode(pd_ctx, PPU_V1_MODE_OFF, state, allow_async) ==
+            FWK_SUCCESS)
+            complete_core_transition(pd_ctx);
         break;
 
     case MOD_PD_STATE_ON:
@@ -254,11 +382,9 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
         ppu_v1_set_input_edge_sensitivity(ppu,
                                           PPU_V1_MODE_ON,
                                           PPU_V1_EDGE_SENSITIVITY_MASKED);
-        ppu_v1_set_power_mode(ppu, PPU_V1_MODE_ON);
-        ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_ON);
-        assert(status == FWK_SUCCESS);
+        if (set_power_mode(pd_ctx, PPU_V1_MODE_ON, state, allow_async) ==
+            FWK_SUCCESS)
+            complete_core_transition(pd_ctx);
         break;
 
     case MOD_PD_STATE_SLEEP:
@@ -281,7 +407,7 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
         break;
 
     default:
-        ppu_v1_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(ppu_v1_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[PPU_V1] Requested CPU power state (%i) is not supported!\n",
             state);
         return FWK_E_PARAM;
@@ -290,13 +416,35 @@ static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
     return FWK_SUCCESS;
 }
 
+static int ppu_v1_core_pd_set_state(fwk_id_t core_pd_id, unsigned int state)
+{
+    int status;
+    struct ppu_v1_pd_ctx *pd_ctx;
+
+    status = fwk_module_check_call(core_pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(core_pd_id);
+
+    return set_core_state(pd_ctx, state, true);
+}
+
 static int ppu_v1_core_pd_reset(fwk_id_t core_pd_id)
 {
     int status;
+    struct ppu_v1_pd_ctx *pd_ctx;
 
-    status = ppu_v1_core_pd_set_state(core_pd_id, MOD_PD_STATE_OFF);
+    status = fwk_module_check_call(core_pd_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(core_pd_id);
+
+    /* The power up follows the power down, the latter has to be waited for */
+    status = set_core_state(pd_ctx, MOD_PD_STATE_OFF, false);
     if (status == FWK_SUCCESS)
-        status = ppu_v1_core_pd_set_state(core_pd_id, MOD_PD_STATE_ON);
+        status = set_core_state(pd_ctx, MOD_PD_STATE_ON, true);
 
     return status;
 }
@@ -427,7 +575,32 @@ static bool lock_all_dynamic_cores(struct ppu_v1_pd_ctx *pd_ctx)
     return true;
 }
 
-static bool cluster_off(struct ppu_v1_pd_ctx *pd_ctx)
+/*
+ * Power down a cluster.
+ *
+ * \param pd_ctx Cluster power domain context.
+ * \param state Power state to report once the cluster is powered down.
+ *
+ * \retval FWK_SUCCESS The cluster is powered down.
+ * \retval FWK_PENDING The cluster is being powered down.
+ * \retval FWK_E_STATE A core prevented the power down of the cluster.
+ */
+/*
+ * Let the PPU of an autonomous cluster power the cluster down and up along with
+ * its cores.
+ */
+static void enable_cluster_dynamic_mode(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_reg *ppu = pd_ctx->ppu;
+
+    ppu_v1_set_input_edge_sensitivity(ppu,
+                                      PPU_V1_MODE_ON,
+                                      PPU_V1_EDGE_SENSITIVITY_MASKED);
+    ppu_v1_interrupt_unmask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
+    ppu_v1_dynamic_enable(ppu, PPU_V1_MODE_OFF);
+}
+
+static int cluster_off(struct ppu_v1_pd_ctx *pd_ctx, unsigned int state)
 {
     struct ppu_v1_reg *ppu;
     bool lock_successful;
@@ -439,20 +612,58 @@ static bool cluster_off(struct ppu_v1_pd_ctx *pd_ctx)
     ppu_v1_set_input_edge_sensitivity(ppu,
                                       PPU_V1_MODE_ON,
                                       PPU_V1_EDGE_SENSITIVITY_MASKED);
+    if (pd_ctx->config->autonomous)
+        ppu_v1_interrupt_mask(ppu, PPU_V1_IMR_DYN_POLICY_MIN_IRQ_MASK);
 
     lock_successful = lock_all_dynamic_cores(pd_ctx);
     if (!lock_successful) {
         unlock_all_cores(pd_ctx);
-        return false;
+        return FWK_E_STATE;
     }
 
-    ppu_v1_set_power_mode(ppu, PPU_V1_MODE_OFF);
-    return true;
+    return set_power_mode(pd_ctx, PPU_V1_MODE_OFF, state, true);
 }
 
-static void cluster_on(struct ppu_v1_pd_ctx *pd_ctx)
+/* Complete the power down of a cluster */
+static void complete_cluster_off(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    /* Power down requested by the cluster, power up on the next core wake-up */
+    if (pd_ctx->pending_state == MOD_PD_STATE_SLEEP) {
+        ppu_v1_set_input_edge_sensitivity(pd_ctx->ppu,
+            PPU_V1_MODE_ON, PPU_V1_EDGE_SENSITIVITY_RISING_EDGE);
+    }
+
+    report_pending_state(pd_ctx);
+}
+
+/* Complete the power up of a cluster */
+static void complete_cluster_on(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    report_pending_state(pd_ctx);
+
+    if (pd_ctx->observer_api != NULL)
+        pd_ctx->observer_api->post_ppu_on(pd_ctx->config->post_ppu_on_param);
+
+    unlock_all_cores(pd_ctx);
+
+    if (pd_ctx->config->autonomous)
+        enable_cluster_dynamic_mode(pd_ctx);
+    else if (pd_ctx->arm_cluster_off_irq) {
+        ppu_v1_set_input_edge_sensitivity(pd_ctx->ppu,
+                                          PPU_V1_MODE_ON,
+                                          PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+    }
+}
+
+/*
+ * Power up a cluster.
+ *
+ * \param pd_ctx Cluster power domain context.
+ * \param arm_cluster_off_irq Whether to enable the cluster power down
+ *      interrupt once the cluster is powered up.
+ */
+static void cluster_on(struct ppu_v1_pd_ctx *pd_ctx, bool arm_cluster_off_irq)
 {
-    int status;
     struct ppu_v1_reg *ppu;
 
     assert(pd_ctx != NULL);
@@ -463,16 +674,10 @@ static void cluster_on(struct ppu_v1_pd_ctx *pd_ctx)
                                       PPU_V1_MODE_ON,
                                       PPU_V1_EDGE_SENSITIVITY_MASKED);
 
-    ppu_v1_set_power_mode(ppu, PPU_V1_MODE_ON);
-    status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-        pd_ctx->bound_id, MOD_PD_STATE_ON);
-    assert(status == FWK_SUCCESS);
-    (void)status;
-
-    if (pd_ctx->observer_api != NULL)
-        pd_ctx->observer_api->post_ppu_on(pd_ctx->config->post_ppu_on_param);
-
-    unlock_all_cores(pd_ctx);
+    pd_ctx->arm_cluster_off_irq = arm_cluster_off_irq;
+    if (set_power_mode(pd_ctx, PPU_V1_MODE_ON, MOD_PD_STATE_ON, true) ==
+        FWK_SUCCESS)
+        complete_cluster_on(pd_ctx);
 }
 
 static int ppu_v1_cluster_pd_init(struct ppu_v1_pd_ctx *pd_ctx)
@@ -492,9 +697,12 @@ static int ppu_v1_cluster_pd_init(struct ppu_v1_pd_ctx *pd_ctx)
         ppu_v1_opmode_dynamic_enable(ppu, PPU_V1_OPMODE_00);
 
     if (state == MOD_PD_STATE_ON) {
-        ppu_v1_set_input_edge_sensitivity(ppu,
-                                          PPU_V1_MODE_ON,
-                                          PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+        if (pd_ctx->config->autonomous)
+            enable_cluster_dynamic_mode(pd_ctx);
+        else {
+            ppu_v1_set_input_edge_sensitivity(ppu,
+                PPU_V1_MODE_ON, PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+        }
     }
 
     return FWK_SUCCESS;
@@ -517,16 +725,20 @@ static int ppu_v1_cluster_pd_set_state(fwk_id_t cluster_pd_id,
 
     switch (state) {
     case MOD_PD_STATE_ON:
-        cluster_on(pd_ctx);
         #ifdef BUILD_HAS_MULTITHREADING
-        ppu_v1_set_input_edge_sensitivity(ppu,
-                                          PPU_V1_MODE_ON,
-                                          PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+        cluster_on(pd_ctx, true);
+        #else
+        cluster_on(pd_ctx, false);
         #endif
         return FWK_SUCCESS;
 
     case MOD_PD_STATE_OFF:
-        if (!cluster_off(pd_ctx)) {
+        status = cluster_off(pd_ctx, MOD_PD_STATE_OFF);
+        if ((status == FWK_E_STATE) && pd_ctx->config->autonomous) {
+            enable_cluster_dynamic_mode(pd_ctx);
+            return FWK_E_STATE;
+        }
+        if (status == FWK_E_STATE) {
             /* Cluster failed to transition to off */
             #ifdef BUILD_HAS_MULTITHREADING
             ppu_v1_set_input_edge_sensitivity(ppu,
@@ -534,13 +746,12 @@ static int ppu_v1_cluster_pd_set_state(fwk_id_t cluster_pd_id,
             #endif
             return FWK_E_STATE;
         }
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_OFF);
-        assert(status == FWK_SUCCESS);
+        if (status == FWK_SUCCESS)
+            complete_cluster_off(pd_ctx);
         return FWK_SUCCESS;
 
     default:
-        ppu_v1_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(ppu_v1_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[PPU_V1] Requested CPU power state (%i) is not supported!\n",
             state);
         return FWK_E_PARAM;
@@ -566,10 +777,7 @@ static void cluster_pd_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
     switch (current_mode) {
     case PPU_V1_MODE_OFF:
         /* Cluster has to be powered on */
-        cluster_on(pd_ctx);
-        ppu_v1_set_input_edge_sensitivity(ppu,
-                                          PPU_V1_MODE_ON,
-                                          PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
+        cluster_on(pd_ctx, true);
         return;
 
     case PPU_V1_MODE_ON:
@@ -583,15 +791,11 @@ static void cluster_pd_ppu_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
         }
 
         /* All PACTIVE lines are low, so the cluster can be turned off */
-        if (cluster_off(pd_ctx)) {
+        status = cluster_off(pd_ctx, MOD_PD_STATE_SLEEP);
+        if (status == FWK_SUCCESS) {
             /* Cluster successfuly transitioned to off */
-            ppu_v1_set_input_edge_sensitivity(ppu,
-                PPU_V1_MODE_ON, PPU_V1_EDGE_SENSITIVITY_RISING_EDGE);
-            status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-                pd_ctx->bound_id, MOD_PD_STATE_SLEEP);
-            assert(status == FWK_SUCCESS);
-            (void)status;
-        } else {
+            complete_cluster_off(pd_ctx);
+        } else if (status == FWK_E_STATE) {
             /* Cluster did not transition to off */
             ppu_v1_set_input_edge_sensitivity(ppu,
                 PPU_V1_MODE_ON, PPU_V1_EDGE_SENSITIVITY_FALLING_EDGE);
@@ -611,13 +815,55 @@ static const struct mod_pd_driver_api cluster_pd_driver = {
     .reset = ppu_v1_pd_reset,
 };
 
+/*
+ * Complete the transition pending on the policy transition interrupt of a PPU.
+ * Each PPU reports its own transition, the reports of the PPUs interrupting
+ * together are processed in a single run of the event loop.
+ */
+static void policy_transition_interrupt_handler(struct ppu_v1_pd_ctx *pd_ctx)
+{
+    struct ppu_v1_reg *ppu = pd_ctx->ppu;
+
+    if (!pd_ctx->transition_pending ||
+        !ppu_v1_is_policy_transition_interrupt(ppu))
+        return;
+
+    ppu_v1_ack_interrupt(ppu, PPU_V1_ISR_STA_POLICY_TRN_IRQ);
+    ppu_v1_interrupt_mask(ppu, PPU_V1_IMR_STA_POLICY_TRN_IRQ_MASK);
+    pd_ctx->transition_pending = false;
+
+    switch (pd_ctx->config->pd_type) {
+    case MOD_PD_TYPE_CORE:
+        complete_core_transition(pd_ctx);
+        break;
+
+    case MOD_PD_TYPE_CLUSTER:
+        if (pd_ctx->pending_state == MOD_PD_STATE_ON)
+            complete_cluster_on(pd_ctx);
+        else
+            complete_cluster_off(pd_ctx);
+        break;
+
+    default:
+        report_pending_state(pd_ctx);
+        break;
+    }
+}
+
 static void ppu_interrupt_handler(uintptr_t pd_ctx_param)
 {
     struct ppu_v1_pd_ctx *pd_ctx = (struct ppu_v1_pd_ctx *)pd_ctx_param;
 
     assert(pd_ctx != NULL);
 
-    if (pd_ctx->config->pd_type == MOD_PD_TYPE_CORE)
+    policy_transition_interrupt_handler(pd_ctx);
+
+    /*
+     * The wake-up and power down interrupts of the autonomous clusters are
+     * those of the cores.
+     */
+    if ((pd_ctx->config->pd_type == MOD_PD_TYPE_CORE) ||
+        pd_ctx->config->autonomous)
         core_pd_ppu_interrupt_handler(pd_ctx);
     else
         cluster_pd_ppu_interrupt_handler(pd_ctx);
@@ -689,6 +935,12 @@ static int ppu_v1_pd_init(fwk_id_t pd_id, unsigned int unused, const void *data)
     if (config->pd_type >= MOD_PD_TYPE_COUNT)
         return FWK_E_DATA;
 
+    /* Only the clusters without observer can be autonomous */
+    if (config->autonomous &&
+        ((config->pd_type != MOD_PD_TYPE_CLUSTER) ||
+         !fwk_id_is_equal(config->observer_id, FWK_ID_NONE)))
+        return FWK_E_DATA;
+
     pd_ctx = ppu_v1_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
     pd_ctx->config = config;
     pd_ctx->ppu = (struct ppu_v1_reg *)(config->ppu.reg_base);
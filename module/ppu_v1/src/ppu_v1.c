@@ -47,13 +47,19 @@ int ppu_v1_set_power_mode(struct ppu_v1_reg *ppu, enum ppu_v1_mode ppu_mode)
     if (status != FWK_SUCCESS)
         return status;
 
-    while ((ppu->PWSR & (PPU_V1_PWSR_PWR_STATUS | PPU_V1_PWSR_PWR_DYN_STATUS))
-            != ppu_mode)
+    while (!ppu_v1_is_power_mode_reached(ppu, ppu_mode))
         continue;
 
     return FWK_SUCCESS;
 }
 
+bool ppu_v1_is_power_mode_reached(struct ppu_v1_reg *ppu,
+                                  enum ppu_v1_mode ppu_mode)
+{
+    return (ppu->PWSR & (PPU_V1_PWSR_PWR_STATUS | PPU_V1_PWSR_PWR_DYN_STATUS))
+           == ppu_mode;
+}
+
 int ppu_v1_request_operating_mode(struct ppu_v1_reg *ppu,
                                   enum ppu_v1_opmode op_mode)
 {
@@ -339,6 +345,11 @@ bool ppu_v1_is_dyn_policy_min_interrupt(struct ppu_v1_reg *ppu)
     return ppu->ISR & PPU_V1_ISR_DYN_POLICY_MIN_IRQ;
 }
 
+bool ppu_v1_is_policy_transition_interrupt(struct ppu_v1_reg *ppu)
+{
+    return ppu->ISR & PPU_V1_ISR_STA_POLICY_TRN_IRQ;
+}
+
 /*
  * IDR0 register
  */
@@ -267,6 +267,12 @@ int ppu_v1_set_power_mode(struct ppu_v1_reg *ppu, enum ppu_v1_mode ppu_mode);
 int ppu_v1_request_power_mode(struct ppu_v1_reg *ppu,
                               enum ppu_v1_mode ppu_mode);
 
+/*
+ * Check if the PPU has reached a power mode.
+ */
+bool ppu_v1_is_power_mode_reached(struct ppu_v1_reg *ppu,
+                                  enum ppu_v1_mode ppu_mode);
+
 /*
  * Request a change to the PPU's operating mode.
  */
@@ -449,6 +455,11 @@ bool ppu_v1_is_op_active_edge_interrupt(struct ppu_v1_reg *ppu,
  */
 bool ppu_v1_is_dyn_policy_min_interrupt(struct ppu_v1_reg *ppu);
 
+/*
+ * Check if the static policy transition completion interrupt is pending.
+ */
+bool ppu_v1_is_policy_transition_interrupt(struct ppu_v1_reg *ppu);
+
 /*
  * Get the number of operating modes.
  */
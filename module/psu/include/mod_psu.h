@@ -52,6 +52,8 @@ struct mod_psu_device_api {
      * \retval FWK_E_PARAM One or more parameters were invalid.
      * \retval FWK_E_STATE The element cannot accept the request.
      * \retval FWK_E_HANDLER An error occurred in the device driver.
+     * \retval FWK_PENDING The driver completes the request asynchronously,
+     *      the completion is not reported.
      */
     int (*set_enabled)(fwk_id_t device_id, bool enable);
 
@@ -92,6 +94,8 @@ struct mod_psu_device_api {
      * \retval FWK_E_PARAM One or more parameters were invalid.
      * \retval FWK_E_STATE The element cannot accept the request.
      * \retval FWK_E_HANDLER An error occurred in the device driver.
+     * \retval FWK_PENDING The driver completes the request asynchronously,
+     *      the completion is not reported.
      */
     int (*set_voltage)(fwk_id_t device_id, uintmax_t voltage);
 
@@ -108,10 +112,82 @@ struct mod_psu_device_api {
      * \retval FWK_E_PANIC An error in the framework occurred.
      */
     int (*set_voltage_async)(fwk_id_t device_id, uintmax_t voltage);
+
+    /*!
+     * \brief Get the voltage vote of a voter of a device.
+     *
+     * \param device_id Identifier of the device.
+     * \param voter_idx Index of the voter.
+     * \param [out] voltage Voltage voted for in mV, or zero if the voter has
+     *      not voted.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     * \retval FWK_E_STATE The element cannot accept the request.
+     */
+    int (*get_voltage_vote)(
+        fwk_id_t device_id,
+        unsigned int voter_idx,
+        uintmax_t *voltage);
+
+    /*!
+     * \brief Vote for the voltage of a device.
+     *
+     * \details The output voltage is raised to the vote before the function
+     *      returns if the vote is higher than the output voltage. Otherwise,
+     *      the output voltage is lowered lazily, once the votes submitted in
+     *      the meantime have been received.
+     *
+     * \param device_id Identifier of the device.
+     * \param voter_idx Index of the voter.
+     * \param voltage Voltage voted for in mV, or zero to withdraw the vote.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     * \retval FWK_E_STATE The element cannot accept the request.
+     * \retval FWK_E_HANDLER An error occurred in the device driver.
+     * \retval FWK_E_NOMEM The event queue is full.
+     * \retval FWK_E_PANIC An error in the framework occurred.
+     * \retval FWK_PENDING The driver raises the voltage asynchronously, the
+     *      completion is not reported.
+     */
+    int (*set_voltage_vote)(
+        fwk_id_t device_id,
+        unsigned int voter_idx,
+        uintmax_t voltage);
+
+    /*!
+     * \brief Vote for the voltage of a device.
+     *
+     * \details The response to the request is a \ref
+     *      mod_psu_event_id_set_voltage_vote event, submitted once the output
+     *      voltage is at least the vote.
+     *
+     * \param device_id Identifier of the device.
+     * \param voter_idx Index of the voter.
+     * \param voltage Voltage voted for in mV, or zero to withdraw the vote.
+     *
+     * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_E_PARAM One or more parameters were invalid.
+     * \retval FWK_E_STATE The element cannot accept the request.
+     * \retval FWK_E_NOMEM The event queue is full.
+     * \retval FWK_E_PANIC An error in the framework occurred.
+     */
+    int (*set_voltage_vote_async)(
+        fwk_id_t device_id,
+        unsigned int voter_idx,
+        uintmax_t voltage);
 };
 
 /*!
  * \brief Driver API.
+ *
+ * \details The drivers of devices signalling the end of a transition, such as
+ *      a power-good output, may complete the requests to set the enabled
+ *      state and the voltage asynchronously: the function returns
+ *      \ref FWK_PENDING and the driver reports the completion through the
+ *      \ref mod_psu_driver_response_api. A single request of a device is in
+ *      progress at a time.
  */
 struct mod_psu_driver_api {
     /*!
@@ -121,6 +197,8 @@ struct mod_psu_driver_api {
      * \param enable \c true to enable the device, or \c false to disable it.
      *
      * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_PENDING The request was accepted and its completion will be
+     *      reported through the driver response API.
      * \return One of the other driver-defined error codes.
      */
     int (*set_enabled)(fwk_id_t id, bool enable);
@@ -144,6 +222,8 @@ struct mod_psu_driver_api {
      * \param voltage New voltage in millivolts (mV).
      *
      * \retval FWK_SUCCESS The operation succeeded.
+     * \retval FWK_PENDING The request was accepted and its completion will be
+     *      reported through the driver response API.
      * \return One of the other driver-defined error codes.
      */
     int (*set_voltage)(fwk_id_t id, uintmax_t voltage);
@@ -160,6 +240,25 @@ struct mod_psu_driver_api {
     int (*get_voltage)(fwk_id_t id, uintmax_t *voltage);
 };
 
+/*!
+ * \brief Driver response API.
+ *
+ * \details Only the driver of a device can bind to the API of the device.
+ */
+struct mod_psu_driver_response_api {
+    /*!
+     * \brief Report the completion of a request the driver returned
+     *      \ref FWK_PENDING for.
+     *
+     * \details The request of the module waiting for the driver is completed
+     *      in turn. The function can be called from an interrupt handler.
+     *
+     * \param device_id Identifier of the PSU device.
+     * \param status Status of the request.
+     */
+    void (*respond)(fwk_id_t device_id, int status);
+};
+
 /*!
  * \}
  */
@@ -175,6 +274,52 @@ struct mod_psu_driver_api {
 struct mod_psu_device_config {
     fwk_id_t driver_id; /*!< Driver identifier */
     fwk_id_t driver_api_id; /*!< Driver API identifier */
+
+    /*!
+     * \brief Slew rate of the output voltage in millivolts per millisecond
+     *      (mV/ms), or zero if it is not known.
+     *
+     * \details When the slew rate is known, an asynchronous voltage change
+     *      completes once the output voltage has ramped to the new voltage and
+     *      settled, as computed from the slew rate and the settle time. A
+     *      voltage change requested while a ramp is in progress redirects the
+     *      ramp, and the request that started the ramp completes with the
+     *      \ref FWK_E_OVERWRITTEN status.
+     *
+     * \note The timing of the voltage ramps requires the timer module.
+     *
+     * \note The ramps of a device whose driver completes the voltage changes
+     *      asynchronously are timed by the module when the slew rate is known:
+     *      the responses of the driver are then ignored.
+     */
+    unsigned int slew_rate;
+
+    /*! Settle time of the output voltage at the end of a ramp (us) */
+    unsigned int settle_time;
+
+    /*!
+     * \brief Identifier of the alarm timing the voltage ramps.
+     *
+     * \details Ignored if the slew rate is zero.
+     */
+    fwk_id_t alarm_id;
+
+    /*!
+     * \brief Number of voters sharing the device, or zero if the voltage of
+     *      the device is not arbitrated.
+     *
+     * \details The voters of a device shared by several consumers, such as
+     *      the DVFS domains of a rail, vote for the voltage they require
+     *      instead of setting the voltage of the device. The output voltage is
+     *      the highest vote. It is raised as soon as a vote exceeds it, and
+     *      lowered lazily when the votes drop. The votes received during one
+     *      pass of the event loop are applied in a single voltage change.
+     *
+     * \note The voltage of an arbitrated device should only be changed
+     *      through the votes. A voltage set directly is overridden by the next
+     *      vote.
+     */
+    unsigned int voter_count;
 };
 
 /*!
@@ -188,6 +333,9 @@ struct mod_psu_device_config {
 
 /*!
  * \brief <tt>Set enabled</tt> event response parameters.
+ *
+ * \details The status is \ref FWK_E_BUSY if the driver was completing another
+ *      request of the device asynchronously.
  */
 struct mod_psu_event_params_set_enabled_response {
     int status; /*!< Status of the request */
@@ -195,11 +343,27 @@ struct mod_psu_event_params_set_enabled_response {
 
 /*!
  * \brief <tt>Set voltage</tt> event response parameters.
+ *
+ * \details The status is \ref FWK_E_OVERWRITTEN if another voltage change
+ *      redirected the voltage ramp before it completed, or \ref FWK_E_BUSY if
+ *      the driver was completing another request of the device
+ *      asynchronously.
  */
 struct mod_psu_event_params_set_voltage_response {
     int status; /*!< Status of the request */
 };
 
+/*!
+ * \brief <tt>Set voltage vote</tt> event response parameters.
+ *
+ * \details The status is \ref FWK_E_OVERWRITTEN if the voter voted again, or
+ *      if the voltage of the device was set directly, before the output
+ *      voltage satisfied the vote.
+ */
+struct mod_psu_event_params_set_voltage_vote_response {
+    int status; /*!< Status of the request */
+};
+
 /*!
  * \}
  */
@@ -216,6 +380,9 @@ enum mod_psu_api_idx {
     /*! API index for mod_psu_api_id_psu_device */
     MOD_PSU_API_IDX_PSU_DEVICE,
 
+    /*! API index for mod_psu_api_id_driver_response */
+    MOD_PSU_API_IDX_DRIVER_RESPONSE,
+
     /*! Number of defined APIs */
     MOD_PSU_API_IDX_COUNT
 };
@@ -224,6 +391,10 @@ enum mod_psu_api_idx {
 static const fwk_id_t mod_psu_api_id_psu_device =
     FWK_ID_API_INIT(FWK_MODULE_IDX_PSU, MOD_PSU_API_IDX_PSU_DEVICE);
 
+/*! Driver response API identifier */
+static const fwk_id_t mod_psu_api_id_driver_response =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_PSU, MOD_PSU_API_IDX_DRIVER_RESPONSE);
+
 /*!
  * \brief Event indices.
  */
@@ -234,6 +405,9 @@ enum mod_psu_event_idx {
     /*! Event index for mod_psu_event_id_set_voltage */
     MOD_PSU_EVENT_IDX_SET_VOLTAGE,
 
+    /*! Event index for mod_psu_event_id_set_voltage_vote */
+    MOD_PSU_EVENT_IDX_SET_VOLTAGE_VOTE,
+
     /*! Number of defined events */
     MOD_PSU_EVENT_IDX_COUNT
 };
@@ -246,6 +420,10 @@ static const fwk_id_t mod_psu_event_id_set_enabled =
 static const fwk_id_t mod_psu_event_id_set_voltage =
     FWK_ID_EVENT_INIT(FWK_MODULE_IDX_PSU, MOD_PSU_EVENT_IDX_SET_VOLTAGE);
 
+/*! <tt>Set voltage vote</tt> event identifier */
+static const fwk_id_t mod_psu_event_id_set_voltage_vote =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_PSU, MOD_PSU_EVENT_IDX_SET_VOLTAGE_VOTE);
+
 /*!
  * \}
  */
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <fwk_assert.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -65,10 +66,10 @@ static int api_set_enabled(fwk_id_t device_id, bool enable)
 
     /* Set the enabled state through the driver */
     status = ctx->apis.driver->set_enabled(ctx->config->driver_id, enable);
-    if (status != FWK_SUCCESS)
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING))
         return FWK_E_HANDLER;
 
-    return FWK_SUCCESS;
+    return status;
 }
 
 static int api_set_enabled_async(fwk_id_t device_id, bool enable)
@@ -82,7 +83,7 @@ static int api_set_enabled_async(fwk_id_t device_id, bool enable)
         return FWK_E_PARAM;
 
     /* Ensure the identifier refers to an existing element */
-    if (fwk_module_is_valid_element_id(device_id))
+    if (!fwk_module_is_valid_element_id(device_id))
         return FWK_E_PARAM;
 
     /* Validate the API call */
@@ -145,7 +146,7 @@ static int api_get_voltage(fwk_id_t device_id, uintmax_t *voltage)
 static int api_set_voltage(fwk_id_t device_id, uintmax_t voltage)
 {
     int status;
-    const struct mod_psu_device_ctx *ctx;
+    struct mod_psu_device_ctx *ctx;
 
     /* This API call cannot target another module */
     if (fwk_id_get_module_idx(device_id) != FWK_MODULE_IDX_PSU)
@@ -164,12 +165,15 @@ static int api_set_voltage(fwk_id_t device_id, uintmax_t voltage)
     if (ctx == NULL)
         return FWK_E_PARAM;
 
+    /* The votes are applied again from the next one */
+    ctx->arbitration.voltage = 0;
+
     /* Set the voltage state through the driver */
     status = ctx->apis.driver->set_voltage(ctx->config->driver_id, voltage);
-    if (status != FWK_SUCCESS)
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING))
         return FWK_E_HANDLER;
 
-    return FWK_SUCCESS;
+    return status;
 }
 
 static int api_set_voltage_async(fwk_id_t device_id, uintmax_t voltage)
@@ -183,7 +187,7 @@ static int api_set_voltage_async(fwk_id_t device_id, uintmax_t voltage)
         return FWK_E_PARAM;
 
     /* Ensure the identifier refers to an existing element */
-    if (fwk_module_is_valid_element_id(device_id))
+    if (!fwk_module_is_valid_element_id(device_id))
         return FWK_E_PARAM;
 
     /* Validate the API call */
@@ -193,7 +197,7 @@ static int api_set_voltage_async(fwk_id_t device_id, uintmax_t voltage)
 
     /* Build and submit the event */
     event = (struct fwk_event) {
-        .id = mod_psu_event_id_set_enabled,
+        .id = mod_psu_event_id_set_voltage,
         .target_id = device_id,
         .response_requested = true,
     };
@@ -212,6 +216,138 @@ static int api_set_voltage_async(fwk_id_t device_id, uintmax_t voltage)
     return FWK_SUCCESS;
 }
 
+static int api_get_voltage_vote(
+    fwk_id_t device_id,
+    unsigned int voter_idx,
+    uintmax_t *voltage)
+{
+    int status;
+    const struct mod_psu_device_ctx *ctx;
+
+    /* This API call cannot target another module */
+    if (fwk_id_get_module_idx(device_id) != FWK_MODULE_IDX_PSU)
+        return FWK_E_PARAM;
+
+    /* Ensure the identifier refers to a valid element */
+    if (!fwk_module_is_valid_element_id(device_id))
+        return FWK_E_PARAM;
+
+    /* Validate the API call */
+    status = fwk_module_check_call(device_id);
+    if (status != FWK_SUCCESS)
+        return FWK_E_STATE;
+
+    ctx = __mod_psu_get_valid_device_ctx(device_id);
+    if ((ctx == NULL) || (voter_idx >= ctx->config->voter_count))
+        return FWK_E_PARAM;
+
+    *voltage = ctx->arbitration.vote_table[voter_idx].voltage;
+
+    return FWK_SUCCESS;
+}
+
+static int api_set_voltage_vote(
+    fwk_id_t device_id,
+    unsigned int voter_idx,
+    uintmax_t voltage)
+{
+    int status;
+    uintmax_t max_voltage;
+    struct mod_psu_device_ctx *ctx;
+
+    /* This API call cannot target another module */
+    if (fwk_id_get_module_idx(device_id) != FWK_MODULE_IDX_PSU)
+        return FWK_E_PARAM;
+
+    /* Ensure the identifier refers to a valid element */
+    if (!fwk_module_is_valid_element_id(device_id))
+        return FWK_E_PARAM;
+
+    /* Validate the API call */
+    status = fwk_module_check_call(device_id);
+    if (status != FWK_SUCCESS)
+        return FWK_E_STATE;
+
+    ctx = __mod_psu_get_valid_device_ctx(device_id);
+    if ((ctx == NULL) || (voter_idx >= ctx->config->voter_count))
+        return FWK_E_PARAM;
+
+    ctx->arbitration.vote_table[voter_idx].voltage = voltage;
+
+    if (voltage > ctx->arbitration.voltage) {
+        /* Raise the voltage through the driver right away */
+        max_voltage = __mod_psu_get_max_vote(ctx);
+
+        status = ctx->apis.driver->set_voltage(
+            ctx->config->driver_id,
+            max_voltage);
+        if ((status != FWK_SUCCESS) && (status != FWK_PENDING))
+            return FWK_E_HANDLER;
+
+        ctx->arbitration.voltage = max_voltage;
+
+        return status;
+    }
+
+    /* Lower the voltage lazily, along with the votes submitted meanwhile */
+    status = __mod_psu_schedule_apply_votes(ctx, device_id);
+    if (status == FWK_E_NOMEM)
+        return FWK_E_NOMEM;
+    else if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
+static int api_set_voltage_vote_async(
+    fwk_id_t device_id,
+    unsigned int voter_idx,
+    uintmax_t voltage)
+{
+    int status;
+    struct fwk_event event;
+    const struct mod_psu_device_ctx *ctx;
+    struct mod_psu_event_params_set_voltage_vote *params;
+
+    /* This API call cannot target another module */
+    if (fwk_id_get_module_idx(device_id) != FWK_MODULE_IDX_PSU)
+        return FWK_E_PARAM;
+
+    /* Ensure the identifier refers to an existing element */
+    if (!fwk_module_is_valid_element_id(device_id))
+        return FWK_E_PARAM;
+
+    /* Validate the API call */
+    status = fwk_module_check_call(device_id);
+    if (status != FWK_SUCCESS)
+        return FWK_E_STATE;
+
+    ctx = __mod_psu_get_valid_device_ctx(device_id);
+    if ((ctx == NULL) || (voter_idx >= ctx->config->voter_count))
+        return FWK_E_PARAM;
+
+    /* Build and submit the event */
+    event = (struct fwk_event) {
+        .id = mod_psu_event_id_set_voltage_vote,
+        .target_id = device_id,
+        .response_requested = true,
+    };
+
+    params = (void *)&event.params;
+    *params = (struct mod_psu_event_params_set_voltage_vote) {
+        .voter_idx = voter_idx,
+        .voltage = voltage,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status == FWK_E_NOMEM)
+        return FWK_E_NOMEM;
+    else if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
 /* Module API implementation */
 const struct mod_psu_device_api __mod_psu_device_api = {
     .get_enabled = api_get_enabled,
@@ -220,4 +356,33 @@ const struct mod_psu_device_api __mod_psu_device_api = {
     .get_voltage = api_get_voltage,
     .set_voltage = api_set_voltage,
     .set_voltage_async = api_set_voltage_async,
+    .get_voltage_vote = api_get_voltage_vote,
+    .set_voltage_vote = api_set_voltage_vote,
+    .set_voltage_vote_async = api_set_voltage_vote_async,
+};
+
+static void api_respond(fwk_id_t device_id, int status)
+{
+    int put_status;
+    struct fwk_event event;
+    struct mod_psu_event_params_driver_response *params;
+
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_PSU,
+                           MOD_PSU_INTERNAL_EVENT_IDX_DRIVER_RESPONSE),
+        .source_id = device_id,
+        .target_id = device_id,
+    };
+
+    params = (void *)&event.params;
+    params->status = status;
+
+    put_status = fwk_thread_put_event(&event);
+    assert(put_status == FWK_SUCCESS);
+    (void)put_status;
+}
+
+/* Driver response API implementation */
+const struct mod_psu_driver_response_api __mod_psu_driver_response_api = {
+    .respond = api_respond,
 };
@@ -13,4 +13,7 @@
 /* Module API implementation */
 extern const struct mod_psu_device_api __mod_psu_device_api;
 
+/* Driver response API implementation */
+extern const struct mod_psu_driver_response_api __mod_psu_driver_response_api;
+
 #endif /* MOD_PSU_DEVICE_API_PRIVATE_H */
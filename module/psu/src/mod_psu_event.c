@@ -9,13 +9,558 @@
 #include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <mod_psu_private.h>
 
+/* Respond to the request of a voter waiting for its vote to be satisfied */
+static int respond_to_vote(
+    struct mod_psu_vote *vote,
+    fwk_id_t device_id,
+    int status)
+{
+    int put_status;
+    struct fwk_event response;
+    struct mod_psu_event_params_set_voltage_vote_response *response_params;
+
+    vote->waiting = false;
+
+    put_status = fwk_thread_get_delayed_response(device_id, vote->cookie,
+                                                 &response);
+    if (put_status != FWK_SUCCESS)
+        return put_status;
+
+    response_params = (void *)&response.params;
+    response_params->status = status;
+
+    return fwk_thread_put_event(&response);
+}
+
+/* Respond to the requests of all the voters waiting for their vote */
+static int respond_to_voters(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    int status)
+{
+    int put_status;
+    unsigned int voter_idx;
+    struct mod_psu_vote *vote;
+
+    for (voter_idx = 0; voter_idx < ctx->config->voter_count; voter_idx++) {
+        vote = &ctx->arbitration.vote_table[voter_idx];
+        if (!vote->waiting)
+            continue;
+
+        put_status = respond_to_vote(vote, device_id, status);
+        if (put_status != FWK_SUCCESS)
+            return put_status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+#if BUILD_HAS_MOD_TIMER
+/*
+ * Get the current time in microseconds from the timer of the alarm timing the
+ * voltage ramps of a device.
+ */
+static int get_time(const struct mod_psu_device_ctx *ctx, uint64_t *time)
+{
+    int status;
+    fwk_id_t timer_id;
+
+    timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+                              fwk_id_get_element_idx(ctx->config->alarm_id));
+
+    status = ctx->apis.timer->get_time(timer_id, time);
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Estimate the output voltage of a device during the ramp in progress. The
+ * estimate is conservative for a ramp to the new voltage: without a time
+ * reference, the output voltage is assumed to be at the end of the ramp in
+ * progress farthest from the new voltage.
+ */
+static uintmax_t get_ramp_voltage(
+    const struct mod_psu_device_ctx *ctx,
+    uint64_t now,
+    bool now_valid,
+    uintmax_t new_voltage)
+{
+    uintmax_t start = ctx->ramp.start_voltage;
+    uintmax_t target = ctx->ramp.target_voltage;
+    uintmax_t step;
+
+    if (!now_valid || !ctx->ramp.start_time_valid) {
+        if (start > target)
+            return (new_voltage > target) ? target : start;
+        else
+            return (new_voltage > start) ? start : target;
+    }
+
+    /* The slew rate in mV/ms is the voltage step in mV per 1000 us */
+    step = ((now - ctx->ramp.start_time) * ctx->config->slew_rate) / 1000;
+
+    if (start > target)
+        return ((start - target) > step) ? (start - step) : target;
+    else
+        return ((target - start) > step) ? (start + step) : target;
+}
+
+/*
+ * Get the time in microseconds for the output voltage of a device to ramp
+ * between two voltages and settle.
+ */
+static uint32_t get_ramp_time(
+    const struct mod_psu_device_ctx *ctx,
+    uintmax_t from_voltage,
+    uintmax_t to_voltage)
+{
+    uintmax_t delta;
+    uintmax_t time;
+
+    delta = (from_voltage > to_voltage) ?
+        (from_voltage - to_voltage) : (to_voltage - from_voltage);
+
+    /* Round the ramp time up so as not to complete before the ramp ends */
+    time = ((delta * 1000) + ctx->config->slew_rate - 1) /
+           ctx->config->slew_rate;
+    time += ctx->config->settle_time;
+
+    return (uint32_t)FWK_MIN(time, (uintmax_t)UINT32_MAX);
+}
+
+/* Respond to the request waiting for the end of the voltage ramp */
+static int respond_to_ramp_request(
+    const struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    int status)
+{
+    int put_status;
+    struct fwk_event response;
+    struct mod_psu_event_params_set_voltage_response *response_params;
+
+    put_status = fwk_thread_get_delayed_response(device_id, ctx->ramp.cookie,
+                                                 &response);
+    if (put_status != FWK_SUCCESS)
+        return put_status;
+
+    response_params = (void *)&response.params;
+    response_params->status = status;
+
+    return fwk_thread_put_event(&response);
+}
+
+/* Alarm callback, called from the timer ISR at the end of a voltage ramp */
+static void ramp_alarm_callback(uintptr_t param)
+{
+    int status;
+    struct fwk_event event;
+    struct mod_psu_event_params_ramp_complete *params;
+    fwk_id_t device_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_PSU, param);
+
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_PSU,
+                           MOD_PSU_INTERNAL_EVENT_IDX_RAMP_COMPLETE),
+        .source_id = device_id,
+        .target_id = device_id,
+    };
+
+    params = (void *)&event.params;
+    params->seq = __mod_psu_get_device_ctx(device_id)->ramp.seq;
+
+    status = fwk_thread_put_event(&event);
+    assert(status == FWK_SUCCESS);
+    (void)status;
+}
+
+/*
+ * Set the voltage of a device and start the alarm signalling the end of the
+ * ramp to the new voltage. The ramp status is FWK_PENDING while the ramp is in
+ * progress, FWK_SUCCESS if the output voltage settled immediately, or the
+ * error that prevented the voltage change.
+ */
+static int start_ramp(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    uintmax_t new_voltage,
+    bool arbitrated,
+    int *ramp_status)
+{
+    int status;
+    bool now_valid;
+    uint64_t now = 0;
+    uintmax_t voltage;
+    uint32_t ramp_time;
+
+    now_valid = (get_time(ctx, &now) == FWK_SUCCESS);
+
+    /* A ramp in progress is redirected from the voltage it has reached */
+    if (ctx->ramp.pending)
+        voltage = get_ramp_voltage(ctx, now, now_valid, new_voltage);
+    else {
+        status = ctx->apis.driver->get_voltage(
+            ctx->config->driver_id,
+            &voltage);
+        if (status != FWK_SUCCESS) {
+            *ramp_status = status;
+            return FWK_SUCCESS;
+        }
+    }
+
+    /*
+     * Set the voltage through the driver. The ramp is timed from the slew rate
+     * even if the driver completes the change asynchronously.
+     */
+    status = ctx->apis.driver->set_voltage(
+        ctx->config->driver_id,
+        new_voltage);
+    if ((status != FWK_SUCCESS) && (status != FWK_PENDING)) {
+        *ramp_status = status;
+        return FWK_SUCCESS;
+    }
+
+    if (ctx->ramp.pending) {
+        /* Stop the alarm first so that it does not report the new ramp */
+        ctx->apis.alarm->stop(ctx->config->alarm_id);
+        ctx->ramp.pending = false;
+
+        /*
+         * The voters waiting for a redirected ramp keep waiting when the new
+         * ramp applies the votes as well.
+         */
+        status = FWK_SUCCESS;
+        if (!ctx->ramp.arbitrated)
+            status = respond_to_ramp_request(ctx, device_id,
+                                             FWK_E_OVERWRITTEN);
+        else if (!arbitrated)
+            status = respond_to_voters(ctx, device_id, FWK_E_OVERWRITTEN);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    ctx->ramp.seq++;
+
+    ramp_time = get_ramp_time(ctx, voltage, new_voltage);
+    if (ramp_time == 0) {
+        *ramp_status = FWK_SUCCESS;
+        return FWK_SUCCESS;
+    }
+
+    status = ctx->apis.alarm->start_us(
+        ctx->config->alarm_id,
+        ramp_time,
+        MOD_TIMER_ALARM_TYPE_ONCE,
+        ramp_alarm_callback,
+        fwk_id_get_element_idx(device_id));
+    if (status != FWK_SUCCESS) {
+        *ramp_status = FWK_E_DEVICE;
+        return FWK_SUCCESS;
+    }
+
+    ctx->ramp.pending = true;
+    ctx->ramp.arbitrated = arbitrated;
+    ctx->ramp.start_voltage = voltage;
+    ctx->ramp.target_voltage = new_voltage;
+    ctx->ramp.start_time = now;
+    ctx->ramp.start_time_valid = now_valid;
+
+    *ramp_status = FWK_PENDING;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Set the voltage of a device and complete the request once the output
+ * voltage has ramped to the new voltage and settled.
+ */
+static int set_voltage_ramped(
+    struct mod_psu_device_ctx *ctx,
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    int status;
+    int ramp_status;
+    const struct mod_psu_event_params_set_voltage *params;
+    struct mod_psu_event_params_set_voltage_response *response_params;
+
+    params = (void *)&event->params;
+    response_params = (void *)&response->params;
+
+    status = start_ramp(ctx, event->target_id, params->voltage, false,
+                        &ramp_status);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (ramp_status != FWK_PENDING) {
+        response_params->status = ramp_status;
+        return FWK_SUCCESS;
+    }
+
+    ctx->ramp.cookie = event->cookie;
+    response->is_delayed_response = true;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Apply the votes of a device and complete the requests of the voters once
+ * the output voltage has ramped to the highest vote and settled.
+ */
+static int apply_votes_ramped(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    uintmax_t voltage)
+{
+    int status;
+    int ramp_status;
+
+    status = start_ramp(ctx, device_id, voltage, true, &ramp_status);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((ramp_status == FWK_SUCCESS) || (ramp_status == FWK_PENDING))
+        ctx->arbitration.voltage = voltage;
+
+    if (ramp_status == FWK_PENDING)
+        return FWK_SUCCESS;
+
+    return respond_to_voters(ctx, device_id, ramp_status);
+}
+
+static int mod_psu_event_ramp_complete(
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    int status;
+    struct mod_psu_device_ctx *ctx;
+    const struct mod_psu_event_params_ramp_complete *params;
+
+    params = (void *)&event->params;
+
+    ctx = __mod_psu_get_device_ctx(event->target_id);
+
+    /* Ignore the alarms of the ramps redirected since they triggered */
+    if (!ctx->ramp.pending || (params->seq != ctx->ramp.seq))
+        return FWK_SUCCESS;
+
+    ctx->ramp.pending = false;
+
+    if (!ctx->ramp.arbitrated)
+        return respond_to_ramp_request(ctx, event->target_id, FWK_SUCCESS);
+
+    status = respond_to_voters(ctx, event->target_id, FWK_SUCCESS);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Settle the votes that dropped while the output voltage ramped */
+    if (__mod_psu_get_max_vote(ctx) != ctx->arbitration.voltage)
+        return __mod_psu_schedule_apply_votes(ctx, event->target_id);
+
+    return FWK_SUCCESS;
+}
+#endif
+
+/* Wait for the response of the driver completing a request asynchronously */
+static void wait_for_driver(
+    struct mod_psu_device_ctx *ctx,
+    enum mod_psu_driver_request_type type,
+    uint32_t cookie,
+    uintmax_t voltage)
+{
+    ctx->driver_request.pending = true;
+    ctx->driver_request.type = type;
+    ctx->driver_request.cookie = cookie;
+    ctx->driver_request.voltage = voltage;
+}
+
+uintmax_t __mod_psu_get_max_vote(const struct mod_psu_device_ctx *ctx)
+{
+    unsigned int voter_idx;
+    uintmax_t voltage = 0;
+
+    for (voter_idx = 0; voter_idx < ctx->config->voter_count; voter_idx++) {
+        voltage = FWK_MAX(voltage,
+                          ctx->arbitration.vote_table[voter_idx].voltage);
+    }
+
+    return voltage;
+}
+
+int __mod_psu_schedule_apply_votes(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id)
+{
+    int status;
+    struct fwk_event event;
+
+    /*
+     * The pending event is processed after the votes submitted before it,
+     * which it applies in a single voltage change.
+     */
+    if (ctx->arbitration.apply_pending)
+        return FWK_SUCCESS;
+
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_PSU,
+                           MOD_PSU_INTERNAL_EVENT_IDX_APPLY_VOTES),
+        .source_id = device_id,
+        .target_id = device_id,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx->arbitration.apply_pending = true;
+
+    return FWK_SUCCESS;
+}
+
+static int mod_psu_event_apply_votes(
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    int status;
+    uintmax_t voltage;
+    struct mod_psu_device_ctx *ctx;
+
+    ctx = __mod_psu_get_device_ctx(event->target_id);
+    ctx->arbitration.apply_pending = false;
+
+    /* The votes are applied again once the driver responds */
+    if (ctx->driver_request.pending)
+        return FWK_SUCCESS;
+
+    voltage = __mod_psu_get_max_vote(ctx);
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Lower votes are applied again once the ramp in progress completes */
+    if (ctx->ramp.pending && ctx->ramp.arbitrated &&
+        (voltage <= ctx->arbitration.voltage))
+        return FWK_SUCCESS;
+    #endif
+
+    /* The output voltage is left unchanged once all the votes are withdrawn */
+    if ((voltage == 0) || (voltage == ctx->arbitration.voltage))
+        return respond_to_voters(ctx, event->target_id, FWK_SUCCESS);
+
+    /* The output voltage satisfies the votes until it is lowered */
+    if (voltage < ctx->arbitration.voltage) {
+        status = respond_to_voters(ctx, event->target_id, FWK_SUCCESS);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    #if BUILD_HAS_MOD_TIMER
+    if (ctx->apis.alarm != NULL)
+        return apply_votes_ramped(ctx, event->target_id, voltage);
+    #endif
+
+    /* Set the voltage through the driver */
+    status = ctx->apis.driver->set_voltage(ctx->config->driver_id, voltage);
+    if (status == FWK_PENDING) {
+        wait_for_driver(ctx, MOD_PSU_DRIVER_REQUEST_TYPE_APPLY_VOTES, 0,
+                        voltage);
+        return FWK_SUCCESS;
+    }
+
+    if (status == FWK_SUCCESS)
+        ctx->arbitration.voltage = voltage;
+
+    return respond_to_voters(ctx, event->target_id, status);
+}
+
+/* Complete the votes applied asynchronously by the driver */
+static int complete_votes(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id,
+    int status)
+{
+    if (status != FWK_SUCCESS)
+        return respond_to_voters(ctx, device_id, status);
+
+    ctx->arbitration.voltage = ctx->driver_request.voltage;
+
+    /* The voters whose vote was raised meanwhile wait for the next change */
+    if (__mod_psu_get_max_vote(ctx) > ctx->arbitration.voltage)
+        return __mod_psu_schedule_apply_votes(ctx, device_id);
+
+    status = respond_to_voters(ctx, device_id, FWK_SUCCESS);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Settle the votes that dropped while the driver changed the voltage */
+    if (__mod_psu_get_max_vote(ctx) != ctx->arbitration.voltage)
+        return __mod_psu_schedule_apply_votes(ctx, device_id);
+
+    return FWK_SUCCESS;
+}
+
+static int mod_psu_event_driver_response(
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    int status;
+    unsigned int voter_idx;
+    struct fwk_event delayed_response;
+    struct mod_psu_device_ctx *ctx;
+    const struct mod_psu_event_params_driver_response *params;
+    struct mod_psu_event_params_set_enabled_response *enabled_params;
+    struct mod_psu_event_params_set_voltage_response *voltage_params;
+
+    params = (void *)&event->params;
+
+    ctx = __mod_psu_get_device_ctx(event->target_id);
+
+    /*
+     * Ignore the responses to the requests not waited for, made through the
+     * synchronous API or timed from the slew rate.
+     */
+    if (!ctx->driver_request.pending)
+        return FWK_SUCCESS;
+
+    ctx->driver_request.pending = false;
+
+    if (ctx->driver_request.type == MOD_PSU_DRIVER_REQUEST_TYPE_APPLY_VOTES)
+        return complete_votes(ctx, event->target_id, params->status);
+
+    status = fwk_thread_get_delayed_response(event->target_id,
+                                             ctx->driver_request.cookie,
+                                             &delayed_response);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (ctx->driver_request.type == MOD_PSU_DRIVER_REQUEST_TYPE_SET_ENABLED) {
+        enabled_params = (void *)&delayed_response.params;
+        enabled_params->status = params->status;
+    } else {
+        voltage_params = (void *)&delayed_response.params;
+        voltage_params->status = params->status;
+    }
+
+    status = fwk_thread_put_event(&delayed_response);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Apply the votes submitted while the driver was busy */
+    for (voter_idx = 0; voter_idx < ctx->config->voter_count; voter_idx++) {
+        if (ctx->arbitration.vote_table[voter_idx].waiting)
+            return __mod_psu_schedule_apply_votes(ctx, event->target_id);
+    }
+
+    return FWK_SUCCESS;
+}
+
 int mod_psu_event_set_enabled(
     const struct fwk_event *event,
     struct fwk_event *response)
 {
-    const struct mod_psu_device_ctx *ctx;
+    int status;
+    struct mod_psu_device_ctx *ctx;
     const struct mod_psu_event_params_set_enabled *params;
     struct mod_psu_event_params_set_enabled_response *response_params;
 
@@ -29,10 +574,23 @@ int mod_psu_event_set_enabled(
 
     ctx = __mod_psu_get_device_ctx(event->target_id);
 
+    if (ctx->driver_request.pending) {
+        response_params->status = FWK_E_BUSY;
+        return FWK_SUCCESS;
+    }
+
     /* Set the enabled state through the driver */
-    response_params->status = ctx->apis.driver->set_enabled(
+    status = ctx->apis.driver->set_enabled(
         ctx->config->driver_id,
         params->enable);
+    if (status == FWK_PENDING) {
+        wait_for_driver(ctx, MOD_PSU_DRIVER_REQUEST_TYPE_SET_ENABLED,
+                        event->cookie, 0);
+        response->is_delayed_response = true;
+        return FWK_SUCCESS;
+    }
+
+    response_params->status = status;
 
     return FWK_SUCCESS;
 }
@@ -41,7 +599,8 @@ int mod_psu_event_set_voltage(
     const struct fwk_event *event,
     struct fwk_event *response)
 {
-    const struct mod_psu_device_ctx *ctx;
+    int status;
+    struct mod_psu_device_ctx *ctx;
     const struct mod_psu_event_params_set_voltage *params;
     struct mod_psu_event_params_set_voltage_response *response_params;
 
@@ -55,10 +614,78 @@ int mod_psu_event_set_voltage(
 
     ctx = __mod_psu_get_device_ctx(event->target_id);
 
+    if (ctx->driver_request.pending) {
+        response_params->status = FWK_E_BUSY;
+        return FWK_SUCCESS;
+    }
+
+    /* The votes are applied again from the next one */
+    ctx->arbitration.voltage = 0;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (ctx->apis.alarm != NULL)
+        return set_voltage_ramped(ctx, event, response);
+    #endif
+
     /* Set the voltage through the driver */
-    response_params->status = ctx->apis.driver->set_voltage(
+    status = ctx->apis.driver->set_voltage(
         ctx->config->driver_id,
         params->voltage);
+    if (status == FWK_PENDING) {
+        wait_for_driver(ctx, MOD_PSU_DRIVER_REQUEST_TYPE_SET_VOLTAGE,
+                        event->cookie, 0);
+        response->is_delayed_response = true;
+        return FWK_SUCCESS;
+    }
+
+    response_params->status = status;
+
+    return FWK_SUCCESS;
+}
+
+int mod_psu_event_set_voltage_vote(
+    const struct fwk_event *event,
+    struct fwk_event *response)
+{
+    int status;
+    struct mod_psu_vote *vote;
+    struct mod_psu_device_ctx *ctx;
+    const struct mod_psu_event_params_set_voltage_vote *params;
+    struct mod_psu_event_params_set_voltage_vote_response *response_params;
+
+    /* These conditions were checked when we submitted the event */
+    assert(fwk_id_get_module_idx(event->target_id) == FWK_MODULE_IDX_PSU);
+    assert(fwk_module_is_valid_element_id(event->target_id));
+
+    /* Explicitly cast to our parameter types */
+    params = (void *)&event->params;
+    response_params = (void *)&response->params;
+
+    ctx = __mod_psu_get_device_ctx(event->target_id);
+
+    assert(params->voter_idx < ctx->config->voter_count);
+    vote = &ctx->arbitration.vote_table[params->voter_idx];
+
+    /* The previous request of the voter is superseded */
+    if (vote->waiting) {
+        status = respond_to_vote(vote, event->target_id, FWK_E_OVERWRITTEN);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    vote->voltage = params->voltage;
+
+    status = __mod_psu_schedule_apply_votes(ctx, event->target_id);
+    if (status != FWK_SUCCESS) {
+        response_params->status = status;
+        return FWK_SUCCESS;
+    }
+
+    /* Respond once the output voltage satisfies the vote */
+    vote->cookie = event->cookie;
+    vote->waiting = true;
+
+    response->is_delayed_response = true;
 
     return FWK_SUCCESS;
 }
@@ -74,6 +701,14 @@ int __mod_psu_process_event(
     static const handler_t handlers[] = {
         [MOD_PSU_EVENT_IDX_SET_ENABLED] = mod_psu_event_set_enabled,
         [MOD_PSU_EVENT_IDX_SET_VOLTAGE] = mod_psu_event_set_voltage,
+        [MOD_PSU_EVENT_IDX_SET_VOLTAGE_VOTE] = mod_psu_event_set_voltage_vote,
+        #if BUILD_HAS_MOD_TIMER
+        [MOD_PSU_INTERNAL_EVENT_IDX_RAMP_COMPLETE] =
+            mod_psu_event_ramp_complete,
+        #endif
+        [MOD_PSU_INTERNAL_EVENT_IDX_APPLY_VOTES] = mod_psu_event_apply_votes,
+        [MOD_PSU_INTERNAL_EVENT_IDX_DRIVER_RESPONSE] =
+            mod_psu_event_driver_response,
     };
 
     unsigned int event_idx;
@@ -10,6 +10,16 @@
 
 #include <fwk_event.h>
 #include <fwk_id.h>
+#include <mod_psu.h>
+#include <mod_psu_module_private.h>
+
+/* Events internal to the module, following the public ones */
+enum mod_psu_internal_event_idx {
+    MOD_PSU_INTERNAL_EVENT_IDX_RAMP_COMPLETE = MOD_PSU_EVENT_IDX_COUNT,
+    MOD_PSU_INTERNAL_EVENT_IDX_APPLY_VOTES,
+    MOD_PSU_INTERNAL_EVENT_IDX_DRIVER_RESPONSE,
+    MOD_PSU_INTERNAL_EVENT_IDX_COUNT
+};
 
 /* "Set enabled" event */
 struct mod_psu_event_params_set_enabled {
@@ -21,6 +31,32 @@ struct mod_psu_event_params_set_voltage {
     uintmax_t voltage;
 };
 
+/* "Set voltage vote" event */
+struct mod_psu_event_params_set_voltage_vote {
+    unsigned int voter_idx;
+    uintmax_t voltage;
+};
+
+/* "Ramp complete" event */
+struct mod_psu_event_params_ramp_complete {
+    /* Sequence number of the ramp the alarm was started for */
+    unsigned int seq;
+};
+
+/* "Driver response" event */
+struct mod_psu_event_params_driver_response {
+    /* Status of the request the driver completed */
+    int status;
+};
+
+/* Get the highest vote of the voters of a device */
+uintmax_t __mod_psu_get_max_vote(const struct mod_psu_device_ctx *ctx);
+
+/* Submit the event applying the votes of a device, unless one is pending */
+int __mod_psu_schedule_apply_votes(
+    struct mod_psu_device_ctx *ctx,
+    fwk_id_t device_id);
+
 /* Event handler */
 int __mod_psu_process_event(
     const struct fwk_event *event,
@@ -34,9 +34,27 @@ static int psu_element_init(
     unsigned int sub_element_count,
     const void *data)
 {
+    struct mod_psu_device_ctx *ctx;
+    const struct mod_psu_device_config *config = data;
+
     assert(sub_element_count == 0);
 
-    __mod_psu_get_device_ctx(device_id)->config = data;
+    /* The voltage ramps are timed with an alarm */
+    if ((config->slew_rate != 0) &&
+        !fwk_id_is_type(config->alarm_id, FWK_ID_TYPE_SUB_ELEMENT))
+        return FWK_E_DATA;
+
+    ctx = __mod_psu_get_device_ctx(device_id);
+    ctx->config = config;
+
+    if (config->voter_count == 0)
+        return FWK_SUCCESS;
+
+    ctx->arbitration.vote_table = fwk_mm_calloc(
+        config->voter_count,
+        sizeof(ctx->arbitration.vote_table[0]));
+    if (ctx->arbitration.vote_table == NULL)
+        return FWK_E_NOMEM;
 
     return FWK_SUCCESS;
 }
@@ -44,7 +62,7 @@ static int psu_element_init(
 static int psu_bind_element(fwk_id_t device_id, unsigned int round)
 {
     int status;
-    const struct mod_psu_device_ctx *ctx;
+    struct mod_psu_device_ctx *ctx;
 
     /* Only handle the first round */
     if (round > 0)
@@ -68,6 +86,27 @@ static int psu_bind_element(fwk_id_t device_id, unsigned int round)
     assert(ctx->apis.driver->set_voltage != NULL);
     assert(ctx->apis.driver->get_voltage != NULL);
 
+    #if BUILD_HAS_MOD_TIMER
+    if (ctx->config->slew_rate == 0)
+        return FWK_SUCCESS;
+
+    /* Bind to the alarm timing the voltage ramps and to its timer */
+    status = fwk_module_bind(
+        ctx->config->alarm_id,
+        MOD_TIMER_API_ID_ALARM,
+        &ctx->apis.alarm);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    status = fwk_module_bind(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+                       fwk_id_get_element_idx(ctx->config->alarm_id)),
+        MOD_TIMER_API_ID_TIMER,
+        &ctx->apis.timer);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+    #endif
+
     return FWK_SUCCESS;
 }
 
@@ -86,15 +125,27 @@ static int psu_process_bind_request(
     fwk_id_t api_id,
     const void **api)
 {
+    const struct mod_psu_device_ctx *ctx;
+
     /* Only accept binds to the elements */
     if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
         return FWK_E_PARAM;
 
-    /* Only expose the device API */
-    if (!fwk_id_is_equal(api_id, mod_psu_api_id_psu_device))
+    if (fwk_id_is_equal(api_id, mod_psu_api_id_psu_device)) {
+        *api = &__mod_psu_device_api;
+
+        return FWK_SUCCESS;
+    }
+
+    if (!fwk_id_is_equal(api_id, mod_psu_api_id_driver_response))
         return FWK_E_PARAM;
 
-    *api = &__mod_psu_device_api;
+    /* Only the driver of the device reports the completion of its requests */
+    ctx = __mod_psu_get_device_ctx(target_id);
+    if (!fwk_id_is_equal(source_id, ctx->config->driver_id))
+        return FWK_E_ACCESS;
+
+    *api = &__mod_psu_driver_response_api;
 
     return FWK_SUCCESS;
 }
@@ -124,5 +175,5 @@ const struct fwk_module module_psu = {
     .process_bind_request = psu_process_bind_request,
     .process_event = __mod_psu_process_event,
     .api_count = MOD_PSU_API_IDX_COUNT,
-    .event_count = MOD_PSU_EVENT_IDX_COUNT,
+    .event_count = MOD_PSU_INTERNAL_EVENT_IDX_COUNT,
 };
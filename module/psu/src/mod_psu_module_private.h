@@ -8,8 +8,32 @@
 #ifndef MOD_PSU_DEVICE_CTX_PRIVATE_H
 #define MOD_PSU_DEVICE_CTX_PRIVATE_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <fwk_id.h>
 #include <mod_psu.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
+
+/* Voltage vote of a voter */
+struct mod_psu_vote {
+    /* Voltage voted for (mV), zero if the voter has no vote */
+    uintmax_t voltage;
+
+    /* Cookie of the request waiting for the output voltage to satisfy it */
+    uint32_t cookie;
+
+    /* A request is waiting for the output voltage to satisfy it */
+    bool waiting;
+};
+
+/* Requests waiting for the response of an asynchronous driver */
+enum mod_psu_driver_request_type {
+    MOD_PSU_DRIVER_REQUEST_TYPE_SET_ENABLED,
+    MOD_PSU_DRIVER_REQUEST_TYPE_SET_VOLTAGE,
+    MOD_PSU_DRIVER_REQUEST_TYPE_APPLY_VOTES,
+};
 
 /* Device context */
 struct mod_psu_device_ctx {
@@ -19,7 +43,67 @@ struct mod_psu_device_ctx {
     struct {
         /* Driver API */
         const struct mod_psu_driver_api *driver;
+
+        #if BUILD_HAS_MOD_TIMER
+        /* Timer API, used to measure the progress of the voltage ramps */
+        const struct mod_timer_api *timer;
+
+        /* Alarm API, NULL if the voltage ramps are not timed */
+        const struct mod_timer_alarm_api *alarm;
+        #endif
     } apis;
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Voltage ramp */
+    struct {
+        /* A ramp is in progress */
+        bool pending;
+
+        /* Sequence number of the ramp, incremented when a ramp starts */
+        unsigned int seq;
+
+        /* Cookie of the request waiting for the end of the ramp */
+        uint32_t cookie;
+
+        /* Voltages at the start and at the end of the ramp (mV) */
+        uintmax_t start_voltage;
+        uintmax_t target_voltage;
+
+        /* Time at the start of the ramp (us), if it was available */
+        uint64_t start_time;
+        bool start_time_valid;
+
+        /* The ramp applies the votes rather than a direct request */
+        bool arbitrated;
+    } ramp;
+    #endif
+
+    /* Request waiting for the response of the driver */
+    struct {
+        /* The driver is completing a request asynchronously */
+        bool pending;
+
+        /* Type of the request */
+        enum mod_psu_driver_request_type type;
+
+        /* Cookie of the request, unless it applies the votes */
+        uint32_t cookie;
+
+        /* Voltage requested to the driver (mV), when it applies the votes */
+        uintmax_t voltage;
+    } driver_request;
+
+    /* Voltage arbitration between the voters of the device */
+    struct {
+        /* Table of the votes, one per voter */
+        struct mod_psu_vote *vote_table;
+
+        /* Voltage applied by the arbitration (mV), zero if none was yet */
+        uintmax_t voltage;
+
+        /* The votes are due to be applied by a pending event */
+        bool apply_pending;
+    } arbitration;
 };
 
 struct mod_psu_device_ctx *__mod_psu_get_device_ctx(fwk_id_t device_id);
@@ -0,0 +1,191 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Register script interpreter.
+ */
+
+#ifndef MOD_REG_SCRIPT_H
+#define MOD_REG_SCRIPT_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupRegScript Register Script Interpreter
+ *
+ * \details Register initialization sequences are described by scripts rather
+ *      than by chains of register accesses in C. A script is a table of 32-bit
+ *      words holding a list of operations, terminated by an end operation.
+ *      Each operation starts with a header word holding the operation in its
+ *      four most significant bits and an argument in the other bits, and is
+ *      followed by zero to three parameter words.
+ *
+ *      The register offsets of the operations are relative to a base address
+ *      given when running the script, so that a script can be shared by the
+ *      instances of a peripheral. A script can be run again as is, for
+ *      instance to restore the state of a peripheral on resume.
+ *
+ *      The scripts are expected to be written with the macros below, or to be
+ *      generated from the register tables of the peripherals.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Operations.
+ */
+enum mod_reg_script_op {
+    /*! End of the script */
+    MOD_REG_SCRIPT_OP_END,
+
+    /*! Write of the parameter word to the register */
+    MOD_REG_SCRIPT_OP_WRITE,
+
+    /*!
+     * \brief Read-modify-write of the register.
+     *
+     * \details The bits of the register set in the first parameter word are
+     *      replaced by those of the second parameter word.
+     */
+    MOD_REG_SCRIPT_OP_RMW,
+
+    /*!
+     * \brief Read of the register, the value is discarded.
+     *
+     * \details Used to make sure that the previous writes to the peripheral
+     *      have completed.
+     */
+    MOD_REG_SCRIPT_OP_READ,
+
+    /*!
+     * \brief Poll of the register.
+     *
+     * \details The bits of the register set in the first parameter word are
+     *      polled until they are equal to those of the second parameter word,
+     *      or until the timeout given in microseconds by the third parameter
+     *      word has elapsed.
+     */
+    MOD_REG_SCRIPT_OP_POLL,
+
+    /*! Delay, the argument is the delay in microseconds */
+    MOD_REG_SCRIPT_OP_DELAY,
+
+    /*! Number of defined operations */
+    MOD_REG_SCRIPT_OP_COUNT
+};
+
+/*! Position of the operation in the header word */
+#define MOD_REG_SCRIPT_OP_POS 28
+
+/*! Mask of the argument in the header word */
+#define MOD_REG_SCRIPT_ARG_MASK UINT32_C(0x0FFFFFFF)
+
+/*!
+ * \brief Build the header word of an operation.
+ *
+ * \param OP Operation, see ::mod_reg_script_op.
+ * \param ARG Register offset, or delay in microseconds. Must be lower than
+ *      2^28.
+ */
+#define MOD_REG_SCRIPT_HEADER(OP, ARG) \
+    (((uint32_t)(OP) << MOD_REG_SCRIPT_OP_POS) | \
+     ((uint32_t)(ARG) & MOD_REG_SCRIPT_ARG_MASK))
+
+/*! End of a script */
+#define MOD_REG_SCRIPT_END() \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_END, 0)
+
+/*! Write \p VALUE to the register at \p OFFSET */
+#define MOD_REG_SCRIPT_WRITE(OFFSET, VALUE) \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_WRITE, (OFFSET)), \
+    (uint32_t)(VALUE)
+
+/*! Replace the bits in \p MASK of the register at \p OFFSET by \p VALUE */
+#define MOD_REG_SCRIPT_RMW(OFFSET, MASK, VALUE) \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_RMW, (OFFSET)), \
+    (uint32_t)(MASK), \
+    (uint32_t)(VALUE)
+
+/*! Read the register at \p OFFSET */
+#define MOD_REG_SCRIPT_READ(OFFSET) \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_READ, (OFFSET))
+
+/*!
+ * \brief Wait until the bits in \p MASK of the register at \p OFFSET are equal
+ *      to \p VALUE, for \p TIMEOUT_US microseconds at most.
+ */
+#define MOD_REG_SCRIPT_POLL(OFFSET, MASK, VALUE, TIMEOUT_US) \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_POLL, (OFFSET)), \
+    (uint32_t)(MASK), \
+    (uint32_t)(VALUE), \
+    (uint32_t)(TIMEOUT_US)
+
+/*! Wait for \p US microseconds */
+#define MOD_REG_SCRIPT_DELAY(US) \
+    MOD_REG_SCRIPT_HEADER(MOD_REG_SCRIPT_OP_DELAY, (US))
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_reg_script_config {
+    /*! Identifier of the timer device timing the delays and the polls */
+    fwk_id_t timer_id;
+};
+
+/*!
+ * \brief Register script API.
+ */
+struct mod_reg_script_api {
+    /*!
+     * \brief Run a script.
+     *
+     * \details The operations are run in order, until the end of the script
+     *      or the first failed operation.
+     *
+     * \param script Pointer to the script.
+     * \param base Base address of the register offsets of the script.
+     * \param[out] failed_op Index in the script of the header word of the
+     *      failed operation, if any. May be NULL.
+     *
+     * \retval FWK_SUCCESS The script has completed.
+     * \retval FWK_E_PARAM The script is NULL or holds an invalid operation.
+     * \retval FWK_E_TIMEOUT A poll has timed out.
+     * \retval One of the other error codes returned by the timer API.
+     */
+    int (*run)(const uint32_t *script, uintptr_t base, unsigned int *failed_op);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_reg_script_api_idx {
+    /*! Index of the register script API */
+    MOD_REG_SCRIPT_API_IDX_RUN,
+
+    /*! Number of APIs */
+    MOD_REG_SCRIPT_API_COUNT
+};
+
+/*! Identifier of the register script API */
+#define MOD_REG_SCRIPT_API_ID_RUN \
+    FWK_ID_API(FWK_MODULE_IDX_REG_SCRIPT, MOD_REG_SCRIPT_API_IDX_RUN)
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_REG_SCRIPT_H */
@@ -0,0 +1,170 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Register script interpreter.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <mod_reg_script.h>
+#include <mod_timer.h>
+
+/* Number of parameter words of each operation */
+static const uint8_t param_count_table[MOD_REG_SCRIPT_OP_COUNT] = {
+    [MOD_REG_SCRIPT_OP_END] = 0,
+    [MOD_REG_SCRIPT_OP_WRITE] = 1,
+    [MOD_REG_SCRIPT_OP_RMW] = 2,
+    [MOD_REG_SCRIPT_OP_READ] = 0,
+    [MOD_REG_SCRIPT_OP_POLL] = 3,
+    [MOD_REG_SCRIPT_OP_DELAY] = 0,
+};
+
+/* Register and expected value of a poll */
+struct poll_ctx {
+    volatile uint32_t *reg;
+    uint32_t mask;
+    uint32_t value;
+};
+
+static struct mod_reg_script_ctx {
+    /* Module configuration */
+    const struct mod_reg_script_config *config;
+
+    /* Timer API */
+    struct mod_timer_api *timer_api;
+} ctx;
+
+static bool poll_cond(void *data)
+{
+    struct poll_ctx *poll = data;
+
+    return (*poll->reg & poll->mask) == poll->value;
+}
+
+/*
+ * Module API
+ */
+
+static int run(const uint32_t *script, uintptr_t base, unsigned int *failed_op)
+{
+    int status = FWK_SUCCESS;
+    const uint32_t *header = script;
+    const uint32_t *param;
+    enum mod_reg_script_op op;
+    uint32_t arg;
+    volatile uint32_t *reg;
+    struct poll_ctx poll;
+
+    if (script == NULL)
+        return FWK_E_PARAM;
+
+    for (;; header = param + param_count_table[op]) {
+        op = (enum mod_reg_script_op)(*header >> MOD_REG_SCRIPT_OP_POS);
+        if (op >= MOD_REG_SCRIPT_OP_COUNT) {
+            status = FWK_E_PARAM;
+            break;
+        }
+
+        arg = *header & MOD_REG_SCRIPT_ARG_MASK;
+        param = header + 1;
+        reg = (volatile uint32_t *)(base + arg);
+
+        switch (op) {
+        case MOD_REG_SCRIPT_OP_WRITE:
+            *reg = param[0];
+            break;
+
+        case MOD_REG_SCRIPT_OP_RMW:
+            *reg = (*reg & ~param[0]) | (param[1] & param[0]);
+            break;
+
+        case MOD_REG_SCRIPT_OP_READ:
+            (void)*reg;
+            break;
+
+        case MOD_REG_SCRIPT_OP_POLL:
+            poll.reg = reg;
+            poll.mask = param[0];
+            poll.value = param[1] & param[0];
+            status = ctx.timer_api->wait(ctx.config->timer_id, param[2],
+                                         poll_cond, &poll);
+            break;
+
+        case MOD_REG_SCRIPT_OP_DELAY:
+            /* Make sure that the writes have completed before waiting */
+            __sync_synchronize();
+            status = ctx.timer_api->delay(ctx.config->timer_id, arg);
+            break;
+
+        default:
+            break;
+        }
+
+        if ((op == MOD_REG_SCRIPT_OP_END) || (status != FWK_SUCCESS))
+            break;
+    }
+
+    if ((status != FWK_SUCCESS) && (failed_op != NULL))
+        *failed_op = (unsigned int)(header - script);
+
+    return status;
+}
+
+static const struct mod_reg_script_api reg_script_api = {
+    .run = run,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int reg_script_init(fwk_id_t module_id, unsigned int element_count,
+                           const void *data)
+{
+    if (data == NULL)
+        return FWK_E_PARAM;
+
+    ctx.config = data;
+
+    return FWK_SUCCESS;
+}
+
+static int reg_script_bind(fwk_id_t id, unsigned int round)
+{
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(ctx.config->timer_id, MOD_TIMER_API_ID_TIMER,
+                           &ctx.timer_api);
+}
+
+static int reg_script_process_bind_request(fwk_id_t requester_id,
+                                           fwk_id_t target_id,
+                                           fwk_id_t api_id,
+                                           const void **api)
+{
+    if (!fwk_id_is_equal(api_id, MOD_REG_SCRIPT_API_ID_RUN))
+        return FWK_E_PARAM;
+
+    *api = &reg_script_api;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_reg_script = {
+    .name = "Register script",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_REG_SCRIPT_API_COUNT,
+    .init = reg_script_init,
+    .bind = reg_script_bind,
+    .process_bind_request = reg_script_process_bind_request,
+};
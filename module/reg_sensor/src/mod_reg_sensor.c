@@ -11,6 +11,7 @@
 #include <fwk_id.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <mod_reg_sensor.h>
 #include <mod_sensor.h>
 
@@ -42,6 +43,33 @@ static int get_value(fwk_id_t id, uint64_t *value)
     return FWK_SUCCESS;
 }
 
+static int get_values(const fwk_id_t *id_table, unsigned int count,
+                      uint64_t *value_table)
+{
+    int status;
+    unsigned int idx;
+    const struct mod_reg_sensor_dev_config *config;
+
+    /* The module is checked once for the whole group */
+    status = fwk_module_check_call(FWK_ID_MODULE(FWK_MODULE_IDX_REG_SENSOR));
+    if (status != FWK_SUCCESS) {
+        assert(false);
+        return status;
+    }
+
+    if ((id_table == NULL) || (value_table == NULL)) {
+        assert(false);
+        return FWK_E_PARAM;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        config = config_table[fwk_id_get_element_idx(id_table[idx])];
+        value_table[idx] = *(uint64_t*)config->reg;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int get_info(fwk_id_t id, struct mod_sensor_info *info)
 {
     int status;
@@ -65,6 +93,7 @@ static int get_info(fwk_id_t id, struct mod_sensor_info *info)
 static const struct mod_sensor_driver_api reg_sensor_api = {
     .get_value = get_value,
     .get_info = get_info,
+    .get_values = get_values,
 };
 
 /*
@@ -13,16 +13,20 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <fwk_list.h>
 #include <mod_scmi.h>
 
 #define SCMI_VERSION 0x10000
 
-#define SCMI_MESSAGE_HEADER_MESSAGE_ID_POS  0
-#define SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS 10
-#define SCMI_MESSAGE_HEADER_TOKEN_POS       18
+#define SCMI_MESSAGE_HEADER_MESSAGE_ID_POS    0
+#define SCMI_MESSAGE_HEADER_MESSAGE_TYPE_POS  8
+#define SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS   10
+#define SCMI_MESSAGE_HEADER_TOKEN_POS         18
 
 #define SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK \
     (UINT32_C(0x3FF) << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS)
+#define SCMI_MESSAGE_HEADER_MESSAGE_TYPE_MASK \
+    (UINT32_C(0x3) << SCMI_MESSAGE_HEADER_MESSAGE_TYPE_POS)
 #define SCMI_MESSAGE_HEADER_PROTOCOL_ID_MASK \
     (UINT32_C(0xFF)  << SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS)
 #define SCMI_MESSAGE_HEADER_TOKEN_MASK  \
@@ -36,11 +40,32 @@
     (((TOKEN) << SCMI_MESSAGE_HEADER_TOKEN_POS) & \
         SCMI_MESSAGE_HEADER_TOKEN_POS))
 
+/* SCMI message types */
+#define SCMI_MESSAGE_TYPE_COMMAND          0
+#define SCMI_MESSAGE_TYPE_DELAYED_RESPONSE 2
+#define SCMI_MESSAGE_TYPE_NOTIFICATION     3
+
+/* Notification or delayed response pending delivery on a P2A channel */
+struct scmi_notification {
+    /* Message header */
+    uint32_t message_header;
+
+    /* Size in bytes of the payload */
+    size_t size;
+
+    /* Payload */
+    uint32_t payload[MOD_SCMI_NOTIFICATION_PAYLOAD_SIZE_MAX /
+                     sizeof(uint32_t)];
+};
+
 /* SCMI service context */
 struct scmi_service_ctx {
     /* Pointer to SCMI service configuration data */
     const struct mod_scmi_service_config *config;
 
+    /* Mask of the type of the agent associated with the service */
+    uint32_t agent_type_mask;
+
     /*
      * Identifier of the transport entity used by the service to read/respond
      * to SCMI messages.
@@ -50,14 +75,56 @@ struct scmi_service_ctx {
     /* Pointer to the transport API used to read and respond to messages */
     const struct mod_scmi_to_transport_api *transport_api;
 
-    /* Copy of the pointer to the 'respond' function within the transport API */
-    int (*respond)(fwk_id_t transport_id, const void *payload, size_t size);
-
     /* SCMI identifier of the protocol processing the current message */
     unsigned int scmi_protocol_id;
 
     /* SCMI identifier of the message currently being processed */
     unsigned int scmi_message_id;
+
+    /* Token of the message currently being processed */
+    unsigned int scmi_token;
+
+    /* Header of the message currently being processed (tracing only) */
+    uint32_t trace_message_header;
+
+    /* Counter value when the current message was signaled (tracing only) */
+    uint64_t trace_doorbell;
+
+    /* Counter value when the current message was dispatched (tracing only) */
+    uint64_t trace_dispatch;
+
+    /* Table of the notifications pending delivery, oldest first (P2A only) */
+    struct scmi_notification *pending_notification_table;
+
+    /* Number of notifications pending delivery (P2A only) */
+    unsigned int pending_notification_count;
+
+    /* Number of messages signaled and not responded to yet (A2P only) */
+    unsigned int message_count;
+
+    /* Node in the list of the services of the agent with messages pending */
+    struct fwk_slist_node scheduler_node;
+
+    /* Number of messages signaled and not dispatched yet (scheduler only) */
+    unsigned int scheduler_pending_count;
+};
+
+/* SCMI agent context, agent scheduler only */
+struct scmi_agent_ctx {
+    /* Node in the list of the agents with messages pending */
+    struct fwk_slist_node active_node;
+
+    /* Services of the agent with messages pending, in dispatch order */
+    struct fwk_slist service_list;
+
+    /* Scheduling weight of the agent, one or more */
+    unsigned int weight;
+
+    /* Number of messages the agent may still dispatch in its current turn */
+    unsigned int deficit;
+
+    /* Message statistics */
+    struct mod_scmi_agent_stats stats;
 };
 
 #endif /* MOD_INTERNAL_SCMI_H */
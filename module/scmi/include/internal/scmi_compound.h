@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI compound protocol definitions.
+ */
+
+#ifndef SCMI_COMPOUND_H
+#define SCMI_COMPOUND_H
+
+#include <stdint.h>
+
+#define SCMI_PROTOCOL_VERSION_COMPOUND UINT32_C(0x10000)
+
+/* Lowest SCMI protocol identifier of the vendor protocols */
+#define SCMI_PROTOCOL_ID_VENDOR_MIN 0x80
+
+enum scmi_compound_command_id {
+    SCMI_COMPOUND_EXECUTE = 0x003,
+};
+
+/*
+ * COMPOUND_EXECUTE
+ *
+ * The fixed part of the message is followed by the sub-commands, each made of
+ * a scmi_compound_command structure followed by the payload of the
+ * sub-command, padded to a multiple of four bytes. The fixed part of the
+ * response is followed by the responses to the sub-commands executed, in the
+ * same format.
+ */
+
+struct __attribute((packed)) scmi_compound_command {
+    /* SCMI message header of the sub-command or of its response */
+    uint32_t message_header;
+
+    /* Size in bytes of the payload, without padding */
+    uint32_t payload_size;
+};
+
+struct __attribute((packed)) scmi_compound_execute_a2p {
+    uint32_t command_count;
+};
+
+struct __attribute((packed)) scmi_compound_execute_p2a {
+    /*
+     * SCMI_SUCCESS when the sub-commands were executed up to the first one
+     * failing, which is included, or the error that stopped the execution:
+     * SCMI_PROTOCOL_ERROR for a malformed sub-command, SCMI_OUT_OF_RANGE for
+     * a response not fitting in the response buffer.
+     */
+    int32_t status;
+
+    /* Number of responses that follow, whatever the status */
+    uint32_t command_count;
+};
+
+#endif /* SCMI_COMPOUND_H */
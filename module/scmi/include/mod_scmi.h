@@ -53,6 +53,15 @@ struct mod_scmi_agent {
      *       in the system will be provided with a truncated version of it.
      */
     const char *name;
+
+    /*!
+     *  \brief Scheduling weight of the agent.
+     *
+     *  \details Number of messages of the agent dispatched in a round of the
+     *       agent scheduler, see \ref mod_scmi_config::agent_scheduling. A
+     *       weight equal to zero is equivalent to a weight of one.
+     */
+    unsigned int weight;
 };
 
 /*!
@@ -101,10 +110,171 @@ struct mod_scmi_config {
      *       if it exceeds this limit.
      */
     const char *sub_vendor_identifier;
+
+    /*!
+     *  \brief Address of the message trace ring, zero to disable tracing.
+     *
+     *  \details When tracing is enabled, the SCMI module records every
+     *       command it responds to into the ring, see
+     *       \ref mod_scmi_trace_ring. The ring can be placed in memory
+     *       readable by the application processors, for instance in a region
+     *       reserved next to the SDS structures, for post-mortem and latency
+     *       analysis.
+     */
+    uintptr_t trace_ring;
+
+    /*!
+     *  \brief Number of entries of the message trace ring. Must be a power of
+     *       two when tracing is enabled.
+     */
+    unsigned int trace_entry_count;
+
+    /*!
+     *  \brief Identifier of the timer timestamping the trace entries.
+     *
+     *  \details The entries are timestamped with the counter of the timer, or
+     *       are not timestamped if the firmware does not include the timer
+     *       module.
+     */
+    fwk_id_t trace_timer_id;
+
+    /*!
+     *  \brief Dispatch the messages of the agents in a weighted round-robin.
+     *
+     *  \details By default, the messages are dispatched in the order the
+     *       transports signal them and an agent sending messages at a high
+     *       rate delays the messages of the other agents. When this flag is
+     *       set, the messages are queued per agent and the agents with
+     *       messages pending take turns, each dispatching up to its weight in
+     *       messages per turn. The delay of a message then depends on the
+     *       number of agents with messages pending, not on the number of
+     *       messages they sent. Not supported in multi-threaded builds, where
+     *       each service has a thread of its own.
+     */
+    bool agent_scheduling;
+
+    /*!
+     *  \brief SCMI identifier of the compound protocol, zero to disable it.
+     *
+     *  \details The compound protocol is a vendor protocol implemented by the
+     *       SCMI module. Its COMPOUND_EXECUTE command (0x3) carries a sequence
+     *       of commands of the other protocols, which are executed in order
+     *       up to the first one failing, and its response carries their
+     *       responses. An agent sending several related commands, for
+     *       instance to set a clock rate and then a performance level, then
+     *       pays for a single round trip on its channel. The identifier must
+     *       be in the range of the vendor protocols. Not supported in
+     *       multi-threaded builds.
+     */
+    uint8_t compound_protocol_id;
+
+    /*!
+     *  \brief Size in bytes of the buffer of the responses of the compound
+     *       protocol, a multiple of four.
+     *
+     *  \details The responses to the commands of a COMPOUND_EXECUTE command
+     *       are gathered in the buffer, a single one being allocated for all
+     *       the agents. An agent sending a COMPOUND_EXECUTE command while the
+     *       command of another agent is being executed gets the SCMI_BUSY
+     *       status.
+     */
+    size_t compound_response_size;
+};
+
+/*!
+ * \brief Message statistics of an agent.
+ *
+ * \details Only maintained when the agent scheduler is enabled, see
+ *      \ref mod_scmi_config::agent_scheduling.
+ */
+struct mod_scmi_agent_stats {
+    /*! Number of messages signaled and not dispatched yet */
+    unsigned int pending_count;
+
+    /*! Highest number of messages pending dispatch */
+    unsigned int pending_count_max;
+
+    /*! Number of messages dispatched */
+    uint32_t dispatch_count;
+};
+
+/*!
+ * \brief Signature of the message trace ring, "SCTR".
+ */
+#define MOD_SCMI_TRACE_RING_SIGNATURE UINT32_C(0x52544353)
+
+/*!
+ * \brief Message trace entry.
+ *
+ * \details All the timestamps are expressed in ticks of the counter of the
+ *      trace timer.
+ */
+struct mod_scmi_trace_entry {
+    /*!
+     * \brief Sequence number of the entry plus one, written last.
+     *
+     * \details The entry is being written or has been overwritten if its
+     *      sequence number does not match its position in the ring.
+     */
+    uint32_t sequence;
+
+    /*! Header of the message, with its protocol, message and token */
+    uint32_t message_header;
+
+    /*! Identifier of the agent that sent the message */
+    uint32_t agent_id;
+
+    /*! SCMI status of the response */
+    int32_t status;
+
+    /*! Counter value when the transport signaled the message */
+    uint64_t doorbell;
+
+    /*! Ticks between the signal of the message and its dispatch */
+    uint32_t dispatch_latency;
+
+    /*! Ticks between the dispatch of the message and its response */
+    uint32_t processing_time;
+};
+
+/*!
+ * \brief Message trace ring.
+ *
+ * \details The entry of sequence number \c n is stored at index
+ *      \c n % \c entry_count and \c head is the sequence number of the next
+ *      entry. A reader reads the sequence field of an entry, copies the
+ *      entry and reads the sequence field again. The copy is discarded unless
+ *      both reads match the sequence number of the entry plus one.
+ */
+struct mod_scmi_trace_ring {
+    /*! Signature, \ref MOD_SCMI_TRACE_RING_SIGNATURE */
+    uint32_t signature;
+
+    /*! Number of entries in the ring */
+    uint32_t entry_count;
+
+    /*! Frequency of the counter timestamping the entries, in Hertz */
+    uint32_t frequency;
+
+    /*! Sequence number of the next entry */
+    volatile uint32_t head;
+
+    /*! Table of entries */
+    struct mod_scmi_trace_entry entries[];
 };
 
 /*!
  * \brief Service configuration data.
+ *
+ * \details In multi-threaded builds, each service processes the messages of
+ *      its channel in a thread of its own, created with the thread priority
+ *      and stack size of the SCMI module configuration. A service waiting for
+ *      the completion of a request, for instance a power domain state
+ *      transition, does not prevent the other services from processing their
+ *      messages. The message handlers of the protocol modules may thus be
+ *      entered by several services at the same time and keep the state of a
+ *      message on the stack or in per-service storage. In single-threaded
+ *      builds, all the services share the common thread.
  */
 struct mod_scmi_service_config {
     /*!
@@ -135,8 +305,35 @@ struct mod_scmi_service_config {
      *        module configuration data.
      */
     unsigned int scmi_agent_id;
+
+    /*!
+     *  \brief Type of the channel of the service.
+     *
+     *  \details The services of agent-to-platform (A2P) channels process the
+     *        commands of the agent. The service of a platform-to-agent (P2A)
+     *        channel delivers the notifications the agent subscribed to. An
+     *        agent has at most one P2A channel.
+     */
+    enum scmi_channel_type channel_type;
+
+    /*!
+     *  \brief Maximum number of notifications pending delivery on the channel.
+     *
+     *  \details P2A channels only. The notifications raised while the channel
+     *        is busy are kept pending until the agent frees the channel. A
+     *        pending notification is replaced by a later notification of the
+     *        same protocol and message about the same resource, identified by
+     *        the second word of the payload. The maximum number must be
+     *        greater than or equal to one.
+     */
+    unsigned int pending_notification_count_max;
 };
 
+/*!
+ * \brief Maximum size in bytes of the payload of a notification.
+ */
+#define MOD_SCMI_NOTIFICATION_PAYLOAD_SIZE_MAX 16
+
 /*!
  * \brief SCMI module to transport entity API.
  */
@@ -238,6 +435,31 @@ struct mod_scmi_to_transport_api {
      * errors.
      */
     int (*respond)(fwk_id_t channel_id, const void *payload, size_t size);
+
+    /*!
+     * \brief Send a message to the agent on a platform-to-agent channel.
+     *
+     * \note This function is mandatory only for the transport entities of
+     *      platform-to-agent channels.
+     *
+     * \param channel_id Channel identifier.
+     * \param message_header Message header.
+     * \param payload Payload data to write.
+     * \param size Size of the payload.
+     *
+     * \retval FWK_SUCCESS The message was sent.
+     * \retval FWK_E_PARAM The channel_id parameter is invalid.
+     * \retval FWK_E_PARAM The size of the payload exceeds the size of the
+     *      channel.
+     * \retval FWK_E_BUSY The agent has not freed the channel yet. It signals
+     *      the SCMI service bound to the channel once it has.
+     * \retval FWK_E_STATE The channel is not ready.
+     * \retval FWK_E_SUPPORT The channel is not a platform-to-agent channel.
+     * \return One of the standard error codes for implementation-defined
+     * errors.
+     */
+    int (*transmit)(fwk_id_t channel_id, uint32_t message_header,
+                    const void *payload, size_t size);
 };
 
 /*!
@@ -247,6 +469,10 @@ struct mod_scmi_from_transport_api {
     /*!
      * \brief Signal to a service that a message is incoming.
      *
+     * \details The message may be processed before the function returns, see
+     *      \ref mod_scmi_message_desc::isr_safe. On a platform-to-agent
+     *      channel, signal that the agent has freed the channel.
+     *
      * \param service_id SCMI service identifier.
      *
      * \retval FWK_SUCCESS The operation succeeded.
@@ -262,7 +488,10 @@ struct mod_scmi_from_transport_api {
  * \brief SCMI protocol message handler prototype.
  *
  * \details Prototype of a message handler called by the SCMI module when it
- *      receives a message for a SCMI protocol module.
+ *      receives a message for a SCMI protocol module. The SCMI module calls
+ *      the handler only once it has checked that the size of the payload
+ *      matches the size expected for the message and that the agent is
+ *      permitted to send the message.
  *
  * \note A return value of FWK_SUCCESS indicates only that no internal error
  *      was encountered, not that the SCMI command has returned a successful
@@ -270,20 +499,59 @@ struct mod_scmi_from_transport_api {
  *      an internal failure, the SCMI command is expected to return the status
  *      code SCMI_GENERIC_ERROR per the specification.
  *
- * \param protocol_id Identifier of the protocol module.
  * \param service_id Identifer of the SCMI service which received the message.
  * \param payload Pointer to the message payload.
- * \param payload_size Size in number of bytes of the message payload.
- * \param message_id Identifier of the message to be handled by the protocol
- *      handler.
  *
  * \retval FWK_SUCCESS The operation succeeded.
  * \return One of the standard error codes for implementation-defined errors.
  *
  */
-typedef int mod_scmi_message_handler_t(fwk_id_t protocol_id,
-    fwk_id_t service_id, const uint32_t *payload, size_t payload_size,
-    unsigned int message_id);
+typedef int mod_scmi_message_handler_t(fwk_id_t service_id,
+                                       const uint32_t *payload);
+
+/*!
+ * \brief Build the mask of an SCMI agent type.
+ *
+ * \param TYPE SCMI agent type (\ref scmi_agent_type).
+ */
+#define MOD_SCMI_AGENT_TYPE_MASK(TYPE) (UINT32_C(1) << (TYPE))
+
+/*!
+ * \brief SCMI protocol message descriptor.
+ */
+struct mod_scmi_message_desc {
+    /*! Message handler, NULL if the message is not supported */
+    mod_scmi_message_handler_t *handler;
+
+    /*! Size in bytes of the payload of the message */
+    size_t payload_size;
+
+    /*!
+     * \brief Mask of the types of the agents that are not permitted to send
+     *      the message.
+     *
+     * \details The SCMI module responds with the SCMI_DENIED status to the
+     *      messages sent by these agents, without calling the handler. The
+     *      mask of an agent type is built with \ref MOD_SCMI_AGENT_TYPE_MASK.
+     *      All the agents are permitted to send the message when the mask is
+     *      equal to zero.
+     */
+    uint32_t denied_agent_types;
+
+    /*!
+     * \brief The handler may be called from the context of the transport
+     *      signaling the message.
+     *
+     * \details A message signaled on an idle channel with such a handler is
+     *      processed straight away, without going through the event queue.
+     *      As the transport may signal the message from an interrupt handler,
+     *      the handler must respond before it returns and must only read data
+     *      that is not modified after the initialization of the firmware,
+     *      typically to answer a discovery message. It must not put any event
+     *      and must not call any API that may do so.
+     */
+    bool isr_safe;
+};
 
 /*!
  * \brief SCMI module to SCMI protocol module API.
@@ -304,8 +572,17 @@ struct mod_scmi_to_protocol_api {
     int (*get_scmi_protocol_id)(fwk_id_t protocol_id,
                                 uint8_t *scmi_protocol_id);
 
-    /*! Protocol message handler. */
-    mod_scmi_message_handler_t *message_handler;
+    /*!
+     * \brief Table of the message descriptors of the protocol, indexed by
+     *      message identifier.
+     *
+     * \details The SCMI module dispatches the messages of the protocol
+     *      directly through this table.
+     */
+    const struct mod_scmi_message_desc *message_table;
+
+    /*! Number of entries in the message table */
+    unsigned int message_count;
 };
 
 /*!
@@ -342,6 +619,16 @@ struct mod_scmi_from_protocol_api {
      int (*get_agent_type)(uint32_t agent_id,
                            enum scmi_agent_type *agent_type);
 
+    /*!
+     * \brief Get the number of agents in the system.
+     *
+     * \param[out] agent_count Number of agents.
+     *
+     * \retval FWK_SUCCESS The number of agents was returned.
+     * \retval FWK_E_PARAM The parameter 'agent_count' is equal to NULL.
+     */
+    int (*get_agent_count)(unsigned int *agent_count);
+
     /*!
      * \brief Get the maximum permitted payload size of a channel associated
      *        with a service.
@@ -380,14 +667,110 @@ struct mod_scmi_from_protocol_api {
     /*!
      * \brief Respond to an SCMI message on a service.
      *
+     * \details The response to a command of a COMPOUND_EXECUTE command, see
+     *      \ref mod_scmi_config::compound_protocol_id, is gathered with the
+     *      others. The next command of the sequence is executed once the
+     *      handler has responded, which it may do after it has returned.
+     *
      * \param service_id Service identifier.
      * \param payload Payload data to write, or NULL if a payload has already
      * been written.
      * \param size Size of the payload.
      */
     void (*respond)(fwk_id_t service_id, const void *payload, size_t size);
-};
 
+    /*!
+     * \brief Send a notification to an agent.
+     *
+     * \details The notification is sent on the platform-to-agent channel of
+     *      the agent. If the channel is busy, the notification is kept
+     *      pending until the agent frees the channel.
+     *
+     * \note This function must not be called from an interrupt handler.
+     *
+     * \param agent_id Identifier of the agent.
+     * \param scmi_protocol_id SCMI identifier of the protocol.
+     * \param scmi_message_id SCMI identifier of the notification message.
+     * \param payload Payload of the notification.
+     * \param size Size in bytes of the payload. Must be lower than or equal to
+     *      \ref MOD_SCMI_NOTIFICATION_PAYLOAD_SIZE_MAX.
+     *
+     * \retval FWK_SUCCESS The notification was sent or is pending delivery.
+     * \retval FWK_E_PARAM The agent identifier is not valid.
+     * \retval FWK_E_PARAM The payload parameter is NULL or its size is
+     *      invalid.
+     * \retval FWK_E_SUPPORT The agent has no platform-to-agent channel.
+     * \retval FWK_E_NOMEM The channel is busy and the maximum number of
+     *      notifications pending delivery is reached. The notification is
+     *      discarded.
+     * \return One of the standard error codes for implementation-defined
+     * errors.
+     */
+    int (*notify)(unsigned int agent_id, uint8_t scmi_protocol_id,
+                  unsigned int scmi_message_id, const void *payload,
+                  size_t size);
+
+    /*!
+     * \brief Get the token of the message being processed by a service, to
+     *      send a delayed response to the message.
+     *
+     * \param service_id Service identifier.
+     * \param[out] token Token of the message.
+     *
+     * \retval FWK_SUCCESS The token was returned.
+     * \retval FWK_E_PARAM The service_id parameter is invalid.
+     * \retval FWK_E_PARAM The token parameter is NULL.
+     * \retval FWK_E_SUPPORT The agent of the service has no
+     *      platform-to-agent channel to receive delayed responses on.
+     * \return One of the standard error codes for implementation-defined
+     * errors.
+     */
+    int (*get_delayed_response_token)(fwk_id_t service_id,
+                                      unsigned int *token);
+
+    /*!
+     * \brief Send the delayed response to a message.
+     *
+     * \details The delayed response is delivered on the platform-to-agent
+     *      channel of the agent as a notification is, see \ref notify.
+     *
+     * \param agent_id Identifier of the agent.
+     * \param scmi_protocol_id SCMI identifier of the protocol.
+     * \param scmi_message_id SCMI identifier of the message.
+     * \param token Token of the message, see \ref get_delayed_response_token.
+     * \param payload Payload of the delayed response.
+     * \param size Size in bytes of the payload. Must be lower than or equal to
+     *      \ref MOD_SCMI_NOTIFICATION_PAYLOAD_SIZE_MAX.
+     *
+     * \retval FWK_SUCCESS The delayed response was sent or is pending
+     *      delivery.
+     * \retval FWK_E_PARAM One or more parameters are invalid.
+     * \retval FWK_E_SUPPORT The agent has no platform-to-agent channel.
+     * \retval FWK_E_NOMEM The maximum number of messages pending delivery is
+     *      reached. The delayed response is discarded.
+     * \return One of the standard error codes for implementation-defined
+     * errors.
+     */
+    int (*send_delayed_response)(unsigned int agent_id,
+                                 uint8_t scmi_protocol_id,
+                                 unsigned int scmi_message_id,
+                                 unsigned int token, const void *payload,
+                                 size_t size);
+
+    /*!
+     * \brief Get the message statistics of an agent.
+     *
+     * \param agent_id Identifier of the agent.
+     * \param[out] stats Message statistics of the agent.
+     *
+     * \retval FWK_SUCCESS The statistics were returned.
+     * \retval FWK_E_PARAM The agent identifier is not valid.
+     * \retval FWK_E_PARAM The parameter 'stats' is equal to NULL.
+     * \retval FWK_E_SUPPORT The agent scheduler is disabled.
+     */
+    int (*get_agent_stats)(unsigned int agent_id,
+                           struct mod_scmi_agent_stats *stats);
+};
 
 /*!
  * \brief Identify if an SCMI entity is the communications master for a given
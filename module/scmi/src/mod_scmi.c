@@ -14,6 +14,7 @@
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -23,17 +24,65 @@
 #include <internal/mod_scmi.h>
 #include <internal/scmi.h>
 #include <internal/scmi_base.h>
+#include <internal/scmi_compound.h>
 #include <mod_log.h>
-#include <mod_smt.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 
 struct scmi_protocol {
-    /* SCMI protocol message handler */
-    mod_scmi_message_handler_t *message_handler;
+    /* Table of the SCMI protocol message descriptors */
+    const struct mod_scmi_message_desc *message_table;
+
+    /* Number of entries in the message table */
+    unsigned int message_count;
 
     /* SCMI protocol framework identifier */
     fwk_id_t id;
 };
 
+/* Execution of a COMPOUND_EXECUTE command */
+struct scmi_compound_ctx {
+    /* Context of the service of the command, NULL if none is executed */
+    struct scmi_service_ctx *service_ctx;
+
+    /* Next sub-command to execute */
+    const uint8_t *command;
+
+    /* Size in bytes of the sub-commands left, from the next one */
+    size_t remaining_size;
+
+    /* Number of sub-commands left, from the next one */
+    unsigned int remaining_count;
+
+    /* Number of responses to the sub-commands gathered so far */
+    unsigned int executed_count;
+
+    /* Message header of the sub-command being executed */
+    uint32_t message_header;
+
+    /* Status of the command, once set the execution stops */
+    int32_t status;
+
+    /* A sub-command failed, the execution stops */
+    bool failed;
+
+    /* A handler is being called */
+    bool dispatching;
+
+    /* The sub-command being executed has been responded to */
+    bool responded;
+
+    /* Response buffer, the fixed part of the response first */
+    uint32_t *response;
+
+    /* Size in bytes of the response buffer available to the service */
+    size_t response_size_max;
+
+    /* Size in bytes of the responses gathered so far, fixed part included */
+    size_t response_size;
+};
+
 struct scmi_ctx {
     /* SCMI module configuration data */
     struct mod_scmi_config *config;
@@ -44,27 +93,89 @@ struct scmi_ctx {
     /* Number of bound protocols */
     unsigned int protocol_count;
 
+    /*
+     * Number of protocols listed to the agents, the bound protocols and the
+     * compound protocol when it is enabled.
+     */
+    unsigned int listed_protocol_count;
+
     /*
      * SCMI protocol identifier to the index of the entry in protocol_table[]
      * dedicated to the protocol.
      */
     uint8_t scmi_protocol_id_to_idx[SCMI_PROTOCOL_ID_MAX + 1];
 
+    /*
+     * Identifiers of the bound protocols in ascending order, the response to
+     * the BASE_DISCOVER_LIST_PROTOCOLS command.
+     */
+    uint8_t *protocol_id_list;
+
     /* Table of service contexts */
     struct scmi_service_ctx *service_ctx_table;
 
+    /*
+     * SCMI agent identifier to the index plus one of the service of the P2A
+     * channel of the agent, zero if the agent has no P2A channel.
+     */
+    unsigned int *agent_id_to_p2a_service_idx;
+
+    /*
+     * Table of the agent contexts indexed by agent identifier, NULL if the
+     * agent scheduler is disabled.
+     */
+    struct scmi_agent_ctx *agent_ctx_table;
+
+    /* Agents with messages pending, the agent at the head having its turn */
+    struct fwk_slist active_agent_list;
+
     /* Log module API */
     struct mod_log_api *log_api;
+
+    /* Message trace ring, NULL if tracing is disabled */
+    struct mod_scmi_trace_ring *trace_ring;
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Timer API used to timestamp the trace entries */
+    const struct mod_timer_api *timer_api;
+    #endif
+
+    /* Execution of the COMPOUND_EXECUTE commands */
+    struct scmi_compound_ctx compound;
+};
+
+enum scmi_event_idx {
+    /* Dispatch of a message */
+    SCMI_EVENT_IDX_MESSAGE,
+
+    /* Execution of the next sub-command of a COMPOUND_EXECUTE command */
+    SCMI_EVENT_IDX_COMPOUND,
+
+    SCMI_EVENT_IDX_COUNT,
 };
 
 /*
  * Entry zero (0) of the protocol table 'protocol_table' is not used, as index
  * 0 is the index of the unused entries of the 'scmi_protocol_id_to_idx[]'
- * table. Entry one (1) is reserved for the base protocol implemented in this
- * file.
+ * table. Entries one (1) and two (2) are reserved for the base and compound
+ * protocols implemented in this file.
  */
 #define PROTOCOL_TABLE_BASE_PROTOCOL_IDX 1
-#define PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT 2
+#define PROTOCOL_TABLE_COMPOUND_PROTOCOL_IDX 2
+#define PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT 3
+
+#ifdef BUILD_STATIC_API_SCMI_TRANSPORT
+/*
+ * The transport API is bound at build time, all the services using the same
+ * one. The compiler knows the functions of the API and may inline them, with
+ * link-time optimization when they are defined in another module.
+ */
+extern const struct mod_scmi_to_transport_api BUILD_STATIC_API_SCMI_TRANSPORT;
+
+#define TRANSPORT_API(ctx) (&BUILD_STATIC_API_SCMI_TRANSPORT)
+#else
+#define TRANSPORT_API(ctx) ((ctx)->transport_api)
+#endif
 
 static int scmi_base_protocol_version_handler(
     fwk_id_t service_id, const uint32_t *payload);
@@ -82,38 +193,68 @@ static int scmi_base_discover_list_protocols_handler(
     fwk_id_t service_id, const uint32_t *payload);
 static int scmi_base_discover_agent_handler(
     fwk_id_t service_id, const uint32_t *payload);
+static int scmi_compound_protocol_version_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_compound_protocol_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_compound_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_compound_execute_handler(
+    fwk_id_t service_id, const uint32_t *payload);
 
-static int (* const base_handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] =
-        scmi_base_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] =
-        scmi_base_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_base_protocol_message_attributes_handler,
-    [SCMI_BASE_DISCOVER_VENDOR] =
-        scmi_base_discover_vendor_handler,
-    [SCMI_BASE_DISCOVER_SUB_VENDOR] =
-        scmi_base_discover_sub_vendor_handler,
-    [SCMI_BASE_DISCOVER_IMPLEMENTATION_VERSION] =
-        scmi_base_discover_implementation_version_handler,
-    [SCMI_BASE_DISCOVER_LIST_PROTOCOLS] =
-        scmi_base_discover_list_protocols_handler,
-    [SCMI_BASE_DISCOVER_AGENT] =
-        scmi_base_discover_agent_handler,
+static const struct mod_scmi_message_desc base_message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_base_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_base_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_base_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_BASE_DISCOVER_VENDOR] = {
+        .handler = scmi_base_discover_vendor_handler,
+        .isr_safe = true,
+    },
+    [SCMI_BASE_DISCOVER_SUB_VENDOR] = {
+        .handler = scmi_base_discover_sub_vendor_handler,
+        .isr_safe = true,
+    },
+    [SCMI_BASE_DISCOVER_IMPLEMENTATION_VERSION] = {
+        .handler = scmi_base_discover_implementation_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_BASE_DISCOVER_LIST_PROTOCOLS] = {
+        .handler = scmi_base_discover_list_protocols_handler,
+        .payload_size = sizeof(struct scmi_base_discover_list_protocols_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_BASE_DISCOVER_AGENT] = {
+        .handler = scmi_base_discover_agent_handler,
+        .payload_size = sizeof(struct scmi_base_discover_agent_a2p),
+        .isr_safe = true,
+    },
 };
 
-static const unsigned int base_payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                        sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_BASE_DISCOVER_VENDOR] = 0,
-    [SCMI_BASE_DISCOVER_SUB_VENDOR] = 0,
-    [SCMI_BASE_DISCOVER_IMPLEMENTATION_VERSION] = 0,
-    [SCMI_BASE_DISCOVER_LIST_PROTOCOLS] =
-                        sizeof(struct scmi_base_discover_list_protocols_a2p),
-    [SCMI_BASE_DISCOVER_AGENT] =
-                        sizeof(struct scmi_base_discover_agent_a2p),
+static const struct mod_scmi_message_desc compound_message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_compound_protocol_version_handler,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_compound_protocol_attributes_handler,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_compound_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+    },
+    [SCMI_COMPOUND_EXECUTE] = {
+        .handler = scmi_compound_execute_handler,
+        .payload_size = sizeof(struct scmi_compound_execute_a2p),
+    },
 };
 
 static const char * const default_agent_names[] = {
@@ -140,6 +281,274 @@ static uint8_t read_protocol_id(uint32_t message_header)
         SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS;
 }
 
+static unsigned int read_token(uint32_t message_header)
+{
+    return (message_header & SCMI_MESSAGE_HEADER_TOKEN_MASK) >>
+        SCMI_MESSAGE_HEADER_TOKEN_POS;
+}
+
+/*
+ * The sub-commands of a COMPOUND_EXECUTE command follow the fixed part of its
+ * payload, the payloads of the other messages have a fixed size.
+ */
+static bool is_payload_size_valid(const struct mod_scmi_message_desc *message,
+                                  size_t payload_size)
+{
+    if (message == &compound_message_table[SCMI_COMPOUND_EXECUTE])
+        return payload_size >= message->payload_size;
+
+    return payload_size == message->payload_size;
+}
+
+static uint64_t trace_timestamp(void)
+{
+    #if BUILD_HAS_MOD_TIMER
+    uint64_t counter;
+
+    if (scmi_ctx.timer_api->get_counter(scmi_ctx.config->trace_timer_id,
+                                        &counter) == FWK_SUCCESS)
+        return counter;
+    #endif
+
+    return 0;
+}
+
+/*
+ * Record the response to the message being processed by a service into the
+ * trace ring. The sequence field of the entry is cleared first and written
+ * last so that a reader can detect an entry being written.
+ */
+static void trace_response(struct scmi_service_ctx *ctx, int32_t status)
+{
+    struct mod_scmi_trace_ring *ring = scmi_ctx.trace_ring;
+    struct mod_scmi_trace_entry *entry;
+    uint32_t sequence;
+    uint64_t now;
+
+    if (ring == NULL)
+        return;
+
+    now = trace_timestamp();
+
+    #ifdef BUILD_HAS_MULTITHREADING
+    /* The services responding in different threads get distinct entries */
+    fwk_interrupt_global_disable();
+    sequence = ring->head++;
+    fwk_interrupt_global_enable();
+    #else
+    sequence = ring->head++;
+    #endif
+
+    entry = &ring->entries[sequence & (ring->entry_count - 1)];
+
+    entry->sequence = 0;
+    entry->message_header = ctx->trace_message_header;
+    entry->agent_id = ctx->config->scmi_agent_id;
+    entry->status = status;
+    entry->doorbell = ctx->trace_doorbell;
+    entry->dispatch_latency =
+        (uint32_t)(ctx->trace_dispatch - ctx->trace_doorbell);
+    entry->processing_time = (uint32_t)(now - ctx->trace_dispatch);
+    entry->sequence = sequence + 1;
+}
+
+/*
+ * Send the notifications pending delivery on a P2A channel, oldest first,
+ * until the channel is busy.
+ */
+static void flush_notifications(struct scmi_service_ctx *ctx)
+{
+    int status;
+    struct scmi_notification *pending_table = ctx->pending_notification_table;
+
+    while (ctx->pending_notification_count > 0) {
+        status = TRANSPORT_API(ctx)->transmit(ctx->transport_id,
+                                              pending_table[0].message_header,
+                                              pending_table[0].payload,
+                                              pending_table[0].size);
+        if (status == FWK_E_BUSY)
+            return;
+
+        if (status != FWK_SUCCESS) {
+            MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[SCMI] Failed to send notification (%e)\n", status);
+        }
+
+        ctx->pending_notification_count--;
+        memmove(&pending_table[0], &pending_table[1],
+                ctx->pending_notification_count * sizeof(pending_table[0]));
+    }
+}
+
+/*
+ * Account for the response to a message of an A2P channel.
+ */
+static void release_message(struct scmi_service_ctx *ctx)
+{
+    fwk_interrupt_global_disable();
+    if (ctx->message_count > 0)
+        ctx->message_count--;
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Send the response to the message being processed by a service.
+ */
+static void send_response(struct scmi_service_ctx *ctx, const void *payload,
+                          size_t size)
+{
+    int status;
+
+    /*
+     * A response without payload was written with write_payload(), its status
+     * is not known here and it is traced as successful.
+     */
+    trace_response(ctx, (payload != NULL) ? *((int32_t *)payload) :
+                                            SCMI_SUCCESS);
+
+    status = TRANSPORT_API(ctx)->respond(ctx->transport_id, payload, size);
+    if (status != FWK_SUCCESS)
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[SCMI] Failed to send response (%e)\n", status);
+
+    /* The next message of the channel may now be processed on its signal */
+    release_message(ctx);
+}
+
+/*
+ * Process a message from the context of the transport signaling it, provided
+ * that its handler is ISR-safe. Returns false when the message has to go
+ * through the event queue instead, including when it is invalid so that it
+ * is answered with the appropriate error.
+ */
+static bool process_fast_message(struct scmi_service_ctx *ctx,
+                                 fwk_id_t service_id)
+{
+    int status;
+    uint32_t message_header;
+    const void *payload;
+    size_t payload_size;
+    unsigned int protocol_idx;
+    unsigned int message_id;
+    const struct scmi_protocol *protocol;
+    const struct mod_scmi_message_desc *message;
+
+    if (TRANSPORT_API(ctx)->get_message_header(ctx->transport_id,
+                                               &message_header) != FWK_SUCCESS)
+        return false;
+
+    protocol_idx =
+        scmi_ctx.scmi_protocol_id_to_idx[read_protocol_id(message_header)];
+    if (protocol_idx == 0)
+        return false;
+
+    protocol = &scmi_ctx.protocol_table[protocol_idx];
+    message_id = read_message_id(message_header);
+    if (message_id >= protocol->message_count)
+        return false;
+
+    message = &protocol->message_table[message_id];
+    if (!message->isr_safe || (message->handler == NULL) ||
+        (message->denied_agent_types & ctx->agent_type_mask))
+        return false;
+
+    if ((TRANSPORT_API(ctx)->get_payload(ctx->transport_id, &payload,
+                                         &payload_size) != FWK_SUCCESS) ||
+        (payload_size != message->payload_size))
+        return false;
+
+    if (scmi_ctx.trace_ring != NULL) {
+        ctx->trace_message_header = message_header;
+        ctx->trace_dispatch = ctx->trace_doorbell;
+    }
+
+    ctx->scmi_protocol_id = read_protocol_id(message_header);
+    ctx->scmi_message_id = message_id;
+    ctx->scmi_token = read_token(message_header);
+
+    status = message->handler(service_id, payload);
+    if (status != FWK_SUCCESS) {
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[SCMI] Protocol 0x%x handler error (%e), message_id = 0x%x\n",
+            ctx->scmi_protocol_id, status, ctx->scmi_message_id);
+    }
+
+    return true;
+}
+
+/*
+ * Queue a message signaled on an A2P channel to the agent scheduler.
+ */
+static void schedule_message(struct scmi_service_ctx *ctx)
+{
+    struct scmi_agent_ctx *agent_ctx;
+
+    agent_ctx = &scmi_ctx.agent_ctx_table[ctx->config->scmi_agent_id];
+
+    /* The transports may signal messages from interrupt handlers */
+    fwk_interrupt_global_disable();
+
+    if (ctx->scheduler_pending_count++ == 0)
+        fwk_list_push_tail(&agent_ctx->service_list, &ctx->scheduler_node);
+
+    if (agent_ctx->stats.pending_count++ == 0) {
+        agent_ctx->deficit = agent_ctx->weight;
+        fwk_list_push_tail(&scmi_ctx.active_agent_list,
+                           &agent_ctx->active_node);
+    }
+
+    if (agent_ctx->stats.pending_count > agent_ctx->stats.pending_count_max)
+        agent_ctx->stats.pending_count_max = agent_ctx->stats.pending_count;
+
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Pick the service of the next message to dispatch with a deficit
+ * round-robin over the agents, the cost of a message being one. The agent at
+ * the head of the active list dispatches messages until it has used its
+ * weight or has no message pending, and then passes its turn to the next
+ * agent. The services of an agent take turns in the same way, one message at
+ * a time.
+ */
+static struct scmi_service_ctx *schedule_next_message(void)
+{
+    struct fwk_slist_node *node;
+    struct scmi_agent_ctx *agent_ctx;
+    struct scmi_service_ctx *ctx;
+
+    fwk_interrupt_global_disable();
+
+    node = fwk_list_head(&scmi_ctx.active_agent_list);
+    if (node == NULL) {
+        fwk_interrupt_global_enable();
+        return NULL;
+    }
+
+    agent_ctx = FWK_LIST_GET(node, struct scmi_agent_ctx, active_node);
+
+    ctx = FWK_LIST_GET(fwk_list_pop_head(&agent_ctx->service_list),
+                       struct scmi_service_ctx, scheduler_node);
+    if (--ctx->scheduler_pending_count > 0)
+        fwk_list_push_tail(&agent_ctx->service_list, &ctx->scheduler_node);
+
+    agent_ctx->stats.pending_count--;
+    agent_ctx->stats.dispatch_count++;
+
+    if (agent_ctx->stats.pending_count == 0)
+        fwk_list_pop_head(&scmi_ctx.active_agent_list);
+    else if (--agent_ctx->deficit == 0) {
+        agent_ctx->deficit = agent_ctx->weight;
+        fwk_list_pop_head(&scmi_ctx.active_agent_list);
+        fwk_list_push_tail(&scmi_ctx.active_agent_list,
+                           &agent_ctx->active_node);
+    }
+
+    fwk_interrupt_global_enable();
+
+    return ctx;
+}
+
 /*
  * Transport entity -> SCMI module
  */
@@ -147,25 +556,194 @@ static uint8_t read_protocol_id(uint32_t message_header)
 static int signal_message(fwk_id_t service_id)
 {
     int32_t status;
-    struct fwk_event event;
+    struct fwk_event *event;
+    struct scmi_service_ctx *ctx;
+    bool is_a2p;
+    bool idle;
+    bool scheduled;
 
     status = fwk_module_check_call(service_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    event = (struct fwk_event) {
-        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI, 0),
-        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
-        .target_id = service_id,
-    };
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    if (scmi_ctx.trace_ring != NULL)
+        ctx->trace_doorbell = trace_timestamp();
+
+    is_a2p = (ctx->config->channel_type == SCMI_CHANNEL_TYPE_A2P);
+    if (is_a2p) {
+        fwk_interrupt_global_disable();
+        idle = (ctx->message_count++ == 0);
+        fwk_interrupt_global_enable();
+
+        /*
+         * With a queued transport, the transport presents the oldest message
+         * of the channel. Only the single message of an idle channel can be
+         * processed here.
+         */
+        if (idle && process_fast_message(ctx, service_id))
+            return FWK_SUCCESS;
+    }
 
-    return fwk_thread_put_event(&event);
+    scheduled = is_a2p && (scmi_ctx.agent_ctx_table != NULL);
+
+    /* The event is filled in place to save a copy on every message */
+    status = fwk_thread_reserve_event(&event);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    event->id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI, SCMI_EVENT_IDX_MESSAGE);
+    event->source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI);
+    event->target_id = service_id;
+    event->priority = FWK_EVENT_PRIORITY_HIGH;
+
+    /*
+     * With the agent scheduler, the event only requests the dispatch of a
+     * message, the scheduler choosing which one when the event is processed.
+     */
+    if (scheduled)
+        event->target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI);
+
+    status = fwk_thread_commit_event(event);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    if (scheduled)
+        schedule_message(ctx);
+
+    return FWK_SUCCESS;
+
+error:
+    if (is_a2p)
+        release_message(ctx);
+
+    return status;
 }
 
 static const struct mod_scmi_from_transport_api mod_scmi_from_transport_api = {
     .signal_message = signal_message
 };
 
+/*
+ * Responses to the sub-commands of a COMPOUND_EXECUTE command
+ */
+
+static bool is_compound_service(const struct scmi_service_ctx *ctx)
+{
+    return scmi_ctx.compound.service_ctx == ctx;
+}
+
+/* Size in bytes available to the payload of the next sub-command response */
+static size_t get_compound_payload_size_max(void)
+{
+    const struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    size_t used_size;
+
+    used_size = compound->response_size + sizeof(struct scmi_compound_command);
+    if (used_size > compound->response_size_max)
+        return 0;
+
+    return compound->response_size_max - used_size;
+}
+
+static int write_compound_payload(size_t offset, const void *payload,
+                                  size_t size)
+{
+    struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    size_t size_max = get_compound_payload_size_max();
+
+    if ((payload == NULL) || (offset > size_max) ||
+        (size > (size_max - offset)))
+        return FWK_E_PARAM;
+
+    memcpy((uint8_t *)compound->response + compound->response_size +
+               sizeof(struct scmi_compound_command) + offset,
+           payload, size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Send the response of the COMPOUND_EXECUTE command, made of the responses to
+ * the sub-commands executed even when the execution stopped on an error.
+ */
+static void finish_compound(void)
+{
+    struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    struct scmi_service_ctx *ctx = compound->service_ctx;
+    struct scmi_compound_execute_p2a *return_values;
+
+    compound->service_ctx = NULL;
+
+    return_values = (struct scmi_compound_execute_p2a *)compound->response;
+    return_values->status = compound->status;
+    return_values->command_count = compound->executed_count;
+
+    send_response(ctx, compound->response, compound->response_size);
+}
+
+/*
+ * Append the response to the sub-command being executed to the response of
+ * the COMPOUND_EXECUTE command. The payload of a response without payload was
+ * written with write_payload() and is already in place.
+ */
+static void gather_compound_response(const void *payload, size_t size)
+{
+    struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    struct scmi_compound_command *response;
+    uint8_t *response_payload;
+    size_t padded_size;
+    struct fwk_event event;
+    int status;
+
+    if (compound->responded)
+        return;
+
+    compound->responded = true;
+
+    padded_size = FWK_ALIGN_NEXT(size, sizeof(uint32_t));
+    if ((size < sizeof(int32_t)) ||
+        (padded_size > get_compound_payload_size_max()))
+        compound->status = SCMI_OUT_OF_RANGE;
+    else {
+        response = (struct scmi_compound_command *)(
+            (uint8_t *)compound->response + compound->response_size);
+        response->message_header = compound->message_header;
+        response->payload_size = size;
+
+        response_payload = (uint8_t *)(response + 1);
+        if (payload != NULL)
+            memcpy(response_payload, payload, size);
+        memset(response_payload + size, 0, padded_size - size);
+
+        if (*(const int32_t *)response_payload < SCMI_SUCCESS)
+            compound->failed = true;
+
+        compound->response_size += sizeof(*response) + padded_size;
+        compound->executed_count++;
+    }
+
+    /* The execution continues where the handler was called */
+    if (compound->dispatching)
+        return;
+
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI, SCMI_EVENT_IDX_COMPOUND),
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI,
+            compound->service_ctx - scmi_ctx.service_ctx_table),
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS) {
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[SCMI] Unable to resume compound command (%e)\n", status);
+        compound->status = SCMI_GENERIC_ERROR;
+        finish_compound();
+    }
+}
+
 /*
  * SCMI protocol module -> SCMI module interface
  */
@@ -216,7 +794,12 @@ static int get_max_payload_size(fwk_id_t service_id, size_t *size)
 
     ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
 
-    return ctx->transport_api->get_max_payload_size(ctx->transport_id, size);
+    if (is_compound_service(ctx)) {
+        *size = get_compound_payload_size_max();
+        return FWK_SUCCESS;
+    }
+
+    return TRANSPORT_API(ctx)->get_max_payload_size(ctx->transport_id, size);
 }
 
 static int write_payload(fwk_id_t service_id, size_t offset,
@@ -231,14 +814,17 @@ static int write_payload(fwk_id_t service_id, size_t offset,
 
     ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
 
-    return ctx->transport_api->write_payload(ctx->transport_id,
+    if (is_compound_service(ctx))
+        return write_compound_payload(offset, payload, size);
+
+    return TRANSPORT_API(ctx)->write_payload(ctx->transport_id,
                                              offset, payload, size);
 }
 
 static void respond(fwk_id_t service_id, const void *payload, size_t size)
 {
     int status;
-    const struct scmi_service_ctx *ctx;
+    struct scmi_service_ctx *ctx;
 
     status = fwk_module_check_call(service_id);
     if (status != FWK_SUCCESS)
@@ -254,15 +840,160 @@ static void respond(fwk_id_t service_id, const void *payload, size_t size)
      * specification it should be like that for all commands.
      */
     if ((payload != NULL) && (*((int32_t *)payload) < SCMI_SUCCESS)) {
-       scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+       MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
            "[SCMI] Protocol 0x%x, message_id 0x%x returned with error %d\n",
            ctx->scmi_protocol_id, ctx->scmi_message_id, *((int *)payload));
     }
 
-    status = ctx->respond(ctx->transport_id, payload, size);
+    if (is_compound_service(ctx))
+        gather_compound_response(payload, size);
+    else
+        send_response(ctx, payload, size);
+}
+
+static int get_agent_count(unsigned int *agent_count)
+{
+    if (agent_count == NULL)
+        return FWK_E_PARAM;
+
+    *agent_count = scmi_ctx.config->agent_count;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Queue a message to an agent on its P2A channel and send it when possible.
+ */
+static int send_p2a_message(unsigned int agent_id, unsigned int message_type,
+                            uint8_t scmi_protocol_id,
+                            unsigned int scmi_message_id, unsigned int token,
+                            const void *payload, size_t size)
+{
+    unsigned int service_idx;
+    struct scmi_service_ctx *ctx;
+    struct scmi_notification *notification;
+    uint32_t message_header;
+    unsigned int pending_idx;
+
+    if ((agent_id == SCMI_PLATFORM_ID) ||
+        (agent_id > scmi_ctx.config->agent_count))
+        return FWK_E_PARAM;
+
+    if (scmi_message_id > UINT8_MAX)
+        return FWK_E_PARAM;
+
+    if ((payload == NULL) || (size > MOD_SCMI_NOTIFICATION_PAYLOAD_SIZE_MAX) ||
+        ((size % sizeof(uint32_t)) != 0))
+        return FWK_E_PARAM;
+
+    service_idx = scmi_ctx.agent_id_to_p2a_service_idx[agent_id];
+    if (service_idx == 0)
+        return FWK_E_SUPPORT;
+
+    ctx = &scmi_ctx.service_ctx_table[service_idx - 1];
+
+    message_header =
+        ((scmi_message_id << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS) &
+         SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK) |
+        (((uint32_t)message_type << SCMI_MESSAGE_HEADER_MESSAGE_TYPE_POS) &
+         SCMI_MESSAGE_HEADER_MESSAGE_TYPE_MASK) |
+        (((uint32_t)scmi_protocol_id << SCMI_MESSAGE_HEADER_PROTOCOL_ID_POS) &
+         SCMI_MESSAGE_HEADER_PROTOCOL_ID_MASK) |
+        (((uint32_t)token << SCMI_MESSAGE_HEADER_TOKEN_POS) &
+         SCMI_MESSAGE_HEADER_TOKEN_MASK);
+
+    /*
+     * A notification pending delivery about the same resource is out of date,
+     * replace it.
+     */
+    for (pending_idx = 0; pending_idx < ctx->pending_notification_count;
+         pending_idx++) {
+        notification = &ctx->pending_notification_table[pending_idx];
+        if ((notification->message_header == message_header) &&
+            (notification->size == size) &&
+            ((size < (2 * sizeof(uint32_t))) ||
+             (notification->payload[1] == ((const uint32_t *)payload)[1])))
+            break;
+    }
+
+    if (pending_idx == ctx->pending_notification_count) {
+        if (ctx->pending_notification_count >=
+            ctx->config->pending_notification_count_max) {
+            MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[SCMI] Agent %u: message discarded\n", agent_id);
+            return FWK_E_NOMEM;
+        }
+        ctx->pending_notification_count++;
+    }
+
+    notification = &ctx->pending_notification_table[pending_idx];
+    notification->message_header = message_header;
+    notification->size = size;
+    memcpy(notification->payload, payload, size);
+
+    flush_notifications(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int notify(unsigned int agent_id, uint8_t scmi_protocol_id,
+                  unsigned int scmi_message_id, const void *payload,
+                  size_t size)
+{
+    return send_p2a_message(agent_id, SCMI_MESSAGE_TYPE_NOTIFICATION,
+                            scmi_protocol_id, scmi_message_id, 0, payload,
+                            size);
+}
+
+static int get_delayed_response_token(fwk_id_t service_id,
+                                      unsigned int *token)
+{
+    int status;
+    const struct scmi_service_ctx *ctx;
+
+    status = fwk_module_check_call(service_id);
     if (status != FWK_SUCCESS)
-        scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
-            "[SCMI] Failed to send response (%e)\n", status);
+        return status;
+
+    if (token == NULL)
+        return FWK_E_PARAM;
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    if (scmi_ctx.agent_id_to_p2a_service_idx[ctx->config->scmi_agent_id] == 0)
+        return FWK_E_SUPPORT;
+
+    *token = ctx->scmi_token;
+
+    return FWK_SUCCESS;
+}
+
+static int send_delayed_response(unsigned int agent_id,
+                                 uint8_t scmi_protocol_id,
+                                 unsigned int scmi_message_id,
+                                 unsigned int token, const void *payload,
+                                 size_t size)
+{
+    return send_p2a_message(agent_id, SCMI_MESSAGE_TYPE_DELAYED_RESPONSE,
+                            scmi_protocol_id, scmi_message_id, token, payload,
+                            size);
+}
+
+static int get_agent_stats(unsigned int agent_id,
+                           struct mod_scmi_agent_stats *stats)
+{
+    if ((agent_id == SCMI_PLATFORM_ID) ||
+        (agent_id > scmi_ctx.config->agent_count) || (stats == NULL))
+        return FWK_E_PARAM;
+
+    if (scmi_ctx.agent_ctx_table == NULL)
+        return FWK_E_SUPPORT;
+
+    fwk_interrupt_global_disable();
+    *stats = scmi_ctx.agent_ctx_table[agent_id].stats;
+    fwk_interrupt_global_enable();
+
+    return FWK_SUCCESS;
 }
 
 static const struct mod_scmi_from_protocol_api mod_scmi_from_protocol_api = {
@@ -271,6 +1002,11 @@ static const struct mod_scmi_from_protocol_api mod_scmi_from_protocol_api = {
     .get_max_payload_size = get_max_payload_size,
     .write_payload = write_payload,
     .respond = respond,
+    .get_agent_count = get_agent_count,
+    .notify = notify,
+    .get_delayed_response_token = get_delayed_response_token,
+    .send_delayed_response = send_delayed_response,
+    .get_agent_stats = get_agent_stats,
 };
 
 /*
@@ -303,7 +1039,7 @@ static int scmi_base_protocol_attributes_handler(fwk_id_t service_id,
     };
 
     return_values.attributes =
-        SCMI_BASE_PROTOCOL_ATTRIBUTES(scmi_ctx.protocol_count,
+        SCMI_BASE_PROTOCOL_ATTRIBUTES(scmi_ctx.listed_protocol_count,
                                       scmi_ctx.config->agent_count);
 
     respond(service_id, &return_values, sizeof(return_values));
@@ -326,8 +1062,8 @@ static int scmi_base_protocol_message_attributes_handler(fwk_id_t service_id,
     parameters = (struct scmi_protocol_message_attributes_a2p *)payload;
     message_id = parameters->message_id;
 
-    if ((message_id < FWK_ARRAY_SIZE(base_handler_table)) &&
-        (base_handler_table[message_id] != NULL))
+    if ((message_id < FWK_ARRAY_SIZE(base_message_table)) &&
+        (base_message_table[message_id].handler != NULL))
         return_values.status = SCMI_SUCCESS;
 
     /* For this protocol, all commands have an attributes value of 0, which
@@ -413,9 +1149,7 @@ static int scmi_base_discover_list_protocols_handler(fwk_id_t service_id,
     size_t max_payload_size;
     size_t payload_size;
     size_t entry_count;
-    size_t protocol_count, protocol_count_max;
-    unsigned int index;
-    uint8_t protocol_id;
+    size_t protocol_count;
 
     status = get_max_payload_size(service_id, &max_payload_size);
     if (status != FWK_SUCCESS)
@@ -434,37 +1168,27 @@ static int scmi_base_discover_list_protocols_handler(fwk_id_t service_id,
     parameters = (const struct scmi_base_discover_list_protocols_a2p *)payload;
     skip = parameters->skip;
 
-    if (skip > scmi_ctx.protocol_count) {
+    if (skip > scmi_ctx.listed_protocol_count) {
         return_values.status = SCMI_INVALID_PARAMETERS;
         goto error;
     }
 
-    protocol_count_max = (scmi_ctx.protocol_count < (skip + entry_count)) ?
-                         scmi_ctx.protocol_count : (skip + entry_count);
+    protocol_count = scmi_ctx.listed_protocol_count - skip;
+    if (protocol_count > entry_count)
+        protocol_count = entry_count;
 
-    for (index = 0, protocol_count = 0,
-         payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
-         (index < FWK_ARRAY_SIZE(scmi_ctx.scmi_protocol_id_to_idx)) &&
-         (protocol_count < protocol_count_max);
-         index++) {
-        if ((scmi_ctx.scmi_protocol_id_to_idx[index] == 0) ||
-            (index == SCMI_PROTOCOL_ID_BASE))
-            continue;
-
-        protocol_count++;
-        if (protocol_count <= skip)
-            continue;
-
-        protocol_id = index;
-        status = write_payload(service_id, payload_size, &protocol_id,
-                               sizeof(protocol_id));
+    payload_size = sizeof(struct scmi_base_discover_list_protocols_p2a);
+    if (protocol_count != 0) {
+        status = write_payload(service_id, payload_size,
+                               &scmi_ctx.protocol_id_list[skip],
+                               protocol_count);
         if (status != FWK_SUCCESS)
             goto error;
-        payload_size += sizeof(protocol_id);
+        payload_size += protocol_count;
     }
 
     return_values.status = SCMI_SUCCESS;
-    return_values.num_protocols = protocol_count_max - skip;
+    return_values.num_protocols = protocol_count;
 
     status = write_payload(service_id, 0,
                            &return_values, sizeof(return_values));
@@ -529,32 +1253,232 @@ exit:
     return FWK_SUCCESS;
 }
 
-static int scmi_base_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
-    const uint32_t *payload, size_t payload_size, unsigned int message_id)
+/*
+ * Compound protocol implementation
+ */
+
+static int32_t find_compound_message(const struct scmi_service_ctx *ctx,
+    size_t payload_size, const struct mod_scmi_message_desc **message)
 {
+    unsigned int protocol_idx;
+    const struct scmi_protocol *protocol;
+
+    protocol_idx = scmi_ctx.scmi_protocol_id_to_idx[ctx->scmi_protocol_id];
+    if (protocol_idx == 0)
+        return SCMI_NOT_SUPPORTED;
+
+    protocol = &scmi_ctx.protocol_table[protocol_idx];
+    if ((ctx->scmi_message_id >= protocol->message_count) ||
+        (protocol->message_table[ctx->scmi_message_id].handler == NULL))
+        return SCMI_NOT_SUPPORTED;
+
+    *message = &protocol->message_table[ctx->scmi_message_id];
+
+    /* The COMPOUND_EXECUTE commands are not nested */
+    if (*message == &compound_message_table[SCMI_COMPOUND_EXECUTE])
+        return SCMI_NOT_SUPPORTED;
+
+    if (payload_size != (*message)->payload_size)
+        return SCMI_PROTOCOL_ERROR;
+
+    if ((*message)->denied_agent_types & ctx->agent_type_mask)
+        return SCMI_DENIED;
+
+    return SCMI_SUCCESS;
+}
+
+/*
+ * Execute the sub-commands of the COMPOUND_EXECUTE command in order, until
+ * one of them fails. When the handler of a sub-command returns before it has
+ * responded, the execution continues on the response.
+ */
+static void execute_compound(void)
+{
+    struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    struct scmi_service_ctx *ctx = compound->service_ctx;
+    const struct scmi_compound_command *command;
+    const struct mod_scmi_message_desc *message;
+    size_t command_size;
     int32_t return_value;
+    int status;
+    fwk_id_t service_id;
 
-    static_assert(FWK_ARRAY_SIZE(base_handler_table) ==
-                  FWK_ARRAY_SIZE(base_payload_size_table),
-                  "[SCMI] Base protocol table sizes not consistent");
-    assert(payload != NULL);
+    service_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI,
+                                ctx - scmi_ctx.service_ctx_table);
 
-    if (message_id >= FWK_ARRAY_SIZE(base_handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
+    while ((compound->remaining_count > 0) && !compound->failed &&
+           (compound->status == SCMI_SUCCESS)) {
+        command = (const struct scmi_compound_command *)compound->command;
+
+        if ((compound->remaining_size < sizeof(*command)) ||
+            (command->payload_size >
+             (compound->remaining_size - sizeof(*command)))) {
+            compound->status = SCMI_PROTOCOL_ERROR;
+            break;
+        }
+
+        command_size = sizeof(*command) +
+            FWK_ALIGN_NEXT(command->payload_size, sizeof(uint32_t));
+        if (command_size > compound->remaining_size) {
+            compound->status = SCMI_PROTOCOL_ERROR;
+            break;
+        }
+
+        compound->command += command_size;
+        compound->remaining_size -= command_size;
+        compound->remaining_count--;
+        compound->message_header = command->message_header;
+        compound->responded = false;
+
+        ctx->scmi_protocol_id = read_protocol_id(command->message_header);
+        ctx->scmi_message_id = read_message_id(command->message_header);
+        ctx->scmi_token = read_token(command->message_header);
+
+        compound->dispatching = true;
+
+        return_value = find_compound_message(ctx, command->payload_size,
+                                             &message);
+        if (return_value != SCMI_SUCCESS)
+            respond(service_id, &return_value, sizeof(return_value));
+        else {
+            status = message->handler(service_id,
+                                      (const uint32_t *)(command + 1));
+            if (status != FWK_SUCCESS) {
+                MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                    "[SCMI] Protocol 0x%x handler error (%e), "
+                    "message_id = 0x%x\n",
+                    ctx->scmi_protocol_id, status, ctx->scmi_message_id);
+            }
+        }
+
+        compound->dispatching = false;
+
+        if (!compound->responded)
+            return;
+    }
+
+    finish_compound();
+}
+
+/*
+ * Compound Protocol - PROTOCOL_VERSION
+ */
+static int scmi_compound_protocol_version_handler(fwk_id_t service_id,
+                                                  const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_COMPOUND,
+    };
+
+    respond(service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Compound Protocol - PROTOCOL_ATTRIBUTES
+ */
+static int scmi_compound_protocol_attributes_handler(fwk_id_t service_id,
+                                                     const uint32_t *payload)
+{
+    /* The attributes are the size in bytes of the response buffer */
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = scmi_ctx.config->compound_response_size,
+    };
+
+    respond(service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Compound Protocol - PROTOCOL_MESSAGE_ATTRIBUTES
+ */
+static int scmi_compound_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_NOT_FOUND,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)payload;
+
+    if ((parameters->message_id < FWK_ARRAY_SIZE(compound_message_table)) &&
+        (compound_message_table[parameters->message_id].handler != NULL))
+        return_values.status = SCMI_SUCCESS;
+
+    respond(service_id, &return_values,
+            (return_values.status == SCMI_SUCCESS) ?
+            sizeof(return_values) : sizeof(return_values.status));
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Compound Protocol - COMPOUND_EXECUTE
+ */
+static int scmi_compound_execute_handler(fwk_id_t service_id,
+                                         const uint32_t *payload)
+{
+    int status;
+    struct scmi_compound_ctx *compound = &scmi_ctx.compound;
+    struct scmi_service_ctx *ctx;
+    const struct scmi_compound_execute_a2p *parameters;
+    const void *message_payload;
+    size_t payload_size;
+    size_t max_payload_size;
+    int32_t return_value = SCMI_GENERIC_ERROR;
+
+    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    /* A single command is executed at a time, for all the agents */
+    if (compound->service_ctx != NULL) {
+        return_value = SCMI_BUSY;
+        status = FWK_SUCCESS;
         goto error;
     }
 
-    if (payload_size != base_payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
+    status = TRANSPORT_API(ctx)->get_payload(ctx->transport_id,
+                                             &message_payload, &payload_size);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    status = TRANSPORT_API(ctx)->get_max_payload_size(ctx->transport_id,
+                                                      &max_payload_size);
+    if (status != FWK_SUCCESS)
+        goto error;
+
+    max_payload_size = FWK_ALIGN_PREVIOUS(
+        FWK_MIN(max_payload_size, scmi_ctx.config->compound_response_size),
+        sizeof(uint32_t));
+    if (max_payload_size < sizeof(struct scmi_compound_execute_p2a)) {
+        status = FWK_E_SIZE;
         goto error;
     }
 
-    return base_handler_table[message_id](service_id, payload);
+    parameters = (const struct scmi_compound_execute_a2p *)payload;
+
+    compound->service_ctx = ctx;
+    compound->command = (const uint8_t *)(parameters + 1);
+    compound->remaining_size = payload_size - sizeof(*parameters);
+    compound->remaining_count = parameters->command_count;
+    compound->executed_count = 0;
+    compound->status = SCMI_SUCCESS;
+    compound->failed = false;
+    compound->response_size_max = max_payload_size;
+    compound->response_size = sizeof(struct scmi_compound_execute_p2a);
+
+    execute_compound();
+
+    return FWK_SUCCESS;
 
 error:
     respond(service_id, &return_value, sizeof(return_value));
 
-    return FWK_SUCCESS;
+    return status;
 }
 
 /*
@@ -567,6 +1491,10 @@ static int scmi_init(fwk_id_t module_id, unsigned int service_count,
     struct mod_scmi_config *config = (struct mod_scmi_config *)data;
     unsigned int agent_idx;
     const struct mod_scmi_agent *agent;
+    struct scmi_protocol *protocol;
+    #ifndef BUILD_HAS_MULTITHREADING
+    struct scmi_agent_ctx *agent_ctx;
+    #endif
 
     if (config == NULL)
         return FWK_E_PARAM;
@@ -586,22 +1514,89 @@ static int scmi_init(fwk_id_t module_id, unsigned int service_count,
             return FWK_E_PARAM;
     }
 
+    if (config->trace_ring != 0) {
+        if ((config->trace_entry_count == 0) ||
+            ((config->trace_entry_count &
+              (config->trace_entry_count - 1)) != 0))
+            return FWK_E_PARAM;
+
+        scmi_ctx.trace_ring = (struct mod_scmi_trace_ring *)config->trace_ring;
+        memset(scmi_ctx.trace_ring, 0, sizeof(struct mod_scmi_trace_ring) +
+            (config->trace_entry_count * sizeof(struct mod_scmi_trace_entry)));
+        scmi_ctx.trace_ring->entry_count = config->trace_entry_count;
+        scmi_ctx.trace_ring->signature = MOD_SCMI_TRACE_RING_SIGNATURE;
+    }
+
     scmi_ctx.protocol_table = fwk_mm_calloc(
         config->protocol_count_max + PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT,
         sizeof(scmi_ctx.protocol_table[0]));
     if (scmi_ctx.protocol_table == NULL)
         return FWK_E_NOMEM;
 
-    scmi_ctx.service_ctx_table = fwk_mm_calloc(
+    scmi_ctx.service_ctx_table = fwk_mm_calloc_hot(
         service_count, sizeof(scmi_ctx.service_ctx_table[0]));
     if (scmi_ctx.service_ctx_table == NULL)
         return FWK_E_NOMEM;
 
-    scmi_ctx.protocol_table[PROTOCOL_TABLE_BASE_PROTOCOL_IDX].message_handler =
-        scmi_base_message_handler;
+    scmi_ctx.agent_id_to_p2a_service_idx = fwk_mm_calloc(
+        config->agent_count + 1,
+        sizeof(scmi_ctx.agent_id_to_p2a_service_idx[0]));
+    if (scmi_ctx.agent_id_to_p2a_service_idx == NULL)
+        return FWK_E_NOMEM;
+
+    if (config->agent_scheduling) {
+        #ifdef BUILD_HAS_MULTITHREADING
+        return FWK_E_SUPPORT;
+        #else
+        scmi_ctx.agent_ctx_table = fwk_mm_calloc_hot(
+            config->agent_count + 1, sizeof(scmi_ctx.agent_ctx_table[0]));
+        if (scmi_ctx.agent_ctx_table == NULL)
+            return FWK_E_NOMEM;
+
+        for (agent_idx = SCMI_PLATFORM_ID + 1;
+             agent_idx <= config->agent_count; agent_idx++) {
+            agent_ctx = &scmi_ctx.agent_ctx_table[agent_idx];
+            agent_ctx->weight = config->agent_table[agent_idx].weight;
+            if (agent_ctx->weight == 0)
+                agent_ctx->weight = 1;
+            fwk_list_init(&agent_ctx->service_list);
+        }
+
+        fwk_list_init(&scmi_ctx.active_agent_list);
+        #endif
+    }
+
+    protocol = &scmi_ctx.protocol_table[PROTOCOL_TABLE_BASE_PROTOCOL_IDX];
+    protocol->message_table = base_message_table;
+    protocol->message_count = FWK_ARRAY_SIZE(base_message_table);
     scmi_ctx.scmi_protocol_id_to_idx[SCMI_PROTOCOL_ID_BASE] =
         PROTOCOL_TABLE_BASE_PROTOCOL_IDX;
 
+    if (config->compound_protocol_id != 0) {
+        #ifdef BUILD_HAS_MULTITHREADING
+        return FWK_E_SUPPORT;
+        #else
+        if ((config->compound_protocol_id < SCMI_PROTOCOL_ID_VENDOR_MIN) ||
+            (config->compound_response_size <
+             sizeof(struct scmi_compound_execute_p2a)) ||
+            ((config->compound_response_size % sizeof(uint32_t)) != 0))
+            return FWK_E_PARAM;
+
+        scmi_ctx.compound.response = fwk_mm_alloc(
+            config->compound_response_size / sizeof(uint32_t),
+            sizeof(uint32_t));
+        if (scmi_ctx.compound.response == NULL)
+            return FWK_E_NOMEM;
+
+        protocol =
+            &scmi_ctx.protocol_table[PROTOCOL_TABLE_COMPOUND_PROTOCOL_IDX];
+        protocol->message_table = compound_message_table;
+        protocol->message_count = FWK_ARRAY_SIZE(compound_message_table);
+        scmi_ctx.scmi_protocol_id_to_idx[config->compound_protocol_id] =
+            PROTOCOL_TABLE_COMPOUND_PROTOCOL_IDX;
+        #endif
+    }
+
     scmi_ctx.config = config;
 
     return FWK_SUCCESS;
@@ -613,6 +1608,7 @@ static int scmi_service_init(fwk_id_t service_id, unsigned int unused,
     const struct mod_scmi_service_config *config =
         (struct mod_scmi_service_config *)data;
     struct scmi_service_ctx *ctx;
+    unsigned int *p2a_service_idx;
 
     if ((config->scmi_agent_id == SCMI_PLATFORM_ID) ||
         (config->scmi_agent_id > scmi_ctx.config->agent_count))
@@ -620,8 +1616,35 @@ static int scmi_service_init(fwk_id_t service_id, unsigned int unused,
 
     ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
     ctx->config = config;
+    ctx->agent_type_mask = MOD_SCMI_AGENT_TYPE_MASK(
+        scmi_ctx.config->agent_table[config->scmi_agent_id].type);
+
+    if (config->channel_type == SCMI_CHANNEL_TYPE_P2A) {
+        if (config->pending_notification_count_max == 0)
+            return FWK_E_PARAM;
+
+        p2a_service_idx =
+            &scmi_ctx.agent_id_to_p2a_service_idx[config->scmi_agent_id];
+        if (*p2a_service_idx != 0)
+            return FWK_E_DATA;
+
+        ctx->pending_notification_table = fwk_mm_calloc(
+            config->pending_notification_count_max,
+            sizeof(ctx->pending_notification_table[0]));
+        if (ctx->pending_notification_table == NULL)
+            return FWK_E_NOMEM;
+
+        *p2a_service_idx = fwk_id_get_element_idx(service_id) + 1;
+
+        /* The service does not process commands, it needs no thread */
+        return FWK_SUCCESS;
+    }
 
+    #ifdef BUILD_HAS_MULTITHREADING
     return fwk_thread_create(service_id);
+    #else
+    return FWK_SUCCESS;
+    #endif
 }
 
 static int scmi_bind(fwk_id_t id, unsigned int round)
@@ -633,9 +1656,19 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
     struct scmi_protocol *protocol;
     struct mod_scmi_to_protocol_api *protocol_api = NULL;
     uint8_t scmi_protocol_id;
+    unsigned int index;
 
     if (round == 0) {
         if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+            #if BUILD_HAS_MOD_TIMER
+            if (scmi_ctx.trace_ring != NULL) {
+                status = fwk_module_bind(scmi_ctx.config->trace_timer_id,
+                    MOD_TIMER_API_ID_TIMER, &scmi_ctx.timer_api);
+                if (status != FWK_SUCCESS)
+                    return status;
+            }
+            #endif
+
             return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
                                    FWK_ID_API(FWK_MODULE_IDX_LOG, 0),
                                    &scmi_ctx.log_api);
@@ -655,9 +1688,17 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
             (transport_api->respond == NULL))
             return FWK_E_DATA;
 
+        if ((ctx->config->channel_type == SCMI_CHANNEL_TYPE_P2A) &&
+            (transport_api->transmit == NULL))
+            return FWK_E_DATA;
+
+        #ifdef BUILD_STATIC_API_SCMI_TRANSPORT
+        if (transport_api != &BUILD_STATIC_API_SCMI_TRANSPORT)
+            return FWK_E_DATA;
+        #endif
+
         ctx->transport_api = transport_api;
         ctx->transport_id = ctx->config->transport_id;
-        ctx->respond = transport_api->respond;
 
         return FWK_SUCCESS;
     }
@@ -676,8 +1717,10 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
             return status;
 
         if ((protocol_api->get_scmi_protocol_id == NULL) ||
-            (protocol_api->message_handler == NULL))
+            (protocol_api->message_table == NULL) ||
+            (protocol_api->message_count == 0))
             return FWK_E_DATA;
+
         status = protocol_api->get_scmi_protocol_id(protocol->id,
                                                     &scmi_protocol_id);
         if (status != FWK_SUCCESS)
@@ -688,7 +1731,35 @@ static int scmi_bind(fwk_id_t id, unsigned int round)
 
         scmi_ctx.scmi_protocol_id_to_idx[scmi_protocol_id] =
             protocol_idx + PROTOCOL_TABLE_RESERVED_ENTRIES_COUNT;
-        protocol->message_handler = protocol_api->message_handler;
+        protocol->message_table = protocol_api->message_table;
+        protocol->message_count = protocol_api->message_count;
+    }
+
+    scmi_ctx.listed_protocol_count = scmi_ctx.protocol_count;
+    if (scmi_ctx.config->compound_protocol_id != 0)
+        scmi_ctx.listed_protocol_count++;
+
+    if (scmi_ctx.listed_protocol_count == 0)
+        return FWK_SUCCESS;
+
+    /*
+     * The list of the protocols does not change once they are all bound, it
+     * is built once here rather than on each BASE_DISCOVER_LIST_PROTOCOLS
+     * command.
+     */
+    scmi_ctx.protocol_id_list = fwk_mm_alloc(scmi_ctx.listed_protocol_count,
+                                             sizeof(uint8_t));
+    if (scmi_ctx.protocol_id_list == NULL)
+        return FWK_E_NOMEM;
+
+    for (index = 0, protocol_idx = 0;
+         index < FWK_ARRAY_SIZE(scmi_ctx.scmi_protocol_id_to_idx);
+         index++) {
+        if ((scmi_ctx.scmi_protocol_id_to_idx[index] == 0) ||
+            (index == SCMI_PROTOCOL_ID_BASE))
+            continue;
+
+        scmi_ctx.protocol_id_list[protocol_idx++] = index;
     }
 
     return FWK_SUCCESS;
@@ -733,8 +1804,8 @@ static int scmi_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_process_event(const struct fwk_event *event,
-                              struct fwk_event *resp)
+static FWK_HOT int scmi_process_event(const struct fwk_event *event,
+                                      struct fwk_event *resp)
 {
     int status;
     struct scmi_service_ctx *ctx;
@@ -744,49 +1815,106 @@ static int scmi_process_event(const struct fwk_event *event,
     const void *payload;
     size_t payload_size;
     unsigned int protocol_idx;
-    struct scmi_protocol *protocol;
+    const struct scmi_protocol *protocol;
+    const struct mod_scmi_message_desc *message;
+    int32_t return_value;
+    fwk_id_t service_id = event->target_id;
+
+    if (fwk_id_get_event_idx(event->id) == SCMI_EVENT_IDX_COMPOUND) {
+        if (scmi_ctx.compound.service_ctx != NULL)
+            execute_compound();
 
-    ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(event->target_id)];
-    transport_api = ctx->transport_api;
+        return FWK_SUCCESS;
+    }
+
+    if (fwk_id_is_type(service_id, FWK_ID_TYPE_MODULE)) {
+        /* Dispatch request of the agent scheduler */
+        ctx = schedule_next_message();
+        if (ctx == NULL)
+            return FWK_SUCCESS;
+
+        service_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI,
+                                    ctx - scmi_ctx.service_ctx_table);
+    } else
+        ctx = &scmi_ctx.service_ctx_table[fwk_id_get_element_idx(service_id)];
+
+    transport_api = TRANSPORT_API(ctx);
     transport_id = ctx->transport_id;
 
+    /* The agent freed the P2A channel, send the next notification */
+    if (ctx->config->channel_type == SCMI_CHANNEL_TYPE_P2A) {
+        flush_notifications(ctx);
+        return FWK_SUCCESS;
+    }
+
     status = transport_api->get_message_header(transport_id, &message_header);
     if (status != FWK_SUCCESS) {
-        scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[SCMI] Unable to read message header\n");
         return status;
     }
 
+    if (scmi_ctx.trace_ring != NULL) {
+        ctx->trace_message_header = message_header;
+        ctx->trace_dispatch = trace_timestamp();
+    }
+
     status = transport_api->get_payload(transport_id, &payload, &payload_size);
     if (status != FWK_SUCCESS) {
-        scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[SCMI] Unable to read message payload\n");
         return status;
     }
 
     ctx->scmi_protocol_id = read_protocol_id(message_header);
     ctx->scmi_message_id = read_message_id(message_header);
+    ctx->scmi_token = read_token(message_header);
 
     protocol_idx = scmi_ctx.scmi_protocol_id_to_idx[ctx->scmi_protocol_id];
 
     if (protocol_idx == 0) {
-        scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[SCMI] Protocol 0x%x not supported\n", ctx->scmi_protocol_id);
-        ctx->respond(transport_id, &(int32_t) { SCMI_NOT_SUPPORTED },
-                     sizeof(int32_t));
+        transport_api->respond(transport_id, &(int32_t) { SCMI_NOT_SUPPORTED },
+                               sizeof(int32_t));
+        trace_response(ctx, SCMI_NOT_SUPPORTED);
+        release_message(ctx);
         return FWK_SUCCESS;
     }
 
     protocol = &scmi_ctx.protocol_table[protocol_idx];
-    status = protocol->message_handler(protocol->id, event->target_id,
-        payload, payload_size, ctx->scmi_message_id);
+
+    if ((ctx->scmi_message_id >= protocol->message_count) ||
+        (protocol->message_table[ctx->scmi_message_id].handler == NULL)) {
+        return_value = SCMI_NOT_SUPPORTED;
+        goto error;
+    }
+
+    message = &protocol->message_table[ctx->scmi_message_id];
+
+    if (!is_payload_size_valid(message, payload_size)) {
+        return_value = SCMI_PROTOCOL_ERROR;
+        goto error;
+    }
+
+    if (message->denied_agent_types & ctx->agent_type_mask) {
+        return_value = SCMI_DENIED;
+        goto error;
+    }
+
+    status = message->handler(service_id, payload);
 
     if (status != FWK_SUCCESS) {
-        scmi_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(scmi_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[SCMI] Protocol 0x%x handler error (%e), message_id = 0x%x\n",
             ctx->scmi_protocol_id, status, ctx->scmi_message_id);
     }
 
+    return FWK_SUCCESS;
+
+error:
+    respond(service_id, &return_value, sizeof(return_value));
+
     return FWK_SUCCESS;
 }
 
@@ -795,8 +1923,17 @@ static int scmi_start(fwk_id_t id)
     const struct mod_scmi_service_config *config;
     unsigned int notifications_sent;
 
-    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        #if BUILD_HAS_MOD_TIMER
+        if (scmi_ctx.trace_ring != NULL) {
+            return scmi_ctx.timer_api->get_frequency(
+                scmi_ctx.config->trace_timer_id,
+                &scmi_ctx.trace_ring->frequency);
+        }
+        #endif
+
         return FWK_SUCCESS;
+    }
 
     config = fwk_module_get_data(id);
 
@@ -844,7 +1981,7 @@ static int scmi_process_notification(const struct fwk_event *event,
 const struct fwk_module module_scmi = {
     .name = "SCMI",
     .api_count = MOD_SCMI_API_IDX_COUNT,
-    .event_count = 1,
+    .event_count = SCMI_EVENT_IDX_COUNT,
     .notification_count = MOD_SCMI_NOTIFICATION_IDX_COUNT,
     .type = FWK_MODULE_TYPE_SERVICE,
     .init = scmi_init,
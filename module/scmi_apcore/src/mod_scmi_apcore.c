@@ -51,23 +51,33 @@ static int scmi_apcore_reset_address_get_handler(fwk_id_t service_id,
  */
 static struct scmi_apcore_ctx scmi_apcore_ctx;
 
-static int (* const handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] = scmi_apcore_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] = scmi_apcore_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_apcore_protocol_message_attributes_handler,
-    [SCMI_APCORE_RESET_ADDRESS_SET] = scmi_apcore_reset_address_set_handler,
-    [SCMI_APCORE_RESET_ADDRESS_GET] = scmi_apcore_reset_address_get_handler,
-};
-
-static const unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_APCORE_RESET_ADDRESS_SET] =
-        sizeof(struct scmi_apcore_reset_address_set_a2p),
-    [SCMI_APCORE_RESET_ADDRESS_GET] = 0,
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_apcore_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_apcore_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_apcore_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_APCORE_RESET_ADDRESS_SET] = {
+        .handler = scmi_apcore_reset_address_set_handler,
+        .payload_size = sizeof(struct scmi_apcore_reset_address_set_a2p),
+        /* Only the PSCI agent may set the reset address */
+        .denied_agent_types =
+            ~MOD_SCMI_AGENT_TYPE_MASK(SCMI_AGENT_TYPE_PSCI),
+    },
+    [SCMI_APCORE_RESET_ADDRESS_GET] = {
+        .handler = scmi_apcore_reset_address_get_handler,
+        /* Only the PSCI agent may get the current reset address */
+        .denied_agent_types =
+            ~MOD_SCMI_AGENT_TYPE_MASK(SCMI_AGENT_TYPE_PSCI),
+    },
 };
 
 /*
@@ -170,8 +180,8 @@ static int scmi_apcore_protocol_message_attributes_handler(fwk_id_t service_id,
         payload;
     message_id = parameters->message_id;
 
-    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
-        (handler_table[message_id] == NULL))
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL))
         return_values.status = SCMI_NOT_FOUND;
 
     response_size = (return_values.status == SCMI_SUCCESS) ?
@@ -189,9 +199,7 @@ static int scmi_apcore_protocol_message_attributes_handler(fwk_id_t service_id,
 static int scmi_apcore_reset_address_set_handler(fwk_id_t service_id,
     const uint32_t *payload)
 {
-    int status;
-    unsigned int agent_id;
-    enum scmi_agent_type agent_type;
+    int status = FWK_SUCCESS;
     const struct scmi_apcore_reset_address_set_a2p *parameters;
     struct scmi_apcore_reset_address_set_p2a return_values = {
         .status = SCMI_GENERIC_ERROR
@@ -199,20 +207,6 @@ static int scmi_apcore_reset_address_set_handler(fwk_id_t service_id,
 
     parameters = (const struct scmi_apcore_reset_address_set_a2p *)payload;
 
-    status = scmi_apcore_ctx.scmi_api->get_agent_id(service_id, &agent_id);
-    if (status != FWK_SUCCESS)
-        goto exit;
-
-    status = scmi_apcore_ctx.scmi_api->get_agent_type(agent_id, &agent_type);
-    if (status != FWK_SUCCESS)
-        goto exit;
-
-    /* Only the PSCI agent may set the reset address */
-    if (agent_type != SCMI_AGENT_TYPE_PSCI) {
-        return_values.status = SCMI_DENIED;
-        goto exit;
-    }
-
     /* An agent previously requested that the configuration be locked */
     if (scmi_apcore_ctx.locked) {
         return_values.status = SCMI_DENIED;
@@ -265,28 +259,9 @@ exit:
 static int scmi_apcore_reset_address_get_handler(fwk_id_t service_id,
     const uint32_t *payload)
 {
-    int status;
-    unsigned int agent_id;
     const struct mod_scmi_apcore_reset_register_group *reg_group;
     uint64_t reset_address;
-    enum scmi_agent_type agent_type;
-    struct scmi_apcore_reset_address_get_p2a return_values = {
-        .status = SCMI_GENERIC_ERROR
-    };
-
-    status = scmi_apcore_ctx.scmi_api->get_agent_id(service_id, &agent_id);
-    if (status != FWK_SUCCESS)
-        goto exit;
-
-    status = scmi_apcore_ctx.scmi_api->get_agent_type(agent_id, &agent_type);
-    if (status != FWK_SUCCESS)
-        goto exit;
-
-    /* Only the PSCI agent may get the current reset address */
-    if (agent_type != SCMI_AGENT_TYPE_PSCI) {
-        return_values.status = SCMI_DENIED;
-        goto exit;
-    }
+    struct scmi_apcore_reset_address_get_p2a return_values = { 0 };
 
     /* The reset address is common across all reset address registers */
     reg_group = &scmi_apcore_ctx.config->reset_register_group_table[0];
@@ -306,10 +281,10 @@ static int scmi_apcore_reset_address_get_handler(fwk_id_t service_id,
         (scmi_apcore_ctx.locked << SCMI_APCORE_RESET_ADDRESS_GET_LOCK_POS);
     return_values.status = SCMI_SUCCESS;
 
-exit:
     scmi_apcore_ctx.scmi_api->respond(
         service_id, &return_values, sizeof(return_values));
-    return status;
+
+    return FWK_SUCCESS;
 }
 
 /*
@@ -329,49 +304,10 @@ static int scmi_apcore_get_scmi_protocol_id(fwk_id_t protocol_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_apcore_message_handler(
-    fwk_id_t protocol_id,
-    fwk_id_t service_id,
-    const uint32_t *payload,
-    size_t payload_size,
-    unsigned int message_id)
-{
-    int status;
-    int32_t return_value;
-
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Core configuration protocol table sizes not consistent");
-    assert(payload != NULL);
-
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
-
-error:
-    scmi_apcore_ctx.scmi_api->respond(
-        service_id,
-        &return_value,
-        sizeof(return_value));
-
-    return FWK_SUCCESS;
-}
-
 static struct mod_scmi_to_protocol_api scmi_apcore_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_apcore_get_scmi_protocol_id,
-    .message_handler = scmi_apcore_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -12,6 +12,7 @@
 #define MOD_SCMI_CLOCK_H
 
 #include <stdint.h>
+#include <fwk_id.h>
 
 /*!
  * \ingroup GroupModules Modules
@@ -102,6 +103,27 @@ struct mod_scmi_clock_config {
 
     /*! Number of agents in \ref agent_table */
     size_t agent_count;
+
+    /*!
+     * \brief Delay in microseconds before gating a clock, zero to gate the
+     *      clocks immediately.
+     *
+     * \details The agents enable and disable the clocks independently, a clock
+     *      is gated once none of the agents that enabled it use it anymore.
+     *      An enable request received within the delay that follows the
+     *      release of the clock cancels the gating without any access to the
+     *      clock. The delay requires the timer module and an alarm, see
+     *      \ref gate_delay_alarm_id.
+     */
+    uint32_t gate_delay_us;
+
+    /*!
+     * \brief Sub-element identifier of the alarm timing the delay before
+     *      gating the clocks.
+     *
+     * \details Only used when \ref gate_delay_us is not equal to zero.
+     */
+    fwk_id_t gate_delay_alarm_id;
 };
 
 /*!
@@ -13,13 +13,57 @@
 #include <fwk_errno.h>
 #include <fwk_id.h>
 #include <fwk_macros.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <internal/scmi.h>
 #include <internal/scmi_clock.h>
 #include <mod_clock.h>
 #include <mod_scmi.h>
 #include <mod_scmi_clock.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
+
+/*
+ * Number of discrete rates retrieved from the clock HAL and written to the
+ * payload at once when describing the rates of a clock.
+ */
+#define SCMI_CLOCK_DESCRIBE_RATES_BATCH_SIZE 16
+
+enum scmi_clock_event_idx {
+    SCMI_CLOCK_EVENT_IDX_SET_RATE,
+    SCMI_CLOCK_EVENT_IDX_COUNT,
+};
+
+/* Parameters of the SCMI_CLOCK_EVENT_IDX_SET_RATE event */
+struct scmi_clock_set_rate_request {
+    uint64_t rate;
+    fwk_id_t clock_id;
+    enum mod_clock_round_mode round_mode;
+};
+
+/* State of the gating of a clock released by all the agents */
+enum scmi_clock_gate_state {
+    /* The clock is not waiting to be gated */
+    SCMI_CLOCK_GATE_STATE_NONE,
+
+    /* The clock is gated when the running gating delay elapses */
+    SCMI_CLOCK_GATE_STATE_PENDING,
+
+    /* The clock was released after the start of the running gating delay */
+    SCMI_CLOCK_GATE_STATE_QUEUED,
+};
+
+/* Reference counting of the enable requests of the agents for a clock */
+struct scmi_clock_gate_ctx {
+    /* Number of agents that enabled the clock */
+    unsigned int ref_count;
+
+    /* State of the gating of the clock */
+    enum scmi_clock_gate_state state;
+};
 
 struct scmi_clock_ctx {
     /*! SCMI Clock Module Configuration */
@@ -39,6 +83,39 @@ struct scmi_clock_ctx {
 
     /* Clock module API */
     const struct mod_clock_api *clock_api;
+
+    /*
+     * Table of the services to respond to, indexed by clock element index, for
+     * the CLOCK_RATE_SET commands in progress. FWK_ID_NONE if none.
+     */
+    fwk_id_t *rate_set_service_table;
+
+    /*
+     * Responses to the CLOCK_ATTRIBUTES command, indexed by agent identifier
+     * and then by clock index. Only the state of the clock in the attributes
+     * is updated when responding.
+     */
+    struct scmi_clock_attributes_p2a **attributes_table;
+
+    /*
+     * Enable requests of the agents, indexed by agent identifier and then by
+     * clock index. True when the agent has enabled the clock.
+     */
+    bool **enabled_table;
+
+    /* Table of the reference counts, indexed by clock element index */
+    struct scmi_clock_gate_ctx *gate_table;
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Alarm API, for the delay before gating the clocks */
+    const struct mod_timer_alarm_api *alarm_api;
+    #endif
+
+    /* True while the delay before gating the clocks is running */
+    bool gate_delay_armed;
+
+    /* Number of clock elements */
+    unsigned int clock_count;
 };
 
 static int scmi_clock_protocol_version_handler(fwk_id_t service_id,
@@ -63,28 +140,40 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
  */
 static struct scmi_clock_ctx scmi_clock_ctx;
 
-static int (* const handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] = scmi_clock_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] = scmi_clock_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_clock_protocol_message_attributes_handler,
-    [SCMI_CLOCK_ATTRIBUTES] = scmi_clock_attributes_handler,
-    [SCMI_CLOCK_RATE_GET] = scmi_clock_rate_get_handler,
-    [SCMI_CLOCK_RATE_SET] = scmi_clock_rate_set_handler,
-    [SCMI_CLOCK_CONFIG_SET] = scmi_clock_config_set_handler,
-    [SCMI_CLOCK_DESCRIBE_RATES] = scmi_clock_describe_rates_handler,
-};
-
-static const unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_CLOCK_ATTRIBUTES] = sizeof(struct scmi_clock_attributes_a2p),
-    [SCMI_CLOCK_RATE_GET] = sizeof(struct scmi_clock_rate_get_a2p),
-    [SCMI_CLOCK_RATE_SET] = sizeof(struct scmi_clock_rate_set_a2p),
-    [SCMI_CLOCK_CONFIG_SET] = sizeof(struct scmi_clock_config_set_a2p),
-    [SCMI_CLOCK_DESCRIBE_RATES] = sizeof(struct scmi_clock_describe_rates_a2p),
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_clock_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_clock_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_clock_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_CLOCK_ATTRIBUTES] = {
+        .handler = scmi_clock_attributes_handler,
+        .payload_size = sizeof(struct scmi_clock_attributes_a2p),
+    },
+    [SCMI_CLOCK_RATE_GET] = {
+        .handler = scmi_clock_rate_get_handler,
+        .payload_size = sizeof(struct scmi_clock_rate_get_a2p),
+    },
+    [SCMI_CLOCK_RATE_SET] = {
+        .handler = scmi_clock_rate_set_handler,
+        .payload_size = sizeof(struct scmi_clock_rate_set_a2p),
+    },
+    [SCMI_CLOCK_CONFIG_SET] = {
+        .handler = scmi_clock_config_set_handler,
+        .payload_size = sizeof(struct scmi_clock_config_set_a2p),
+    },
+    [SCMI_CLOCK_DESCRIBE_RATES] = {
+        .handler = scmi_clock_describe_rates_handler,
+        .payload_size = sizeof(struct scmi_clock_describe_rates_a2p),
+    },
 };
 
 /*
@@ -229,8 +318,8 @@ static int scmi_clock_protocol_message_attributes_handler(fwk_id_t service_id,
         payload;
     message_id = parameters->message_id;
 
-    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
-        (handler_table[message_id] == NULL)) {
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL)) {
         return_values.status = SCMI_NOT_FOUND;
         goto exit;
     }
@@ -249,56 +338,56 @@ static int scmi_clock_attributes_handler(fwk_id_t service_id,
     const uint32_t *payload)
 {
     int status;
-    const struct mod_scmi_clock_agent *agent;
+    unsigned int agent_id;
     const struct mod_scmi_clock_device *clock_device;
-    bool service_permission_granted;
-    size_t response_size;
     enum mod_clock_state clock_state;
     const struct scmi_clock_attributes_a2p *parameters;
-    struct scmi_clock_attributes_p2a return_values = {
-        .status = SCMI_GENERIC_ERROR
-    };
+    struct scmi_clock_attributes_p2a *return_values;
+    int32_t return_value = SCMI_GENERIC_ERROR;
 
     parameters = (const struct scmi_clock_attributes_a2p*)payload;
 
-    status = get_clock_device_entry(service_id,
-                                    parameters->clock_id,
-                                    &clock_device,
-                                    &agent);
-    if (status != FWK_SUCCESS) {
-        return_values.status = SCMI_NOT_FOUND;
+    status = scmi_clock_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
         goto exit;
-    }
 
-    status = check_service_permission(clock_device,
-        MOD_SCMI_CLOCK_PERM_ATTRIBUTES, &service_permission_granted);
-    if (status != FWK_SUCCESS)
+    if ((agent_id >= scmi_clock_ctx.config->agent_count) ||
+        (parameters->clock_id >=
+         scmi_clock_ctx.agent_table[agent_id].device_count)) {
+        return_value = SCMI_NOT_FOUND;
         goto exit;
+    }
 
-    if (!service_permission_granted) {
-        return_values.status = SCMI_DENIED;
+    return_values =
+        &scmi_clock_ctx.attributes_table[agent_id][parameters->clock_id];
+    if (return_values->status != SCMI_SUCCESS) {
+        return_value = return_values->status;
         goto exit;
     }
 
+    clock_device =
+        &scmi_clock_ctx.agent_table[agent_id].device_table[
+            parameters->clock_id];
     status = scmi_clock_ctx.clock_api->get_state(clock_device->element_id,
                                                  &clock_state);
     if (status != FWK_SUCCESS)
         goto exit;
 
-    return_values = (struct scmi_clock_attributes_p2a) {
-        .status = SCMI_SUCCESS,
-        .attributes = SCMI_CLOCK_ATTRIBUTES(
-            clock_state == MOD_CLOCK_STATE_RUNNING),
-    };
+    /* A clock waiting to be gated is reported as stopped */
+    return_values->attributes = SCMI_CLOCK_ATTRIBUTES(
+        (clock_state == MOD_CLOCK_STATE_RUNNING) &&
+        (scmi_clock_ctx.gate_table[
+             fwk_id_get_element_idx(clock_device->element_id)].state ==
+         SCMI_CLOCK_GATE_STATE_NONE));
+
+    scmi_clock_ctx.scmi_api->respond(service_id, return_values,
+                                     sizeof(*return_values));
 
-    strncpy(return_values.clock_name,
-            fwk_module_get_name(clock_device->element_id),
-            sizeof(return_values.clock_name) - 1);
+    return FWK_SUCCESS;
 
 exit:
-    response_size = (return_values.status == SCMI_SUCCESS) ?
-        sizeof(return_values) : sizeof(return_values.status);
-    scmi_clock_ctx.scmi_api->respond(service_id, &return_values, response_size);
+    scmi_clock_ctx.scmi_api->respond(service_id, &return_value,
+                                     sizeof(return_value));
     return status;
 }
 
@@ -374,6 +463,10 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
     struct scmi_clock_rate_set_p2a return_values = {
         .status = SCMI_GENERIC_ERROR
     };
+    fwk_id_t *service;
+    struct fwk_event event;
+    struct scmi_clock_set_rate_request *request =
+        (struct scmi_clock_set_rate_request *)event.params;
 
     parameters = (const struct scmi_clock_rate_set_a2p*)payload;
     round_up = parameters->flags & SCMI_CLOCK_RATE_SET_ROUND_UP_MASK;
@@ -407,17 +500,38 @@ static int scmi_clock_rate_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    status = scmi_clock_ctx.clock_api->set_rate(clock_device->element_id, rate,
-        round_auto ? MOD_CLOCK_ROUND_MODE_NEAREST :
-        (round_up ? MOD_CLOCK_ROUND_MODE_UP : MOD_CLOCK_ROUND_MODE_DOWN));
-    if (status == FWK_E_RANGE) {
-        return_values.status = SCMI_INVALID_PARAMETERS;
+    service = &scmi_clock_ctx.rate_set_service_table[
+        fwk_id_get_element_idx(clock_device->element_id)];
+    if (!fwk_id_is_equal(*service, FWK_ID_NONE)) {
+        return_values.status = SCMI_BUSY;
         goto exit;
     }
+
+    /*
+     * The rate is set from the event handler of this module so that the clock
+     * HAL sends the response to the rate changes completed asynchronously to
+     * this module rather than to the SCMI service.
+     */
+    event = (struct fwk_event) {
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_CLOCK),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_CLOCK,
+                           SCMI_CLOCK_EVENT_IDX_SET_RATE),
+    };
+    *request = (struct scmi_clock_set_rate_request) {
+        .rate = rate,
+        .clock_id = clock_device->element_id,
+        .round_mode = round_auto ? MOD_CLOCK_ROUND_MODE_NEAREST :
+            (round_up ? MOD_CLOCK_ROUND_MODE_UP : MOD_CLOCK_ROUND_MODE_DOWN),
+    };
+
+    status = fwk_thread_put_event(&event);
     if (status != FWK_SUCCESS)
         goto exit;
 
-    return_values.status = SCMI_SUCCESS;
+    /* The command is responded to once the rate is set */
+    *service = service_id;
+
+    return FWK_SUCCESS;
 
 exit:
     response_size = (return_values.status == SCMI_SUCCESS) ?
@@ -426,6 +540,87 @@ exit:
     return FWK_SUCCESS;
 }
 
+/*
+ * Respond to a CLOCK_RATE_SET command once the clock HAL has processed it.
+ */
+static void complete_rate_set(unsigned int clock_idx, int status)
+{
+    fwk_id_t service_id;
+    struct scmi_clock_rate_set_p2a return_values;
+
+    service_id = scmi_clock_ctx.rate_set_service_table[clock_idx];
+    scmi_clock_ctx.rate_set_service_table[clock_idx] = FWK_ID_NONE;
+
+    if (status == FWK_SUCCESS)
+        return_values.status = SCMI_SUCCESS;
+    else if (status == FWK_E_RANGE)
+        return_values.status = SCMI_INVALID_PARAMETERS;
+    else
+        return_values.status = SCMI_GENERIC_ERROR;
+
+    scmi_clock_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+}
+
+/*
+ * Gate a clock released by all the agents, once the gating delay has elapsed
+ * if there is one.
+ */
+static int gate_clock(fwk_id_t clock_id)
+{
+    struct scmi_clock_gate_ctx *gate;
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    #endif
+
+    gate = &scmi_clock_ctx.gate_table[fwk_id_get_element_idx(clock_id)];
+    if (gate->state != SCMI_CLOCK_GATE_STATE_NONE)
+        return FWK_SUCCESS;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (scmi_clock_ctx.config->gate_delay_us != 0) {
+        if (scmi_clock_ctx.gate_delay_armed) {
+            gate->state = SCMI_CLOCK_GATE_STATE_QUEUED;
+            return FWK_SUCCESS;
+        }
+
+        status = scmi_clock_ctx.alarm_api->start_us(
+            scmi_clock_ctx.config->gate_delay_alarm_id,
+            scmi_clock_ctx.config->gate_delay_us, MOD_TIMER_ALARM_TYPE_ONCE,
+            NULL, 0);
+        if (status == FWK_SUCCESS) {
+            scmi_clock_ctx.gate_delay_armed = true;
+            gate->state = SCMI_CLOCK_GATE_STATE_PENDING;
+            return FWK_SUCCESS;
+        }
+
+        /* The clock is gated immediately if the delay cannot be started */
+    }
+    #endif
+
+    return scmi_clock_ctx.clock_api->set_state(clock_id,
+                                               MOD_CLOCK_STATE_STOPPED);
+}
+
+/*
+ * Ungate a clock enabled by its first agent. A clock waiting to be gated is
+ * still running and is left untouched.
+ */
+static int ungate_clock(fwk_id_t clock_id)
+{
+    struct scmi_clock_gate_ctx *gate;
+
+    gate = &scmi_clock_ctx.gate_table[fwk_id_get_element_idx(clock_id)];
+    if (gate->state != SCMI_CLOCK_GATE_STATE_NONE) {
+        gate->state = SCMI_CLOCK_GATE_STATE_NONE;
+        return FWK_SUCCESS;
+    }
+
+    return scmi_clock_ctx.clock_api->set_state(clock_id,
+                                               MOD_CLOCK_STATE_RUNNING);
+}
+
 /*
  * Clock Config Set
  */
@@ -434,11 +629,13 @@ static int scmi_clock_config_set_handler(fwk_id_t service_id,
 {
     int status;
     bool enable;
+    bool *enabled;
     bool service_permission_granted;
     size_t response_size;
     const struct scmi_clock_config_set_a2p *parameters;
     const struct mod_scmi_clock_agent *agent;
     const struct mod_scmi_clock_device *clock_device;
+    struct scmi_clock_gate_ctx *gate;
     struct scmi_clock_rate_set_p2a return_values = {
         .status = SCMI_GENERIC_ERROR
     };
@@ -465,17 +662,46 @@ static int scmi_clock_config_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    status = scmi_clock_ctx.clock_api->set_state(
-        clock_device->element_id,
-        enable ? MOD_CLOCK_STATE_RUNNING : MOD_CLOCK_STATE_STOPPED);
-    if (status == FWK_E_SUPPORT) {
-        return_values.status = SCMI_NOT_SUPPORTED;
-        goto exit;
+    enabled = &scmi_clock_ctx.enabled_table[agent - scmi_clock_ctx.agent_table]
+        [parameters->clock_id];
+    gate = &scmi_clock_ctx.gate_table[
+        fwk_id_get_element_idx(clock_device->element_id)];
+
+    if (enable) {
+        if (!*enabled) {
+            if (gate->ref_count == 0) {
+                status = ungate_clock(clock_device->element_id);
+                if (status != FWK_SUCCESS)
+                    goto set_state_exit;
+            }
+
+            gate->ref_count++;
+            *enabled = true;
+        }
+    } else {
+        if (*enabled) {
+            gate->ref_count--;
+            *enabled = false;
+        }
+
+        /*
+         * The clock is gated once it is released by all the agents. A release
+         * by an agent that did not enable the clock only gates the clocks
+         * that none of the agents use.
+         */
+        if (gate->ref_count == 0) {
+            status = gate_clock(clock_device->element_id);
+            if (status != FWK_SUCCESS)
+                goto set_state_exit;
+        }
     }
-    if (status != FWK_SUCCESS)
-        goto exit;
 
     return_values.status = SCMI_SUCCESS;
+    goto exit;
+
+set_state_exit:
+    if (status == FWK_E_SUPPORT)
+        return_values.status = SCMI_NOT_SUPPORTED;
 
 exit:
     response_size = (return_values.status == SCMI_SUCCESS) ?
@@ -500,8 +726,9 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
     uint32_t index;
     unsigned int rate_count;
     unsigned int remaining_rates;
-    uint64_t rate;
-    struct scmi_clock_rate scmi_rate;
+    unsigned int batch_count;
+    uint64_t rates[SCMI_CLOCK_DESCRIBE_RATES_BATCH_SIZE];
+    struct scmi_clock_rate scmi_rates[SCMI_CLOCK_DESCRIBE_RATES_BATCH_SIZE];
     struct scmi_clock_rate clock_range[3];
     struct mod_clock_info info;
     const struct scmi_clock_describe_rates_a2p *parameters;
@@ -585,23 +812,35 @@ static int scmi_clock_describe_rates_handler(fwk_id_t service_id,
                 remaining_rates
             );
 
-        /* Set each rate entry in the payload to the associated frequency */
-        for (i = 0; i < rate_count; i++,
-                payload_size += sizeof(struct scmi_clock_rate)) {
-            status = scmi_clock_ctx.clock_api->get_rate_from_index(
+        /*
+         * Set the rate entries in the payload to the associated frequencies,
+         * retrieving and writing them in batches.
+         */
+        while (rate_count > 0) {
+            batch_count = FWK_MIN(rate_count, FWK_ARRAY_SIZE(rates));
+
+            status = scmi_clock_ctx.clock_api->get_rates(
                 clock_device->element_id,
-                index + i,
-                &rate);
+                index,
+                batch_count,
+                rates);
             if (status != FWK_SUCCESS)
                 goto exit;
 
-            scmi_rate.low = (uint32_t)rate;
-            scmi_rate.high = (uint32_t)(rate >> 32);
+            for (i = 0; i < batch_count; i++) {
+                scmi_rates[i].low = (uint32_t)rates[i];
+                scmi_rates[i].high = (uint32_t)(rates[i] >> 32);
+            }
 
             status = scmi_clock_ctx.scmi_api->write_payload(service_id,
-                payload_size, &scmi_rate, sizeof(scmi_rate));
+                payload_size, scmi_rates,
+                batch_count * sizeof(struct scmi_clock_rate));
             if (status != FWK_SUCCESS)
                 goto exit;
+
+            payload_size += batch_count * sizeof(struct scmi_clock_rate);
+            index += batch_count;
+            rate_count -= batch_count;
         }
     } else {
         /* The clock has a linear stepping */
@@ -666,42 +905,10 @@ static int scmi_clock_get_scmi_protocol_id(fwk_id_t protocol_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_clock_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
-    const uint32_t *payload, size_t payload_size, unsigned int message_id)
-{
-    int status;
-    int32_t return_value;
-
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Clock management protocol table sizes not consistent");
-    assert(payload != NULL);
-
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
-
-error:
-    scmi_clock_ctx.scmi_api->respond(service_id,
-                                     &return_value, sizeof(return_value));
-    return FWK_SUCCESS;
-}
-
 static struct mod_scmi_to_protocol_api scmi_clock_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_clock_get_scmi_protocol_id,
-    .message_handler = scmi_clock_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -711,16 +918,43 @@ static struct mod_scmi_to_protocol_api scmi_clock_mod_scmi_to_protocol_api = {
 static int scmi_clock_init(fwk_id_t module_id, unsigned int element_count,
                            const void *data)
 {
+    int clock_count;
+    int clock_idx;
     const struct mod_scmi_clock_config *config =
         (const struct mod_scmi_clock_config *)data;
 
     if ((config == NULL) || (config->agent_table == NULL))
         return FWK_E_PARAM;
 
+    #if !BUILD_HAS_MOD_TIMER
+    if (config->gate_delay_us != 0)
+        return FWK_E_SUPPORT;
+    #endif
+
     scmi_clock_ctx.config = config;
     scmi_clock_ctx.max_pending_transactions = config->max_pending_transactions;
     scmi_clock_ctx.agent_table = config->agent_table;
 
+    clock_count = fwk_module_get_element_count(
+        FWK_ID_MODULE(FWK_MODULE_IDX_CLOCK));
+    if (clock_count <= 0)
+        return FWK_SUCCESS;
+
+    scmi_clock_ctx.rate_set_service_table = fwk_mm_calloc(clock_count,
+        sizeof(scmi_clock_ctx.rate_set_service_table[0]));
+    if (scmi_clock_ctx.rate_set_service_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (clock_idx = 0; clock_idx < clock_count; clock_idx++)
+        scmi_clock_ctx.rate_set_service_table[clock_idx] = FWK_ID_NONE;
+
+    scmi_clock_ctx.gate_table = fwk_mm_calloc(clock_count,
+        sizeof(scmi_clock_ctx.gate_table[0]));
+    if (scmi_clock_ctx.gate_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_clock_ctx.clock_count = clock_count;
+
     return FWK_SUCCESS;
 }
 
@@ -737,8 +971,79 @@ static int scmi_clock_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
-    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_CLOCK),
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_CLOCK),
         FWK_ID_API(FWK_MODULE_IDX_CLOCK, 0), &scmi_clock_ctx.clock_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (scmi_clock_ctx.config->gate_delay_us != 0) {
+        return fwk_module_bind(scmi_clock_ctx.config->gate_delay_alarm_id,
+            MOD_TIMER_API_ID_ALARM, &scmi_clock_ctx.alarm_api);
+    }
+    #endif
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_clock_start(fwk_id_t id)
+{
+    unsigned int agent_id, clock_idx;
+    const struct mod_scmi_clock_agent *agent;
+    const struct mod_scmi_clock_device *clock_device;
+    struct scmi_clock_attributes_p2a *attributes;
+
+    /*
+     * The name of the clocks and the permissions of the agents are static, the
+     * responses to the CLOCK_ATTRIBUTES command are built once.
+     */
+    scmi_clock_ctx.attributes_table = fwk_mm_calloc(
+        scmi_clock_ctx.config->agent_count,
+        sizeof(scmi_clock_ctx.attributes_table[0]));
+    if (scmi_clock_ctx.attributes_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_clock_ctx.enabled_table = fwk_mm_calloc(
+        scmi_clock_ctx.config->agent_count,
+        sizeof(scmi_clock_ctx.enabled_table[0]));
+    if (scmi_clock_ctx.enabled_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (agent_id = 0; agent_id < scmi_clock_ctx.config->agent_count;
+         agent_id++) {
+        agent = &scmi_clock_ctx.agent_table[agent_id];
+        if (agent->device_count == 0)
+            continue;
+
+        attributes = fwk_mm_calloc(agent->device_count, sizeof(*attributes));
+        if (attributes == NULL)
+            return FWK_E_NOMEM;
+
+        scmi_clock_ctx.attributes_table[agent_id] = attributes;
+
+        scmi_clock_ctx.enabled_table[agent_id] = fwk_mm_calloc(
+            agent->device_count, sizeof(scmi_clock_ctx.enabled_table[0][0]));
+        if (scmi_clock_ctx.enabled_table[agent_id] == NULL)
+            return FWK_E_NOMEM;
+
+        for (clock_idx = 0; clock_idx < agent->device_count;
+             clock_idx++, attributes++) {
+            clock_device = &agent->device_table[clock_idx];
+
+            if (!(clock_device->permissions &
+                  MOD_SCMI_CLOCK_PERM_ATTRIBUTES)) {
+                attributes->status = SCMI_DENIED;
+                continue;
+            }
+
+            attributes->status = SCMI_SUCCESS;
+            strncpy(attributes->clock_name,
+                    fwk_module_get_name(clock_device->element_id),
+                    sizeof(attributes->clock_name) - 1);
+        }
+    }
+
+    return FWK_SUCCESS;
 }
 
 static int scmi_clock_process_bind_request(fwk_id_t source_id,
@@ -752,12 +1057,107 @@ static int scmi_clock_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+#if BUILD_HAS_MOD_TIMER
+/*
+ * Gate the clocks released during the previous gating delay, and start a new
+ * delay for the clocks released since.
+ */
+static bool gate_pending_clocks(void)
+{
+    unsigned int clock_idx;
+    bool queued = false;
+    struct scmi_clock_gate_ctx *gate;
+
+    for (clock_idx = 0; clock_idx < scmi_clock_ctx.clock_count; clock_idx++) {
+        gate = &scmi_clock_ctx.gate_table[clock_idx];
+
+        if (gate->state == SCMI_CLOCK_GATE_STATE_PENDING) {
+            gate->state = SCMI_CLOCK_GATE_STATE_NONE;
+            scmi_clock_ctx.clock_api->set_state(
+                FWK_ID_ELEMENT(FWK_MODULE_IDX_CLOCK, clock_idx),
+                MOD_CLOCK_STATE_STOPPED);
+        } else if (gate->state == SCMI_CLOCK_GATE_STATE_QUEUED) {
+            gate->state = SCMI_CLOCK_GATE_STATE_PENDING;
+            queued = true;
+        }
+    }
+
+    return queued;
+}
+
+/*
+ * Process the expiry of the delay before gating the clocks.
+ */
+static void process_gate_delay_alarm(void)
+{
+    int status;
+
+    scmi_clock_ctx.gate_delay_armed = false;
+
+    if (!gate_pending_clocks())
+        return;
+
+    status = scmi_clock_ctx.alarm_api->start_us(
+        scmi_clock_ctx.config->gate_delay_alarm_id,
+        scmi_clock_ctx.config->gate_delay_us, MOD_TIMER_ALARM_TYPE_ONCE,
+        NULL, 0);
+    if (status == FWK_SUCCESS) {
+        scmi_clock_ctx.gate_delay_armed = true;
+        return;
+    }
+
+    /* The clocks are gated immediately if the delay cannot be started */
+    gate_pending_clocks();
+}
+#endif
+
+static int scmi_clock_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp_event)
+{
+    int status;
+    const struct scmi_clock_set_rate_request *request;
+    const struct mod_clock_resp_params *params;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        process_gate_delay_alarm();
+        return FWK_SUCCESS;
+    }
+    #endif
+
+    /* Response of the clock HAL to a rate change completed asynchronously */
+    if (event->is_response) {
+        params = (const struct mod_clock_resp_params *)event->params;
+        complete_rate_set(fwk_id_get_element_idx(event->source_id),
+                          params->status);
+
+        return FWK_SUCCESS;
+    }
+
+    if (fwk_id_get_event_idx(event->id) != SCMI_CLOCK_EVENT_IDX_SET_RATE)
+        return FWK_E_PARAM;
+
+    request = (const struct scmi_clock_set_rate_request *)event->params;
+
+    status = scmi_clock_ctx.clock_api->set_rate(request->clock_id,
+        request->rate, request->round_mode);
+
+    /* On FWK_PENDING, the command is responded to once the clock responds */
+    if (status != FWK_PENDING)
+        complete_rate_set(fwk_id_get_element_idx(request->clock_id), status);
+
+    return FWK_SUCCESS;
+}
+
 /* SCMI Clock Management Protocol Definition */
 const struct fwk_module module_scmi_clock = {
     .name = "SCMI Clock Management Protocol",
     .api_count = 1,
+    .event_count = SCMI_CLOCK_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_clock_init,
     .bind = scmi_clock_bind,
+    .start = scmi_clock_start,
     .process_bind_request = scmi_clock_process_bind_request,
+    .process_event = scmi_clock_process_event,
 };
@@ -12,6 +12,9 @@
 #define MOD_SCMI_PERF_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \addtogroup GroupModules Modules
@@ -33,15 +36,150 @@ enum mod_scmi_perf_permissions {
     /*! Permission to set performance level */
     MOD_SCMI_PERF_PERMS_SET_LEVEL  = (1 << 0),
 
-    /*! Permission to set performance limits */
+    /*!
+     * \brief Permission to set performance limits.
+     *
+     * \details The limits of the agents are kept separately, the domain is
+     *      limited to their intersection.
+     */
     MOD_SCMI_PERF_PERMS_SET_LIMITS = (1 << 1),
 };
 
+/*!
+ * \brief Fast channels of a performance domain.
+ *
+ * \details Layout of the memory region shared with the agents for the fast
+ *      channels of a domain. Each fast channel is a 32-bit word.
+ */
+struct mod_scmi_perf_fast_channel {
+    /*!
+     * \brief Performance level requested by the agents.
+     *
+     * \details Written by the agents and polled by the SCP. A value of zero
+     *      is not a valid performance level and marks the absence of request.
+     */
+    uint32_t level_set;
+
+    /*! Current performance level of the domain, written by the SCP */
+    uint32_t level_get;
+};
+
+/*!
+ * \brief Signature of the statistics region, "PERF" in ASCII.
+ */
+#define MOD_SCMI_PERF_STATS_SIGNATURE UINT32_C(0x50455246)
+
+/*!
+ * \brief Revision of the layout of the statistics region.
+ */
+#define MOD_SCMI_PERF_STATS_REVISION UINT16_C(0x1)
+
+/*!
+ * \brief Header of the statistics region.
+ *
+ * \details The statistics region is shared with the agents, which read it
+ *      without issuing any message. The header is followed by the statistics
+ *      of each domain, at the offsets given in \ref domain_offset. All the
+ *      times are in microseconds, from the timer configured with
+ *      \ref mod_scmi_perf_config::stats_timer_id.
+ */
+struct mod_scmi_perf_stats_header {
+    /*! \ref MOD_SCMI_PERF_STATS_SIGNATURE */
+    uint32_t signature;
+
+    /*! \ref MOD_SCMI_PERF_STATS_REVISION */
+    uint16_t revision;
+
+    /*! Reserved, zero */
+    uint16_t attributes;
+
+    /*! Number of performance domains */
+    uint16_t domain_count;
+
+    /*! Reserved, zero */
+    uint16_t reserved;
+
+    /*! Size of the statistics, in bytes */
+    uint32_t size;
+
+    /*! Offsets of the domain statistics from the start of the region */
+    uint32_t domain_offset[];
+};
+
+/*!
+ * \brief Statistics of a performance level.
+ */
+struct mod_scmi_perf_stats_level {
+    /*! Performance level */
+    uint32_t level;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+
+    /*! Number of transitions to the level */
+    uint64_t usage_count;
+
+    /*!
+     * \brief Time spent at the level.
+     *
+     * \note The time spent at the current level since the last transition
+     *      is not included.
+     */
+    uint64_t residency;
+};
+
+/*!
+ * \brief Statistics of a performance domain.
+ *
+ * \details The SCP increments \ref sequence before and after each update of
+ *      the statistics of the domain. An agent reading an odd value, or
+ *      different values before and after reading the statistics, must read
+ *      them again.
+ */
+struct mod_scmi_perf_stats_domain {
+    /*! Number of performance levels */
+    uint16_t level_count;
+
+    /*! Index of the current performance level */
+    uint16_t current_level_idx;
+
+    /*! Update sequence number */
+    uint32_t sequence;
+
+    /*! Time of the transition to the current performance level */
+    uint64_t current_level_entry_time;
+
+    /*! Total number of transitions */
+    uint64_t transition_count;
+
+    /*! Latency of the last transition, from the request to its completion */
+    uint64_t last_transition_latency;
+
+    /*! Statistics of each performance level */
+    struct mod_scmi_perf_stats_level levels[];
+};
+
 /*!
  * \brief Performance domain configuration data.
  */
 struct mod_scmi_perf_domain_config {
     const uint32_t (*permissions)[]; /*!< Per-agent permission flags */
+
+    /*!
+     * \brief Address of the fast channels of the domain, as seen by the SCP.
+     *
+     * \details The region must be at least
+     *      sizeof(struct mod_scmi_perf_fast_channel) bytes long. Zero if the
+     *      domain does not support fast channels.
+     *
+     * \warning The fast channels bypass the per-agent permissions. Only the
+     *      agents allowed to set the level of the domain should have access
+     *      to the region.
+     */
+    uintptr_t fast_channels_addr_scp;
+
+    /*! Address of the fast channels of the domain, as seen by the agents */
+    uint64_t fast_channels_addr_ap;
 };
 
 /*!
@@ -50,8 +188,78 @@ struct mod_scmi_perf_domain_config {
 struct mod_scmi_perf_config {
     /*! Per-domain configuration data */
     const struct mod_scmi_perf_domain_config (*domains)[];
+
+    /*!
+     * \brief Identifier of the timer alarm used to poll the fast channels.
+     *
+     * \details Only used when at least one domain supports fast channels.
+     */
+    fwk_id_t fast_channels_alarm_id;
+
+    /*! Period of the polling of the fast channels, in milliseconds */
+    unsigned int fast_channels_rate_limit;
+
+    /*!
+     * \brief Address of the statistics region, as seen by the SCP.
+     *
+     * \details Zero if the statistics are not supported.
+     */
+    uintptr_t stats_addr_scp;
+
+    /*! Address of the statistics region, as seen by the agents */
+    uint64_t stats_addr_ap;
+
+    /*! Size of the statistics region, in bytes */
+    size_t stats_size;
+
+    /*!
+     * \brief Identifier of the timer used to timestamp the statistics.
+     *
+     * \details Only used when the statistics are supported.
+     */
+    fwk_id_t stats_timer_id;
+};
+
+/*!
+ * \brief Notification API.
+ *
+ * \details The API is used by the modules that change the performance limits
+ *      of the domains on behalf of the platform, for the agents to be notified
+ *      of the changes.
+ */
+struct mod_scmi_perf_notification_api {
+    /*!
+     * \brief Notify the agents of a change of the limits of a domain.
+     *
+     * \details The agents subscribed to the PERFORMANCE_LIMITS_CHANGED and
+     *      PERFORMANCE_LEVEL_CHANGED notifications of the domain are notified
+     *      of its current limits and level. The change is attributed to the
+     *      platform.
+     *
+     * \param domain_id Element identifier of the DVFS domain.
+     */
+    void (*notify_limits_changed)(fwk_id_t domain_id);
 };
 
+/*!
+ * \brief API indices.
+ */
+enum mod_scmi_perf_api_idx {
+    /*! SCMI protocol API, reserved to the SCMI module */
+    MOD_SCMI_PERF_API_IDX_PROTOCOL,
+
+    /*! Notification API */
+    MOD_SCMI_PERF_API_IDX_NOTIFICATION,
+
+    /*! Number of APIs */
+    MOD_SCMI_PERF_API_IDX_COUNT,
+};
+
+/*! Identifier of the notification API */
+static const fwk_id_t mod_scmi_perf_api_id_notification =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_PERF,
+                    MOD_SCMI_PERF_API_IDX_NOTIFICATION);
+
 /*!
  * @}
  */
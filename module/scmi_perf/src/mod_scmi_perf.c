@@ -8,17 +8,96 @@
  *     SCMI performance domain management protocol support.
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_list.h>
 #include <fwk_macros.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <internal/scmi.h>
 #include <internal/scmi_perf.h>
 #include <mod_dvfs.h>
 #include <mod_scmi.h>
 #include <mod_scmi_perf.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
+
+enum scmi_perf_event_idx {
+    SCMI_PERF_EVENT_IDX_FAST_CHANNELS_PROCESS,
+    SCMI_PERF_EVENT_IDX_REQUEST,
+    SCMI_PERF_EVENT_IDX_COUNT
+};
+
+/* "Request" event */
+struct scmi_perf_event_params_request {
+    unsigned int service_idx;
+};
+
+/*
+ * LEVEL_SET or LIMITS_SET request. A service has at most one request in
+ * progress as its channel is not released until the request is responded to.
+ */
+struct scmi_perf_request {
+    /* Node in the list of the requests in progress on the domain */
+    struct fwk_slist_node node;
+
+    /* Identifier of the message of the request */
+    unsigned int message_id;
+
+    /* Service to respond to once the request is complete */
+    fwk_id_t service_id;
+
+    /* Index of the performance domain targeted by the request */
+    unsigned int domain_idx;
+
+    /* Requested performance level */
+    uint64_t level;
+
+    /* Requested performance limits */
+    struct mod_dvfs_frequency_limits limits;
+
+    /* Agent of a LIMITS_SET request */
+    unsigned int agent_id;
+
+    /* Previous limits of the agent, restored if a LIMITS_SET request fails */
+    struct mod_dvfs_frequency_limits previous_agent_limits;
+
+    /* Time of the request, in microseconds */
+    uint64_t start_time;
+};
+
+/* Performance domain context */
+struct scmi_perf_domain_ctx {
+    /*
+     * Requests submitted to the DVFS module, in submission order. The DVFS
+     * module responds to the requests of a domain in the same order.
+     */
+    struct fwk_slist request_list;
+
+    /* Last level requested through the fast channels */
+    uint32_t fast_channel_last_level;
+
+    /* Response entries of the PERFORMANCE_DESCRIBE_LEVELS command */
+    struct scmi_perf_level *level_table;
+
+    /* Number of performance levels */
+    size_t level_count;
+
+    /*
+     * The power costs of the levels are calibrated at runtime by the DVFS
+     * module and must be refreshed before each response.
+     */
+    bool calibrated_power_costs;
+
+    /* Intersection of the limits of all the agents */
+    struct mod_dvfs_frequency_limits limits;
+};
 
 struct scmi_perf_ctx {
     /* SCMI Performance Module Configuration */
@@ -32,6 +111,49 @@ struct scmi_perf_ctx {
 
     /* DVFS module API */
     const struct mod_dvfs_domain_api *dvfs_api;
+
+    /* Table of performance domain contexts */
+    struct scmi_perf_domain_ctx *domain_ctx_table;
+
+    /* Table of requests, one per SCMI service */
+    struct scmi_perf_request *request_table;
+
+    /* At least one domain supports fast channels */
+    bool fast_channels;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /*
+     * Tables of the PERFORMANCE_LIMITS_CHANGED and PERFORMANCE_LEVEL_CHANGED
+     * subscriptions, one entry per agent for each performance domain.
+     */
+    bool *notify_limits_table;
+    bool *notify_level_table;
+
+    /*
+     * Responses to the PERFORMANCE_DOMAIN_ATTRIBUTES command, one entry per
+     * agent for each performance domain.
+     */
+    struct scmi_perf_domain_attributes_p2a *domain_attributes_table;
+
+    /*
+     * Limits requested by the agents, one entry per agent for each performance
+     * domain. An agent that has not set any limits does not restrict the
+     * levels of the domain.
+     */
+    struct mod_dvfs_frequency_limits *agent_limits_table;
+
+    /* Statistics region, NULL if the statistics are not supported */
+    volatile struct mod_scmi_perf_stats_header *stats;
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Alarm API used to poll the fast channels */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Timer API used to timestamp the statistics */
+    const struct mod_timer_api *timer_api;
+    #endif
 };
 
 static int scmi_perf_protocol_version_handler(
@@ -52,48 +174,494 @@ static int scmi_perf_limits_set_handler(
     fwk_id_t service_id, const uint32_t *payload);
 static int scmi_perf_limits_get_handler(
     fwk_id_t service_id, const uint32_t *payload);
+static int scmi_perf_notify_limits_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_perf_notify_level_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_perf_describe_fast_channels_handler(
+    fwk_id_t service_id, const uint32_t *payload);
 
 static struct scmi_perf_ctx scmi_perf_ctx;
 
-static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] =
-                       scmi_perf_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] =
-                       scmi_perf_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       scmi_perf_protocol_message_attributes_handler,
-    [SCMI_PERF_DOMAIN_ATTRIBUTES] =
-                       scmi_perf_domain_attributes_handler,
-    [SCMI_PERF_DESCRIBE_LEVELS] =
-                       scmi_perf_describe_levels_handler,
-    [SCMI_PERF_LIMITS_SET] =
-                       scmi_perf_limits_set_handler,
-    [SCMI_PERF_LIMITS_GET] =
-                       scmi_perf_limits_get_handler,
-    [SCMI_PERF_LEVEL_SET] =
-                       scmi_perf_level_set_handler,
-    [SCMI_PERF_LEVEL_GET] =
-                       scmi_perf_level_get_handler
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_perf_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_perf_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_perf_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_PERF_DOMAIN_ATTRIBUTES] = {
+        .handler = scmi_perf_domain_attributes_handler,
+        .payload_size = sizeof(struct scmi_perf_domain_attributes_a2p),
+    },
+    [SCMI_PERF_DESCRIBE_LEVELS] = {
+        .handler = scmi_perf_describe_levels_handler,
+        .payload_size = sizeof(struct scmi_perf_describe_levels_a2p),
+    },
+    [SCMI_PERF_LIMITS_SET] = {
+        .handler = scmi_perf_limits_set_handler,
+        .payload_size = sizeof(struct scmi_perf_limits_set_a2p),
+    },
+    [SCMI_PERF_LIMITS_GET] = {
+        .handler = scmi_perf_limits_get_handler,
+        .payload_size = sizeof(struct scmi_perf_limits_get_a2p),
+    },
+    [SCMI_PERF_LEVEL_SET] = {
+        .handler = scmi_perf_level_set_handler,
+        .payload_size = sizeof(struct scmi_perf_level_set_a2p),
+    },
+    [SCMI_PERF_LEVEL_GET] = {
+        .handler = scmi_perf_level_get_handler,
+        .payload_size = sizeof(struct scmi_perf_level_get_a2p),
+    },
+    [SCMI_PERF_NOTIFY_LIMITS] = {
+        .handler = scmi_perf_notify_limits_handler,
+        .payload_size = sizeof(struct scmi_perf_notify_limits_a2p),
+    },
+    [SCMI_PERF_NOTIFY_LEVEL] = {
+        .handler = scmi_perf_notify_level_handler,
+        .payload_size = sizeof(struct scmi_perf_notify_level_a2p),
+    },
+    [SCMI_PERF_DESCRIBE_FAST_CHANNEL] = {
+        .handler = scmi_perf_describe_fast_channels_handler,
+        .payload_size = sizeof(struct scmi_perf_describe_fast_channel_a2p),
+    },
 };
 
-static unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_PERF_DOMAIN_ATTRIBUTES] =
-                       sizeof(struct scmi_perf_domain_attributes_a2p),
-    [SCMI_PERF_DESCRIBE_LEVELS] =
-                       sizeof(struct scmi_perf_describe_levels_a2p),
-    [SCMI_PERF_LEVEL_SET] =
-                       sizeof(struct scmi_perf_level_set_a2p),
-    [SCMI_PERF_LEVEL_GET] =
-                       sizeof(struct scmi_perf_level_get_a2p),
-    [SCMI_PERF_LIMITS_SET] =
-                       sizeof(struct scmi_perf_limits_set_a2p),
-    [SCMI_PERF_LIMITS_GET] =
-                       sizeof(struct scmi_perf_limits_get_a2p),
-};
+/*
+ * Static helpers
+ */
+
+static bool has_fast_channels(const struct mod_scmi_perf_domain_config *domain)
+{
+    return domain->fast_channels_addr_scp != 0;
+}
+
+/* Whether a message can be issued through a fast channel */
+static bool is_fast_channel_message(unsigned int message_id)
+{
+    return (message_id == SCMI_PERF_LEVEL_SET) ||
+           (message_id == SCMI_PERF_LEVEL_GET);
+}
+
+/*
+ * Get the current time in microseconds, zero if the time is not available.
+ */
+static uint64_t get_time(void)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    fwk_id_t timer_id = scmi_perf_ctx.config->stats_timer_id;
+    uint64_t time;
+
+    if (scmi_perf_ctx.timer_api == NULL)
+        return 0;
+
+    status = scmi_perf_ctx.timer_api->get_time(timer_id, &time);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    return time;
+    #else
+    return 0;
+    #endif
+}
+
+static volatile struct mod_scmi_perf_stats_domain *get_stats_domain(
+    unsigned int domain_idx)
+{
+    return (volatile struct mod_scmi_perf_stats_domain *)
+        ((uintptr_t)scmi_perf_ctx.stats +
+         scmi_perf_ctx.stats->domain_offset[domain_idx]);
+}
+
+/* Find the index of a performance level in the statistics of a domain */
+static bool get_stats_level_idx(
+    const volatile struct mod_scmi_perf_stats_domain *stats,
+    uint32_t level,
+    unsigned int *level_idx)
+{
+    unsigned int idx;
+
+    for (idx = 0; idx < stats->level_count; idx++) {
+        if (stats->levels[idx].level == level) {
+            *level_idx = idx;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Account for the completion of a transition in the statistics of a domain.
+ */
+static void stats_update(unsigned int domain_idx, uint64_t start_time)
+{
+    int status;
+    volatile struct mod_scmi_perf_stats_domain *stats;
+    unsigned int level_idx;
+    struct mod_dvfs_opp opp;
+    uint64_t now;
+
+    if (scmi_perf_ctx.stats == NULL)
+        return;
+
+    status = scmi_perf_ctx.dvfs_api->get_current_opp(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx), &opp);
+    if (status != FWK_SUCCESS)
+        return;
+
+    stats = get_stats_domain(domain_idx);
+    if (!get_stats_level_idx(stats, (uint32_t)opp.frequency, &level_idx))
+        return;
+
+    now = get_time();
+
+    stats->sequence++;
+
+    if (level_idx != stats->current_level_idx) {
+        stats->levels[stats->current_level_idx].residency +=
+            now - stats->current_level_entry_time;
+        stats->levels[level_idx].usage_count++;
+        stats->current_level_idx = level_idx;
+        stats->current_level_entry_time = now;
+        stats->transition_count++;
+    }
+
+    stats->last_transition_latency = now - start_time;
+
+    stats->sequence++;
+}
+
+/*
+ * Lay out the statistics region. This is done once the DVFS module is bound
+ * as the layout depends on the number of operating points of each domain.
+ */
+static int stats_init(void)
+{
+    int status;
+    const struct mod_scmi_perf_config *config = scmi_perf_ctx.config;
+    volatile struct mod_scmi_perf_stats_header *header;
+    volatile struct mod_scmi_perf_stats_domain *stats;
+    unsigned int domain_idx, level_idx;
+    fwk_id_t domain_id;
+    size_t opp_count;
+    size_t header_size, size;
+    struct mod_dvfs_opp opp;
+    uint64_t now;
+
+    if (config->stats_addr_scp == 0)
+        return FWK_SUCCESS;
+
+    /* Size the region, the domain statistics follow the domain offsets */
+    header_size = FWK_ALIGN_NEXT(sizeof(struct mod_scmi_perf_stats_header) +
+        (scmi_perf_ctx.domain_count * sizeof(uint32_t)), sizeof(uint64_t));
+    size = header_size;
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+        status = scmi_perf_ctx.dvfs_api->get_opp_count(domain_id, &opp_count);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        size += sizeof(struct mod_scmi_perf_stats_domain) +
+                (opp_count * sizeof(struct mod_scmi_perf_stats_level));
+    }
+
+    if (size > config->stats_size)
+        return FWK_E_NOMEM;
+
+    header = (volatile struct mod_scmi_perf_stats_header *)
+        config->stats_addr_scp;
+    memset((void *)header, 0, size);
+
+    header->signature = MOD_SCMI_PERF_STATS_SIGNATURE;
+    header->revision = MOD_SCMI_PERF_STATS_REVISION;
+    header->domain_count = scmi_perf_ctx.domain_count;
+    header->size = size;
+
+    /* Lay out the domains after the header */
+    size = header_size;
+    now = get_time();
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+        status = scmi_perf_ctx.dvfs_api->get_opp_count(domain_id, &opp_count);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        header->domain_offset[domain_idx] = size;
+        stats = (volatile struct mod_scmi_perf_stats_domain *)
+            ((uintptr_t)header + size);
+        stats->level_count = opp_count;
+        stats->current_level_entry_time = now;
+
+        for (level_idx = 0; level_idx < opp_count; level_idx++) {
+            status = scmi_perf_ctx.dvfs_api->get_nth_opp(domain_id, level_idx,
+                                                         &opp);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            stats->levels[level_idx].level = (uint32_t)opp.frequency;
+        }
+
+        status = scmi_perf_ctx.dvfs_api->get_current_opp(domain_id, &opp);
+        if ((status == FWK_SUCCESS) &&
+            get_stats_level_idx(stats, (uint32_t)opp.frequency, &level_idx))
+            stats->current_level_idx = level_idx;
+
+        size += sizeof(struct mod_scmi_perf_stats_domain) +
+                (opp_count * sizeof(struct mod_scmi_perf_stats_level));
+    }
+
+    scmi_perf_ctx.stats = header;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Send a notification to the agents subscribed to it for a domain. The payload
+ * starts with the identifier of the agent that caused the change.
+ */
+static void notify_agents(const bool *notify_table, unsigned int domain_idx,
+                          unsigned int message_id, const void *payload,
+                          size_t size)
+{
+    unsigned int agent_idx;
+
+    notify_table += domain_idx * scmi_perf_ctx.agent_count;
+
+    /* A notification that cannot be delivered is lost, as per the protocol */
+    for (agent_idx = 0; agent_idx < scmi_perf_ctx.agent_count; agent_idx++) {
+        if (notify_table[agent_idx]) {
+            scmi_perf_ctx.scmi_api->notify(agent_idx + 1,
+                SCMI_PROTOCOL_ID_PERF, message_id, payload, size);
+        }
+    }
+}
+
+/* Notify the agents of a change of the performance limits of a domain */
+static void notify_limits(unsigned int domain_idx, unsigned int agent_id)
+{
+    struct mod_dvfs_frequency_limits limits;
+    struct scmi_perf_limits_changed_p2a payload;
+
+    if (scmi_perf_ctx.dvfs_api->get_frequency_limits(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx), &limits) !=
+        FWK_SUCCESS)
+        return;
+
+    payload = (struct scmi_perf_limits_changed_p2a) {
+        .agent_id = agent_id,
+        .domain_id = domain_idx,
+        .range_min = (uint32_t)limits.minimum,
+        .range_max = (uint32_t)limits.maximum,
+    };
+
+    notify_agents(scmi_perf_ctx.notify_limits_table, domain_idx,
+                  SCMI_PERF_LIMITS_CHANGED, &payload, sizeof(payload));
+}
+
+/* Notify the agents of a change of the performance level of a domain */
+static void notify_level(unsigned int domain_idx, unsigned int agent_id)
+{
+    struct mod_dvfs_opp opp;
+    struct scmi_perf_level_changed_p2a payload;
+
+    if (scmi_perf_ctx.dvfs_api->get_current_opp(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx), &opp) !=
+        FWK_SUCCESS)
+        return;
+
+    payload = (struct scmi_perf_level_changed_p2a) {
+        .agent_id = agent_id,
+        .domain_id = domain_idx,
+        .performance_level = (uint32_t)opp.frequency,
+    };
+
+    notify_agents(scmi_perf_ctx.notify_level_table, domain_idx,
+                  SCMI_PERF_LEVEL_CHANGED, &payload, sizeof(payload));
+}
+
+/* Get the limits requested by an agent for a domain */
+static struct mod_dvfs_frequency_limits *get_agent_limits(
+    unsigned int domain_idx, unsigned int agent_id)
+{
+    return &scmi_perf_ctx.agent_limits_table[
+        (domain_idx * scmi_perf_ctx.agent_count) + (agent_id - 1)];
+}
+
+/* Compute the intersection of the limits of all the agents for a domain */
+static void compute_limits(unsigned int domain_idx,
+                           struct mod_dvfs_frequency_limits *limits)
+{
+    unsigned int agent_id;
+    const struct mod_dvfs_frequency_limits *agent_limits;
+
+    *limits = *get_agent_limits(domain_idx, 1);
+
+    for (agent_id = 2; agent_id <= scmi_perf_ctx.agent_count; agent_id++) {
+        agent_limits = get_agent_limits(domain_idx, agent_id);
+        limits->minimum = FWK_MAX(limits->minimum, agent_limits->minimum);
+        limits->maximum = FWK_MIN(limits->maximum, agent_limits->maximum);
+    }
+}
+
+/*
+ * Update the limits of an agent for a domain and get the resulting intersection
+ * of the limits of all the agents. The intersection is derived from the current
+ * one, unless the agent relaxes a bound that was set by its previous limits.
+ */
+static void set_agent_limits(unsigned int domain_idx, unsigned int agent_id,
+                             const struct mod_dvfs_frequency_limits *new_limits,
+                             struct mod_dvfs_frequency_limits *limits)
+{
+    struct mod_dvfs_frequency_limits *agent_limits;
+    const struct mod_dvfs_frequency_limits *current;
+    bool relaxed;
+
+    agent_limits = get_agent_limits(domain_idx, agent_id);
+    current = &scmi_perf_ctx.domain_ctx_table[domain_idx].limits;
+
+    relaxed = ((new_limits->minimum < agent_limits->minimum) &&
+               (agent_limits->minimum == current->minimum)) ||
+              ((new_limits->maximum > agent_limits->maximum) &&
+               (agent_limits->maximum == current->maximum));
+
+    *agent_limits = *new_limits;
+
+    if (relaxed) {
+        compute_limits(domain_idx, limits);
+        return;
+    }
+
+    limits->minimum = FWK_MAX(current->minimum, new_limits->minimum);
+    limits->maximum = FWK_MIN(current->maximum, new_limits->maximum);
+}
+
+/* Check whether a frequency is one of the performance levels of a domain */
+static bool is_level(unsigned int domain_idx, uint64_t frequency)
+{
+    const struct scmi_perf_domain_ctx *domain_ctx;
+    size_t level_idx;
+
+    domain_ctx = &scmi_perf_ctx.domain_ctx_table[domain_idx];
+
+    for (level_idx = 0; level_idx < domain_ctx->level_count; level_idx++) {
+        if (domain_ctx->level_table[level_idx].performance_level == frequency)
+            return true;
+    }
+
+    return false;
+}
+
+/*
+ * Start the processing of a LEVEL_SET or LIMITS_SET request. The request is
+ * carried out from the event handler of this module so that the DVFS module
+ * responds to this module rather than to the SCMI service.
+ *
+ * \return The SCMI status to respond with if the request was not submitted,
+ *      SCMI_SUCCESS otherwise.
+ */
+static int32_t submit_request(struct scmi_perf_request *request)
+{
+    struct fwk_event event;
+    struct scmi_perf_event_params_request *params;
+
+    event = (struct fwk_event) {
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_PERF),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_PERF,
+                           SCMI_PERF_EVENT_IDX_REQUEST),
+    };
+
+    params = (void *)&event.params;
+    params->service_idx = fwk_id_get_element_idx(request->service_id);
+
+    request->start_time = get_time();
+
+    if (fwk_thread_put_event(&event) != FWK_SUCCESS)
+        return SCMI_GENERIC_ERROR;
+
+    return SCMI_SUCCESS;
+}
+
+/* Send the delayed response of a request */
+static void complete_request(const struct scmi_perf_request *request,
+                             int status)
+{
+    int32_t return_value;
+    unsigned int agent_id;
+
+    if (status == FWK_SUCCESS) {
+        return_value = SCMI_SUCCESS;
+        stats_update(request->domain_idx, request->start_time);
+    } else if (status == FWK_E_BUSY)
+        return_value = SCMI_BUSY;
+    else if ((status == FWK_E_RANGE) ||
+             (request->message_id == SCMI_PERF_LIMITS_SET))
+        return_value = SCMI_OUT_OF_RANGE;
+    else
+        return_value = SCMI_GENERIC_ERROR;
+
+    /* The limits of the agent are restored when they cannot be applied */
+    if ((status != FWK_SUCCESS) &&
+        (request->message_id == SCMI_PERF_LIMITS_SET)) {
+        *get_agent_limits(request->domain_idx, request->agent_id) =
+            request->previous_agent_limits;
+        compute_limits(request->domain_idx,
+            &scmi_perf_ctx.domain_ctx_table[request->domain_idx].limits);
+    }
+
+    /* The LEVEL_SET and LIMITS_SET responses only hold a status */
+    scmi_perf_ctx.scmi_api->respond(request->service_id, &return_value,
+                                    sizeof(return_value));
+
+    if ((status != FWK_SUCCESS) ||
+        (scmi_perf_ctx.scmi_api->get_agent_id(request->service_id, &agent_id)
+         != FWK_SUCCESS))
+        return;
+
+    /* A change of the limits may also change the level */
+    if (request->message_id == SCMI_PERF_LIMITS_SET)
+        notify_limits(request->domain_idx, agent_id);
+    notify_level(request->domain_idx, agent_id);
+}
+
+static void process_request(struct scmi_perf_request *request)
+{
+    int status;
+    fwk_id_t domain_id;
+
+    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, request->domain_idx);
+
+    if (request->message_id == SCMI_PERF_LEVEL_SET) {
+        status = scmi_perf_ctx.dvfs_api->set_frequency_async(
+            domain_id, request->level);
+    } else {
+        status = scmi_perf_ctx.dvfs_api->set_frequency_limits_async(
+            domain_id, &request->limits);
+    }
+
+    /* On success, the response is sent once the DVFS module responds */
+    if (status != FWK_SUCCESS) {
+        complete_request(request, status);
+        return;
+    }
+
+    fwk_list_push_tail(
+        &scmi_perf_ctx.domain_ctx_table[request->domain_idx].request_list,
+        &request->node);
+}
 
 /*
  * Protocol command handlers
@@ -120,11 +688,16 @@ static int scmi_perf_protocol_attributes_handler(fwk_id_t service_id,
         .status = SCMI_SUCCESS,
         .attributes =
             SCMI_PERF_PROTOCOL_ATTRIBUTES(true, scmi_perf_ctx.domain_count),
-        .statistics_len = 0, /* Unsupported */
-        .statistics_address_low = 0, /* Unsupported */
-        .statistics_address_high = 0, /* Unsupported */
     };
 
+    if (scmi_perf_ctx.stats != NULL) {
+        return_values.statistics_len = scmi_perf_ctx.stats->size;
+        return_values.statistics_address_low =
+            (uint32_t)scmi_perf_ctx.config->stats_addr_ap;
+        return_values.statistics_address_high =
+            (uint32_t)(scmi_perf_ctx.config->stats_addr_ap >> 32);
+    }
+
     scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
                                     sizeof(return_values));
 
@@ -142,11 +715,13 @@ static int scmi_perf_protocol_message_attributes_handler(fwk_id_t service_id,
         (const struct scmi_protocol_message_attributes_a2p *)payload;
     message_id = parameters->message_id;
 
-    if ((message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[message_id] != NULL)) {
+    if ((message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[message_id].handler != NULL)) {
         return_values = (struct scmi_protocol_message_attributes_p2a) {
             .status = SCMI_SUCCESS,
-            .attributes = 0, /* All commands have an attributes value of 0 */
+            .attributes = (scmi_perf_ctx.fast_channels &&
+                           is_fast_channel_message(message_id)) ?
+                SCMI_PERF_MESSAGE_ATTRIBUTES_FAST_CHANNEL_MASK : 0,
         };
     } else
         return_values.status = SCMI_NOT_FOUND;
@@ -163,20 +738,17 @@ static int scmi_perf_domain_attributes_handler(fwk_id_t service_id,
 {
     int status;
     unsigned int agent_id;
-    const struct mod_scmi_perf_domain_config *domain;
     const struct scmi_perf_domain_attributes_a2p *parameters;
-    struct scmi_perf_domain_attributes_p2a return_values;
-    uint32_t permissions;
-    fwk_id_t domain_id;
-    struct mod_dvfs_opp opp;
+    const struct scmi_perf_domain_attributes_p2a *return_values;
+    int32_t return_value;
 
-    return_values.status = SCMI_GENERIC_ERROR;
+    return_value = SCMI_GENERIC_ERROR;
 
     /* Validate the domain identifier */
     parameters = (const struct scmi_perf_domain_attributes_a2p *)payload;
     if (parameters->domain_id >= scmi_perf_ctx.domain_count) {
         status = FWK_SUCCESS;
-        return_values.status = SCMI_NOT_FOUND;
+        return_value = SCMI_NOT_FOUND;
 
         goto exit;
     }
@@ -185,34 +757,17 @@ static int scmi_perf_domain_attributes_handler(fwk_id_t service_id,
     if (status != FWK_SUCCESS)
         goto exit;
 
-    domain = &(*scmi_perf_ctx.config->domains)[parameters->domain_id];
-    permissions = (*domain->permissions)[agent_id];
-
-    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id),
-    status = scmi_perf_ctx.dvfs_api->get_sustained_opp(domain_id, &opp);
-    if (status != FWK_SUCCESS)
-        goto exit;
+    return_values = &scmi_perf_ctx.domain_attributes_table[
+        (parameters->domain_id * scmi_perf_ctx.agent_count) + (agent_id - 1)];
 
-    return_values = (struct scmi_perf_domain_attributes_p2a) {
-        .status = SCMI_SUCCESS,
-        .attributes = SCMI_PERF_DOMAIN_ATTRIBUTES(
-            false, false,
-            !!(permissions & MOD_SCMI_PERF_PERMS_SET_LEVEL),
-            !!(permissions & MOD_SCMI_PERF_PERMS_SET_LIMITS)
-        ),
-        .rate_limit = 0, /* Unsupported */
-        .sustained_freq = opp.frequency / FWK_KHZ,
-        .sustained_perf_level = opp.frequency,
-    };
+    scmi_perf_ctx.scmi_api->respond(service_id, return_values,
+                                    sizeof(*return_values));
 
-    /* Copy the domain name into the mailbox */
-    strncpy((char *)return_values.name, fwk_module_get_name(domain_id),
-        sizeof(return_values.name) - 1);
+    return FWK_SUCCESS;
 
 exit:
-    scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
-        (return_values.status == SCMI_SUCCESS) ?
-        sizeof(return_values) : sizeof(return_values.status));
+    scmi_perf_ctx.scmi_api->respond(service_id, &return_value,
+                                    sizeof(return_value));
 
     return status;
 }
@@ -224,13 +779,11 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
     size_t max_payload_size;
     const struct scmi_perf_describe_levels_a2p *parameters;
     struct scmi_perf_describe_levels_p2a return_values;
+    const struct scmi_perf_domain_ctx *domain_ctx;
     fwk_id_t domain_id;
-    struct scmi_perf_level perf_level;
     unsigned int num_levels, level_index, level_index_max;
     size_t payload_size;
-    size_t opp_count;
     struct mod_dvfs_opp opp;
-    uint16_t latency;
 
     return_values.status = SCMI_GENERIC_ERROR;
     payload_size = sizeof(return_values);
@@ -255,15 +808,11 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Get the number of operating points for the domain */
-    domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id);
-    status = scmi_perf_ctx.dvfs_api->get_opp_count(domain_id, &opp_count);
-    if (status != FWK_SUCCESS)
-        goto exit;
+    domain_ctx = &scmi_perf_ctx.domain_ctx_table[parameters->domain_id];
 
     /* Validate level index */
     level_index = parameters->level_index;
-    if (level_index >= opp_count) {
+    if (level_index >= domain_ctx->level_count) {
         return_values.status = SCMI_INVALID_PARAMETERS;
 
         goto exit;
@@ -272,38 +821,38 @@ static int scmi_perf_describe_levels_handler(fwk_id_t service_id,
     /* Identify the maximum number of performance levels we can send at once */
     num_levels =
         (SCMI_PERF_LEVELS_MAX(max_payload_size) <
-            (opp_count - level_index)) ?
+            (domain_ctx->level_count - level_index)) ?
         SCMI_PERF_LEVELS_MAX(max_payload_size) :
-            (opp_count - level_index);
+            (domain_ctx->level_count - level_index);
     level_index_max = (level_index + num_levels - 1);
 
-    status = scmi_perf_ctx.dvfs_api->get_latency(domain_id, &latency);
-    if (status != FWK_SUCCESS)
-        goto exit;
-
-    /* Copy DVFS data into returned data structure */
-    for (; level_index <= level_index_max; level_index++,
-         payload_size += sizeof(perf_level)) {
+    if (domain_ctx->calibrated_power_costs) {
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id);
 
-        status = scmi_perf_ctx.dvfs_api->get_nth_opp(
-            domain_id, level_index, &opp);
-        if (status != FWK_SUCCESS)
-            goto exit;
+        for (; level_index <= level_index_max; level_index++) {
+            status = scmi_perf_ctx.dvfs_api->get_nth_opp(
+                domain_id, level_index, &opp);
+            if (status != FWK_SUCCESS)
+                goto exit;
 
-        perf_level.power_cost = opp.voltage;
-        perf_level.performance_level = opp.frequency;
-        perf_level.attributes = latency;
+            if (opp.power != 0)
+                domain_ctx->level_table[level_index].power_cost = opp.power;
+        }
 
-        status = scmi_perf_ctx.scmi_api->write_payload(service_id, payload_size,
-            &perf_level, sizeof(perf_level));
-        if (status != FWK_SUCCESS)
-            goto exit;
+        level_index = parameters->level_index;
     }
 
+    status = scmi_perf_ctx.scmi_api->write_payload(service_id, payload_size,
+        &domain_ctx->level_table[level_index],
+        num_levels * sizeof(struct scmi_perf_level));
+    if (status != FWK_SUCCESS)
+        goto exit;
+    payload_size += num_levels * sizeof(struct scmi_perf_level);
+
     return_values = (struct scmi_perf_describe_levels_p2a) {
         .status = SCMI_SUCCESS,
         .num_levels = SCMI_PERF_NUM_LEVELS(num_levels,
-            (opp_count - level_index_max - 1))
+            (domain_ctx->level_count - level_index_max - 1))
     };
 
     status = scmi_perf_ctx.scmi_api->write_payload(service_id, 0,
@@ -327,6 +876,11 @@ static int scmi_perf_limits_set_handler(fwk_id_t service_id,
     const struct mod_scmi_perf_domain_config *domain;
     const struct scmi_perf_limits_set_a2p *parameters;
     struct scmi_perf_limits_set_p2a return_values;
+    struct scmi_perf_request *request;
+    struct scmi_perf_domain_ctx *domain_ctx;
+    struct mod_dvfs_frequency_limits *agent_limits;
+    struct mod_dvfs_frequency_limits previous_agent_limits;
+    struct mod_dvfs_frequency_limits new_limits, limits;
     uint32_t permissions;
 
     return_values.status = SCMI_GENERIC_ERROR;
@@ -358,24 +912,63 @@ static int scmi_perf_limits_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Execute the transition asynchronously */
-    status = scmi_perf_ctx.dvfs_api->set_frequency_limits(
-        FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id),
-        &((struct mod_dvfs_frequency_limits) {
-           .minimum = parameters->range_min,
-           .maximum = parameters->range_max
-          }));
-    if (status != FWK_SUCCESS) {
-        status = FWK_SUCCESS;
+    if (!is_level(parameters->domain_id, parameters->range_min) ||
+        !is_level(parameters->domain_id, parameters->range_max)) {
         return_values.status = SCMI_OUT_OF_RANGE;
 
         goto exit;
     }
 
-    return_values = (struct scmi_perf_limits_set_p2a) {
-        .status = SCMI_SUCCESS,
+    agent_limits = get_agent_limits(parameters->domain_id, agent_id);
+    previous_agent_limits = *agent_limits;
+    new_limits = (struct mod_dvfs_frequency_limits) {
+        .minimum = parameters->range_min,
+        .maximum = parameters->range_max
     };
 
+    /*
+     * The domain is limited to the intersection of the limits of all the
+     * agents. Limits that are disjoint from the limits of the other agents are
+     * rejected.
+     */
+    set_agent_limits(parameters->domain_id, agent_id, &new_limits, &limits);
+    if (limits.minimum > limits.maximum) {
+        *agent_limits = previous_agent_limits;
+        return_values.status = SCMI_OUT_OF_RANGE;
+
+        goto exit;
+    }
+
+    domain_ctx = &scmi_perf_ctx.domain_ctx_table[parameters->domain_id];
+    if ((limits.minimum == domain_ctx->limits.minimum) &&
+        (limits.maximum == domain_ctx->limits.maximum)) {
+        /* The limits of the domain are unchanged */
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_SUCCESS;
+
+        goto exit;
+    }
+
+    domain_ctx->limits = limits;
+
+    /* Execute the transition asynchronously, the response is delayed */
+    request = &scmi_perf_ctx.request_table[fwk_id_get_element_idx(service_id)];
+    *request = (struct scmi_perf_request) {
+        .message_id = SCMI_PERF_LIMITS_SET,
+        .service_id = service_id,
+        .domain_idx = parameters->domain_id,
+        .limits = limits,
+        .agent_id = agent_id,
+        .previous_agent_limits = previous_agent_limits,
+    };
+
+    return_values.status = submit_request(request);
+    if (return_values.status == SCMI_SUCCESS)
+        return FWK_SUCCESS;
+
+    *agent_limits = previous_agent_limits;
+    compute_limits(parameters->domain_id, &domain_ctx->limits);
+
 exit:
     scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
         (return_values.status == SCMI_SUCCESS) ?
@@ -429,6 +1022,7 @@ static int scmi_perf_level_set_handler(fwk_id_t service_id,
     const struct mod_scmi_perf_domain_config *domain;
     const struct scmi_perf_level_set_a2p *parameters;
     struct scmi_perf_level_set_p2a return_values;
+    struct scmi_perf_request *request;
     uint32_t permissions;
 
     return_values.status = SCMI_GENERIC_ERROR;
@@ -454,21 +1048,18 @@ static int scmi_perf_level_set_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Execute the transition synchronously */
-    status = scmi_perf_ctx.dvfs_api->set_frequency(
-        FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, parameters->domain_id),
-        parameters->performance_level);
+    /* Execute the transition asynchronously, the response is delayed */
+    request = &scmi_perf_ctx.request_table[fwk_id_get_element_idx(service_id)];
+    *request = (struct scmi_perf_request) {
+        .message_id = SCMI_PERF_LEVEL_SET,
+        .service_id = service_id,
+        .domain_idx = parameters->domain_id,
+        .level = parameters->performance_level,
+    };
 
-    if (status == FWK_E_RANGE) {
-        status = FWK_SUCCESS;
-        return_values.status = SCMI_OUT_OF_RANGE;
-    } else if (status != FWK_SUCCESS) {
-        return_values.status = SCMI_GENERIC_ERROR;
-    } else {
-        return_values = (struct scmi_perf_level_set_p2a) {
-            .status = SCMI_SUCCESS,
-        };
-    }
+    return_values.status = submit_request(request);
+    if (return_values.status == SCMI_SUCCESS)
+        return FWK_SUCCESS;
 
 exit:
     scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
@@ -516,60 +1107,258 @@ exit:
 }
 
 /*
- * SCMI module -> SCMI performance module interface
+ * Enable or disable the notifications of an agent for a domain. The
+ * PERFORMANCE_NOTIFY_LIMITS and PERFORMANCE_NOTIFY_LEVEL parameters have the
+ * same layout.
  */
-
-static int scmi_perf_get_scmi_protocol_id(fwk_id_t protocol_id,
-                                          uint8_t *scmi_protocol_id)
+static int notify_set(fwk_id_t service_id, bool *notify_table,
+                      const struct scmi_perf_notify_limits_a2p *parameters)
 {
     int status;
+    unsigned int agent_id;
+    int32_t return_value;
 
-    status = fwk_module_check_call(protocol_id);
+    return_value = SCMI_GENERIC_ERROR;
+
+    if (parameters->domain_id >= scmi_perf_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_value = SCMI_NOT_FOUND;
+
+        goto exit;
+    }
+
+    if (parameters->notify_enable & ~SCMI_PERF_NOTIFY_ENABLE_MASK) {
+        status = FWK_SUCCESS;
+        return_value = SCMI_INVALID_PARAMETERS;
+
+        goto exit;
+    }
+
+    status = scmi_perf_ctx.scmi_api->get_agent_id(service_id, &agent_id);
     if (status != FWK_SUCCESS)
-        return status;
+        goto exit;
 
-    *scmi_protocol_id = SCMI_PROTOCOL_ID_PERF;
+    notify_table[(parameters->domain_id * scmi_perf_ctx.agent_count) +
+                 (agent_id - 1)] =
+        !!(parameters->notify_enable & SCMI_PERF_NOTIFY_ENABLE_MASK);
 
-    return FWK_SUCCESS;
+    return_value = SCMI_SUCCESS;
+
+exit:
+    /* The PERFORMANCE_NOTIFY_LIMITS and LEVEL responses only hold a status */
+    scmi_perf_ctx.scmi_api->respond(service_id, &return_value,
+                                    sizeof(return_value));
+
+    return status;
 }
 
-static int scmi_perf_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
-    const uint32_t *payload, size_t payload_size, unsigned int message_id)
+static int scmi_perf_notify_limits_handler(fwk_id_t service_id,
+                                           const uint32_t *payload)
+{
+    return notify_set(service_id, scmi_perf_ctx.notify_limits_table,
+        (const struct scmi_perf_notify_limits_a2p *)payload);
+}
+
+static int scmi_perf_notify_level_handler(fwk_id_t service_id,
+                                          const uint32_t *payload)
+{
+    return notify_set(service_id, scmi_perf_ctx.notify_level_table,
+        (const struct scmi_perf_notify_limits_a2p *)payload);
+}
+
+static int scmi_perf_describe_fast_channels_handler(fwk_id_t service_id,
+                                                    const uint32_t *payload)
 {
     int status;
-    int32_t return_value;
+    unsigned int agent_id;
+    const struct mod_scmi_perf_domain_config *domain;
+    const struct scmi_perf_describe_fast_channel_a2p *parameters;
+    struct scmi_perf_describe_fast_channel_p2a return_values;
+    uint32_t permissions;
+    uint64_t chan_addr;
 
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Performance management protocol table sizes not consistent");
-    assert(payload != NULL);
+    return_values.status = SCMI_GENERIC_ERROR;
 
-    status = fwk_module_check_call(protocol_id);
+    parameters = (const struct scmi_perf_describe_fast_channel_a2p *)payload;
+    if (parameters->domain_id >= scmi_perf_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+
+        goto exit;
+    }
+
+    status = scmi_perf_ctx.scmi_api->get_agent_id(service_id, &agent_id);
     if (status != FWK_SUCCESS)
-        return status;
+        goto exit;
 
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
+    domain = &(*scmi_perf_ctx.config->domains)[parameters->domain_id];
+    if (!has_fast_channels(domain)) {
+        return_values.status = SCMI_NOT_SUPPORTED;
+
+        goto exit;
     }
 
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
+    switch (parameters->message_id) {
+    case SCMI_PERF_LEVEL_SET:
+        /* Ensure the agent has permission to do this */
+        permissions = (*domain->permissions)[agent_id];
+        if (!(permissions & MOD_SCMI_PERF_PERMS_SET_LEVEL)) {
+            return_values.status = SCMI_DENIED;
+
+            goto exit;
+        }
+
+        chan_addr = domain->fast_channels_addr_ap +
+            offsetof(struct mod_scmi_perf_fast_channel, level_set);
+        break;
+
+    case SCMI_PERF_LEVEL_GET:
+        chan_addr = domain->fast_channels_addr_ap +
+            offsetof(struct mod_scmi_perf_fast_channel, level_get);
+        break;
+
+    default:
+        return_values.status = SCMI_NOT_SUPPORTED;
+
+        goto exit;
     }
 
-    return handler_table[message_id](service_id, payload);
+    /* The fast channels are polled and do not have a doorbell */
+    return_values = (struct scmi_perf_describe_fast_channel_p2a) {
+        .status = SCMI_SUCCESS,
+        .attributes = 0,
+        .rate_limit =
+            scmi_perf_ctx.config->fast_channels_rate_limit * FWK_KHZ,
+        .chan_addr_low = (uint32_t)chan_addr,
+        .chan_addr_high = (uint32_t)(chan_addr >> 32),
+        .chan_size = sizeof(uint32_t),
+    };
 
-error:
-    scmi_perf_ctx.scmi_api->respond(service_id, &return_value,
-                                    sizeof(return_value));
+exit:
+    scmi_perf_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * Fast channels
+ */
+
+#if BUILD_HAS_MOD_TIMER
+/*
+ * The alarm callback is called from within an interrupt service routine, the
+ * fast channels are processed from the event loop. A processing event still
+ * queued when the next period starts is redundant and superseded.
+ */
+static void fast_channels_alarm_callback(uintptr_t param)
+{
+    struct fwk_event event = {
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_PERF),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_PERF),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_PERF,
+                           SCMI_PERF_EVENT_IDX_FAST_CHANNELS_PROCESS),
+        .supersedes = true,
+    };
+
+    fwk_thread_put_event(&event);
+}
+#endif
+
+static void fast_channels_process(void)
+{
+    int status;
+    unsigned int domain_idx;
+    const struct mod_scmi_perf_domain_config *domain;
+    struct scmi_perf_domain_ctx *domain_ctx;
+    volatile struct mod_scmi_perf_fast_channel *fast_channel;
+    uint32_t level;
+    uint64_t start_time;
+    fwk_id_t domain_id;
+    struct mod_dvfs_opp opp;
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain = &(*scmi_perf_ctx.config->domains)[domain_idx];
+        if (!has_fast_channels(domain))
+            continue;
+
+        domain_ctx = &scmi_perf_ctx.domain_ctx_table[domain_idx];
+        fast_channel = (volatile struct mod_scmi_perf_fast_channel *)
+            domain->fast_channels_addr_scp;
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+
+        /*
+         * Only a new request leads to a transition, a level out of range is
+         * ignored as there is no way to report it to the agent. The request
+         * is deferred to a later poll while message requests or a transition
+         * are in progress.
+         */
+        level = fast_channel->level_set;
+        if ((level != 0) && (level != domain_ctx->fast_channel_last_level) &&
+            fwk_list_is_empty(&domain_ctx->request_list)) {
+            start_time = get_time();
+            status = scmi_perf_ctx.dvfs_api->set_frequency(domain_id, level);
+            if (status == FWK_SUCCESS) {
+                stats_update(domain_idx, start_time);
+
+                /* The agent that wrote the fast channel is not known */
+                notify_level(domain_idx, SCMI_PLATFORM_ID);
+            }
+            if (status != FWK_E_BUSY)
+                domain_ctx->fast_channel_last_level = level;
+        }
+
+        status = scmi_perf_ctx.dvfs_api->get_current_opp(domain_id, &opp);
+        if (status == FWK_SUCCESS)
+            fast_channel->level_get = (uint32_t)opp.frequency;
+    }
+}
+
+/*
+ * SCMI module -> SCMI performance module interface
+ */
+
+static int scmi_perf_get_scmi_protocol_id(fwk_id_t protocol_id,
+                                          uint8_t *scmi_protocol_id)
+{
+    int status;
+
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_PERF;
 
     return FWK_SUCCESS;
 }
 
 static struct mod_scmi_to_protocol_api scmi_perf_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_perf_get_scmi_protocol_id,
-    .message_handler = scmi_perf_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
+};
+
+/*
+ * Notification API
+ */
+
+static void scmi_perf_notify_limits_changed(fwk_id_t domain_id)
+{
+    unsigned int domain_idx = fwk_id_get_element_idx(domain_id);
+
+    if (domain_idx >= scmi_perf_ctx.domain_count)
+        return;
+
+    /* The changes made by the platform are attributed to agent 0 */
+    notify_limits(domain_idx, 0);
+    notify_level(domain_idx, 0);
+}
+
+static const struct mod_scmi_perf_notification_api
+    scmi_perf_notification_api = {
+    .notify_limits_changed = scmi_perf_notify_limits_changed,
 };
 
 /*
@@ -579,6 +1368,8 @@ static int scmi_perf_init(fwk_id_t module_id, unsigned int element_count,
                           const void *data)
 {
     int return_val;
+    int service_count;
+    unsigned int domain_idx;
     const struct mod_scmi_perf_config *config =
         (const struct mod_scmi_perf_config *)data;
 
@@ -593,7 +1384,47 @@ static int scmi_perf_init(fwk_id_t module_id, unsigned int element_count,
     scmi_perf_ctx.config = config;
     scmi_perf_ctx.domain_count = return_val;
 
+    scmi_perf_ctx.domain_ctx_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count, sizeof(struct scmi_perf_domain_ctx));
+    if (scmi_perf_ctx.domain_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    service_count = fwk_module_get_element_count(
+        FWK_ID_MODULE(FWK_MODULE_IDX_SCMI));
+    if (service_count <= 0)
+        return FWK_E_SUPPORT;
+
+    scmi_perf_ctx.request_table = fwk_mm_calloc(
+        service_count, sizeof(struct scmi_perf_request));
+    if (scmi_perf_ctx.request_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        fwk_list_init(&scmi_perf_ctx.domain_ctx_table[domain_idx].request_list);
+
+        if (has_fast_channels(&(*config->domains)[domain_idx]))
+            scmi_perf_ctx.fast_channels = true;
+    }
+
+    /* The statistics are timestamped with a timer */
+    #if !BUILD_HAS_MOD_TIMER
+    if (config->stats_addr_scp != 0)
+        return FWK_E_SUPPORT;
+    #endif
+
+    if (!scmi_perf_ctx.fast_channels)
+        return FWK_SUCCESS;
+
+    /* The fast channels are polled with a timer alarm */
+    #if BUILD_HAS_MOD_TIMER
+    if (config->fast_channels_rate_limit == 0)
+        return FWK_E_PARAM;
+
     return FWK_SUCCESS;
+    #else
+    return FWK_E_SUPPORT;
+    #endif
 }
 
 static int scmi_perf_bind(fwk_id_t id, unsigned int round)
@@ -609,13 +1440,229 @@ static int scmi_perf_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
-    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
         FWK_ID_API(FWK_MODULE_IDX_DVFS, 0), &scmi_perf_ctx.dvfs_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    #if BUILD_HAS_MOD_TIMER
+    if (scmi_perf_ctx.config->stats_addr_scp != 0) {
+        status = fwk_module_bind(scmi_perf_ctx.config->stats_timer_id,
+            MOD_TIMER_API_ID_TIMER, &scmi_perf_ctx.timer_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    if (scmi_perf_ctx.fast_channels) {
+        return fwk_module_bind(scmi_perf_ctx.config->fast_channels_alarm_id,
+            MOD_TIMER_API_ID_ALARM, &scmi_perf_ctx.alarm_api);
+    }
+    #endif
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Build the responses to the discovery commands, their content only depends on
+ * the configuration of the domains and on the agent issuing them.
+ */
+static int discovery_init(void)
+{
+    int status;
+    unsigned int domain_idx, agent_id;
+    size_t level_idx;
+    const struct mod_scmi_perf_domain_config *domain;
+    const struct mod_dvfs_domain_config *dvfs_config;
+    struct scmi_perf_domain_ctx *domain_ctx;
+    struct scmi_perf_domain_attributes_p2a *attributes;
+    fwk_id_t domain_id;
+    struct mod_dvfs_opp opp;
+    uint16_t latency;
+    uint32_t permissions;
+
+    scmi_perf_ctx.domain_attributes_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count * scmi_perf_ctx.agent_count,
+        sizeof(struct scmi_perf_domain_attributes_p2a));
+    if (scmi_perf_ctx.domain_attributes_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain = &(*scmi_perf_ctx.config->domains)[domain_idx];
+        domain_ctx = &scmi_perf_ctx.domain_ctx_table[domain_idx];
+        domain_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_DVFS, domain_idx);
+
+        status = scmi_perf_ctx.dvfs_api->get_sustained_opp(domain_id, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        attributes = &scmi_perf_ctx.domain_attributes_table[
+            domain_idx * scmi_perf_ctx.agent_count];
+
+        for (agent_id = 1; agent_id <= scmi_perf_ctx.agent_count;
+             agent_id++, attributes++) {
+            permissions = (*domain->permissions)[agent_id];
+
+            *attributes = (struct scmi_perf_domain_attributes_p2a) {
+                .status = SCMI_SUCCESS,
+                .attributes = SCMI_PERF_DOMAIN_ATTRIBUTES(
+                    true, true,
+                    !!(permissions & MOD_SCMI_PERF_PERMS_SET_LEVEL),
+                    !!(permissions & MOD_SCMI_PERF_PERMS_SET_LIMITS),
+                    has_fast_channels(domain)
+                ),
+                .rate_limit = 0, /* Unsupported */
+                .sustained_freq = opp.frequency / FWK_KHZ,
+                .sustained_perf_level = opp.frequency,
+            };
+
+            strncpy((char *)attributes->name, fwk_module_get_name(domain_id),
+                sizeof(attributes->name) - 1);
+        }
+
+        status = scmi_perf_ctx.dvfs_api->get_opp_count(domain_id,
+            &domain_ctx->level_count);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = scmi_perf_ctx.dvfs_api->get_latency(domain_id, &latency);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        domain_ctx->level_table = fwk_mm_calloc(domain_ctx->level_count,
+                                                sizeof(struct scmi_perf_level));
+        if (domain_ctx->level_table == NULL)
+            return FWK_E_NOMEM;
+
+        for (level_idx = 0; level_idx < domain_ctx->level_count;
+             level_idx++) {
+            status = scmi_perf_ctx.dvfs_api->get_nth_opp(domain_id, level_idx,
+                                                         &opp);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            /*
+             * The operating points without a power cost keep reporting their
+             * voltage as an abstract cost.
+             */
+            domain_ctx->level_table[level_idx] = (struct scmi_perf_level) {
+                .performance_level = opp.frequency,
+                .power_cost = (opp.power != 0) ?
+                    opp.power : (uint32_t)opp.voltage,
+                .attributes = latency,
+            };
+        }
+
+        dvfs_config = fwk_module_get_data(domain_id);
+        domain_ctx->calibrated_power_costs = (dvfs_config != NULL) &&
+            fwk_id_is_type(dvfs_config->power_sensor_id, FWK_ID_TYPE_ELEMENT);
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Initially, none of the agents restricts the levels of the domains.
+ */
+static int limits_init(void)
+{
+    unsigned int domain_idx, agent_id;
+    struct scmi_perf_domain_ctx *domain_ctx;
+
+    scmi_perf_ctx.agent_limits_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count * scmi_perf_ctx.agent_count,
+        sizeof(struct mod_dvfs_frequency_limits));
+    if (scmi_perf_ctx.agent_limits_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain_ctx = &scmi_perf_ctx.domain_ctx_table[domain_idx];
+        if (domain_ctx->level_count == 0)
+            return FWK_E_DATA;
+
+        domain_ctx->limits = (struct mod_dvfs_frequency_limits) {
+            .minimum = domain_ctx->level_table[0].performance_level,
+            .maximum = domain_ctx->level_table[
+                domain_ctx->level_count - 1].performance_level,
+        };
+
+        for (agent_id = 1; agent_id <= scmi_perf_ctx.agent_count; agent_id++)
+            *get_agent_limits(domain_idx, agent_id) = domain_ctx->limits;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_perf_start(fwk_id_t id)
+{
+    int status;
+    unsigned int domain_idx;
+    const struct mod_scmi_perf_domain_config *domain;
+    volatile struct mod_scmi_perf_fast_channel *fast_channel;
+
+    status = stats_init();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = scmi_perf_ctx.scmi_api->get_agent_count(
+        &scmi_perf_ctx.agent_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    scmi_perf_ctx.notify_limits_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count * scmi_perf_ctx.agent_count, sizeof(bool));
+    if (scmi_perf_ctx.notify_limits_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_perf_ctx.notify_level_table = fwk_mm_calloc(
+        scmi_perf_ctx.domain_count * scmi_perf_ctx.agent_count, sizeof(bool));
+    if (scmi_perf_ctx.notify_level_table == NULL)
+        return FWK_E_NOMEM;
+
+    status = discovery_init();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = limits_init();
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (!scmi_perf_ctx.fast_channels)
+        return FWK_SUCCESS;
+
+    /* Clear the fast channels so that no level request is pending */
+    for (domain_idx = 0; domain_idx < scmi_perf_ctx.domain_count;
+         domain_idx++) {
+        domain = &(*scmi_perf_ctx.config->domains)[domain_idx];
+        if (!has_fast_channels(domain))
+            continue;
+
+        fast_channel = (volatile struct mod_scmi_perf_fast_channel *)
+            domain->fast_channels_addr_scp;
+        fast_channel->level_set = 0;
+        fast_channel->level_get = 0;
+    }
+
+    #if BUILD_HAS_MOD_TIMER
+    return scmi_perf_ctx.alarm_api->start(
+        scmi_perf_ctx.config->fast_channels_alarm_id,
+        scmi_perf_ctx.config->fast_channels_rate_limit,
+        MOD_TIMER_ALARM_TYPE_PERIODIC, fast_channels_alarm_callback, 0);
+    #else
+    return FWK_SUCCESS;
+    #endif
 }
 
 static int scmi_perf_process_bind_request(fwk_id_t source_id,
     fwk_id_t target_id, fwk_id_t api_id, const void **api)
 {
+    if (fwk_id_is_equal(api_id, mod_scmi_perf_api_id_notification)) {
+        *api = &scmi_perf_notification_api;
+
+        return FWK_SUCCESS;
+    }
+
     if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
         return FWK_E_ACCESS;
 
@@ -623,12 +1670,56 @@ static int scmi_perf_process_bind_request(fwk_id_t source_id,
 
     return FWK_SUCCESS;
 }
+
+static int scmi_perf_process_event(const struct fwk_event *event,
+                                   struct fwk_event *resp_event)
+{
+    const struct scmi_perf_event_params_request *params;
+    const struct mod_dvfs_event_params_set_frequency_response *resp_params;
+    struct scmi_perf_domain_ctx *domain_ctx;
+    struct fwk_slist_node *node;
+
+    /* Response of the DVFS module to a LEVEL_SET or LIMITS_SET request */
+    if (event->is_response) {
+        domain_ctx = &scmi_perf_ctx.domain_ctx_table[
+            fwk_id_get_element_idx(event->source_id)];
+
+        node = fwk_list_pop_head(&domain_ctx->request_list);
+        if (node == NULL)
+            return FWK_E_STATE;
+
+        /* Both DVFS response parameters only hold a status */
+        resp_params = (const void *)&event->params;
+        complete_request(FWK_LIST_GET(node, struct scmi_perf_request, node),
+                         resp_params->status);
+
+        return FWK_SUCCESS;
+    }
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case SCMI_PERF_EVENT_IDX_FAST_CHANNELS_PROCESS:
+        fast_channels_process();
+        return FWK_SUCCESS;
+
+    case SCMI_PERF_EVENT_IDX_REQUEST:
+        params = (const void *)&event->params;
+        process_request(&scmi_perf_ctx.request_table[params->service_idx]);
+        return FWK_SUCCESS;
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 /* SCMI Performance Management Protocol Definition */
 const struct fwk_module module_scmi_perf = {
     .name = "SCMI Performance Management Protocol",
-    .api_count = 1,
+    .api_count = MOD_SCMI_PERF_API_IDX_COUNT,
+    .event_count = SCMI_PERF_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_perf_init,
     .bind = scmi_perf_bind,
+    .start = scmi_perf_start,
     .process_bind_request = scmi_perf_process_bind_request,
+    .process_event = scmi_perf_process_event,
 };
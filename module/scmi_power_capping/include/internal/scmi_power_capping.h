@@ -0,0 +1,133 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      System Control and Management Interface (SCMI) support.
+ */
+
+#ifndef SCMI_POWER_CAPPING_H
+#define SCMI_POWER_CAPPING_H
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupSCMI_POWER_CAPPING SCMI Powercap Protocol
+ * @{
+ */
+
+#define SCMI_PROTOCOL_ID_POWER_CAPPING      UINT32_C(0x18)
+#define SCMI_PROTOCOL_VERSION_POWER_CAPPING UINT32_C(0x10000)
+
+/*
+ * Identifiers of the SCMI Powercap Protocol commands
+ */
+enum scmi_power_capping_command_id {
+    SCMI_POWER_CAPPING_DOMAIN_ATTRIBUTES = 0x003,
+    SCMI_POWER_CAPPING_CAP_GET           = 0x004,
+    SCMI_POWER_CAPPING_CAP_SET           = 0x005,
+    SCMI_POWER_CAPPING_PAI_GET           = 0x006,
+    SCMI_POWER_CAPPING_PAI_SET           = 0x007,
+    SCMI_POWER_CAPPING_DOMAIN_NAME_GET   = 0x008,
+    SCMI_POWER_CAPPING_MEASUREMENTS_GET  = 0x009,
+};
+
+/*
+ * PROTOCOL_ATTRIBUTES
+ */
+
+#define SCMI_POWER_CAPPING_PROTOCOL_ATTRIBUTES(DOMAIN_COUNT) \
+    ((DOMAIN_COUNT) & UINT32_C(0xFFFF))
+
+/*
+ * DOMAIN_ATTRIBUTES
+ */
+
+#define SCMI_POWER_CAPPING_DOMAIN_ATTRS_CAP_CONFIG_MASK  (UINT32_C(1) << 28)
+#define SCMI_POWER_CAPPING_DOMAIN_ATTRS_MONITORING_MASK  (UINT32_C(1) << 27)
+#define SCMI_POWER_CAPPING_DOMAIN_ATTRS_POWER_UNIT_MASK  (UINT32_C(1) << 25)
+
+#define SCMI_POWER_CAPPING_DOMAIN_NAME_LEN 16
+
+/* The domain has no parent */
+#define SCMI_POWER_CAPPING_DOMAIN_NO_PARENT UINT32_C(0xFFFFFFFF)
+
+struct __attribute((packed)) scmi_power_capping_domain_attributes_a2p {
+    uint32_t domain_id;
+};
+
+struct __attribute((packed)) scmi_power_capping_domain_attributes_p2a {
+    int32_t status;
+    uint32_t attributes;
+    char name[SCMI_POWER_CAPPING_DOMAIN_NAME_LEN];
+    uint32_t min_pai;
+    uint32_t max_pai;
+    uint32_t pai_step;
+    uint32_t min_power_cap;
+    uint32_t max_power_cap;
+    uint32_t power_cap_step;
+    uint32_t sustainable_power;
+    uint32_t accuracy;
+    uint32_t parent_id;
+};
+
+/*
+ * CAP_GET
+ */
+
+struct __attribute((packed)) scmi_power_capping_cap_get_a2p {
+    uint32_t domain_id;
+};
+
+struct __attribute((packed)) scmi_power_capping_cap_get_p2a {
+    int32_t status;
+    uint32_t power_cap;
+};
+
+/*
+ * CAP_SET
+ */
+
+#define SCMI_POWER_CAPPING_CAP_SET_ASYNC_FLAG_MASK    (UINT32_C(1) << 1)
+#define SCMI_POWER_CAPPING_CAP_SET_IGNORE_DRESP_MASK  (UINT32_C(1) << 0)
+
+struct __attribute((packed)) scmi_power_capping_cap_set_a2p {
+    uint32_t domain_id;
+    uint32_t flags;
+    uint32_t power_cap;
+};
+
+struct __attribute((packed)) scmi_power_capping_cap_set_p2a {
+    int32_t status;
+};
+
+/*
+ * MEASUREMENTS_GET
+ */
+
+struct __attribute((packed)) scmi_power_capping_measurements_get_a2p {
+    uint32_t domain_id;
+};
+
+struct __attribute((packed)) scmi_power_capping_measurements_get_p2a {
+    int32_t status;
+    uint32_t power;
+    uint32_t pai;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* SCMI_POWER_CAPPING_H */
@@ -0,0 +1,434 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI powercap protocol support.
+ */
+
+#include <string.h>
+#include <fwk_element.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <internal/scmi.h>
+#include <internal/scmi_power_capping.h>
+#include <mod_power_capping.h>
+#include <mod_scmi.h>
+
+struct scmi_power_capping_ctx {
+    unsigned int domain_count;
+    const struct mod_scmi_from_protocol_api *scmi_api;
+    const struct mod_power_capping_api *power_capping_api;
+};
+
+static int scmi_power_capping_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_power_capping_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_power_capping_protocol_msg_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_power_capping_domain_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_power_capping_cap_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_power_capping_cap_set_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_power_capping_measurements_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables.
+ */
+static struct scmi_power_capping_ctx scmi_power_capping_ctx;
+
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_power_capping_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_power_capping_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_power_capping_protocol_msg_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_POWER_CAPPING_DOMAIN_ATTRIBUTES] = {
+        .handler = scmi_power_capping_domain_attributes_handler,
+        .payload_size =
+            sizeof(struct scmi_power_capping_domain_attributes_a2p),
+    },
+    [SCMI_POWER_CAPPING_CAP_GET] = {
+        .handler = scmi_power_capping_cap_get_handler,
+        .payload_size = sizeof(struct scmi_power_capping_cap_get_a2p),
+    },
+    /*
+     * The budgets are a constraint of the platform, only the management
+     * agents may change them.
+     */
+    [SCMI_POWER_CAPPING_CAP_SET] = {
+        .handler = scmi_power_capping_cap_set_handler,
+        .payload_size = sizeof(struct scmi_power_capping_cap_set_a2p),
+        .denied_agent_types =
+            ~MOD_SCMI_AGENT_TYPE_MASK(SCMI_AGENT_TYPE_MANAGEMENT),
+    },
+    [SCMI_POWER_CAPPING_MEASUREMENTS_GET] = {
+        .handler = scmi_power_capping_measurements_get_handler,
+        .payload_size =
+            sizeof(struct scmi_power_capping_measurements_get_a2p),
+    },
+};
+
+/*
+ * Powercap protocol implementation
+ */
+static int scmi_power_capping_protocol_version_handler(fwk_id_t service_id,
+                                                       const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_POWER_CAPPING,
+    };
+
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+                                             sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_power_capping_protocol_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = SCMI_POWER_CAPPING_PROTOCOL_ATTRIBUTES(
+            scmi_power_capping_ctx.domain_count),
+    };
+
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+                                             sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_power_capping_protocol_msg_attributes_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    struct scmi_protocol_message_attributes_p2a return_values;
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)
+                 payload;
+
+    if ((parameters->message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[parameters->message_id].handler != NULL)) {
+        return_values = (struct scmi_protocol_message_attributes_p2a) {
+            .status = SCMI_SUCCESS,
+            /* All commands have an attributes value of 0 */
+            .attributes = 0,
+        };
+    } else
+        return_values.status = SCMI_NOT_FOUND;
+
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_power_capping_domain_attributes_handler(fwk_id_t service_id,
+                                                        const uint32_t *payload)
+{
+    const struct scmi_power_capping_domain_attributes_a2p *parameters;
+    struct scmi_power_capping_domain_attributes_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+    struct mod_power_capping_info info;
+    fwk_id_t group_id;
+    uint32_t pai;
+    int status;
+
+    parameters =
+        (const struct scmi_power_capping_domain_attributes_a2p *)payload;
+
+    if (parameters->domain_id >= scmi_power_capping_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    group_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_CAPPING,
+                              parameters->domain_id);
+
+    status = scmi_power_capping_ctx.power_capping_api->get_info(group_id,
+                                                                &info);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    /* The power averaging interval is the control period */
+    pai = info.control_period_ms * 1000;
+
+    return_values = (struct scmi_power_capping_domain_attributes_p2a) {
+        .status = SCMI_SUCCESS,
+        .attributes = SCMI_POWER_CAPPING_DOMAIN_ATTRS_CAP_CONFIG_MASK |
+                      SCMI_POWER_CAPPING_DOMAIN_ATTRS_MONITORING_MASK,
+        .min_pai = pai,
+        .max_pai = pai,
+        .pai_step = 1,
+        .min_power_cap = info.budget_min,
+        .max_power_cap = info.budget_max,
+        .power_cap_step = 1,
+        .sustainable_power = info.budget_max,
+        .accuracy = 0,
+        .parent_id = SCMI_POWER_CAPPING_DOMAIN_NO_PARENT,
+    };
+
+    /*
+     * Copy the group name into the response. Copy n-1 chars to ensure a NULL
+     * terminator at the end (the structure has been zeroed out).
+     */
+    strncpy(return_values.name, fwk_module_get_name(group_id),
+            sizeof(return_values.name) - 1);
+
+exit:
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+static int scmi_power_capping_cap_get_handler(fwk_id_t service_id,
+                                              const uint32_t *payload)
+{
+    const struct scmi_power_capping_cap_get_a2p *parameters;
+    struct scmi_power_capping_cap_get_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+    uint32_t budget;
+    int status;
+
+    parameters = (const struct scmi_power_capping_cap_get_a2p *)payload;
+
+    if (parameters->domain_id >= scmi_power_capping_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    status = scmi_power_capping_ctx.power_capping_api->get_budget(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_CAPPING, parameters->domain_id),
+        &budget);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.power_cap = budget;
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+static int scmi_power_capping_cap_set_handler(fwk_id_t service_id,
+                                              const uint32_t *payload)
+{
+    const struct scmi_power_capping_cap_set_a2p *parameters;
+    struct scmi_power_capping_cap_set_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+    int status = FWK_SUCCESS;
+
+    parameters = (const struct scmi_power_capping_cap_set_a2p *)payload;
+
+    if (parameters->domain_id >= scmi_power_capping_ctx.domain_count) {
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    if (parameters->flags & ~(SCMI_POWER_CAPPING_CAP_SET_ASYNC_FLAG_MASK |
+                              SCMI_POWER_CAPPING_CAP_SET_IGNORE_DRESP_MASK)) {
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    /* The budget is set at once, asynchronous requests are not supported */
+    if (parameters->flags & SCMI_POWER_CAPPING_CAP_SET_ASYNC_FLAG_MASK) {
+        return_values.status = SCMI_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    status = scmi_power_capping_ctx.power_capping_api->set_budget(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_CAPPING, parameters->domain_id),
+        parameters->power_cap);
+    if (status == FWK_E_RANGE) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_OUT_OF_RANGE;
+        goto exit;
+    } else if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+                                             sizeof(return_values));
+
+    return status;
+}
+
+static int scmi_power_capping_measurements_get_handler(fwk_id_t service_id,
+                                                       const uint32_t *payload)
+{
+    const struct scmi_power_capping_measurements_get_a2p *parameters;
+    struct scmi_power_capping_measurements_get_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR,
+    };
+    struct mod_power_capping_info info;
+    fwk_id_t group_id;
+    uint32_t power;
+    int status;
+
+    parameters =
+        (const struct scmi_power_capping_measurements_get_a2p *)payload;
+
+    if (parameters->domain_id >= scmi_power_capping_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    group_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_CAPPING,
+                              parameters->domain_id);
+
+    status = scmi_power_capping_ctx.power_capping_api->get_info(group_id,
+                                                                &info);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    status = scmi_power_capping_ctx.power_capping_api->get_power(group_id,
+                                                                 &power);
+    if (status == FWK_E_STATE) {
+        /* No control period has completed yet */
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_BUSY;
+        goto exit;
+    } else if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.power = power;
+    return_values.pai = info.control_period_ms * 1000;
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_power_capping_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * SCMI module -> SCMI powercap module interface
+ */
+static int scmi_power_capping_get_scmi_protocol_id(fwk_id_t protocol_id,
+                                                   uint8_t *scmi_protocol_id)
+{
+    int status;
+
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_POWER_CAPPING;
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api
+    scmi_power_capping_mod_scmi_to_protocol_api = {
+    .get_scmi_protocol_id = scmi_power_capping_get_scmi_protocol_id,
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
+};
+
+/*
+ * Framework interface
+ */
+static int scmi_power_capping_init(fwk_id_t module_id,
+                                   unsigned int element_count,
+                                   const void *unused)
+{
+    if (element_count != 0) {
+        /* This module should not have any elements */
+        return FWK_E_SUPPORT;
+    }
+
+    scmi_power_capping_ctx.domain_count = fwk_module_get_element_count(
+        FWK_ID_MODULE(FWK_MODULE_IDX_POWER_CAPPING));
+    if (scmi_power_capping_ctx.domain_count == 0)
+        return FWK_E_SUPPORT;
+
+    /* The protocol attributes hold the number of domains on 16 bits */
+    if (scmi_power_capping_ctx.domain_count > UINT16_MAX)
+        scmi_power_capping_ctx.domain_count = UINT16_MAX;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_power_capping_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if (round == 1)
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+                             FWK_ID_API(FWK_MODULE_IDX_SCMI,
+                                        MOD_SCMI_API_IDX_PROTOCOL),
+                             &scmi_power_capping_ctx.scmi_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_POWER_CAPPING),
+                           mod_power_capping_api_id_power_capping,
+                           &scmi_power_capping_ctx.power_capping_api);
+}
+
+static int scmi_power_capping_process_bind_request(fwk_id_t source_id,
+                                                   fwk_id_t target_id,
+                                                   fwk_id_t api_id,
+                                                   const void **api)
+{
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_power_capping_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_scmi_power_capping = {
+    .name = "SCMI powercap",
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_power_capping_init,
+    .bind = scmi_power_capping_bind,
+    .process_bind_request = scmi_power_capping_process_bind_request,
+};
+
+/* No elements, no module configuration data */
+struct fwk_module_config config_scmi_power_capping = { 0 };
@@ -39,6 +39,13 @@ enum scmi_pd_command_id {
     SCMI_PD_POWER_STATE_NOTIFY      = 0x06,
 };
 
+/*
+ * Identifier of the SCMI Power Domain Management Protocol notifications
+ */
+enum scmi_pd_notification_id {
+    SCMI_PD_POWER_STATE_CHANGED = 0x00,
+};
+
 /*
  * PROTOCOL_ATTRIBUTES
  */
@@ -59,6 +66,7 @@ struct __attribute((packed)) scmi_pd_power_domain_attributes_a2p {
     uint32_t domain_id;
 };
 
+#define SCMI_PD_POWER_STATE_NOTIFICATIONS (UINT32_C(1) << 31)
 #define SCMI_PD_POWER_STATE_SET_ASYNC    (1 << 30)
 #define SCMI_PD_POWER_STATE_SET_SYNC     (1 << 29)
 
@@ -106,10 +114,22 @@ struct __attribute((packed)) scmi_pd_power_state_notify_a2p {
     uint32_t notify_enable;
 };
 
+#define SCMI_PD_POWER_STATE_NOTIFY_ENABLE_MASK    (1 << 0)
+
 struct __attribute((packed)) scmi_pd_power_state_notify_p2a {
     int32_t status;
 };
 
+/*
+ * POWER_STATE_CHANGED
+ */
+
+struct __attribute((packed)) scmi_pd_power_state_changed_p2a {
+    uint32_t agent_id;
+    uint32_t domain_id;
+    uint32_t power_state;
+};
+
 /*!
  * @}
  */
@@ -15,7 +15,9 @@
 #include <fwk_id.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
+#include <fwk_mm.h>
 #include <fwk_module_idx.h>
+#include <fwk_notification.h>
 #include <internal/scmi.h>
 #include <internal/scmi_power_domain.h>
 #include <mod_log.h>
@@ -34,6 +36,24 @@ struct scmi_pd_ctx {
 
     /* Power domain module API */
     const struct mod_pd_restricted_api *pd_api;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /*
+     * Table of the POWER_STATE_CHANGED subscriptions, one entry per agent for
+     * each power domain.
+     */
+    bool *notify_enabled_table;
+
+    /* Table of the number of agents subscribed to each power domain */
+    unsigned int *subscriber_count_table;
+
+    /*
+     * Responses to the POWER_DOMAIN_ATTRIBUTES command, one entry per agent
+     * for each power domain.
+     */
+    struct scmi_pd_power_domain_attributes_p2a *attributes_table;
 };
 
 static int scmi_pd_protocol_version_handler(fwk_id_t service_id,
@@ -48,6 +68,8 @@ static int scmi_pd_power_state_set_handler(fwk_id_t service_id,
     const uint32_t *payload);
 static int scmi_pd_power_state_get_handler(fwk_id_t service_id,
     const uint32_t *payload);
+static int scmi_pd_power_state_notify_handler(fwk_id_t service_id,
+    const uint32_t *payload);
 
 /*
  * Internal variables
@@ -55,32 +77,36 @@ static int scmi_pd_power_state_get_handler(fwk_id_t service_id,
 
 static struct scmi_pd_ctx scmi_pd_ctx;
 
-static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] =
-                       scmi_pd_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] =
-                       scmi_pd_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       scmi_pd_protocol_message_attributes_handler,
-    [SCMI_PD_POWER_DOMAIN_ATTRIBUTES] =
-                       scmi_pd_power_domain_attributes_handler,
-    [SCMI_PD_POWER_STATE_SET] =
-                       scmi_pd_power_state_set_handler,
-    [SCMI_PD_POWER_STATE_GET] =
-                       scmi_pd_power_state_get_handler,
-};
-
-static unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_PD_POWER_DOMAIN_ATTRIBUTES] =
-                       sizeof(struct scmi_pd_power_domain_attributes_a2p),
-    [SCMI_PD_POWER_STATE_SET] =
-                       sizeof(struct scmi_pd_power_state_set_a2p),
-    [SCMI_PD_POWER_STATE_GET] =
-                       sizeof(struct scmi_pd_power_state_get_a2p),
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_pd_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_pd_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_pd_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_PD_POWER_DOMAIN_ATTRIBUTES] = {
+        .handler = scmi_pd_power_domain_attributes_handler,
+        .payload_size = sizeof(struct scmi_pd_power_domain_attributes_a2p),
+    },
+    [SCMI_PD_POWER_STATE_SET] = {
+        .handler = scmi_pd_power_state_set_handler,
+        .payload_size = sizeof(struct scmi_pd_power_state_set_a2p),
+    },
+    [SCMI_PD_POWER_STATE_GET] = {
+        .handler = scmi_pd_power_state_get_handler,
+        .payload_size = sizeof(struct scmi_pd_power_state_get_a2p),
+    },
+    [SCMI_PD_POWER_STATE_NOTIFY] = {
+        .handler = scmi_pd_power_state_notify_handler,
+        .payload_size = sizeof(struct scmi_pd_power_state_notify_a2p),
+    },
 };
 
 static unsigned int scmi_dev_state_id_lost_ctx_to_pd_state[] = {
@@ -172,26 +198,14 @@ static int scmi_pd_power_domain_attributes_handler(fwk_id_t service_id,
 {
     int status = FWK_SUCCESS;
     const struct scmi_pd_power_domain_attributes_a2p *parameters;
-    enum mod_pd_type pd_type;
-    unsigned int domain_idx;
-    fwk_id_t pd_id;
+    const struct scmi_pd_power_domain_attributes_p2a *return_values;
     unsigned int agent_id;
-    enum scmi_agent_type agent_type;
-    struct scmi_pd_power_domain_attributes_p2a return_values = {
-        .status = SCMI_GENERIC_ERROR,
-    };
+    int32_t return_value = SCMI_GENERIC_ERROR;
 
     parameters = (const struct scmi_pd_power_domain_attributes_a2p *)payload;
 
-    domain_idx = parameters->domain_id;
-    if (domain_idx > UINT16_MAX) {
-        return_values.status = SCMI_NOT_FOUND;
-        goto exit;
-    }
-
-    pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, domain_idx);
-    if (!fwk_module_is_valid_element_id(pd_id)) {
-        return_values.status = SCMI_NOT_FOUND;
+    if (parameters->domain_id >= scmi_pd_ctx.domain_count) {
+        return_value = SCMI_NOT_FOUND;
         goto exit;
     }
 
@@ -199,62 +213,18 @@ static int scmi_pd_power_domain_attributes_handler(fwk_id_t service_id,
     if (status != FWK_SUCCESS)
         goto exit;
 
-    status = scmi_pd_ctx.scmi_api->get_agent_type(agent_id, &agent_type);
-    if (status != FWK_SUCCESS)
-        goto exit;
+    return_values = &scmi_pd_ctx.attributes_table[
+        (parameters->domain_id * scmi_pd_ctx.agent_count) + (agent_id - 1)];
 
-    status = scmi_pd_ctx.pd_api->get_domain_type(pd_id, &pd_type);
-    if (status != FWK_SUCCESS)
-        goto exit;
+    scmi_pd_ctx.scmi_api->respond(service_id, return_values,
+        (return_values->status == SCMI_SUCCESS) ?
+        sizeof(*return_values) : sizeof(return_values->status));
 
-    switch (pd_type) {
-    case MOD_PD_TYPE_CORE:
-        /*
-         * For core power domains, the POWER_STATE_SET command is supported
-         * only asynchronously for the PSCI agent. In all other cases, reply
-         * that the command is not supported either synchronously nor
-         * asynchronously.
-         */
-        if (agent_type == SCMI_AGENT_TYPE_PSCI)
-            return_values.attributes = SCMI_PD_POWER_STATE_SET_ASYNC;
-        break;
-
-    case MOD_PD_TYPE_CLUSTER:
-        /*
-         * For cluster power domains, the POWER_STATE_SET command is supported
-         * only synchronously for the PSCI agent. In all other cases, reply
-         * that the command is not supported either synchronously nor
-         * asynchronously.
-         */
-        if (agent_type == SCMI_AGENT_TYPE_PSCI)
-            return_values.attributes = SCMI_PD_POWER_STATE_SET_SYNC;
-        break;
-
-    case MOD_PD_TYPE_DEVICE:
-    case MOD_PD_TYPE_DEVICE_DEBUG:
-        /*
-         * Support only synchronous POWER_STATE_SET for devices for any agent.
-         */
-        return_values.attributes = SCMI_PD_POWER_STATE_SET_SYNC;
-        break;
-
-    case MOD_PD_TYPE_SYSTEM:
-        return_values.status = SCMI_NOT_FOUND;
-        /* Fallthrough. */
-
-    default:
-        goto exit;
-    }
-
-    strncpy((char *)return_values.name, fwk_module_get_name(pd_id),
-            sizeof(return_values.name) - 1);
-
-    return_values.status = SCMI_SUCCESS;
+    return FWK_SUCCESS;
 
 exit:
-    scmi_pd_ctx.scmi_api->respond(service_id, &return_values,
-        (return_values.status == SCMI_SUCCESS) ?
-        sizeof(return_values) : sizeof(return_values.status));
+    scmi_pd_ctx.scmi_api->respond(service_id, &return_value,
+                                  sizeof(return_value));
 
     return status;
 }
@@ -270,8 +240,8 @@ static int scmi_pd_protocol_message_attributes_handler(
     parameters = (const struct scmi_protocol_message_attributes_a2p *)
                   payload;
 
-    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[parameters->message_id] != NULL))
+    if ((parameters->message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[parameters->message_id].handler != NULL))
         return_values.status = SCMI_SUCCESS;
 
     scmi_pd_ctx.scmi_api->respond(service_id, &return_values,
@@ -289,7 +259,7 @@ static int scmi_power_scp_set_core_state(fwk_id_t pd_id,
     status = scmi_pd_ctx.pd_api->set_composite_state_async(pd_id, false,
                                                            composite_state);
     if (status != FWK_SUCCESS) {
-        scmi_pd_ctx.log_api->log(MOD_LOG_GROUP_ERROR,
+        MOD_LOG(scmi_pd_ctx.log_api, MOD_LOG_GROUP_ERROR,
             "[SCMI:power] Failed to send core set request (error %e)\n",
             status);
     }
@@ -353,7 +323,9 @@ static int scmi_pd_power_state_set_handler(fwk_id_t service_id,
     case MOD_PD_TYPE_CORE:
         /*
          * Async/sync flag is ignored for core power domains as stated
-         * by the specification.
+         * by the specification. No response being requested, the power
+         * domain module turns a core on straight away when its cluster is
+         * already on.
          */
         status = scmi_power_scp_set_core_state(pd_id, parameters->power_state);
         if (status == FWK_E_PARAM)
@@ -440,17 +412,18 @@ static int scmi_pd_power_state_get_handler(fwk_id_t service_id,
 
     switch (pd_type) {
     case MOD_PD_TYPE_CORE:
-        status = scmi_pd_ctx.pd_api->get_composite_state(pd_id, &power_state);
+        status = scmi_pd_ctx.pd_api->get_current_composite_state(pd_id,
+                                                                 &power_state);
         break;
 
     case MOD_PD_TYPE_CLUSTER:
-        status = scmi_pd_ctx.pd_api->get_state(pd_id, &power_state);
+        status = scmi_pd_ctx.pd_api->get_current_state(pd_id, &power_state);
         break;
 
     case MOD_PD_TYPE_DEVICE:
     case MOD_PD_TYPE_DEVICE_DEBUG:
 
-        status = scmi_pd_ctx.pd_api->get_state(pd_id, &pd_power_state);
+        status = scmi_pd_ctx.pd_api->get_current_state(pd_id, &pd_power_state);
         if (status != FWK_SUCCESS)
             goto exit;
 
@@ -479,59 +452,104 @@ exit:
     return status;
 }
 
-/*
- * SCMI module -> SCMI power module interface
- */
-static int scmi_pd_get_scmi_protocol_id(fwk_id_t protocol_id,
-                                        uint8_t *scmi_protocol_id)
+static int scmi_pd_power_state_notify_handler(fwk_id_t service_id,
+                                              const uint32_t *payload)
 {
     int status;
+    const struct scmi_pd_power_state_notify_a2p *parameters;
+    unsigned int agent_id;
+    unsigned int domain_idx;
+    fwk_id_t pd_id;
+    bool *notify_enabled;
+    bool enable;
+    unsigned int *subscriber_count;
+    struct scmi_pd_power_state_notify_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR
+    };
 
-    status = fwk_module_check_call(protocol_id);
+    parameters = (const struct scmi_pd_power_state_notify_a2p *)payload;
+
+    domain_idx = parameters->domain_id;
+    if (domain_idx >= scmi_pd_ctx.domain_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    if (parameters->notify_enable & ~SCMI_PD_POWER_STATE_NOTIFY_ENABLE_MASK) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    status = scmi_pd_ctx.scmi_api->get_agent_id(service_id, &agent_id);
     if (status != FWK_SUCCESS)
-        return status;
+        goto exit;
 
-    *scmi_protocol_id = SCMI_PROTOCOL_ID_POWER_DOMAIN;
+    pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, domain_idx);
+    notify_enabled = &scmi_pd_ctx.notify_enabled_table[
+        (domain_idx * scmi_pd_ctx.agent_count) + (agent_id - 1)];
+    subscriber_count = &scmi_pd_ctx.subscriber_count_table[domain_idx];
+    enable = !!(parameters->notify_enable &
+                SCMI_PD_POWER_STATE_NOTIFY_ENABLE_MASK);
 
-    return FWK_SUCCESS;
+    if (enable == *notify_enabled) {
+        return_values.status = SCMI_SUCCESS;
+        goto exit;
+    }
+
+    /*
+     * Subscribe to the power state transitions of the domain only while at
+     * least one agent is interested in them.
+     */
+    if (enable && (*subscriber_count == 0)) {
+        status = fwk_notification_subscribe(
+            mod_pd_notification_id_power_state_transition, pd_id,
+            FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_POWER_DOMAIN));
+    } else if (!enable && (*subscriber_count == 1)) {
+        status = fwk_notification_unsubscribe(
+            mod_pd_notification_id_power_state_transition, pd_id,
+            FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_POWER_DOMAIN));
+    }
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    *notify_enabled = enable;
+    if (enable)
+        (*subscriber_count)++;
+    else
+        (*subscriber_count)--;
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_pd_ctx.scmi_api->respond(service_id, &return_values,
+                                  sizeof(return_values));
+
+    return status;
 }
 
-static int scmi_pd_message_handler(fwk_id_t protocol_id, fwk_id_t service_id,
-    const uint32_t *payload, size_t payload_size, unsigned int message_id)
+/*
+ * SCMI module -> SCMI power module interface
+ */
+static int scmi_pd_get_scmi_protocol_id(fwk_id_t protocol_id,
+                                        uint8_t *scmi_protocol_id)
 {
     int status;
-    int32_t return_value;
 
     status = fwk_module_check_call(protocol_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Power domain management protocol table sizes not consistent");
-    assert(payload != NULL);
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_POWER_DOMAIN;
 
-error:
-    scmi_pd_ctx.scmi_api->respond(service_id,
-                                  &return_value, sizeof(return_value));
     return FWK_SUCCESS;
 }
 
 static struct mod_scmi_to_protocol_api scmi_pd_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_pd_get_scmi_protocol_id,
-    .message_handler = scmi_pd_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -580,6 +598,121 @@ static int scmi_pd_bind(fwk_id_t id, unsigned int round)
         &scmi_pd_ctx.pd_api);
 }
 
+/*
+ * Build the response to the POWER_DOMAIN_ATTRIBUTES command for a power domain
+ * and an agent, it only depends on the type of the domain and of the agent.
+ */
+static int build_power_domain_attributes(unsigned int domain_idx,
+    enum scmi_agent_type agent_type,
+    struct scmi_pd_power_domain_attributes_p2a *return_values)
+{
+    int status;
+    enum mod_pd_type pd_type;
+    fwk_id_t pd_id;
+
+    *return_values = (struct scmi_pd_power_domain_attributes_p2a) {
+        .status = SCMI_NOT_FOUND,
+    };
+
+    pd_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, domain_idx);
+
+    status = scmi_pd_ctx.pd_api->get_domain_type(pd_id, &pd_type);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    switch (pd_type) {
+    case MOD_PD_TYPE_CORE:
+        /*
+         * For core power domains, the POWER_STATE_SET command is supported
+         * only asynchronously for the PSCI agent. In all other cases, reply
+         * that the command is not supported either synchronously nor
+         * asynchronously.
+         */
+        if (agent_type == SCMI_AGENT_TYPE_PSCI)
+            return_values->attributes = SCMI_PD_POWER_STATE_SET_ASYNC;
+        break;
+
+    case MOD_PD_TYPE_CLUSTER:
+        /*
+         * For cluster power domains, the POWER_STATE_SET command is supported
+         * only synchronously for the PSCI agent. In all other cases, reply
+         * that the command is not supported either synchronously nor
+         * asynchronously.
+         */
+        if (agent_type == SCMI_AGENT_TYPE_PSCI)
+            return_values->attributes = SCMI_PD_POWER_STATE_SET_SYNC;
+        break;
+
+    case MOD_PD_TYPE_DEVICE:
+    case MOD_PD_TYPE_DEVICE_DEBUG:
+        /*
+         * Support only synchronous POWER_STATE_SET for devices for any agent.
+         */
+        return_values->attributes = SCMI_PD_POWER_STATE_SET_SYNC;
+        break;
+
+    default:
+        /* The SYSTEM power domain is not exposed to the agents */
+        return FWK_SUCCESS;
+    }
+
+    return_values->attributes |= SCMI_PD_POWER_STATE_NOTIFICATIONS;
+
+    strncpy((char *)return_values->name, fwk_module_get_name(pd_id),
+            sizeof(return_values->name) - 1);
+
+    return_values->status = SCMI_SUCCESS;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_pd_start(fwk_id_t id)
+{
+    int status;
+    unsigned int agent_id, domain_idx;
+    enum scmi_agent_type agent_type;
+
+    status = scmi_pd_ctx.scmi_api->get_agent_count(&scmi_pd_ctx.agent_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    scmi_pd_ctx.notify_enabled_table = fwk_mm_calloc(
+        scmi_pd_ctx.domain_count * scmi_pd_ctx.agent_count,
+        sizeof(scmi_pd_ctx.notify_enabled_table[0]));
+    if (scmi_pd_ctx.notify_enabled_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_pd_ctx.subscriber_count_table = fwk_mm_calloc(
+        scmi_pd_ctx.domain_count,
+        sizeof(scmi_pd_ctx.subscriber_count_table[0]));
+    if (scmi_pd_ctx.subscriber_count_table == NULL)
+        return FWK_E_NOMEM;
+
+    /* The attributes of the domains are static, build the responses once */
+    scmi_pd_ctx.attributes_table = fwk_mm_calloc(
+        scmi_pd_ctx.domain_count * scmi_pd_ctx.agent_count,
+        sizeof(scmi_pd_ctx.attributes_table[0]));
+    if (scmi_pd_ctx.attributes_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (agent_id = 1; agent_id <= scmi_pd_ctx.agent_count; agent_id++) {
+        status = scmi_pd_ctx.scmi_api->get_agent_type(agent_id, &agent_type);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        for (domain_idx = 0; domain_idx < scmi_pd_ctx.domain_count;
+             domain_idx++) {
+            status = build_power_domain_attributes(domain_idx, agent_type,
+                &scmi_pd_ctx.attributes_table[
+                    (domain_idx * scmi_pd_ctx.agent_count) + (agent_id - 1)]);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_pd_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
                                         fwk_id_t api_id, const void **api)
 {
@@ -591,6 +724,66 @@ static int scmi_pd_process_bind_request(fwk_id_t source_id, fwk_id_t target_id,
     return FWK_SUCCESS;
 }
 
+static int scmi_pd_process_notification(const struct fwk_event *event,
+                                        struct fwk_event *resp_event)
+{
+    int status;
+    const struct mod_pd_power_state_transition_notification_params *params;
+    unsigned int domain_idx;
+    enum mod_pd_type pd_type;
+    uint32_t power_state;
+    unsigned int agent_idx;
+    struct scmi_pd_power_state_changed_p2a payload;
+
+    fwk_assert(fwk_id_is_equal(event->id,
+                               mod_pd_notification_id_power_state_transition));
+
+    params = (const struct mod_pd_power_state_transition_notification_params *)
+        event->params;
+
+    domain_idx = fwk_id_get_element_idx(event->source_id);
+    if (domain_idx >= scmi_pd_ctx.domain_count)
+        return FWK_E_PARAM;
+
+    status = scmi_pd_ctx.pd_api->get_domain_type(event->source_id, &pd_type);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((pd_type == MOD_PD_TYPE_DEVICE) ||
+        (pd_type == MOD_PD_TYPE_DEVICE_DEBUG)) {
+        status = pd_state_to_scmi_device_state(params->state, &power_state);
+        if (status != FWK_SUCCESS)
+            return status;
+    } else
+        power_state = params->state;
+
+    payload.domain_id = domain_idx;
+    payload.power_state = power_state;
+
+    /*
+     * The agent that caused the transition is not known, the platform is
+     * reported as its originator.
+     */
+    payload.agent_id = SCMI_PLATFORM_ID;
+
+    for (agent_idx = 0; agent_idx < scmi_pd_ctx.agent_count; agent_idx++) {
+        if (!scmi_pd_ctx.notify_enabled_table[
+                (domain_idx * scmi_pd_ctx.agent_count) + agent_idx])
+            continue;
+
+        status = scmi_pd_ctx.scmi_api->notify(agent_idx + 1,
+            SCMI_PROTOCOL_ID_POWER_DOMAIN, SCMI_PD_POWER_STATE_CHANGED,
+            &payload, sizeof(payload));
+        if (status != FWK_SUCCESS) {
+            MOD_LOG(scmi_pd_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[SCMI:power] Agent %u: POWER_STATE_CHANGED not sent (%e)\n",
+                agent_idx + 1, status);
+        }
+    }
+
+    return FWK_SUCCESS;
+}
+
 /* SCMI Power Domain Management Protocol Definition */
 const struct fwk_module module_scmi_power_domain = {
     .name = "SCMI Power Domain Management Protocol",
@@ -598,7 +791,9 @@ const struct fwk_module module_scmi_power_domain = {
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_pd_init,
     .bind = scmi_pd_bind,
+    .start = scmi_pd_start,
     .process_bind_request = scmi_pd_process_bind_request,
+    .process_notification = scmi_pd_process_notification,
 };
 
 /* No elements, no module configuration data */
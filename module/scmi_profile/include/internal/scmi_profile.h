@@ -0,0 +1,63 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Event Profiling Protocol Support
+ */
+
+#ifndef SCMI_PROFILE_H
+#define SCMI_PROFILE_H
+
+#include <stdint.h>
+#include <fwk_thread.h>
+
+#define SCMI_PROTOCOL_ID_PROFILE      UINT32_C(0x92)
+#define SCMI_PROTOCOL_VERSION_PROFILE UINT32_C(0x10000)
+
+/*
+ * Identifiers of the SCMI Event Profiling Protocol commands
+ */
+enum scmi_profile_command_id {
+    SCMI_PROFILE_QUEUE_STATS_GET = 0x3,
+    SCMI_PROFILE_PROCESSING_STATS_GET = 0x4,
+    SCMI_PROFILE_STATS_RESET = 0x5,
+};
+
+/*
+ * Protocol Attributes
+ */
+
+#define SCMI_PROFILE_PROTOCOL_ATTRIBUTES_MODULE_COUNT_POS 0
+
+#define SCMI_PROFILE_PROTOCOL_ATTRIBUTES_MODULE_COUNT_MASK \
+    (UINT32_C(0xFFFF) << SCMI_PROFILE_PROTOCOL_ATTRIBUTES_MODULE_COUNT_POS)
+
+/*
+ * Queue Stats Get and Processing Stats Get
+ */
+
+struct __attribute((packed)) scmi_profile_stats_get_a2p {
+    uint32_t module_idx;
+};
+
+struct __attribute((packed)) scmi_profile_stats_get_p2a {
+    int32_t status;
+    uint32_t count;
+    uint32_t total_low;
+    uint32_t total_high;
+    uint32_t max;
+    uint32_t histogram[FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT];
+};
+
+/*
+ * Stats Reset
+ */
+
+struct __attribute((packed)) scmi_profile_stats_reset_p2a {
+    int32_t status;
+};
+
+#endif /* SCMI_PROFILE_H */
@@ -0,0 +1,33 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Event Profiling Protocol Support.
+ */
+
+#ifndef MOD_SCMI_PROFILE_H
+#define MOD_SCMI_PROFILE_H
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSCMI_PROFILE SCMI Event Profiling Protocol
+ *
+ * \details Exposes the event profiling statistics gathered by the framework to
+ *      the agents: the queuing delay and the processing time of the events of
+ *      each module, and a command clearing them. The statistics are only
+ *      gathered when the firmware is built with event profiling support,
+ *      otherwise the commands return NOT_SUPPORTED.
+ *
+ *      The module has no configuration data.
+ *
+ * \{
+ */
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_PROFILE_H */
@@ -0,0 +1,331 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Event Profiling Protocol Support.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <internal/scmi.h>
+#include <internal/scmi_profile.h>
+#include <mod_scmi.h>
+#include <mod_scmi_profile.h>
+
+struct scmi_profile_ctx {
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* Number of modules of the firmware */
+    unsigned int module_count;
+};
+
+static int scmi_profile_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_profile_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_profile_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_profile_queue_stats_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_profile_processing_stats_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_profile_stats_reset_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables.
+ */
+static struct scmi_profile_ctx scmi_profile_ctx;
+
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_profile_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_profile_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_profile_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_PROFILE_QUEUE_STATS_GET] = {
+        .handler = scmi_profile_queue_stats_get_handler,
+        .payload_size = sizeof(struct scmi_profile_stats_get_a2p),
+    },
+    [SCMI_PROFILE_PROCESSING_STATS_GET] = {
+        .handler = scmi_profile_processing_stats_get_handler,
+        .payload_size = sizeof(struct scmi_profile_stats_get_a2p),
+    },
+    [SCMI_PROFILE_STATS_RESET] = {
+        .handler = scmi_profile_stats_reset_handler,
+    },
+};
+
+/*
+ * Static, Helper Functions
+ */
+#ifdef BUILD_HAS_EVENT_PROFILING
+static int32_t scmi_status(int status)
+{
+    switch (status) {
+    case FWK_SUCCESS:
+        return SCMI_SUCCESS;
+
+    case FWK_E_PARAM:
+        return SCMI_NOT_FOUND;
+
+    case FWK_E_INIT:
+    case FWK_E_SUPPORT:
+        return SCMI_NOT_SUPPORTED;
+
+    default:
+        return SCMI_GENERIC_ERROR;
+    }
+}
+#endif
+
+/*
+ * Fill in the response to a statistics request with the queuing delay
+ * statistics of the module when 'queue' is true, with its processing time
+ * statistics otherwise.
+ */
+static void get_stats(unsigned int module_idx, bool queue,
+                      struct scmi_profile_stats_get_p2a *return_values)
+{
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    int status;
+    unsigned int bin;
+    fwk_id_t module_id;
+    struct fwk_thread_profile_stats stats;
+
+    if (module_idx >= scmi_profile_ctx.module_count) {
+        return_values->status = SCMI_NOT_FOUND;
+        return;
+    }
+
+    module_id = FWK_ID_MODULE(module_idx);
+    if (queue)
+        status = fwk_thread_get_queue_stats(module_id, &stats);
+    else
+        status = fwk_thread_get_profile_stats(module_id, &stats);
+
+    return_values->status = scmi_status(status);
+    if (status != FWK_SUCCESS)
+        return;
+
+    return_values->count = stats.count;
+    return_values->total_low = (uint32_t)stats.total;
+    return_values->total_high = (uint32_t)(stats.total >> 32);
+    return_values->max = stats.max;
+    for (bin = 0; bin < FWK_THREAD_PROFILE_HISTOGRAM_BIN_COUNT; bin++)
+        return_values->histogram[bin] = stats.histogram[bin];
+    #else
+    return_values->status = SCMI_NOT_SUPPORTED;
+    #endif
+}
+
+static void respond_stats(fwk_id_t service_id, const uint32_t *payload,
+                          bool queue)
+{
+    const struct scmi_profile_stats_get_a2p *parameters;
+    struct scmi_profile_stats_get_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR
+    };
+
+    parameters = (const struct scmi_profile_stats_get_a2p *)payload;
+
+    get_stats(parameters->module_idx, queue, &return_values);
+
+    scmi_profile_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+}
+
+/*
+ * Protocol Version
+ */
+static int scmi_profile_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_PROFILE,
+    };
+
+    scmi_profile_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Attributes
+ */
+static int scmi_profile_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = (scmi_profile_ctx.module_count <<
+                       SCMI_PROFILE_PROTOCOL_ATTRIBUTES_MODULE_COUNT_POS) &
+                      SCMI_PROFILE_PROTOCOL_ATTRIBUTES_MODULE_COUNT_MASK,
+    };
+
+    scmi_profile_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Message Attributes
+ */
+static int scmi_profile_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    size_t response_size;
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    unsigned int message_id;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = 0,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)
+        payload;
+    message_id = parameters->message_id;
+
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL))
+        return_values.status = SCMI_NOT_FOUND;
+
+    response_size = (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status);
+
+    scmi_profile_ctx.scmi_api->respond(
+        service_id, &return_values, response_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Queue Stats Get
+ */
+static int scmi_profile_queue_stats_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    respond_stats(service_id, payload, true);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Processing Stats Get
+ */
+static int scmi_profile_processing_stats_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    respond_stats(service_id, payload, false);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Stats Reset
+ */
+static int scmi_profile_stats_reset_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_profile_stats_reset_p2a return_values = {
+        .status = SCMI_NOT_SUPPORTED
+    };
+
+    #ifdef BUILD_HAS_EVENT_PROFILING
+    return_values.status = scmi_status(fwk_thread_reset_profile_stats());
+    #endif
+
+    scmi_profile_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return FWK_SUCCESS;
+}
+
+/*
+ * SCMI module -> SCMI Event Profiling module interface
+ */
+static int scmi_profile_get_scmi_protocol_id(fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    int status;
+
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_PROFILE;
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api scmi_profile_mod_scmi_to_protocol_api = {
+    .get_scmi_protocol_id = scmi_profile_get_scmi_protocol_id,
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_profile_init(fwk_id_t module_id, unsigned int element_count,
+                             const void *data)
+{
+    while (fwk_module_is_valid_module_id(
+               FWK_ID_MODULE(scmi_profile_ctx.module_count)))
+        scmi_profile_ctx.module_count++;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_profile_bind(fwk_id_t id, unsigned int round)
+{
+    if (round == 1)
+        return FWK_SUCCESS;
+
+    /* Bind to the SCMI module, storing an API pointer for later use. */
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+        &scmi_profile_ctx.scmi_api);
+}
+
+static int scmi_profile_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    /* Only accept binding requests from the SCMI module. */
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_profile_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+/* SCMI Event Profiling Protocol Definition */
+const struct fwk_module module_scmi_profile = {
+    .name = "SCMI Event Profiling Protocol",
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_profile_init,
+    .bind = scmi_profile_bind,
+    .process_bind_request = scmi_profile_process_bind_request,
+};
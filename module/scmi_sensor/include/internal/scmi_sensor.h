@@ -28,10 +28,17 @@
  * Identifiers of the SCMI Sensor Management Protocol commands
  */
 enum scmi_sensor_command_id {
-    SCMI_SENSOR_DESCRIPTION_GET = 0x003,
-    SCMI_SENSOR_CONFIG_SET      = 0x004,
-    SCMI_SENSOR_TRIP_POINT_SET  = 0x005,
-    SCMI_SENSOR_READING_GET     = 0x006,
+    SCMI_SENSOR_DESCRIPTION_GET       = 0x003,
+    SCMI_SENSOR_TRIP_POINT_NOTIFY     = 0x004,
+    SCMI_SENSOR_TRIP_POINT_CONFIG     = 0x005,
+    SCMI_SENSOR_READING_GET           = 0x006,
+};
+
+/*
+ * Identifier of the SCMI Sensor Management Protocol notifications
+ */
+enum scmi_sensor_notification_id {
+    SCMI_SENSOR_TRIP_POINT_EVENT = 0x000,
 };
 
 /*
@@ -63,6 +70,74 @@ struct __attribute((packed)) scmi_sensor_protocol_reading_get_p2a {
     uint32_t sensor_value_high;
 };
 
+/*
+ * SENSOR_READING_COMPLETE
+ */
+
+struct __attribute((packed)) scmi_sensor_protocol_reading_complete_p2a {
+    int32_t status;
+    uint32_t sensor_id;
+    uint32_t sensor_value_low;
+    uint32_t sensor_value_high;
+};
+
+/*
+ * SENSOR_TRIP_POINT_NOTIFY
+ */
+
+#define SCMI_SENSOR_TRIP_POINT_NOTIFY_ENABLE_MASK (UINT32_C(1) << 0)
+
+struct __attribute((packed)) scmi_sensor_trip_point_notify_a2p {
+    uint32_t sensor_id;
+    uint32_t sensor_event_control;
+};
+
+struct __attribute((packed)) scmi_sensor_trip_point_notify_p2a {
+    int32_t status;
+};
+
+/*
+ * SENSOR_TRIP_POINT_CONFIG
+ */
+
+#define SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_POS  0
+#define SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_POS    4
+
+#define SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_MASK \
+    (UINT32_C(0x3) << SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_POS)
+#define SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_MASK \
+    (UINT32_C(0xFF) << SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_POS)
+
+struct __attribute((packed)) scmi_sensor_trip_point_config_a2p {
+    uint32_t sensor_id;
+    uint32_t trip_point_ev_ctrl;
+    uint32_t trip_point_val_low;
+    uint32_t trip_point_val_high;
+};
+
+struct __attribute((packed)) scmi_sensor_trip_point_config_p2a {
+    int32_t status;
+};
+
+/*
+ * SENSOR_TRIP_POINT_EVENT
+ */
+
+#define SCMI_SENSOR_TRIP_POINT_DESC_ID_POS         0
+#define SCMI_SENSOR_TRIP_POINT_DESC_DIRECTION_POS  16
+
+#define SCMI_SENSOR_TRIP_POINT_DESC(ID, RISING) \
+    ((((uint32_t)(ID) & UINT32_C(0xFF)) << \
+        SCMI_SENSOR_TRIP_POINT_DESC_ID_POS) | \
+     ((RISING) ? (UINT32_C(1) << SCMI_SENSOR_TRIP_POINT_DESC_DIRECTION_POS) : \
+        0))
+
+struct __attribute((packed)) scmi_sensor_trip_point_event_p2a {
+    uint32_t agent_id;
+    uint32_t sensor_id;
+    uint32_t trip_point_desc;
+};
+
 /*
  * SENSOR_DESCRIPTION_GET
  */
@@ -136,6 +211,9 @@ struct __attribute((packed)) scmi_sensor_protocol_reading_get_p2a {
 
 #define SCMI_SENSOR_NAME_LEN    16
 
+#define SCMI_SENSOR_DESC_ATTRS_LOW_ASYNC_READ_MASK  (UINT32_C(1) << 31)
+#define SCMI_SENSOR_DESC_ATTRS_LOW_TRIP_POINTS_MASK UINT32_C(0xFF)
+
 struct __attribute((packed)) scmi_sensor_desc {
     uint32_t sensor_id;
     uint32_t sensor_attributes_low;
@@ -0,0 +1,102 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI sensor management protocol support.
+ */
+
+#ifndef MOD_SCMI_SENSOR_H
+#define MOD_SCMI_SENSOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupSCMI_SENSOR SCMI Sensor Management Protocol
+ *
+ * \details The agents may be given a shared memory region holding the last
+ *      samples of the sensors, as reported by the PROTOCOL_ATTRIBUTES command.
+ *      The region is an array of \ref mod_scmi_sensor_shmem_entry structures
+ *      indexed by sensor identifier. The entries of the periodically sampled
+ *      sensors are refreshed after each sample, so that the agents can read
+ *      them without any message.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Entry of a sensor in the shared memory region.
+ *
+ * \details Each field is a 32-bit word. The entry is protected by a sequence
+ *      lock: \ref sequence is odd while the entry is being written. An agent
+ *      reads \ref sequence, then the value and the timestamp, and retries if
+ *      \ref sequence was odd or has changed in the meantime.
+ */
+struct mod_scmi_sensor_shmem_entry {
+    /*! Sequence number, zero until the first sample of the sensor */
+    uint32_t sequence;
+
+    /*! Reserved, zero */
+    uint32_t reserved;
+
+    /*! Sensor value, 32 least significant bits */
+    uint32_t value_low;
+
+    /*! Sensor value, 32 most significant bits */
+    uint32_t value_high;
+
+    /*! Time of the sample in microseconds, 32 least significant bits */
+    uint32_t timestamp_low;
+
+    /*! Time of the sample in microseconds, 32 most significant bits */
+    uint32_t timestamp_high;
+};
+
+/*!
+ * \brief Agent descriptor.
+ */
+struct mod_scmi_sensor_agent {
+    /*!
+     * \brief Address of the shared memory region of the agent, as seen by
+     *      the SCP. Zero if the agent has no shared memory region.
+     *
+     * \details The region holds the entries of as many sensors as fit in
+     *      \ref shmem_size, starting from sensor 0.
+     */
+    uintptr_t shmem_addr_scp;
+
+    /*! Address of the shared memory region, as seen by the agent */
+    uint64_t shmem_addr_ap;
+
+    /*! Size in bytes of the shared memory region */
+    size_t shmem_size;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_scmi_sensor_config {
+    /*! Table of agent descriptors, indexed by agent identifier */
+    const struct mod_scmi_sensor_agent *agent_table;
+
+    /*! Number of agents in \ref agent_table */
+    unsigned int agent_count;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_SCMI_SENSOR_H */
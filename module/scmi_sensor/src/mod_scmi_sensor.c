@@ -15,16 +15,79 @@
 #include <fwk_id.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
+#include <fwk_mm.h>
 #include <fwk_module_idx.h>
+#include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <internal/scmi.h>
 #include <internal/scmi_sensor.h>
 #include <mod_sensor.h>
 #include <mod_scmi.h>
+#include <mod_scmi_sensor.h>
+
+enum scmi_sensor_event_idx {
+    SCMI_SENSOR_EVENT_IDX_REQUEST,
+    SCMI_SENSOR_EVENT_IDX_COUNT,
+};
+
+/*
+ * SENSOR_READING_GET request waiting for the reading of a sensor. An agent has
+ * at most one request in progress per sensor.
+ */
+struct scmi_sensor_request {
+    /* The agent waits for the reading of the sensor */
+    bool busy;
+
+    /* The agent requested an asynchronous reading */
+    bool async;
+
+    /* Service to respond to, for synchronous readings */
+    fwk_id_t service_id;
+
+    /* Agent to send the delayed response to, for asynchronous readings */
+    unsigned int agent_id;
+
+    /* Token of the delayed response, for asynchronous readings */
+    unsigned int token;
+};
 
 struct scmi_sensor_ctx {
+    /* Module configuration, NULL if there is no shared memory region */
+    const struct mod_scmi_sensor_config *config;
+
     unsigned int sensor_count;
     const struct mod_scmi_from_protocol_api *scmi_api;
     const struct mod_sensor_api *sensor_api;
+
+    /*
+     * Table of the requests waiting for a reading, one entry per agent for
+     * each sensor.
+     */
+    struct scmi_sensor_request *request_table;
+
+    /*
+     * Table of the deferred readings in progress, one entry per sensor. The
+     * result of a reading completes all the requests waiting for it.
+     */
+    bool *reading_busy_table;
+
+    /* Number of sensors with an entry in at least one shared memory region */
+    unsigned int shmem_sensor_count;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /*
+     * Table of the SENSOR_TRIP_POINT_EVENT subscriptions, one entry per agent
+     * for each sensor.
+     */
+    bool *notify_trip_point_table;
+
+    /*
+     * Table of the subscriptions of this module to the trip point
+     * notifications of the sensors, one entry per sensor.
+     */
+    bool *trip_point_subscribed_table;
 };
 
 static int scmi_sensor_protocol_version_handler(fwk_id_t service_id,
@@ -37,34 +100,116 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
     const uint32_t *payload);
 static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
     const uint32_t *payload);
+static int scmi_sensor_trip_point_notify_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_sensor_trip_point_config_handler(fwk_id_t service_id,
+    const uint32_t *payload);
 
 /*
  * Internal variables.
  */
 static struct scmi_sensor_ctx scmi_sensor_ctx;
 
-static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] =
-                       scmi_sensor_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] =
-                       scmi_sensor_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       scmi_sensor_protocol_msg_attributes_handler,
-    [SCMI_SENSOR_DESCRIPTION_GET] =
-                       scmi_sensor_protocol_desc_get_handler,
-    [SCMI_SENSOR_READING_GET] = scmi_sensor_reading_get_handler
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_sensor_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_sensor_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_sensor_protocol_msg_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_SENSOR_DESCRIPTION_GET] = {
+        .handler = scmi_sensor_protocol_desc_get_handler,
+        .payload_size = sizeof(struct scmi_sensor_protocol_description_get_a2p),
+    },
+    [SCMI_SENSOR_TRIP_POINT_NOTIFY] = {
+        .handler = scmi_sensor_trip_point_notify_handler,
+        .payload_size = sizeof(struct scmi_sensor_trip_point_notify_a2p),
+    },
+    [SCMI_SENSOR_TRIP_POINT_CONFIG] = {
+        .handler = scmi_sensor_trip_point_config_handler,
+        .payload_size = sizeof(struct scmi_sensor_trip_point_config_a2p),
+    },
+    [SCMI_SENSOR_READING_GET] = {
+        .handler = scmi_sensor_reading_get_handler,
+        .payload_size = sizeof(struct scmi_sensor_protocol_reading_get_a2p),
+    },
 };
 
-static unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_SENSOR_DESCRIPTION_GET] =
-                       sizeof(struct scmi_sensor_protocol_description_get_a2p),
-    [SCMI_SENSOR_READING_GET] =
-                       sizeof(struct scmi_sensor_protocol_reading_get_a2p),
-};
+/*
+ * Shared memory regions
+ */
+
+/*
+ * Get the descriptor of the agent of a service if the agent has a shared
+ * memory region, NULL otherwise.
+ */
+static const struct mod_scmi_sensor_agent *get_agent(fwk_id_t service_id,
+                                                     unsigned int *agent_id)
+{
+    const struct mod_scmi_sensor_agent *agent;
+
+    if ((scmi_sensor_ctx.config == NULL) ||
+        (scmi_sensor_ctx.scmi_api->get_agent_id(service_id, agent_id) !=
+         FWK_SUCCESS) ||
+        (*agent_id >= scmi_sensor_ctx.config->agent_count))
+        return NULL;
+
+    agent = &scmi_sensor_ctx.config->agent_table[*agent_id];
+
+    return (agent->shmem_addr_scp != 0) ? agent : NULL;
+}
+
+/* Number of sensors with an entry in the shared memory region of an agent */
+static unsigned int get_shmem_sensor_count(
+    const struct mod_scmi_sensor_agent *agent)
+{
+    if (agent->shmem_addr_scp == 0)
+        return 0;
+
+    return FWK_MIN(scmi_sensor_ctx.sensor_count,
+        agent->shmem_size / sizeof(struct mod_scmi_sensor_shmem_entry));
+}
+
+/*
+ * Write a sample to the entries of a sensor. The sequence number is odd while
+ * the entries are written, the barriers order the writes as seen by the
+ * agents.
+ */
+static void shmem_update(unsigned int sensor_idx,
+    const struct mod_sensor_sample_notification_params *sample)
+{
+    unsigned int agent_id;
+    const struct mod_scmi_sensor_agent *agent;
+    volatile struct mod_scmi_sensor_shmem_entry *entry;
+
+    for (agent_id = 0; agent_id < scmi_sensor_ctx.config->agent_count;
+         agent_id++) {
+        agent = &scmi_sensor_ctx.config->agent_table[agent_id];
+        if (sensor_idx >= get_shmem_sensor_count(agent))
+            continue;
+
+        entry = (volatile struct mod_scmi_sensor_shmem_entry *)
+            agent->shmem_addr_scp + sensor_idx;
+
+        entry->sequence++;
+        __sync_synchronize();
+
+        entry->value_low = (uint32_t)sample->value;
+        entry->value_high = (uint32_t)(sample->value >> 32);
+        entry->timestamp_low = (uint32_t)sample->timestamp;
+        entry->timestamp_high = (uint32_t)(sample->timestamp >> 32);
+
+        __sync_synchronize();
+        entry->sequence++;
+    }
+}
 
 /*
  * Sensor management protocol implementation
@@ -86,12 +231,23 @@ static int scmi_sensor_protocol_version_handler(fwk_id_t service_id,
 static int scmi_sensor_protocol_attributes_handler(fwk_id_t service_id,
                                                    const uint32_t *payload)
 {
+    unsigned int agent_id;
+    const struct mod_scmi_sensor_agent *agent;
     struct scmi_sensor_protocol_attributes_p2a return_values = {
         .status = SCMI_SUCCESS,
         .attributes = scmi_sensor_ctx.sensor_count,
-        .sensor_reg_len = 0, /* Unsupported */
+        .sensor_reg_len = 0,
     };
 
+    /* The shared memory region of the agent, if any */
+    agent = get_agent(service_id, &agent_id);
+    if (agent != NULL) {
+        return_values.sensor_reg_address_low = (uint32_t)agent->shmem_addr_ap;
+        return_values.sensor_reg_address_high =
+            (uint32_t)(agent->shmem_addr_ap >> 32);
+        return_values.sensor_reg_len = (uint32_t)agent->shmem_size;
+    }
+
     scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
                                       sizeof(return_values));
 
@@ -107,8 +263,8 @@ static int scmi_sensor_protocol_msg_attributes_handler(fwk_id_t service_id,
     parameters = (const struct scmi_protocol_message_attributes_a2p *)
                  payload;
 
-    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[parameters->message_id] != NULL)) {
+    if ((parameters->message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[parameters->message_id].handler != NULL)) {
         return_values = (struct scmi_protocol_message_attributes_p2a) {
             .status = SCMI_SUCCESS,
             /* All commands have an attributes value of 0 */
@@ -139,6 +295,8 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
         .status = SCMI_GENERIC_ERROR,
     };
     fwk_id_t sensor_id;
+    uint32_t sensor_attributes_low;
+    unsigned int token;
 
     payload_size = sizeof(return_values);
 
@@ -163,6 +321,15 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
         goto exit;
     }
 
+    /*
+     * The asynchronous readings are supported only for the agents with a P2A
+     * channel to receive the delayed responses on.
+     */
+    sensor_attributes_low =
+        (scmi_sensor_ctx.scmi_api->get_delayed_response_token(service_id,
+                                                              &token) ==
+         FWK_SUCCESS) ? SCMI_SENSOR_DESC_ATTRS_LOW_ASYNC_READ_MASK : 0;
+
     num_descs = FWK_MIN(SCMI_SENSOR_DESCS_MAX(max_payload_size),
         (scmi_sensor_ctx.sensor_count - desc_index));
     desc_index_max = (desc_index + num_descs - 1);
@@ -172,7 +339,7 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
 
         desc = (struct scmi_sensor_desc) {
             .sensor_id = desc_index,
-            .sensor_attributes_low = 0, /* None supported */
+            .sensor_attributes_low = sensor_attributes_low,
         };
 
         sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, desc_index);
@@ -224,6 +391,10 @@ static int scmi_sensor_protocol_desc_get_handler(fwk_id_t service_id,
             goto exit;
         }
 
+        desc.sensor_attributes_low |=
+            FWK_MIN(sensor_info.trip_point_count,
+                    SCMI_SENSOR_DESC_ATTRS_LOW_TRIP_POINTS_MASK);
+
         desc.sensor_attributes_high =
             SCMI_SENSOR_DESC_ATTRIBUTES_HIGH(sensor_info.type,
                 sensor_info.unit_multiplier,
@@ -268,14 +439,87 @@ exit:
     return status;
 }
 
+/*
+ * Send the result of a reading to the agent that requested it. Synchronous
+ * readings are answered with the SENSOR_READING_GET response, asynchronous
+ * ones with the SENSOR_READING_COMPLETE delayed response.
+ */
+static void complete_request(const struct scmi_sensor_request *request,
+                             unsigned int sensor_idx, int status,
+                             uint64_t sensor_value)
+{
+    int32_t return_status;
+    struct scmi_sensor_protocol_reading_get_p2a return_values;
+    struct scmi_sensor_protocol_reading_complete_p2a delayed_response;
+
+    if (status == FWK_SUCCESS)
+        return_status = SCMI_SUCCESS;
+    else if (status == FWK_E_PWRSTATE) {
+        /* The sensor is currently unpowered */
+        return_status = SCMI_HARDWARE_ERROR;
+    } else if (status == FWK_E_BUSY)
+        return_status = SCMI_BUSY;
+    else
+        return_status = SCMI_GENERIC_ERROR;
+
+    if (request->async) {
+        delayed_response = (struct scmi_sensor_protocol_reading_complete_p2a) {
+            .status = return_status,
+            .sensor_id = sensor_idx,
+            .sensor_value_low = (uint32_t)sensor_value,
+            .sensor_value_high = (uint32_t)(sensor_value >> 32),
+        };
+
+        scmi_sensor_ctx.scmi_api->send_delayed_response(request->agent_id,
+            SCMI_PROTOCOL_ID_SENSOR, SCMI_SENSOR_READING_GET, request->token,
+            &delayed_response, sizeof(delayed_response));
+        return;
+    }
+
+    return_values = (struct scmi_sensor_protocol_reading_get_p2a) {
+        .status = return_status,
+        .sensor_value_low = (uint32_t)sensor_value,
+        .sensor_value_high = (uint32_t)(sensor_value >> 32),
+    };
+
+    scmi_sensor_ctx.scmi_api->respond(request->service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+}
+
+/* Complete all the requests waiting for the deferred reading of a sensor */
+static void complete_reading(unsigned int sensor_idx, int status,
+                             uint64_t sensor_value)
+{
+    unsigned int agent_idx;
+    struct scmi_sensor_request *request;
+
+    scmi_sensor_ctx.reading_busy_table[sensor_idx] = false;
+
+    request = &scmi_sensor_ctx.request_table[
+        sensor_idx * scmi_sensor_ctx.agent_count];
+    for (agent_idx = 0; agent_idx < scmi_sensor_ctx.agent_count;
+         agent_idx++, request++) {
+        if (!request->busy)
+            continue;
+
+        request->busy = false;
+        complete_request(request, sensor_idx, status, sensor_value);
+    }
+}
+
 static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
                                            const uint32_t *payload)
 {
     const struct scmi_sensor_protocol_reading_get_a2p *parameters;
     struct scmi_sensor_protocol_reading_get_p2a return_values;
-    uint64_t sensor_value;
-    uint32_t flags;
+    struct scmi_sensor_request *request;
+    struct scmi_sensor_request new_request;
+    struct fwk_event event;
     fwk_id_t sensor_id;
+    unsigned int agent_id;
+    uint64_t sensor_value = 0;
+    bool async;
     int status;
 
     parameters = (const struct scmi_sensor_protocol_reading_get_a2p *)payload;
@@ -288,98 +532,288 @@ static int scmi_sensor_reading_get_handler(fwk_id_t service_id,
         goto exit;
     }
 
-    /* Reject asynchronous read requests for now */
-    flags = parameters->flags;
-    if (flags & SCMI_SENSOR_PROTOCOL_READING_GET_ASYNC_FLAG_MASK) {
-        return_values.status = SCMI_NOT_SUPPORTED;
+    if (parameters->flags & ~SCMI_SENSOR_PROTOCOL_READING_GET_ASYNC_FLAG_MASK) {
         status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
         goto exit;
     }
 
-    sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR,
-                               parameters->sensor_id);
+    status = scmi_sensor_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto exit;
 
-    status = scmi_sensor_ctx.sensor_api->get_value(sensor_id, &sensor_value);
-    if (status == FWK_SUCCESS) {
-        return_values = (struct scmi_sensor_protocol_reading_get_p2a) {
-            .status = SCMI_SUCCESS,
-            .sensor_value_low = (uint32_t)sensor_value,
-            .sensor_value_high = (uint32_t)(sensor_value >> 32),
-        };
-    } else if (status == FWK_E_PWRSTATE) {
-        /* The sensor is currently unpowered */
+    if ((agent_id == 0) || (agent_id > scmi_sensor_ctx.agent_count)) {
+        status = FWK_E_PARAM;
+        goto exit;
+    }
+
+    request = &scmi_sensor_ctx.request_table[
+        (parameters->sensor_id * scmi_sensor_ctx.agent_count) +
+        (agent_id - 1)];
+    if (request->busy) {
         status = FWK_SUCCESS;
-        return_values.status = SCMI_HARDWARE_ERROR;
-    } else {
-        /* Unable to read sensor */
-        assert(false);
+        return_values.status = SCMI_BUSY;
+        goto exit;
+    }
+
+    async = !!(parameters->flags &
+               SCMI_SENSOR_PROTOCOL_READING_GET_ASYNC_FLAG_MASK);
+
+    new_request = (struct scmi_sensor_request) {
+        .async = async,
+        .service_id = service_id,
+        .agent_id = agent_id,
+    };
+
+    if (async) {
+        /* The agent needs a P2A channel to receive the delayed response */
+        status = scmi_sensor_ctx.scmi_api->get_delayed_response_token(
+            service_id, &new_request.token);
+        if (status == FWK_E_SUPPORT) {
+            status = FWK_SUCCESS;
+            return_values.status = SCMI_NOT_SUPPORTED;
+            goto exit;
+        } else if (status != FWK_SUCCESS)
+            goto exit;
+    }
+
+    /* A deferred reading of the sensor in progress also serves the request */
+    if (scmi_sensor_ctx.reading_busy_table[parameters->sensor_id])
+        goto wait;
+
+    /*
+     * Try to read the sensor synchronously. The group read does not defer
+     * the reading to the sensor module event handler: when the driver
+     * cannot read the sensor without blocking, the reading it starts serves
+     * the deferred reading below.
+     */
+    sensor_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, parameters->sensor_id);
+    status = scmi_sensor_ctx.sensor_api->get_values(&sensor_id, 1,
+                                                    &sensor_value);
+    if ((status != FWK_E_SUPPORT) && (status != FWK_E_BUSY)) {
+        if (async) {
+            return_values.status = SCMI_SUCCESS;
+            scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
+                sizeof(return_values.status));
+        }
+
+        complete_request(&new_request, parameters->sensor_id, status,
+                         sensor_value);
+
+        return FWK_SUCCESS;
     }
 
+    /*
+     * The reading is carried out from the event handler of this module so
+     * that the sensor module sends the pending readings to this module rather
+     * than to the SCMI service.
+     */
+    event = (struct fwk_event) {
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_SENSOR),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_SENSOR,
+                           SCMI_SENSOR_EVENT_IDX_REQUEST),
+    };
+    *(unsigned int *)event.params = parameters->sensor_id;
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    scmi_sensor_ctx.reading_busy_table[parameters->sensor_id] = true;
+
+wait:
+    *request = new_request;
+    request->busy = true;
+
+    /* The synchronous readings are responded to once complete */
+    if (!async)
+        return FWK_SUCCESS;
+
+    status = FWK_SUCCESS;
+    return_values.status = SCMI_SUCCESS;
+
 exit:
+    /* The response to an asynchronous reading only holds a status */
     scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
-        (return_values.status == SCMI_SUCCESS) ?
-        sizeof(return_values) : sizeof(return_values.status));
+        sizeof(return_values.status));
 
     return status;
 }
 
-/*
- * SCMI module -> SCMI sensor module interface
- */
-static int scmi_sensor_get_scmi_protocol_id(fwk_id_t protocol_id,
-                                            uint8_t *scmi_protocol_id)
+static int scmi_sensor_trip_point_notify_handler(fwk_id_t service_id,
+                                                 const uint32_t *payload)
 {
+    const struct scmi_sensor_trip_point_notify_a2p *parameters;
+    struct scmi_sensor_trip_point_notify_p2a return_values;
+    unsigned int agent_id;
+    bool enable;
     int status;
 
-    status = fwk_module_check_call(protocol_id);
+    parameters = (const struct scmi_sensor_trip_point_notify_a2p *)payload;
+    return_values.status = SCMI_GENERIC_ERROR;
+
+    if (parameters->sensor_id >= scmi_sensor_ctx.sensor_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    if (parameters->sensor_event_control &
+        ~SCMI_SENSOR_TRIP_POINT_NOTIFY_ENABLE_MASK) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    status = scmi_sensor_ctx.scmi_api->get_agent_id(service_id, &agent_id);
     if (status != FWK_SUCCESS)
-        return status;
+        goto exit;
 
-    *scmi_protocol_id = SCMI_PROTOCOL_ID_SENSOR;
+    enable = !!(parameters->sensor_event_control &
+                SCMI_SENSOR_TRIP_POINT_NOTIFY_ENABLE_MASK);
+
+    /* The notifications of a sensor are subscribed to on first use */
+    if (enable &&
+        !scmi_sensor_ctx.trip_point_subscribed_table[parameters->sensor_id]) {
+        status = fwk_notification_subscribe(
+            mod_sensor_notification_id_trip_point,
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, parameters->sensor_id),
+            FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_SENSOR));
+        if (status != FWK_SUCCESS)
+            goto exit;
 
-    return FWK_SUCCESS;
+        scmi_sensor_ctx.trip_point_subscribed_table[parameters->sensor_id] =
+            true;
+    }
+
+    scmi_sensor_ctx.notify_trip_point_table[
+        (parameters->sensor_id * scmi_sensor_ctx.agent_count) +
+        (agent_id - 1)] = enable;
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
+                                      sizeof(return_values));
+
+    return status;
 }
 
-static int scmi_sensor_message_handler(fwk_id_t protocol_id,
-                                       fwk_id_t service_id,
-                                       const uint32_t *payload,
-                                       size_t payload_size,
-                                       unsigned int message_id)
+static int scmi_sensor_trip_point_config_handler(fwk_id_t service_id,
+                                                 const uint32_t *payload)
 {
+    const struct scmi_sensor_trip_point_config_a2p *parameters;
+    struct scmi_sensor_trip_point_config_p2a return_values;
+    struct mod_sensor_trip_point trip_point;
+    unsigned int trip_point_idx;
     int status;
-    int32_t return_value;
 
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
+    parameters = (const struct scmi_sensor_trip_point_config_a2p *)payload;
+    return_values.status = SCMI_GENERIC_ERROR;
 
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Sensor management protocol table sizes not consistent");
-    assert(payload != NULL);
+    if (parameters->sensor_id >= scmi_sensor_ctx.sensor_count) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
 
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
+    if (parameters->trip_point_ev_ctrl &
+        ~(SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_MASK |
+          SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_MASK)) {
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
     }
 
-    if (payload_size != payload_size_table[message_id]) {
-        /* Incorrect payload size or message is not supported */
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
+    trip_point_idx =
+        (parameters->trip_point_ev_ctrl &
+         SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_MASK) >>
+        SCMI_SENSOR_TRIP_POINT_EV_CTRL_ID_POS;
+
+    /* The SCMI modes have the values of the sensor module modes */
+    trip_point = (struct mod_sensor_trip_point) {
+        .value = ((uint64_t)parameters->trip_point_val_high << 32) |
+                 parameters->trip_point_val_low,
+        .mode = (enum mod_sensor_trip_point_mode)
+            ((parameters->trip_point_ev_ctrl &
+              SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_MASK) >>
+             SCMI_SENSOR_TRIP_POINT_EV_CTRL_MODE_POS),
+    };
+
+    status = scmi_sensor_ctx.sensor_api->set_trip_point(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, parameters->sensor_id),
+        trip_point_idx, &trip_point);
+    if (status == FWK_E_PARAM) {
+        /* No such trip point */
+        status = FWK_SUCCESS;
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    } else if (status != FWK_SUCCESS)
+        goto exit;
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_sensor_ctx.scmi_api->respond(service_id, &return_values,
+                                      sizeof(return_values));
+
+    return status;
+}
+
+/*
+ * Notify the agents subscribed to the SENSOR_TRIP_POINT_EVENT notifications of
+ * a sensor of the crossing of one of its trip points.
+ */
+static void notify_trip_point(unsigned int sensor_idx,
+    const struct mod_sensor_trip_point_notification_params *params)
+{
+    unsigned int agent_idx;
+    const bool *notify_table;
+    struct scmi_sensor_trip_point_event_p2a payload;
+
+    /* The crossings are detected by the platform */
+    payload = (struct scmi_sensor_trip_point_event_p2a) {
+        .agent_id = SCMI_PLATFORM_ID,
+        .sensor_id = sensor_idx,
+        .trip_point_desc = SCMI_SENSOR_TRIP_POINT_DESC(params->trip_point_idx,
+                                                       params->rising),
+    };
+
+    notify_table = &scmi_sensor_ctx.notify_trip_point_table[
+        sensor_idx * scmi_sensor_ctx.agent_count];
+
+    /* A notification that cannot be delivered is lost, as per the protocol */
+    for (agent_idx = 0; agent_idx < scmi_sensor_ctx.agent_count;
+         agent_idx++) {
+        if (notify_table[agent_idx]) {
+            scmi_sensor_ctx.scmi_api->notify(agent_idx + 1,
+                SCMI_PROTOCOL_ID_SENSOR, SCMI_SENSOR_TRIP_POINT_EVENT,
+                &payload, sizeof(payload));
+        }
     }
+}
+
+/*
+ * SCMI module -> SCMI sensor module interface
+ */
+static int scmi_sensor_get_scmi_protocol_id(fwk_id_t protocol_id,
+                                            uint8_t *scmi_protocol_id)
+{
+    int status;
 
-    return handler_table[message_id](service_id, payload);
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_SENSOR;
 
-error:
-    scmi_sensor_ctx.scmi_api->respond(service_id, &return_value,
-                                      sizeof(return_value));
     return FWK_SUCCESS;
 }
 
 static struct mod_scmi_to_protocol_api scmi_sensor_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_sensor_get_scmi_protocol_id,
-    .message_handler = scmi_sensor_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -387,8 +821,11 @@ static struct mod_scmi_to_protocol_api scmi_sensor_mod_scmi_to_protocol_api = {
  */
 static int scmi_sensor_init(fwk_id_t module_id,
                             unsigned int element_count,
-                            const void *unused)
+                            const void *data)
 {
+    unsigned int agent_id;
+    const struct mod_scmi_sensor_config *config = data;
+
     if (element_count != 0) {
         /* This module should not have any elements */
         assert(false);
@@ -405,6 +842,22 @@ static int scmi_sensor_init(fwk_id_t module_id,
     if (scmi_sensor_ctx.sensor_count > UINT16_MAX)
         scmi_sensor_ctx.sensor_count = UINT16_MAX;
 
+    scmi_sensor_ctx.reading_busy_table = fwk_mm_calloc(
+        scmi_sensor_ctx.sensor_count, sizeof(bool));
+    if (scmi_sensor_ctx.reading_busy_table == NULL)
+        return FWK_E_NOMEM;
+
+    if ((config == NULL) || (config->agent_table == NULL))
+        return FWK_SUCCESS;
+
+    scmi_sensor_ctx.config = config;
+
+    for (agent_id = 0; agent_id < config->agent_count; agent_id++) {
+        scmi_sensor_ctx.shmem_sensor_count = FWK_MAX(
+            scmi_sensor_ctx.shmem_sensor_count,
+            get_shmem_sensor_count(&config->agent_table[agent_id]));
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -437,6 +890,56 @@ static int scmi_sensor_bind(fwk_id_t id, unsigned int round)
     return FWK_SUCCESS;
 }
 
+static int scmi_sensor_start(fwk_id_t id)
+{
+    int status;
+    unsigned int agent_id, sensor_idx;
+    const struct mod_scmi_sensor_agent *agent;
+
+    status = scmi_sensor_ctx.scmi_api->get_agent_count(
+        &scmi_sensor_ctx.agent_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    scmi_sensor_ctx.notify_trip_point_table = fwk_mm_calloc(
+        scmi_sensor_ctx.sensor_count * scmi_sensor_ctx.agent_count,
+        sizeof(bool));
+    if (scmi_sensor_ctx.notify_trip_point_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_sensor_ctx.trip_point_subscribed_table = fwk_mm_calloc(
+        scmi_sensor_ctx.sensor_count, sizeof(bool));
+    if (scmi_sensor_ctx.trip_point_subscribed_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_sensor_ctx.request_table = fwk_mm_calloc(
+        scmi_sensor_ctx.sensor_count * scmi_sensor_ctx.agent_count,
+        sizeof(struct scmi_sensor_request));
+    if (scmi_sensor_ctx.request_table == NULL)
+        return FWK_E_NOMEM;
+
+    if (scmi_sensor_ctx.shmem_sensor_count == 0)
+        return FWK_SUCCESS;
+
+    /* The entries hold no sample until the first sample of their sensor */
+    for (agent_id = 0; agent_id < scmi_sensor_ctx.config->agent_count;
+         agent_id++) {
+        agent = &scmi_sensor_ctx.config->agent_table[agent_id];
+        if (agent->shmem_addr_scp != 0)
+            memset((void *)agent->shmem_addr_scp, 0, agent->shmem_size);
+    }
+
+    for (sensor_idx = 0; sensor_idx < scmi_sensor_ctx.shmem_sensor_count;
+         sensor_idx++) {
+        status = fwk_notification_subscribe(mod_sensor_notification_id_sample,
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, sensor_idx), id);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_sensor_process_bind_request(fwk_id_t source_id,
                                             fwk_id_t target_id,
                                             fwk_id_t api_id,
@@ -450,14 +953,69 @@ static int scmi_sensor_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+static int scmi_sensor_process_event(const struct fwk_event *event,
+                                     struct fwk_event *resp_event)
+{
+    int status;
+    unsigned int sensor_idx;
+    uint64_t sensor_value = 0;
+    const struct mod_sensor_event_params *params;
+
+    /* Response of the sensor module to a pending reading */
+    if (event->is_response) {
+        params = (const struct mod_sensor_event_params *)event->params;
+        complete_reading(fwk_id_get_element_idx(event->source_id),
+                         params->status, params->value);
+
+        return FWK_SUCCESS;
+    }
+
+    if (fwk_id_get_event_idx(event->id) != SCMI_SENSOR_EVENT_IDX_REQUEST)
+        return FWK_E_PARAM;
+
+    sensor_idx = *(const unsigned int *)event->params;
+
+    status = scmi_sensor_ctx.sensor_api->get_value(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, sensor_idx), &sensor_value);
+
+    /* On FWK_PENDING, the request is completed once the sensor responds */
+    if (status != FWK_PENDING)
+        complete_reading(sensor_idx, status, sensor_value);
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_sensor_process_notification(const struct fwk_event *event,
+                                            struct fwk_event *resp_event)
+{
+    unsigned int sensor_idx = fwk_id_get_element_idx(event->source_id);
+
+    if (fwk_id_is_equal(event->id, mod_sensor_notification_id_sample)) {
+        shmem_update(sensor_idx,
+            (const struct mod_sensor_sample_notification_params *)
+                event->params);
+        return FWK_SUCCESS;
+    }
+
+    if (fwk_id_is_equal(event->id, mod_sensor_notification_id_trip_point)) {
+        notify_trip_point(sensor_idx,
+            (const struct mod_sensor_trip_point_notification_params *)
+                event->params);
+        return FWK_SUCCESS;
+    }
+
+    return FWK_E_PARAM;
+}
+
 const struct fwk_module module_scmi_sensor = {
     .name = "SCMI sensor management",
     .api_count = 1,
+    .event_count = SCMI_SENSOR_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_sensor_init,
     .bind = scmi_sensor_bind,
+    .start = scmi_sensor_start,
     .process_bind_request = scmi_sensor_process_bind_request,
+    .process_event = scmi_sensor_process_event,
+    .process_notification = scmi_sensor_process_notification,
 };
-
-/* No elements, no module configuration data */
-struct fwk_module_config config_scmi_sensor = { 0 };
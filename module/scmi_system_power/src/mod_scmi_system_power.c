@@ -41,22 +41,27 @@ static int scmi_sys_power_state_get_handler(fwk_id_t service_id,
  */
 static struct scmi_sys_power_ctx scmi_sys_power_ctx;
 
-static int (* const handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] = scmi_sys_power_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] = scmi_sys_power_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = scmi_sys_power_msg_attributes_handler,
-    [SCMI_SYS_POWER_STATE_SET] = scmi_sys_power_state_set_handler,
-    [SCMI_SYS_POWER_STATE_GET] = scmi_sys_power_state_get_handler,
-};
-
-static const unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-                       sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_SYS_POWER_STATE_SET] =
-                       sizeof(struct scmi_sys_power_state_set_a2p),
-    [SCMI_SYS_POWER_STATE_GET] = 0,
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_sys_power_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_sys_power_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_sys_power_msg_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_SYS_POWER_STATE_SET] = {
+        .handler = scmi_sys_power_state_set_handler,
+        .payload_size = sizeof(struct scmi_sys_power_state_set_a2p),
+    },
+    [SCMI_SYS_POWER_STATE_GET] = {
+        .handler = scmi_sys_power_state_get_handler,
+    },
 };
 
 static enum mod_pd_system_shutdown system_state2system_shutdown[] = {
@@ -70,7 +75,7 @@ static int system_state_get(enum scmi_system_state *system_state)
     int status;
     unsigned int state;
 
-    status = scmi_sys_power_ctx.pd_api->get_state(
+    status = scmi_sys_power_ctx.pd_api->get_current_state(
         scmi_sys_power_ctx.system_power_domain_id, &state);
     if (status != FWK_SUCCESS)
         return status;
@@ -136,8 +141,8 @@ static int scmi_sys_power_msg_attributes_handler(fwk_id_t service_id,
     parameters = (const struct scmi_protocol_message_attributes_a2p*)payload;
     message_id = parameters->message_id;
 
-    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
-        (handler_table[message_id] == NULL)) {
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL)) {
 
         return_values.status = SCMI_NOT_FOUND;
         goto exit;
@@ -337,46 +342,10 @@ static int scmi_sys_power_get_scmi_protocol_id(fwk_id_t protocol_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_sys_power_handler(fwk_id_t protocol_id,
-                                  fwk_id_t service_id,
-                                  const uint32_t *payload,
-                                  size_t payload_size,
-                                  unsigned int message_id)
-{
-    int status;
-    int32_t return_value;
-
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-                  FWK_ARRAY_SIZE(payload_size_table),
-                  "[SCMI] System power protocol table sizes not consistent");
-
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
-    assert(payload != NULL);
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        /* Incorrect payload size or message is not supported */
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
-
-error:
-    scmi_sys_power_ctx.scmi_api->respond(service_id, &return_value,
-                                         sizeof(return_value));
-    return FWK_SUCCESS;
-}
-
 static struct mod_scmi_to_protocol_api scmi_sys_power_mod_scmi_to_protocol = {
     .get_scmi_protocol_id = scmi_sys_power_get_scmi_protocol_id,
-    .message_handler = scmi_sys_power_handler,
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Time Synchronization Protocol Support
+ */
+
+#ifndef SCMI_TIMESYNC_H
+#define SCMI_TIMESYNC_H
+
+#include <stdint.h>
+
+#define SCMI_PROTOCOL_ID_TIMESYNC      UINT32_C(0x91)
+#define SCMI_PROTOCOL_VERSION_TIMESYNC UINT32_C(0x10000)
+
+/*
+ * Identifiers of the SCMI Time Synchronization Protocol commands
+ */
+enum scmi_timesync_command_id {
+    SCMI_TIMESYNC_PAGE_GET = 0x3,
+    SCMI_TIMESYNC_COUNTER_OFFSET_SET = 0x4,
+};
+
+/*
+ * Protocol Attributes
+ */
+
+#define SCMI_TIMESYNC_PROTOCOL_ATTRIBUTES_PAGE_COUNT_POS 0
+
+#define SCMI_TIMESYNC_PROTOCOL_ATTRIBUTES_PAGE_COUNT_MASK \
+    (UINT32_C(0xFFFF) << SCMI_TIMESYNC_PROTOCOL_ATTRIBUTES_PAGE_COUNT_POS)
+
+/*
+ * Page Get
+ */
+
+struct __attribute((packed)) scmi_timesync_page_get_p2a {
+    int32_t status;
+    uint32_t page_address_low;
+    uint32_t page_address_high;
+    uint32_t page_size;
+};
+
+/*
+ * Counter Offset Set
+ */
+
+struct __attribute((packed)) scmi_timesync_counter_offset_set_a2p {
+    uint32_t offset_low;
+    uint32_t offset_high;
+};
+
+struct __attribute((packed)) scmi_timesync_counter_offset_set_p2a {
+    int32_t status;
+};
+
+#endif /* SCMI_TIMESYNC_H */
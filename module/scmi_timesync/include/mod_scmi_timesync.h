@@ -0,0 +1,106 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      SCMI Time Synchronization Protocol Support.
+ */
+
+#ifndef MOD_SCMI_TIMESYNC_H
+#define MOD_SCMI_TIMESYNC_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSCMI_TIMESYNC SCMI Time Synchronization Protocol
+ * \{
+ */
+
+/*!
+ * \brief Time synchronization page.
+ *
+ * \details Page shared with an agent, relating the SCP time to the counter of
+ *      the agent. The counter value of the agent at the SCP time \c t, in
+ *      microseconds, is:
+ *
+ *      agent_counter + ((t - scp_time) * rate) / 1000000
+ *
+ *      The page is updated by the SCP while the agent reads it. The agent reads
+ *      the sequence count, which is odd while an update is in progress, then
+ *      the other fields and finally the sequence count again. The fields are
+ *      consistent if the two sequence counts are equal and even.
+ */
+struct mod_scmi_timesync_page {
+    /*! Sequence count, odd while the page is being updated */
+    FWK_RW uint32_t sequence;
+
+    /*! Nominal frequency of the counter of the agent, in Hertz */
+    FWK_RW uint32_t frequency;
+
+    /*!
+     * \brief Rate of the counter of the agent, in ticks per second of SCP
+     *      time, as measured between the two last synchronization points.
+     */
+    FWK_RW uint32_t rate;
+
+    /*! Reserved, zero */
+    FWK_RW uint32_t reserved;
+
+    /*! SCP time at the synchronization point, in microseconds */
+    FWK_RW uint64_t scp_time;
+
+    /*! Counter value of the agent at the synchronization point */
+    FWK_RW uint64_t agent_counter;
+};
+
+/*!
+ * \brief Agent descriptor.
+ *
+ * \details Describes the time synchronization page of an agent. The counter
+ *      of an agent is the system counter minus the counter offset of the
+ *      agent, zero until the agent sets it.
+ */
+struct mod_scmi_timesync_agent_config {
+    /*! Identifier of the SCMI agent */
+    unsigned int agent_id;
+
+    /*! Address of the page in the address space of the SCP */
+    uintptr_t page;
+
+    /*! Address of the page in the address space of the agent */
+    uint64_t agent_page_address;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_scmi_timesync_config {
+    /*!
+     * \brief Identifier of the alarm triggering the synchronization points.
+     *      The timer of the alarm is the SCP time base.
+     */
+    fwk_id_t alarm_id;
+
+    /*! Time between two synchronization points, in milliseconds */
+    unsigned int period_ms;
+
+    /*!
+     * \brief Address of a counter frame (CNTBase) of the system counter of the
+     *      agents, readable by the SCP.
+     */
+    uintptr_t system_counter;
+
+    /*! Frequency of the system counter, in Hertz */
+    uint32_t system_counter_frequency;
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SCMI_TIMESYNC_H */
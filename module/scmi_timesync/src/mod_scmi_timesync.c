@@ -0,0 +1,509 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Time Synchronization Protocol Support.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <internal/scmi.h>
+#include <internal/scmi_timesync.h>
+#include <mod_scmi.h>
+#include <mod_scmi_timesync.h>
+#include <mod_timer.h>
+
+#define MICROSECONDS_PER_SECOND UINT64_C(1000000)
+
+/* Physical count registers of a counter frame (CNTBase) */
+struct cntbase_count_reg {
+    FWK_R uint32_t PCTL;
+    FWK_R uint32_t PCTH;
+};
+
+struct scmi_timesync_agent_ctx {
+    /* Agent configuration */
+    const struct mod_scmi_timesync_agent_config *config;
+
+    /* Offset of the counter of the agent from the system counter */
+    uint64_t counter_offset;
+};
+
+struct scmi_timesync_ctx {
+    /* Module Configuration */
+    const struct mod_scmi_timesync_config *config;
+
+    /* SCMI module API */
+    const struct mod_scmi_from_protocol_api *scmi_api;
+
+    /* Timer API of the SCP time base */
+    const struct mod_timer_api *timer_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Identifier of the timer of the SCP time base */
+    fwk_id_t timer_id;
+
+    /* Table of agent contexts */
+    struct scmi_timesync_agent_ctx *agent_ctx_table;
+
+    /* Number of agents with a time synchronization page */
+    unsigned int agent_count;
+
+    /* Flag indicating if a synchronization point has been sampled */
+    bool synchronized;
+
+    /* SCP time at the last synchronization point, in microseconds */
+    uint64_t scp_time;
+
+    /* System counter value at the last synchronization point */
+    uint64_t system_counter;
+
+    /* Measured rate of the system counter, in ticks per second of SCP time */
+    uint32_t rate;
+};
+
+static int scmi_timesync_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_timesync_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_timesync_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload);
+static int scmi_timesync_page_get_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_timesync_counter_offset_set_handler(fwk_id_t service_id,
+    const uint32_t *payload);
+
+/*
+ * Internal variables.
+ */
+static struct scmi_timesync_ctx scmi_timesync_ctx;
+
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_timesync_protocol_version_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_timesync_protocol_attributes_handler,
+        .isr_safe = true,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_timesync_protocol_message_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+        .isr_safe = true,
+    },
+    [SCMI_TIMESYNC_PAGE_GET] = {
+        .handler = scmi_timesync_page_get_handler,
+    },
+    [SCMI_TIMESYNC_COUNTER_OFFSET_SET] = {
+        .handler = scmi_timesync_counter_offset_set_handler,
+        .payload_size = sizeof(struct scmi_timesync_counter_offset_set_a2p),
+    },
+};
+
+/*
+ * Static, Helper Functions
+ */
+static uint64_t read_system_counter(void)
+{
+    const struct cntbase_count_reg *reg = (const struct cntbase_count_reg *)
+        scmi_timesync_ctx.config->system_counter;
+    uint32_t counter_low, counter_high;
+
+    /* Read the upper half again in case the lower half wrapped around */
+    do {
+        counter_high = reg->PCTH;
+        counter_low = reg->PCTL;
+    } while (counter_high != reg->PCTH);
+
+    return ((uint64_t)counter_high << 32) | counter_low;
+}
+
+static struct scmi_timesync_agent_ctx *get_agent_ctx(unsigned int agent_id)
+{
+    unsigned int agent_idx;
+    struct scmi_timesync_agent_ctx *agent_ctx;
+
+    for (agent_idx = 0; agent_idx < scmi_timesync_ctx.agent_count;
+         agent_idx++) {
+        agent_ctx = &scmi_timesync_ctx.agent_ctx_table[agent_idx];
+        if (agent_ctx->config->agent_id == agent_id)
+            return agent_ctx;
+    }
+
+    return NULL;
+}
+
+/*
+ * Write the last synchronization point to the page of an agent. The page is
+ * updated with the interrupts disabled as both the alarm and the agent
+ * messages update it.
+ */
+static void publish(struct scmi_timesync_agent_ctx *agent_ctx)
+{
+    struct mod_scmi_timesync_page *page =
+        (struct mod_scmi_timesync_page *)agent_ctx->config->page;
+
+    if (!scmi_timesync_ctx.synchronized)
+        return;
+
+    fwk_interrupt_global_disable();
+
+    page->sequence++;
+
+    page->frequency = scmi_timesync_ctx.config->system_counter_frequency;
+    page->rate = scmi_timesync_ctx.rate;
+    page->reserved = 0;
+    page->scp_time = scmi_timesync_ctx.scp_time;
+    page->agent_counter = scmi_timesync_ctx.system_counter -
+                          agent_ctx->counter_offset;
+
+    page->sequence++;
+
+    fwk_interrupt_global_enable();
+}
+
+/*
+ * Sample a synchronization point and publish it to the agents.
+ *
+ * The system counter is read before and after the SCP time, the value of the
+ * system counter at the synchronization point being the middle of the two
+ * reads.
+ */
+static void synchronize(uintptr_t param)
+{
+    int status;
+    unsigned int agent_idx;
+    uint64_t counter_before, counter_after, counter;
+    uint64_t scp_time, elapsed_time;
+
+    fwk_interrupt_global_disable();
+
+    counter_before = read_system_counter();
+    status = scmi_timesync_ctx.timer_api->get_time(scmi_timesync_ctx.timer_id,
+                                                   &scp_time);
+    counter_after = read_system_counter();
+
+    fwk_interrupt_global_enable();
+
+    if (status != FWK_SUCCESS)
+        return;
+
+    counter = counter_before + ((counter_after - counter_before) / 2);
+
+    /*
+     * The rate is measured between the two last synchronization points to
+     * compensate for the drift between the clocks of the SCP time base and of
+     * the system counter.
+     */
+    if (scmi_timesync_ctx.synchronized &&
+        (scp_time > scmi_timesync_ctx.scp_time) &&
+        (counter > scmi_timesync_ctx.system_counter)) {
+        elapsed_time = scp_time - scmi_timesync_ctx.scp_time;
+        scmi_timesync_ctx.rate = (uint32_t)(
+            ((counter - scmi_timesync_ctx.system_counter) *
+             MICROSECONDS_PER_SECOND) / elapsed_time);
+    }
+
+    scmi_timesync_ctx.scp_time = scp_time;
+    scmi_timesync_ctx.system_counter = counter;
+    scmi_timesync_ctx.synchronized = true;
+
+    for (agent_idx = 0; agent_idx < scmi_timesync_ctx.agent_count; agent_idx++)
+        publish(&scmi_timesync_ctx.agent_ctx_table[agent_idx]);
+}
+
+/*
+ * Protocol Version
+ */
+static int scmi_timesync_protocol_version_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_version_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .version = SCMI_PROTOCOL_VERSION_TIMESYNC,
+    };
+
+    scmi_timesync_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Attributes
+ */
+static int scmi_timesync_protocol_attributes_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_protocol_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = (scmi_timesync_ctx.agent_count <<
+                       SCMI_TIMESYNC_PROTOCOL_ATTRIBUTES_PAGE_COUNT_POS) &
+                      SCMI_TIMESYNC_PROTOCOL_ATTRIBUTES_PAGE_COUNT_MASK,
+    };
+
+    scmi_timesync_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return FWK_SUCCESS;
+}
+
+/*
+ * Protocol Message Attributes
+ */
+static int scmi_timesync_protocol_message_attributes_handler(
+    fwk_id_t service_id, const uint32_t *payload)
+{
+    size_t response_size;
+    const struct scmi_protocol_message_attributes_a2p *parameters;
+    unsigned int message_id;
+    struct scmi_protocol_message_attributes_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .attributes = 0,
+    };
+
+    parameters = (const struct scmi_protocol_message_attributes_a2p *)
+        payload;
+    message_id = parameters->message_id;
+
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL))
+        return_values.status = SCMI_NOT_FOUND;
+
+    response_size = (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status);
+
+    scmi_timesync_ctx.scmi_api->respond(
+        service_id, &return_values, response_size);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Page Get
+ */
+static int scmi_timesync_page_get_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    unsigned int agent_id;
+    const struct scmi_timesync_agent_ctx *agent_ctx;
+    struct scmi_timesync_page_get_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR
+    };
+
+    status = scmi_timesync_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    agent_ctx = get_agent_ctx(agent_id);
+    if (agent_ctx == NULL) {
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    return_values.page_address_low =
+        (uint32_t)agent_ctx->config->agent_page_address;
+    return_values.page_address_high =
+        (uint32_t)(agent_ctx->config->agent_page_address >> 32);
+    return_values.page_size = sizeof(struct mod_scmi_timesync_page);
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_timesync_ctx.scmi_api->respond(service_id, &return_values,
+        (return_values.status == SCMI_SUCCESS) ?
+        sizeof(return_values) : sizeof(return_values.status));
+
+    return status;
+}
+
+/*
+ * Counter Offset Set
+ */
+static int scmi_timesync_counter_offset_set_handler(fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    int status;
+    unsigned int agent_id;
+    const struct scmi_timesync_counter_offset_set_a2p *parameters;
+    struct scmi_timesync_agent_ctx *agent_ctx;
+    struct scmi_timesync_counter_offset_set_p2a return_values = {
+        .status = SCMI_GENERIC_ERROR
+    };
+
+    parameters = (const struct scmi_timesync_counter_offset_set_a2p *)payload;
+
+    status = scmi_timesync_ctx.scmi_api->get_agent_id(service_id, &agent_id);
+    if (status != FWK_SUCCESS)
+        goto exit;
+
+    agent_ctx = get_agent_ctx(agent_id);
+    if (agent_ctx == NULL) {
+        return_values.status = SCMI_NOT_FOUND;
+        goto exit;
+    }
+
+    agent_ctx->counter_offset = ((uint64_t)parameters->offset_high << 32) |
+                                parameters->offset_low;
+
+    /* The page of the agent reflects the new offset right away */
+    publish(agent_ctx);
+
+    return_values.status = SCMI_SUCCESS;
+
+exit:
+    scmi_timesync_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+    return status;
+}
+
+/*
+ * SCMI module -> SCMI Time Synchronization module interface
+ */
+static int scmi_timesync_get_scmi_protocol_id(fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    int status;
+
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_TIMESYNC;
+
+    return FWK_SUCCESS;
+}
+
+static struct mod_scmi_to_protocol_api
+    scmi_timesync_mod_scmi_to_protocol_api = {
+    .get_scmi_protocol_id = scmi_timesync_get_scmi_protocol_id,
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_timesync_init(fwk_id_t module_id, unsigned int element_count,
+                              const void *data)
+{
+    const struct mod_scmi_timesync_config *config =
+        (const struct mod_scmi_timesync_config *)data;
+
+    if (config == NULL)
+        return FWK_E_PARAM;
+    if (!fwk_module_is_valid_sub_element_id(config->alarm_id))
+        return FWK_E_PARAM;
+    if (config->system_counter == 0)
+        return FWK_E_PARAM;
+    if (config->system_counter_frequency == 0)
+        return FWK_E_PARAM;
+
+    if (element_count > 0) {
+        scmi_timesync_ctx.agent_ctx_table = fwk_mm_calloc(element_count,
+            sizeof(struct scmi_timesync_agent_ctx));
+        if (scmi_timesync_ctx.agent_ctx_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
+    scmi_timesync_ctx.config = config;
+    scmi_timesync_ctx.agent_count = element_count;
+    scmi_timesync_ctx.timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+        fwk_id_get_element_idx(config->alarm_id));
+    scmi_timesync_ctx.rate = config->system_counter_frequency;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_timesync_agent_init(fwk_id_t element_id,
+                                    unsigned int sub_element_count,
+                                    const void *data)
+{
+    const struct mod_scmi_timesync_agent_config *config =
+        (const struct mod_scmi_timesync_agent_config *)data;
+
+    if ((config == NULL) || (config->page == 0))
+        return FWK_E_DATA;
+
+    scmi_timesync_ctx.agent_ctx_table[fwk_id_get_element_idx(element_id)]
+        .config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_timesync_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if ((round == 1) || !fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    /* Bind to the SCMI module, storing an API pointer for later use. */
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI),
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_PROTOCOL),
+        &scmi_timesync_ctx.scmi_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(scmi_timesync_ctx.timer_id,
+        MOD_TIMER_API_ID_TIMER, &scmi_timesync_ctx.timer_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return fwk_module_bind(scmi_timesync_ctx.config->alarm_id,
+        MOD_TIMER_API_ID_ALARM, &scmi_timesync_ctx.alarm_api);
+}
+
+static int scmi_timesync_start(fwk_id_t id)
+{
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    /* Publish a first synchronization point before the agents start */
+    synchronize(0);
+
+    if (scmi_timesync_ctx.config->period_ms == 0)
+        return FWK_SUCCESS;
+
+    return scmi_timesync_ctx.alarm_api->start(
+        scmi_timesync_ctx.config->alarm_id,
+        scmi_timesync_ctx.config->period_ms, MOD_TIMER_ALARM_TYPE_PERIODIC,
+        synchronize, 0);
+}
+
+static int scmi_timesync_process_bind_request(fwk_id_t source_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    /* Only accept binding requests from the SCMI module. */
+    if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
+        return FWK_E_ACCESS;
+
+    *api = &scmi_timesync_mod_scmi_to_protocol_api;
+
+    return FWK_SUCCESS;
+}
+
+/* SCMI Time Synchronization Protocol Definition */
+const struct fwk_module module_scmi_timesync = {
+    .name = "SCMI Time Synchronization Protocol",
+    .api_count = 1,
+    .type = FWK_MODULE_TYPE_PROTOCOL,
+    .init = scmi_timesync_init,
+    .element_init = scmi_timesync_agent_init,
+    .bind = scmi_timesync_bind,
+    .start = scmi_timesync_start,
+    .process_bind_request = scmi_timesync_process_bind_request,
+};
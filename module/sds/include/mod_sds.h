@@ -71,6 +71,17 @@ struct mod_sds_structure_desc {
     const void *payload;
     /*! Set the valid flag in the structure if true. */
     bool finalize;
+
+    /*!
+     * \brief Watch the structure for updates by the application processor
+     *      firmware.
+     *
+     * \details When true, the content of the structure is checked whenever
+     *      the doorbell of the region rings or the polling alarm of the region
+     *      triggers. A change of the content is reported by the
+     *      \ref mod_sds_notification_id_structure_updated notification.
+     */
+    bool watch;
 };
 
 /*!
@@ -94,6 +105,33 @@ struct mod_sds_config {
     /*! Identifier of the clock that this module depends on */
     fwk_id_t clock_id;
 #endif
+
+    /*!
+     * \brief Identifier of the doorbell the application processor firmware
+     *      rings once it has updated structures of the region.
+     *
+     * \details A sub-element of a doorbell driver compatible with the SMT
+     *      drivers, such as an MHU slot. The driver binds back to the
+     *      \ref mod_smt_driver_input_api of the module to signal the doorbell.
+     *      The region has no doorbell if the identifier is not a sub-element
+     *      identifier, or in firmware without the SMT module.
+     */
+    fwk_id_t doorbell_id;
+
+    /*! Identifier of the API of the doorbell driver */
+    fwk_id_t doorbell_api_id;
+
+    /*!
+     * \brief Sub-element identifier of the alarm polling the watched
+     *      structures.
+     *
+     * \details The watched structures are not polled if the identifier is not
+     *      a sub-element identifier, or in firmware without the timer module.
+     */
+    fwk_id_t poll_alarm_id;
+
+    /*! Period of the polling of the watched structures in milliseconds */
+    unsigned int poll_period_ms;
 };
 
 /*!
@@ -103,6 +141,9 @@ enum mod_sds_notification_idx {
     /*! The SDS region has been initialized */
     MOD_SDS_NOTIFICATION_IDX_INITIALIZED,
 
+    /*! A watched structure has been updated */
+    MOD_SDS_NOTIFICATION_IDX_STRUCTURE_UPDATED,
+
     /*! Number of defined notifications */
     MOD_SDS_NOTIFICATION_IDX_COUNT
 };
@@ -116,6 +157,27 @@ static const fwk_id_t mod_sds_notification_id_initialized =
         FWK_MODULE_IDX_SDS,
         MOD_SDS_NOTIFICATION_IDX_INITIALIZED);
 
+/*!
+ * \brief Identifier for the ::MOD_SDS_NOTIFICATION_IDX_STRUCTURE_UPDATED
+ *     notification.
+ *
+ * \details The notification is sent by the module, see
+ *      \ref mod_sds_structure_desc::watch.
+ */
+static const fwk_id_t mod_sds_notification_id_structure_updated =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_SDS,
+        MOD_SDS_NOTIFICATION_IDX_STRUCTURE_UPDATED);
+
+/*!
+ * \brief Parameters of the ::MOD_SDS_NOTIFICATION_IDX_STRUCTURE_UPDATED
+ *     notification.
+ */
+struct mod_sds_notification_params_structure_updated {
+    /*! Identifier of the updated structure */
+    uint32_t structure_id;
+};
+
 /*!
  * \brief Module interface.
  */
@@ -197,6 +259,34 @@ struct mod_sds_api {
      * \retval FWK_E_STATE The structure has already been finalized.
      */
     int (*struct_finalize)(uint32_t structure_id);
+
+    /*!
+     * \brief Get the location of a Shared Data Structure.
+     *
+     * \details Return a pointer to the content of a Shared Data Structure and
+     *      its size, so that the caller can read several of its fields without
+     *      a lookup for each one. The structure is looked up and its header
+     *      validated once, by this call.
+     *
+     * \note The content of the structure may be written by the application
+     *      processor firmware, it must be read through the volatile pointer
+     *      and validated by the caller.
+     *
+     * \param structure_id The identifier of the Shared Data Structure.
+     *
+     * \param[out] structure Pointer to the content of the structure.
+     *
+     * \param[out] size Size, in bytes, of the content of the structure. This
+     *      may be larger than the size of the structure when it was created,
+     *      as it includes the padding of the structure.
+     *
+     * \retval FWK_SUCCESS The location of the structure was returned.
+     * \retval FWK_E_PARAM A pointer parameter was NULL.
+     * \retval FWK_E_PARAM An invalid structure identifier was provided.
+     * \retval FWK_E_DATA The header of the structure is invalid.
+     */
+    int (*struct_get)(uint32_t structure_id, const volatile void **structure,
+                      size_t *size);
 };
 
 /*!
@@ -13,14 +13,22 @@
 #include <fwk_element.h>
 #include <fwk_errno.h>
 #include <fwk_macros.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <mod_sds.h>
 
 #if BUILD_HAS_MOD_CLOCK
 #include <mod_clock.h>
 #endif
+#if BUILD_HAS_MOD_SMT
+#include <mod_smt.h>
+#endif
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 
 /* Arbitrary, 16 bit value that indicates a valid SDS Memory Region */
 #define REGION_SIGNATURE 0xAA7A
@@ -36,6 +44,23 @@
 /* Minimum structure size in bytes */
 #define MIN_STRUCT_SIZE 4
 
+/* Number of entries of the structure index, a power of two */
+#define INDEX_ENTRY_COUNT 32
+/* Maximum number of structures in the index, to keep the probe chains short */
+#define INDEX_STRUCTURE_COUNT_MAX ((INDEX_ENTRY_COUNT * 3) / 4)
+
+/* Offset basis and prime of the FNV-1a checksums of the watched structures */
+#define CHECKSUM_OFFSET_BASIS UINT32_C(2166136261)
+#define CHECKSUM_PRIME UINT32_C(16777619)
+
+/* Events of the module */
+enum sds_event_idx {
+    /* Check the watched structures for updates */
+    SDS_EVENT_IDX_CHECK_UPDATES,
+
+    SDS_EVENT_IDX_COUNT,
+};
+
 /* Header containing Shared Data Structure metadata */
 struct structure_header {
     /*
@@ -94,6 +119,15 @@ struct region_descriptor {
     uint32_t region_size;
 };
 
+/* Entry of the structure index */
+struct index_entry {
+    /* Structure identifier, zero for an unused entry */
+    uint32_t id;
+
+    /* Offset of the Structure Header from the base of the SDS Memory Region */
+    uint32_t offset;
+};
+
 /* Module context structure*/
 struct sds_ctx {
     /* Pointer to the module configuration. */
@@ -113,6 +147,41 @@ struct sds_ctx {
 
     /* Pointer to the Region Descriptor structure at the memory region base. */
     volatile struct region_descriptor *region_desc;
+
+    /*
+     * Index of the structures of the SDS Memory Region, an open-addressing
+     * hash table of their offsets. It is rebuilt from the region whenever the
+     * region is (re)initialized and updated as structures are allocated.
+     */
+    struct index_entry index[INDEX_ENTRY_COUNT];
+
+    /* Number of structures in the index */
+    unsigned int index_count;
+
+    /*
+     * Whether some structures of the region are not in the index. The region
+     * is then searched for the structures that are not in the index.
+     */
+    bool index_incomplete;
+
+    /* The region has been initialized */
+    bool initialized;
+
+    /*
+     * Checksums of the content of the watched structures, by index of the
+     * elements describing them.
+     */
+    uint32_t *checksum_table;
+
+#if BUILD_HAS_MOD_SMT
+    /* Doorbell driver API, NULL if the region has no doorbell */
+    const struct mod_smt_driver_api *doorbell_api;
+#endif
+
+#if BUILD_HAS_MOD_TIMER
+    /* Alarm API, NULL if the watched structures are not polled */
+    const struct mod_timer_alarm_api *alarm_api;
+#endif
 };
 
 /* Module context */
@@ -159,6 +228,59 @@ static bool validate_structure_access(uint32_t structure_size, uint32_t offset,
     return FWK_SUCCESS;
 }
 
+static unsigned int index_hash(uint32_t structure_id)
+{
+    return ((structure_id & MOD_SDS_ID_IDENTIFIER_MASK) ^
+            (structure_id >> MOD_SDS_ID_VERSION_MINOR_POS)) &
+           (INDEX_ENTRY_COUNT - 1);
+}
+
+static void index_clear(void)
+{
+    memset(ctx.index, 0, sizeof(ctx.index));
+    ctx.index_count = 0;
+    ctx.index_incomplete = false;
+}
+
+static void index_insert(uint32_t structure_id, uint32_t offset)
+{
+    unsigned int entry_idx;
+
+    if (ctx.index_count == INDEX_STRUCTURE_COUNT_MAX) {
+        ctx.index_incomplete = true;
+        return;
+    }
+
+    entry_idx = index_hash(structure_id);
+    while (ctx.index[entry_idx].id != 0)
+        entry_idx = (entry_idx + 1) & (INDEX_ENTRY_COUNT - 1);
+
+    ctx.index[entry_idx].id = structure_id;
+    ctx.index[entry_idx].offset = offset;
+    ctx.index_count++;
+}
+
+/*
+ * Look up the offset of a structure in the index. Returns false if the
+ * structure is not in the index.
+ */
+static bool index_lookup(uint32_t structure_id, uint32_t *offset)
+{
+    unsigned int entry_idx;
+
+    entry_idx = index_hash(structure_id);
+    while (ctx.index[entry_idx].id != 0) {
+        if (ctx.index[entry_idx].id == structure_id) {
+            *offset = ctx.index[entry_idx].offset;
+            return true;
+        }
+
+        entry_idx = (entry_idx + 1) & (INDEX_ENTRY_COUNT - 1);
+    }
+
+    return false;
+}
+
 /*
  * Search the SDS Memory Region for a given structure ID and return a
  * copy of the Structure Header that holds its information. Optionally, a
@@ -175,6 +297,9 @@ static bool validate_structure_access(uint32_t structure_size, uint32_t offset,
  * from this function.
  *
  * If a structure with the given ID is not present then FWK_E_PARAM is returned.
+ *
+ * The structure is looked up in the index first. The region is only searched
+ * when the index does not cover all the structures of the region.
  */
 static int get_structure_info(uint32_t structure_id,
                               struct structure_header *header,
@@ -184,6 +309,24 @@ static int get_structure_info(uint32_t structure_id,
     struct structure_header current_header;
     uint32_t offset;
 
+    if (index_lookup(structure_id, &offset)) {
+        current_header = *(struct structure_header *)(ctx.mem_base + offset);
+        if (!header_is_valid(&current_header) ||
+            (current_header.id != structure_id))
+            return FWK_E_DATA;
+
+        if (structure_base != NULL)
+            *structure_base = ((volatile char *)(ctx.mem_base + offset)) +
+                sizeof(struct structure_header);
+
+        *header = current_header;
+        return FWK_SUCCESS;
+    }
+
+    if (!ctx.index_incomplete &&
+        (ctx.index_count == ctx.region_desc->structure_count))
+        return FWK_E_PARAM;
+
     offset = sizeof(struct region_descriptor);
 
     /* Iterate over structure headers to find one with a matching ID */
@@ -248,6 +391,8 @@ static int struct_alloc(uint32_t structure_id, size_t size)
         goto exit;
     }
 
+    index_insert(structure_id, (uint32_t)(ctx.mem_next_free - ctx.mem_base));
+
     /* Create the Structure Header */
     header = (volatile struct structure_header *)ctx.mem_next_free;
     header->id = structure_id;
@@ -300,6 +445,8 @@ static int reinitialize_memory_region(void)
 
     mem_used = sizeof(struct region_descriptor);
 
+    index_clear();
+
     for (struct_idx = 0; struct_idx < ctx.region_desc->structure_count;
         struct_idx++) {
         header = *(volatile struct structure_header *)(ctx.mem_base + mem_used);
@@ -307,6 +454,8 @@ static int reinitialize_memory_region(void)
         if (!header_is_valid(&header))
             return FWK_E_DATA; /* Unexpected invalid header */
 
+        index_insert(header.id, mem_used);
+
         mem_used += header.size;
         mem_used += sizeof(struct structure_header);
         if (mem_used > ctx.region_desc->region_size)
@@ -354,6 +503,8 @@ static int create_memory_region(void)
 
     ctx.mem_free = ctx.mem_size - sizeof(struct region_descriptor);
 
+    index_clear();
+
     /*
      * Update the Region Descriptor
      */
@@ -445,6 +596,80 @@ static int struct_init(const struct mod_sds_structure_desc *struct_desc)
     return status;
 }
 
+/* Get the checksum of the content of a structure */
+static int get_structure_checksum(uint32_t structure_id, uint32_t *checksum)
+{
+    int status;
+    volatile char *structure_base;
+    struct structure_header header;
+    const volatile uint32_t *word;
+    unsigned int word_idx;
+
+    status = get_structure_info(structure_id, &header, &structure_base);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    word = (const volatile uint32_t *)structure_base;
+    *checksum = CHECKSUM_OFFSET_BASIS;
+
+    /* The size of the structures is a multiple of their alignment */
+    for (word_idx = 0; word_idx < (header.size / sizeof(*word)); word_idx++)
+        *checksum = (*checksum ^ word[word_idx]) * CHECKSUM_PRIME;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Check the content of the watched structures, and notify the updates of those
+ * whose content changed since the last check.
+ */
+static int check_updates(void)
+{
+    int status;
+    unsigned int element_idx;
+    unsigned int element_count;
+    const struct mod_sds_structure_desc *struct_desc;
+    uint32_t checksum;
+    unsigned int notification_count;
+    struct fwk_event notification_event;
+    struct mod_sds_notification_params_structure_updated *params;
+
+    if (!ctx.initialized)
+        return FWK_SUCCESS;
+
+    element_count = fwk_module_get_element_count(fwk_module_id_sds);
+    for (element_idx = 0; element_idx < element_count; ++element_idx) {
+        struct_desc = fwk_module_get_data(
+            fwk_id_build_element_id(fwk_module_id_sds, element_idx));
+        if (!struct_desc->watch)
+            continue;
+
+        status = get_structure_checksum(struct_desc->id, &checksum);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (checksum == ctx.checksum_table[element_idx])
+            continue;
+
+        ctx.checksum_table[element_idx] = checksum;
+
+        notification_event = (struct fwk_event) {
+            .id = mod_sds_notification_id_structure_updated,
+            .source_id = fwk_module_id_sds,
+        };
+
+        params = (void *)notification_event.params;
+        params->structure_id = struct_desc->id;
+
+        status = fwk_notification_notify(&notification_event,
+                                         &notification_count);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
 static int init_sds(void)
 {
     int status;
@@ -473,8 +698,18 @@ static int init_sds(void)
         status = struct_init(struct_desc);
         if (status != FWK_SUCCESS)
             return status;
+
+        /* Only the later updates of the watched structures are notified */
+        if (struct_desc->watch) {
+            status = get_structure_checksum(struct_desc->id,
+                                            &ctx.checksum_table[element_idx]);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
     }
 
+    ctx.initialized = true;
+
     return fwk_notification_notify(&notification_event, &notification_count);
 }
 
@@ -543,12 +778,70 @@ static int sds_struct_finalize(uint32_t structure_id)
     return struct_finalize(structure_id);
 }
 
+static int sds_struct_get(uint32_t structure_id,
+                          const volatile void **structure, size_t *size)
+{
+    int status;
+    volatile char *structure_base;
+    struct structure_header header;
+
+    status = fwk_module_check_call(fwk_module_id_sds);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((structure == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    status = get_structure_info(structure_id, &header, &structure_base);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *structure = structure_base;
+    *size = header.size;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_sds_api module_api = {
     .struct_write = sds_struct_write,
     .struct_read = sds_struct_read,
     .struct_finalize = sds_struct_finalize,
+    .struct_get = sds_struct_get,
 };
 
+#if BUILD_HAS_MOD_SMT
+/*
+ * Doorbell driver input API
+ */
+
+static int doorbell_signal_message(fwk_id_t channel_id)
+{
+    /* The doorbells rung before the check is processed are coalesced */
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SDS, SDS_EVENT_IDX_CHECK_UPDATES),
+        .source_id = fwk_module_id_sds,
+        .target_id = fwk_module_id_sds,
+        .supersedes = true,
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static const struct mod_smt_driver_input_api doorbell_input_api = {
+    .signal_message = doorbell_signal_message,
+};
+
+static bool is_doorbell_driver(fwk_id_t requester_id, fwk_id_t api_id)
+{
+    fwk_id_t doorbell_id = ctx.module_config->doorbell_id;
+
+    return fwk_id_is_type(doorbell_id, FWK_ID_TYPE_SUB_ELEMENT) &&
+           (fwk_id_get_module_idx(requester_id) ==
+            fwk_id_get_module_idx(doorbell_id)) &&
+           (fwk_id_get_api_idx(api_id) == MOD_SMT_API_IDX_DRIVER_INPUT);
+}
+#endif
+
 /*
  * Framework handlers
  */
@@ -569,6 +862,18 @@ static int sds_init(fwk_id_t module_id, unsigned int element_count,
         MIN_STRUCT_ALIGNMENT) > 0)
         return FWK_E_PARAM;
 
+    if (fwk_id_is_type(ctx.module_config->poll_alarm_id,
+                       FWK_ID_TYPE_SUB_ELEMENT) &&
+        (ctx.module_config->poll_period_ms == 0))
+        return FWK_E_PARAM;
+
+    if (element_count > 0) {
+        ctx.checksum_table = fwk_mm_calloc(element_count,
+                                           sizeof(ctx.checksum_table[0]));
+        if (ctx.checksum_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
     ctx.mem_base = (volatile char *)ctx.module_config->region_base_address;
     ctx.mem_size = ctx.module_config->region_size;
     ctx.region_desc = (volatile struct region_descriptor *)ctx.mem_base;
@@ -582,9 +887,50 @@ static int sds_element_init(fwk_id_t element_id, unsigned int unused,
     return FWK_SUCCESS;
 }
 
+static int sds_bind(fwk_id_t id, unsigned int round)
+{
+#if BUILD_HAS_MOD_SMT || BUILD_HAS_MOD_TIMER
+    int status;
+#endif
+
+    if ((round != 0) || !fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+#if BUILD_HAS_MOD_SMT
+    /* The doorbell driver binds back to the module to signal the doorbell */
+    if (fwk_id_is_type(ctx.module_config->doorbell_id,
+                       FWK_ID_TYPE_SUB_ELEMENT)) {
+        status = fwk_module_bind(ctx.module_config->doorbell_id,
+                                 ctx.module_config->doorbell_api_id,
+                                 &ctx.doorbell_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+#endif
+
+#if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_type(ctx.module_config->poll_alarm_id,
+                       FWK_ID_TYPE_SUB_ELEMENT)) {
+        status = fwk_module_bind(ctx.module_config->poll_alarm_id,
+                                 MOD_TIMER_API_ID_ALARM, &ctx.alarm_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+#endif
+
+    return FWK_SUCCESS;
+}
+
 static int sds_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
                                     fwk_id_t api_id, const void **api)
 {
+#if BUILD_HAS_MOD_SMT
+    if (is_doorbell_driver(requester_id, api_id)) {
+        *api = &doorbell_input_api;
+        return FWK_SUCCESS;
+    }
+#endif
+
     if (!fwk_module_is_valid_module_id(requester_id))
         return FWK_E_ACCESS;
 
@@ -594,9 +940,23 @@ static int sds_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
 
 static int sds_start(fwk_id_t id)
 {
+#if BUILD_HAS_MOD_TIMER
+    int status;
+#endif
+
     if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
         return FWK_SUCCESS;
 
+#if BUILD_HAS_MOD_TIMER
+    if (ctx.alarm_api != NULL) {
+        status = ctx.alarm_api->start(ctx.module_config->poll_alarm_id,
+                                      ctx.module_config->poll_period_ms,
+                                      MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+#endif
+
 #if BUILD_HAS_MOD_CLOCK
     if (!fwk_id_is_equal(ctx.module_config->clock_id, FWK_ID_NONE)) {
         /* Register for clock state notifications */
@@ -629,17 +989,33 @@ static int sds_process_notification(
 }
 #endif
 
+static int sds_process_event(const struct fwk_event *event,
+                             struct fwk_event *resp_event)
+{
+#if BUILD_HAS_MOD_TIMER
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm))
+        return check_updates();
+#endif
+
+    if (fwk_id_get_event_idx(event->id) == SDS_EVENT_IDX_CHECK_UPDATES)
+        return check_updates();
+
+    return FWK_E_PARAM;
+}
+
 /* Module descriptor */
 const struct fwk_module module_sds = {
     .name = "Shared Data Storage",
     .type = FWK_MODULE_TYPE_SERVICE,
     .api_count = 1,
-    .event_count = 0,
+    .event_count = SDS_EVENT_IDX_COUNT,
     .notification_count = MOD_SDS_NOTIFICATION_IDX_COUNT,
     .init = sds_init,
     .element_init = sds_element_init,
+    .bind = sds_bind,
     .process_bind_request = sds_process_bind_request,
     .start = sds_start,
+    .process_event = sds_process_event,
 #if BUILD_HAS_MOD_CLOCK
     .process_notification = sds_process_notification
 #endif
@@ -9,6 +9,7 @@
 #define MOD_SENSOR_H
 
 #include <fwk_id.h>
+#include <fwk_module_idx.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -151,6 +152,48 @@ struct mod_sensor_info {
      *  Used like this: unit x10^(\ref unit_multiplier)
      */
     int unit_multiplier;
+
+    /*!
+     * \brief Number of trip points of the sensor.
+     *
+     * \details Filled in by the sensor module from
+     *      \ref mod_sensor_dev_config::trip_point_count, the drivers do not
+     *      need to set it.
+     */
+    unsigned int trip_point_count;
+};
+
+/*!
+ * \brief Trip point modes.
+ *
+ * \details The mode selects the crossings of the trip point that are
+ *      notified. The values are bit masks, a crossing in either direction is
+ *      notified in \ref MOD_SENSOR_TRIP_POINT_MODE_BOTH.
+ */
+enum mod_sensor_trip_point_mode {
+    /*! The trip point is disabled */
+    MOD_SENSOR_TRIP_POINT_MODE_DISABLED = 0,
+
+    /*! The value rises to or above the trip point */
+    MOD_SENSOR_TRIP_POINT_MODE_RISING = (1 << 0),
+
+    /*! The value falls below the trip point */
+    MOD_SENSOR_TRIP_POINT_MODE_FALLING = (1 << 1),
+
+    /*! The value crosses the trip point in either direction */
+    MOD_SENSOR_TRIP_POINT_MODE_BOTH = MOD_SENSOR_TRIP_POINT_MODE_RISING |
+                                      MOD_SENSOR_TRIP_POINT_MODE_FALLING,
+};
+
+/*!
+ * \brief Trip point.
+ */
+struct mod_sensor_trip_point {
+    /*! Value of the trip point */
+    uint64_t value;
+
+    /*! Mode of the trip point */
+    enum mod_sensor_trip_point_mode mode;
 };
 
 /*!
@@ -162,6 +205,43 @@ struct mod_sensor_dev_config {
     /*! Module or element id of the driver */
     fwk_id_t driver_id;
 
+    /*!
+     * \brief Period in milliseconds of the sampling of the sensor, 0 to
+     *      disable the periodic sampling.
+     *
+     * \details The sensor is read periodically and the last value read is
+     *      cached. The readings are served from the cache as long as the
+     *      cached value is not older than \ref cache_tolerance.
+     *
+     * \note The periodic sampling requires the timer module.
+     */
+    unsigned int sampling_period;
+
+    /*!
+     * \brief Sub-element identifier of the alarm used to sample the sensor.
+     *      The timer of the alarm timestamps the samples.
+     *
+     * \note Used only if \ref sampling_period is not equal to 0.
+     */
+    fwk_id_t sampling_alarm_id;
+
+    /*!
+     * \brief Maximum age in microseconds of the cached value to serve a
+     *      reading from.
+     *
+     * \note Used only if \ref sampling_period is not equal to 0.
+     */
+    uint32_t cache_tolerance;
+
+    /*!
+     * \brief Number of trip points of the sensor.
+     *
+     * \details The trip points are programmed in hardware comparators when
+     *      the driver implements \ref mod_sensor_driver_api::set_trip_point.
+     *      Otherwise, they are compared to the periodic samples of the sensor,
+     *      which requires a non-zero \ref sampling_period.
+     */
+    unsigned int trip_point_count;
 };
 
 /*!
@@ -173,12 +253,17 @@ struct mod_sensor_driver_api {
     /*!
      * \brief Read sensor value.
      *
-     * \details Synchronously read current sensor value.
+     * \details Read current sensor value. A driver that cannot read the
+     *      value without blocking, for instance because the sensor is on a
+     *      bus, starts the reading and returns \ref FWK_PENDING. It then
+     *      reports the value through the sensor module driver response API.
      *
      * \param id Specific sensor device id.
      * \param[out] value The sensor value.
      *
      * \retval FWK_SUCCESS Value was read successfully.
+     * \retval FWK_PENDING The reading was started, its completion is reported
+     *      through \ref mod_sensor_driver_response_api::reading_complete.
      * \return One of the standard framework error codes.
      */
     int (*get_value)(fwk_id_t id, uint64_t *value);
@@ -193,6 +278,118 @@ struct mod_sensor_driver_api {
      * \return One of the standard framework error codes.
      */
     int (*get_info)(fwk_id_t id, struct mod_sensor_info *info);
+
+    /*!
+     * \brief Program a hardware threshold comparator. Optional.
+     *
+     * \details The driver reports the crossings through
+     *      \ref mod_sensor_driver_response_api::trip_point_crossed. When the
+     *      function is not implemented, the sensor module compares the trip
+     *      points to the periodic samples of the sensor.
+     *
+     * \param id Specific sensor device id.
+     * \param trip_point_idx Index of the trip point.
+     * \param trip_point The trip point.
+     *
+     * \retval FWK_SUCCESS The comparator was programmed successfully.
+     * \return One of the standard framework error codes.
+     */
+    int (*set_trip_point)(fwk_id_t id, unsigned int trip_point_idx,
+                          const struct mod_sensor_trip_point *trip_point);
+
+    /*!
+     * \brief Read the values of a group of sensors of the driver. Optional.
+     *
+     * \details The values are read without blocking, in a single call. When
+     *      the function is not implemented, the sensor module reads the
+     *      sensors of the group one by one.
+     *
+     * \param id_table Table of the sensor device ids.
+     * \param count Number of sensors in the group.
+     * \param[out] value_table Table of the sensor values.
+     *
+     * \retval FWK_SUCCESS The values were read successfully.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_values)(const fwk_id_t *id_table, unsigned int count,
+                      uint64_t *value_table);
+};
+
+/*!
+ * \brief Result of a sensor reading reported by a driver.
+ */
+struct mod_sensor_driver_resp_params {
+    /*! Status of the reading */
+    int status;
+
+    /*! Sensor value, valid only if the status is \ref FWK_SUCCESS */
+    uint64_t value;
+};
+
+/*!
+ * \brief Sensor driver response API.
+ *
+ * \details The interface the sensor module exposes to its drivers to report
+ *      the completion of the readings they returned \ref FWK_PENDING for.
+ */
+struct mod_sensor_driver_response_api {
+    /*!
+     * \brief Report the completion of a sensor reading.
+     *
+     * \note This function can be called from an interrupt handler.
+     *
+     * \param id Identifier of the sensor device.
+     * \param response Result of the reading.
+     */
+    void (*reading_complete)(fwk_id_t id,
+                             const struct mod_sensor_driver_resp_params
+                                 *response);
+
+    /*!
+     * \brief Report the crossing of a trip point by a hardware comparator.
+     *
+     * \note This function can be called from an interrupt handler.
+     *
+     * \param id Identifier of the sensor device.
+     * \param trip_point_idx Index of the trip point.
+     * \param rising \c true if the value rose to or above the trip point,
+     *      \c false if it fell below.
+     */
+    void (*trip_point_crossed)(fwk_id_t id, unsigned int trip_point_idx,
+                               bool rising);
+};
+
+/*!
+ * \brief Parameters of the response to a pending sensor reading.
+ */
+struct mod_sensor_event_params {
+    /*! Status of the reading */
+    int status;
+
+    /*! Sensor value, valid only if the status is \ref FWK_SUCCESS */
+    uint64_t value;
+};
+
+/*!
+ * \brief Parameters of the sample notification.
+ */
+struct mod_sensor_sample_notification_params {
+    /*! Sensor value */
+    uint64_t value;
+
+    /*! Time of the sample, in microseconds */
+    uint64_t timestamp;
+};
+
+/*!
+ * \brief Parameters of the trip point notification.
+ */
+struct mod_sensor_trip_point_notification_params {
+    /*! Index of the trip point */
+    unsigned int trip_point_idx;
+
+    /*! The value rose to or above the trip point if true, fell below if not */
+    bool rising;
 };
 
 /*!
@@ -202,12 +399,22 @@ struct mod_sensor_api {
     /*!
      * \brief Read sensor value.
      *
-     * \details Synchronously read current sensor value.
+     * \details Read current sensor value. If the driver of the sensor cannot
+     *      read the value without blocking, the function returns
+     *      \ref FWK_PENDING and the value is sent later to the caller with a
+     *      response event. The identifier of the response event is
+     *      \ref mod_sensor_event_id_read_request and its parameters are a
+     *      \ref mod_sensor_event_params structure.
+     *
+     * \note A sensor has at most one reading in progress.
      *
      * \param id Specific sensor device id.
      * \param[out] value The sensor value.
      *
      * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_PENDING The reading is in progress, the value is sent with
+     *      a response event.
+     * \retval FWK_E_BUSY A reading of the sensor is already in progress.
      * \retval FWK_E_DEVICE Driver error.
      * \return One of the standard framework error codes.
      */
@@ -226,8 +433,152 @@ struct mod_sensor_api {
      * \return One of the standard framework error codes.
      */
     int (*get_info)(fwk_id_t id, struct mod_sensor_info *info);
+
+    /*!
+     * \brief Configure a trip point.
+     *
+     * \details The crossings of the trip point selected by its mode are
+     *      notified with the \ref mod_sensor_notification_id_trip_point
+     *      notification of the sensor.
+     *
+     * \param id Specific sensor device id.
+     * \param trip_point_idx Index of the trip point.
+     * \param trip_point The trip point.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM The trip point index or mode is not valid.
+     * \retval FWK_E_DEVICE Driver error.
+     * \return One of the standard framework error codes.
+     */
+    int (*set_trip_point)(fwk_id_t id, unsigned int trip_point_idx,
+                          const struct mod_sensor_trip_point *trip_point);
+
+    /*!
+     * \brief Read the values of a group of sensors.
+     *
+     * \details The sensors are read synchronously. The consecutive sensors
+     *      of the group that share a driver implementing
+     *      \ref mod_sensor_driver_api::get_values are read with a single call
+     *      to the driver. The values read refresh the caches of the
+     *      periodically sampled sensors.
+     *
+     * \param id_table Table of the sensor device ids.
+     * \param count Number of sensors in the group.
+     * \param[out] value_table Table of the sensor values, in the order of
+     *      \p id_table.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM One of the identifiers is not a sensor.
+     * \retval FWK_E_BUSY A reading of one of the sensors is in progress.
+     * \retval FWK_E_SUPPORT The driver of one of the sensors cannot read its
+     *      value without blocking.
+     * \retval FWK_E_DEVICE Driver error.
+     * \return One of the standard framework error codes.
+     */
+    int (*get_values)(const fwk_id_t *id_table, unsigned int count,
+                      uint64_t *value_table);
+};
+
+/*!
+ * \defgroup GroupSensorIds Identifiers
+ * \{
+ */
+
+/*!
+ * \brief API indices.
+ */
+enum mod_sensor_api_idx {
+    /*! Sensor API */
+    MOD_SENSOR_API_IDX_SENSOR,
+
+    /*! Driver response API */
+    MOD_SENSOR_API_IDX_DRIVER_RESPONSE,
+
+    /*! Number of APIs */
+    MOD_SENSOR_API_IDX_COUNT,
+};
+
+/*! Sensor API identifier */
+static const fwk_id_t mod_sensor_api_id_sensor =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_SENSOR, MOD_SENSOR_API_IDX_SENSOR);
+
+/*! Driver response API identifier */
+static const fwk_id_t mod_sensor_api_id_driver_response =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_SENSOR, MOD_SENSOR_API_IDX_DRIVER_RESPONSE);
+
+/*!
+ * \brief Event indices.
+ */
+enum mod_sensor_event_idx {
+    /*! Pending reading */
+    MOD_SENSOR_EVENT_IDX_READ_REQUEST,
+
+    /*! Completion of a pending reading reported by a driver */
+    MOD_SENSOR_EVENT_IDX_READ_COMPLETE,
+
+    /*! Periodic sampling */
+    MOD_SENSOR_EVENT_IDX_SAMPLE,
+
+    /*! Crossing of a trip point reported by a driver */
+    MOD_SENSOR_EVENT_IDX_TRIP_POINT,
+
+    /*! Number of events */
+    MOD_SENSOR_EVENT_IDX_COUNT,
 };
 
+/*! Read request event identifier */
+static const fwk_id_t mod_sensor_event_id_read_request =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SENSOR, MOD_SENSOR_EVENT_IDX_READ_REQUEST);
+
+/*! Read complete event identifier */
+static const fwk_id_t mod_sensor_event_id_read_complete =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SENSOR,
+                      MOD_SENSOR_EVENT_IDX_READ_COMPLETE);
+
+/*! Sample event identifier */
+static const fwk_id_t mod_sensor_event_id_sample =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SENSOR, MOD_SENSOR_EVENT_IDX_SAMPLE);
+
+/*!
+ * \brief Notification indices.
+ */
+enum mod_sensor_notification_idx {
+    /*!
+     * \brief New sample of a periodically sampled sensor.
+     *
+     * \details The parameters of the notification are a
+     *      \ref mod_sensor_sample_notification_params structure. Only the
+     *      successful readings of the sensors with a non-zero
+     *      \ref mod_sensor_dev_config::sampling_period are notified.
+     */
+    MOD_SENSOR_NOTIFICATION_IDX_SAMPLE,
+
+    /*!
+     * \brief Crossing of a trip point.
+     *
+     * \details The parameters of the notification are a
+     *      \ref mod_sensor_trip_point_notification_params structure.
+     */
+    MOD_SENSOR_NOTIFICATION_IDX_TRIP_POINT,
+
+    /*! Number of notifications */
+    MOD_SENSOR_NOTIFICATION_IDX_COUNT,
+};
+
+/*! Sample notification identifier */
+static const fwk_id_t mod_sensor_notification_id_sample =
+    FWK_ID_NOTIFICATION_INIT(FWK_MODULE_IDX_SENSOR,
+                             MOD_SENSOR_NOTIFICATION_IDX_SAMPLE);
+
+/*! Trip point notification identifier */
+static const fwk_id_t mod_sensor_notification_id_trip_point =
+    FWK_ID_NOTIFICATION_INIT(FWK_MODULE_IDX_SENSOR,
+                             MOD_SENSOR_NOTIFICATION_IDX_TRIP_POINT);
+
+/*!
+ * \}
+ */
+
 /*!
  * @}
  */
@@ -9,18 +9,240 @@
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
+#include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_notification.h>
+#include <fwk_thread.h>
 #include <mod_sensor.h>
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
+
+/* Maximum number of sensors read with a single call to their driver */
+#define SENSOR_GROUP_BATCH_SIZE 16
 
 struct sensor_dev_ctx {
     struct mod_sensor_dev_config *config;
     struct mod_sensor_driver_api *driver_api;
+
+    /* A driver reading is in progress */
+    bool read_busy;
+
+    /* A caller waits for the value of the reading in progress */
+    bool request_pending;
+
+    /* The response to the read request event of the caller is delayed */
+    bool response_delayed;
+
+    /* Cookie of the read request event the response is delayed for */
+    uint32_t cookie;
+
+    /* Status of the last driver reading */
+    int last_status;
+
+    /* Last value read, valid if 'cache_valid' is set */
+    uint64_t cached_value;
+
+    /* Time of the last successful reading, in microseconds */
+    uint64_t cache_timestamp;
+
+    /* At least one reading succeeded */
+    bool cache_valid;
+
+    /* Table of the trip points, NULL if the sensor has none */
+    struct mod_sensor_trip_point *trip_point_table;
+
+    /* Last sample compared to the trip points, valid if 'trip_ref_valid' */
+    uint64_t trip_ref_value;
+
+    /* At least one sample was compared to the trip points */
+    bool trip_ref_valid;
+
+    #if BUILD_HAS_MOD_TIMER
+    /* Timer API used to timestamp the readings */
+    const struct mod_timer_api *timer_api;
+
+    /* Alarm API used to sample the sensor periodically */
+    const struct mod_timer_alarm_api *alarm_api;
+    #endif
 };
 
 static struct sensor_dev_ctx *ctx_table;
 
+/* Whether a sensor is sampled periodically */
+static bool is_sampled(const struct sensor_dev_ctx *ctx)
+{
+    return ctx->config->sampling_period != 0;
+}
+
+/*
+ * Get the current time in microseconds, zero if the time is not available.
+ */
+static uint64_t get_time(const struct sensor_dev_ctx *ctx)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    fwk_id_t timer_id;
+    uint64_t time;
+
+    if (ctx->timer_api == NULL)
+        return 0;
+
+    timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+        fwk_id_get_element_idx(ctx->config->sampling_alarm_id));
+
+    status = ctx->timer_api->get_time(timer_id, &time);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    return time;
+    #else
+    return 0;
+    #endif
+}
+
+/* Whether the cached value is fresh enough to serve a reading */
+static bool is_cache_fresh(const struct sensor_dev_ctx *ctx)
+{
+    return is_sampled(ctx) && ctx->cache_valid &&
+        ((get_time(ctx) - ctx->cache_timestamp) <=
+         ctx->config->cache_tolerance);
+}
+
+/* Account for the result of a driver reading */
+static void reading_done(struct sensor_dev_ctx *ctx, int status,
+                         uint64_t value)
+{
+    ctx->last_status = (status == FWK_SUCCESS) ? FWK_SUCCESS : FWK_E_DEVICE;
+    if (status != FWK_SUCCESS)
+        return;
+
+    ctx->cached_value = value;
+    ctx->cache_timestamp = get_time(ctx);
+    ctx->cache_valid = true;
+}
+
+/*
+ * Notify the subscribers of the last sample of a sensor. Called from the event
+ * handler of the sensor, so that the sensor is the source of the notification.
+ */
+static void notify_sample(struct sensor_dev_ctx *ctx)
+{
+    struct fwk_event notification;
+    struct mod_sensor_sample_notification_params *params;
+    unsigned int count;
+
+    if (!is_sampled(ctx) || (ctx->last_status != FWK_SUCCESS))
+        return;
+
+    notification = (struct fwk_event) {
+        .id = mod_sensor_notification_id_sample,
+    };
+
+    params = (struct mod_sensor_sample_notification_params *)
+        notification.params;
+    *params = (struct mod_sensor_sample_notification_params) {
+        .value = ctx->cached_value,
+        .timestamp = ctx->cache_timestamp,
+    };
+
+    fwk_notification_notify(&notification, &count);
+}
+
+/*
+ * Notify the subscribers of the crossing of a trip point of a sensor, if the
+ * mode of the trip point selects it. Called from the event handler of the
+ * sensor.
+ */
+static void notify_trip_point(struct sensor_dev_ctx *ctx,
+                              unsigned int trip_point_idx, bool rising)
+{
+    struct fwk_event notification;
+    struct mod_sensor_trip_point_notification_params *params;
+    unsigned int count;
+    enum mod_sensor_trip_point_mode mode;
+
+    if (trip_point_idx >= ctx->config->trip_point_count)
+        return;
+
+    mode = ctx->trip_point_table[trip_point_idx].mode;
+    if (!(mode & (rising ? MOD_SENSOR_TRIP_POINT_MODE_RISING :
+                           MOD_SENSOR_TRIP_POINT_MODE_FALLING)))
+        return;
+
+    notification = (struct fwk_event) {
+        .id = mod_sensor_notification_id_trip_point,
+    };
+
+    params = (struct mod_sensor_trip_point_notification_params *)
+        notification.params;
+    *params = (struct mod_sensor_trip_point_notification_params) {
+        .trip_point_idx = trip_point_idx,
+        .rising = rising,
+    };
+
+    fwk_notification_notify(&notification, &count);
+}
+
+/*
+ * Compare the last sample of a sensor to its trip points, for the sensors
+ * without hardware comparators. A trip point is crossed when the sample and
+ * the previous one compared are on either side of it.
+ */
+static void check_trip_points(struct sensor_dev_ctx *ctx)
+{
+    unsigned int trip_point_idx;
+    uint64_t previous, value, trip_value;
+
+    if ((ctx->config->trip_point_count == 0) ||
+        (ctx->driver_api->set_trip_point != NULL) ||
+        (ctx->last_status != FWK_SUCCESS))
+        return;
+
+    previous = ctx->trip_ref_value;
+    value = ctx->cached_value;
+
+    if (ctx->trip_ref_valid) {
+        for (trip_point_idx = 0;
+             trip_point_idx < ctx->config->trip_point_count;
+             trip_point_idx++) {
+            trip_value = ctx->trip_point_table[trip_point_idx].value;
+
+            if ((previous < trip_value) && (value >= trip_value))
+                notify_trip_point(ctx, trip_point_idx, true);
+            else if ((previous >= trip_value) && (value < trip_value))
+                notify_trip_point(ctx, trip_point_idx, false);
+        }
+    }
+
+    ctx->trip_ref_value = value;
+    ctx->trip_ref_valid = true;
+}
+
+/*
+ * Start a driver reading.
+ *
+ * \retval FWK_SUCCESS The value was read.
+ * \retval FWK_PENDING The driver reports the value later.
+ * \retval FWK_E_DEVICE Driver error.
+ */
+static int start_reading(struct sensor_dev_ctx *ctx, uint64_t *value)
+{
+    int status;
+
+    status = ctx->driver_api->get_value(ctx->config->driver_id, value);
+    if (status == FWK_PENDING) {
+        ctx->read_busy = true;
+        return FWK_PENDING;
+    }
+
+    reading_done(ctx, status, *value);
+
+    return ctx->last_status;
+}
+
 static int get_ctx_if_valid_call(fwk_id_t id,
                                  void *data,
                                  struct sensor_dev_ctx **ctx)
@@ -49,16 +271,42 @@ static int get_value(fwk_id_t id, uint64_t *value)
 {
     int status;
     struct sensor_dev_ctx *ctx;
+    struct fwk_event event;
 
     status = get_ctx_if_valid_call(id, value, &ctx);
     if (status != FWK_SUCCESS)
         return status;
 
-    status = ctx->driver_api->get_value(ctx->config->driver_id, value);
-    if (!fwk_expect(status == FWK_SUCCESS))
+    /* Serve the reading from the cache of the periodic samples if possible */
+    if (is_cache_fresh(ctx)) {
+        *value = ctx->cached_value;
+        return FWK_SUCCESS;
+    }
+
+    if (ctx->request_pending)
+        return FWK_E_BUSY;
+
+    /* A sample being read also serves the caller */
+    if (!ctx->read_busy) {
+        status = start_reading(ctx, value);
+        if (status != FWK_PENDING)
+            return status;
+    }
+
+    /* The caller receives the value in the response to this event */
+    event = (struct fwk_event) {
+        .id = mod_sensor_event_id_read_request,
+        .target_id = id,
+        .response_requested = true,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
         return FWK_E_DEVICE;
 
-    return FWK_SUCCESS;
+    ctx->request_pending = true;
+
+    return FWK_PENDING;
 }
 
 static int get_info(fwk_id_t id, struct mod_sensor_info *info)
@@ -74,14 +322,207 @@ static int get_info(fwk_id_t id, struct mod_sensor_info *info)
     if (!fwk_expect(status == FWK_SUCCESS))
         return FWK_E_DEVICE;
 
+    info->trip_point_count = ctx->config->trip_point_count;
+
+    return FWK_SUCCESS;
+}
+
+static int set_trip_point(fwk_id_t id, unsigned int trip_point_idx,
+                          const struct mod_sensor_trip_point *trip_point)
+{
+    int status;
+    struct sensor_dev_ctx *ctx;
+
+    status = get_ctx_if_valid_call(id, (void *)trip_point, &ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((trip_point_idx >= ctx->config->trip_point_count) ||
+        (trip_point->mode & ~MOD_SENSOR_TRIP_POINT_MODE_BOTH))
+        return FWK_E_PARAM;
+
+    if (ctx->driver_api->set_trip_point != NULL) {
+        status = ctx->driver_api->set_trip_point(ctx->config->driver_id,
+                                                 trip_point_idx, trip_point);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+    }
+
+    ctx->trip_point_table[trip_point_idx] = *trip_point;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Read a batch of consecutive sensors of a group, starting with the given one.
+ * The sensors that follow it and share its driver are read with it if the
+ * driver reads groups of sensors.
+ *
+ * \param[out] batch_count Number of sensors read.
+ */
+static int get_batch_values(const fwk_id_t *id_table, unsigned int count,
+                            uint64_t *value_table, unsigned int *batch_count)
+{
+    int status;
+    unsigned int idx;
+    struct sensor_dev_ctx *first, *ctx;
+    fwk_id_t driver_id_table[SENSOR_GROUP_BATCH_SIZE];
+
+    first = ctx_table + fwk_id_get_element_idx(id_table[0]);
+    *batch_count = 1;
+
+    if (first->driver_api->get_values == NULL) {
+        status = first->driver_api->get_value(first->config->driver_id,
+                                              value_table);
+        if (status == FWK_PENDING) {
+            /* The completion of the reading refreshes the cache */
+            first->read_busy = true;
+            return FWK_E_SUPPORT;
+        }
+
+        reading_done(first, status, value_table[0]);
+
+        return first->last_status;
+    }
+
+    driver_id_table[0] = first->config->driver_id;
+    while ((*batch_count < count) &&
+           (*batch_count < SENSOR_GROUP_BATCH_SIZE)) {
+        ctx = ctx_table + fwk_id_get_element_idx(id_table[*batch_count]);
+        if (ctx->driver_api != first->driver_api)
+            break;
+
+        driver_id_table[(*batch_count)++] = ctx->config->driver_id;
+    }
+
+    status = first->driver_api->get_values(driver_id_table, *batch_count,
+                                           value_table);
+
+    for (idx = 0; idx < *batch_count; idx++) {
+        ctx = ctx_table + fwk_id_get_element_idx(id_table[idx]);
+        reading_done(ctx, status, value_table[idx]);
+    }
+
+    return first->last_status;
+}
+
+static int get_values(const fwk_id_t *id_table, unsigned int count,
+                      uint64_t *value_table)
+{
+    int status;
+    unsigned int idx, batch_count;
+
+    if ((id_table == NULL) || (value_table == NULL))
+        return FWK_E_PARAM;
+
+    status = fwk_module_check_call(FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR));
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (idx = 0; idx < count; idx++) {
+        if ((fwk_id_get_module_idx(id_table[idx]) != FWK_MODULE_IDX_SENSOR) ||
+            !fwk_module_is_valid_element_id(id_table[idx]))
+            return FWK_E_PARAM;
+
+        if (ctx_table[fwk_id_get_element_idx(id_table[idx])].read_busy)
+            return FWK_E_BUSY;
+    }
+
+    for (idx = 0; idx < count; idx += batch_count) {
+        status = get_batch_values(&id_table[idx], count - idx,
+                                  &value_table[idx], &batch_count);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     return FWK_SUCCESS;
 }
 
 static struct mod_sensor_api sensor_api = {
     .get_value = get_value,
     .get_info  = get_info,
+    .set_trip_point = set_trip_point,
+    .get_values = get_values,
 };
 
+/*
+ * Driver response API
+ */
+static void reading_complete(fwk_id_t id,
+                             const struct mod_sensor_driver_resp_params
+                                 *response)
+{
+    int status;
+    struct fwk_event event;
+    struct mod_sensor_event_params *params =
+        (struct mod_sensor_event_params *)event.params;
+
+    fwk_assert(fwk_module_is_valid_element_id(id));
+    fwk_assert(response != NULL);
+
+    event = (struct fwk_event) {
+        .id = mod_sensor_event_id_read_complete,
+        .source_id = id,
+        .target_id = id,
+    };
+
+    *params = (struct mod_sensor_event_params) {
+        .status = response->status,
+        .value = response->value,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+static void trip_point_crossed(fwk_id_t id, unsigned int trip_point_idx,
+                               bool rising)
+{
+    int status;
+    struct fwk_event event;
+    struct mod_sensor_trip_point_notification_params *params =
+        (struct mod_sensor_trip_point_notification_params *)event.params;
+
+    fwk_assert(fwk_module_is_valid_element_id(id));
+
+    event = (struct fwk_event) {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SENSOR,
+                           MOD_SENSOR_EVENT_IDX_TRIP_POINT),
+        .source_id = id,
+        .target_id = id,
+    };
+
+    *params = (struct mod_sensor_trip_point_notification_params) {
+        .trip_point_idx = trip_point_idx,
+        .rising = rising,
+    };
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+static struct mod_sensor_driver_response_api driver_response_api = {
+    .reading_complete = reading_complete,
+    .trip_point_crossed = trip_point_crossed,
+};
+
+#if BUILD_HAS_MOD_TIMER
+/*
+ * The alarm callback is called from within an interrupt service routine, the
+ * sensor is read from the event loop.
+ */
+static void sampling_alarm_callback(uintptr_t param)
+{
+    struct fwk_event event = {
+        .id = mod_sensor_event_id_sample,
+        .source_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, param),
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SENSOR, param),
+    };
+
+    fwk_thread_put_event(&event);
+}
+#endif
+
 /*
  * Framework handlers
  */
@@ -89,7 +530,7 @@ static int sensor_init(fwk_id_t module_id,
                        unsigned int element_count,
                        const void *unused)
 {
-    ctx_table = fwk_mm_alloc(element_count, sizeof(ctx_table[0]));
+    ctx_table = fwk_mm_calloc(element_count, sizeof(ctx_table[0]));
 
     if (ctx_table == NULL)
         return FWK_E_NOMEM;
@@ -109,7 +550,19 @@ static int sensor_dev_init(fwk_id_t element_id,
 
     ctx->config = config;
 
+    if (config->trip_point_count != 0) {
+        ctx->trip_point_table = fwk_mm_calloc(config->trip_point_count,
+            sizeof(ctx->trip_point_table[0]));
+        if (ctx->trip_point_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
+    /* The samples are taken with a timer alarm */
+    #if BUILD_HAS_MOD_TIMER
     return FWK_SUCCESS;
+    #else
+    return (config->sampling_period == 0) ? FWK_SUCCESS : FWK_E_SUPPORT;
+    #endif
 }
 
 static int sensor_bind(fwk_id_t id, unsigned int round)
@@ -139,9 +592,50 @@ static int sensor_bind(fwk_id_t id, unsigned int round)
     if ((driver == NULL) || (driver->get_value == NULL))
         return FWK_E_DATA;
 
+    /* Without hardware comparators, the trip points need periodic samples */
+    if ((ctx->config->trip_point_count != 0) &&
+        (driver->set_trip_point == NULL) && !is_sampled(ctx))
+        return FWK_E_DATA;
+
     ctx->driver_api = driver;
 
+    #if BUILD_HAS_MOD_TIMER
+    if (is_sampled(ctx)) {
+        status = fwk_module_bind(ctx->config->sampling_alarm_id,
+            MOD_TIMER_API_ID_ALARM, &ctx->alarm_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = fwk_module_bind(
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER,
+                fwk_id_get_element_idx(ctx->config->sampling_alarm_id)),
+            MOD_TIMER_API_ID_TIMER, &ctx->timer_api);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+    #endif
+
+    return FWK_SUCCESS;
+}
+
+static int sensor_start(fwk_id_t id)
+{
+    #if BUILD_HAS_MOD_TIMER
+    struct sensor_dev_ctx *ctx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    ctx = ctx_table + fwk_id_get_element_idx(id);
+    if (!is_sampled(ctx))
+        return FWK_SUCCESS;
+
+    return ctx->alarm_api->start(ctx->config->sampling_alarm_id,
+        ctx->config->sampling_period, MOD_TIMER_ALARM_TYPE_PERIODIC,
+        sampling_alarm_callback, fwk_id_get_element_idx(id));
+    #else
     return FWK_SUCCESS;
+    #endif
 }
 
 static int sensor_process_bind_request(fwk_id_t source_id,
@@ -149,17 +643,129 @@ static int sensor_process_bind_request(fwk_id_t source_id,
                                        fwk_id_t api_type,
                                        const void **api)
 {
-    *api = &sensor_api;
+    struct sensor_dev_ctx *ctx;
+
+    switch (fwk_id_get_api_idx(api_type)) {
+    case MOD_SENSOR_API_IDX_SENSOR:
+        *api = &sensor_api;
+        break;
+
+    case MOD_SENSOR_API_IDX_DRIVER_RESPONSE:
+        if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
+            return FWK_E_PARAM;
+
+        ctx = ctx_table + fwk_id_get_element_idx(target_id);
+        if (!fwk_id_is_equal(source_id, ctx->config->driver_id))
+            return FWK_E_ACCESS;
+
+        *api = &driver_response_api;
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
     return FWK_SUCCESS;
 }
 
+static int sensor_process_event(const struct fwk_event *event,
+                                struct fwk_event *resp_event)
+{
+    int status;
+    struct sensor_dev_ctx *ctx;
+    struct fwk_event resp;
+    struct mod_sensor_event_params *resp_params;
+    const struct mod_sensor_event_params *params;
+    const struct mod_sensor_trip_point_notification_params *trip_params;
+    uint64_t value;
+
+    fwk_assert(fwk_module_is_valid_element_id(event->target_id));
+
+    ctx = ctx_table + fwk_id_get_element_idx(event->target_id);
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_SENSOR_EVENT_IDX_READ_REQUEST:
+        /* The response is sent once the driver reports the value */
+        if (ctx->read_busy) {
+            ctx->cookie = event->cookie;
+            ctx->response_delayed = true;
+            resp_event->is_delayed_response = true;
+
+            return FWK_SUCCESS;
+        }
+
+        /* The driver reported the value before this event was processed */
+        ctx->request_pending = false;
+        resp_params = (struct mod_sensor_event_params *)resp_event->params;
+        *resp_params = (struct mod_sensor_event_params) {
+            .status = ctx->last_status,
+            .value = ctx->cached_value,
+        };
+
+        return FWK_SUCCESS;
+
+    case MOD_SENSOR_EVENT_IDX_READ_COMPLETE:
+        if (!ctx->read_busy)
+            return FWK_E_STATE;
+
+        ctx->read_busy = false;
+
+        params = (const struct mod_sensor_event_params *)event->params;
+        reading_done(ctx, params->status, params->value);
+        notify_sample(ctx);
+        check_trip_points(ctx);
+
+        if (!ctx->response_delayed)
+            return FWK_SUCCESS;
+
+        ctx->response_delayed = false;
+        ctx->request_pending = false;
+
+        status = fwk_thread_get_delayed_response(event->target_id,
+                                                 ctx->cookie, &resp);
+        if (status != FWK_SUCCESS)
+            return FWK_E_DEVICE;
+
+        resp_params = (struct mod_sensor_event_params *)resp.params;
+        *resp_params = (struct mod_sensor_event_params) {
+            .status = ctx->last_status,
+            .value = params->value,
+        };
+
+        return fwk_thread_put_event(&resp);
+
+    case MOD_SENSOR_EVENT_IDX_SAMPLE:
+        /* A reading in progress refreshes the cache already */
+        if (!ctx->read_busy && (start_reading(ctx, &value) == FWK_SUCCESS)) {
+            notify_sample(ctx);
+            check_trip_points(ctx);
+        }
+
+        return FWK_SUCCESS;
+
+    case MOD_SENSOR_EVENT_IDX_TRIP_POINT:
+        trip_params = (const struct mod_sensor_trip_point_notification_params *)
+            event->params;
+        notify_trip_point(ctx, trip_params->trip_point_idx,
+                          trip_params->rising);
+
+        return FWK_SUCCESS;
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 const struct fwk_module module_sensor = {
     .name = "SENSOR",
-    .api_count = 1,
-    .event_count = 0,
+    .api_count = MOD_SENSOR_API_IDX_COUNT,
+    .event_count = MOD_SENSOR_EVENT_IDX_COUNT,
+    .notification_count = MOD_SENSOR_NOTIFICATION_IDX_COUNT,
     .type = FWK_MODULE_TYPE_HAL,
     .init = sensor_init,
     .element_init = sensor_dev_init,
     .bind = sensor_bind,
+    .start = sensor_start,
     .process_bind_request = sensor_process_bind_request,
+    .process_event = sensor_process_event,
 };
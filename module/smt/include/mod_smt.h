@@ -30,6 +30,48 @@
 /*! The mailbox for this channel requires initialization */
 #define MOD_SMT_POLICY_INIT_MAILBOX ((uint32_t)(1 << 1))
 
+/*!
+ * \brief The payloads of this channel are accessed in place.
+ *
+ * \details The protocols read the message payload from and write the response
+ *      payload to the mailbox directly, instead of buffers mirroring it. Only
+ *      the mailbox header is copied, and it is validated once on that copy.
+ *
+ * \warning The agent can modify the message payload while it is processed,
+ *      so this policy must only be set for channels of trusted agents. The
+ *      message and response payloads share the mailbox: the protocols must
+ *      read the parameters of a message before writing its response.
+ */
+#define MOD_SMT_POLICY_ZERO_COPY    ((uint32_t)(1 << 2))
+
+/*!
+ * \brief The agent of this channel polls for the responses.
+ *
+ * \details The responses are completed by setting the free bit of the mailbox
+ *      only: the completion interrupt is never raised, whatever the flags of
+ *      the mailbox. The mailbox is released with a memory barrier rather than
+ *      with the interrupts globally disabled.
+ */
+#define MOD_SMT_POLICY_POLLED       ((uint32_t)(1 << 3))
+
+/*!
+ * \brief The mailbox of this channel is mapped cacheable.
+ *
+ * \details The module maintains the data cache over the mailbox explicitly,
+ *      through the cache API of the channel configuration. It invalidates the
+ *      mailbox header before reading it and the payload of a message before
+ *      reading the payload, over its actual length only. It cleans the header
+ *      and the payload it writes before it releases the mailbox, and cleans
+ *      the status word again once it has updated it. The copies of the
+ *      payloads then run at the speed of the cache rather than at the speed
+ *      of uncached accesses to the shared memory.
+ *
+ * \warning The address and the size of the mailbox must be multiples of the
+ *      size of a cache line, so that no other data shares a cache line with
+ *      the mailbox.
+ */
+#define MOD_SMT_POLICY_CACHED       ((uint32_t)(1 << 4))
+
 /*!
  * @}
  */
@@ -40,10 +82,10 @@
  * \details Defines the role of an entity in a channel
  */
 enum mod_smt_channel_type {
-    /*! Master channel */
+    /*! Master channel, the platform sends the messages */
     MOD_SMT_CHANNEL_TYPE_MASTER,
 
-    /*! Slave channel */
+    /*! Slave channel, the agent sends the messages */
     MOD_SMT_CHANNEL_TYPE_SLAVE,
 
     /*! Channel type count */
@@ -72,8 +114,31 @@ struct mod_smt_channel_config {
     /*! Identifier of the driver API to bind to */
     fwk_id_t driver_api_id;
 
-    /*! Identifier of the power domain that this channel depends on */
+    /*!
+     * \brief Identifier of the power domain that this channel depends on.
+     *
+     * \note When the firmware does not include the power domain module, the
+     *      channel is considered always powered on and its mailbox is
+     *      initialized when the module starts.
+     */
     fwk_id_t pd_source_id;
+
+    /*!
+     * \brief Identifier of the entity maintaining the data cache.
+     *
+     * \note Only used by the channels with the \ref MOD_SMT_POLICY_CACHED
+     *      policy.
+     */
+    fwk_id_t cache_id;
+
+    /*!
+     * \brief Identifier of the cache API of the entity to bind to, see
+     *      \ref mod_smt_cache_api.
+     *
+     * \note Only used by the channels with the \ref MOD_SMT_POLICY_CACHED
+     *      policy.
+     */
+    fwk_id_t cache_api_id;
 };
 
 /*!
@@ -93,6 +158,36 @@ struct mod_smt_driver_api {
     int (*raise_interrupt)(fwk_id_t device_id);
 };
 
+/*!
+ * \brief Cache API
+ *
+ * \details Interface used by the channels with a cacheable mailbox to
+ *      maintain the data cache over the mailbox. The ranges are extended to
+ *      whole cache lines.
+ */
+struct mod_smt_cache_api {
+    /*!
+     * \brief Write the cached data of a range back to memory.
+     *
+     * \details The function returns once the data is visible to the other
+     *      observers of the memory.
+     *
+     * \param address Address of the start of the range.
+     * \param size Size in bytes of the range.
+     */
+    void (*clean)(uintptr_t address, size_t size);
+
+    /*!
+     * \brief Discard the cached data of a range.
+     *
+     * \details The accesses to the range following the call read the memory.
+     *
+     * \param address Address of the start of the range.
+     * \param size Size in bytes of the range.
+     */
+    void (*invalidate)(uintptr_t address, size_t size);
+};
+
 /*!
  * \brief Driver input API (Implemented by SMT)
  *
@@ -120,6 +215,16 @@ enum mod_smt_api_idx {
     MOD_SMT_API_IDX_COUNT,
 };
 
+/*!
+ * \brief SCMI transport API of the module.
+ *
+ * \details The API bound with the MOD_SMT_API_IDX_SCMI_TRANSPORT API index. It
+ *      is exposed for a firmware to bind it statically as the transport API of
+ *      the SCMI module, with
+ *      BS_FIRMWARE_STATIC_APIS := scmi_transport:mod_smt_scmi_to_transport_api
+ */
+extern const struct mod_scmi_to_transport_api mod_smt_scmi_to_transport_api;
+
 /*!
  * \brief SMT notification indices.
  */
@@ -10,6 +10,8 @@
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_interrupt.h>
+#include <fwk_macros.h>
+#include <fwk_mem.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -30,6 +32,12 @@ struct smt_channel_ctx {
     /* Channel read and write cache memory areas */
     struct mod_smt_memory *in, *out;
 
+    /*
+     * Payloads read and written by the protocols. They are the payloads of the
+     * cache memory areas, or of the mailbox in zero-copy mode.
+     */
+    void *in_payload, *out_payload;
+
     /* Message processing in progrees flag */
     volatile bool locked;
 
@@ -48,6 +56,9 @@ struct smt_channel_ctx {
     /* SCMI service API */
     struct mod_scmi_from_transport_api *scmi_api;
 
+    /* Cache API, cacheable mailboxes only */
+    const struct mod_smt_cache_api *cache_api;
+
     /* Flag indicating the mailbox is ready */
     bool smt_mailbox_ready;
 };
@@ -65,6 +76,28 @@ struct smt_ctx {
 
 static struct smt_ctx smt_ctx;
 
+/*
+ * Write a range of the mailbox of a channel back to memory, if the mailbox is
+ * cacheable.
+ */
+static void clean_mailbox(const struct smt_channel_ctx *channel_ctx,
+                          const void *address, size_t size)
+{
+    if (channel_ctx->config->policies & MOD_SMT_POLICY_CACHED)
+        channel_ctx->cache_api->clean((uintptr_t)address, size);
+}
+
+/*
+ * Discard the cached copy of a range of the mailbox of a channel, if the
+ * mailbox is cacheable.
+ */
+static void invalidate_mailbox(const struct smt_channel_ctx *channel_ctx,
+                               const void *address, size_t size)
+{
+    if (channel_ctx->config->policies & MOD_SMT_POLICY_CACHED)
+        channel_ctx->cache_api->invalidate((uintptr_t)address, size);
+}
+
 /*
  * SCMI Transport API
  */
@@ -167,7 +200,7 @@ static int smt_get_payload(fwk_id_t channel_id,
     if (!channel_ctx->locked)
         return FWK_E_ACCESS;
 
-    *payload = channel_ctx->in->payload;
+    *payload = channel_ctx->in_payload;
 
     if (size != NULL) {
         *size = channel_ctx->in->length -
@@ -206,12 +239,13 @@ static int smt_write_payload(fwk_id_t channel_id,
     if (!channel_ctx->locked)
         return FWK_E_ACCESS;
 
-    memcpy(((uint8_t*)channel_ctx->out->payload) + offset, payload, size);
+    memcpy(((uint8_t*)channel_ctx->out_payload) + offset, payload, size);
 
     return FWK_SUCCESS;
 }
 
-static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
+static FWK_HOT int smt_respond(fwk_id_t channel_id, const void *payload,
+                               size_t size)
 {
     struct smt_channel_ctx *channel_ctx;
     struct mod_smt_memory *memory;
@@ -231,10 +265,37 @@ static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
     /* Copy the header from the write buffer */
     *memory = *channel_ctx->out;
 
-    /* Copy the payload from either the write buffer or the payload parameter */
-    memcpy(memory->payload,
-           (payload == NULL ? channel_ctx->out->payload : payload),
-           size);
+    /*
+     * Copy the payload from either the write buffer or the payload parameter,
+     * unless it has been written in place.
+     */
+    if (payload == NULL)
+        payload = channel_ctx->out_payload;
+    if (payload != memory->payload)
+        fwk_mem_copy(memory->payload, payload, size);
+
+    if (channel_ctx->config->policies & MOD_SMT_POLICY_POLLED) {
+        channel_ctx->locked = false;
+
+        memory->length = sizeof(memory->message_header) + size;
+
+        /*
+         * The response must be visible to the agent before the free bit. A
+         * message signaled before the free bit is set is rejected as a mailbox
+         * ownership error.
+         */
+        clean_mailbox(channel_ctx, memory, sizeof(*memory) + size);
+        __sync_synchronize();
+
+        memory->status |= MOD_SMT_MAILBOX_STATUS_FREE_MASK;
+        clean_mailbox(channel_ctx, &memory->status, sizeof(memory->status));
+
+        return FWK_SUCCESS;
+    }
+
+    /* The response is written back before the free bit, see the polled case */
+    memory->length = sizeof(memory->message_header) + size;
+    clean_mailbox(channel_ctx, memory, sizeof(*memory) + size);
 
     /*
      * NOTE: Disable interrupts for a brief period to ensure interrupts are not
@@ -247,8 +308,8 @@ static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
 
     channel_ctx->locked = false;
 
-    memory->length = sizeof(memory->message_header) + size;
     memory->status |= MOD_SMT_MAILBOX_STATUS_FREE_MASK;
+    clean_mailbox(channel_ctx, &memory->status, sizeof(memory->status));
 
     fwk_interrupt_global_enable();
 
@@ -258,19 +319,94 @@ static int smt_respond(fwk_id_t channel_id, const void *payload, size_t size)
     return FWK_SUCCESS;
 }
 
-static const struct mod_scmi_to_transport_api smt_mod_scmi_to_transport_api = {
+static int smt_transmit(fwk_id_t channel_id, uint32_t message_header,
+                        const void *payload, size_t size)
+{
+    struct smt_channel_ctx *channel_ctx;
+    struct mod_smt_memory *memory;
+    int status;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS) {
+        assert(false);
+        return status;
+    }
+
+    channel_ctx =
+        &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (channel_ctx->config->type != MOD_SMT_CHANNEL_TYPE_MASTER)
+        return FWK_E_SUPPORT;
+
+    if (((payload == NULL) && (size != 0)) ||
+        (size > channel_ctx->max_payload_size))
+        return FWK_E_PARAM;
+
+    if (!channel_ctx->smt_mailbox_ready)
+        return FWK_E_STATE;
+
+    memory = ((struct mod_smt_memory*)channel_ctx->config->mailbox_address);
+
+    invalidate_mailbox(channel_ctx, memory, sizeof(*memory));
+
+    /* The agent has not processed the previous message yet */
+    if (!(memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK))
+        return FWK_E_BUSY;
+
+    memory->message_header = message_header;
+    if (size != 0)
+        fwk_mem_copy(memory->payload, payload, size);
+    memory->length = sizeof(memory->message_header) + size;
+    clean_mailbox(channel_ctx, memory, sizeof(*memory) + size);
+
+    /* Hand the ownership of the mailbox over to the agent */
+    fwk_interrupt_global_disable();
+
+    memory->status &= ~(MOD_SMT_MAILBOX_STATUS_FREE_MASK |
+                        MOD_SMT_MAILBOX_STATUS_ERROR_MASK);
+    clean_mailbox(channel_ctx, &memory->status, sizeof(memory->status));
+
+    fwk_interrupt_global_enable();
+
+    channel_ctx->driver_api->raise_interrupt(channel_ctx->driver_id);
+
+    return FWK_SUCCESS;
+}
+
+const struct mod_scmi_to_transport_api mod_smt_scmi_to_transport_api = {
     .get_secure = smt_get_secure,
     .get_max_payload_size = smt_get_max_payload_size,
     .get_message_header = smt_get_message_header,
     .get_payload = smt_get_payload,
     .write_payload = smt_write_payload,
     .respond = smt_respond,
+    .transmit = smt_transmit,
 };
 
 /*
  * Driver handler API
  */
-static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
+static int smt_master_handler(struct smt_channel_ctx *channel_ctx)
+{
+    struct mod_smt_memory *memory;
+
+    memory = ((struct mod_smt_memory*)channel_ctx->config->mailbox_address);
+
+    invalidate_mailbox(channel_ctx, &memory->status, sizeof(memory->status));
+
+    /* The agent has not released the mailbox yet, ignore the signal */
+    if (!(memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK))
+        return FWK_SUCCESS;
+
+    /* Let SCMI send the next message, if any */
+    if (channel_ctx->scmi_api->signal_message(channel_ctx->scmi_service_id) !=
+        FWK_SUCCESS)
+        return FWK_E_HANDLER;
+
+    return FWK_SUCCESS;
+}
+
+static FWK_HOT int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
 {
     struct mod_smt_memory *memory, *in, *out;
     size_t payload_size;
@@ -284,9 +420,11 @@ static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
     in = channel_ctx->in;
     out = channel_ctx->out;
 
+    invalidate_mailbox(channel_ctx, memory, sizeof(*memory));
+
     /* Check we have ownership of the mailbox */
     if (memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK) {
-        smt_ctx.log_api->log(
+        MOD_LOG(smt_ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[SMT] Mailbox ownership error on channel %u\n",
             fwk_id_get_element_idx(channel_ctx->id));
@@ -323,7 +461,9 @@ static int smt_slave_handler(struct smt_channel_ctx *channel_ctx)
 
     /* Copy payload from shared memory to read buffer */
     payload_size = in->length - sizeof(in->message_header);
-    memcpy(in->payload, memory->payload, payload_size);
+    invalidate_mailbox(channel_ctx, memory->payload, payload_size);
+    if (channel_ctx->in_payload != memory->payload)
+        fwk_mem_copy(channel_ctx->in_payload, memory->payload, payload_size);
 
     /* Let SCMI handle the message */
     status =
@@ -348,15 +488,15 @@ static int smt_signal_message(fwk_id_t channel_id)
 
     if (!channel_ctx->smt_mailbox_ready) {
         /* Discard any message in the mailbox when not ready */
-        smt_ctx.log_api->log(MOD_LOG_GROUP_ERROR, "[SMT] Message not valid\n");
+        MOD_LOG(smt_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[SMT] Message not valid\n");
 
         return FWK_SUCCESS;
     }
 
     switch (channel_ctx->config->type) {
     case MOD_SMT_CHANNEL_TYPE_MASTER:
-        /* Not supported yet */
-        assert(false);
+        return smt_master_handler(channel_ctx);
         break;
     case MOD_SMT_CHANNEL_TYPE_SLAVE:
         return smt_slave_handler(channel_ctx);
@@ -380,7 +520,7 @@ static const struct mod_smt_driver_input_api driver_input_api = {
 static int smt_init(fwk_id_t module_id, unsigned int element_count,
                     const void *data)
 {
-    smt_ctx.channel_ctx_table = fwk_mm_calloc(element_count,
+    smt_ctx.channel_ctx_table = fwk_mm_calloc_hot(element_count,
         sizeof(smt_ctx.channel_ctx_table[0]));
     if (smt_ctx.channel_ctx_table == NULL) {
         assert(false);
@@ -395,6 +535,8 @@ static int smt_channel_init(fwk_id_t channel_id, unsigned int unused,
                             const void *data)
 {
     struct smt_channel_ctx *channel_ctx;
+    struct mod_smt_memory *memory;
+    size_t buffer_size;
 
     channel_ctx =
         &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
@@ -408,9 +550,15 @@ static int smt_channel_init(fwk_id_t channel_id, unsigned int unused,
         return FWK_E_DATA;
     }
 
+    /* In zero-copy mode, only the mailbox header is mirrored */
+    if (channel_ctx->config->policies & MOD_SMT_POLICY_ZERO_COPY)
+        buffer_size = sizeof(struct mod_smt_memory);
+    else
+        buffer_size = channel_ctx->config->mailbox_size;
+
     channel_ctx->id = channel_id;
-    channel_ctx->in = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
-    channel_ctx->out = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
+    channel_ctx->in = fwk_mm_alloc(1, buffer_size);
+    channel_ctx->out = fwk_mm_alloc(1, buffer_size);
 
     if ((channel_ctx->in == NULL) || (channel_ctx->out == NULL))
         return FWK_E_NOMEM;
@@ -424,6 +572,15 @@ static int smt_channel_init(fwk_id_t channel_id, unsigned int unused,
         return FWK_E_NOMEM;
     }
 
+    if (channel_ctx->config->policies & MOD_SMT_POLICY_ZERO_COPY) {
+        memory = (struct mod_smt_memory *)channel_ctx->config->mailbox_address;
+        channel_ctx->in_payload = memory->payload;
+        channel_ctx->out_payload = memory->payload;
+    } else {
+        channel_ctx->in_payload = channel_ctx->in->payload;
+        channel_ctx->out_payload = channel_ctx->out->payload;
+    }
+
     return FWK_SUCCESS;
 }
 
@@ -446,6 +603,18 @@ static int smt_bind(fwk_id_t id, unsigned int round)
         if (status != FWK_SUCCESS)
             return status;
         channel_ctx->driver_id = channel_ctx->config->driver_id;
+
+        if (channel_ctx->config->policies & MOD_SMT_POLICY_CACHED) {
+            status = fwk_module_bind(channel_ctx->config->cache_id,
+                                     channel_ctx->config->cache_api_id,
+                                     &channel_ctx->cache_api);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            if ((channel_ctx->cache_api->clean == NULL) ||
+                (channel_ctx->cache_api->invalidate == NULL))
+                return FWK_E_DATA;
+        }
     }
 
     if ((round == 1) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
@@ -506,7 +675,7 @@ static int smt_process_bind_request(fwk_id_t source_id,
 
     case MOD_SMT_API_IDX_SCMI_TRANSPORT:
         /* SCMI transport API */
-        *api = &smt_mod_scmi_to_transport_api;
+        *api = &mod_smt_scmi_to_transport_api;
         channel_ctx->scmi_service_id = source_id;
         break;
 
@@ -519,6 +688,37 @@ static int smt_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+/*
+ * Initialize the mailbox of a channel if required by its policies and notify
+ * that the channel is ready.
+ */
+static int smt_init_mailbox(struct smt_channel_ctx *channel_ctx)
+{
+    unsigned int notifications_sent;
+
+    if (!(channel_ctx->config->policies & MOD_SMT_POLICY_INIT_MAILBOX))
+        return FWK_SUCCESS;
+
+    *((struct mod_smt_memory *)channel_ctx->config->mailbox_address) =
+        (struct mod_smt_memory) {
+        .status = (1 << MOD_SMT_MAILBOX_STATUS_FREE_POS)
+    };
+    clean_mailbox(channel_ctx,
+                  (const void *)channel_ctx->config->mailbox_address,
+                  sizeof(struct mod_smt_memory));
+
+    /* Notify that this mailbox is initialized */
+    struct fwk_event smt_channels_initialized_notification = {
+        .id = mod_smt_notification_id_initialized,
+        .source_id = channel_ctx->id,
+    };
+
+    channel_ctx->smt_mailbox_ready = true;
+
+    return fwk_notification_notify(&smt_channels_initialized_notification,
+        &notifications_sent);
+}
+
 static int smt_start(fwk_id_t id)
 {
     struct smt_channel_ctx *ctx;
@@ -528,21 +728,25 @@ static int smt_start(fwk_id_t id)
 
     ctx = &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
 
+    #if BUILD_HAS_MOD_POWER_DOMAIN
     /* Register for power domain state transition notifications */
     return fwk_notification_subscribe(
         mod_pd_notification_id_power_state_transition,
         ctx->config->pd_source_id,
         id);
+    #else
+    /* Without power domains, the channel is always powered on */
+    return smt_init_mailbox(ctx);
+    #endif
 }
 
+#if BUILD_HAS_MOD_POWER_DOMAIN
 static int smt_process_notification(
     const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
     struct mod_pd_power_state_transition_notification_params *params;
     struct smt_channel_ctx *channel_ctx;
-    unsigned int notifications_sent;
-    int status;
 
     assert(fwk_id_is_equal(event->id,
         mod_pd_notification_id_power_state_transition));
@@ -561,28 +765,9 @@ static int smt_process_notification(
         return FWK_SUCCESS;
     }
 
-    if (channel_ctx->config->policies & MOD_SMT_POLICY_INIT_MAILBOX) {
-        /* Initialize mailbox */
-        *((struct mod_smt_memory *)channel_ctx->config->mailbox_address) =
-            (struct mod_smt_memory) {
-            .status = (1 << MOD_SMT_MAILBOX_STATUS_FREE_POS)
-        };
-
-        /* Notify that this mailbox is initialized */
-        struct fwk_event smt_channels_initialized_notification = {
-            .id = mod_smt_notification_id_initialized,
-        };
-
-        channel_ctx->smt_mailbox_ready = true;
-
-        status = fwk_notification_notify(&smt_channels_initialized_notification,
-            &notifications_sent);
-        if (status != FWK_SUCCESS)
-            return status;
-    }
-
-    return FWK_SUCCESS;
+    return smt_init_mailbox(channel_ctx);
 }
+#endif
 
 const struct fwk_module module_smt = {
     .name = "smt",
@@ -594,5 +779,7 @@ const struct fwk_module module_smt = {
     .bind = smt_bind,
     .start = smt_start,
     .process_bind_request = smt_process_bind_request,
+    #if BUILD_HAS_MOD_POWER_DOMAIN
     .process_notification = smt_process_notification,
+    #endif
 };
@@ -0,0 +1,39 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SMT_QUEUE_H
+#define SMT_QUEUE_H
+
+#include <stdint.h>
+
+/* Layout of a slot, identical to the one of an SMT mailbox */
+struct __attribute((packed)) smt_queue_slot {
+    uint32_t reserved0;
+    uint32_t status;
+    uint64_t reserved1;
+    uint32_t flags;
+    uint32_t length; /* message_header + payload */
+    uint32_t message_header;
+    uint32_t payload[];
+};
+
+#define SMT_QUEUE_SLOT_STATUS_FREE_POS 0
+#define SMT_QUEUE_SLOT_STATUS_FREE_MASK \
+    (UINT32_C(0x1) << SMT_QUEUE_SLOT_STATUS_FREE_POS)
+
+#define SMT_QUEUE_SLOT_STATUS_ERROR_POS 1
+#define SMT_QUEUE_SLOT_STATUS_ERROR_MASK \
+    (UINT32_C(0x1) << SMT_QUEUE_SLOT_STATUS_ERROR_POS)
+
+#define SMT_QUEUE_SLOT_FLAGS_IENABLED_POS 0
+#define SMT_QUEUE_SLOT_FLAGS_IENABLED_MASK \
+    (UINT32_C(0x1) << SMT_QUEUE_SLOT_FLAGS_IENABLED_POS)
+
+#define SMT_QUEUE_MIN_SLOT_SIZE \
+    (sizeof(struct smt_queue_slot) + sizeof(uint32_t))
+
+#endif /* SMT_QUEUE_H */
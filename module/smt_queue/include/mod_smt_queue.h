@@ -0,0 +1,86 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      Queued shared mailbox transport.
+ */
+
+#ifndef MOD_SMT_QUEUE_H
+#define MOD_SMT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_id.h>
+#include <mod_smt.h>
+
+/*!
+ * \ingroup GroupModules Modules
+ * \defgroup GroupSmtQueue Queued Shared Mailbox Transport
+ *
+ * \details Shared mailbox transport letting an agent send several messages
+ *      without waiting for the responses. The memory of a channel is a ring of
+ *      slots, each with the layout of an SMT mailbox. The agent writes its
+ *      messages into the slots in ring order, the platform processes them in
+ *      the same order and writes each response into the slot of its message.
+ *      The agent matches the responses with its messages by their token.
+ *
+ *      The channels are driven by the drivers of the SMT module, through the
+ *      \ref mod_smt_driver_api and \ref mod_smt_driver_input_api interfaces.
+ *
+ * \{
+ */
+
+/*!
+ * \brief Channel config.
+ */
+struct mod_smt_queue_channel_config {
+    /*!
+     * \brief Channel policies.
+     *
+     * \details Only \ref MOD_SMT_POLICY_SECURE and
+     *      \ref MOD_SMT_POLICY_INIT_MAILBOX apply to a queued channel. With the
+     *      latter, all the slots are released when the module starts.
+     */
+    uint32_t policies;
+
+    /*! Address of the first slot */
+    uintptr_t queue_address;
+
+    /*! Size of a slot in bytes */
+    size_t slot_size;
+
+    /*! Number of slots */
+    unsigned int slot_count;
+
+    /*! Identifier of the driver */
+    fwk_id_t driver_id;
+
+    /*! Identifier of the driver API to bind to */
+    fwk_id_t driver_api_id;
+};
+
+/*!
+ * \brief API indices.
+ *
+ * \details The driver input API has the index of the one of the SMT module,
+ *      so that a driver can bind back to the transport that bound to it.
+ */
+enum mod_smt_queue_api_idx {
+    /*! Driver input API, see \ref mod_smt_driver_input_api */
+    MOD_SMT_QUEUE_API_IDX_DRIVER_INPUT = MOD_SMT_API_IDX_DRIVER_INPUT,
+
+    /*! SCMI transport API */
+    MOD_SMT_QUEUE_API_IDX_SCMI_TRANSPORT,
+
+    /*! Number of APIs */
+    MOD_SMT_QUEUE_API_IDX_COUNT,
+};
+
+/*!
+ * \}
+ */
+
+#endif /* MOD_SMT_QUEUE_H */
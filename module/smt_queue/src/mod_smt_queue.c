@@ -0,0 +1,504 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *      Queued shared mailbox transport.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_interrupt.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <mod_scmi.h>
+#include <mod_smt.h>
+#include <mod_smt_queue.h>
+#include <internal/smt_queue.h>
+
+struct smt_queue_channel_ctx {
+    /* Channel identifier */
+    fwk_id_t id;
+
+    /* Channel configuration data */
+    const struct mod_smt_queue_channel_config *config;
+
+    /* Copy of the slot being processed, and response to write into it */
+    struct smt_queue_slot *in, *out;
+
+    /* Index of the slot holding the next message to process */
+    unsigned int head;
+
+    /* Message processing in progress flag */
+    volatile bool locked;
+
+    /* Maximum payload size of the channel */
+    size_t max_payload_size;
+
+    /* SCMI module service bound to the channel */
+    fwk_id_t scmi_service_id;
+
+    /* Driver API */
+    const struct mod_smt_driver_api *driver_api;
+
+    /* SCMI service API */
+    const struct mod_scmi_from_transport_api *scmi_api;
+};
+
+static struct {
+    /* Table of channel contexts */
+    struct smt_queue_channel_ctx *channel_ctx_table;
+
+    /* Number of channels */
+    unsigned int channel_count;
+} smt_queue_ctx;
+
+static struct smt_queue_slot *get_slot(
+    const struct smt_queue_channel_ctx *channel_ctx,
+    unsigned int slot_idx)
+{
+    return (struct smt_queue_slot *)(channel_ctx->config->queue_address +
+        (slot_idx * channel_ctx->config->slot_size));
+}
+
+/*
+ * Write the response into the slot being processed, release the slot to the
+ * agent and move on to the next slot.
+ */
+static void release_slot(struct smt_queue_channel_ctx *channel_ctx,
+                         const void *payload, size_t size)
+{
+    struct smt_queue_slot *slot = get_slot(channel_ctx, channel_ctx->head);
+    bool raise_interrupt;
+
+    slot->message_header = channel_ctx->out->message_header;
+    if (payload != NULL)
+        memcpy(slot->payload, payload, size);
+    slot->length = sizeof(slot->message_header) + size;
+
+    raise_interrupt = slot->flags & SMT_QUEUE_SLOT_FLAGS_IENABLED_MASK;
+
+    /*
+     * Unlocking the channel, releasing the slot and moving to the next slot
+     * happen together, so that a message signaled in between is processed
+     * once, from the right slot.
+     */
+    fwk_interrupt_global_disable();
+
+    slot->status = (slot->status & ~SMT_QUEUE_SLOT_STATUS_ERROR_MASK) |
+                   (channel_ctx->out->status &
+                    SMT_QUEUE_SLOT_STATUS_ERROR_MASK) |
+                   SMT_QUEUE_SLOT_STATUS_FREE_MASK;
+
+    if (++channel_ctx->head == channel_ctx->config->slot_count)
+        channel_ctx->head = 0;
+
+    channel_ctx->locked = false;
+
+    fwk_interrupt_global_enable();
+
+    if (raise_interrupt)
+        channel_ctx->driver_api->raise_interrupt(channel_ctx->config->driver_id);
+}
+
+/*
+ * Lock the channel if the agent has written a message into the next slot and
+ * no message is being processed.
+ */
+static bool claim_slot(struct smt_queue_channel_ctx *channel_ctx)
+{
+    bool claimed = false;
+
+    fwk_interrupt_global_disable();
+
+    if (!channel_ctx->locked &&
+        !(get_slot(channel_ctx, channel_ctx->head)->status &
+          SMT_QUEUE_SLOT_STATUS_FREE_MASK)) {
+        channel_ctx->locked = true;
+        claimed = true;
+    }
+
+    fwk_interrupt_global_enable();
+
+    return claimed;
+}
+
+/*
+ * Hand the next message of the queue, if any, over to the SCMI service. The
+ * messages with an invalid length are answered directly.
+ */
+static int process_queue(struct smt_queue_channel_ctx *channel_ctx)
+{
+    struct smt_queue_slot *slot, *in, *out;
+
+    in = channel_ctx->in;
+    out = channel_ctx->out;
+
+    while (claim_slot(channel_ctx)) {
+        slot = get_slot(channel_ctx, channel_ctx->head);
+
+        /* Mirror the slot header (payload not copied) */
+        *in = *slot;
+        *out = *slot;
+
+        out->status &= ~SMT_QUEUE_SLOT_STATUS_ERROR_MASK;
+
+        if ((in->length >= sizeof(in->message_header)) &&
+            ((in->length - sizeof(in->message_header)) <=
+             channel_ctx->max_payload_size)) {
+            memcpy(in->payload, slot->payload,
+                   in->length - sizeof(in->message_header));
+
+            if (channel_ctx->scmi_api->signal_message(
+                    channel_ctx->scmi_service_id) != FWK_SUCCESS)
+                return FWK_E_HANDLER;
+
+            return FWK_SUCCESS;
+        }
+
+        out->status |= SMT_QUEUE_SLOT_STATUS_ERROR_MASK;
+        release_slot(channel_ctx, &(int32_t){ SCMI_PROTOCOL_ERROR },
+                     sizeof(int32_t));
+    }
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * SCMI Transport API
+ */
+static int smt_queue_get_secure(fwk_id_t channel_id, bool *secure)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (secure == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    *secure = channel_ctx->config->policies & MOD_SMT_POLICY_SECURE;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_get_max_payload_size(fwk_id_t channel_id, size_t *size)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (size == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    *size = channel_ctx->max_payload_size;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_get_message_header(fwk_id_t channel_id, uint32_t *header)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (header == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *header = channel_ctx->in->message_header;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_get_payload(fwk_id_t channel_id, const void **payload,
+                                 size_t *size)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (payload == NULL)
+        return FWK_E_PARAM;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    *payload = channel_ctx->in->payload;
+
+    if (size != NULL) {
+        *size = channel_ctx->in->length -
+            sizeof(channel_ctx->in->message_header);
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_write_payload(fwk_id_t channel_id, size_t offset,
+                                   const void *payload, size_t size)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if ((payload == NULL) ||
+        (offset > channel_ctx->max_payload_size) ||
+        (size > (channel_ctx->max_payload_size - offset)))
+        return FWK_E_PARAM;
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    memcpy((uint8_t *)channel_ctx->out->payload + offset, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_respond(fwk_id_t channel_id, const void *payload,
+                             size_t size)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    if (!channel_ctx->locked)
+        return FWK_E_ACCESS;
+
+    if (size > channel_ctx->max_payload_size)
+        return FWK_E_PARAM;
+
+    if (payload == NULL)
+        payload = channel_ctx->out->payload;
+
+    release_slot(channel_ctx, payload, size);
+
+    /* The agent may have queued more messages in the meantime */
+    return process_queue(channel_ctx);
+}
+
+static int smt_queue_transmit(fwk_id_t channel_id, uint32_t message_header,
+                              const void *payload, size_t size)
+{
+    /* The queued channels carry agent to platform messages only */
+    return FWK_E_SUPPORT;
+}
+
+static const struct mod_scmi_to_transport_api smt_queue_mod_scmi_to_transport_api = {
+    .get_secure = smt_queue_get_secure,
+    .get_max_payload_size = smt_queue_get_max_payload_size,
+    .get_message_header = smt_queue_get_message_header,
+    .get_payload = smt_queue_get_payload,
+    .write_payload = smt_queue_write_payload,
+    .respond = smt_queue_respond,
+    .transmit = smt_queue_transmit,
+};
+
+/*
+ * Driver handler API
+ */
+static int smt_queue_signal_message(fwk_id_t channel_id)
+{
+    int status;
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    return process_queue(channel_ctx);
+}
+
+static const struct mod_smt_driver_input_api driver_input_api = {
+    .signal_message = smt_queue_signal_message,
+};
+
+/*
+ * Framework handlers
+ */
+static int smt_queue_init(fwk_id_t module_id, unsigned int element_count,
+                          const void *data)
+{
+    smt_queue_ctx.channel_ctx_table = fwk_mm_calloc(element_count,
+        sizeof(smt_queue_ctx.channel_ctx_table[0]));
+    if (smt_queue_ctx.channel_ctx_table == NULL) {
+        assert(false);
+        return FWK_E_NOMEM;
+    }
+
+    smt_queue_ctx.channel_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_channel_init(fwk_id_t channel_id, unsigned int unused,
+                                  const void *data)
+{
+    struct smt_queue_channel_ctx *channel_ctx;
+    const struct mod_smt_queue_channel_config *config = data;
+
+    if ((config == NULL) || (config->queue_address == 0) ||
+        (config->slot_count == 0) ||
+        (config->slot_size < SMT_QUEUE_MIN_SLOT_SIZE) ||
+        ((config->slot_size % sizeof(uint32_t)) != 0)) {
+        assert(false);
+        return FWK_E_DATA;
+    }
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+
+    channel_ctx->id = channel_id;
+    channel_ctx->config = config;
+    channel_ctx->max_payload_size =
+        config->slot_size - sizeof(struct smt_queue_slot);
+
+    channel_ctx->in = fwk_mm_alloc(1, config->slot_size);
+    channel_ctx->out = fwk_mm_alloc(1, config->slot_size);
+    if ((channel_ctx->in == NULL) || (channel_ctx->out == NULL)) {
+        assert(false);
+        return FWK_E_NOMEM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_bind(fwk_id_t id, unsigned int round)
+{
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    channel_ctx = &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
+
+    if (round == 0) {
+        return fwk_module_bind(channel_ctx->config->driver_id,
+                               channel_ctx->config->driver_api_id,
+                               &channel_ctx->driver_api);
+    }
+
+    return fwk_module_bind(channel_ctx->scmi_service_id,
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TRANSPORT),
+        &channel_ctx->scmi_api);
+}
+
+static int smt_queue_process_bind_request(fwk_id_t source_id,
+                                          fwk_id_t target_id,
+                                          fwk_id_t api_id,
+                                          const void **api)
+{
+    struct smt_queue_channel_ctx *channel_ctx;
+
+    /* Only bind to a channel (not the whole module) */
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT)) {
+        assert(false);
+        return FWK_E_PARAM;
+    }
+
+    channel_ctx =
+        &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(target_id)];
+
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_SMT_QUEUE_API_IDX_DRIVER_INPUT:
+        /* Only the driver of the channel, or one of its slots, binds back */
+        if ((fwk_id_get_module_idx(channel_ctx->config->driver_id) !=
+             fwk_id_get_module_idx(source_id)) ||
+            (fwk_id_get_element_idx(channel_ctx->config->driver_id) !=
+             fwk_id_get_element_idx(source_id))) {
+            assert(false);
+            return FWK_E_ACCESS;
+        }
+
+        *api = &driver_input_api;
+        break;
+
+    case MOD_SMT_QUEUE_API_IDX_SCMI_TRANSPORT:
+        *api = &smt_queue_mod_scmi_to_transport_api;
+        channel_ctx->scmi_service_id = source_id;
+        break;
+
+    default:
+        assert(false);
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int smt_queue_start(fwk_id_t id)
+{
+    struct smt_queue_channel_ctx *channel_ctx;
+    unsigned int slot_idx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    channel_ctx = &smt_queue_ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
+
+    if (!(channel_ctx->config->policies & MOD_SMT_POLICY_INIT_MAILBOX))
+        return FWK_SUCCESS;
+
+    for (slot_idx = 0; slot_idx < channel_ctx->config->slot_count; slot_idx++) {
+        *get_slot(channel_ctx, slot_idx) = (struct smt_queue_slot) {
+            .status = SMT_QUEUE_SLOT_STATUS_FREE_MASK,
+        };
+    }
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_smt_queue = {
+    .name = "SMT Queue",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .api_count = MOD_SMT_QUEUE_API_IDX_COUNT,
+    .init = smt_queue_init,
+    .element_init = smt_queue_channel_init,
+    .bind = smt_queue_bind,
+    .process_bind_request = smt_queue_process_bind_request,
+    .start = smt_queue_start,
+};
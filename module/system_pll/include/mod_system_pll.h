@@ -80,6 +80,16 @@ struct mod_system_pll_dev_config {
      * event.
      */
     const bool defer_initialization;
+
+    /*!
+     * If \c true, the rate changes requested through the clock HAL do not
+     * wait for the PLL to lock. They are completed asynchronously on the
+     * \ref lock_irq interrupt. Requires a status register.
+     */
+    const bool async_lock;
+
+    /*! Interrupt signalling the lock of the PLL, used if \ref async_lock. */
+    const unsigned int lock_irq;
 };
 
 /*!
@@ -8,9 +8,11 @@
 #include <stdint.h>
 #include <fwk_element.h>
 #include <fwk_errno.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <mod_clock.h>
 #include <mod_system_pll.h>
 #include <mod_power_domain.h>
@@ -21,6 +23,16 @@ struct system_pll_dev_ctx {
     uint64_t current_rate;
     enum mod_clock_state current_state;
     const struct mod_system_pll_dev_config *config;
+
+    /* Clock HAL element bound to the PLL, if any */
+    fwk_id_t clock_id;
+
+    /* Clock HAL driver response API, bound only if the lock is asynchronous */
+    const struct mod_clock_drv_response_api *drv_response_api;
+
+    /* The PLL is locking to the rate below, the lock interrupt is enabled */
+    bool lock_pending;
+    uint64_t pending_rate;
 };
 
 /* Module context */
@@ -76,26 +88,68 @@ static unsigned int freq_to_half_cycle_ps(unsigned int freq_hz)
     return 500000000UL / freq_khz;
 }
 
+static bool is_locked(const struct system_pll_dev_ctx *ctx)
+{
+    return (*ctx->config->status_reg & ctx->config->lock_flag_mask) != 0;
+}
+
 /*
- * Clock driver API functions
+ * Wait for the lock of the PLL from its lock interrupt.
+ *
+ * \retval FWK_SUCCESS The PLL has already locked.
+ * \retval FWK_PENDING The rate change is completed by the lock interrupt.
  */
+static int start_async_lock(struct system_pll_dev_ctx *ctx, uint64_t rate)
+{
+    unsigned int irq = ctx->config->lock_irq;
 
-static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
-                               enum mod_clock_round_mode round_mode)
+    if (is_locked(ctx))
+        return FWK_SUCCESS;
+
+    ctx->pending_rate = rate;
+    ctx->lock_pending = true;
+
+    fwk_interrupt_clear_pending(irq);
+    fwk_interrupt_enable(irq);
+
+    /* The PLL may have locked before the interrupt was enabled */
+    if (ctx->lock_pending && is_locked(ctx)) {
+        fwk_interrupt_disable(irq);
+        ctx->lock_pending = false;
+        return FWK_SUCCESS;
+    }
+
+    return FWK_PENDING;
+}
+
+static void lock_isr(uintptr_t param)
+{
+    struct system_pll_dev_ctx *ctx = module_ctx.dev_ctx_table + param;
+
+    if (!ctx->lock_pending || !is_locked(ctx))
+        return;
+
+    fwk_interrupt_disable(ctx->config->lock_irq);
+    ctx->lock_pending = false;
+    ctx->current_rate = ctx->pending_rate;
+
+    ctx->drv_response_api->request_complete(ctx->clock_id, FWK_SUCCESS);
+}
+
+static int set_rate(struct system_pll_dev_ctx *ctx, uint64_t rate,
+                    enum mod_clock_round_mode round_mode, bool allow_async)
 {
+    int status;
     uint64_t rounded_rate;
     uint64_t rounded_rate_alt;
     unsigned int picoseconds;
-    struct system_pll_dev_ctx *ctx;
-
-    if (!fwk_module_is_valid_element_id(dev_id))
-    return FWK_E_PARAM;
-
-    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
 
     if (ctx->current_state == MOD_CLOCK_STATE_STOPPED)
         return FWK_E_PWRSTATE;
 
+    if (ctx->lock_pending)
+        return FWK_E_BUSY;
+
     /* If the given rate is not attainable as-is then round as requested */
     if ((rate % ctx->config->min_step) > 0) {
         switch (round_mode) {
@@ -133,9 +187,13 @@ static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
 
     *ctx->config->control_reg = picoseconds;
 
-    if (ctx->config->status_reg != NULL) {
+    if (allow_async && (ctx->drv_response_api != NULL)) {
+        status = start_async_lock(ctx, rounded_rate);
+        if (status == FWK_PENDING)
+            return status;
+    } else if (ctx->config->status_reg != NULL) {
         /* Wait until the PLL has locked */
-        while ((*ctx->config->status_reg & ctx->config->lock_flag_mask) == 0)
+        while (!is_locked(ctx))
             continue;
     }
 
@@ -144,6 +202,37 @@ static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
     return FWK_SUCCESS;
 }
 
+/*
+ * Clock driver API functions
+ */
+
+static int system_pll_set_rate(fwk_id_t dev_id, uint64_t rate,
+                               enum mod_clock_round_mode round_mode)
+{
+    struct system_pll_dev_ctx *ctx;
+
+    if (!fwk_module_is_valid_element_id(dev_id))
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    return set_rate(ctx, rate, round_mode, false);
+}
+
+/* Set rate function of the API bound by the clock HAL */
+static int system_pll_hal_set_rate(fwk_id_t dev_id, uint64_t rate,
+                                   enum mod_clock_round_mode round_mode)
+{
+    struct system_pll_dev_ctx *ctx;
+
+    if (!fwk_module_is_valid_element_id(dev_id))
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(dev_id);
+
+    return set_rate(ctx, rate, round_mode, true);
+}
+
 static int system_pll_get_rate(fwk_id_t dev_id, uint64_t *rate)
 {
     struct system_pll_dev_ctx *ctx;
@@ -238,7 +327,7 @@ static int system_pll_power_state_change(
         rate = ctx->config->initial_rate;
     }
 
-    return system_pll_set_rate(dev_id, rate, MOD_CLOCK_ROUND_MODE_NONE);
+    return set_rate(ctx, rate, MOD_CLOCK_ROUND_MODE_NONE, false);
 }
 
 static int system_pll_power_state_pending_change(
@@ -274,6 +363,22 @@ static const struct mod_clock_drv_api api_system_pll = {
     .process_pending_power_transition = system_pll_power_state_pending_change,
 };
 
+/*
+ * API bound by the clock HAL, which handles the asynchronous completion of the
+ * rate changes. The other entities, such as the CSS clocks, expect the PLL to
+ * have locked on return.
+ */
+static const struct mod_clock_drv_api api_system_pll_hal = {
+    .set_rate = system_pll_hal_set_rate,
+    .get_rate = system_pll_get_rate,
+    .get_rate_from_index = system_pll_get_rate_from_index,
+    .set_state = system_pll_set_state,
+    .get_state = system_pll_get_state,
+    .get_range = system_pll_get_range,
+    .process_power_transition = system_pll_power_state_change,
+    .process_pending_power_transition = system_pll_power_state_pending_change,
+};
+
 /*
  * Framework handler functions
  */
@@ -297,6 +402,7 @@ static int system_pll_init(fwk_id_t module_id, unsigned int element_count,
 static int system_pll_element_init(fwk_id_t element_id, unsigned int unused,
                                   const void *data)
 {
+    int status;
     struct system_pll_dev_ctx *ctx;
     const struct mod_system_pll_dev_config *dev_config = data;
 
@@ -306,20 +412,63 @@ static int system_pll_element_init(fwk_id_t element_id, unsigned int unused,
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
     ctx->config = dev_config;
+    ctx->clock_id = FWK_ID_NONE;
+
+    if (ctx->config->async_lock) {
+        if (ctx->config->status_reg == NULL)
+            return FWK_E_DATA;
+
+        status = fwk_interrupt_set_isr_param(ctx->config->lock_irq, lock_isr,
+            fwk_id_get_element_idx(element_id));
+        if (status != FWK_SUCCESS)
+            return status;
+    }
 
     if (ctx->config->defer_initialization)
         return FWK_SUCCESS;
 
     ctx->initialized = true;
     ctx->current_state = MOD_CLOCK_STATE_RUNNING;
-    return system_pll_set_rate(element_id, ctx->config->initial_rate,
-                                MOD_CLOCK_ROUND_MODE_NONE);
+    return set_rate(ctx, ctx->config->initial_rate, MOD_CLOCK_ROUND_MODE_NONE,
+                    false);
+}
+
+static int system_pll_bind(fwk_id_t id, unsigned int round)
+{
+    struct system_pll_dev_ctx *ctx;
+
+    /* The clock HAL binds to the PLLs during the first round */
+    if ((round == 0) || !fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(id);
+
+    if (!ctx->config->async_lock ||
+        fwk_id_is_equal(ctx->clock_id, FWK_ID_NONE))
+        return FWK_SUCCESS;
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_CLOCK),
+        FWK_ID_API(FWK_MODULE_IDX_CLOCK, MOD_CLOCK_API_TYPE_DRIVER_RESPONSE),
+        &ctx->drv_response_api);
 }
 
 static int system_pll_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
                                         fwk_id_t api_type, const void **api)
 {
-    *api = &api_system_pll;
+    struct system_pll_dev_ctx *ctx;
+
+    if (fwk_id_get_module_idx(requester_id) != FWK_MODULE_IDX_CLOCK) {
+        *api = &api_system_pll;
+        return FWK_SUCCESS;
+    }
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_PARAM;
+
+    ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(id);
+    ctx->clock_id = requester_id;
+
+    *api = &api_system_pll_hal;
     return FWK_SUCCESS;
 }
 
@@ -330,5 +479,6 @@ const struct fwk_module module_system_pll = {
     .event_count = 0,
     .init = system_pll_init,
     .element_init = system_pll_element_init,
+    .bind = system_pll_bind,
     .process_bind_request = system_pll_process_bind_request,
 };
@@ -11,6 +11,9 @@
 #ifndef MOD_SYSTEM_POWER_H
 #define MOD_SYSTEM_POWER_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <fwk_id.h>
 #include <mod_power_domain.h>
 
@@ -35,6 +38,17 @@ struct mod_system_power_ext_ppu_config {
 
     /*! API identifier */
     fwk_id_t api_id;
+
+    /*!
+     * \brief Power the PPU on in parallel with the system PPUs.
+     *
+     * \details By default, the extended PPUs are powered on once the system
+     *      PPUs are on. The transition of a PPU which does not depend on the
+     *      system PPUs can instead be initiated before those of the system
+     *      PPUs, and be waited for after them, shortening the wake-up of the
+     *      system.
+     */
+    bool parallel_power_on;
 };
 
 /*! Element configuration */
@@ -48,6 +62,11 @@ struct mod_system_power_dev_config {
     /*!
      * \brief Pointer to a table defining the power states this system PPU will
      *      be set for each system state.
+     *
+     * \details When the system wakes up from
+     *      ::MOD_SYSTEM_POWER_POWER_STATE_SLEEP0, the system PPUs whose power
+     *      state is the same in the sleep state as in ::MOD_PD_STATE_ON are
+     *      left as they are.
      */
     const uint8_t *sys_state_table;
 };
@@ -76,6 +95,146 @@ struct mod_system_power_config {
 
     /*! Initial System Power state after power-on */
     enum mod_pd_state initial_system_power_state;
+
+    /*!
+     * \brief Pointer to the table of the interrupts which can wake the system
+     *      up.
+     *
+     * \details When the SoC wakeup interrupt is taken, the first of these
+     *      interrupts found pending is recorded as the source of the wakeup,
+     *      see \ref mod_system_power_wakeup_source. Optional, may be NULL.
+     */
+    const unsigned int *wakeup_irqs;
+
+    /*! Number of interrupts in the table of the wakeup interrupts */
+    size_t wakeup_irq_count;
+
+    /*!
+     * \brief Address of the statistics region, as seen by the SCP.
+     *
+     * \details Zero if the statistics are not supported. The region is laid
+     *      out as a \ref mod_system_power_stats structure, and is meant to be
+     *      shared with the agents.
+     */
+    uintptr_t stats_addr;
+
+    /*! Size of the statistics region, in bytes */
+    size_t stats_size;
+
+    /*!
+     * \brief Identifier of the timer used to timestamp the statistics.
+     *
+     * \details Only used when the statistics are supported. The statistics
+     *      require the timer module.
+     */
+    fwk_id_t stats_timer_id;
+};
+
+/*!
+ * \brief Sources of the wakeups of the system.
+ */
+enum mod_system_power_wakeup_source {
+    /*! The system was powered on by a request, without a wakeup interrupt */
+    MOD_SYSTEM_POWER_WAKEUP_SOURCE_REQUEST,
+
+    /*! SoC wakeup interrupt, with none of the wakeup interrupts pending */
+    MOD_SYSTEM_POWER_WAKEUP_SOURCE_SOC_WAKEUP,
+
+    /*!
+     * \brief First wakeup interrupt.
+     *
+     * \details The source of a wakeup by the wakeup interrupt 'i' of
+     *      \ref mod_system_power_config::wakeup_irqs is
+     *      MOD_SYSTEM_POWER_WAKEUP_SOURCE_IRQ + i.
+     */
+    MOD_SYSTEM_POWER_WAKEUP_SOURCE_IRQ,
+};
+
+/*!
+ * \brief Signature of the statistics region, "SPWR".
+ */
+#define MOD_SYSTEM_POWER_STATS_SIGNATURE UINT32_C(0x53505752)
+
+/*!
+ * \brief Revision of the layout of the statistics region.
+ */
+#define MOD_SYSTEM_POWER_STATS_REVISION UINT16_C(0x1)
+
+/*!
+ * \brief Statistics of a system power state.
+ *
+ * \details The latency of the entry to a state runs from the request of the
+ *      state to the report of the transitions of all the system PPUs. The
+ *      latency of the exit from a state runs from the SoC wakeup interrupt,
+ *      or from the request of the next state when the system was not woken up
+ *      by an interrupt, to the report of the next state.
+ */
+struct mod_system_power_stats_state {
+    /*! Number of times the state was entered */
+    uint64_t entry_count;
+
+    /*!
+     * \brief Time spent in the state.
+     *
+     * \note The time spent in the current state since its entry is not
+     *      included.
+     */
+    uint64_t residency;
+
+    /*! Total latency of the entries to the state */
+    uint64_t entry_latency_total;
+
+    /*! Total latency of the exits from the state */
+    uint64_t exit_latency_total;
+
+    /*! Worst-case latency of an entry to the state */
+    uint32_t entry_latency_max;
+
+    /*! Worst-case latency of an exit from the state */
+    uint32_t exit_latency_max;
+};
+
+/*!
+ * \brief Layout of the statistics region.
+ *
+ * \details The agents read the region without issuing any message. All the
+ *      times are in microseconds, from the timer configured with
+ *      \ref mod_system_power_config::stats_timer_id. The SCP increments
+ *      \ref sequence before and after each update of the statistics. An agent
+ *      reading an odd value, or different values before and after reading the
+ *      statistics, must read them again.
+ */
+struct mod_system_power_stats {
+    /*! \ref MOD_SYSTEM_POWER_STATS_SIGNATURE */
+    uint32_t signature;
+
+    /*! \ref MOD_SYSTEM_POWER_STATS_REVISION */
+    uint16_t revision;
+
+    /*! Number of system power states, ::MOD_SYSTEM_POWER_POWER_STATE_COUNT */
+    uint16_t state_count;
+
+    /*! Update sequence number */
+    uint32_t sequence;
+
+    /*! Current system power state */
+    uint32_t current_state;
+
+    /*! Time of the entry to the current system power state */
+    uint64_t current_state_entry_time;
+
+    /*! Source of the last wakeup, see \ref mod_system_power_wakeup_source */
+    uint32_t last_wakeup_source;
+
+    /*! Number of wakeup sources, the length of \ref wakeup_count */
+    uint32_t wakeup_source_count;
+
+    /*! Statistics of each system power state */
+    struct mod_system_power_stats_state
+        states[MOD_SYSTEM_POWER_POWER_STATE_COUNT];
+
+    /*! Number of wakeups from each source */
+    uint64_t wakeup_count[];
 };
 
 /*! Platform-specific interrupt commands indices */
@@ -8,7 +8,9 @@
  *     System Power Support.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <fwk_assert.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
@@ -19,6 +21,7 @@
 #include <mod_log.h>
 #include <mod_system_power.h>
 #include <mod_power_domain.h>
+#include <mod_timer.h>
 
 /* SoC wakeup composite state */
 #define MOD_SYSTEM_POWER_SOC_WAKEUP_STATE \
@@ -39,6 +42,9 @@ struct system_power_dev_ctx {
 
     /* Power domain driver API pointer */
     const struct mod_pd_driver_api *sys_ppu_api;
+
+    /* Whether the system PPU is left as it is when waking up from SLEEP0 */
+    bool skip_on_wakeup;
 };
 
 /* Module context */
@@ -52,6 +58,12 @@ struct system_power_ctx {
     /* Number of elements */
     unsigned int dev_count;
 
+    /* Number of system PPUs transitioned when waking up from SLEEP0 */
+    unsigned int wakeup_dev_count;
+
+    /* Number of system PPU transitions of the ongoing system transition */
+    unsigned int transition_dev_count;
+
     /* Pointer to array of extended PPU power domain driver APIs */
     const struct mod_pd_driver_api **ext_ppu_apis;
 
@@ -75,6 +87,21 @@ struct system_power_ctx {
 
     /* Pointer to module config */
     const struct mod_system_power_config *config;
+
+    /* Timer API pointer, NULL if the statistics are not supported */
+    const struct mod_timer_api *timer_api;
+
+    /* Statistics region, NULL if the statistics are not supported */
+    volatile struct mod_system_power_stats *stats;
+
+    /* Time of the request of the ongoing system transition */
+    uint64_t request_time;
+
+    /* Time of the last SoC wakeup interrupt */
+    uint64_t wakeup_time;
+
+    /* Source of the wakeup, until the system is reported on */
+    enum mod_system_power_wakeup_source wakeup_source;
 };
 
 static struct system_power_ctx system_power_ctx;
@@ -83,31 +110,220 @@ static struct system_power_ctx system_power_ctx;
  * Static helpers
  */
 
-static void ext_ppus_set_state(enum mod_pd_state state)
+/*
+ * Get the current time in microseconds, zero if the time is not available.
+ */
+static uint64_t get_time(void)
+{
+    #if BUILD_HAS_MOD_TIMER
+    int status;
+    uint64_t time;
+
+    if (system_power_ctx.timer_api == NULL)
+        return 0;
+
+    status = system_power_ctx.timer_api->get_time(
+        system_power_ctx.config->stats_timer_id, &time);
+    if (status != FWK_SUCCESS)
+        return 0;
+
+    return time;
+    #else
+    return 0;
+    #endif
+}
+
+static void update_latency(volatile uint64_t *total, volatile uint32_t *max,
+                           uint64_t latency)
+{
+    *total += latency;
+    if (latency > *max)
+        *max = (latency > UINT32_MAX) ? UINT32_MAX : latency;
+}
+
+/*
+ * Update the statistics once the system has entered a new power state.
+ */
+static void stats_update(unsigned int previous_state, unsigned int new_state)
+{
+    volatile struct mod_system_power_stats *stats = system_power_ctx.stats;
+    volatile struct mod_system_power_stats_state *state_stats;
+    uint64_t now, exit_start;
+
+    if (stats == NULL)
+        return;
+
+    now = get_time();
+
+    stats->sequence++;
+
+    state_stats = &stats->states[previous_state];
+    state_stats->residency += now - stats->current_state_entry_time;
+
+    if (system_power_ctx.wakeup_source ==
+        MOD_SYSTEM_POWER_WAKEUP_SOURCE_REQUEST)
+        exit_start = system_power_ctx.request_time;
+    else
+        exit_start = system_power_ctx.wakeup_time;
+    update_latency(&state_stats->exit_latency_total,
+                   &state_stats->exit_latency_max, now - exit_start);
+
+    state_stats = &stats->states[new_state];
+    state_stats->entry_count++;
+    update_latency(&state_stats->entry_latency_total,
+                   &state_stats->entry_latency_max,
+                   now - system_power_ctx.request_time);
+
+    stats->current_state = new_state;
+    stats->current_state_entry_time = now;
+
+    if ((new_state == MOD_PD_STATE_ON) && (previous_state != MOD_PD_STATE_ON)) {
+        stats->last_wakeup_source = system_power_ctx.wakeup_source;
+        stats->wakeup_count[system_power_ctx.wakeup_source]++;
+    }
+
+    stats->sequence++;
+}
+
+static int stats_init(void)
+{
+    const struct mod_system_power_config *config = system_power_ctx.config;
+    volatile struct mod_system_power_stats *stats;
+    unsigned int source_count;
+    size_t size;
+
+    if (config->stats_addr == 0)
+        return FWK_SUCCESS;
+
+    source_count = MOD_SYSTEM_POWER_WAKEUP_SOURCE_IRQ +
+                   config->wakeup_irq_count;
+    size = sizeof(struct mod_system_power_stats) +
+           (source_count * sizeof(stats->wakeup_count[0]));
+    if (size > config->stats_size)
+        return FWK_E_NOMEM;
+
+    stats = (volatile struct mod_system_power_stats *)config->stats_addr;
+    memset((void *)stats, 0, size);
+
+    stats->signature = MOD_SYSTEM_POWER_STATS_SIGNATURE;
+    stats->revision = MOD_SYSTEM_POWER_STATS_REVISION;
+    stats->state_count = MOD_SYSTEM_POWER_POWER_STATE_COUNT;
+    stats->current_state = system_power_ctx.state;
+    stats->current_state_entry_time = get_time();
+    stats->wakeup_source_count = source_count;
+
+    system_power_ctx.stats = stats;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Identify the source of a wakeup from the wakeup interrupts left pending.
+ */
+static enum mod_system_power_wakeup_source get_wakeup_source(void)
+{
+    const struct mod_system_power_config *config = system_power_ctx.config;
+    unsigned int i;
+    bool pending;
+
+    for (i = 0; i < config->wakeup_irq_count; i++) {
+        if ((fwk_interrupt_is_pending(config->wakeup_irqs[i], &pending) ==
+             FWK_SUCCESS) && pending)
+            return MOD_SYSTEM_POWER_WAKEUP_SOURCE_IRQ + i;
+    }
+
+    return MOD_SYSTEM_POWER_WAKEUP_SOURCE_SOC_WAKEUP;
+}
+
+/*
+ * The PPUs are transitioned in parallel: the transitions of the PPUs whose
+ * driver can initiate a transition without waiting for its completion are all
+ * initiated before waiting for any of them.
+ */
+static void ext_ppus_request_state(enum mod_pd_state state,
+                                   bool parallel_power_on)
 {
     unsigned int i;
+    const struct mod_pd_driver_api *api;
+    const struct mod_system_power_ext_ppu_config *ext_ppu;
 
     for (i = 0; i < system_power_ctx.config->ext_ppus_count; i++) {
-        system_power_ctx.ext_ppu_apis[i]->set_state(
-            system_power_ctx.config->ext_ppus[i].ppu_id,
-            state);
+        api = system_power_ctx.ext_ppu_apis[i];
+        ext_ppu = &system_power_ctx.config->ext_ppus[i];
+
+        if (ext_ppu->parallel_power_on != parallel_power_on)
+            continue;
+
+        if (api->request_state != NULL)
+            api->request_state(ext_ppu->ppu_id, state);
+        else
+            api->set_state(ext_ppu->ppu_id, state);
     }
 }
 
-static int set_system_power_state(unsigned int state)
+static void ext_ppus_wait_state(void)
+{
+    unsigned int i;
+    const struct mod_pd_driver_api *api;
+
+    for (i = 0; i < system_power_ctx.config->ext_ppus_count; i++) {
+        api = system_power_ctx.ext_ppu_apis[i];
+
+        if (api->request_state != NULL)
+            api->wait_state(system_power_ctx.config->ext_ppus[i].ppu_id);
+    }
+}
+
+static void ext_ppus_set_state(enum mod_pd_state state)
+{
+    ext_ppus_request_state(state, false);
+    ext_ppus_request_state(state, true);
+    ext_ppus_wait_state();
+}
+
+/*
+ * When waking up from SLEEP0, only the system PPUs whose state differs between
+ * SLEEP0 and ON are transitioned, and only their transitions are waited for
+ * before the system power domain is reported on.
+ */
+static int set_system_power_state(unsigned int state, bool wakeup)
 {
     int status;
     unsigned int i;
     struct system_power_dev_ctx *dev_ctx;
     const uint8_t *sys_state_table;
 
+    system_power_ctx.transition_dev_count = wakeup ?
+        system_power_ctx.wakeup_dev_count : system_power_ctx.dev_count;
+
     for (i = 0; i < system_power_ctx.dev_count; i++) {
         dev_ctx = &system_power_ctx.dev_ctx_table[i];
 
+        if (wakeup && dev_ctx->skip_on_wakeup)
+            continue;
+
         sys_state_table = dev_ctx->config->sys_state_table;
 
-        status = dev_ctx->sys_ppu_api->set_state(dev_ctx->config->sys_ppu_id,
-                                                 sys_state_table[state]);
+        if (dev_ctx->sys_ppu_api->request_state != NULL) {
+            status = dev_ctx->sys_ppu_api->request_state(
+                dev_ctx->config->sys_ppu_id, sys_state_table[state]);
+        } else {
+            status = dev_ctx->sys_ppu_api->set_state(
+                dev_ctx->config->sys_ppu_id, sys_state_table[state]);
+        }
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    /* Wait for the transitions initiated above, in parallel */
+    for (i = 0; i < system_power_ctx.dev_count; i++) {
+        dev_ctx = &system_power_ctx.dev_ctx_table[i];
+
+        if ((dev_ctx->sys_ppu_api->request_state == NULL) ||
+            (wakeup && dev_ctx->skip_on_wakeup))
+            continue;
+
+        status = dev_ctx->sys_ppu_api->wait_state(dev_ctx->config->sys_ppu_id);
         if (status != FWK_SUCCESS)
             return status;
     }
@@ -123,6 +339,7 @@ static int system_power_set_state(fwk_id_t pd_id, unsigned int state)
 {
     int status;
     unsigned int soc_wakeup_irq;
+    bool wakeup;
 
     status = fwk_module_check_call(pd_id);
     if (status != FWK_SUCCESS)
@@ -134,6 +351,7 @@ static int system_power_set_state(fwk_id_t pd_id, unsigned int state)
     soc_wakeup_irq = system_power_ctx.config->soc_wakeup_irq;
 
     system_power_ctx.requested_state = state;
+    system_power_ctx.request_time = get_time();
 
     switch (state) {
     case MOD_PD_STATE_ON:
@@ -146,11 +364,17 @@ static int system_power_set_state(fwk_id_t pd_id, unsigned int state)
                 return FWK_E_DEVICE;
         }
 
-        status = set_system_power_state(state);
+        wakeup = (system_power_ctx.state ==
+                  MOD_SYSTEM_POWER_POWER_STATE_SLEEP0);
+
+        ext_ppus_request_state(MOD_PD_STATE_ON, true);
+
+        status = set_system_power_state(state, wakeup);
         if (status != FWK_SUCCESS)
             return status;
 
-        ext_ppus_set_state(MOD_PD_STATE_ON);
+        ext_ppus_request_state(MOD_PD_STATE_ON, false);
+        ext_ppus_wait_state();
 
         break;
 
@@ -167,7 +391,7 @@ static int system_power_set_state(fwk_id_t pd_id, unsigned int state)
                 return FWK_E_DEVICE;
         }
 
-        status = set_system_power_state(state);
+        status = set_system_power_state(state, false);
         if (status != FWK_SUCCESS)
             return status;
 
@@ -194,7 +418,7 @@ static int system_power_set_state(fwk_id_t pd_id, unsigned int state)
 
         ext_ppus_set_state(MOD_PD_STATE_OFF);
 
-        status = set_system_power_state(state);
+        status = set_system_power_state(state, false);
         if (status != FWK_SUCCESS)
             return status;
 
@@ -242,6 +466,11 @@ static void soc_wakeup_handler(void)
     int status;
     uint32_t state = MOD_SYSTEM_POWER_SOC_WAKEUP_STATE;
 
+    if (system_power_ctx.stats != NULL) {
+        system_power_ctx.wakeup_time = get_time();
+        system_power_ctx.wakeup_source = get_wakeup_source();
+    }
+
     status =
         system_power_ctx.mod_pd_restricted_api->set_composite_state_async(
             mod_system_power_soc_wakeup_pd_id, false, state);
@@ -263,6 +492,7 @@ static int system_power_report_power_state_transition(fwk_id_t dev_id,
     unsigned int state)
 {
     int status;
+    unsigned int previous_state;
     static unsigned int sys_ppu_transition_count = 0;
 
     status = fwk_module_check_call(dev_id);
@@ -271,13 +501,17 @@ static int system_power_report_power_state_transition(fwk_id_t dev_id,
 
     sys_ppu_transition_count++;
 
-    if (sys_ppu_transition_count < system_power_ctx.dev_count)
+    if (sys_ppu_transition_count < system_power_ctx.transition_dev_count)
         return FWK_SUCCESS;
 
+    previous_state = system_power_ctx.state;
     system_power_ctx.state = system_power_ctx.requested_state;
 
     sys_ppu_transition_count = 0;
 
+    stats_update(previous_state, system_power_ctx.state);
+    system_power_ctx.wakeup_source = MOD_SYSTEM_POWER_WAKEUP_SOURCE_REQUEST;
+
     return system_power_ctx.mod_pd_driver_input_api->
         report_power_state_transition(system_power_ctx.mod_pd_system_id,
                                       system_power_ctx.state);
@@ -304,12 +538,21 @@ static int system_power_mod_init(fwk_id_t module_id,
     system_power_ctx.config = config = data;
     system_power_ctx.mod_pd_system_id = FWK_ID_NONE;
     system_power_ctx.dev_count = element_count;
+    system_power_ctx.transition_dev_count = element_count;
 
     system_power_ctx.dev_ctx_table =
         fwk_mm_calloc(element_count, sizeof(struct system_power_dev_ctx));
     if (system_power_ctx.dev_ctx_table == NULL)
         return FWK_E_NOMEM;
 
+    #if !BUILD_HAS_MOD_TIMER
+    if (config->stats_addr != 0)
+        return FWK_E_SUPPORT;
+    #endif
+
+    if ((config->wakeup_irq_count > 0) && (config->wakeup_irqs == NULL))
+        return FWK_E_DATA;
+
     if (system_power_ctx.config->ext_ppus_count > 0) {
         system_power_ctx.ext_ppu_apis = fwk_mm_calloc(
             system_power_ctx.config->ext_ppus_count,
@@ -343,6 +586,12 @@ static int system_power_mod_element_init(fwk_id_t element_id,
     if (dev_ctx->config->sys_state_table == NULL)
         return FWK_E_DATA;
 
+    dev_ctx->skip_on_wakeup =
+        (dev_ctx->config->sys_state_table[MOD_SYSTEM_POWER_POWER_STATE_SLEEP0]
+         == dev_ctx->config->sys_state_table[MOD_PD_STATE_ON]);
+    if (!dev_ctx->skip_on_wakeup)
+        system_power_ctx.wakeup_dev_count++;
+
     return FWK_SUCCESS;
 }
 
@@ -392,6 +641,15 @@ static int system_power_bind(fwk_id_t id, unsigned int round)
         if (status != FWK_SUCCESS)
             return status;
 
+        #if BUILD_HAS_MOD_TIMER
+        if (config->stats_addr != 0) {
+            status = fwk_module_bind(config->stats_timer_id,
+                MOD_TIMER_API_ID_TIMER, &system_power_ctx.timer_api);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+        #endif
+
         return fwk_module_bind(fwk_module_id_power_domain,
             mod_pd_api_id_restricted,
             &system_power_ctx.mod_pd_restricted_api);
@@ -445,6 +703,7 @@ static int system_power_process_bind_request(fwk_id_t requester_id,
 static int system_power_start(fwk_id_t id)
 {
     int status;
+    unsigned int i;
 
     if (system_power_ctx.driver_api->platform_interrupts != NULL) {
         status = system_power_ctx.driver_api->platform_interrupts(
@@ -453,11 +712,26 @@ static int system_power_start(fwk_id_t id)
             return status;
     }
 
+    /*
+     * At least one system PPU has to report its transition for the system
+     * power domain to be reported on. If none differs between SLEEP0 and ON,
+     * they are all transitioned.
+     */
+    if (system_power_ctx.wakeup_dev_count == 0) {
+        for (i = 0; i < system_power_ctx.dev_count; i++)
+            system_power_ctx.dev_ctx_table[i].skip_on_wakeup = false;
+
+        system_power_ctx.wakeup_dev_count = system_power_ctx.dev_count;
+    }
+
     /* Configure initial power state */
     system_power_ctx.state =
         (unsigned int)system_power_ctx.config->initial_system_power_state;
 
-    return FWK_SUCCESS;
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    return stats_init();
 }
 
 const struct fwk_module module_system_power = {
@@ -0,0 +1,126 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Thermal governor.
+ */
+
+#ifndef MOD_THERMAL_H
+#define MOD_THERMAL_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupModules Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupThermal Thermal Governor
+ *
+ * \details The module throttles the DVFS domains of thermal zones when their
+ *      temperature rises. The elements of the module are the zones.
+ *
+ *      The temperature sensor of each zone is read periodically and compared
+ *      to the trip points of the zone. A trip point is crossed when the
+ *      temperature reaches it, and crossed back once the temperature has
+ *      fallen below it by the hysteresis of the trip point. The governor of
+ *      the zone derives from the temperature and the crossed trip points the
+ *      share of the operating points of its domains that are permitted, and
+ *      the maximum frequency limit of each domain is set accordingly. The
+ *      minimum limits are left unchanged.
+ *
+ *      In firmware including the SCMI performance protocol, the agents
+ *      subscribed to the PERFORMANCE_LIMITS_CHANGED notifications of a domain
+ *      are notified once its limits have changed.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Governor.
+ */
+enum mod_thermal_governor {
+    /*!
+     * \brief Step-wise governor.
+     *
+     * \details Each crossed trip point removes an equal share of the operating
+     *      points, the domains run at their lowest operating point once all
+     *      the trip points are crossed.
+     */
+    MOD_THERMAL_GOVERNOR_STEP_WISE,
+
+    /*!
+     * \brief Proportional governor.
+     *
+     * \details Once the first trip point is crossed, the share of the
+     *      operating points decreases linearly with the temperature, from all
+     *      of them at the first trip point to the lowest one at the last trip
+     *      point. The zone must have two trip points at least.
+     */
+    MOD_THERMAL_GOVERNOR_PROPORTIONAL,
+};
+
+/*!
+ * \brief Trip point.
+ */
+struct mod_thermal_trip_point {
+    /*! Temperature of the trip point, in the unit of the sensor */
+    uint64_t temperature;
+
+    /*!
+     * \brief Hysteresis of the trip point, in the unit of the sensor.
+     *
+     * \details The trip point is crossed back once the temperature is lower
+     *      than the temperature of the trip point minus the hysteresis.
+     */
+    uint64_t hysteresis;
+};
+
+/*!
+ * \brief Zone configuration.
+ */
+struct mod_thermal_zone_config {
+    /*! Identifier of the temperature sensor of the zone */
+    fwk_id_t sensor_id;
+
+    /*! Table of the identifiers of the DVFS domains of the zone */
+    const fwk_id_t *dvfs_domain_id_table;
+
+    /*! Number of DVFS domains */
+    unsigned int dvfs_domain_count;
+
+    /*! Table of trip points, in ascending order of temperature */
+    const struct mod_thermal_trip_point *trip_point_table;
+
+    /*! Number of trip points */
+    unsigned int trip_point_count;
+
+    /*! Governor of the zone */
+    enum mod_thermal_governor governor;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_thermal_config {
+    /*! Sub-element identifier of the alarm polling the sensors */
+    fwk_id_t alarm_id;
+
+    /*! Polling period in milliseconds */
+    unsigned int polling_period_ms;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_THERMAL_H */
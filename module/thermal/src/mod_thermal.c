@@ -0,0 +1,395 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Thermal governor.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_thread.h>
+#include <mod_dvfs.h>
+#include <mod_log.h>
+#include <mod_sensor.h>
+#include <mod_thermal.h>
+#include <mod_timer.h>
+#if BUILD_HAS_MOD_SCMI_PERF
+#include <mod_scmi_perf.h>
+#endif
+
+/* Share of the operating points permitted to an unthrottled zone, Q16 */
+#define OUTPUT_MAX (UINT32_C(1) << 16)
+
+struct zone_ctx {
+    /* Zone configuration */
+    const struct mod_thermal_zone_config *config;
+
+    /* Number of trip points crossed */
+    unsigned int trip_level;
+
+    /* Share of the operating points permitted to the domains, Q16 */
+    uint32_t output;
+
+    /* A reading of the sensor is in progress */
+    bool reading_pending;
+};
+
+static struct {
+    /* Module configuration */
+    const struct mod_thermal_config *config;
+
+    /* Table of zone contexts */
+    struct zone_ctx *zone_ctx_table;
+
+    /* Number of zones */
+    unsigned int zone_count;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Sensor API */
+    const struct mod_sensor_api *sensor_api;
+
+    /* DVFS domain API */
+    const struct mod_dvfs_domain_api *dvfs_api;
+
+    #if BUILD_HAS_MOD_SCMI_PERF
+    /* SCMI performance notification API */
+    const struct mod_scmi_perf_notification_api *scmi_perf_api;
+    #endif
+} ctx;
+
+/*
+ * Static functions
+ */
+
+/*
+ * Set the maximum frequency limit of a domain to the operating point selected
+ * by the output of the governor, among the operating points above the minimum
+ * limit.
+ */
+static int apply_output(fwk_id_t domain_id, uint32_t output)
+{
+    const struct mod_dvfs_domain_api *dvfs_api = ctx.dvfs_api;
+    struct mod_dvfs_frequency_limits limits;
+    struct mod_dvfs_opp opp;
+    size_t opp_count;
+    size_t min_idx;
+    size_t max_idx;
+    int status;
+
+    status = dvfs_api->get_opp_count(domain_id, &opp_count);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = dvfs_api->get_frequency_limits(domain_id, &limits);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (min_idx = 0; min_idx < (opp_count - 1); min_idx++) {
+        status = dvfs_api->get_nth_opp(domain_id, min_idx, &opp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (opp.frequency >= limits.minimum)
+            break;
+    }
+
+    max_idx = min_idx + (size_t)(((uint64_t)(opp_count - 1 - min_idx) *
+                                  output) / OUTPUT_MAX);
+
+    status = dvfs_api->get_nth_opp(domain_id, max_idx, &opp);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (opp.frequency == limits.maximum)
+        return FWK_SUCCESS;
+
+    limits.maximum = opp.frequency;
+
+    return dvfs_api->set_frequency_limits_async(domain_id, &limits);
+}
+
+/* Update the number of trip points crossed, with their hysteresis */
+static void update_trip_level(struct zone_ctx *zone_ctx, uint64_t temperature)
+{
+    const struct mod_thermal_trip_point *trip_point_table =
+        zone_ctx->config->trip_point_table;
+    const struct mod_thermal_trip_point *trip_point;
+    unsigned int trip_level = zone_ctx->trip_level;
+
+    while ((trip_level < zone_ctx->config->trip_point_count) &&
+           (temperature >= trip_point_table[trip_level].temperature))
+        trip_level++;
+
+    while (trip_level > 0) {
+        trip_point = &trip_point_table[trip_level - 1];
+        if ((temperature + trip_point->hysteresis) >= trip_point->temperature)
+            break;
+
+        trip_level--;
+    }
+
+    if (trip_level == zone_ctx->trip_level)
+        return;
+
+    zone_ctx->trip_level = trip_level;
+
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_WARNING,
+            "[THERMAL] Zone %u: %u trip point(s) crossed, temperature %u\n",
+            (unsigned int)(zone_ctx - ctx.zone_ctx_table), trip_level,
+            (unsigned int)temperature);
+}
+
+static uint32_t get_output(const struct zone_ctx *zone_ctx,
+                           uint64_t temperature)
+{
+    const struct mod_thermal_zone_config *config = zone_ctx->config;
+    uint64_t first;
+    uint64_t last;
+
+    if (zone_ctx->trip_level == 0)
+        return OUTPUT_MAX;
+
+    if (config->governor == MOD_THERMAL_GOVERNOR_STEP_WISE) {
+        return (uint32_t)(((uint64_t)OUTPUT_MAX *
+                           (config->trip_point_count - zone_ctx->trip_level)) /
+                          config->trip_point_count);
+    }
+
+    first = config->trip_point_table[0].temperature;
+    last = config->trip_point_table[config->trip_point_count - 1].temperature;
+
+    /* The first trip point is still crossed within its hysteresis */
+    if (temperature <= first)
+        return OUTPUT_MAX;
+
+    if (temperature >= last)
+        return 0;
+
+    return (uint32_t)(((last - temperature) * OUTPUT_MAX) / (last - first));
+}
+
+static void update_zone(struct zone_ctx *zone_ctx, uint64_t temperature)
+{
+    const struct mod_thermal_zone_config *config = zone_ctx->config;
+    unsigned int domain_idx;
+
+    update_trip_level(zone_ctx, temperature);
+    zone_ctx->output = get_output(zone_ctx, temperature);
+
+    for (domain_idx = 0; domain_idx < config->dvfs_domain_count; domain_idx++)
+        apply_output(config->dvfs_domain_id_table[domain_idx],
+                     zone_ctx->output);
+}
+
+static void poll_zone(struct zone_ctx *zone_ctx)
+{
+    uint64_t temperature;
+    int status;
+
+    /* The reading of the previous period is still in progress */
+    if (zone_ctx->reading_pending)
+        return;
+
+    status = ctx.sensor_api->get_value(zone_ctx->config->sensor_id,
+                                       &temperature);
+    if (status == FWK_SUCCESS)
+        update_zone(zone_ctx, temperature);
+    else if (status == FWK_PENDING)
+        zone_ctx->reading_pending = true;
+}
+
+static void complete_reading(fwk_id_t sensor_id,
+                             const struct mod_sensor_event_params *params)
+{
+    struct zone_ctx *zone_ctx;
+    unsigned int zone_idx;
+
+    for (zone_idx = 0; zone_idx < ctx.zone_count; zone_idx++) {
+        zone_ctx = &ctx.zone_ctx_table[zone_idx];
+        if (!zone_ctx->reading_pending ||
+            !fwk_id_is_equal(zone_ctx->config->sensor_id, sensor_id))
+            continue;
+
+        zone_ctx->reading_pending = false;
+
+        if (params->status == FWK_SUCCESS)
+            update_zone(zone_ctx, params->value);
+
+        return;
+    }
+}
+
+/*
+ * Framework handlers
+ */
+
+static int thermal_init(fwk_id_t module_id, unsigned int element_count,
+                        const void *data)
+{
+    const struct mod_thermal_config *config = data;
+
+    if ((element_count == 0) || (config == NULL) ||
+        (config->polling_period_ms == 0))
+        return FWK_E_DATA;
+
+    ctx.zone_ctx_table = fwk_mm_calloc(element_count,
+                                       sizeof(ctx.zone_ctx_table[0]));
+    if (ctx.zone_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    ctx.zone_count = element_count;
+    ctx.config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int thermal_element_init(fwk_id_t element_id,
+                                unsigned int sub_element_count,
+                                const void *data)
+{
+    const struct mod_thermal_zone_config *config = data;
+    struct zone_ctx *zone_ctx;
+    unsigned int trip_idx;
+
+    if ((config == NULL) || (config->dvfs_domain_count == 0) ||
+        (config->dvfs_domain_id_table == NULL) ||
+        (config->trip_point_count == 0) ||
+        (config->trip_point_table == NULL))
+        return FWK_E_DATA;
+
+    for (trip_idx = 1; trip_idx < config->trip_point_count; trip_idx++) {
+        if (config->trip_point_table[trip_idx].temperature <=
+            config->trip_point_table[trip_idx - 1].temperature)
+            return FWK_E_DATA;
+    }
+
+    switch (config->governor) {
+    case MOD_THERMAL_GOVERNOR_STEP_WISE:
+        break;
+
+    case MOD_THERMAL_GOVERNOR_PROPORTIONAL:
+        if (config->trip_point_count < 2)
+            return FWK_E_DATA;
+        break;
+
+    default:
+        return FWK_E_DATA;
+    }
+
+    zone_ctx = &ctx.zone_ctx_table[fwk_id_get_element_idx(element_id)];
+    zone_ctx->config = config;
+    zone_ctx->output = OUTPUT_MAX;
+
+    return FWK_SUCCESS;
+}
+
+static int thermal_bind(fwk_id_t id, unsigned int round)
+{
+    int status;
+
+    if ((round != 0) || fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+                             MOD_LOG_API_ID, &ctx.log_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(ctx.config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                             &ctx.alarm_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SENSOR),
+                             mod_sensor_api_id_sensor, &ctx.sensor_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    #if BUILD_HAS_MOD_SCMI_PERF
+    status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_PERF),
+                             mod_scmi_perf_api_id_notification,
+                             &ctx.scmi_perf_api);
+    if (status != FWK_SUCCESS)
+        return status;
+    #endif
+
+    return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_DVFS),
+                           mod_dvfs_api_id_dvfs, &ctx.dvfs_api);
+}
+
+static int thermal_start(fwk_id_t id)
+{
+    if (fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    return ctx.alarm_api->start(ctx.config->alarm_id,
+                                ctx.config->polling_period_ms,
+                                MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+static int thermal_process_event(const struct fwk_event *event,
+                                 struct fwk_event *resp_event)
+{
+    const struct mod_dvfs_event_params_set_frequency_limits_response *params;
+    unsigned int zone_idx;
+
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        for (zone_idx = 0; zone_idx < ctx.zone_count; zone_idx++)
+            poll_zone(&ctx.zone_ctx_table[zone_idx]);
+
+        return FWK_SUCCESS;
+    }
+
+    /* Value of a pending sensor reading */
+    if (fwk_id_is_equal(event->id, mod_sensor_event_id_read_request)) {
+        complete_reading(event->source_id,
+            (const struct mod_sensor_event_params *)event->params);
+
+        return FWK_SUCCESS;
+    }
+
+    /*
+     * The limits of a domain have been applied. A failed request is retried
+     * in the next polling period.
+     */
+    if (fwk_id_is_equal(event->id, mod_dvfs_event_id_set_frequency_limits)) {
+        params = (const struct
+            mod_dvfs_event_params_set_frequency_limits_response *)
+            event->params;
+
+        #if BUILD_HAS_MOD_SCMI_PERF
+        if (params->status == FWK_SUCCESS)
+            ctx.scmi_perf_api->notify_limits_changed(event->source_id);
+        #else
+        (void)params;
+        #endif
+
+        return FWK_SUCCESS;
+    }
+
+    return FWK_E_PARAM;
+}
+
+const struct fwk_module module_thermal = {
+    .name = "Thermal",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .init = thermal_init,
+    .element_init = thermal_element_init,
+    .bind = thermal_bind,
+    .start = thermal_start,
+    .process_event = thermal_process_event,
+};
@@ -58,6 +58,38 @@ enum mod_timer_api_idx {
 #define MOD_TIMER_API_ID_ALARM FWK_ID_API(FWK_MODULE_IDX_TIMER, \
                                           MOD_TIMER_API_IDX_ALARM)
 
+/*!
+ * \brief Timer module event indices
+ */
+enum mod_timer_event_idx {
+    /*! Deferred alarm event index */
+    MOD_TIMER_EVENT_IDX_ALARM,
+
+    /*! Number of events */
+    MOD_TIMER_EVENT_IDX_COUNT,
+};
+
+#if BUILD_HAS_MOD_TIMER
+/*!
+ * \brief Deferred alarm event identifier
+ *
+ * \details Event sent to the entity bound to an alarm when the alarm, started
+ *      without a callback function, triggers. The source of the event is the
+ *      alarm and its parameters are described by
+ *      ::mod_timer_alarm_event_params.
+ */
+static const fwk_id_t mod_timer_event_id_alarm =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_TIMER, MOD_TIMER_EVENT_IDX_ALARM);
+#endif
+
+/*!
+ * \brief Parameters of the deferred alarm event
+ */
+struct mod_timer_alarm_event_params {
+    /*! Parameter given when the alarm was started */
+    uintptr_t param;
+};
+
 /*!
  * \brief Alarm type.
  */
@@ -161,6 +193,21 @@ struct mod_timer_api {
      */
     int (*get_counter)(fwk_id_t dev_id, uint64_t *counter);
 
+    /*!
+     * \brief Get the current time of a given timer in microseconds (µS).
+     *
+     * \details The time is the value of the counter of the timer, converted
+     *      to microseconds.
+     *
+     * \param dev_id Element identifier that identifies the timer device.
+     * \param[out] microseconds The current time, in microseconds.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM The \p microseconds parameter is NULL.
+     * \retval One of the other specific error codes described by the framework.
+     */
+    int (*get_time)(fwk_id_t dev_id, uint64_t *microseconds);
+
     /*!
      * \brief Delay execution by synchronously waiting for a specified amount
      *      of time.
@@ -201,6 +248,60 @@ struct mod_timer_api {
                 bool (*cond)(void*),
                 void *data);
 
+    /*!
+     * \brief Delay execution by sleeping for a specified amount of time.
+     *
+     * \details Same as \ref delay, except that the timer is armed to trigger
+     *      at the end of the delay and the calling thread waits for interrupts
+     *      in between, see ::fwk_thread_wait_for_interrupt. The processor is
+     *      then put into a low-power state in single-thread builds and the
+     *      other threads keep running in multi-thread builds.
+     *
+     * \note Interrupts are serviced during the delay. The function cannot be
+     *      called from an interrupt handler as the timer interrupt could not
+     *      be taken.
+     *
+     * \param dev_id Element identifier that identifies the timer device.
+     * \param microseconds The amount of time, given in microseconds, to delay.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_ACCESS The function was called from an interrupt handler.
+     * \retval One of the other specific error codes described by the framework.
+     */
+    int (*delay_sleep)(fwk_id_t dev_id, uint32_t microseconds);
+
+    /*!
+     * \brief Delay execution, sleeping until a given condition is true or until
+     *      a given timeout period has been exceeded, whichever occurs first.
+     *
+     * \details Same as \ref wait, except that the calling thread sleeps as
+     *      with \ref delay_sleep in between the evaluations of the condition.
+     *      The condition is evaluated with the interrupts disabled, each time
+     *      the calling thread is woken up.
+     *
+     * \note The condition is expected to be met as a result of an interrupt,
+     *      or to be met within the timeout period otherwise. It is not
+     *      evaluated in between interrupts.
+     *
+     * \param dev_id Element identifier that identifies the timer device.
+     * \param microseconds Maximum amount of time, in microseconds, to wait for
+     *      the given condition to be met.
+     * \param cond Pointer to the function that evaluates the condition and
+     *      which returns a boolean value indicating if it has been met or not.
+     * \param data Pointer passed to the condition function when it is called.
+     *
+     * \retval FWK_SUCCESS The condition was met before the timeout period
+     *      elapsed.
+     * \retval FWK_E_TIMEOUT The timeout period elapsed before the condition was
+     *      met.
+     * \retval FWK_E_ACCESS The function was called from an interrupt handler.
+     * \retval One of the other specific error codes described by the framework.
+     */
+    int (*wait_sleep)(fwk_id_t dev_id,
+                      uint32_t microseconds,
+                      bool (*cond)(void*),
+                      void *data);
+
     /*!
      * \brief Get the time difference, expressed in timer ticks, between the
      *      current timer counter value and the given timestamp. This represents
@@ -253,7 +354,10 @@ struct mod_timer_alarm_api {
     /*!
      * \brief Start an alarm so it will trigger after a specified time.
      *
-     * \details When an alarm is triggered, \p callback is called.
+     * \details When an alarm is triggered, \p callback is called. If
+     *     \p callback is NULL, the delivery of the alarm is deferred instead:
+     *     the ::mod_timer_event_id_alarm event is sent to the entity that bound
+     *     to the alarm and is processed in the thread context.
      *
      *     If the alarm is periodic, it will automatically be started again
      *     with the same time delay after it triggers.
@@ -265,12 +369,16 @@ struct mod_timer_alarm_api {
      * \warning \p callback will be called from within an interrupt service
      *      routine.
      *
+     * \note A deferred alarm event sent before the alarm is stopped or started
+     *      again is still delivered.
+     *
      * \param alarm_id Sub-element identifier of the alarm.
      * \param milliseconds The time delay, given in milliseconds, until the
      *     alarm should trigger.
      * \param type \ref MOD_TIMER_ALARM_TYPE_ONCE or
      *     \ref MOD_TIMER_ALARM_TYPE_PERIODIC.
-     * \param callback Pointer to the callback function.
+     * \param callback Pointer to the callback function, NULL for a deferred
+     *     alarm.
      * \param param Parameter given to the callback function when called.
      *
      * \pre \p alarm_id must be a valid sub-element alarm identifier that has
@@ -284,6 +392,56 @@ struct mod_timer_alarm_api {
                  void (*callback)(uintptr_t param),
                  uintptr_t param);
 
+    /*!
+     * \brief Start an alarm so it will trigger after a specified time given
+     *     in microseconds.
+     *
+     * \details This function behaves as \ref start but for a time delay
+     *     given in microseconds, for the alarms that must trigger after less
+     *     than a millisecond or with a sub-millisecond accuracy.
+     *
+     * \warning \p callback will be called from within an interrupt service
+     *      routine.
+     *
+     * \param alarm_id Sub-element identifier of the alarm.
+     * \param microseconds The time delay, given in microseconds, until the
+     *     alarm should trigger.
+     * \param type \ref MOD_TIMER_ALARM_TYPE_ONCE or
+     *     \ref MOD_TIMER_ALARM_TYPE_PERIODIC.
+     * \param callback Pointer to the callback function, NULL for a deferred
+     *     alarm.
+     * \param param Parameter given to the callback function when called.
+     *
+     * \pre \p alarm_id must be a valid sub-element alarm identifier that has
+     *     previously been bound to.
+     *
+     * \retval FWK_SUCCESS The alarm was started.
+     */
+    int (*start_us)(fwk_id_t alarm_id,
+                    uint32_t microseconds,
+                    enum mod_timer_alarm_type type,
+                    void (*callback)(uintptr_t param),
+                    uintptr_t param);
+
+    /*!
+     * \brief Set the slack of an alarm.
+     *
+     * \details The slack is the time after its deadline within which the
+     *     alarm may trigger. The timer triggers the alarms whose slacks overlap
+     *     with a single interrupt, at the latest time acceptable to all of
+     *     them. The slack is taken into account the next time the alarm is
+     *     started, and is zero until it is set.
+     *
+     * \param alarm_id Sub-element identifier of the alarm.
+     * \param microseconds The slack, given in microseconds.
+     *
+     * \pre \p alarm_id must be a valid sub-element alarm identifier that has
+     *     previously been bound to.
+     *
+     * \retval FWK_SUCCESS The slack was set.
+     */
+    int (*set_slack)(fwk_id_t alarm_id, uint32_t microseconds);
+
     /*!
      * \brief Stop a previously started alarm.
      *
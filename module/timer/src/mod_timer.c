@@ -17,7 +17,6 @@
 #include <fwk_event.h>
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
-#include <fwk_list.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -34,21 +33,47 @@ struct dev_ctx {
     struct mod_timer_driver_api *driver;
     /* Identifier of the driver that controls the device */
     fwk_id_t driver_dev_id;
+    /* Frequency of the counter, zero until it has been read from the driver */
+    uint32_t frequency;
+    /* Reciprocal of the frequency, see _divide() */
+    uint64_t frequency_reciprocal;
     /* Storage for all alarms */
     struct alarm_ctx *alarm_pool;
-    /* Queue of active alarms */
-    struct fwk_dlist alarms_active;
+    /* Root of the pairing heap of active alarms, the next alarm to trigger */
+    struct alarm_ctx *alarms_active;
+    /* Number of active alarms with a slack */
+    unsigned int slack_alarm_count;
+    /* Timestamp at which the thread sleeping in the timer is woken up */
+    uint64_t wakeup_timestamp;
+    /* Flag indicating if the timer is armed for the wake-up timestamp */
+    bool wakeup_armed;
+    /* Timestamp the device is programmed to trigger at */
+    uint64_t programmed_timestamp;
+    /* Flag indicating if the device is programmed for programmed_timestamp */
+    bool programmed;
 };
 
 /* Alarm item context (sub-element) */
 struct alarm_ctx {
-    /* List node */
-    struct fwk_dlist_node node;
+    /* First child in the heap of active alarms */
+    struct alarm_ctx *child;
+    /* Next sibling in the heap of active alarms */
+    struct alarm_ctx *sibling;
+    /* Previous sibling, or parent for the first child, NULL for the root */
+    struct alarm_ctx *prev;
     /* Time between starting this alarm and it triggering */
     uint32_t microseconds;
     /* Timestamp of the time this alarm will trigger */
     uint64_t timestamp;
-    /* Pointer to the callback function */
+    /* Time after the timestamp within which this alarm may trigger */
+    uint32_t slack_us;
+    /* Same as slack_us, in timer ticks */
+    uint64_t slack;
+    /* Identifier of the alarm */
+    fwk_id_t id;
+    /* Identifier of the entity bound to the alarm */
+    fwk_id_t owner_id;
+    /* Pointer to the callback function, NULL for a deferred alarm */
     void (*callback)(uintptr_t param);
     /* Parameter of the callback function */
     uintptr_t param;
@@ -76,21 +101,118 @@ static void timer_isr(uintptr_t ctx_ptr);
  * Internal functions
  */
 
+/* Reciprocal of the number of microseconds in a second, see _divide() */
+#define MICROSECONDS_RECIPROCAL (UINT64_MAX / FWK_MHZ)
+
+/* Get the upper 64 bits of the 128-bit product of two 64-bit values */
+static uint64_t _multiply_high(uint64_t a, uint64_t b)
+{
+    uint64_t a_low = (uint32_t)a;
+    uint64_t a_high = a >> 32;
+    uint64_t b_low = (uint32_t)b;
+    uint64_t b_high = b >> 32;
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t cross;
+
+    cross = (low_low >> 32) + (uint32_t)high_low + low_high;
+
+    return (a_high * b_high) + (high_low >> 32) + (cross >> 32);
+}
+
+/*
+ * Divide a 64-bit value by a 32-bit divisor without a 64-bit division, which
+ * the Cortex-M processors do not support in hardware. The reciprocal of the
+ * divisor is UINT64_MAX / divisor. The quotient estimated from it is at most
+ * two below the exact quotient, and corrected using the remainder.
+ */
+static uint64_t _divide(uint64_t dividend, uint32_t divisor,
+                        uint64_t reciprocal, uint64_t *remainder)
+{
+    uint64_t quotient;
+    uint64_t rest;
+
+    quotient = _multiply_high(dividend, reciprocal);
+    rest = dividend - (quotient * divisor);
+
+    while (rest >= divisor) {
+        quotient++;
+        rest -= divisor;
+    }
+
+    if (remainder != NULL)
+        *remainder = rest;
+
+    return quotient;
+}
+
+/*
+ * The frequency of the counter and its reciprocal are read once from the
+ * driver, on the first conversion or when the device is started.
+ */
+static int _cache_frequency(struct dev_ctx *ctx)
+{
+    int status;
+    uint32_t frequency;
+
+    if (ctx->frequency != 0)
+        return FWK_SUCCESS;
+
+    status = ctx->driver->get_frequency(ctx->driver_dev_id, &frequency);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (frequency == 0)
+        return FWK_E_DEVICE;
+
+    ctx->frequency_reciprocal = UINT64_MAX / frequency;
+    ctx->frequency = frequency;
+
+    return FWK_SUCCESS;
+}
+
 static int _time_to_timestamp(struct dev_ctx *ctx,
                               uint32_t microseconds,
                               uint64_t *timestamp)
 {
     int status;
-    uint32_t frequency;
 
     assert(ctx != NULL);
     assert(timestamp != NULL);
 
-    status = ctx->driver->get_frequency(ctx->driver_dev_id, &frequency);
+    status = _cache_frequency(ctx);
     if (status != FWK_SUCCESS)
         return status;
 
-    *timestamp = ((uint64_t)frequency * microseconds) / 1000000;
+    *timestamp = _divide((uint64_t)ctx->frequency * microseconds, FWK_MHZ,
+                         MICROSECONDS_RECIPROCAL, NULL);
+
+    return FWK_SUCCESS;
+}
+
+static int _timestamp_to_time(struct dev_ctx *ctx,
+                              uint64_t timestamp,
+                              uint64_t *microseconds)
+{
+    int status;
+    uint64_t seconds;
+    uint64_t remainder;
+
+    assert(ctx != NULL);
+    assert(microseconds != NULL);
+
+    status = _cache_frequency(ctx);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Split the conversion to avoid overflowing the timestamp */
+    seconds = _divide(timestamp, ctx->frequency, ctx->frequency_reciprocal,
+                      &remainder);
+
+    *microseconds = (seconds * FWK_MHZ) +
+        _divide(remainder * FWK_MHZ, ctx->frequency,
+                ctx->frequency_reciprocal, NULL);
 
     return FWK_SUCCESS;
 }
@@ -141,49 +263,266 @@ static int _remaining(const struct dev_ctx *ctx,
     return FWK_SUCCESS;
 }
 
+/*
+ * Get the timestamp at which the timer should trigger: the latest time within
+ * the slack of all the alarms whose deadlines are before it. The ISR then
+ * processes all these alarms at once.
+ */
+static uint64_t _get_trigger_timestamp(const struct dev_ctx *ctx)
+{
+    const struct alarm_ctx *root = ctx->alarms_active;
+    const struct alarm_ctx *alarm = root;
+    uint64_t trigger;
+
+    if (ctx->slack_alarm_count == 0)
+        return root->timestamp;
+
+    trigger = root->timestamp + root->slack;
+
+    /*
+     * Only the alarms whose deadlines are before the trigger timestamp can
+     * lower it. As the heap is ordered by deadline, the children of the other
+     * alarms are skipped.
+     */
+    while (true) {
+        if (alarm->timestamp <= trigger) {
+            trigger = FWK_MIN(trigger, alarm->timestamp + alarm->slack);
+
+            if (alarm->child != NULL) {
+                alarm = alarm->child;
+                continue;
+            }
+        }
+
+        /* Move to the next sibling, climbing up the heap when needed */
+        while ((alarm != root) && (alarm->sibling == NULL)) {
+            while (alarm->prev->child != alarm)
+                alarm = alarm->prev;
+            alarm = alarm->prev;
+        }
+
+        if (alarm == root)
+            return trigger;
+
+        alarm = alarm->sibling;
+    }
+}
+
 static void _configure_timer_with_next_alarm(struct dev_ctx *ctx)
 {
-    struct alarm_ctx *alarm_head;
+    bool armed = false;
+    uint64_t trigger = 0;
 
     assert(ctx != NULL);
 
-    alarm_head = (struct alarm_ctx *)fwk_list_head(&ctx->alarms_active);
-    if (alarm_head != NULL) {
-        /* Configure timer device */
-        ctx->driver->set_timer(ctx->driver_dev_id, alarm_head->timestamp);
+    if (ctx->alarms_active != NULL) {
+        trigger = _get_trigger_timestamp(ctx);
+        armed = true;
+    }
+
+    if (ctx->wakeup_armed && (!armed || (ctx->wakeup_timestamp < trigger))) {
+        trigger = ctx->wakeup_timestamp;
+        armed = true;
+    }
+
+    if (armed) {
+        /*
+         * The device is only reprogrammed when the trigger timestamp changes,
+         * for instance not when an alarm later than the next one is started
+         * or stopped.
+         */
+        if (!ctx->programmed || (ctx->programmed_timestamp != trigger)) {
+            ctx->programmed = (ctx->driver->set_timer(ctx->driver_dev_id,
+                                                      trigger) == FWK_SUCCESS);
+            ctx->programmed_timestamp = trigger;
+        }
+
         ctx->driver->enable(ctx->driver_dev_id);
     }
 }
 
+/*
+ * Sleep until the counter reaches a limit or, if a condition function is
+ * given, until the condition is met. The timer is armed for the limit so that
+ * the calling thread is woken up even if no other interrupt is raised.
+ *
+ * Only one thread can sleep in a timer in single-thread builds, as the
+ * function cannot be called from an interrupt handler. In multi-thread builds,
+ * the sleeping threads yield rather than rely on the timer interrupt to be
+ * woken up.
+ */
+static int _sleep(struct dev_ctx *ctx, uint64_t counter_limit,
+                  bool (*cond)(void *), void *data)
+{
+    int status;
+    uint64_t counter;
+    unsigned int interrupt;
+
+    if (fwk_interrupt_get_current(&interrupt) == FWK_SUCCESS)
+        return FWK_E_ACCESS;
+
+    /* The condition and the counter are checked with the interrupts disabled */
+    fwk_interrupt_global_disable();
+
+    ctx->driver->disable(ctx->driver_dev_id);
+    ctx->wakeup_timestamp = counter_limit;
+    ctx->wakeup_armed = true;
+    _configure_timer_with_next_alarm(ctx);
+
+    while (true) {
+        if ((cond != NULL) && cond(data)) {
+            status = FWK_SUCCESS;
+            break;
+        }
+
+        status = ctx->driver->get_counter(ctx->driver_dev_id, &counter);
+        if (status != FWK_SUCCESS) {
+            status = FWK_E_DEVICE;
+            break;
+        }
+
+        /*
+         * If the time to wait is over, check the condition one last time.
+         */
+        if (counter >= counter_limit) {
+            if ((cond != NULL) && !cond(data))
+                status = FWK_E_TIMEOUT;
+            break;
+        }
+
+        fwk_thread_wait_for_interrupt();
+
+        /* Let the pending interrupts be serviced */
+        fwk_interrupt_global_enable();
+        fwk_interrupt_global_disable();
+    }
+
+    /* Disarm the timer for the wake-up timestamp */
+    ctx->driver->disable(ctx->driver_dev_id);
+    fwk_interrupt_clear_pending(ctx->config->timer_irq);
+    ctx->wakeup_armed = false;
+    _configure_timer_with_next_alarm(ctx);
+
+    fwk_interrupt_global_enable();
+
+    return status;
+}
+
+/*
+ * The active alarms are kept in a pairing heap ordered by timestamp. Inserting
+ * an alarm is done in constant time, and removing an alarm is done in
+ * amortized logarithmic time, whatever the position of the alarm.
+ */
+
+/* Meld two heaps and return the root of the resulting heap */
+static struct alarm_ctx *_heap_meld(struct alarm_ctx *heap,
+                                    struct alarm_ctx *other)
+{
+    struct alarm_ctx *tmp;
+
+    if (heap == NULL)
+        return other;
+    if (other == NULL)
+        return heap;
+
+    if (other->timestamp < heap->timestamp) {
+        tmp = heap;
+        heap = other;
+        other = tmp;
+    }
+
+    /* The root of the other heap becomes the first child of the heap */
+    other->prev = heap;
+    other->sibling = heap->child;
+    if (heap->child != NULL)
+        heap->child->prev = other;
+    heap->child = other;
+
+    return heap;
+}
+
+/*
+ * Meld a list of sibling heaps by pairs from left to right, then meld the
+ * pairs from right to left. This is done iteratively to bound the stack usage.
+ */
+static struct alarm_ctx *_heap_merge_pairs(struct alarm_ctx *first)
+{
+    struct alarm_ctx *heap, *other, *next;
+    struct alarm_ctx *pairs = NULL;
+    struct alarm_ctx *root = NULL;
+
+    while (first != NULL) {
+        heap = first;
+        other = heap->sibling;
+        next = (other != NULL) ? other->sibling : NULL;
+
+        heap->sibling = heap->prev = NULL;
+        if (other != NULL)
+            other->sibling = other->prev = NULL;
+
+        /* Stack the pairs, linked through their sibling pointer */
+        heap = _heap_meld(heap, other);
+        heap->sibling = pairs;
+        pairs = heap;
+
+        first = next;
+    }
+
+    while (pairs != NULL) {
+        next = pairs->sibling;
+        pairs->sibling = NULL;
+        root = _heap_meld(root, pairs);
+        pairs = next;
+    }
+
+    return root;
+}
+
 static void _insert_alarm_ctx_into_active_queue(struct dev_ctx *ctx,
                                                 struct alarm_ctx *alarm_new)
 {
-    struct fwk_dlist_node *alarm_node;
-    struct alarm_ctx *alarm;
-
     assert(ctx != NULL);
     assert(alarm_new != NULL);
 
-    /*
-     * Search though the active queue to find the correct place to insert the
-     * new alarm item
-     */
-    alarm_node = fwk_list_head(&ctx->alarms_active);
-    alarm = FWK_LIST_GET(alarm_node, struct alarm_ctx, node);
-
-    while ((alarm_node != NULL) && (alarm_new->timestamp > alarm->timestamp)) {
-        alarm_node = fwk_list_next(&ctx->alarms_active, alarm_node);
-        alarm = FWK_LIST_GET(alarm_node, struct alarm_ctx, node);
-    }
+    alarm_new->child = alarm_new->sibling = alarm_new->prev = NULL;
+    ctx->alarms_active = _heap_meld(ctx->alarms_active, alarm_new);
 
-    /* Insert alarm_new just BEFORE the alarm that was found */
-    fwk_list_insert(&ctx->alarms_active,
-                    &(alarm_new->node),
-                    alarm_node);
+    if (alarm_new->slack != 0)
+        ctx->slack_alarm_count++;
 
     alarm_new->started = true;
 }
 
+static void _remove_alarm_ctx_from_active_queue(struct dev_ctx *ctx,
+                                                struct alarm_ctx *alarm)
+{
+    struct alarm_ctx *children;
+
+    assert(ctx != NULL);
+    assert(alarm != NULL);
+
+    children = _heap_merge_pairs(alarm->child);
+
+    if (alarm == ctx->alarms_active)
+        ctx->alarms_active = children;
+    else {
+        /* Unlink the alarm from the children of its parent */
+        if (alarm->prev->child == alarm)
+            alarm->prev->child = alarm->sibling;
+        else
+            alarm->prev->sibling = alarm->sibling;
+        if (alarm->sibling != NULL)
+            alarm->sibling->prev = alarm->prev;
+
+        ctx->alarms_active = _heap_meld(ctx->alarms_active, children);
+    }
+
+    alarm->child = alarm->sibling = alarm->prev = NULL;
+    alarm->started = false;
+
+    if (alarm->slack != 0)
+        ctx->slack_alarm_count--;
+}
 
 /*
  * Functions fulfilling the timer API
@@ -203,7 +542,12 @@ static int get_frequency(fwk_id_t dev_id, uint32_t *frequency)
     if (frequency == NULL)
         return FWK_E_PARAM;
 
-    return ctx->driver->get_frequency(ctx->driver_dev_id, frequency);
+    if (_cache_frequency(ctx) != FWK_SUCCESS)
+        return ctx->driver->get_frequency(ctx->driver_dev_id, frequency);
+
+    *frequency = ctx->frequency;
+
+    return FWK_SUCCESS;
 }
 
 static int time_to_timestamp(fwk_id_t dev_id,
@@ -243,6 +587,28 @@ static int get_counter(fwk_id_t dev_id, uint64_t *counter)
     return ctx->driver->get_counter(ctx->driver_dev_id, counter);
 }
 
+static int get_time(fwk_id_t dev_id, uint64_t *microseconds)
+{
+    int status;
+    struct dev_ctx *ctx;
+    uint64_t counter;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (microseconds == NULL)
+        return FWK_E_PARAM;
+
+    ctx = &ctx_table[fwk_id_get_element_idx(dev_id)];
+
+    status = ctx->driver->get_counter(ctx->driver_dev_id, &counter);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return _timestamp_to_time(ctx, counter, microseconds);
+}
+
 static int delay(fwk_id_t dev_id, uint32_t microseconds)
 {
     int status;
@@ -308,6 +674,50 @@ static int wait(fwk_id_t dev_id,
     }
 }
 
+static int delay_sleep(fwk_id_t dev_id, uint32_t microseconds)
+{
+    int status;
+    struct dev_ctx *ctx;
+    uint64_t counter_limit;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx = &ctx_table[fwk_id_get_element_idx(dev_id)];
+
+    status = _timestamp_from_now(ctx, microseconds, &counter_limit);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return _sleep(ctx, counter_limit, NULL, NULL);
+}
+
+static int wait_sleep(fwk_id_t dev_id,
+                      uint32_t microseconds,
+                      bool (*cond)(void*),
+                      void *data)
+{
+    int status;
+    struct dev_ctx *ctx;
+    uint64_t counter_limit;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (cond == NULL)
+        return FWK_E_PARAM;
+
+    ctx = &ctx_table[fwk_id_get_element_idx(dev_id)];
+
+    status = _timestamp_from_now(ctx, microseconds, &counter_limit);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return _sleep(ctx, counter_limit, cond, data);
+}
+
 static int remaining(fwk_id_t dev_id,
                      uint64_t timestamp,
                      uint64_t *remaining_ticks)
@@ -333,8 +743,6 @@ static int get_next_alarm_remaining(fwk_id_t dev_id,
 {
     int status;
     const struct dev_ctx *ctx;
-    const struct alarm_ctx *alarm_ctx;
-    const struct fwk_dlist_node *alarm_ctx_node;
 
     status = fwk_module_check_call(dev_id);
     if (status != FWK_SUCCESS)
@@ -354,14 +762,11 @@ static int get_next_alarm_remaining(fwk_id_t dev_id,
      */
     ctx->driver->disable(ctx->driver_dev_id);
 
-    *has_alarm = !fwk_list_is_empty(&ctx->alarms_active);
+    *has_alarm = (ctx->alarms_active != NULL);
 
-    if (*has_alarm) {
-        alarm_ctx_node = fwk_list_head(&ctx->alarms_active);
-        alarm_ctx = FWK_LIST_GET(alarm_ctx_node, struct alarm_ctx, node);
-
-        status = _remaining(ctx, alarm_ctx->timestamp, remaining_ticks);
-    }
+    if (*has_alarm)
+        status = _remaining(ctx, _get_trigger_timestamp(ctx),
+                            remaining_ticks);
 
     ctx->driver->enable(ctx->driver_dev_id);
 
@@ -372,8 +777,11 @@ static const struct mod_timer_api timer_api = {
     .get_frequency = get_frequency,
     .time_to_timestamp = time_to_timestamp,
     .get_counter = get_counter,
+    .get_time = get_time,
     .delay = delay,
     .wait = wait,
+    .delay_sleep = delay_sleep,
+    .wait_sleep = wait_sleep,
     .remaining = remaining,
     .get_next_alarm_remaining = get_next_alarm_remaining,
 };
@@ -416,19 +824,18 @@ static int alarm_stop(fwk_id_t alarm_id)
      */
     fwk_interrupt_clear_pending(ctx->config->timer_irq);
 
-    fwk_list_remove(&ctx->alarms_active, (struct fwk_dlist_node *)alarm);
-    alarm->started = false;
+    _remove_alarm_ctx_from_active_queue(ctx, alarm);
 
     _configure_timer_with_next_alarm(ctx);
 
     return FWK_SUCCESS;
 }
 
-static int alarm_start(fwk_id_t alarm_id,
-                       unsigned int milliseconds,
-                       enum mod_timer_alarm_type type,
-                       void (*callback)(uintptr_t param),
-                       uintptr_t param)
+static int alarm_start_us(fwk_id_t alarm_id,
+                          uint32_t microseconds,
+                          enum mod_timer_alarm_type type,
+                          void (*callback)(uintptr_t param),
+                          uintptr_t param)
 {
     int status;
     struct dev_ctx *ctx;
@@ -446,21 +853,22 @@ static int alarm_start(fwk_id_t alarm_id,
     if (alarm->started)
         alarm_stop(alarm_id);
 
-    /* Cap to ensure value will not overflow when stored as microseconds */
-    milliseconds = FWK_MIN(milliseconds, UINT32_MAX / 1000);
-
     /* Populate alarm item */
     alarm->callback = callback;
     alarm->param = param;
     alarm->periodic =
         (type == MOD_TIMER_ALARM_TYPE_PERIODIC ? true : false);
-    alarm->microseconds = milliseconds * 1000;
+    alarm->microseconds = microseconds;
     status = _timestamp_from_now(ctx,
                                  alarm->microseconds,
                                  &alarm->timestamp);
     if (status != FWK_SUCCESS)
         return status;
 
+    status = _time_to_timestamp(ctx, alarm->slack_us, &alarm->slack);
+    if (status != FWK_SUCCESS)
+        return status;
+
     /* Disable timer interrupts to work with the active queue */
     ctx->driver->disable(ctx->driver_dev_id);
 
@@ -471,17 +879,80 @@ static int alarm_start(fwk_id_t alarm_id,
     return FWK_SUCCESS;
 }
 
+static int alarm_start(fwk_id_t alarm_id,
+                       unsigned int milliseconds,
+                       enum mod_timer_alarm_type type,
+                       void (*callback)(uintptr_t param),
+                       uintptr_t param)
+{
+    /* Cap to ensure value will not overflow when stored as microseconds */
+    milliseconds = FWK_MIN(milliseconds, UINT32_MAX / 1000);
+
+    return alarm_start_us(alarm_id, milliseconds * 1000, type, callback,
+                          param);
+}
+
+static int alarm_set_slack(fwk_id_t alarm_id, uint32_t microseconds)
+{
+    int status;
+    struct dev_ctx *ctx;
+
+    assert(fwk_module_is_valid_sub_element_id(alarm_id));
+
+    status = fwk_module_check_call(alarm_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx = ctx_table + fwk_id_get_element_idx(alarm_id);
+    ctx->alarm_pool[fwk_id_get_sub_element_idx(alarm_id)].slack_us =
+        microseconds;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_timer_alarm_api alarm_api = {
     .start = alarm_start,
+    .start_us = alarm_start_us,
+    .set_slack = alarm_set_slack,
     .stop = alarm_stop,
 };
 
-static void timer_isr(uintptr_t ctx_ptr)
+/*
+ * Run the callback of an alarm, or send the deferred alarm event to the entity
+ * bound to the alarm so that it is processed outside of the interrupt context.
+ */
+static void _deliver_alarm(struct alarm_ctx *alarm)
+{
+    int status;
+    struct fwk_event event;
+    struct mod_timer_alarm_event_params *params =
+        (struct mod_timer_alarm_event_params *)event.params;
+
+    if (alarm->callback != NULL) {
+        alarm->callback(alarm->param);
+        return;
+    }
+
+    event = (struct fwk_event) {
+        .source_id = alarm->id,
+        .target_id = alarm->owner_id,
+        .id = mod_timer_event_id_alarm,
+    };
+    params->param = alarm->param;
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        MOD_LOG(log_api, MOD_LOG_GROUP_ERROR,
+                "[Timer] Error: Deferred alarm event could not be sent.\n");
+}
+
+static FWK_HOT void timer_isr(uintptr_t ctx_ptr)
 {
     int status;
     struct alarm_ctx *alarm;
     struct dev_ctx *ctx = (struct dev_ctx *)ctx_ptr;
     uint64_t timestamp = 0;
+    uint64_t counter;
 
     assert(ctx != NULL);
 
@@ -489,30 +960,58 @@ static void timer_isr(uintptr_t ctx_ptr)
     ctx->driver->disable(ctx->driver_dev_id);
     fwk_interrupt_clear_pending(ctx->config->timer_irq);
 
-    alarm = (struct alarm_ctx *)fwk_list_pop_head(&ctx->alarms_active);
+    /* The programmed timestamp has been reached, the device is reprogrammed */
+    ctx->programmed = false;
+
+    status = ctx->driver->get_counter(ctx->driver_dev_id, &counter);
 
-    if (alarm == NULL) {
+    if (ctx->wakeup_armed &&
+        ((status != FWK_SUCCESS) || (counter >= ctx->wakeup_timestamp))) {
+        /* The sleeping thread resumes once the interrupt has been handled */
+        ctx->wakeup_armed = false;
+    } else if (ctx->alarms_active == NULL) {
         /* Timer interrupt triggered without any alarm in the active queue */
         assert(false);
         return;
     }
 
-    alarm->started = false;
+    /*
+     * All the alarms expired when the interrupt is handled are processed, the
+     * alarm that triggered the interrupt included even if the counter cannot
+     * be read.
+     */
+    if ((status != FWK_SUCCESS) && (ctx->alarms_active != NULL))
+        counter = ctx->alarms_active->timestamp;
 
-    /* Execute the callback function */
-    alarm->callback(alarm->param);
+    while ((ctx->alarms_active != NULL) &&
+           (ctx->alarms_active->timestamp <= counter)) {
+        alarm = ctx->alarms_active;
+
+        _remove_alarm_ctx_from_active_queue(ctx, alarm);
+
+        _deliver_alarm(alarm);
+
+        /* The alarm may have been started again by its callback */
+        if (!alarm->periodic || alarm->started)
+            continue;
 
-    if (alarm->periodic) {
         /* Put this alarm back into the active queue */
         status = _time_to_timestamp(ctx, alarm->microseconds, &timestamp);
 
         if (status == FWK_SUCCESS) {
             alarm->timestamp += timestamp;
             _insert_alarm_ctx_into_active_queue(ctx, alarm);
+
+            /*
+             * A periodic alarm that is already late triggers the interrupt
+             * again rather than being processed repeatedly here.
+             */
+            if (alarm->timestamp <= counter)
+                break;
         } else
-            log_api->log(MOD_LOG_GROUP_ERROR,
-                         "[Timer] Error: Periodic alarm could not be added "
-                         "back into queue.\n");
+            MOD_LOG(log_api, MOD_LOG_GROUP_ERROR,
+                             "[Timer] Error: Periodic alarm could not be added "
+                             "back into queue.\n");
     }
 
     _configure_timer_with_next_alarm(ctx);
@@ -545,7 +1044,8 @@ static int timer_device_init(fwk_id_t element_id, unsigned int alarm_count,
     ctx->config = data;
 
     if (alarm_count > 0) {
-        ctx->alarm_pool = fwk_mm_calloc(alarm_count, sizeof(struct alarm_ctx));
+        ctx->alarm_pool = fwk_mm_calloc_hot(alarm_count,
+                                            sizeof(struct alarm_ctx));
         if (ctx->alarm_pool == NULL) {
             assert(false);
             return FWK_E_NOMEM;
@@ -630,6 +1130,8 @@ static int timer_process_bind_request(fwk_id_t requester_id,
     }
 
     alarm_ctx->bound = true;
+    alarm_ctx->id = id;
+    alarm_ctx->owner_id = requester_id;
 
     *api = &alarm_api;
     return FWK_SUCCESS;
@@ -644,7 +1146,8 @@ static int timer_start(fwk_id_t id)
 
     ctx = ctx_table + fwk_id_get_element_idx(id);
 
-    fwk_list_init(&ctx->alarms_active);
+    /* The failure is reported again on the first conversion */
+    _cache_frequency(ctx);
 
     fwk_interrupt_set_isr_param(ctx->config->timer_irq,
                                 timer_isr,
@@ -658,6 +1161,7 @@ static int timer_start(fwk_id_t id)
 const struct fwk_module module_timer = {
     .name = "Timer HAL",
     .api_count = MOD_TIMER_API_COUNT,
+    .event_count = MOD_TIMER_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_HAL,
     .init = timer_init,
     .element_init = timer_device_init,
@@ -0,0 +1,39 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Definitions for the power domain and power domain benchmark module
+ *     configurations.
+ */
+
+#ifndef HOST_PD_BENCH_H
+#define HOST_PD_BENCH_H
+
+/* Number of clusters */
+#define HOST_PD_BENCH_CLUSTER_COUNT 2
+
+/* Number of cores per cluster */
+#define HOST_PD_BENCH_CORE_PER_CLUSTER_COUNT 8
+
+/* Number of cores */
+#define HOST_PD_BENCH_CORE_COUNT \
+    (HOST_PD_BENCH_CLUSTER_COUNT * HOST_PD_BENCH_CORE_PER_CLUSTER_COUNT)
+
+/*
+ * Index of the power domain of the first cluster. The power domains of the
+ * cores come first, in cluster order, then the power domains of the clusters
+ * and the system power domain.
+ */
+#define HOST_PD_BENCH_PD_IDX_CLUSTER0 HOST_PD_BENCH_CORE_COUNT
+
+/* Index of the system power domain */
+#define HOST_PD_BENCH_PD_IDX_SYSTEM \
+    (HOST_PD_BENCH_PD_IDX_CLUSTER0 + HOST_PD_BENCH_CLUSTER_COUNT)
+
+/* Number of power domains */
+#define HOST_PD_BENCH_PD_COUNT (HOST_PD_BENCH_PD_IDX_SYSTEM + 1)
+
+#endif /* HOST_PD_BENCH_H */
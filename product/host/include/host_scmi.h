@@ -0,0 +1,43 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Definitions for SCMI, SMT and SCMI queue module configurations.
+ */
+
+#ifndef HOST_SCMI_H
+#define HOST_SCMI_H
+
+#include <stdint.h>
+
+/* SCMI agent identifiers */
+enum host_scmi_agent_id {
+    /* 0 is reserved for the platform */
+    SCMI_AGENT_ID_OSPM = 1,
+    SCMI_AGENT_ID_PSCI,
+};
+
+/* SCMI service indexes */
+enum host_scmi_service_idx {
+    HOST_SCMI_SERVICE_IDX_PSCI,
+    HOST_SCMI_SERVICE_IDX_OSPM,
+    HOST_SCMI_SERVICE_IDX_COUNT,
+};
+
+/* Size in bytes of the mailbox of a service */
+#define HOST_SCMI_MAILBOX_SIZE 128
+
+/* Mailboxes shared between the agents and the platform, one per service */
+extern uint32_t host_scmi_mailbox_table[HOST_SCMI_SERVICE_IDX_COUNT]
+    [HOST_SCMI_MAILBOX_SIZE / sizeof(uint32_t)];
+
+/* Maximum number of messages in the queue of an SCMI queue channel */
+#define HOST_SCMI_QUEUE_LENGTH 16
+
+/* Maximum size in bytes of the payloads of an SCMI queue channel */
+#define HOST_SCMI_QUEUE_PAYLOAD_SIZE 128
+
+#endif /* HOST_SCMI_H */
@@ -0,0 +1,31 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Definitions for the timer and alarm simulation module configurations.
+ */
+
+#ifndef HOST_VTIME_H
+#define HOST_VTIME_H
+
+#include <fwk_macros.h>
+
+/* Interrupt of the virtual timer */
+#define HOST_VTIME_TIMER_IRQ 0
+
+/* Frequency of the counter of the virtual timer in Hertz */
+#define HOST_VTIME_TIMER_FREQUENCY (50 * FWK_MHZ)
+
+/* Alarm indexes of the virtual timer */
+enum host_vtime_alarm_idx {
+    HOST_VTIME_ALARM_IDX_TICK,
+    HOST_VTIME_ALARM_IDX_DVFS,
+    HOST_VTIME_ALARM_IDX_SENSOR,
+    HOST_VTIME_ALARM_IDX_END,
+    HOST_VTIME_ALARM_IDX_COUNT,
+};
+
+#endif /* HOST_VTIME_H */
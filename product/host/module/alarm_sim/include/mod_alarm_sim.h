@@ -0,0 +1,74 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Alarm simulation.
+ */
+
+#ifndef MOD_ALARM_SIM_H
+#define MOD_ALARM_SIM_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostAlarmSim Alarm Simulation
+ *
+ * \details The module runs a scenario of periodic alarms over a simulated
+ *      duration, meant to be run on a virtual timer. Each element starts a
+ *      periodic alarm when the firmware starts and counts how many times it
+ *      triggers. Once the simulated duration has
+ *      elapsed, the result and the time of the timer are logged on lines of
+ *      the form:
+ *      \code
+ *      [SIM] alarm=<name> period=<us> count=<count>
+ *      [SIM] time=<us> alarms=<count>
+ *      \endcode
+ *      and the firmware exits, with an error status if an alarm did not
+ *      trigger as many times as its period fits in the duration.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Module configuration data.
+ */
+struct mod_alarm_sim_config {
+    /*! Identifier of the timer device the alarms belong to */
+    fwk_id_t timer_id;
+
+    /*! Identifier of the alarm signalling the end of the simulation */
+    fwk_id_t end_alarm_id;
+
+    /*! Simulated duration in microseconds */
+    uint32_t duration;
+};
+
+/*!
+ * \brief Element configuration data.
+ */
+struct mod_alarm_sim_alarm_config {
+    /*! Identifier of the alarm */
+    fwk_id_t alarm_id;
+
+    /*! Period of the alarm in microseconds */
+    uint32_t period;
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_ALARM_SIM_H */
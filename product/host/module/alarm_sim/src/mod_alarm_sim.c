@@ -0,0 +1,228 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Alarm simulation.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_noreturn.h>
+#include <fwk_thread.h>
+#include <mod_alarm_sim.h>
+#include <mod_log.h>
+#include <mod_timer.h>
+
+enum alarm_sim_event_idx {
+    /* Report the result, once the alarms due at the end have been delivered */
+    ALARM_SIM_EVENT_IDX_REPORT,
+
+    ALARM_SIM_EVENT_IDX_COUNT,
+};
+
+struct alarm_ctx {
+    /* Element configuration data */
+    const struct mod_alarm_sim_alarm_config *config;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Number of times the alarm triggered */
+    unsigned int count;
+};
+
+static struct {
+    /* Module configuration data */
+    const struct mod_alarm_sim_config *config;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Timer API */
+    const struct mod_timer_api *timer_api;
+
+    /* Alarm API of the end alarm */
+    const struct mod_timer_alarm_api *end_alarm_api;
+
+    /* Table of alarm contexts */
+    struct alarm_ctx *alarm_ctx_table;
+
+    /* Number of alarms */
+    unsigned int alarm_count;
+} alarm_sim_ctx;
+
+/*
+ * Static functions
+ */
+
+static noreturn void report(void)
+{
+    const struct alarm_ctx *alarm_ctx;
+    unsigned int alarm_idx, total_count = 0;
+    uint64_t time = 0;
+    bool error = false;
+
+    if (alarm_sim_ctx.timer_api->get_time(alarm_sim_ctx.config->timer_id,
+                                          &time) != FWK_SUCCESS)
+        error = true;
+
+    for (alarm_idx = 0; alarm_idx < alarm_sim_ctx.alarm_count; alarm_idx++) {
+        alarm_ctx = &alarm_sim_ctx.alarm_ctx_table[alarm_idx];
+
+        MOD_LOG(alarm_sim_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[SIM] alarm=%s period=%u count=%u\n",
+            fwk_module_get_name(FWK_ID_ELEMENT(FWK_MODULE_IDX_ALARM_SIM,
+                                               alarm_idx)),
+            alarm_ctx->config->period, alarm_ctx->count);
+
+        if (alarm_ctx->count !=
+            (alarm_sim_ctx.config->duration / alarm_ctx->config->period))
+            error = true;
+
+        total_count += alarm_ctx->count;
+    }
+
+    MOD_LOG(alarm_sim_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[SIM] time=%u alarms=%u\n", (unsigned int)time, total_count);
+
+    exit(error ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static void alarm_callback(uintptr_t param)
+{
+    alarm_sim_ctx.alarm_ctx_table[param].count++;
+}
+
+/*
+ * The alarms due at the end of the simulation trigger from the same timer
+ * interrupt, the report is processed once they have all been counted.
+ */
+static void end_alarm_callback(uintptr_t param)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_ALARM_SIM,
+                           ALARM_SIM_EVENT_IDX_REPORT),
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_ALARM_SIM),
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_ALARM_SIM),
+    };
+
+    if (fwk_thread_put_event(&event) != FWK_SUCCESS)
+        exit(EXIT_FAILURE);
+}
+
+/*
+ * Framework handlers
+ */
+
+static int alarm_sim_init(fwk_id_t module_id, unsigned int element_count,
+                          const void *data)
+{
+    const struct mod_alarm_sim_config *config = data;
+
+    if ((config == NULL) || (config->duration == 0))
+        return FWK_E_PARAM;
+
+    alarm_sim_ctx.alarm_ctx_table = fwk_mm_calloc(element_count,
+                                                  sizeof(struct alarm_ctx));
+    if (alarm_sim_ctx.alarm_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    alarm_sim_ctx.config = config;
+    alarm_sim_ctx.alarm_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int alarm_sim_element_init(fwk_id_t element_id,
+                                  unsigned int sub_element_count,
+                                  const void *data)
+{
+    const struct mod_alarm_sim_alarm_config *config = data;
+
+    if ((config == NULL) || (config->period == 0))
+        return FWK_E_PARAM;
+
+    alarm_sim_ctx.alarm_ctx_table[fwk_id_get_element_idx(element_id)].config =
+        config;
+
+    return FWK_SUCCESS;
+}
+
+static int alarm_sim_bind(fwk_id_t id, unsigned int round)
+{
+    struct alarm_ctx *alarm_ctx;
+    int status;
+
+    if (round > 0)
+        return FWK_SUCCESS;
+
+    if (fwk_module_is_valid_module_id(id)) {
+        status = fwk_module_bind(fwk_module_id_log, MOD_LOG_API_ID,
+                                 &alarm_sim_ctx.log_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = fwk_module_bind(alarm_sim_ctx.config->timer_id,
+                                 MOD_TIMER_API_ID_TIMER,
+                                 &alarm_sim_ctx.timer_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        return fwk_module_bind(alarm_sim_ctx.config->end_alarm_id,
+                               MOD_TIMER_API_ID_ALARM,
+                               &alarm_sim_ctx.end_alarm_api);
+    }
+
+    alarm_ctx = &alarm_sim_ctx.alarm_ctx_table[fwk_id_get_element_idx(id)];
+
+    return fwk_module_bind(alarm_ctx->config->alarm_id, MOD_TIMER_API_ID_ALARM,
+                           &alarm_ctx->alarm_api);
+}
+
+static int alarm_sim_start(fwk_id_t id)
+{
+    struct alarm_ctx *alarm_ctx;
+
+    if (fwk_module_is_valid_module_id(id)) {
+        return alarm_sim_ctx.end_alarm_api->start_us(
+            alarm_sim_ctx.config->end_alarm_id,
+            alarm_sim_ctx.config->duration, MOD_TIMER_ALARM_TYPE_ONCE,
+            end_alarm_callback, 0);
+    }
+
+    alarm_ctx = &alarm_sim_ctx.alarm_ctx_table[fwk_id_get_element_idx(id)];
+
+    return alarm_ctx->alarm_api->start_us(alarm_ctx->config->alarm_id,
+        alarm_ctx->config->period, MOD_TIMER_ALARM_TYPE_PERIODIC,
+        alarm_callback, fwk_id_get_element_idx(id));
+}
+
+static int alarm_sim_process_event(const struct fwk_event *event,
+                                   struct fwk_event *resp_event)
+{
+    if (fwk_id_get_event_idx(event->id) != ALARM_SIM_EVENT_IDX_REPORT)
+        return FWK_E_PARAM;
+
+    report();
+}
+
+const struct fwk_module module_alarm_sim = {
+    .name = "Alarm simulation",
+    .type = FWK_MODULE_TYPE_SERVICE,
+    .event_count = ALARM_SIM_EVENT_IDX_COUNT,
+    .init = alarm_sim_init,
+    .element_init = alarm_sim_element_init,
+    .bind = alarm_sim_bind,
+    .start = alarm_sim_start,
+    .process_event = alarm_sim_process_event,
+};
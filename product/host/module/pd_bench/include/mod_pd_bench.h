@@ -0,0 +1,122 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Power domain transition benchmark.
+ */
+
+#ifndef MOD_PD_BENCH_H
+#define MOD_PD_BENCH_H
+
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostPdBench Power Domain Benchmark
+ *
+ * \details The module plays the role of both the agent requesting power state
+ *      transitions and the PPU drivers of all the power domains. The drivers
+ *      complete the transitions asynchronously: the new power state is
+ *      reported to the power domain module from an event, as the interrupt
+ *      of a PPU would. The power domains start ON.
+ *
+ *      The benchmark runs three phases in a row:
+ *      - Core transitions: a randomly selected core is switched ON or OFF,
+ *        its cluster staying ON.
+ *      - Cluster transitions: as for the core transitions, but the cluster is
+ *        switched OFF with its last core and ON with its first core.
+ *      - System suspend: all the cores but a randomly selected one are
+ *        switched OFF, the system is suspended and then resumed by a wake-up
+ *        request for the remaining core.
+ *
+ *      The latency of each transition, from the request to its completion, is
+ *      recorded. The requests are issued one at a time. The results are logged
+ *      on lines of the form:
+ *      \code
+ *      [PD_BENCH] transition=<name> count=<count> rate=<per second>
+ *      p50=<ns> p99=<ns> max=<ns>
+ *      \endcode
+ *      where the rate is the number of transitions per second of the time
+ *      spent in the transitions of that kind. The firmware exits when the
+ *      report is complete, with an error status if a transition failed or if
+ *      the results are worse than the configured thresholds, so that it can
+ *      be used as a performance regression test.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Module configuration data.
+ */
+struct mod_pd_bench_config {
+    /*! Number of transitions of each of the core and cluster phases */
+    unsigned int transition_count;
+
+    /*! Number of system suspend and resume cycles */
+    unsigned int suspend_count;
+
+    /*! Power state of the system power domain when suspended */
+    unsigned int system_suspend_state;
+
+    /*!
+     * \brief Seed of the pseudo-random sequence of transitions.
+     *
+     * \details The same seed always results in the same sequence.
+     */
+    uint32_t seed;
+
+    /*!
+     * \brief Maximum 99th percentile latency in nanoseconds of each kind of
+     *      transition.
+     *
+     * \details Not checked if equal to zero.
+     */
+    uint32_t max_p99_latency;
+
+    /*!
+     * \brief Minimum rate in transitions per second of each kind of
+     *      transition.
+     *
+     * \details Not checked if equal to zero.
+     */
+    uint32_t min_rate;
+};
+
+/*!
+ * \brief Element configuration data.
+ *
+ * \details Each element is the mock PPU of a power domain.
+ */
+struct mod_pd_bench_domain_config {
+    /*! Identifier of the power domain */
+    fwk_id_t pd_id;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_pd_bench_api_idx {
+    /*! Power domain driver API */
+    MOD_PD_BENCH_API_IDX_DRIVER,
+
+    /*! Number of APIs */
+    MOD_PD_BENCH_API_IDX_COUNT,
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_PD_BENCH_H */
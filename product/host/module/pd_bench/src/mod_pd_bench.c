@@ -0,0 +1,705 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Power domain transition benchmark.
+ */
+
+/* Required for clock_gettime() when building with -std=c11 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_multi_thread.h>
+#include <fwk_noreturn.h>
+#include <fwk_thread.h>
+#include <mod_log.h>
+#include <mod_pd_bench.h>
+#include <mod_power_domain.h>
+
+/* Index of no domain, the parent of the top-level domain */
+#define DOMAIN_IDX_NONE UINT_MAX
+
+enum pd_bench_event_idx {
+    /* Issue the next request of the benchmark */
+    PD_BENCH_EVENT_IDX_NEXT,
+
+    /* Complete the transition of the power domain of a mock PPU */
+    PD_BENCH_EVENT_IDX_TRANSITION,
+
+    PD_BENCH_EVENT_IDX_COUNT,
+};
+
+/* Kinds of transition measured */
+enum transition_kind {
+    TRANSITION_KIND_CORE,
+    TRANSITION_KIND_CLUSTER,
+    TRANSITION_KIND_SUSPEND,
+    TRANSITION_KIND_RESUME,
+    TRANSITION_KIND_COUNT,
+
+    /* Transitions preparing a measured one, not recorded */
+    TRANSITION_KIND_NONE = TRANSITION_KIND_COUNT,
+};
+
+static const char * const transition_kind_name[TRANSITION_KIND_COUNT] = {
+    [TRANSITION_KIND_CORE] = "core",
+    [TRANSITION_KIND_CLUSTER] = "cluster",
+    [TRANSITION_KIND_SUSPEND] = "suspend",
+    [TRANSITION_KIND_RESUME] = "resume",
+};
+
+/* Phases of the benchmark */
+enum phase {
+    PHASE_CORE,
+    PHASE_CLUSTER,
+    PHASE_SUSPEND,
+    PHASE_DONE,
+};
+
+/* Parameters of the transition event of a mock PPU */
+struct transition_params {
+    /* Power state reached */
+    unsigned int state;
+};
+
+/* Mock PPU of a power domain */
+struct domain_ctx {
+    /* Element configuration data */
+    const struct mod_pd_bench_domain_config *config;
+
+    /* Power domain driver input API */
+    const struct mod_pd_driver_input_api *pd_input_api;
+
+    /* Type of the power domain */
+    enum mod_pd_type type;
+
+    /* Index of the domain of the parent, DOMAIN_IDX_NONE if none */
+    unsigned int parent_idx;
+
+    /* Current power state of the domain */
+    unsigned int state;
+
+    /* Power state last requested by the benchmark, for the cores */
+    unsigned int requested_state;
+};
+
+/* Recorded latencies of a kind of transition */
+struct samples {
+    /* Table of latencies in nanoseconds */
+    uint32_t *latency_table;
+
+    /* Number of latencies recorded */
+    unsigned int count;
+
+    /* Sum of the latencies in nanoseconds */
+    uint64_t total;
+};
+
+struct pd_bench_ctx {
+    /* Module configuration data */
+    const struct mod_pd_bench_config *config;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Power domain restricted API */
+    const struct mod_pd_restricted_api *pd_api;
+
+    /* Table of domain contexts */
+    struct domain_ctx *domain_ctx_table;
+
+    /* Number of domains */
+    unsigned int domain_count;
+
+    /* Table of the indices of the cores in the table of domain contexts */
+    unsigned int *core_idx_table;
+
+    /* Number of cores */
+    unsigned int core_count;
+
+    /* Latencies per kind of transition */
+    struct samples samples[TRANSITION_KIND_COUNT];
+
+    /* Current phase */
+    enum phase phase;
+
+    /* Number of transitions or suspend cycles completed in the phase */
+    unsigned int phase_count;
+
+    /* Index of the core kept ON for the system suspend */
+    unsigned int suspend_core_idx;
+
+    /* Kind of the transition being processed */
+    enum transition_kind kind;
+
+    /* Index of the core target of the transition being processed */
+    unsigned int core_idx;
+
+    /* Timestamp of the request of the transition being processed */
+    uint64_t request_timestamp;
+
+    /* State of the pseudo-random number generator */
+    uint32_t random;
+
+    /* Number of failed transitions */
+    unsigned int error_count;
+};
+
+static struct pd_bench_ctx pd_bench_ctx;
+
+/*
+ * Static functions
+ */
+
+static uint64_t get_timestamp(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (time.tv_sec * 1000000000ULL) + time.tv_nsec;
+}
+
+static unsigned int get_random(unsigned int range)
+{
+    pd_bench_ctx.random = (pd_bench_ctx.random * 1103515245U) + 12345U;
+
+    return (pd_bench_ctx.random >> 16) % range;
+}
+
+static int put_event(fwk_id_t target_id, unsigned int event_idx,
+                     unsigned int state)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_PD_BENCH, event_idx),
+        .source_id = target_id,
+        .target_id = target_id,
+    };
+    struct transition_params *params = (struct transition_params *)event.params;
+
+    params->state = state;
+
+    return fwk_thread_put_event(&event);
+}
+
+static int put_next_event(void)
+{
+    return put_event(FWK_ID_MODULE(FWK_MODULE_IDX_PD_BENCH),
+                     PD_BENCH_EVENT_IDX_NEXT, 0);
+}
+
+static int compare_latency(const void *a, const void *b)
+{
+    uint32_t latency_a = *(const uint32_t *)a;
+    uint32_t latency_b = *(const uint32_t *)b;
+
+    return (latency_a > latency_b) - (latency_a < latency_b);
+}
+
+/* Nearest-rank percentile of a sorted table of latencies */
+static uint32_t get_percentile(const uint32_t *latency_table,
+                               unsigned int count,
+                               unsigned int percentile)
+{
+    unsigned int rank;
+
+    rank = ((count * percentile) + 99) / 100;
+
+    return latency_table[(rank == 0) ? 0 : (rank - 1)];
+}
+
+static noreturn void report(void)
+{
+    const struct mod_pd_bench_config *config = pd_bench_ctx.config;
+    enum transition_kind kind;
+    struct samples *samples;
+    unsigned int rate, p99, transition_count = 0;
+    bool failed = (pd_bench_ctx.error_count != 0);
+
+    for (kind = 0; kind < TRANSITION_KIND_COUNT; kind++) {
+        samples = &pd_bench_ctx.samples[kind];
+        if ((samples->count == 0) || (samples->total == 0))
+            continue;
+
+        qsort(samples->latency_table, samples->count,
+              sizeof(samples->latency_table[0]), compare_latency);
+
+        rate = (unsigned int)((samples->count * 1000000000ULL) /
+                              samples->total);
+        p99 = get_percentile(samples->latency_table, samples->count, 99);
+
+        MOD_LOG(pd_bench_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[PD_BENCH] transition=%s count=%u rate=%u p50=%u p99=%u "
+            "max=%u\n",
+            transition_kind_name[kind], samples->count, rate,
+            get_percentile(samples->latency_table, samples->count, 50), p99,
+            samples->latency_table[samples->count - 1]);
+
+        if (((config->max_p99_latency != 0) &&
+             (p99 > config->max_p99_latency)) ||
+            ((config->min_rate != 0) && (rate < config->min_rate)))
+            failed = true;
+
+        transition_count += samples->count;
+    }
+
+    MOD_LOG(pd_bench_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[PD_BENCH] transitions=%u errors=%u\n",
+        transition_count, pd_bench_ctx.error_count);
+
+    exit(failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static void record_latency(void)
+{
+    struct samples *samples;
+    uint64_t latency;
+
+    if (pd_bench_ctx.kind == TRANSITION_KIND_NONE)
+        return;
+
+    latency = get_timestamp() - pd_bench_ctx.request_timestamp;
+    samples = &pd_bench_ctx.samples[pd_bench_ctx.kind];
+
+    samples->latency_table[samples->count++] = (uint32_t)latency;
+    samples->total += latency;
+}
+
+static struct domain_ctx *get_core_ctx(unsigned int core_idx)
+{
+    return &pd_bench_ctx.domain_ctx_table[
+        pd_bench_ctx.core_idx_table[core_idx]];
+}
+
+/*
+ * Whether all the cores of the cluster of a core but the core itself have
+ * been requested to be OFF.
+ */
+static bool is_last_core_on(const struct domain_ctx *core_ctx)
+{
+    const struct domain_ctx *other_ctx;
+    unsigned int core_idx;
+
+    for (core_idx = 0; core_idx < pd_bench_ctx.core_count; core_idx++) {
+        other_ctx = get_core_ctx(core_idx);
+        if ((other_ctx != core_ctx) &&
+            (other_ctx->parent_idx == core_ctx->parent_idx) &&
+            (other_ctx->requested_state != MOD_PD_STATE_OFF))
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Request a core to be switched ON or OFF. The cluster of the core is switched
+ * OFF with it if 'cluster_off' is true and it is the last core ON of the
+ * cluster.
+ */
+static int request_core_state(unsigned int core_idx, unsigned int state,
+                              bool cluster_off, enum transition_kind kind)
+{
+    struct domain_ctx *core_ctx = get_core_ctx(core_idx);
+    unsigned int cluster_state = MOD_PD_STATE_ON;
+
+    if (cluster_off && (state == MOD_PD_STATE_OFF) &&
+        is_last_core_on(core_ctx))
+        cluster_state = MOD_PD_STATE_OFF;
+
+    core_ctx->requested_state = state;
+
+    pd_bench_ctx.kind = kind;
+    pd_bench_ctx.core_idx = core_idx;
+    pd_bench_ctx.request_timestamp = get_timestamp();
+
+    return pd_bench_ctx.pd_api->set_composite_state_async(
+        core_ctx->config->pd_id, true,
+        MOD_PD_COMPOSITE_STATE(MOD_PD_LEVEL_1, 0, 0, cluster_state, state));
+}
+
+/* Switch a randomly selected core ON if it is OFF, OFF otherwise */
+static int request_random_core_transition(bool cluster_off,
+                                          enum transition_kind kind)
+{
+    unsigned int core_idx = get_random(pd_bench_ctx.core_count);
+
+    return request_core_state(core_idx,
+        (get_core_ctx(core_idx)->requested_state == MOD_PD_STATE_OFF) ?
+        MOD_PD_STATE_ON : MOD_PD_STATE_OFF, cluster_off, kind);
+}
+
+/*
+ * Step of a system suspend cycle: switch the cores but one OFF, then suspend
+ * the system. The system is resumed when its suspend is complete, see
+ * complete_system_suspend().
+ */
+static int step_system_suspend(void)
+{
+    unsigned int core_idx;
+    int status;
+
+    if (get_core_ctx(pd_bench_ctx.suspend_core_idx)->requested_state ==
+        MOD_PD_STATE_OFF) {
+        return request_core_state(pd_bench_ctx.suspend_core_idx,
+            MOD_PD_STATE_ON, true, TRANSITION_KIND_NONE);
+    }
+
+    for (core_idx = 0; core_idx < pd_bench_ctx.core_count; core_idx++) {
+        if ((core_idx != pd_bench_ctx.suspend_core_idx) &&
+            (get_core_ctx(core_idx)->requested_state != MOD_PD_STATE_OFF)) {
+            return request_core_state(core_idx, MOD_PD_STATE_OFF, true,
+                                      TRANSITION_KIND_NONE);
+        }
+    }
+
+    pd_bench_ctx.kind = TRANSITION_KIND_SUSPEND;
+    pd_bench_ctx.request_timestamp = get_timestamp();
+
+    status = pd_bench_ctx.pd_api->system_suspend(
+        pd_bench_ctx.config->system_suspend_state);
+    if (status != FWK_SUCCESS) {
+        pd_bench_ctx.error_count++;
+        report();
+    }
+
+    return FWK_SUCCESS;
+}
+
+/* Issue the next request of the benchmark */
+static int process_next(void)
+{
+    const struct mod_pd_bench_config *config = pd_bench_ctx.config;
+
+    if ((pd_bench_ctx.phase == PHASE_CORE) &&
+        (pd_bench_ctx.phase_count == config->transition_count)) {
+        pd_bench_ctx.phase = PHASE_CLUSTER;
+        pd_bench_ctx.phase_count = 0;
+    }
+
+    if ((pd_bench_ctx.phase == PHASE_CLUSTER) &&
+        (pd_bench_ctx.phase_count == config->transition_count)) {
+        pd_bench_ctx.phase = PHASE_SUSPEND;
+        pd_bench_ctx.phase_count = 0;
+        pd_bench_ctx.suspend_core_idx = get_random(pd_bench_ctx.core_count);
+    }
+
+    if ((pd_bench_ctx.phase == PHASE_SUSPEND) &&
+        (pd_bench_ctx.phase_count == config->suspend_count))
+        pd_bench_ctx.phase = PHASE_DONE;
+
+    switch (pd_bench_ctx.phase) {
+    case PHASE_CORE:
+        return request_random_core_transition(false, TRANSITION_KIND_CORE);
+
+    case PHASE_CLUSTER:
+        return request_random_core_transition(true, TRANSITION_KIND_CLUSTER);
+
+    case PHASE_SUSPEND:
+        return step_system_suspend();
+
+    default:
+        report();
+    }
+}
+
+/* Process the response to a request of the benchmark */
+static int process_response(void)
+{
+    const struct domain_ctx *core_ctx = get_core_ctx(pd_bench_ctx.core_idx);
+    const struct domain_ctx *cluster_ctx =
+        &pd_bench_ctx.domain_ctx_table[core_ctx->parent_idx];
+
+    record_latency();
+
+    /* The mock PPUs must have completed the transitions requested */
+    if ((core_ctx->state != core_ctx->requested_state) ||
+        ((core_ctx->state == MOD_PD_STATE_ON) &&
+         (cluster_ctx->state != MOD_PD_STATE_ON)))
+        pd_bench_ctx.error_count++;
+
+    if (pd_bench_ctx.kind == TRANSITION_KIND_RESUME) {
+        pd_bench_ctx.phase_count++;
+        pd_bench_ctx.suspend_core_idx = get_random(pd_bench_ctx.core_count);
+    } else if (pd_bench_ctx.kind != TRANSITION_KIND_NONE)
+        pd_bench_ctx.phase_count++;
+
+    return put_next_event();
+}
+
+/*
+ * Complete a system suspend, once the system power domain is suspended, by
+ * waking the remaining core up.
+ */
+static int complete_system_suspend(void)
+{
+    struct domain_ctx *core_ctx = get_core_ctx(pd_bench_ctx.suspend_core_idx);
+
+    record_latency();
+
+    core_ctx->requested_state = MOD_PD_STATE_ON;
+
+    pd_bench_ctx.kind = TRANSITION_KIND_RESUME;
+    pd_bench_ctx.core_idx = pd_bench_ctx.suspend_core_idx;
+    pd_bench_ctx.request_timestamp = get_timestamp();
+
+    return pd_bench_ctx.pd_api->set_composite_state_async(
+        core_ctx->config->pd_id, true,
+        MOD_PD_COMPOSITE_STATE(MOD_PD_LEVEL_2, 0, MOD_PD_STATE_ON,
+                               MOD_PD_STATE_ON, MOD_PD_STATE_ON));
+}
+
+/* Complete the transition of the power domain of a mock PPU */
+static int process_transition(fwk_id_t domain_id,
+                              const struct transition_params *params)
+{
+    struct domain_ctx *domain_ctx =
+        &pd_bench_ctx.domain_ctx_table[fwk_id_get_element_idx(domain_id)];
+    int status;
+
+    domain_ctx->state = params->state;
+
+    status = domain_ctx->pd_input_api->report_power_state_transition(
+        domain_ctx->config->pd_id, params->state);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((domain_ctx->type == MOD_PD_TYPE_SYSTEM) &&
+        (params->state == pd_bench_ctx.config->system_suspend_state) &&
+        (pd_bench_ctx.kind == TRANSITION_KIND_SUSPEND))
+        return complete_system_suspend();
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Power domain driver API
+ */
+
+static int set_state(fwk_id_t dev_id, unsigned int state)
+{
+    /* The PPU reports the completion of the transition asynchronously */
+    return put_event(dev_id, PD_BENCH_EVENT_IDX_TRANSITION, state);
+}
+
+static int get_state(fwk_id_t dev_id, unsigned int *state)
+{
+    *state = pd_bench_ctx.domain_ctx_table[fwk_id_get_element_idx(dev_id)].
+        state;
+
+    return FWK_SUCCESS;
+}
+
+static int reset(fwk_id_t dev_id)
+{
+    return FWK_SUCCESS;
+}
+
+static int prepare_core_for_system_suspend(fwk_id_t dev_id)
+{
+    /* The core executes WFI once prepared, the PPU switches it OFF */
+    return put_event(dev_id, PD_BENCH_EVENT_IDX_TRANSITION, MOD_PD_STATE_OFF);
+}
+
+static const struct mod_pd_driver_api driver_api = {
+    .set_state = set_state,
+    .get_state = get_state,
+    .reset = reset,
+    .prepare_core_for_system_suspend = prepare_core_for_system_suspend,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int pd_bench_init(fwk_id_t module_id, unsigned int element_count,
+                         const void *data)
+{
+    const struct mod_pd_bench_config *config = data;
+    enum transition_kind kind;
+    unsigned int sample_count;
+
+    if ((config == NULL) || (element_count == 0))
+        return FWK_E_DATA;
+
+    pd_bench_ctx.domain_ctx_table = fwk_mm_calloc(element_count,
+        sizeof(pd_bench_ctx.domain_ctx_table[0]));
+    if (pd_bench_ctx.domain_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    pd_bench_ctx.core_idx_table = fwk_mm_calloc(element_count,
+        sizeof(pd_bench_ctx.core_idx_table[0]));
+    if (pd_bench_ctx.core_idx_table == NULL)
+        return FWK_E_NOMEM;
+
+    for (kind = 0; kind < TRANSITION_KIND_COUNT; kind++) {
+        sample_count = ((kind == TRANSITION_KIND_CORE) ||
+                        (kind == TRANSITION_KIND_CLUSTER)) ?
+                       config->transition_count : config->suspend_count;
+        if (sample_count == 0)
+            continue;
+
+        pd_bench_ctx.samples[kind].latency_table = fwk_mm_calloc(sample_count,
+            sizeof(pd_bench_ctx.samples[kind].latency_table[0]));
+        if (pd_bench_ctx.samples[kind].latency_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
+    pd_bench_ctx.config = config;
+    pd_bench_ctx.domain_count = element_count;
+    pd_bench_ctx.random = config->seed;
+
+    /* The system suspend waits for the power domain module */
+    return fwk_thread_create(module_id);
+}
+
+static int pd_bench_domain_init(fwk_id_t domain_id, unsigned int unused,
+                                const void *data)
+{
+    struct domain_ctx *domain_ctx;
+
+    if (data == NULL)
+        return FWK_E_DATA;
+
+    domain_ctx =
+        &pd_bench_ctx.domain_ctx_table[fwk_id_get_element_idx(domain_id)];
+    domain_ctx->config = data;
+    domain_ctx->state = MOD_PD_STATE_ON;
+    domain_ctx->requested_state = MOD_PD_STATE_ON;
+
+    return FWK_SUCCESS;
+}
+
+static int pd_bench_bind(fwk_id_t id, unsigned int round)
+{
+    struct domain_ctx *domain_ctx;
+    int status;
+
+    if (round != 0)
+        return FWK_SUCCESS;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        status = fwk_module_bind(fwk_module_id_log, MOD_LOG_API_ID,
+                                 &pd_bench_ctx.log_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        return fwk_module_bind(fwk_module_id_power_domain,
+                               mod_pd_api_id_restricted,
+                               &pd_bench_ctx.pd_api);
+    }
+
+    domain_ctx = &pd_bench_ctx.domain_ctx_table[fwk_id_get_element_idx(id)];
+
+    return fwk_module_bind(domain_ctx->config->pd_id,
+                           mod_pd_api_id_driver_input,
+                           &domain_ctx->pd_input_api);
+}
+
+static int pd_bench_process_bind_request(fwk_id_t source_id,
+                                         fwk_id_t target_id,
+                                         fwk_id_t api_id,
+                                         const void **api)
+{
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT) ||
+        (fwk_id_get_api_idx(api_id) != MOD_PD_BENCH_API_IDX_DRIVER))
+        return FWK_E_PARAM;
+
+    *api = &driver_api;
+
+    return FWK_SUCCESS;
+}
+
+static int pd_bench_start(fwk_id_t id)
+{
+    struct domain_ctx *domain_ctx, *parent_ctx;
+    fwk_id_t parent_pd_id;
+    unsigned int domain_idx, parent_idx;
+    int status;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_MODULE))
+        return FWK_SUCCESS;
+
+    /* Build the tree of the domains from the power domain module */
+    for (domain_idx = 0; domain_idx < pd_bench_ctx.domain_count;
+         domain_idx++) {
+        domain_ctx = &pd_bench_ctx.domain_ctx_table[domain_idx];
+
+        status = pd_bench_ctx.pd_api->get_domain_type(domain_ctx->config->pd_id,
+                                                      &domain_ctx->type);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        status = pd_bench_ctx.pd_api->get_domain_parent_id(
+            domain_ctx->config->pd_id, &parent_pd_id);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        domain_ctx->parent_idx = DOMAIN_IDX_NONE;
+        for (parent_idx = 0; parent_idx < pd_bench_ctx.domain_count;
+             parent_idx++) {
+            parent_ctx = &pd_bench_ctx.domain_ctx_table[parent_idx];
+            if (fwk_id_is_equal(parent_ctx->config->pd_id, parent_pd_id))
+                domain_ctx->parent_idx = parent_idx;
+        }
+
+        if (domain_ctx->type != MOD_PD_TYPE_CORE)
+            continue;
+
+        /* The benchmark relies on the cores being the children of clusters */
+        if (domain_ctx->parent_idx == DOMAIN_IDX_NONE)
+            return FWK_E_DATA;
+
+        pd_bench_ctx.core_idx_table[pd_bench_ctx.core_count++] = domain_idx;
+    }
+
+    if (pd_bench_ctx.core_count == 0)
+        return FWK_E_DATA;
+
+    return put_next_event();
+}
+
+static int pd_bench_process_event(const struct fwk_event *event,
+                                  struct fwk_event *resp_event)
+{
+    if (event->is_response)
+        return process_response();
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case PD_BENCH_EVENT_IDX_NEXT:
+        return process_next();
+
+    case PD_BENCH_EVENT_IDX_TRANSITION:
+        return process_transition(event->target_id,
+            (const struct transition_params *)event->params);
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
+const struct fwk_module module_pd_bench = {
+    .name = "Power domain benchmark",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_PD_BENCH_API_IDX_COUNT,
+    .event_count = PD_BENCH_EVENT_IDX_COUNT,
+    .init = pd_bench_init,
+    .element_init = pd_bench_domain_init,
+    .bind = pd_bench_bind,
+    .start = pd_bench_start,
+    .process_bind_request = pd_bench_process_bind_request,
+    .process_event = pd_bench_process_event,
+};
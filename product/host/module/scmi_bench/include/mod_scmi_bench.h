@@ -0,0 +1,135 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI message path benchmark.
+ */
+
+#ifndef MOD_SCMI_BENCH_H
+#define MOD_SCMI_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostScmiBench SCMI Benchmark
+ *
+ * \details The module plays the role of both the agents and the doorbell
+ *      driver of SMT channels. Each agent writes messages in the shared
+ *      mailbox of its channel and rings the doorbell by signalling the SMT
+ *      module, then waits for the platform to raise the completion interrupt.
+ *      The latency of each message, from the doorbell to the response, is
+ *      recorded and its percentiles are reported per message and per protocol
+ *      once all the messages have been sent.
+ *
+ *      The results are logged on lines of the form:
+ *      \code
+ *      [BENCH] protocol=<id> message=<id> name=<name> count=<count>
+ *      min=<ns> p50=<ns> p90=<ns> p99=<ns> max=<ns>
+ *      \endcode
+ *      where the message identifier and name are omitted on the lines
+ *      summarizing a protocol. The firmware exits when the report is
+ *      complete, with an error status if a message was not responded to with
+ *      the SCMI_SUCCESS status.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Message sent by the agents.
+ */
+struct mod_scmi_bench_message {
+    /*! Name of the message, reported with its results */
+    const char *name;
+
+    /*! SCMI protocol identifier */
+    uint8_t protocol_id;
+
+    /*! SCMI message identifier */
+    uint8_t message_id;
+
+    /*! Pointer to the payload of the message, may be NULL if empty */
+    const void *payload;
+
+    /*! Size of the payload in bytes */
+    size_t payload_size;
+
+    /*!
+     * \brief Relative frequency of the message in the message mix.
+     *
+     * \details The probability for a message to be sent is its weight divided
+     *      by the sum of the weights of all the messages.
+     */
+    unsigned int weight;
+};
+
+/*!
+ * \brief Module configuration data.
+ */
+struct mod_scmi_bench_config {
+    /*! Table of messages that make up the message mix */
+    const struct mod_scmi_bench_message *message_table;
+
+    /*! Number of messages in the message table */
+    unsigned int message_table_size;
+
+    /*! Number of messages sent by each agent */
+    unsigned int message_count;
+
+    /*!
+     * \brief Seed of the pseudo-random sequence of messages.
+     *
+     * \details The same seed always results in the same sequences of
+     *      messages, so that the results of two runs are comparable. The
+     *      sequence of each agent is seeded with the sum of the seed and the
+     *      index of the agent.
+     */
+    uint32_t seed;
+};
+
+/*!
+ * \brief Agent configuration data.
+ */
+struct mod_scmi_bench_agent_config {
+    /*! Identifier of the SMT channel of the agent */
+    fwk_id_t transport_id;
+
+    /*! Identifier of the driver input API of the SMT channel */
+    fwk_id_t transport_api_id;
+
+    /*! Address of the mailbox shared with the SMT channel */
+    uintptr_t mailbox_address;
+
+    /*! Size of the shared mailbox in bytes */
+    size_t mailbox_size;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_scmi_bench_api_idx {
+    /*! SMT driver API */
+    MOD_SCMI_BENCH_API_IDX_DRIVER,
+
+    /*! Number of APIs */
+    MOD_SCMI_BENCH_API_IDX_COUNT,
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_SCMI_BENCH_H */
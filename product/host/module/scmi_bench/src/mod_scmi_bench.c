@@ -0,0 +1,477 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI message path benchmark.
+ */
+
+/* Required for clock_gettime() when building with -std=c11 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fwk_assert.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_noreturn.h>
+#include <fwk_notification.h>
+#include <fwk_thread.h>
+#include <mod_log.h>
+#include <mod_scmi.h>
+#include <mod_scmi_bench.h>
+#include <mod_smt.h>
+#include <internal/mod_scmi.h>
+#include <internal/scmi.h>
+#include <internal/smt.h>
+
+enum scmi_bench_event_idx {
+    /* Send the next message of an agent */
+    SCMI_BENCH_EVENT_IDX_SEND,
+
+    SCMI_BENCH_EVENT_IDX_COUNT,
+};
+
+/* Latency of a message */
+struct sample {
+    /* Duration in nanoseconds from the doorbell to the response */
+    uint32_t latency;
+
+    /* Index of the message in the message table */
+    unsigned int message_idx;
+};
+
+struct agent_ctx {
+    /* Agent configuration data */
+    const struct mod_scmi_bench_agent_config *config;
+
+    /* SMT driver input API */
+    const struct mod_smt_driver_input_api *transport_api;
+
+    /* Number of messages the platform has responded to */
+    unsigned int response_count;
+
+    /* Index in the message table of the message being processed */
+    unsigned int message_idx;
+
+    /* Timestamp of the doorbell of the message being processed */
+    uint64_t doorbell_timestamp;
+
+    /* State of the pseudo-random number generator selecting the messages */
+    uint32_t random;
+};
+
+struct scmi_bench_ctx {
+    /* Module configuration data */
+    const struct mod_scmi_bench_config *config;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Table of agent contexts */
+    struct agent_ctx *agent_ctx_table;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /* Number of agents that sent all their messages */
+    unsigned int done_agent_count;
+
+    /* Sum of the weights of the messages */
+    unsigned int total_weight;
+
+    /* Table of the latencies of all the messages sent */
+    struct sample *sample_table;
+
+    /* Number of latencies recorded */
+    unsigned int sample_count;
+
+    /* Table where the latencies are sorted when computing percentiles */
+    uint32_t *latency_table;
+
+    /* Number of messages not responded to with SCMI_SUCCESS */
+    unsigned int error_count;
+};
+
+static struct scmi_bench_ctx scmi_bench_ctx;
+
+/*
+ * Static functions
+ */
+
+static uint64_t get_timestamp(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (time.tv_sec * 1000000000ULL) + time.tv_nsec;
+}
+
+/*
+ * Select the next message of an agent. Each agent has its own linear
+ * congruential generator so that its sequence of messages only depends on the
+ * seed, whatever the interleaving of the agents.
+ */
+static unsigned int select_message(struct agent_ctx *agent_ctx)
+{
+    const struct mod_scmi_bench_config *config = scmi_bench_ctx.config;
+    unsigned int message_idx, value;
+
+    agent_ctx->random = (agent_ctx->random * 1103515245U) + 12345U;
+    value = (agent_ctx->random >> 16) % scmi_bench_ctx.total_weight;
+
+    for (message_idx = 0; message_idx < config->message_table_size;
+         message_idx++) {
+        if (value < config->message_table[message_idx].weight)
+            break;
+        value -= config->message_table[message_idx].weight;
+    }
+
+    return message_idx;
+}
+
+static int put_send_event(fwk_id_t agent_id)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_BENCH,
+                           SCMI_BENCH_EVENT_IDX_SEND),
+        .source_id = agent_id,
+        .target_id = agent_id,
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static int compare_latency(const void *a, const void *b)
+{
+    uint32_t latency_a = *(const uint32_t *)a;
+    uint32_t latency_b = *(const uint32_t *)b;
+
+    return (latency_a > latency_b) - (latency_a < latency_b);
+}
+
+/* Nearest-rank percentile of a sorted table of latencies */
+static uint32_t get_percentile(const uint32_t *latency_table,
+                               unsigned int count,
+                               unsigned int percentile)
+{
+    unsigned int rank;
+
+    rank = ((count * percentile) + 99) / 100;
+
+    return latency_table[(rank == 0) ? 0 : (rank - 1)];
+}
+
+/*
+ * Report the latency percentiles of one message of a protocol, or of all the
+ * messages of the protocol if the message is NULL.
+ */
+static void report_latency(uint8_t protocol_id,
+                           const struct mod_scmi_bench_message *message)
+{
+    const struct mod_scmi_bench_message *sample_message;
+    uint32_t *latency_table = scmi_bench_ctx.latency_table;
+    unsigned int sample_idx, count = 0;
+
+    for (sample_idx = 0; sample_idx < scmi_bench_ctx.sample_count;
+         sample_idx++) {
+        sample_message = &scmi_bench_ctx.config->message_table[
+            scmi_bench_ctx.sample_table[sample_idx].message_idx];
+
+        if ((sample_message == message) ||
+            ((message == NULL) && (sample_message->protocol_id == protocol_id)))
+            latency_table[count++] =
+                scmi_bench_ctx.sample_table[sample_idx].latency;
+    }
+
+    if (count == 0)
+        return;
+
+    qsort(latency_table, count, sizeof(latency_table[0]), compare_latency);
+
+    if (message != NULL) {
+        MOD_LOG(scmi_bench_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[BENCH] protocol=0x%x message=0x%x name=%s count=%u min=%u "
+            "p50=%u p90=%u p99=%u max=%u\n",
+            protocol_id, message->message_id, message->name, count,
+            latency_table[0],
+            get_percentile(latency_table, count, 50),
+            get_percentile(latency_table, count, 90),
+            get_percentile(latency_table, count, 99),
+            latency_table[count - 1]);
+    } else {
+        MOD_LOG(scmi_bench_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[BENCH] protocol=0x%x count=%u min=%u p50=%u p90=%u p99=%u "
+            "max=%u\n",
+            protocol_id, count, latency_table[0],
+            get_percentile(latency_table, count, 50),
+            get_percentile(latency_table, count, 90),
+            get_percentile(latency_table, count, 99),
+            latency_table[count - 1]);
+    }
+}
+
+static noreturn void report(void)
+{
+    const struct mod_scmi_bench_config *config = scmi_bench_ctx.config;
+    unsigned int message_idx, previous_idx;
+    uint8_t protocol_id;
+
+    for (message_idx = 0; message_idx < config->message_table_size;
+         message_idx++) {
+        protocol_id = config->message_table[message_idx].protocol_id;
+
+        /* Report each protocol once, with all its messages */
+        for (previous_idx = 0; previous_idx < message_idx; previous_idx++) {
+            if (config->message_table[previous_idx].protocol_id == protocol_id)
+                break;
+        }
+        if (previous_idx < message_idx)
+            continue;
+
+        for (previous_idx = message_idx;
+             previous_idx < config->message_table_size; previous_idx++) {
+            if (config->message_table[previous_idx].protocol_id == protocol_id)
+                report_latency(protocol_id,
+                               &config->message_table[previous_idx]);
+        }
+
+        report_latency(protocol_id, NULL);
+    }
+
+    MOD_LOG(scmi_bench_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[BENCH] messages=%u errors=%u\n",
+        scmi_bench_ctx.sample_count, scmi_bench_ctx.error_count);
+
+    exit((scmi_bench_ctx.error_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/*
+ * SMT driver API
+ */
+
+static int raise_interrupt(fwk_id_t device_id)
+{
+    uint64_t timestamp = get_timestamp();
+    struct agent_ctx *agent_ctx;
+    struct mod_smt_memory *memory;
+    struct sample *sample;
+
+    agent_ctx =
+        &scmi_bench_ctx.agent_ctx_table[fwk_id_get_element_idx(device_id)];
+    memory = (struct mod_smt_memory *)agent_ctx->config->mailbox_address;
+
+    sample = &scmi_bench_ctx.sample_table[scmi_bench_ctx.sample_count++];
+    sample->latency = (uint32_t)(timestamp - agent_ctx->doorbell_timestamp);
+    sample->message_idx = agent_ctx->message_idx;
+
+    if ((memory->status & MOD_SMT_MAILBOX_STATUS_ERROR_MASK) ||
+        ((int32_t)memory->payload[0] != SCMI_SUCCESS))
+        scmi_bench_ctx.error_count++;
+
+    if (++agent_ctx->response_count < scmi_bench_ctx.config->message_count)
+        return put_send_event(device_id);
+
+    if (++scmi_bench_ctx.done_agent_count == scmi_bench_ctx.agent_count)
+        report();
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_smt_driver_api driver_api = {
+    .raise_interrupt = raise_interrupt,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_bench_init(fwk_id_t module_id, unsigned int element_count,
+                           const void *data)
+{
+    const struct mod_scmi_bench_config *config = data;
+    unsigned int message_idx, sample_count;
+
+    if ((config == NULL) || (config->message_table_size == 0) ||
+        (config->message_count == 0) || (element_count == 0))
+        return FWK_E_DATA;
+
+    for (message_idx = 0; message_idx < config->message_table_size;
+         message_idx++)
+        scmi_bench_ctx.total_weight +=
+            config->message_table[message_idx].weight;
+
+    if (scmi_bench_ctx.total_weight == 0)
+        return FWK_E_DATA;
+
+    scmi_bench_ctx.agent_ctx_table = fwk_mm_calloc(element_count,
+        sizeof(scmi_bench_ctx.agent_ctx_table[0]));
+    if (scmi_bench_ctx.agent_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    sample_count = element_count * config->message_count;
+
+    scmi_bench_ctx.sample_table = fwk_mm_calloc(sample_count,
+        sizeof(scmi_bench_ctx.sample_table[0]));
+    if (scmi_bench_ctx.sample_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_bench_ctx.latency_table = fwk_mm_calloc(sample_count,
+        sizeof(scmi_bench_ctx.latency_table[0]));
+    if (scmi_bench_ctx.latency_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_bench_ctx.config = config;
+    scmi_bench_ctx.agent_count = element_count;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_bench_agent_init(fwk_id_t agent_id, unsigned int unused,
+                                 const void *data)
+{
+    const struct mod_scmi_bench_agent_config *config = data;
+    const struct mod_scmi_bench_config *module_config = scmi_bench_ctx.config;
+    struct agent_ctx *agent_ctx;
+    unsigned int message_idx;
+
+    if ((config == NULL) || (config->mailbox_address == 0) ||
+        (config->mailbox_size < sizeof(struct mod_smt_memory)))
+        return FWK_E_DATA;
+
+    /* Ensure all the messages fit in the mailbox */
+    for (message_idx = 0; message_idx < module_config->message_table_size;
+         message_idx++) {
+        if (module_config->message_table[message_idx].payload_size >
+            (config->mailbox_size - sizeof(struct mod_smt_memory)))
+            return FWK_E_DATA;
+    }
+
+    agent_ctx =
+        &scmi_bench_ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+    agent_ctx->config = config;
+    agent_ctx->random = module_config->seed + fwk_id_get_element_idx(agent_id);
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_bench_bind(fwk_id_t id, unsigned int round)
+{
+    struct agent_ctx *agent_ctx;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        if (round != 0)
+            return FWK_SUCCESS;
+
+        return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+                               FWK_ID_API(FWK_MODULE_IDX_LOG, 0),
+                               &scmi_bench_ctx.log_api);
+    }
+
+    /*
+     * The SMT channels only accept the binding of their driver once they have
+     * bound to it in the first round.
+     */
+    if (round != 1)
+        return FWK_SUCCESS;
+
+    agent_ctx = &scmi_bench_ctx.agent_ctx_table[fwk_id_get_element_idx(id)];
+
+    return fwk_module_bind(agent_ctx->config->transport_id,
+                           agent_ctx->config->transport_api_id,
+                           &agent_ctx->transport_api);
+}
+
+static int scmi_bench_process_bind_request(fwk_id_t source_id,
+                                           fwk_id_t target_id,
+                                           fwk_id_t api_id,
+                                           const void **api)
+{
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT) ||
+        (fwk_id_get_api_idx(api_id) != MOD_SCMI_BENCH_API_IDX_DRIVER))
+        return FWK_E_PARAM;
+
+    *api = &driver_api;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_bench_start(fwk_id_t id)
+{
+    struct agent_ctx *agent_ctx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    agent_ctx = &scmi_bench_ctx.agent_ctx_table[fwk_id_get_element_idx(id)];
+
+    /* The agent starts sending messages once its channel is ready */
+    return fwk_notification_subscribe(mod_smt_notification_id_initialized,
+                                      agent_ctx->config->transport_id,
+                                      id);
+}
+
+static int scmi_bench_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp_event)
+{
+    const struct mod_scmi_bench_message *message;
+    struct agent_ctx *agent_ctx;
+    struct mod_smt_memory *memory;
+
+    agent_ctx = &scmi_bench_ctx.agent_ctx_table[
+        fwk_id_get_element_idx(event->target_id)];
+    memory = (struct mod_smt_memory *)agent_ctx->config->mailbox_address;
+
+    /* The platform must have released the mailbox */
+    if (!(memory->status & MOD_SMT_MAILBOX_STATUS_FREE_MASK))
+        return FWK_E_STATE;
+
+    agent_ctx->message_idx = select_message(agent_ctx);
+    message = &scmi_bench_ctx.config->message_table[agent_ctx->message_idx];
+
+    memory->message_header = SCMI_MESSAGE_HEADER(message->message_id,
+                                                 message->protocol_id, 0);
+    if (message->payload_size > 0)
+        memcpy(memory->payload, message->payload, message->payload_size);
+    memory->length = sizeof(memory->message_header) + message->payload_size;
+    memory->flags = MOD_SMT_MAILBOX_FLAGS_IENABLED_MASK;
+    memory->status = 0;
+
+    agent_ctx->doorbell_timestamp = get_timestamp();
+
+    return agent_ctx->transport_api->signal_message(
+        agent_ctx->config->transport_id);
+}
+
+static int scmi_bench_process_notification(const struct fwk_event *event,
+                                           struct fwk_event *resp_event)
+{
+    fwk_assert(fwk_id_is_equal(event->id,
+                               mod_smt_notification_id_initialized));
+
+    return put_send_event(event->target_id);
+}
+
+const struct fwk_module module_scmi_bench = {
+    .name = "SCMI benchmark",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_SCMI_BENCH_API_IDX_COUNT,
+    .event_count = SCMI_BENCH_EVENT_IDX_COUNT,
+    .init = scmi_bench_init,
+    .element_init = scmi_bench_agent_init,
+    .bind = scmi_bench_bind,
+    .start = scmi_bench_start,
+    .process_bind_request = scmi_bench_process_bind_request,
+    .process_event = scmi_bench_process_event,
+    .process_notification = scmi_bench_process_notification,
+};
@@ -0,0 +1,147 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI fuzzing and throughput driver.
+ */
+
+#ifndef MOD_SCMI_FUZZ_H
+#define MOD_SCMI_FUZZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostScmiFuzz SCMI Fuzzing Driver
+ *
+ * \details The module plays the role of the agents of SCMI queue channels. It
+ *      keeps the queue of each channel filled with messages so that the SCMI
+ *      services process messages back to back, and checks every response:
+ *      * The response must be for the message at the head of the queue, with
+ *        the same header.
+ *      * The response payload must hold at least a status, within the range
+ *        of the SCMI status codes.
+ *
+ *      The messages sent by each agent are, in order:
+ *      * The messages of the recording given by the SCMI_FUZZ_RECORDING
+ *        environment variable, if set. The recording is a sequence of records
+ *        made of the 32-bit message header, the 32-bit payload size in bytes
+ *        and the payload padded to a multiple of 4 bytes, in the byte order
+ *        of the host.
+ *      * Messages drawn from the message table of the configuration, a share
+ *        of which are randomized: their message identifier, payload size and
+ *        payload contents are drawn at random.
+ *
+ *      Once all the messages have been sent the results are logged on lines
+ *      of the form:
+ *      \code
+ *      [FUZZ] messages=<count> violations=<count> duration_us=<duration>
+ *      rate=<messages per second>
+ *      [FUZZ] status=<SCMI status> count=<count>
+ *      \endcode
+ *      followed by the processing time of the events of each module when the
+ *      firmware is built with event profiling support. The firmware exits
+ *      when the report is complete, with an error status if a response
+ *      violated the protocol. It also exits with an error status when no
+ *      response has been received for a second.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Message of the message table.
+ */
+struct mod_scmi_fuzz_message {
+    /*! SCMI protocol identifier */
+    uint8_t protocol_id;
+
+    /*! SCMI message identifier */
+    uint8_t message_id;
+
+    /*! Pointer to the payload of the message, may be NULL if empty */
+    const void *payload;
+
+    /*! Size of the payload in bytes */
+    size_t payload_size;
+};
+
+/*!
+ * \brief Module configuration data.
+ */
+struct mod_scmi_fuzz_config {
+    /*! Table of messages the messages are drawn from */
+    const struct mod_scmi_fuzz_message *message_table;
+
+    /*! Number of messages in the message table */
+    unsigned int message_table_size;
+
+    /*! Number of messages sent by each agent */
+    unsigned int message_count;
+
+    /*!
+     * \brief Percentage of the messages drawn from the table which are
+     *      randomized.
+     */
+    unsigned int random_percentage;
+
+    /*!
+     * \brief Seed of the pseudo-random sequence of messages.
+     *
+     * \details The sequence of each agent is seeded with the sum of the seed
+     *      and the index of the agent.
+     */
+    uint32_t seed;
+};
+
+/*!
+ * \brief Agent configuration data.
+ */
+struct mod_scmi_fuzz_agent_config {
+    /*! Identifier of the SCMI queue channel of the agent */
+    fwk_id_t transport_id;
+
+    /*! Identifier of the queue API of the channel */
+    fwk_id_t transport_api_id;
+
+    /*! Maximum size in bytes of the payload of the messages */
+    size_t max_payload_size;
+
+    /*!
+     * \brief Number of messages the agent keeps in the queue of its channel.
+     *
+     * \details The agent sends its next message when it receives a response,
+     *      before the message is removed from the queue. The window must then
+     *      be lower than the length of the queue of the channel.
+     */
+    unsigned int window;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_scmi_fuzz_api_idx {
+    /*! SCMI queue driver API */
+    MOD_SCMI_FUZZ_API_IDX_DRIVER,
+
+    /*! Number of APIs */
+    MOD_SCMI_FUZZ_API_IDX_COUNT,
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_SCMI_FUZZ_H */
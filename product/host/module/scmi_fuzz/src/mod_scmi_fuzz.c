@@ -0,0 +1,539 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI fuzzing and throughput driver.
+ */
+
+/* Required for clock_gettime() and alarm() when building with -std=c11 */
+#define _POSIX_C_SOURCE 199309L
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <fwk_noreturn.h>
+#include <fwk_thread.h>
+#include <mod_log.h>
+#include <mod_scmi_fuzz.h>
+#include <mod_scmi_queue.h>
+#include <internal/mod_scmi.h>
+#include <internal/scmi.h>
+
+/* Environment variable giving the path of the recording to replay */
+#define RECORDING_VARIABLE "SCMI_FUZZ_RECORDING"
+
+/* Size in bytes of the header of a record: message header and payload size */
+#define RECORD_HEADER_SIZE (2 * sizeof(uint32_t))
+
+/* Number of responses between two resets of the stall watchdog */
+#define WATCHDOG_PERIOD 1024
+
+/* Number of protocol violations logged individually */
+#define VIOLATION_LOG_MAX 10
+
+/* Number of SCMI status codes, from SCMI_SUCCESS to SCMI_PROTOCOL_ERROR */
+#define STATUS_COUNT (1 - SCMI_PROTOCOL_ERROR)
+
+enum scmi_fuzz_event_idx {
+    /* Fill the queue of an agent */
+    SCMI_FUZZ_EVENT_IDX_START,
+
+    SCMI_FUZZ_EVENT_IDX_COUNT,
+};
+
+struct agent_ctx {
+    /* Agent configuration data */
+    const struct mod_scmi_fuzz_agent_config *config;
+
+    /* Queue API of the channel */
+    const struct mod_scmi_queue_api *queue_api;
+
+    /* Number of messages sent */
+    unsigned int sent_count;
+
+    /* Number of responses received */
+    unsigned int response_count;
+
+    /* Headers of the messages in the queue, in the order they were sent */
+    uint32_t *header_ring;
+
+    /* Index in the header ring of the message at the head of the queue */
+    unsigned int header_head;
+
+    /* Offset in the recording of the next message to replay */
+    size_t recording_offset;
+
+    /* Buffer the payload of the next message is built in */
+    uint32_t *payload;
+
+    /* State of the pseudo-random number generator */
+    uint32_t random;
+};
+
+struct scmi_fuzz_ctx {
+    /* Module configuration data */
+    const struct mod_scmi_fuzz_config *config;
+
+    /* Log API */
+    const struct mod_log_api *log_api;
+
+    /* Table of agent contexts */
+    struct agent_ctx *agent_ctx_table;
+
+    /* Number of agents */
+    unsigned int agent_count;
+
+    /* Number of agents that received all their responses */
+    unsigned int done_agent_count;
+
+    /* Recording replayed by the agents, NULL if none */
+    uint8_t *recording;
+
+    /* Size of the recording in bytes */
+    size_t recording_size;
+
+    /* Number of responses received by all the agents */
+    unsigned int response_count;
+
+    /* Number of responses per status, indexed by the opposite of the status */
+    unsigned int status_count[STATUS_COUNT];
+
+    /* Number of responses violating the protocol */
+    unsigned int violation_count;
+
+    /* Timestamp of the first message */
+    uint64_t start_timestamp;
+};
+
+static struct scmi_fuzz_ctx scmi_fuzz_ctx;
+
+/*
+ * Static functions
+ */
+
+static uint64_t get_timestamp(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (time.tv_sec * 1000000000ULL) + time.tv_nsec;
+}
+
+static void stall_handler(int signal_number)
+{
+    static const char message[] = "[FUZZ] No response for a second\n";
+    ssize_t written;
+
+    /* Only async-signal-safe functions can be called from the handler */
+    written = write(STDOUT_FILENO, message, sizeof(message) - 1);
+    (void)written;
+
+    _exit(EXIT_FAILURE);
+}
+
+/* Linear congruential generator, the sequence only depends on the seed */
+static uint32_t get_random(struct agent_ctx *agent_ctx)
+{
+    agent_ctx->random = (agent_ctx->random * 1103515245U) + 12345U;
+
+    return agent_ctx->random >> 16;
+}
+
+/*
+ * Load the recording given by the environment, and check that its records fit
+ * in the messages.
+ */
+static int load_recording(void)
+{
+    const char *path;
+    FILE *file;
+    long size;
+    size_t offset;
+    uint32_t payload_size;
+    int status = FWK_E_DATA;
+
+    path = getenv(RECORDING_VARIABLE);
+    if (path == NULL)
+        return FWK_SUCCESS;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+        return FWK_E_PARAM;
+
+    if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) <= 0) ||
+        (fseek(file, 0, SEEK_SET) != 0))
+        goto exit;
+
+    /* The recording lives as long as the process and may be large */
+    scmi_fuzz_ctx.recording = malloc(size);
+    if (scmi_fuzz_ctx.recording == NULL) {
+        status = FWK_E_NOMEM;
+        goto exit;
+    }
+
+    if (fread(scmi_fuzz_ctx.recording, 1, size, file) != (size_t)size) {
+        status = FWK_E_DEVICE;
+        goto exit;
+    }
+
+    for (offset = 0; offset < (size_t)size;
+         offset += RECORD_HEADER_SIZE + FWK_ALIGN_NEXT(payload_size, 4)) {
+        if (((size_t)size - offset) < RECORD_HEADER_SIZE)
+            goto exit;
+
+        memcpy(&payload_size,
+               &scmi_fuzz_ctx.recording[offset + sizeof(uint32_t)],
+               sizeof(payload_size));
+        if (FWK_ALIGN_NEXT(payload_size, 4) >
+            ((size_t)size - offset - RECORD_HEADER_SIZE))
+            goto exit;
+    }
+
+    scmi_fuzz_ctx.recording_size = size;
+    status = FWK_SUCCESS;
+
+exit:
+    fclose(file);
+
+    return status;
+}
+
+/*
+ * Build the next message of an agent in its payload buffer, returning its
+ * header and the size of its payload.
+ */
+static uint32_t build_message(struct agent_ctx *agent_ctx, size_t *size)
+{
+    const struct mod_scmi_fuzz_config *config = scmi_fuzz_ctx.config;
+    const struct mod_scmi_fuzz_message *message;
+    uint32_t header, payload_size;
+    size_t max_payload_size = agent_ctx->config->max_payload_size;
+    unsigned int word;
+
+    if (agent_ctx->recording_offset < scmi_fuzz_ctx.recording_size) {
+        const uint8_t *record =
+            &scmi_fuzz_ctx.recording[agent_ctx->recording_offset];
+
+        memcpy(&header, record, sizeof(header));
+        memcpy(&payload_size, record + sizeof(header), sizeof(payload_size));
+        agent_ctx->recording_offset +=
+            RECORD_HEADER_SIZE + FWK_ALIGN_NEXT(payload_size, 4);
+
+        /* The payloads too large for the channel are truncated */
+        *size = FWK_MIN(payload_size, max_payload_size);
+        memcpy(agent_ctx->payload, record + RECORD_HEADER_SIZE, *size);
+
+        return header;
+    }
+
+    message = &config->message_table[get_random(agent_ctx) %
+                                     config->message_table_size];
+    header = SCMI_MESSAGE_HEADER(message->message_id, message->protocol_id, 0);
+    *size = FWK_MIN(message->payload_size, max_payload_size);
+    if (*size > 0)
+        memcpy(agent_ctx->payload, message->payload, *size);
+
+    if ((get_random(agent_ctx) % 100) >= config->random_percentage)
+        return header;
+
+    switch (get_random(agent_ctx) % 3) {
+    case 0:
+        header &= ~SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK;
+        header |= (get_random(agent_ctx) << SCMI_MESSAGE_HEADER_MESSAGE_ID_POS)
+                  & SCMI_MESSAGE_HEADER_MESSAGE_ID_MASK;
+        break;
+
+    case 1:
+        *size = get_random(agent_ctx) % (max_payload_size + 1);
+        /* Fall through */
+
+    default:
+        for (word = 0; word < FWK_ALIGN_NEXT(*size, 4) / 4; word++)
+            agent_ctx->payload[word] =
+                (get_random(agent_ctx) << 16) ^ get_random(agent_ctx);
+        break;
+    }
+
+    return header;
+}
+
+static int send_message(struct agent_ctx *agent_ctx)
+{
+    uint32_t header;
+    size_t size;
+    unsigned int token, window = agent_ctx->config->window;
+
+    header = build_message(agent_ctx, &size);
+
+    /* The token identifies the message the response is for */
+    token = agent_ctx->sent_count;
+    header &= ~SCMI_MESSAGE_HEADER_TOKEN_MASK;
+    header |= (token << SCMI_MESSAGE_HEADER_TOKEN_POS) &
+              SCMI_MESSAGE_HEADER_TOKEN_MASK;
+
+    agent_ctx->header_ring[(agent_ctx->header_head +
+        (agent_ctx->sent_count - agent_ctx->response_count)) % window] = header;
+    agent_ctx->sent_count++;
+
+    return agent_ctx->queue_api->send(agent_ctx->config->transport_id, header,
+                                      agent_ctx->payload, size);
+}
+
+static void record_violation(uint32_t header, const char *reason)
+{
+    if (scmi_fuzz_ctx.violation_count++ < VIOLATION_LOG_MAX) {
+        MOD_LOG(scmi_fuzz_ctx.log_api, MOD_LOG_GROUP_ERROR,
+            "[FUZZ] Response to 0x%x: %s\n", header, reason);
+    }
+}
+
+static noreturn void report(void)
+{
+    uint64_t duration;
+    unsigned int status_idx;
+    int status;
+
+    /* Keep the duration above zero for the rate */
+    duration = ((get_timestamp() - scmi_fuzz_ctx.start_timestamp) / 1000) + 1;
+
+    alarm(0);
+
+    MOD_LOG(scmi_fuzz_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[FUZZ] messages=%u violations=%u duration_us=%u rate=%u\n",
+        scmi_fuzz_ctx.response_count, scmi_fuzz_ctx.violation_count,
+        (unsigned int)duration,
+        (unsigned int)((scmi_fuzz_ctx.response_count * 1000000ULL) /
+                       duration));
+
+    for (status_idx = 0; status_idx < STATUS_COUNT; status_idx++) {
+        if (scmi_fuzz_ctx.status_count[status_idx] == 0)
+            continue;
+
+        MOD_LOG(scmi_fuzz_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[FUZZ] status=%d count=%u\n", -(int)status_idx,
+            scmi_fuzz_ctx.status_count[status_idx]);
+    }
+
+    /* The processing time of the SCMI and protocol events */
+    status = scmi_fuzz_ctx.log_api->log_event_profile();
+    if ((status != FWK_SUCCESS) && (status != FWK_E_SUPPORT))
+        exit(EXIT_FAILURE);
+
+    scmi_fuzz_ctx.log_api->flush();
+
+    exit((scmi_fuzz_ctx.violation_count == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/*
+ * SCMI queue driver API
+ */
+
+static int receive_response(fwk_id_t driver_id, uint32_t message_header,
+                            const void *payload, size_t size)
+{
+    struct agent_ctx *agent_ctx;
+    uint32_t expected_header;
+    int32_t status;
+
+    agent_ctx =
+        &scmi_fuzz_ctx.agent_ctx_table[fwk_id_get_element_idx(driver_id)];
+
+    expected_header = agent_ctx->header_ring[agent_ctx->header_head];
+    agent_ctx->header_head =
+        (agent_ctx->header_head + 1) % agent_ctx->config->window;
+    agent_ctx->response_count++;
+
+    if (message_header != expected_header)
+        record_violation(expected_header, "unexpected header");
+    else if ((size < sizeof(status)) ||
+             (size > agent_ctx->config->max_payload_size))
+        record_violation(message_header, "invalid size");
+    else {
+        memcpy(&status, payload, sizeof(status));
+        if ((status > SCMI_SUCCESS) || (status < SCMI_PROTOCOL_ERROR))
+            record_violation(message_header, "invalid status");
+        else
+            scmi_fuzz_ctx.status_count[-status]++;
+    }
+
+    if ((++scmi_fuzz_ctx.response_count % WATCHDOG_PERIOD) == 0)
+        alarm(1);
+
+    if (agent_ctx->sent_count < scmi_fuzz_ctx.config->message_count)
+        return send_message(agent_ctx);
+
+    if ((agent_ctx->response_count == scmi_fuzz_ctx.config->message_count) &&
+        (++scmi_fuzz_ctx.done_agent_count == scmi_fuzz_ctx.agent_count))
+        report();
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_scmi_queue_driver_api driver_api = {
+    .receive_response = receive_response,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_fuzz_init(fwk_id_t module_id, unsigned int element_count,
+                          const void *data)
+{
+    const struct mod_scmi_fuzz_config *config = data;
+
+    if ((config == NULL) || (config->message_table_size == 0) ||
+        (config->message_count == 0) || (config->random_percentage > 100) ||
+        (element_count == 0))
+        return FWK_E_DATA;
+
+    scmi_fuzz_ctx.agent_ctx_table = fwk_mm_calloc(element_count,
+        sizeof(scmi_fuzz_ctx.agent_ctx_table[0]));
+    if (scmi_fuzz_ctx.agent_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    scmi_fuzz_ctx.config = config;
+    scmi_fuzz_ctx.agent_count = element_count;
+
+    return load_recording();
+}
+
+static int scmi_fuzz_agent_init(fwk_id_t agent_id, unsigned int unused,
+                                const void *data)
+{
+    const struct mod_scmi_fuzz_agent_config *config = data;
+    struct agent_ctx *agent_ctx;
+
+    if ((config == NULL) || (config->window == 0) ||
+        (config->max_payload_size == 0))
+        return FWK_E_DATA;
+
+    agent_ctx =
+        &scmi_fuzz_ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+
+    agent_ctx->header_ring = fwk_mm_calloc(config->window,
+                                           sizeof(agent_ctx->header_ring[0]));
+    if (agent_ctx->header_ring == NULL)
+        return FWK_E_NOMEM;
+
+    agent_ctx->payload =
+        fwk_mm_calloc(FWK_ALIGN_NEXT(config->max_payload_size, 4) / 4,
+                      sizeof(uint32_t));
+    if (agent_ctx->payload == NULL)
+        return FWK_E_NOMEM;
+
+    agent_ctx->config = config;
+    agent_ctx->random =
+        scmi_fuzz_ctx.config->seed + fwk_id_get_element_idx(agent_id);
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_fuzz_bind(fwk_id_t id, unsigned int round)
+{
+    struct agent_ctx *agent_ctx;
+
+    if (fwk_id_is_type(id, FWK_ID_TYPE_MODULE)) {
+        if (round != 0)
+            return FWK_SUCCESS;
+
+        return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+                               FWK_ID_API(FWK_MODULE_IDX_LOG, 0),
+                               &scmi_fuzz_ctx.log_api);
+    }
+
+    /* The channels bind to their driver in the first round */
+    if (round != 1)
+        return FWK_SUCCESS;
+
+    agent_ctx = &scmi_fuzz_ctx.agent_ctx_table[fwk_id_get_element_idx(id)];
+
+    return fwk_module_bind(agent_ctx->config->transport_id,
+                           agent_ctx->config->transport_api_id,
+                           &agent_ctx->queue_api);
+}
+
+static int scmi_fuzz_process_bind_request(fwk_id_t source_id,
+                                          fwk_id_t target_id,
+                                          fwk_id_t api_id,
+                                          const void **api)
+{
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT) ||
+        (fwk_id_get_api_idx(api_id) != MOD_SCMI_FUZZ_API_IDX_DRIVER))
+        return FWK_E_PARAM;
+
+    *api = &driver_api;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_fuzz_start(fwk_id_t id)
+{
+    struct fwk_event event = {
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_FUZZ,
+                           SCMI_FUZZ_EVENT_IDX_START),
+        .source_id = id,
+        .target_id = id,
+    };
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    /* The queues are filled once the framework runs */
+    return fwk_thread_put_event(&event);
+}
+
+static int scmi_fuzz_process_event(const struct fwk_event *event,
+                                   struct fwk_event *resp_event)
+{
+    struct agent_ctx *agent_ctx;
+    unsigned int message_count = scmi_fuzz_ctx.config->message_count;
+    int status;
+
+    agent_ctx = &scmi_fuzz_ctx.agent_ctx_table[
+        fwk_id_get_element_idx(event->target_id)];
+
+    if (scmi_fuzz_ctx.start_timestamp == 0) {
+        signal(SIGALRM, stall_handler);
+        alarm(1);
+        scmi_fuzz_ctx.start_timestamp = get_timestamp();
+    }
+
+    while ((agent_ctx->sent_count < agent_ctx->config->window) &&
+           (agent_ctx->sent_count < message_count)) {
+        status = send_message(agent_ctx);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_scmi_fuzz = {
+    .name = "SCMI fuzz",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_SCMI_FUZZ_API_IDX_COUNT,
+    .event_count = SCMI_FUZZ_EVENT_IDX_COUNT,
+    .init = scmi_fuzz_init,
+    .element_init = scmi_fuzz_agent_init,
+    .bind = scmi_fuzz_bind,
+    .start = scmi_fuzz_start,
+    .process_bind_request = scmi_fuzz_process_bind_request,
+    .process_event = scmi_fuzz_process_event,
+};
@@ -0,0 +1,129 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     In-process SCMI transport.
+ */
+
+#ifndef MOD_SCMI_QUEUE_H
+#define MOD_SCMI_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <fwk_id.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostScmiQueue SCMI Queue Transport
+ *
+ * \details The module is an SCMI transport standing in for the SMT and MHU
+ *      modules on the host. Each channel holds a queue of the messages sent by
+ *      its agent, the driver of the channel, in the memory of the process.
+ *      The SCMI service bound to the channel processes the messages of the
+ *      queue in order, and the response to each message is returned to the
+ *      driver before the next message is signalled to the service.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Channel configuration data.
+ */
+struct mod_scmi_queue_channel_config {
+    /*! Maximum number of messages in the queue of the channel */
+    unsigned int queue_length;
+
+    /*! Maximum size in bytes of the payload of a message or response */
+    size_t max_payload_size;
+
+    /*! Whether the channel is secure */
+    bool secure;
+
+    /*! Identifier of the driver of the channel */
+    fwk_id_t driver_id;
+
+    /*! Identifier of the API of the driver receiving the responses */
+    fwk_id_t driver_api_id;
+};
+
+/*!
+ * \brief Driver API, implemented by the driver of a channel.
+ */
+struct mod_scmi_queue_driver_api {
+    /*!
+     * \brief Receive the response to the message at the head of the queue.
+     *
+     * \details The message is removed from the queue once the function
+     *      returns, the response payload is only valid until then.
+     *
+     * \param driver_id Identifier of the driver of the channel.
+     * \param message_header Header of the message.
+     * \param payload Response payload.
+     * \param size Size of the response payload in bytes.
+     *
+     * \retval FWK_SUCCESS The response was received.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*receive_response)(fwk_id_t driver_id, uint32_t message_header,
+                            const void *payload, size_t size);
+};
+
+/*!
+ * \brief Queue API, used by the driver of a channel to send messages.
+ */
+struct mod_scmi_queue_api {
+    /*!
+     * \brief Add a message to the queue of a channel.
+     *
+     * \details The payload is copied into the queue. The SCMI service bound to
+     *      the channel is signalled when the queue was empty, and otherwise
+     *      once the message reaches the head of the queue.
+     *
+     * \param channel_id Channel identifier.
+     * \param message_header Message header.
+     * \param payload Message payload, may be NULL if the size is zero.
+     * \param size Size of the message payload in bytes.
+     *
+     * \retval FWK_SUCCESS The message was added to the queue.
+     * \retval FWK_E_PARAM The size of the payload exceeds the maximum payload
+     *      size of the channel.
+     * \retval FWK_E_BUSY The queue of the channel is full.
+     * \return One of the standard error codes for implementation-defined
+     *      errors.
+     */
+    int (*send)(fwk_id_t channel_id, uint32_t message_header,
+                const void *payload, size_t size);
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_scmi_queue_api_idx {
+    /*! SCMI transport API */
+    MOD_SCMI_QUEUE_API_IDX_SCMI_TRANSPORT,
+
+    /*! Queue API */
+    MOD_SCMI_QUEUE_API_IDX_QUEUE,
+
+    /*! Number of APIs */
+    MOD_SCMI_QUEUE_API_IDX_COUNT,
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_SCMI_QUEUE_H */
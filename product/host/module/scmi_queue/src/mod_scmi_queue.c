@@ -0,0 +1,383 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     In-process SCMI transport.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <mod_scmi.h>
+#include <mod_scmi_queue.h>
+
+/* Message of a queue */
+struct message {
+    /* Message header */
+    uint32_t header;
+
+    /* Size in bytes of the message payload, then of the response payload */
+    size_t size;
+
+    /* Payload, shared by the message and its response */
+    uint32_t *payload;
+};
+
+struct channel_ctx {
+    /* Channel configuration data */
+    const struct mod_scmi_queue_channel_config *config;
+
+    /* Driver API */
+    const struct mod_scmi_queue_driver_api *driver_api;
+
+    /* Identifier of the SCMI service bound to the channel */
+    fwk_id_t service_id;
+
+    /* SCMI service API */
+    const struct mod_scmi_from_transport_api *scmi_api;
+
+    /* Ring of messages, the message at the head is being processed */
+    struct message *queue;
+
+    /* Index of the message at the head of the queue */
+    unsigned int head;
+
+    /* Number of messages in the queue */
+    unsigned int count;
+};
+
+static struct channel_ctx *channel_ctx_table;
+
+/*
+ * Static functions
+ */
+
+static struct channel_ctx *get_channel_ctx(fwk_id_t channel_id)
+{
+    return &channel_ctx_table[fwk_id_get_element_idx(channel_id)];
+}
+
+/*
+ * Get the message being processed by the SCMI service of a channel, NULL if
+ * the queue is empty.
+ */
+static struct message *get_head(fwk_id_t channel_id)
+{
+    struct channel_ctx *channel_ctx;
+    int status;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return NULL;
+
+    channel_ctx = get_channel_ctx(channel_id);
+    if (channel_ctx->count == 0)
+        return NULL;
+
+    return &channel_ctx->queue[channel_ctx->head];
+}
+
+/*
+ * SCMI transport API
+ */
+
+static int get_secure(fwk_id_t channel_id, bool *secure)
+{
+    int status;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (secure == NULL)
+        return FWK_E_PARAM;
+
+    *secure = get_channel_ctx(channel_id)->config->secure;
+
+    return FWK_SUCCESS;
+}
+
+static int get_max_payload_size(fwk_id_t channel_id, size_t *size)
+{
+    int status;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (size == NULL)
+        return FWK_E_PARAM;
+
+    *size = get_channel_ctx(channel_id)->config->max_payload_size;
+
+    return FWK_SUCCESS;
+}
+
+static int get_message_header(fwk_id_t channel_id, uint32_t *message_header)
+{
+    struct message *message;
+
+    if (message_header == NULL)
+        return FWK_E_PARAM;
+
+    message = get_head(channel_id);
+    if (message == NULL)
+        return FWK_E_ACCESS;
+
+    *message_header = message->header;
+
+    return FWK_SUCCESS;
+}
+
+static int get_payload(fwk_id_t channel_id, const void **payload,
+                       size_t *size)
+{
+    struct message *message;
+
+    if (payload == NULL)
+        return FWK_E_PARAM;
+
+    message = get_head(channel_id);
+    if (message == NULL)
+        return FWK_E_ACCESS;
+
+    *payload = message->payload;
+    if (size != NULL)
+        *size = message->size;
+
+    return FWK_SUCCESS;
+}
+
+static int write_payload(fwk_id_t channel_id, size_t offset,
+                         const void *payload, size_t size)
+{
+    struct message *message;
+    size_t max_payload_size;
+
+    if (payload == NULL)
+        return FWK_E_PARAM;
+
+    message = get_head(channel_id);
+    if (message == NULL)
+        return FWK_E_ACCESS;
+
+    max_payload_size = get_channel_ctx(channel_id)->config->max_payload_size;
+    if ((offset > max_payload_size) || (size > (max_payload_size - offset)))
+        return FWK_E_PARAM;
+
+    memmove((uint8_t *)message->payload + offset, payload, size);
+
+    return FWK_SUCCESS;
+}
+
+static int respond(fwk_id_t channel_id, const void *payload, size_t size)
+{
+    struct channel_ctx *channel_ctx;
+    struct message *message;
+    int status;
+
+    message = get_head(channel_id);
+    if (message == NULL)
+        return FWK_E_ACCESS;
+
+    channel_ctx = get_channel_ctx(channel_id);
+    if (size > channel_ctx->config->max_payload_size)
+        return FWK_E_PARAM;
+
+    if (payload != NULL)
+        memmove(message->payload, payload, size);
+    message->size = size;
+
+    status = channel_ctx->driver_api->receive_response(
+        channel_ctx->config->driver_id, message->header, message->payload,
+        size);
+
+    channel_ctx->head = (channel_ctx->head + 1) %
+                        channel_ctx->config->queue_length;
+    channel_ctx->count--;
+
+    /* The service processes the messages one at a time */
+    if (channel_ctx->count > 0)
+        channel_ctx->scmi_api->signal_message(channel_ctx->service_id);
+
+    return status;
+}
+
+static const struct mod_scmi_to_transport_api scmi_transport_api = {
+    .get_secure = get_secure,
+    .get_max_payload_size = get_max_payload_size,
+    .get_message_header = get_message_header,
+    .get_payload = get_payload,
+    .write_payload = write_payload,
+    .respond = respond,
+};
+
+/*
+ * Queue API
+ */
+
+static int send(fwk_id_t channel_id, uint32_t message_header,
+                const void *payload, size_t size)
+{
+    struct channel_ctx *channel_ctx;
+    struct message *message;
+    int status;
+
+    status = fwk_module_check_call(channel_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    channel_ctx = get_channel_ctx(channel_id);
+
+    if ((size > channel_ctx->config->max_payload_size) ||
+        ((payload == NULL) && (size != 0)))
+        return FWK_E_PARAM;
+
+    if (channel_ctx->count == channel_ctx->config->queue_length)
+        return FWK_E_BUSY;
+
+    message = &channel_ctx->queue[(channel_ctx->head + channel_ctx->count) %
+                                  channel_ctx->config->queue_length];
+    message->header = message_header;
+    message->size = size;
+    if (size != 0)
+        memcpy(message->payload, payload, size);
+
+    if (channel_ctx->count++ > 0)
+        return FWK_SUCCESS;
+
+    return channel_ctx->scmi_api->signal_message(channel_ctx->service_id);
+}
+
+static const struct mod_scmi_queue_api queue_api = {
+    .send = send,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int scmi_queue_init(fwk_id_t module_id, unsigned int channel_count,
+                           const void *data)
+{
+    if (channel_count == 0)
+        return FWK_E_DATA;
+
+    channel_ctx_table = fwk_mm_calloc(channel_count,
+                                      sizeof(channel_ctx_table[0]));
+    if (channel_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_queue_channel_init(fwk_id_t channel_id, unsigned int unused,
+                                   const void *data)
+{
+    const struct mod_scmi_queue_channel_config *config = data;
+    struct channel_ctx *channel_ctx;
+    unsigned int message_idx;
+    size_t payload_words;
+    uint32_t *payload;
+
+    if ((config == NULL) || (config->queue_length == 0) ||
+        (config->max_payload_size < sizeof(int32_t)))
+        return FWK_E_DATA;
+
+    channel_ctx = get_channel_ctx(channel_id);
+
+    channel_ctx->queue = fwk_mm_calloc(config->queue_length,
+                                       sizeof(channel_ctx->queue[0]));
+    if (channel_ctx->queue == NULL)
+        return FWK_E_NOMEM;
+
+    payload_words = FWK_ALIGN_NEXT(config->max_payload_size,
+                                   sizeof(uint32_t)) / sizeof(uint32_t);
+    payload = fwk_mm_calloc(config->queue_length * payload_words,
+                            sizeof(uint32_t));
+    if (payload == NULL)
+        return FWK_E_NOMEM;
+
+    for (message_idx = 0; message_idx < config->queue_length; message_idx++)
+        channel_ctx->queue[message_idx].payload =
+            &payload[message_idx * payload_words];
+
+    channel_ctx->config = config;
+
+    return FWK_SUCCESS;
+}
+
+static int scmi_queue_bind(fwk_id_t id, unsigned int round)
+{
+    struct channel_ctx *channel_ctx;
+
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    channel_ctx = get_channel_ctx(id);
+
+    if (round == 0) {
+        return fwk_module_bind(channel_ctx->config->driver_id,
+                               channel_ctx->config->driver_api_id,
+                               &channel_ctx->driver_api);
+    }
+
+    /* The SCMI service bound to the channel in the first round */
+    return fwk_module_bind(channel_ctx->service_id,
+        FWK_ID_API(FWK_MODULE_IDX_SCMI, MOD_SCMI_API_IDX_TRANSPORT),
+        &channel_ctx->scmi_api);
+}
+
+static int scmi_queue_process_bind_request(fwk_id_t source_id,
+                                           fwk_id_t target_id,
+                                           fwk_id_t api_id,
+                                           const void **api)
+{
+    struct channel_ctx *channel_ctx;
+
+    if (!fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_PARAM;
+
+    channel_ctx = get_channel_ctx(target_id);
+
+    switch (fwk_id_get_api_idx(api_id)) {
+    case MOD_SCMI_QUEUE_API_IDX_SCMI_TRANSPORT:
+        channel_ctx->service_id = source_id;
+        *api = &scmi_transport_api;
+        break;
+
+    case MOD_SCMI_QUEUE_API_IDX_QUEUE:
+        if ((fwk_id_get_module_idx(source_id) !=
+             fwk_id_get_module_idx(channel_ctx->config->driver_id)) ||
+            (fwk_id_get_element_idx(source_id) !=
+             fwk_id_get_element_idx(channel_ctx->config->driver_id)))
+            return FWK_E_ACCESS;
+
+        *api = &queue_api;
+        break;
+
+    default:
+        return FWK_E_PARAM;
+    }
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_scmi_queue = {
+    .name = "SCMI queue",
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .api_count = MOD_SCMI_QUEUE_API_IDX_COUNT,
+    .init = scmi_queue_init,
+    .element_init = scmi_queue_channel_init,
+    .bind = scmi_queue_bind,
+    .process_bind_request = scmi_queue_process_bind_request,
+};
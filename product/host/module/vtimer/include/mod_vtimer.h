@@ -0,0 +1,86 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Virtual timer driver.
+ */
+
+#ifndef MOD_VTIMER_H
+#define MOD_VTIMER_H
+
+#include <stdint.h>
+
+/*!
+ * \addtogroup GroupHostModule Host Product Modules
+ * @{
+ */
+
+/*!
+ * \defgroup GroupHostVtimer Virtual Timer
+ *
+ * \details Timer driver for the timer module counting virtual time. The
+ *      counter of a device does not progress while the firmware runs: it
+ *      jumps to the earliest timestamp the device is armed for when the
+ *      firmware waits for an interrupt, and the timer interrupt of the device
+ *      is raised. Long scenarios driven by alarms and timeouts thus run as
+ *      fast as the events can be processed, and the same scenario always
+ *      results in the same sequence of events and timestamps.
+ *
+ *      Busy-waits on the counter, such as the delays of the timer module,
+ *      complete only if the device is configured to advance the virtual time
+ *      on every read of its counter.
+ *
+ *      The firmware waits for an interrupt in the idle handler of the
+ *      framework, only called in single-threaded builds: the module is not
+ *      supported in multi-threaded builds.
+ *
+ * @{
+ */
+
+/*!
+ * \brief Device configuration data.
+ */
+struct mod_vtimer_dev_config {
+    /*! Frequency of the counter in Hertz */
+    uint32_t frequency;
+
+    /*!
+     * \brief Timer interrupt of the device.
+     *
+     * \details Must be the interrupt configured for the device in the timer
+     *      module.
+     */
+    unsigned int timer_irq;
+
+    /*!
+     * \brief Virtual time in nanoseconds elapsing on each read of the counter.
+     *
+     * \details Emulates the time spent polling the counter. When 0, the
+     *      counter only progresses while the firmware waits for an interrupt.
+     */
+    uint32_t read_time;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_vtimer_api_idx {
+    /*! Timer driver API */
+    MOD_VTIMER_API_IDX_DRIVER,
+
+    /*! Number of APIs */
+    MOD_VTIMER_API_IDX_COUNT,
+};
+
+/*!
+ * @}
+ */
+
+/*!
+ * @}
+ */
+
+#endif /* MOD_VTIMER_H */
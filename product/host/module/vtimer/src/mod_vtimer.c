@@ -0,0 +1,286 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     Virtual timer driver.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <mod_timer.h>
+#include <mod_vtimer.h>
+
+#define NANOSECONDS_PER_SECOND UINT64_C(1000000000)
+
+/* Set the handler called by the host when the firmware waits, see host.c */
+extern void host_set_idle_handler(bool (*handler)(void));
+
+/* Device context */
+struct dev_ctx {
+    /* Device configuration data */
+    const struct mod_vtimer_dev_config *config;
+
+    /* Counter value the timer interrupt is raised at */
+    uint64_t compare;
+
+    /* Whether the timer interrupt is enabled */
+    bool enabled;
+};
+
+static struct {
+    /* Table of device contexts */
+    struct dev_ctx *dev_ctx_table;
+
+    /* Number of devices */
+    unsigned int dev_count;
+
+    /*
+     * Virtual time in nanoseconds, common to all the devices so that their
+     * counters stay consistent with each other.
+     */
+    uint64_t time;
+} vtimer_ctx;
+
+/*
+ * Static functions
+ */
+
+/* Counter value of a device at a virtual time */
+static uint64_t time_to_counter(const struct dev_ctx *ctx, uint64_t time)
+{
+    uint64_t frequency = ctx->config->frequency;
+
+    return ((time / NANOSECONDS_PER_SECOND) * frequency) +
+           (((time % NANOSECONDS_PER_SECOND) * frequency) /
+            NANOSECONDS_PER_SECOND);
+}
+
+/* Earliest virtual time at which the counter of a device reaches a value */
+static uint64_t counter_to_time(const struct dev_ctx *ctx, uint64_t counter)
+{
+    uint64_t frequency = ctx->config->frequency;
+
+    return ((counter / frequency) * NANOSECONDS_PER_SECOND) +
+           ((((counter % frequency) * NANOSECONDS_PER_SECOND) +
+            frequency - 1) / frequency);
+}
+
+/* Raise the timer interrupt of a device if its counter reached the compare */
+static void update_interrupt(const struct dev_ctx *ctx)
+{
+    if (ctx->enabled &&
+        (time_to_counter(ctx, vtimer_ctx.time) >= ctx->compare))
+        fwk_interrupt_set_pending(ctx->config->timer_irq);
+}
+
+/*
+ * Handler called when the firmware waits for an interrupt. The virtual time
+ * jumps to the earliest time a device is armed for and the interrupts of the
+ * devices whose counter reached their compare value are raised.
+ */
+static bool idle(void)
+{
+    bool armed = false;
+    uint64_t deadline = UINT64_MAX;
+    uint64_t time;
+    unsigned int dev_idx;
+    struct dev_ctx *ctx;
+
+    for (dev_idx = 0; dev_idx < vtimer_ctx.dev_count; dev_idx++) {
+        ctx = &vtimer_ctx.dev_ctx_table[dev_idx];
+        if (!ctx->enabled)
+            continue;
+
+        time = counter_to_time(ctx, ctx->compare);
+        deadline = FWK_MIN(deadline, time);
+        armed = true;
+    }
+
+    if (!armed)
+        return false;
+
+    vtimer_ctx.time = FWK_MAX(vtimer_ctx.time, deadline);
+
+    for (dev_idx = 0; dev_idx < vtimer_ctx.dev_count; dev_idx++)
+        update_interrupt(&vtimer_ctx.dev_ctx_table[dev_idx]);
+
+    return true;
+}
+
+/*
+ * Functions fulfilling the Timer module's driver interface
+ */
+
+static int enable(fwk_id_t dev_id)
+{
+    struct dev_ctx *ctx;
+    int status;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx = &vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)];
+    ctx->enabled = true;
+    update_interrupt(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int disable(fwk_id_t dev_id)
+{
+    int status;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)].enabled = false;
+
+    return FWK_SUCCESS;
+}
+
+static int set_timer(fwk_id_t dev_id, uint64_t timestamp)
+{
+    struct dev_ctx *ctx;
+    int status;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ctx = &vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)];
+    ctx->compare = timestamp;
+    update_interrupt(ctx);
+
+    return FWK_SUCCESS;
+}
+
+static int get_timer(fwk_id_t dev_id, uint64_t *timestamp)
+{
+    int status;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *timestamp = vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)].
+        compare;
+
+    return FWK_SUCCESS;
+}
+
+static int get_counter(fwk_id_t dev_id, uint64_t *value)
+{
+    unsigned int dev_idx;
+    struct dev_ctx *ctx;
+
+    ctx = &vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)];
+
+    *value = time_to_counter(ctx, vtimer_ctx.time);
+
+    if (ctx->config->read_time != 0) {
+        vtimer_ctx.time += ctx->config->read_time;
+
+        for (dev_idx = 0; dev_idx < vtimer_ctx.dev_count; dev_idx++)
+            update_interrupt(&vtimer_ctx.dev_ctx_table[dev_idx]);
+    }
+
+    return FWK_SUCCESS;
+}
+
+static int get_frequency(fwk_id_t dev_id, uint32_t *frequency)
+{
+    int status;
+
+    if (frequency == NULL)
+        return FWK_E_PARAM;
+
+    status = fwk_module_check_call(dev_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    *frequency =
+        vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(dev_id)].config->
+        frequency;
+
+    return FWK_SUCCESS;
+}
+
+static const struct mod_timer_driver_api driver_api = {
+    .name = "Virtual Timer Driver",
+    .enable = enable,
+    .disable = disable,
+    .set_timer = set_timer,
+    .get_timer = get_timer,
+    .get_counter = get_counter,
+    .get_frequency = get_frequency,
+};
+
+/*
+ * Framework handlers
+ */
+
+static int vtimer_init(fwk_id_t module_id, unsigned int element_count,
+                       const void *data)
+{
+    #ifdef BUILD_HAS_MULTITHREADING
+    /* The framework does not call the idle handler in multi-thread builds */
+    return FWK_E_SUPPORT;
+    #else
+    vtimer_ctx.dev_ctx_table = fwk_mm_calloc(element_count,
+                                             sizeof(struct dev_ctx));
+    if (vtimer_ctx.dev_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
+    vtimer_ctx.dev_count = element_count;
+
+    host_set_idle_handler(idle);
+
+    return FWK_SUCCESS;
+    #endif
+}
+
+static int vtimer_element_init(fwk_id_t element_id, unsigned int unused,
+                               const void *data)
+{
+    const struct mod_vtimer_dev_config *config = data;
+
+    if ((config == NULL) || (config->frequency == 0))
+        return FWK_E_PARAM;
+
+    vtimer_ctx.dev_ctx_table[fwk_id_get_element_idx(element_id)].config =
+        config;
+
+    return FWK_SUCCESS;
+}
+
+static int vtimer_process_bind_request(fwk_id_t requester_id, fwk_id_t id,
+                                       fwk_id_t api_id, const void **api)
+{
+    /* Only bindings to the devices are allowed */
+    if (!fwk_module_is_valid_element_id(id))
+        return FWK_E_ACCESS;
+
+    *api = &driver_api;
+
+    return FWK_SUCCESS;
+}
+
+const struct fwk_module module_vtimer = {
+    .name = "Virtual Timer",
+    .api_count = MOD_VTIMER_API_IDX_COUNT,
+    .type = FWK_MODULE_TYPE_DRIVER,
+    .init = vtimer_init,
+    .element_init = vtimer_element_init,
+    .process_bind_request = vtimer_process_bind_request,
+};
@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_pd_bench.h>
+#include <mod_pd_bench.h>
+#include <mod_power_domain.h>
+
+/*
+ * The thresholds leave a wide margin over the results on a development host
+ * so that only a significant regression makes the benchmark fail.
+ */
+static const struct mod_pd_bench_config pd_bench_config = {
+    .transition_count = 10000,
+    .suspend_count = 1000,
+    .system_suspend_state = MOD_PD_STATE_SLEEP,
+    .seed = 1,
+    .max_p99_latency = 2000000,
+    .min_rate = 1000,
+};
+
+static const struct fwk_element *get_element_table(fwk_id_t module_id)
+{
+    struct fwk_element *element_table;
+    struct mod_pd_bench_domain_config *domain_config_table;
+    unsigned int pd_idx;
+
+    element_table = fwk_mm_calloc(HOST_PD_BENCH_PD_COUNT + 1, /* Terminator */
+                                  sizeof(struct fwk_element));
+    if (element_table == NULL)
+        return NULL;
+
+    domain_config_table = fwk_mm_calloc(HOST_PD_BENCH_PD_COUNT,
+        sizeof(struct mod_pd_bench_domain_config));
+    if (domain_config_table == NULL)
+        return NULL;
+
+    /* Each element is the mock PPU of the power domain of the same index */
+    for (pd_idx = 0; pd_idx < HOST_PD_BENCH_PD_COUNT; pd_idx++) {
+        domain_config_table[pd_idx].pd_id =
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_POWER_DOMAIN, pd_idx);
+        element_table[pd_idx].name = "";
+        element_table[pd_idx].data = &domain_config_table[pd_idx];
+    }
+
+    return element_table;
+}
+
+const struct fwk_module_config config_pd_bench = {
+    .get_element_table = get_element_table,
+    .data = &pd_bench_config,
+};
@@ -0,0 +1,135 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_mm.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_pd_bench.h>
+#include <mod_pd_bench.h>
+#include <mod_power_domain.h>
+
+/* Maximum power domain name size including the null terminator */
+#define PD_NAME_SIZE 12
+
+/* Mask of the allowed states for the system power domain */
+static const uint32_t system_allowed_state_mask_table[] = {
+    [0] = MOD_PD_STATE_OFF_MASK | MOD_PD_STATE_ON_MASK |
+          MOD_PD_STATE_SLEEP_MASK,
+};
+
+/*
+ * Mask of the allowed states for the cluster power domains depending on the
+ * system states.
+ */
+static const uint32_t cluster_allowed_state_mask_table[] = {
+    [MOD_PD_STATE_OFF] = MOD_PD_STATE_OFF_MASK,
+    [MOD_PD_STATE_ON] = MOD_PD_STATE_OFF_MASK | MOD_PD_STATE_ON_MASK,
+    [MOD_PD_STATE_SLEEP] = MOD_PD_STATE_OFF_MASK,
+};
+
+/* Mask of the allowed states for a core depending on the cluster states */
+static const uint32_t core_allowed_state_mask_table[] = {
+    [MOD_PD_STATE_OFF] = MOD_PD_STATE_OFF_MASK,
+    [MOD_PD_STATE_ON] = MOD_PD_STATE_OFF_MASK | MOD_PD_STATE_ON_MASK,
+};
+
+/*
+ * Power module specific configuration data, no timestamping timer and no
+ * bound on the quiescing before a shutdown
+ */
+static const struct mod_power_domain_config power_domain_config = {
+    .stats_timer_id = FWK_ID_NONE_INIT,
+    .shutdown_alarm_id = FWK_ID_NONE_INIT,
+};
+
+/*
+ * Function definitions with internal linkage
+ */
+static const struct fwk_element *get_element_table(fwk_id_t module_id)
+{
+    struct fwk_element *element_table, *element;
+    struct mod_power_domain_element_config *pd_config_table, *pd_config;
+    unsigned int pd_idx, cluster_idx, core_idx;
+
+    element_table = fwk_mm_calloc(HOST_PD_BENCH_PD_COUNT + 1, /* Terminator */
+                                  sizeof(struct fwk_element));
+    if (element_table == NULL)
+        return NULL;
+
+    pd_config_table = fwk_mm_calloc(HOST_PD_BENCH_PD_COUNT,
+        sizeof(struct mod_power_domain_element_config));
+    if (pd_config_table == NULL)
+        return NULL;
+
+    for (pd_idx = 0; pd_idx < HOST_PD_BENCH_PD_COUNT; pd_idx++) {
+        element = &element_table[pd_idx];
+        pd_config = &pd_config_table[pd_idx];
+
+        element->name = fwk_mm_alloc(PD_NAME_SIZE, 1);
+        if (element->name == NULL)
+            return NULL;
+
+        element->data = pd_config;
+
+        pd_config->driver_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_PD_BENCH, pd_idx);
+        pd_config->api_id = FWK_ID_API(FWK_MODULE_IDX_PD_BENCH,
+                                       MOD_PD_BENCH_API_IDX_DRIVER);
+
+        if (pd_idx < HOST_PD_BENCH_PD_IDX_CLUSTER0) {
+            cluster_idx = pd_idx / HOST_PD_BENCH_CORE_PER_CLUSTER_COUNT;
+            core_idx = pd_idx % HOST_PD_BENCH_CORE_PER_CLUSTER_COUNT;
+
+            snprintf((char *)element->name, PD_NAME_SIZE, "CLUS%uCORE%u",
+                     cluster_idx, core_idx);
+
+            pd_config->attributes.pd_type = MOD_PD_TYPE_CORE;
+            pd_config->tree_pos = MOD_PD_TREE_POS(
+                MOD_PD_LEVEL_0, 0, 0, cluster_idx, core_idx);
+            pd_config->allowed_state_mask_table =
+                core_allowed_state_mask_table;
+            pd_config->allowed_state_mask_table_size =
+                FWK_ARRAY_SIZE(core_allowed_state_mask_table);
+        } else if (pd_idx < HOST_PD_BENCH_PD_IDX_SYSTEM) {
+            cluster_idx = pd_idx - HOST_PD_BENCH_PD_IDX_CLUSTER0;
+
+            snprintf((char *)element->name, PD_NAME_SIZE, "CLUS%u",
+                     cluster_idx);
+
+            pd_config->attributes.pd_type = MOD_PD_TYPE_CLUSTER;
+            pd_config->tree_pos = MOD_PD_TREE_POS(
+                MOD_PD_LEVEL_1, 0, 0, cluster_idx, 0);
+            pd_config->allowed_state_mask_table =
+                cluster_allowed_state_mask_table;
+            pd_config->allowed_state_mask_table_size =
+                FWK_ARRAY_SIZE(cluster_allowed_state_mask_table);
+        } else {
+            snprintf((char *)element->name, PD_NAME_SIZE, "SYSTOP");
+
+            pd_config->attributes.pd_type = MOD_PD_TYPE_SYSTEM;
+            pd_config->tree_pos = MOD_PD_TREE_POS(MOD_PD_LEVEL_2, 0, 0, 0, 0);
+            pd_config->allowed_state_mask_table =
+                system_allowed_state_mask_table;
+            pd_config->allowed_state_mask_table_size =
+                FWK_ARRAY_SIZE(system_allowed_state_mask_table);
+        }
+    }
+
+    return element_table;
+}
+
+/*
+ * Power module configuration data
+ */
+const struct fwk_module_config config_power_domain = {
+    .get_element_table = get_element_table,
+    .data = &power_domain_config,
+};
@@ -0,0 +1,26 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The power domain module relies on the delayed responses and on the blocking
+# events of the multi-threaded framework.
+#
+# The power domain module is bound to its drivers before the pd_bench module
+# binds to its driver input API, thus it is listed before it.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := yes
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_MODULES := log \
+                       host_console \
+                       power_domain \
+                       pd_bench
+
+BS_FIRMWARE_SOURCES := config_log.c \
+                       config_power_domain.c \
+                       config_pd_bench.c
+
+include $(BS_DIR)/firmware.mk
@@ -6,4 +6,8 @@
 #
 
 BS_PRODUCT_NAME := Host
-BS_FIRMWARE_LIST := fw
+BS_FIRMWARE_LIST := fw \
+                    scmi_bench \
+                    scmi_fuzz \
+                    vtime \
+                    pd_bench
@@ -0,0 +1,119 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_scmi.h>
+#include <mod_scmi_bench.h>
+#include <mod_smt.h>
+#include <internal/scmi.h>
+#include <internal/scmi_base.h>
+#include <internal/scmi_sensor.h>
+
+/*
+ * Message mix: the sensor readings dominate, as for an agent polling the
+ * temperature, with occasional discovery messages.
+ */
+static const struct mod_scmi_bench_message message_table[] = {
+    {
+        .name = "BASE_PROTOCOL_VERSION",
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_PROTOCOL_VERSION,
+        .weight = 1,
+    },
+    {
+        .name = "BASE_DISCOVER_VENDOR",
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_BASE_DISCOVER_VENDOR,
+        .weight = 1,
+    },
+    {
+        .name = "BASE_DISCOVER_LIST_PROTOCOLS",
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_BASE_DISCOVER_LIST_PROTOCOLS,
+        .payload = &((struct scmi_base_discover_list_protocols_a2p) {
+            .skip = 0,
+        }),
+        .payload_size = sizeof(struct scmi_base_discover_list_protocols_a2p),
+        .weight = 1,
+    },
+    {
+        .name = "SENSOR_PROTOCOL_ATTRIBUTES",
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_PROTOCOL_ATTRIBUTES,
+        .weight = 1,
+    },
+    {
+        .name = "SENSOR_DESCRIPTION_GET",
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_SENSOR_DESCRIPTION_GET,
+        .payload = &((struct scmi_sensor_protocol_description_get_a2p) {
+            .desc_index = 0,
+        }),
+        .payload_size =
+            sizeof(struct scmi_sensor_protocol_description_get_a2p),
+        .weight = 2,
+    },
+    {
+        .name = "SENSOR_READING_GET",
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_SENSOR_READING_GET,
+        .payload = &((struct scmi_sensor_protocol_reading_get_a2p) {
+            .sensor_id = 0,
+            .flags = 0,
+        }),
+        .payload_size = sizeof(struct scmi_sensor_protocol_reading_get_a2p),
+        .weight = 10,
+    },
+};
+
+static const struct fwk_element agent_table[] = {
+    [HOST_SCMI_SERVICE_IDX_PSCI] = {
+        .name = "PSCI",
+        .data = &((struct mod_scmi_bench_agent_config) {
+            .transport_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SMT,
+                                                HOST_SCMI_SERVICE_IDX_PSCI),
+            .transport_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SMT,
+                                                MOD_SMT_API_IDX_DRIVER_INPUT),
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[
+                HOST_SCMI_SERVICE_IDX_PSCI],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_OSPM] = {
+        .name = "OSPM",
+        .data = &((struct mod_scmi_bench_agent_config) {
+            .transport_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SMT,
+                                                HOST_SCMI_SERVICE_IDX_OSPM),
+            .transport_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SMT,
+                                                MOD_SMT_API_IDX_DRIVER_INPUT),
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[
+                HOST_SCMI_SERVICE_IDX_OSPM],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *get_agent_table(fwk_id_t module_id)
+{
+    return agent_table;
+}
+
+struct fwk_module_config config_scmi_bench = {
+    .get_element_table = get_agent_table,
+    .data = &((struct mod_scmi_bench_config) {
+        .message_table = message_table,
+        .message_table_size = FWK_ARRAY_SIZE(message_table),
+        .message_count = 10000,
+        .seed = 1,
+    }),
+};
@@ -0,0 +1,60 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_scmi.h>
+#include <mod_scmi_bench.h>
+#include <mod_smt.h>
+
+uint32_t host_scmi_mailbox_table[HOST_SCMI_SERVICE_IDX_COUNT]
+    [HOST_SCMI_MAILBOX_SIZE / sizeof(uint32_t)];
+
+static const struct fwk_element smt_element_table[] = {
+    [HOST_SCMI_SERVICE_IDX_PSCI] = {
+        .name = "PSCI",
+        .data = &((struct mod_smt_channel_config) {
+            .type = MOD_SMT_CHANNEL_TYPE_SLAVE,
+            .policies = MOD_SMT_POLICY_INIT_MAILBOX | MOD_SMT_POLICY_SECURE |
+                        MOD_SMT_POLICY_ZERO_COPY,
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[
+                HOST_SCMI_SERVICE_IDX_PSCI],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+            .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_BENCH,
+                                             HOST_SCMI_SERVICE_IDX_PSCI),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_BENCH,
+                                             MOD_SCMI_BENCH_API_IDX_DRIVER),
+        })
+    },
+    [HOST_SCMI_SERVICE_IDX_OSPM] = {
+        .name = "OSPM",
+        .data = &((struct mod_smt_channel_config) {
+            .type = MOD_SMT_CHANNEL_TYPE_SLAVE,
+            .policies = MOD_SMT_POLICY_INIT_MAILBOX | MOD_SMT_POLICY_ZERO_COPY,
+            .mailbox_address = (uintptr_t)host_scmi_mailbox_table[
+                HOST_SCMI_SERVICE_IDX_OSPM],
+            .mailbox_size = HOST_SCMI_MAILBOX_SIZE,
+            .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_BENCH,
+                                             HOST_SCMI_SERVICE_IDX_OSPM),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_BENCH,
+                                             MOD_SCMI_BENCH_API_IDX_DRIVER),
+        })
+    },
+    [HOST_SCMI_SERVICE_IDX_COUNT] = { 0 },
+};
+
+static const struct fwk_element *smt_get_element_table(fwk_id_t module_id)
+{
+    return smt_element_table;
+}
+
+struct fwk_module_config config_smt = {
+    .get_element_table = smt_get_element_table,
+};
@@ -0,0 +1,35 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The order of the modules in the BS_FIRMWARE_MODULES list is the order in which
+# the modules are initialized, bound, started during the pre-runtime phase.
+#
+# The scmi_bench and scmi modules subscribe to the notification of the smt
+# module signalling that a channel is ready when they start, thus they are
+# started before it.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := yes
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_MODULE_HEADERS_ONLY := power_domain
+BS_FIRMWARE_MODULES := log \
+                       host_console \
+                       scmi_bench \
+                       scmi \
+                       smt \
+                       sensor \
+                       reg_sensor \
+                       scmi_sensor
+
+BS_FIRMWARE_SOURCES := config_log.c \
+                       config_scmi_bench.c \
+                       config_scmi.c \
+                       config_smt.c \
+                       config_sensor.c \
+                       config_scmi_sensor.c
+
+include $(BS_DIR)/firmware.mk
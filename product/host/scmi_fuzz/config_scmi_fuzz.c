@@ -0,0 +1,107 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_scmi.h>
+#include <mod_scmi_fuzz.h>
+#include <mod_scmi_queue.h>
+#include <internal/scmi.h>
+#include <internal/scmi_base.h>
+#include <internal/scmi_sensor.h>
+
+/* Number of messages each agent keeps in the queue of its channel */
+#define AGENT_WINDOW (HOST_SCMI_QUEUE_LENGTH / 2)
+
+/*
+ * Messages of the base and sensor protocols the randomized messages are
+ * derived from.
+ */
+static const struct mod_scmi_fuzz_message message_table[] = {
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_PROTOCOL_VERSION,
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_PROTOCOL_ATTRIBUTES,
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_BASE_DISCOVER_VENDOR,
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_BASE,
+        .message_id = SCMI_BASE_DISCOVER_LIST_PROTOCOLS,
+        .payload = &((struct scmi_base_discover_list_protocols_a2p) {
+            .skip = 0,
+        }),
+        .payload_size = sizeof(struct scmi_base_discover_list_protocols_a2p),
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_PROTOCOL_ATTRIBUTES,
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_SENSOR_DESCRIPTION_GET,
+        .payload = &((struct scmi_sensor_protocol_description_get_a2p) {
+            .desc_index = 0,
+        }),
+        .payload_size =
+            sizeof(struct scmi_sensor_protocol_description_get_a2p),
+    },
+    {
+        .protocol_id = SCMI_PROTOCOL_ID_SENSOR,
+        .message_id = SCMI_SENSOR_READING_GET,
+        .payload = &((struct scmi_sensor_protocol_reading_get_a2p) {
+            .sensor_id = 0,
+            .flags = 0,
+        }),
+        .payload_size = sizeof(struct scmi_sensor_protocol_reading_get_a2p),
+    },
+};
+
+static const struct fwk_element agent_table[] = {
+    [HOST_SCMI_SERVICE_IDX_PSCI] = {
+        .name = "PSCI",
+        .data = &((struct mod_scmi_fuzz_agent_config) {
+            .transport_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_QUEUE,
+                                                HOST_SCMI_SERVICE_IDX_PSCI),
+            .transport_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_QUEUE,
+                                                MOD_SCMI_QUEUE_API_IDX_QUEUE),
+            .max_payload_size = HOST_SCMI_QUEUE_PAYLOAD_SIZE,
+            .window = AGENT_WINDOW,
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_OSPM] = {
+        .name = "OSPM",
+        .data = &((struct mod_scmi_fuzz_agent_config) {
+            .transport_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_QUEUE,
+                                                HOST_SCMI_SERVICE_IDX_OSPM),
+            .transport_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_QUEUE,
+                                                MOD_SCMI_QUEUE_API_IDX_QUEUE),
+            .max_payload_size = HOST_SCMI_QUEUE_PAYLOAD_SIZE,
+            .window = AGENT_WINDOW,
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_COUNT] = { 0 },
+};
+
+const struct fwk_module_config config_scmi_fuzz = {
+    .elements = agent_table,
+    .data = &((struct mod_scmi_fuzz_config) {
+        .message_table = message_table,
+        .message_table_size = FWK_ARRAY_SIZE(message_table),
+        .message_count = 100000,
+        .random_percentage = 25,
+        .seed = 1,
+    }),
+};
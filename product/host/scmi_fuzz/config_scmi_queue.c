@@ -0,0 +1,46 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_scmi.h>
+#include <mod_scmi_fuzz.h>
+#include <mod_scmi_queue.h>
+
+static const struct fwk_element channel_table[] = {
+    [HOST_SCMI_SERVICE_IDX_PSCI] = {
+        .name = "PSCI",
+        .data = &((struct mod_scmi_queue_channel_config) {
+            .queue_length = HOST_SCMI_QUEUE_LENGTH,
+            .max_payload_size = HOST_SCMI_QUEUE_PAYLOAD_SIZE,
+            .secure = true,
+            .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_FUZZ,
+                                             HOST_SCMI_SERVICE_IDX_PSCI),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_FUZZ,
+                                             MOD_SCMI_FUZZ_API_IDX_DRIVER),
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_OSPM] = {
+        .name = "OSPM",
+        .data = &((struct mod_scmi_queue_channel_config) {
+            .queue_length = HOST_SCMI_QUEUE_LENGTH,
+            .max_payload_size = HOST_SCMI_QUEUE_PAYLOAD_SIZE,
+            .driver_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SCMI_FUZZ,
+                                             HOST_SCMI_SERVICE_IDX_OSPM),
+            .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_FUZZ,
+                                             MOD_SCMI_FUZZ_API_IDX_DRIVER),
+        }),
+    },
+    [HOST_SCMI_SERVICE_IDX_COUNT] = { 0 },
+};
+
+const struct fwk_module_config config_scmi_queue = {
+    .elements = channel_table,
+};
@@ -0,0 +1,35 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The order of the modules in the BS_FIRMWARE_MODULES list is the order in which
+# the modules are initialized, bound, started during the pre-runtime phase.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := yes
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+
+# The processing time of the events is reported with the results
+BS_FIRMWARE_HAS_EVENT_PROFILING := yes
+
+BS_FIRMWARE_MODULE_HEADERS_ONLY := power_domain
+BS_FIRMWARE_MODULES := log \
+                       host_console \
+                       scmi_fuzz \
+                       scmi_queue \
+                       scmi \
+                       sensor \
+                       reg_sensor \
+                       scmi_sensor
+
+BS_FIRMWARE_SOURCES := config_log.c \
+                       config_scmi_fuzz.c \
+                       config_scmi_queue.c \
+                       config_scmi.c \
+                       config_sensor.c \
+                       config_scmi_sensor.c
+
+include $(BS_DIR)/firmware.mk
@@ -0,0 +1,61 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_vtime.h>
+#include <mod_alarm_sim.h>
+
+/*
+ * One hour of the periodic activity of a platform: the scheduler tick of an
+ * idle governor, the sampling of a DVFS governor and a sensor poll.
+ */
+static const struct fwk_element alarm_sim_element_table[] = {
+    [HOST_VTIME_ALARM_IDX_TICK] = {
+        .name = "TICK",
+        .data = &((struct mod_alarm_sim_alarm_config) {
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0,
+                HOST_VTIME_ALARM_IDX_TICK),
+            .period = 4000,
+        }),
+    },
+    [HOST_VTIME_ALARM_IDX_DVFS] = {
+        .name = "DVFS",
+        .data = &((struct mod_alarm_sim_alarm_config) {
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0,
+                HOST_VTIME_ALARM_IDX_DVFS),
+            .period = 20000,
+        }),
+    },
+    [HOST_VTIME_ALARM_IDX_SENSOR] = {
+        .name = "SENSOR",
+        .data = &((struct mod_alarm_sim_alarm_config) {
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0,
+                HOST_VTIME_ALARM_IDX_SENSOR),
+            .period = 1000000,
+        }),
+    },
+    [HOST_VTIME_ALARM_IDX_END] = { 0 },
+};
+
+static const struct fwk_element *get_alarm_sim_element_table(
+    fwk_id_t module_id)
+{
+    return alarm_sim_element_table;
+}
+
+const struct fwk_module_config config_alarm_sim = {
+    .get_element_table = get_alarm_sim_element_table,
+    .data = &((struct mod_alarm_sim_config) {
+        .timer_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0),
+        .end_alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0,
+            HOST_VTIME_ALARM_IDX_END),
+        .duration = 3600000000,
+    }),
+};
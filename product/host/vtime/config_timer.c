@@ -0,0 +1,57 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <host_vtime.h>
+#include <mod_timer.h>
+#include <mod_vtimer.h>
+
+static const struct fwk_element vtimer_element_table[] = {
+    [0] = {
+        .name = "VTIMER",
+        .data = &((struct mod_vtimer_dev_config) {
+            .frequency = HOST_VTIME_TIMER_FREQUENCY,
+            .timer_irq = HOST_VTIME_TIMER_IRQ,
+            .read_time = 20,
+        }),
+    },
+    [1] = { 0 },
+};
+
+static const struct fwk_element *get_vtimer_element_table(fwk_id_t module_id)
+{
+    return vtimer_element_table;
+}
+
+const struct fwk_module_config config_vtimer = {
+    .get_element_table = get_vtimer_element_table,
+};
+
+static const struct fwk_element timer_element_table[] = {
+    [0] = {
+        .name = "VTIMER",
+        .data = &((struct mod_timer_dev_config) {
+            .id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_VTIMER, 0),
+            .timer_irq = HOST_VTIME_TIMER_IRQ,
+        }),
+        .sub_element_count = HOST_VTIME_ALARM_IDX_COUNT,
+    },
+    [1] = { 0 },
+};
+
+static const struct fwk_element *get_timer_element_table(fwk_id_t module_id)
+{
+    return timer_element_table;
+}
+
+const struct fwk_module_config config_timer = {
+    .get_element_table = get_timer_element_table,
+};
@@ -0,0 +1,24 @@
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# The virtual timer relies on the idle handler of the framework, only called in
+# single-threaded builds.
+#
+
+BS_FIRMWARE_CPU := host
+BS_FIRMWARE_HAS_MULTITHREADING := no
+BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_MODULES := log \
+                       host_console \
+                       vtimer \
+                       timer \
+                       alarm_sim
+
+BS_FIRMWARE_SOURCES := config_log.c \
+                       config_timer.c \
+                       config_alarm_sim.c
+
+include $(BS_DIR)/firmware.mk
@@ -8,6 +8,7 @@
  *     Juno DDR-PHY400 driver
  */
 
+#include <stddef.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_id.h>
@@ -18,11 +19,70 @@
 #include <mod_juno_dmc400.h>
 #include <juno_scc.h>
 
+#define DDR_PHY_400_CONFIG_IDLE_WAIT_TIMEOUT_US     1000
+#define DDR_PHY_PTM_PHY_STATUS_IDLE                 UINT32_C(0xFFFFF7FF)
+#define DDR_PHY_400_BL_COUNT                        4
+
+#define BL_REG(reg) offsetof(struct mod_juno_ddr_phy400_bl_reg, reg)
+
+/* Byte lane registers holding the delay line settings found by training */
+static const size_t training_reg_offset[] = {
+    BL_REG(WRLVL_DLL_CTRL1),
+    BL_REG(WRLVL_DLL_CTRL2),
+    BL_REG(WRLVL_DLL_CTRL3),
+    BL_REG(RDLVL_DLL_CTRL1),
+    BL_REG(RDLVL_DLL_CTRL2),
+    BL_REG(RDLVL_DLL_CTRL3),
+    BL_REG(RDLVL_DLL_CTRL4),
+    BL_REG(RDLVL_DLL_CTRL5),
+    BL_REG(RDLVL_DLL_CTRL6),
+    BL_REG(RDLVL_DLL_CTRL7),
+    BL_REG(RDLVL_DLL_CTRL8),
+    BL_REG(RDLVL_DLL_CTRL9),
+    BL_REG(RDLVL_DLL_CTRL10),
+    BL_REG(WREQ_DLL_CTRL1),
+    BL_REG(WREQ_DLL_CTRL2),
+    BL_REG(WREQ_DLL_CTRL3),
+    BL_REG(WREQ_DLL_CTRL4),
+    BL_REG(WREQ_DLL_CTRL5),
+    BL_REG(WREQ_DLL_CTRL6),
+    BL_REG(WREQ_DLL_CTRL7),
+    BL_REG(WREQ_DLL_CTRL8),
+    BL_REG(WREQ_DLL_CTRL9),
+    BL_REG(WREQ_DLL_CTRL10),
+    BL_REG(WREQ_DLL_CTRL11),
+    BL_REG(SQUELCH_DIGITAL_DELAY_CTRL),
+    BL_REG(SQUELCH_DLL_CTRL1),
+    BL_REG(SQUELCH_DLL_CTRL2),
+};
+
+#define TRAINING_REG_COUNT FWK_ARRAY_SIZE(training_reg_offset)
+
+struct juno_ddr_phy400_element_ctx {
+    /* Training values saved for each byte lane */
+    uint32_t training[DDR_PHY_400_BL_COUNT][TRAINING_REG_COUNT];
+
+    /* Flag indicating whether the training values have been saved */
+    bool is_training_saved;
+};
+
 static struct mod_log_api *log_api;
 static struct mod_timer_api *timer_api;
+static struct juno_ddr_phy400_element_ctx *element_ctx_table;
 
-#define DDR_PHY_400_CONFIG_IDLE_WAIT_TIMEOUT_US     1000
-#define DDR_PHY_PTM_PHY_STATUS_IDLE                 UINT32_C(0xFFFFF7FF)
+/*
+ * Static helpers
+ */
+
+static void get_bl_table(
+    const struct mod_juno_ddr_phy400_element_config *element_config,
+    uintptr_t bl_table[DDR_PHY_400_BL_COUNT])
+{
+    bl_table[0] = element_config->ddr_phy_bl0;
+    bl_table[1] = element_config->ddr_phy_bl1;
+    bl_table[2] = element_config->ddr_phy_bl2;
+    bl_table[3] = element_config->ddr_phy_bl3;
+}
 
 /*
  * Module API functions
@@ -51,7 +111,7 @@ static int juno_ddr_phy400_config_ddr(fwk_id_t element_id)
     if ((phy_ptm == NULL) || (phy_c3a == NULL) || (phy_bl0 == NULL))
         return FWK_E_DATA;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
         "[DDR] Initializing PHY at 0x%x\n", (uintptr_t)phy_ptm);
 
     /* All writes to BL0 are copied to BL1-3 */
@@ -152,7 +212,7 @@ static int juno_ddr_phy400_config_clk(fwk_id_t module_id)
     if (status != FWK_SUCCESS)
         return status;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Initializing PHY-PLL\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Initializing PHY-PLL\n");
 
     /* Complete clock settings */
     SCC->DDR_PHY0_PLL = SCC_DDR_PHY_PLL_BYPASS_EN;
@@ -213,11 +273,91 @@ static int juno_ddr_phy400_config_retention(fwk_id_t module_id, bool enable)
     return FWK_SUCCESS;
 }
 
+static int juno_ddr_phy400_save_training(fwk_id_t element_id)
+{
+    int status;
+    unsigned int bl, reg;
+    uintptr_t bl_table[DDR_PHY_400_BL_COUNT];
+    struct juno_ddr_phy400_element_ctx *element_ctx;
+    const struct mod_juno_ddr_phy400_element_config *element_config;
+
+    status = fwk_module_check_call(element_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    element_config = fwk_module_get_data(element_id);
+    if (element_config == NULL)
+        return FWK_E_DATA;
+
+    element_ctx = &element_ctx_table[fwk_id_get_element_idx(element_id)];
+
+    get_bl_table(element_config, bl_table);
+
+    for (bl = 0; bl < DDR_PHY_400_BL_COUNT; bl++) {
+        if (bl_table[bl] == 0)
+            return FWK_E_DATA;
+
+        for (reg = 0; reg < TRAINING_REG_COUNT; reg++) {
+            element_ctx->training[bl][reg] = *(volatile uint32_t *)
+                (bl_table[bl] + training_reg_offset[reg]);
+        }
+    }
+
+    element_ctx->is_training_saved = true;
+
+    return FWK_SUCCESS;
+}
+
+static int juno_ddr_phy400_restore_training(fwk_id_t element_id)
+{
+    int status;
+    unsigned int bl, reg;
+    uintptr_t bl_table[DDR_PHY_400_BL_COUNT];
+    struct mod_juno_ddr_phy400_ptm_reg *phy_ptm;
+    struct juno_ddr_phy400_element_ctx *element_ctx;
+    const struct mod_juno_ddr_phy400_element_config *element_config;
+
+    status = fwk_module_check_call(element_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    element_config = fwk_module_get_data(element_id);
+    if (element_config == NULL)
+        return FWK_E_DATA;
+
+    element_ctx = &element_ctx_table[fwk_id_get_element_idx(element_id)];
+    if (!element_ctx->is_training_saved)
+        return FWK_E_STATE;
+
+    /* The saved values can only be used once */
+    element_ctx->is_training_saved = false;
+
+    phy_ptm = (struct mod_juno_ddr_phy400_ptm_reg *)element_config->ddr_phy_ptm;
+
+    get_bl_table(element_config, bl_table);
+
+    /* Each byte lane has its own values, disable the copy of BL0 writes */
+    phy_ptm->BL_APB_CTRL = 0x00000000;
+
+    for (bl = 0; bl < DDR_PHY_400_BL_COUNT; bl++) {
+        for (reg = 0; reg < TRAINING_REG_COUNT; reg++) {
+            *(volatile uint32_t *)(bl_table[bl] + training_reg_offset[reg]) =
+                element_ctx->training[bl][reg];
+        }
+    }
+
+    phy_ptm->BL_APB_CTRL = 0x00000001;
+
+    return FWK_SUCCESS;
+}
+
 static struct mod_juno_dmc400_ddr_phy_api ddr_phy400_api = {
     .configure_ddr = juno_ddr_phy400_config_ddr,
     .configure_clk = juno_ddr_phy400_config_clk,
     .configure_idle = juno_ddr_phy400_config_idle,
     .configure_retention = juno_ddr_phy400_config_retention,
+    .save_training = juno_ddr_phy400_save_training,
+    .restore_training = juno_ddr_phy400_restore_training,
 };
 
 /*
@@ -227,6 +367,14 @@ static int juno_ddr_phy400_init(fwk_id_t module_id,
                                 unsigned int element_count,
                                 const void *config)
 {
+    if (element_count == 0)
+        return FWK_SUCCESS;
+
+    element_ctx_table = fwk_mm_calloc(element_count,
+        sizeof(struct juno_ddr_phy400_element_ctx));
+    if (element_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
@@ -417,6 +417,17 @@ struct mod_juno_dmc400_element_config {
 
     /*! Power domain identifier */
     fwk_id_t pd_id;
+
+    /*!
+     * \brief Flag indicating whether the DDR is resumed from the state saved
+     *      on suspend.
+     *
+     * \details When set, the training values of the DDR PHYs are saved when
+     *      the DDR enters self-refresh and restored when it is resumed. The
+     *      LPDDR3 initialization and the training are then skipped on
+     *      resume.
+     */
+    bool fast_resume;
 };
 
 /*!
@@ -469,6 +480,31 @@ struct mod_juno_dmc400_ddr_phy_api {
      * \return One of the standard framework error codes.
      */
     int (*configure_retention)(fwk_id_t module_id, bool enable);
+
+    /*!
+     * \brief Save the training values of the DDR PHY device.
+     *
+     * \param element_id Element identifier corresponding to the device.
+     *
+     * \retval FWK_E_DATA No data found for the element.
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \return One of the standard framework error codes.
+     */
+    int (*save_training)(fwk_id_t element_id);
+
+    /*!
+     * \brief Restore the training values saved by save_training().
+     *
+     * \details The saved values are discarded once restored.
+     *
+     * \param element_id Element identifier corresponding to the device.
+     *
+     * \retval FWK_E_DATA No data found for the element.
+     * \retval FWK_E_STATE No training values have been saved.
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \return One of the standard framework error codes.
+     */
+    int (*restore_training)(fwk_id_t element_id);
 };
 
 /*!
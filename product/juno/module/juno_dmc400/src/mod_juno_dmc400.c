@@ -33,6 +33,9 @@ struct juno_dmc400_ctx {
     const struct mod_timer_api *timer_api;
     unsigned int dmc_refclk_ratio;
     const struct mod_log_api *log_api;
+
+    /* Flag indicating whether the DDR PHYs training values are saved */
+    bool is_training_saved;
 };
 
 static struct juno_dmc400_ctx ctx;
@@ -239,7 +242,7 @@ static int ddr_clk_init(fwk_id_t id)
     if (status != FWK_SUCCESS)
         return status;
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Setting clocks\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Setting clocks\n");
 
     /* Set DDR PHY PLLs after DMCCLK is stable */
     status = ctx.ddr_phy_api->configure_clk(fwk_module_id_juno_ddr_phy400);
@@ -251,17 +254,16 @@ static int ddr_clk_init(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
-static int ddr_dmc_init(fwk_id_t id)
+static void ddr_dmc_config(fwk_id_t id)
 {
-    uint32_t ddr_chip_count, chip, channel, dev;
     const struct mod_juno_dmc400_element_config *element_config;
     struct mod_juno_dmc400_reg *dmc;
 
     element_config = fwk_module_get_data(id);
     dmc = (struct mod_juno_dmc400_reg *)element_config->dmc;
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
-                     "[DMC] Writing functional settings\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG,
+                         "[DMC] Writing functional settings\n");
 
     /* QoS control */
     dmc->TURNAROUND_PRIORITY = 0x0000008C;
@@ -343,8 +345,20 @@ static int ddr_dmc_init(fwk_id_t id)
     dmc->DECODE_CONTROL = 0x10000043;
     dmc->MODE_CONTROL = 0x00000012;
     dmc->LOW_POWER_CONTROL = 0x00000010;
+}
+
+static int ddr_dmc_init(fwk_id_t id)
+{
+    uint32_t ddr_chip_count, chip, channel, dev;
+    const struct mod_juno_dmc400_element_config *element_config;
+    struct mod_juno_dmc400_reg *dmc;
+
+    element_config = fwk_module_get_data(id);
+    dmc = (struct mod_juno_dmc400_reg *)element_config->dmc;
+
+    ddr_dmc_config(id);
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Initialize LPDDR3\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Initialize LPDDR3\n");
 
     /*  Direct commands to initialize LPDDR3 */
     ddr_chip_count = element_config->ddr_chip_count;
@@ -382,6 +396,17 @@ static int ddr_dmc_init(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
+static void ddr_training_config(struct mod_juno_dmc400_reg *dmc)
+{
+    dmc->RDLVL_CONTROL = 0x00001002;
+    dmc->T_RDLVL_EN = 0x00000020;
+    dmc->T_RDLVL_RR = 0x00000014;
+    dmc->WRLVL_CONTROL = 0x00001002;
+    dmc->WRLVL_DIRECT = 0x00000000;
+    dmc->T_WRLVL_EN = 0x00000028;
+    dmc->T_WRLVL_WW = 0x0000001B;
+}
+
 /*
  * The training sequence must run with interrupts disabled
  */
@@ -402,7 +427,7 @@ static int ddr_training(fwk_id_t id)
         return FWK_SUCCESS;
     }
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Configure training\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Configure training\n");
 
     /* Configure the time-out for the DDR programming */
     status = ctx.timer_api->time_to_timestamp(module_config->timer_id,
@@ -418,15 +443,9 @@ static int ddr_training(fwk_id_t id)
     timeout += counter;
 
     /* Training related setup */
-    dmc->RDLVL_CONTROL = 0x00001002;
-    dmc->T_RDLVL_EN = 0x00000020;
-    dmc->T_RDLVL_RR = 0x00000014;
-    dmc->WRLVL_CONTROL = 0x00001002;
-    dmc->WRLVL_DIRECT = 0x00000000;
-    dmc->T_WRLVL_EN = 0x00000028;
-    dmc->T_WRLVL_WW = 0x0000001B;
+    ddr_training_config(dmc);
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Write training\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Write training\n");
 
     /*
      * Write training
@@ -490,7 +509,7 @@ static int ddr_training(fwk_id_t id)
         }
     }
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Read training\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Read training\n");
 
     /*
      * Read Gate training
@@ -617,12 +636,12 @@ static int ddr_training(fwk_id_t id)
 
     }
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] Training completed\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] Training completed\n");
 
     return FWK_SUCCESS;
 
 timeout:
-    ctx.log_api->log(MOD_LOG_GROUP_WARNING, "[DMC] Training time-out\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_WARNING, "[DMC] Training time-out\n");
 
     return FWK_E_TIMEOUT;
 }
@@ -661,7 +680,7 @@ static int ddr_retraining(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
-static int ddr_wake(fwk_id_t id)
+static int ddr_wake(fwk_id_t id, bool retrain)
 {
     int status;
     uint32_t ddr_chip_count, chip, channel, dev;
@@ -716,19 +735,44 @@ static int ddr_wake(fwk_id_t id)
 
     dmc_delay_cycles(64);
 
+    if (!retrain) {
+        /* The training values have been restored */
+        fwk_interrupt_enable(PHY_TRAINING_IRQ);
+
+        return FWK_SUCCESS;
+    }
+
     /* Re-run training program */
     return ddr_retraining(id);
 }
 
-static int ddr_resume(const struct mod_juno_dmc400_element_config *config,
-                      fwk_id_t id)
+static int ddr_sleep(fwk_id_t id)
 {
-    int status;
+    const struct mod_juno_dmc400_element_config *element_config;
     const struct mod_juno_dmc400_module_config *module_config;
     struct mod_juno_dmc400_reg *dmc;
 
     module_config = fwk_module_get_data(fwk_module_id_juno_dmc400);
-    dmc = (struct mod_juno_dmc400_reg *)config->dmc;
+    element_config = fwk_module_get_data(id);
+    dmc = (struct mod_juno_dmc400_reg *)element_config->dmc;
+
+    dmc->MEMC_CMD = DMC400_CMD_SLEEP;
+
+    return ctx.timer_api->wait(module_config->timer_id,
+                               DMC400_CONFIG_WAIT_TIMEOUT_US,
+                               ddr_cmd_sleep_check,
+                               dmc);
+}
+
+/*
+ * The DDR has been kept in self-refresh while the DMC was off: its mode
+ * registers are preserved and the delay lines of the PHYs can be restored from
+ * the values saved on suspend. Only the DMC registers are reprogrammed.
+ */
+static int ddr_resume_fast(const struct mod_juno_dmc400_element_config *config,
+                           fwk_id_t id)
+{
+    int status;
 
     status = ddr_clk_init(id);
     if (status != FWK_SUCCESS)
@@ -738,23 +782,68 @@ static int ddr_resume(const struct mod_juno_dmc400_element_config *config,
     if (status != FWK_SUCCESS)
         return status;
 
-    status = ddr_dmc_init(id);
+    status = ctx.ddr_phy_api->restore_training(config->ddr_phy_0_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    /* Sleep the DMC */
-    dmc->MEMC_CMD = DMC400_CMD_SLEEP;
-    status = ctx.timer_api->wait(module_config->timer_id,
-                                 DMC400_CONFIG_WAIT_TIMEOUT_US,
-                                 ddr_cmd_sleep_check,
-                                 dmc);
+    status = ctx.ddr_phy_api->restore_training(config->ddr_phy_1_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    ddr_dmc_config(id);
+    ddr_training_config((struct mod_juno_dmc400_reg *)config->dmc);
+
+    status = ddr_sleep(id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return ddr_wake(id, false);
+}
+
+static int ddr_resume_full(fwk_id_t id)
+{
+    int status;
+
+    status = ddr_clk_init(id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = ddr_phy_init(id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = ddr_dmc_init(id);
     if (status != FWK_SUCCESS)
         return status;
 
-    status = ddr_wake(id);
+    status = ddr_sleep(id);
     if (status != FWK_SUCCESS)
         return status;
 
+    return ddr_wake(id, true);
+}
+
+static int ddr_resume(const struct mod_juno_dmc400_element_config *config,
+                      fwk_id_t id)
+{
+    int status = FWK_E_STATE;
+
+    if (ctx.is_training_saved) {
+        ctx.is_training_saved = false;
+
+        status = ddr_resume_fast(config, id);
+        if (status != FWK_SUCCESS) {
+            MOD_LOG(ctx.log_api, MOD_LOG_GROUP_WARNING,
+                "[DMC] Fast resume failed, re-initializing DDR\n");
+        }
+    }
+
+    if (status != FWK_SUCCESS) {
+        status = ddr_resume_full(id);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     status = fwk_notification_unsubscribe(
         mod_pd_notification_id_power_state_transition,
         config->pd_id,
@@ -800,6 +889,14 @@ static int ddr_suspend(const struct mod_juno_dmc400_element_config *config,
     if (status != FWK_SUCCESS)
         return status;
 
+    if (config->fast_resume) {
+        ctx.is_training_saved =
+            (ctx.ddr_phy_api->save_training(config->ddr_phy_0_id) ==
+                FWK_SUCCESS) &&
+            (ctx.ddr_phy_api->save_training(config->ddr_phy_1_id) ==
+                FWK_SUCCESS);
+    }
+
     /* Enable PHY retention */
     status = ctx.ddr_phy_api->configure_retention(fwk_module_id_juno_ddr_phy400,
                                                   true);
@@ -916,8 +1013,8 @@ static int juno_dmc400_start(fwk_id_t id)
         return FWK_SUCCESS;
 
     if (SCC->GPR0 & SCC_GPR0_DDR_DISABLE) {
-        ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
-                         "[DMC] GPR_0 disable flag set: skipping init");
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG,
+                             "[DMC] GPR_0 disable flag set: skipping init");
 
         return FWK_SUCCESS;
     }
@@ -933,8 +1030,9 @@ static int juno_dmc400_start(fwk_id_t id)
     ctx.dmc_refclk_ratio = (DDR_FREQUENCY_MHZ * FWK_MHZ) / CLOCK_RATE_REFCLK;
     fwk_assert(ctx.dmc_refclk_ratio > 0);
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
-                     "[DMC] Initializing DMC-400 at 0x%x\n", (uintptr_t) dmc);
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG,
+                         "[DMC] Initializing DMC-400 at 0x%x\n",
+                         (uintptr_t) dmc);
 
     status = ddr_clk_init(id);
     if (status != FWK_SUCCESS)
@@ -970,7 +1068,7 @@ static int juno_dmc400_start(fwk_id_t id)
     dmc->INTEG_CFG = 0x00000000;
     dmc->INTEG_OUTPUTS = 0x00000000;
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG, "[DMC] DDR Ready\n");
+    MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG, "[DMC] DDR Ready\n");
 
     /* Switch to READY */
     dmc->MEMC_CMD = DMC400_CMD_GO;
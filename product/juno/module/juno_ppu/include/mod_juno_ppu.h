@@ -8,6 +8,7 @@
 #ifndef MOD_JUNO_PPU_H
 #define MOD_JUNO_PPU_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <fwk_id.h>
 #include <fwk_module_idx.h>
@@ -94,6 +95,23 @@ struct mod_juno_ppu_element_config {
      * \brief Warm reset request IRQ number.
      */
     unsigned int warm_reset_irq;
+
+    /*!
+     * \brief Complete the transitions asynchronously.
+     *
+     * \details Only used by the cluster PPUs. When set, the state of the PPU
+     *      is polled with the alarm identified by \ref alarm_id and the
+     *      transition is reported once the requested mode has been reached,
+     *      instead of being waited for.
+     */
+    bool async_transitions;
+
+    /*!
+     * \brief Sub-element identifier of the alarm polling the transitions.
+     *
+     * \details Only used when \ref async_transitions is set.
+     */
+    fwk_id_t alarm_id;
 };
 
 /*!
@@ -46,6 +46,12 @@ struct ppu_ctx {
 
     /* Power domain driver input API */
     const struct mod_pd_driver_input_api *pd_api;
+
+    /* Alarm API, for the PPUs with asynchronous transitions */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Power state to report once the pending transition has completed */
+    unsigned int pending_state;
 };
 
 struct module_ctx {
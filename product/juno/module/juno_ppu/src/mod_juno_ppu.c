@@ -27,6 +27,7 @@
 #include <system_mmap.h>
 
 #define PPU_SET_STATE_AND_WAIT_TIMEOUT_US   (100 * 1000)
+#define PPU_TRANSITION_POLL_PERIOD_US       10
 
 #define CPU_WAKEUP_COMPOSITE_STATE  MOD_PD_COMPOSITE_STATE(MOD_PD_LEVEL_2, \
                                                            0, \
@@ -446,6 +447,85 @@ static const struct mod_pd_driver_api css_pd_driver_api = {
 /*
  * Cluster API
  */
+static volatile uint32_t *get_snoop_ctrl(struct ppu_ctx *ppu_ctx)
+{
+    if ((uintptr_t)ppu_ctx->reg == PPU_BIG_SSTOP_BASE)
+        return &SCP_CONFIG->BIG_SNOOP_CONTROL;
+    else if ((uintptr_t)ppu_ctx->reg == PPU_LITTLE_SSTOP_BASE)
+        return &SCP_CONFIG->LITTLE_SNOOP_CONTROL;
+
+    return NULL;
+}
+
+static int cluster_complete_transition(struct ppu_ctx *ppu_ctx)
+{
+    int status;
+
+    if (ppu_ctx->pending_state == MOD_PD_STATE_ON)
+        juno_utils_open_snoop_gate_and_wait(get_snoop_ctrl(ppu_ctx));
+
+    status = ppu_ctx->pd_api->report_power_state_transition(ppu_ctx->bound_id,
+        ppu_ctx->pending_state);
+    if (status != FWK_SUCCESS)
+        return FWK_E_PANIC;
+
+    return FWK_SUCCESS;
+}
+
+static void cluster_transition_poll(uintptr_t param)
+{
+    int status;
+    struct ppu_ctx *ppu_ctx = (struct ppu_ctx *)param;
+    struct set_power_status_check_params params;
+
+    params.mode = pd_state_to_ppu_mode[ppu_ctx->pending_state];
+    params.reg = ppu_ctx->reg;
+
+    if (!set_power_status_check(&params)) {
+        status = ppu_ctx->alarm_api->start_us(ppu_ctx->config->alarm_id,
+            PPU_TRANSITION_POLL_PERIOD_US, MOD_TIMER_ALARM_TYPE_ONCE,
+            cluster_transition_poll, param);
+        fwk_assert(status == FWK_SUCCESS);
+
+        return;
+    }
+
+    status = cluster_complete_transition(ppu_ctx);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+/*
+ * Request the mode of a cluster PPU, the transition is reported from the
+ * alarm callback once the mode has been reached.
+ */
+static int cluster_request_state_async(struct ppu_ctx *ppu_ctx,
+                                       enum ppu_mode mode,
+                                       unsigned int state)
+{
+    int status;
+    struct set_power_status_check_params params;
+
+    ppu_ctx->pending_state = state;
+
+    status = ppu_request_state(ppu_ctx, mode);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    params.mode = mode;
+    params.reg = ppu_ctx->reg;
+
+    if (set_power_status_check(&params))
+        return cluster_complete_transition(ppu_ctx);
+
+    status = ppu_ctx->alarm_api->start_us(ppu_ctx->config->alarm_id,
+        PPU_TRANSITION_POLL_PERIOD_US, MOD_TIMER_ALARM_TYPE_ONCE,
+        cluster_transition_poll, (uintptr_t)ppu_ctx);
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    return FWK_SUCCESS;
+}
+
 static int cluster_set_state(fwk_id_t ppu_id, unsigned int state)
 {
     enum ppu_mode mode;
@@ -457,11 +537,8 @@ static int cluster_set_state(fwk_id_t ppu_id, unsigned int state)
     if (status != FWK_SUCCESS)
         return status;
 
-    if ((uintptr_t)ppu_ctx->reg == PPU_BIG_SSTOP_BASE)
-        snoop_ctrl = &SCP_CONFIG->BIG_SNOOP_CONTROL;
-    else if ((uintptr_t)ppu_ctx->reg == PPU_LITTLE_SSTOP_BASE)
-        snoop_ctrl = &SCP_CONFIG->LITTLE_SNOOP_CONTROL;
-    else
+    snoop_ctrl = get_snoop_ctrl(ppu_ctx);
+    if (snoop_ctrl == NULL)
         return FWK_E_PARAM;
 
     if (!fwk_expect(state < MOD_PD_STATE_COUNT))
@@ -471,6 +548,9 @@ static int cluster_set_state(fwk_id_t ppu_id, unsigned int state)
 
     switch (state) {
     case MOD_PD_STATE_ON:
+        if (ppu_ctx->config->async_transitions)
+            return cluster_request_state_async(ppu_ctx, mode, state);
+
         status = ppu_set_state_and_wait(ppu_ctx, mode);
         if (status != FWK_SUCCESS)
             return status;
@@ -483,6 +563,9 @@ static int cluster_set_state(fwk_id_t ppu_id, unsigned int state)
 
         juno_utils_close_snoop_gate(snoop_ctrl);
 
+        if (ppu_ctx->config->async_transitions)
+            return cluster_request_state_async(ppu_ctx, mode, state);
+
         status = ppu_set_state_and_wait(ppu_ctx, mode);
         if (status != FWK_SUCCESS)
             return status;
@@ -785,6 +868,11 @@ static int juno_ppu_element_init(fwk_id_t ppu_id,
     ppu_ctx->reg = (struct ppu_reg *)dev_config->reg_base;
     ppu_ctx->bound_id = FWK_ID_NONE;
 
+    #if !BUILD_HAS_MOD_TIMER
+    if (dev_config->async_transitions)
+        return FWK_E_SUPPORT;
+    #endif
+
     if (dev_config->pd_type == MOD_PD_TYPE_SYSTEM) {
         status = ppu_get_state(ppu_ctx->reg, &mode);
         if (status != FWK_SUCCESS)
@@ -830,6 +918,14 @@ static int juno_ppu_bind(fwk_id_t id, unsigned int round)
         if (status != FWK_SUCCESS)
             return FWK_E_PANIC;
     }
+
+    if (dev_config->async_transitions) {
+        /* Bind to the alarm polling the transitions */
+        status = fwk_module_bind(dev_config->alarm_id,
+            MOD_TIMER_API_ID_ALARM, &ppu_ctx->alarm_api);
+        if (status != FWK_SUCCESS)
+            return FWK_E_PANIC;
+    }
     #endif
 
     if (!fwk_id_is_equal(ppu_ctx->bound_id, FWK_ID_NONE)) {
@@ -69,6 +69,18 @@ struct mod_juno_rom_config {
 
     /*! Base address of the RAM firmware image */
     uintptr_t ramfw_base;
+
+    /*!
+     * \brief Load the RAM firmware image without waiting for it.
+     *
+     * \details When set, the image is requested from the bootloader module
+     *      as soon as the cores of the boot maps are powered, before the
+     *      clocks of the clusters are switched to their private PLLs, and the
+     *      jump to the RAM firmware is done once the bootloader responds. The
+     *      SDS structure of the bootloader must then be watched (see
+     *      \ref mod_bootloader_api::load_image_async).
+     */
+    bool async_image_load;
 };
 
 /*!
@@ -49,6 +49,7 @@ static struct {
     struct mod_log_api *log_api;
     struct mod_bootloader_api *bootloader_api;
     unsigned int notification_count;
+    bool image_load_pending;
     unsigned int boot_map_little;
     unsigned int boot_map_big;
 } ctx;
@@ -197,7 +198,7 @@ static int deferred_setup(void)
         FWK_ARRAY_SIZE(core_ppu_table_little));
 
     if (status != FWK_SUCCESS) {
-        ctx.log_api->log(
+        MOD_LOG(ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[ROM] ERROR: Failed to turn on LITTLE cluster.\n");
         return FWK_E_DEVICE;
@@ -210,12 +211,24 @@ static int deferred_setup(void)
         FWK_ARRAY_SIZE(core_ppu_table_big));
 
     if (status != FWK_SUCCESS) {
-        ctx.log_api->log(
+        MOD_LOG(ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[ROM] ERROR: Failed to turn on big cluster.\n");
         return FWK_E_DEVICE;
     }
 
+    /*
+     * The AP firmware provides the image while the clocks are switched, the
+     * jump is done once the bootloader responds.
+     */
+    if (ctx.config->async_image_load) {
+        status = ctx.bootloader_api->load_image_async();
+        if (status != FWK_SUCCESS)
+            return status;
+
+        ctx.image_load_pending = true;
+    }
+
     if (ctx.boot_map_little) {
         /* Switch clock source to the private PLL */
         css_clock_cluster_div_set(&SCP_CONFIG->LITTLECLK_CONTROL, 1, 1, true);
@@ -234,10 +247,38 @@ static int deferred_setup(void)
     juno_wdog_rom_reload();
     #endif
 
+    if (ctx.image_load_pending)
+        return FWK_SUCCESS;
+
     status = ctx.bootloader_api->load_image();
     if (status != FWK_SUCCESS) {
-        ctx.log_api->log(MOD_LOG_GROUP_ERROR,
-                         "[ROM] ERROR: Failed to load RAM firmware image\n");
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[ROM] ERROR: Failed to load RAM firmware image\n");
+        return FWK_E_DATA;
+    }
+
+    #ifndef BUILD_MODE_DEBUG
+    juno_wdog_rom_reload();
+    #endif
+
+    jump_to_ramfw();
+
+    return FWK_SUCCESS;
+}
+
+static int process_image_load_response(const struct fwk_event *event)
+{
+    const struct mod_bootloader_load_image_resp_params *params =
+        (const void *)event->params;
+
+    if (!fwk_expect(ctx.image_load_pending))
+        return FWK_E_STATE;
+
+    ctx.image_load_pending = false;
+
+    if (params->status != FWK_SUCCESS) {
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[ROM] ERROR: Failed to load RAM firmware image\n");
         return FWK_E_DATA;
     }
 
@@ -329,6 +370,9 @@ static int juno_rom_process_event(
     struct mod_pd_power_state_transition_notification_params
         *notification_params;
 
+    if (fwk_id_is_equal(event->id, mod_bootloader_event_id_load_image))
+        return process_image_load_response(event);
+
     /* Configure the boot maps to power on LITTLE_CPU0 by default */
     ctx.boot_map_little = 1;
     ctx.boot_map_big = 0;
@@ -370,7 +414,7 @@ static int juno_rom_process_event(
     /* Set alternative AP ROM address (if applicable) */
     if (SCC->APP_ALT_BOOT != 0) {
         if ((SCC->APP_ALT_BOOT & 0x3) != 0) {
-            ctx.log_api->log(
+            MOD_LOG(ctx.log_api,
                 MOD_LOG_GROUP_ERROR,
                 "[ROM] ERROR: Alternative AP ROM address does not have 4 byte "
                 "alignment\n");
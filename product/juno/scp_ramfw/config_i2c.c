@@ -26,14 +26,8 @@ static const struct fwk_element dw_apb_i2c_element_table[] = {
     [1] = {0},
 };
 
-static const struct fwk_element *dw_apb_i2c_get_element_table(
-    fwk_id_t module_id)
-{
-    return dw_apb_i2c_element_table;
-}
-
-struct fwk_module_config config_dw_apb_i2c = {
-    .get_element_table = dw_apb_i2c_get_element_table,
+const struct fwk_module_config config_dw_apb_i2c = {
+    .elements = dw_apb_i2c_element_table,
 };
 
 static const struct fwk_element i2c_element_table[] = {
@@ -48,11 +42,6 @@ static const struct fwk_element i2c_element_table[] = {
     [1] = {0},
 };
 
-static const struct fwk_element *i2c_get_element_table(fwk_id_t module_id)
-{
-    return i2c_element_table;
-}
-
-struct fwk_module_config config_i2c = {
-    .get_element_table = i2c_get_element_table,
+const struct fwk_module_config config_i2c = {
+    .elements = i2c_element_table,
 };
@@ -45,6 +45,7 @@ static struct fwk_element juno_dmc400_element_table[] = {
                 1),
             .pd_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_POWER_DOMAIN,
                 POWER_DOMAIN_IDX_SYSTOP),
+            .fast_resume = true,
         }),
     },
 
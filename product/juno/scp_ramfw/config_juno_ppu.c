@@ -14,13 +14,15 @@
 #include <system_clock.h>
 #include <system_mmap.h>
 
-static struct fwk_element element_table[] = {
+static const struct fwk_element element_table[] = {
     [JUNO_PPU_DEV_IDX_BIG_SSTOP] = {
         .name = "BIG_SSTOP",
         .data = &(const struct mod_juno_ppu_element_config) {
             .reg_base = PPU_BIG_SSTOP_BASE,
             .timer_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0),
             .pd_type = MOD_PD_TYPE_CLUSTER,
+            .async_transitions = true,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 0),
         },
     },
     [JUNO_PPU_DEV_IDX_BIG_CPU0] = {
@@ -51,6 +53,8 @@ static struct fwk_element element_table[] = {
             .reg_base = PPU_LITTLE_SSTOP_BASE,
             .timer_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0),
             .pd_type = MOD_PD_TYPE_CLUSTER,
+            .async_transitions = true,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 1),
         },
     },
     [JUNO_PPU_DEV_IDX_LITTLE_CPU0] = {
@@ -124,12 +128,7 @@ static struct fwk_element element_table[] = {
     [JUNO_PPU_DEV_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *get_element_table(fwk_id_t module_id)
-{
-    return element_table;
-}
-
-struct fwk_module_config config_juno_ppu = {
-    .get_element_table = get_element_table,
+const struct fwk_module_config config_juno_ppu = {
+    .elements = element_table,
     .data = NULL,
 };
@@ -36,14 +36,8 @@ static const struct fwk_element juno_xrp7724_element_table[] = {
     [MOD_JUNO_XRP7724_ELEMENT_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *juno_xrp7724_get_element_table(
-    fwk_id_t module_id)
-{
-    return juno_xrp7724_element_table;
-}
-
 const struct fwk_module_config config_juno_xrp7724 = {
-    .get_element_table = juno_xrp7724_get_element_table,
+    .elements = juno_xrp7724_element_table,
     .data = &((struct mod_juno_xrp7724_config) {
         .slave_address = 0x28,
         .i2c_hal_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_I2C, 0),
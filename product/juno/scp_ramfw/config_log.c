@@ -27,13 +27,8 @@ static const struct fwk_element pl011_element_desc_table[] = {
     [1] = {0},
 };
 
-static const struct fwk_element *get_pl011_table(fwk_id_t module_id)
-{
-    return pl011_element_desc_table;
-}
-
-struct fwk_module_config config_pl011 = {
-    .get_element_table = get_pl011_table,
+const struct fwk_module_config config_pl011 = {
+    .elements = pl011_element_desc_table,
 };
 
 /*
@@ -53,6 +48,7 @@ static const struct mod_log_config log_data = {
     .banner = FWK_BANNER_SCP
               FWK_BANNER_RAM_FIRMWARE
               BUILD_VERSION_DESCRIBE_STRING "\n",
+    .heap_usage_summary = true,
 };
 
 struct fwk_module_config config_log = {
@@ -44,12 +44,7 @@ static const struct fwk_element element_table[] = {
     [JUNO_MHU_DEVICE_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *get_element_table(fwk_id_t module_id)
-{
-    return element_table;
-}
-
-struct fwk_module_config config_mhu = {
-    .get_element_table = get_element_table,
+const struct fwk_module_config config_mhu = {
+    .elements = element_table,
     .data = NULL,
 };
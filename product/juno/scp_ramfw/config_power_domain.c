@@ -70,7 +70,7 @@ enum tree_idx_systop_child {
     TREE_IDX_SYSTOP_CHILD_GPU,
 };
 
-static struct fwk_element element_table[] = {
+static const struct fwk_element element_table[] = {
     [POWER_DOMAIN_IDX_BIG_CPU0] = {
         .name = "BIG_CPU0",
         .data = &(struct mod_power_domain_element_config) {
@@ -302,12 +302,7 @@ static struct fwk_element element_table[] = {
     [POWER_DOMAIN_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *get_element_table(fwk_id_t module_id)
-{
-    return element_table;
-}
-
-struct fwk_module_config config_power_domain = {
-    .get_element_table = get_element_table,
+const struct fwk_module_config config_power_domain = {
+    .elements = element_table,
     .data = &(struct mod_power_domain_config){ 0 }
 };
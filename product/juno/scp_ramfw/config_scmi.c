@@ -67,11 +67,6 @@ static const struct fwk_element element_table[] = {
     [JUNO_SCMI_SERVICE_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *get_element_table(fwk_id_t module_id)
-{
-    return element_table;
-}
-
 static const struct mod_scmi_agent agent_table[] = {
     [JUNO_SCMI_AGENT_IDX_OSPM] = {
         .type = SCMI_AGENT_TYPE_OSPM,
@@ -83,8 +78,8 @@ static const struct mod_scmi_agent agent_table[] = {
     },
 };
 
-struct fwk_module_config config_scmi = {
-    .get_element_table = get_element_table,
+const struct fwk_module_config config_scmi = {
+    .elements = element_table,
     .data = &(struct mod_scmi_config) {
         .protocol_count_max = 2,
         .agent_count = FWK_ARRAY_SIZE(agent_table) - 1,
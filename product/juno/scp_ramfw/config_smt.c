@@ -70,12 +70,7 @@ static const struct fwk_element element_table[] = {
     [JUNO_SCMI_SERVICE_IDX_COUNT] = { 0 },
 };
 
-static const struct fwk_element *get_element_table(fwk_id_t module_id)
-{
-    return element_table;
-}
-
-struct fwk_module_config config_smt = {
-    .get_element_table = get_element_table,
+const struct fwk_module_config config_smt = {
+    .elements = element_table,
     .data = NULL,
 };
@@ -50,12 +50,6 @@ static const struct fwk_element system_power_element_table[] = {
     [1] = { 0 }, /* Termination description */
 };
 
-static const struct fwk_element *system_power_get_element_table(
-    fwk_id_t module_id)
-{
-    return system_power_element_table;
-}
-
 const struct fwk_module_config config_system_power = {
     .data = &((struct mod_system_power_config) {
         .soc_wakeup_irq = EXT_WAKEUP_IRQ,
@@ -65,5 +59,5 @@ const struct fwk_module_config config_system_power = {
         .driver_api_id = FWK_ID_API_INIT(FWK_MODULE_IDX_JUNO_SYSTEM, 0),
         .initial_system_power_state = MOD_PD_STATE_ON,
     }),
-    .get_element_table = system_power_get_element_table,
+    .elements = system_power_element_table,
 };
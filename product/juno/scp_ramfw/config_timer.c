@@ -30,13 +30,8 @@ static const struct fwk_element gtimer_element_table[] = {
     [1] = { 0 },
 };
 
-static const struct fwk_element *gtimer_get_element_table(fwk_id_t module_id)
-{
-    return gtimer_element_table;
-}
-
-struct fwk_module_config config_gtimer = {
-    .get_element_table = gtimer_get_element_table,
+const struct fwk_module_config config_gtimer = {
+    .elements = gtimer_element_table,
 };
 
 static const struct fwk_element timer_element_table[] = {
@@ -46,15 +41,11 @@ static const struct fwk_element timer_element_table[] = {
             .id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_GTIMER, 0),
             .timer_irq = TIMREFCLK_IRQ,
         },
+        .sub_element_count = 2, /* Number of alarms */
     },
     [1] = { 0 },
 };
 
-static const struct fwk_element *timer_get_element_table(fwk_id_t module_id)
-{
-    return timer_element_table;
-}
-
-struct fwk_module_config config_timer = {
-    .get_element_table = timer_get_element_table,
+const struct fwk_module_config config_timer = {
+    .elements = timer_element_table,
 };
@@ -12,6 +12,12 @@ BS_FIRMWARE_CPU := cortex-m3
 BS_FIRMWARE_HAS_MULTITHREADING := yes
 BS_FIRMWARE_HAS_NOTIFICATION := yes
 
+# All the SCMI services use SMT channels
+BS_FIRMWARE_STATIC_APIS := scmi_transport:mod_smt_scmi_to_transport_api
+
+# The log API has no state per binding
+BS_FIRMWARE_STATIC_BINDINGS := any:log:0:mod_log_module_api
+
 BS_FIRMWARE_MODULE_HEADERS_ONLY :=
 
 BS_FIRMWARE_MODULES := \
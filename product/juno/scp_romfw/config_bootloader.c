@@ -17,6 +17,8 @@ static const struct mod_bootloader_config bootloader_module_config = {
     .destination_base = SCP_RAM_BASE,
     .destination_size = SCP_RAM_SIZE,
     .sds_struct_id = JUNO_SDS_BOOTLOADER,
+    .copy_driver_id = FWK_ID_NONE_INIT,
+    .timer_id = FWK_ID_NONE_INIT,
 };
 
 struct fwk_module_config config_bootloader = {
@@ -13,6 +13,7 @@
 const struct fwk_module_config config_n1sdp_rom = {
     .data = &((struct n1sdp_rom_config) {
         .ramfw_base = MCP_RAM0_BASE,
+        .ramfw_size = MCP_RAM0_SIZE,
         .image_type = MOD_N1SDP_FIP_TYPE_MCP_BL2,
     })
 };
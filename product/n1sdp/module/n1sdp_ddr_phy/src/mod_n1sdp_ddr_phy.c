@@ -22,8 +22,8 @@
 #include <n1sdp_ddr_phy_values.h>
 #include <n1sdp_scp_mmap.h>
 
-#define NUM_SLICES          9
-#define NUM_BITS_PER_SLICE  8
+#define NUM_SLICES          MOD_DMC620_DDR_PHY_SLICE_COUNT
+#define NUM_BITS_PER_SLICE  MOD_DMC620_DDR_PHY_BITS_PER_SLICE
 #define NUM_DATA_PATTERNS   5
 #define DCI_FIFO_SIZE       20
 
@@ -62,17 +62,90 @@ struct slice_eye_stat {
   int16_t median_mid;
 };
 
-struct wrdq_eye wrdq_eyes[NUM_SLICES][NUM_BITS_PER_SLICE];
-struct wrdq_eye best_wrdq_eyes[NUM_SLICES][NUM_BITS_PER_SLICE];
-uint16_t cur_wrdq_delays[NUM_SLICES][NUM_BITS_PER_SLICE];
+/* Time for the PHY to settle after an update of its delays, in microseconds */
+#define WET_SETTLE_TIME_US  1000
 
-struct slice_eye_stat slice_eye_stats[NUM_SLICES];
-struct slice_eye_stat best_slice_eye_stats[NUM_SLICES];
-int16_t sorted_mids[NUM_BITS_PER_SLICE];
-uint32_t *wr_data;
-uint32_t rd_data[DCI_FIFO_SIZE];
-uint8_t wrrd_passes[NUM_SLICES][NUM_BITS_PER_SLICE];
-uint16_t DEFAULT_DELAY = 0x240;
+/*
+ * States of the write eye training of a PHY. The training sweeps the write DQ
+ * delays of each rank, for each VREFDQ value when VREFDQ is swept, and waits
+ * for the PHY to settle after each update of the delays or of the VREFDQ value.
+ *
+ * When the result of a previous training is provided, it is restored and
+ * verified rank by rank instead, and the ranks are trained if the verification
+ * fails.
+ */
+enum wet_state {
+    WET_STATE_IDLE,
+    WET_STATE_RANK_START,
+    WET_STATE_VREF_START,
+    WET_STATE_DELAY_SET,
+    WET_STATE_DELAY_TEST,
+    WET_STATE_VREF_END,
+    WET_STATE_RANK_FINISH,
+    WET_STATE_BEST_VREF_SET,
+    WET_STATE_BEST_DELAY_SET,
+    WET_STATE_BEST_DELAY_UPDATE,
+    WET_STATE_RANK_END,
+    WET_STATE_RESTORE_RANK_START,
+    WET_STATE_RESTORE_VREF_SET,
+    WET_STATE_RESTORE_DELAY_SET,
+    WET_STATE_RESTORE_VERIFY,
+};
+
+/* Write eye training context of a PHY */
+struct wet_ctx {
+    struct dimm_info *info;
+    struct mod_dmc620_reg *dmc;
+    uint32_t ddr_phy_base;
+    enum wet_state state;
+
+    /* Training parameters */
+    uint32_t rank;
+    uint32_t start_rank;
+    uint32_t stop_rank;
+    uint16_t delay_increment;
+    uint32_t vrefdq_increment;
+    uint32_t dbg_level;
+
+    /* Sweep state of the rank being trained */
+    int16_t vrefdq_mr6;
+    int16_t best_vrefdq_mr6;
+    int32_t direction;
+    uint32_t delay;
+    uint32_t num_completed;
+    uint32_t direct_addr;
+    uint32_t direct_cmd;
+    uint32_t sc_phy_manual_update_reg_val;
+    int analysis_status;
+    uint32_t orig_training_idx_vals[NUM_SLICES];
+
+    struct wrdq_eye wrdq_eyes[NUM_SLICES][NUM_BITS_PER_SLICE];
+    struct wrdq_eye best_wrdq_eyes[NUM_SLICES][NUM_BITS_PER_SLICE];
+    uint16_t cur_wrdq_delays[NUM_SLICES][NUM_BITS_PER_SLICE];
+    struct slice_eye_stat slice_eye_stats[NUM_SLICES];
+    struct slice_eye_stat best_slice_eye_stats[NUM_SLICES];
+    uint8_t wrrd_passes[NUM_SLICES][NUM_BITS_PER_SLICE];
+    uint32_t rd_data[DCI_FIFO_SIZE];
+
+    /* Result of the training, or result to restore when restore is true */
+    struct mod_dmc620_wet_result result;
+    bool restore;
+    bool result_valid;
+};
+
+static const uint16_t DEFAULT_DELAY = 0x240;
+
+static const uint32_t NUM_DQ_BITS = NUM_SLICES * NUM_BITS_PER_SLICE;
+static const uint32_t PHY_PER_CS_TRAINING_INDEX_0_REG_IDX = 9;
+static const uint32_t PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX = 82;
+static const uint32_t SC_PHY_MANUAL_UPDATE_REG_IDX = 2310;
+static const uint16_t DELAY_MIN = 0x0;
+static const uint16_t DELAY_MAX = 0x7FF;
+static const int16_t MIN_VREFDQ_MR6 = 0x0;
+static const int16_t MAX_VREFDQ_MR6 = 0x32;
+
+/* Table of the write eye training contexts, one per PHY */
+static struct wet_ctx *wet_ctx_table;
 
 static struct mod_log_api *log_api;
 
@@ -97,7 +170,7 @@ static int n1sdp_ddr_phy_config(fwk_id_t element_id, struct dimm_info *info)
 
     ddr_phy = (struct mod_n1sdp_ddr_phy_reg *)element_config->ddr;
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR-PHY] Initializing PHY at 0x%x for %d MHz speed\n",
         (uintptr_t)ddr_phy, info->speed);
 
@@ -112,7 +185,8 @@ static int n1sdp_ddr_phy_config(fwk_id_t element_id, struct dimm_info *info)
         ddr_phy_config_800(ddr_phy, info);
         break;
     default:
-        log_api->log(MOD_LOG_GROUP_INFO, "[DDR-PHY] Unsupported frequency!\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+                "[DDR-PHY] Unsupported frequency!\n");
         break;
     }
 
@@ -207,16 +281,6 @@ static void adjust_per_rank_rptr_update_value(uint32_t phy_addr,
     }
 }
 
-static void delay_ms(uint32_t ms)
-{
-    volatile uint32_t i = 0;
-    while (ms) {
-        for (i = 0; i < 6000; i++)
-            ;
-        ms--;
-    }
-}
-
 uint32_t dci_write_dram(struct mod_dmc620_reg *dmc, uint32_t *scp_address,
     uint32_t size_32, uint32_t rank, uint32_t bank)
 {
@@ -225,7 +289,8 @@ uint32_t dci_write_dram(struct mod_dmc620_reg *dmc, uint32_t *scp_address,
 
     // Confirm that DMC is in config state
     if ((dmc->MEMC_STATUS & 0x7) != 0x0) {
-        log_api->log(MOD_LOG_GROUP_INFO, "DMC needs to be in config state\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+                "DMC needs to be in config state\n");
         return FWK_E_STATE;
     }
 
@@ -279,7 +344,8 @@ uint32_t dci_read_dram(struct mod_dmc620_reg *dmc, uint32_t *scp_address,
 
     // Confirm that DMC is in config state
     if ((dmc->MEMC_STATUS & 0x7) != 0x0) {
-        log_api->log(MOD_LOG_GROUP_INFO, "DMC needs to be in config state\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+                "DMC needs to be in config state\n");
         return FWK_E_PARAM;
     }
 
@@ -309,432 +375,700 @@ uint32_t dci_read_dram(struct mod_dmc620_reg *dmc, uint32_t *scp_address,
 }
 
 
-static int write_eye_detect_single_rank(fwk_id_t element_id,
-    struct dimm_info *info, uint32_t rank, uint32_t delay_increment,
-    uint32_t vrefdq_increment, uint32_t dbg_level)
+static void wet_set_delays(struct wet_ctx *wet, uint32_t delay)
 {
-    const uint32_t NUM_DQ_BITS = NUM_SLICES * NUM_BITS_PER_SLICE;
-    const uint32_t NUM_DFI_BEATS_TO_CHECK = 4;
-    const uint32_t SLICE_MASK = ~(0xFFFFFFFF << NUM_BITS_PER_SLICE);
-    const uint32_t NUM_WORDS_IN_DFI_BEAT = 5;
-    const uint8_t BIT_WRRD_SUCCESS =
-        NUM_DATA_PATTERNS * NUM_DFI_BEATS_TO_CHECK * 2;
-    const uint32_t PHY_PER_CS_TRAINING_INDEX_0_REG_IDX = 9;
-    const uint32_t PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX = 82;
-    const uint32_t SC_PHY_MANUAL_UPDATE_REG_IDX = 2310;
-
-    const uint16_t DELAY_MIN = 0x0;
-    const uint16_t DELAY_MAX = 0x7FF;
-    uint16_t DELAY_INCR = delay_increment;
+    uint32_t slice;
+    uint32_t bit;
+    uint32_t reg_val;
+    uint32_t denali_index;
 
-    uint32_t orig_training_idx_vals[NUM_SLICES];
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+            wet->cur_wrdq_delays[slice][bit] = delay;
+            if (bit % 2 == 1) {
+                reg_val = (wet->cur_wrdq_delays[slice][bit] & 0x7FF) << 16;
+                reg_val |= (wet->cur_wrdq_delays[slice][bit - 1] & 0x7FF);
+                denali_index = (PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX +
+                                (bit / 2)) + (slice * 256);
+                *(uint32_t *)(wet->ddr_phy_base + (4 * denali_index)) =
+                    reg_val;
+            }
+        }
+    }
+}
 
-    bool sweep_vrefdq = (vrefdq_increment != 0);
-    bool no_bits_pass;
+static void wet_manual_update(struct wet_ctx *wet)
+{
+    wet->sc_phy_manual_update_reg_val |= 1;
+    *(uint32_t *)(wet->ddr_phy_base + (4 * SC_PHY_MANUAL_UPDATE_REG_IDX)) =
+        wet->sc_phy_manual_update_reg_val;
+}
 
-    uint32_t ret_code = FWK_SUCCESS;
-    uint32_t analysis_ret_code = FWK_SUCCESS;
-    uint32_t denali_index = 0;
-    uint32_t sc_phy_manual_update_reg_val = 0;
-    uint32_t reg_val = 0;
-    uint32_t wait_ms = 1;
+static void wet_send_mr6(struct wet_ctx *wet)
+{
+    wet->dmc->DIRECT_ADDR = wet->direct_addr;
+    wet->dmc->DIRECT_CMD = wet->direct_cmd;
+}
 
-    const int16_t MIN_VREFDQ_MR6 = 0x0;
-    const int16_t MAX_VREFDQ_MR6 = 0x32;
-    int16_t best_vrefdq_mr6 = -1;
-    int32_t direction;
-    uint32_t num_completed;
-    uint32_t delay;
-    uint32_t data_pattern;
-    uint32_t i;
-    uint32_t dfi_beat;
-    uint32_t dfi_beat_word_offset;
-    uint32_t dqs_edge;
-    int16_t vrefdq_mr6;
+static void wet_reset_eyes(struct wrdq_eye eyes[NUM_SLICES][NUM_BITS_PER_SLICE])
+{
     uint32_t slice;
     uint32_t bit;
-    uint32_t rd_val;
-    uint32_t wr_val;
-    uint32_t eye_a_mid;
-    uint32_t eye_b_mid;
-    struct wrdq_eye *eye = NULL;
-    struct wrdq_eye *eye_b = NULL;
-    uint32_t wr_slice_data;
-    uint32_t rd_slice_data;
-    uint32_t start_bit;
-    uint32_t word_num;
-    uint32_t wr_bit;
-    uint32_t rd_bit;
-    uint16_t min_width;
-    uint32_t num_good_eyes_in_slice;
-    uint32_t better_slices;
 
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+            eyes[slice][bit].min = DELAY_MAX;
+            eyes[slice][bit].min_found = 0;
+            eyes[slice][bit].max = DELAY_MIN;
+            eyes[slice][bit].max_found = 0;
+            eyes[slice][bit].mid = 0;
+            eyes[slice][bit].width = 0;
+        }
+    }
+}
+
+static void wet_rank_start(struct wet_ctx *wet)
+{
+    uint32_t slice;
+    uint32_t denali_index;
+    uint32_t rd_val;
     uint32_t speed;
     uint32_t range;
     uint32_t tccd_l;
-    uint32_t direct_addr;
-    uint32_t direct_cmd;
-    int dmc_id;
-    int s;
-    int t;
-    struct mod_dmc620_reg *dmc = NULL;
-    uint32_t ddr_phy_base = 0;
 
-    fwk_assert(rank < 2);
-    dmc_id = fwk_id_get_element_idx(element_id);
-    if (dmc_id == 0) {
-        dmc = (struct mod_dmc620_reg *)SCP_DMC0;
-        ddr_phy_base = SCP_DDR_PHY0;
-    } else if (dmc_id == 1) {
-        dmc = (struct mod_dmc620_reg *)SCP_DMC1;
-        ddr_phy_base = SCP_DDR_PHY1;
-    } else
-        fwk_assert(false);
-
-    best_vrefdq_mr6 = -1;
+    wet->best_vrefdq_mr6 = -1;
+    wet->analysis_status = FWK_SUCCESS;
     for (slice = 0; slice < NUM_SLICES; slice++) {
-        best_slice_eye_stats[slice].min_width = 0;
-        best_slice_eye_stats[slice].median_mid = 0;
+        wet->best_slice_eye_stats[slice].min_width = 0;
+        wet->best_slice_eye_stats[slice].median_mid = 0;
     }
 
-    for (slice = 0; slice < NUM_SLICES; slice++) {
-        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-            best_wrdq_eyes[slice][bit].min = DELAY_MAX;
-            best_wrdq_eyes[slice][bit].min_found = 0;
-            best_wrdq_eyes[slice][bit].max = DELAY_MIN;
-            best_wrdq_eyes[slice][bit].max_found = 0;
-            best_wrdq_eyes[slice][bit].mid = 0;
-            best_wrdq_eyes[slice][bit].width = 0;
-        }
-    }
+    wet_reset_eyes(wet->best_wrdq_eyes);
 
     for (slice = 0; slice < NUM_SLICES; slice++) {
-        rd_val = 0;
-        wr_val = 0;
         denali_index = PHY_PER_CS_TRAINING_INDEX_0_REG_IDX + (slice * 256);
-        rd_val = *(uint32_t *)(ddr_phy_base + (4 * denali_index));
-        orig_training_idx_vals[slice] = rd_val;
-        wr_val = (rank << 16) | (rd_val & 0xFFFFCFEFF);
-        *(uint32_t *)(ddr_phy_base + (4 * denali_index)) = wr_val;
+        rd_val = *(uint32_t *)(wet->ddr_phy_base + (4 * denali_index));
+        wet->orig_training_idx_vals[slice] = rd_val;
+        *(uint32_t *)(wet->ddr_phy_base + (4 * denali_index)) =
+            (wet->rank << 16) | (rd_val & 0xFFFFCFEFF);
     }
 
-    for (slice = 0; slice < NUM_SLICES; slice++) {
-        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit += 2) {
-            rd_val = 0;
-            denali_index = (PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX + (bit / 2)) +
-                            (slice * 256);
-            rd_val = *(uint32_t *)(ddr_phy_base + (4 * denali_index));
-        }
-    }
+    wet->sc_phy_manual_update_reg_val = *(uint32_t *)(wet->ddr_phy_base +
+                                         (4 * SC_PHY_MANUAL_UPDATE_REG_IDX));
 
-    sc_phy_manual_update_reg_val = *(uint32_t *)(ddr_phy_base +
-                                    (4 * SC_PHY_MANUAL_UPDATE_REG_IDX));
-
-    speed = info->speed;
+    speed = wet->info->speed;
     range = 1;
     tccd_l =
         (speed == 800) ? 1 : (speed == 1200) ? 2 : (speed == 1333) ? 3 : 3;
-    direct_addr = (tccd_l << 10) | (1 << 7) | (range - 1) << 6;
-    direct_cmd = ((1 << rank) << 16) | (0x6 << 8) | 1;
+    wet->direct_addr = (tccd_l << 10) | (1 << 7) | (range - 1) << 6;
+    wet->direct_cmd = ((1 << wet->rank) << 16) | (0x6 << 8) | 1;
+}
 
-    if (sweep_vrefdq) {
-        dmc->DIRECT_ADDR = direct_addr;
-        dmc->DIRECT_CMD = direct_cmd;
-        delay_ms(wait_ms);
-    }
+#define NUM_DFI_BEATS_TO_CHECK  4
+#define BIT_WRRD_SUCCESS        (NUM_DATA_PATTERNS * NUM_DFI_BEATS_TO_CHECK * 2)
 
-    for (vrefdq_mr6 = MIN_VREFDQ_MR6;
-         vrefdq_mr6 <= MAX_VREFDQ_MR6;
-         vrefdq_mr6 += vrefdq_increment) {
-        if (sweep_vrefdq) {
-            direct_addr = (direct_addr & 0xFFFFFFC0) | vrefdq_mr6;
-            dmc->DIRECT_ADDR = direct_addr;
-            dmc->DIRECT_CMD = direct_cmd;
-            delay_ms(wait_ms);
-        }
+/*
+ * Write and read back the data patterns with the current delays, and count the
+ * successful transfers of each DQ bit.
+ */
+static int wet_test_patterns(struct wet_ctx *wet)
+{
+    const uint32_t SLICE_MASK = ~(0xFFFFFFFF << NUM_BITS_PER_SLICE);
+    const uint32_t NUM_WORDS_IN_DFI_BEAT = 5;
 
-        for (slice = 0; slice < NUM_SLICES; slice++) {
-            for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-                wrdq_eyes[slice][bit].min = DELAY_MAX;
-                wrdq_eyes[slice][bit].min_found = 0;
-                wrdq_eyes[slice][bit].max = DELAY_MIN;
-                wrdq_eyes[slice][bit].max_found = 0;
-                wrdq_eyes[slice][bit].mid = 0;
-                wrdq_eyes[slice][bit].width = 0;
-            }
-        }
+    int status;
+    bool no_bits_pass;
+    uint32_t *wr_data;
+    uint32_t *rd_data = wet->rd_data;
+    uint32_t data_pattern;
+    uint32_t dfi_beat;
+    uint32_t dfi_beat_word_offset;
+    uint32_t dqs_edge;
+    uint32_t slice;
+    uint32_t bit;
+    uint32_t wr_slice_data;
+    uint32_t rd_slice_data;
+    uint32_t start_bit;
+    uint32_t word_num;
+    uint32_t wr_bit;
+    uint32_t rd_bit;
 
-        for (direction = -1; direction < 2; direction += 2) {
-            num_completed = 0;
-            delay = DEFAULT_DELAY;
-            while (num_completed != NUM_DQ_BITS) {
-                if ((delay < DELAY_MIN) || (delay > DELAY_MAX))
-                    break;
+    wet_manual_update(wet);
 
-                for (slice = 0; slice < NUM_SLICES; slice++) {
-                    for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-                        cur_wrdq_delays[slice][bit] = delay;
-                        if (bit % 2 == 1) {
-                            reg_val =
-                                (cur_wrdq_delays[slice][bit] & 0x7FF) << 16;
-                            reg_val |=
-                                (cur_wrdq_delays[slice][bit - 1] & 0x7FF);
-                            denali_index =
-                                (PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX +
-                                 (bit / 2)) + (slice*256);
-                            *(uint32_t *)(ddr_phy_base + (4 * denali_index)) =
-                                reg_val;
-                        }
-                    }
-                }
+    memset(wet->wrrd_passes, 0, sizeof(wet->wrrd_passes));
 
-                delay_ms(wait_ms);
-                sc_phy_manual_update_reg_val |= 1;
-                *(uint32_t *)(ddr_phy_base +
-                              (4 * SC_PHY_MANUAL_UPDATE_REG_IDX)) =
-                    sc_phy_manual_update_reg_val;
-
-                memset(wrrd_passes, 0, sizeof(uint8_t) * NUM_DQ_BITS);
-
-                for (data_pattern = 0;
-                     data_pattern < NUM_DATA_PATTERNS;
-                     data_pattern++) {
-                    wr_data = wr_data_all[data_pattern];
-                    ret_code = dci_write_dram(dmc, wr_data,
-                                              DCI_FIFO_SIZE, rank, 0);
-                    if (ret_code != FWK_SUCCESS)
-                        return ret_code;
-                    ret_code = dci_read_dram(dmc, rd_data,
-                                             DCI_FIFO_SIZE, rank, 0);
-                    if (ret_code != FWK_SUCCESS)
-                        return ret_code;
-
-                    for (dfi_beat = 0;
-                         dfi_beat < NUM_DFI_BEATS_TO_CHECK;
-                         dfi_beat++) {
-                        dfi_beat_word_offset =
-                            (dfi_beat * NUM_WORDS_IN_DFI_BEAT);
-                        for (dqs_edge = 0; dqs_edge < 2; dqs_edge++) {
-                            no_bits_pass = true;
-                            for (slice = 0; slice < NUM_SLICES; slice++) {
-                                start_bit = (dqs_edge * 64) +
-                                             (slice * NUM_BITS_PER_SLICE);
-
-                                if (slice == NUM_SLICES - 1)
-                                    start_bit += (dqs_edge % 2 == 0) ? 64 : 8;
-
-                                word_num = (start_bit / 32) +
-                                            dfi_beat_word_offset;
-                                wr_slice_data =
-                                    (wr_data[word_num] >> (start_bit % 32)) &
-                                    SLICE_MASK;
-                                rd_slice_data =
-                                    (rd_data[word_num] >> (start_bit % 32)) &
-                                    SLICE_MASK;
-
-                                for (bit = 0;
-                                     bit < NUM_BITS_PER_SLICE; bit++) {
-                                    wr_bit = (wr_slice_data >> bit) & 0x1;
-                                    rd_bit = (rd_slice_data >> bit) & 0x1;
-                                    if (wr_bit == rd_bit) {
-                                        wrrd_passes[slice][bit]++;
-                                        no_bits_pass = false;
-                                    }
-                                }
-                            }
-
-                            if (dbg_level == 0 && no_bits_pass) {
-                                dqs_edge = 2;
-                                dfi_beat = NUM_DFI_BEATS_TO_CHECK;
-                                data_pattern = NUM_DATA_PATTERNS;
-                                break;
-                            }
-                        }
-                    }
-                }
+    for (data_pattern = 0;
+         data_pattern < NUM_DATA_PATTERNS;
+         data_pattern++) {
+        wr_data = wr_data_all[data_pattern];
+        status = dci_write_dram(wet->dmc, wr_data, DCI_FIFO_SIZE, wet->rank, 0);
+        if (status != FWK_SUCCESS)
+            return status;
+        status = dci_read_dram(wet->dmc, rd_data, DCI_FIFO_SIZE, wet->rank, 0);
+        if (status != FWK_SUCCESS)
+            return status;
 
+        for (dfi_beat = 0;
+             dfi_beat < NUM_DFI_BEATS_TO_CHECK;
+             dfi_beat++) {
+            dfi_beat_word_offset = (dfi_beat * NUM_WORDS_IN_DFI_BEAT);
+            for (dqs_edge = 0; dqs_edge < 2; dqs_edge++) {
+                no_bits_pass = true;
                 for (slice = 0; slice < NUM_SLICES; slice++) {
-                    for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-                        if (((direction < 0) &&
-                             (wrdq_eyes[slice][bit].min_found == 1)) ||
-                            ((direction > 0) &&
-                             (wrdq_eyes[slice][bit].max_found == 1))) {
-                            continue;
-                        }
+                    start_bit = (dqs_edge * 64) +
+                                 (slice * NUM_BITS_PER_SLICE);
 
-                        if (wrrd_passes[slice][bit] == BIT_WRRD_SUCCESS) {
-                            if (direction < 0) {
-                                if (cur_wrdq_delays[slice][bit] <
-                                    wrdq_eyes[slice][bit].min) {
-                                    wrdq_eyes[slice][bit].min =
-                                        cur_wrdq_delays[slice][bit];
-                                }
-                            } else if (direction > 0) {
-                                if (cur_wrdq_delays[slice][bit] >
-                                    wrdq_eyes[slice][bit].max) {
-                                    wrdq_eyes[slice][bit].max =
-                                        cur_wrdq_delays[slice][bit];
-                                }
-                            }
-                        } else {
-                            if ((direction < 0) &&
-                                (wrdq_eyes[slice][bit].min != DELAY_MAX)) {
-                                wrdq_eyes[slice][bit].min_found = 1;
-                                num_completed++;
-                            }
-                            if ((direction > 0) &&
-                                (wrdq_eyes[slice][bit].max != DELAY_MIN)) {
-                                wrdq_eyes[slice][bit].max_found = 1;
-                                num_completed++;
-                            }
+                    if (slice == NUM_SLICES - 1)
+                        start_bit += (dqs_edge % 2 == 0) ? 64 : 8;
+
+                    word_num = (start_bit / 32) + dfi_beat_word_offset;
+                    wr_slice_data =
+                        (wr_data[word_num] >> (start_bit % 32)) & SLICE_MASK;
+                    rd_slice_data =
+                        (rd_data[word_num] >> (start_bit % 32)) & SLICE_MASK;
+
+                    for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+                        wr_bit = (wr_slice_data >> bit) & 0x1;
+                        rd_bit = (rd_slice_data >> bit) & 0x1;
+                        if (wr_bit == rd_bit) {
+                            wet->wrrd_passes[slice][bit]++;
+                            no_bits_pass = false;
                         }
                     }
                 }
-                delay += (direction*DELAY_INCR);
-            }
-        }
 
-        for (slice = 0; slice < NUM_SLICES; slice++) {
-            min_width = DELAY_MAX;
-            num_good_eyes_in_slice = 0;
-            for (i = 0; i < NUM_BITS_PER_SLICE; i++)
-                sorted_mids[i] = DELAY_MAX;
-            for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-                eye = &wrdq_eyes[slice][bit];
-                if (!eye->min_found && !eye->max_found)
+                if (wet->dbg_level == 0 && no_bits_pass) {
+                    dqs_edge = 2;
+                    dfi_beat = NUM_DFI_BEATS_TO_CHECK;
+                    data_pattern = NUM_DATA_PATTERNS;
                     break;
-                eye->width = eye->max - eye->min;
-                if (eye->width < min_width)
-                    min_width = eye->width;
-
-                eye->mid = (eye->min + eye->max) / 2;
-                for (s = 0; s < (int)NUM_BITS_PER_SLICE; s++) {
-                    if (eye->mid < sorted_mids[s]) {
-                        for (t = num_good_eyes_in_slice-1; t >= 0; t--)
-                            sorted_mids[t+1] = sorted_mids[t];
-                        sorted_mids[s] = eye->mid;
-                        break;
-                    }
                 }
-                num_good_eyes_in_slice++;
             }
-            slice_eye_stats[slice].min_width =
-                (min_width == DELAY_MAX) ? 0 : min_width;
-            slice_eye_stats[slice].median_mid =
-                sorted_mids[(num_good_eyes_in_slice+1)/2];
-        }
-
-        better_slices = 0;
-        for (slice = 0; slice < NUM_SLICES; slice++) {
-            if (slice_eye_stats[slice].min_width >
-                best_slice_eye_stats[slice].min_width)
-                better_slices++;
         }
-        if (better_slices == NUM_SLICES) {
-            best_vrefdq_mr6 = vrefdq_mr6;
-            memcpy(best_wrdq_eyes, wrdq_eyes,
-                sizeof(struct wrdq_eye)*NUM_SLICES*NUM_BITS_PER_SLICE);
-            memcpy(best_slice_eye_stats, slice_eye_stats,
-                sizeof(struct slice_eye_stat)*NUM_SLICES);
-        }
-        if (!sweep_vrefdq)
-            break;
     }
 
-    if (best_vrefdq_mr6 != -1) {
-        for (slice = 0; slice < NUM_SLICES; slice++) {
-            for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
-                eye = &best_wrdq_eyes[slice][bit];
-                if (eye->max == 0)
-                    analysis_ret_code = FWK_E_RANGE;
+    return FWK_SUCCESS;
+}
+
+/*
+ * Test the current delays and update the eye of each DQ bit.
+ */
+static int wet_test_delay(struct wet_ctx *wet)
+{
+    int status;
+    uint32_t slice;
+    uint32_t bit;
+    int32_t direction = wet->direction;
+    struct wrdq_eye *eye;
+
+    status = wet_test_patterns(wet);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+            eye = &wet->wrdq_eyes[slice][bit];
+            if (((direction < 0) && (eye->min_found == 1)) ||
+                ((direction > 0) && (eye->max_found == 1)))
+                continue;
+
+            if (wet->wrrd_passes[slice][bit] == BIT_WRRD_SUCCESS) {
+                if (direction < 0) {
+                    if (wet->cur_wrdq_delays[slice][bit] < eye->min)
+                        eye->min = wet->cur_wrdq_delays[slice][bit];
+                } else if (direction > 0) {
+                    if (wet->cur_wrdq_delays[slice][bit] > eye->max)
+                        eye->max = wet->cur_wrdq_delays[slice][bit];
+                }
+            } else {
+                if ((direction < 0) && (eye->min != DELAY_MAX)) {
+                    eye->min_found = 1;
+                    wet->num_completed++;
+                }
+                if ((direction > 0) && (eye->max != DELAY_MIN)) {
+                    eye->max_found = 1;
+                    wet->num_completed++;
+                }
             }
         }
     }
 
-    if (best_vrefdq_mr6 == -1) {
-        analysis_ret_code = FWK_E_RANGE;
-        direct_addr &= 0xFFFFFF7F;
-        dmc->DIRECT_ADDR = direct_addr;
-        dmc->DIRECT_CMD = direct_cmd;
-        delay_ms(wait_ms);
-    } else {
-        if (sweep_vrefdq) {
-            direct_addr = (direct_addr & 0xFFFFFFC0) | best_vrefdq_mr6;
-            dmc->DIRECT_ADDR = direct_addr;
-            dmc->DIRECT_CMD = direct_cmd;
-            delay_ms(wait_ms);
-            direct_addr &= 0xFFFFFF7F;
-            dmc->DIRECT_ADDR = direct_addr;
-            dmc->DIRECT_CMD = direct_cmd;
-            delay_ms(wait_ms);
+    wet->delay += (direction * wet->delay_increment);
+
+    return FWK_SUCCESS;
+}
+
+/* Check that all the DQ bits transfer the data patterns successfully */
+static bool wet_verify(struct wet_ctx *wet)
+{
+    uint32_t slice;
+    uint32_t bit;
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+            if (wet->wrrd_passes[slice][bit] != BIT_WRRD_SUCCESS)
+                return false;
         }
+    }
 
-        for (slice = 0; slice < NUM_SLICES; slice++) {
-            for (bit = 0; bit < NUM_BITS_PER_SLICE; bit += 2) {
-                eye = &best_wrdq_eyes[slice][bit];
-                eye_a_mid = eye->mid;
-                eye_b = &best_wrdq_eyes[slice][bit + 1];
-                eye_b_mid = eye_b->mid;
-                reg_val = (eye_b_mid << 16) | eye_a_mid;
-                denali_index = (PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX +
-                                (bit / 2)) + (slice * 256);
-                *(uint32_t *)(ddr_phy_base + (4 * denali_index)) = reg_val;
+    return true;
+}
+
+/*
+ * Compute the width and middle of the eyes found for the current VREFDQ value
+ * and keep them if they are wider than the best ones found so far.
+ */
+static void wet_analyse_eyes(struct wet_ctx *wet)
+{
+    int16_t sorted_mids[NUM_BITS_PER_SLICE];
+    uint16_t min_width;
+    uint32_t num_good_eyes_in_slice;
+    uint32_t better_slices;
+    uint32_t slice;
+    uint32_t bit;
+    uint32_t i;
+    int s;
+    int t;
+    struct wrdq_eye *eye;
+
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        min_width = DELAY_MAX;
+        num_good_eyes_in_slice = 0;
+        for (i = 0; i < NUM_BITS_PER_SLICE; i++)
+            sorted_mids[i] = DELAY_MAX;
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit++) {
+            eye = &wet->wrdq_eyes[slice][bit];
+            if (!eye->min_found && !eye->max_found)
+                break;
+            eye->width = eye->max - eye->min;
+            if (eye->width < min_width)
+                min_width = eye->width;
+
+            eye->mid = (eye->min + eye->max) / 2;
+            for (s = 0; s < (int)NUM_BITS_PER_SLICE; s++) {
+                if (eye->mid < sorted_mids[s]) {
+                    for (t = num_good_eyes_in_slice-1; t >= 0; t--)
+                        sorted_mids[t+1] = sorted_mids[t];
+                    sorted_mids[s] = eye->mid;
+                    break;
+                }
             }
+            num_good_eyes_in_slice++;
         }
+        wet->slice_eye_stats[slice].min_width =
+            (min_width == DELAY_MAX) ? 0 : min_width;
+        wet->slice_eye_stats[slice].median_mid =
+            sorted_mids[(num_good_eyes_in_slice+1)/2];
+    }
 
-        delay_ms(wait_ms);
-        sc_phy_manual_update_reg_val |= 1;
-        *(uint32_t *)(ddr_phy_base + (4 * SC_PHY_MANUAL_UPDATE_REG_IDX)) =
-            sc_phy_manual_update_reg_val;
+    better_slices = 0;
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        if (wet->slice_eye_stats[slice].min_width >
+            wet->best_slice_eye_stats[slice].min_width)
+            better_slices++;
+    }
+    if (better_slices == NUM_SLICES) {
+        wet->best_vrefdq_mr6 = wet->vrefdq_mr6;
+        memcpy(wet->best_wrdq_eyes, wet->wrdq_eyes,
+            sizeof(wet->best_wrdq_eyes));
+        memcpy(wet->best_slice_eye_stats, wet->slice_eye_stats,
+            sizeof(wet->best_slice_eye_stats));
     }
+}
+
+/* Set the delays of the training result of the current rank */
+static void wet_set_result_delays(struct wet_ctx *wet)
+{
+    uint32_t slice;
+    uint32_t bit;
+    uint32_t reg_val;
+    uint32_t denali_index;
+    uint16_t (*delays)[NUM_BITS_PER_SLICE] =
+        wet->result.wrdq_delay[wet->rank];
 
     for (slice = 0; slice < NUM_SLICES; slice++) {
-        wr_val = 0;
-        denali_index = PHY_PER_CS_TRAINING_INDEX_0_REG_IDX + (slice * 256);
-        wr_val = orig_training_idx_vals[slice];
-        *(uint32_t *)(ddr_phy_base + (4 * denali_index)) = wr_val;
+        for (bit = 0; bit < NUM_BITS_PER_SLICE; bit += 2) {
+            reg_val = (delays[slice][bit + 1] << 16) | delays[slice][bit];
+            denali_index = (PHY_CLK_WRDQ0_SLAVE_DELAY_0_REG_IDX +
+                            (bit / 2)) + (slice * 256);
+            *(uint32_t *)(wet->ddr_phy_base + (4 * denali_index)) = reg_val;
+        }
     }
+}
 
-    if (ret_code != FWK_SUCCESS)
-      return ret_code;
+static void wet_rank_end(struct wet_ctx *wet)
+{
+    uint32_t slice;
+    uint32_t denali_index;
 
-    return analysis_ret_code;
+    for (slice = 0; slice < NUM_SLICES; slice++) {
+        denali_index = PHY_PER_CS_TRAINING_INDEX_0_REG_IDX + (slice * 256);
+        *(uint32_t *)(wet->ddr_phy_base + (4 * denali_index)) =
+            wet->orig_training_idx_vals[slice];
+    }
 }
 
-static int write_eye_detect(fwk_id_t element_id, struct dimm_info *info,
+static int wet_start(fwk_id_t element_id, struct dimm_info *info,
     uint32_t rank_sel, uint32_t delay_increment,
     uint32_t vrefdq_increment, uint32_t dbg_level)
 {
-    uint32_t start_rank;
-    uint32_t stop_rank;
-    uint32_t rank;
-    int status = FWK_SUCCESS;
+    int dmc_id;
+    struct wet_ctx *wet;
 
     if (((int)rank_sel > (info->number_of_ranks - 1)) && (rank_sel != 0xF)) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR-PHY] Invalid rank parameter %d\n", rank_sel);
         return FWK_E_PARAM;
     }
 
+    dmc_id = fwk_id_get_element_idx(element_id);
+    wet = &wet_ctx_table[dmc_id];
+
+    if (dmc_id == 0) {
+        wet->dmc = (struct mod_dmc620_reg *)SCP_DMC0;
+        wet->ddr_phy_base = SCP_DDR_PHY0;
+    } else if (dmc_id == 1) {
+        wet->dmc = (struct mod_dmc620_reg *)SCP_DMC1;
+        wet->ddr_phy_base = SCP_DDR_PHY1;
+    } else {
+        fwk_assert(false);
+        return FWK_E_PARAM;
+    }
+
     if (rank_sel == 0xF) {
-        start_rank = 0;
-        stop_rank = info->number_of_ranks - 1;
+        wet->start_rank = 0;
+        wet->stop_rank = info->number_of_ranks - 1;
     } else {
-        start_rank = rank_sel;
-        stop_rank = rank_sel;
+        wet->start_rank = rank_sel;
+        wet->stop_rank = rank_sel;
     }
+    fwk_assert(wet->stop_rank < MOD_DMC620_DDR_PHY_RANK_MAX);
+
+    wet->info = info;
+    wet->rank = wet->start_rank;
+    wet->delay_increment = delay_increment;
+    wet->vrefdq_increment = vrefdq_increment;
+    wet->dbg_level = dbg_level;
+    wet->result_valid = false;
+    wet->state = wet->restore ? WET_STATE_RESTORE_RANK_START :
+                                WET_STATE_RANK_START;
+    wet->restore = false;
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * Run the write eye training until it has to wait for the PHY to settle.
+ *
+ * \retval FWK_PENDING The training must be resumed after *wait_us us.
+ * \retval FWK_SUCCESS The training of all the ranks succeeded.
+ * \return One of the other error codes if the training failed.
+ */
+static int wet_step(struct wet_ctx *wet, uint32_t *wait_us)
+{
+    int status;
+    bool sweep_vrefdq = (wet->vrefdq_increment != 0);
+    uint32_t eye_idx;
+    struct wrdq_eye *eye;
+
+    *wait_us = WET_SETTLE_TIME_US;
+
+    for (;;) {
+        switch (wet->state) {
+        case WET_STATE_RANK_START:
+            wet_rank_start(wet);
+            wet->vrefdq_mr6 = MIN_VREFDQ_MR6;
+            wet->state = WET_STATE_VREF_START;
+            if (sweep_vrefdq) {
+                wet_send_mr6(wet);
+                return FWK_PENDING;
+            }
+            break;
+
+        case WET_STATE_VREF_START:
+            if (wet->vrefdq_mr6 > MAX_VREFDQ_MR6) {
+                wet->state = WET_STATE_RANK_FINISH;
+                break;
+            }
+
+            wet_reset_eyes(wet->wrdq_eyes);
+            wet->direction = -1;
+            wet->num_completed = 0;
+            wet->delay = DEFAULT_DELAY;
+            wet->state = WET_STATE_DELAY_SET;
+            if (sweep_vrefdq) {
+                wet->direct_addr =
+                    (wet->direct_addr & 0xFFFFFFC0) | wet->vrefdq_mr6;
+                wet_send_mr6(wet);
+                return FWK_PENDING;
+            }
+            break;
+
+        case WET_STATE_DELAY_SET:
+            if ((wet->num_completed == NUM_DQ_BITS) ||
+                (wet->delay < DELAY_MIN) || (wet->delay > DELAY_MAX)) {
+                /* Sweep the delays upwards once done downwards */
+                if (wet->direction < 0) {
+                    wet->direction = 1;
+                    wet->num_completed = 0;
+                    wet->delay = DEFAULT_DELAY;
+                } else
+                    wet->state = WET_STATE_VREF_END;
+                break;
+            }
+
+            wet_set_delays(wet, wet->delay);
+            wet->state = WET_STATE_DELAY_TEST;
+            return FWK_PENDING;
+
+        case WET_STATE_DELAY_TEST:
+            status = wet_test_delay(wet);
+            if (status != FWK_SUCCESS) {
+                wet->state = WET_STATE_IDLE;
+                return status;
+            }
+            wet->state = WET_STATE_DELAY_SET;
+            break;
+
+        case WET_STATE_VREF_END:
+            wet_analyse_eyes(wet);
+            if (sweep_vrefdq) {
+                wet->vrefdq_mr6 += wet->vrefdq_increment;
+                wet->state = WET_STATE_VREF_START;
+            } else
+                wet->state = WET_STATE_RANK_FINISH;
+            break;
+
+        case WET_STATE_RANK_FINISH:
+            if (wet->best_vrefdq_mr6 == -1) {
+                wet->analysis_status = FWK_E_RANGE;
+                wet->direct_addr &= 0xFFFFFF7F;
+                wet_send_mr6(wet);
+                wet->state = WET_STATE_RANK_END;
+                return FWK_PENDING;
+            }
+
+            for (eye_idx = 0; eye_idx < NUM_DQ_BITS; eye_idx++) {
+                eye = &wet->best_wrdq_eyes[eye_idx / NUM_BITS_PER_SLICE]
+                                          [eye_idx % NUM_BITS_PER_SLICE];
+                if (eye->max == 0)
+                    wet->analysis_status = FWK_E_RANGE;
+            }
+
+            for (eye_idx = 0; eye_idx < NUM_DQ_BITS; eye_idx++) {
+                eye = &wet->best_wrdq_eyes[eye_idx / NUM_BITS_PER_SLICE]
+                                          [eye_idx % NUM_BITS_PER_SLICE];
+                wet->result.wrdq_delay[wet->rank]
+                                      [eye_idx / NUM_BITS_PER_SLICE]
+                                      [eye_idx % NUM_BITS_PER_SLICE] = eye->mid;
+            }
+            wet->result.vrefdq_mr6[wet->rank] =
+                sweep_vrefdq ? wet->best_vrefdq_mr6 : -1;
+
+            if (sweep_vrefdq) {
+                wet->direct_addr =
+                    (wet->direct_addr & 0xFFFFFFC0) | wet->best_vrefdq_mr6;
+                wet_send_mr6(wet);
+                wet->state = WET_STATE_BEST_VREF_SET;
+                return FWK_PENDING;
+            }
+            wet->state = WET_STATE_BEST_DELAY_SET;
+            break;
+
+        case WET_STATE_BEST_VREF_SET:
+            wet->direct_addr &= 0xFFFFFF7F;
+            wet_send_mr6(wet);
+            wet->state = WET_STATE_BEST_DELAY_SET;
+            return FWK_PENDING;
+
+        case WET_STATE_BEST_DELAY_SET:
+            wet_set_result_delays(wet);
+            wet->state = WET_STATE_BEST_DELAY_UPDATE;
+            return FWK_PENDING;
+
+        case WET_STATE_BEST_DELAY_UPDATE:
+            wet_manual_update(wet);
+            wet->state = WET_STATE_RANK_END;
+            break;
 
-    for (rank = start_rank; rank <= stop_rank; rank++) {
-        status = write_eye_detect_single_rank(element_id, info, rank,
-            delay_increment, vrefdq_increment, dbg_level);
-        if (status != FWK_SUCCESS) {
-            log_api->log(MOD_LOG_GROUP_INFO,
-                "[DDR-PHY] WET single rank failed with error %d\n", status);
+        case WET_STATE_RANK_END:
+            wet_rank_end(wet);
+            if (wet->analysis_status != FWK_SUCCESS) {
+                MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+                    "[DDR-PHY] WET single rank failed with error %d\n",
+                    wet->analysis_status);
+                wet->state = WET_STATE_IDLE;
+                return wet->analysis_status;
+            }
+
+            if (wet->rank == wet->stop_rank) {
+                wet->result_valid = true;
+                wet->state = WET_STATE_IDLE;
+                return FWK_SUCCESS;
+            }
+            wet->rank++;
+            wet->state = WET_STATE_RANK_START;
+            break;
+
+        case WET_STATE_RESTORE_RANK_START:
+            wet_rank_start(wet);
+            wet->state = WET_STATE_RESTORE_DELAY_SET;
+            if (wet->result.vrefdq_mr6[wet->rank] >= 0) {
+                wet->direct_addr = (wet->direct_addr & 0xFFFFFFC0) |
+                                   wet->result.vrefdq_mr6[wet->rank];
+                wet_send_mr6(wet);
+                wet->state = WET_STATE_RESTORE_VREF_SET;
+                return FWK_PENDING;
+            }
             break;
+
+        case WET_STATE_RESTORE_VREF_SET:
+            wet->direct_addr &= 0xFFFFFF7F;
+            wet_send_mr6(wet);
+            wet->state = WET_STATE_RESTORE_DELAY_SET;
+            return FWK_PENDING;
+
+        case WET_STATE_RESTORE_DELAY_SET:
+            wet_set_result_delays(wet);
+            wet->state = WET_STATE_RESTORE_VERIFY;
+            return FWK_PENDING;
+
+        case WET_STATE_RESTORE_VERIFY:
+            status = wet_test_patterns(wet);
+            wet_rank_end(wet);
+            if (status != FWK_SUCCESS) {
+                wet->state = WET_STATE_IDLE;
+                return status;
+            }
+
+            if (!wet_verify(wet)) {
+                MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+                    "[DDR-PHY] Cached training of rank %u rejected\n",
+                    (unsigned int)wet->rank);
+                wet->rank = wet->start_rank;
+                wet->state = WET_STATE_RANK_START;
+                break;
+            }
+
+            if (wet->rank == wet->stop_rank) {
+                wet->result_valid = true;
+                wet->state = WET_STATE_IDLE;
+                return FWK_SUCCESS;
+            }
+            wet->rank++;
+            wet->state = WET_STATE_RESTORE_RANK_START;
+            break;
+
+        default:
+            return FWK_E_STATE;
+        }
+    }
+}
+
+/*
+ * Last setting of the PHY, once the write eye training has been done.
+ */
+static int post_training_finish(fwk_id_t element_id, struct dimm_info *info)
+{
+    const struct mod_n1sdp_ddr_phy_element_config *element_config;
+    uint32_t i;
+    uint32_t h;
+    uint32_t phy_addr;
+    uint32_t value;
+    uint32_t temp;
+
+    element_config = fwk_module_get_data(element_id);
+    phy_addr = (uint32_t)element_config->ddr;
+
+    for (h = 0; h < info->number_of_ranks; h++) {
+        for (i = 0; i < 9; i++) {
+            value = *(uint32_t *)(phy_addr + (4 * (9 + (i * 256))));
+            temp = value;
+            value = (value & 0xFFFCFFFF) | (h << 16);
+            *(uint32_t *)(phy_addr + (4 * (9 + (i * 256)))) = value;
+            value = *(uint32_t *)(phy_addr + (4 * (17 + (i * 256))));
+            value = (value & 0xFFFF00FF) | 0x100;
+            *(uint32_t *)(phy_addr + (4 * (17 + (i * 256)))) = value;
+            *(uint32_t *)(phy_addr + (4 * (9 + (i * 256)))) = temp;
         }
     }
 
-    return status;
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_ddr_phy_set_wet_result(fwk_id_t element_id,
+    const struct mod_dmc620_wet_result *result)
+{
+    int status;
+    struct wet_ctx *wet;
+
+    fwk_assert(result != NULL);
+
+    status = fwk_module_check_call(element_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    wet = &wet_ctx_table[fwk_id_get_element_idx(element_id)];
+    if (wet->state != WET_STATE_IDLE)
+        return FWK_E_STATE;
+
+    wet->result = *result;
+    wet->restore = true;
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_ddr_phy_get_wet_result(fwk_id_t element_id,
+    struct mod_dmc620_wet_result *result)
+{
+    int status;
+    struct wet_ctx *wet;
+
+    fwk_assert(result != NULL);
+
+    status = fwk_module_check_call(element_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    wet = &wet_ctx_table[fwk_id_get_element_idx(element_id)];
+    if (!wet->result_valid)
+        return FWK_E_STATE;
+
+    *result = wet->result;
+
+    return FWK_SUCCESS;
+}
+
+static int n1sdp_ddr_phy_post_training_step(fwk_id_t element_id,
+    uint32_t *wait_us)
+{
+    int status;
+    struct wet_ctx *wet;
+    const struct mod_n1sdp_ddr_phy_element_config *element_config;
+
+    fwk_assert(wait_us != NULL);
+
+    status = fwk_module_check_call(element_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    wet = &wet_ctx_table[fwk_id_get_element_idx(element_id)];
+    if (wet->state == WET_STATE_IDLE)
+        return FWK_E_STATE;
+
+    status = wet_step(wet, wait_us);
+    if (status == FWK_PENDING)
+        return status;
+
+    element_config = fwk_module_get_data(element_id);
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+        "[DDR-PHY] Write eye training at 0x%x %s\n",
+        (unsigned int)element_config->ddr,
+        (status == FWK_SUCCESS) ? "PASS!" : "FAIL!");
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return post_training_finish(element_id, wet->info);
 }
 
 static int n1sdp_ddr_phy_post_training_configure(fwk_id_t element_id,
@@ -743,10 +1077,8 @@ static int n1sdp_ddr_phy_post_training_configure(fwk_id_t element_id,
     int status;
     const struct mod_n1sdp_ddr_phy_element_config *element_config;
     uint32_t i;
-    uint32_t h;
     uint32_t phy_addr;
     uint32_t value;
-    uint32_t temp;
     uint32_t rddqs_latency_adjust_value;
     uint32_t rddqs_gate_slave_delay_value;
     uint32_t rddqs_x4_latency_adjust_value;
@@ -764,7 +1096,7 @@ static int n1sdp_ddr_phy_post_training_configure(fwk_id_t element_id,
     phy_addr = (uint32_t)element_config->ddr;
     rddata_valid_value = 0;
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR-PHY] Post training PHY setting at 0x%x\n", phy_addr);
 
     for (i = 0; i < 9; i++)  {
@@ -829,30 +1161,19 @@ static int n1sdp_ddr_phy_post_training_configure(fwk_id_t element_id,
         adjust_per_rank_rptr_update_value(phy_addr, info);
 
     if (info->speed >= 1333) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR-PHY] Performing write eye training...");
-        status = write_eye_detect(element_id, info, 0xF, 0x4, 0x2, 0);
-        if (status != FWK_SUCCESS) {
-            log_api->log(MOD_LOG_GROUP_INFO, "FAIL!\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+            "[DDR-PHY] Performing write eye training at 0x%x\n", phy_addr);
+        status = wet_start(element_id, info, 0xF, 0x4, 0x2, 0);
+        if (status != FWK_SUCCESS)
             return status;
-        }
-        log_api->log(MOD_LOG_GROUP_INFO, "PASS!\n");
-    }
 
-    for (h = 0; h < info->number_of_ranks; h++) {
-        for (i = 0; i < 9; i++) {
-            value = *(uint32_t *)(phy_addr + (4 * (9 + (i * 256))));
-            temp = value;
-            value = (value & 0xFFFCFFFF) | (h << 16);
-            *(uint32_t *)(phy_addr + (4 * (9 + (i * 256)))) = value;
-            value = *(uint32_t *)(phy_addr + (4 * (17 + (i * 256))));
-            value = (value & 0xFFFF00FF) | 0x100;
-            *(uint32_t *)(phy_addr + (4 * (17 + (i * 256)))) = value;
-            *(uint32_t *)(phy_addr + (4 * (9 + (i * 256)))) = temp;
-        }
+        /* The training is run by n1sdp_ddr_phy_post_training_step() */
+        return FWK_PENDING;
     }
 
-    return FWK_SUCCESS;
+    wet_ctx_table[fwk_id_get_element_idx(element_id)].restore = false;
+
+    return post_training_finish(element_id, info);
 }
 
 static int n1sdp_verify_phy_status(fwk_id_t element_id,
@@ -892,7 +1213,7 @@ static int n1sdp_verify_phy_status(fwk_id_t element_id,
                 value2 = *(uint32_t *)(phy_base + (4 * (42 + (i * 256))));
                 if (((value1 >> 16) >= 0x0200) ||
                     ((value2 & 0x0000FFFF) >= 0x200)) {
-                log_api->log(MOD_LOG_GROUP_INFO,
+                MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
                     "[DDR-PHY] PHY 0x%08x : Invalid Hard0/Hard 1 value found "
                     "for slice %d\n", phy_base, i);
                 }
@@ -909,7 +1230,7 @@ static int n1sdp_verify_phy_status(fwk_id_t element_id,
                 value1 = *(uint32_t *)(phy_base + (4 * (46 + (i * 256))));
                 if ((value1 != 0x003C) &&
                     ((info->dimm_mem_width == 4) && (value1 != 0x13C))) {
-                    log_api->log(MOD_LOG_GROUP_INFO,
+                    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
                         "[DDR-PHY] PHY 0x%08x : Final read gate training "
                         "status != 0x003C for slice %d\n", phy_base, i);
                 }
@@ -933,20 +1254,20 @@ static int n1sdp_verify_phy_status(fwk_id_t element_id,
                     *(uint32_t *)(phy_base + (4 * (34 + (i * 256)))) = value1;
                     value1 = *(uint32_t *)(phy_base + (4 * (47 + (i * 256))));
                     if ((value1 & 0x0000FFFF) > 0x0180) {
-                        log_api->log(MOD_LOG_GROUP_INFO,
+                        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
                             "[DDR-PHY] PHY 0x%08x : slice %d "
                             " phy_rdlvl_rddqs_dq_le_dly_obs_%d is > 0x180\n",
                             phy_base, j, i);
                     }
                     if ((value1 >> 16) > 0x0180) {
-                        log_api->log(MOD_LOG_GROUP_INFO,
+                        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
                         "[DDR-PHY] PHY 0x%08x : slice %d "
                         "phy_rdlvl_rddqs_dq_te_dly_obs_%d is > 0x180\n",
                         phy_base, j, i);
                     }
                     value1 = *(uint32_t *)(phy_base + (4 * (49 + (i * 256))));
                     if ((value1 >> 16) != 0x0C00) {
-                        log_api->log(MOD_LOG_GROUP_INFO,
+                        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
                             "[DDR-PHY] PHY 0x%08x : Final read data eye training "
                             "status != 0x0C00 for slice %d\n", phy_base, i);
                     }
@@ -1124,6 +1445,9 @@ static int n1sdp_phy_obs_regs(fwk_id_t element_id,
 static struct mod_dmc_ddr_phy_api n1sdp_ddr_phy_api = {
     .configure = n1sdp_ddr_phy_config,
     .post_training_configure = n1sdp_ddr_phy_post_training_configure,
+    .post_training_step = n1sdp_ddr_phy_post_training_step,
+    .set_wet_result = n1sdp_ddr_phy_set_wet_result,
+    .get_wet_result = n1sdp_ddr_phy_get_wet_result,
     .verify_phy_status = n1sdp_verify_phy_status,
     .wrlvl_phy_obs_regs = n1sdp_wrlvl_phy_obs_regs,
     .read_gate_phy_obs_regs = n1sdp_read_gate_phy_obs_regs,
@@ -1137,6 +1461,10 @@ static struct mod_dmc_ddr_phy_api n1sdp_ddr_phy_api = {
 static int n1sdp_ddr_phy_init(fwk_id_t module_id, unsigned int element_count,
     const void *config)
 {
+    wet_ctx_table = fwk_mm_calloc(element_count, sizeof(wet_ctx_table[0]));
+    if (wet_ctx_table == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
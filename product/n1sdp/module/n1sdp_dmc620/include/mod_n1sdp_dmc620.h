@@ -665,6 +665,57 @@ struct mod_dmc620_reg {
 /*!
  * \brief Element configuration.
  */
+/*! Number of byte slices of a DDR PHY, including the ECC slice */
+#define MOD_DMC620_DDR_PHY_SLICE_COUNT 9
+
+/*! Number of DQ bits of a byte slice of a DDR PHY */
+#define MOD_DMC620_DDR_PHY_BITS_PER_SLICE 8
+
+/*! Maximum number of ranks trained by a DDR PHY */
+#define MOD_DMC620_DDR_PHY_RANK_MAX 2
+
+/*! Number of DIMMs identified in a training cache */
+#define MOD_DMC620_DIMM_COUNT 2
+
+/*! Signature of a valid training cache, "DDRT" in memory */
+#define MOD_DMC620_TRAINING_CACHE_SIGNATURE UINT32_C(0x54524444)
+
+/*!
+ * \brief Write eye training result of a DDR PHY.
+ */
+struct mod_dmc620_wet_result {
+    /*! Write DQ delay of each bit of each rank */
+    uint16_t wrdq_delay[MOD_DMC620_DDR_PHY_RANK_MAX]
+                      [MOD_DMC620_DDR_PHY_SLICE_COUNT]
+                      [MOD_DMC620_DDR_PHY_BITS_PER_SLICE];
+
+    /*! VREFDQ value (MR6) of each rank, -1 if it was not trained */
+    int16_t vrefdq_mr6[MOD_DMC620_DDR_PHY_RANK_MAX];
+};
+
+/*!
+ * \brief Training result of a DMC kept across reboots.
+ *
+ * \details The result is only restored when the DIMMs and the speed are the
+ *      ones it was trained for, and it is verified before being used.
+ */
+struct mod_dmc620_training_cache {
+    /*! Signature, \ref MOD_DMC620_TRAINING_CACHE_SIGNATURE when valid */
+    uint32_t signature;
+
+    /*! Sum of the words of the cache following the checksum */
+    uint32_t checksum;
+
+    /*! Speed at which the DIMMs were trained */
+    uint32_t speed;
+
+    /*! Serial number of each DIMM */
+    uint32_t dimm_serial[MOD_DMC620_DIMM_COUNT];
+
+    /*! Write eye training result */
+    struct mod_dmc620_wet_result wet_result;
+};
+
 struct mod_dmc620_element_config {
     /*! Base address of the DMC-620 device's registers */
     uintptr_t dmc;
@@ -672,6 +723,12 @@ struct mod_dmc620_element_config {
     fwk_id_t ddr_id;
     /*! Identifier of the clock that this element depends on */
     fwk_id_t clock_id;
+    /*!
+     * \brief Training cache of the DMC, in memory retained across reboots.
+     *
+     * \details May be \c NULL if the training is not cached.
+     */
+    struct mod_dmc620_training_cache *training_cache;
 };
 
 /*!
@@ -716,11 +773,65 @@ struct mod_dmc_ddr_phy_api {
      *      configure.
      *
      * \retval FWK_SUCCESS if the operation succeed.
+     * \retval FWK_PENDING The setting requires a write eye training, which
+     *      is run by calls to post_training_step().
      * \return one of the error code otherwise.
      */
     int (*post_training_configure)(fwk_id_t element_id,
                                    struct dimm_info *info);
 
+    /*!
+     * \brief Run the write eye training started by post_training_configure()
+     *      until the PHY has to settle, and complete the post training setting
+     *      once the training is done.
+     *
+     * \details The training of several devices can be interleaved, each device
+     *      settling while the others are trained.
+     *
+     * \param element_id Element identifier corresponding to the device to
+     *      configure.
+     * \param[out] wait_us Time to wait, in microseconds, before the next call
+     *      when the training is not done.
+     *
+     * \retval FWK_PENDING The training is not done.
+     * \retval FWK_SUCCESS The training and the post training setting
+     *      succeeded.
+     * \retval FWK_E_STATE No training is in progress.
+     * \return one of the error code otherwise.
+     */
+    int (*post_training_step)(fwk_id_t element_id, uint32_t *wait_us);
+
+    /*!
+     * \brief Provide the write eye training result of a previous boot.
+     *
+     * \details The next post_training_configure() restores the result and
+     *      verifies it instead of training the device, and trains the device
+     *      if the verification fails.
+     *
+     * \param element_id Element identifier corresponding to the device to
+     *      configure.
+     * \param result Training result to restore.
+     *
+     * \retval FWK_SUCCESS if the operation succeed.
+     * \return one of the error code otherwise.
+     */
+    int (*set_wet_result)(fwk_id_t element_id,
+                          const struct mod_dmc620_wet_result *result);
+
+    /*!
+     * \brief Get the write eye training result of the last post training
+     *      setting.
+     *
+     * \param element_id Element identifier corresponding to the device.
+     * \param[out] result Training result.
+     *
+     * \retval FWK_SUCCESS if the operation succeed.
+     * \retval FWK_E_STATE No write eye training was done.
+     * \return one of the error code otherwise.
+     */
+    int (*get_wet_result)(fwk_id_t element_id,
+                          struct mod_dmc620_wet_result *result);
+
     /*!
      * \brief API to verify DDR PHY status at different training stage
      *
@@ -15,15 +15,19 @@
 #include <mod_n1sdp_i2c.h>
 #include <dimm_spd.h>
 
+/* Refresh interval of the DIMMs in nanoseconds */
+#define T_REFI_NS            7800U
+
 static bool multi_rank;
-static float t_refi = .0000078;
-static uint32_t dmc_clk_freq;
-static float dmc_clk_period;
+static uint32_t dmc_clk_freq_mhz;
 static int32_t dmc_clk_period_ps;
 
 static struct ddr4_spd ddr4_dimm0;
 static struct ddr4_spd ddr4_dimm1;
 
+/* Descriptor parsed from the SPD data, shared by all the DMCs */
+static struct dimm_spd_timing spd_timing;
+
 /*
  * Internal APIs used by SPD functions
  */
@@ -40,7 +44,7 @@ static int spd_read(struct mod_n1sdp_i2c_master_api *i2c_api,
     if (status != FWK_SUCCESS)
         return status;
 
-    for (i = SPD_PAGE0_START; i <= MAX_SPD_PAGE0; i++) {
+    for (i = SPD_PAGE0_START; i <= MAX_SPD_PAGE0; i += SPD_R_TRANSFER_SIZE) {
         status = i2c_api->read((FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_I2C, 0)),
                                address, (char *)&spd_data[i],
                                SPD_R_TRANSFER_SIZE);
@@ -53,7 +57,7 @@ static int spd_read(struct mod_n1sdp_i2c_master_api *i2c_api,
     if (status != FWK_SUCCESS)
         return status;
 
-    for (i = SPD_PAGE1_START; i <= MAX_SPD_PAGE1; i++) {
+    for (i = SPD_PAGE1_START; i <= MAX_SPD_PAGE1; i += SPD_R_TRANSFER_SIZE) {
         status = i2c_api->read((FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_I2C, 0)),
                                address, (char *)&spd_data[i],
                                SPD_R_TRANSFER_SIZE);
@@ -105,26 +109,26 @@ static void dimm_device_data(uint8_t *spd_data,
     unsigned int i;
 
     if (spd_data[2] == 0x0C) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "    DIMM %d information:\n", dimm_id);
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "    Manufacturer ID = 0x%x 0x%x\n",
             spd_data[320], spd_data[321]);
-        log_api->log(MOD_LOG_GROUP_INFO, "    Module part number = ");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "    Module part number = ");
         for (i = 329; i <= 348; i++)
-            log_api->log(MOD_LOG_GROUP_INFO, "%c", spd_data[i]);
-        log_api->log(MOD_LOG_GROUP_INFO, "\n");
+            MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "%c", spd_data[i]);
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "\n");
 
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "    Module serial number = 0x%x 0x%x 0x%x 0x%x\n",
             spd_data[325], spd_data[326], spd_data[327], spd_data[328]);
 
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "    Module manufacturing week %d%d year %d%d\n",
             0xF & (spd_data[324] >> 4), 0xF & spd_data[324],
             0xF & (spd_data[323] >> 4), 0xF & spd_data[323]);
     } else {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] ERROR! DDR4 SPD EEPROM Not Detected\n");
         fwk_assert(false);
     }
@@ -428,36 +432,10 @@ static uint32_t cal_dly_wth_rounding(int32_t spd_val, int32_t spd_val_fine)
 }
 
 /*
- * APIs invoked by DMC-620 core functions
+ * SPD parsing functions, filling the descriptor from the SPD data of DIMM 0
  */
-int dimm_spd_init_check(struct mod_n1sdp_i2c_master_api *i2c_api,
-                         struct dimm_info *ddr)
-{
-    int status;
-
-    spd_read(i2c_api, DIMM0_SPD_SLAVE, (uint8_t *)&ddr4_dimm0);
-    spd_read(i2c_api, DIMM1_SPD_SLAVE, (uint8_t *)&ddr4_dimm1);
-
-    status = chk_ddr4_dimms(ddr->speed, &ddr4_dimm0, &ddr4_dimm1);
-    if (status != FWK_SUCCESS)
-        return status;
 
-    dmc_clk_freq = ddr->speed * 1000000;
-    dmc_clk_period = 1/((float)(ddr->speed * 1000000));
-    dmc_clk_period_ps = (int32_t)((1/((float)(ddr->speed * 1000000))) *
-                                  1000000000000);
-    return FWK_SUCCESS;
-}
-
-void dimm_spd_mem_info(struct mod_log_api *log_api)
-{
-    fwk_assert(log_api != NULL);
-
-    dimm_device_data((uint8_t *)&ddr4_dimm0, log_api, 0);
-    dimm_device_data((uint8_t *)&ddr4_dimm1, log_api, 1);
-}
-
-int dimm_spd_address_control(uint32_t *temp_reg, struct dimm_info *ddr)
+static int spd_address_control(uint32_t *temp_reg, struct dimm_info *ddr)
 {
     int status;
     uint8_t temp = 0;
@@ -489,22 +467,9 @@ int dimm_spd_address_control(uint32_t *temp_reg, struct dimm_info *ddr)
     return FWK_SUCCESS;
 }
 
-int dimm_spd_format_control(uint32_t *temp_reg)
-{
-    uint32_t status;
-    uint8_t temp = 0;
-
-    temp = ddr4_dimm0.dram_param.mod_mem_bus_width;
-    status = get_dimm_memory_width(temp, temp_reg);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    return FWK_SUCCESS;
-}
-
-int dimm_spd_memory_type(uint32_t *temp_reg, struct dimm_info *ddr)
+static int spd_memory_type(uint32_t *temp_reg, struct dimm_info *ddr)
 {
-    uint32_t status;
+    int status;
     uint8_t temp = 0;
 
     temp = ddr4_dimm0.dram_param.kb_dram_type;
@@ -529,73 +494,57 @@ int dimm_spd_memory_type(uint32_t *temp_reg, struct dimm_info *ddr)
     return FWK_SUCCESS;
 }
 
-int dimm_spd_t_refi(uint32_t *temp_reg)
+static uint32_t spd_t_refi(void)
 {
-    float refi_tmp = t_refi/8;
-    uint32_t tmp_refi_now = 0;
-
-    *temp_reg &= ~T_REFI_NEXT_MASK;
-
-    tmp_refi_now = (uint32_t)(refi_tmp/dmc_clk_period);
-    *temp_reg = (T_REFI_NEXT_MASK & tmp_refi_now);
-
-    return FWK_SUCCESS;
+    /* Refresh interval in 8x refresh mode, in DMC clock cycles */
+    return T_REFI_NEXT_MASK & (((T_REFI_NS / 8) * dmc_clk_freq_mhz) / 1000);
 }
 
-int dimm_spd_t_rfc(uint32_t *temp_reg)
+static uint32_t spd_t_rfc(void)
 {
-    uint32_t status = FWK_SUCCESS;
+    uint32_t temp_reg = 0;
     uint32_t tmp_value = 0;
     uint32_t rfc_tmp = 0;
 
-    *temp_reg &= ~T_RFC_NEXT_MASK;
     rfc_tmp = (uint32_t)ddr4_dimm0.dram_param.trfc1min_msb;
 
     rfc_tmp = rfc_tmp << 8;
     rfc_tmp |= (uint32_t)ddr4_dimm0.dram_param.trfc1min_lsb;
 
     tmp_value = cal_dly_wth_rounding(rfc_tmp, 0);
-    *temp_reg |= (T_RFC_NEXT_MASK & tmp_value);
-    *temp_reg &= ~T_RFCFG_NEXT_MASK;
-    *temp_reg |= (T_RFCFG_NEXT_MASK & (tmp_value << 10));
-    *temp_reg &= ~T_RFCFC_NEXT_MASK;
+    temp_reg |= (T_RFC_NEXT_MASK & tmp_value);
+    temp_reg |= (T_RFCFG_NEXT_MASK & (tmp_value << 10));
 
     if (multi_rank == true) {
-        status = dimm_spd_t_refi(&tmp_value);
-        if (status != FWK_SUCCESS)
-            return status;
-
-        *temp_reg |= (T_RFCFC_NEXT_MASK &
-                     ((uint32_t)((float)tmp_value/t_refi) << 20));
+        /* Refresh interval cycles divided by the interval in seconds */
+        tmp_value = (uint32_t)(((uint64_t)spd_t_refi() * 1000000000) /
+                               T_REFI_NS);
+        temp_reg |= (T_RFCFC_NEXT_MASK & (tmp_value << 20));
     }
 
-    return FWK_SUCCESS;
+    return temp_reg;
 }
 
-int dimm_spd_t_rcd(uint32_t *temp_reg)
+static uint32_t spd_t_rcd(void)
 {
     uint8_t spd_tmp = 0;
     uint8_t spd_tmp2 = 0;
     uint32_t tmp_value = 0;
 
-    *temp_reg &= ~T_RCD_NEXT_MASK;
-
     spd_tmp = ddr4_dimm0.dram_param.trcdmin;
     spd_tmp2 = ddr4_dimm0.dram_param.trcdmin_fine;
 
     tmp_value = cal_dly_wth_rounding((int32_t)spd_tmp, (int32_t)spd_tmp2);
-    *temp_reg = T_RCD_NEXT_MASK & tmp_value;
 
-    return FWK_SUCCESS;
+    return T_RCD_NEXT_MASK & tmp_value;
 }
 
-int dimm_spd_t_ras(uint32_t *temp_reg)
+static uint32_t spd_t_ras(void)
 {
     uint8_t temp = 0;
     uint32_t tras_tmp = 0;
     uint32_t tmp_value = 0;
 
-    *temp_reg &= ~T_RAS_NEXT_MASK;
     tras_tmp = (uint32_t)ddr4_dimm0.dram_param.uppr_nbls_trasmin_trcmin;
 
     tras_tmp &= (uint32_t)LWR_NBBL_MASK;
@@ -605,61 +554,74 @@ int dimm_spd_t_ras(uint32_t *temp_reg)
     tras_tmp |= (uint32_t)temp;
 
     tmp_value = cal_dly_wth_rounding(tras_tmp, 0);
-    *temp_reg = (T_RAS_NEXT_MASK & tmp_value);
 
-    return FWK_SUCCESS;
+    return T_RAS_NEXT_MASK & tmp_value;
 }
 
-int dimm_spd_t_rp(uint32_t *temp_reg)
+static uint32_t spd_t_rp(void)
 {
     uint8_t spd_tmp = 0;
     uint8_t spd_tmp2 = 0;
     uint32_t tmp_value = 0;
 
-    *temp_reg &= ~T_RP_NEXT_MASK;
-
     spd_tmp = ddr4_dimm0.dram_param.trpmin;
     spd_tmp2 = ddr4_dimm0.dram_param.trpmin_fine;
 
     tmp_value = cal_dly_wth_rounding((int32_t)spd_tmp, (int32_t)spd_tmp2);
-    *temp_reg = T_RP_NEXT_MASK & tmp_value;
 
-    return FWK_SUCCESS;
+    return T_RP_NEXT_MASK & tmp_value;
 }
 
-int dimm_spd_t_rrd(uint32_t *temp_reg)
+static uint32_t spd_t_rrd(void)
 {
     uint8_t spd_tmp = 0;
     uint8_t spd_tmp2 = 0;
+    uint32_t temp_reg = 0;
     uint32_t tmp_value = 0;
 
-    *temp_reg &= ~T_RRD_S_NEXT_MASK;
-
     spd_tmp = ddr4_dimm0.dram_param.trrd_smin;
     spd_tmp2 = ddr4_dimm0.dram_param.trrd_smin_fine;
 
     tmp_value = cal_dly_wth_rounding((int32_t)spd_tmp, (int32_t)spd_tmp2);
-    *temp_reg = T_RRD_S_NEXT_MASK & tmp_value;
-    *temp_reg &= ~T_RRD_L_NEXT_MASK;
+    temp_reg = T_RRD_S_NEXT_MASK & tmp_value;
 
     spd_tmp = ddr4_dimm0.dram_param.trrd_lmin;
     spd_tmp2 = ddr4_dimm0.dram_param.trrd_lmin_fine;
 
-    tmp_value = 0;
     tmp_value = cal_dly_wth_rounding((int32_t)spd_tmp, (int32_t)spd_tmp2);
     tmp_value = tmp_value << 8;
 
-    *temp_reg |= (T_RRD_L_NEXT_MASK & tmp_value);
+    temp_reg |= (T_RRD_L_NEXT_MASK & tmp_value);
     tmp_value = 0x04000000;
-    *temp_reg |= (T_RRD_DLR_NEXT_MASK & tmp_value);
+    temp_reg |= (T_RRD_DLR_NEXT_MASK & tmp_value);
+
+    return temp_reg;
+}
+
+static int spd_cwl(struct dimm_info *ddr)
+{
+    switch (ddr->speed) {
+    case 800:
+        ddr->cwl_value = 9;
+        break;
+    case 1200:
+        ddr->cwl_value = 12;
+        break;
+    case 1333:
+        ddr->cwl_value = 14;
+        break;
+    default:
+        return FWK_E_PARAM;
+    }
 
     return FWK_SUCCESS;
 }
 
-int dimm_spd_t_wtr(uint32_t* temp_reg, struct dimm_info *ddr)
+static uint32_t spd_t_wtr(const struct dimm_info *ddr)
 {
     uint8_t spd_tmp1 = 0;
     uint8_t spd_temp = 0;
+    uint32_t temp_reg = 0;
     uint32_t twtr_tmp = 0;
     uint32_t tmp_value = 0;
     uint32_t bl_value = 8;
@@ -673,7 +635,7 @@ int dimm_spd_t_wtr(uint32_t* temp_reg, struct dimm_info *ddr)
 
     tmp_value = cal_dly_wth_rounding(twtr_tmp, 0);
     tmp_value = ddr->cwl_value + (bl_value/2) + tmp_value;
-    *temp_reg = (T_WTR_S_NEXT_MASK & tmp_value);
+    temp_reg = (T_WTR_S_NEXT_MASK & tmp_value);
 
     twtr_tmp = (uint32_t)(spd_temp & UPPR_NBBL_MASK);
     twtr_tmp = twtr_tmp << 4;
@@ -682,21 +644,19 @@ int dimm_spd_t_wtr(uint32_t* temp_reg, struct dimm_info *ddr)
     twtr_tmp |= (uint32_t)spd_tmp1;
     tmp_value = cal_dly_wth_rounding(twtr_tmp, 0);
     tmp_value = ddr->cwl_value + (bl_value/2) + tmp_value;
-    *temp_reg |= (T_WTR_L_NEXT_MASK & (tmp_value << 8));
-    *temp_reg |= (T_WTR_CS_NEXT_MASK & (tmp_value << 16));
+    temp_reg |= (T_WTR_L_NEXT_MASK & (tmp_value << 8));
+    temp_reg |= (T_WTR_CS_NEXT_MASK & (tmp_value << 16));
 
-    return FWK_SUCCESS;
+    return temp_reg;
 }
 
-int dimm_spd_t_act_window(uint32_t *temp_reg)
+static int spd_t_act_window(uint32_t *temp_reg)
 {
     uint8_t temp = 0;
     uint32_t tfawmin = 0;
     uint32_t tmp_value = 0;
     uint8_t tmp_mac = 0;
 
-    *temp_reg &= ~T_FAW_NEXT_MASK;
-
     tfawmin = (uint32_t)ddr4_dimm0.dram_param.tfawmin_msn;
     tfawmin &= (uint32_t)LWR_NBBL_MASK;
     tfawmin = tfawmin << 8;
@@ -705,7 +665,6 @@ int dimm_spd_t_act_window(uint32_t *temp_reg)
     tfawmin |= temp;
     tmp_value = cal_dly_wth_rounding(tfawmin, 0);
     *temp_reg = (T_FAW_NEXT_MASK & tmp_value);
-    *temp_reg &= ~T_FAW_DLR_NEXT_MASK;
     *temp_reg |= (T_FAW_DLR_NEXT_MASK & (tmp_value << 8));
 
     temp = ddr4_dimm0.dram_param.sdram_opt_features;
@@ -730,7 +689,7 @@ int dimm_spd_t_act_window(uint32_t *temp_reg)
     return FWK_SUCCESS;
 }
 
-int dimm_spd_calculate_dimm_size_gb(uint32_t *size_gb)
+static int spd_dimm_size_gb(uint32_t *size_gb)
 {
     uint64_t size;
     uint8_t temp;
@@ -773,3 +732,91 @@ int dimm_spd_calculate_dimm_size_gb(uint32_t *size_gb)
     *size_gb = size / FWK_GIB;
     return FWK_SUCCESS;
 }
+
+static uint32_t spd_serial_number(const struct ddr4_spd *spd)
+{
+    /* Module serial number, SPD bytes 325 to 328 */
+    return ((uint32_t)spd->mfg_info[5] << 24) |
+           ((uint32_t)spd->mfg_info[6] << 16) |
+           ((uint32_t)spd->mfg_info[7] << 8) |
+           (uint32_t)spd->mfg_info[8];
+}
+
+static int spd_parse(struct dimm_spd_timing *timing, struct dimm_info *ddr)
+{
+    int status;
+
+    memset(timing, 0, sizeof(*timing));
+
+    status = spd_address_control(&timing->address_control, ddr);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = get_dimm_memory_width(ddr4_dimm0.dram_param.mod_mem_bus_width,
+                                   &timing->format_control);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = spd_memory_type(&timing->memory_type, ddr);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = spd_cwl(ddr);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    timing->t_refi = spd_t_refi();
+    timing->t_rfc = spd_t_rfc();
+    timing->t_rcd = spd_t_rcd();
+    timing->t_ras = spd_t_ras();
+    timing->t_rp = spd_t_rp();
+    timing->t_rrd = spd_t_rrd();
+    timing->t_wtr = spd_t_wtr(ddr);
+
+    status = spd_t_act_window(&timing->t_act_window);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = spd_dimm_size_gb(&timing->dimm_size_gb);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    timing->dimm_serial[0] = spd_serial_number(&ddr4_dimm0);
+    timing->dimm_serial[1] = spd_serial_number(&ddr4_dimm1);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * APIs invoked by DMC-620 core functions
+ */
+int dimm_spd_init_check(struct mod_n1sdp_i2c_master_api *i2c_api,
+                         struct dimm_info *ddr)
+{
+    int status;
+
+    spd_read(i2c_api, DIMM0_SPD_SLAVE, (uint8_t *)&ddr4_dimm0);
+    spd_read(i2c_api, DIMM1_SPD_SLAVE, (uint8_t *)&ddr4_dimm1);
+
+    status = chk_ddr4_dimms(ddr->speed, &ddr4_dimm0, &ddr4_dimm1);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    dmc_clk_freq_mhz = ddr->speed;
+    dmc_clk_period_ps = (int32_t)(1000000 / ddr->speed);
+
+    return spd_parse(&spd_timing, ddr);
+}
+
+void dimm_spd_mem_info(struct mod_log_api *log_api)
+{
+    fwk_assert(log_api != NULL);
+
+    dimm_device_data((uint8_t *)&ddr4_dimm0, log_api, 0);
+    dimm_device_data((uint8_t *)&ddr4_dimm1, log_api, 1);
+}
+
+const struct dimm_spd_timing *dimm_spd_get_timing(void)
+{
+    return &spd_timing;
+}
@@ -198,7 +198,8 @@
 #define MAX_SPD_PAGE1        511
 
 #define SPD_W_TRANSFER_SIZE  2
-#define SPD_R_TRANSFER_SIZE  1
+/* SPD bytes read per I2C transfer, at most the depth of the I2C FIFO */
+#define SPD_R_TRANSFER_SIZE  16
 #define SPD_STOP             1
 
 
@@ -347,6 +348,30 @@ struct ddr4_spd {
   uint8_t end_usr[128];
 } __attribute__((packed));
 
+/*
+ * DMC-620 register values and DIMM parameters derived from the SPD data.
+ *
+ * The SPD data is parsed once into this descriptor, which only holds plain
+ * integers and is shared by all the DMC-620 instances.
+ */
+struct dimm_spd_timing {
+    uint32_t address_control;
+    uint32_t format_control;
+    uint32_t memory_type;
+    uint32_t t_refi;
+    uint32_t t_rfc;
+    uint32_t t_rcd;
+    uint32_t t_ras;
+    uint32_t t_rp;
+    uint32_t t_rrd;
+    uint32_t t_wtr;
+    uint32_t t_act_window;
+    /* Size of one DIMM in GiB */
+    uint32_t dimm_size_gb;
+    /* Module serial number of each DIMM */
+    uint32_t dimm_serial[2];
+};
+
 /*
  * SPD API function prototypes
  */
@@ -359,6 +384,8 @@ struct ddr4_spd {
  *
  * retval - FWK_SUCCESS - if the operation is succeeded
  *          FWK_E_DATA - if the SPD data is wrong
+ *          FWK_E_PARAM - if a value cannot be derived from the SPD data
+ *          FWK_E_DEVICE - if the DIMM size is invalid
  */
 int dimm_spd_init_check(struct mod_n1sdp_i2c_master_api *i2c_api,
                          struct dimm_info *ddr);
@@ -373,126 +400,11 @@ int dimm_spd_init_check(struct mod_n1sdp_i2c_master_api *i2c_api,
 void dimm_spd_mem_info(struct mod_log_api *log_api);
 
 /*
- * Brief - Function to calculate DMC-620 ADDRESS_CONTROL register value
- *
- * param - value - Pointer to variable where calculated value is saved
- * param - info - Pointer to DIMM information structure
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_address_control(uint32_t *value, struct dimm_info *info);
-
-/*
- * Brief - Function to calculate DMC-620 FORMAT_CONTROL register value
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_format_control(uint32_t *value);
-
-/*
- * Brief - Function to calculate DMC-620 MEMORY_TYPE register value
- *
- * param - value - Pointer to variable where calculated value is saved
- * param - info - Pointer to DIMM information structure
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_memory_type(uint32_t *value, struct dimm_info *info);
-
-/*
- * Brief - Function to calculate tREFI timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_refi(uint32_t *value);
-
-/*
- * Brief - Function to calculate tRFC timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_rfc(uint32_t *value);
-
-/*
- * Brief - Function to calculate tRCD timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_rcd(uint32_t *value);
-
-/*
- * Brief - Function to calculate tRAS timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_ras(uint32_t *value);
-
-/*
- * Brief - Function to calculate tRP timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_rp(uint32_t *value);
-
-/*
- * Brief - Function to calculate tRRD timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_rrd(uint32_t *value);
-
-/*
- * Brief - Function to calculate tWTR timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
- * param - info - Pointer to DIMM information structure
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_wtr(uint32_t *value, struct dimm_info *info);
-
-/*
- * Brief - Function to calculate tACT_WINDOW timing parameter
- *
- * param - value - Pointer to variable where calculated value is saved
+ * Brief - Function to get the descriptor parsed from the SPD data by
+ *         dimm_spd_init_check()
  *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DATA - if the value cannot be calculated
- */
-int dimm_spd_t_act_window(uint32_t *value);
-
-/*
- * Brief - Function to calculate total DIMM size
- *
- * param - size_gb - Pointer to variable where calculated value is saved
- *
- * retval - FWK_SUCCESS - if the operation is succeeded
- *          FWK_E_DEVICE - if the SPD value is invalid
+ * retval - Pointer to the descriptor
  */
-int dimm_spd_calculate_dimm_size_gb(uint32_t *size_gb);
+const struct dimm_spd_timing *dimm_spd_get_timing(void);
 
 #endif /* DIMM_SPD_H */
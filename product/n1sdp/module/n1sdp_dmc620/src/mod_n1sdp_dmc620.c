@@ -8,9 +8,11 @@
  *     N1SDP DMC-620 driver
  */
 
+#include <string.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_interrupt.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_notification.h>
@@ -35,6 +37,32 @@ static struct mod_timer_api *timer_api;
 static struct mod_n1sdp_i2c_master_api *i2c_api;
 static struct dimm_info ddr_info;
 
+/* Write eye training state of a DMC */
+struct dmc620_training {
+    /* The training is in progress */
+    bool pending;
+
+    /* Time of the next step of the training in microseconds */
+    uint64_t step_time;
+};
+
+/* Context of the configuration of the DMCs */
+struct dmc620_ctx {
+    /* Number of DMCs */
+    unsigned int dmc_count;
+
+    /* Number of DMCs configured since the last post initialization */
+    unsigned int config_count;
+
+    /* Status of the configuration of the DMCs */
+    int config_status;
+
+    /* Table of the write eye training state of the DMCs */
+    struct dmc620_training *training;
+};
+
+static struct dmc620_ctx dmc620_ctx;
+
 /*
  * DMC-620 interrupt handling functions
  */
@@ -47,7 +75,7 @@ void dmc620_abort_recover(struct mod_dmc620_reg *dmc)
     current_state = dmc->MEMC_STATUS & 0x00000007;
     /* Make sure we don't run this from ABORT or RECOVERY states */
     if (current_state > 3) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] DMC generated abortable error from abort/recovery state\n");
         return;
     }
@@ -56,48 +84,48 @@ void dmc620_abort_recover(struct mod_dmc620_reg *dmc)
     dmc_abort = (uint32_t *)((uint32_t)dmc + 0x10000);
 
     /* Assert abort request */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Asserting abort request\n");
     *dmc_abort = 0x1;
 
     /* Wait for DMC to enter aborted state */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Waiting for DMC to enter abort state...");
     while ((dmc->MEMC_STATUS & 0x00000007) != 0x4)
         continue;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "DONE\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "DONE\n");
 
     /* Deassert abort request */
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Deasserting abort request\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Deasserting abort request\n");
     *dmc_abort = 0x0;
 
     /* Send ABORT_CLR command to change to recovery mode. */
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Sending abort clear\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Sending abort clear\n");
     dmc->MEMC_CMD = 0x00000006;
 
     /* Wait for state transition to complete */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Waiting for DMC state transition...");
     while ((dmc->MEMC_STATUS & 0x00000007) != 0x5)
         continue;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "DONE\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "DONE\n");
 
     /* Go back to pre-error state */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Initiating state transition back to normal world\n");
     dmc->MEMC_CMD = current_state;
 
     /* Wait for state transition to complete */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Waiting for DMC state transition...");
     while ((dmc->MEMC_STATUS & 0x00000007) != current_state)
         continue;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "DONE\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "DONE\n");
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Resuming operation in state %d\n", current_state);
 }
 
@@ -116,7 +144,7 @@ void dmc620_handle_interrupt(int dmc_num)
 
 void dmc0_misc_oflow_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 MISC overflow interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_MISC_OFLOW_IRQ);
@@ -124,7 +152,7 @@ void dmc0_misc_oflow_handler(void)
 
 void dmc0_err_oflow_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 error overflow interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_ERR_OFLOW_IRQ);
@@ -132,7 +160,7 @@ void dmc0_err_oflow_handler(void)
 
 void dmc0_ecc_err_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 ECC error interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_ECC_ERR_INT_IRQ);
@@ -140,7 +168,7 @@ void dmc0_ecc_err_handler(void)
 
 void dmc0_misc_access_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 misc access interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_MISC_ACCESS_INT_IRQ);
@@ -148,7 +176,7 @@ void dmc0_misc_access_handler(void)
 
 void dmc0_temp_event_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 temperature event interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_TEMPERATURE_EVENT_INT_IRQ);
@@ -156,7 +184,7 @@ void dmc0_temp_event_handler(void)
 
 void dmc0_failed_access_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 failed access interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_FAILED_ACCESS_INT_IRQ);
@@ -164,7 +192,7 @@ void dmc0_failed_access_handler(void)
 
 void dmc0_mgr_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC0 mgr interrupt!\n");
     dmc620_handle_interrupt(0);
     fwk_interrupt_clear_pending(DMCS0_MGR_INT_IRQ);
@@ -172,7 +200,7 @@ void dmc0_mgr_handler(void)
 
 void dmc1_misc_oflow_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 MISC overflow interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_MISC_OFLOW_IRQ);
@@ -180,7 +208,7 @@ void dmc1_misc_oflow_handler(void)
 
 void dmc1_err_oflow_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 error overflow interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_ERR_OFLOW_IRQ);
@@ -188,7 +216,7 @@ void dmc1_err_oflow_handler(void)
 
 void dmc1_ecc_err_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 ECC error interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_ECC_ERR_INT_IRQ);
@@ -196,7 +224,7 @@ void dmc1_ecc_err_handler(void)
 
 void dmc1_misc_access_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 misc access interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_MISC_ACCESS_INT_IRQ);
@@ -204,7 +232,7 @@ void dmc1_misc_access_handler(void)
 
 void dmc1_temp_event_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 temperature event interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_TEMPERATURE_EVENT_INT_IRQ);
@@ -212,7 +240,7 @@ void dmc1_temp_event_handler(void)
 
 void dmc1_failed_access_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 failed access interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_FAILED_ACCESS_INT_IRQ);
@@ -220,7 +248,7 @@ void dmc1_failed_access_handler(void)
 
 void dmc1_mgr_handler(void)
 {
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] DMC1 mgr interrupt!\n");
     dmc620_handle_interrupt(1);
     fwk_interrupt_clear_pending(DMCS1_MGR_INT_IRQ);
@@ -231,7 +259,7 @@ static int dmc620_config_interrupt(fwk_id_t ddr_id)
     int id;
 
     id = fwk_id_get_element_idx(ddr_id);
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Configuring interrupts for DMC%d\n", id);
 
     if (id == 0) {
@@ -327,7 +355,7 @@ static int ddr_poll_training_status(struct mod_dmc620_reg *dmc)
                              dmc620_wait_condition,
                              &wait_data);
     if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO, "FAIL\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "FAIL\n");
         return status;
     }
 
@@ -337,11 +365,11 @@ static int ddr_poll_training_status(struct mod_dmc620_reg *dmc)
                              dmc620_wait_condition,
                              &wait_data);
     if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO, "FAIL\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "FAIL\n");
         return status;
     }
 
-    log_api->log(MOD_LOG_GROUP_INFO, "PASS\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "PASS\n");
 
     return FWK_SUCCESS;
 }
@@ -366,10 +394,10 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
     int j;
     int status;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Training DDR memories...\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Training DDR memories...\n");
 
     for (i = 1; i <= ddr_info.number_of_ranks; i++) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] Write leveling rank %d... ", i);
 
         /* Clear interrupt status if any */
@@ -395,12 +423,12 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
     ddr_phy_api->verify_phy_status(ddr_id, DDR_ADDR_TRAIN_TYPE_WR_LVL, info);
 
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Read gate training\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Read gate training\n");
     /* Clear interrupt status if any */
     if (dmc->INTERRUPT_STATUS != 0)
         dmc->INTERRUPT_CLR = 0xFFFFFFFF;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] A side...");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] A side...");
 
     /* Set read level control parameter */
     value = dmc->RDLVL_CONTROL_NEXT;
@@ -428,7 +456,7 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
         dmc->INTERRUPT_CLR = 0xFFFFFFFF;
 
 #if DDR_TRAIN_TWO_RANKS
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] B side...");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] B side...");
 
     /* Set write leveling parameters */
     value = dmc->RDLVL_CONTROL_NEXT;
@@ -451,13 +479,13 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
     for (j = 1; j <= ddr_info.number_of_ranks; j++)
         ddr_phy_api->read_gate_phy_obs_regs(ddr_id, j, info);
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Read eye training\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Read eye training\n");
 
     /* Clear interrupt status if any */
     if (dmc->INTERRUPT_STATUS != 0)
         dmc->INTERRUPT_CLR = 0xFFFFFFFF;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] A side...");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] A side...");
 
     /* Set write leveling parameters */
     value = dmc->RDLVL_CONTROL_NEXT;
@@ -484,7 +512,7 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
     if (dmc->INTERRUPT_STATUS != 0)
         dmc->INTERRUPT_CLR = 0xFFFFFFFF;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] B side...");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] B side...");
 
     /* Set write leveling parameters */
     value = dmc->RDLVL_CONTROL_NEXT;
@@ -510,7 +538,7 @@ static int ddr_training(struct mod_dmc620_reg *dmc,
     if (dmc->INTERRUPT_STATUS != 0)
         dmc->INTERRUPT_CLR = 0xFFFFFFFF;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] MC initiated update...");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] MC initiated update...");
 
     dmc->DIRECT_ADDR = 0;
     dmc->DIRECT_CMD  = ((ddr_info.ranks_to_train << 16) | 0x000A);
@@ -577,7 +605,7 @@ static void execute_ddr_cmd(struct mod_dmc620_reg *dmc,
 
     status = dmc620_poll_dmc_status(dmc);
     if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] Execute command failed! ADDR: 0x%08x CMD: 0x%08x\n",
             addr, cmd);
     }
@@ -757,15 +785,12 @@ static int direct_ddr_cmd(struct mod_dmc620_reg *dmc)
     switch (ddr_info.speed) {
     case 800:
         addr = 0x00000800;
-        ddr_info.cwl_value = 9;
         break;
     case 1200:
         addr = 0x00000818;
-        ddr_info.cwl_value = 12;
         break;
     case 1333:
         addr = 0x00000820;
-        ddr_info.cwl_value = 14;
         break;
     default:
         fwk_assert(false);
@@ -797,15 +822,7 @@ static int direct_ddr_cmd(struct mod_dmc620_reg *dmc)
     execute_ddr_cmd(dmc, addr,
                     ((ddr_info.ranks_to_train << 16) | 0x0001), 0);
 
-    addr = 0;
-    status = dimm_spd_t_wtr(&addr, &ddr_info);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_WTR value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_WTR_NEXT = addr;
+    dmc->T_WTR_NEXT = dimm_spd_get_timing()->t_wtr;
 
     for (count = 0; count < 12; count++)
         execute_ddr_cmd(dmc, 0x00000200, 0x0001000D, 0);
@@ -831,15 +848,15 @@ static int dmc620_pre_init(void)
 {
     int status;
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Starting DDR subsystem initialization at %d MHz\n",
         ddr_info.speed);
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Identifying connected DIMM cards...\n");
     status = dimm_spd_init_check(i2c_api, &ddr_info);
     if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] Error checking DIMM SPD data: %d\n", status);
         return status;
     }
@@ -864,12 +881,12 @@ static int dmc620_post_init(void)
         id = FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_DMC620, i);
         element_config = fwk_module_get_data(id);
 
-        log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
             "[DDR] Verifying PHY status for DMC %d...", i);
         status = dmc620_verify_phy_status(element_config->ddr_id);
         if (status != FWK_SUCCESS)
             return status;
-        log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "Done\n");
     }
 
     for (i = 0; i < count; i++) {
@@ -882,11 +899,105 @@ static int dmc620_post_init(void)
     return FWK_SUCCESS;
 }
 
-static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
+/*
+ * Training cache functions
+ */
+
+static uint32_t training_cache_checksum(
+    const struct mod_dmc620_training_cache *cache)
+{
+    const uint32_t *word = &cache->speed;
+    const uint32_t *end = (const uint32_t *)(cache + 1);
+    uint32_t checksum = 0;
+
+    while (word < end)
+        checksum += *word++;
+
+    return checksum;
+}
+
+/* Fill the header of a training cache for the current DIMMs and speed */
+static void training_cache_header(struct mod_dmc620_training_cache *cache)
+{
+    const struct dimm_spd_timing *timing = dimm_spd_get_timing();
+
+    cache->signature = MOD_DMC620_TRAINING_CACHE_SIGNATURE;
+    cache->speed = ddr_info.speed;
+    memcpy(cache->dimm_serial, timing->dimm_serial,
+           sizeof(cache->dimm_serial));
+}
+
+/*
+ * Provide the cached write eye training result of a DMC to its PHY when it
+ * was trained for the current DIMMs and speed. The PHY verifies the result
+ * and trains again if the verification fails.
+ */
+static void training_cache_restore(
+    const struct mod_dmc620_element_config *element_config)
+{
+    int status;
+    struct mod_dmc620_training_cache header;
+    const struct mod_dmc620_training_cache *cache =
+        element_config->training_cache;
+
+    if (cache == NULL)
+        return;
+
+    training_cache_header(&header);
+
+    if ((cache->signature != header.signature) ||
+        (cache->speed != header.speed) ||
+        (memcmp(cache->dimm_serial, header.dimm_serial,
+                sizeof(header.dimm_serial)) != 0) ||
+        (cache->checksum != training_cache_checksum(cache)))
+        return;
+
+    status = ddr_phy_api->set_wet_result(element_config->ddr_id,
+                                         &cache->wet_result);
+    if (status == FWK_SUCCESS) {
+        MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+            "[DDR] Restoring cached write eye training\n");
+    }
+}
+
+/*
+ * Save the write eye training result of a DMC. The cache is only written when
+ * the result differs from the cached one.
+ */
+static void training_cache_store(
+    const struct mod_dmc620_element_config *element_config)
+{
+    int status;
+    struct mod_dmc620_training_cache record;
+    struct mod_dmc620_training_cache *cache = element_config->training_cache;
+
+    if (cache == NULL)
+        return;
+
+    memset(&record, 0, sizeof(record));
+
+    training_cache_header(&record);
+
+    status = ddr_phy_api->get_wet_result(element_config->ddr_id,
+                                         &record.wet_result);
+    if (status != FWK_SUCCESS)
+        return;
+
+    record.checksum = training_cache_checksum(&record);
+
+    if (memcmp(cache, &record, sizeof(record)) != 0)
+        *cache = record;
+}
+
+static int dmc620_config_ready(struct mod_dmc620_reg *dmc);
+
+static int dmc620_config(struct mod_dmc620_reg *dmc,
+    const struct mod_dmc620_element_config *element_config)
 {
     int status;
     int dmc_id;
-    uint32_t value;
+    fwk_id_t ddr_id = element_config->ddr_id;
+    const struct dimm_spd_timing *timing;
 
     dmc_id = fwk_id_get_element_idx(ddr_id);
     if (dmc_id == 0) {
@@ -895,33 +1006,19 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
             return status;
     }
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    timing = dimm_spd_get_timing();
+
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Initialising DMC620 at 0x%x\n", (uintptr_t)dmc);
 
     dmc620_config_interrupt(ddr_id);
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Writing functional settings\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] Writing functional settings\n");
 
-    value = 0;
-    status = dimm_spd_address_control(&value, &ddr_info);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting address control value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->ADDRESS_CONTROL_NEXT = value | DMC_ADDR_CTLR_BANK_HASH_ENABLE;
+    dmc->ADDRESS_CONTROL_NEXT = timing->address_control |
+                                DMC_ADDR_CTLR_BANK_HASH_ENABLE;
     dmc->DECODE_CONTROL_NEXT = 0x00142C10;
-
-    value = 0;
-    status = dimm_spd_format_control(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting format control value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->FORMAT_CONTROL = value;
+    dmc->FORMAT_CONTROL = timing->format_control;
     dmc->ADDRESS_MAP_NEXT = 0x00000003;
     dmc->ADDRESS_SHUTTER_31_00_NEXT = 0x11111110;
     dmc->ADDRESS_SHUTTER_63_32_NEXT = 0x11111111;
@@ -943,90 +1040,18 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     dmc->DCI_REPLAY_TYPE_NEXT = 0x00000000;
     dmc->DIRECT_CONTROL_NEXT = 0x00000000;
     dmc->DCI_STRB = 0x00000000;
-
-    value = 0;
-    status = dimm_spd_memory_type(&value, &ddr_info);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting memory type value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->MEMORY_TYPE_NEXT = value;
+    dmc->MEMORY_TYPE_NEXT = timing->memory_type;
     dmc->FEATURE_CONFIG = 0x00001820;
-
-    value = 0;
-    status = dimm_spd_t_refi(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_REFI value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_REFI_NEXT = value;
-
-    value = 0;
-    status = dimm_spd_t_rfc(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_RFC value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_RFC_NEXT = value;
+    dmc->T_REFI_NEXT = timing->t_refi;
+    dmc->T_RFC_NEXT = timing->t_rfc;
     dmc->T_MRR_NEXT = 0x00000001;
     dmc->T_MRW_NEXT = 0x00080030;
-
-    value = 0;
-    status = dimm_spd_t_rcd(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_RCD value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_RCD_NEXT = value;
-
-    value = 0;
-    status = dimm_spd_t_ras(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_RAS value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_RAS_NEXT = value;
-
-    value = 0;
-    status = dimm_spd_t_rp(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_RP value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_RP_NEXT = value;
+    dmc->T_RCD_NEXT = timing->t_rcd;
+    dmc->T_RAS_NEXT = timing->t_ras;
+    dmc->T_RP_NEXT = timing->t_rp;
     dmc->T_RPALL_NEXT = 0x00000013;
-
-    value = 0;
-    status = dimm_spd_t_rrd(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_RRD value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_RRD_NEXT = value;
-
-    value = 0;
-    status = dimm_spd_t_act_window(&value);
-    if (status != FWK_SUCCESS) {
-        log_api->log(MOD_LOG_GROUP_INFO,
-            "[DDR] Error code %d getting t_ACT_WINDOW value from SPD\n",
-            status);
-        return status;
-    }
-    dmc->T_ACT_WINDOW_NEXT = value;
+    dmc->T_RRD_NEXT = timing->t_rrd;
+    dmc->T_ACT_WINDOW_NEXT = timing->t_act_window;
 
     if ((ddr_info.speed == 1333) || (ddr_info.speed == 1200))
         dmc->T_RTR_NEXT = 0x24090805;
@@ -1156,7 +1181,7 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
            MOD_DMC620_MEMC_CMD_CONFIG)
         continue;
 
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Sending direct DDR commands\n");
 
     status = direct_ddr_cmd(dmc);
@@ -1167,17 +1192,31 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     if (status != FWK_SUCCESS)
         return status;
 
+    training_cache_restore(element_config);
+
+    /*
+     * When a write eye training is required, it is run once all the DMCs have
+     * been configured, in parallel on all the DMCs.
+     */
     status = ddr_phy_api->post_training_configure(ddr_id, &ddr_info);
     if (status != FWK_SUCCESS)
         return status;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] Enable DIMM refresh...");
+    return dmc620_config_ready(dmc);
+}
+
+static int dmc620_config_ready(struct mod_dmc620_reg *dmc)
+{
+    int status;
+
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
+        "[DDR] Enable DIMM refresh for DMC620 at 0x%x...", (uintptr_t)dmc);
     status = enable_dimm_refresh(dmc);
     if (status != FWK_SUCCESS)
         return status;
 
     /* Switch to READY */
-    log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO,
         "[DDR] Setting DMC to READY mode\n");
 
     dmc->MEMC_CMD = MOD_DMC620_MEMC_CMD_GO;
@@ -1185,32 +1224,93 @@ static int dmc620_config(struct mod_dmc620_reg *dmc, fwk_id_t ddr_id)
     while ((dmc->MEMC_STATUS & MOD_DMC620_MEMC_CMD) != MOD_DMC620_MEMC_CMD_GO)
         continue;
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[DDR] DMC init done.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[DDR] DMC init done.\n");
+
+    return FWK_SUCCESS;
+}
 
-    if (dmc_id == 1) {
-        status = dmc620_post_init();
+/*
+ * Run the write eye training of the DMCs waiting for it. A step of the training
+ * of a DMC is run as soon as its PHY has settled, and the SCP sleeps while all
+ * the PHYs are settling.
+ */
+static int dmc620_train(void)
+{
+    int status;
+    int training_status = FWK_SUCCESS;
+    unsigned int dmc_idx;
+    bool training;
+    uint32_t wait_us;
+    uint64_t now;
+    uint64_t next_step_time;
+    struct dmc620_training *training_ctx;
+    fwk_id_t timer_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0);
+    const struct mod_dmc620_element_config *element_config;
+
+    do {
+        training = false;
+        next_step_time = UINT64_MAX;
+
+        for (dmc_idx = 0; dmc_idx < dmc620_ctx.dmc_count; dmc_idx++) {
+            training_ctx = &dmc620_ctx.training[dmc_idx];
+            if (!training_ctx->pending)
+                continue;
+
+            status = timer_api->get_time(timer_id, &now);
+            if (status != FWK_SUCCESS)
+                return status;
+
+            if (training_ctx->step_time <= now) {
+                element_config = fwk_module_get_data(
+                    FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_DMC620, dmc_idx));
+
+                status = ddr_phy_api->post_training_step(
+                    element_config->ddr_id, &wait_us);
+                if (status == FWK_PENDING)
+                    training_ctx->step_time = now + wait_us;
+                else {
+                    training_ctx->pending = false;
+                    if (status == FWK_SUCCESS) {
+                        training_cache_store(element_config);
+                        status = dmc620_config_ready(
+                            (struct mod_dmc620_reg *)element_config->dmc);
+                    }
+                    if (status != FWK_SUCCESS)
+                        training_status = status;
+                    continue;
+                }
+            }
+
+            training = true;
+            if (training_ctx->step_time < next_step_time)
+                next_step_time = training_ctx->step_time;
+        }
+
+        if (!training)
+            break;
+
+        status = timer_api->get_time(timer_id, &now);
         if (status != FWK_SUCCESS)
             return status;
-    }
 
-    return FWK_SUCCESS;
+        if (next_step_time > now) {
+            status = timer_api->delay_sleep(timer_id,
+                                            (uint32_t)(next_step_time - now));
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+    } while (true);
+
+    return training_status;
 }
 
 /* Memory Information API */
 
 static int dmc620_get_mem_size_gb(uint32_t *size)
 {
-    uint32_t size_gb;
-    int status;
-
     fwk_assert(size != NULL);
 
-    size_gb = 0;
-    status = dimm_spd_calculate_dimm_size_gb(&size_gb);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    *size = size_gb * 2;
+    *size = dimm_spd_get_timing()->dimm_size_gb * 2;
     return FWK_SUCCESS;
 }
 
@@ -1227,6 +1327,13 @@ static int mod_dmc620_init(fwk_id_t module_id, unsigned int element_count,
         (struct mod_dmc620_module_config *)config;
 
     ddr_info.speed = mod_config->ddr_speed;
+
+    dmc620_ctx.dmc_count = element_count;
+    dmc620_ctx.training = fwk_mm_calloc(element_count,
+        sizeof(dmc620_ctx.training[0]));
+    if (dmc620_ctx.training == NULL)
+        return FWK_E_NOMEM;
+
     return FWK_SUCCESS;
 }
 
@@ -1314,13 +1421,38 @@ static int mod_dmc620_start(fwk_id_t id)
 
 static int dmc620_notify_system_state_transition_resume(fwk_id_t id)
 {
+    int status;
     struct mod_dmc620_reg *dmc;
+    struct dmc620_training *training_ctx;
     const struct mod_dmc620_element_config *element_config;
 
     element_config = fwk_module_get_data(id);
     dmc = (struct mod_dmc620_reg *)element_config->dmc;
 
-    return dmc620_config(dmc, element_config->ddr_id);
+    status = dmc620_config(dmc, element_config);
+    if (status == FWK_PENDING) {
+        training_ctx = &dmc620_ctx.training[fwk_id_get_element_idx(id)];
+        training_ctx->pending = true;
+        training_ctx->step_time = 0;
+        status = FWK_SUCCESS;
+    } else if (status != FWK_SUCCESS)
+        dmc620_ctx.config_status = status;
+
+    /* Wait for all the DMCs to be configured to train them together */
+    if (++dmc620_ctx.config_count < dmc620_ctx.dmc_count)
+        return status;
+
+    status = dmc620_train();
+    if (status != FWK_SUCCESS)
+        dmc620_ctx.config_status = status;
+
+    status = dmc620_ctx.config_status;
+    dmc620_ctx.config_count = 0;
+    dmc620_ctx.config_status = FWK_SUCCESS;
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return dmc620_post_init();
 }
 
 static int mod_dmc620_process_notification(
@@ -200,6 +200,27 @@ struct mod_n1sdp_flash_api {
     int (*get_n1sdp_fip_descriptor_table)(
         fwk_id_t id,
         struct mod_n1sdp_fip_descriptor **table);
+
+    /*!
+     * \brief Get the descriptor of the NFIP entry of a given type.
+     *
+     * \details The descriptor is looked up in an index built once when the
+     *      NFIP is parsed. When the NFIP holds several entries of the type,
+     *      the first one is returned.
+     *
+     * \param id Module identifier.
+     * \param type The NFIP entry type.
+     * \param[out] descriptor The NFIP descriptor.
+     *
+     * \retval FWK_SUCCESS Operation succeeded.
+     * \retval FWK_E_PARAM The \p type or \p descriptor parameter was invalid.
+     * \retval FWK_E_DATA The NFIP has no entry of the type.
+     * \return One of the other specific error codes described by framework.
+     */
+    int (*get_n1sdp_fip_descriptor)(
+        fwk_id_t id,
+        enum mod_n1sdp_fip_data_type type,
+        struct mod_n1sdp_fip_descriptor **descriptor);
 };
 
 /*!
@@ -206,4 +206,7 @@ struct i2c_reg {
 
 #define I2C_TSR_TANSFER_SIZE 0xF
 
+/* Depth of the data FIFO in bytes */
+#define I2C_FIFO_DEPTH   16
+
 #endif /* N1SDP_I2C_H */
@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <fwk_id.h>
 #include <fwk_macros.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \addtogroup GroupN1SDPModule N1SDP Product Modules
@@ -37,6 +38,26 @@
  */
 #define MOD_N1SDP_I2C_API_ID  FWK_ID_API_INIT(FWK_MODULE_IDX_N1SDP_I2C, 0)
 
+/*!
+ * \brief Event indices.
+ */
+enum mod_n1sdp_i2c_event_idx {
+    /*! Batch of asynchronous transfers */
+    MOD_N1SDP_I2C_EVENT_IDX_TRANSFER,
+
+    /*! Number of defined events */
+    MOD_N1SDP_I2C_EVENT_IDX_COUNT,
+};
+
+/*!
+ * \brief Identifier of the asynchronous transfer event.
+ *
+ * \details The completion of a batch of asynchronous transfers is reported by
+ *      a response to this event.
+ */
+static const fwk_id_t mod_n1sdp_i2c_event_id_transfer = FWK_ID_EVENT_INIT(
+    FWK_MODULE_IDX_N1SDP_I2C, MOD_N1SDP_I2C_EVENT_IDX_TRANSFER);
+
 /*!
  * \brief I2C Speed.
  */
@@ -105,6 +126,45 @@ struct mod_n1sdp_i2c_device_config {
 
     /*! Slave address */
     uint16_t slave_addr;
+
+    /*!
+     * \brief Interrupt number of the device.
+     *
+     * \details FWK_INTERRUPT_NONE if the device is only used through the
+     *      polled read and write functions.
+     */
+    unsigned int irq;
+};
+
+/*!
+ * \brief I2C transfer, part of a batch of asynchronous transfers.
+ */
+struct mod_n1sdp_i2c_transfer {
+    /*! Address of the slave */
+    uint16_t address;
+
+    /*! Pointer to the data buffer, written to for a read */
+    char *data;
+
+    /*! Data size to be transferred in bytes */
+    uint16_t length;
+
+    /*! Direction of the transfer, true for a read */
+    bool read;
+
+    /*!
+     * \brief When set to true for a write, indicates end of data transfer and
+     *      interface releases the sclk line. A read always releases it.
+     */
+    bool stop;
+};
+
+/*!
+ * \brief Parameters of the response to the asynchronous transfer event.
+ */
+struct mod_n1sdp_i2c_event_params {
+    /*! Status of the batch of transfers */
+    int status;
 };
 
 /*!
@@ -140,6 +200,32 @@ struct mod_n1sdp_i2c_master_api {
      */
     int (*write)(fwk_id_t device_id, uint16_t address, const char *data,
                  uint16_t length, bool stop);
+
+    /*!
+     * \brief Perform a batch of I2C transfers asynchronously.
+     *
+     * \details The transfers are performed in order and under interrupt
+     *      control, they may target different slaves. The completion of the
+     *      batch, or its abortion on the first failed transfer, is reported by
+     *      a response to the ::mod_n1sdp_i2c_event_id_transfer event with
+     *      ::mod_n1sdp_i2c_event_params parameters.
+     *
+     * \note The transfer table and the data buffers must remain valid until
+     *      the completion of the batch.
+     *
+     * \param device_id Element identifier.
+     * \param transfer_table Table of transfers.
+     * \param transfer_count Number of transfers in the table.
+     *
+     * \retval FWK_SUCCESS The batch has been accepted.
+     * \retval FWK_E_PARAM An invalid parameter was encountered.
+     * \retval FWK_E_SUPPORT The device has no interrupt.
+     * \retval FWK_E_BUSY A batch is already in progress on the device.
+     * \return One of the other specific error codes described by the framework.
+     */
+    int (*transfer_async)(fwk_id_t device_id,
+                          const struct mod_n1sdp_i2c_transfer *transfer_table,
+                          unsigned int transfer_count);
 };
 
 /*!
@@ -10,8 +10,12 @@
 
 #include <fwk_assert.h>
 #include <fwk_errno.h>
+#include <fwk_event.h>
+#include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_thread.h>
 #include <internal/n1sdp_i2c.h>
 #include <mod_log.h>
 #include <mod_n1sdp_i2c.h>
@@ -39,8 +43,37 @@
 /* Read a register field. */
 #define I2C_REG_R(reg, mask, shift)        (((reg) & (mask)) >> (shift))
 
+/* Interrupts reporting the failure of a transfer */
+#define I2C_ISR_ERROR_MASK      (I2C_ISR_ARBLOST_MASK | I2C_ISR_RXUNF_MASK | \
+                                 I2C_ISR_TXOVF_MASK | I2C_ISR_RXOVF_MASK | \
+                                 I2C_ISR_TO_MASK | I2C_ISR_NACK_MASK)
+
+/* Interrupts used by the asynchronous transfers */
+#define I2C_ISR_ASYNC_MASK      (I2C_ISR_ERROR_MASK | I2C_ISR_DATA_MASK | \
+                                 I2C_ISR_COMP_MASK)
+
+/* Internal events */
+enum n1sdp_i2c_internal_event_idx {
+    N1SDP_I2C_INTERNAL_EVENT_IDX_TRANSFER_COMPLETED =
+        MOD_N1SDP_I2C_EVENT_IDX_COUNT,
+    N1SDP_I2C_INTERNAL_EVENT_IDX_COUNT,
+};
+
+static const fwk_id_t n1sdp_i2c_event_id_transfer_completed =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_N1SDP_I2C,
+                      N1SDP_I2C_INTERNAL_EVENT_IDX_TRANSFER_COMPLETED);
+
+/* Parameters of the asynchronous transfer event */
+struct n1sdp_i2c_transfer_event_params {
+    const struct mod_n1sdp_i2c_transfer *transfer_table;
+    unsigned int transfer_count;
+};
+
 /* Device context */
 struct n1sdp_i2c_dev_ctx {
+    /* Identifier of the device */
+    fwk_id_t id;
+
     /* Pointer to the device configuration */
     const struct mod_n1sdp_i2c_device_config *config;
 
@@ -49,6 +82,26 @@ struct n1sdp_i2c_dev_ctx {
 
     /* Track repeated transfer of data */
     bool perform_repeat_start;
+
+    /* Batch of asynchronous transfers accepted and not completed yet */
+    bool busy;
+
+    /* Batch of asynchronous transfers in progress */
+    const struct mod_n1sdp_i2c_transfer *transfer_table;
+    unsigned int transfer_count;
+    unsigned int transfer_idx;
+
+    /* Position in the data buffer of the transfer in progress */
+    char *data;
+
+    /* Number of bytes of the transfer in progress left to transfer */
+    uint16_t remaining_length;
+
+    /* Number of bytes of the read chunk in progress left to receive */
+    uint16_t chunk_length;
+
+    /* Cookie of the transfer event waiting for the batch completion */
+    uint32_t cookie;
 };
 
 /* Module context */
@@ -70,6 +123,196 @@ static void clear_isr(struct n1sdp_i2c_dev_ctx *device_ctx)
     I2C_REG_W(device_ctx->reg->ISR, I2C_ISR_MASK, I2C_ISR_SHIFT, reg);
 }
 
+/*
+ * Asynchronous transfers, driven by the device interrupt
+ */
+static void write_fifo(struct n1sdp_i2c_dev_ctx *device_ctx,
+                       unsigned int count)
+{
+    if (count > device_ctx->remaining_length)
+        count = device_ctx->remaining_length;
+
+    device_ctx->remaining_length -= count;
+
+    while (count-- > 0)
+        I2C_REG_RMW(device_ctx->reg->DR, I2C_DR_DATA_MASK, I2C_DR_DATA_SHIFT,
+                    *device_ctx->data++);
+}
+
+static void read_fifo(struct n1sdp_i2c_dev_ctx *device_ctx)
+{
+    while ((device_ctx->chunk_length != 0) &&
+           I2C_REG_R(device_ctx->reg->SR, I2C_SR_RXDV_MASK,
+                     I2C_SR_RXDV_SHIFT)) {
+        *device_ctx->data++ = I2C_REG_R(device_ctx->reg->DR, I2C_DR_DATA_MASK,
+                                        I2C_DR_DATA_SHIFT);
+        device_ctx->chunk_length--;
+        device_ctx->remaining_length--;
+    }
+}
+
+/*
+ * Reads are split in chunks that fit in the transfer size register, each chunk
+ * is started by writing the address of the slave.
+ */
+static void start_read_chunk(struct n1sdp_i2c_dev_ctx *device_ctx,
+                             uint16_t address)
+{
+    device_ctx->chunk_length = device_ctx->remaining_length;
+    if (device_ctx->chunk_length > I2C_TSR_TANSFER_SIZE)
+        device_ctx->chunk_length = I2C_TSR_TANSFER_SIZE;
+
+    I2C_REG_RMW(device_ctx->reg->TSR, I2C_TSR_SIZE_MASK, I2C_TSR_SIZE_SHIFT,
+                device_ctx->chunk_length);
+
+    I2C_REG_RMW(device_ctx->reg->AR, I2C_AR_ADD7_MASK, I2C_AR_ADD7_SHIFT,
+                address);
+}
+
+static void start_async_transfer(struct n1sdp_i2c_dev_ctx *device_ctx)
+{
+    unsigned int count = I2C_FIFO_DEPTH;
+    const struct mod_n1sdp_i2c_transfer *transfer =
+        &device_ctx->transfer_table[device_ctx->transfer_idx];
+
+    device_ctx->data = transfer->data;
+    device_ctx->remaining_length = transfer->length;
+
+    I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_HOLD_MASK, I2C_CR_HOLD_SHIFT,
+                I2C_HOLD_ON);
+
+    if (transfer->read) {
+        I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_RW_MASK, I2C_CR_RW_SHIFT,
+                    I2C_RW_READ);
+
+        if (!device_ctx->perform_repeat_start)
+            I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_CLRFIFO_MASK,
+                        I2C_CR_CLRFIFO_SHIFT, I2C_CLRFIFO_ON);
+
+        clear_isr(device_ctx);
+
+        start_read_chunk(device_ctx, transfer->address);
+
+        return;
+    }
+
+    I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_RW_MASK, I2C_CR_RW_SHIFT,
+                I2C_RW_WRITE);
+
+    clear_isr(device_ctx);
+
+    I2C_REG_RMW(device_ctx->reg->TSR, I2C_TSR_SIZE_MASK, I2C_TSR_SIZE_SHIFT,
+                transfer->length);
+
+    /*
+     * Preload the FIFO with a single data byte unless this write is to
+     * generate a repeat start, as in the polled write.
+     */
+    if (!device_ctx->perform_repeat_start) {
+        write_fifo(device_ctx, 1);
+        count--;
+    }
+
+    /* Write the address, triggering the start of the transfer */
+    I2C_REG_RMW(device_ctx->reg->AR, I2C_AR_ADD7_MASK, I2C_AR_ADD7_SHIFT,
+                transfer->address);
+
+    /* The rest of the data is written when the FIFO drains */
+    write_fifo(device_ctx, count);
+}
+
+static void end_async_transfer(struct n1sdp_i2c_dev_ctx *device_ctx, bool stop)
+{
+    if (stop) {
+        /* Clear the hold bit to signify the end of the sequence */
+        I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_HOLD_MASK, I2C_CR_HOLD_SHIFT,
+                    I2C_HOLD_OFF);
+        device_ctx->perform_repeat_start = false;
+    } else
+        device_ctx->perform_repeat_start = true;
+
+    clear_isr(device_ctx);
+}
+
+/*
+ * Stop the batch of transfers and report its completion to the thread, the
+ * client is responded to from the event handler.
+ */
+static void complete_batch(struct n1sdp_i2c_dev_ctx *device_ctx, int status)
+{
+    struct fwk_event event;
+    struct mod_n1sdp_i2c_event_params *params =
+        (struct mod_n1sdp_i2c_event_params *)event.params;
+
+    I2C_REG_W(device_ctx->reg->IDR, I2C_ISR_MASK, I2C_ISR_SHIFT,
+              I2C_ISR_ASYNC_MASK);
+
+    if (status != FWK_SUCCESS)
+        end_async_transfer(device_ctx, true);
+
+    device_ctx->transfer_idx = device_ctx->transfer_count;
+
+    event = (struct fwk_event) {
+        .source_id = device_ctx->id,
+        .target_id = device_ctx->id,
+        .id = n1sdp_i2c_event_id_transfer_completed,
+    };
+    params->status = status;
+
+    status = fwk_thread_put_event(&event);
+    fwk_assert(status == FWK_SUCCESS);
+}
+
+static void i2c_isr(uintptr_t param)
+{
+    uint16_t isr;
+    const struct mod_n1sdp_i2c_transfer *transfer;
+    struct n1sdp_i2c_dev_ctx *device_ctx = (struct n1sdp_i2c_dev_ctx *)param;
+
+    isr = I2C_REG_R(device_ctx->reg->ISR, I2C_ISR_MASK, I2C_ISR_SHIFT);
+    I2C_REG_W(device_ctx->reg->ISR, I2C_ISR_MASK, I2C_ISR_SHIFT, isr);
+
+    /* No asynchronous transfer in progress */
+    if (device_ctx->transfer_idx >= device_ctx->transfer_count)
+        return;
+
+    if ((isr & I2C_ISR_ERROR_MASK) != 0) {
+        complete_batch(device_ctx, FWK_E_DEVICE);
+        return;
+    }
+
+    transfer = &device_ctx->transfer_table[device_ctx->transfer_idx];
+
+    if (transfer->read)
+        read_fifo(device_ctx);
+
+    if ((isr & I2C_ISR_COMP_MASK) == 0)
+        return;
+
+    if (transfer->read) {
+        /* The whole chunk should have been received */
+        if (device_ctx->chunk_length != 0) {
+            complete_batch(device_ctx, FWK_E_DEVICE);
+            return;
+        }
+
+        if (device_ctx->remaining_length != 0) {
+            start_read_chunk(device_ctx, transfer->address);
+            return;
+        }
+    } else if (device_ctx->remaining_length != 0) {
+        write_fifo(device_ctx, I2C_FIFO_DEPTH);
+        return;
+    }
+
+    end_async_transfer(device_ctx, transfer->read || transfer->stop);
+
+    if (++device_ctx->transfer_idx < device_ctx->transfer_count)
+        start_async_transfer(device_ctx);
+    else
+        complete_batch(device_ctx, FWK_SUCCESS);
+}
+
 /*
  * Module I2C driver API
  */
@@ -89,6 +332,9 @@ static int i2c_master_read(fwk_id_t device_id, uint16_t address, char *data,
 
     device_ctx = &i2c_ctx.device_ctx_table[fwk_id_get_element_idx(device_id)];
 
+    if (device_ctx->busy)
+        return FWK_E_BUSY;
+
     I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_HOLD_MASK, I2C_CR_HOLD_SHIFT,
                 I2C_HOLD_ON);
 
@@ -121,7 +367,7 @@ static int i2c_master_read(fwk_id_t device_id, uint16_t address, char *data,
     }
 
     if (timeout == 0) {
-        i2c_ctx.log_api->log(MOD_LOG_GROUP_INFO, "read: timeout expired\n");
+        MOD_LOG(i2c_ctx.log_api, MOD_LOG_GROUP_INFO, "read: timeout expired\n");
         return FWK_E_STATE;
     }
 
@@ -166,6 +412,9 @@ static int i2c_master_write(fwk_id_t device_id, uint16_t address,
 
     device_ctx = &i2c_ctx.device_ctx_table[fwk_id_get_element_idx(device_id)];
 
+    if (device_ctx->busy)
+        return FWK_E_BUSY;
+
     I2C_REG_RMW(device_ctx->reg->CR, I2C_CR_HOLD_MASK, I2C_CR_HOLD_SHIFT,
                 I2C_HOLD_ON);
 
@@ -215,7 +464,8 @@ static int i2c_master_write(fwk_id_t device_id, uint16_t address,
     }
 
     if (timeout == 0) {
-        i2c_ctx.log_api->log(MOD_LOG_GROUP_INFO, "write: timeout expired\n");
+        MOD_LOG(i2c_ctx.log_api, MOD_LOG_GROUP_INFO,
+                "write: timeout expired\n");
         return FWK_E_STATE;
     }
 
@@ -234,9 +484,61 @@ static int i2c_master_write(fwk_id_t device_id, uint16_t address,
     return FWK_SUCCESS;
 }
 
+static int i2c_transfer_async(fwk_id_t device_id,
+    const struct mod_n1sdp_i2c_transfer *transfer_table,
+    unsigned int transfer_count)
+{
+    int status;
+    unsigned int i;
+    struct n1sdp_i2c_dev_ctx *device_ctx;
+    struct fwk_event event;
+    struct n1sdp_i2c_transfer_event_params *params =
+        (struct n1sdp_i2c_transfer_event_params *)event.params;
+
+    status = fwk_module_check_call(device_id);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if ((transfer_table == NULL) || (transfer_count == 0))
+        return FWK_E_PARAM;
+
+    for (i = 0; i < transfer_count; i++) {
+        if ((transfer_table[i].data == NULL) ||
+            (transfer_table[i].length == 0))
+            return FWK_E_PARAM;
+    }
+
+    device_ctx = &i2c_ctx.device_ctx_table[fwk_id_get_element_idx(device_id)];
+
+    if (device_ctx->config->irq == FWK_INTERRUPT_NONE)
+        return FWK_E_SUPPORT;
+
+    if (device_ctx->busy)
+        return FWK_E_BUSY;
+
+    event = (struct fwk_event) {
+        .target_id = device_id,
+        .id = mod_n1sdp_i2c_event_id_transfer,
+        .response_requested = true,
+    };
+    *params = (struct n1sdp_i2c_transfer_event_params) {
+        .transfer_table = transfer_table,
+        .transfer_count = transfer_count,
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    device_ctx->busy = true;
+
+    return FWK_SUCCESS;
+}
+
 static const struct mod_n1sdp_i2c_master_api driver_api = {
     .read = i2c_master_read,
     .write = i2c_master_write,
+    .transfer_async = i2c_transfer_async,
 };
 
 static void i2c_init(struct n1sdp_i2c_dev_ctx *device_ctx,
@@ -294,6 +596,7 @@ static int n1sdp_i2c_element_init(fwk_id_t element_id, unsigned int unused,
     if (device_ctx == NULL)
         return FWK_E_DATA;
 
+    device_ctx->id = element_id;
     device_ctx->config = config;
     device_ctx->reg = (struct i2c_reg *)config->reg_base;
 
@@ -333,12 +636,88 @@ static int n1sdp_i2c_process_bind_request(fwk_id_t requester_id,
     return FWK_SUCCESS;
 }
 
+static int n1sdp_i2c_start(fwk_id_t id)
+{
+    int status;
+    struct n1sdp_i2c_dev_ctx *device_ctx;
+    unsigned int irq;
+
+    if (!fwk_module_is_valid_element_id(id))
+        return FWK_SUCCESS;
+
+    device_ctx = &i2c_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+    irq = device_ctx->config->irq;
+
+    if (irq == FWK_INTERRUPT_NONE)
+        return FWK_SUCCESS;
+
+    status = fwk_interrupt_set_isr_param(irq, i2c_isr, (uintptr_t)device_ctx);
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    status = fwk_interrupt_clear_pending(irq);
+    if (status != FWK_SUCCESS)
+        return FWK_E_DEVICE;
+
+    return fwk_interrupt_enable(irq);
+}
+
+static int n1sdp_i2c_process_event(const struct fwk_event *event,
+                                   struct fwk_event *resp_event)
+{
+    int status;
+    struct fwk_event resp;
+    struct n1sdp_i2c_dev_ctx *device_ctx;
+    const struct n1sdp_i2c_transfer_event_params *transfer_params =
+        (const struct n1sdp_i2c_transfer_event_params *)event->params;
+    const struct mod_n1sdp_i2c_event_params *completed_params =
+        (const struct mod_n1sdp_i2c_event_params *)event->params;
+
+    device_ctx =
+        &i2c_ctx.device_ctx_table[fwk_id_get_element_idx(event->target_id)];
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_N1SDP_I2C_EVENT_IDX_TRANSFER:
+        device_ctx->transfer_table = transfer_params->transfer_table;
+        device_ctx->transfer_count = transfer_params->transfer_count;
+        device_ctx->transfer_idx = 0;
+        device_ctx->cookie = event->cookie;
+
+        start_async_transfer(device_ctx);
+
+        I2C_REG_W(device_ctx->reg->IER, I2C_ISR_MASK, I2C_ISR_SHIFT,
+                  I2C_ISR_ASYNC_MASK);
+
+        resp_event->is_delayed_response = true;
+
+        return FWK_SUCCESS;
+
+    case N1SDP_I2C_INTERNAL_EVENT_IDX_TRANSFER_COMPLETED:
+        device_ctx->busy = false;
+
+        status = fwk_thread_get_delayed_response(event->target_id,
+                                                 device_ctx->cookie, &resp);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        *(struct mod_n1sdp_i2c_event_params *)resp.params = *completed_params;
+
+        return fwk_thread_put_event(&resp);
+
+    default:
+        return FWK_E_PARAM;
+    }
+}
+
 const struct fwk_module module_n1sdp_i2c = {
     .name = "N1SDP_I2C",
     .type = FWK_MODULE_TYPE_DRIVER,
     .api_count = 1,
+    .event_count = N1SDP_I2C_INTERNAL_EVENT_IDX_COUNT,
     .init = n1sdp_i2c_init,
     .element_init = n1sdp_i2c_element_init,
     .bind = n1sdp_i2c_bind,
+    .start = n1sdp_i2c_start,
     .process_bind_request = n1sdp_i2c_process_bind_request,
+    .process_event = n1sdp_i2c_process_event,
 };
@@ -30,9 +30,6 @@ struct n1sdp_mcp_system_ctx {
     /* Log API pointer */
     const struct mod_log_api *log_api;
 
-    /* SCMI agent API pointer */
-    const struct mod_scmi_agent_api *scmi_api;
-
     /* PIK clock API - MCP core clock */
     const struct mod_clock_drv_api *pik_coreclk_api;
 
@@ -64,12 +61,6 @@ static int n1sdp_mcp_system_bind(fwk_id_t id, unsigned int round)
         if (status != FWK_SUCCESS)
             return status;
 
-        status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_AGENT),
-                                 FWK_ID_API(FWK_MODULE_IDX_SCMI_AGENT, 0),
-                                 &n1sdp_mcp_system_ctx.scmi_api);
-        if (status != FWK_SUCCESS)
-            return status;
-
         status = fwk_module_bind(FWK_ID_ELEMENT(FWK_MODULE_IDX_PIK_CLOCK,
                                                 CLOCK_PIK_IDX_MCP_CORECLK),
                                  FWK_ID_API(FWK_MODULE_IDX_PIK_CLOCK,
@@ -100,20 +91,30 @@ static int n1sdp_mcp_system_start(fwk_id_t id)
     return fwk_thread_put_event(&event);
 }
 
-static int n1sdp_mcp_system_process_event(const struct fwk_event *event,
-                                         struct fwk_event *resp)
+/*
+ * Send a command of the management protocol to the SCP, the response is
+ * delivered in a response event.
+ */
+static int request_management_message(uint32_t message_id)
 {
-    int status;
-    uint32_t clock_status = 0;
-    uint8_t mc_mode = 0;
-    uint8_t chipid = 0;
+    struct fwk_event req = {
+        .target_id = FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT, 0),
+        .id = mod_scmi_agent_event_id_request,
+        .response_requested = true,
+    };
+    struct mod_scmi_agent_request_params *req_params =
+        (struct mod_scmi_agent_request_params *)req.params;
 
-    status = n1sdp_mcp_system_ctx.scmi_api->get_clock_status(
-                 FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT, 0), &clock_status);
-    if (status != FWK_SUCCESS)
-        return status;
+    req_params->message_id = message_id;
+
+    return fwk_thread_put_event(&req);
+}
+
+static int process_clock_status(uint32_t clock_status)
+{
+    int status;
 
-    n1sdp_mcp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(n1sdp_mcp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
         "[MCP SYSTEM] SCP clock status: 0x%x\n",
         clock_status);
 
@@ -131,20 +132,39 @@ static int n1sdp_mcp_system_process_event(const struct fwk_event *event,
     if (status != FWK_SUCCESS)
         return FWK_SUCCESS;
 
-    n1sdp_mcp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(n1sdp_mcp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
         "[MCP SYSTEM] MCP PIK clocks configured\n");
 
-    status = n1sdp_mcp_system_ctx.scmi_api->get_chipid_info(
-                 FWK_ID_ELEMENT(FWK_MODULE_IDX_SCMI_AGENT, 0),
-                 &mc_mode, &chipid);
-    if (status != FWK_SUCCESS)
-        return status;
+    return request_management_message(SCMI_MANAGEMENT_CHIPID_INFO_GET);
+}
+
+static int n1sdp_mcp_system_process_event(const struct fwk_event *event,
+                                         struct fwk_event *resp)
+{
+    const struct mod_scmi_agent_response_params *resp_params;
+
+    if (!fwk_id_is_equal(event->id, mod_scmi_agent_event_id_request))
+        return request_management_message(SCMI_MANAGEMENT_CLOCK_STATUS_GET);
+
+    resp_params = (const struct mod_scmi_agent_response_params *)event->params;
+    if (resp_params->status != FWK_SUCCESS)
+        return resp_params->status;
+
+    switch (resp_params->message_id) {
+    case SCMI_MANAGEMENT_CLOCK_STATUS_GET:
+        return process_clock_status(resp_params->return_values[0]);
 
-    n1sdp_mcp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
-        "[MCP SYSTEM] MC Mode: 0x%x CHIPID: 0x%x\n",
-        mc_mode, chipid);
+    case SCMI_MANAGEMENT_CHIPID_INFO_GET:
+        MOD_LOG(n1sdp_mcp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
+            "[MCP SYSTEM] MC Mode: 0x%x CHIPID: 0x%x\n",
+            (uint8_t)resp_params->return_values[0],
+            (uint8_t)resp_params->return_values[1]);
 
-    return status;
+        return FWK_SUCCESS;
+
+    default:
+        return FWK_E_PARAM;
+    }
 }
 
 const struct fwk_module module_n1sdp_mcp_system = {
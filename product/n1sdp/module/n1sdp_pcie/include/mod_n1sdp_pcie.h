@@ -10,6 +10,8 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 
 /*!
  * \addtogroup GroupN1SDPModule N1SDP Product Modules
@@ -27,6 +29,48 @@
  * \{
  */
 
+/*!
+ * \brief Number of TX equalization preset registers of a controller.
+ */
+#define N1SDP_PCIE_TX_PRESET_REG_COUNT 8
+
+/*! Signature of a valid link cache, "PCIL" in memory */
+#define N1SDP_PCIE_LINK_CACHE_SIGNATURE UINT32_C(0x4C494350)
+
+/*!
+ * \brief Link training result of a PCIe controller kept across reboots.
+ *
+ * \details The TX equalization presets of the last trained link are the first
+ *      ones tried on the next boot. The cache is invalidated when the link
+ *      fails to train with them, so that the default presets are used on the
+ *      following boot.
+ */
+struct n1sdp_pcie_link_cache {
+    /*! Signature, \ref N1SDP_PCIE_LINK_CACHE_SIGNATURE when valid */
+    uint32_t signature;
+
+    /*! Sum of the words of the cache following the checksum */
+    uint32_t checksum;
+
+    /*! PCIe generation the link was trained for */
+    uint32_t gen;
+
+    /*! TX equalization preset registers after the link training */
+    uint32_t tx_preset[N1SDP_PCIE_TX_PRESET_REG_COUNT];
+
+    /*! Negotiated speed, the generation minus one */
+    uint32_t negotiated_speed;
+
+    /*! Negotiated link width, log2 of the number of lanes */
+    uint32_t negotiated_width;
+
+    /*! Duration of the link training in milliseconds */
+    uint32_t link_training_time_ms;
+
+    /*! Number of boots whose link trained below its generation or width */
+    uint32_t degraded_count;
+};
+
 /*!
  * \brief N1SDP PCIe instance configuration
  */
@@ -61,6 +105,51 @@ struct n1sdp_pcie_dev_config {
 
     /*! Identifier to indicate if the PCIe controller is CCIX capable */
     bool ccix_capable;
+
+    /*!
+     * Identifier of the alarm polling the link training and waiting for the
+     * downstream devices of the controller.
+     */
+    fwk_id_t alarm_id;
+
+    /*!
+     * \brief Link cache of the controller, in memory retained across reboots.
+     *
+     * \details May be \c NULL if the link training is not cached.
+     */
+    struct n1sdp_pcie_link_cache *link_cache;
+};
+
+/*!
+ * \brief Notification indices.
+ */
+enum n1sdp_pcie_notification_idx {
+    /*!
+     * The setup of a PCIe controller has completed, with
+     * \ref mod_n1sdp_pcie_notification_params parameters.
+     */
+    N1SDP_PCIE_NOTIFICATION_IDX_INITIALIZED,
+
+    /*! Number of defined notifications */
+    N1SDP_PCIE_NOTIFICATION_IDX_COUNT
+};
+
+/*!
+ * \brief Identifier for the ::N1SDP_PCIE_NOTIFICATION_IDX_INITIALIZED
+ *     notification.
+ */
+static const fwk_id_t mod_n1sdp_pcie_notification_id_initialized =
+    FWK_ID_NOTIFICATION_INIT(
+        FWK_MODULE_IDX_N1SDP_PCIE,
+        N1SDP_PCIE_NOTIFICATION_IDX_INITIALIZED);
+
+/*!
+ * \brief Parameters of the ::N1SDP_PCIE_NOTIFICATION_IDX_INITIALIZED
+ *     notification.
+ */
+struct mod_n1sdp_pcie_notification_params {
+    /*! Status of the setup of the controller */
+    int status;
 };
 
 /*!
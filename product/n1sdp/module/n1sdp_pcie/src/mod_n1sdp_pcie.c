@@ -24,6 +24,20 @@
 #include <n1sdp_scp_pik.h>
 #include <internal/pcie_ctrl_apb_reg.h>
 
+/*
+ * Stages of the setup of a controller waiting for an alarm
+ */
+enum n1sdp_pcie_setup_stage {
+    /* The setup of the controller has not started or has completed */
+    N1SDP_PCIE_SETUP_STAGE_IDLE,
+
+    /* The link training of the controller is polled */
+    N1SDP_PCIE_SETUP_STAGE_LINK_TRAINING,
+
+    /* The downstream devices finish their link training */
+    N1SDP_PCIE_SETUP_STAGE_LINK_SETTLE,
+};
+
 /*
  * Device context
  */
@@ -66,6 +80,21 @@ struct n1sdp_pcie_dev_ctx {
      * Accessible in EP mode.
      */
     uintptr_t ep_axi_config_apb;
+
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Stage of the setup waiting for the alarm */
+    enum n1sdp_pcie_setup_stage stage;
+
+    /* Time spent in the link training in milliseconds */
+    unsigned int link_training_time_ms;
+
+    /* PCIe generation of the controller */
+    enum pcie_gen gen_speed;
+
+    /* The TX presets were restored from the link cache */
+    bool cached_presets;
 };
 
 /*
@@ -115,8 +144,8 @@ static int n1sdp_pcie_ccix_enable_opt_tlp(bool enable)
     else
         value = (CCIX_CTRL_CAW | CCIX_VENDER_ID);
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                          "[PCIE] CCIX_CONTROL: 0x%08x\n", value);
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+                              "[PCIE] CCIX_CONTROL: 0x%08x\n", value);
 
     *(uint32_t *)(dev_ctx->lm_apb + PCIE_LM_RC_CCIX_CTRL_REG) = value;
 
@@ -127,15 +156,104 @@ static int n1sdp_pcie_ccix_enable_opt_tlp(bool enable)
 }
 
 
+/*
+ * Link cache functions
+ */
+static uint32_t link_cache_checksum(const struct n1sdp_pcie_link_cache *cache)
+{
+    const uint32_t *word = &cache->gen;
+    const uint32_t *end = (const uint32_t *)(cache + 1);
+    uint32_t sum = 0;
+
+    while (word < end)
+        sum += *word++;
+
+    return sum;
+}
+
+static bool link_cache_is_valid(const struct n1sdp_pcie_dev_ctx *dev_ctx)
+{
+    const struct n1sdp_pcie_link_cache *cache = dev_ctx->config->link_cache;
+
+    return (cache != NULL) &&
+           (cache->signature == N1SDP_PCIE_LINK_CACHE_SIGNATURE) &&
+           (cache->gen == dev_ctx->gen_speed) &&
+           (cache->checksum == link_cache_checksum(cache));
+}
+
+/* Program the presets of the last trained link, or the default ones */
+static int link_cache_restore(struct n1sdp_pcie_dev_ctx *dev_ctx)
+{
+    const struct n1sdp_pcie_link_cache *cache = dev_ctx->config->link_cache;
+
+    dev_ctx->cached_presets = link_cache_is_valid(dev_ctx);
+    if (!dev_ctx->cached_presets) {
+        return pcie_set_gen_tx_preset(dev_ctx->rp_ep_config_apb,
+                                      TX_PRESET_VALUE,
+                                      dev_ctx->gen_speed);
+    }
+
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[PCIe] Restoring TX presets of the last GEN%d x%d link\n",
+        cache->negotiated_speed + 1,
+        fwk_math_pow2(cache->negotiated_width));
+
+    return pcie_set_gen_tx_preset_regs(dev_ctx->rp_ep_config_apb,
+                                       cache->tx_preset,
+                                       dev_ctx->gen_speed);
+}
+
+/* Record the presets and the parameters of a trained link */
+static void link_cache_store(struct n1sdp_pcie_dev_ctx *dev_ctx)
+{
+    struct n1sdp_pcie_link_cache *cache = dev_ctx->config->link_cache;
+    uint32_t config_out = dev_ctx->ctrl_apb->RP_CONFIG_OUT;
+    uint32_t speed = (config_out & RP_CONFIG_OUT_NEGOTIATED_SPD_MASK) >>
+                     RP_CONFIG_OUT_NEGOTIATED_SPD_POS;
+    uint32_t width = (config_out & RP_CONFIG_OUT_NEGOTIATED_LINK_WIDTH_MASK) >>
+                     RP_CONFIG_OUT_NEGOTIATED_LINK_WIDTH_POS;
+    uint32_t degraded_count = 0;
+    bool degraded;
+
+    /* The controller is configured for its generation and 16 lanes */
+    degraded = (speed < (uint32_t)dev_ctx->gen_speed) || (width < 4);
+    if (degraded) {
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[PCIe] Warning! Link trained below GEN%d x16\n",
+            dev_ctx->gen_speed + 1);
+    }
+
+    if (cache == NULL)
+        return;
+
+    if (link_cache_is_valid(dev_ctx))
+        degraded_count = cache->degraded_count;
+
+    memset(cache->tx_preset, 0, sizeof(cache->tx_preset));
+    pcie_get_gen_tx_preset_regs(dev_ctx->rp_ep_config_apb, cache->tx_preset,
+                                dev_ctx->gen_speed);
+    cache->gen = dev_ctx->gen_speed;
+    cache->negotiated_speed = speed;
+    cache->negotiated_width = width;
+    cache->link_training_time_ms = dev_ctx->link_training_time_ms;
+    cache->degraded_count = degraded_count + (degraded ? 1 : 0);
+    cache->checksum = link_cache_checksum(cache);
+    cache->signature = N1SDP_PCIE_LINK_CACHE_SIGNATURE;
+}
+
+/*
+ * Power the controller on, initialize its PHY and start the link training. The
+ * link training is polled by the alarm of the controller so that all the
+ * controllers train their link at the same time.
+ */
 static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
 {
-    uint32_t ecam_base_addr;
-    uint8_t neg_config;
     struct pcie_wait_condition_data wait_data;
     int status;
     enum pcie_gen gen_speed;
 
     gen_speed = dev_ctx->config->ccix_capable ? PCIE_GEN_4 : PCIE_GEN_3;
+    dev_ctx->gen_speed = gen_speed;
 
     /* Enable the CCIX/PCIe controller */
     wait_data.ctrl_apb = NULL;
@@ -149,7 +267,7 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                                           pcie_wait_condition,
                                           &wait_data);
         if (status != FWK_SUCCESS) {
-            pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+            MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
                 "[PCIe] Controller power-on failed!\n");
             return status;
         }
@@ -164,7 +282,7 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                                           pcie_wait_condition,
                                           &wait_data);
         if (status != FWK_SUCCESS) {
-            pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+            MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
                 "[PCIe] Controller power-on failed!\n");
             return status;
         }
@@ -172,7 +290,7 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
     }
 
     /* PHY initialization */
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "[PCIe] Initializing PHY...");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "[PCIe] Initializing PHY...");
 
     pcie_phy_init(dev_ctx->phy_apb, gen_speed);
     status = pcie_init(dev_ctx->ctrl_apb,
@@ -180,59 +298,65 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                        PCIE_INIT_STAGE_PHY,
                        gen_speed);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Timeout!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Timeout!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
     /* Controller initialization */
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                          "[PCIe] Initializing controller...");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+                              "[PCIe] Initializing controller...");
     status = pcie_init(dev_ctx->ctrl_apb,
                        pcie_ctx.timer_api,
                        PCIE_INIT_STAGE_CTRL,
                        gen_speed);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Timeout!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Timeout!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    status = pcie_set_gen_tx_preset(dev_ctx->rp_ep_config_apb,
-                                    TX_PRESET_VALUE,
-                                    gen_speed);
+    status = link_cache_restore(dev_ctx);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Equalization failed!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Equalization failed!\n");
         return status;
     }
 
     /* Link training */
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                          "[PCIe] Starting link training...");
-    status = pcie_init(dev_ctx->ctrl_apb,
-                       pcie_ctx.timer_api,
-                       PCIE_INIT_STAGE_LINK_TRNG,
-                       gen_speed);
-    if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Timeout!\n");
-        return dev_ctx->config->ccix_capable ? FWK_SUCCESS : status;
-    }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+                              "[PCIe] Starting link training\n");
+    dev_ctx->ctrl_apb->RP_CONFIG_IN |= RP_CONFIG_IN_LINK_TRNG_EN_MASK;
+
+    dev_ctx->stage = N1SDP_PCIE_SETUP_STAGE_LINK_TRAINING;
+    dev_ctx->link_training_time_ms = 0;
+
+    return dev_ctx->alarm_api->start(dev_ctx->config->alarm_id,
+        PCIE_LINK_POLL_PERIOD_MS, MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+}
+
+/*
+ * Configure the root port of a controller whose link is up
+ */
+static int n1sdp_pcie_setup_rp(struct n1sdp_pcie_dev_ctx *dev_ctx)
+{
+    uint32_t ecam_base_addr;
+    uint8_t neg_config;
+    int status;
 
     neg_config = (dev_ctx->ctrl_apb->RP_CONFIG_OUT &
         RP_CONFIG_OUT_NEGOTIATED_SPD_MASK) >> RP_CONFIG_OUT_NEGOTIATED_SPD_POS;
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Negotiated speed: GEN%d\n", neg_config + 1);
 
     neg_config = (dev_ctx->ctrl_apb->RP_CONFIG_OUT &
         RP_CONFIG_OUT_NEGOTIATED_LINK_WIDTH_MASK) >>
         RP_CONFIG_OUT_NEGOTIATED_LINK_WIDTH_POS;
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Negotiated link width: x%d\n", fwk_math_pow2(neg_config));
 
     /* Root Complex setup */
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                          "[PCIe] Setup Type0 configuration...");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+                              "[PCIe] Setup Type0 configuration...");
     if (dev_ctx->config->ccix_capable)
         ecam_base_addr = dev_ctx->config->axi_slave_base32 +
                          CCIX_AXI_ECAM_TYPE0_OFFSET;
@@ -244,12 +368,12 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                  __builtin_ctz(AXI_ECAM_TYPE0_SIZE),
                  TRANS_TYPE_0_CFG);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Setup Type1 configuration...");
     if (dev_ctx->config->ccix_capable)
         ecam_base_addr = dev_ctx->config->axi_slave_base32 +
@@ -262,12 +386,12 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                  __builtin_ctz(AXI_ECAM_TYPE1_SIZE),
                  TRANS_TYPE_1_CFG);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Setup MMIO32 configuration...");
     if (dev_ctx->config->ccix_capable)
         ecam_base_addr = dev_ctx->config->axi_slave_base32 +
@@ -280,12 +404,12 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                  __builtin_ctz(AXI_MMIO32_SIZE),
                  TRANS_TYPE_MEM_IO);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Setup IO configuration...");
     if (dev_ctx->config->ccix_capable)
         ecam_base_addr = dev_ctx->config->axi_slave_base32 +
@@ -298,46 +422,46 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
                  __builtin_ctz(AXI_IO_SIZE),
                  TRANS_TYPE_IO);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Setup MMIO64 configuration...");
     status = axi_outbound_region_setup(dev_ctx->rc_axi_config_apb,
                  dev_ctx->config->axi_slave_base64,
                  __builtin_ctz(AXI_MMIO64_SIZE),
                  TRANS_TYPE_MEM_IO);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Setup RP classcode...");
     status = pcie_rp_ep_config_write_word(dev_ctx->rp_ep_config_apb,
                                           PCIE_CLASS_CODE_OFFSET,
                                           PCIE_CLASS_CODE_PCI_BRIDGE);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Enable inbound region in BAR 2...");
     status = axi_inbound_region_setup(dev_ctx->rc_axi_config_apb,
                  AXI_IB_REGION_BASE,
                  AXI_IB_REGION_SIZE_MSB, 2);
     if (status != FWK_SUCCESS) {
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Error!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Error!\n");
         return status;
     }
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Enable Type 1 I/O configuration\n");
     *(uint32_t *)(dev_ctx->lm_apb + PCIE_LM_RC_BAR_CONFIG_REG) =
         (TYPE1_PREF_MEM_BAR_ENABLE_MASK |
@@ -345,32 +469,107 @@ static int n1sdp_pcie_setup(struct n1sdp_pcie_dev_ctx *dev_ctx)
          TYPE1_PREF_IO_BAR_ENABLE_MASK |
          TYPE1_PREF_IO_BAR_SIZE_32BIT_MASK);
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Skipping ATS capability...");
     status = pcie_skip_ext_cap(dev_ctx->rp_ep_config_apb, EXT_CAP_ID_ATS);
     if (status != FWK_SUCCESS)
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Not found!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Not found!\n");
     else
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
-    pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[PCIe] Skipping PRI capability...");
     status = pcie_skip_ext_cap(dev_ctx->rp_ep_config_apb, EXT_CAP_ID_PRI);
     if (status != FWK_SUCCESS)
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Not found!\n");
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Not found!\n");
     else
-        pcie_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Done\n");
-
-    /*
-     * Wait until devices connected in downstream ports
-     * finish link training before doing bus enumeration
-     */
-    pcie_ctx.timer_api->delay(FWK_ID_ELEMENT(FWK_MODULE_IDX_TIMER, 0),
-                                 PCIE_LINK_TRAINING_TIMEOUT);
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO, "Done\n");
 
     return FWK_SUCCESS;
 }
 
+static int n1sdp_pcie_notify_initialized(fwk_id_t id, int status)
+{
+    unsigned int count;
+    struct fwk_event notification_event = {
+        .id = mod_n1sdp_pcie_notification_id_initialized,
+        .source_id = id,
+    };
+    struct mod_n1sdp_pcie_notification_params *params =
+        (struct mod_n1sdp_pcie_notification_params *)
+            notification_event.params;
+
+    params->status = status;
+
+    pcie_ctx.device_ctx_table[fwk_id_get_element_idx(id)].stage =
+        N1SDP_PCIE_SETUP_STAGE_IDLE;
+
+    return fwk_notification_notify(&notification_event, &count);
+}
+
+/*
+ * Poll the link training of a controller, then wait until the devices
+ * connected in its downstream ports finish their link training before the bus
+ * enumeration.
+ */
+static int n1sdp_pcie_process_alarm(fwk_id_t id)
+{
+    int status;
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+    struct pcie_wait_condition_data wait_data;
+
+    dev_ctx = &pcie_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+
+    switch (dev_ctx->stage) {
+    case N1SDP_PCIE_SETUP_STAGE_LINK_TRAINING:
+        wait_data.ctrl_apb = dev_ctx->ctrl_apb;
+        wait_data.stage = PCIE_INIT_STAGE_LINK_TRNG;
+
+        if (!pcie_wait_condition(&wait_data)) {
+            dev_ctx->link_training_time_ms += PCIE_LINK_POLL_PERIOD_MS;
+            if (dev_ctx->link_training_time_ms <
+                (PCIE_LINK_TRAINING_TIMEOUT / 1000))
+                return FWK_SUCCESS;
+
+            dev_ctx->alarm_api->stop(dev_ctx->config->alarm_id);
+            MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+                "[PCIe] %s: link training timeout!\n",
+                fwk_module_get_name(id));
+
+            /* The next boot falls back to the default presets */
+            if (dev_ctx->cached_presets)
+                dev_ctx->config->link_cache->signature = 0;
+
+            /* A CCIX controller without link is not an error */
+            return n1sdp_pcie_notify_initialized(id,
+                dev_ctx->config->ccix_capable ? FWK_SUCCESS : FWK_E_TIMEOUT);
+        }
+
+        dev_ctx->alarm_api->stop(dev_ctx->config->alarm_id);
+        MOD_LOG(pcie_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[PCIe] %s: link training done in %u ms\n",
+            fwk_module_get_name(id), dev_ctx->link_training_time_ms);
+
+        link_cache_store(dev_ctx);
+
+        status = n1sdp_pcie_setup_rp(dev_ctx);
+        if (status != FWK_SUCCESS)
+            return n1sdp_pcie_notify_initialized(id, status);
+
+        dev_ctx->stage = N1SDP_PCIE_SETUP_STAGE_LINK_SETTLE;
+
+        return dev_ctx->alarm_api->start(dev_ctx->config->alarm_id,
+            PCIE_LINK_TRAINING_TIMEOUT / 1000, MOD_TIMER_ALARM_TYPE_ONCE,
+            NULL, 0);
+
+    case N1SDP_PCIE_SETUP_STAGE_LINK_SETTLE:
+        return n1sdp_pcie_notify_initialized(id, FWK_SUCCESS);
+
+    default:
+        return FWK_E_STATE;
+    }
+}
+
 static const struct n1sdp_pcie_ccix_config_api pcie_ccix_config_api = {
     .enable_opt_tlp = n1sdp_pcie_ccix_enable_opt_tlp,
 };
@@ -430,6 +629,14 @@ static int n1sdp_pcie_element_init(fwk_id_t element_id, unsigned int unused,
 static int n1sdp_pcie_bind(fwk_id_t id, unsigned int round)
 {
     int status;
+    struct n1sdp_pcie_dev_ctx *dev_ctx;
+
+    if ((round == 0) && fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT)) {
+        dev_ctx = &pcie_ctx.device_ctx_table[fwk_id_get_element_idx(id)];
+
+        return fwk_module_bind(dev_ctx->config->alarm_id,
+            MOD_TIMER_API_ID_ALARM, &dev_ctx->alarm_api);
+    }
 
     if (round == 0) {
         status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
@@ -481,6 +688,7 @@ static int n1sdp_pcie_process_bind_request(fwk_id_t requester_id,
 static int n1sdp_pcie_process_notification(const struct fwk_event *event,
                                           struct fwk_event *resp)
 {
+    int status;
     struct n1sdp_pcie_dev_ctx *dev_ctx;
 
     dev_ctx = &pcie_ctx.device_ctx_table[
@@ -488,7 +696,23 @@ static int n1sdp_pcie_process_notification(const struct fwk_event *event,
     if (dev_ctx == NULL)
         return FWK_E_PARAM;
 
-    return n1sdp_pcie_setup(dev_ctx);
+    if (dev_ctx->stage != N1SDP_PCIE_SETUP_STAGE_IDLE)
+        return FWK_E_BUSY;
+
+    status = n1sdp_pcie_setup(dev_ctx);
+    if (status != FWK_SUCCESS)
+        n1sdp_pcie_notify_initialized(event->target_id, status);
+
+    return status;
+}
+
+static int n1sdp_pcie_process_event(const struct fwk_event *event,
+                                    struct fwk_event *resp)
+{
+    if (!fwk_id_is_equal(event->id, mod_timer_event_id_alarm))
+        return FWK_E_PARAM;
+
+    return n1sdp_pcie_process_alarm(event->target_id);
 }
 
 const struct fwk_module module_n1sdp_pcie = {
@@ -501,4 +725,6 @@ const struct fwk_module module_n1sdp_pcie = {
     .start = n1sdp_pcie_start,
     .process_bind_request = n1sdp_pcie_process_bind_request,
     .process_notification = n1sdp_pcie_process_notification,
+    .process_event = n1sdp_pcie_process_event,
+    .notification_count = N1SDP_PCIE_NOTIFICATION_IDX_COUNT,
 };
@@ -308,6 +308,60 @@ int pcie_set_gen_tx_preset(uint32_t rp_ep_config_apb_base,
     return FWK_SUCCESS;
 }
 
+int pcie_set_gen_tx_preset_regs(uint32_t rp_ep_config_apb_base,
+                                const uint32_t *preset_reg,
+                                enum pcie_gen gen)
+{
+    uint32_t offset;
+    uint32_t reg_value;
+    uint32_t offset_min;
+    uint32_t offset_max;
+
+    assert((gen == PCIE_GEN_3) || (gen == PCIE_GEN_4));
+    assert(preset_reg != NULL);
+
+    offset_min = (gen == PCIE_GEN_3) ? GEN3_OFFSET_MIN : GEN4_OFFSET_MIN;
+    offset_max = (gen == PCIE_GEN_3) ? GEN3_OFFSET_MAX : GEN4_OFFSET_MAX;
+
+    for (offset = offset_min; offset < offset_max; offset += 0x4) {
+        pcie_rp_ep_config_write_word(rp_ep_config_apb_base, offset,
+                                     *preset_reg);
+        pcie_rp_ep_config_read_word(rp_ep_config_apb_base, offset, &reg_value);
+
+        if (reg_value != *preset_reg++)
+            return FWK_E_DATA;
+    }
+    return FWK_SUCCESS;
+}
+
+unsigned int pcie_get_gen_tx_preset_regs(uint32_t rp_ep_config_apb_base,
+                                         uint32_t *preset_reg,
+                                         enum pcie_gen gen)
+{
+    uint32_t offset;
+    uint32_t offset_min;
+    uint32_t offset_max;
+
+    static_assert(((GEN3_OFFSET_MAX - GEN3_OFFSET_MIN) / 4) <=
+                  N1SDP_PCIE_TX_PRESET_REG_COUNT,
+                  "Too many GEN3 preset registers");
+    static_assert(((GEN4_OFFSET_MAX - GEN4_OFFSET_MIN) / 4) <=
+                  N1SDP_PCIE_TX_PRESET_REG_COUNT,
+                  "Too many GEN4 preset registers");
+
+    assert((gen == PCIE_GEN_3) || (gen == PCIE_GEN_4));
+    assert(preset_reg != NULL);
+
+    offset_min = (gen == PCIE_GEN_3) ? GEN3_OFFSET_MIN : GEN4_OFFSET_MIN;
+    offset_max = (gen == PCIE_GEN_3) ? GEN3_OFFSET_MAX : GEN4_OFFSET_MAX;
+
+    for (offset = offset_min; offset < offset_max; offset += 0x4)
+        pcie_rp_ep_config_read_word(rp_ep_config_apb_base, offset,
+                                    preset_reg++);
+
+    return (offset_max - offset_min) / 4;
+}
+
 int pcie_skip_ext_cap(uint32_t base, uint16_t ext_cap_id)
 {
     uint32_t cap_hdr_now;
@@ -61,8 +61,8 @@
 /*
  * PCIe timeout values for PHY, controller & link training.
  * Timeout values specified in microseconds.
- * Note: Execution will block for the specified timeout. If the timeout
- * is too long switch to alarm API instead of blocking.
+ * Note: Execution will block for the PHY & controller timeouts. The link
+ * training is polled with the alarm API instead of blocking.
  */
 #define PCIE_PHY_PLL_LOCK_TIMEOUT      UINT32_C(100)
 #define PCIE_CTRL_RC_RESET_TIMEOUT     UINT32_C(100)
@@ -71,6 +71,9 @@
 /* PCIe controller power on timeout (in microseconds) */
 #define PCIE_POWER_ON_TIMEOUT          UINT32_C(10)
 
+/* PCIe link training polling period (in milliseconds) */
+#define PCIE_LINK_POLL_PERIOD_MS       UINT32_C(1)
+
 /* PCIe configuration space offset definitions */
 #define PCIE_CLASS_CODE_OFFSET         0x8
 
@@ -538,6 +541,37 @@ int pcie_set_gen_tx_preset(uint32_t rp_ep_config_apb_base,
                            uint32_t preset,
                            enum pcie_gen gen);
 
+/*
+ * Brief - Function to write the TX equalization preset registers.
+ *
+ * param - rp_ep_config_apb_base - Base address of the PCIe configuration
+ *                                 APB registers.
+ * param - preset_reg - Value of each preset register of the generation
+ * param - gen - PCIe generation
+ *
+ * retval - FWK_SUCCESS - if the operation is succeeded
+ *          FWK_E_DATA - if there is a mismatch between value written
+ *                       to and read from the register.
+ */
+int pcie_set_gen_tx_preset_regs(uint32_t rp_ep_config_apb_base,
+                                const uint32_t *preset_reg,
+                                enum pcie_gen gen);
+
+/*
+ * Brief - Function to read the TX equalization preset registers.
+ *
+ * param - rp_ep_config_apb_base - Base address of the PCIe configuration
+ *                                 APB registers.
+ * param - preset_reg - Pointer to hold the value of each preset register of
+ *                      the generation, N1SDP_PCIE_TX_PRESET_REG_COUNT entries
+ * param - gen - PCIe generation
+ *
+ * retval - Number of preset registers of the generation
+ */
+unsigned int pcie_get_gen_tx_preset_regs(uint32_t rp_ep_config_apb_base,
+                                         uint32_t *preset_reg,
+                                         enum pcie_gen gen);
+
 /*
  * Brief - Function to skip an extended capability from capability
  *         linked list.
@@ -33,6 +33,22 @@ enum mod_n1sdp_pll_api_types {
     MOD_N1SDP_PLL_API_COUNT,
 };
 
+/*!
+ * \brief PLL rate table entry.
+ *
+ * \details The rate tables are generated by tools/gen_pll_table.py.
+ */
+struct n1sdp_pll_rate_entry {
+    /*! Output rate in Hertz (Hz) */
+    uint64_t rate;
+
+    /*! Value of the control register 0, the PLL being disabled */
+    uint32_t control_reg0;
+
+    /*! Value of the control register 1 */
+    uint32_t control_reg1;
+};
+
 /*!
  * \brief PLL device configuration.
  */
@@ -56,6 +72,17 @@ struct mod_n1sdp_pll_dev_config {
      */
     const uint64_t ref_rate;
 
+    /*!
+     * Table of the register values of the rates of the PLL, generated for the
+     * rate of its reference clock, in ascending order of rate. The register
+     * values of the rates that are not in the table, if any, are worked out
+     * when the rates are set.
+     */
+    const struct n1sdp_pll_rate_entry *rate_table;
+
+    /*! Number of entries in the rate table */
+    const size_t rate_count;
+
     /*!
      * If \c true, the driver will not attempt to set a default frequency, or
      * to otherwise configure the PLL during the pre-runtime phase. The PLL is
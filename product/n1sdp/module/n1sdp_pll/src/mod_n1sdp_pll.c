@@ -48,33 +48,46 @@ struct n1sdp_pll_ctx {
 static struct n1sdp_pll_ctx module_ctx;
 
 /*
- * PLL rate configuration function
+ * PLL rate configuration functions
  */
 
-static int pll_set_rate(struct n1sdp_pll_dev_ctx *ctx, uint64_t rate,
-                            enum mod_clock_round_mode unused)
+/* Find the entry of a rate in the rate table of a PLL */
+static const struct n1sdp_pll_rate_entry *find_rate_entry(
+    const struct mod_n1sdp_pll_dev_config *config,
+    uint64_t rate)
+{
+    size_t low = 0;
+    size_t high = config->rate_count;
+    size_t mid;
+
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (config->rate_table[mid].rate == rate)
+            return &config->rate_table[mid];
+
+        if (config->rate_table[mid].rate < rate)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return NULL;
+}
+
+/* Work out the register values of a rate that is not in the rate table */
+static int get_rate_registers(const struct mod_n1sdp_pll_dev_config *config,
+                              uint64_t rate, uint32_t *control_reg0,
+                              uint32_t *control_reg1)
 {
     uint64_t rounded_rate;
     uint16_t fbdiv;
     uint8_t refdiv;
     uint8_t postdiv;
-    uint32_t wait_cycles;
     uint16_t rate_val_mhz;
-    const struct mod_n1sdp_pll_dev_config *config = NULL;
     struct n1sdp_pll_custom_freq_param_entry *freq_entry = NULL;
     size_t i;
 
-    fwk_assert(ctx != NULL);
-    fwk_assert(rate <= (UINT16_MAX * FWK_MHZ));
-
-    config = ctx->config;
-
-    if (ctx->current_state == MOD_CLOCK_STATE_STOPPED)
-        return FWK_E_PWRSTATE;
-
-    if ((rate < MOD_N1SDP_PLL_RATE_MIN) || (rate > MOD_N1SDP_PLL_RATE_MAX))
-        return FWK_E_RANGE;
-
     /* Assume initial refdiv and postdiv to be 1 */
     refdiv = MOD_N1SDP_PLL_REFDIV_MIN;
     postdiv = MOD_N1SDP_PLL_POSTDIV_MIN;
@@ -101,11 +114,47 @@ static int pll_set_rate(struct n1sdp_pll_dev_ctx *ctx, uint64_t rate,
     }
 
 result:
+    *control_reg0 = (fbdiv << PLL_FBDIV_BIT_POS) | (refdiv << PLL_REFDIV_POS);
+    *control_reg1 = (postdiv << PLL_POSTDIV1_POS) | (1 << PLL_POSTDIV2_POS);
+
+    return FWK_SUCCESS;
+}
+
+static int pll_set_rate(struct n1sdp_pll_dev_ctx *ctx, uint64_t rate,
+                            enum mod_clock_round_mode unused)
+{
+    uint32_t control_reg0;
+    uint32_t control_reg1;
+    uint32_t wait_cycles;
+    const struct mod_n1sdp_pll_dev_config *config = NULL;
+    const struct n1sdp_pll_rate_entry *rate_entry;
+    int status;
+
+    fwk_assert(ctx != NULL);
+    fwk_assert(rate <= (UINT16_MAX * FWK_MHZ));
+
+    config = ctx->config;
+
+    if (ctx->current_state == MOD_CLOCK_STATE_STOPPED)
+        return FWK_E_PWRSTATE;
+
+    if ((rate < MOD_N1SDP_PLL_RATE_MIN) || (rate > MOD_N1SDP_PLL_RATE_MAX))
+        return FWK_E_RANGE;
+
+    rate_entry = find_rate_entry(config, rate);
+    if (rate_entry != NULL) {
+        control_reg0 = rate_entry->control_reg0;
+        control_reg1 = rate_entry->control_reg1;
+    } else {
+        status = get_rate_registers(config, rate, &control_reg0,
+                                    &control_reg1);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     /* Configure PLL settings */
-    *config->control_reg0 = (fbdiv << PLL_FBDIV_BIT_POS) |
-                            (refdiv << PLL_REFDIV_POS);
-    *config->control_reg1 = (postdiv << PLL_POSTDIV1_POS) |
-                            (1 << PLL_POSTDIV2_POS);
+    *config->control_reg0 = control_reg0;
+    *config->control_reg1 = control_reg1;
 
     /* Enable PLL settings */
     *config->control_reg0 |= (1 << PLL_PLLEN_POS);
@@ -337,6 +386,7 @@ static int n1sdp_pll_element_init(fwk_id_t element_id, unsigned int unused,
                                   const void *data)
 {
     struct n1sdp_pll_dev_ctx *ctx = NULL;
+    size_t idx;
 
     ctx = module_ctx.dev_ctx_table + fwk_id_get_element_idx(element_id);
 
@@ -348,6 +398,16 @@ static int n1sdp_pll_element_init(fwk_id_t element_id, unsigned int unused,
         (ctx->config->ref_rate == 0))
         return FWK_E_PARAM;
 
+    if ((ctx->config->rate_count != 0) && (ctx->config->rate_table == NULL))
+        return FWK_E_PARAM;
+
+    /* The rate lookups rely on the rates being sorted */
+    for (idx = 1; idx < ctx->config->rate_count; idx++) {
+        if (ctx->config->rate_table[idx].rate <=
+            ctx->config->rate_table[idx - 1].rate)
+            return FWK_E_DATA;
+    }
+
     if (ctx->config->defer_initialization)
         return FWK_SUCCESS;
 
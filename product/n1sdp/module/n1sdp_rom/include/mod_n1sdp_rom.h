@@ -8,6 +8,7 @@
 #ifndef MOD_N1SDP_ROM_H
 #define MOD_N1SDP_ROM_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -27,6 +28,9 @@ struct n1sdp_rom_config {
     /*! Base address of the RAM to which SCP BL2 will be copied to */
     const uintptr_t ramfw_base;
 
+    /*! Size of the RAM to which SCP BL2 will be copied to */
+    const size_t ramfw_size;
+
     /*! Type of RAM Firmware to load */
     const uint8_t image_type;
 };
@@ -5,10 +5,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stddef.h>
 #include <stdint.h>
-#include <string.h>
 #include <fwk_errno.h>
 #include <fwk_interrupt.h>
+#include <fwk_lz4.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_thread.h>
@@ -111,61 +112,49 @@ static int n1sdp_rom_start(fwk_id_t id)
 static int n1sdp_rom_process_event(const struct fwk_event *event,
     struct fwk_event *resp)
 {
-    struct mod_n1sdp_fip_descriptor *fip_desc_table = NULL;
     struct mod_n1sdp_fip_descriptor *fip_desc = NULL;
-    unsigned int fip_count = 0;
-    unsigned int i;
     int status;
+    size_t size;
 
-    status = n1sdp_rom_ctx.flash_api->get_n1sdp_fip_descriptor_count(
+    status = n1sdp_rom_ctx.flash_api->get_n1sdp_fip_descriptor(
                  FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_ROM),
-                 &fip_count);
+                 n1sdp_rom_ctx.rom_config->image_type,
+                 &fip_desc);
     if (status != FWK_SUCCESS)
         return status;
-    status = n1sdp_rom_ctx.flash_api->get_n1sdp_fip_descriptor_table(
-                 FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_ROM),
-                 &fip_desc_table);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    for (i = 0; i < fip_count; i++) {
-        fip_desc = &fip_desc_table[i];
-        if (fip_desc->type != n1sdp_rom_ctx.rom_config->image_type)
-            continue;
-
-        if (fip_desc->size == 0)
-            return FWK_E_DATA;
-
-        if (fip_desc->type == MOD_N1SDP_FIP_TYPE_MCP_BL2) {
-            n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                "[ROM] Found MCP RAM Firmware at address: 0x%x,"
-                " size: %d bytes, flags: 0x%x\n",
-                fip_desc->address,
-                fip_desc->size,
-                fip_desc->flags);
-                n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                "[ROM] Copying MCP RAM Firmware to ITCRAM...!\n");
-        } else {
-            n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                "[ROM] Found SCP BL2 RAM Firmware at address: 0x%x,"
-                " size: %d bytes, flags: 0x%x\n",
-                fip_desc->address,
-                fip_desc->size,
-                fip_desc->flags);
-                n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                "[ROM] Copying SCP RAM Firmware to ITCRAM...!\n");
-        }
-        break;
-    }
 
-    if (i >= fip_count)
+    if (fip_desc->size == 0)
         return FWK_E_DATA;
 
-    memcpy((void *)n1sdp_rom_ctx.rom_config->ramfw_base,
-        (uint8_t *)fip_desc->address, fip_desc->size);
-    n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO, "[ROM] Done!\n");
+    if (fip_desc->type == MOD_N1SDP_FIP_TYPE_MCP_BL2) {
+        MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[ROM] Found MCP RAM Firmware at address: 0x%x,"
+            " size: %d bytes, flags: 0x%x\n",
+            fip_desc->address,
+            fip_desc->size,
+            fip_desc->flags);
+            MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[ROM] Copying MCP RAM Firmware to ITCRAM...!\n");
+    } else {
+        MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[ROM] Found SCP BL2 RAM Firmware at address: 0x%x,"
+            " size: %d bytes, flags: 0x%x\n",
+            fip_desc->address,
+            fip_desc->size,
+            fip_desc->flags);
+            MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO,
+            "[ROM] Copying SCP RAM Firmware to ITCRAM...!\n");
+    }
+
+    /* The image is decompressed on the fly if it is compressed */
+    status = fwk_lz4_load_image((void *)n1sdp_rom_ctx.rom_config->ramfw_base,
+        n1sdp_rom_ctx.rom_config->ramfw_size,
+        (const void *)fip_desc->address, fip_desc->size, &size);
+    if (status != FWK_SUCCESS)
+        return status;
+    MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO, "[ROM] Done!\n");
 
-    n1sdp_rom_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_rom_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[ROM] Jumping to RAM Firmware\n");
 
     jump_to_ramfw();
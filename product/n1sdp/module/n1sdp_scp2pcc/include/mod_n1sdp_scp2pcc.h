@@ -11,7 +11,11 @@
 #ifndef MOD_N1SDP_SCP2PCC_H
 #define MOD_N1SDP_SCP2PCC_H
 
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
 #include <internal/n1sdp_scp2pcc.h>
+
 /*!
  * \addtogroup GroupN1SDPModule N1SDP Product Modules
  * @{
@@ -41,6 +45,52 @@ struct mem_msg_config_st {
     uintptr_t shared_rx_buffer;
     /*! Number of RX packets allocated */
     unsigned int shared_num_rx;
+    /*!
+     * Identifier of the alarm polling the acknowledgement of the TX packets
+     * by the PCC.
+     */
+    fwk_id_t alarm_id;
+    /*!
+     * Polling period of the acknowledgement of the TX packets in
+     * milliseconds. When zero, the messages cannot be sent asynchronously.
+     */
+    unsigned int ack_poll_period_ms;
+};
+
+/*!
+ * \brief SCP to PCC event indices.
+ */
+enum mod_n1sdp_scp2pcc_event_idx {
+    /*!
+     * Message acknowledged by the PCC. The response to the event, with
+     * \ref mod_n1sdp_scp2pcc_resp_params parameters, is sent to the entity
+     * whose message was sent asynchronously once the PCC has released the
+     * TX packet of the message.
+     */
+    MOD_N1SDP_SCP2PCC_EVENT_IDX_ACK,
+
+    /*! Number of defined events */
+    MOD_N1SDP_SCP2PCC_EVENT_IDX_COUNT
+};
+
+#if BUILD_HAS_MOD_N1SDP_SCP2PCC
+/*!
+ * \brief Identifier for the \ref MOD_N1SDP_SCP2PCC_EVENT_IDX_ACK event.
+ */
+static const fwk_id_t mod_n1sdp_scp2pcc_event_id_ack =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_N1SDP_SCP2PCC,
+                      MOD_N1SDP_SCP2PCC_EVENT_IDX_ACK);
+#endif
+
+/*!
+ * \brief Parameters of the response to the
+ *     \ref MOD_N1SDP_SCP2PCC_EVENT_IDX_ACK event.
+ */
+struct mod_n1sdp_scp2pcc_resp_params {
+    /*! Status of the message */
+    int status;
+    /*! Sequence number of the message */
+    unsigned int sequence;
 };
 
 /*!
@@ -58,6 +108,27 @@ struct mod_n1sdp_scp2pcc_api {
      * \return One of the other specific error codes described by the framework.
      */
     int (*send)(void *data, uint16_t size, uint16_t type);
+
+    /*!
+     * \brief Function to send data from SCP to PCC without waiting for the
+     *     acknowledgement of the PCC.
+     *
+     * \details The message is written to a TX packet before the function
+     *      returns. Once the PCC has released the packet, the response to the
+     *      \ref MOD_N1SDP_SCP2PCC_EVENT_IDX_ACK event is sent to the calling
+     *      entity. The function must be called while an event of the calling
+     *      entity is processed.
+     *
+     * \param data Data payload.
+     * \param size Size of the payload to be sent.
+     * \param type Indicates the type of payload sent.
+     *
+     * \retval FWK_PENDING The message was sent, the acknowledgement is
+     *      pending.
+     * \retval FWK_E_SUPPORT The acknowledgement polling is not configured.
+     * \return One of the other specific error codes described by the framework.
+     */
+    int (*send_async)(void *data, uint16_t size, uint16_t type);
 };
 
 /*!
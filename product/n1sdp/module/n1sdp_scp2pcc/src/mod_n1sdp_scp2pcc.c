@@ -8,11 +8,41 @@
  *     N1SDP SCP to PCC communications protocol driver
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <fwk_errno.h>
+#include <fwk_mem.h>
+#include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <mod_log.h>
 #include <mod_n1sdp_scp2pcc.h>
+#include <mod_timer.h>
+
+/* Context of a TX packet waiting for its acknowledgement by the PCC */
+struct scp2pcc_tx_ctx {
+    /* Entity the acknowledgement is sent to */
+    fwk_id_t requester_id;
+
+    /* Cookie of the acknowledgement request */
+    uint32_t cookie;
+
+    /* Sequence number of the message written to the packet */
+    unsigned int sequence;
+
+    /* The packet is reserved for an asynchronous message */
+    bool pending;
+
+    /* The acknowledgement request of the packet has been processed */
+    bool waiting;
+};
+
+/* Parameters of the acknowledgement request */
+struct scp2pcc_ack_params {
+    /* Index of the TX packet of the message */
+    unsigned int tx_index;
+};
 
 /* Module context */
 struct n1sdp_scp2pcc_ctx {
@@ -24,6 +54,15 @@ struct n1sdp_scp2pcc_ctx {
 
     /* Sequence variable */
     unsigned int sequence;
+
+    /* Alarm API pointer, NULL when asynchronous messages are not supported */
+    const struct mod_timer_alarm_api *alarm_api;
+
+    /* Table of the TX packet contexts */
+    struct scp2pcc_tx_ctx *tx_ctx_table;
+
+    /* Number of TX packets waiting for their acknowledgement */
+    unsigned int waiting_count;
 };
 
 static struct n1sdp_scp2pcc_ctx scp2pcc_ctx;
@@ -33,12 +72,67 @@ static void wrdmemset(void *ptr, unsigned int value)
     ((unsigned int *)ptr)[0] = value;
 }
 
-static void wrdmemcpy(void *destination, const void *source, unsigned int num)
+static struct mem_msg_packet_st *get_tx_packet(unsigned int index)
+{
+    return (struct mem_msg_packet_st *)(scp2pcc_ctx.config->shared_tx_buffer +
+        (index * sizeof(struct mem_msg_packet_st)));
+}
+
+static void send_ack(struct scp2pcc_tx_ctx *tx_ctx, int status)
+{
+    struct fwk_event resp_event = {
+        .id = mod_n1sdp_scp2pcc_event_id_ack,
+        .source_id = FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SCP2PCC),
+        .target_id = tx_ctx->requester_id,
+        .cookie = tx_ctx->cookie,
+        .is_response = true,
+        .is_delayed_response = true,
+    };
+    struct mod_n1sdp_scp2pcc_resp_params *resp_params =
+        (struct mod_n1sdp_scp2pcc_resp_params *)resp_event.params;
+
+    resp_params->status = status;
+    resp_params->sequence = tx_ctx->sequence;
+
+    tx_ctx->pending = false;
+    tx_ctx->waiting = false;
+    scp2pcc_ctx.waiting_count--;
+
+    if (fwk_thread_put_event(&resp_event) != FWK_SUCCESS) {
+        MOD_LOG(scp2pcc_ctx.log_api, MOD_LOG_GROUP_ERROR,
+                "[SCP2PCC] Acknowledgement could not be sent\n");
+    }
+}
+
+/*
+ * Send the acknowledgement of the TX packets released by the PCC. When the
+ * shared memory is reset, all the pending messages fail instead.
+ */
+static void poll_tx_packets(bool reset)
 {
     unsigned int index;
+    unsigned int waiting_count = scp2pcc_ctx.waiting_count;
+    struct scp2pcc_tx_ctx *tx_ctx;
+    volatile struct mem_msg_packet_st *packet;
 
-    for (index = 0; index < num; index++)
-        ((unsigned int *)destination)[index] = ((unsigned int *)source)[index];
+    for (index = 0; index < scp2pcc_ctx.config->shared_num_tx; index++) {
+        tx_ctx = &scp2pcc_ctx.tx_ctx_table[index];
+        packet = get_tx_packet(index);
+
+        if (!tx_ctx->waiting) {
+            /* The request of the packet fails when it is processed */
+            if (reset)
+                tx_ctx->pending = false;
+        } else if (reset) {
+            send_ack(tx_ctx, FWK_E_STATE);
+        } else if ((packet->type == MSG_UNUSED_MESSAGE_TYPE) ||
+                   (packet->sequence != tx_ctx->sequence)) {
+            send_ack(tx_ctx, FWK_SUCCESS);
+        }
+    }
+
+    if ((waiting_count != 0) && (scp2pcc_ctx.waiting_count == 0))
+        scp2pcc_ctx.alarm_api->stop(scp2pcc_ctx.config->alarm_id);
 }
 
 static void reset_shared_memory(void)
@@ -61,21 +155,26 @@ static void reset_shared_memory(void)
 
         wrdmemset(&packet->type, MSG_UNUSED_MESSAGE_TYPE);
     }
+
+    if (scp2pcc_ctx.alarm_api != NULL)
+        poll_tx_packets(true);
 }
 
-static int mem_msg_send_message(void *data, uint16_t size, uint16_t type)
+static int mem_msg_write_packet(void *data, uint16_t size, uint16_t type,
+    unsigned int *tx_index)
 {
     unsigned int index;
     struct mem_msg_packet_st *packet = NULL;
 
     if (type == SCP2PCC_TYPE_SHUTDOWN)
-        scp2pcc_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                                 "Shutdown request to PCC\n");
+        MOD_LOG(scp2pcc_ctx.log_api, MOD_LOG_GROUP_INFO,
+                                     "Shutdown request to PCC\n");
 
     /* Check parameters. */
     if ((size > MSG_PAYLOAD_SIZE) ||
         (type == MSG_UNUSED_MESSAGE_TYPE)) {
-        scp2pcc_ctx.log_api->log(MOD_LOG_GROUP_INFO, "Invalid parameters\n");
+        MOD_LOG(scp2pcc_ctx.log_api, MOD_LOG_GROUP_INFO,
+                "Invalid parameters\n");
         return FWK_E_PARAM;
     }
 
@@ -94,14 +193,17 @@ static int mem_msg_send_message(void *data, uint16_t size, uint16_t type)
     /* Find unused TX packet. */
     for (index = 0; index < scp2pcc_ctx.config->shared_num_tx; index++) {
         /* Get pointer to packet. */
-        packet = (struct mem_msg_packet_st *)
-                 (scp2pcc_ctx.config->shared_tx_buffer +
-                  (index * sizeof(struct mem_msg_packet_st)));
+        packet = get_tx_packet(index);
+
+        /* Packets still owned by an asynchronous message are skipped. */
+        if ((scp2pcc_ctx.tx_ctx_table != NULL) &&
+            scp2pcc_ctx.tx_ctx_table[index].pending)
+            continue;
 
         if (packet->type == MSG_UNUSED_MESSAGE_TYPE) {
             /* Unused packet found, copy data payload. */
             if (data != NULL)
-                wrdmemcpy((void *)&packet->payload, data, (size / 4));
+                fwk_mem_write_words(&packet->payload, data, size);
 
             /* Set size. */
             wrdmemset((void *)&packet->size, size);
@@ -114,6 +216,8 @@ static int mem_msg_send_message(void *data, uint16_t size, uint16_t type)
             /* Set type last since it is a sort of valid indicator. */
             wrdmemset((void *)&packet->type, type);
 
+            *tx_index = index;
+
             return FWK_SUCCESS;
         }
     }
@@ -121,8 +225,49 @@ static int mem_msg_send_message(void *data, uint16_t size, uint16_t type)
     return FWK_E_NOMEM;
 }
 
+static int mem_msg_send_message(void *data, uint16_t size, uint16_t type)
+{
+    unsigned int tx_index;
+
+    return mem_msg_write_packet(data, size, type, &tx_index);
+}
+
+static int mem_msg_send_message_async(void *data, uint16_t size, uint16_t type)
+{
+    int status;
+    struct fwk_event event = {
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SCP2PCC),
+        .id = mod_n1sdp_scp2pcc_event_id_ack,
+        .response_requested = true,
+    };
+    struct scp2pcc_ack_params *params =
+        (struct scp2pcc_ack_params *)event.params;
+    struct scp2pcc_tx_ctx *tx_ctx;
+
+    if (scp2pcc_ctx.alarm_api == NULL)
+        return FWK_E_SUPPORT;
+
+    status = mem_msg_write_packet(data, size, type, &params->tx_index);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    /* Reserve the packet until the PCC has released it */
+    tx_ctx = &scp2pcc_ctx.tx_ctx_table[params->tx_index];
+    tx_ctx->sequence = get_tx_packet(params->tx_index)->sequence;
+    tx_ctx->pending = true;
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS) {
+        tx_ctx->pending = false;
+        return status;
+    }
+
+    return FWK_PENDING;
+}
+
 static const struct mod_n1sdp_scp2pcc_api n1sdp_scp2pcc_api = {
     .send = mem_msg_send_message,
+    .send_async = mem_msg_send_message_async,
 };
 
 static int n1sdp_scp2pcc_init(fwk_id_t module_id, unsigned int unused,
@@ -135,14 +280,30 @@ static int n1sdp_scp2pcc_init(fwk_id_t module_id, unsigned int unused,
 
     *(scp2pcc_ctx.config->shared_alive_address) = MSG_ALIVE_VALUE;
 
+    if (scp2pcc_ctx.config->ack_poll_period_ms != 0) {
+        scp2pcc_ctx.tx_ctx_table = fwk_mm_calloc(
+            scp2pcc_ctx.config->shared_num_tx, sizeof(struct scp2pcc_tx_ctx));
+        if (scp2pcc_ctx.tx_ctx_table == NULL)
+            return FWK_E_NOMEM;
+    }
+
     return FWK_SUCCESS;
 }
 
 static int n1sdp_scp2pcc_bind(fwk_id_t id, unsigned int round)
 {
+    int status;
+
     if (round == 0) {
-        return fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
+        status = fwk_module_bind(FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
             MOD_LOG_API_ID, &scp2pcc_ctx.log_api);
+        if (status != FWK_SUCCESS)
+            return status;
+
+        if (scp2pcc_ctx.config->ack_poll_period_ms != 0) {
+            return fwk_module_bind(scp2pcc_ctx.config->alarm_id,
+                MOD_TIMER_API_ID_ALARM, &scp2pcc_ctx.alarm_api);
+        }
     }
 
     return FWK_SUCCESS;
@@ -164,12 +325,54 @@ static int n1sdp_scp2pcc_start(fwk_id_t id)
     return FWK_SUCCESS;
 }
 
+static int n1sdp_scp2pcc_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    struct scp2pcc_ack_params *params;
+    struct scp2pcc_tx_ctx *tx_ctx;
+
+    /* Periodic poll of the TX packets waiting for their acknowledgement */
+    if (fwk_id_is_equal(event->id, mod_timer_event_id_alarm)) {
+        poll_tx_packets(false);
+        return FWK_SUCCESS;
+    }
+
+    if (!fwk_id_is_equal(event->id, mod_n1sdp_scp2pcc_event_id_ack))
+        return FWK_E_PARAM;
+
+    params = (struct scp2pcc_ack_params *)event->params;
+    tx_ctx = &scp2pcc_ctx.tx_ctx_table[params->tx_index];
+
+    /* The shared memory was reset before the request was processed */
+    if (!tx_ctx->pending) {
+        ((struct mod_n1sdp_scp2pcc_resp_params *)resp_event->params)->status =
+            FWK_E_STATE;
+        return FWK_SUCCESS;
+    }
+
+    tx_ctx->requester_id = event->source_id;
+    tx_ctx->cookie = event->cookie;
+    tx_ctx->waiting = true;
+    resp_event->is_delayed_response = true;
+
+    /* The first waiting packet starts the polling */
+    if (++scp2pcc_ctx.waiting_count == 1) {
+        return scp2pcc_ctx.alarm_api->start(scp2pcc_ctx.config->alarm_id,
+            scp2pcc_ctx.config->ack_poll_period_ms,
+            MOD_TIMER_ALARM_TYPE_PERIODIC, NULL, 0);
+    }
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_n1sdp_scp2pcc = {
     .name = "N1SDP_SCP2PCC",
     .api_count = 1,
+    .event_count = MOD_N1SDP_SCP2PCC_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = n1sdp_scp2pcc_init,
     .bind = n1sdp_scp2pcc_bind,
     .process_bind_request = n1sdp_scp2pcc_process_bind_request,
     .start = n1sdp_scp2pcc_start,
+    .process_event = n1sdp_scp2pcc_process_event,
 };
@@ -16,6 +16,9 @@
 #include <fwk_notification.h>
 #include <mod_log.h>
 #include <mod_power_domain.h>
+#if BUILD_HAS_MOD_SCMI_AGENT
+#include <mod_scmi_agent.h>
+#endif
 #include <mod_smt.h>
 #include <internal/smt.h>
 
@@ -43,6 +46,11 @@ struct smt_channel_ctx {
 
     /* Driver API */
     struct mod_smt_driver_api *driver_api;
+
+#if BUILD_HAS_MOD_SCMI_AGENT
+    /* SCMI agent transport input API, for the master channels */
+    const struct mod_scmi_agent_transport_input_api *agent_api;
+#endif
 };
 
 struct smt_ctx {
@@ -377,6 +385,13 @@ static int smt_master_handler(struct smt_channel_ctx *channel_ctx)
     payload_size = in->length - sizeof(in->message_header);
     memcpy(in->payload, memory->payload, payload_size);
 
+#if BUILD_HAS_MOD_SCMI_AGENT
+    /* Signal the response to the SCMI agent bound to the channel */
+    if (channel_ctx->agent_api != NULL)
+        return channel_ctx->agent_api->signal_response(
+            channel_ctx->scmi_service_id);
+#endif
+
     return FWK_SUCCESS;
 }
 
@@ -447,6 +462,7 @@ static int smt_channel_init(fwk_id_t channel_id, unsigned int unused,
     }
 
     channel_ctx->id = channel_id;
+    channel_ctx->scmi_service_id = FWK_ID_NONE;
     channel_ctx->in = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
     channel_ctx->out = fwk_mm_alloc(1, channel_ctx->config->mailbox_size);
 
@@ -484,8 +500,26 @@ static int smt_bind(fwk_id_t id, unsigned int round)
         if (status != FWK_SUCCESS)
             return status;
         channel_ctx->driver_id = channel_ctx->config->driver_id;
+
+        return FWK_SUCCESS;
     }
 
+#if BUILD_HAS_MOD_SCMI_AGENT
+    if (!fwk_id_is_type(id, FWK_ID_TYPE_ELEMENT))
+        return FWK_SUCCESS;
+
+    /* Bind back to the SCMI agent bound to a master channel */
+    channel_ctx = &smt_ctx.channel_ctx_table[fwk_id_get_element_idx(id)];
+    if ((channel_ctx->config->type == MOD_SMT_CHANNEL_TYPE_MASTER) &&
+        !fwk_id_is_equal(channel_ctx->scmi_service_id, FWK_ID_NONE) &&
+        (fwk_id_get_module_idx(channel_ctx->scmi_service_id) ==
+         FWK_MODULE_IDX_SCMI_AGENT)) {
+        return fwk_module_bind(channel_ctx->scmi_service_id,
+                               mod_scmi_agent_api_id_transport_input,
+                               &channel_ctx->agent_api);
+    }
+#endif
+
     return FWK_SUCCESS;
 }
 
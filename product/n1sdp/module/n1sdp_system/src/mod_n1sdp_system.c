@@ -15,6 +15,7 @@
 #include <fwk_id.h>
 #include <fwk_interrupt.h>
 #include <fwk_macros.h>
+#include <fwk_mem.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
@@ -22,6 +23,7 @@
 #include <mod_clock.h>
 #include <mod_n1sdp_dmc620.h>
 #include <mod_n1sdp_flash.h>
+#include <mod_n1sdp_pcie.h>
 #include <mod_n1sdp_system.h>
 #include <mod_log.h>
 #include <mod_power_domain.h>
@@ -232,15 +234,15 @@ static int n1sdp_system_copy_to_ap_sram(uint64_t sram_address,
 {
     uint32_t target_addr = (uint32_t)sram_address;
 
-    memcpy((void *)target_addr, (void *)spi_address, size);
+    fwk_mem_copy((void *)target_addr, (const void *)spi_address, size);
 
     if (memcmp((void *)target_addr, (void *)spi_address, size) != 0) {
-        n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
             "[N1SDP SYSTEM] Copy failed at destination address: 0x%08x\n",
             target_addr);
             return FWK_E_DATA;
     }
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Copied binary to SRAM address: 0x%08x\n",
         sram_address);
     return FWK_SUCCESS;
@@ -248,10 +250,10 @@ static int n1sdp_system_copy_to_ap_sram(uint64_t sram_address,
 
 void cdbg_pwrupreq_handler(void)
 {
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Received debug power up request interrupt\n");
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Power on Debug PIK\n");
 
     /* Clear interrupt */
@@ -261,7 +263,7 @@ void cdbg_pwrupreq_handler(void)
 
 void csys_pwrupreq_handler(void)
 {
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Received system power up request interrupt\n");
 
     /* Clear interrupt */
@@ -282,11 +284,11 @@ static int n1sdp_system_fill_mem_info(void)
     ddr_size_gb = 0;
     status = n1sdp_system_ctx.dmc620_api->get_mem_size_gb(&ddr_size_gb);
     if (status != FWK_SUCCESS) {
-        n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+        MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
             "Error calculating DDR memory size!\n");
         return status;
     }
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "    Total DDR Size: %d GB\n", ddr_size_gb);
 
     sds_ddr_mem_info.ddr_size_gb = ddr_size_gb;
@@ -313,65 +315,51 @@ static int n1sdp_system_init_primary_core(void)
 {
     int status;
     struct mod_pd_restricted_api *mod_pd_restricted_api = NULL;
-    struct mod_n1sdp_fip_descriptor *fip_desc_table = NULL;
-    unsigned int fip_count;
-    unsigned int i;
+    struct mod_n1sdp_fip_descriptor *fip_desc_bl31 = NULL;
     unsigned int core_idx;
     unsigned int cluster_idx;
     unsigned int cluster_count;
-    int fip_index_bl31 = -1;
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Looking for AP firmware in flash memory...\n");
 
-    status = n1sdp_system_ctx.flash_api->get_n1sdp_fip_descriptor_count(
-        FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SYSTEM), &fip_count);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    status = n1sdp_system_ctx.flash_api->get_n1sdp_fip_descriptor_table(
-        FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SYSTEM), &fip_desc_table);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    for (i = 0; i < fip_count; i++) {
-        if (fip_desc_table[i].type == MOD_N1SDP_FIP_TYPE_TF_BL31) {
-            n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
-                "[N1SDP SYSTEM] Found BL31 at address: 0x%08x,"
-                " size: %u, flags: 0x%x\n",
-                fip_desc_table[i].address, fip_desc_table[i].size,
-                fip_desc_table[i].flags);
-            fip_index_bl31 = i;
-            break;
-        }
-    }
-
-    if (fip_index_bl31 < 0) {
-        n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    status = n1sdp_system_ctx.flash_api->get_n1sdp_fip_descriptor(
+        FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_SYSTEM),
+        MOD_N1SDP_FIP_TYPE_TF_BL31, &fip_desc_bl31);
+    if (status == FWK_E_DATA) {
+        MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
             "[N1SDP SYSTEM] Error! "
             "FIP does not have BL31 binary\n");
         return FWK_E_PANIC;
     }
+    if (status != FWK_SUCCESS)
+        return status;
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
+        "[N1SDP SYSTEM] Found BL31 at address: 0x%08x,"
+        " size: %u, flags: 0x%x\n",
+        fip_desc_bl31->address, fip_desc_bl31->size,
+        fip_desc_bl31->flags);
+
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Copying AP BL31 to address 0x%x...\n",
         AP_CORE_RESET_ADDR);
 
     status = n1sdp_system_copy_to_ap_sram(AP_CORE_RESET_ADDR,
-                 fip_desc_table[fip_index_bl31].address,
-                 fip_desc_table[fip_index_bl31].size);
+                 fip_desc_bl31->address,
+                 fip_desc_bl31->size);
     if (status != FWK_SUCCESS)
         return FWK_E_PANIC;
 
     /* Fill memory information structure */
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Collecting memory information...\n");
     status = n1sdp_system_fill_mem_info();
     if (status != FWK_SUCCESS)
         return status;
 
     /* Fill BL33 image information structure */
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Collecting memory information...\n");
     status = n1sdp_system_fill_bl33_info();
     if (status != FWK_SUCCESS)
@@ -379,7 +367,7 @@ static int n1sdp_system_init_primary_core(void)
 
     mod_pd_restricted_api = n1sdp_system_ctx.mod_pd_restricted_api;
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_INFO,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
         "[N1SDP SYSTEM] Setting AP Reset Address to 0x%08x\n",
         AP_CORE_RESET_ADDR - AP_SCP_SRAM_OFFSET);
 
@@ -396,7 +384,7 @@ static int n1sdp_system_init_primary_core(void)
         }
     }
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
         "[N1SDP SYSTEM] Booting primary core at %d MHz...\n",
         PIK_CLK_RATE_CLUS0_CPU / FWK_MHZ);
 
@@ -515,6 +503,21 @@ static int n1sdp_system_start(fwk_id_t id)
     if (status != FWK_SUCCESS)
         return status;
 
+    /*
+     * The PCIe controllers train their link in parallel. Subscribe to their
+     * initialized notifications so that the primary core boots once the PCIe
+     * buses can be enumerated.
+     */
+    for (i = 0; i < (unsigned int)fwk_module_get_element_count(
+                        FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_PCIE)); i++) {
+        status = fwk_notification_subscribe(
+            mod_n1sdp_pcie_notification_id_initialized,
+            FWK_ID_ELEMENT(FWK_MODULE_IDX_N1SDP_PCIE, i),
+            id);
+        if (status != FWK_SUCCESS)
+            return status;
+    }
+
     status = fwk_interrupt_set_isr(CDBG_PWR_UP_REQ_IRQ, cdbg_pwrupreq_handler);
     if (status == FWK_SUCCESS) {
         fwk_interrupt_enable(CDBG_PWR_UP_REQ_IRQ);
@@ -535,13 +538,13 @@ static int n1sdp_system_start(fwk_id_t id)
             CS_CNTCONTROL->CS_CNTCVLW = 0x00000000;
             CS_CNTCONTROL->CS_CNTCVUP = 0x0000FFFF;
         } else
-            n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+            MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
                 "[N1SDP SYSTEM] CSYS PWR UP REQ IRQ register failed\n");
     } else
-        n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
             "[N1SDP SYSTEM] CDBG PWR UP REQ IRQ register failed\n");
 
-    n1sdp_system_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_DEBUG,
         "[N1SDP SYSTEM] Requesting SYSTOP initialization...\n");
 
     /*
@@ -581,34 +584,60 @@ static int n1sdp_system_process_notification(const struct fwk_event *event,
     struct fwk_event *resp_event)
 {
     struct clock_notification_params *params = NULL;
+    struct mod_n1sdp_pcie_notification_params *pcie_params = NULL;
     static unsigned int scmi_notification_count = 0;
     static bool sds_notification_received = false;
+    static bool interconnect_running = false;
+    static unsigned int pcie_notification_count = 0;
     int status;
 
     assert(fwk_id_is_type(event->target_id, FWK_ID_TYPE_MODULE));
 
     params = (struct clock_notification_params *)event->params;
 
-    if (fwk_id_is_equal(event->id, mod_clock_notification_id_state_changed)) {
+    if (fwk_id_is_equal(event->id, mod_clock_notification_id_state_changed) ||
+        fwk_id_is_equal(event->id,
+                        mod_n1sdp_pcie_notification_id_initialized)) {
+        if (fwk_id_is_equal(event->id,
+                            mod_n1sdp_pcie_notification_id_initialized)) {
+            pcie_params =
+                (struct mod_n1sdp_pcie_notification_params *)event->params;
+            if (pcie_params->status != FWK_SUCCESS) {
+                MOD_LOG(n1sdp_system_ctx.log_api, MOD_LOG_GROUP_INFO,
+                    "[N1SDP SYSTEM] %s setup failed\n",
+                    fwk_module_get_name(event->source_id));
+            }
+            pcie_notification_count++;
+        } else if (params->new_state == MOD_CLOCK_STATE_RUNNING) {
+            interconnect_running = true;
+        } else
+            return FWK_SUCCESS;
+
+        /*
+         * Unsubscribe from the notification as it has to be processed only
+         * once during system startup.
+         */
+        status = fwk_notification_unsubscribe(event->id, event->source_id,
+                                              event->target_id);
+        if (status != FWK_SUCCESS)
+            return status;
 
         /*
          * Initialize primary core when the system is initialized for the
-         * first time only.
+         * first time and the PCIe controllers are set up.
          */
-        if (params->new_state == MOD_CLOCK_STATE_RUNNING) {
-            status = n1sdp_system_init_primary_core();
-            if (status != FWK_SUCCESS)
-                return status;
-
-            /*
-             * Unsubscribe to interconnect clock state change notification as
-             * it has to be processed only once during system startup.
-             */
-            return fwk_notification_unsubscribe(event->id, event->source_id,
-                                                event->target_id);
-        }
+        if (!interconnect_running ||
+            (pcie_notification_count != (unsigned int)
+                fwk_module_get_element_count(
+                    FWK_ID_MODULE(FWK_MODULE_IDX_N1SDP_PCIE))))
+            return FWK_SUCCESS;
 
-        return FWK_SUCCESS;
+        status = n1sdp_system_init_primary_core();
+        if (status != FWK_SUCCESS)
+            return status;
+
+        /* Start the modules that are not needed to boot the AP */
+        return fwk_module_start_deferred();
     } else if (fwk_id_is_equal(event->id,
                                mod_scmi_notification_id_initialized)) {
         scmi_notification_count++;
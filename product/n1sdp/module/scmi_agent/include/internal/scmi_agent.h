@@ -0,0 +1,58 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *     SCMI Agent Support, compound protocol definitions.
+ */
+
+#ifndef SCMI_AGENT_H
+#define SCMI_AGENT_H
+
+#include <stdint.h>
+
+#define SCMI_AGENT_MESSAGE_HEADER_MESSAGE_ID_POS  0
+#define SCMI_AGENT_MESSAGE_HEADER_PROTOCOL_ID_POS 10
+
+#define SCMI_AGENT_MESSAGE_HEADER_MESSAGE_ID_MASK \
+    (UINT32_C(0x3FF) << SCMI_AGENT_MESSAGE_HEADER_MESSAGE_ID_POS)
+#define SCMI_AGENT_MESSAGE_HEADER_PROTOCOL_ID_MASK \
+    (UINT32_C(0xFF) << SCMI_AGENT_MESSAGE_HEADER_PROTOCOL_ID_POS)
+
+#define SCMI_AGENT_MESSAGE_HEADER(MESSAGE_ID, PROTOCOL_ID) \
+    ((((MESSAGE_ID) << SCMI_AGENT_MESSAGE_HEADER_MESSAGE_ID_POS) & \
+        SCMI_AGENT_MESSAGE_HEADER_MESSAGE_ID_MASK) | \
+    (((PROTOCOL_ID) << SCMI_AGENT_MESSAGE_HEADER_PROTOCOL_ID_POS) & \
+        SCMI_AGENT_MESSAGE_HEADER_PROTOCOL_ID_MASK))
+
+/* COMPOUND_EXECUTE command of the compound protocol of the platform */
+#define SCMI_AGENT_COMPOUND_EXECUTE 0x003
+
+/*
+ * The fixed part of the COMPOUND_EXECUTE command is followed by the commands,
+ * each made of a scmi_agent_compound_command structure followed by the
+ * payload of the command, padded to a multiple of four bytes. The fixed part
+ * of the response is followed by the responses to the commands executed, in
+ * the same format.
+ */
+
+struct __attribute((packed)) scmi_agent_compound_command {
+    /* SCMI message header of the command or of its response */
+    uint32_t message_header;
+
+    /* Size in bytes of the payload, without padding */
+    uint32_t payload_size;
+};
+
+struct __attribute((packed)) scmi_agent_compound_execute_a2p {
+    uint32_t command_count;
+};
+
+struct __attribute((packed)) scmi_agent_compound_execute_p2a {
+    int32_t status;
+    uint32_t command_count;
+};
+
+#endif /* SCMI_AGENT_H */
@@ -11,6 +11,10 @@
 #ifndef MOD_SCMI_AGENT_H
 #define MOD_SCMI_AGENT_H
 
+#include <stdint.h>
+#include <fwk_id.h>
+#include <fwk_module_idx.h>
+
 /*!
  * \addtogroup GroupN1SDPModule N1SDP Product Modules
  * @{
@@ -59,63 +63,149 @@ struct mod_scmi_agent_config {
      * \brief Identifier of the API of the transport entity.
      */
     fwk_id_t transport_api_id;
+
+    /*!
+     * \brief SCMI identifier of the compound protocol of the platform, zero if
+     *      the platform does not implement it.
+     *
+     * \details When the platform implements the compound protocol, the
+     *      requests queued while a command is in progress on the channel of
+     *      the agent are sent together, in a single COMPOUND_EXECUTE command,
+     *      once the command in progress has completed. The platform executes
+     *      them in order up to the first one failing, and a single round trip
+     *      on the channel completes all of them.
+     */
+    uint8_t compound_protocol_id;
 };
 
 /*!
- * \brief SCMI Management Agent API Interface
+ * \brief Number of return values of a response delivered in a response event.
+ */
+#define MOD_SCMI_AGENT_RETURN_VALUE_COUNT 2
+
+/*!
+ * \brief Maximum number of parameters of a command sent in a request event.
+ */
+#define MOD_SCMI_AGENT_PARAMETER_COUNT 2
+
+/*!
+ * \brief Event indices.
+ */
+enum mod_scmi_agent_event_idx {
+    /*! Request event, see \ref mod_scmi_agent_event_id_request */
+    MOD_SCMI_AGENT_EVENT_IDX_REQUEST,
+
+    /*! Number of public events */
+    MOD_SCMI_AGENT_EVENT_IDX_COUNT,
+};
+
+/*!
+ * \brief Request event identifier.
  *
- * \details Interface used for MCP System -> SCMI Agent.
+ * \details Event sent to an agent to send a command of the management
+ *      protocol to the platform, with the parameters described by
+ *      ::mod_scmi_agent_request_params. The event is processed without
+ *      waiting for the platform: the response event is delivered once the
+ *      platform has responded, on the completion interrupt of the channel of
+ *      the agent, with the parameters described by
+ *      ::mod_scmi_agent_response_params.
+ *
+ *      The requests made to an agent while a command is in progress on its
+ *      channel are queued, the agents with different channels have their
+ *      commands in progress concurrently.
+ */
+static const fwk_id_t mod_scmi_agent_event_id_request =
+    FWK_ID_EVENT_INIT(FWK_MODULE_IDX_SCMI_AGENT,
+                      MOD_SCMI_AGENT_EVENT_IDX_REQUEST);
+
+/*!
+ * \brief Parameters of the request event.
  */
-struct mod_scmi_agent_api {
+struct mod_scmi_agent_request_params {
     /*!
-     * \brief Get the management protocol version from SCP
-     *
-     * \param agent_id Agent identifier
-     * \param[out] version Protocol version.
-     *
-     * \retval FWK_SUCCESS The operation succeeded.
-     * \return One of the standard error codes for implementation-defined
-     * errors.
+     * \brief Message identifier, see ::scmi_management_message_id for the
+     *      commands of the management protocol.
      */
-    int (*get_protocol_version)(fwk_id_t agent_id, uint32_t *version);
+    uint32_t message_id;
 
     /*!
-     * \brief Get the PLL clock status from SCP
+     * \brief Protocol identifier of the command, zero for the management
+     *      protocol.
+     */
+    uint8_t protocol_id;
+
+    /*! Number of parameters of the command */
+    uint8_t parameter_count;
+
+    /*! Parameters of the command, its payload */
+    uint32_t parameters[MOD_SCMI_AGENT_PARAMETER_COUNT];
+};
+
+/*!
+ * \brief Parameters of the response to the request event.
+ */
+struct mod_scmi_agent_response_params {
+    /*!
+     * \brief Status of the request.
      *
-     * \param agent_id Agent identifier
-     * \param[out] clock_status SCP clock status.
+     * \details FWK_E_BUSY if the queue of the requests of the agent was full,
+     *      FWK_E_PARAM if the request had too many parameters, FWK_E_DEVICE if
+     *      the platform responded with an error status or, for a request sent
+     *      in a COMPOUND_EXECUTE command, did not execute it because a command
+     *      before it failed.
+     */
+    int status;
+
+    /*! Message identifier of the request */
+    uint32_t message_id;
+
+    /*!
+     * \brief Return values of the response, following its status word.
      *
-     * \retval FWK_SUCCESS The operation succeeded.
-     * \return One of the standard error codes for implementation-defined
-     * errors.
+     * \details The return values not part of the response are equal to zero.
      */
-    int (*get_clock_status)(fwk_id_t agent_id, uint32_t *clock_status);
+    uint32_t return_values[MOD_SCMI_AGENT_RETURN_VALUE_COUNT];
+};
 
+/*!
+ * \brief Transport input API.
+ *
+ * \details Interface used for SMT -> SCMI Agent communication.
+ */
+struct mod_scmi_agent_transport_input_api {
     /*!
-     * \brief Get the chip ID information from SCP
+     * \brief Signal that the platform has responded to the command in
+     *      progress on the channel of an agent.
+     *
+     * \note May be called from an interrupt handler, the response is
+     *      processed in the thread context.
      *
      * \param agent_id Agent identifier
-     * \param[out] multichip_mode Multi-chip mode value.
-     * \param[out] chipid Chip ID value.
      *
      * \retval FWK_SUCCESS The operation succeeded.
      * \return One of the standard error codes for implementation-defined
      * errors.
      */
-    int (*get_chipid_info)(fwk_id_t agent_id, uint8_t *multichip_mode,
-                           uint8_t *chipid);
+    int (*signal_response)(fwk_id_t agent_id);
 };
 
 /*!
  * \brief API types exposed by SCMI agent module.
  */
 enum mod_scmi_agent_api_idx {
-    /*! API ID to be binded by system module */
-    MOD_SCMI_AGENT_API_IDX_SYSTEM,
+    /*! API ID to be bound by the transport of the agents */
+    MOD_SCMI_AGENT_API_IDX_TRANSPORT_INPUT,
     /*! API ID count */
     MOD_SCMI_AGENT_API_IDX_COUNT,
 };
 
+/*!
+ * \brief Transport input API identifier.
+ */
+static const fwk_id_t mod_scmi_agent_api_id_transport_input =
+    FWK_ID_API_INIT(FWK_MODULE_IDX_SCMI_AGENT,
+                    MOD_SCMI_AGENT_API_IDX_TRANSPORT_INPUT);
+
 /*!
  * @}
  */
@@ -8,7 +8,9 @@
  *     SCMI Agent Support.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <fwk_id.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
@@ -18,17 +20,69 @@
 #include <mod_log.h>
 #include <mod_scmi_agent.h>
 #include <mod_smt.h>
+#include <internal/scmi_agent.h>
+
+/* Maximum number of requests queued for an agent */
+#define SCMI_AGENT_REQUEST_QUEUE_LENGTH 4
+
+/* Size in words of the payload of a COMPOUND_EXECUTE command */
+#define SCMI_AGENT_COMPOUND_PAYLOAD_LENGTH \
+    ((sizeof(struct scmi_agent_compound_execute_a2p) + \
+      (SCMI_AGENT_REQUEST_QUEUE_LENGTH * \
+       (sizeof(struct scmi_agent_compound_command) + \
+        (MOD_SCMI_AGENT_PARAMETER_COUNT * sizeof(uint32_t))))) / \
+     sizeof(uint32_t))
+
+/* Request queued for an agent */
+struct scmi_agent_request {
+    /* Message identifier */
+    uint32_t message_id;
+
+    /* Protocol identifier */
+    uint8_t protocol_id;
+
+    /* Number of parameters */
+    uint8_t parameter_count;
+
+    /* Parameters of the command */
+    uint32_t parameters[MOD_SCMI_AGENT_PARAMETER_COUNT];
+
+    /* Cookie of the request event */
+    uint32_t cookie;
+
+    /* A response to the request event is expected */
+    bool response_requested;
+};
 
 /* SCMI agent context */
 struct scmi_agent_ctx {
+    /* Agent identifier */
+    fwk_id_t id;
+
     /* Pointer to agent configuration data */
     struct mod_scmi_agent_config *config;
 
-    /* Pointer to received payload data */
-    const void *payload;
+    /*
+     * Queue of the requests of the agent. The request at the head of the
+     * queue is in progress on the channel of the agent.
+     */
+    struct scmi_agent_request request_queue[SCMI_AGENT_REQUEST_QUEUE_LENGTH];
+
+    /* Index of the head of the queue of requests */
+    unsigned int request_head;
+
+    /* Number of requests in the queue */
+    unsigned int request_count;
 
-    /* Size of received payload */
-    size_t size;
+    /*
+     * Number of requests at the head of the queue whose commands are in
+     * progress, more than one when they were sent in a COMPOUND_EXECUTE
+     * command.
+     */
+    unsigned int batch_count;
+
+    /* Payload of the COMPOUND_EXECUTE commands */
+    uint32_t compound_payload[SCMI_AGENT_COMPOUND_PAYLOAD_LENGTH];
 };
 
 /* Module context */
@@ -44,134 +98,303 @@ struct mod_scmi_agent_module_ctx {
 };
 
 enum scmi_agent_event {
-    MOD_SCMI_AGENT_EVENT_RUN,
-    MOD_SCMI_AGENT_EVENT_COUNT,
+    SCMI_AGENT_EVENT_IDX_RUN = MOD_SCMI_AGENT_EVENT_IDX_COUNT,
+    SCMI_AGENT_EVENT_IDX_RESPONSE,
+    SCMI_AGENT_EVENT_COUNT,
 };
 
 static struct mod_scmi_agent_module_ctx ctx;
 
-static int _scmi_agent_transact(fwk_id_t agent_id,
-                               struct mod_smt_command_config *cmd)
+static struct scmi_agent_request *get_request(
+    struct scmi_agent_ctx *agent_ctx, unsigned int idx)
+{
+    return &agent_ctx->request_queue[(agent_ctx->request_head + idx) %
+                                     SCMI_AGENT_REQUEST_QUEUE_LENGTH];
+}
+
+/*
+ * Build the COMPOUND_EXECUTE command carrying the commands of all the requests
+ * queued for an agent.
+ */
+static void build_compound_command(struct scmi_agent_ctx *agent_ctx,
+                                   struct mod_smt_command_config *cmd)
+{
+    unsigned int idx, param_idx;
+    size_t offset = 0;
+    uint32_t *payload = agent_ctx->compound_payload;
+    const struct scmi_agent_request *request;
+
+    payload[offset++] = agent_ctx->request_count;
+
+    for (idx = 0; idx < agent_ctx->request_count; idx++) {
+        request = get_request(agent_ctx, idx);
+
+        payload[offset++] = SCMI_AGENT_MESSAGE_HEADER(request->message_id,
+                                                      request->protocol_id);
+        payload[offset++] = request->parameter_count * sizeof(uint32_t);
+        for (param_idx = 0; param_idx < request->parameter_count; param_idx++)
+            payload[offset++] = request->parameters[param_idx];
+    }
+
+    cmd->protocol_id = agent_ctx->config->compound_protocol_id;
+    cmd->message_id = SCMI_AGENT_COMPOUND_EXECUTE;
+    cmd->payload = payload;
+    cmd->size = offset * sizeof(uint32_t);
+
+    agent_ctx->batch_count = agent_ctx->request_count;
+}
+
+/*
+ * Send the command of the request at the head of the queue of an agent, or the
+ * commands of all the requests queued in a single COMPOUND_EXECUTE command if
+ * the platform implements the compound protocol.
+ */
+static int send_request(struct scmi_agent_ctx *agent_ctx)
 {
-    struct scmi_agent_ctx *agent_ctx;
     int status;
+    struct scmi_agent_request *request = get_request(agent_ctx, 0);
+    struct mod_smt_command_config cmd = {
+        .protocol_id = request->protocol_id,
+        .message_id = request->message_id,
+        .payload = request->parameters,
+        .size = request->parameter_count * sizeof(uint32_t),
+    };
 
-    agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+    agent_ctx->batch_count = 1;
+    if ((agent_ctx->config->compound_protocol_id != 0) &&
+        (agent_ctx->request_count > 1))
+        build_compound_command(agent_ctx, &cmd);
 
     /* Check if channel is free */
     if (!ctx.smt_api->is_channel_free(agent_ctx->config->transport_id)) {
-        ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG,
             "[SCMI AGENT] Channel Busy!\n");
         return FWK_E_BUSY;
     }
 
     /* Send SCMI command to platform */
-    status = ctx.smt_api->send(agent_ctx->config->transport_id, cmd);
+    status = ctx.smt_api->send(agent_ctx->config->transport_id, &cmd);
     if (status != FWK_SUCCESS) {
         ctx.smt_api->put_channel(agent_ctx->config->transport_id);
         return status;
     }
 
-    /* Wait until platform responds */
-    while (!ctx.smt_api->is_channel_free(agent_ctx->config->transport_id))
-        ;
-
-    /* Get response payload */
-    status = ctx.smt_api->get_payload(agent_ctx->config->transport_id,
-                                      &agent_ctx->payload, &agent_ctx->size);
-    if (status != FWK_SUCCESS)
-        return status;
+    return FWK_SUCCESS;
+}
 
-    /* Release channel */
-    status = ctx.smt_api->put_channel(agent_ctx->config->transport_id);
-    if (status != FWK_SUCCESS)
-        return status;
+/*
+ * Remove the request at the head of the queue of an agent and deliver its
+ * response, if requested.
+ */
+static void complete_request(struct scmi_agent_ctx *agent_ctx, int status,
+                             const uint32_t *payload, size_t size)
+{
+    int resp_status;
+    unsigned int idx;
+    struct scmi_agent_request *request;
+    struct fwk_event resp_event;
+    struct mod_scmi_agent_response_params *resp_params =
+        (struct mod_scmi_agent_response_params *)resp_event.params;
+
+    request = get_request(agent_ctx, 0);
+
+    agent_ctx->request_head =
+        (agent_ctx->request_head + 1) % SCMI_AGENT_REQUEST_QUEUE_LENGTH;
+    agent_ctx->request_count--;
+
+    if (!request->response_requested)
+        return;
+
+    resp_status = fwk_thread_get_delayed_response(agent_ctx->id,
+        request->cookie, &resp_event);
+    if (resp_status != FWK_SUCCESS)
+        return;
+
+    resp_params->status = status;
+    resp_params->message_id = request->message_id;
+
+    /* The return values follow the status word of the response */
+    for (idx = 0; idx < MOD_SCMI_AGENT_RETURN_VALUE_COUNT; idx++) {
+        if ((status == FWK_SUCCESS) &&
+            (((idx + 2) * sizeof(uint32_t)) <= size))
+            resp_params->return_values[idx] = payload[idx + 1];
+        else
+            resp_params->return_values[idx] = 0;
+    }
 
-    return FWK_SUCCESS;
+    fwk_thread_put_event(&resp_event);
 }
 
 /*
- * SCMI Management Agent API interface
+ * Send the commands of the requests queued for an agent until one of them is
+ * in progress, completing those whose command could not be sent.
  */
-static int agent_get_protocol_version(fwk_id_t agent_id, uint32_t *version)
+static void send_next_request(struct scmi_agent_ctx *agent_ctx)
 {
     int status;
-    struct scmi_agent_ctx *agent_ctx;
-    struct mod_smt_command_config cmd = {
-        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
-        .message_id = SCMI_MANAGEMENT_PROTOCOL_VERSION_GET,
-        .payload = NULL,
-        .size = 0,
-    };
 
-    if (version == NULL)
-        return FWK_E_PARAM;
+    while (agent_ctx->request_count != 0) {
+        status = send_request(agent_ctx);
+        if (status == FWK_SUCCESS)
+            return;
 
-    status = _scmi_agent_transact(agent_id, &cmd);
-    if (status != FWK_SUCCESS)
-        return status;
+        complete_request(agent_ctx, status, NULL, 0);
+    }
+}
 
-    agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
-    *version = *(((uint32_t *)agent_ctx->payload) + 1);
+static int process_request(struct scmi_agent_ctx *agent_ctx,
+                           const struct fwk_event *event,
+                           struct fwk_event *resp)
+{
+    int status;
+    struct scmi_agent_request *request;
+    const struct mod_scmi_agent_request_params *req_params =
+        (const struct mod_scmi_agent_request_params *)event->params;
+    struct mod_scmi_agent_response_params *resp_params =
+        (struct mod_scmi_agent_response_params *)resp->params;
+
+    resp_params->message_id = req_params->message_id;
+
+    if (agent_ctx->request_count == SCMI_AGENT_REQUEST_QUEUE_LENGTH) {
+        resp_params->status = FWK_E_BUSY;
+        return FWK_SUCCESS;
+    }
+
+    if (req_params->parameter_count > MOD_SCMI_AGENT_PARAMETER_COUNT) {
+        resp_params->status = FWK_E_PARAM;
+        return FWK_SUCCESS;
+    }
+
+    request = get_request(agent_ctx, agent_ctx->request_count);
+    request->message_id = req_params->message_id;
+    request->protocol_id = (req_params->protocol_id != 0) ?
+        req_params->protocol_id : SCMI_PROTOCOL_ID_MANAGEMENT;
+    request->parameter_count = req_params->parameter_count;
+    memcpy(request->parameters, req_params->parameters,
+           sizeof(request->parameters));
+    request->cookie = event->cookie;
+    request->response_requested = event->response_requested;
+    agent_ctx->request_count++;
+
+    /* The command is sent once the commands queued before it have completed */
+    if (agent_ctx->request_count == 1) {
+        status = send_request(agent_ctx);
+        if (status != FWK_SUCCESS) {
+            agent_ctx->request_count--;
+            resp_params->status = status;
+            return FWK_SUCCESS;
+        }
+    }
+
+    resp->is_delayed_response = event->response_requested;
 
     return FWK_SUCCESS;
 }
 
-static int agent_get_clock_status(fwk_id_t agent_id, uint32_t *clock_status)
+/*
+ * Complete the request at the head of the queue of an agent with a response
+ * whose first word is the SCMI status.
+ */
+static void complete_request_with_response(struct scmi_agent_ctx *agent_ctx,
+                                           int status, const void *payload,
+                                           size_t size)
 {
-    int status;
-    struct scmi_agent_ctx *agent_ctx;
-    struct mod_smt_command_config cmd = {
-        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
-        .message_id = SCMI_MANAGEMENT_CLOCK_STATUS_GET,
-        .payload = NULL,
-        .size = 0,
-    };
+    if ((status == FWK_SUCCESS) &&
+        ((size < sizeof(uint32_t)) || (*(const int32_t *)payload != 0)))
+        status = FWK_E_DEVICE;
 
-    if (clock_status == NULL)
-        return FWK_E_PARAM;
+    complete_request(agent_ctx, status, payload, size);
+}
 
-    status = _scmi_agent_transact(agent_id, &cmd);
-    if (status != FWK_SUCCESS)
-        return status;
+/*
+ * Complete the requests sent in a COMPOUND_EXECUTE command with the responses
+ * to their commands. The requests whose command was not executed, the commands
+ * being executed up to the first one failing, complete with FWK_E_DEVICE.
+ */
+static void complete_batch(struct scmi_agent_ctx *agent_ctx, int status,
+                           const void *payload, size_t size)
+{
+    unsigned int idx;
+    unsigned int response_count = 0;
+    size_t offset = sizeof(struct scmi_agent_compound_execute_p2a);
+    const struct scmi_agent_compound_command *response;
+    size_t response_size;
+
+    if ((status == FWK_SUCCESS) && (size >= offset)) {
+        response_count =
+            ((const struct scmi_agent_compound_execute_p2a *)payload)->
+                command_count;
+    }
 
-    agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
-    *clock_status = *(((uint32_t *)agent_ctx->payload) + 1);
+    for (idx = 0; idx < agent_ctx->batch_count; idx++) {
+        if ((idx >= response_count) ||
+            ((offset + sizeof(*response)) > size)) {
+            complete_request(agent_ctx, FWK_E_DEVICE, NULL, 0);
+            continue;
+        }
 
-    return FWK_SUCCESS;
+        response = (const struct scmi_agent_compound_command *)
+            ((uintptr_t)payload + offset);
+        offset += sizeof(*response);
+
+        response_size = response->payload_size;
+        if (response_size > (size - offset)) {
+            complete_request(agent_ctx, FWK_E_DEVICE, NULL, 0);
+            response_count = 0;
+            continue;
+        }
+
+        complete_request_with_response(agent_ctx, FWK_SUCCESS,
+            (const void *)((uintptr_t)payload + offset), response_size);
+        offset += FWK_ALIGN_NEXT(response_size, sizeof(uint32_t));
+    }
 }
 
-static int agent_get_chipid_info(fwk_id_t agent_id,
-                                 uint8_t *multichip_mode,
-                                 uint8_t *chipid)
+static int process_response(struct scmi_agent_ctx *agent_ctx)
 {
     int status;
-    struct scmi_agent_ctx *agent_ctx;
-    struct mod_smt_command_config cmd = {
-        .protocol_id = SCMI_PROTOCOL_ID_MANAGEMENT,
-        .message_id = SCMI_MANAGEMENT_CHIPID_INFO_GET,
-        .payload = NULL,
-        .size = 0,
-    };
+    const void *payload = NULL;
+    size_t size = 0;
 
-    if ((multichip_mode == NULL) || (chipid == NULL))
-        return FWK_E_PARAM;
+    if (agent_ctx->request_count == 0)
+        return FWK_E_STATE;
 
-    status = _scmi_agent_transact(agent_id, &cmd);
+    /* Get response payload */
+    status = ctx.smt_api->get_payload(agent_ctx->config->transport_id,
+                                      &payload, &size);
+
+    if (agent_ctx->batch_count > 1)
+        complete_batch(agent_ctx, status, payload, size);
+    else
+        complete_request_with_response(agent_ctx, status, payload, size);
+
+    /* Release channel */
+    status = ctx.smt_api->put_channel(agent_ctx->config->transport_id);
     if (status != FWK_SUCCESS)
         return status;
 
-    agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
-    *multichip_mode = (uint8_t)(*(((uint32_t *)agent_ctx->payload) + 1));
-    *chipid = (uint8_t)(*(((uint32_t *)agent_ctx->payload) + 2));
+    send_next_request(agent_ctx);
 
     return FWK_SUCCESS;
 }
 
-struct mod_scmi_agent_api scmi_agent_api = {
-    .get_protocol_version = agent_get_protocol_version,
-    .get_clock_status = agent_get_clock_status,
-    .get_chipid_info = agent_get_chipid_info,
+/*
+ * SCMI Agent transport input API interface
+ */
+static int agent_signal_response(fwk_id_t agent_id)
+{
+    struct fwk_event event = {
+        .source_id = agent_id,
+        .target_id = agent_id,
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_AGENT,
+                           SCMI_AGENT_EVENT_IDX_RESPONSE),
+    };
+
+    return fwk_thread_put_event(&event);
+}
+
+static const struct mod_scmi_agent_transport_input_api transport_input_api = {
+    .signal_response = agent_signal_response,
 };
 
 /*
@@ -200,6 +423,7 @@ static int scmi_agent_element_init(fwk_id_t agent_id, unsigned int unused,
         return FWK_E_PARAM;
 
     agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(agent_id)];
+    agent_ctx->id = agent_id;
     agent_ctx->config = config;
 
     return FWK_SUCCESS;
@@ -233,7 +457,7 @@ static int scmi_agent_start(fwk_id_t id)
         .source_id = id,
         .target_id = id,
         .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_AGENT,
-                           MOD_SCMI_AGENT_EVENT_RUN),
+                           SCMI_AGENT_EVENT_IDX_RUN),
     };
 
     return fwk_thread_put_event(&event);
@@ -244,32 +468,65 @@ static int scmi_agent_process_bind_request(fwk_id_t source_id,
                                            fwk_id_t api_id,
                                            const void **api)
 {
-    *api = &scmi_agent_api;
+    if (!fwk_id_is_equal(api_id, mod_scmi_agent_api_id_transport_input) ||
+        !fwk_id_is_type(target_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_PARAM;
+
+    *api = &transport_input_api;
     return FWK_SUCCESS;
 }
 
 static int scmi_agent_process_event(const struct fwk_event *event,
                                     struct fwk_event *resp)
 {
-    int status;
-    uint32_t temp = 0;
+    struct scmi_agent_ctx *agent_ctx;
+    const struct mod_scmi_agent_response_params *resp_params;
+    struct fwk_event req;
+    struct mod_scmi_agent_request_params *req_params =
+        (struct mod_scmi_agent_request_params *)req.params;
 
-    status = agent_get_protocol_version(event->target_id, &temp);
-    if (status != FWK_SUCCESS)
-        return status;
+    agent_ctx = &ctx.agent_ctx_table[fwk_id_get_element_idx(event->target_id)];
+
+    switch (fwk_id_get_event_idx(event->id)) {
+    case MOD_SCMI_AGENT_EVENT_IDX_REQUEST:
+        if (!event->is_response)
+            return process_request(agent_ctx, event, resp);
 
-    ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
-        "[SCMI AGENT] Found management protocol version: 0x%x\n",
-        temp);
+        /* Response to the protocol version request of the run event */
+        resp_params =
+            (const struct mod_scmi_agent_response_params *)event->params;
+        if (resp_params->status != FWK_SUCCESS)
+            return resp_params->status;
 
-    return status;
+        MOD_LOG(ctx.log_api, MOD_LOG_GROUP_DEBUG,
+            "[SCMI AGENT] Found management protocol version: 0x%x\n",
+            resp_params->return_values[0]);
+
+        return FWK_SUCCESS;
+
+    case SCMI_AGENT_EVENT_IDX_RUN:
+        req = (struct fwk_event) {
+            .target_id = event->target_id,
+            .id = mod_scmi_agent_event_id_request,
+            .response_requested = true,
+        };
+        req_params->message_id = SCMI_MANAGEMENT_PROTOCOL_VERSION_GET;
+
+        return fwk_thread_put_event(&req);
+
+    case SCMI_AGENT_EVENT_IDX_RESPONSE:
+        return process_response(agent_ctx);
+
+    default:
+        return FWK_E_PARAM;
+    }
 }
 
 const struct fwk_module module_scmi_agent = {
     .name = "SCMI AGENT",
     .type = FWK_MODULE_TYPE_SERVICE,
     .api_count = MOD_SCMI_AGENT_API_IDX_COUNT,
-    .event_count = MOD_SCMI_AGENT_EVENT_COUNT,
+    .event_count = SCMI_AGENT_EVENT_COUNT,
     .init = scmi_agent_init,
     .element_init = scmi_agent_element_init,
     .bind = scmi_agent_bind,
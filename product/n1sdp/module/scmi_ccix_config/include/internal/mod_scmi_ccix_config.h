@@ -82,7 +82,9 @@ struct __attribute((packed)) scmi_ccix_config_protocol_get_p2a {
  *
  * config_property bit field definition
  *
- * reserved[31-26]
+ * reserved[31-29]
+ * link_balance[28]
+ * link_count[27-26]
  * opt_tlp[25]
  * msg_packing[24]
  * link_id[23-16]
@@ -99,6 +101,10 @@ struct __attribute((packed)) scmi_ccix_config_protocol_get_p2a {
 #define MSG_PACK_BIT_POS         24
 #define OPT_TLP_MASK             UINT32_C(0x03000000)
 #define OPT_TLP_BIT_POS          25
+#define LINK_COUNT_MASK          UINT32_C(0x0C000000)
+#define LINK_COUNT_BIT_POS       26
+#define LINK_BALANCE_MASK        UINT32_C(0x10000000)
+#define LINK_BALANCE_BIT_POS     28
 
 struct __attribute((packed)) scmi_ccix_config_protocol_set_a2p {
     uint32_t agent_count;
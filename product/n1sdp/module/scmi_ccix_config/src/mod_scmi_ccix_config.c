@@ -16,6 +16,7 @@
 #include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <fwk_thread.h>
 #include <internal/scmi.h>
 #include <internal/mod_scmi_ccix_config.h>
 #include <mod_n1sdp_pcie.h>
@@ -23,6 +24,32 @@
 #include <mod_cmn600.h>
 #include <mod_log.h>
 
+enum scmi_ccix_config_event_idx {
+    SCMI_CCIX_CONFIG_EVENT_IDX_REQUEST,
+    SCMI_CCIX_CONFIG_EVENT_IDX_COUNT,
+};
+
+/*
+ * CCIX_CONFIG_SET or CCIX_CONFIG_ENTER_SYSTEM_COHERENCY request. The CCIX link
+ * operations are carried out one at a time.
+ */
+struct scmi_ccix_config_request {
+    /* A request is in progress */
+    bool busy;
+
+    /* Identifier of the message being processed */
+    unsigned int message_id;
+
+    /* Service to respond to */
+    fwk_id_t service_id;
+
+    /* CCIX endpoint configuration, for CCIX_CONFIG_SET */
+    struct mod_cmn600_ccix_remote_node_config ccix_ep_config;
+
+    /* CCIX link, for CCIX_CONFIG_ENTER_SYSTEM_COHERENCY */
+    uint8_t link_id;
+};
+
 struct scmi_ccix_config_ctx {
     /* scmi module api */
     const struct mod_scmi_from_protocol_api *scmi_api;
@@ -35,6 +62,9 @@ struct scmi_ccix_config_ctx {
 
     /* Log module API */
     struct mod_log_api *log_api;
+
+    /* CCIX link request in progress */
+    struct scmi_ccix_config_request request;
 };
 
 static struct scmi_ccix_config_ctx scmi_ccix_config_ctx;
@@ -54,35 +84,33 @@ static int scmi_ccix_config_protocol_exchange_credit(fwk_id_t service_id,
 static int scmi_ccix_config_protocol_enter_system_coherency(fwk_id_t service_id,
     const uint32_t *payload);
 
-static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] =
-        scmi_ccix_config_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] =
-        scmi_ccix_config_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_ccix_config_protocol_msg_attributes_handler,
-    [SCMI_CCIX_CONFIG_SET] =
-        scmi_ccix_config_protocol_set_handler,
-    [SCMI_CCIX_CONFIG_GET] =
-        scmi_ccix_config_protocol_get_handler,
-    [SCMI_CCIX_CONFIG_EXCHANGE_PROTOCOL_CREDIT] =
-        scmi_ccix_config_protocol_exchange_credit,
-    [SCMI_CCIX_CONFIG_ENTER_SYSTEM_COHERENCY] =
-        scmi_ccix_config_protocol_enter_system_coherency,
-};
-
-static unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_CCIX_CONFIG_SET] =
-        sizeof(struct scmi_ccix_config_protocol_set_a2p),
-    [SCMI_CCIX_CONFIG_GET] = 0,
-    [SCMI_CCIX_CONFIG_EXCHANGE_PROTOCOL_CREDIT] =
-        sizeof(struct scmi_ccix_config_protocol_credit_a2p),
-    [SCMI_CCIX_CONFIG_ENTER_SYSTEM_COHERENCY] =
-        sizeof(struct scmi_ccix_config_protocol_sys_coherency_a2p),
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_ccix_config_protocol_version_handler,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_ccix_config_protocol_attributes_handler,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_ccix_config_protocol_msg_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+    },
+    [SCMI_CCIX_CONFIG_SET] = {
+        .handler = scmi_ccix_config_protocol_set_handler,
+        .payload_size = sizeof(struct scmi_ccix_config_protocol_set_a2p),
+    },
+    [SCMI_CCIX_CONFIG_GET] = {
+        .handler = scmi_ccix_config_protocol_get_handler,
+    },
+    [SCMI_CCIX_CONFIG_EXCHANGE_PROTOCOL_CREDIT] = {
+        .handler = scmi_ccix_config_protocol_exchange_credit,
+        .payload_size = sizeof(struct scmi_ccix_config_protocol_credit_a2p),
+    },
+    [SCMI_CCIX_CONFIG_ENTER_SYSTEM_COHERENCY] = {
+        .handler = scmi_ccix_config_protocol_enter_system_coherency,
+        .payload_size =
+            sizeof(struct scmi_ccix_config_protocol_sys_coherency_a2p),
+    },
 };
 
 static int scmi_ccix_config_protocol_version_handler(fwk_id_t service_id,
@@ -122,8 +150,8 @@ static int scmi_ccix_config_protocol_msg_attributes_handler(fwk_id_t service_id,
     parameters = (const struct scmi_protocol_message_attributes_a2p *)
                  payload;
 
-    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[parameters->message_id] != NULL)) {
+    if ((parameters->message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[parameters->message_id].handler != NULL)) {
         return_values = (struct scmi_protocol_message_attributes_p2a) {
             .status = SCMI_SUCCESS,
             /* All commands have an attributes value of 0 */
@@ -176,7 +204,7 @@ static int scmi_ccix_config_protocol_get_handler(fwk_id_t service_id,
     if (sizeof(return_values) > max_payload_size) {
         return_values.status = SCMI_OUT_OF_RANGE;
         status = FWK_E_RANGE;
-        scmi_ccix_config_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(scmi_ccix_config_ctx.log_api, MOD_LOG_GROUP_DEBUG,
             "[SCMI CCIX CONFIG] max payload size is  %d\n",
              max_payload_size);
         goto exit;
@@ -217,13 +245,52 @@ exit:
     return status;
 }
 
+static void complete_request(int status)
+{
+    struct scmi_ccix_config_request *request = &scmi_ccix_config_ctx.request;
+    int32_t return_status;
+
+    request->busy = false;
+
+    return_status = (status == FWK_SUCCESS) ? SCMI_SUCCESS : SCMI_GENERIC_ERROR;
+
+    scmi_ccix_config_ctx.scmi_api->respond(request->service_id, &return_status,
+        sizeof(return_status));
+}
+
+/*
+ * The CCIX link operations are carried out from the event handler of this
+ * module so that the CMN600 module sends the completion of the pending
+ * operations to this module rather than to the SCMI service.
+ */
+static int start_request(fwk_id_t service_id, unsigned int message_id)
+{
+    int status;
+    struct scmi_ccix_config_request *request = &scmi_ccix_config_ctx.request;
+    struct fwk_event event = {
+        .target_id = FWK_ID_MODULE(FWK_MODULE_IDX_SCMI_CCIX_CONFIG),
+        .id = FWK_ID_EVENT(FWK_MODULE_IDX_SCMI_CCIX_CONFIG,
+                           SCMI_CCIX_CONFIG_EVENT_IDX_REQUEST),
+    };
+
+    status = fwk_thread_put_event(&event);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    request->busy = true;
+    request->message_id = message_id;
+    request->service_id = service_id;
+
+    return FWK_SUCCESS;
+}
+
 static int scmi_ccix_config_protocol_set_handler(fwk_id_t service_id,
     const uint32_t *payload)
 {
     int status = FWK_SUCCESS;
     unsigned int i;
     struct scmi_ccix_config_protocol_set_p2a return_values;
-    struct mod_cmn600_ccix_remote_node_config ccix_ep_config;
+    struct mod_cmn600_ccix_remote_node_config *ccix_ep_config;
     size_t max_payload_size;
     unsigned int agent_id;
     enum scmi_agent_type agent_type;
@@ -256,47 +323,69 @@ static int scmi_ccix_config_protocol_set_handler(fwk_id_t service_id,
     if (sizeof(*params) > max_payload_size) {
         return_values.status = SCMI_OUT_OF_RANGE;
         status = FWK_E_RANGE;
-        scmi_ccix_config_ctx.log_api->log(MOD_LOG_GROUP_DEBUG,
+        MOD_LOG(scmi_ccix_config_ctx.log_api, MOD_LOG_GROUP_DEBUG,
             "[SCMI CCIX CONFIG] max payload size is  %d\n",
              max_payload_size);
         goto exit;
     }
 
-    ccix_ep_config.remote_ra_count =
+    if (scmi_ccix_config_ctx.request.busy) {
+        return_values.status = SCMI_BUSY;
+        status = FWK_SUCCESS;
+        goto exit;
+    }
+
+    ccix_ep_config = &scmi_ccix_config_ctx.request.ccix_ep_config;
+
+    ccix_ep_config->remote_ra_count =
         (uint8_t)(params->agent_count & RA_COUNT_MASK);
-    ccix_ep_config.remote_ha_count =
+    ccix_ep_config->remote_ha_count =
         (uint8_t)((params->agent_count & HA_COUNT_MASK) >> HA_COUNT_BIT_POS);
-    ccix_ep_config.remote_sa_count =
+    ccix_ep_config->remote_sa_count =
         (uint8_t)((params->agent_count & SA_COUNT_MASK) >> SA_COUNT_BIT_POS);
-    ccix_ep_config.pcie_bus_num =
+    ccix_ep_config->pcie_bus_num =
         (uint8_t)((params->config_property & EP_START_BUS_NUM_MASK) >>
                    EP_START_BUS_NUM_BIT_POS);
-    ccix_ep_config.ccix_link_id =
+    ccix_ep_config->ccix_link_id =
         (uint8_t)((params->config_property & LINK_ID_MASK) >> LINK_ID_BIT_POS);
-    ccix_ep_config.ccix_tc =
+    ccix_ep_config->ccix_link_count =
+        (uint8_t)((params->config_property & LINK_COUNT_MASK) >>
+                   LINK_COUNT_BIT_POS);
+    ccix_ep_config->ccix_link_balance =
+        ((params->config_property & LINK_BALANCE_MASK) >>
+            LINK_BALANCE_BIT_POS) ?
+        MOD_CMN600_CCIX_LINK_BALANCE_REGION :
+        MOD_CMN600_CCIX_LINK_BALANCE_AGENT;
+    ccix_ep_config->ccix_tc =
         (uint8_t)((params->config_property & TRAFFIC_CLASS_MASK) >>
                    TRAFFIC_CLASS_BIT_POS);
-    ccix_ep_config.ccix_msg_pack_enable =
+    ccix_ep_config->ccix_msg_pack_enable =
         (bool)((params->config_property & MSG_PACK_MASK) >> MSG_PACK_BIT_POS);
-    ccix_ep_config.remote_ha_mmap_count = (uint8_t)(params->remote_mmap_count);
-    ccix_ep_config.ccix_opt_tlp = (bool)((params->config_property &
+    ccix_ep_config->remote_ha_mmap_count = (uint8_t)(params->remote_mmap_count);
+    ccix_ep_config->ccix_opt_tlp = (bool)((params->config_property &
                                           OPT_TLP_MASK) >> OPT_TLP_BIT_POS);
 
-    for (i = 0; i < ccix_ep_config.remote_ha_mmap_count; i++) {
-        ccix_ep_config.remote_ha_mmap[i].ha_id =
+    for (i = 0; i < ccix_ep_config->remote_ha_mmap_count; i++) {
+        ccix_ep_config->remote_ha_mmap[i].ha_id =
             (uint8_t)params->mem_pools[i].ha_id;
-        ccix_ep_config.remote_ha_mmap[i].base  =
+        ccix_ep_config->remote_ha_mmap[i].base  =
             (((uint64_t)params->mem_pools[i].base_msb << 32) |
                         params->mem_pools[i].base_lsb);
-        ccix_ep_config.remote_ha_mmap[i].size  =
+        ccix_ep_config->remote_ha_mmap[i].size  =
             (((uint64_t)params->mem_pools[i].size_msb << 32) |
                         params->mem_pools[i].size_lsb);
     }
     status = scmi_ccix_config_ctx.pcie_ccix_config_api->enable_opt_tlp(
-                 ccix_ep_config.ccix_opt_tlp);
+                 ccix_ep_config->ccix_opt_tlp);
 
-    status = scmi_ccix_config_ctx.cmn600_ccix_config_api->set_config(
-                 &ccix_ep_config);
+    status = start_request(service_id, SCMI_CCIX_CONFIG_SET);
+    if (status != FWK_SUCCESS) {
+        return_values.status = SCMI_GENERIC_ERROR;
+        goto exit;
+    }
+
+    /* The request is responded to once complete */
+    return FWK_SUCCESS;
 
 exit:
     scmi_ccix_config_ctx.scmi_api->respond(service_id, &return_values,
@@ -325,17 +414,31 @@ static int scmi_ccix_config_protocol_exchange_credit(fwk_id_t service_id,
 static int scmi_ccix_config_protocol_enter_system_coherency(
     fwk_id_t service_id, const uint32_t *payload)
 {
-    int status = FWK_SUCCESS;
+    int status;
+    int32_t return_status;
     const struct scmi_ccix_config_protocol_sys_coherency_a2p  *params;
     params =
         (const struct scmi_ccix_config_protocol_sys_coherency_a2p *)payload;
 
-    status =
-        scmi_ccix_config_ctx.cmn600_ccix_config_api->enter_system_coherency(
-        (uint8_t)params->link_id);
+    if (scmi_ccix_config_ctx.request.busy) {
+        return_status = SCMI_BUSY;
+        status = FWK_SUCCESS;
+        goto exit;
+    }
 
-    scmi_ccix_config_ctx.scmi_api->respond(service_id, &status,
-        sizeof(status));
+    scmi_ccix_config_ctx.request.link_id = (uint8_t)params->link_id;
+
+    status = start_request(service_id, SCMI_CCIX_CONFIG_ENTER_SYSTEM_COHERENCY);
+    if (status == FWK_SUCCESS) {
+        /* The request is responded to once complete */
+        return FWK_SUCCESS;
+    }
+
+    return_status = SCMI_GENERIC_ERROR;
+
+exit:
+    scmi_ccix_config_ctx.scmi_api->respond(service_id, &return_status,
+        sizeof(return_status));
 
     return status;
 }
@@ -354,46 +457,10 @@ static int scmi_ccix_config_get_scmi_protocol_id(fwk_id_t protocol_id,
     return status;
 }
 
-static int scmi_ccix_config_message_handler(fwk_id_t protocol_id,
-    fwk_id_t service_id,
-    const uint32_t *payload,
-    size_t payload_size,
-    unsigned int message_id)
-{
-    int status;
-    int32_t return_value;
-
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] CCIX_CONFIG management protocol table sizes not consistent");
-    fwk_assert(payload != NULL);
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        /* Incorrect payload size or message is not supported */
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
-
-error:
-    scmi_ccix_config_ctx.scmi_api->respond(service_id, &return_value,
-                                      sizeof(return_value));
-    return FWK_SUCCESS;
-}
-
 static struct mod_scmi_to_protocol_api scmi_ccix_config_protocol_api = {
     .get_scmi_protocol_id = scmi_ccix_config_get_scmi_protocol_id,
-    .message_handler = scmi_ccix_config_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -470,13 +537,48 @@ static int scmi_ccix_config_process_bind_request(fwk_id_t source_id,
     return FWK_SUCCESS;
 }
 
+static int scmi_ccix_config_process_event(const struct fwk_event *event,
+    struct fwk_event *resp_event)
+{
+    int status;
+    const struct mod_cmn600_ccix_link_event_params *params;
+    struct scmi_ccix_config_request *request = &scmi_ccix_config_ctx.request;
+    const struct mod_cmn600_ccix_config_api *cmn600_api =
+        scmi_ccix_config_ctx.cmn600_ccix_config_api;
+
+    /* Completion of a pending CCIX link operation */
+    if (event->is_response) {
+        params = (const struct mod_cmn600_ccix_link_event_params *)
+            event->params;
+        complete_request(params->status);
+
+        return FWK_SUCCESS;
+    }
+
+    if (fwk_id_get_event_idx(event->id) != SCMI_CCIX_CONFIG_EVENT_IDX_REQUEST)
+        return FWK_E_PARAM;
+
+    if (request->message_id == SCMI_CCIX_CONFIG_SET)
+        status = cmn600_api->set_config(&request->ccix_ep_config);
+    else
+        status = cmn600_api->enter_system_coherency(request->link_id);
+
+    /* On FWK_PENDING, the request is completed once the CMN600 responds */
+    if (status != FWK_PENDING)
+        complete_request(status);
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_scmi_ccix_config = {
     .name = "SCMI CCIX Config Management Protocol",
     .api_count = 1,
+    .event_count = SCMI_CCIX_CONFIG_EVENT_IDX_COUNT,
     .type = FWK_MODULE_TYPE_PROTOCOL,
     .init = scmi_ccix_config_init,
     .bind = scmi_ccix_config_bind,
     .process_bind_request = scmi_ccix_config_process_bind_request,
+    .process_event = scmi_ccix_config_process_event,
 };
 
 /* No elements, no module configuration data */
@@ -42,23 +42,22 @@ static int scmi_management_chipid_info_get_handler(fwk_id_t service_id,
  */
 static struct scmi_management_ctx scmi_management_ctx;
 
-static int (* const handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] = scmi_management_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] = scmi_management_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_management_protocol_message_attributes_handler,
-    [SCMI_MANAGEMENT_CLOCK_STATUS_GET] =
-        scmi_management_clock_status_get_handler,
-    [SCMI_MANAGEMENT_CHIPID_INFO_GET] =
-        scmi_management_chipid_info_get_handler,
-};
-
-static const unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = 0,
-    [SCMI_MANAGEMENT_CLOCK_STATUS_GET] = 0,
-    [SCMI_MANAGEMENT_CHIPID_INFO_GET] = 0,
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_management_protocol_version_handler,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_management_protocol_attributes_handler,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_management_protocol_message_attributes_handler,
+    },
+    [SCMI_MANAGEMENT_CLOCK_STATUS_GET] = {
+        .handler = scmi_management_clock_status_get_handler,
+    },
+    [SCMI_MANAGEMENT_CHIPID_INFO_GET] = {
+        .handler = scmi_management_chipid_info_get_handler,
+    },
 };
 
 /*
@@ -115,8 +114,8 @@ static int scmi_management_protocol_message_attributes_handler(
         payload;
     message_id = parameters->message_id;
 
-    if ((message_id >= FWK_ARRAY_SIZE(handler_table)) ||
-        (handler_table[message_id] == NULL))
+    if ((message_id >= FWK_ARRAY_SIZE(message_table)) ||
+        (message_table[message_id].handler == NULL))
         return_values.status = SCMI_NOT_FOUND;
 
     response_size = (return_values.status == SCMI_SUCCESS) ?
@@ -228,52 +227,11 @@ static int scmi_management_get_scmi_protocol_id(fwk_id_t protocol_id,
     return FWK_SUCCESS;
 }
 
-static int scmi_management_message_handler(
-    fwk_id_t protocol_id,
-    fwk_id_t service_id,
-    const uint32_t *payload,
-    size_t payload_size,
-    unsigned int message_id)
-{
-    int status;
-    int32_t return_value;
-
-    static_assert(FWK_ARRAY_SIZE(handler_table) ==
-        FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] Management protocol table sizes not consistent");
-    assert(payload != NULL);
-
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
-
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        status = FWK_E_RANGE;
-        goto error;
-    }
-
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        status = FWK_E_SIZE;
-        goto error;
-    }
-
-    return handler_table[message_id](service_id, payload);
-
-error:
-    scmi_management_ctx.scmi_api->respond(
-        service_id,
-        &return_value,
-        sizeof(return_value));
-
-    return FWK_SUCCESS;
-}
-
 static struct mod_scmi_to_protocol_api
     scmi_management_mod_scmi_to_protocol_api = {
     .get_scmi_protocol_id = scmi_management_get_scmi_protocol_id,
-    .message_handler = scmi_management_message_handler
+    .message_table = message_table,
+    .message_count = FWK_ARRAY_SIZE(message_table),
 };
 
 /*
@@ -167,5 +167,7 @@ const struct fwk_module_config config_cmn600 = {
         .mmap_count = FWK_ARRAY_SIZE(mmap),
         .clock_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_CLOCK,
             CLOCK_IDX_INTERCONNECT),
+        .ccix_poll_period = 10,
+        .ccix_alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 1),
     }),
 };
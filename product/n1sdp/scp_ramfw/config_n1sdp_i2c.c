@@ -7,6 +7,7 @@
 
 #include <fwk_module.h>
 #include <mod_n1sdp_i2c.h>
+#include <n1sdp_scp_irq.h>
 #include <n1sdp_scp_mmap.h>
 #include <config_clock.h>
 
@@ -21,6 +22,7 @@ static const struct fwk_element i2c_element_desc_table[] = {
             .ack_en = MOD_N1SDP_I2C_ACK_ENABLE,
             .addr_size = MOD_N1SDP_I2C_ADDRESS_7_BIT,
             .hold_mode = MOD_N1SDP_I2C_HOLD_ON,
+            .irq = SCP_I2C0_IRQ,
         }),
     },
     [1] = { 0 }, /* Termination description. */
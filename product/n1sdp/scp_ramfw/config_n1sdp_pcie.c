@@ -9,6 +9,7 @@
 #include <fwk_element.h>
 #include <fwk_id.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <mod_n1sdp_pcie.h>
 #include <n1sdp_scp_mmap.h>
 
@@ -22,6 +23,7 @@ static const struct fwk_element n1sdp_pcie_element_table[] = {
             .axi_slave_base32 = PCIE_AXI_SLAVE_SCP_BASE,
             .axi_slave_base64 = PCIE_AXI64_SLAVE_AP_BASE,
             .ccix_capable = false,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 3),
         }),
     },
     [1] = {
@@ -33,6 +35,7 @@ static const struct fwk_element n1sdp_pcie_element_table[] = {
             .axi_slave_base32 = CCIX_AXI_SLAVE_SCP_BASE,
             .axi_slave_base64 = CCIX_AXI64_SLAVE_AP_BASE,
             .ccix_capable = true,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 4),
         }),
     },
     [2] = { 0 }, /* Termination description. */
@@ -12,6 +12,7 @@
 #include <mod_n1sdp_pll.h>
 #include <n1sdp_scp_mmap.h>
 #include <config_clock.h>
+#include <config_n1sdp_pll_rates.h>
 #include <n1sdp_system_clock.h>
 
 static struct n1sdp_pll_custom_freq_param_entry freq_table[] = {
@@ -31,6 +32,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_CPU0_STAT,
             .initial_rate = N1SDP_PLL_RATE_CPU_PLL0,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_CPU1] = {
@@ -40,6 +43,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_CPU1_STAT,
             .initial_rate = N1SDP_PLL_RATE_CPU_PLL1,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_CLUS] = {
@@ -49,6 +54,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_CLUS_STAT,
             .initial_rate = N1SDP_PLL_RATE_CLUSTER_PLL,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_INTERCONNECT] = {
@@ -58,6 +65,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_INTERCONNECT_STAT,
             .initial_rate = N1SDP_PLL_RATE_INTERCONNECT_PLL,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_SYS] = {
@@ -67,6 +76,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_SYSPLL_STAT,
             .initial_rate = N1SDP_PLL_RATE_SYSTEM_PLL,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_DMC] = {
@@ -76,6 +87,8 @@ static const struct fwk_element n1sdp_pll_element_table[] = {
             .control_reg1 = (void *)SCP_PLL_DMC_STAT,
             .initial_rate = N1SDP_PLL_RATE_DMC_PLL,
             .ref_rate = CLOCK_RATE_REFCLK,
+            .rate_table = n1sdp_pll_rate_table,
+            .rate_count = FWK_ARRAY_SIZE(n1sdp_pll_rate_table),
         }),
     },
     [CLOCK_PLL_IDX_COUNT] = { 0 }, /* Termination description. */
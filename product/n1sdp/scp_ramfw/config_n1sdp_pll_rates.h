@@ -0,0 +1,71 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * This file was auto generated using:
+ *     gen_pll_table.py -r 50 -o config_n1sdp_pll_rates.h 1333 1600 2400 2600
+ *     2700 2800 2900 3000
+ */
+#ifndef CONFIG_N1SDP_PLL_RATES_H
+#define CONFIG_N1SDP_PLL_RATES_H
+
+#include <stdint.h>
+#include <mod_n1sdp_pll.h>
+
+/* Reference clock rate: 50000000 Hz */
+static const struct n1sdp_pll_rate_entry n1sdp_pll_rate_table[] = {
+    {
+        /* 1333000000 Hz: FBDIV 160, REFDIV 3, POSTDIV 2 */
+        .rate = UINT64_C(1333000000),
+        .control_reg0 = UINT32_C(0x0030A000),
+        .control_reg1 = UINT32_C(0x12000000),
+    },
+    {
+        /* 1600000000 Hz: FBDIV 32, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(1600000000),
+        .control_reg0 = UINT32_C(0x00102000),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 2400000000 Hz: FBDIV 48, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(2400000000),
+        .control_reg0 = UINT32_C(0x00103000),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 2600000000 Hz: FBDIV 52, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(2600000000),
+        .control_reg0 = UINT32_C(0x00103400),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 2700000000 Hz: FBDIV 54, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(2700000000),
+        .control_reg0 = UINT32_C(0x00103600),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 2800000000 Hz: FBDIV 56, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(2800000000),
+        .control_reg0 = UINT32_C(0x00103800),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 2900000000 Hz: FBDIV 58, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(2900000000),
+        .control_reg0 = UINT32_C(0x00103A00),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+    {
+        /* 3000000000 Hz: FBDIV 60, REFDIV 1, POSTDIV 1 */
+        .rate = UINT64_C(3000000000),
+        .control_reg0 = UINT32_C(0x00103C00),
+        .control_reg1 = UINT32_C(0x11000000),
+    },
+};
+
+#endif /* CONFIG_N1SDP_PLL_RATES_H */
@@ -6,13 +6,16 @@
  */
 
 #include <mod_n1sdp_scp2pcc.h>
+#include <fwk_id.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 
 #define MSG_ALIVE_ADDRESS    0xB3FFF000
 #define MSG_RX_BUF_ADDRESS   0xB3FFF104
 #define MSG_TX_BUF_ADDRESS   0xB3FFF004
 #define MSG_NUM_TX_MESSAGES  8
 #define MSG_NUM_RX_MESSAGES  8
+#define MSG_ACK_POLL_PERIOD_MS 1
 
 const struct fwk_module_config config_n1sdp_scp2pcc = {
     .data = &((struct mem_msg_config_st) {
@@ -21,5 +24,7 @@ const struct fwk_module_config config_n1sdp_scp2pcc = {
             .shared_num_tx = MSG_NUM_TX_MESSAGES,
             .shared_rx_buffer = (uintptr_t)MSG_RX_BUF_ADDRESS,
             .shared_num_rx = MSG_NUM_RX_MESSAGES,
+            .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 2),
+            .ack_poll_period_ms = MSG_ACK_POLL_PERIOD_MS,
         }),
 };
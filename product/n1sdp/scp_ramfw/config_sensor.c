@@ -103,6 +103,7 @@ struct fwk_module_config config_n1sdp_sensor = {
         .t_sensor_count = 3,
         .v_sensor_count = 5,
     }),
+    .deferred_start = true,
 };
 
 /*
@@ -176,4 +177,5 @@ static const struct fwk_element *get_sensor_element_table(fwk_id_t module_id)
 struct fwk_module_config config_sensor = {
     .get_element_table = get_sensor_element_table,
     .data = NULL,
+    .deferred_start = true,
 };
@@ -75,6 +75,7 @@ BS_FIRMWARE_SOURCES := \
     config_n1sdp_pcie.c \
     config_n1sdp_scp2pcc.c \
     config_sensor.c \
+    config_scmi_sensor.c \
     config_apcontext.c
 
 include $(BS_DIR)/firmware.mk
@@ -5,10 +5,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stddef.h>
 #include <stdint.h>
-#include <string.h>
 #include <fwk_errno.h>
 #include <fwk_interrupt.h>
+#include <fwk_lz4.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <fwk_thread.h>
@@ -94,11 +95,21 @@ static int rdn1e1_rom_start(fwk_id_t id)
 static int rdn1e1_rom_process_event(const struct fwk_event *event,
     struct fwk_event *resp)
 {
-    log_api->log(MOD_LOG_GROUP_INFO, "[ROM] Launch RAM\n");
+    int status;
+    size_t size;
+
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[ROM] Launch RAM\n");
 
     if (rom_config->load_ram_size != 0) {
-        memcpy((void *)rom_config->ramfw_base,
-            (uint8_t *)rom_config->nor_base, rom_config->load_ram_size);
+        /*
+         * The image is decompressed on the fly if it is compressed, in which
+         * case only the compressed image is read from the flash memory.
+         */
+        status = fwk_lz4_load_image((void *)rom_config->ramfw_base,
+            rom_config->load_ram_size, (const void *)rom_config->nor_base,
+            rom_config->load_ram_size, &size);
+        if (status != FWK_SUCCESS)
+            return status;
     }
 
     jump_to_ramfw();
@@ -63,6 +63,7 @@ BS_FIRMWARE_SOURCES := \
     config_sds.c \
     config_timer.c \
     config_sensor.c \
+    config_scmi_sensor.c \
     config_cmn600.c \
     config_scmi_system_power.c \
     config_system_pll.c \
@@ -68,6 +68,7 @@ BS_FIRMWARE_SOURCES := \
     config_css_clock.c \
     config_timer.c \
     config_sensor.c \
+    config_scmi_sensor.c \
     config_mock_psu.c \
     config_psu.c \
     config_dvfs.c \
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
+#include <mod_clock.h>
 #include <mod_log.h>
 #include <mod_timer.h>
 
@@ -422,6 +423,11 @@ struct mod_sgm775_dmc500_reg {
  */
 #define MOD_DMC500_MI_STATUS_IDLE  (1 << 0)
 
+/*!
+ * \brief SI_STATE_CONTROL and QUEUE_STATE_CONTROL value stalling the requests.
+ */
+#define MOD_DMC500_STATE_CONTROL_STALL  (1 << 0)
+
 /*!
  * \brief Element configuration.
  */
@@ -458,6 +464,38 @@ struct mod_sgm775_dmc500_module_config {
      * DMC-500.
      */
     fwk_id_t timer_id;
+
+    /*!
+     * \brief Identifier of the clock driver element of the DMC clock.
+     *
+     * \details The DMC-500 devices share their clock. When this identifier is
+     *      an element identifier, the module implements the clock driver API
+     *      for the DMC clock, see \ref MOD_SGM775_DMC500_API_IDX_CLOCK, and
+     *      forwards the requests to the driver of the clock. The rate changes
+     *      are then sequenced so that the memory is idle while the clock
+     *      changes, which allows the DMC clock to be the clock of a DVFS
+     *      domain.
+     */
+    fwk_id_t clock_id;
+
+    /*! Identifier of the clock driver API of \ref clock_id */
+    fwk_id_t clock_api_id;
+};
+
+/*!
+ * \brief API indices.
+ */
+enum mod_sgm775_dmc500_api_idx {
+    /*!
+     * \brief Clock driver API of the DMC clock.
+     *
+     * \details The API is implemented for the module identifier, see
+     *      \ref mod_sgm775_dmc500_module_config::clock_id.
+     */
+    MOD_SGM775_DMC500_API_IDX_CLOCK,
+
+    /*! Number of APIs */
+    MOD_SGM775_DMC500_API_COUNT
 };
 
 /*!
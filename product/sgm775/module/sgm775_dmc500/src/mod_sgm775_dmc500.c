@@ -8,6 +8,7 @@
  *     SGM775 DMC-500 module.
  */
 
+#include <stdbool.h>
 #include <fwk_assert.h>
 #include <fwk_errno.h>
 #include <fwk_mm.h>
@@ -27,15 +28,212 @@
 
 /* Timeout in us */
 #define TIMEOUT_DMC_INIT_US (1000 * 1000)
+#define TIMEOUT_DMC_STALL_US (1000)
 
 static struct mod_log_api *log_api;
 static struct mod_timer_api *timer_api;
 static struct mod_sgm775_dmc_ddr_phy_api *ddr_phy_api;
+static const struct mod_clock_drv_api *clock_drv_api;
+static unsigned int dmc_count;
+
+/* Status register bits awaited by wait_status() */
+struct status_wait {
+    FWK_R uint32_t *reg;
+    uint32_t mask;
+    uint32_t value;
+};
 
 /* Forward declaration */
 static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
                                 fwk_id_t ddr_phy_id);
 
+/*
+ * DMC clock
+ */
+
+static bool status_reached(void *data)
+{
+    struct status_wait *wait = data;
+
+    return (*wait->reg & wait->mask) == wait->value;
+}
+
+static int wait_status(FWK_R uint32_t *reg, uint32_t mask, uint32_t value)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config;
+    struct status_wait wait = {
+        .reg = reg,
+        .mask = mask,
+        .value = value,
+    };
+
+    module_config = fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return timer_api->wait(module_config->timer_id, TIMEOUT_DMC_STALL_US,
+                           status_reached, &wait);
+}
+
+static const struct mod_sgm775_dmc500_element_config *get_element_config(
+    unsigned int dmc_idx)
+{
+    return fwk_module_get_data(
+        FWK_ID_ELEMENT(FWK_MODULE_IDX_SGM775_DMC500, dmc_idx));
+}
+
+/* Stall the requests to the DMC and wait for the memory interface idling */
+static int dmc_stall(struct mod_sgm775_dmc500_reg *dmc)
+{
+    int status;
+
+    dmc->SI0_SI_STATE_CONTROL = MOD_DMC500_STATE_CONTROL_STALL;
+    dmc->SI1_SI_STATE_CONTROL = MOD_DMC500_STATE_CONTROL_STALL;
+
+    status = wait_status(&dmc->SI0_SI_STATUS, MOD_DMC500_SI_STATUS_STALL_ACK,
+                         MOD_DMC500_SI_STATUS_STALL_ACK);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = wait_status(&dmc->SI1_SI_STATUS, MOD_DMC500_SI_STATUS_STALL_ACK,
+                         MOD_DMC500_SI_STATUS_STALL_ACK);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    dmc->QUEUE_STATE_CONTROL = MOD_DMC500_STATE_CONTROL_STALL;
+
+    status = wait_status(&dmc->QUEUE_STATUS, MOD_DMC500_QUEUE_STATUS_STALL_ACK,
+                         MOD_DMC500_QUEUE_STATUS_STALL_ACK);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return wait_status(&dmc->MI_STATUS, MOD_DMC500_MI_STATUS_IDLE,
+                       MOD_DMC500_MI_STATUS_IDLE);
+}
+
+/* Resume the requests to the DMC */
+static int dmc_resume(struct mod_sgm775_dmc500_reg *dmc)
+{
+    int status;
+
+    dmc->QUEUE_STATE_CONTROL = 0;
+    dmc->SI0_SI_STATE_CONTROL = 0;
+    dmc->SI1_SI_STATE_CONTROL = 0;
+
+    status = wait_status(&dmc->QUEUE_STATUS, MOD_DMC500_QUEUE_STATUS_STALL_ACK,
+                         0);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    status = wait_status(&dmc->SI0_SI_STATUS, MOD_DMC500_SI_STATUS_STALL_ACK,
+                         0);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    return wait_status(&dmc->SI1_SI_STATUS, MOD_DMC500_SI_STATUS_STALL_ACK, 0);
+}
+
+/*
+ * The memory is idle while the clock changes: the requests are stalled and
+ * the memory interfaces are idle. The PHYs are then configured again to lock
+ * to the new rate before the requests resume. The DMCs are resumed even if
+ * the change failed, so that the memory remains accessible.
+ */
+static int dmc_clock_set_rate(fwk_id_t clock_id, uint64_t rate,
+                              enum mod_clock_round_mode round_mode)
+{
+    int status = FWK_SUCCESS;
+    int resume_status;
+    unsigned int dmc_idx;
+    const struct mod_sgm775_dmc500_module_config *module_config;
+    const struct mod_sgm775_dmc500_element_config *element_config;
+
+    module_config = fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    for (dmc_idx = 0; (dmc_idx < dmc_count) && (status == FWK_SUCCESS);
+         dmc_idx++) {
+        element_config = get_element_config(dmc_idx);
+        status = dmc_stall((struct mod_sgm775_dmc500_reg *)element_config->dmc);
+    }
+
+    if (status == FWK_SUCCESS) {
+        status = clock_drv_api->set_rate(module_config->clock_id, rate,
+                                         round_mode);
+    }
+
+    for (dmc_idx = 0; (dmc_idx < dmc_count) && (status == FWK_SUCCESS);
+         dmc_idx++) {
+        element_config = get_element_config(dmc_idx);
+        status = ddr_phy_api->configure(element_config->ddr_phy_id);
+    }
+
+    for (dmc_idx = 0; dmc_idx < dmc_count; dmc_idx++) {
+        element_config = get_element_config(dmc_idx);
+        resume_status =
+            dmc_resume((struct mod_sgm775_dmc500_reg *)element_config->dmc);
+        if (status == FWK_SUCCESS)
+            status = resume_status;
+    }
+
+    if (status != FWK_SUCCESS) {
+        MOD_LOG(log_api, MOD_LOG_GROUP_ERROR,
+            "[DDR] DMC clock change failed.\n");
+    }
+
+    return status;
+}
+
+static int dmc_clock_get_rate(fwk_id_t clock_id, uint64_t *rate)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return clock_drv_api->get_rate(module_config->clock_id, rate);
+}
+
+static int dmc_clock_get_rate_from_index(fwk_id_t clock_id,
+                                         unsigned int rate_index,
+                                         uint64_t *rate)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return clock_drv_api->get_rate_from_index(module_config->clock_id,
+                                              rate_index, rate);
+}
+
+static int dmc_clock_set_state(fwk_id_t clock_id, enum mod_clock_state state)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return clock_drv_api->set_state(module_config->clock_id, state);
+}
+
+static int dmc_clock_get_state(fwk_id_t clock_id, enum mod_clock_state *state)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return clock_drv_api->get_state(module_config->clock_id, state);
+}
+
+static int dmc_clock_get_range(fwk_id_t clock_id,
+                               struct mod_clock_range *range)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    return clock_drv_api->get_range(module_config->clock_id, range);
+}
+
+static const struct mod_clock_drv_api dmc_clock_api = {
+    .set_rate = dmc_clock_set_rate,
+    .get_rate = dmc_clock_get_rate,
+    .get_rate_from_index = dmc_clock_get_rate_from_index,
+    .set_state = dmc_clock_set_state,
+    .get_state = dmc_clock_get_state,
+    .get_range = dmc_clock_get_range,
+};
+
 /*
  * Framework APIs
  */
@@ -43,6 +241,8 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
 static int mod_sgm775_dmc500_init(fwk_id_t module_id,
     unsigned int element_count, const void *data)
 {
+    dmc_count = element_count;
+
     return FWK_SUCCESS;
 }
 
@@ -86,6 +286,14 @@ static int mod_sgm775_dmc500_bind(fwk_id_t id, unsigned int round)
                 FWK_ID_API(FWK_MODULE_IDX_SGM775_DDR_PHY500, 0), &ddr_phy_api);
         if (status != FWK_SUCCESS)
             return status;
+
+        /* Bind to the driver of the DMC clock */
+        if (fwk_id_is_type(module_config->clock_id, FWK_ID_TYPE_ELEMENT)) {
+            status = fwk_module_bind(module_config->clock_id,
+                module_config->clock_api_id, &clock_drv_api);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
     }
 
     return FWK_SUCCESS;
@@ -106,6 +314,24 @@ static int mod_sgm775_dmc500_start(fwk_id_t id)
     return sgm775_dmc500_config(dmc, element_config->ddr_phy_id);
 }
 
+static int mod_sgm775_dmc500_process_bind_request(fwk_id_t requester_id,
+    fwk_id_t target_id, fwk_id_t api_id, const void **api)
+{
+    const struct mod_sgm775_dmc500_module_config *module_config =
+        fwk_module_get_data(fwk_module_id_sgm775_dmc500);
+
+    if (!fwk_id_is_type(module_config->clock_id, FWK_ID_TYPE_ELEMENT))
+        return FWK_E_ACCESS;
+
+    if (!fwk_module_is_valid_module_id(target_id) ||
+        (fwk_id_get_api_idx(api_id) != MOD_SGM775_DMC500_API_IDX_CLOCK))
+        return FWK_E_PARAM;
+
+    *api = &dmc_clock_api;
+
+    return FWK_SUCCESS;
+}
+
 const struct fwk_module module_sgm775_dmc500 = {
     .name = "SGM775_DMC500",
     .type = FWK_MODULE_TYPE_DRIVER,
@@ -113,7 +339,8 @@ const struct fwk_module module_sgm775_dmc500 = {
     .element_init = mod_sgm775_dmc500_element_init,
     .bind = mod_sgm775_dmc500_bind,
     .start = mod_sgm775_dmc500_start,
-    .api_count = 0,
+    .process_bind_request = mod_sgm775_dmc500_process_bind_request,
+    .api_count = MOD_SGM775_DMC500_API_COUNT,
     .event_count = 0,
 };
 
@@ -128,7 +355,7 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
 
     module_config = fwk_module_get_data(fwk_module_id_sgm775_dmc500);
 
-    log_api->log(MOD_LOG_GROUP_DEBUG,
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
         "[DDR] Initialising DMC500 at 0x%x\n", (uintptr_t)dmc);
 
     dmc->ADDRESS_CONTROL = ((RANK_BITS << 24) |
@@ -146,7 +373,7 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->ODT_RD_CONTROL_31_00 = 0x00000000;
     dmc->ODT_TIMING = 0x10001000;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Setting timing settings\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Setting timing settings\n");
 
     dmc->T_REFI = 0x0000030B;
     dmc->T_RFC = 0x000340D0;
@@ -169,11 +396,11 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->T_ESR = 0x00000019;
     dmc->T_XSR = 0x00E100E1;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Setting address map\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Setting address map\n");
 
     dmc->ADDRESS_MAP = ((1 << 8) | (ADDR_SHUTTER));
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Setting PMU settings\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Setting PMU settings\n");
 
     dmc->SI0_SI_INTERRUPT_CONTROL = 0x00000000;
     dmc->SI0_PMU_REQ_CONTROL = 0x00000B1A;
@@ -256,7 +483,8 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->T_PHYWRLAT = 0x010F170E;
     dmc->ERR_RAMECC_CTLR = 0x00000000;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Setting PHY-related settings\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
+            "[DDR] Setting PHY-related settings\n");
 
     dmc->PHY_POWER_CONTROL = 0x0000012A;
     dmc->T_PHY_TRAIN = 0x00F8000A;
@@ -273,7 +501,7 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->PHY_CONFIG = 0x01000000;
     dmc->PHY_CONFIG = 0x00000003;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Doing direct DDR commands\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Doing direct DDR commands\n");
 
     dmc->DIRECT_CMD_SETTINGS = 0x00C80000;
     dmc->DIRECT_CMD = 0x00000000;
@@ -300,7 +528,7 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->DIRECT_CMD = 0x00D60DE6;
     dmc->REFRESH_ENABLE = 0x00000001;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Setting dmc in READY mode\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] Setting dmc in READY mode\n");
 
     status = timer_api->time_to_timestamp(module_config->timer_id,
                                           TIMEOUT_DMC_INIT_US, &timeout);
@@ -329,7 +557,8 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
     dmc->SI0_SI_STATE_CONTROL = 0x00000000;
     dmc->SI1_SI_STATE_CONTROL = 0x00000000;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Waiting for Queue stall = 0...\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
+            "[DDR] Waiting for Queue stall = 0...\n");
 
     while ((dmc->QUEUE_STATUS & MOD_DMC500_QUEUE_STATUS_STALL_ACK) != 0) {
         status = timer_api->remaining(module_config->timer_id, timeout,
@@ -341,7 +570,8 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
             goto timeout;
     }
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Waiting for SI0 stall = 0...\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
+            "[DDR] Waiting for SI0 stall = 0...\n");
 
     while ((dmc->SI0_SI_STATUS & MOD_DMC500_SI_STATUS_STALL_ACK) != 0) {
         status = timer_api->remaining(module_config->timer_id, timeout,
@@ -353,7 +583,8 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
             goto timeout;
     }
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] Waiting for SI1 stall = 0...\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG,
+            "[DDR] Waiting for SI1 stall = 0...\n");
 
     while ((dmc->SI1_SI_STATUS & MOD_DMC500_SI_STATUS_STALL_ACK) != 0) {
         status = timer_api->remaining(module_config->timer_id, timeout,
@@ -365,12 +596,12 @@ static int sgm775_dmc500_config(struct mod_sgm775_dmc500_reg *dmc,
             goto timeout;
     }
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[DDR] DMC init done.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[DDR] DMC init done.\n");
 
     return FWK_SUCCESS;
 
 timeout:
-    log_api->log(MOD_LOG_GROUP_ERROR, "[DDR] Timed out in DMC500 init.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_ERROR, "[DDR] Timed out in DMC500 init.\n");
 
     return FWK_E_TIMEOUT;
 }
@@ -150,6 +150,9 @@ static int sgm775_system_process_notification(const struct fwk_event *event,
 
         scmi_notification_count = 0;
         sds_notification_received = false;
+
+        /* Start the modules that are not needed to boot the AP */
+        return fwk_module_start_deferred();
     }
 
     return FWK_SUCCESS;
@@ -0,0 +1,52 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <mod_irq_priority.h>
+#include <sgm775_irq.h>
+
+/*
+ * The MHU doorbells keep the highest priority and preempt the service routines
+ * of the timer and of the power management. The Cortex-M3 implements at least
+ * three priority bits.
+ */
+enum irq_priority {
+    IRQ_PRIORITY_MHU_LOW = 1,
+    IRQ_PRIORITY_TIMER = 2,
+    IRQ_PRIORITY_POWER = 3,
+};
+
+static const struct mod_irq_priority_entry priority_table[] = {
+    { .interrupt = MHU_LOW_PRIO_IRQ, .priority = IRQ_PRIORITY_MHU_LOW },
+    { .interrupt = TIMREFCLK_IRQ, .priority = IRQ_PRIORITY_TIMER },
+    { .interrupt = SOC_WAKEUP0_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_DEBUG_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_SYS0_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_SYS1_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE0_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE1_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE2_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE3_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE4_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE5_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE6_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_CLUS0CORE7_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_GPU_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_VPU_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_DPU0_IRQ, .priority = IRQ_PRIORITY_POWER },
+    { .interrupt = PPU_DPU1_IRQ, .priority = IRQ_PRIORITY_POWER },
+};
+
+const struct fwk_module_config config_irq_priority = {
+    .data = &((struct mod_irq_priority_config) {
+        .subpriority_bits = 0,
+        .priority_table = priority_table,
+        .priority_count = FWK_ARRAY_SIZE(priority_table),
+    }),
+};
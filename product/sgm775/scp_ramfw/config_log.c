@@ -55,6 +55,12 @@ static const struct mod_log_config log_data = {
     .banner = FWK_BANNER_SCP
               FWK_BANNER_RAM_FIRMWARE
               BUILD_VERSION_DESCRIBE_STRING "\n",
+    .heap_usage_summary = true,
+    .rate_limit_groups = MOD_LOG_GROUP_ERROR | MOD_LOG_GROUP_WARNING,
+    .rate_limit_entry_count = 8,
+    .rate_limit_burst = 4,
+    .rate_limit_period_ms = 1000,
+    .rate_limit_timer_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0),
 };
 
 struct fwk_module_config config_log = {
@@ -28,6 +28,7 @@ static struct fwk_element sgm775_ppu_v0_element_table[] = {
             .ppu.reg_base = PPU_DPU0_BASE,
             .ppu.irq = PPU_DPU0_IRQ,
             .default_power_on = true,
+            .async_transitions = true,
         }),
     },
     [PPU_V0_ELEMENT_IDX_DPU1TOP] = {
@@ -37,6 +38,7 @@ static struct fwk_element sgm775_ppu_v0_element_table[] = {
             .ppu.reg_base = PPU_DPU1_BASE,
             .ppu.irq = PPU_DPU1_IRQ,
             .default_power_on = true,
+            .async_transitions = true,
         }),
     },
     [PPU_V0_ELEMENT_IDX_GPUTOP] = {
@@ -46,6 +48,7 @@ static struct fwk_element sgm775_ppu_v0_element_table[] = {
             .ppu.reg_base = PPU_GPU_BASE,
             .ppu.irq = PPU_GPU_IRQ,
             .default_power_on = true,
+            .async_transitions = true,
         }),
     },
     [PPU_V0_ELEMENT_IDX_VPUTOP] = {
@@ -55,6 +58,7 @@ static struct fwk_element sgm775_ppu_v0_element_table[] = {
             .ppu.reg_base = PPU_VPU_BASE,
             .ppu.irq = PPU_VPU_IRQ,
             .default_power_on = true,
+            .async_transitions = true,
         }),
     },
     [PPU_V0_ELEMENT_IDX_SYS0] = {
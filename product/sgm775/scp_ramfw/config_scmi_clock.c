@@ -66,5 +66,8 @@ struct fwk_module_config config_scmi_clock = {
         .max_pending_transactions = 0,
         .agent_table = agent_table,
         .agent_count = FWK_ARRAY_SIZE(agent_table),
+        .gate_delay_us = 1000,
+        .gate_delay_alarm_id =
+            FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 1),
     }),
 };
@@ -46,6 +46,7 @@ static const struct fwk_element *get_reg_sensor_element_table(fwk_id_t id)
 
 struct fwk_module_config config_reg_sensor = {
     .get_element_table = get_reg_sensor_element_table,
+    .deferred_start = true,
 };
 
 /*
@@ -70,4 +71,5 @@ static const struct fwk_element *get_sensor_element_table(fwk_id_t module_id)
 struct fwk_module_config config_sensor = {
     .get_element_table = get_sensor_element_table,
     .data = NULL,
+    .deferred_start = true,
 };
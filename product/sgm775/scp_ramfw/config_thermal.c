@@ -0,0 +1,55 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_element.h>
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <mod_thermal.h>
+#include <config_dvfs.h>
+
+static const fwk_id_t soc_dvfs_domain_id_table[] = {
+    FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, DVFS_ELEMENT_IDX_LITTLE),
+    FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, DVFS_ELEMENT_IDX_BIG),
+    FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_DVFS, DVFS_ELEMENT_IDX_GPU),
+};
+
+/* Temperatures in degrees Celsius */
+static const struct mod_thermal_trip_point soc_trip_point_table[] = {
+    { .temperature = 85, .hysteresis = 5 },
+    { .temperature = 95, .hysteresis = 5 },
+    { .temperature = 105, .hysteresis = 5 },
+};
+
+static const struct fwk_element thermal_element_table[] = {
+    [0] = {
+        .name = "SoC",
+        .data = &((struct mod_thermal_zone_config) {
+            .sensor_id = FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_SENSOR, 0),
+            .dvfs_domain_id_table = soc_dvfs_domain_id_table,
+            .dvfs_domain_count = FWK_ARRAY_SIZE(soc_dvfs_domain_id_table),
+            .trip_point_table = soc_trip_point_table,
+            .trip_point_count = FWK_ARRAY_SIZE(soc_trip_point_table),
+            .governor = MOD_THERMAL_GOVERNOR_STEP_WISE,
+        }),
+    },
+    [1] = { 0 },
+};
+
+static const struct fwk_element *get_thermal_element_table(fwk_id_t module_id)
+{
+    return thermal_element_table;
+}
+
+struct fwk_module_config config_thermal = {
+    .get_element_table = get_thermal_element_table,
+    .data = &((struct mod_thermal_config) {
+        .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 0),
+        .polling_period_ms = 10,
+    }),
+};
@@ -13,6 +13,7 @@ BS_FIRMWARE_HAS_MULTITHREADING := yes
 BS_FIRMWARE_HAS_NOTIFICATION := yes
 
 BS_FIRMWARE_MODULES := \
+    irq_priority \
     pl011 \
     log \
     gtimer \
@@ -33,6 +34,7 @@ BS_FIRMWARE_MODULES := \
     dvfs \
     psu \
     mock_psu \
+    thermal \
     mhu \
     smt \
     scmi \
@@ -47,6 +49,7 @@ BS_FIRMWARE_MODULES := \
 BS_FIRMWARE_SOURCES := \
     rtx_config.c \
     sgm775_core.c \
+    config_irq_priority.c \
     config_log.c \
     config_timer.c \
     config_sgm775_ddr_phy500.c \
@@ -60,9 +63,11 @@ BS_FIRMWARE_SOURCES := \
     config_ppu_v1.c \
     config_power_domain.c \
     config_sensor.c \
+    config_scmi_sensor.c \
     config_dvfs.c \
     config_psu.c \
     config_mock_psu.c \
+    config_thermal.c \
     config_mhu.c \
     config_smt.c \
     config_scmi.c \
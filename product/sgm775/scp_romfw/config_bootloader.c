@@ -6,6 +6,7 @@
  */
 
 #include <fwk_element.h>
+#include <fwk_id.h>
 #include <fwk_macros.h>
 #include <fwk_module.h>
 #include <mod_bootloader.h>
@@ -19,6 +20,8 @@ static const struct mod_bootloader_config bootloader_module_config = {
     .destination_base = SCP_RAM_BASE,
     .destination_size = SCP_RAM_SIZE,
     .sds_struct_id = SGM775_SDS_BOOTLOADER,
+    .copy_driver_id = FWK_ID_NONE_INIT,
+    .timer_id = FWK_ID_NONE_INIT,
 };
 
 struct fwk_module_config config_bootloader = {
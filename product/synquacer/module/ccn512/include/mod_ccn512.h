@@ -96,6 +96,24 @@ typedef struct {
     */
 } ccn512_reg_t;
 
+/*!
+ * \brief QoS profiles of the ports of the CPU clusters and PCIe root
+ *      complexes.
+ */
+enum mod_ccn512_qos_profile {
+    /*! Same priority for the CPU clusters and the PCIe ports */
+    MOD_CCN512_QOS_PROFILE_BALANCED,
+
+    /*! Priority to the CPU clusters */
+    MOD_CCN512_QOS_PROFILE_LATENCY,
+
+    /*! Priority to the PCIe ports */
+    MOD_CCN512_QOS_PROFILE_BANDWIDTH,
+
+    /*! Number of QoS profiles */
+    MOD_CCN512_QOS_PROFILE_COUNT,
+};
+
 /*!
  * \brief APIs to configure ccn512.
  */
@@ -107,6 +125,23 @@ struct mod_ccn512_api {
      *
      */
     void (*ccn512_exit)(void);
+
+    /*!
+     * \brief Apply a QoS profile to all the crosspoints.
+     *
+     * \param profile QoS profile.
+     *
+     * \retval FWK_SUCCESS The profile was applied.
+     * \retval FWK_E_PARAM The profile is not valid.
+     */
+    int (*set_qos_profile)(enum mod_ccn512_qos_profile profile);
+
+    /*!
+     * \brief Get the QoS profile in use.
+     *
+     * \return QoS profile in use.
+     */
+    enum mod_ccn512_qos_profile (*get_qos_profile)(void);
 };
 
 /*!
@@ -115,6 +150,9 @@ struct mod_ccn512_api {
 struct mod_ccn512_module_config {
     /*! Base address of the device registers */
     ccn512_reg_t *reg_base;
+
+    /*! QoS profile applied at boot */
+    enum mod_ccn512_qos_profile qos_profile;
 };
 
 /*!
@@ -25,10 +25,80 @@ static struct mod_log_api *log_api;
 #define SNF_MP_ID_DMC0 0x8ULL
 #define SNF_MP_ID_DMC1 0x1AULL
 
+#define XP_COUNT 18
+#define XP_DEV_COUNT 2
+
+/* QoS value and enable bit of the QoS override of a device port */
+#define QOS_CONTROL_OVERRIDE_EN UINT64_C(0x4)
+#define QOS_CONTROL_OVERRIDE_VALUE_POS 16
+#define QOS_CONTROL_OVERRIDE(VALUE) \
+    (((uint64_t)(VALUE) << QOS_CONTROL_OVERRIDE_VALUE_POS) | \
+     QOS_CONTROL_OVERRIDE_EN)
+
+/* Class of the device attached to a crosspoint port */
+enum ccn512_port_class {
+    CCN512_PORT_NONE,
+    CCN512_PORT_CLUSTER,
+    CCN512_PORT_PCIE,
+    CCN512_PORT_CLASS_COUNT,
+};
+
+static const uint8_t port_class[XP_COUNT][XP_DEV_COUNT] = {
+    [0] = { CCN512_PORT_CLUSTER, CCN512_PORT_NONE }, /* Cluster 0 */
+    [5] = { CCN512_PORT_PCIE, CCN512_PORT_CLUSTER }, /* PCIE1, Cluster 2 */
+    [6] = { CCN512_PORT_CLUSTER, CCN512_PORT_NONE }, /* Cluster 6 */
+    [7] = { CCN512_PORT_CLUSTER, CCN512_PORT_CLUSTER }, /* Cluster 8, 10 */
+    [8] = { CCN512_PORT_NONE, CCN512_PORT_CLUSTER }, /* Cluster 5 */
+    [9] = { CCN512_PORT_CLUSTER, CCN512_PORT_PCIE }, /* Cluster 1, PCIE0 */
+    [14] = { CCN512_PORT_NONE, CCN512_PORT_CLUSTER }, /* Cluster 3 */
+    [15] = { CCN512_PORT_CLUSTER, CCN512_PORT_NONE }, /* Cluster 7 */
+    [16] = { CCN512_PORT_CLUSTER, CCN512_PORT_CLUSTER }, /* Cluster 9, 11 */
+    [17] = { CCN512_PORT_NONE, CCN512_PORT_CLUSTER }, /* Cluster 4 */
+};
+
+/* Value of the QoS control register of each class of port per profile */
+static const uint64_t
+    qos_profile_table[MOD_CCN512_QOS_PROFILE_COUNT][CCN512_PORT_CLASS_COUNT] = {
+    [MOD_CCN512_QOS_PROFILE_BALANCED] = {
+        [CCN512_PORT_CLUSTER] = QOS_CONTROL_OVERRIDE(0xE),
+        [CCN512_PORT_PCIE] = QOS_CONTROL_OVERRIDE(0xE),
+    },
+    [MOD_CCN512_QOS_PROFILE_LATENCY] = {
+        [CCN512_PORT_CLUSTER] = QOS_CONTROL_OVERRIDE(0xE),
+        [CCN512_PORT_PCIE] = QOS_CONTROL_OVERRIDE(0x8),
+    },
+    [MOD_CCN512_QOS_PROFILE_BANDWIDTH] = {
+        [CCN512_PORT_CLUSTER] = QOS_CONTROL_OVERRIDE(0x8),
+        [CCN512_PORT_PCIE] = QOS_CONTROL_OVERRIDE(0xE),
+    },
+};
+
+static enum mod_ccn512_qos_profile qos_profile;
+
+static void ccn512_qos_apply(
+    ccn512_reg_t *ccn512,
+    enum mod_ccn512_qos_profile profile)
+{
+    unsigned int xp_idx;
+    ccn5xx_xp_reg_t *xp = &ccn512->XP_ID_0;
+    const uint64_t *qos_control = qos_profile_table[profile];
+
+    for (xp_idx = 0; xp_idx < XP_COUNT; xp_idx++) {
+        xp[xp_idx].DEV0_QOS_CONTROL = qos_control[port_class[xp_idx][0]];
+        xp[xp_idx].DEV1_QOS_CONTROL = qos_control[port_class[xp_idx][1]];
+    }
+
+    qos_profile = profile;
+}
+
 static void ccn512_qos_init(ccn512_reg_t *ccn512)
 {
+    const struct mod_ccn512_module_config *module_config;
+
+    module_config = fwk_module_get_data(fwk_module_id_ccn512);
+
     /*
-     * Setting QOS priority for each CPU cluster to 0xE and setting the
+     * Setting QOS priority for each CPU cluster and PCIe port and setting the
      * enable bit so the new setting takes effect.  This function must be
      * called when there are no ongoing transactions on the ports being
      * configured, so it must be called after powering on SYSTOP and before
@@ -37,43 +107,7 @@ static void ccn512_qos_init(ccn512_reg_t *ccn512)
      * See "Device 0 Port QoS Control register" in the Corelink CCN512 Cache
      * Coherent Network technical reference manual.
      */
-    ccn512->XP_ID_0.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 0   */
-    ccn512->XP_ID_1.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_2.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_3.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_4.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_5.DEV0_QOS_CONTROL = 0xE0004; /* PCIE1       */
-    ccn512->XP_ID_6.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 6   */
-    ccn512->XP_ID_7.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 8   */
-    ccn512->XP_ID_8.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_9.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 1   */
-    ccn512->XP_ID_10.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_11.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_12.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_13.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_14.DEV0_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_15.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 7   */
-    ccn512->XP_ID_16.DEV0_QOS_CONTROL = 0xE0004; /* Cluster 9   */
-    ccn512->XP_ID_17.DEV0_QOS_CONTROL = 0;
-
-    ccn512->XP_ID_0.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_1.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_2.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_3.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_4.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_5.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 2   */
-    ccn512->XP_ID_6.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_7.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 10  */
-    ccn512->XP_ID_8.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 5   */
-    ccn512->XP_ID_9.DEV1_QOS_CONTROL = 0xE0004; /* PCIE0       */
-    ccn512->XP_ID_10.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_11.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_12.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_13.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_14.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 3   */
-    ccn512->XP_ID_15.DEV1_QOS_CONTROL = 0; /* not Cluster */
-    ccn512->XP_ID_16.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 11  */
-    ccn512->XP_ID_17.DEV1_QOS_CONTROL = 0xE0004; /* Cluster 4   */
+    ccn512_qos_apply(ccn512, module_config->qos_profile);
 }
 
 static void ccn512_dmc_init(ccn512_reg_t *ccn512)
@@ -136,7 +170,7 @@ void fw_ccn512_exit(void)
 
     ccn5xx_hnf_reg_t *hnf = &ccn512->HNF_ID_2;
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 exit.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 exit.\n");
 
     /* exit ALL CA53 CPU SNOOP */
     for (i = 0; i < HNF_COUNT; i++)
@@ -145,25 +179,58 @@ void fw_ccn512_exit(void)
     /* Wait for write operations to finish. */
     __DMB();
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 exit end.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 exit end.\n");
 }
 
 static int ccn512_config(ccn512_reg_t *ccn512)
 {
-    log_api->log(
+    MOD_LOG(log_api,
         MOD_LOG_GROUP_DEBUG,
         "[CCN512] Initialising ccn512 at 0x%x\n",
         (uintptr_t)ccn512);
 
     fw_ccn512_init(ccn512);
 
-    log_api->log(MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 init done.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[CCN512] CCN512 init done.\n");
 
     return FWK_SUCCESS;
 }
 
+static int ccn512_set_qos_profile(enum mod_ccn512_qos_profile profile)
+{
+    const struct mod_ccn512_module_config *module_config;
+
+    if (profile >= MOD_CCN512_QOS_PROFILE_COUNT)
+        return FWK_E_PARAM;
+
+    module_config = fwk_module_get_data(fwk_module_id_ccn512);
+    assert(module_config != NULL);
+
+    /*
+     * The QoS override stays enabled on the same ports whatever the profile,
+     * only the priority of the ports changes. All the crosspoints are updated
+     * before any other request is processed.
+     */
+    ccn512_qos_apply(module_config->reg_base, profile);
+
+    /* Wait for write operations to finish. */
+    __DMB();
+
+    MOD_LOG(log_api, MOD_LOG_GROUP_DEBUG, "[CCN512] QoS profile %u\n",
+        (unsigned int)profile);
+
+    return FWK_SUCCESS;
+}
+
+static enum mod_ccn512_qos_profile ccn512_get_qos_profile(void)
+{
+    return qos_profile;
+}
+
 static struct mod_ccn512_api module_api = {
     .ccn512_exit = fw_ccn512_exit,
+    .set_qos_profile = ccn512_set_qos_profile,
+    .get_qos_profile = ccn512_get_qos_profile,
 };
 
 /* Framework API */
@@ -172,6 +239,12 @@ static int mod_ccn512_init(
     unsigned int element_count,
     const void *data)
 {
+    const struct mod_ccn512_module_config *module_config = data;
+
+    if ((module_config == NULL) ||
+        (module_config->qos_profile >= MOD_CCN512_QOS_PROFILE_COUNT))
+        return FWK_E_DATA;
+
     return FWK_SUCCESS;
 }
 
@@ -9,6 +9,7 @@
 #define HSSPI_API_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <internal/hsspi_driver.h>
 
@@ -26,5 +27,13 @@ void HSSPI_init(void);
  * Finalize HS-SPI controller and external serial flash memory
  */
 void HSSPI_exit(void);
+/**
+ * Get the memory-mapped read window of the serial flash memory
+ */
+int HSSPI_get_read_window(uintptr_t *base, size_t *size);
+/**
+ * Read the serial flash memory through the memory-mapped read window
+ */
+int HSSPI_read(size_t offset, void *data, size_t size);
 
 #endif /* HSSPI_API_H */
@@ -8,6 +8,7 @@
 #ifndef MOD_HSSPI_H
 #define MOD_HSSPI_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <fwk_id.h>
 #include <internal/hsspi_api.h>
@@ -45,6 +46,39 @@ struct mod_hsspi_api {
      * \return void
      */
     void (*hsspi_exit)(void);
+
+    /*!
+     * \brief Get the memory-mapped read window of the flash memory.
+     *
+     * \details The flash memory can be read as plain memory through the
+     *      window, in quad output fast read mode when the flash memory
+     *      supports it, once the controller is initialized.
+     *
+     * \param[out] base Base address of the window.
+     * \param[out] size Size of the window in bytes.
+     *
+     * \retval FWK_SUCCESS The window is enabled.
+     * \retval FWK_E_PARAM An invalid parameter was given.
+     * \retval FWK_E_STATE The controller is not initialized.
+     */
+    int (*get_read_window)(uintptr_t *base, size_t *size);
+
+    /*!
+     * \brief Read the flash memory through the read window.
+     *
+     * \details The window is read with sequential word accesses, whatever the
+     *      alignment of the buffer.
+     *
+     * \param offset Offset of the data in the window.
+     * \param[out] data Buffer receiving the data.
+     * \param size Size of the data in bytes.
+     *
+     * \retval FWK_SUCCESS The data was read.
+     * \retval FWK_E_PARAM An invalid parameter was given.
+     * \retval FWK_E_STATE The controller is not initialized.
+     * \retval FWK_E_RANGE The data is not within the window.
+     */
+    int (*read)(size_t offset, void *data, size_t size);
 };
 
 /*!
@@ -6,7 +6,9 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <fwk_errno.h>
 #include <synquacer_debug.h>
 #include <synquacer_mmap.h>
 #include <low_level_access.h>
@@ -30,6 +32,12 @@ static const struct HSSPI_clk_config clk_config = CONFIG_SOC_HSSPI_CLK_CONFIG;
 #define CONFIG_SCB_FORCE_HSSPI_RESOURCE_ALLOCATION_MODEL \
     HSSPI_WINDOW_SIZE_INDEX_256MB
 
+/* Size of the read window selected by a window size index */
+#define HSSPI_WINDOW_SIZE(index) ((size_t)1 << ((index) + 13))
+
+/* The read window is set up in quad or dual output fast read mode */
+static bool read_window_enabled;
+
 void HSSPI_init(void)
 {
     int model_index;
@@ -58,6 +66,8 @@ void HSSPI_init(void)
         0, /* use_hsspi_cs1_flag disable*/
         (HSSPI_EN_CSCFG_MSEL_t)model_index);
 
+    read_window_enabled = true;
+
     xcpb_bridge_mode_set(false);
 }
 
@@ -69,6 +79,8 @@ void HSSPI_exit(void)
 
     model_index = CONFIG_SCB_FORCE_HSSPI_RESOURCE_ALLOCATION_MODEL;
 
+    read_window_enabled = false;
+
     /* Initialize HS-SPI controller and external serial flash memory */
     hsspi_exit(
         (volatile REG_ST_HSSPI_t *)HSSPI_REG_BASE,
@@ -80,3 +92,68 @@ void HSSPI_exit(void)
         0, /* use_hsspi_cs1_flag disable*/
         (HSSPI_EN_CSCFG_MSEL_t)model_index);
 }
+
+int HSSPI_get_read_window(uintptr_t *base, size_t *size)
+{
+    if ((base == NULL) || (size == NULL))
+        return FWK_E_PARAM;
+
+    if (!read_window_enabled)
+        return FWK_E_STATE;
+
+    *base = (uintptr_t)HSSPI_MEM_BASE;
+    *size = HSSPI_WINDOW_SIZE(CONFIG_SCB_FORCE_HSSPI_RESOURCE_ALLOCATION_MODEL);
+
+    return FWK_SUCCESS;
+}
+
+/*
+ * The window is read with sequential word accesses, which take a quarter of
+ * the fast read transactions of a byte copy. Only the unaligned head and tail
+ * of the data are read byte by byte.
+ */
+int HSSPI_read(size_t offset, void *data, size_t size)
+{
+    const size_t window_size =
+        HSSPI_WINDOW_SIZE(CONFIG_SCB_FORCE_HSSPI_RESOURCE_ALLOCATION_MODEL);
+    uintptr_t src;
+    uint8_t *dst = data;
+    uint32_t word;
+
+    if ((data == NULL) && (size != 0))
+        return FWK_E_PARAM;
+
+    if (!read_window_enabled)
+        return FWK_E_STATE;
+
+    if ((offset > window_size) || (size > (window_size - offset)))
+        return FWK_E_RANGE;
+
+    src = (uintptr_t)HSSPI_MEM_BASE + offset;
+
+    for (; (size != 0) && ((src & 0x3) != 0); size--)
+        *dst++ = *MEM_HSSPI_BYTE(src++);
+
+    if (((uintptr_t)dst & 0x3) == 0) {
+        for (; size >= sizeof(word); size -= sizeof(word)) {
+            *(uint32_t *)dst = *MEM_HSSPI_WORD(src);
+            dst += sizeof(word);
+            src += sizeof(word);
+        }
+    } else {
+        for (; size >= sizeof(word); size -= sizeof(word)) {
+            word = *MEM_HSSPI_WORD(src);
+            dst[0] = (uint8_t)word;
+            dst[1] = (uint8_t)(word >> 8);
+            dst[2] = (uint8_t)(word >> 16);
+            dst[3] = (uint8_t)(word >> 24);
+            dst += sizeof(word);
+            src += sizeof(word);
+        }
+    }
+
+    for (; size != 0; size--)
+        *dst++ = *MEM_HSSPI_BYTE(src++);
+
+    return FWK_SUCCESS;
+}
@@ -21,6 +21,8 @@
 static struct mod_hsspi_api module_api = {
     .hsspi_init = HSSPI_init,
     .hsspi_exit = HSSPI_exit,
+    .get_read_window = HSSPI_get_read_window,
+    .read = HSSPI_read,
 };
 
 /*
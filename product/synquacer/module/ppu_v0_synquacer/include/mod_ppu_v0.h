@@ -13,6 +13,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <fwk_id.h>
 #include <mod_power_domain.h>
 
 /*!
@@ -59,6 +60,29 @@ struct mod_ppu_v0_pd_config {
      * Flag indicating if this domain should be powered on during element init.
      */
     bool default_power_on;
+
+    /*!
+     * \brief Complete the transitions asynchronously.
+     *
+     * \details When set, the state of the PPU is polled with the alarm of the
+     *      module configuration and the transition is reported once the
+     *      requested mode has been reached, instead of being waited for. The
+     *      transitions of the resets are still waited for.
+     */
+    bool async_transitions;
+};
+
+/*!
+ * \brief Module configuration.
+ */
+struct mod_ppu_v0_config {
+    /*!
+     * \brief Sub-element identifier of the alarm polling the PPUs with
+     *      asynchronous transitions.
+     *
+     * \details The alarm is shared by all the power domains of the module.
+     */
+    fwk_id_t alarm_id;
 };
 
 /*!
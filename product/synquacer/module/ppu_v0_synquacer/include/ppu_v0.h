@@ -137,6 +137,8 @@ enum ppu_v0_mode {
 void ppu_v0_init(struct ppu_v0_reg *ppu);
 int ppu_v0_request_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode);
 int ppu_v0_set_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode);
+bool ppu_v0_is_power_mode_reached(struct ppu_v0_reg *ppu,
+                                  enum ppu_v0_mode mode);
 int ppu_v0_get_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode *mode);
 
 /*!
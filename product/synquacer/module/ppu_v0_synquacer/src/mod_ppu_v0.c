@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <fwk_assert.h>
 #include <fwk_id.h>
+#include <fwk_interrupt.h>
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
@@ -21,8 +22,13 @@
 #if BUILD_HAS_MOD_SYSTEM_POWER
 #include <mod_system_power.h>
 #endif
+#if BUILD_HAS_MOD_TIMER
+#include <mod_timer.h>
+#endif
 #include <ppu_v0.h>
 
+#define PPU_V0_TRANSITION_POLL_PERIOD_US 10
+
 /* Power domain context */
 struct ppu_v0_pd_ctx {
     /* Power domain configuration data */
@@ -36,6 +42,15 @@ struct ppu_v0_pd_ctx {
 
     /* Power module driver input API */
     struct mod_pd_driver_input_api *pd_driver_input_api;
+
+    /* An asynchronous transition is pending */
+    volatile bool transition_pending;
+
+    /* Mode requested by the pending transition */
+    enum ppu_v0_mode pending_mode;
+
+    /* Power state to report once the pending transition has completed */
+    unsigned int pending_state;
 };
 
 /* Module context */
@@ -45,6 +60,20 @@ struct ppu_v0_ctx {
 
     /* Log API */
     struct mod_log_api *log_api;
+
+    /* Number of power domains */
+    unsigned int pd_count;
+
+    /* Module configuration, NULL when no transition is asynchronous */
+    const struct mod_ppu_v0_config *config;
+
+#if BUILD_HAS_MOD_TIMER
+    /* Alarm API */
+    const struct mod_timer_alarm_api *alarm_api;
+#endif
+
+    /* The alarm polling the pending transitions is running */
+    bool alarm_active;
 };
 
 /*
@@ -84,14 +113,14 @@ static int get_state(struct ppu_v0_reg *ppu, unsigned int *state)
 
     *state = ppu_mode_to_power_state[ppu_mode];
     if (*state == MODE_UNSUPPORTED) {
-        ppu_v0_ctx.log_api->log(
+        MOD_LOG(ppu_v0_ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[PPUV0] Unexpected PPU mode (%i).\n",
             ppu_mode);
         return FWK_E_DEVICE;
     }
 
-    ppu_v0_ctx.log_api->log(
+    MOD_LOG(ppu_v0_ctx.log_api,
         MOD_LOG_GROUP_INFO, "[PPUV0] get state reg=0x%x (0x%x)\n", ppu, *state);
 
     return FWK_SUCCESS;
@@ -104,6 +133,100 @@ static int pd_init(struct ppu_v0_pd_ctx *pd_ctx)
     return FWK_SUCCESS;
 }
 
+static void report_state(struct ppu_v0_pd_ctx *pd_ctx, unsigned int state)
+{
+    int status;
+
+    status = pd_ctx->pd_driver_input_api->report_power_state_transition(
+        pd_ctx->bound_id, state);
+    assert(status == FWK_SUCCESS);
+    (void)status;
+}
+
+#if BUILD_HAS_MOD_TIMER
+/*
+ * Alarm callback polling the power domains with a pending transition. The
+ * alarm is started again as long as a transition is pending.
+ */
+static void transition_poll(uintptr_t param)
+{
+    int status;
+    unsigned int pd_idx;
+    struct ppu_v0_pd_ctx *pd_ctx;
+    bool pending = false;
+
+    for (pd_idx = 0; pd_idx < ppu_v0_ctx.pd_count; pd_idx++) {
+        pd_ctx = &ppu_v0_ctx.pd_ctx_table[pd_idx];
+        if (!pd_ctx->transition_pending)
+            continue;
+
+        if (!ppu_v0_is_power_mode_reached(pd_ctx->ppu,
+                                          pd_ctx->pending_mode)) {
+            pending = true;
+            continue;
+        }
+
+        pd_ctx->transition_pending = false;
+        report_state(pd_ctx, pd_ctx->pending_state);
+    }
+
+    if (!pending) {
+        ppu_v0_ctx.alarm_active = false;
+        return;
+    }
+
+    status = ppu_v0_ctx.alarm_api->start_us(ppu_v0_ctx.config->alarm_id,
+        PPU_V0_TRANSITION_POLL_PERIOD_US, MOD_TIMER_ALARM_TYPE_ONCE,
+        transition_poll, 0);
+    assert(status == FWK_SUCCESS);
+}
+#endif
+
+/*
+ * Set the power mode of a PPU.
+ *
+ * \retval FWK_SUCCESS The power mode has been reached.
+ * \retval FWK_PENDING The transition is reported once the alarm has polled
+ *      the completion of the transition.
+ */
+static int set_power_mode(struct ppu_v0_pd_ctx *pd_ctx, enum ppu_v0_mode mode,
+                          unsigned int state)
+{
+    int status = FWK_SUCCESS;
+
+    if (!pd_ctx->config->async_transitions)
+        return ppu_v0_set_power_mode(pd_ctx->ppu, mode);
+
+#if BUILD_HAS_MOD_TIMER
+    status = ppu_v0_request_power_mode(pd_ctx->ppu, mode);
+    if (status != FWK_SUCCESS)
+        return status;
+
+    if (ppu_v0_is_power_mode_reached(pd_ctx->ppu, mode))
+        return FWK_SUCCESS;
+
+    pd_ctx->pending_mode = mode;
+    pd_ctx->pending_state = state;
+
+    fwk_interrupt_global_disable();
+
+    pd_ctx->transition_pending = true;
+    if (!ppu_v0_ctx.alarm_active) {
+        status = ppu_v0_ctx.alarm_api->start_us(ppu_v0_ctx.config->alarm_id,
+            PPU_V0_TRANSITION_POLL_PERIOD_US, MOD_TIMER_ALARM_TYPE_ONCE,
+            transition_poll, 0);
+        if (status == FWK_SUCCESS)
+            ppu_v0_ctx.alarm_active = true;
+        else
+            pd_ctx->transition_pending = false;
+    }
+
+    fwk_interrupt_global_enable();
+#endif
+
+    return (status == FWK_SUCCESS) ? FWK_PENDING : FWK_E_DEVICE;
+}
+
 static int pd_set_state(fwk_id_t pd_id, unsigned int state)
 {
     int status;
@@ -115,7 +238,7 @@ static int pd_set_state(fwk_id_t pd_id, unsigned int state)
 
     pd_ctx = ppu_v0_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
 
-    ppu_v0_ctx.log_api->log(
+    MOD_LOG(ppu_v0_ctx.log_api,
         MOD_LOG_GROUP_INFO,
         "[PPUV0] set_state start. reg=(0x%x) state=(0x%x)\n",
         pd_ctx->ppu,
@@ -123,22 +246,24 @@ static int pd_set_state(fwk_id_t pd_id, unsigned int state)
 
     switch (state) {
     case MOD_PD_STATE_ON:
-        ppu_v0_set_power_mode(pd_ctx->ppu, PPU_V0_MODE_ON);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_ON);
+        status = set_power_mode(pd_ctx, PPU_V0_MODE_ON, state);
+        if (status == FWK_PENDING)
+            break;
+        if (status != FWK_SUCCESS)
+            return status;
 
-        ppu_v0_ctx.log_api->log(
+        report_state(pd_ctx, MOD_PD_STATE_ON);
+
+        MOD_LOG(ppu_v0_ctx.log_api,
             MOD_LOG_GROUP_INFO,
             "[PPUV0] set_state end. reg=(0x%x) state=(0x%x)\n",
             pd_ctx->ppu,
             state);
-
-        assert(status == FWK_SUCCESS);
         break;
 
     case MOD_PD_STATE_OFF:
         if (pd_ctx->config->pd_type == MOD_PD_TYPE_SYSTEM) {
-            ppu_v0_ctx.log_api->log(
+            MOD_LOG(ppu_v0_ctx.log_api,
                 MOD_LOG_GROUP_INFO,
                 "[PPUV0] SYNQUACER SYSTEM module will shutdown the system\n");
             break;
@@ -153,21 +278,23 @@ static int pd_set_state(fwk_id_t pd_id, unsigned int state)
         pd_ctx->ppu->POWER_CFG &= ~PPU_PCR_DEV_ACTIVE_EN;
         pd_ctx->ppu->POWER_CFG &= ~PPU_PCR_DEV_REQ_EN;
 
-        ppu_v0_set_power_mode(pd_ctx->ppu, PPU_V0_MODE_OFF);
-        status = pd_ctx->pd_driver_input_api->report_power_state_transition(
-            pd_ctx->bound_id, MOD_PD_STATE_OFF);
+        status = set_power_mode(pd_ctx, PPU_V0_MODE_OFF, state);
+        if (status == FWK_PENDING)
+            break;
+        if (status != FWK_SUCCESS)
+            return status;
 
-        ppu_v0_ctx.log_api->log(
+        report_state(pd_ctx, MOD_PD_STATE_OFF);
+
+        MOD_LOG(ppu_v0_ctx.log_api,
             MOD_LOG_GROUP_INFO,
             "[PPUV0] set_state end. reg=(0x%x) state=(0x%x)\n",
             pd_ctx->ppu,
             state);
-
-        assert(status == FWK_SUCCESS);
         break;
 
     default:
-        ppu_v0_ctx.log_api->log(
+        MOD_LOG(ppu_v0_ctx.log_api,
             MOD_LOG_GROUP_ERROR,
             "[PPUV0] Requested power state (%i) is not supported.\n",
             state);
@@ -239,13 +366,16 @@ static const struct mod_pd_driver_api pd_driver = {
 static int ppu_v0_mod_init(
     fwk_id_t module_id,
     unsigned int pd_count,
-    const void *unused)
+    const void *data)
 {
     ppu_v0_ctx.pd_ctx_table =
         fwk_mm_calloc(pd_count, sizeof(struct ppu_v0_pd_ctx));
     if (ppu_v0_ctx.pd_ctx_table == NULL)
         return FWK_E_NOMEM;
 
+    ppu_v0_ctx.pd_count = pd_count;
+    ppu_v0_ctx.config = data;
+
     return FWK_SUCCESS;
 }
 
@@ -258,6 +388,15 @@ static int ppu_v0_pd_init(fwk_id_t pd_id, unsigned int unused, const void *data)
     if (config->pd_type >= MOD_PD_TYPE_COUNT)
         return FWK_E_DATA;
 
+    if (config->async_transitions) {
+#if BUILD_HAS_MOD_TIMER
+        if (ppu_v0_ctx.config == NULL)
+            return FWK_E_DATA;
+#else
+        return FWK_E_SUPPORT;
+#endif
+    }
+
     pd_ctx = ppu_v0_ctx.pd_ctx_table + fwk_id_get_element_idx(pd_id);
     pd_ctx->config = config;
     pd_ctx->ppu = (struct ppu_v0_reg *)(config->ppu.reg_base);
@@ -285,8 +424,11 @@ static int ppu_v0_pd_init(fwk_id_t pd_id, unsigned int unused, const void *data)
 
 static int ppu_v0_bind(fwk_id_t id, unsigned int round)
 {
+    int status;
     struct ppu_v0_pd_ctx *pd_ctx;
 
+    (void)status;
+
     /* Nothing to do during the first round of calls where the power module
        will bind to the power domains of this module. */
     if (round == 0)
@@ -294,6 +436,17 @@ static int ppu_v0_bind(fwk_id_t id, unsigned int round)
 
     /* In the case of the module, bind to the log component */
     if (fwk_module_is_valid_module_id(id)) {
+#if BUILD_HAS_MOD_TIMER
+        /* Bind to the alarm polling the asynchronous transitions */
+        if (ppu_v0_ctx.config != NULL) {
+            status = fwk_module_bind(ppu_v0_ctx.config->alarm_id,
+                                     MOD_TIMER_API_ID_ALARM,
+                                     &ppu_v0_ctx.alarm_api);
+            if (status != FWK_SUCCESS)
+                return status;
+        }
+#endif
+
         return fwk_module_bind(
             FWK_ID_MODULE(FWK_MODULE_IDX_LOG),
             FWK_ID_API(FWK_MODULE_IDX_LOG, 0),
@@ -46,13 +46,21 @@ int ppu_v0_set_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode mode)
     if (status != FWK_SUCCESS)
         return status;
 
-    while ((ppu->POWER_STATUS & (PPU_V0_PSR_POWSTAT | PPU_V0_PSR_DYNAMIC)) !=
-           mode)
+    while (!ppu_v0_is_power_mode_reached(ppu, mode))
         continue;
 
     return FWK_SUCCESS;
 }
 
+bool ppu_v0_is_power_mode_reached(struct ppu_v0_reg *ppu,
+                                  enum ppu_v0_mode mode)
+{
+    assert(ppu != NULL);
+
+    return (ppu->POWER_STATUS & (PPU_V0_PSR_POWSTAT | PPU_V0_PSR_DYNAMIC))
+           == mode;
+}
+
 int ppu_v0_get_power_mode(struct ppu_v0_reg *ppu, enum ppu_v0_mode *mode)
 {
     assert(ppu != NULL);
@@ -37,6 +37,12 @@
 enum scmi_vendor_ext_command_id {
     /*! Retrieve DRAM mapping information */
     SCMI_VENDOR_EXT_MEMORY_INFO_GET = 0x003,
+    /*! Select the QoS profile of the interconnect */
+    SCMI_VENDOR_EXT_QOS_PROFILE_SET = 0x004,
+    /*! Retrieve the QoS profile of the interconnect */
+    SCMI_VENDOR_EXT_QOS_PROFILE_GET = 0x005,
+    /*! Retrieve the load of the SCP */
+    SCMI_VENDOR_EXT_LOAD_GET = 0x006,
 };
 
 /*!
@@ -94,6 +100,68 @@ struct scmi_vendor_ext_memory_info_get_resp {
     struct synquacer_memory_info meminfo;
 };
 
+/*
+ * QoS profile set and get structures
+ */
+
+/*!
+ * \brief QoS profile set request.
+ */
+struct __attribute((packed)) scmi_vendor_ext_qos_profile_set_a2p {
+    /*! QoS profile, see ::mod_ccn512_qos_profile. */
+    uint32_t profile;
+};
+
+/*!
+ * \brief QoS profile set response.
+ */
+struct __attribute((packed)) scmi_vendor_ext_qos_profile_set_p2a {
+    /*! SCMI status. */
+    int32_t status;
+};
+
+/*!
+ * \brief QoS profile get response.
+ */
+struct __attribute((packed)) scmi_vendor_ext_qos_profile_get_p2a {
+    /*! SCMI status. */
+    int32_t status;
+    /*! QoS profile, see ::mod_ccn512_qos_profile. */
+    uint32_t profile;
+};
+
+/*
+ * Load get structures
+ */
+
+/*! Index of the load of the whole SCP in the load get request. */
+#define SCMI_VENDOR_EXT_LOAD_INDEX_SCP UINT32_C(0)
+
+/*!
+ * \brief Load get request.
+ */
+struct __attribute((packed)) scmi_vendor_ext_load_get_a2p {
+    /*!
+     * Index of the load, SCMI_VENDOR_EXT_LOAD_INDEX_SCP for the load of the
+     * whole SCP, n for the load due to the n-th monitored module.
+     */
+    uint32_t index;
+};
+
+/*!
+ * \brief Load get response.
+ */
+struct __attribute((packed)) scmi_vendor_ext_load_get_p2a {
+    /*! SCMI status, SCMI_NOT_FOUND past the last monitored module. */
+    int32_t status;
+    /*! Load in hundredths of a percent. */
+    uint32_t load;
+    /*! Duration of the window the load is computed over in milliseconds. */
+    uint32_t window_ms;
+    /*! Firmware index of the module, 0xFFFFFFFF for the whole SCP. */
+    uint32_t module_idx;
+};
+
 /*!
  * @}
  */
@@ -13,6 +13,10 @@
 #include <fwk_macros.h>
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
+#include <mod_ccn512.h>
+#if BUILD_HAS_MOD_LOAD_MONITOR
+#include <mod_load_monitor.h>
+#endif
 #include <mod_log.h>
 #include <mod_scmi.h>
 #include <ddr_init.h>
@@ -24,6 +28,10 @@ struct scmi_vendor_ext_ctx {
     const struct mod_scmi_from_protocol_api *scmi_api;
     const struct mod_vendor_ext_api *vendor_ext_api;
     const struct mod_log_api *log_api;
+    const struct mod_ccn512_api *ccn512_api;
+#if BUILD_HAS_MOD_LOAD_MONITOR
+    const struct mod_load_monitor_api *load_monitor_api;
+#endif
     uint32_t vendor_ext_count;
 };
 
@@ -39,27 +47,50 @@ static int scmi_vendor_ext_protocol_msg_attributes_handler(
 static int scmi_vendor_ext_protocol_memory_info_get_handler(
     fwk_id_t service_id,
     const uint32_t *payload);
+static int scmi_vendor_ext_protocol_qos_profile_set_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+static int scmi_vendor_ext_protocol_qos_profile_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+#if BUILD_HAS_MOD_LOAD_MONITOR
+static int scmi_vendor_ext_protocol_load_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload);
+#endif
 
 /*
  * Internal variables.
  */
 static struct scmi_vendor_ext_ctx scmi_vendor_ext_ctx;
 
-static int (*handler_table[])(fwk_id_t, const uint32_t *) = {
-    [SCMI_PROTOCOL_VERSION] = scmi_vendor_ext_protocol_version_handler,
-    [SCMI_PROTOCOL_ATTRIBUTES] = scmi_vendor_ext_protocol_attributes_handler,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        scmi_vendor_ext_protocol_msg_attributes_handler,
-    [SCMI_VENDOR_EXT_MEMORY_INFO_GET] =
-        scmi_vendor_ext_protocol_memory_info_get_handler,
-};
-
-static unsigned int payload_size_table[] = {
-    [SCMI_PROTOCOL_VERSION] = 0,
-    [SCMI_PROTOCOL_ATTRIBUTES] = 0,
-    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] =
-        sizeof(struct scmi_protocol_message_attributes_a2p),
-    [SCMI_VENDOR_EXT_MEMORY_INFO_GET] = 0,
+static const struct mod_scmi_message_desc message_table[] = {
+    [SCMI_PROTOCOL_VERSION] = {
+        .handler = scmi_vendor_ext_protocol_version_handler,
+    },
+    [SCMI_PROTOCOL_ATTRIBUTES] = {
+        .handler = scmi_vendor_ext_protocol_attributes_handler,
+    },
+    [SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = {
+        .handler = scmi_vendor_ext_protocol_msg_attributes_handler,
+        .payload_size = sizeof(struct scmi_protocol_message_attributes_a2p),
+    },
+    [SCMI_VENDOR_EXT_MEMORY_INFO_GET] = {
+        .handler = scmi_vendor_ext_protocol_memory_info_get_handler,
+    },
+    [SCMI_VENDOR_EXT_QOS_PROFILE_SET] = {
+        .handler = scmi_vendor_ext_protocol_qos_profile_set_handler,
+        .payload_size = sizeof(struct scmi_vendor_ext_qos_profile_set_a2p),
+    },
+    [SCMI_VENDOR_EXT_QOS_PROFILE_GET] = {
+        .handler = scmi_vendor_ext_protocol_qos_profile_get_handler,
+    },
+#if BUILD_HAS_MOD_LOAD_MONITOR
+    [SCMI_VENDOR_EXT_LOAD_GET] = {
+        .handler = scmi_vendor_ext_protocol_load_get_handler,
+        .payload_size = sizeof(struct scmi_vendor_ext_load_get_a2p),
+    },
+#endif
 };
 
 /*
@@ -104,8 +135,8 @@ static int scmi_vendor_ext_protocol_msg_attributes_handler(
 
     parameters = (const struct scmi_protocol_message_attributes_a2p *)payload;
 
-    if ((parameters->message_id < FWK_ARRAY_SIZE(handler_table)) &&
-        (handler_table[parameters->message_id] != NULL)) {
+    if ((parameters->message_id < FWK_ARRAY_SIZE(message_table)) &&
+        (message_table[parameters->message_id].handler != NULL)) {
         return_values = (struct scmi_protocol_message_attributes_p2a) {
             .status = SCMI_SUCCESS,
             /* All commands have an attributes value of 0 */
@@ -194,7 +225,7 @@ static int scmi_vendor_ext_protocol_memory_info_get_handler(
 {
     memset(&resp, 0, sizeof(struct scmi_vendor_ext_memory_info_get_resp));
 
-    scmi_vendor_ext_ctx.log_api->log(
+    MOD_LOG(scmi_vendor_ext_ctx.log_api,
         MOD_LOG_GROUP_DEBUG, "[scmi_vendor_ext] memory info get handler.\n");
 
     get_memory_info(&resp.meminfo);
@@ -204,68 +235,119 @@ static int scmi_vendor_ext_protocol_memory_info_get_handler(
     return FWK_SUCCESS;
 }
 
-/*
- * SCMI module -> SCMI vendor_ext module interface
- */
-static int scmi_vendor_ext_get_scmi_protocol_id(
-    fwk_id_t protocol_id,
-    uint8_t *scmi_protocol_id)
+static int scmi_vendor_ext_protocol_qos_profile_set_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
 {
     int status;
+    const struct scmi_vendor_ext_qos_profile_set_a2p *parameters;
+    struct scmi_vendor_ext_qos_profile_set_p2a return_values = {
+        .status = SCMI_SUCCESS,
+    };
 
-    status = fwk_module_check_call(protocol_id);
+    parameters = (const struct scmi_vendor_ext_qos_profile_set_a2p *)payload;
+
+    if (parameters->profile >= MOD_CCN512_QOS_PROFILE_COUNT) {
+        return_values.status = SCMI_INVALID_PARAMETERS;
+        goto exit;
+    }
+
+    status = scmi_vendor_ext_ctx.ccn512_api->set_qos_profile(
+        (enum mod_ccn512_qos_profile)parameters->profile);
     if (status != FWK_SUCCESS)
-        return status;
+        return_values.status = SCMI_GENERIC_ERROR;
 
-    *scmi_protocol_id = SCMI_PROTOCOL_ID_VENDOR_EXT;
+exit:
+    scmi_vendor_ext_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
 
     return FWK_SUCCESS;
 }
 
-static int scmi_vendor_ext_message_handler(
-    fwk_id_t protocol_id,
+static int scmi_vendor_ext_protocol_qos_profile_get_handler(
+    fwk_id_t service_id,
+    const uint32_t *payload)
+{
+    struct scmi_vendor_ext_qos_profile_get_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .profile = scmi_vendor_ext_ctx.ccn512_api->get_qos_profile(),
+    };
+
+    scmi_vendor_ext_ctx.scmi_api->respond(
+        service_id, &return_values, sizeof(return_values));
+
+    return FWK_SUCCESS;
+}
+
+#if BUILD_HAS_MOD_LOAD_MONITOR
+static int scmi_vendor_ext_protocol_load_get_handler(
     fwk_id_t service_id,
-    const uint32_t *payload,
-    size_t payload_size,
-    unsigned int message_id)
+    const uint32_t *payload)
 {
     int status;
-    int32_t return_value;
+    const struct scmi_vendor_ext_load_get_a2p *parameters;
+    const struct mod_load_monitor_api *load_monitor_api;
+    struct scmi_vendor_ext_load_get_p2a return_values = {
+        .status = SCMI_SUCCESS,
+        .module_idx = UINT32_MAX,
+    };
+    fwk_id_t module_id;
+    unsigned int load, window_ms;
+
+    parameters = (const struct scmi_vendor_ext_load_get_a2p *)payload;
+    load_monitor_api = scmi_vendor_ext_ctx.load_monitor_api;
+
+    status = load_monitor_api->get_load(&load, &window_ms);
+    if ((status == FWK_SUCCESS) &&
+        (parameters->index != SCMI_VENDOR_EXT_LOAD_INDEX_SCP)) {
+        status = load_monitor_api->get_module_load(parameters->index - 1,
+                                                   &module_id, &load);
+        return_values.module_idx = fwk_id_get_module_idx(module_id);
+    }
 
-    scmi_vendor_ext_ctx.log_api->log(
-        MOD_LOG_GROUP_DEBUG, "[scmi_vendor_ext] message handler.\n");
+    if (status == FWK_SUCCESS) {
+        return_values.load = load;
+        return_values.window_ms = window_ms;
+    } else if (status == FWK_E_RANGE)
+        return_values.status = SCMI_NOT_FOUND;
+    else if (status == FWK_E_STATE)
+        return_values.status = SCMI_BUSY;
+    else
+        return_values.status = SCMI_GENERIC_ERROR;
 
-    status = fwk_module_check_call(protocol_id);
-    if (status != FWK_SUCCESS)
-        return status;
+    scmi_vendor_ext_ctx.scmi_api->respond(
+        service_id,
+        &return_values,
+        (return_values.status == SCMI_SUCCESS) ? sizeof(return_values) :
+                                                 sizeof(return_values.status));
 
-    static_assert(
-        FWK_ARRAY_SIZE(handler_table) == FWK_ARRAY_SIZE(payload_size_table),
-        "[SCMI] vendor_ext management protocol table sizes not consistent");
-    assert(payload != NULL);
+    return FWK_SUCCESS;
+}
+#endif
 
-    if (message_id >= FWK_ARRAY_SIZE(handler_table)) {
-        return_value = SCMI_NOT_SUPPORTED;
-        goto error;
-    }
+/*
+ * SCMI module -> SCMI vendor_ext module interface
+ */
+static int scmi_vendor_ext_get_scmi_protocol_id(
+    fwk_id_t protocol_id,
+    uint8_t *scmi_protocol_id)
+{
+    int status;
 
-    if (payload_size != payload_size_table[message_id]) {
-        return_value = SCMI_PROTOCOL_ERROR;
-        goto error;
-    }
+    status = fwk_module_check_call(protocol_id);
+    if (status != FWK_SUCCESS)
+        return status;
 
-    return handler_table[message_id](service_id, payload);
+    *scmi_protocol_id = SCMI_PROTOCOL_ID_VENDOR_EXT;
 
-error:
-    scmi_vendor_ext_ctx.scmi_api->respond(
-        service_id, &return_value, sizeof(return_value));
     return FWK_SUCCESS;
 }
 
 static struct mod_scmi_to_protocol_api
     scmi_vendor_ext_mod_scmi_to_protocol_api = {
         .get_scmi_protocol_id = scmi_vendor_ext_get_scmi_protocol_id,
-        .message_handler = scmi_vendor_ext_message_handler
+        .message_table = message_table,
+        .message_count = FWK_ARRAY_SIZE(message_table),
     };
 
 /*
@@ -309,7 +391,19 @@ static int scmi_vendor_ext_bind(fwk_id_t id, unsigned int round)
         return status;
     }
 
-    return FWK_SUCCESS;
+#if BUILD_HAS_MOD_LOAD_MONITOR
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_LOAD_MONITOR),
+        mod_load_monitor_api_id_load,
+        &scmi_vendor_ext_ctx.load_monitor_api);
+    if (status != FWK_SUCCESS)
+        return status;
+#endif
+
+    return fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_CCN512),
+        FWK_ID_API(FWK_MODULE_IDX_CCN512, 0),
+        &scmi_vendor_ext_ctx.ccn512_api);
 }
 
 static int scmi_vendor_ext_process_bind_request(
@@ -321,7 +415,7 @@ static int scmi_vendor_ext_process_bind_request(
     if (!fwk_id_is_equal(source_id, FWK_ID_MODULE(FWK_MODULE_IDX_SCMI)))
         return FWK_E_ACCESS;
 
-    scmi_vendor_ext_ctx.log_api->log(
+    MOD_LOG(scmi_vendor_ext_ctx.log_api,
         MOD_LOG_GROUP_DEBUG, "[scmi_vendor_ext] process bind request.\n");
 
     *api = &scmi_vendor_ext_mod_scmi_to_protocol_api;
@@ -5,13 +5,16 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stddef.h>
 #include <stdint.h>
+#include <mod_reg_script.h>
 #include <synquacer_config.h>
 #include <synquacer_ddr.h>
 #include <boot_ctl.h>
 #include <ddr_init.h>
 
 extern void usleep_en(uint32_t usec);
+extern const struct mod_reg_script_api *reg_script_api;
 
 int ddr_init_mc0_mp(REG_ST_DMC520 *REG_DMC520);
 int ddr_init_phy0_mp(REG_ST_DDRPHY_CONFIG_t *REG_DDRPHY_CONFIG,
@@ -1028,62 +1031,50 @@ int ddr_init_sdram_mp(
     return 0;
 }
 
-int ddr_init_mc1_mp(REG_ST_DMC520 *REG_DMC520)
-{
-    REG_DMC520->memc_status;
-    REG_DMC520->memc_config;
+#define DMC520_REG(FIELD) offsetof(REG_ST_DMC520, FIELD)
 
-    // POWERDOWN_ENTRY
-    REG_DMC520->direct_addr = 0x00000006;
-    REG_DMC520->direct_cmd = 0x000F0004;
-    REG_DMC520->memc_status;
+#define DMC520_DIRECT_CMD(ADDR, CMD) \
+    MOD_REG_SCRIPT_WRITE(DMC520_REG(direct_addr), (ADDR)), \
+    MOD_REG_SCRIPT_WRITE(DMC520_REG(direct_cmd), (CMD)), \
+    MOD_REG_SCRIPT_READ(DMC520_REG(memc_status))
 
-    // wait
-    usleep_en(500);
+static const uint32_t ddr_init_mc1_script[] = {
+    MOD_REG_SCRIPT_READ(DMC520_REG(memc_status)),
+    MOD_REG_SCRIPT_READ(DMC520_REG(memc_config)),
 
-    // INVALIDATE RESET
-    REG_DMC520->direct_addr = 0x00000000;
-    REG_DMC520->direct_cmd = 0x0001000B;
-    REG_DMC520->memc_status;
-
-    // wait
-    usleep_en(500);
+    // POWERDOWN_ENTRY
+    DMC520_DIRECT_CMD(0x00000006, 0x000F0004),
+    MOD_REG_SCRIPT_DELAY(500),
 
     // INVALIDATE RESET
-    REG_DMC520->direct_addr = 0x00000001;
-    REG_DMC520->direct_cmd = 0x000F000B;
-    REG_DMC520->memc_status;
+    DMC520_DIRECT_CMD(0x00000000, 0x0001000B),
+    MOD_REG_SCRIPT_DELAY(500),
 
-    // wait
-    usleep_en(500);
+    // INVALIDATE RESET
+    DMC520_DIRECT_CMD(0x00000001, 0x000F000B),
+    MOD_REG_SCRIPT_DELAY(500),
 
     // WAIT
-    REG_DMC520->direct_addr = 0x000003E8;
-    REG_DMC520->direct_cmd = 0x0001000D;
-    REG_DMC520->memc_status;
-    REG_DMC520->direct_addr = 0x00000258;
-    REG_DMC520->direct_cmd = 0x0001000D;
-    REG_DMC520->memc_status;
+    DMC520_DIRECT_CMD(0x000003E8, 0x0001000D),
+    DMC520_DIRECT_CMD(0x00000258, 0x0001000D),
 
     // INVALIDATE RESET
-    REG_DMC520->direct_addr = 0x00010001;
-    REG_DMC520->direct_cmd = 0x000F000B;
-    REG_DMC520->memc_status;
-
-    // wait
-    usleep_en(500);
+    DMC520_DIRECT_CMD(0x00010001, 0x000F000B),
+    MOD_REG_SCRIPT_DELAY(500),
 
     // WAIT
-    REG_DMC520->direct_addr = 0x0000003C;
-    REG_DMC520->direct_cmd = 0x0001000D;
-    REG_DMC520->memc_status;
+    DMC520_DIRECT_CMD(0x0000003C, 0x0001000D),
 
     // NOP
-    REG_DMC520->direct_addr = 0x00000000;
-    REG_DMC520->direct_cmd = 0x000F0000;
-    REG_DMC520->memc_status;
+    DMC520_DIRECT_CMD(0x00000000, 0x000F0000),
 
-    return 0;
+    MOD_REG_SCRIPT_END(),
+};
+
+int ddr_init_mc1_mp(REG_ST_DMC520 *REG_DMC520)
+{
+    return reg_script_api->run(
+        ddr_init_mc1_script, (uintptr_t)REG_DMC520, NULL);
 }
 
 int ddr_init_train_mp(
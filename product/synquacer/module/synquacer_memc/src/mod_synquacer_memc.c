@@ -10,10 +10,12 @@
 #include <fwk_module.h>
 #include <fwk_module_idx.h>
 #include <mod_log.h>
+#include <mod_reg_script.h>
 #include <mod_synquacer_memc.h>
 #include <synquacer_ddr.h>
 
 const struct mod_f_i2c_api *f_i2c_api;
+const struct mod_reg_script_api *reg_script_api;
 static struct mod_log_api *log_api;
 static int synquacer_memc_config(void);
 
@@ -58,6 +60,13 @@ static int mod_synquacer_memc_bind(fwk_id_t id, unsigned int round)
     if (status != FWK_SUCCESS)
         return status;
 
+    status = fwk_module_bind(
+        FWK_ID_MODULE(FWK_MODULE_IDX_REG_SCRIPT),
+        MOD_REG_SCRIPT_API_ID_RUN,
+        &reg_script_api);
+    if (status != FWK_SUCCESS)
+        return status;
+
     return FWK_SUCCESS;
 }
 
@@ -71,7 +80,7 @@ static int synquacer_memc_config(void)
 {
     fw_ddr_init();
 
-    log_api->log(MOD_LOG_GROUP_INFO, "[SYNQUACER MEMC] DMC init done.\n");
+    MOD_LOG(log_api, MOD_LOG_GROUP_INFO, "[SYNQUACER MEMC] DMC init done.\n");
 
     return FWK_SUCCESS;
 }
@@ -9,6 +9,10 @@
 #include <string.h>
 
 #include <fwk_assert.h>
+#include <fwk_errno.h>
+
+#include <mod_hsspi.h>
+#include <mod_synquacer_system.h>
 
 #include <synquacer_debug.h>
 #include <synquacer_mmap.h>
@@ -49,6 +53,19 @@ struct arm_tf_fip_package_s {
 
 typedef struct arm_tf_fip_package_s arm_tf_fip_package_t;
 
+/* Copy an image of the FIP package from the flash memory */
+static int fw_fip_copy(
+    void *dst,
+    const arm_tf_fip_package_t *fip_package_p,
+    const fip_toc_entry_t *entry)
+{
+    return synquacer_system_ctx.hsspi_api->read(
+        ((uint32_t)fip_package_p - HSSPI_MEM_BASE) +
+            (uint32_t)entry->offset_addr,
+        dst,
+        (uint32_t)entry->size);
+}
+
 #define ADDR_TRANS_EN (0x1 /* ADDR_TRANS_EN */ << 20)
 #define REG_ASH_SCP_POW_CTL UINT32_C(0x50000000)
 #define ADDR_TRANS_OFFSET UINT32_C(0x34)
@@ -68,8 +85,8 @@ typedef struct arm_tf_fip_package_s arm_tf_fip_package_t;
  */
 static void fw_fip_load_bl32(void)
 {
+    int status;
     uint32_t trans_addr_39_20;
-    void *src, *dst;
     uint8_t bl32_uuid[] = UUID_SECURE_PAYLOAD_BL32;
 
     arm_tf_fip_package_t *fip_package_p =
@@ -91,10 +108,10 @@ static void fw_fip_load_bl32(void)
     *((volatile uint32_t *)(REG_ASH_SCP_POW_CTL + ADDR_TRANS_OFFSET)) =
         trans_addr_39_20;
 
-    src = (void *)((uint32_t)fip_package_p +
-     (uint32_t)fip_package_p->fip_toc_entry[BL32_TOC_ENTRY_INDEX].offset_addr);
-    dst = (void *)SCP_ADDR_TRANS_AREA;
-    memcpy(dst, src, fip_package_p->fip_toc_entry[BL32_TOC_ENTRY_INDEX].size);
+    status = fw_fip_copy(
+        (void *)SCP_ADDR_TRANS_AREA,
+        fip_package_p,
+        &fip_package_p->fip_toc_entry[BL32_TOC_ENTRY_INDEX]);
 
     /* disable DRAM access */
     trans_addr_39_20 =
@@ -102,11 +119,17 @@ static void fw_fip_load_bl32(void)
     *((volatile uint32_t *)(REG_ASH_SCP_POW_CTL + ADDR_TRANS_OFFSET)) =
         trans_addr_39_20;
 
+    if (status != FWK_SUCCESS) {
+        SYNQUACER_DEV_LOG_ERROR("[FIP] BL32 read failed: %d\n", status);
+        return;
+    }
+
     SYNQUACER_DEV_LOG_ERROR("[FIP] BL32 is loaded\n");
 }
 
 void fw_fip_load_arm_tf(void)
 {
+    int status;
     uint32_t i;
 
     const uint32_t arm_tf_dst_addr[3] = { CONFIG_SCB_ARM_TB_BL1_BASE_ADDR,
@@ -144,10 +167,11 @@ void fw_fip_load_arm_tf(void)
             ((uint32_t)fip_package_p +
              (uint32_t)fip_package_p->fip_toc_entry[i].offset_addr));
 
-        memcpy((void *)arm_tf_dst_addr[i],
-               (void *)((uint32_t)fip_package_p +
-                        (uint32_t)fip_package_p->fip_toc_entry[i].offset_addr),
-               (uint32_t)fip_package_p->fip_toc_entry[i].size);
+        status = fw_fip_copy(
+            (void *)arm_tf_dst_addr[i],
+            fip_package_p,
+            &fip_package_p->fip_toc_entry[i]);
+        fwk_assert(status == FWK_SUCCESS);
     }
 
     if (ddr_is_secure_dram_enabled())
@@ -48,7 +48,7 @@ int synquacer_main(void);
 static int synquacer_system_shutdown(
     enum mod_pd_system_shutdown system_shutdown)
 {
-    synquacer_system_ctx.log_api->log(
+    MOD_LOG(synquacer_system_ctx.log_api,
         MOD_LOG_GROUP_DEBUG,
         "[SYNQUACER SYSTEM] requesting synquacer system_shutdown\n");
 
@@ -135,7 +135,7 @@ static int synquacer_system_start(fwk_id_t id)
 
     main_initialize();
 
-    synquacer_system_ctx.log_api->log(
+    MOD_LOG(synquacer_system_ctx.log_api,
         MOD_LOG_GROUP_DEBUG,
         "[SYNQUACER SYSTEM] Request system initialization.\n");
 
@@ -163,7 +163,7 @@ int synquacer_process_event(
     struct fwk_event *resp)
 {
     if (fwk_id_get_event_idx(event->id) == SYNQUACER_SYSTEM_EVENT_START) {
-        synquacer_system_ctx.log_api->log(
+        MOD_LOG(synquacer_system_ctx.log_api,
             MOD_LOG_GROUP_DEBUG,
             "[SYNQUACER SYSTEM] Process system start event.\n");
         synquacer_main();
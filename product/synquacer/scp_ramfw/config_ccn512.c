@@ -18,5 +18,6 @@ struct fwk_module_config config_ccn512 = {
     .get_element_table = NULL,
     .data = &((struct mod_ccn512_module_config){
         .reg_base = (ccn512_reg_t *)CCN512_BASE,
+        .qos_profile = MOD_CCN512_QOS_PROFILE_BALANCED,
     }),
 };
@@ -0,0 +1,31 @@
+/*
+ * Arm SCP/MCP Software
+ * Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <fwk_id.h>
+#include <fwk_macros.h>
+#include <fwk_module.h>
+#include <fwk_module_idx.h>
+#include <mod_load_monitor.h>
+
+static const fwk_id_t module_id_table[] = {
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_SCMI),
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_SCMI_POWER_DOMAIN),
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_POWER_DOMAIN),
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_PPU_V0_SYNQUACER),
+    FWK_ID_MODULE_INIT(FWK_MODULE_IDX_SYSTEM_POWER),
+};
+
+const struct fwk_module_config config_load_monitor = {
+    .data = &((struct mod_load_monitor_config) {
+        .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 0),
+        .sampling_period_ms = 100,
+        .window_length = 10,
+        .warning_threshold = 8000,
+        .module_id_table = module_id_table,
+        .module_count = FWK_ARRAY_SIZE(module_id_table),
+    }),
+};
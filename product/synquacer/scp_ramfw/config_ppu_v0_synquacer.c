@@ -13,6 +13,7 @@
 #include <fwk_macros.h>
 #include <fwk_mm.h>
 #include <fwk_module.h>
+#include <fwk_module_idx.h>
 #include <mod_ppu_v0.h>
 #include <synquacer_core.h>
 #include <synquacer_irq.h>
@@ -141,6 +142,7 @@ static const struct fwk_element *ppu_v0_get_element_table(fwk_id_t module_id)
         ppu_v0_config->ppu.reg_base = (uintptr_t)PPU_CLUSTER(cluster_idx);
         ppu_v0_config->ppu.irq = FWK_INTERRUPT_NONE;
         ppu_v0_config->default_power_on = false;
+        ppu_v0_config->async_transitions = true;
         element_count++;
     }
 
@@ -156,4 +158,7 @@ static const struct fwk_element *ppu_v0_get_element_table(fwk_id_t module_id)
  */
 const struct fwk_module_config config_ppu_v0_synquacer = {
     .get_element_table = ppu_v0_get_element_table,
+    .data = &((struct mod_ppu_v0_config) {
+        .alarm_id = FWK_ID_SUB_ELEMENT_INIT(FWK_MODULE_IDX_TIMER, 0, 1),
+    }),
 };
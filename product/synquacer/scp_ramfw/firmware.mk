@@ -8,6 +8,7 @@
 BS_FIRMWARE_CPU := cortex-m3
 BS_FIRMWARE_HAS_MULTITHREADING := yes
 BS_FIRMWARE_HAS_NOTIFICATION := yes
+BS_FIRMWARE_HAS_EVENT_PROFILING := yes
 
 DEFINES += HAS_RTOS
 DEFINES += SYNQUACER_LOG_GROUP_ERROR
@@ -28,6 +29,7 @@ BS_FIRMWARE_MODULES := \
     log \
     gtimer \
     timer \
+    load_monitor \
     ppu_v0_synquacer \
     system_power \
     power_domain \
@@ -38,6 +40,7 @@ BS_FIRMWARE_MODULES := \
     ccn512 \
     f_i2c \
     hsspi \
+    reg_script \
     synquacer_memc \
     mhu \
     smt \
@@ -55,11 +58,13 @@ BS_FIRMWARE_SOURCES := \
     config_css_clock.c \
     config_f_i2c.c \
     config_hsspi.c \
+    config_load_monitor.c \
     config_log_f_uart3.c \
     config_mhu.c \
     config_pik_clock.c \
     config_power_domain.c \
     config_ppu_v0_synquacer.c \
+    config_reg_script.c \
     config_scmi.c \
     config_scmi_apcore.c \
     config_scmi_system_power.c \
@@ -44,6 +44,48 @@ ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_NOTIFICATION)),)
              Aborting...")
 endif
 
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_EVENT_PROFILING)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_EVENT_PROFILING. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_INTERRUPT_TRACING)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_INTERRUPT_TRACING. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_TRACE)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_TRACE. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_COMPRESSED_IMAGE)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_COMPRESSED_IMAGE. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_LTO)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_LTO. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out yes no,$(BS_FIRMWARE_HAS_HOT_SECTION_REPORT)),)
+    $(error "Invalid parameter for BS_FIRMWARE_HAS_HOT_SECTION_REPORT. \
+             Valid options are: 'yes' and 'no'. \
+             Aborting...")
+endif
+
+ifneq ($(filter-out debug error info warning,$(BS_FIRMWARE_LOG_GROUPS)),)
+    $(error "Invalid parameter for BS_FIRMWARE_LOG_GROUPS. \
+             Valid options are: 'debug', 'error', 'info' and 'warning'. \
+             Aborting...")
+endif
+
 export BS_FIRMWARE_CPU
 export BS_FIRMWARE_HAS_MULTITHREADING
 export BS_FIRMWARE_HAS_NOTIFICATION
@@ -83,6 +125,7 @@ FIRMWARE_DIR := $(PRODUCT_DIR)/$(FIRMWARE)
 TARGET := $(BIN_DIR)/$(FIRMWARE)
 TARGET_BIN := $(TARGET).bin
 TARGET_ELF := $(TARGET).elf
+TARGET_LZ4 := $(TARGET).lz4
 
 vpath %.c $(FIRMWARE_DIR)
 vpath %.S $(FIRMWARE_DIR)
@@ -90,6 +133,9 @@ vpath %.c $(PRODUCT_DIR)/src
 vpath %.S $(PRODUCT_DIR)/src
 
 goal: $(TARGET_BIN)
+ifeq ($(BS_FIRMWARE_HAS_COMPRESSED_IMAGE),yes)
+goal: $(TARGET_LZ4)
+endif
 
 ifneq ($(BS_ARCH_CPU),host)
     ifeq ($(BS_LINKER),ARM)
@@ -204,6 +250,46 @@ else
 endif
 export BUILD_HAS_NOTIFICATION
 
+ifeq ($(BS_FIRMWARE_HAS_EVENT_PROFILING),yes)
+    BUILD_HAS_EVENT_PROFILING := yes
+else
+    BUILD_HAS_EVENT_PROFILING := no
+endif
+export BUILD_HAS_EVENT_PROFILING
+
+ifeq ($(BS_FIRMWARE_HAS_INTERRUPT_TRACING),yes)
+    BUILD_HAS_INTERRUPT_TRACING := yes
+else
+    BUILD_HAS_INTERRUPT_TRACING := no
+endif
+export BUILD_HAS_INTERRUPT_TRACING
+
+ifeq ($(BS_FIRMWARE_HAS_TRACE),yes)
+    BUILD_HAS_TRACE := yes
+else
+    BUILD_HAS_TRACE := no
+endif
+export BUILD_HAS_TRACE
+
+ifeq ($(BS_FIRMWARE_HAS_LTO),yes)
+    BUILD_HAS_LTO := yes
+else
+    BUILD_HAS_LTO := no
+endif
+export BUILD_HAS_LTO
+
+export BUILD_STATIC_APIS := $(BS_FIRMWARE_STATIC_APIS)
+export BUILD_STATIC_BINDINGS := $(BS_FIRMWARE_STATIC_BINDINGS)
+export BUILD_STATIC_SUBSCRIPTIONS := $(BS_FIRMWARE_STATIC_SUBSCRIPTIONS)
+export BUILD_NOTIFICATION_COUNT := $(BS_FIRMWARE_NOTIFICATION_COUNT)
+
+ifneq ($(BS_FIRMWARE_LOG_GROUPS),)
+    BUILD_LOG_GROUPS := $(BS_FIRMWARE_LOG_GROUPS)
+else
+    BUILD_LOG_GROUPS :=
+endif
+export BUILD_LOG_GROUPS
+
 # Add directories to the list of targets to build
 LIB_TARGETS_y += $(patsubst %,$(MODULES_DIR)/%/src, \
                             $(BUILD_STANDARD_MODULES))
@@ -289,6 +375,10 @@ $(TARGET_ELF): $(LIB_TARGETS_y) $(SCATTER_PP) $(OBJECTS) | $$(@D)/
 	$(call show-action,LD,$@)
 	$(LD) $(LDFLAGS) -o $@
 	$(SIZE) $@
+ifeq ($(BS_FIRMWARE_HAS_HOT_SECTION_REPORT),yes)
+	$(SIZE) -A $@ | awk '$$1 == ".hottext" || $$1 == "ER_HOTTEXT" \
+	    { print "Hot section: " $$2 " bytes" }'
+endif
 
 $(SCATTER_PP): $(SCATTER_SRC) | $$(@D)/
 	$(call show-action,GEN,$@)
@@ -298,4 +388,21 @@ $(TARGET_BIN): $(TARGET_ELF) | $$(@D)/
 	$(call show-action,BIN,$@)
 	$(OBJCOPY) $< $(OCFLAGS) $@
 	cp $@ $(BIN_DIR)/firmware.bin
+
+$(TARGET_LZ4): $(TARGET_BIN) | $$(@D)/
+	$(call show-action,LZ4,$@)
+	$(TOOLS_DIR)/compress_image.py $< $@ > /dev/null
+	cp $@ $(BIN_DIR)/firmware.lz4
+
+#
+# Size and stack usage report of the modules, compared against the baseline
+# stored next to the firmware sources
+#
+SIZE_REPORT_BASELINE := $(FIRMWARE_DIR)/size_baseline.json
+
+.PHONY: size-report
+size-report: $(TARGET_BIN)
+	$(TOOLS_DIR)/size_report.py --build-dir $(BUILD_FIRMWARE_DIR) \
+	    --suffix "$(BUILD_SUFFIX)" --baseline $(SIZE_REPORT_BASELINE) \
+	    $(if $(filter yes,$(SIZE_REPORT_UPDATE)),--update) $(TARGET).map
 endif
@@ -21,11 +21,69 @@ ifeq ($(BUILD_HAS_NOTIFICATION),yes)
     DEFINES += BUILD_HAS_NOTIFICATION
 endif
 
+ifeq ($(BUILD_HAS_EVENT_PROFILING),yes)
+    DEFINES += BUILD_HAS_EVENT_PROFILING
+endif
+
+ifeq ($(BUILD_HAS_INTERRUPT_TRACING),yes)
+    DEFINES += BUILD_HAS_INTERRUPT_TRACING
+endif
+
+ifeq ($(BUILD_HAS_TRACE),yes)
+    DEFINES += BUILD_HAS_TRACE
+endif
+
+# Each static API is given as <name>:<symbol of the API structure>
+static_api_name = $(call to_upper,$(word 1,$(subst :, ,$1)))
+static_api_symbol = $(word 2,$(subst :, ,$1))
+DEFINES += $(foreach a,$(BUILD_STATIC_APIS), \
+    BUILD_STATIC_API_$(call static_api_name,$a)=$(call static_api_symbol,$a))
+
+ifneq ($(BUILD_NOTIFICATION_COUNT),)
+    DEFINES += BUILD_NOTIFICATION_COUNT=$(BUILD_NOTIFICATION_COUNT)
+endif
+
+ifneq ($(BUILD_LOG_GROUPS),)
+    DEFINES += BUILD_HAS_LOG_GROUP_FILTER
+    DEFINES += $(foreach group,$(BUILD_LOG_GROUPS), \
+                         BUILD_HAS_LOG_GROUP_$(call to_upper,$(group)))
+endif
+
 export AS := $(CC)
 export LD := $(CC)
 
 include $(BS_DIR)/toolchain.mk
 
+#
+# Link-time optimization across the framework, the modules and the firmware
+#
+ifeq ($(BUILD_HAS_LTO),yes)
+    CFLAGS_GCC += -flto
+    LDFLAGS_GCC += -flto
+
+    # Keep the regular object code next to the intermediate representation for
+    # the archiver to index the symbols of the libraries without a plugin
+    ifeq ($(BS_COMPILER),GCC)
+        CFLAGS_GCC += -ffat-lto-objects
+    endif
+
+    LDFLAGS_ARM += -Wl,--lto
+endif
+
+#
+# Stack usage of the functions, read by the size report of the firmware
+#
+ifeq ($(BS_COMPILER),GCC)
+    ifneq ($(BUILD_HAS_LTO),yes)
+        CFLAGS_GCC += -fstack-usage
+
+        # The call graph of the functions is only generated from GCC 10
+        ifeq ($(shell expr `$(CC) -dumpversion | cut -d. -f1` \>= 10),1)
+            CFLAGS_GCC += -fcallgraph-info=su
+        endif
+    endif
+endif
+
 ifeq ($(BS_LINKER),ARM)
     export AR := $(shell $(CC) --print-prog-name armar)
     export OBJCOPY := $(shell $(CC) --print-prog-name fromelf)
@@ -192,6 +250,8 @@ OBJECTS := $(addprefix $(OBJ_DIR)/, \
 .PHONY: gen_module
 gen_module: $(TOOLS_DIR)/gen_module_code.py | $(BUILD_FIRMWARE_DIR)/
 	$(TOOLS_DIR)/gen_module_code.py --path $(BUILD_FIRMWARE_DIR) \
+	    $(addprefix --static-binding ,$(BUILD_STATIC_BINDINGS)) \
+	    $(addprefix --static-subscription ,$(BUILD_STATIC_SUBSCRIPTIONS)) \
 	    $(FIRMWARE_MODULES_LIST)
 
 # Include BUILD_FIRMWARE_DIR in the compilation
@@ -93,6 +93,14 @@ def main():
     result = subprocess.call(cmd, shell=True)
     results.append(('Product host build (GCC)', result))
 
+    banner('Test running host power domain benchmark')
+
+    cmd = \
+        './build/product/host/pd_bench/release/bin/pd_bench.elf ' \
+        '> build/pd_bench.log'
+    result = subprocess.call(cmd, shell=True)
+    results.append(('Product host power domain benchmark', result))
+
     banner('Test building sgm775 product')
 
     cmd = \
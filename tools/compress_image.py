@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Description:
+#   This tool compresses a firmware binary image into the compressed image
+#   format loaded by fwk_lz4_load_image(): a header followed by an LZ4 block.
+#
+
+import argparse
+import struct
+import sys
+
+# Signature of a compressed image, "LZ4I" in memory
+IMAGE_SIGNATURE = 0x49345A4C
+
+MIN_MATCH = 4
+MAX_OFFSET = 0xFFFF
+# The last match must start at least 12 bytes before the end of the block
+MF_LIMIT = 12
+# The last 5 bytes of the block are always literals
+LAST_LITERALS = 5
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def write_sequence(out, literals, offset=None, match_length=0):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if offset is not None:
+        token |= min(match_length - MIN_MATCH, 15)
+
+    out.append(token)
+    if literal_length >= 15:
+        write_length(out, literal_length - 15)
+    out += literals
+
+    if offset is not None:
+        out += struct.pack('<H', offset)
+        if match_length - MIN_MATCH >= 15:
+            write_length(out, match_length - MIN_MATCH - 15)
+
+
+def compress_block(data):
+    out = bytearray()
+    table = {}
+    size = len(data)
+    match_limit = size - MF_LIMIT
+    anchor = 0
+    pos = 0
+
+    while pos < match_limit:
+        key = data[pos:pos + MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = pos
+
+        if candidate is None or pos - candidate > MAX_OFFSET:
+            pos += 1
+            continue
+
+        length = MIN_MATCH
+        end = size - LAST_LITERALS
+        while pos + length < end and \
+                data[candidate + length] == data[pos + length]:
+            length += 1
+
+        write_sequence(out, data[anchor:pos], pos - candidate, length)
+        pos += length
+        anchor = pos
+
+    write_sequence(out, data[anchor:])
+
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress a firmware image')
+    parser.add_argument('input', help='Binary image to compress')
+    parser.add_argument('output', help='Compressed image')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    block = compress_block(data)
+
+    with open(args.output, 'wb') as f:
+        f.write(struct.pack('<III', IMAGE_SIGNATURE, len(data), len(block)))
+        f.write(block)
+
+    print('{}: {} -> {} bytes'.format(args.output, len(data),
+                                      len(block) + 12))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -9,6 +9,9 @@
 #   This tool takes a list of module names and generates two files:
 #   * fwk_modules_idx.h: Contains an enumeration giving the modules' indices.
 #   * fwk_modules_list.c: Contains a table of pointers to a module descriptor.
+#     The tables are constant for them to be kept in read-only memory.
+#     It also contains the table of the bindings resolved at build time and
+#     the table of the notification subscriptions declared at build time.
 #
 # Note: The files are updated only if their contents will differ, relative to
 #   the last time the tool was run.
@@ -20,6 +23,9 @@ import sys
 
 DEFAULT_PATH = 'build/'
 
+# Source of a static binding matching any module
+ANY_SOURCE = 'any'
+
 FILENAME_H = "fwk_module_idx.h"
 TEMPLATE_H = "/* This file was auto generated using {} */\n" \
              "#ifndef FWK_MODULE_IDX_H\n" \
@@ -38,18 +44,36 @@ TEMPLATE_H = "/* This file was auto generated using {} */\n" \
 FILENAME_C = "fwk_module_list.c"
 TEMPLATE_C = "/* This file was auto generated using {} */\n" \
              "#include <stddef.h>\n" \
+             "#include <fwk_id.h>\n" \
              "#include <fwk_module.h>\n" \
+             "#include <fwk_module_idx.h>\n" \
+             "#include <internal/fwk_module.h>\n" \
+             "#include <internal/fwk_notification.h>\n" \
+             "{}" \
              "\n" \
              "{}" \
              "\n" \
-             "const struct fwk_module *module_table[] = {{\n" \
+             "const struct fwk_module *const module_table[] = {{\n" \
              "{}" \
              "    NULL\n" \
              "}};\n" \
              "\n" \
-             "const struct fwk_module_config *module_config_table[] = {{\n" \
+             "const struct fwk_module_config *const module_config_table[] = " \
+             "{{\n" \
              "{}" \
              "    NULL\n" \
+             "}};\n" \
+             "\n" \
+             "const struct fwk_module_static_binding " \
+             "module_static_binding_table[] = {{\n" \
+             "{}" \
+             "    {{ .api = NULL }}\n" \
+             "}};\n" \
+             "\n" \
+             "const struct fwk_notification_static_subscription " \
+             "module_static_subscription_table[] = {{\n" \
+             "{}" \
+             "    {{ .notification_id = FWK_ID_NONE_INIT }}\n" \
              "}};\n"
 
 
@@ -78,10 +102,22 @@ def generate_header(path, modules):
     generate_file(path, FILENAME_H, content)
 
 
-def generate_c(path, modules):
+def entity_id(entity):
+    module, element = entity
+    if element is None:
+        return "FWK_ID_MODULE_INIT(FWK_MODULE_IDX_{})".format(module.upper())
+
+    return "FWK_ID_ELEMENT_INIT(FWK_MODULE_IDX_{}, {})".format(module.upper(),
+                                                             element)
+
+
+def generate_c(path, modules, bindings, subscriptions):
     module_entry = ""
     config_entry = ""
     extern_entry = ""
+    include_entry = ""
+    binding_entry = ""
+    subscription_entry = ""
     for module in modules:
         extern_entry += "extern const struct fwk_module module_{};\n"\
             .format(module.lower())
@@ -90,11 +126,94 @@ def generate_c(path, modules):
         module_entry += "    &module_{},\n".format(module.lower())
         config_entry += "    &config_{},\n".format(module.lower())
 
-    content = TEMPLATE_C.format(sys.argv[0], extern_entry, module_entry,
-                                config_entry)
+    for source, target, api, symbol in bindings:
+        header = "#include <mod_{}.h>\n".format(target.lower())
+        if header not in include_entry:
+            include_entry += header
+
+        if source == ANY_SOURCE:
+            source_id = "FWK_ID_NONE_INIT"
+        else:
+            source_id = "FWK_ID_MODULE_INIT(FWK_MODULE_IDX_{})"\
+                .format(source.upper())
+
+        binding_entry += "    {{\n" \
+                         "        .source_id = {},\n" \
+                         "        .api_id = FWK_ID_API_INIT(" \
+                         "FWK_MODULE_IDX_{}, {}),\n" \
+                         "        .api = &{},\n" \
+                         "    }},\n".format(source_id, target.upper(), api,
+                                          symbol)
+
+    for source, notification, target in subscriptions:
+        header = "#include <mod_{}.h>\n".format(source[0].lower())
+        if header not in include_entry:
+            include_entry += header
+
+        subscription_entry += "    {{\n" \
+                              "        .notification_id = " \
+                              "FWK_ID_NOTIFICATION_INIT(" \
+                              "FWK_MODULE_IDX_{}, {}),\n" \
+                              "        .source_id = {},\n" \
+                              "        .target_id = {},\n" \
+                              "    }},\n".format(source[0].upper(),
+                                               notification,
+                                               entity_id(source),
+                                               entity_id(target))
+
+    content = TEMPLATE_C.format(sys.argv[0], include_entry, extern_entry,
+                                module_entry, config_entry, binding_entry,
+                                subscription_entry)
     generate_file(path, FILENAME_C, content)
 
 
+def parse_binding(binding, modules):
+    fields = binding.split(':')
+    if len(fields) != 4:
+        raise argparse.ArgumentTypeError(
+            "Invalid static binding '{}', expected "
+            "<source>:<target>:<api index>:<symbol>".format(binding))
+
+    source, target = fields[0:2]
+    for module in [target] + ([] if source == ANY_SOURCE else [source]):
+        if module not in modules:
+            raise argparse.ArgumentTypeError(
+                "Static binding '{}' refers to the module '{}' which is not "
+                "in the firmware".format(binding, module))
+
+    return fields
+
+
+def parse_entity(entity, subscription, modules):
+    module, _, element = entity.partition('.')
+    if module not in modules:
+        raise argparse.ArgumentTypeError(
+            "Static subscription '{}' refers to the module '{}' which is not "
+            "in the firmware".format(subscription, module))
+
+    if element == "":
+        return (module, None)
+
+    if not element.isdigit():
+        raise argparse.ArgumentTypeError(
+            "Invalid element index '{}' in static subscription '{}'"
+            .format(element, subscription))
+
+    return (module, int(element))
+
+
+def parse_subscription(subscription, modules):
+    fields = subscription.split(':')
+    if len(fields) != 3:
+        raise argparse.ArgumentTypeError(
+            "Invalid static subscription '{}', expected "
+            "<source>:<notification index>:<target>".format(subscription))
+
+    source, notification, target = fields
+    return (parse_entity(source, subscription, modules), notification,
+            parse_entity(target, subscription, modules))
+
+
 def main():
     parser = argparse.ArgumentParser(description="Generates a header file and \
         source file enumerating the modules that are included in a firmware.")
@@ -112,12 +231,37 @@ def main():
                         overwritten.',
                         default=DEFAULT_PATH)
 
+    parser.add_argument('-b', '--static-binding',
+                        metavar='binding',
+                        action='append',
+                        default=[],
+                        help='A binding resolved at build time, given as \
+                        <source>:<target>:<api index>:<symbol>. The source \
+                        module may be "any".')
+
+    parser.add_argument('-s', '--static-subscription',
+                        metavar='subscription',
+                        action='append',
+                        default=[],
+                        help='A notification subscription declared at build \
+                        time, given as <source>:<notification index>:<target> \
+                        where the source and the target are <module> or \
+                        <module>.<element index>.')
+
     args = parser.parse_args()
 
     modules = args.modules
 
+    try:
+        bindings = [parse_binding(binding, modules)
+                    for binding in args.static_binding]
+        subscriptions = [parse_subscription(subscription, modules)
+                         for subscription in args.static_subscription]
+    except argparse.ArgumentTypeError as error:
+        parser.error(str(error))
+
     generate_header(args.path, modules)
-    generate_c(args.path, modules)
+    generate_c(args.path, modules, bindings, subscriptions)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Description:
+#   This tool generates the rate table of an N1SDP PLL: for each of the given
+#   rates, the values of the control registers of the PLL programming it from
+#   the given reference clock. The table is written as a header to be included
+#   by the configuration of the n1sdp_pll module, so that the driver does not
+#   have to work out the dividers when a rate is set.
+#
+#   The rates that are multiples of the reference clock rate use the feedback
+#   divider alone, as the driver does. For the other rates, the dividers are
+#   searched for an output rate within the tolerance of the requested rate,
+#   with the smallest reference divider first, and the highest VCO rate then.
+#
+
+import argparse
+import datetime
+import os
+import sys
+import textwrap
+
+MHZ = 1000 * 1000
+KHZ = 1000
+
+# Limits of the PLL, see product/n1sdp/module/n1sdp_pll/include/internal
+RATE_MIN = 50 * MHZ
+RATE_MAX = 3200 * MHZ
+FBDIV_MIN = 16
+FBDIV_MAX = 1600
+REFDIV_MIN = 1
+REFDIV_MAX = 63
+POSTDIV_MIN = 1
+POSTDIV_MAX = 7
+
+# Bit positions of the fields of the control registers
+PLL_FBDIV_BIT_POS = 8
+PLL_REFDIV_POS = 20
+PLL_POSTDIV1_POS = 24
+PLL_POSTDIV2_POS = 28
+
+TEMPLATE_H = "/*\n" \
+             " * Arm SCP/MCP Software\n" \
+             " * Copyright (c) {}, Arm Limited and Contributors. " \
+             "All rights reserved.\n" \
+             " *\n" \
+             " * SPDX-License-Identifier: BSD-3-Clause\n" \
+             " */\n" \
+             "\n" \
+             "/*\n" \
+             " * This file was auto generated using:\n" \
+             "{}" \
+             " */\n" \
+             "#ifndef {}\n" \
+             "#define {}\n" \
+             "\n" \
+             "#include <stdint.h>\n" \
+             "#include <mod_n1sdp_pll.h>\n" \
+             "\n" \
+             "/* Reference clock rate: {} Hz */\n" \
+             "static const struct n1sdp_pll_rate_entry {}[] = {{\n" \
+             "{}" \
+             "}};\n" \
+             "\n" \
+             "#endif /* {} */\n"
+
+TEMPLATE_ENTRY = "    {{\n" \
+                 "        /* {} Hz: FBDIV {}, REFDIV {}, POSTDIV {} */\n" \
+                 "        .rate = UINT64_C({}),\n" \
+                 "        .control_reg0 = UINT32_C(0x{:08X}),\n" \
+                 "        .control_reg1 = UINT32_C(0x{:08X}),\n" \
+                 "    }},\n"
+
+
+def find_dividers(ref_rate, rate, tolerance):
+    if (rate % ref_rate) == 0:
+        fbdiv = rate // ref_rate
+        if FBDIV_MIN <= fbdiv <= FBDIV_MAX:
+            return (fbdiv, REFDIV_MIN, POSTDIV_MIN)
+
+    for refdiv in range(REFDIV_MIN, REFDIV_MAX + 1):
+        best = None
+
+        for postdiv in range(POSTDIV_MIN, POSTDIV_MAX + 1):
+            fbdiv = (rate * refdiv * postdiv + (ref_rate // 2)) // ref_rate
+            if not FBDIV_MIN <= fbdiv <= FBDIV_MAX:
+                continue
+
+            vco_rate = (ref_rate * fbdiv) // refdiv
+            if not RATE_MIN <= vco_rate <= RATE_MAX:
+                continue
+
+            if abs((vco_rate // postdiv) - rate) >= tolerance:
+                continue
+
+            if (best is None) or (vco_rate > best[0]):
+                best = (vco_rate, fbdiv, postdiv)
+
+        if best is not None:
+            return (best[1], refdiv, best[2])
+
+    return None
+
+
+def generate_entry(ref_rate, rate, tolerance):
+    dividers = find_dividers(ref_rate, rate, tolerance)
+    if dividers is None:
+        return None
+
+    fbdiv, refdiv, postdiv = dividers
+    control_reg0 = (fbdiv << PLL_FBDIV_BIT_POS) | (refdiv << PLL_REFDIV_POS)
+    control_reg1 = (postdiv << PLL_POSTDIV1_POS) | (1 << PLL_POSTDIV2_POS)
+
+    return TEMPLATE_ENTRY.format(rate, fbdiv, refdiv, postdiv, rate,
+                                 control_reg0, control_reg1)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generates the rate table of an N1SDP PLL')
+
+    parser.add_argument('rates', metavar='rate', type=int, nargs='+',
+                        help='Rate of the table, in MHz')
+
+    parser.add_argument('-r', '--ref-rate', type=int, required=True,
+                        help='Rate of the reference clock, in MHz')
+
+    parser.add_argument('-t', '--tolerance', type=int, default=1000,
+                        help='Tolerance on the output rates, in kHz')
+
+    parser.add_argument('-n', '--name', default='n1sdp_pll_rate_table',
+                        help='Name of the table')
+
+    parser.add_argument('-o', '--output', required=True,
+                        help='Path of the generated header')
+
+    args = parser.parse_args()
+
+    ref_rate = args.ref_rate * MHZ
+    tolerance = args.tolerance * KHZ
+
+    entries = ''
+    for rate in sorted(set(args.rates)):
+        entry = generate_entry(ref_rate, rate * MHZ, tolerance)
+        if entry is None:
+            print('No dividers for {} MHz'.format(rate), file=sys.stderr)
+            return 1
+
+        entries += entry
+
+    guard = os.path.basename(args.output).upper().replace('.', '_')
+    command = ' '.join([os.path.basename(__file__)] + sys.argv[1:])
+    command = ''.join(' *     {}\n'.format(line)
+                      for line in textwrap.wrap(command, 70))
+
+    content = TEMPLATE_H.format(datetime.date.today().year, command, guard,
+                                guard, ref_rate, args.name, entries, guard)
+
+    with open(args.output, 'w') as output:
+        output.write(content)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,295 @@
+#!/usr/bin/env python3
+#
+# Arm SCP/MCP Software
+# Copyright (c) 2019, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Description:
+#   This tool reports, for each module of a firmware, the size of its code,
+#   read-only data, data and zero-initialized data from the map file of the
+#   firmware, the largest stack frame of its functions from the .su files
+#   generated with -fstack-usage and the worst-case stack usage and call depth
+#   of its functions from the .ci files generated with -fcallgraph-info.
+#
+#   The report is compared against a baseline, stored in the tree next to the
+#   firmware, and the tool fails when a module has grown.
+#
+
+import argparse
+import json
+import os
+import re
+import sys
+
+METRICS = ['text', 'rodata', 'data', 'bss', 'frame', 'stack', 'depth']
+
+# Component of the objects not built from the tree, e.g. the C library
+TOOLCHAIN = 'toolchain'
+
+INPUT_SECTION = re.compile(r'^ (\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)'
+                           r'\s+(.+))?$')
+SECTION_CONTINUATION = re.compile(r'^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)'
+                                  r'\s+(.+)$')
+CI_NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "[^"]*?'
+                     r'(?:\\n(\d+) bytes \([^)]*\))?"')
+CI_EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" '
+                     r'targetname: "([^"]+)"')
+
+INDIRECT_CALL = '__indirect_call'
+
+
+def section_metric(name):
+    if name == '.text' or name.startswith('.text.'):
+        return 'text'
+    if name == '.rodata' or name.startswith('.rodata.'):
+        return 'rodata'
+    if name == '.data' or name.startswith('.data.'):
+        return 'data'
+    if name == '.bss' or name.startswith('.bss.') or name == 'COMMON':
+        return 'bss'
+    return None
+
+
+class Firmware:
+    def __init__(self, build_dir, suffix):
+        self.build_dir = os.path.abspath(build_dir)
+        self.suffix = suffix
+        self.modules = {}
+
+    def component(self, path):
+        # Archive members are given as <archive>(<member>)
+        path = os.path.abspath(re.sub(r'\(.*\)$', '', path))
+        if not path.startswith(self.build_dir + os.sep):
+            return TOOLCHAIN
+
+        parts = os.path.relpath(path, self.build_dir).split(os.sep)
+        if parts[0] == 'module' and len(parts) > 1:
+            name = parts[1]
+            if self.suffix and name.endswith(self.suffix):
+                name = name[:-len(self.suffix)]
+            return name
+        if parts[0] in ['framework' + self.suffix, 'arch' + self.suffix]:
+            return parts[0][:len(parts[0]) - len(self.suffix)]
+
+        # The objects of the firmware itself, including the generated ones
+        return 'firmware'
+
+    def module(self, name):
+        return self.modules.setdefault(name, dict.fromkeys(METRICS, 0))
+
+    def parse_map(self, path):
+        with open(path) as f:
+            lines = f.read().splitlines()
+
+        # The sections listed before the memory map have been discarded
+        try:
+            start = lines.index('Linker script and memory map')
+        except ValueError:
+            sys.exit('{}: not a GNU linker map file'.format(path))
+
+        pending = None
+        for line in lines[start:]:
+            if pending is not None:
+                match = SECTION_CONTINUATION.match(line)
+                if match:
+                    self.add_section(pending, int(match.group(2), 16),
+                                     match.group(3))
+                pending = None
+                continue
+
+            match = INPUT_SECTION.match(line)
+            if not match:
+                continue
+
+            if match.group(4) is None:
+                # The name is too long, the section continues on the next line
+                pending = match.group(1)
+            else:
+                self.add_section(match.group(1), int(match.group(3), 16),
+                                 match.group(4))
+
+    def add_section(self, name, size, path):
+        metric = section_metric(name)
+        if metric is not None:
+            self.module(self.component(path))[metric] += size
+
+    def parse_stack_usage(self):
+        nodes = {}
+        frames = {}
+        edges = {}
+
+        for root, _, files in os.walk(self.build_dir):
+            for filename in files:
+                path = os.path.join(root, filename)
+                if filename.endswith('.su'):
+                    self.parse_su(path)
+                elif filename.endswith('.ci'):
+                    self.parse_ci(path, nodes, frames, edges)
+
+        self.call_graph = CallGraph(frames, edges)
+        for function, component in nodes.items():
+            if component is None:
+                continue
+
+            stack, depth = self.call_graph.worst_case(function)
+            module = self.module(component)
+            if stack > module['stack']:
+                module['stack'] = stack
+                module['depth'] = depth
+
+    def parse_su(self, path):
+        module = self.module(self.component(path))
+        with open(path) as f:
+            for line in f:
+                fields = line.split('\t')
+                if len(fields) >= 2:
+                    module['frame'] = max(module['frame'], int(fields[1]))
+
+    def parse_ci(self, path, nodes, frames, edges):
+        component = self.component(path)
+        with open(path) as f:
+            for line in f:
+                match = CI_NODE.match(line)
+                if match:
+                    title, size = match.groups()
+                    if size is not None:
+                        nodes[title] = component
+                        frames[title] = int(size)
+                    else:
+                        nodes.setdefault(title, None)
+                    continue
+
+                match = CI_EDGE.match(line)
+                if match:
+                    edges.setdefault(match.group(1), set()).add(match.group(2))
+
+
+class CallGraph:
+    def __init__(self, frames, edges):
+        self.frames = frames
+        self.edges = edges
+        self.cache = {}
+        self.recursive = set()
+        self.indirect = set()
+
+    def worst_case(self, function, path=()):
+        """Worst-case stack usage and call depth of a function's call tree."""
+
+        if function in self.cache:
+            return self.cache[function]
+
+        if function in path:
+            # The stack usage of a recursion cannot be bounded statically
+            self.recursive.add(function)
+            return 0, 0
+
+        stack = 0
+        depth = 0
+        for callee in self.edges.get(function, ()):
+            if callee == INDIRECT_CALL:
+                self.indirect.add(function)
+                continue
+
+            callee_stack, callee_depth = \
+                self.worst_case(callee, path + (function,))
+            if (callee_stack, callee_depth) > (stack, depth):
+                stack, depth = callee_stack, callee_depth
+
+        # Functions without a stack frame are outside of the firmware sources
+        result = (self.frames.get(function, 0) + stack, depth + 1)
+        self.cache[function] = result
+        return result
+
+
+def print_report(modules, baseline):
+    header = '{:<20}'.format('Module') + \
+        ''.join('{:>8}'.format(metric) for metric in METRICS)
+    print(header)
+    print('-' * len(header))
+
+    for name in sorted(modules):
+        print('{:<20}'.format(name) +
+              ''.join('{:>8}'.format(modules[name][metric])
+                      for metric in METRICS))
+
+    totals = {metric: sum(module[metric] for module in modules.values())
+              for metric in METRICS[:4]}
+    print('-' * len(header))
+    print('ROM (text + rodata + data): {} bytes'.format(
+        totals['text'] + totals['rodata'] + totals['data']))
+    print('RAM (data + bss): {} bytes'.format(totals['data'] + totals['bss']))
+
+    growth = []
+    if baseline is None:
+        return growth
+
+    for name in sorted(set(modules) | set(baseline)):
+        for metric in METRICS:
+            old = baseline.get(name, {}).get(metric, 0)
+            new = modules.get(name, {}).get(metric, 0)
+            if new != old:
+                print('{}: {} {} -> {} ({:+d})'.format(name, metric, old, new,
+                                                       new - old))
+            if new > old:
+                growth.append(name)
+
+    return growth
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Report the size and stack usage of the modules of a '
+                    'firmware')
+    parser.add_argument('map', help='Map file of the firmware')
+    parser.add_argument('-d', '--build-dir', required=True,
+                        help='Build directory of the firmware')
+    parser.add_argument('-s', '--suffix', default='',
+                        help='Suffix of the build directories of the modules')
+    parser.add_argument('-b', '--baseline',
+                        help='Baseline to compare the report against')
+    parser.add_argument('-u', '--update', action='store_true',
+                        help='Write the report to the baseline')
+    args = parser.parse_args()
+
+    firmware = Firmware(args.build_dir, args.suffix)
+    firmware.parse_map(args.map)
+    firmware.parse_stack_usage()
+
+    baseline = None
+    if args.baseline and not args.update and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    growth = print_report(firmware.modules, baseline)
+
+    graph = firmware.call_graph
+    if graph.recursive:
+        print('Recursive functions (not bounded): {}'.format(
+            ', '.join(sorted(graph.recursive))))
+    if graph.indirect:
+        print('Functions with indirect calls (not followed): {}'.format(
+            len(graph.indirect)))
+
+    if args.update and args.baseline:
+        with open(args.baseline, 'w') as f:
+            json.dump(firmware.modules, f, indent=4, sort_keys=True)
+            f.write('\n')
+        print('Baseline {} updated'.format(args.baseline))
+        return 0
+
+    if baseline is None:
+        if args.baseline:
+            print('No baseline {}'.format(args.baseline))
+        return 0
+
+    if growth:
+        print('Modules grown since the baseline: {}'.format(
+            ', '.join(sorted(set(growth)))))
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())